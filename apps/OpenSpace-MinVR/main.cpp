@@ -39,6 +39,7 @@
 #include <api/MinVR.h>
 #include <GLFW/glfw3.h>
 #include <numeric>
+#include <optional>
 
 // @TODO:  Add Spout support
 // @TODO:  Reintroduce commandline-parsing
@@ -76,6 +77,8 @@ struct {
 
     float averageDeltatime = -1.f;
     float deltaTime = -1.f;
+
+    std::optional<glm::vec3> gazeDirection;
 } windowingGlobals;
 
 struct {
@@ -226,6 +229,13 @@ void Handler::onVREvent(const VRDataIndex& eventData) {
     }
     else if (type == "TrackerMove") {
         const VRTrackerEvent& event = static_cast<const VRTrackerEvent&>(eventData);
+
+        // Eye trackers are reported as trackers whose forward axis is the direction the
+        // user is looking at. It is used to center the foveated rendering
+        if (event.getName().find("Gaze") != std::string::npos) {
+            const glm::mat4 transform = glm::make_mat4(event.getTransform());
+            windowingGlobals.gazeDirection = -glm::vec3(transform[2]);
+        }
     }
     else if (type == "OpenSpaceMessage") {
         if (global::windowDelegate.isMaster()) {
@@ -322,6 +332,8 @@ void setupMinVrDelegateFunctions(VRMain& main) {
 
     delegate.isMaster = []() { return IsMasterNode; };
 
+    delegate.gazeDirection = []() { return windowingGlobals.gazeDirection; };
+
     delegate.openGLProcedureAddress = [](const char* func) {
         VRWindowToolkit* wtk = engine.getWindowToolkit("VRGLFWWindowToolkit");
         VRglproc procAddress = wtk->getProcAddress(func);
@@ -86,10 +86,17 @@ private:
     std::pair<std::string, std::string> readTimeRange();
     bool handleRequest();
     std::string constructUrl();
+    nlohmann::json sendChunkedRequest();
     openspace::HorizonsFile handleAnswer(nlohmann::json& answer);
     bool handleResult(openspace::HorizonsResultCode& result);
 
     openspace::HorizonsFile _horizonsFile;
+
+    // The parameters of the latest request that was constructed
+    openspace::HorizonsType _requestType = openspace::HorizonsType::Invalid;
+    std::string _command;
+    std::string _center;
+    std::string _unit;
 #endif // OPENSPACE_MODULE_SPACE_ENABLED
 
     QNetworkAccessManager* _manager;
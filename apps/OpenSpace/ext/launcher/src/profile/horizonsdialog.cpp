@@ -30,6 +30,7 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/boolean.h>
 #include <QComboBox>
+#include <QCoreApplication>
 #include <QDateTimeEdit>
 #include <QDialogButtonBox>
 #include <QEventLoop>
@@ -45,6 +46,8 @@
 #include <QPushButton>
 #include <QScrollBar>
 #include <QStyle>
+#include <chrono>
+#include <future>
 #include <sstream>
 
 using json = nlohmann::json;
@@ -720,6 +723,17 @@ bool HorizonsDialog::handleRequest() {
         return false;
     }
 
+    // Requests with too many steps for a single answer are split into several requests
+    // if the length of a step is fixed
+    const bool isFixedStep = _unit == "m" || _unit == "h" || _unit == "d";
+    if (isValidHorizonsAnswer(answer) == HorizonsResultCode::ErrorSize && isFixedStep) {
+        answer = sendChunkedRequest();
+        if (answer.empty()) {
+            _errorMsg->setText("Connection error");
+            return false;
+        }
+    }
+
     HorizonsFile file = handleAnswer(answer);
     if (!file.hasFile()) {
         return false;
@@ -829,6 +843,11 @@ std::string HorizonsDialog::constructUrl() {
         return "";
     }
 
+    _requestType = type;
+    _command = command;
+    _center = center;
+    _unit = unit;
+
     return constructHorizonsUrl(
         type,
         command,
@@ -840,6 +859,43 @@ std::string HorizonsDialog::constructUrl() {
     );
 }
 
+json HorizonsDialog::sendChunkedRequest() {
+    appendLog(
+        "The request is too big for a single answer, splitting it into several requests",
+        HorizonsDialog::LogLevel::Info
+    );
+
+    // The chunks are downloaded next to the requested file and are kept if the download
+    // fails, so that trying again only downloads the chunks that are still missing
+    std::filesystem::path filePath =
+        std::filesystem::absolute(_fileEdit->text().toStdString());
+    std::filesystem::path downloadPath = filePath;
+    downloadPath.replace_extension(".download");
+
+    std::future<json> answer = std::async(
+        std::launch::async,
+        [type = _requestType, command = _command, center = _center,
+         start = _startTime, end = _endTime, step = _stepEdit->text().toStdString(),
+         unit = _unit, downloadPath]()
+        {
+            return sendChunkedHorizonsRequest(
+                type, command, center, start, end, step, unit, downloadPath
+            );
+        }
+    );
+
+    // Keep the dialog responsive while waiting, in the same way as for a single request
+    _downloadProgress->setRange(0, 0);
+    _downloadProgress->show();
+    while (answer.wait_for(std::chrono::milliseconds(50)) != std::future_status::ready) {
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+    _downloadProgress->hide();
+
+    std::filesystem::remove(downloadPath);
+    return answer.get();
+}
+
 openspace::HorizonsFile HorizonsDialog::handleAnswer(json& answer) {
     auto it = answer.find("error");
     if (it != answer.end()) {
@@ -25,10 +25,12 @@
 #include <openspace/engine/configuration.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/engine/globals.h>
+#include <openspace/engine/globalscallbacks.h>
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/interaction/joystickinputstate.h>
 #include <openspace/openspace.h>
+#include <openspace/util/benchmarkrunner.h>
 #include <ghoul/ghoul.h>
 #include <ghoul/fmt.h>
 #include <ghoul/glm.h>
@@ -55,6 +57,7 @@
 #include <stb_image.h>
 #include <tracy/Tracy.hpp>
 #include <iostream>
+#include <span>
 #include <string_view>
 
 #ifdef WIN32
@@ -654,7 +657,10 @@ std::vector<std::byte> mainEncodeFun() {
     ZoneScoped;
     LTRACE("main::mainEncodeFun(begin)");
 
-    std::vector<std::byte> data = global::openSpaceEngine->encode();
+    // SGCT takes ownership of the returned vector, so this is the only copy of the
+    // encoded data that is made per frame
+    std::span<const std::byte> encoded = global::openSpaceEngine->encode();
+    std::vector<std::byte> data(encoded.begin(), encoded.end());
 
     LTRACE("main::mainEncodeFun(end)");
     return data;
@@ -1181,6 +1187,28 @@ int main(int argc, char* argv[]) {
         "example:  OpenSpace --config Profile=[[jwst]]"
     ));
 
+    parser.addCommand(std::make_unique<ghoul::cmdparser::SingleCommand<std::string>>(
+        commandlineArguments.benchmarkRecording, "--benchmark", "",
+        "Runs a rendering benchmark by playing back the provided session recording, "
+        "relative to the ${RECORDINGS} folder, with a fixed time step per frame after "
+        "the profile has been loaded. The duration, phase timings, and memory of each "
+        "frame are written to a report and OpenSpace exits when the playback ends. The "
+        "launcher is skipped, so the profile has to be provided in the configuration "
+        "file or with --config"
+    ));
+
+    parser.addCommand(std::make_unique<ghoul::cmdparser::SingleCommand<std::string>>(
+        commandlineArguments.benchmarkReport, "--benchmark-report", "",
+        "The path to which the JSON report of the benchmark is written. If it is not "
+        "provided, the report is written to ${LOGS}/benchmark.json"
+    ));
+
+    parser.addCommand(std::make_unique<ghoul::cmdparser::SingleCommand<int>>(
+        commandlineArguments.benchmarkFps, "--benchmark-fps", "",
+        "The number of frames that are rendered per second of recorded time during the "
+        "benchmark. The default is 60"
+    ));
+
     // setCommandLine returns a reference to the vector that will be filled later
     const std::vector<std::string>& sgctArguments = parser.setCommandLine(
         { argv, argv + argc }
@@ -1308,8 +1336,10 @@ int main(int argc, char* argv[]) {
     QApplication app(qac, nullptr);
 #endif // __APPLE__
 
+    const bool isBenchmark = !commandlineArguments.benchmarkRecording.empty();
     bool skipLauncher =
-        (hasProfile && hasSGCTConfig) || global::configuration->bypassLauncher;
+        (hasProfile && hasSGCTConfig) || global::configuration->bypassLauncher ||
+        isBenchmark;
     if (!skipLauncher) {
 #ifndef __APPLE__
         int qac = 0;
@@ -1360,6 +1390,22 @@ int main(int argc, char* argv[]) {
         exit(EXIT_FAILURE);
     }
 
+    // The runner has to outlive the rendering loop in which its callback is called
+    std::unique_ptr<BenchmarkRunner> benchmarkRunner;
+    if (isBenchmark) {
+        std::filesystem::path report = commandlineArguments.benchmarkReport.empty() ?
+            absPath("${LOGS}/benchmark.json") :
+            absPath(commandlineArguments.benchmarkReport);
+        benchmarkRunner = std::make_unique<BenchmarkRunner>(BenchmarkRunner::Settings {
+            .recording = commandlineArguments.benchmarkRecording,
+            .report = std::move(report),
+            .fps = std::max(commandlineArguments.benchmarkFps, 1)
+        });
+        global::callback::postDraw->push_back(
+            [runner = benchmarkRunner.get()]() { runner->postDraw(); }
+        );
+    }
+
 
     // Prepend the outgoing sgctArguments with the program name
     // as well as the configuration file that sgct is supposed to use
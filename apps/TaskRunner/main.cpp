@@ -22,7 +22,11 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <ghoul/glm.h>
 
@@ -36,6 +40,7 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/cmdparser/commandlineparser.h>
 #include <ghoul/cmdparser/singlecommand.h>
+#include <ghoul/misc/exception.h>
 
 #include <openspace/engine/configuration.h>
 #include <openspace/engine/globals.h>
@@ -49,6 +54,8 @@
 #include <openspace/util/factorymanager.h>
 #include <openspace/util/resourcesynchronization.h>
 #include <openspace/util/task.h>
+#include <openspace/util/taskcache.h>
+#include <openspace/util/taskscheduler.h>
 #include <openspace/scene/translation.h>
 #include <openspace/scene/rotation.h>
 #include <openspace/scene/scale.h>
@@ -62,7 +69,9 @@ namespace {
     const std::string _loggerCat = "TaskRunner Main";
 }
 
-void performTasks(const std::string& path) {
+void performTasks(const std::string& path, int nThreads, int memoryLimit,
+                  bool useCache)
+{
     using namespace openspace;
 
     TaskLoader taskLoader;
@@ -76,18 +85,83 @@ void performTasks(const std::string& path) {
         LINFO(fmt::format("Task queue has {} items", tasks.size()));
     }
 
-    for (size_t i = 0; i < tasks.size(); i++) {
-        Task& task = *tasks[i].get();
-        LINFO(fmt::format(
-            "Performing task {} out of {}: {}", i + 1, tasks.size(), task.description()
-        ));
-        ProgressBar progressBar(100);
-        auto onProgress = [&progressBar](float progress) {
-            progressBar.print(static_cast<int>(progress * 100.f));
-        };
-        task.perform(onProgress);
+    std::optional<TaskScheduler> scheduler;
+    try {
+        scheduler.emplace(std::move(tasks));
     }
-    std::cout << "Done performing tasks" << std::endl;
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(fmt::format("Could not schedule tasks: {}", e.message));
+        return;
+    }
+
+    // With a single thread, only one task runs at a time and can have a progress bar.
+    // Otherwise the progress of all tasks is logged in steps of 10%
+    std::mutex progressMutex;
+    size_t progressBarTask = nTasks;
+    std::unique_ptr<ProgressBar> progressBar;
+    std::vector<int> reportedProgress(nTasks, 0);
+    auto onProgress = [&](size_t task, float progress) {
+        std::lock_guard lock(progressMutex);
+        const int percent = static_cast<int>(progress * 100.f);
+        if (nThreads == 1) {
+            if (task != progressBarTask) {
+                progressBar = std::make_unique<ProgressBar>(100);
+                progressBarTask = task;
+            }
+            progressBar->print(percent);
+        }
+        else if (percent / 10 > reportedProgress[task] / 10) {
+            reportedProgress[task] = percent;
+            LINFO(fmt::format("Task {} out of {}: {}%", task + 1, nTasks, percent));
+        }
+    };
+
+    // Tasks whose inputs and parameters have not changed since their last successful
+    // run are skipped unless the cache is disabled
+    std::optional<TaskCache> cache;
+    if (useCache) {
+        cache.emplace(absPath("${CACHE}/tasks.json"));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<TaskScheduler::Result> results = scheduler->perform(
+        nThreads,
+        memoryLimit,
+        onProgress,
+        cache.has_value() ? &*cache : nullptr
+    );
+    const std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - start;
+    progressBar = nullptr;
+    if (cache.has_value()) {
+        cache->save();
+    }
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const TaskScheduler::Result& r = results[i];
+        switch (r.status) {
+            case TaskScheduler::Result::Status::Succeeded:
+                LINFO(fmt::format(
+                    "Task {} succeeded in {:.2f} s: {}",
+                    i + 1, r.duration.count(), r.description
+                ));
+                break;
+            case TaskScheduler::Result::Status::UpToDate:
+                LINFO(fmt::format("Task {} was up to date: {}", i + 1, r.description));
+                break;
+            case TaskScheduler::Result::Status::Failed:
+                LERROR(fmt::format(
+                    "Task {} failed after {:.2f} s: {}",
+                    i + 1, r.duration.count(), r.description
+                ));
+                break;
+            case TaskScheduler::Result::Status::Skipped:
+                LWARNING(fmt::format("Task {} was skipped: {}", i + 1, r.description));
+                break;
+        }
+    }
+    std::cout << fmt::format("Done performing tasks in {:.2f} s", duration.count())
+              << std::endl;
 }
 
 int main(int argc, char** argv) {
@@ -150,13 +224,48 @@ int main(int argc, char** argv) {
         )
     );
 
+    int nThreads = 1;
+    commandlineParser.addCommand(
+        std::make_unique<ghoul::cmdparser::SingleCommand<int>>(
+            nThreads,
+            "--jobs",
+            "-j",
+            "The number of threads that tasks without a dependency between them can use "
+            "to run concurrently. The default is 1, which performs one task at a time"
+        )
+    );
+
+    int memoryLimit = 0;
+    commandlineParser.addCommand(
+        std::make_unique<ghoul::cmdparser::SingleCommand<int>>(
+            memoryLimit,
+            "--memory",
+            "-m",
+            "The amount of memory in megabytes that concurrently running tasks can use "
+            "based on their estimates. The default is 0, which means no limit"
+        )
+    );
+
+    bool force = false;
+    commandlineParser.addCommand(
+        std::make_unique<ghoul::cmdparser::SingleCommandZeroArguments>(
+            force,
+            "--force",
+            "-f",
+            "Performs all tasks, even those whose inputs have not changed since they "
+            "were last performed successfully"
+        )
+    );
+
     commandlineParser.setCommandLine({ argv, argv + argc });
     commandlineParser.execute();
+    nThreads = std::max(nThreads, 1);
+    memoryLimit = std::max(memoryLimit, 0);
 
     //FileSys.setCurrentDirectory(launchDirectory);
 
     if (!tasksPath.empty()) {
-        performTasks(tasksPath);
+        performTasks(tasksPath, nThreads, memoryLimit, !force);
         return 0;
     }
 
@@ -167,7 +276,7 @@ int main(int argc, char** argv) {
 
     std::cout << "TASK > ";
     while (std::cin >> tasksPath) {
-        performTasks(tasksPath);
+        performTasks(tasksPath, nThreads, memoryLimit, !force);
         std::cout << "TASK > ";
     }
 
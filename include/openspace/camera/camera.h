@@ -104,6 +104,14 @@ public:
     // of the old calls to the function wrong..
     const glm::dmat4& combinedViewMatrix() const;
 
+    /**
+     * Returns the #combinedViewMatrix without the translation by the camera position.
+     * Applying this matrix to positions relative to the camera, rather than the combined
+     * view matrix to world positions, avoids the loss of precision that comes with
+     * subtracting two large translations after they have been rotated.
+     */
+    glm::dmat4 cameraRelativeViewMatrix() const;
+
     void invalidateCache();
 
     void serialize(std::ostream& os) const;
@@ -28,6 +28,7 @@
 #include <ghoul/misc/boolean.h>
 #include <ghoul/misc/exception.h>
 #include <ghoul/misc/stringconversion.h>
+#include <filesystem>
 #include <memory>
 #include <string>
 #include <vector>
@@ -303,6 +304,28 @@ TestResult testSpecification(const Documentation& documentation,
 void testSpecificationAndThrow(const Documentation& documentation,
     const ghoul::Dictionary& dictionary, std::string component);
 
+/**
+ * Loads the fingerprints of documentation and dictionary pairs that have passed the
+ * #testSpecificationAndThrow function in a previous run from the file at \p path. These
+ * pairs are not tested again, which means that unchanged assets skip their verification.
+ * Only Documentation%s with an identifier are cached and the fingerprint includes the
+ * Documentation's entries, so a changed specification invalidates the cached results.
+ * If the file does not exist or is from an incompatible version, nothing is loaded.
+ *
+ * \param path The path to the file that was previously written by
+ *        #saveVerificationCache
+ */
+void loadVerificationCache(const std::filesystem::path& path);
+
+/**
+ * Writes the fingerprints of all documentation and dictionary pairs that have passed the
+ * #testSpecificationAndThrow function or were skipped because of a cached result in this
+ * run to the file at \p path.
+ *
+ * \param path The path to the file that is written
+ */
+void saveVerificationCache(const std::filesystem::path& path);
+
 } // namespace openspace::documentation
 
 // Make the overload for std::to_string available for the Offense::Reason for easier
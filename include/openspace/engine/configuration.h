@@ -84,6 +84,10 @@ struct Configuration {
 
     std::string versionCheckUrl;
     bool useMultithreadedInitialization = false;
+    bool useLazyRenderableInitialization = false;
+
+    bool useDeltaSyncEncoding = false;
+    int syncKeyframeInterval = 60;
 
     struct LoadingScreen {
         bool isShowingMessages = true;
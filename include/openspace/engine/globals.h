@@ -37,6 +37,7 @@ class Dashboard;
 class DeferredcasterManager;
 class DownloadManager;
 class EventEngine;
+class FrameProfiler;
 class LuaConsole;
 class MemoryManager;
 class MissionManager;
@@ -46,6 +47,7 @@ class ParallelPeer;
 class RaycasterManager;
 class RenderEngine;
 class ScreenSpaceRenderable;
+class StartupProfiler;
 class SyncEngine;
 class TimeManager;
 class VersionChecker;
@@ -75,6 +77,7 @@ inline Dashboard* dashboard;
 inline DeferredcasterManager* deferredcasterManager;
 inline DownloadManager* downloadManager;
 inline EventEngine* eventEngine;
+inline FrameProfiler* frameProfiler;
 inline LuaConsole* luaConsole;
 inline MemoryManager* memoryManager;
 inline MissionManager* missionManager;
@@ -84,6 +87,7 @@ inline ParallelPeer* parallelPeer;
 inline RaycasterManager* raycasterManager;
 inline RenderEngine* renderEngine;
 inline std::vector<std::unique_ptr<ScreenSpaceRenderable>>* screenSpaceRenderables;
+inline StartupProfiler* startupProfiler;
 inline SyncEngine* syncEngine;
 inline TimeManager* timeManager;
 inline VersionChecker* versionChecker;
@@ -42,6 +42,8 @@ namespace documentation { struct Documentation; }
  * respectively with both also require the `FileName` value for the location at which the
  * logfile should be created. Both logs can be customized using the `Append`,
  * `TimeStamping`, `DateStamping`, `CategoryStamping`, and `LogLevelStamping` values.
+ * The created log is wrapped in a ThreadedLog, so that the messages are written to the
+ * file on a separate thread.
  *
  * \param  dictionary The dictionary from which the ghoul::logging::Log should be created
  * \return The created ghoul::logging::Log
@@ -33,6 +33,7 @@
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/scene/profile.h>
+#include <openspace/util/framebudget.h>
 #include <openspace/util/keys.h>
 #include <openspace/util/mouse.h>
 #include <openspace/util/touch.h>
@@ -40,6 +41,7 @@
 #include <ghoul/glm.h>
 #include <future>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -48,6 +50,7 @@ namespace openspace {
 class AssetManager;
 class LoadingScreen;
 class Scene;
+class ThreadPool;
 
 namespace scripting { struct LuaLibrary; }
 
@@ -66,6 +69,9 @@ struct ShutdownInformation {
 struct CommandlineArguments {
     std::string configurationName;
     std::vector<std::string> configurationOverride;
+    std::string benchmarkRecording;
+    std::string benchmarkReport;
+    int benchmarkFps = 60;
 };
 
 class OpenSpaceEngine : public properties::PropertyOwner {
@@ -107,8 +113,8 @@ public:
     void touchUpdateCallback(TouchInput input);
     void touchExitCallback(TouchInput input);
     void handleDragDrop(std::filesystem::path file);
-    std::vector<std::byte> encode();
-    void decode(std::vector<std::byte> data);
+    std::span<const std::byte> encode();
+    void decode(std::span<const std::byte> data);
 
     properties::Property::Visibility visibility() const;
     bool showHiddenSceneGraphNodes() const;
@@ -128,6 +134,20 @@ public:
     AssetManager& assetManager();
     LoadingScreen* loadingScreen();
 
+    /**
+     * Returns the budget that work which can be deferred to later frames has to stay
+     * within. The frame begins at the start of #preSynchronization.
+     */
+    const FrameBudget& frameBudget() const;
+
+    /**
+     * Returns the pool of worker threads that is shared by all work that is distributed
+     * across the available cores, for example with ThreadPool::parallelFor. The calling
+     * thread takes part in that work, so the pool has one worker fewer than there are
+     * hardware threads.
+     */
+    ThreadPool& threadPool();
+
     void writeDocumentation();
     void createUserDirectoriesIfNecessary();
 
@@ -149,6 +169,11 @@ private:
     properties::BoolProperty _showHiddenSceneGraphNodes;
     properties::FloatProperty _fadeOnEnableDuration;
     properties::BoolProperty _disableAllMouseInputs;
+    properties::FloatProperty _frameBudgetTime;
+    properties::BoolProperty _deferRenderableUpdates;
+
+    FrameBudget _frameBudget;
+    std::unique_ptr<ThreadPool> _threadPool;
 
     std::unique_ptr<Scene> _scene;
     std::unique_ptr<AssetManager> _assetManager;
@@ -28,7 +28,9 @@
 #include <openspace/util/syncbuffer.h>
 
 #include <ghoul/misc/boolean.h>
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace openspace {
@@ -50,16 +52,20 @@ public:
     SyncEngine(unsigned int syncBufferSize);
 
     /**
-     * Encodes all added Syncables in the injected `SyncBuffer`.
-     * This method is only called on the SGCT master node
+     * Encodes all added Syncables in the injected `SyncBuffer`. If delta encoding is
+     * enabled, only the Syncables that report a change are encoded, except for every
+     * keyframe in which all Syncables are encoded.
+     * This method is only called on the SGCT master node. The returned data stays valid
+     * until the next call to this function has completed.
      */
-    std::vector<std::byte> encodeSyncables();
+    std::span<const std::byte> encodeSyncables();
 
     /**
-     * Decodes the `SyncBuffer` into the added Syncables.
+     * Decodes the \p data into the added Syncables. The data is read in place and is not
+     * copied.
      * This method is only called on the SGCT client nodes
      */
-    void decodeSyncables(std::vector<std::byte> data);
+    void decodeSyncables(std::span<const std::byte> data);
 
     /**
      * Invokes the presync method of all added Syncables
@@ -93,7 +99,32 @@ public:
     */
     void removeSyncables(const std::vector<Syncable*>& syncables);
 
+    /**
+     * Enables or disables the delta encoding of frames. With delta encoding enabled,
+     * only the Syncables whose Syncable::hasChanged function returns `true` are sent to
+     * the clients. In order for clients that join late to catch up, every
+     * \p keyframeInterval frames all Syncables are encoded regardless of their state.
+     *
+     * \param enabled Whether the delta encoding should be used
+     * \param keyframeInterval The number of frames between two full frames
+     *
+     * \pre keyframeInterval must be bigger than 0
+     */
+    void setDeltaEncoding(bool enabled, int keyframeInterval);
+
 private:
+    enum class FrameType : uint8_t {
+        Full = 0,
+        Delta = 1
+    };
+
+    bool _useDeltaEncoding = false;
+    int _keyframeInterval = 60;
+    int _framesSinceKeyframe = 0;
+
+    /// Reusable storage for the bit mask of changed Syncables in delta frames
+    std::vector<uint8_t> _changedMask;
+
     /**
      * Vector of Syncables. The vectors ensures consistent encode/decode order
      */
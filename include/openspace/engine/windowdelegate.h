@@ -27,6 +27,7 @@
 
 #include <ghoul/glm.h>
 #include <glbinding/glbinding.h>
+#include <optional>
 #include <vector>
 
 namespace openspace {
@@ -124,6 +125,9 @@ struct WindowDelegate {
 
     glm::vec2 (*mousePositionViewportRelative)(glm::vec2 mousePosition) =
         [](glm::vec2) { return glm::vec2(0); };
+
+    std::optional<glm::vec3> (*gazeDirection)() =
+        []() -> std::optional<glm::vec3> { return std::nullopt; };
 };
 
 } // namespace openspace
@@ -28,6 +28,7 @@
 #include <openspace/events/event.h>
 #include <openspace/scripting/lualibrary.h>
 #include <ghoul/misc/memorypool.h>
+#include <functional>
 #include <unordered_map>
 
 namespace openspace {
@@ -44,6 +45,9 @@ public:
         std::optional<ghoul::Dictionary> filter;
     };
 
+    /// A native callback that is invoked for each event of the type it is registered for
+    using EventCallback = std::function<void(const events::Event&)>;
+
     /**
      * This function returns the first event stored in the EventEngine, or `nullptr` if
      * no event exists. To navigate the full list of events, you can access the returned
@@ -105,6 +109,26 @@ public:
      */
     void unregisterEventAction(uint32_t identifier);
 
+    /**
+     * Registers a native \p callback that is invoked for every event of the provided
+     * \p type when the events of a frame are dispatched in #triggerActions. Unlike event
+     * actions, no parameter Dictionary is created for the event and the callback does its
+     * own filtering on the concrete event type. The callback must not register or
+     * unregister callbacks itself.
+     *
+     * \param type The type of events for which the \p callback is invoked
+     * \param callback The function that is called with each event of the \p type
+     * \return An identifier that can be used to unregister the callback again
+     */
+    uint32_t registerEventCallback(events::Event::Type type, EventCallback callback);
+
+    /**
+     * Removes the native callback that was registered with the \p identifier.
+     *
+     * \param identifier The identifier returned by #registerEventCallback
+     */
+    void unregisterEventCallback(uint32_t identifier);
+
     /**
      * Returns the list of all registered actions, sorted by their identifiers.
      *
@@ -129,8 +153,8 @@ public:
     void disableEvent(uint32_t identifier);
 
     /**
-     * Triggers all actions that are registered for events that are in the current event
-     * queue
+     * Triggers all actions and native callbacks that are registered for events that are
+     * in the current event queue. The queue is traversed only once for both
      */
     void triggerActions() const;
 
@@ -150,7 +174,13 @@ private:
     // the lookup really fast. So having this extra wasted memory is probably worth it
     std::unordered_map<events::Event::Type, std::vector<ActionInfo>> _eventActions;
 
+    /// The native callbacks together with the identifiers they were registered with
+    std::unordered_map<
+        events::Event::Type, std::vector<std::pair<uint32_t, EventCallback>>
+    > _eventCallbacks;
+
     static uint32_t nextRegisteredEventId;
+    static uint32_t nextRegisteredCallbackId;
 
 #ifdef _DEBUG
     /// Stores the total number of events during this frame for debugging purposes
@@ -23,6 +23,7 @@
  ****************************************************************************************/
 
 #include <type_traits>
+#include <utility>
 
 namespace openspace {
 
@@ -33,7 +34,7 @@ void EventEngine::publishEvent(Args&&... args) {
         "T must be a subclass of Event"
     );
 
-    T* e = _memory.alloc<T>(args...);
+    T* e = _memory.alloc<T>(std::forward<Args>(args)...);
     if (!_firstEvent) {
         _firstEvent = e;
         _lastEvent = e;
@@ -30,8 +30,10 @@
 #include <openspace/navigation/keyframenavigator.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/scripting/lualibrary.h>
+#include <openspace/util/memorymappedfile.h>
 #include <vector>
 #include <chrono>
+#include <thread>
 
 namespace openspace::interaction {
 
@@ -50,6 +52,7 @@ public:
     inline static const char HeaderCameraBinary = 'c';
     inline static const char HeaderTimeBinary = 't';
     inline static const char HeaderScriptBinary = 's';
+    inline static const char HeaderIndexBinary = 'i';
     inline static const std::string FileExtensionBinary = ".osrec";
     inline static const std::string FileExtensionAscii = ".osrectxt";
 
@@ -85,8 +88,11 @@ public:
     };
 
     static const size_t FileHeaderVersionLength = 5;
-    char FileHeaderVersion[FileHeaderVersionLength+1] = "01.00";
-    char TargetConvertVersion[FileHeaderVersionLength+1] = "01.00";
+    char FileHeaderVersion[FileHeaderVersionLength+1] = "01.01";
+    char TargetConvertVersion[FileHeaderVersionLength+1] = "01.01";
+    // The first file format version whose binary files end with a keyframe index
+    inline static const std::string IndexedFileFormatVersion = "01.01";
+    inline static const std::string IndexMagic = "OSRECIDX";
     static const char DataFormatAsciiTag = 'A';
     static const char DataFormatBinaryTag = 'B';
     static const size_t keyframeHeaderSize_bytes = 33;
@@ -241,6 +247,14 @@ public:
      */
     void enableTakeScreenShotDuringPlayback(int fps);
 
+    /**
+     * Enables that the playback advances with a fixed time step per rendered frame, as
+     * it does with enableTakeScreenShotDuringPlayback(), but without saving the frames.
+     * This is used to get reproducible frames when benchmarking a recording
+     * \param fps Number of frames per second.
+     */
+    void enableFixedStepPlayback(int fps);
+
     /**
      * Used to disable that renderings are saved during playback
      */
@@ -635,6 +649,51 @@ protected:
     bool playbackTimeChange();
     bool playbackScript();
     bool playbackAddEntriesToTimeline();
+
+    /// All data of a stopped recording that is needed to write it to disk
+    struct RecordingJob {
+        std::string filename;
+        DataMode mode = DataMode::Binary;
+        Timestamps timestampsStarted = { 0.0, 0.0, 0.0 };
+        std::vector<TimelineEntry> timeline;
+        std::vector<interaction::KeyframeNavigator::CameraPose> keyframesCamera;
+        std::vector<datamessagestructures::TimeKeyframe> keyframesTime;
+        std::vector<std::string> keyframesScript;
+        std::vector<std::string> baselineScripts;
+        std::vector<TimelineEntry> baselineTimeline;
+    };
+
+    /**
+     * Formats and appends all keyframes of \p job to its recording file, which already
+     * contains the header. This is run on #_recordWriterThread after a recording has
+     * been stopped. The file is synced to disk only once it is complete.
+     */
+    void writeRecording(RecordingJob job);
+
+    /// Blocks until a previous recording has been completely written to disk
+    void waitForRecordingWriter();
+
+    /**
+     * Appends a keyframe index to the end of the binary recording \p filename. The
+     * index stores the type, timestamps, and file offset of every keyframe so that
+     * playback can build its timeline without decoding the keyframes themselves.
+     *
+     * \param filename the binary recording file that has been written and closed
+     * \return true if the index was written successfully
+     */
+    bool appendPlaybackIndex(const std::string& filename);
+
+    /**
+     * Memory-maps the current playback file and builds the timeline from its keyframe
+     * index. Camera keyframes are decoded on demand from the mapping through
+     * #cameraKeyframe, while time and script keyframes are decoded immediately.
+     *
+     * \return true if the file contained a valid index and the timeline was built
+     */
+    bool playbackAddEntriesFromIndex();
+    void unmapPlaybackFile();
+    interaction::KeyframeNavigator::CameraPose cameraKeyframe(unsigned int index) const;
+    size_t nCameraKeyframes() const;
     void signalPlaybackFinishedForComponent(RecordedType type);
     void handlePlaybackEnd();
 
@@ -696,16 +755,16 @@ protected:
     void cleanUpPlayback();
     void cleanUpRecording();
     void cleanUpTimelinesAndKeyframes();
-    bool convertEntries(std::string& inFilename, std::stringstream& inStream,
+    bool convertEntries(std::string& inFilename, std::ifstream& inStream,
         DataMode mode, int lineNum, std::ofstream& outFile);
-    virtual bool convertCamera(std::stringstream& inStream, DataMode mode, int lineNum,
+    virtual bool convertCamera(std::ifstream& inStream, DataMode mode, int lineNum,
         std::string& inputLine, std::ofstream& outFile, unsigned char* buff);
-    virtual bool convertTimeChange(std::stringstream& inStream, DataMode mode,
+    virtual bool convertTimeChange(std::ifstream& inStream, DataMode mode,
         int lineNum, std::string& inputLine, std::ofstream& outFile, unsigned char* buff);
-    virtual bool convertScript(std::stringstream& inStream, DataMode mode, int lineNum,
+    virtual bool convertScript(std::ifstream& inStream, DataMode mode, int lineNum,
         std::string& inputLine, std::ofstream& outFile, unsigned char* buff);
     DataMode readModeFromHeader(std::string filename);
-    void readPlaybackHeader_stream(std::stringstream& conversionInStream,
+    void readPlaybackHeader_stream(std::ifstream& conversionInStream,
         std::string& version, DataMode& mode);
     void populateListofLoadedSceneGraphNodes();
 
@@ -722,8 +781,7 @@ protected:
     static void writeToFileBuffer(unsigned char* buf, size_t& idx, std::vector<char>& cv);
     static void writeToFileBuffer(unsigned char* buf, size_t& idx, unsigned char c);
     static void writeToFileBuffer(unsigned char* buf, size_t& idx, bool b);
-    void readFileIntoStringStream(std::string filename,
-        std::ifstream& inputFstream, std::stringstream& stream);
+    void openFileForConversion(std::string filename, std::ifstream& inputFstream);
 
     DataMode _recordingDataMode = DataMode::Binary;
     SessionState _state = SessionState::Idle;
@@ -732,6 +790,8 @@ protected:
     std::ifstream _playbackFile;
     std::string _playbackLineParsing;
     std::ofstream _recordFile;
+    std::string _recordFilename;
+    std::thread _recordWriterThread;
     int _playbackLineNum = 1;
     int _recordingEntryNum = 1;
     KeyframeTimeRef _playbackTimeReferenceMode;
@@ -747,6 +807,7 @@ protected:
     double _previousTime = 0.0;
 
     bool _saveRenderingDuringPlayback = false;
+    bool _saveRenderingTakeScreenshots = true;
     double _saveRenderingDeltaTime = 1.0 / 30.0;
     double _saveRenderingCurrentRecordedTime = 0.0;
     bool _shouldWaitForFinishLoadingWhenPlayback = false;
@@ -767,6 +828,13 @@ protected:
     std::vector<std::string> _keyframesScript;
     std::vector<TimelineEntry> _timeline;
 
+    // Only used when playing back an indexed binary recording; the camera keyframes are
+    // then read from the mapped file instead of being stored in _keyframesCamera
+    MemoryMappedFile _playbackFile;
+    const char* _playbackMapping = nullptr;
+    size_t _playbackIndexOffset = 0;
+    std::vector<uint64_t> _cameraKeyframeOffsets;
+
     std::vector<std::string> _keyframesSavePropertiesBaseline_scripts;
     std::vector<TimelineEntry> _keyframesSavePropertiesBaseline_timeline;
     std::vector<std::string> _propertyBaselinesSaved;
@@ -848,6 +916,21 @@ protected:
 //    (for example SessionRecording_legacy_0085::convertScript uses its own
 //    override of script keyframe for the conversion functionality).
 
+class SessionRecording_legacy_0100 : public SessionRecording {
+public:
+    SessionRecording_legacy_0100() : SessionRecording() {}
+    ~SessionRecording_legacy_0100() override {}
+    char FileHeaderVersion[FileHeaderVersionLength+1] = "01.00";
+    char TargetConvertVersion[FileHeaderVersionLength+1] = "01.01";
+    std::string fileFormatVersion() override {
+        return std::string(FileHeaderVersion);
+    }
+    std::string targetFileFormatVersion() override {
+        return std::string(TargetConvertVersion);
+    }
+    std::string getLegacyConversionResult(std::string filename, int depth) override;
+};
+
 class SessionRecording_legacy_0085 : public SessionRecording {
 public:
     SessionRecording_legacy_0085() : SessionRecording() {}
@@ -881,7 +964,7 @@ public:
     };
 
 protected:
-    bool convertScript(std::stringstream& inStream, DataMode mode, int lineNum,
+    bool convertScript(std::ifstream& inStream, DataMode mode, int lineNum,
         std::string& inputLine, std::ofstream& outFile, unsigned char* buffer) override;
 };
 
@@ -31,6 +31,7 @@
 #include <ghoul/glm.h>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 namespace openspace::interaction {
 
@@ -42,11 +43,20 @@ public:
     void perform(const Task::ProgressCallback& progressCallback) override;
     static documentation::Documentation documentation();
     void convert();
-    SessionRecording* sessRec;
+    SessionRecording* sessRec = nullptr;
 
 private:
+    /**
+     * Converts all files in #_directoryFiles using #_nThreads threads, each of which
+     * uses its own SessionRecording instance.
+     */
+    void convertDirectory(const Task::ProgressCallback& progressCallback);
+
     std::string _inFilename;
     std::filesystem::path _inFilePath;
+    std::filesystem::path _inDirectory;
+    std::vector<std::filesystem::path> _directoryFiles;
+    unsigned int _nThreads = 1;
     std::string _valueFunctionLua;
 };
 
@@ -30,6 +30,8 @@
 #include <ghoul/glm.h>
 #include <ghoul/misc/boolean.h>
 #include <glm/gtx/quaternion.hpp>
+#include <array>
+#include <optional>
 
 namespace openspace {
     class Camera;
@@ -63,6 +65,9 @@ public:
     * Update camera position using the next camera pose keyframe from the timeline.
     * Returns true if camera was set to a pose from the next keyframe.
     * Returns false if no keyframes are available after the current time.
+    * The position is interpolated with a cubic Hermite spline through the neighboring
+    * keyframes. If the next keyframe has not arrived yet, the motion between the last
+    * two keyframes is extrapolated for at most one keyframe interval.
     * \param camera A reference to the camera object to have its pose updated.
     * \param ignoreFutureKeyframes true if only past keyframes are to be used.
     * \returns true only if a new future keyframe is available to set camera pose.
@@ -80,6 +85,19 @@ public:
     void setTimeReferenceMode(KeyframeTimeRef refType, double referenceTimestamp);
 
 private:
+    using Tangents = std::array<glm::dvec3, 2>;
+
+    /**
+     * Sets the camera to the pose at \p t between \p prevPose and \p nextPose. If
+     * \p tangents are provided and both poses use the same focus node and rotation
+     * mode, the position follows a cubic Hermite curve with these tangents (in the
+     * frame of the poses), otherwise it is interpolated linearly. \p t is clamped to
+     * [0, \p maxT]; values above 1 extrapolate beyond \p nextPose.
+     */
+    static bool applyPose(Camera* camera, const CameraPose& prevPose,
+        const CameraPose& nextPose, double t, bool ignoreFutureKeyframes,
+        const std::optional<Tangents>& tangents, double maxT);
+
     Timeline<CameraPose> _cameraPoseTimeline;
     KeyframeTimeRef _timeframeMode = KeyframeTimeRef::Relative_applicationStart;
     double _referenceTimestamp = 0.0;
@@ -62,6 +62,11 @@ public:
      */
     double pathLength() const;
 
+    /**
+     * Return the distance that has been traveled along the path so far, in meters
+     */
+    double traveledDistance() const;
+
     /**
      * Return a vector of positions corresponding to the control points of the path's
      * spline curve
@@ -84,7 +84,8 @@ protected:
     void initializeParameterData();
 
     /**
-     * Compute curve parameter u that matches the input arc length s.
+     * Compute curve parameter u that matches the input arc length s, in constant time
+     * from the samples precomputed in initializeParameterData.
      * Input s is a length value in meters, in the range [0, _totalLength].
      * The returned curve parameter u is in range [0, 1].
      */
@@ -104,9 +105,14 @@ protected:
     struct ParameterPair {
         double u; // curve parameter
         double s; // arc length parameter
+        double dudS = 0.0; // derivative of the curve parameter with respect to s
     };
 
     std::vector<ParameterPair> _parameterSamples;
+
+    // For evenly spaced arc lengths, the index of the last sample at or before them
+    std::vector<size_t> _sampleLookup;
+    double _lookupStep = 0.0; // meters
 };
 
 class LinearCurve : public PathCurve {
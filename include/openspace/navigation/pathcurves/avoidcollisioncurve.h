@@ -27,6 +27,8 @@
 
 #include <openspace/navigation/pathcurve.h>
 
+#include <vector>
+
 namespace openspace { class SceneGraphNode; }
 
 namespace openspace::interaction {
@@ -38,9 +40,43 @@ public:
     AvoidCollisionCurve(const Waypoint& start, const Waypoint& end);
 
 private:
+    struct Obstacle {
+        SceneGraphNode* node = nullptr;
+        glm::dmat4 modelTransform = glm::dmat4(1.0);
+        glm::dmat4 inverseModelTransform = glm::dmat4(1.0);
+        /// The radius of the collision sphere in model coordinates, without the buffer
+        double radius = 0.0;
+        /// The world space bounding sphere that includes the buffer
+        glm::dvec3 center = glm::dvec3(0.0);
+        double worldRadius = 0.0;
+    };
+
+    /// A node in the bounding sphere hierarchy over the obstacles
+    struct HierarchyNode {
+        glm::dvec3 center = glm::dvec3(0.0);
+        double radius = 0.0;
+        /// Index of the second child; the first child directly follows the node
+        int secondChild = -1;
+        /// The range in _obstacleOrder covered by a leaf
+        int first = 0;
+        int count = 0;
+    };
+
+    void buildObstacleHierarchy();
+    int buildHierarchyNode(int first, int count);
+
+    /**
+     * Returns the indices of the obstacles, in the order of the relevant nodes, whose
+     * buffered bounding sphere intersects the line segment between \p p1 and \p p2.
+     */
+    std::vector<int> potentialObstacles(const glm::dvec3& p1, const glm::dvec3& p2) const;
+
     void removeCollisions(int step = 0);
 
-    std::vector<SceneGraphNode*> _relevantNodes;
+    std::vector<Obstacle> _obstacles;
+    /// The indices into _obstacles, ordered so that every leaf covers a continuous range
+    std::vector<int> _obstacleOrder;
+    std::vector<HierarchyNode> _obstacleHierarchy;
 };
 
 } // namespace openspace::interaction
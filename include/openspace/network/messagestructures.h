@@ -29,6 +29,7 @@
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <fstream>
 #include <iomanip>
@@ -41,7 +42,8 @@ namespace openspace::datamessagestructures {
 enum class Type : uint32_t {
     CameraData = 0,
     TimelineData,
-    ScriptData
+    ScriptData,
+    CameraDataCompact
 };
 
 struct CameraKeyframe {
@@ -253,6 +255,164 @@ struct CameraKeyframe {
     }
 };
 
+/**
+ * Encodes a stream of camera keyframes compactly by sending most of them as deltas to the
+ * previous keyframe of the stream. A full keyframe contains the complete CameraKeyframe
+ * and is sent whenever the focus node or the rotation-following mode changes, every
+ * FullKeyframeInterval keyframes, or when requested. All other keyframes only contain
+ * the position and timestamp changes as floats, the rotation as three quantized
+ * components, and the scale.
+ *
+ * The encoder stores the keyframe as the decoder reconstructs it, so the quantization
+ * errors are corrected by the following delta instead of accumulating. Keyframes are
+ * delivered in order over the connection, so the last keyframe that was sent is also
+ * the one the receiver has.
+ */
+struct CameraKeyframeCodec {
+    static constexpr uint8_t FlagFull = 1;
+    static constexpr int FullKeyframeInterval = 20;
+    // A delta keyframe: flags, position, rotation, scale, and timestamp
+    static constexpr size_t DeltaSize = sizeof(uint8_t) + 3 * sizeof(float) +
+        sizeof(uint8_t) + 3 * sizeof(int16_t) + sizeof(float) + sizeof(float);
+
+    void encode(const CameraKeyframe& kf, bool forceFull, std::vector<char>& buffer) {
+        const bool isFull = forceFull || !hasReference ||
+            kf._focusNode != reference._focusNode ||
+            kf._followNodeRotation != reference._followNodeRotation ||
+            nDeltas >= FullKeyframeInterval;
+
+        if (isFull) {
+            buffer.push_back(static_cast<char>(FlagFull));
+            kf.serialize(buffer);
+            reference = kf;
+            hasReference = true;
+            nDeltas = 0;
+            return;
+        }
+
+        const size_t start = buffer.size();
+        buffer.resize(start + DeltaSize);
+        char* p = buffer.data() + start;
+        *p = 0;
+        p += sizeof(uint8_t);
+
+        const glm::vec3 dPos = glm::vec3(kf._position - reference._position);
+        std::memcpy(p, glm::value_ptr(dPos), sizeof(dPos));
+        p += sizeof(dPos);
+        reference._position += glm::dvec3(dPos);
+
+        p = packRotation(kf._rotation, p);
+        reference._rotation = unpackRotation(p - 1 - 3 * sizeof(int16_t));
+
+        std::memcpy(p, &kf._scale, sizeof(float));
+        p += sizeof(float);
+        reference._scale = kf._scale;
+
+        const float dt = static_cast<float>(kf._timestamp - reference._timestamp);
+        std::memcpy(p, &dt, sizeof(float));
+        reference._timestamp += static_cast<double>(dt);
+        nDeltas++;
+    }
+
+    /**
+     * Decodes the keyframe in \p buffer into \p kf. Returns \c false if the buffer is
+     * malformed or if it contains a delta keyframe but no full keyframe has been
+     * received yet, which happens when joining a session in progress.
+     */
+    bool decode(const std::vector<char>& buffer, CameraKeyframe& kf) {
+        if (buffer.empty()) {
+            return false;
+        }
+        const uint8_t flags = static_cast<uint8_t>(buffer[0]);
+        if (flags & FlagFull) {
+            const std::vector<char> body(buffer.begin() + 1, buffer.end());
+            reference.deserialize(body);
+            hasReference = true;
+            kf = reference;
+            return true;
+        }
+        if (!hasReference || buffer.size() < DeltaSize) {
+            return false;
+        }
+
+        const char* p = buffer.data() + sizeof(uint8_t);
+        glm::vec3 dPos;
+        std::memcpy(glm::value_ptr(dPos), p, sizeof(dPos));
+        p += sizeof(dPos);
+        reference._position += glm::dvec3(dPos);
+
+        reference._rotation = unpackRotation(p);
+        p += sizeof(uint8_t) + 3 * sizeof(int16_t);
+
+        std::memcpy(&reference._scale, p, sizeof(float));
+        p += sizeof(float);
+
+        float dt;
+        std::memcpy(&dt, p, sizeof(float));
+        reference._timestamp += static_cast<double>(dt);
+
+        kf = reference;
+        return true;
+    }
+
+    void reset() {
+        hasReference = false;
+        nDeltas = 0;
+    }
+
+private:
+    static constexpr double Sqrt2 = 1.4142135623730951;
+
+    // Stores the index of the largest component and the other three components
+    // quantized to 16 bits. The largest component is recovered from the unit length
+    static char* packRotation(glm::dquat q, char* p) {
+        uint8_t largest = 0;
+        for (uint8_t i = 1; i < 4; i++) {
+            if (std::abs(q[i]) > std::abs(q[largest])) {
+                largest = i;
+            }
+        }
+        if (q[largest] < 0.0) {
+            q = -q;
+        }
+        *p = static_cast<char>(largest);
+        p += sizeof(uint8_t);
+        for (uint8_t i = 0; i < 4; i++) {
+            if (i == largest) {
+                continue;
+            }
+            const double v = std::clamp(q[i] * Sqrt2, -1.0, 1.0);
+            const int16_t c = static_cast<int16_t>(std::round(v * 32767.0));
+            std::memcpy(p, &c, sizeof(int16_t));
+            p += sizeof(int16_t);
+        }
+        return p;
+    }
+
+    static glm::dquat unpackRotation(const char* p) {
+        const uint8_t largest = static_cast<uint8_t>(*p) % 4;
+        p += sizeof(uint8_t);
+        glm::dquat q;
+        double sum = 0.0;
+        for (uint8_t i = 0; i < 4; i++) {
+            if (i == largest) {
+                continue;
+            }
+            int16_t c;
+            std::memcpy(&c, p, sizeof(int16_t));
+            p += sizeof(int16_t);
+            q[i] = c / 32767.0 / Sqrt2;
+            sum += q[i] * q[i];
+        }
+        q[largest] = std::sqrt(std::max(1.0 - sum, 0.0));
+        return glm::normalize(q);
+    }
+
+    CameraKeyframe reference;
+    bool hasReference = false;
+    int nDeltas = 0;
+};
+
 struct TimeKeyframe {
     TimeKeyframe() = default;
     TimeKeyframe(const std::vector<char>& buffer) {
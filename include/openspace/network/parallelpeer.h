@@ -29,8 +29,10 @@
 
 #include <openspace/network/messagestructures.h>
 #include <openspace/network/parallelconnection.h>
+#include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/stringproperty.h>
+#include <openspace/util/boundedconcurrentqueue.h>
 #include <openspace/util/timemanager.h>
 #include <ghoul/designpattern/event.h>
 #include <atomic>
@@ -94,6 +96,7 @@ private:
 
     double convertTimestamp(double messageTimestamp);
     void analyzeTimeDifference(double messageTimestamp);
+    void updatePlayoutDelay(double now);
 
     properties::StringProperty _password;
     properties::StringProperty _hostPassword;
@@ -104,12 +107,19 @@ private:
     properties::StringProperty _address;
     properties::StringProperty _name;
     properties::FloatProperty _bufferTime;
+    properties::BoolProperty _adaptiveBufferTime;
     properties::FloatProperty _timeKeyframeInterval;
     properties::FloatProperty _cameraKeyframeInterval;
+    properties::BoolProperty _compactCameraKeyframes;
 
     double _lastTimeKeyframeTimestamp = 0.0;
     double _lastCameraKeyframeTimestamp = 0.0;
 
+    datamessagestructures::CameraKeyframeCodec _cameraKeyframeEncoder;
+    datamessagestructures::CameraKeyframeCodec _cameraKeyframeDecoder;
+    // Set when a client might have missed the previous full camera keyframe
+    bool _forceFullCameraKeyframe = true;
+
     std::atomic_bool _shouldDisconnect = false;
 
     std::atomic<size_t> _nConnections = 0;
@@ -118,14 +128,20 @@ private:
 
     std::string _hostName;
 
-    std::deque<ParallelConnection::Message> _receiveBuffer;
-    std::mutex _receiveBufferMutex;
+    BoundedConcurrentQueue<ParallelConnection::Message> _receiveBuffer;
 
     std::atomic<bool> _timeJumped;
     std::atomic<bool> _timeTimelineChanged;
     std::mutex _latencyMutex;
     std::deque<double> _latencyDiffs;
     double _initialTimeDiff = 0.0;
+    // The adaptive playout delay, which follows _targetPlayoutDelay at a limited rate
+    double _playoutDelay = 0.2;
+    double _targetPlayoutDelay = 0.2;
+    double _lastPlayoutDelayUpdate = 0.0;
+    // Smoothed interval between the received camera keyframes
+    double _cameraKeyframeSpacing = 0.0;
+    double _lastReceivedCameraTimestamp = -1.0;
 
     std::unique_ptr<std::thread> _receiveThread = nullptr;
     std::shared_ptr<ghoul::Event<>> _connectionEvent;
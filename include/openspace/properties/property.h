@@ -137,8 +137,8 @@ public:
     Property(PropertyInfo info);
 
     /**
-     * The destructor taking care of deallocating all unused memory. This method will not
-     * remove the Property from the PropertyOwner.
+     * The destructor taking care of deallocating all unused memory. If the Property still
+     * has a PropertyOwner, it is removed from it.
      */
     virtual ~Property();
 
@@ -264,6 +264,40 @@ public:
      */
     void removeOnChange(OnChangeHandle handle);
 
+    /**
+     * Starts a batch of changes on the calling thread. While a batch is open, the
+     * onChange callbacks of all Propertys that are changed on this thread are deferred
+     * until the outermost batch is closed with #endChangeNotificationBatch. A Property
+     * that changes several times during a batch has its callbacks invoked only once.
+     * Batches can be nested.
+     */
+    static void beginChangeNotificationBatch();
+
+    /**
+     * Closes the innermost batch that was opened on the calling thread with
+     * #beginChangeNotificationBatch. If it was the outermost batch, the deferred onChange
+     * callbacks are invoked. Errors that are thrown by these callbacks are logged.
+     *
+     * \pre A batch must have been opened on the calling thread
+     */
+    static void endChangeNotificationBatch();
+
+    /**
+     * Returns whether a batch of changes is open on the calling thread.
+     *
+     * \return `true` if onChange callbacks are currently being deferred
+     */
+    static bool isBatchingChangeNotifications();
+
+    /**
+     * Closes all batches that are open on the calling thread and invokes the deferred
+     * onChange callbacks. This is called at the end of each frame so that a batch that
+     * was never closed does not hold back callbacks indefinitely.
+     *
+     * \return The number of batches that were still open
+     */
+    static int flushChangeNotificationBatches();
+
     /**
     * This method deregisters a callback that was previously registered with the onDelete
     * method.
@@ -516,6 +550,12 @@ protected:
 private:
     void notifyDeleteListeners();
 
+    /// Invokes the onChange callbacks that were deferred on this thread during a batch
+    static void invokeDeferredChangeListeners();
+
+    /// Whether this Property is waiting for its onChange callbacks in an open batch
+    bool _hasDeferredNotification = false;
+
     OnChangeHandle _currentHandleValue = 0;
 
 #ifdef _DEBUG
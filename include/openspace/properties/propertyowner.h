@@ -26,8 +26,12 @@
 #define __OPENSPACE_CORE___PROPERTYOWNER___H__
 
 #include <openspace/json.h>
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace openspace::properties {
@@ -71,8 +75,8 @@ public:
     PropertyOwner(PropertyOwnerInfo info);
 
     /**
-     * The destructor will remove all Propertys and PropertyOwners it owns along with
-     * itself.
+     * The destructor will detach all Propertys and PropertyOwners it owns and remove
+     * itself from its own PropertyOwner, if it has one.
      */
     virtual ~PropertyOwner();
 
@@ -147,11 +151,14 @@ public:
      * sub-owner and only the last part of the identifier is referring to a Property owned
      * by PropertyOwner named by the second-but-last name.
      *
+     * If this PropertyOwner is the root of its tree, the lookup is a single query into
+     * the URI index that the root maintains for all Propertys in its tree.
+     *
      * \param uri The identifier of the Property that should be extracted
      * \return If the Property cannot be found, `nullptr` is returned, otherwise the
      *         pointer to the Property is returned
      */
-    Property* property(const std::string& uri) const;
+    Property* property(std::string_view uri) const;
 
     /**
      * This method checks if a Property with the provided \p uri exists in this
@@ -170,6 +177,27 @@ public:
     */
     bool hasProperty(const Property* prop) const;
 
+    /**
+     * Calls the \p function with the URI and the Property for all Propertys in the tree
+     * of this PropertyOwner, without creating the fully qualified identifier of each
+     * Property. The \p function must not add or remove any Property or PropertyOwner.
+     *
+     * \param function The function that is called for each Property
+     * \pre This PropertyOwner must be the root of its tree
+     */
+    void forEachProperty(
+        const std::function<void(std::string_view, Property*)>& function) const;
+
+    /**
+     * Returns a counter that is increased whenever any Property or PropertyOwner is added
+     * or removed, a PropertyOwner is renamed, or the tags of a PropertyOwner change.
+     * Results that have been computed from the property trees remain valid as long as
+     * this value stays the same.
+     *
+     * \return The current version of all property trees
+     */
+    static uint64_t treeVersion();
+
     void setPropertyOwner(PropertyOwner* owner) { _owner = owner; }
     PropertyOwner* owner() const { return _owner; }
 
@@ -317,6 +345,34 @@ protected:
     std::map<std::string, std::string> _groupNames;
     /// Collection of string tag(s) assigned to this property
     std::vector<std::string> _tags;
+
+private:
+    struct UriHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view uri) const {
+            return std::hash<std::string_view>()(uri);
+        }
+    };
+    using UriIndex = std::unordered_map<std::string, Property*, UriHash, std::equal_to<>>;
+
+    /// Returns the PropertyOwner at the top of the tree that this PropertyOwner is in
+    PropertyOwner* rootOwner();
+
+    /// Returns the URI of this PropertyOwner relative to the root, including the
+    /// trailing separator, or an empty string if this PropertyOwner is the root
+    std::string uriPrefix() const;
+
+    /// Adds all Propertys in this PropertyOwner's subtree to the \p index under the
+    /// \p prefix
+    void addToUriIndex(UriIndex& index, const std::string& prefix) const;
+
+    /// Removes all Propertys in this PropertyOwner's subtree with the \p prefix from
+    /// the \p index
+    void removeFromUriIndex(UriIndex& index, const std::string& prefix) const;
+
+    /// Maps the URIs relative to this PropertyOwner to all Propertys in its tree. Only
+    /// the root of a tree populates this index, it is empty for all other owners
+    UriIndex _uriIndex;
 };
 
 }  // namespace openspace::properties
@@ -45,10 +45,23 @@ public:
         const std::string& fontName = "Mono");
 
 protected:
+    /**
+     * Renders the #_text at the \p penPosition and advances the pen by one line.
+     */
+    void renderText(glm::vec2& penPosition) const;
+
     properties::StringProperty _fontName;
     properties::FloatProperty _fontSize;
 
     std::shared_ptr<ghoul::fontrendering::Font> _font;
+
+    /// The text that was rendered last. Items that derive their text from values that
+    /// rarely change only have to recreate it when these values change, for example
+    /// when the same dashboard is rendered in multiple windows or the time is paused
+    std::string _text;
+
+    /// Set if a property has changed that affects the #_text
+    bool _isTextDirty = true;
 };
 
 } // openspace
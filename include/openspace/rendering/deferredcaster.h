@@ -25,7 +25,9 @@
 #ifndef __OPENSPACE_CORE___DEFERREDCASTER___H
 #define __OPENSPACE_CORE___DEFERREDCASTER___H
 
+#include <ghoul/glm.h>
 #include <filesystem>
+#include <optional>
 #include <string>
 
 namespace ghoul::opengl {
@@ -59,6 +61,17 @@ public:
 
     virtual void update(const UpdateData&) = 0;
 
+    /**
+     * Returns the part of the screen that this deferredcaster can change, as the minimum
+     * and maximum corners (x, y, z, w) = (minX, minY, maxX, maxY) in normalized device
+     * coordinates. The deferred pass is restricted to this region and is skipped
+     * entirely if the region is empty. If no bounds are returned, which is the default,
+     * the whole screen is processed.
+     */
+    virtual std::optional<glm::vec4> screenSpaceBounds(const RenderData&) const {
+        return std::nullopt;
+    }
+
     /**
      * Return a path to a GLSL file with helper functions required for the transformation
      * and raycast steps. This file will be included once per shader program generated,
@@ -0,0 +1,78 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___ECLIPSESHADOW___H__
+#define __OPENSPACE_CORE___ECLIPSESHADOW___H__
+
+#include <ghoul/glm.h>
+#include <optional>
+#include <string>
+
+namespace openspace {
+
+/**
+ * The shadow cones that a caster body throws when it is lit by a source body. All
+ * positions and lengths are in meters in the galactic frame, relative to the solar system
+ * barycenter.
+ */
+struct EclipseShadow {
+    /// The position of the caster
+    glm::dvec3 casterPosition = glm::dvec3(0.0);
+    /// The vector pointing from the source to the caster
+    glm::dvec3 sourceCasterVec = glm::dvec3(0.0);
+    /// The position of the Sun, which has to be further away from a receiver than the
+    /// caster for the receiver to be shadowed
+    glm::dvec3 sunPosition = glm::dvec3(0.0);
+    /// The radius of the source, scaled by the scale of its scene graph node
+    double radiusSource = 0.0;
+    /// The radius of the caster, scaled by the scale of its scene graph node
+    double radiusCaster = 0.0;
+    /// The distance between the caster and the apex of the penumbra cone
+    double penumbra = 0.0;
+    /// The distance between the caster and the apex of the umbra cone
+    double umbra = 0.0;
+
+    /**
+     * Returns whether a spherical receiver at the \p position with the \p radius
+     * intersects the penumbra cone behind the caster. The bodies are treated as spheres.
+     */
+    bool isShadowing(const glm::dvec3& position, double radius) const;
+};
+
+/**
+ * Returns the EclipseShadow that the \p caster throws when it is lit by the \p source at
+ * the time \p j2000Seconds, where the two identifiers name both the SPICE bodies and the
+ * scene graph nodes. The shadow only depends on the source and the caster, so it is
+ * computed once per frame and shared between all renderables that receive it, such as a
+ * globe and its atmosphere in each of their render passes.
+ *
+ * \return The shadow, or `std::nullopt` if the source or caster scene graph node does not
+ *         exist
+ */
+std::optional<EclipseShadow> eclipseShadow(const std::string& source, double sourceRadius,
+    const std::string& caster, double casterRadius, double j2000Seconds);
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___ECLIPSESHADOW___H__
@@ -25,14 +25,20 @@
 #ifndef __OPENSPACE_CORE___FRAMEBUFFERRENDERER___H__
 #define __OPENSPACE_CORE___FRAMEBUFFERRENDERER___H__
 
+#include <openspace/properties/propertyowner.h>
 #include <openspace/rendering/raycasterlistener.h>
 #include <openspace/rendering/deferredcasterlistener.h>
 
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/properties/vector/vec3property.h>
 #include <ghoul/glm.h>
 #include <ghoul/misc/dictionary.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <array>
 #include <map>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -54,9 +60,11 @@ struct RaycasterTask;
 class Scene;
 struct UpdateStructures;
 
-class FramebufferRenderer final : public RaycasterListener, public DeferredcasterListener
+class FramebufferRenderer final : public RaycasterListener, public DeferredcasterListener,
+                                  public properties::PropertyOwner
 {
 public:
+    FramebufferRenderer();
     virtual ~FramebufferRenderer() override = default;
 
     //============================//
@@ -164,9 +172,9 @@ public:
     void setDisableHDR(bool disable);
 
     void update();
-    void performRaycasterTasks(const std::vector<RaycasterTask>& tasks,
+    void performRaycasterTasks(const std::pmr::vector<RaycasterTask>& tasks,
         const glm::ivec4& viewport);
-    void performDeferredTasks(const std::vector<DeferredcasterTask>& tasks,
+    void performDeferredTasks(const std::pmr::vector<DeferredcasterTask>& tasks,
         const glm::ivec4& viewport);
     void render(Scene* scene, Camera* camera, float blackoutFactor);
 
@@ -198,6 +206,40 @@ private:
     void updateExitVolumeTextures();
     void writeDownscaledVolume(const glm::ivec4& viewport);
 
+    enum class GpuStage {
+        GBuffer = 0,
+        Raycasters,
+        DownscaledVolume,
+        DeferredCasters,
+        TMO,
+        FXAA
+    };
+    static constexpr int NGpuStages = 6;
+
+    void beginGpuStage(GpuStage stage);
+    void endGpuStage(GpuStage stage);
+    /// Stores the results of the queries that were issued in the previous frame
+    void collectGpuTimes();
+    /// Returns whether the GPU stage queries should be issued in this frame
+    bool isMeasuringGpuTimes() const;
+
+    /**
+     * Adjusts the raycasting quality based on the GPU time that the raycasters used in
+     * the previous frame. While the \p camera is moving, the quality is lowered until
+     * the raycasters fit into the target time and increased again if there is room.
+     * Once the camera has stopped, the quality is ramped back up to the full quality.
+     */
+    void updateAdaptiveRaycasting(const Camera& camera);
+
+    /**
+     * Fills the shading rate image for the \p viewport so that the parts of the image
+     * that are close to the focus direction are shaded at the full rate, while the
+     * periphery is shaded at a reduced rate. The focus direction is rotated into the
+     * frustum of the \p camera, so each cube face of a fisheye rendering, as well as
+     * each eye of a VR rendering, receives its own rates.
+     */
+    void updateShadingRateImage(const Camera& camera, const glm::ivec4& viewport);
+
     std::map<VolumeRaycaster*, RaycastData> _raycastData;
     RaycasterProgObjMap _exitPrograms;
     RaycasterProgObjMap _raycastPrograms;
@@ -268,6 +310,46 @@ private:
     float _value = 1.f;
 
     ghoul::Dictionary _rendererData;
+
+    properties::BoolProperty _measureGpuTimes;
+    properties::PropertyOwner _gpuTimes;
+    properties::FloatProperty _gBufferTime;
+    properties::FloatProperty _raycasterTime;
+    properties::FloatProperty _downscaledVolumeTime;
+    properties::FloatProperty _deferredcasterTime;
+    properties::FloatProperty _tmoTime;
+    properties::FloatProperty _fxaaTime;
+
+    properties::PropertyOwner _adaptiveRaycasting;
+    properties::BoolProperty _adaptiveRaycastingEnabled;
+    properties::FloatProperty _targetRaycastTime;
+    properties::FloatProperty _minimumRaycastQuality;
+    properties::FloatProperty _raycastQuality;
+    glm::dmat4 _previousViewMatrix = glm::dmat4(0.0);
+
+    properties::PropertyOwner _variableRateShading;
+    properties::BoolProperty _variableRateShadingEnabled;
+    properties::FloatProperty _fullRateAngle;
+    properties::FloatProperty _halfRateAngle;
+    properties::Vec3Property _focusDirection;
+
+    // The shading rate image of GL_NV_shading_rate_image. Every texel covers a tile of
+    // texelSize pixels and contains an index into the palette of shading rates
+    struct {
+        GLuint texture = 0;
+        glm::ivec2 size = glm::ivec2(0);
+        glm::ivec2 texelSize = glm::ivec2(16);
+        std::vector<GLubyte> rates;
+    } _shadingRateImage;
+
+    // The timestamp queries alternate between two sets, so that the results of the
+    // previous frame can be read without stalling on the current one. Each stage has a
+    // query for its beginning and its end
+    struct {
+        std::array<std::array<GLuint, 2 * NGpuStages>, 2> queries;
+        std::array<std::array<bool, NGpuStages>, 2> isIssued;
+        int current = 0;
+    } _gpuTimer;
 };
 
 } // namespace openspace
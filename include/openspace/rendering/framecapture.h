@@ -0,0 +1,142 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___FRAMECAPTURE___H__
+#define __OPENSPACE_CORE___FRAMECAPTURE___H__
+
+#include <openspace/util/threadpool.h>
+#include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * Captures the contents of the default framebuffer without stalling the rendering. The
+ * pixels of a frame are read back into a pixel buffer object, and once the fence that is
+ * placed after the read back has been signalled, the frame is handed to a set of worker
+ * threads that write it to disk. Alternatively, the frames are streamed into an ffmpeg
+ * process that encodes them into a video. All functions have to be called from the
+ * thread that owns the OpenGL context.
+ */
+class FrameCapture {
+public:
+    enum class Format {
+        /// Binary Portable Pixmap files with 8 bit RGB values
+        Ppm = 0,
+        /// Files with the 8 bit RGBA values of the rows from top to bottom
+        Raw,
+        /// Frames that are piped into an ffmpeg process as 8 bit RGBA values
+        Ffmpeg
+    };
+
+    /**
+     * Creates a frame capture. If \p dropLateFrames is `true`, frames are dropped when
+     * the worker threads fall behind instead of waiting for them, which keeps the
+     * rendering from stalling when the frames are streamed live rather than recorded.
+     */
+    explicit FrameCapture(bool dropLateFrames = false);
+
+    /**
+     * Starts to read back the \p size pixels in the lower left corner of the back buffer
+     * of the default framebuffer.
+     *
+     * \param size The number of pixels that are captured
+     * \param format The format in which the frame is written
+     * \param target The file to which the frame is written or, if the \p format is
+     *        Format::Ffmpeg, the command that starts the ffmpeg process. If the command
+     *        or the size changes between frames, a new process is started
+     */
+    void capture(const glm::ivec2& size, Format format, std::string target);
+
+    /**
+     * Hands all frames whose read back has finished to the worker threads. This function
+     * does not block unless the worker threads fall too far behind, in which case it
+     * waits for them to limit the memory that is used by the frames, or drops the frames
+     * if late frames should be dropped.
+     */
+    void update();
+
+    /**
+     * Waits until all captured frames have been written and ends the ffmpeg process, so
+     * that the next captured frame starts a new video.
+     */
+    void finish();
+
+    /**
+     * Writes all outstanding frames and releases the OpenGL resources.
+     */
+    void deinitialize();
+
+private:
+    struct Readback {
+        /// The index into the _buffers
+        size_t buffer = 0;
+        GLsync fence = nullptr;
+        glm::ivec2 size = glm::ivec2(0);
+        Format format = Format::Ppm;
+        std::string target;
+    };
+
+    struct Buffer {
+        GLuint buffer = 0;
+        size_t size = 0;
+        bool isInUse = false;
+    };
+
+    /**
+     * Hands the frames whose read back has finished to the worker threads, in the order
+     * in which they were captured. If \p waitForGpu is true, this function waits for all
+     * read backs to finish.
+     */
+    void processReadbacks(bool waitForGpu);
+    void write(std::vector<std::byte> pixels, const glm::ivec2& size, Format format,
+        const std::string& target);
+    void writeToFfmpeg(const std::vector<std::byte>& pixels, const glm::ivec2& size,
+        const std::string& command);
+    void closeFfmpeg();
+
+    std::deque<Readback> _readbacks;
+    std::vector<Buffer> _buffers;
+
+    /// Writes the image files
+    ThreadPool _filePool;
+    /// Writes to the ffmpeg process. It only has a single thread to keep frames in order
+    ThreadPool _ffmpegPool;
+    std::atomic_int _nOutstandingTasks = 0;
+    const bool _dropLateFrames;
+
+    // Only accessed from the thread of the _ffmpegPool
+    FILE* _ffmpeg = nullptr;
+    glm::ivec2 _ffmpegSize = glm::ivec2(0);
+    std::string _ffmpegCommand;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___FRAMECAPTURE___H__
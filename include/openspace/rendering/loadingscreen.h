@@ -30,6 +30,7 @@
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <random>
@@ -58,6 +59,13 @@ public:
 
     void render();
 
+    /**
+     * Renders a new frame of the loading screen if the last frame was rendered at least
+     * one refresh period ago and does nothing otherwise. Long-running work on the main
+     * thread can call this in between its steps to keep the loading screen responsive.
+     */
+    void renderIfDue();
+
     void postMessage(std::string message);
     void setCatastrophicError(CatastrophicError catastrophicError);
 
@@ -90,10 +98,17 @@ public:
         int64_t totalSize = -1;
     };
 
+    /**
+     * Queues an update of the item with the provided \p itemIdentifier, or the creation
+     * of a new item if no such item exists yet. This function can be called from any
+     * thread and the queued updates are applied the next time a frame is rendered.
+     */
     void updateItem(const std::string& itemIdentifier, const std::string& itemName,
         ItemStatus newStatus, ProgressInfo progressInfo);
 
 private:
+    void applyItemUpdates();
+
     bool _showMessage;
     bool _showNodeNames;
     bool _showProgressbar;
@@ -125,8 +140,20 @@ private:
 
         std::chrono::system_clock::time_point finishedTime;
     };
+    // Only accessed from the main thread
     std::vector<Item> _items;
-    std::mutex _itemsMutex;
+
+    struct ItemUpdate {
+        std::string identifier;
+        std::string name;
+        ItemStatus status;
+        ProgressInfo progress;
+        std::chrono::system_clock::time_point time;
+    };
+    std::vector<ItemUpdate> _itemUpdates;
+    std::mutex _itemUpdatesMutex;
+
+    std::chrono::steady_clock::time_point _lastFrameTime;
 
     std::random_device _randomDevice;
     std::default_random_engine _randomEngine;
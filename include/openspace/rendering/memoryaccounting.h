@@ -0,0 +1,82 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___MEMORYACCOUNTING___H__
+#define __OPENSPACE_CORE___MEMORYACCOUNTING___H__
+
+#include <openspace/properties/propertyowner.h>
+
+#include <openspace/properties/scalar/doubleproperty.h>
+#include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/rendering/renderable.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+class Scene;
+
+/**
+ * Collects the memory that is used by all Renderable%s of the scene, as reported by
+ * Renderable::memoryUsage, in regular intervals. The totals are exposed as read-only
+ * properties, next to the per-Renderable values that are updated at the same time. If
+ * the GPU memory exceeds the budget, the Renderable with the largest GPU memory usage
+ * that is able to do so is asked to reduce its memory usage in each interval.
+ */
+class MemoryAccounting : public properties::PropertyOwner {
+public:
+    struct Entry {
+        std::string identifier;
+        Renderable::MemoryUsage usage;
+    };
+
+    MemoryAccounting();
+
+    /**
+     * Updates the memory usage of all Renderable%s in the \p scene if the update interval
+     * has passed since the last update and reduces the quality of Renderables if the
+     * budget is exceeded.
+     */
+    void update(const Scene& scene);
+
+    /// Returns the memory usage of all Renderables at the time of the last update,
+    /// sorted by the sum of their GPU memory in descending order
+    const std::vector<Entry>& entries() const;
+
+private:
+    properties::DoubleProperty _gpuBuffers;
+    properties::DoubleProperty _gpuTextures;
+    properties::DoubleProperty _cpuData;
+    properties::FloatProperty _gpuBudget;
+    properties::FloatProperty _updateInterval;
+
+    std::vector<Entry> _entries;
+    std::chrono::steady_clock::time_point _lastUpdate;
+    bool _hasReportedExceededBudget = false;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___MEMORYACCOUNTING___H__
@@ -0,0 +1,93 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___PROGRAMBINARYCACHE___H__
+#define __OPENSPACE_CORE___PROGRAMBINARYCACHE___H__
+
+#include <ghoul/misc/dictionary.h>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace ghoul::opengl { class ProgramObject; }
+
+namespace openspace {
+
+/**
+ * This class stores the linked binaries of program objects in a folder on disk so that
+ * subsequent requests for the same program can skip compiling and linking the shaders.
+ * The binaries are keyed by the preprocessed source code of the shaders as well as the
+ * vendor, renderer, and version of the OpenGL driver, as the binaries are not portable
+ * between different drivers. All functions of this class must be called from the thread
+ * that owns the OpenGL context.
+ */
+class ProgramBinaryCache {
+public:
+    /// The shaders that make up a single program, in the order vertex, fragment, and an
+    /// optional geometry shader
+    struct Shaders {
+        std::filesystem::path vertex;
+        std::filesystem::path fragment;
+        std::optional<std::filesystem::path> geometry;
+    };
+
+    /**
+     * Creates a cache that stores its binaries in the provided \p folder, which is
+     * created when the first binary is stored.
+     */
+    explicit ProgramBinaryCache(std::filesystem::path folder);
+
+    /**
+     * Calculates the key for the program consisting of the \p shaders that have been
+     * preprocessed using the \p dictionary. If any of the shaders could not be
+     * preprocessed, `std::nullopt` is returned and the program should not be cached.
+     */
+    std::optional<std::string> key(const Shaders& shaders,
+        const ghoul::Dictionary& dictionary) const;
+
+    /**
+     * Returns a program object with the provided \p name that has been created from the
+     * binary stored for the \p key, or `nullptr` if no binary exists or the driver
+     * rejects it. The shader objects are attached to the program without being compiled
+     * so that the program can still be rebuilt if its files or dictionary change.
+     */
+    std::unique_ptr<ghoul::opengl::ProgramObject> load(const std::string& key,
+        const std::string& name, const Shaders& shaders,
+        const ghoul::Dictionary& dictionary) const;
+
+    /**
+     * Stores the binary of the linked \p program using the \p key. Drivers are allowed to
+     * not provide a binary, in which case nothing is stored.
+     */
+    void store(const std::string& key, const ghoul::opengl::ProgramObject& program) const;
+
+private:
+    std::filesystem::path _folder;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___PROGRAMBINARYCACHE___H__
@@ -58,6 +58,14 @@ class Camera;
 struct RenderableSettings {
     bool automaticallyUpdateRenderBin = true;
     bool shouldUpdateIfDisabled = false;
+    // If this is `true`, the Renderable::update function does not access any OpenGL
+    // state or other shared data and can therefore be called from a worker thread when
+    // the scene is updated in parallel
+    bool hasThreadSafeUpdate = false;
+    // If this is `false`, the Renderable is always rendered, even if its bounding sphere
+    // is outside of the view frustum. This is necessary for Renderables whose geometry
+    // is not contained in the bounding sphere around the position of their node
+    bool supportsCulling = true;
 };
 
 class Renderable : public properties::PropertyOwner, public Fadeable {
@@ -86,6 +94,8 @@ public:
     virtual bool isReady() const = 0;
     bool isEnabled() const;
     bool shouldUpdateIfDisabled() const noexcept;
+    bool hasThreadSafeUpdate() const noexcept;
+    bool supportsCulling() const noexcept;
 
     double boundingSphere() const noexcept;
     double interactionSphere() const noexcept;
@@ -114,6 +124,44 @@ public:
 
     bool isVisible() const override;
 
+    /// The memory that is held by a Renderable in bytes, split by category
+    struct MemoryUsage {
+        /// OpenGL buffer objects, such as vertex, index, or shader storage buffers
+        size_t gpuBuffers = 0;
+        /// OpenGL textures
+        size_t gpuTextures = 0;
+        /// Data that is kept in main memory, such as loaded datasets
+        size_t cpuData = 0;
+
+        MemoryUsage& operator+=(const MemoryUsage& rhs);
+    };
+
+    /**
+     * Returns an estimate of the memory that is currently held by this Renderable. The
+     * default implementation reports no memory, so Renderables that hold large datasets
+     * or textures should override this function. It is only called from the main thread
+     * and may query the OpenGL state.
+     */
+    virtual MemoryUsage memoryUsage() const;
+
+    /**
+     * Asks the Renderable to free some of its memory, for example by lowering the
+     * resolution or the amount of data it keeps resident, as the memory of all
+     * Renderables exceeds the budget. This function is called repeatedly until the usage
+     * is within the budget, so every call should only reduce the quality by one step.
+     *
+     * \return `true` if the Renderable has reduced its memory usage, `false` if it
+     *         cannot reduce it any further. The default implementation returns `false`
+     */
+    virtual bool reduceMemoryUsage();
+
+    /**
+     * Calls #memoryUsage and updates the read-only properties that expose the result.
+     *
+     * \return The result of the #memoryUsage call
+     */
+    MemoryUsage updateMemoryUsage();
+
     void onEnabledChange(std::function<void(bool)> callback);
 
     static documentation::Documentation Documentation();
@@ -128,6 +176,14 @@ protected:
 
     void setRenderBinFromOpacity();
 
+    /// Returns the size of the OpenGL buffer object \p buffer in bytes, or 0 if the
+    /// \p buffer is 0
+    static size_t bufferMemory(unsigned int buffer);
+
+    /// Returns the size of the pixel data of the \p texture in bytes, or 0 if the
+    /// \p texture is a `nullptr`
+    static size_t textureMemory(const ghoul::opengl::Texture* texture);
+
     /// Returns the full opacity constructed from the _opacity and _fade property values
     float opacity() const noexcept override;
 
@@ -142,11 +198,17 @@ protected:
     // where all parts of the renderable should not be rendered in the same bin
     std::optional<RenderBin> _secondaryRenderBin;
 private:
+    properties::PropertyOwner _memoryUsageOwner;
+    properties::DoubleProperty _gpuBufferMemory;
+    properties::DoubleProperty _gpuTextureMemory;
+    properties::DoubleProperty _cpuDataMemory;
 
     double _boundingSphere = 0.0;
     double _interactionSphere = 0.0;
     SceneGraphNode* _parent = nullptr;
     const bool _shouldUpdateIfDisabled = false;
+    const bool _hasThreadSafeUpdate = false;
+    const bool _supportsCulling = true;
     bool _automaticallyUpdateRenderBin = true;
     bool _hasOverrideRenderBin = false;
 
@@ -32,12 +32,17 @@
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/properties/stringproperty.h>
 #include <openspace/properties/vector/vec3property.h>
 #include <openspace/properties/vector/vec4property.h>
 #include <openspace/properties/triggerproperty.h>
 #include <openspace/rendering/framebufferrenderer.h>
+#include <openspace/rendering/framecapture.h>
+#include <openspace/rendering/memoryaccounting.h>
 #include <chrono>
 #include <filesystem>
+#include <functional>
+#include <optional>
 
 namespace ghoul {
     namespace fontrendering { class Font; }
@@ -55,6 +60,7 @@ namespace openspace {
 namespace scripting { struct LuaLibrary; }
 
 class Camera;
+class ProgramBinaryCache;
 class RaycasterManager;
 class DeferredcasterManager;
 class Scene;
@@ -69,6 +75,7 @@ public:
     virtual ~RenderEngine() override;
 
     const FramebufferRenderer& renderer() const;
+    const MemoryAccounting& memoryAccounting() const;
 
     void initialize();
     void initializeGL();
@@ -78,6 +85,13 @@ public:
     Scene* scene();
     void updateScene();
 
+    /**
+     * Updates only the transformations of the scene graph nodes for the current time,
+     * but not their Renderables. This is sufficient for placing the camera before the
+     * cluster synchronization, while the full update is done afterwards.
+     */
+    void updateSceneTransforms();
+
     ghoul::opengl::OpenGLStateCache& openglStateCache();
 
     void updateShaderPrograms();
@@ -142,6 +156,12 @@ public:
      */
     void resetScreenshotNumber();
 
+    /**
+     * Waits until all screenshots that are taken asynchronously have been written. If
+     * the screenshots are piped into ffmpeg, the video is finished.
+     */
+    void finishScreenshots();
+
     /**
      * Get the filename of the latest screenshot
      */
@@ -163,6 +183,18 @@ public:
     uint64_t frameNumber() const;
 
 private:
+    /**
+     * Returns the program built by \p build for the provided \p shaders. If the program
+     * binary cache is enabled, a previously stored binary is used instead if one exists
+     * for the same preprocessed shaders and driver, and a newly built program is stored.
+     */
+    std::unique_ptr<ghoul::opengl::ProgramObject> buildCachedProgram(
+        const std::string& name, const std::filesystem::path& vsPath,
+        const std::filesystem::path& fsPath,
+        const std::optional<std::filesystem::path>& gsPath,
+        const ghoul::Dictionary& dictionary,
+        const std::function<std::unique_ptr<ghoul::opengl::ProgramObject>()>& build);
+
     void renderScreenLog();
     void renderVersionInformation();
     void renderCameraInformation();
@@ -173,6 +205,7 @@ private:
     Scene* _scene = nullptr;
 
     FramebufferRenderer _renderer;
+    MemoryAccounting _memoryAccounting;
     ghoul::Dictionary _rendererData;
     ghoul::Dictionary _resolveData;
     ScreenLog* _log = nullptr;
@@ -189,6 +222,11 @@ private:
     properties::BoolProperty _applyWarping;
     properties::BoolProperty _showStatistics;
     properties::BoolProperty _screenshotUseDate;
+    properties::BoolProperty _asyncScreenshots;
+    properties::OptionProperty _asyncScreenshotFormat;
+    properties::StringProperty _ffmpegCommand;
+    properties::BoolProperty _liveOutput;
+    properties::StringProperty _liveOutputCommand;
     properties::BoolProperty _showFrameInformation;
     properties::BoolProperty _disableMasterRendering;
 
@@ -214,8 +252,13 @@ private:
 
     uint64_t _frameNumber = 0;
     unsigned int _latestScreenshotNumber = 0;
+    bool _shouldCaptureFrame = false;
+    FrameCapture _frameCapture;
+    FrameCapture _liveCapture{ true };
 
     std::vector<ghoul::opengl::ProgramObject*> _programs;
+    std::unique_ptr<ProgramBinaryCache> _programBinaryCache;
+    properties::BoolProperty _useProgramBinaryCache;
 
     std::shared_ptr<ghoul::fontrendering::Font> _fontFrameInfo;
     std::shared_ptr<ghoul::fontrendering::Font> _fontCameraInfo;
@@ -26,6 +26,7 @@
 #define __OPENSPACE_CORE___VOLUMERAYCASTER___H__
 
 #include <ghoul/glm.h>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -80,6 +81,15 @@ public:
     */
     virtual bool isCameraInside(const RenderData& data, glm::vec3& localPosition);
 
+    /**
+     * Returns the part of the screen that is covered by the volume's bounding geometry,
+     * as the minimum and maximum corners (x, y, z, w) = (minX, minY, maxX, maxY) in
+     * normalized device coordinates. The raycasting passes are restricted to this region
+     * and are skipped if it is empty. If no bounds are returned, which is the default,
+     * the passes cover the whole screen.
+     */
+    virtual std::optional<glm::vec4> screenSpaceBounds(const RenderData& data);
+
     /**
      * Return a path the file to use as vertex shader
      *
@@ -137,6 +147,25 @@ public:
 
     float downscaleRender() const;
 
+    /**
+     * Sets the factor by which the raycaster should multiply its step size for the next
+     * raycast. This is used by the renderer to temporarily trade quality for speed, and
+     * implementations should apply it in addition to their own step size.
+     */
+    void setStepSizeScale(float scale);
+
+    float stepSizeScale() const;
+
+protected:
+    /**
+     * Returns the screen-space bounds, as described in #screenSpaceBounds, of the unit
+     * cube centered on the origin after it has been transformed by
+     * \p modelViewProjection. No bounds are returned if the cube reaches behind the
+     * camera, as its projection is unbounded in that case.
+     */
+    static std::optional<glm::vec4> boxScreenSpaceBounds(
+        const glm::dmat4& modelViewProjection);
+
 private:
     /**
      * Maximum number of integration steps to be executed by the volume integrator.
@@ -147,6 +176,11 @@ private:
      * Enable and set the downscale rendering of the volume. Used to improve performance.
      */
     float _downscaleRenderConst = 1.0f;
+
+    /**
+     * The factor the raycaster's step size is multiplied with.
+     */
+    float _stepSizeScale = 1.f;
 };
 
 } // namespace openspace
@@ -26,10 +26,13 @@
 #define __OPENSPACE_CORE___ASSETMANAGER___H__
 
 #include <ghoul/lua/luastate.h>
+#include <chrono>
 #include <filesystem>
 #include <optional>
+#include <string>
 #include <unordered_map>
 #include <list>
+#include <vector>
 
 namespace openspace {
 
@@ -150,6 +153,26 @@ public:
      */
     void callOnDeinitialize(Asset* asset) const;
 
+    /**
+     * Loads the compiled asset files that were written by #saveSnapshot in a previous run
+     * from the file at \p path. Asset files whose size and modification time still match
+     * the snapshot are neither read nor compiled again and their dependencies are taken
+     * from the snapshot, too. Changed asset files are compiled as usual and replace their
+     * entry in the snapshot. If the file does not exist or was written by an incompatible
+     * version, nothing is loaded.
+     *
+     * \param path The path to the file that was previously written by #saveSnapshot
+     */
+    void loadSnapshot(const std::filesystem::path& path);
+
+    /**
+     * Writes the compiled asset files that have been used in this run to the file at
+     * \p path, from where they can be loaded by #loadSnapshot in the next run.
+     *
+     * \param path The path to the file that is written
+     */
+    void saveSnapshot(const std::filesystem::path& path) const;
+
 private:
     /// Creates and registers all of the callback functions that the asset is expected to
     /// call in the file, for example the `localResource`, `require`, etc.
@@ -164,6 +187,12 @@ private:
     /// Setup the asset table of the provided asset in the shared Lua state
     void setCurrentAsset(Asset* asset);
 
+    /// Reads and compiles the asset files at \p paths and, transitively, all of the
+    /// assets that they require by name. Each level of the dependency graph is compiled
+    /// concurrently in separate Lua states and the resulting bytecode is stored in
+    /// #_precompiledAssets, from where #loadAsset picks it up
+    void precompileAssets(std::vector<std::filesystem::path> paths);
+
     /// Takes the asset path, determines the type of path (relative to base, relative to
     /// root or absolute and returns fully formed path
     std::filesystem::path generateAssetPath(const std::filesystem::path& baseDirectory,
@@ -192,6 +221,23 @@ private:
     /// This list contains all of the assets that will be deleted in the next update call
     std::vector<std::unique_ptr<Asset>> _toBeDeleted;
 
+    /// The compiled Lua bytecode of asset files that have been prepared by
+    /// #precompileAssets but have not been loaded yet, keyed by the asset path
+    std::unordered_map<std::string, std::string> _precompiledAssets;
+
+    struct SnapshotEntry {
+        /// The size and the modification time of the asset file that was compiled
+        uint64_t fileSize = 0;
+        int64_t writeTime = 0;
+        std::vector<std::string> dependencies;
+        std::string bytecode;
+        /// Whether the asset was compiled or loaded from the snapshot in this run
+        bool isUsed = false;
+    };
+    /// The compiled asset files from the snapshot of a previous run together with those
+    /// compiled in this run, keyed by the asset path
+    std::unordered_map<std::string, SnapshotEntry> _snapshot;
+
     //
     // ResourceSynchronizations
     //
@@ -200,6 +246,9 @@ private:
     struct SyncItem {
         std::unique_ptr<ResourceSynchronization> synchronization;
         std::vector<Asset*> assets;
+        /// The time at which the synchronization was first requested, used to report
+        /// its duration at startup
+        std::chrono::steady_clock::time_point requestTime;
     };
     /// Authoritative list over all ResourceSynchronizations that have been requested by
     /// any asset
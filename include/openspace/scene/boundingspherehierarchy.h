@@ -0,0 +1,132 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___BOUNDINGSPHEREHIERARCHY___H__
+#define __OPENSPACE_CORE___BOUNDINGSPHEREHIERARCHY___H__
+
+#include <ghoul/glm.h>
+#include <cstdint>
+#include <vector>
+
+namespace openspace {
+
+class SceneGraphNode;
+class WorldTransformCache;
+
+/**
+ * A bounding volume hierarchy over the world positions and bounding spheres of the scene
+ * graph nodes in a WorldTransformCache that answers spatial queries, such as which nodes
+ * a ray hits, without testing every node in the scene.
+ *
+ * The hierarchy is updated lazily by the first query after the scene has changed. If
+ * only the transformations have changed, the bounding spheres of the existing hierarchy
+ * are refit, which only requires a single pass over the nodes. The hierarchy is built
+ * anew if the nodes in the cache have changed or if the refitted spheres have grown too
+ * much, for example because the nodes have moved far along their orbits. All functions
+ * have to be called from the thread that updates the scene.
+ */
+class BoundingSphereHierarchy {
+public:
+    struct RayHit {
+        SceneGraphNode* node = nullptr;
+        /// The distance along the ray at which the bounding sphere is entered, or 0 if
+        /// the origin of the ray is inside the bounding sphere
+        double distance = 0.0;
+    };
+
+    explicit BoundingSphereHierarchy(const WorldTransformCache& cache);
+
+    /**
+     * Notifies the hierarchy that the world transformations in the cache have changed,
+     * which causes the bounding spheres to be refit before the next query.
+     */
+    void invalidateTransforms();
+
+    /**
+     * Notifies the hierarchy that the nodes in the cache have changed, which causes the
+     * hierarchy to be rebuilt before the next query.
+     */
+    void invalidateNodes();
+
+    /**
+     * Returns the active nodes whose bounding spheres are hit by the ray starting at
+     * \p origin in the \p direction, ordered by increasing distance. Nodes without a
+     * bounding sphere are never hit.
+     */
+    std::vector<RayHit> intersectRay(const glm::dvec3& origin,
+        const glm::dvec3& direction);
+
+    /**
+     * Returns the active node whose bounding sphere has the closest surface to the
+     * \p position, or `nullptr` if the scene is empty. Positions inside of a bounding
+     * sphere are closer the deeper they are inside of it.
+     */
+    SceneGraphNode* nearestNode(const glm::dvec3& position);
+
+    /**
+     * Returns the active nodes whose bounding spheres are at least partially inside the
+     * view frustum described by the \p viewProjection matrix, which transforms world
+     * coordinates into clip space.
+     */
+    std::vector<SceneGraphNode*> nodesInFrustum(const glm::dmat4& viewProjection);
+
+private:
+    struct Node {
+        glm::dvec3 center = glm::dvec3(0.0);
+        double radius = 0.0;
+        /// Index of the second child; the first child directly follows the node. Leaves
+        /// have no children
+        int secondChild = -1;
+        /// The range in _order that is covered by a leaf
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    void update();
+    void rebuild();
+    int buildNode(uint32_t first, uint32_t count);
+    void refit();
+    double totalRadius() const;
+
+    /// Returns the node in the cache at \p index if it is part of the query results
+    SceneGraphNode* queryableNode(uint32_t index) const;
+
+    const WorldTransformCache& _cache;
+
+    /// The indices into the cache, ordered so that every leaf covers a continuous range
+    std::vector<uint32_t> _order;
+    /// The world space bounding spheres of the nodes, indexed like the cache
+    std::vector<glm::dvec4> _spheres;
+    std::vector<Node> _nodes;
+
+    /// The sum of all radii right after the last rebuild, which is used to detect when
+    /// the hierarchy has degraded too much through refitting
+    double _builtTotalRadius = 0.0;
+    bool _needsRefit = true;
+    bool _needsRebuild = true;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___BOUNDINGSPHEREHIERARCHY___H__
@@ -52,6 +52,25 @@ public:
     virtual glm::dmat3 matrix(const UpdateData& time) const = 0;
     virtual void update(const UpdateData& data);
 
+    /**
+     * Returns whether the #update and #matrix functions of this rotation can be called
+     * from a worker thread concurrently with other Rotation%s. Rotations that access
+     * shared state that is not thread-safe (such as CSPICE, a Lua state, or the data of
+     * other scene graph nodes) have to return `false` here, which causes the owning
+     * SceneGraphNode to be updated on the main thread.
+     *
+     * \return `true` if this rotation can be updated from a worker thread
+     */
+    virtual bool isThreadSafe() const;
+
+    /**
+     * Returns whether the rotation matrix has changed during the last call to #update.
+     * This can be used to skip any expensive computations that depend on the rotation.
+     *
+     * \return `true` if the rotation matrix changed during the last call to #update
+     */
+    bool hasChanged() const;
+
     static documentation::Documentation Documentation();
 
 protected:
@@ -59,6 +78,7 @@ protected:
 
 private:
     bool _needsUpdate = true;
+    bool _hasChanged = true;
     double _cachedTime = -std::numeric_limits<double>::max();
     glm::dmat3 _cachedMatrix = glm::dmat3(1.0);
 };
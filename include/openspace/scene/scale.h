@@ -52,6 +52,24 @@ public:
     virtual glm::dvec3 scaleValue(const UpdateData& data) const = 0;
     virtual void update(const UpdateData& data);
 
+    /**
+     * Returns whether the #update and #scaleValue functions of this scale can be called
+     * from a worker thread concurrently with other Scale%s. Scales that access shared
+     * state that is not thread-safe (such as a Lua state) have to return `false` here,
+     * which causes the owning SceneGraphNode to be updated on the main thread.
+     *
+     * \return `true` if this scale can be updated from a worker thread
+     */
+    virtual bool isThreadSafe() const;
+
+    /**
+     * Returns whether the scale has changed during the last call to #update. This can be
+     * used to skip any expensive computations that depend on the scale.
+     *
+     * \return `true` if the scale changed during the last call to #update
+     */
+    bool hasChanged() const;
+
     static documentation::Documentation Documentation();
 
 protected:
@@ -59,6 +77,7 @@ protected:
 
 private:
     bool _needsUpdate = true;
+    bool _hasChanged = true;
     double _cachedTime = -std::numeric_limits<double>::max();
     glm::dvec3 _cachedScale = glm::dvec3(1.0);
 };
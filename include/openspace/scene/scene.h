@@ -27,13 +27,19 @@
 
 #include <openspace/properties/propertyowner.h>
 
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/scene/boundingspherehierarchy.h>
 #include <openspace/scene/profile.h>
 #include <openspace/scene/scenegraphnode.h>
+#include <openspace/scene/worldtransformcache.h>
 #include <openspace/scripting/scriptengine.h>
 #include <ghoul/lua/luastate.h>
 #include <ghoul/misc/easing.h>
 #include <ghoul/misc/exception.h>
 #include <ghoul/misc/memorypool.h>
+#include <array>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <set>
@@ -58,12 +64,14 @@ enum class PropertyValueType {
 using ProfilePropertyLua = std::variant<bool, float, std::string, ghoul::lua::nil_t>;
 
 class SceneInitializer;
+class ThreadPool;
 
 // Notifications:
 // SceneGraphFinishedLoading
 class Scene : public properties::PropertyOwner {
 public:
     BooleanType(UpdateDependencies);
+    BooleanType(UpdateRenderables);
 
     struct InvalidSceneError : ghoul::RuntimeError {
         /**
@@ -101,9 +109,12 @@ public:
     Camera* camera() const;
 
     /**
-     * Updates all SceneGraphNodes relative positions
+     * Updates all SceneGraphNodes relative positions. If \p updateRenderables is `No`,
+     * only the transformations of the nodes are updated, which is sufficient to place
+     * the camera relative to the nodes, and the Renderables keep their previous state.
      */
-    void update(const UpdateData& data);
+    void update(const UpdateData& data,
+        UpdateRenderables updateRenderables = UpdateRenderables::Yes);
 
     /**
      * Render visible SceneGraphNodes using the provided camera.
@@ -146,6 +157,20 @@ public:
      */
     const std::vector<SceneGraphNode*>& allSceneGraphNodes() const;
 
+    /**
+     * Returns the cache that contains the world transformations of all scene graph nodes
+     * as contiguous arrays. The order of the entries is topologically sorted, but not
+     * necessarily the same as the order of #allSceneGraphNodes.
+     */
+    const WorldTransformCache& worldTransformCache() const;
+
+    /**
+     * Returns the bounding sphere hierarchy over all scene graph nodes, which can be used
+     * to find the nodes in a region of space without testing every node in the scene.
+     * The hierarchy is brought up to date with the last #update by the first query.
+     */
+    BoundingSphereHierarchy& boundingSphereHierarchy();
+
     /**
      * Returns a map from identifier to scene graph node.
      */
@@ -326,13 +351,93 @@ private:
     std::chrono::steady_clock::time_point currentTimeForInterpolation();
     void sortTopologically();
 
+    /**
+     * Groups the topologically sorted nodes into levels where each node only depends on
+     * nodes in previous levels. All nodes within one level can be updated concurrently.
+     */
+    void createUpdateLevels();
+
+    /**
+     * Collects the nodes with a visible renderable into the #_renderCandidates lists. If
+     * #_sortRenderBins is enabled, the nodes in each bin are then ordered to reduce the
+     * number of OpenGL state changes, or back to front for transparent bins. None of this
+     * depends on the orientation or projection of the camera, so the lists are shared by
+     * all views that are rendered from the same \p cameraPosition in a frame, such as the
+     * eyes of a stereo window, multiple viewports, or the faces of a fisheye cube map.
+     *
+     * \return `true` if the lists were rebuilt, `false` if they were still valid
+     */
+    bool updateRenderCandidates(const glm::dvec3& cameraPosition);
+
+    /**
+     * Culls the render candidates against the view frustum of the \p camera and the
+     * minimum screen size and copies the remaining nodes into the #_visibleNodes lists,
+     * keeping the order of the candidates. The lists are only rebuilt if the camera or
+     * the scene has changed since the last call, which makes this a no-op for all but the
+     * first render bin of a view.
+     */
+    void updateVisibleNodes(const Camera& camera);
+
     std::unique_ptr<Camera> _camera;
     std::vector<SceneGraphNode*> _topologicallySortedNodes;
     std::vector<SceneGraphNode*> _circularNodes;
+
+    struct UpdateLevel {
+        // The range of this level in the _transformCache
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        // Nodes whose transformation can be updated on a worker thread
+        std::vector<SceneGraphNode*> parallelNodes;
+        // Nodes whose transformation has to be updated on the main thread
+        std::vector<SceneGraphNode*> serialNodes;
+    };
+
+    /**
+     * Updates the transformation, and optionally the renderable, of every node one after
+     * another in topological order on the calling thread.
+     */
+    void updateSerially(const UpdateData& data, UpdateRenderables updateRenderables);
+
+    /**
+     * Updates the transformations of all nodes in the \p level. The thread-safe nodes are
+     * updated first, using the \p pool if it is not `nullptr`, followed by the remaining
+     * nodes one after another in topological order on the calling thread.
+     */
+    void updateTransforms(const UpdateLevel& level, const UpdateData& data,
+        ThreadPool* pool);
+
+    std::vector<UpdateLevel> _updateLevels;
+    WorldTransformCache _transformCache;
+    BoundingSphereHierarchy _boundingHierarchy = BoundingSphereHierarchy(_transformCache);
+    properties::BoolProperty _parallelUpdate;
+    properties::BoolProperty _frustumCulling;
+    properties::FloatProperty _minimumScreenSize;
+    properties::BoolProperty _sortRenderBins;
+
+    // The number of bits in the Renderable::RenderBin enum
+    static constexpr int NRenderBins = 6;
+    // The nodes with a visible renderable in topological order, and for each render bin
+    // the indices of the candidates that render into it, in the order they are drawn
+    std::vector<SceneGraphNode*> _renderCandidates;
+    std::array<std::vector<uint32_t>, NRenderBins> _renderCandidatesPerBin;
+    glm::dvec3 _renderCandidatesCameraPosition = glm::dvec3(0.0);
+    bool _renderCandidatesDirty = true;
+    // The nodes that survived culling for the last view. The first list is used for
+    // render bin masks that combine multiple bins and for the Sticker bin, in which the
+    // debug spheres of all nodes are drawn. The other lists only contain the nodes that
+    // render into the respective bin, either as their primary or their secondary bin
+    std::vector<SceneGraphNode*> _visibleNodes;
+    std::array<std::vector<SceneGraphNode*>, NRenderBins> _visibleNodesPerBin;
+    std::vector<bool> _isCandidateCulled;
+    glm::dmat4 _visibleNodesViewProjection = glm::dmat4(1.0);
+    bool _visibleNodesDirty = true;
     std::unordered_map<std::string, SceneGraphNode*> _nodesByIdentifier;
     bool _dirtyNodeRegistry = false;
     SceneGraphNode _rootDummy;
     std::unique_ptr<SceneInitializer> _initializer;
+    /// Nodes that have been initialized but whose OpenGL initialization was deferred as
+    /// the frame budget was used up
+    std::deque<SceneGraphNode*> _nodesToInitializeGL;
     std::string _profilePropertyName;
     std::vector<InterestingTime> _interestingTimes;
     bool _valueIsTable = false;
@@ -341,16 +446,26 @@ private:
     std::set<ghoul::opengl::ProgramObject*> _programsToUpdate;
     std::vector<std::unique_ptr<ghoul::opengl::ProgramObject>> _programs;
 
-    struct PropertyInterpolationInfo {
-        properties::Property* prop;
-        std::chrono::time_point<std::chrono::steady_clock> beginTime;
-        float durationSeconds;
-        std::string postScript;
-
-        ghoul::EasingFunc<float> easingFunction;
-        bool isExpired = false;
+    /// Removes the interpolation at \p index by moving the last interpolation into its
+    /// place
+    void erasePropertyInterpolation(size_t index);
+
+    /// The active interpolations, stored as parallel arrays that are indexed by the same
+    /// position so that each step of an update can run over all Propertys at once
+    struct PropertyInterpolations {
+        std::vector<properties::Property*> props;
+        std::vector<std::chrono::time_point<std::chrono::steady_clock>> beginTimes;
+        std::vector<float> durationSeconds;
+        std::vector<std::string> postScripts;
+        std::vector<ghoul::EasingFunc<float>> easingFunctions;
+
+        // Scratch space for the raw and eased interpolation parameters of an update
+        std::vector<float> t;
+        std::vector<float> easedT;
     };
-    std::vector<PropertyInterpolationInfo> _propertyInterpolationInfos;
+    PropertyInterpolations _propertyInterpolations;
+    /// The position of each Property with an active interpolation in the arrays above
+    std::unordered_map<properties::Property*, size_t> _propertyInterpolationIndices;
 
     ghoul::MemoryPool<4096> _memoryPool;
 };
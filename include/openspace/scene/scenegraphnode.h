@@ -38,6 +38,7 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -61,6 +62,7 @@ struct UpdateData;
 struct SurfacePositionHandle;
 class TimeFrame;
 class Time;
+class WorldTransformCache;
 
 namespace documentation { struct Documentation; }
 
@@ -94,6 +96,40 @@ public:
     void traversePreOrder(const std::function<void(SceneGraphNode*)>& fn);
     void traversePostOrder(const std::function<void(SceneGraphNode*)>& fn);
     void update(const UpdateData& data);
+
+    /**
+     * Updates the Translation, Rotation, and Scale of this node and recomputes the cached
+     * world transformation. Requires the transformation of the parent to be up to date.
+     * Calling this function followed by #updateRenderable is equivalent to #update.
+     *
+     * \return `true` if the node is active and #updateRenderable should be called
+     */
+    bool updateTransform(const UpdateData& data);
+
+    /**
+     * Updates the Translation, Rotation, and Scale of this node. If the node is part of
+     * a WorldTransformCache, only the local transformation is written into the cache and
+     * the world transformation is computed later by a call to
+     * WorldTransformCache::computeWorldTransforms. If the node is not part of a cache,
+     * this function behaves like #updateTransform.
+     *
+     * \return `true` if the node is active and #updateRenderable should be called
+     */
+    bool updateLocalTransform(const UpdateData& data);
+
+    /**
+     * Calls Renderable::update using the cached world transformation of this node. This
+     * function must only be called after a successful call to #updateTransform in the
+     * same frame.
+     */
+    void updateRenderable(const UpdateData& data);
+
+    /**
+     * Returns whether the #updateTransform function can be called from a worker thread.
+     * This is the case if the Translation, Rotation, and Scale are all thread-safe.
+     */
+    bool hasThreadSafeTransform() const;
+
     void render(const RenderData& data, RendererTasks& tasks);
 
     void attachChild(ghoul::mm_unique_ptr<SceneGraphNode> child);
@@ -141,6 +177,10 @@ public:
 
     bool supportsDirectInteraction() const;
 
+    /// Returns whether the screen-space values of this node are computed when it is
+    /// rendered, which requires the node to be rendered even if it is not visible
+    bool computesScreenSpaceValues() const;
+
     SceneGraphNode* childNode(const std::string& identifier);
 
     const Renderable* renderable() const;
@@ -152,13 +192,37 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    friend class WorldTransformCache;
+
+    /**
+     * Moves the storage of the world transformation of this node into the provided
+     * \p cache at the \p index. If \p cache is `nullptr`, the current world
+     * transformation is copied into the local members of this node instead.
+     */
+    void setWorldTransformCache(WorldTransformCache* cache, uint32_t index);
+
     glm::dvec3 calculateWorldPosition() const;
     glm::dmat3 calculateWorldRotation() const;
     glm::dvec3 calculateWorldScale() const;
     void computeScreenSpaceData(RenderData& newData);
     void renderDebugSphere(const Camera& camera, double size, glm::vec4 color);
 
+    /**
+     * If lazy renderable initialization is enabled in the configuration, a renderable
+     * that is disabled when its node is initialized is only initialized once it is
+     * enabled for the first time. Its state is tracked separately from the node, as the
+     * node's transformations are initialized and updated regardless.
+     */
+    enum class RenderableState : int {
+        Uninitialized,
+        Deferred,
+        Initializing,
+        Initialized,
+        GLInitialized
+    };
+
     std::atomic<State> _state = State::Loaded;
+    std::atomic<RenderableState> _renderableState = RenderableState::Uninitialized;
     std::vector<ghoul::mm_unique_ptr<SceneGraphNode>> _children;
     SceneGraphNode* _parent = nullptr;
     std::vector<SceneGraphNode*> _dependencies;
@@ -196,6 +260,11 @@ private:
 
     glm::dmat4 _modelTransformCached = glm::dmat4(1.0);
 
+    // If this node is part of a scene, its world transformation is stored in the
+    // scene's cache instead of the members above
+    WorldTransformCache* _transformCache = nullptr;
+    uint32_t _transformIndex = std::numeric_limits<uint32_t>::max();
+
     properties::DoubleProperty _boundingSphere;
     properties::DoubleProperty _interactionSphere;
     properties::DoubleProperty _approachFactor;
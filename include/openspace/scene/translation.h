@@ -53,6 +53,25 @@ public:
 
     virtual glm::dvec3 position(const UpdateData& data) const = 0;
 
+    /**
+     * Returns whether the #update and #position functions of this translation can be
+     * called from a worker thread concurrently with other Translation%s. Translations
+     * that access shared state that is not thread-safe (such as CSPICE, a Lua state, or
+     * the data of other scene graph nodes) have to return `false` here, which causes the
+     * owning SceneGraphNode to be updated on the main thread.
+     *
+     * \return `true` if this translation can be updated from a worker thread
+     */
+    virtual bool isThreadSafe() const;
+
+    /**
+     * Returns whether the position has changed during the last call to #update. This can
+     * be used to skip any expensive computations that depend on the position.
+     *
+     * \return `true` if the position changed during the last call to #update
+     */
+    bool hasChanged() const;
+
     // Registers a callback that gets called when a significant change has been made that
     // invalidates potentially stored points, for example in trails
     void onParameterChange(std::function<void()> callback);
@@ -65,6 +84,7 @@ protected:
 
 private:
     bool _needsUpdate = true;
+    bool _hasChanged = true;
     double _cachedTime = -std::numeric_limits<double>::max();
     glm::dvec3 _cachedPosition = glm::dvec3(0.0);
     std::function<void()> _onParameterChangeCallback;
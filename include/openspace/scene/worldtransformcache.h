@@ -0,0 +1,188 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___WORLDTRANSFORMCACHE___H__
+#define __OPENSPACE_CORE___WORLDTRANSFORMCACHE___H__
+
+#include <ghoul/glm.h>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace openspace {
+
+class SceneGraphNode;
+
+/**
+ * A structure-of-arrays store for the local and world transformations of the scene graph
+ * nodes of a Scene. The entries are ordered such that the parent of a node is always
+ * stored before the node itself, which makes it possible to compute the world
+ * transformations of a contiguous range of nodes in a single loop without following any
+ * parent pointers. The contiguous arrays of world transformations can also be consumed
+ * directly by render passes that need the transformations of many nodes.
+ *
+ * Every scene graph node that is part of the cache stores its index and reads its world
+ * transformation from here instead of from its own members.
+ */
+class WorldTransformCache {
+public:
+    static constexpr uint32_t NoIndex = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * Rebuilds the cache for the provided \p nodes and assigns each node the index of its
+     * position in the list. The last known world transformation of each node is carried
+     * over so that it stays valid until the node is updated the next time. Nodes that
+     * were part of the cache before, but are no longer part of \p nodes, are removed
+     * from the cache and keep their last world transformation locally.
+     *
+     * \param nodes The list of nodes that should be stored in the cache
+     *
+     * \pre The parent of every node in \p nodes must appear before the node itself
+     */
+    void rebuild(const std::vector<SceneGraphNode*>& nodes);
+
+    /**
+     * Removes the \p node from this cache. The node keeps its last world transformation
+     * locally. The slot in the cache becomes inactive until the next #rebuild.
+     *
+     * \param node The node that should be removed from the cache
+     */
+    void remove(SceneGraphNode* node);
+
+    /**
+     * Removes all nodes from this cache.
+     */
+    void clear();
+
+    /**
+     * Stores the local \p position, \p rotation, and \p scale of the node at \p index and
+     * marks the node as active for the world transformation pass. The world
+     * transformation of the node is only recomputed if \p hasChanged is `true`, if the
+     * world transformation of its parent has changed in the same frame, or if the node
+     * was inactive in the previous frame.
+     */
+    void setLocalTransform(uint32_t index, const glm::dvec3& position,
+        const glm::dmat3& rotation, const glm::dvec3& scale, bool hasChanged);
+
+    /**
+     * Marks the node at \p index as inactive for this frame, for example because its
+     * time frame is not active. World transformations of inactive nodes are not
+     * recomputed and keep their previous values.
+     */
+    void setInactive(uint32_t index);
+
+    bool isActive(uint32_t index) const;
+
+    /**
+     * Returns whether the world transformation of the node at \p index was recomputed
+     * during the last call to #computeWorldTransforms that included the node.
+     */
+    bool hasChanged(uint32_t index) const;
+
+    /**
+     * Computes the world transformation of all active nodes in the range
+     * [\p begin, \p end) whose local transformation, or the world transformation of
+     * their parent, has changed. All parents of nodes in this range must either be
+     * located before \p begin and already have been updated, or be part of the range.
+     */
+    void computeWorldTransforms(uint32_t begin, uint32_t end);
+
+    /**
+     * Computes the world transformation of the single node at \p index.
+     */
+    void computeWorldTransform(uint32_t index);
+
+    /**
+     * Computes the transformation from the model space into the view space of the camera
+     * for every node in the cache. The world position of each node is made relative to
+     * the \p cameraPosition before the \p cameraRelativeView matrix is applied (see
+     * Camera::cameraRelativeViewMatrix), which keeps the full precision even if the node
+     * and the camera are far away from the origin. The transformations are only
+     * recomputed if the camera or any world transformation has changed since the last
+     * call.
+     */
+    void computeModelViewTransforms(const glm::dvec3& cameraPosition,
+        const glm::dmat4& cameraRelativeView);
+
+    /**
+     * Returns the same transformation as #computeModelViewTransforms for a node with the
+     * world \p position, \p rotation, and \p scale that is not part of a cache.
+     */
+    static glm::dmat4 modelViewTransform(const glm::dvec3& position,
+        const glm::dmat3& rotation, const glm::dvec3& scale,
+        const glm::dvec3& cameraPosition, const glm::dmat4& cameraRelativeView);
+
+    const glm::dvec3& worldPosition(uint32_t index) const;
+    const glm::dmat3& worldRotation(uint32_t index) const;
+    const glm::dvec3& worldScale(uint32_t index) const;
+    const glm::dmat4& modelTransform(uint32_t index) const;
+    const glm::dmat4& modelViewTransform(uint32_t index) const;
+
+    std::span<const glm::dvec3> worldPositions() const;
+    std::span<const glm::dmat3> worldRotations() const;
+    std::span<const glm::dvec3> worldScales() const;
+    std::span<const glm::dmat4> modelTransforms() const;
+    std::span<const glm::dmat4> modelViewTransforms() const;
+
+    /**
+     * Returns the node that is stored at the provided \p index or `nullptr` if the node
+     * has been removed from the cache since the last #rebuild.
+     */
+    SceneGraphNode* node(uint32_t index) const;
+
+    size_t size() const;
+
+private:
+    void setWorldTransform(uint32_t index, const glm::dvec3& position,
+        const glm::dmat3& rotation, const glm::dvec3& scale);
+
+    std::vector<SceneGraphNode*> _nodes;
+    std::vector<uint32_t> _parentIndices;
+    std::vector<uint8_t> _isActive;
+    // Set if the local transformation has changed since the last world transform pass
+    std::vector<uint8_t> _isDirty;
+    // Set if the world transformation was recomputed during the last pass
+    std::vector<uint8_t> _hasChanged;
+
+    std::vector<glm::dvec3> _localPositions;
+    std::vector<glm::dmat3> _localRotations;
+    std::vector<glm::dvec3> _localScales;
+
+    std::vector<glm::dvec3> _worldPositions;
+    std::vector<glm::dmat3> _worldRotations;
+    std::vector<glm::dvec3> _worldScales;
+    std::vector<glm::dmat4> _modelTransforms;
+
+    std::vector<glm::dmat4> _modelViewTransforms;
+    // The camera for which the _modelViewTransforms were computed
+    glm::dvec3 _modelViewCameraPosition = glm::dvec3(0.0);
+    glm::dmat4 _modelViewCameraMatrix = glm::dmat4(1.0);
+    // Cleared whenever a world transformation changes
+    bool _hasValidModelViewTransforms = false;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___WORLDTRANSFORMCACHE___H__
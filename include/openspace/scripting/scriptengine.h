@@ -28,13 +28,16 @@
 #include <openspace/util/syncable.h>
 #include <openspace/scripting/lualibrary.h>
 #include <openspace/json.h>
+#include <openspace/util/framebudget.h>
 #include <ghoul/lua/luastate.h>
 #include <ghoul/misc/boolean.h>
+#include <chrono>
 #include <filesystem>
 #include <mutex>
 #include <optional>
 #include <queue>
 #include <functional>
+#include <unordered_map>
 
 namespace openspace { class SyncBuffer; }
 
@@ -59,6 +62,20 @@ public:
         ScriptCallback callback;
     };
 
+    /// Timing information about the garbage collection steps run by #collectGarbage
+    struct GarbageCollectionStatistics {
+        /// The number of incremental steps that have been run
+        uint64_t nSteps = 0;
+        /// The number of garbage collection cycles that have been completed
+        uint64_t nCycles = 0;
+        /// The time spent collecting garbage in the last frame
+        std::chrono::microseconds lastDuration = std::chrono::microseconds(0);
+        /// The longest time spent collecting garbage in a single frame
+        std::chrono::microseconds maxDuration = std::chrono::microseconds(0);
+        /// The total time spent collecting garbage
+        std::chrono::microseconds totalDuration = std::chrono::microseconds(0);
+    };
+
     static constexpr std::string_view OpenSpaceLibraryName = "openspace";
 
     ScriptEngine();
@@ -85,6 +102,7 @@ public:
     bool runScriptFile(const std::filesystem::path& filename);
 
     virtual void preSync(bool isMaster) override;
+    virtual bool hasChanged() const override;
     virtual void encode(SyncBuffer* syncBuffer) override;
     virtual void decode(SyncBuffer* syncBuffer) override;
     virtual void postSync(bool isMaster) override;
@@ -92,6 +110,20 @@ public:
     void queueScript(std::string script, RemoteScripting remoteScripting,
         ScriptCallback cb = ScriptCallback());
 
+    /**
+     * Runs incremental garbage collection steps on the Lua state until the \p budget for
+     * the current frame is used up or a collection cycle has been completed. At least one
+     * step is run per call so that the collection keeps pace with the allocations even if
+     * the frame is over budget. This function should be called once per frame after all
+     * scripts of that frame have been run.
+     */
+    void collectGarbage(const FrameBudget& budget);
+
+    const GarbageCollectionStatistics& garbageCollectionStatistics() const;
+
+    /// Returns the amount of memory, in bytes, that is used by the Lua state
+    size_t luaMemoryUsage();
+
     std::vector<std::string> allLuaFunctions() const;
 
     nlohmann::json generateJson() const;
@@ -101,6 +133,16 @@ private:
 
     void writeLog(const std::string& script);
 
+    /**
+     * Runs the \p script using a compiled chunk from #_compiledScripts, compiling and
+     * caching it first if this script has not been run before. Scripts that are queued
+     * repeatedly, such as property setters bound to GUI toggles, therefore only pay the
+     * Lua compilation cost once.
+     *
+     * \throw ghoul::lua::LuaRuntimeException If the script cannot be loaded or fails
+     */
+    void runCompiledScript(const std::string& script);
+
     bool registerLuaLibrary(lua_State* state, LuaLibrary& library);
     void addLibraryFunctions(lua_State* state, LuaLibrary& library, Replace replace);
 
@@ -121,6 +163,11 @@ private:
 
     std::vector<std::string> _scriptsToSync;
 
+    // Registry references to the compiled chunks of previously run scripts
+    std::unordered_map<std::string, int> _compiledScripts;
+
+    GarbageCollectionStatistics _garbageCollectionStatistics;
+
     // Logging variables
     bool _logFileExists = false;
     bool _logScripts = true;
@@ -62,6 +62,11 @@ public:
         std::string universalScript;
 
         int group = 0;
+
+        /// Identifies the state that this script sets, for example the URI of the
+        /// property it changes. If a time jump passes over multiple scripts with the
+        /// same key, only the last of them is executed
+        std::string key;
     };
 
     /**
@@ -92,7 +97,8 @@ public:
     /**
     * Progresses the script schedulers time and returns all scripts that has been
     * scheduled to run between \p newTime and the time provided in the last invocation
-    * of this method.
+    * of this method. Of multiple scripts that share the same ScheduledScript::key, only
+    * the one that would be executed last is returned.
     *
     * \param newTime A j2000 time value specifying the new time stamp that
     * the script scheduler should progress to.
@@ -0,0 +1,99 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___BENCHMARKRUNNER___H__
+#define __OPENSPACE_CORE___BENCHMARKRUNNER___H__
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * The BenchmarkRunner plays back a session recording with a fixed time step per frame
+ * once the profile has been loaded and records the duration of each frame, the CPU and
+ * GPU timings of its phases as measured by the FrameProfiler, and the memory used by
+ * the process. The playback waits for the tiles of the focus node to finish loading
+ * before advancing, so that every run renders the same frames with the same data. When
+ * the playback has finished, the results are written as a JSON report and the
+ * application is terminated.
+ *
+ * The runner has to be registered as a postDraw callback before the first frame.
+ */
+class BenchmarkRunner {
+public:
+    struct Settings {
+        /// The session recording that is played back, either as an absolute path or
+        /// relative to the `${RECORDINGS}` folder
+        std::string recording;
+        /// The path to which the JSON report is written
+        std::filesystem::path report;
+        /// The number of frames per second of recorded time that are rendered
+        int fps = 60;
+    };
+
+    explicit BenchmarkRunner(Settings settings);
+
+    /// Advances the benchmark. Has to be called once at the end of every frame
+    void postDraw();
+
+private:
+    enum class State {
+        Loading = 0,
+        Running,
+        Finished
+    };
+
+    /// The measurements of a single frame
+    struct Frame {
+        /// The time between the end of the previous frame and the end of this frame
+        double durationMs = 0.0;
+        /// The resident memory of the process at the end of the frame
+        uint64_t memory = 0;
+        /// The total time per phase name in this frame, separately for CPU and GPU
+        std::map<std::string, double> cpuMs;
+        std::map<std::string, double> gpuMs;
+    };
+
+    void start();
+    void collectEvents();
+    void finish();
+    void writeReport() const;
+
+    Settings _settings;
+    State _state = State::Loading;
+    std::chrono::steady_clock::time_point _lastFrameEnd;
+    uint32_t _firstFrame = 0;
+    uint64_t _eventCursor = 0;
+
+    std::map<uint32_t, Frame> _frames;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___BENCHMARKRUNNER___H__
@@ -0,0 +1,106 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___BOUNDED_CONCURRENT_QUEUE___H__
+#define __OPENSPACE_CORE___BOUNDED_CONCURRENT_QUEUE___H__
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * Templated lock-free multi-producer/multi-consumer queue with a fixed capacity, based
+ * on the bounded queue by Dmitry Vyukov. In contrast to the ConcurrentQueue, none of the
+ * functions block; pushing into a full queue or popping from an empty queue fails
+ * instead. The type \p T has to be default constructible and move assignable.
+ */
+template <typename T>
+class BoundedConcurrentQueue {
+public:
+    /**
+     * Creates a queue that can hold at least \p capacity items. The capacity is rounded
+     * up to the next power of two.
+     */
+    BoundedConcurrentQueue(size_t capacity);
+
+    /**
+     * Adds the \p item to the end of the queue if the queue is not full.
+     *
+     * \return `true` if the item was added, `false` if the queue was full
+     */
+    bool tryPush(const T& item);
+    bool tryPush(T&& item);
+
+    /**
+     * Removes the first item from the queue and stores it in \p item if the queue is not
+     * empty.
+     *
+     * \return `true` if an item was removed, `false` if the queue was empty
+     */
+    bool tryPop(T& item);
+
+    /**
+     * Removes up to \p maxItems items from the front of the queue and appends them to
+     * \p items.
+     *
+     * \return The number of items that were removed
+     */
+    size_t tryPopBatch(std::vector<T>& items, size_t maxItems);
+
+    /**
+     * Returns the number of items in the queue. As other threads can modify the queue
+     * concurrently, the returned value is only an approximation.
+     */
+    size_t size() const;
+
+    bool empty() const;
+
+    size_t capacity() const;
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    template <typename U>
+    bool push(U&& item);
+
+    const size_t _mask;
+    std::unique_ptr<Cell[]> _buffer;
+
+    // The positions are kept on separate cache lines to prevent false sharing between
+    // the producers and the consumers
+    alignas(64) std::atomic<size_t> _enqueuePosition = 0;
+    alignas(64) std::atomic<size_t> _dequeuePosition = 0;
+};
+
+} // namespace openspace
+
+#include "boundedconcurrentqueue.inl"
+
+#endif // __OPENSPACE_CORE___BOUNDED_CONCURRENT_QUEUE___H__
@@ -0,0 +1,148 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <algorithm>
+#include <bit>
+
+namespace openspace {
+
+template <typename T>
+BoundedConcurrentQueue<T>::BoundedConcurrentQueue(size_t capacity)
+    : _mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1)
+    , _buffer(std::make_unique<Cell[]>(_mask + 1))
+{
+    // The sequence number of a cell is equal to the position at which the next item can
+    // be pushed into it
+    for (size_t i = 0; i <= _mask; i++) {
+        _buffer[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool BoundedConcurrentQueue<T>::tryPush(const T& item) {
+    return push(item);
+}
+
+template <typename T>
+bool BoundedConcurrentQueue<T>::tryPush(T&& item) {
+    return push(std::move(item));
+}
+
+template <typename T>
+template <typename U>
+bool BoundedConcurrentQueue<T>::push(U&& item) {
+    Cell* cell = nullptr;
+    size_t pos = _enqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &_buffer[pos & _mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff =
+            static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            // The cell is free, so we try to claim it
+            if (_enqueuePosition.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed
+               ))
+            {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The cell still contains the item from the previous lap: the queue is full
+            return false;
+        }
+        else {
+            // Another producer claimed the cell before us
+            pos = _enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->data = std::forward<U>(item);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool BoundedConcurrentQueue<T>::tryPop(T& item) {
+    Cell* cell = nullptr;
+    size_t pos = _dequeuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &_buffer[pos & _mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        const std::ptrdiff_t diff =
+            static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (diff == 0) {
+            // The cell contains an item, so we try to claim it
+            if (_dequeuePosition.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed
+               ))
+            {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The cell has not been written yet: the queue is empty
+            return false;
+        }
+        else {
+            // Another consumer claimed the cell before us
+            pos = _dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    item = std::move(cell->data);
+    // Mark the cell as free for the producer one lap ahead
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+size_t BoundedConcurrentQueue<T>::tryPopBatch(std::vector<T>& items, size_t maxItems) {
+    size_t nPopped = 0;
+    T item;
+    while (nPopped < maxItems && tryPop(item)) {
+        items.push_back(std::move(item));
+        nPopped++;
+    }
+    return nPopped;
+}
+
+template <typename T>
+size_t BoundedConcurrentQueue<T>::size() const {
+    const size_t dequeue = _dequeuePosition.load(std::memory_order_relaxed);
+    const size_t enqueue = _enqueuePosition.load(std::memory_order_relaxed);
+    return enqueue > dequeue ? std::min(enqueue - dequeue, _mask + 1) : 0;
+}
+
+template <typename T>
+bool BoundedConcurrentQueue<T>::empty() const {
+    return size() == 0;
+}
+
+template <typename T>
+size_t BoundedConcurrentQueue<T>::capacity() const {
+    return _mask + 1;
+}
+
+} // namespace openspace
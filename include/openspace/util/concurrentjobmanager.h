@@ -25,10 +25,11 @@
 #ifndef __OPENSPACE_CORE___CONCURRENT_JOB_MANAGER___H__
 #define __OPENSPACE_CORE___CONCURRENT_JOB_MANAGER___H__
 
-#include <openspace/util/concurrentqueue.h>
+#include <openspace/util/boundedconcurrentqueue.h>
 #include <openspace/util/threadpool.h>
 
-#include <mutex>
+#include <atomic>
+#include <memory>
 
 namespace openspace {
 
@@ -41,7 +42,13 @@ template <typename T> struct Job;
 template<typename P>
 class ConcurrentJobManager {
 public:
-    ConcurrentJobManager(ThreadPool pool);
+    /**
+     * Creates a job manager that executes the jobs on the \p pool. At most
+     * \p maxFinishedJobs finished jobs are stored; if that number is reached, the
+     * workers wait until jobs have been popped before storing more.
+     */
+    ConcurrentJobManager(ThreadPool pool, size_t maxFinishedJobs = 1024);
+    ~ConcurrentJobManager();
 
     void enqueueJob(std::shared_ptr<Job<P>> job);
 
@@ -52,8 +59,9 @@ public:
     size_t numFinishedJobs() const;
 
 private:
-    ConcurrentQueue<std::shared_ptr<Job<P>>> _finishedJobs;
-    std::mutex _finishedJobsMutex;
+    BoundedConcurrentQueue<std::shared_ptr<Job<P>>> _finishedJobs;
+    // Must be declared before the threadPool as the workers read it during destruction
+    std::atomic_bool _isStopping = false;
     ThreadPool threadPool;
 };
 
@@ -24,20 +24,34 @@
 
 #include <openspace/util/job.h>
 #include <ghoul/misc/assert.h>
+#include <thread>
 
 namespace openspace {
 
 template<typename P>
-ConcurrentJobManager<P>::ConcurrentJobManager(ThreadPool pool)
-    : threadPool(pool)
+ConcurrentJobManager<P>::ConcurrentJobManager(ThreadPool pool, size_t maxFinishedJobs)
+    : _finishedJobs(maxFinishedJobs)
+    , threadPool(pool)
 {}
 
+template<typename P>
+ConcurrentJobManager<P>::~ConcurrentJobManager() {
+    // Workers that are waiting for room in the full queue of finished jobs would never
+    // return as nobody pops from it anymore, which would block the pool's destructor
+    _isStopping = true;
+    threadPool.clearTasks();
+}
+
 template<typename P>
 void ConcurrentJobManager<P>::enqueueJob(std::shared_ptr<Job<P>> job) {
     threadPool.enqueue([this, job]() {
         job->execute();
-        std::lock_guard lock(_finishedJobsMutex);
-        _finishedJobs.push(job);
+        while (!_finishedJobs.tryPush(job)) {
+            if (_isStopping) {
+                return;
+            }
+            std::this_thread::yield();
+        }
     });
 }
 
@@ -50,8 +64,9 @@ template<typename P>
 std::shared_ptr<Job<P>> ConcurrentJobManager<P>::popFinishedJob() {
     ghoul_assert(!_finishedJobs.empty(), "There is no finished job to pop");
 
-    std::lock_guard lock(_finishedJobsMutex);
-    return _finishedJobs.pop();
+    std::shared_ptr<Job<P>> job;
+    _finishedJobs.tryPop(job);
+    return job;
 }
 
 template<typename P>
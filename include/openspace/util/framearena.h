@@ -0,0 +1,127 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___FRAMEARENA___H__
+#define __OPENSPACE_CORE___FRAMEARENA___H__
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * A monotonic memory resource for allocations that only live for a short time, for
+ * example for the duration of a frame. Memory is handed out by advancing an offset into
+ * a set of blocks and individual deallocations are ignored; instead all memory is
+ * released at once by calling #reset or, for a part of the allocations, by rewinding to
+ * a Marker. The blocks are kept between resets so that, after a few frames, no further
+ * heap allocations are necessary. The FrameArena is not thread-safe; worker threads
+ * should use their own arena that is returned by #threadArena.
+ */
+class FrameArena : public std::pmr::memory_resource {
+public:
+    /// Describes a position in the arena to which it can be rewound
+    struct Marker {
+        size_t block = 0;
+        size_t offset = 0;
+        size_t usedBytes = 0;
+    };
+
+    /**
+     * RAII helper that rewinds the arena to the position at which it was created when it
+     * goes out of scope.
+     */
+    struct Scope {
+        Scope(FrameArena& arena);
+        ~Scope();
+
+        FrameArena& arena;
+        Marker marker;
+    };
+
+    /**
+     * Creates an arena whose first block is \p initialSize bytes large. When the arena is
+     * reset, at most \p maxRetainedSize bytes are kept for the next use.
+     */
+    explicit FrameArena(size_t initialSize, size_t maxRetainedSize = 64 * 1024 * 1024);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * Releases all allocations. If more than one block was needed since the last reset,
+     * the blocks are replaced by a single block that is large enough to hold the same
+     * number of bytes, unless that would exceed the maximum retained size.
+     */
+    void reset();
+
+    Marker marker() const;
+
+    /**
+     * Releases all allocations that have been made since the \p marker was created.
+     */
+    void rewind(const Marker& marker);
+
+    /// Returns the number of bytes that have been allocated since the last reset
+    size_t usedBytes() const;
+
+    /// Returns the largest number of bytes that were allocated between two resets
+    size_t highWaterMark() const;
+
+    /// Returns the number of bytes that are currently reserved by the arena
+    size_t capacity() const;
+
+    /**
+     * Returns an arena that belongs to the calling thread. It is never reset
+     * automatically, so allocations should be made within a Scope.
+     */
+    static FrameArena& threadArena();
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+    };
+
+    std::vector<Block> _blocks;
+    size_t _currentBlock = 0;
+    size_t _offset = 0;
+
+    size_t _usedBytes = 0;
+    size_t _highWaterMark = 0;
+    // The largest number of bytes that were in use at the same time since the last reset
+    size_t _peakBytes = 0;
+    const size_t _initialSize;
+    const size_t _maxRetainedSize;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___FRAMEARENA___H__
@@ -0,0 +1,67 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___FRAMEBUDGET___H__
+#define __OPENSPACE_CORE___FRAMEBUDGET___H__
+
+#include <chrono>
+#include <optional>
+
+namespace openspace {
+
+/**
+ * Keeps track of how much of the time that is budgeted for a single frame has been used.
+ * Work that can be postponed to a later frame without visible artifacts, such as the
+ * OpenGL initialization of newly loaded scene graph nodes or tile uploads, checks
+ * #hasTimeRemaining before each unit of work and defers the rest once the budget is used
+ * up. Every such consumer still has to make progress by at least one unit per frame so
+ * that its work is not starved if the frame alone takes longer than the budget.
+ *
+ * The time is measured from the last call to #beginFrame. There is no limit before the
+ * first frame has begun, for example while the initial assets are loaded, or if the
+ * budget is 0. All functions have to be called from the main thread.
+ */
+class FrameBudget {
+public:
+    /// Marks the beginning of a new frame from which the used time is measured
+    void beginFrame();
+
+    /// Sets the time that is available per frame. A budget of 0 disables the limit
+    void setBudget(std::chrono::microseconds budget);
+    std::chrono::microseconds budget() const;
+
+    /**
+     * Returns `true` if the time that has passed since the beginning of the frame is
+     * smaller than the budget or if there is no limit.
+     */
+    bool hasTimeRemaining() const;
+
+private:
+    std::chrono::microseconds _budget = std::chrono::microseconds(0);
+    std::optional<std::chrono::steady_clock::time_point> _frameBegin;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___FRAMEBUDGET___H__
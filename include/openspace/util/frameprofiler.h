@@ -0,0 +1,171 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___FRAMEPROFILER___H__
+#define __OPENSPACE_CORE___FRAMEPROFILER___H__
+
+#include <ghoul/misc/boolean.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * The FrameProfiler records the CPU and GPU durations of the phases of a frame into a
+ * ring buffer of fixed size, so that the performance can be inspected without a build
+ * that has Tracy enabled. Phases are recorded with the Scope helper, which optionally
+ * also measures the time that the GPU spent on the commands that were issued within it
+ * using OpenGL timestamp queries. As the results of these queries only become available
+ * a few frames later, the GPU durations are collected in #beginFrame.
+ *
+ * The recorded phases can be inspected using #phaseStatistics or exported using
+ * #saveChromeTrace into a JSON file that can be opened in `chrome://tracing` or Perfetto.
+ * The profiler is disabled by default, in which case a Scope does not do any work.
+ */
+class FrameProfiler {
+public:
+    BooleanType(Gpu);
+
+    /// A single recorded phase
+    struct Event {
+        /// The name of the phase; this has to be a string literal
+        const char* name = nullptr;
+        /// The beginning of the phase in nanoseconds since the profiler was created
+        uint64_t begin = 0;
+        /// The duration of the phase in nanoseconds
+        uint64_t duration = 0;
+        /// The frame in which the phase was recorded
+        uint32_t frame = 0;
+        /// A sequential number identifying the thread on which the phase was recorded
+        uint16_t thread = 0;
+        /// The number of enclosing phases on the same thread
+        uint8_t depth = 0;
+        /// Whether this event measures GPU or CPU time
+        bool isGpu = false;
+    };
+
+    /// The timings of one phase aggregated over all frames that are in the ring buffer
+    struct PhaseStatistics {
+        const char* name = nullptr;
+        bool isGpu = false;
+        uint8_t depth = 0;
+        double lastMs = 0.0;
+        double averageMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    /**
+     * Measures the time between its construction and destruction and records it as a
+     * phase with the provided \p name, which has to be a string literal. If \p gpu is
+     * `Yes`, the GPU time of the OpenGL commands issued in the meantime is also
+     * recorded; this must only be used on the thread that owns the OpenGL context.
+     */
+    class Scope {
+    public:
+        Scope(const char* name, Gpu gpu = Gpu::No);
+        ~Scope();
+
+    private:
+        const char* _name;
+        int _gpuQuery = -1;
+        uint64_t _begin = 0;
+        uint8_t _depth = 0;
+        bool _isActive;
+    };
+
+    explicit FrameProfiler(size_t capacity = 16384);
+    ~FrameProfiler();
+
+    /**
+     * Marks the start of a new frame and collects the results of the GPU timer queries
+     * that have become available since the last call. Has to be called on the thread
+     * that owns the OpenGL context.
+     */
+    void beginFrame();
+
+    /// Releases the OpenGL query objects. Has to be called while the context is current
+    void deinitializeGL();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    /// Returns the number of the frame that is currently being recorded
+    uint32_t frame() const;
+
+    /// Returns a copy of all recorded events, ordered by the time they were recorded
+    std::vector<Event> events() const;
+
+    /**
+     * Returns the events that were recorded since the last call with the same \p cursor
+     * and advances it past them. A new cursor has to start at 0. Events that have been
+     * overwritten in the ring buffer since the last call are skipped.
+     */
+    std::vector<Event> newEvents(uint64_t& cursor) const;
+
+    /// Returns the aggregated timings of each phase, in the order they first occurred
+    std::vector<PhaseStatistics> phaseStatistics() const;
+
+    /**
+     * Writes all recorded events to \p path in the Chrome trace event JSON format.
+     */
+    void saveChromeTrace(const std::filesystem::path& path) const;
+
+private:
+    struct GpuQuery {
+        const char* name = nullptr;
+        unsigned int queries[2] = { 0, 0 };
+        uint32_t frame = 0;
+        uint8_t depth = 0;
+    };
+
+    void record(const Event& event);
+    int beginGpuQuery(const char* name, uint8_t depth);
+    void endGpuQuery(int index);
+    uint64_t now() const;
+
+    const std::chrono::steady_clock::time_point _epoch;
+    std::atomic_bool _isEnabled = false;
+    std::atomic<uint32_t> _frame = 0;
+
+    mutable std::mutex _mutex;
+    std::vector<Event> _events;
+    size_t _nextEvent = 0;
+    bool _hasWrapped = false;
+    uint64_t _nRecordedEvents = 0;
+
+    // These are only accessed from the thread that owns the OpenGL context
+    std::vector<GpuQuery> _gpuQueries;
+    std::vector<int> _pendingGpuQueries;
+    std::vector<int> _freeGpuQueries;
+    int64_t _gpuClockOffset = 0;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___FRAMEPROFILER___H__
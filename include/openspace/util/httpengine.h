@@ -0,0 +1,194 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___HTTPENGINE___H__
+#define __OPENSPACE_CORE___HTTPENGINE___H__
+
+#include <openspace/util/httprequest.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * The HttpEngine performs all HTTP transfers of the application on a single thread using
+ * a curl multi handle. All transfers share one connection cache, so that connections to
+ * the same server are reused, and are multiplexed over a single connection if the server
+ * supports HTTP/2. At most #MaxActiveTransfers are active at the same time; any
+ * additional transfer is queued until a slot becomes available. Of these slots,
+ * #ReservedHighPriorityTransfers are kept free for transfers with a high priority, so
+ * that these do not have to wait for long downloads to finish. Queued transfers are
+ * started in the order of their Priority, and transfers with the same priority are
+ * started in the order in which they were submitted. For HTTP/2 connections, the priority
+ * is also passed to the server as the stream weight, so that the bandwidth of a shared
+ * connection is distributed according to the priority.
+ *
+ * All callbacks of a transfer are called on the thread of the HttpEngine and should
+ * therefore return quickly, as they would otherwise stall all other transfers.
+ */
+class HttpEngine {
+public:
+    /// The priority with which transfers are started and share the bandwidth
+    enum class Priority {
+        /// Transfers that can happen in the background, such as prefetching
+        Low = 0,
+        /// Downloads of files, for example for resource synchronizations
+        Normal,
+        /// Requests that a caller is actively waiting for
+        High
+    };
+
+    /// The outcome of a transfer that is passed to the Transfer::onFinish callback
+    struct Result {
+        /// `true` if the transfer completed without a transport error and was not
+        /// cancelled. Responses with an error status code still count as completed
+        bool isComplete = false;
+
+        /// The HTTP response code, or 0 if no response was received
+        long responseCode = 0;
+
+        /// The value of the Content-Type header of the response, if one was received
+        std::string contentType;
+
+        /// A description of the error if the transfer did not complete
+        std::string error;
+    };
+
+    struct Transfer {
+        std::string url;
+
+        /// The time after which the transfer is aborted. If this is 0, there is no limit
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0);
+
+        Priority priority = Priority::Normal;
+
+        /// If this is `true`, only the header of the response is requested
+        bool headerOnly = false;
+
+        /// If this is `false`, the certificate of the server is not verified
+        bool verifyPeer = true;
+
+        /// Additional headers, such as `If-None-Match: "abc"`, that are sent with the
+        /// request
+        std::vector<std::string> requestHeaders;
+
+        /// Called when the transfer leaves the queue and before any data is transferred.
+        /// If this returns `false`, the transfer is finished without being performed
+        std::function<bool()> onStart;
+
+        HttpRequest::HeaderCallback onHeader;
+        HttpRequest::DataCallback onData;
+        HttpRequest::ProgressCallback onProgress;
+
+        /// Called exactly once for every submitted transfer when it has finished, has
+        /// failed, or was cancelled
+        std::function<void(const Result&)> onFinish;
+    };
+
+    /// The identifier of a submitted transfer that can be used to cancel it
+    using TransferId = uint64_t;
+
+    /// The maximum number of transfers that are performed concurrently
+    static constexpr int MaxActiveTransfers = 16;
+
+    /// The number of the #MaxActiveTransfers slots that can only be used by transfers
+    /// with Priority::High
+    static constexpr int ReservedHighPriorityTransfers = 2;
+
+    static void initialize();
+    static void deinitialize();
+    static bool isInitialized();
+    static HttpEngine& ref();
+
+    HttpEngine();
+
+    /**
+     * Finishes all transfers that are still queued or active as cancelled and stops the
+     * thread of the HttpEngine.
+     */
+    ~HttpEngine();
+
+    /**
+     * Queues the \p transfer to be performed as soon as there is an available slot and
+     * no transfer with a higher priority is waiting. This function can be called from
+     * any thread, including from inside the callbacks of another transfer.
+     *
+     * \return The identifier with which the transfer can be cancelled
+     */
+    TransferId submit(Transfer transfer);
+
+    /**
+     * Cancels the transfer with the provided \p id. If the transfer is still queued, it
+     * is removed from the queue, otherwise it is aborted. In both cases, its onFinish
+     * callback is called on the thread of the HttpEngine. Cancelling a transfer that has
+     * already finished does nothing.
+     */
+    void cancel(TransferId id);
+
+private:
+    struct ActiveTransfer;
+
+    /// The main loop of the HttpEngine's thread
+    void run();
+
+    /// Starts queued transfers until all slots are used or the queue is empty
+    void startQueuedTransfers();
+
+    /// Aborts the transfers whose cancellation was requested since the last call
+    void processCancellations();
+
+    /// Removes the \p transfer from the multi handle and calls its onFinish callback
+    void finishTransfer(ActiveTransfer* transfer, Result result);
+
+    /// Wakes up the thread if it is waiting for network activity
+    void wakeUp();
+
+    static HttpEngine* _instance;
+
+    /// The curl multi handle that drives all active transfers
+    void* _multiHandle = nullptr;
+
+    std::vector<std::unique_ptr<ActiveTransfer>> _activeTransfers;
+
+    std::mutex _mutex;
+    /// The submitted transfers that have not been started yet, one queue per priority
+    std::array<std::deque<std::pair<TransferId, Transfer>>, 3> _queuedTransfers;
+    std::vector<TransferId> _cancellations;
+    TransferId _nextId = 1;
+    bool _shouldStop = false;
+
+    std::thread _thread;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___HTTPENGINE___H__
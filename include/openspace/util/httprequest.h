@@ -28,12 +28,14 @@
 #include <ghoul/misc/boolean.h>
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <string>
-#include <thread>
+#include <string_view>
 #include <vector>
 #include <chrono>
 
@@ -46,6 +48,11 @@ namespace openspace {
  * functions will overwrite any previously registered handler.
  * The ProgressCallback can be used to stop the download if the handler returns `false`.
  *
+ * The request is performed by the HttpEngine with a high priority while the calling
+ * thread is blocked, so the callbacks are called on the HttpEngine's thread. For the
+ * same reason, a request must not be performed from within the callback of another
+ * request.
+ *
  * The workflow for this class:
  * 1. Create a new object with the URL that points to the location from which the data
  *    should be loaded
@@ -230,10 +237,15 @@ public:
     void onProgress(HttpRequest::ProgressCallback progressCallback);
 
     /**
-     * Starts the asynchronous download of the file by starting a new thread that will
-     * take care of the download, meaning that this function will return almost
-     * instantaneously. If the HttpDownload is already downloading a file this function
-     * does nothing.
+     * Sets additional \p headers, for example `If-None-Match` for a conditional request,
+     * that are sent with the request. This function has to be called before #start.
+     */
+    void setRequestHeaders(std::vector<std::string> headers);
+
+    /**
+     * Starts the asynchronous download of the file by queueing it in the HttpEngine,
+     * meaning that this function will return almost instantaneously. If the HttpDownload
+     * is already downloading a file this function does nothing.
      *
      * \param timeout The number of milliseconds that the download will be kept alive
      *        while waiting for a reply from the server. If this value is 0, the
@@ -279,6 +291,20 @@ public:
      */
     const std::string& url() const;
 
+    /**
+     * Returns the HTTP response code of the download, or 0 if no response was received.
+     * This value is only valid after #wait has returned.
+     */
+    long responseCode() const;
+
+    /**
+     * Returns the value of the response header with the provided \p name, which is
+     * compared case-insensitively, or `std::nullopt` if the response did not contain the
+     * header. If there were redirects, only the headers of the final response are
+     * considered. This value is only valid after #wait has returned.
+     */
+    std::optional<std::string> responseHeader(std::string_view name) const;
+
 protected:
     /**
      * This abstract function has to be implemented by any concrete subclass to handle an
@@ -330,25 +356,41 @@ private:
     HttpRequest::ProgressCallback _onProgress;
 
     /// Value indicating whether the HttpDownload is currently downloading a file
-    bool _isDownloading = false;
+    std::atomic_bool _isDownloading = false;
 
     /// Value indicating whether the download is finished
-    bool _isFinished = false;
+    std::atomic_bool _isFinished = false;
 
     /// Value indicated whether the download was successful
-    bool _isSuccessful = false;
+    std::atomic_bool _isSuccessful = false;
+
+    /// Marker telling the HttpEngine that the download should be cancelled
+    std::atomic_bool _shouldCancel = false;
+
+    /// Whether the #setup function was successful, in which case #teardown is called
+    bool _isSetUp = false;
+
+    /// The URL that this HttpDownload is going to download
+    std::string _url;
+
+    /// Additional headers that are sent with the request
+    std::vector<std::string> _requestHeaders;
+
+    /// The header lines of the most recent response
+    std::vector<std::string> _responseHeaders;
 
-    /// Marker telling the downloading thread that the download should be cancelled
-    bool _shouldCancel = false;
+    /// The HTTP response code of the finished download
+    long _responseCode = 0;
 
-    /// The HttpRequest class that will be used for the download
-    HttpRequest _httpRequest;
+    /// The identifier of the transfer in the HttpEngine, or 0 if it has not started
+    std::atomic<uint64_t> _transferId = 0;
 
-    /// The thread that contains the HttpRequest to download the file
-    std::thread _downloadThread;
+    /// Protects the flags describing the state of the download between the HttpEngine's
+    /// thread and the thread calling #wait
+    std::mutex _stateMutex;
 
     /// This condition variable is used by the #wait function to be able to wait for
-    /// completion of the downloading thread
+    /// completion of the download
     std::condition_variable _downloadFinishCondition;
 };
 
@@ -0,0 +1,235 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___LRUCACHE___H__
+#define __OPENSPACE_CORE___LRUCACHE___H__
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * A Least-Recently-Used cache that holds at most a fixed number of items and that
+ * optionally also limits the sum of the weights of the items, for example their sizes
+ * in bytes. If either limit is exceeded by an insertion, the least recently used items
+ * are evicted.
+ *
+ * All storage is allocated when the cache is created, so that inserting, touching, and
+ * evicting items does not allocate memory. The items are stored in a flat array and are
+ * found through an open-addressed hash table with linear probing. The order of recency
+ * is kept in a doubly linked list that uses indices into the item array instead of
+ * pointers, with the most recently used item at the front.
+ *
+ * The `Hasher` does not need to distribute the keys well, as its result is mixed before
+ * it is used. The functions that are marked `const` do not modify the cache and can be
+ * called concurrently; all others require exclusive access.
+ */
+template <typename Key, typename Value, typename Hasher = std::hash<Key>>
+class LruCache {
+public:
+    using Item = std::pair<Key, Value>;
+
+    /// The maximum weight that is used if the weight of the items is not limited
+    static constexpr size_t NoWeightLimit = std::numeric_limits<size_t>::max();
+
+    /**
+     * Creates a cache for at most \p capacity items, whose weights must not sum up to
+     * more than \p maximumWeight.
+     */
+    explicit LruCache(size_t capacity, size_t maximumWeight = NoWeightLimit);
+
+    /**
+     * Puts the item at the front of the queue, replacing the value and weight of an
+     * existing item with the same \p key, and evicts items from the back of the queue
+     * to stay within the limits of the cache.
+     */
+    void put(Key key, Value value, size_t weight = 1);
+
+    /**
+     * Same as #put, but returns the items that were evicted.
+     */
+    std::vector<Item> putAndFetchPopped(Key key, Value value, size_t weight = 1);
+
+    /**
+     * Puts the value at the back of the queue, which makes it the first item to be
+     * removed when the cache is full. If the key already exists, the existing item keeps
+     * its position and value.
+     * \returns the items that were removed to stay within the limits of the cache
+     */
+    std::vector<Item> putBackAndFetchPopped(Key key, Value value, size_t weight = 1);
+
+    bool exist(const Key& key) const;
+
+    /**
+     * If value exists, the value is bumped to the front of the queue.
+     * \returns true if value of this key exists.
+     */
+    bool touch(const Key& key);
+
+    /**
+     * Returns the value of the \p key, which has to exist, and bumps it to the front of
+     * the queue.
+     */
+    Value& get(const Key& key);
+
+    /**
+     * Returns the value of the \p key, which has to exist, without changing its position
+     * in the queue.
+     */
+    Value& peek(const Key& key);
+    const Value& peek(const Key& key) const;
+
+    /**
+     * Removes the item with the \p key.
+     * \returns true if the item existed
+     */
+    bool erase(const Key& key);
+
+    /**
+     * Pops the front of the queue.
+     */
+    Item popMRU();
+
+    /**
+     * Pops the back of the queue.
+     */
+    Item popLRU();
+
+    void clear();
+    bool isEmpty() const;
+    size_t size() const;
+    size_t maximumCacheSize() const;
+
+    /// Returns the sum of the weights of all items in the cache
+    size_t weight() const;
+    size_t maximumWeight() const;
+
+    /**
+     * Changes the number of items the cache can hold, which reallocates the storage. If
+     * the cache holds more items than the new \p capacity, the least recently used items
+     * are removed.
+     */
+    void setMaximumCacheSize(size_t capacity);
+
+private:
+    static constexpr uint32_t Invalid = std::numeric_limits<uint32_t>::max();
+
+    struct Entry {
+        std::optional<Item> item;
+        uint64_t hash = 0;
+        size_t weight = 0;
+        // The neighbor closer to the front of the queue
+        uint32_t previous = Invalid;
+        // The neighbor closer to the back of the queue; the next free entry if unused
+        uint32_t next = Invalid;
+    };
+
+    void allocate(size_t capacity);
+    uint64_t hash(const Key& key) const;
+    size_t homeBucket(uint64_t hash) const;
+    size_t findBucket(const Key& key, uint64_t hash) const;
+    uint32_t insert(Key key, Value value, size_t weight, bool atFront);
+    void removeFromBuckets(size_t bucket);
+    Item remove(uint32_t index);
+    void unlink(uint32_t index);
+    void linkFront(uint32_t index);
+    void linkBack(uint32_t index);
+    void evict(std::vector<Item>* popped);
+
+    Hasher _hasher;
+    // One more entry than the capacity, as items are evicted after the insertion
+    std::vector<Entry> _entries;
+    // Indices into _entries; the number of buckets is a power of two that is at least
+    // twice the number of entries to keep the probe sequences short
+    std::vector<uint32_t> _buckets;
+    int _bucketShift = 0;
+
+    uint32_t _front = Invalid;
+    uint32_t _back = Invalid;
+    uint32_t _firstFree = Invalid;
+
+    size_t _size = 0;
+    size_t _weight = 0;
+    size_t _capacity = 0;
+    size_t _maximumWeight = NoWeightLimit;
+};
+
+/**
+ * A LruCache that can be used from multiple threads at the same time. The items are
+ * distributed by their key across a number of independently locked shards, each of
+ * which is an LruCache with an equal share of the capacity and weight, so that threads
+ * that access different shards do not contend. As a consequence, the evicted item is
+ * the least recently used item of its shard rather than of the whole cache.
+ */
+template <typename Key, typename Value, typename Hasher = std::hash<Key>>
+class ConcurrentLruCache {
+public:
+    using Cache = LruCache<Key, Value, Hasher>;
+
+    /**
+     * Creates a cache for at most \p capacity items with a maximum total weight of
+     * \p maximumWeight, which are split into \p nShards shards.
+     */
+    explicit ConcurrentLruCache(size_t capacity, size_t nShards = 16,
+        size_t maximumWeight = Cache::NoWeightLimit);
+
+    void put(Key key, Value value, size_t weight = 1);
+
+    /**
+     * Returns a copy of the value of the \p key and bumps it to the front of the queue of
+     * its shard, or `std::nullopt` if it does not exist.
+     */
+    std::optional<Value> get(const Key& key);
+
+    bool exist(const Key& key) const;
+    bool erase(const Key& key);
+    void clear();
+    size_t size() const;
+
+private:
+    struct Shard {
+        explicit Shard(size_t capacity, size_t maximumWeight);
+
+        mutable std::mutex mutex;
+        Cache cache;
+    };
+
+    Shard& shard(const Key& key) const;
+
+    Hasher _hasher;
+    std::vector<std::unique_ptr<Shard>> _shards;
+};
+
+} // namespace openspace
+
+#include "lrucache.inl"
+
+#endif // __OPENSPACE_CORE___LRUCACHE___H__
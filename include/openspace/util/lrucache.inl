@@ -0,0 +1,452 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <bit>
+
+namespace openspace {
+
+namespace internal {
+
+// The finalizer of MurmurHash3, which spreads the bits of hashes that only differ in a
+// few bits, such as the identity hash of integers, across all bits
+constexpr uint64_t mixHash(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace internal
+
+template <typename Key, typename Value, typename Hasher>
+LruCache<Key, Value, Hasher>::LruCache(size_t capacity, size_t maximumWeight)
+    : _maximumWeight(maximumWeight)
+{
+    allocate(capacity);
+}
+
+template <typename Key, typename Value, typename Hasher>
+void LruCache<Key, Value, Hasher>::put(Key key, Value value, size_t weight) {
+    insert(std::move(key), std::move(value), weight, true);
+    evict(nullptr);
+}
+
+template <typename Key, typename Value, typename Hasher>
+std::vector<typename LruCache<Key, Value, Hasher>::Item>
+LruCache<Key, Value, Hasher>::putAndFetchPopped(Key key, Value value, size_t weight) {
+    insert(std::move(key), std::move(value), weight, true);
+    std::vector<Item> popped;
+    evict(&popped);
+    return popped;
+}
+
+template <typename Key, typename Value, typename Hasher>
+std::vector<typename LruCache<Key, Value, Hasher>::Item>
+LruCache<Key, Value, Hasher>::putBackAndFetchPopped(Key key, Value value, size_t weight)
+{
+    if (exist(key)) {
+        return {};
+    }
+    insert(std::move(key), std::move(value), weight, false);
+    std::vector<Item> popped;
+    evict(&popped);
+    return popped;
+}
+
+template <typename Key, typename Value, typename Hasher>
+bool LruCache<Key, Value, Hasher>::exist(const Key& key) const {
+    return findBucket(key, hash(key)) != _buckets.size();
+}
+
+template <typename Key, typename Value, typename Hasher>
+bool LruCache<Key, Value, Hasher>::touch(const Key& key) {
+    const size_t bucket = findBucket(key, hash(key));
+    if (bucket == _buckets.size()) {
+        return false;
+    }
+    const uint32_t index = _buckets[bucket];
+    unlink(index);
+    linkFront(index);
+    return true;
+}
+
+template <typename Key, typename Value, typename Hasher>
+Value& LruCache<Key, Value, Hasher>::get(const Key& key) {
+    const size_t bucket = findBucket(key, hash(key));
+    ghoul_assert(bucket != _buckets.size(), "Key must exist in the cache");
+    const uint32_t index = _buckets[bucket];
+    unlink(index);
+    linkFront(index);
+    return _entries[index].item->second;
+}
+
+template <typename Key, typename Value, typename Hasher>
+Value& LruCache<Key, Value, Hasher>::peek(const Key& key) {
+    const size_t bucket = findBucket(key, hash(key));
+    ghoul_assert(bucket != _buckets.size(), "Key must exist in the cache");
+    return _entries[_buckets[bucket]].item->second;
+}
+
+template <typename Key, typename Value, typename Hasher>
+const Value& LruCache<Key, Value, Hasher>::peek(const Key& key) const {
+    const size_t bucket = findBucket(key, hash(key));
+    ghoul_assert(bucket != _buckets.size(), "Key must exist in the cache");
+    return _entries[_buckets[bucket]].item->second;
+}
+
+template <typename Key, typename Value, typename Hasher>
+bool LruCache<Key, Value, Hasher>::erase(const Key& key) {
+    const size_t bucket = findBucket(key, hash(key));
+    if (bucket == _buckets.size()) {
+        return false;
+    }
+    remove(_buckets[bucket]);
+    return true;
+}
+
+template <typename Key, typename Value, typename Hasher>
+typename LruCache<Key, Value, Hasher>::Item LruCache<Key, Value, Hasher>::popMRU() {
+    ghoul_assert(_size > 0, "Cannot pop LRU cache. Ensure cache is not empty");
+    return remove(_front);
+}
+
+template <typename Key, typename Value, typename Hasher>
+typename LruCache<Key, Value, Hasher>::Item LruCache<Key, Value, Hasher>::popLRU() {
+    ghoul_assert(_size > 0, "Cannot pop LRU cache. Ensure cache is not empty");
+    return remove(_back);
+}
+
+template <typename Key, typename Value, typename Hasher>
+void LruCache<Key, Value, Hasher>::clear() {
+    // All entries are chained into the list of free entries
+    for (size_t i = 0; i < _entries.size(); i++) {
+        _entries[i].item = std::nullopt;
+        _entries[i].next = static_cast<uint32_t>(i + 1);
+    }
+    _entries.back().next = Invalid;
+    std::fill(_buckets.begin(), _buckets.end(), Invalid);
+    _front = Invalid;
+    _back = Invalid;
+    _firstFree = 0;
+    _size = 0;
+    _weight = 0;
+}
+
+template <typename Key, typename Value, typename Hasher>
+bool LruCache<Key, Value, Hasher>::isEmpty() const {
+    return _size == 0;
+}
+
+template <typename Key, typename Value, typename Hasher>
+size_t LruCache<Key, Value, Hasher>::size() const {
+    return _size;
+}
+
+template <typename Key, typename Value, typename Hasher>
+size_t LruCache<Key, Value, Hasher>::maximumCacheSize() const {
+    return _capacity;
+}
+
+template <typename Key, typename Value, typename Hasher>
+size_t LruCache<Key, Value, Hasher>::weight() const {
+    return _weight;
+}
+
+template <typename Key, typename Value, typename Hasher>
+size_t LruCache<Key, Value, Hasher>::maximumWeight() const {
+    return _maximumWeight;
+}
+
+template <typename Key, typename Value, typename Hasher>
+void LruCache<Key, Value, Hasher>::setMaximumCacheSize(size_t capacity) {
+    // Move the items out from the front so that the most recently used items are
+    // reinserted last and are kept if the new capacity is smaller
+    std::vector<std::pair<Item, size_t>> items;
+    items.reserve(_size);
+    while (_size > 0) {
+        const size_t weight = _entries[_front].weight;
+        items.emplace_back(popMRU(), weight);
+    }
+
+    allocate(capacity);
+    for (auto it = items.rbegin(); it != items.rend(); it++) {
+        put(std::move(it->first.first), std::move(it->first.second), it->second);
+    }
+}
+
+template <typename Key, typename Value, typename Hasher>
+void LruCache<Key, Value, Hasher>::allocate(size_t capacity) {
+    ghoul_assert(capacity < Invalid, "Capacity is too large");
+
+    _capacity = capacity;
+    _entries = std::vector<Entry>(capacity + 1);
+    const size_t nBuckets = std::bit_ceil(std::max<size_t>(2 * _entries.size(), 2));
+    _buckets = std::vector<uint32_t>(nBuckets);
+    _bucketShift = 64 - std::countr_zero(nBuckets);
+    clear();
+}
+
+template <typename Key, typename Value, typename Hasher>
+uint64_t LruCache<Key, Value, Hasher>::hash(const Key& key) const {
+    return internal::mixHash(static_cast<uint64_t>(_hasher(key)));
+}
+
+template <typename Key, typename Value, typename Hasher>
+size_t LruCache<Key, Value, Hasher>::homeBucket(uint64_t hash) const {
+    // ConcurrentLruCache selects the shard using the lower bits of the hash, so the upper
+    // bits are used here to keep the buckets within a shard evenly filled
+    return static_cast<size_t>(hash >> _bucketShift);
+}
+
+template <typename Key, typename Value, typename Hasher>
+size_t LruCache<Key, Value, Hasher>::findBucket(const Key& key, uint64_t hash) const {
+    const size_t mask = _buckets.size() - 1;
+    for (size_t bucket = homeBucket(hash); ; bucket = (bucket + 1) & mask) {
+        const uint32_t index = _buckets[bucket];
+        if (index == Invalid) {
+            return _buckets.size();
+        }
+        const Entry& e = _entries[index];
+        if (e.hash == hash && e.item->first == key) {
+            return bucket;
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Hasher>
+uint32_t LruCache<Key, Value, Hasher>::insert(Key key, Value value, size_t weight,
+                                              bool atFront)
+{
+    const uint64_t h = hash(key);
+    const size_t bucket = findBucket(key, h);
+    if (bucket != _buckets.size()) {
+        const uint32_t index = _buckets[bucket];
+        Entry& e = _entries[index];
+        e.item->second = std::move(value);
+        _weight = _weight - e.weight + weight;
+        e.weight = weight;
+        unlink(index);
+        atFront ? linkFront(index) : linkBack(index);
+        return index;
+    }
+
+    // There is always a free entry as the cache is at most full before an insertion
+    ghoul_assert(_firstFree != Invalid, "No free entry");
+    const uint32_t index = _firstFree;
+    Entry& e = _entries[index];
+    _firstFree = e.next;
+    e.item.emplace(std::move(key), std::move(value));
+    e.hash = h;
+    e.weight = weight;
+    atFront ? linkFront(index) : linkBack(index);
+
+    const size_t mask = _buckets.size() - 1;
+    size_t b = homeBucket(h);
+    while (_buckets[b] != Invalid) {
+        b = (b + 1) & mask;
+    }
+    _buckets[b] = index;
+
+    _size++;
+    _weight += weight;
+    return index;
+}
+
+template <typename Key, typename Value, typename Hasher>
+void LruCache<Key, Value, Hasher>::removeFromBuckets(size_t bucket) {
+    // Backward shift deletion: the following entries of the probe sequence are moved
+    // into the hole if their home bucket does not lie between the hole and themselves,
+    // so that no tombstones are needed and lookups stay short
+    const size_t mask = _buckets.size() - 1;
+    size_t hole = bucket;
+    for (size_t i = (bucket + 1) & mask; _buckets[i] != Invalid; i = (i + 1) & mask) {
+        const size_t home = homeBucket(_entries[_buckets[i]].hash);
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            _buckets[hole] = _buckets[i];
+            hole = i;
+        }
+    }
+    _buckets[hole] = Invalid;
+}
+
+template <typename Key, typename Value, typename Hasher>
+typename LruCache<Key, Value, Hasher>::Item
+LruCache<Key, Value, Hasher>::remove(uint32_t index)
+{
+    Entry& e = _entries[index];
+    removeFromBuckets(findBucket(e.item->first, e.hash));
+    unlink(index);
+
+    Item item = std::move(*e.item);
+    e.item = std::nullopt;
+    e.next = _firstFree;
+    _firstFree = index;
+
+    _size--;
+    _weight -= e.weight;
+    return item;
+}
+
+template <typename Key, typename Value, typename Hasher>
+void LruCache<Key, Value, Hasher>::unlink(uint32_t index) {
+    Entry& e = _entries[index];
+    if (e.previous != Invalid) {
+        _entries[e.previous].next = e.next;
+    }
+    else {
+        _front = e.next;
+    }
+    if (e.next != Invalid) {
+        _entries[e.next].previous = e.previous;
+    }
+    else {
+        _back = e.previous;
+    }
+    e.previous = Invalid;
+    e.next = Invalid;
+}
+
+template <typename Key, typename Value, typename Hasher>
+void LruCache<Key, Value, Hasher>::linkFront(uint32_t index) {
+    Entry& e = _entries[index];
+    e.previous = Invalid;
+    e.next = _front;
+    if (_front != Invalid) {
+        _entries[_front].previous = index;
+    }
+    else {
+        _back = index;
+    }
+    _front = index;
+}
+
+template <typename Key, typename Value, typename Hasher>
+void LruCache<Key, Value, Hasher>::linkBack(uint32_t index) {
+    Entry& e = _entries[index];
+    e.next = Invalid;
+    e.previous = _back;
+    if (_back != Invalid) {
+        _entries[_back].next = index;
+    }
+    else {
+        _front = index;
+    }
+    _back = index;
+}
+
+template <typename Key, typename Value, typename Hasher>
+void LruCache<Key, Value, Hasher>::evict(std::vector<Item>* popped) {
+    while (_size > _capacity || (_size > 0 && _weight > _maximumWeight)) {
+        Item item = popLRU();
+        if (popped) {
+            popped->push_back(std::move(item));
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Hasher>
+ConcurrentLruCache<Key, Value, Hasher>::Shard::Shard(size_t capacity,
+                                                     size_t maximumWeight)
+    : cache(capacity, maximumWeight)
+{}
+
+template <typename Key, typename Value, typename Hasher>
+ConcurrentLruCache<Key, Value, Hasher>::ConcurrentLruCache(size_t capacity,
+                                                           size_t nShards,
+                                                           size_t maximumWeight)
+{
+    nShards = std::max<size_t>(nShards, 1);
+    const size_t shardCapacity = (capacity + nShards - 1) / nShards;
+    const size_t shardWeight = maximumWeight == Cache::NoWeightLimit ?
+        Cache::NoWeightLimit :
+        (maximumWeight + nShards - 1) / nShards;
+
+    _shards.reserve(nShards);
+    for (size_t i = 0; i < nShards; i++) {
+        _shards.push_back(std::make_unique<Shard>(shardCapacity, shardWeight));
+    }
+}
+
+template <typename Key, typename Value, typename Hasher>
+void ConcurrentLruCache<Key, Value, Hasher>::put(Key key, Value value, size_t weight) {
+    Shard& s = shard(key);
+    std::lock_guard lock(s.mutex);
+    s.cache.put(std::move(key), std::move(value), weight);
+}
+
+template <typename Key, typename Value, typename Hasher>
+std::optional<Value> ConcurrentLruCache<Key, Value, Hasher>::get(const Key& key) {
+    Shard& s = shard(key);
+    std::lock_guard lock(s.mutex);
+    if (!s.cache.touch(key)) {
+        return std::nullopt;
+    }
+    return s.cache.peek(key);
+}
+
+template <typename Key, typename Value, typename Hasher>
+bool ConcurrentLruCache<Key, Value, Hasher>::exist(const Key& key) const {
+    Shard& s = shard(key);
+    std::lock_guard lock(s.mutex);
+    return s.cache.exist(key);
+}
+
+template <typename Key, typename Value, typename Hasher>
+bool ConcurrentLruCache<Key, Value, Hasher>::erase(const Key& key) {
+    Shard& s = shard(key);
+    std::lock_guard lock(s.mutex);
+    return s.cache.erase(key);
+}
+
+template <typename Key, typename Value, typename Hasher>
+void ConcurrentLruCache<Key, Value, Hasher>::clear() {
+    for (const std::unique_ptr<Shard>& s : _shards) {
+        std::lock_guard lock(s->mutex);
+        s->cache.clear();
+    }
+}
+
+template <typename Key, typename Value, typename Hasher>
+size_t ConcurrentLruCache<Key, Value, Hasher>::size() const {
+    size_t result = 0;
+    for (const std::unique_ptr<Shard>& s : _shards) {
+        std::lock_guard lock(s->mutex);
+        result += s->cache.size();
+    }
+    return result;
+}
+
+template <typename Key, typename Value, typename Hasher>
+typename ConcurrentLruCache<Key, Value, Hasher>::Shard&
+ConcurrentLruCache<Key, Value, Hasher>::shard(const Key& key) const
+{
+    const uint64_t h = internal::mixHash(static_cast<uint64_t>(_hasher(key)));
+    return *_shards[h % _shards.size()];
+}
+
+} // namespace openspace
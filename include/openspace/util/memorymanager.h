@@ -25,6 +25,7 @@
 #ifndef __OPENSPACE_CORE___MEMORYMANAGER___H__
 #define __OPENSPACE_CORE___MEMORYMANAGER___H__
 
+#include <openspace/util/framearena.h>
 #include <ghoul/misc/memorypool.h>
 
 namespace openspace {
@@ -33,9 +34,9 @@ class MemoryManager {
 public:
     ghoul::MemoryPool<8 * 1024 * 1024> PersistentMemory;
 
-    // This should be replaced with a std::pmr::memory_resource wrapper around our own
-    // Memory pool so that we can get a high-water mark out of it
-    ghoul::MemoryPool<100 * 4096, false, true> TemporaryMemory;
+    // Frame-based storage that is reset at the beginning of every frame. It must only be
+    // used from the main thread; worker threads use FrameArena::threadArena instead
+    FrameArena TemporaryMemory = FrameArena(100 * 4096);
 };
 
 } // namespace openspace
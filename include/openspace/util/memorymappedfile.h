@@ -0,0 +1,102 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___MEMORYMAPPEDFILE___H__
+#define __OPENSPACE_CORE___MEMORYMAPPEDFILE___H__
+
+#include <cstddef>
+#include <filesystem>
+
+namespace openspace {
+
+/**
+ * A read-only view of the contents of a file that is mapped into the address space of
+ * the process. The operating system pages in the parts of the file that are accessed
+ * and can drop them again under memory pressure, which makes this a cheap way to read
+ * large files of which only parts are needed or which are only read once. The mapping
+ * is released when the object is destroyed. If the file could not be mapped, for
+ * example because it does not exist or is empty, the object is not valid.
+ */
+class MemoryMappedFile {
+public:
+    enum class Mode {
+        /// The mapped memory must only be read
+        ReadOnly,
+        /// The mapped memory can be written to, which creates private copies of the
+        /// modified pages. The file on disk is never changed
+        CopyOnWrite
+    };
+
+    /// How the mapped memory is going to be accessed, see #advise
+    enum class Usage {
+        /// The memory is going to be read soon, so it can be read ahead of time
+        WillNeed,
+        /// The memory is not going to be needed for a while, so its pages can be released
+        DontNeed,
+        /// The memory is going to be read in a random order, so reading ahead is wasted
+        Random
+    };
+
+    MemoryMappedFile() = default;
+    explicit MemoryMappedFile(const std::filesystem::path& file,
+        Mode mode = Mode::ReadOnly);
+    MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    ~MemoryMappedFile();
+
+    bool isValid() const;
+
+    /// Returns the beginning of the mapped file or `nullptr` if the file is not valid
+    const std::byte* data() const;
+
+    /// Returns the beginning of the mapped file or `nullptr` if the file is not valid.
+    /// The memory must only be written to if the file was mapped as Mode::CopyOnWrite
+    std::byte* data();
+
+    /// Returns the size of the mapped file in bytes or 0 if the file is not valid
+    size_t size() const;
+
+    /**
+     * Tells the operating system how the \p size bytes starting at \p begin are going to
+     * be accessed. The range has to lie within the mapped file. This is only a hint that
+     * does not change the contents of the memory and that is ignored on Windows, where
+     * the system's own read-ahead is relied upon instead.
+     */
+    void advise(Usage usage, const void* begin, size_t size) const;
+
+    /// Tells the operating system how the whole mapped file is going to be accessed
+    void advise(Usage usage) const;
+
+private:
+    void release();
+
+    std::byte* _data = nullptr;
+    size_t _size = 0;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___MEMORYMAPPEDFILE___H__
@@ -27,8 +27,9 @@
 
 #include <ghoul/logging/log.h>
 
+#include <openspace/util/boundedconcurrentqueue.h>
+#include <atomic>
 #include <chrono>
-#include <mutex>
 #include <string_view>
 #include <vector>
 
@@ -40,6 +41,12 @@ namespace openspace {
  * log message (#log) is tagged with the current time and all stored log messages can
  * expire based on the time-to-live as specified in the constructor
  * (#removeExpiredEntries).
+ *
+ * Incoming messages are pushed into a lock-free queue from which they are collected once
+ * per frame by #removeExpiredEntries, so logging from any thread never waits for the
+ * rendering of the log. Repeated identical messages are merged into a single entry that
+ * counts the repetitions, which keeps a storm of the same warning from pushing all
+ * other messages off the screen.
  */
 class ScreenLog : public ghoul::logging::Log {
 public:
@@ -65,6 +72,10 @@ public:
 
         /// The actual message of the log entry
         std::string message;
+
+        /// The number of times that this message has been logged while the entry was
+        /// alive. The #timeStamp and #timeString refer to the last time
+        int count = 1;
     };
 
     /**
@@ -96,8 +107,10 @@ public:
         std::string_view message) override;
 
     /**
-     * This method removes all the stored LogEntry%s that have expired, calculated by
-     * their `timeStamp` and the #_timeToLive value.
+     * This method collects all messages that have been logged since the last call and
+     * then removes all the stored LogEntry%s that have expired, calculated by their
+     * `timeStamp` and the #_timeToLive value. This method and #entries must be called
+     * from the same thread.
      *
      * \post All entries retrieved by the #entries function have a `timeStamp`
      *       that is lower than the current time + #_timeToLive. The current time used is
@@ -113,19 +126,25 @@ public:
     const std::vector<LogEntry>& entries() const;
 
 private:
+    /// Adds the \p entry to the #_entries or increases the count of an existing entry
+    /// with the same level, category, and message
+    void addEntry(LogEntry entry);
+
     /// The list of all LogEntry%s stored by this ScreenLog
     std::vector<LogEntry> _entries;
 
+    /// The messages that have been logged, but not yet been collected into #_entries
+    BoundedConcurrentQueue<LogEntry> _pending;
+
+    /// The number of messages that were discarded because #_pending was full
+    std::atomic<int> _nDropped = 0;
+
     /// The time-to-live for the LogEntry%s in this ScreenLog. Is used by the
     /// #removeExpiredEntries method to remove expired entries.
     std::chrono::seconds _timeToLive;
 
     /// The minimum LogLevel of messages
     LogLevel _logLevel;
-
-    /// A mutex to ensure thread-safety since the logging and the removal of expired
-    /// entires can occur on different threads
-    mutable std::mutex _mutex;
 };
 
 } // namespace openspace
@@ -31,8 +31,11 @@
 #include <ghoul/misc/boolean.h>
 #include <ghoul/misc/exception.h>
 #include <array>
+#include <limits>
 #include <map>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <set>
 
@@ -59,6 +62,24 @@ namespace scripting { struct LuaLibrary; }
 
 void throwSpiceError(const std::string& errorMessage);
 
+namespace detail {
+
+/**
+ * Inserts the interval [\p begin, \p end] into the sorted and disjoint list of
+ * \p intervals, merging it with all intervals that it overlaps. The coverage checks are
+ * exclusive of the end points, so intervals that only touch are kept separate.
+ */
+void insertInterval(std::vector<std::pair<double, double>>& intervals, double begin,
+    double end);
+
+/**
+ * Returns whether any of the sorted and disjoint \p intervals contains the time \p t.
+ * The begin of an interval is part of it, its end is not.
+ */
+bool containsTime(const std::vector<std::pair<double, double>>& intervals, double t);
+
+} // namespace detail
+
 class SpiceManager {
 public:
     BooleanType(UseException);
@@ -984,6 +1005,18 @@ public:
      */
     UseException exceptionHandling() const;
 
+    /**
+     * Sets the time for which the results of #targetPosition, #targetState,
+     * #frameTransformationMatrix, and #positionTransformMatrix are memoized. Many parts
+     * of the scene ask for the same values at the current time within a frame, and only
+     * the first of these requests has to call into SPICE. Requests for other times are
+     * not memoized. Changing the time or loading or unloading a kernel discards all
+     * memoized results.
+     *
+     * \param ephemerisTime The ephemeris time for which results are memoized
+     */
+    void setQueryCacheTime(double ephemerisTime);
+
     static scripting::LuaLibrary luaLibrary();
 
 private:
@@ -1088,9 +1121,58 @@ private:
     /// A list of all loaded kernels
     std::vector<KernelInformation> _loadedKernels;
 
+    /**
+     * Returns the NAIF ID of the \p body like #naifId, but remembers successful lookups
+     * until the next kernel is loaded or unloaded.
+     */
+    int cachedNaifId(const std::string& body) const;
+
+    /**
+     * Returns the NAIF ID of the \p frame like #frameId, but remembers successful
+     * lookups until the next kernel is loaded or unloaded.
+     */
+    int cachedFrameId(const std::string& frame) const;
+
+    /// Key of the a memoized query: (target, observer, frame, aberration, time) for
+    /// positions and states and (from, to, "", kind, time) for transformations
+    using QueryKey = std::tuple<std::string, std::string, std::string, int, double>;
+    using QueryKeyView = std::tuple<
+        const std::string&, const std::string&, const std::string&, int, double
+    >;
+
+    /**
+     * Returns the memoized value for the \p key from the \p cache or calls \p compute and
+     * memoizes its result if the time of the \p key is the current query cache time.
+     */
+    template <typename T, typename Func>
+    T memoized(std::map<QueryKey, T, std::less<>>& cache, const QueryKeyView& key,
+        Func compute) const;
+
+    /// Discards all memoized query results
+    void clearQueryCache();
+
+    glm::dvec3 uncachedTargetPosition(const std::string& target,
+        const std::string& observer, const std::string& referenceFrame,
+        AberrationCorrection aberrationCorrection, double ephemerisTime,
+        double& lightTime) const;
+
     // Map: id, vector of pairs. Pair: Start time, end time;
     std::map<int, std::vector< std::pair<double, double>>> _ckIntervals;
     std::map<int, std::vector< std::pair<double, double>>> _spkIntervals;
+    // The same intervals as above, but sorted by start time and with all overlapping
+    // intervals merged, so that a time can be looked up with a binary search
+    std::map<int, std::vector<std::pair<double, double>>> _ckMergedIntervals;
+    std::map<int, std::vector<std::pair<double, double>>> _spkMergedIntervals;
+    // The name to ID lookups are comparatively expensive and are done for every coverage
+    // check. Loading or unloading a kernel can change the mapping and clears these
+    mutable std::map<std::string, int, std::less<>> _naifIdCache;
+    mutable std::map<std::string, int, std::less<>> _frameIdCache;
+
+    mutable std::mutex _queryCacheMutex;
+    double _queryCacheTime = std::numeric_limits<double>::quiet_NaN();
+    mutable std::map<QueryKey, std::pair<glm::dvec3, double>, std::less<>> _positionCache;
+    mutable std::map<QueryKey, TargetStateResult, std::less<>> _stateCache;
+    mutable std::map<QueryKey, glm::dmat3, std::less<>> _transformCache;
     std::map<int, std::set<double>> _ckCoverageTimes;
     std::map<int, std::set<double>> _spkCoverageTimes;
 
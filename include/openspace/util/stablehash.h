@@ -0,0 +1,67 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___STABLEHASH___H__
+#define __OPENSPACE_CORE___STABLEHASH___H__
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+namespace openspace {
+
+/// The value of a stable hash to which no data has been added yet
+constexpr uint64_t StableHashOffset = 14695981039346656037ULL;
+
+/**
+ * Returns the 64-bit FNV-1a hash of the \p data, continuing from the previous \p hash.
+ * Unlike `std::hash`, the result only depends on the data and is therefore the same
+ * between runs, builds, and platforms, which makes it suitable for keys that are stored
+ * on disk.
+ */
+uint64_t stableHash(std::string_view data, uint64_t hash = StableHashOffset);
+
+/**
+ * Adds the \p data followed by its length to the \p hash. The length makes the hash of a
+ * sequence of strings unambiguous, so that `("ab", "c")` and `("a", "bc")` result in
+ * different hashes.
+ */
+void stableHashCombine(uint64_t& hash, std::string_view data);
+
+/// The stableHash of the contents of a file together with the size of the file
+struct StableFileHash {
+    uint64_t hash = StableHashOffset;
+    uint64_t size = 0;
+};
+
+/**
+ * Returns the stableHash of the contents of the file at \p path and its size, or
+ * `std::nullopt` if the file could not be read.
+ */
+std::optional<StableFileHash> stableHashFile(const std::filesystem::path& path);
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___STABLEHASH___H__
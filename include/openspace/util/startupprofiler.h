@@ -0,0 +1,128 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___STARTUPPROFILER___H__
+#define __OPENSPACE_CORE___STARTUPPROFILER___H__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * The StartupProfiler records how long each step of starting OpenSpace takes, from the
+ * initialization of the engine through the loading, synchronization, and initialization
+ * of the assets to the initialization of the scene graph nodes, both on the CPU and in
+ * `initializeGL`. The steps are recorded with the Scope helper or, for steps that span
+ * several frames such as resource synchronizations, with #record.
+ *
+ * When the startup is complete, #finish writes a report as a JSON file that contains
+ * all recorded steps with their inclusive and exclusive durations, the totals for each
+ * Category, and the critical path; the chain of steps that ended last, each preceded by
+ * the step that finished last before it started. After #finish, nothing is recorded.
+ */
+class StartupProfiler {
+public:
+    enum class Category {
+        Engine = 0,
+        AssetLoad,
+        AssetSynchronization,
+        AssetInitialize,
+        NodeInitialize,
+        NodeInitializeGL
+    };
+
+    /// The thread number of steps that were recorded with #record, as they do not have
+    /// to begin and end on the same thread
+    static constexpr uint16_t AsyncThread = 0xFFFF;
+
+    /// A single recorded step of the startup
+    struct Record {
+        Category category;
+        std::string name;
+        /// The beginning of the step in nanoseconds since the profiler was created
+        uint64_t begin = 0;
+        /// The duration of the step in nanoseconds
+        uint64_t duration = 0;
+        /// A sequential number identifying the thread on which the step was recorded
+        uint16_t thread = 0;
+        /// The number of enclosing Scopes on the same thread
+        uint8_t depth = 0;
+    };
+
+    /**
+     * Measures the time between its construction and destruction and records it as a
+     * step of the provided \p category. Scopes can be nested, in which case the time of
+     * the inner Scope is not counted towards the exclusive time of the outer Scope.
+     */
+    class Scope {
+    public:
+        Scope(Category category, std::string name);
+        ~Scope();
+
+    private:
+        Category _category;
+        std::string _name;
+        uint64_t _begin = 0;
+        uint8_t _depth = 0;
+        bool _isActive;
+    };
+
+    StartupProfiler();
+
+    /**
+     * Records a step of the provided \p category that began at \p begin and ended at
+     * \p end. This is used for steps that are not contained in a single function call.
+     */
+    void record(Category category, std::string name,
+        std::chrono::steady_clock::time_point begin,
+        std::chrono::steady_clock::time_point end);
+
+    /**
+     * Finishes the recording and writes the report to \p path. Subsequent calls to this
+     * function or to #record and any Scope will not do anything.
+     */
+    void finish(const std::filesystem::path& path);
+
+    /// Returns whether steps are still being recorded
+    bool isRecording() const;
+
+private:
+    uint64_t toNanoseconds(std::chrono::steady_clock::time_point time) const;
+
+    const std::chrono::steady_clock::time_point _epoch;
+    std::atomic_bool _isRecording = true;
+
+    std::mutex _mutex;
+    std::vector<Record> _records;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___STARTUPPROFILER___H__
@@ -44,6 +44,15 @@ protected:
     friend class SyncEngine;
 
     virtual void preSync(bool /*isMaster*/) {}
+
+    /**
+     * Returns whether the state of this Syncable has changed since the last time it was
+     * encoded. If the SyncEngine uses delta encoding, only Syncables that report a change
+     * are encoded into the frames between two keyframes. The default implementation
+     * always reports a change.
+     */
+    virtual bool hasChanged() const { return true; }
+
     virtual void encode(SyncBuffer* /*syncBuffer*/) = 0;
     virtual void decode(SyncBuffer* /*syncBuffer*/) = 0;
     virtual void postSync(bool /*isMaster*/) {}
@@ -26,12 +26,21 @@
 #define __OPENSPACE_CORE___SYNCBUFFER___H__
 
 #include <ghoul/glm.h>
+#include <array>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace openspace {
 
+/**
+ * The SyncBuffer is used to serialize the state of the Syncable%s on the master and to
+ * deserialize it on the clients. Encoding happens into one of two preallocated buffers
+ * that are alternated between frames, so that the span returned by #encodedData stays
+ * valid while the next frame is being encoded. Decoding is performed directly from the
+ * memory that is passed to #setData without copying it.
+ */
 class SyncBuffer {
 public:
     SyncBuffer(size_t n);
@@ -57,19 +66,39 @@ public:
     template <typename T>
     void decode(T& value);
 
+    /**
+     * Finishes the current frame. The encoding switches to the other buffer and the
+     * decoding view is released. The memory of both buffers is kept for reuse.
+     */
     void reset();
 
-    //void write();
-    //void read();
-
-    void setData(std::vector<std::byte> data);
-    std::vector<std::byte> data();
+    /**
+     * Sets the memory that subsequent calls to the decode functions read from. The
+     * memory is not copied and has to remain valid until #reset is called.
+     *
+     * \param data The encoded data that should be decoded
+     */
+    void setData(std::span<const std::byte> data);
+
+    /**
+     * Returns the data that has been encoded since the last call to #reset. The returned
+     * span remains valid until the second call to #reset after this function was called.
+     *
+     * \return The data that has been encoded in the current frame
+     */
+    std::span<const std::byte> encodedData() const;
 
 private:
+    /// Makes sure that the current encode buffer can hold \p size more bytes
+    void reserve(size_t size);
+
     size_t _n;
     size_t _encodeOffset = 0;
     size_t _decodeOffset = 0;
-    std::vector<std::byte> _dataStream;
+
+    std::array<std::vector<std::byte>, 2> _buffers;
+    size_t _activeBuffer = 0;
+    std::span<const std::byte> _decodeData;
 };
 
 } // namespace openspace
@@ -31,22 +31,17 @@ namespace openspace {
 template <typename T>
 void SyncBuffer::encode(const T& v) {
     const size_t size = sizeof(T);
-
-    size_t anticpatedBufferSize = _encodeOffset + size;
-    if (anticpatedBufferSize >= _n) {
-        _dataStream.resize(anticpatedBufferSize);
-    }
-
-    std::memcpy(_dataStream.data() + _encodeOffset, &v, size);
+    reserve(size);
+    std::memcpy(_buffers[_activeBuffer].data() + _encodeOffset, &v, size);
     _encodeOffset += size;
 }
 
 template <typename T>
 T SyncBuffer::decode() {
     const size_t size = sizeof(T);
-    ghoul_assert(_decodeOffset + size < _n, "");
+    ghoul_assert(_decodeOffset + size <= _decodeData.size(), "Reading past the end");
     T value;
-    std::memcpy(&value, _dataStream.data() + _decodeOffset, size);
+    std::memcpy(&value, _decodeData.data() + _decodeOffset, size);
     _decodeOffset += size;
     return value;
 }
@@ -54,8 +49,8 @@ T SyncBuffer::decode() {
 template <typename T>
 void SyncBuffer::decode(T& value) {
     const size_t size = sizeof(T);
-    ghoul_assert(_decodeOffset + size < _n, "");
-    std::memcpy(&value, _dataStream.data() + _decodeOffset, size);
+    ghoul_assert(_decodeOffset + size <= _decodeData.size(), "Reading past the end");
+    std::memcpy(&value, _decodeData.data() + _decodeOffset, size);
     _decodeOffset += size;
 }
 
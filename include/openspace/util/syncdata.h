@@ -28,6 +28,7 @@
 #include <openspace/util/syncable.h>
 
 #include <mutex>
+#include <type_traits>
 
 namespace openspace {
 
@@ -76,13 +77,17 @@ public:
     const T& data() const;
 
 protected:
+    virtual bool hasChanged() const override;
     virtual void encode(SyncBuffer* syncBuffer) override;
     virtual void decode(SyncBuffer* syncBuffer) override;
     virtual void postSync(bool isMaster) override;
 
     T _data;
     T _doubleBufferedData;
-    std::mutex _mutex;
+    // The value that was encoded last, used to determine whether the data has changed
+    T _lastEncodedData;
+    bool _hasBeenEncoded = false;
+    mutable std::mutex _mutex;
 };
 
 } // namespace openspace
@@ -23,6 +23,7 @@
  ****************************************************************************************/
 
 #include <openspace/util/syncbuffer.h>
+#include <cstring>
 
 namespace openspace {
 
@@ -58,10 +59,29 @@ const T& SyncData<T>::data() const {
     return _data;
 }
 
+template<class T>
+bool SyncData<T>::hasChanged() const {
+    std::lock_guard guard(_mutex);
+    if (!_hasBeenEncoded) {
+        return true;
+    }
+
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        // The SyncBuffer transmits the raw bytes of the value, so a bytewise comparison
+        // is exactly what determines whether the encoded data would be different
+        return std::memcmp(&_data, &_lastEncodedData, sizeof(T)) != 0;
+    }
+    else {
+        return true;
+    }
+}
+
 template<class T>
 void SyncData<T>::encode(SyncBuffer* syncBuffer) {
     _mutex.lock();
     syncBuffer->encode(_data);
+    _lastEncodedData = _data;
+    _hasBeenEncoded = true;
     _mutex.unlock();
 }
 
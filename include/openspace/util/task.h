@@ -25,8 +25,11 @@
 #ifndef __OPENSPACE_CORE___TASK___H__
 #define __OPENSPACE_CORE___TASK___H__
 
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace ghoul { class Dictionary; }
 
@@ -38,15 +41,55 @@ class Task {
 public:
     using ProgressCallback = std::function<void(float)>;
 
+    /// Information that the TaskScheduler uses to decide when a task can be performed
+    struct Scheduling {
+        /// The identifier by which other tasks can depend on this task
+        std::string identifier;
+
+        /// The identifiers of the tasks that have to finish before this task is started
+        std::vector<std::string> dependencies;
+
+        /// The number of threads that this task uses while it is performed
+        int nThreads = 1;
+
+        /// The estimated peak amount of memory, in megabytes, that this task uses
+        int memory = 0;
+    };
+
     virtual ~Task() = default;
     virtual void perform(const ProgressCallback& onProgress) = 0;
     virtual std::string description() = 0;
 
+    /**
+     * Returns the files or folders that this task reads. The TaskCache performs the task
+     * again if the contents of any of these has changed since the last time.
+     */
+    virtual std::vector<std::filesystem::path> inputFiles() const;
+
+    /**
+     * Returns the files or folders that this task writes. Tasks that do not declare any
+     * outputs are never skipped by the TaskCache.
+     */
+    virtual std::vector<std::filesystem::path> outputFiles() const;
+
+    const Scheduling& scheduling() const;
+    void setScheduling(Scheduling scheduling);
+
+    /**
+     * Returns a serialization of the dictionary that this task was created from, which
+     * is used to detect changes of the task's parameters.
+     */
+    const std::string& parameters() const;
+
     static std::unique_ptr<Task> createFromDictionary(
         const ghoul::Dictionary& dictionary
     );
 
     static documentation::Documentation documentation();
+
+private:
+    Scheduling _scheduling;
+    std::string _parameters;
 };
 
 } // namespace openspace
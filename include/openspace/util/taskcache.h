@@ -0,0 +1,105 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___TASKCACHE___H__
+#define __OPENSPACE_CORE___TASKCACHE___H__
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace openspace {
+
+class Task;
+
+/**
+ * Remembers the state of the inputs and outputs of every Task that was performed
+ * successfully, so that a task can be skipped if neither its parameters nor the contents
+ * of its input files have changed and its output files are still unmodified. The
+ * contents of an input file are only hashed again if its size or modification time has
+ * changed. Tasks are identified by their parameters, so changing any parameter of a task
+ * causes it to be performed again.
+ *
+ * All functions of this class can be called from multiple threads at the same time.
+ */
+class TaskCache {
+public:
+    /**
+     * Creates a cache that is stored in the file at \p path. If the file exists, the
+     * previously recorded tasks are loaded from it.
+     */
+    explicit TaskCache(std::filesystem::path path);
+
+    /**
+     * Returns `true` if the \p task has been performed successfully with the same
+     * parameters and inputs before and its outputs have not been modified since then.
+     * Tasks that do not declare any outputs are never up to date.
+     */
+    bool isUpToDate(const Task& task);
+
+    /**
+     * Records the current state of the inputs and outputs of the \p task, which has to
+     * be called after the \p task has been performed successfully.
+     */
+    void update(const Task& task);
+
+    /// Writes all recorded tasks to the file that was passed to the constructor
+    void save();
+
+private:
+    struct FileState {
+        std::filesystem::path path;
+        uint64_t size = 0;
+        int64_t modificationTime = 0;
+        std::string hash;
+
+        bool operator==(const FileState& rhs) const = default;
+    };
+
+    struct Record {
+        std::vector<FileState> inputs;
+        std::vector<FileState> outputs;
+    };
+
+    /**
+     * Returns the state of all files in the \p paths, where folders are expanded to the
+     * files they contain. If \p previous is provided, the contents of the files are
+     * hashed, reusing the hashes of the \p previous states for files whose size and
+     * modification time are unchanged. Otherwise the hashes are left empty.
+     */
+    static std::vector<FileState> fileStates(
+        const std::vector<std::filesystem::path>& paths,
+        const std::vector<FileState>* previous);
+
+    const std::filesystem::path _path;
+    std::unordered_map<std::string, Record> _records;
+    std::mutex _mutex;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___TASKCACHE___H__
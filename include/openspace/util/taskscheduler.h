@@ -0,0 +1,110 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___TASKSCHEDULER___H__
+#define __OPENSPACE_CORE___TASKSCHEDULER___H__
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+class Task;
+class TaskCache;
+
+/**
+ * Performs a list of Task%s concurrently while respecting the dependencies between them.
+ * A task is started as soon as all of the tasks it depends on have succeeded and enough
+ * threads and memory are available for the amount that the task declares in its
+ * Task::Scheduling. If a task fails, all tasks that depend on it are skipped. Tasks that
+ * are ready at the same time are started in the order in which they were provided.
+ */
+class TaskScheduler {
+public:
+    /// Called with the index of a task and its progress in [0, 1]
+    using ProgressCallback = std::function<void(size_t, float)>;
+
+    struct Result {
+        enum class Status {
+            Succeeded = 0,
+            UpToDate,
+            Failed,
+            Skipped
+        };
+
+        std::string description;
+        Status status = Status::Skipped;
+        std::chrono::duration<double> duration = std::chrono::duration<double>(0.0);
+    };
+
+    /**
+     * Creates a scheduler for the provided \p tasks.
+     *
+     * \throw ghoul::RuntimeError If two tasks have the same identifier, a task depends
+     *        on an identifier that does not exist, or the dependencies contain a cycle
+     */
+    explicit TaskScheduler(std::vector<std::unique_ptr<Task>> tasks);
+    ~TaskScheduler();
+
+    /**
+     * Performs all tasks and returns after they have finished or have been skipped. A
+     * task that requires more threads or memory than is available in total is clamped
+     * to the total and is performed on its own.
+     *
+     * \param nThreads The number of threads that the concurrently running tasks may use
+     * \param memoryLimit The amount of memory, in megabytes, that the concurrently
+     *        running tasks may use. If this is 0, there is no limit
+     * \param onProgress Called from the thread of a task whenever it reports progress.
+     *        This callback might be called concurrently for different tasks
+     * \param cache If this is provided, tasks that are up to date according to the
+     *        cache are not performed, and the cache is updated for all tasks that
+     *        succeed. Tasks depending on an up-to-date task are started as if it had
+     *        succeeded
+     * \return The result of each task, in the order in which the tasks were provided
+     *
+     * \pre \p nThreads must be positive
+     * \pre \p memoryLimit must not be negative
+     */
+    std::vector<Result> perform(int nThreads, int memoryLimit,
+        const ProgressCallback& onProgress = ProgressCallback(),
+        TaskCache* cache = nullptr);
+
+    size_t numberOfTasks() const;
+
+private:
+    std::vector<std::unique_ptr<Task>> _tasks;
+
+    /// The indices of the tasks that each task depends on
+    std::vector<std::vector<size_t>> _dependencies;
+
+    /// The task indices sorted such that every task comes after its dependencies
+    std::vector<size_t> _order;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___TASKSCHEDULER___H__
@@ -0,0 +1,102 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___THREADEDLOG___H__
+#define __OPENSPACE_CORE___THREADEDLOG___H__
+
+#include <ghoul/logging/log.h>
+
+#include <openspace/util/boundedconcurrentqueue.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace openspace {
+
+/**
+ * A ghoul::logging::Log that forwards all messages to another Log on a dedicated writer
+ * thread. Logging a message only pushes it into a lock-free queue, so threads that log a
+ * large number of messages do not have to wait for slow sinks, such as files, to write
+ * them. The writer thread collects all messages that have arrived since it last woke up
+ * and writes them as one batch.
+ *
+ * If the queue is full, the logging thread waits until the writer thread has made room,
+ * which means that no messages are lost. As the messages are written slightly later
+ * than they are logged, time stamps added by the wrapped Log might be delayed.
+ */
+class ThreadedLog : public ghoul::logging::Log {
+public:
+    /**
+     * Creates a ThreadedLog that writes all messages with at least the \p logLevel to
+     * the provided \p log on a new thread.
+     *
+     * \pre \p log must not be `nullptr`
+     */
+    ThreadedLog(std::unique_ptr<ghoul::logging::Log> log,
+        ghoul::logging::LogLevel logLevel = ghoul::logging::LogLevel::AllLogging);
+
+    /**
+     * Writes all remaining messages and stops the writer thread.
+     */
+    ~ThreadedLog() override;
+
+    void log(ghoul::logging::LogLevel level, std::string_view category,
+        std::string_view message) override;
+
+    /**
+     * Waits until all messages that have been logged so far are written and then flushes
+     * the wrapped Log.
+     */
+    void flush() override;
+
+private:
+    struct Message {
+        ghoul::logging::LogLevel level = ghoul::logging::LogLevel::AllLogging;
+        std::string category;
+        std::string message;
+    };
+
+    /// The function that is executed on the writer thread
+    void run();
+
+    /// Writes all messages that are currently in the #_queue to the wrapped Log
+    void writeMessages();
+
+    std::unique_ptr<ghoul::logging::Log> _log;
+    const ghoul::logging::LogLevel _logLevel;
+
+    BoundedConcurrentQueue<Message> _queue;
+    /// The number of messages that have been logged, but not yet written
+    std::atomic<size_t> _nPending = 0;
+    /// Set whenever a message is pushed, which wakes up the writer thread
+    std::atomic<bool> _hasMessages = false;
+    std::atomic<bool> _shouldStop = false;
+    std::thread _thread;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___THREADEDLOG___H__
@@ -25,52 +25,116 @@
 #ifndef __OPENSPACE_CORE___THREAD_POOL___H__
 #define __OPENSPACE_CORE___THREAD_POOL___H__
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
 #include <vector>
 
-// Implementation based on http://progsch.net/wordpress/?p=81
-
 namespace openspace {
 
-class ThreadPool;
-
-class Worker {
-public:
-    Worker(ThreadPool& p);
-    void operator()();
-
-private:
-    ThreadPool& pool;
-};
-
+/**
+ * A pool of worker threads that execute tasks which are passed to #enqueue. Each worker
+ * owns a lock-free deque into which the tasks are placed that are enqueued from within
+ * a task running on that worker. The worker executes the tasks of its own deque in
+ * last-in-first-out order and steals from the other workers' deques when it runs out of
+ * work. Tasks that are enqueued from any other thread are placed into one of the shared
+ * queues, one per task Priority, from which the workers take the tasks with the highest
+ * Priority first.
+ */
 class ThreadPool {
 public:
+    enum class Priority {
+        High = 0,
+        Normal,
+        Low
+    };
+
     ThreadPool(size_t numThreads);
     ThreadPool(const ThreadPool& toCopy);
     ~ThreadPool();
 
-    void enqueue(std::function<void()> f);
+    /**
+     * Adds the task \p f to the pool. If this function is called from one of the pool's
+     * worker threads and the \p priority is Priority::Normal, the task is added to the
+     * worker's own deque, otherwise it is placed in the shared queue of the provided
+     * \p priority.
+     *
+     * \param f The task that is executed on one of the worker threads
+     * \param priority The priority with which the task is executed
+     */
+    void enqueue(std::function<void()> f, Priority priority = Priority::Normal);
+
+    /**
+     * Removes all tasks that have not been started yet.
+     */
     void clearTasks();
 
     bool hasOutstandingTasks() const;
+    size_t numberOfThreads() const;
+
+    /**
+     * Calls \p func for consecutive, non-overlapping subranges of [\p begin, \p end),
+     * each of which is at most \p grainSize long. The subranges are distributed across
+     * the worker threads and the calling thread, which takes part in the work. This
+     * function returns after all calls to \p func have returned. It is safe to call this
+     * function from within a task that runs on this pool. If \p func throws, the
+     * subranges that have not been started yet are skipped and the first exception is
+     * rethrown once all running calls have returned.
+     *
+     * \param begin The first index of the range
+     * \param end The index that is one past the last index of the range
+     * \param grainSize The maximum number of indices that are passed to \p func at once
+     * \param func The function that is called with the beginning and end of a subrange
+     */
+    template <typename Func>
+    void parallelFor(size_t begin, size_t end, size_t grainSize, const Func& func);
+
+    /**
+     * Calls \p func for consecutive, non-overlapping subranges of [\p begin, \p end) in
+     * the same way as #parallelFor and combines the returned values using \p reduce. The
+     * values are combined in the order of the subranges, so the result does not depend
+     * on the scheduling of the tasks.
+     *
+     * \param begin The first index of the range
+     * \param end The index that is one past the last index of the range
+     * \param grainSize The maximum number of indices that are passed to \p func at once
+     * \param identity The value with which the reduction starts
+     * \param func The function that is called with the beginning and end of a subrange
+     *        and that returns the value for the subrange
+     * \param reduce The function that combines two values into one
+     * \return The combined value of all subranges
+     */
+    template <typename T, typename Func, typename Reduce>
+    T parallelReduce(size_t begin, size_t end, size_t grainSize, T identity,
+        const Func& func, const Reduce& reduce);
 
 private:
-    friend class Worker;
+    using Task = std::function<void()>;
+    struct WorkerQueue;
 
-    std::vector<std::thread> workers;
+    void work(size_t workerIndex);
+    Task* findTask(size_t workerIndex);
 
-    std::deque<std::function<void()>> tasks;
+    std::vector<std::thread> _workers;
+    std::vector<std::unique_ptr<WorkerQueue>> _workerQueues;
 
-    std::mutex queue_mutex;
-    std::condition_variable condition;
+    // Shared queues for tasks that are enqueued from outside the workers
+    std::array<std::deque<Task*>, 3> _sharedQueues;
+    std::mutex _mutex;
+    std::condition_variable _condition;
 
-    bool stop;
+    // The number of tasks that have been enqueued but not been started yet
+    std::atomic<size_t> _nQueuedTasks = 0;
+    bool _stop = false;
 };
 
 } // namespace openspace
 
+#include "threadpool.inl"
+
 #endif // __OPENSPACE_CORE___THREAD_POOL___H__
@@ -0,0 +1,137 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <algorithm>
+#include <exception>
+#include <type_traits>
+
+namespace openspace {
+
+template <typename Func>
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grainSize,
+                             const Func& func)
+{
+    if (begin >= end) {
+        return;
+    }
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    const size_t nChunks = (end - begin + grainSize - 1) / grainSize;
+    if (nChunks == 1 || _workers.empty()) {
+        func(begin, end);
+        return;
+    }
+
+    // The state is shared with the helper tasks, as they might only start after this
+    // function has returned, at which point they will not find a chunk to work on
+    struct State {
+        std::atomic<size_t> nextChunk = 0;
+        std::atomic<size_t> nFinishedChunks = 0;
+        // The first exception that was thrown by any of the chunks. It is only written
+        // by the thread that sets the hasException flag
+        std::atomic_flag hasException;
+        std::exception_ptr exception;
+    };
+    std::shared_ptr<State> state = std::make_shared<State>();
+
+    // Returns true if a chunk was processed and false if all chunks have been claimed
+    auto processChunk = [state, &func, begin, end, grainSize, nChunks]() {
+        const size_t chunk = state->nextChunk.fetch_add(1);
+        if (chunk >= nChunks) {
+            return false;
+        }
+        // The calling thread has to wait for all chunks before it can rethrow an
+        // exception, as the chunks that are still running reference its stack. The
+        // remaining chunks are skipped once an exception has occurred
+        if (!state->hasException.test()) {
+            try {
+                const size_t b = begin + chunk * grainSize;
+                func(b, std::min(b + grainSize, end));
+            }
+            catch (...) {
+                if (!state->hasException.test_and_set()) {
+                    state->exception = std::current_exception();
+                }
+            }
+        }
+        if (state->nFinishedChunks.fetch_add(1) + 1 == nChunks) {
+            state->nFinishedChunks.notify_all();
+        }
+        return true;
+    };
+
+    const size_t nHelpers = std::min(_workers.size(), nChunks - 1);
+    for (size_t i = 0; i < nHelpers; i++) {
+        enqueue(
+            [processChunk]() { while (processChunk()) {} },
+            Priority::High
+        );
+    }
+    while (processChunk()) {}
+
+    // All chunks are claimed, but some might still be processed by the helpers
+    size_t nFinished = state->nFinishedChunks.load();
+    while (nFinished < nChunks) {
+        state->nFinishedChunks.wait(nFinished);
+        nFinished = state->nFinishedChunks.load();
+    }
+
+    if (state->exception) {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+template <typename T, typename Func, typename Reduce>
+T ThreadPool::parallelReduce(size_t begin, size_t end, size_t grainSize, T identity,
+                             const Func& func, const Reduce& reduce)
+{
+    static_assert(
+        !std::is_same_v<T, bool>,
+        "The results are written concurrently, which std::vector<bool> does not support"
+    );
+
+    if (begin >= end) {
+        return identity;
+    }
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    const size_t nChunks = (end - begin + grainSize - 1) / grainSize;
+    std::vector<T> results(nChunks, identity);
+    parallelFor(
+        begin,
+        end,
+        grainSize,
+        [&results, &func, begin, grainSize](size_t b, size_t e) {
+            results[(b - begin) / grainSize] = func(b, e);
+        }
+    );
+
+    T result = std::move(identity);
+    for (T& r : results) {
+        result = reduce(std::move(result), std::move(r));
+    }
+    return result;
+}
+
+} // namespace openspace
@@ -26,8 +26,10 @@
 #define __OPENSPACE_CORE___TIMELINE___H__
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <cstddef>
+#include <vector>
 
 namespace openspace {
 
@@ -54,7 +56,17 @@ struct Keyframe : public KeyframeBase {
 };
 
 /**
- * Templated class for timelines
+ * Templated class for timelines. The timestamps of the keyframes are additionally stored
+ * in a separate contiguous array that all searches operate on. The result of the last
+ * search is remembered and checked first by the next search, which makes the lookups
+ * amortized constant time if the requested time changes monotonically, for example
+ * during playback.
+ *
+ * Keyframes are usually streamed in at the back and evicted at the front once they are
+ * in the past. Removing keyframes from the front only moves the beginning of the
+ * timestamp array forward. The consumed prefix is released once it makes up half of the
+ * array, so eviction and appending are amortized constant time regardless of how many
+ * keyframes are queued.
  */
 template <typename T>
 class Timeline {
@@ -73,11 +85,31 @@ public:
     const Keyframe<T>* firstKeyframeAfter(double timestamp, bool inclusive = false) const;
     const Keyframe<T>* lastKeyframeBefore(double timestamp, bool inclusive = false) const;
 
+    /**
+     * Returns the index into #keyframes of the first keyframe after the \p timestamp, or
+     * the number of keyframes if there is no such keyframe. The keyframe before that
+     * index, if it exists, is the last keyframe before the \p timestamp.
+     */
+    size_t firstKeyframeIndexAfter(double timestamp, bool inclusive = false) const;
+
     const std::deque<Keyframe<T>>& keyframes() const;
 
 private:
+    /**
+     * Returns the index of the first keyframe whose timestamp is larger (if \p upper is
+     * `true`) or larger or equal (if \p upper is `false`) than \p timestamp.
+     */
+    size_t boundIndex(double timestamp, bool upper) const;
+
+    /// Removes the keyframes in the range [\p begin, \p end)
+    void eraseRange(size_t begin, size_t end);
+
     size_t _nextKeyframeId = 1;
     std::deque<Keyframe<T>> _keyframes;
+    std::vector<double> _timestamps;
+    /// The index of the timestamp of the first keyframe in #_timestamps
+    size_t _timestampsBegin = 0;
+    mutable std::atomic<size_t> _hint = 0;
 };
 
 /**
@@ -22,6 +22,7 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
+
 namespace openspace {
 
 template <typename T>
@@ -32,133 +33,76 @@ Keyframe<T>::Keyframe(size_t i, double t, T d)
 
 template <typename T>
 void Timeline<T>::addKeyframe(double timestamp, T&& data) {
-    Keyframe<T> keyframe(++_nextKeyframeId, timestamp, std::move(data));
-    const auto iter = std::upper_bound(
-        _keyframes.cbegin(),
-        _keyframes.cend(),
-        keyframe,
-        &compareKeyframeTimes
+    // Keyframes are almost always added in chronological order, so we can skip the
+    // search if the new keyframe belongs at the end
+    const size_t index = _timestamps.size() == _timestampsBegin ||
+        _timestamps.back() <= timestamp ?
+        _keyframes.size() :
+        boundIndex(timestamp, true);
+    _keyframes.insert(
+        _keyframes.begin() + index,
+        Keyframe<T>(++_nextKeyframeId, timestamp, std::move(data))
     );
-    _keyframes.insert(iter, std::move(keyframe));
+    _timestamps.insert(_timestamps.begin() + _timestampsBegin + index, timestamp);
 }
 
 template <typename T>
 void Timeline<T>::addKeyframe(double timestamp, const T& data) {
-    Keyframe<T> keyframe(++_nextKeyframeId, timestamp, data);
-    const auto iter = std::upper_bound(
-        _keyframes.cbegin(),
-        _keyframes.cend(),
-        keyframe,
-        &compareKeyframeTimes
+    // Keyframes are almost always added in chronological order, so we can skip the
+    // search if the new keyframe belongs at the end
+    const size_t index = _timestamps.size() == _timestampsBegin ||
+        _timestamps.back() <= timestamp ?
+        _keyframes.size() :
+        boundIndex(timestamp, true);
+    _keyframes.insert(
+        _keyframes.begin() + index,
+        Keyframe<T>(++_nextKeyframeId, timestamp, data)
     );
-    _keyframes.insert(iter, std::move(keyframe));
+    _timestamps.insert(_timestamps.begin() + _timestampsBegin + index, timestamp);
 }
 
 template <typename T>
 void Timeline<T>::removeKeyframesAfter(double timestamp, bool inclusive) {
-    typename std::deque<Keyframe<T>>::const_iterator iter;
-    if (inclusive) {
-        iter = std::lower_bound(
-            _keyframes.cbegin(),
-            _keyframes.cend(),
-            timestamp,
-            &compareKeyframeTimeWithTime
-        );
-    }
-    else {
-        iter = std::upper_bound(
-            _keyframes.cbegin(),
-            _keyframes.cend(),
-            timestamp,
-            &compareTimeWithKeyframeTime
-        );
-    }
-
-    _keyframes.erase(iter, _keyframes.end());
+    eraseRange(boundIndex(timestamp, !inclusive), _keyframes.size());
 }
 
 template <typename T>
 void Timeline<T>::removeKeyframesBefore(double timestamp, bool inclusive) {
-    typename std::deque<Keyframe<T>>::const_iterator iter;
-    if (inclusive) {
-        iter = std::upper_bound(
-            _keyframes.cbegin(),
-            _keyframes.cend(),
-            timestamp,
-            &compareTimeWithKeyframeTime
-        );
-    }
-    else {
-        iter = std::lower_bound(
-            _keyframes.cbegin(),
-            _keyframes.cend(),
-            timestamp,
-            &compareKeyframeTimeWithTime
-        );
-    }
-
-    _keyframes.erase(_keyframes.begin(), iter);
+    eraseRange(0, boundIndex(timestamp, inclusive));
 }
 
 template <typename T>
 void Timeline<T>::removeKeyframesBetween(double begin, double end, bool inclusiveBegin,
                                          bool inclusiveEnd)
 {
-    typename std::deque<Keyframe<T>>::const_iterator beginIter;
-    if (inclusiveBegin) {
-        beginIter = std::lower_bound(
-            _keyframes.cbegin(),
-            _keyframes.cend(),
-            begin,
-            &compareKeyframeTimeWithTime
-        );
-    }
-    else {
-        beginIter = std::upper_bound(
-            _keyframes.cbegin(),
-            _keyframes.cend(),
-            begin,
-            &compareTimeWithKeyframeTime
-        );
-    }
-
-
-    typename std::deque<Keyframe<T>>::const_iterator endIter;
-    if (inclusiveEnd) {
-        endIter = std::upper_bound(
-            beginIter,
-            _keyframes.cend(),
-            end,
-            &compareTimeWithKeyframeTime
-        );
-    }
-    else {
-        endIter = std::lower_bound(
-            beginIter,
-            _keyframes.cend(),
-            end,
-            &compareKeyframeTimeWithTime
-        );
-    }
-
-    _keyframes.erase(beginIter, endIter);
+    const size_t beginIndex = boundIndex(begin, !inclusiveBegin);
+    const size_t endIndex = std::max(beginIndex, boundIndex(end, inclusiveEnd));
+    eraseRange(beginIndex, endIndex);
 }
 
 template <typename T>
 void Timeline<T>::clearKeyframes() {
     _keyframes.clear();
+    _timestamps.clear();
+    _timestampsBegin = 0;
 }
 
 template <typename T>
 void Timeline<T>::removeKeyframe(size_t id) {
-    _keyframes.erase(
-        std::remove_if(
-            _keyframes.begin(),
-            _keyframes.end(),
-            [id] (const Keyframe<T>& keyframe) { return keyframe.id == id; }
-        ),
-        _keyframes.end()
-    );
+    // Compact both containers in lockstep so that the timestamps stay in sync with the
+    // keyframes
+    size_t write = 0;
+    for (size_t read = 0; read < _keyframes.size(); read++) {
+        if (_keyframes[read].id == id) {
+            continue;
+        }
+        if (write != read) {
+            _keyframes[write] = std::move(_keyframes[read]);
+            _timestamps[_timestampsBegin + write] = _timestamps[_timestampsBegin + read];
+        }
+        write++;
+    }
+    eraseRange(write, _keyframes.size());
 }
 
 template <typename T>
@@ -169,56 +113,26 @@ size_t Timeline<T>::nKeyframes() const {
 template <typename T>
 const Keyframe<T>* Timeline<T>::firstKeyframeAfter(double timestamp, bool inclusive) const
 {
-    typename std::deque<Keyframe<T>>::const_iterator it;
-    if (inclusive) {
-        it = std::lower_bound(
-            _keyframes.begin(),
-            _keyframes.end(),
-            timestamp,
-            &compareKeyframeTimeWithTime
-        );
-    }
-    else {
-        it = std::upper_bound(
-            _keyframes.begin(),
-            _keyframes.end(),
-            timestamp,
-            &compareTimeWithKeyframeTime
-        );
-    }
-
-    if (it == _keyframes.end()) {
+    const size_t index = boundIndex(timestamp, !inclusive);
+    if (index == _keyframes.size()) {
         return nullptr;
     }
-    return &(*it);
+    return &_keyframes[index];
 }
 
 template <typename T>
 const Keyframe<T>* Timeline<T>::lastKeyframeBefore(double timestamp, bool inclusive) const
 {
-    typename std::deque<Keyframe<T>>::const_iterator it;
-    if (inclusive) {
-        it = std::upper_bound(
-            _keyframes.begin(),
-            _keyframes.end(),
-            timestamp,
-            &compareTimeWithKeyframeTime
-        );
-    }
-    else {
-        it = std::lower_bound(
-            _keyframes.begin(),
-            _keyframes.end(),
-            timestamp,
-            &compareKeyframeTimeWithTime
-        );
-    }
-
-    if (it == _keyframes.begin()) {
+    const size_t index = boundIndex(timestamp, inclusive);
+    if (index == 0) {
         return nullptr;
     }
-    it--;
-    return &(*it);
+    return &_keyframes[index - 1];
+}
+
+template <typename T>
+size_t Timeline<T>::firstKeyframeIndexAfter(double timestamp, bool inclusive) const {
+    return boundIndex(timestamp, !inclusive);
 }
 
 template <typename T>
@@ -226,4 +140,63 @@ const std::deque<Keyframe<T>>& Timeline<T>::keyframes() const {
     return _keyframes;
 }
 
+template <typename T>
+size_t Timeline<T>::boundIndex(double timestamp, bool upper) const {
+    const double* timestamps = _timestamps.data() + _timestampsBegin;
+    const size_t n = _timestamps.size() - _timestampsBegin;
+
+    // Returns whether the keyframe at index i is located before the bound
+    auto isBefore = [&](size_t i) {
+        return upper ? timestamps[i] <= timestamp : timestamps[i] < timestamp;
+    };
+    auto isBound = [&](size_t i) {
+        return (i == 0 || isBefore(i - 1)) && (i == n || !isBefore(i));
+    };
+
+    // During playback the requested time only moves forward a little every frame, so the
+    // result is almost always the same as the previous result or the one after it
+    const size_t hint = std::min(_hint.load(std::memory_order_relaxed), n);
+    if (isBound(hint)) {
+        return hint;
+    }
+    if (hint < n && isBound(hint + 1)) {
+        _hint.store(hint + 1, std::memory_order_relaxed);
+        return hint + 1;
+    }
+
+    const double* it = upper ?
+        std::upper_bound(timestamps, timestamps + n, timestamp) :
+        std::lower_bound(timestamps, timestamps + n, timestamp);
+    const size_t index = static_cast<size_t>(it - timestamps);
+    _hint.store(index, std::memory_order_relaxed);
+    return index;
+}
+
+template <typename T>
+void Timeline<T>::eraseRange(size_t begin, size_t end) {
+    if (begin == end) {
+        return;
+    }
+
+    _keyframes.erase(_keyframes.begin() + begin, _keyframes.begin() + end);
+    if (begin == 0) {
+        // Evicting from the front only moves the beginning of the timestamps. The stale
+        // prefix is released once it is larger than the part that is still in use
+        _timestampsBegin += end;
+        if (_timestampsBegin > _keyframes.size()) {
+            _timestamps.erase(
+                _timestamps.begin(),
+                _timestamps.begin() + _timestampsBegin
+            );
+            _timestampsBegin = 0;
+        }
+    }
+    else {
+        _timestamps.erase(
+            _timestamps.begin() + _timestampsBegin + begin,
+            _timestamps.begin() + _timestampsBegin + end
+        );
+    }
+}
+
 }  // namespace openspace
@@ -27,6 +27,8 @@
 
 #include <openspace/camera/camera.h>
 #include <openspace/util/time.h>
+#include <memory_resource>
+#include <vector>
 
 namespace openspace {
 
@@ -52,6 +54,25 @@ struct RenderData {
     const Time time;
     int8_t renderBinMask = -1;
     TransformData modelTransform;
+    /// The transformation from the model space into the view space of the camera. It is
+    /// computed relative to the camera position and is more precise than multiplying
+    /// the camera's combined view matrix with the model transformation
+    glm::dmat4 modelViewTransform = glm::dmat4(1.0);
+
+    /// Returns the #modelViewTransform in single precision for use in shaders
+    glm::mat4 modelViewTransformf() const {
+        return glm::mat4(modelViewTransform);
+    }
+
+    /// Returns the projection matrix of the camera applied to the #modelViewTransform
+    glm::mat4 modelViewProjectionTransform() const {
+        return camera.projectionMatrix() * glm::mat4(modelViewTransform);
+    }
+
+    /// Returns the transformation for normals from the model space into view space
+    glm::mat3 normalTransform() const {
+        return glm::mat3(glm::transpose(glm::inverse(glm::dmat3(modelViewTransform))));
+    }
 };
 
 struct RaycasterTask {
@@ -65,8 +86,8 @@ struct DeferredcasterTask {
 };
 
 struct RendererTasks {
-    std::vector<RaycasterTask> raycasterTasks;
-    std::vector<DeferredcasterTask> deferredcasterTasks;
+    std::pmr::vector<RaycasterTask> raycasterTasks;
+    std::pmr::vector<DeferredcasterTask> deferredcasterTasks;
 };
 
 struct RaycastData {
@@ -58,14 +58,19 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/query/query.h>
+#include <openspace/rendering/eclipseshadow.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scene.h>
-#include <openspace/util/spicemanager.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/crc32.h>
 #include <ghoul/opengl/openglstatecache.h>
 #include <cmath>
 #include <fstream>
+#include <limits>
+#include <optional>
+#include <tuple>
 
 namespace {
     constexpr std::string_view _loggerCat = "AtmosphereDeferredcaster";
@@ -83,6 +88,10 @@ namespace {
     constexpr float ATM_EPS = 2000.f;
     constexpr float KM_TO_M = 1000.f;
 
+    // Has to be increased whenever the precalculation shaders or the layout of the cached
+    // tables change so that stale caches are not used
+    constexpr int8_t PrecalculationCacheVersion = 1;
+
     template <GLenum colorBufferAttachment = GL_COLOR_ATTACHMENT0>
     void saveTextureFile(const std::filesystem::path& fileName, const glm::ivec2& size) {
         std::ofstream ppmFile(fileName);
@@ -198,6 +207,26 @@ namespace {
         return t;
     }
 
+    // Reads the contents of the texture bound to \p target into \p file
+    void writeTexture(std::ofstream& file, GLenum target, GLenum format, size_t nValues) {
+        std::vector<float> values(nValues);
+        glGetTexImage(target, 0, format, GL_FLOAT, values.data());
+        file.write(
+            reinterpret_cast<const char*>(values.data()),
+            values.size() * sizeof(float)
+        );
+    }
+
+    // Reads \p nValues from \p file, returning an empty vector if the file is too short
+    std::vector<float> readTexture(std::ifstream& file, size_t nValues) {
+        std::vector<float> values(nValues);
+        file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(float));
+        if (!file) {
+            return std::vector<float>();
+        }
+        return values;
+    }
+
     GLuint createTexture(const glm::ivec3& size, std::string_view name, int components) {
         ghoul_assert(components == 3 || components == 4, "Only 3-4 components supported");
 
@@ -232,6 +261,35 @@ namespace {
 
 namespace openspace {
 
+struct AtmosphereDeferredcaster::Precalculation {
+    // The tables that the passes are writing to. These are the rendered tables, unless
+    // the calculation is progressive, in which case they replace the rendered tables
+    // once the last pass has finished
+    GLuint transmittance = 0;
+    GLuint irradiance = 0;
+    GLuint inScattering = 0;
+
+    // Intermediate tables that are only needed during the calculation
+    GLuint deltaE = 0;
+    GLuint deltaSRayleigh = 0;
+    GLuint deltaSMie = 0;
+    GLuint deltaJ = 0;
+
+    std::unique_ptr<ghoul::opengl::ProgramObject> deltaJProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> irradianceSupTermsProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> inScatteringSupTermsProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> irradianceFinalProgram;
+    std::unique_ptr<ghoul::opengl::ProgramObject> deltaSSupTermsProgram;
+
+    GLuint fbo = 0;
+    GLuint quadVao = 0;
+    GLuint quadVbo = 0;
+
+    bool isProgressive = false;
+    int pass = 0;
+    std::filesystem::path cacheFile;
+};
+
 AtmosphereDeferredcaster::AtmosphereDeferredcaster(float textureScale,
                                        std::vector<ShadowConfiguration> shadowConfigArray,
                                                               bool saveCalculatedTextures)
@@ -260,7 +318,10 @@ void AtmosphereDeferredcaster::initialize() {
     calculateAtmosphereParameters();
 }
 
+AtmosphereDeferredcaster::~AtmosphereDeferredcaster() = default;
+
 void AtmosphereDeferredcaster::deinitialize() {
+    cancelPrecalculation();
     ZoneScoped;
 
     glDeleteTextures(1, &_transmittanceTableTexture);
@@ -312,11 +373,7 @@ float AtmosphereDeferredcaster::eclipseShadow(glm::dvec3 position) {
     }
 }
 
-void AtmosphereDeferredcaster::preRaycast(const RenderData& data, const DeferredcastData&,
-                                          ghoul::opengl::ProgramObject& prg)
-{
-    ZoneScoped;
-
+bool AtmosphereDeferredcaster::isAtmosphereVisible(const RenderData& data) const {
     // Atmosphere Frustum Culling
     glm::dvec3 tPlanetPos = glm::dvec3(_modelTransform * glm::dvec4(0.0, 0.0, 0.0, 1.0));
     const double distance = glm::distance(tPlanetPos, data.camera.eyePositionVec3());
@@ -327,14 +384,61 @@ void AtmosphereDeferredcaster::preRaycast(const RenderData& data, const Deferred
     );
 
     // Number of planet radii to use as distance threshold for culling
-    prg.setUniform(_uniformCache.cullAtmosphere, 1);
-
     constexpr double DistanceCullingRadii = 5000;
     glm::dmat4 MV = glm::dmat4(data.camera.sgctInternal.projectionMatrix()) *
         data.camera.combinedViewMatrix();
-    if (distance <= scaledRadius * DistanceCullingRadii &&
-        isAtmosphereInFrustum(MV, tPlanetPos, scaledRadius + ATM_EPS))
-    {
+    return distance <= scaledRadius * DistanceCullingRadii &&
+        isAtmosphereInFrustum(MV, tPlanetPos, scaledRadius + ATM_EPS);
+}
+
+std::optional<glm::vec4> AtmosphereDeferredcaster::screenSpaceBounds(
+                                                            const RenderData& data) const
+{
+    if (!isAtmosphereVisible(data)) {
+        return glm::vec4(0.f);
+    }
+
+    const glm::dvec3 center =
+        glm::dvec3(_modelTransform * glm::dvec4(0.0, 0.0, 0.0, 1.0));
+    const double radius = glm::length(
+        glm::dmat3(_modelTransform) * glm::dvec3(KM_TO_M * _atmosphereRadius, 0.0, 0.0)
+    ) + ATM_EPS;
+
+    // The atmosphere only changes the pixels whose view rays intersect its sphere, so
+    // the bounds of the projected box around the sphere contain all of them
+    const glm::dmat4 viewProjection = glm::dmat4(data.camera.projectionMatrix()) *
+        data.camera.combinedViewMatrix();
+    glm::dvec2 min = glm::dvec2(std::numeric_limits<double>::max());
+    glm::dvec2 max = glm::dvec2(-std::numeric_limits<double>::max());
+    for (int i = 0; i < 8; ++i) {
+        const glm::dvec3 corner = center + radius * glm::dvec3(
+            (i & 1) ? 1.0 : -1.0,
+            (i & 2) ? 1.0 : -1.0,
+            (i & 4) ? 1.0 : -1.0
+        );
+        const glm::dvec4 clip = viewProjection * glm::dvec4(corner, 1.0);
+        if (clip.w <= 0.0) {
+            // The box reaches behind the camera, so its projection is unbounded
+            return std::nullopt;
+        }
+        const glm::dvec2 ndc = glm::dvec2(clip) / clip.w;
+        min = glm::min(min, ndc);
+        max = glm::max(max, ndc);
+    }
+
+    min = glm::clamp(min, -1.0, 1.0);
+    max = glm::clamp(max, -1.0, 1.0);
+    return glm::vec4(min.x, min.y, max.x, max.y);
+}
+
+void AtmosphereDeferredcaster::preRaycast(const RenderData& data, const DeferredcastData&,
+                                          ghoul::opengl::ProgramObject& prg)
+{
+    ZoneScoped;
+
+    prg.setUniform(_uniformCache.cullAtmosphere, 1);
+
+    if (isAtmosphereVisible(data)) {
         prg.setUniform(_uniformCache.cullAtmosphere, 0);
         prg.setUniform(_uniformCache.opacity, _opacity);
         prg.setUniform(_uniformCache.Rg, _atmospherePlanetRadius);
@@ -393,89 +497,40 @@ void AtmosphereDeferredcaster::preRaycast(const RenderData& data, const Deferred
         // Sun Position in Object Space
         prg.setUniform(_uniformCache.sunDirectionObj, glm::normalize(sunPosObj));
 
-        // Shadow calculations..
+        // Shadow calculations. The shadow cones are shared with the globe that this
+        // atmosphere belongs to and all other receivers of the frame
         _shadowDataArrayCache.clear();
         for (ShadowConfiguration& shadowConf : _shadowConfArray) {
-            // TO REMEMBER: all distances and lengths in world coordinates are in
-            // meters!!! We need to move this to view space...
-            double lt;
-            glm::dvec3 sourcePos = SpiceManager::ref().targetPosition(
+            std::optional<EclipseShadow> shadow = eclipseShadow(
                 shadowConf.source.first,
-                "SSB",
-                "GALACTIC",
-                {},
-                data.time.j2000Seconds(),
-                lt
-            );
-            sourcePos *= KM_TO_M; // converting to meters
-            glm::dvec3 casterPos = SpiceManager::ref().targetPosition(
+                shadowConf.source.second,
                 shadowConf.caster.first,
-                "SSB",
-                "GALACTIC",
-                {},
-                data.time.j2000Seconds(),
-                lt
+                shadowConf.caster.second,
+                data.time.j2000Seconds()
             );
-            casterPos *= KM_TO_M; // converting to meters
-
-            SceneGraphNode* sourceNode = sceneGraphNode(shadowConf.source.first);
-            if (!sourceNode) {
-                if (!shadowConf.printedSourceError) {
-                    LERROR("Invalid scenegraph node for the shadow's receiver");
-                    shadowConf.printedSourceError = true;
-                }
-                return;
-            }
-            SceneGraphNode* casterNode = sceneGraphNode(shadowConf.caster.first);
-            if (!casterNode) {
-                if (!shadowConf.printedCasterError) {
-                    LERROR("Invalid scenegraph node for the shadow's caster");
-                    shadowConf.printedCasterError = true;
+            if (!shadow.has_value()) {
+                if (!shadowConf.printedError) {
+                    LERROR("Invalid scenegraph node for the shadow's source or caster");
+                    shadowConf.printedError = true;
                 }
                 return;
             }
 
-            double sourceScale = std::max(glm::compMax(sourceNode->scale()), 1.0);
-            double casterScale = std::max(glm::compMax(casterNode->scale()), 1.0);
-            double actualSourceRadius = shadowConf.source.second * sourceScale;
-            double actualCasterRadius = shadowConf.caster.second * casterScale;
-            // First we determine if the caster is shadowing the current planet
-            // (all calculations in World Coordinates):
-            glm::dvec3 planetCasterVec = casterPos - data.modelTransform.translation;
-            glm::dvec3 sourceCasterVec = casterPos - sourcePos;
-            double scLength = glm::length(sourceCasterVec);
-            glm::dvec3 planetCasterProj =
-                (glm::dot(planetCasterVec, sourceCasterVec) / (scLength * scLength)) *
-                sourceCasterVec;
-            double dTest = glm::length(planetCasterVec - planetCasterProj);
-            double xpTest = actualCasterRadius * scLength /
-                (actualSourceRadius + actualCasterRadius);
-            double rpTest = actualCasterRadius *
-                (glm::length(planetCasterProj) + xpTest) / xpTest;
-
-            double casterDistSun = glm::length(casterPos - sunPosWorld);
-            double planetDistSun = glm::length(
-                data.modelTransform.translation - sunPosWorld
-            );
-
-            ShadowRenderingStruct shadow;
-            shadow.isShadowing = false;
+            ShadowRenderingStruct sd;
+            sd.isShadowing = false;
 
-            if (((dTest - rpTest) < (_atmospherePlanetRadius * KM_TO_M)) &&
-                (casterDistSun < planetDistSun))
-            {
+            const double radius = _atmospherePlanetRadius * KM_TO_M;
+            if (shadow->isShadowing(data.modelTransform.translation, radius)) {
                 // The current caster is shadowing the current planet
-                shadow.isShadowing = true;
-                shadow.radiusSource = actualSourceRadius;
-                shadow.radiusCaster = actualCasterRadius;
-                shadow.sourceCasterVec = glm::normalize(sourceCasterVec);
-                shadow.penumbra = xpTest;
-                shadow.umbra =
-                    shadow.radiusCaster * scLength /
-                    (shadow.radiusSource - shadow.radiusCaster);
-                shadow.casterPositionVec = casterPos;
+                sd.isShadowing = true;
+                sd.radiusSource = shadow->radiusSource;
+                sd.radiusCaster = shadow->radiusCaster;
+                sd.sourceCasterVec = glm::normalize(shadow->sourceCasterVec);
+                sd.penumbra = shadow->penumbra;
+                sd.umbra = shadow->umbra;
+                sd.casterPositionVec = shadow->casterPosition;
             }
-            _shadowDataArrayCache.push_back(shadow);
+            _shadowDataArrayCache.push_back(sd);
         }
 
         // _uniformNameBuffer[0..15] = "shadowDataArray["
@@ -593,7 +648,7 @@ void AtmosphereDeferredcaster::calculateTransmittance() {
     glFramebufferTexture(
         GL_FRAMEBUFFER,
         GL_COLOR_ATTACHMENT0,
-        _transmittanceTableTexture,
+        _precalculation->transmittance,
         0
     );
     glViewport(0, 0, _transmittanceTableSize.x, _transmittanceTableSize.y);
@@ -639,7 +694,7 @@ GLuint AtmosphereDeferredcaster::calculateDeltaE() {
     program->activate();
     ghoul::opengl::TextureUnit unit;
     unit.activate();
-    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    glBindTexture(GL_TEXTURE_2D, _precalculation->transmittance);
     program->setUniform("transmittanceTexture", unit);
     program->setUniform("Rg", _atmospherePlanetRadius);
     program->setUniform("Rt", _atmosphereRadius);
@@ -673,7 +728,7 @@ std::pair<GLuint, GLuint> AtmosphereDeferredcaster::calculateDeltaS() {
     program->activate();
     ghoul::opengl::TextureUnit unit;
     unit.activate();
-    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    glBindTexture(GL_TEXTURE_2D, _precalculation->transmittance);
     program->setUniform("transmittanceTexture", unit);
     program->setUniform("Rg", _atmospherePlanetRadius);
     program->setUniform("Rt", _atmosphereRadius);
@@ -713,7 +768,7 @@ void AtmosphereDeferredcaster::calculateIrradiance() {
     glFramebufferTexture(
         GL_FRAMEBUFFER,
         GL_COLOR_ATTACHMENT0,
-        _irradianceTableTexture,
+        _precalculation->irradiance,
         0
     );
     glDrawBuffer(GL_COLOR_ATTACHMENT0);
@@ -742,7 +797,7 @@ void AtmosphereDeferredcaster::calculateInscattering(GLuint deltaSRayleigh,
     glFramebufferTexture(
         GL_FRAMEBUFFER,
         GL_COLOR_ATTACHMENT0,
-        _inScatteringTableTexture,
+        _precalculation->inScattering,
         0
     );
     glViewport(0, 0, _textureSize.x, _textureSize.y);
@@ -793,7 +848,7 @@ void AtmosphereDeferredcaster::calculateDeltaJ(int scatteringOrder,
 
     ghoul::opengl::TextureUnit transmittanceUnit;
     transmittanceUnit.activate();
-    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    glBindTexture(GL_TEXTURE_2D, _precalculation->transmittance);
     program.setUniform("transmittanceTexture", transmittanceUnit);
 
     ghoul::opengl::TextureUnit deltaEUnit;
@@ -890,7 +945,7 @@ void AtmosphereDeferredcaster::calculateDeltaS(int scatteringOrder,
 
     ghoul::opengl::TextureUnit transmittanceUnit;
     transmittanceUnit.activate();
-    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    glBindTexture(GL_TEXTURE_2D, _precalculation->transmittance);
     program.setUniform("transmittanceTexture", transmittanceUnit);
 
     ghoul::opengl::TextureUnit deltaJUnit;
@@ -927,7 +982,7 @@ void AtmosphereDeferredcaster::calculateIrradiance(int scatteringOrder,
     glFramebufferTexture(
         GL_FRAMEBUFFER,
         GL_COLOR_ATTACHMENT0,
-        _irradianceTableTexture,
+        _precalculation->irradiance,
         0
     );
     glViewport(0, 0, _deltaETableSize.x, _deltaETableSize.y);
@@ -959,7 +1014,7 @@ void AtmosphereDeferredcaster::calculateInscattering(int scatteringOrder,
     glFramebufferTexture(
         GL_FRAMEBUFFER,
         GL_COLOR_ATTACHMENT0,
-        _inScatteringTableTexture,
+        _precalculation->inScattering,
         0
     );
     glViewport(0, 0, _textureSize.x, _textureSize.y);
@@ -986,61 +1041,269 @@ void AtmosphereDeferredcaster::calculateInscattering(int scatteringOrder,
     prg.deactivate();
 }
 
+std::filesystem::path AtmosphereDeferredcaster::precalculationCacheFile() const {
+    if (!FileSys.cacheManager()) {
+        return std::filesystem::path();
+    }
+
+    // Only the parameters that are used by the precalculation shaders are part of the
+    // key. The floating point values are formatted with their shortest round-trip
+    // representation, so any change in a parameter results in a different key
+    const std::string parameters = fmt::format(
+        "{}|{}|{}|{}|{}|{}|{}|{}|{}|"
+        "{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|"
+        "{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}",
+        PrecalculationCacheVersion, _atmosphereRadius, _atmospherePlanetRadius,
+        _averageGroundReflectance, _rayleighHeightScale, _ozoneEnabled, _ozoneHeightScale,
+        _mieHeightScale, _miePhaseConstant,
+        _rayleighScatteringCoeff.x, _rayleighScatteringCoeff.y,
+        _rayleighScatteringCoeff.z,
+        _ozoneExtinctionCoeff.x, _ozoneExtinctionCoeff.y, _ozoneExtinctionCoeff.z,
+        _mieScatteringCoeff.x, _mieScatteringCoeff.y, _mieScatteringCoeff.z,
+        _mieExtinctionCoeff.x, _mieExtinctionCoeff.y, _mieExtinctionCoeff.z,
+        _transmittanceTableSize.x, _transmittanceTableSize.y,
+        _irradianceTableSize.x, _irradianceTableSize.y,
+        _deltaETableSize.x, _deltaETableSize.y,
+        _muSSamples, _nuSamples, _muSamples, _rSamples,
+        _textureSize.x, _textureSize.y, _textureSize.z, sizeof(float)
+    );
+
+    return FileSys.cacheManager()->cachedFilename(
+        fmt::format("atmosphere_{:08x}", ghoul::hashCRC32(parameters)),
+        ""
+    );
+}
+
+bool AtmosphereDeferredcaster::loadPrecalculatedTables(const std::filesystem::path& file)
+{
+    ZoneScoped;
+
+    std::ifstream cache(file, std::ifstream::binary);
+    if (!cache.good()) {
+        return false;
+    }
+
+    int8_t version = 0;
+    cache.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+    if (version != PrecalculationCacheVersion) {
+        return false;
+    }
+
+    const size_t nTransmittance = 3 * glm::compMul(_transmittanceTableSize);
+    const size_t nIrradiance = 3 * glm::compMul(_irradianceTableSize);
+    const size_t nInScattering = 4 * glm::compMul(_textureSize);
+
+    // All tables are read before any of them is uploaded so that a truncated file does
+    // not leave the textures partially overwritten
+    std::vector<float> transmittance = readTexture(cache, nTransmittance);
+    std::vector<float> irradiance = readTexture(cache, nIrradiance);
+    std::vector<float> inScattering = readTexture(cache, nInScattering);
+    if (transmittance.empty() || irradiance.empty() || inScattering.empty()) {
+        LWARNING(fmt::format("Ignoring incomplete atmosphere cache {}", file));
+        return false;
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        _transmittanceTableSize.x,
+        _transmittanceTableSize.y,
+        GL_RGB,
+        GL_FLOAT,
+        transmittance.data()
+    );
+
+    glBindTexture(GL_TEXTURE_2D, _irradianceTableTexture);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        _irradianceTableSize.x,
+        _irradianceTableSize.y,
+        GL_RGB,
+        GL_FLOAT,
+        irradiance.data()
+    );
+
+    glBindTexture(GL_TEXTURE_3D, _inScatteringTableTexture);
+    glTexSubImage3D(
+        GL_TEXTURE_3D,
+        0,
+        0,
+        0,
+        0,
+        _textureSize.x,
+        _textureSize.y,
+        _textureSize.z,
+        GL_RGBA,
+        GL_FLOAT,
+        inScattering.data()
+    );
+    return true;
+}
+
+void AtmosphereDeferredcaster::savePrecalculatedTables(
+                                                  const std::filesystem::path& file) const
+{
+    ZoneScoped;
+
+    std::ofstream cache(file, std::ofstream::binary);
+    if (!cache.good()) {
+        LWARNING(fmt::format("Could not write atmosphere cache {}", file));
+        return;
+    }
+
+    cache.write(
+        reinterpret_cast<const char*>(&PrecalculationCacheVersion),
+        sizeof(int8_t)
+    );
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    writeTexture(
+        cache,
+        GL_TEXTURE_2D,
+        GL_RGB,
+        3 * glm::compMul(_transmittanceTableSize)
+    );
+
+    glBindTexture(GL_TEXTURE_2D, _irradianceTableTexture);
+    writeTexture(cache, GL_TEXTURE_2D, GL_RGB, 3 * glm::compMul(_irradianceTableSize));
+
+    glBindTexture(GL_TEXTURE_3D, _inScatteringTableTexture);
+    writeTexture(cache, GL_TEXTURE_3D, GL_RGBA, 4 * glm::compMul(_textureSize));
+}
+
 void AtmosphereDeferredcaster::calculateAtmosphereParameters() {
     ZoneScoped;
 
+    // A synchronous calculation supersedes a progressive one that is still running
+    cancelPrecalculation();
+
+    // The precalculation is deterministic for a set of parameters, so the resulting
+    // tables are reused from an earlier run if possible. The debug textures are only
+    // written while calculating, so the cache is bypassed when they are requested
+    const std::filesystem::path cacheFile = precalculationCacheFile();
+    if (!_saveCalculationTextures && !cacheFile.empty() &&
+        loadPrecalculatedTables(cacheFile))
+    {
+        LDEBUG(fmt::format("Loaded precalculated atmosphere tables from {}", cacheFile));
+        return;
+    }
+
+    LDEBUG("Starting precalculations for scattering effects");
+    beginPrecalculation(false, cacheFile);
+    while (!stepPrecalculation()) {}
+    finishPrecalculation();
+    LDEBUG("Ended precalculations for Atmosphere effects");
+}
+
+void AtmosphereDeferredcaster::startProgressiveCalculation() {
+    ZoneScoped;
+
+    cancelPrecalculation();
+
+    // Loading cached tables is fast enough to not need spreading out over frames
+    const std::filesystem::path cacheFile = precalculationCacheFile();
+    if (!_saveCalculationTextures && !cacheFile.empty() &&
+        loadPrecalculatedTables(cacheFile))
+    {
+        LDEBUG(fmt::format("Loaded precalculated atmosphere tables from {}", cacheFile));
+        return;
+    }
+
+    LDEBUG("Starting progressive precalculations for scattering effects");
+    beginPrecalculation(true, cacheFile);
+}
+
+bool AtmosphereDeferredcaster::updateProgressiveCalculation() {
+    if (!_precalculation) {
+        return false;
+    }
+
+    ghoul_assert(_precalculation->isProgressive, "Calculation must be progressive");
+    if (stepPrecalculation()) {
+        finishPrecalculation();
+        LDEBUG("Ended progressive precalculations for Atmosphere effects");
+        return false;
+    }
+    return true;
+}
+
+void AtmosphereDeferredcaster::beginPrecalculation(bool progressive,
+                                                   std::filesystem::path cacheFile)
+{
+    ZoneScoped;
+
+    ghoul_assert(!_precalculation, "Precalculation already in progress");
+
+    _precalculation = std::make_unique<Precalculation>();
+    Precalculation& p = *_precalculation;
+    p.isProgressive = progressive;
+    p.cacheFile = std::move(cacheFile);
+
+    if (progressive) {
+        p.transmittance = createTexture(_transmittanceTableSize, "Transmittance");
+        p.irradiance = createTexture(_irradianceTableSize, "Irradiance");
+        p.inScattering = createTexture(_textureSize, "InScattering", 4);
+    }
+    else {
+        p.transmittance = _transmittanceTableTexture;
+        p.irradiance = _irradianceTableTexture;
+        p.inScattering = _inScatteringTableTexture;
+    }
+    p.deltaJ = createTexture(_textureSize, "DeltaJ", 3);
+
     using ProgramObject = ghoul::opengl::ProgramObject;
-    std::unique_ptr<ProgramObject> deltaJProgram = ProgramObject::Build(
+    p.deltaJProgram = ProgramObject::Build(
         "DeltaJ Program",
         absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
         absPath("${MODULE_ATMOSPHERE}/shaders/deltaJ_calc_fs.glsl"),
         absPath("${MODULE_ATMOSPHERE}/shaders/calculation_gs.glsl")
     );
-    std::unique_ptr<ProgramObject> irradianceSupTermsProgram = ProgramObject::Build(
+    p.irradianceSupTermsProgram = ProgramObject::Build(
         "IrradianceSupTerms Program",
         absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
         absPath("${MODULE_ATMOSPHERE}/shaders/irradiance_sup_calc_fs.glsl")
     );
-    std::unique_ptr<ProgramObject> inScatteringSupTermsProgram = ProgramObject::Build(
+    p.inScatteringSupTermsProgram = ProgramObject::Build(
         "InScatteringSupTerms Program",
         absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
         absPath("${MODULE_ATMOSPHERE}/shaders/inScattering_sup_calc_fs.glsl"),
         absPath("${MODULE_ATMOSPHERE}/shaders/calculation_gs.glsl")
     );
-    std::unique_ptr<ProgramObject> irradianceFinalProgram = ProgramObject::Build(
+    p.irradianceFinalProgram = ProgramObject::Build(
         "IrradianceEFinal Program",
         absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
         absPath("${MODULE_ATMOSPHERE}/shaders/irradiance_final_fs.glsl")
     );
-    std::unique_ptr<ProgramObject> deltaSSupTermsProgram = ProgramObject::Build(
+    p.deltaSSupTermsProgram = ProgramObject::Build(
         "DeltaSSUPTerms Program",
         absPath("${MODULE_ATMOSPHERE}/shaders/calculation_vs.glsl"),
         absPath("${MODULE_ATMOSPHERE}/shaders/deltaS_sup_calc_fs.glsl"),
         absPath("${MODULE_ATMOSPHERE}/shaders/calculation_gs.glsl")
     );
 
-
     // Saves current FBO first
     GLint defaultFBO;
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &defaultFBO);
 
-    GLint viewport[4];
-    global::renderEngine->openglStateCache().viewport(viewport);
-
     // Creates the FBO for the calculations
-    GLuint calcFBO;
-    glGenFramebuffers(1, &calcFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, calcFBO);
+    glGenFramebuffers(1, &p.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, p.fbo);
     GLenum drawBuffers[1] = { GL_COLOR_ATTACHMENT0 };
     glDrawBuffers(1, drawBuffers);
 
     // Prepare for rendering/calculations
-    GLuint quadVao;
-    glGenVertexArrays(1, &quadVao);
-    glBindVertexArray(quadVao);
-    GLuint quadVbo;
-    glGenBuffers(1, &quadVbo);
-    glBindBuffer(GL_ARRAY_BUFFER, quadVbo);
+    glGenVertexArrays(1, &p.quadVao);
+    glBindVertexArray(p.quadVao);
+    glGenBuffers(1, &p.quadVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, p.quadVbo);
 
     const GLfloat VertexData[] = {
         //  x      y    z
@@ -1056,94 +1319,175 @@ void AtmosphereDeferredcaster::calculateAtmosphereParameters() {
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), nullptr);
 
-    // Execute Calculations
-    LDEBUG("Starting precalculations for scattering effects");
-    glDisable(GL_BLEND);
+    glBindFramebuffer(GL_FRAMEBUFFER, defaultFBO);
+    glBindVertexArray(0);
+}
 
-    // See Precomputed Atmosphere Scattering from Bruneton et al. paper, algorithm 4.1:
-    calculateTransmittance();
+bool AtmosphereDeferredcaster::stepPrecalculation() {
+    ZoneScoped;
 
-    // line 2 in algorithm 4.1
-    GLuint deltaETable = calculateDeltaE();
+    ghoul_assert(_precalculation, "No precalculation in progress");
+    Precalculation& p = *_precalculation;
 
-    // line 3 in algorithm 4.1
-    auto [deltaSRayleighTable, deltaSMieTable] = calculateDeltaS();
+    // The first five passes calculate the single scattering, followed by five passes for
+    // each of the higher scattering orders
+    constexpr int NumSingleScatteringPasses = 5;
+    constexpr int NumPassesPerOrder = 5;
+    constexpr int MaxScatteringOrder = 4;
+    constexpr int NumPasses =
+        NumSingleScatteringPasses + (MaxScatteringOrder - 1) * NumPassesPerOrder;
 
-    // line 4 in algorithm 4.1
-    calculateIrradiance();
+    // Saves current FBO first
+    GLint defaultFBO;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &defaultFBO);
 
-    // line 5 in algorithm 4.1
-    calculateInscattering(deltaSRayleighTable, deltaSMieTable);
+    GLint viewport[4];
+    global::renderEngine->openglStateCache().viewport(viewport);
 
-    GLuint deltaJTable = createTexture(_textureSize, "DeltaJ", 3);
+    glBindFramebuffer(GL_FRAMEBUFFER, p.fbo);
+    glBindVertexArray(p.quadVao);
+    glDisable(GL_BLEND);
 
-    // loop in line 6 in algorithm 4.1
-    for (int scatteringOrder = 2; scatteringOrder <= 4; ++scatteringOrder) {
-        // line 7 in algorithm 4.1
-        calculateDeltaJ(
-            scatteringOrder,
-            *deltaJProgram,
-            deltaJTable,
-            deltaETable,
-            deltaSRayleighTable,
-            deltaSMieTable
-        );
+    // See Precomputed Atmosphere Scattering from Bruneton et al. paper, algorithm 4.1
+    if (p.pass < NumSingleScatteringPasses) {
+        switch (p.pass) {
+            case 0:
+                // line 1 in algorithm 4.1
+                calculateTransmittance();
+                break;
+            case 1:
+                // line 2 in algorithm 4.1
+                p.deltaE = calculateDeltaE();
+                break;
+            case 2:
+                // line 3 in algorithm 4.1
+                std::tie(p.deltaSRayleigh, p.deltaSMie) = calculateDeltaS();
+                break;
+            case 3:
+                // line 4 in algorithm 4.1
+                calculateIrradiance();
+                break;
+            case 4:
+                // line 5 in algorithm 4.1
+                calculateInscattering(p.deltaSRayleigh, p.deltaSMie);
+                break;
+        }
+    }
+    else {
+        // loop in line 6 in algorithm 4.1
+        const int pass = p.pass - NumSingleScatteringPasses;
+        const int scatteringOrder = 2 + pass / NumPassesPerOrder;
+        switch (pass % NumPassesPerOrder) {
+            case 0:
+                // line 7 in algorithm 4.1
+                calculateDeltaJ(
+                    scatteringOrder,
+                    *p.deltaJProgram,
+                    p.deltaJ,
+                    p.deltaE,
+                    p.deltaSRayleigh,
+                    p.deltaSMie
+                );
+                break;
+            case 1:
+                // line 8 in algorithm 4.1
+                calculateDeltaE(
+                    scatteringOrder,
+                    *p.irradianceSupTermsProgram,
+                    p.deltaE,
+                    p.deltaSRayleigh,
+                    p.deltaSMie
+                );
+                break;
+            case 2:
+                // line 9 in algorithm 4.1
+                calculateDeltaS(
+                    scatteringOrder,
+                    *p.inScatteringSupTermsProgram,
+                    p.deltaSRayleigh,
+                    p.deltaJ
+                );
+                break;
+            case 3:
+                glEnable(GL_BLEND);
+                glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+                glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+
+                // line 10 in algorithm 4.1
+                calculateIrradiance(
+                    scatteringOrder,
+                    *p.irradianceFinalProgram,
+                    p.deltaE
+                );
+                break;
+            case 4:
+                glEnable(GL_BLEND);
+                glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+                glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+
+                // line 11 in algorithm 4.1
+                calculateInscattering(
+                    scatteringOrder,
+                    *p.deltaSSupTermsProgram,
+                    p.deltaSRayleigh
+                );
+                break;
+        }
+    }
 
-        // line 8 in algorithm 4.1
-        calculateDeltaE(
-            scatteringOrder,
-            *irradianceSupTermsProgram,
-            deltaETable,
-            deltaSRayleighTable,
-            deltaSMieTable
-        );
+    // Restores system state
+    global::renderEngine->openglStateCache().resetBlendState();
+    glBindFramebuffer(GL_FRAMEBUFFER, defaultFBO);
+    global::renderEngine->openglStateCache().setViewportState(viewport);
+    glBindVertexArray(0);
 
-        // line 9 in algorithm 4.1
-        calculateDeltaS(
-            scatteringOrder,
-            *inScatteringSupTermsProgram,
-            deltaSRayleighTable,
-            deltaJTable
-        );
+    p.pass++;
+    return p.pass == NumPasses;
+}
 
-        glEnable(GL_BLEND);
-        glBlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
-        glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+void AtmosphereDeferredcaster::finishPrecalculation() {
+    ZoneScoped;
 
-        // line 10 in algorithm 4.1
-        calculateIrradiance(
-            scatteringOrder,
-            *irradianceFinalProgram,
-            deltaETable
-        );
+    ghoul_assert(_precalculation, "No precalculation in progress");
+    Precalculation& p = *_precalculation;
 
-        // line 11 in algorithm 4.1
-        calculateInscattering(
-            scatteringOrder,
-            *deltaSSupTermsProgram,
-            deltaSRayleighTable
-        );
+    if (p.isProgressive) {
+        // The previously rendered tables are handed to the precalculation so that they
+        // are deleted together with the intermediate tables
+        std::swap(_transmittanceTableTexture, p.transmittance);
+        std::swap(_irradianceTableTexture, p.irradiance);
+        std::swap(_inScatteringTableTexture, p.inScattering);
+    }
 
-        glDisable(GL_BLEND);
+    const std::filesystem::path cacheFile = std::move(p.cacheFile);
+    cancelPrecalculation();
+
+    if (!cacheFile.empty()) {
+        savePrecalculatedTables(cacheFile);
     }
+}
 
-    // Restores OpenGL blending state
-    global::renderEngine->openglStateCache().resetBlendState();
+void AtmosphereDeferredcaster::cancelPrecalculation() {
+    if (!_precalculation) {
+        return;
+    }
 
-    glDeleteTextures(1, &deltaETable);
-    glDeleteTextures(1, &deltaSRayleighTable);
-    glDeleteTextures(1, &deltaSMieTable);
-    glDeleteTextures(1, &deltaJTable);
+    Precalculation& p = *_precalculation;
+    if (p.isProgressive) {
+        glDeleteTextures(1, &p.transmittance);
+        glDeleteTextures(1, &p.irradiance);
+        glDeleteTextures(1, &p.inScattering);
+    }
+    glDeleteTextures(1, &p.deltaE);
+    glDeleteTextures(1, &p.deltaSRayleigh);
+    glDeleteTextures(1, &p.deltaSMie);
+    glDeleteTextures(1, &p.deltaJ);
 
-    // Restores system state
-    glBindFramebuffer(GL_FRAMEBUFFER, defaultFBO);
-    global::renderEngine->openglStateCache().setViewportState(viewport);
-    glDeleteBuffers(1, &quadVbo);
-    glDeleteVertexArrays(1, &quadVao);
-    glDeleteFramebuffers(1, &calcFBO);
-    glBindVertexArray(0);
+    glDeleteBuffers(1, &p.quadVbo);
+    glDeleteVertexArrays(1, &p.quadVao);
+    glDeleteFramebuffers(1, &p.fbo);
 
-    LDEBUG("Ended precalculations for Atmosphere effects");
+    _precalculation = nullptr;
 }
 
 void AtmosphereDeferredcaster::step3DTexture(ghoul::opengl::ProgramObject& prg, int layer)
@@ -31,6 +31,9 @@
 #include <ghoul/glm.h>
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <filesystem>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -59,7 +62,7 @@ class AtmosphereDeferredcaster : public Deferredcaster {
 public:
     AtmosphereDeferredcaster(float textureScale,
         std::vector<ShadowConfiguration> shadowConfigArray, bool saveCalculatedTextures);
-    ~AtmosphereDeferredcaster() override = default;
+    ~AtmosphereDeferredcaster() override;
 
     void initialize();
     void deinitialize();
@@ -75,10 +78,27 @@ public:
     void initializeCachedVariables(ghoul::opengl::ProgramObject& program) override;
 
     void update(const UpdateData&) override;
+    std::optional<glm::vec4> screenSpaceBounds(const RenderData& data) const override;
     float eclipseShadow(glm::dvec3 position);
 
     void calculateAtmosphereParameters();
 
+    /**
+     * Starts recalculating the precalculated tables one pass at a time in the following
+     * calls to #updateProgressiveCalculation. The current tables keep being rendered
+     * until the new ones are complete. Starting a new calculation discards one that is
+     * still in progress.
+     */
+    void startProgressiveCalculation();
+
+    /**
+     * Runs the next pass of a progressive calculation, if there is one, and replaces the
+     * rendered tables after the last pass.
+     *
+     * \return `true` if the progressive calculation is still in progress
+     */
+    bool updateProgressiveCalculation();
+
     void setModelTransform(glm::dmat4 transform);
     void setOpacity(float opacity);
 
@@ -93,8 +113,22 @@ public:
     void setHardShadows(bool enabled);
 
 private:
+    bool isAtmosphereVisible(const RenderData& data) const;
     void step3DTexture(ghoul::opengl::ProgramObject& prg, int layer);
 
+    /// Returns the file in which the precalculated tables for the current parameters are
+    /// cached, or an empty path if there is no cache
+    std::filesystem::path precalculationCacheFile() const;
+    bool loadPrecalculatedTables(const std::filesystem::path& file);
+    void savePrecalculatedTables(const std::filesystem::path& file) const;
+
+    struct Precalculation;
+    void beginPrecalculation(bool progressive, std::filesystem::path cacheFile);
+    /// Runs the next pass of the precalculation and returns whether it was the last one
+    bool stepPrecalculation();
+    void finishPrecalculation();
+    void cancelPrecalculation();
+
     void calculateTransmittance();
     GLuint calculateDeltaE();
     std::pair<GLuint, GLuint> calculateDeltaS();
@@ -129,6 +163,8 @@ private:
     GLuint _irradianceTableTexture = 0;
     GLuint _inScatteringTableTexture = 0;
 
+    std::unique_ptr<Precalculation> _precalculation;
+
     // Atmosphere Data
     bool _ozoneEnabled = false;
     bool _sunFollowingCameraEnabled = false;
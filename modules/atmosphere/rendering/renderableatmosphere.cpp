@@ -182,6 +182,15 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo ProgressiveInfo = {
+        "ProgressiveCalculation",
+        "Progressive Calculation",
+        "If enabled, changes to the scattering parameters are recalculated over several "
+        "frames, one pass per frame, while the previous result is still shown. This "
+        "keeps the rendering interactive while tuning the atmosphere",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     struct [[codegen::Dictionary(RenderableAtmosphere)]] Parameters {
         struct ShadowGroup {
             // Individual light sources
@@ -270,6 +279,9 @@ namespace {
 
         // [[codegen::verbatim(SunAngularSize.description)]]
         std::optional<float> sunAngularSize [[codegen::inrange(0.0, 180.0)]];
+
+        // [[codegen::verbatim(ProgressiveInfo.description)]]
+        std::optional<bool> progressiveCalculation;
     };
 #include "renderableatmosphere_codegen.cpp"
 
@@ -316,6 +328,7 @@ RenderableAtmosphere::RenderableAtmosphere(const ghoul::Dictionary& dictionary)
         glm::vec2(95.f, 100.f), glm::vec2(0.f), glm::vec2(180.f)
     )
     , _sunAngularSize(SunAngularSize, 0.3f, 0.f, 180.f)
+    , _progressiveCalculation(ProgressiveInfo, false)
  {
     auto updateWithCalculation = [this]() {
         _deferredCasterNeedsUpdate = true;
@@ -435,6 +448,9 @@ RenderableAtmosphere::RenderableAtmosphere(const ghoul::Dictionary& dictionary)
     _sunAngularSize = p.sunAngularSize.value_or(_sunAngularSize);
     _sunAngularSize.onChange(updateWithoutCalculation);
     addProperty(_sunAngularSize);
+
+    _progressiveCalculation = p.progressiveCalculation.value_or(_progressiveCalculation);
+    addProperty(_progressiveCalculation);
 }
 
 void RenderableAtmosphere::deinitializeGL() {
@@ -479,9 +495,17 @@ void RenderableAtmosphere::update(const UpdateData& data) {
         _deferredCasterNeedsUpdate = false;
     }
     if (_deferredCasterNeedsCalculation) {
-        _deferredcaster->calculateAtmosphereParameters();
+        if (_progressiveCalculation) {
+            _deferredcaster->startProgressiveCalculation();
+        }
+        else {
+            _deferredcaster->calculateAtmosphereParameters();
+        }
         _deferredCasterNeedsCalculation = false;
     }
+    else {
+        _deferredcaster->updateProgressiveCalculation();
+    }
 
     glm::dmat4 modelTransform = computeModelTransformMatrix(data.modelTransform);
     _deferredcaster->setModelTransform(modelTransform);
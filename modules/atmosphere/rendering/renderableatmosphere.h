@@ -56,8 +56,7 @@ struct ShadowConfiguration {
     std::pair<std::string, double> caster;
     // Set to 'true' if we printed an error because we couldn't find the source or caster.
     // We only want to print a message once
-    bool printedSourceError = false;
-    bool printedCasterError = false;
+    bool printedError = false;
 };
 
 namespace documentation { struct Documentation; }
@@ -97,6 +96,7 @@ private:
     properties::BoolProperty _sunFollowingCameraEnabled;
     properties::BoolProperty _hardShadowsEnabled;
     properties::FloatProperty _sunAngularSize;
+    properties::BoolProperty _progressiveCalculation;
 
     // Atmosphere dimming
     properties::FloatProperty _atmosphereDimmingHeight;
@@ -79,31 +79,39 @@ DashboardItemDate::DashboardItemDate(const ghoul::Dictionary& dictionary)
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
     _formatString = p.formatString.value_or(_formatString);
+    _formatString.onChange([this]() { _isTextDirty = true; });
     addProperty(_formatString);
 
     _timeFormat = p.timeFormat.value_or(_timeFormat);
+    _timeFormat.onChange([this]() { _isTextDirty = true; });
     addProperty(_timeFormat);
 }
 
 void DashboardItemDate::render(glm::vec2& penPosition) {
     ZoneScoped;
 
-    std::string time = SpiceManager::ref().dateFromEphemerisTime(
-        global::timeManager->time().j2000Seconds(),
-        _timeFormat.value().c_str()
-    );
-
-    try {
-        RenderFont(
-            *_font,
-            penPosition,
-            fmt::format(fmt::runtime(_formatString.value()), time)
+    // Converting the time into a date requires a call into SPICE, so we only do that if
+    // the time has changed, which is not the case while the time is paused or if the
+    // dashboard is rendered in multiple windows
+    const double j2000Seconds = global::timeManager->time().j2000Seconds();
+    if (_isTextDirty || j2000Seconds != _lastJ2000Seconds) {
+        std::string time = SpiceManager::ref().dateFromEphemerisTime(
+            j2000Seconds,
+            _timeFormat.value().c_str()
         );
+
+        try {
+            _text = fmt::format(fmt::runtime(_formatString.value()), time);
+        }
+        catch (const fmt::format_error&) {
+            LERRORC("DashboardItemDate", "Illegal format string");
+            _text.clear();
+        }
+        _lastJ2000Seconds = j2000Seconds;
+        _isTextDirty = false;
     }
-    catch (const fmt::format_error&) {
-        LERRORC("DashboardItemDate", "Illegal format string");
-    }
-    penPosition.y -= _font->height();
+
+    renderText(penPosition);
 }
 
 glm::vec2 DashboardItemDate::size() const {
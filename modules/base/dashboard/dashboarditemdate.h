@@ -47,6 +47,8 @@ public:
 private:
     properties::StringProperty _formatString;
     properties::StringProperty _timeFormat;
+
+    double _lastJ2000Seconds = 0.0;
 };
 
 } // namespace openspace
@@ -39,6 +39,7 @@
 #include <ghoul/font/fontrenderer.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/profiling.h>
+#include <iterator>
 
 namespace {
     enum Type {
@@ -258,6 +259,7 @@ DashboardItemDistance::DashboardItemDistance(const ghoul::Dictionary& dictionary
 
     _doSimplification = p.simplification.value_or(_doSimplification);
     _doSimplification.onChange([this]() {
+        _isTextDirty = true;
         _requestedUnit.setVisibility(
             _doSimplification ?
             properties::Property::Visibility::Hidden :
@@ -278,12 +280,12 @@ DashboardItemDistance::DashboardItemDistance(const ghoul::Dictionary& dictionary
         _requestedUnit = static_cast<int>(unit);
     }
     _requestedUnit.setVisibility(properties::Property::Visibility::Hidden);
+    _requestedUnit.onChange([this]() { _isTextDirty = true; });
     addProperty(_requestedUnit);
 
     _formatString = p.formatString.value_or(_formatString);
+    _formatString.onChange([this]() { _isTextDirty = true; });
     addProperty(_formatString);
-
-    _buffer.resize(256);
 }
 
 std::pair<glm::dvec3, std::string> DashboardItemDistance::positionAndLabel(
@@ -357,31 +359,41 @@ void DashboardItemDistance::render(glm::vec2& penPosition) {
     );
 
     const double d = glm::length(sourceInfo.first - destinationInfo.first);
-    std::pair<double, std::string_view> dist;
-    if (_doSimplification) {
-        dist = simplifyDistance(d);
-    }
-    else {
-        const DistanceUnit unit = static_cast<DistanceUnit>(_requestedUnit.value());
-        const double convertedD = convertMeters(d, unit);
-        dist = std::pair(convertedD, nameForDistanceUnit(unit, convertedD != 1.0));
-    }
 
-    std::fill(_buffer.begin(), _buffer.end(), char(0));
-    try {
-        char* end = fmt::format_to(
-            _buffer.data(),
-            fmt::runtime(_formatString.value()),
-            sourceInfo.second, destinationInfo.second, dist.first, dist.second
-        );
+    // The text only has to be recreated if the distance or one of the labels changed
+    const bool hasChanged = _isTextDirty || d != _lastDistance ||
+        sourceInfo.second != _lastLabels.first ||
+        destinationInfo.second != _lastLabels.second;
+    if (hasChanged) {
+        std::pair<double, std::string_view> dist;
+        if (_doSimplification) {
+            dist = simplifyDistance(d);
+        }
+        else {
+            const DistanceUnit unit = static_cast<DistanceUnit>(_requestedUnit.value());
+            const double convertedD = convertMeters(d, unit);
+            dist = std::pair(convertedD, nameForDistanceUnit(unit, convertedD != 1.0));
+        }
 
-        std::string_view text = std::string_view(_buffer.data(), end - _buffer.data());
-        RenderFont(*_font, penPosition, text);
-    }
-    catch (const fmt::format_error&) {
-        LERRORC("DashboardItemDate", "Illegal format string");
+        _text.clear();
+        try {
+            fmt::format_to(
+                std::back_inserter(_text),
+                fmt::runtime(_formatString.value()),
+                sourceInfo.second, destinationInfo.second, dist.first, dist.second
+            );
+        }
+        catch (const fmt::format_error&) {
+            LERRORC("DashboardItemDistance", "Illegal format string");
+            _text.clear();
+        }
+
+        _lastDistance = d;
+        _lastLabels = { std::move(sourceInfo.second), std::move(destinationInfo.second) };
+        _isTextDirty = false;
     }
-    penPosition.y -= _font->height();
+
+    renderText(penPosition);
 }
 
 glm::vec2 DashboardItemDistance::size() const {
@@ -66,7 +66,8 @@ private:
     Component _source;
     Component _destination;
 
-    std::vector<char> _buffer;
+    double _lastDistance = 0.0;
+    std::pair<std::string, std::string> _lastLabels;
 };
 
 } // namespace openspace
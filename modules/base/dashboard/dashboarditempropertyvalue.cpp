@@ -81,10 +81,14 @@ DashboardItemPropertyValue::DashboardItemPropertyValue(
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
     _propertyUri = p.uri.value_or(_propertyUri);
-    _propertyUri.onChange([this]() { _propertyIsDirty = true; });
+    _propertyUri.onChange([this]() {
+        _propertyIsDirty = true;
+        _isTextDirty = true;
+    });
     addProperty(_propertyUri);
 
     _displayString = p.displayString.value_or(_displayString);
+    _displayString.onChange([this]() { _isTextDirty = true; });
     addProperty(_displayString);
 }
 
@@ -98,12 +102,12 @@ void DashboardItemPropertyValue::render(glm::vec2& penPosition) {
 
     if (_property) {
         std::string value = _property->stringValue();
-        RenderFont(
-            *_font,
-            penPosition,
-            fmt::format(fmt::runtime(_displayString.value()), value)
-        );
-        penPosition.y -= _font->height();
+        if (_isTextDirty || value != _lastValue) {
+            _text = fmt::format(fmt::runtime(_displayString.value()), value);
+            _lastValue = std::move(value);
+            _isTextDirty = false;
+        }
+        renderText(penPosition);
     }
 }
 
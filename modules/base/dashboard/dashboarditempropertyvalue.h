@@ -49,6 +49,7 @@ public:
 private:
     properties::Property* _property = nullptr;
     bool _propertyIsDirty = true;
+    std::string _lastValue;
 
     properties::StringProperty _propertyUri;
     properties::StringProperty _displayString;
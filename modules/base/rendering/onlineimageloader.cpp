@@ -0,0 +1,459 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/base/rendering/onlineimageloader.h>
+
+#include <openspace/util/httpengine.h>
+#include <openspace/util/job.h>
+#include <openspace/util/stablehash.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/fmt.h>
+#include <ghoul/io/texture/texturereader.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/opengl/texture.h>
+#include <stb_image.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <optional>
+#include <string_view>
+#include <thread>
+
+namespace {
+    constexpr std::string_view _loggerCat = "OnlineImageLoader";
+
+    // Large images can take a while to download, so we are more patient than for other
+    // files that are fetched into memory
+    constexpr std::chrono::seconds DownloadTimeout = std::chrono::seconds(30);
+
+    struct Response {
+        std::vector<char> data;
+        std::string etag;
+        std::string lastModified;
+        openspace::HttpEngine::Result result;
+    };
+
+    // The validators and the format of an image that is stored in the cache
+    struct CacheEntry {
+        std::string etag;
+        std::string lastModified;
+        std::string format;
+    };
+
+    std::filesystem::path cachePath(const std::filesystem::path& directory,
+                                    std::string_view url)
+    {
+        return directory / fmt::format("{:016x}", openspace::stableHash(url));
+    }
+
+    void parseHeader(Response& response, std::string_view line) {
+        if (line.starts_with("HTTP/")) {
+            // A new status line means that we were redirected and the headers we have
+            // collected so far belong to the previous response
+            response.etag.clear();
+            response.lastModified.clear();
+            return;
+        }
+
+        const size_t colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            return;
+        }
+
+        std::string key = std::string(line.substr(0, colon));
+        std::transform(
+            key.begin(),
+            key.end(),
+            key.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); }
+        );
+        std::string_view value = line.substr(colon + 1);
+        const size_t first = value.find_first_not_of(" \t");
+        const size_t last = value.find_last_not_of(" \t\r\n");
+        value = first == std::string_view::npos ?
+            std::string_view() :
+            value.substr(first, last - first + 1);
+
+        if (key == "etag") {
+            response.etag = value;
+        }
+        else if (key == "last-modified") {
+            response.lastModified = value;
+        }
+    }
+
+    std::optional<CacheEntry> readCacheEntry(const std::filesystem::path& path) {
+        std::ifstream file(path.string() + ".meta");
+        if (!file.good()) {
+            return std::nullopt;
+        }
+        CacheEntry entry;
+        std::getline(file, entry.etag);
+        std::getline(file, entry.lastModified);
+        std::getline(file, entry.format);
+        if (file.fail()) {
+            return std::nullopt;
+        }
+        return entry;
+    }
+
+    bool readFile(const std::filesystem::path& path, std::vector<char>& data) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.good()) {
+            return false;
+        }
+        data.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(data.data(), data.size());
+        return file.good();
+    }
+
+    void writeCacheEntry(const std::filesystem::path& path, const CacheEntry& entry,
+                         const std::vector<char>& data)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+        // The files are written under a temporary name first so that another loader
+        // requesting the same URL never reads a partially written file
+        const std::string suffix = fmt::format(
+            ".{}.tmp", std::hash<std::thread::id>()(std::this_thread::get_id())
+        );
+        const std::filesystem::path dataFile = path;
+        const std::filesystem::path metaFile = path.string() + ".meta";
+        {
+            std::ofstream file(dataFile.string() + suffix, std::ios::binary);
+            file.write(data.data(), data.size());
+            if (!file.good()) {
+                return;
+            }
+        }
+        {
+            std::ofstream file(metaFile.string() + suffix);
+            file << entry.etag << '\n' << entry.lastModified << '\n' << entry.format
+                 << '\n';
+            if (!file.good()) {
+                return;
+            }
+        }
+        std::filesystem::rename(dataFile.string() + suffix, dataFile, ec);
+        if (!ec) {
+            std::filesystem::rename(metaFile.string() + suffix, metaFile, ec);
+        }
+        if (ec) {
+            LWARNING(fmt::format("Could not cache image in {}: {}", path, ec.message()));
+        }
+    }
+
+    // Halves the size of the image with a box filter until it fits into \p maxSize
+    void downscale(std::vector<std::byte>& pixels, glm::uvec2& dimensions, int nChannels,
+                   unsigned int maxSize)
+    {
+        while (dimensions.x > maxSize || dimensions.y > maxSize) {
+            const glm::uvec2 dim = glm::max(dimensions / 2u, glm::uvec2(1));
+            std::vector<std::byte> result(static_cast<size_t>(dim.x) * dim.y * nChannels);
+            auto pixel = [&](unsigned int x, unsigned int y, int c) {
+                x = std::min(x, dimensions.x - 1);
+                y = std::min(y, dimensions.y - 1);
+                const size_t i = (static_cast<size_t>(y) * dimensions.x + x) * nChannels;
+                return static_cast<unsigned int>(pixels[i + c]);
+            };
+            for (unsigned int y = 0; y < dim.y; y++) {
+                for (unsigned int x = 0; x < dim.x; x++) {
+                    for (int c = 0; c < nChannels; c++) {
+                        const unsigned int sum =
+                            pixel(2 * x, 2 * y, c) + pixel(2 * x + 1, 2 * y, c) +
+                            pixel(2 * x, 2 * y + 1, c) + pixel(2 * x + 1, 2 * y + 1, c);
+                        const size_t i = (static_cast<size_t>(y) * dim.x + x) * nChannels;
+                        result[i + c] = static_cast<std::byte>((sum + 2) / 4);
+                    }
+                }
+            }
+            pixels = std::move(result);
+            dimensions = dim;
+        }
+    }
+} // namespace
+
+namespace openspace {
+
+// Downloading and decoding an image on the worker thread
+struct OnlineImageLoader::LoadImageJob : public Job<Image> {
+    LoadImageJob(std::string url, std::filesystem::path cacheDirectory,
+                 int maxTextureSize)
+        : cacheFile(cachePath(cacheDirectory, url))
+        , maxSize(static_cast<unsigned int>(maxTextureSize))
+    {
+        result.url = std::move(url);
+    }
+
+    void execute() override {
+        if (!download()) {
+            return;
+        }
+
+        // stb_image returns the rows from the top of the image, but OpenGL expects them
+        // from the bottom
+        stbi_set_flip_vertically_on_load_thread(1);
+        int x = 0;
+        int y = 0;
+        int n = 0;
+        stbi_uc* data = stbi_load_from_memory(
+            reinterpret_cast<const stbi_uc*>(result.file.data()),
+            static_cast<int>(result.file.size()),
+            &x,
+            &y,
+            &n,
+            0
+        );
+        if (data) {
+            result.dimensions = glm::uvec2(x, y);
+            result.nChannels = n;
+            const std::byte* begin = reinterpret_cast<const std::byte*>(data);
+            result.pixels.assign(begin, begin + static_cast<size_t>(x) * y * n);
+            stbi_image_free(data);
+            downscale(result.pixels, result.dimensions, result.nChannels, maxSize);
+            result.file.clear();
+        }
+        result.success = true;
+    }
+
+    // Downloads the image into `result.file`, or reads it from the cache if the server
+    // reports that it has not been modified
+    bool download() {
+        if (!HttpEngine::isInitialized()) {
+            return false;
+        }
+
+        const std::optional<CacheEntry> cached = readCacheEntry(cacheFile);
+        std::vector<std::string> headers;
+        if (cached && !cached->etag.empty()) {
+            headers.push_back(fmt::format("If-None-Match: {}", cached->etag));
+        }
+        if (cached && !cached->lastModified.empty()) {
+            headers.push_back(fmt::format("If-Modified-Since: {}", cached->lastModified));
+        }
+
+        auto response = std::make_shared<Response>();
+        auto finished = std::make_shared<std::promise<void>>();
+        std::future<void> finishedFuture = finished->get_future();
+        HttpEngine::ref().submit({
+            .url = result.url,
+            .timeout = DownloadTimeout,
+            .priority = HttpEngine::Priority::High,
+            .verifyPeer = false,
+            .requestHeaders = std::move(headers),
+            .onHeader = [response](char* buffer, size_t size) {
+                parseHeader(*response, std::string_view(buffer, size));
+                return true;
+            },
+            .onData = [response](char* buffer, size_t size) {
+                response->data.insert(response->data.end(), buffer, buffer + size);
+                return true;
+            },
+            .onFinish = [response, finished](const HttpEngine::Result& res) {
+                response->result = res;
+                finished->set_value();
+            }
+        });
+        finishedFuture.wait();
+
+        const HttpEngine::Result& res = response->result;
+        if (res.isComplete && res.responseCode == 304 && cached) {
+            if (readFile(cacheFile, result.file)) {
+                LDEBUG(fmt::format("Using cached version of '{}'", result.url));
+                result.format = cached->format;
+                return true;
+            }
+            // The cached image is gone, so the next request has to fetch it again
+            std::error_code ec;
+            std::filesystem::remove(cacheFile.string() + ".meta", ec);
+        }
+        if (!res.isComplete || res.responseCode >= 300) {
+            LERROR(fmt::format(
+                "Error loading image from URL '{}': {}",
+                result.url,
+                res.isComplete ? fmt::format("HTTP code {}", res.responseCode) : res.error
+            ));
+            return false;
+        }
+
+        const size_t slash = res.contentType.find('/');
+        if (slash != std::string::npos) {
+            result.format = res.contentType.substr(slash + 1);
+        }
+        result.file = std::move(response->data);
+        if (!response->etag.empty() || !response->lastModified.empty()) {
+            writeCacheEntry(
+                cacheFile,
+                { response->etag, response->lastModified, result.format },
+                result.file
+            );
+        }
+        return true;
+    }
+
+    Image product() override {
+        return std::move(result);
+    }
+
+    const std::filesystem::path cacheFile;
+    const unsigned int maxSize;
+    Image result;
+};
+
+OnlineImageLoader::OnlineImageLoader()
+    : _loader(std::make_unique<ConcurrentJobManager<Image>>(ThreadPool(1)))
+{}
+
+OnlineImageLoader::~OnlineImageLoader() = default;
+
+void OnlineImageLoader::load(std::string url) {
+    if (_maxTextureSize == 0) {
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &_maxTextureSize);
+    }
+
+    _url = url;
+    _loader->clearEnqueuedJobs();
+    _loader->enqueueJob(std::make_shared<LoadImageJob>(
+        std::move(url),
+        absPath("${CACHE}/onlineimages"),
+        _maxTextureSize
+    ));
+}
+
+std::unique_ptr<ghoul::opengl::Texture> OnlineImageLoader::finishedTexture() {
+    std::unique_ptr<ghoul::opengl::Texture> texture;
+    while (_loader->numFinishedJobs() > 0) {
+        Image image = _loader->popFinishedJob()->product();
+        // Images of URLs that have been replaced in the meantime are not needed anymore
+        if (image.success && image.url == _url) {
+            texture = upload(image);
+        }
+    }
+    return texture;
+}
+
+std::unique_ptr<ghoul::opengl::Texture> OnlineImageLoader::upload(Image& image) const {
+    using Texture = ghoul::opengl::Texture;
+
+    // Images don't need to start on 4-byte boundaries, for example if the image is only
+    // RGB
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    std::unique_ptr<Texture> texture;
+    if (!image.pixels.empty()) {
+        Texture::Format format = Texture::Format::RGBA;
+        GLenum internalFormat = GL_RGBA;
+        switch (image.nChannels) {
+            case 1:
+                format = Texture::Format::Red;
+                internalFormat = GL_RED;
+                break;
+            case 2:
+                format = Texture::Format::RG;
+                internalFormat = GL_RG;
+                break;
+            case 3:
+                format = Texture::Format::RGB;
+                internalFormat = GL_RGB;
+                break;
+            default:
+                break;
+        }
+
+        // The pixels are copied into a pixel buffer from which the texture is created,
+        // so that the driver can perform the transfer without stalling the frame
+        GLuint pixelBuffer = 0;
+        glGenBuffers(1, &pixelBuffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+        const GLsizeiptr size = static_cast<GLsizeiptr>(image.pixels.size());
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        void* buffer = glMapBufferRange(
+            GL_PIXEL_UNPACK_BUFFER,
+            0,
+            size,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+        );
+        if (buffer) {
+            std::memcpy(buffer, image.pixels.data(), image.pixels.size());
+        }
+        if (buffer && glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+            texture = std::make_unique<Texture>(
+                glm::uvec3(image.dimensions, 1),
+                GL_TEXTURE_2D,
+                format,
+                internalFormat,
+                GL_UNSIGNED_BYTE,
+                Texture::FilterMode::Linear,
+                Texture::WrappingMode::Repeat,
+                Texture::AllocateData::No,
+                Texture::TakeOwnership::No
+            );
+            // As the texture has no pixel data, it is initialized from the bound buffer
+            texture->uploadTexture();
+        }
+        else {
+            LERROR(fmt::format("Could not upload image from URL '{}'", image.url));
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &pixelBuffer);
+    }
+    else {
+        // The image is in a format that stb_image does not support, so we fall back to
+        // the texture reader, which might have other readers available
+        try {
+            texture = ghoul::io::TextureReader::ref().loadTexture(
+                reinterpret_cast<void*>(image.file.data()),
+                image.file.size(),
+                2,
+                image.format
+            );
+            if (texture) {
+                texture->uploadTexture();
+                texture->purgeFromRAM();
+            }
+        }
+        catch (const ghoul::io::TextureReader::InvalidLoadException& e) {
+            LERRORC(e.component, e.message);
+        }
+    }
+
+    if (!texture) {
+        return nullptr;
+    }
+    if (texture->format() == Texture::Format::Red) {
+        texture->setSwizzleMask({ GL_RED, GL_RED, GL_RED, GL_ONE });
+    }
+    texture->setFilter(Texture::FilterMode::LinearMipMap);
+    return texture;
+}
+
+} // namespace openspace
@@ -0,0 +1,95 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_BASE___ONLINEIMAGELOADER___H__
+#define __OPENSPACE_MODULE_BASE___ONLINEIMAGELOADER___H__
+
+#include <openspace/util/concurrentjobmanager.h>
+#include <ghoul/glm.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ghoul::opengl { class Texture; }
+
+namespace openspace {
+
+/**
+ * Loads the images of online renderables in the background. The image is downloaded,
+ * decoded, and downscaled to the maximum texture size on a worker thread, so that the
+ * rendering thread only has to upload the finished pixels, which is done through a pixel
+ * buffer object. Downloaded images are stored on disk together with their `ETag` and
+ * `Last-Modified` headers. When the same URL is requested again, for example after a
+ * profile is reloaded, the server can answer with a 304 Not Modified and the image is
+ * read from the disk instead.
+ */
+class OnlineImageLoader {
+public:
+    OnlineImageLoader();
+    ~OnlineImageLoader();
+
+    /**
+     * Starts loading the image at the \p url. The result of a previous call that has not
+     * finished yet is discarded.
+     */
+    void load(std::string url);
+
+    /**
+     * Returns the texture of the image that was requested last if it has finished
+     * loading since the previous call, or `nullptr` otherwise. Failed loads are logged
+     * and also return `nullptr`. Has to be called from the thread that owns the OpenGL
+     * context.
+     */
+    std::unique_ptr<ghoul::opengl::Texture> finishedTexture();
+
+private:
+    struct Image {
+        std::string url;
+        bool success = false;
+
+        // The decoded pixels, row by row starting at the bottom of the image
+        std::vector<std::byte> pixels;
+        glm::uvec2 dimensions = glm::uvec2(0);
+        int nChannels = 0;
+
+        // If the image could not be decoded on the worker, it is decoded from the
+        // downloaded file when it is uploaded instead
+        std::vector<char> file;
+        std::string format;
+    };
+    struct LoadImageJob;
+
+    std::unique_ptr<ghoul::opengl::Texture> upload(Image& image) const;
+
+    // Downloads and decodes the images on a background thread
+    std::unique_ptr<ConcurrentJobManager<Image>> _loader;
+    // The URL of the image that was requested last
+    std::string _url;
+    int _maxTextureSize = 0;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_BASE___ONLINEIMAGELOADER___H__
@@ -148,16 +148,9 @@ void RenderableDisc::deinitializeGL() {
 void RenderableDisc::render(const RenderData& data, RendererTasks&) {
     _shader->activate();
 
-    glm::dmat4 modelTransform =
-        glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
-        glm::dmat4(data.modelTransform.rotation) *
-        glm::scale(glm::dmat4(1.0), glm::dvec3(data.modelTransform.scale));
-
-    glm::dmat4 modelViewTransform = data.camera.combinedViewMatrix() * modelTransform;
-
     _shader->setUniform(
         _uniformCache.modelViewProjection,
-        data.camera.projectionMatrix() * glm::mat4(modelViewTransform)
+        data.modelViewProjectionTransform()
     );
     _shader->setUniform(_uniformCache.width, _width);
     _shader->setUniform(_uniformCache.opacity, opacity());
@@ -38,6 +38,9 @@
 #include <openspace/scene/scene.h>
 #include <openspace/scene/lightsource.h>
 #include <ghoul/io/model/modelgeometry.h>
+#include <ghoul/io/model/modelmesh.h>
+#include <ghoul/io/model/modelnode.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/invariants.h>
@@ -45,7 +48,9 @@
 #include <ghoul/opengl/framebufferobject.h>
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/programobject.h>
+#include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
+#include <algorithm>
 #include <filesystem>
 #include <optional>
 
@@ -69,6 +74,11 @@ namespace {
 
     constexpr glm::vec4 PosBufferClearVal = glm::vec4(1e32, 1e32, 1e32, 1.f);
 
+    // The fraction by which the screen size of a model has to pass the threshold of a
+    // level of detail before it changes. Without this, models that are close to a
+    // threshold would alternate between two levels as the camera moves
+    constexpr double LevelOfDetailHysteresis = 0.1;
+
     const GLenum ColorAttachmentArray[3] = {
        GL_COLOR_ATTACHMENT0,
        GL_COLOR_ATTACHMENT1,
@@ -191,12 +201,103 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    // Models that are not already stored in the binary model format are imported with
+    // Assimp the first time they are loaded and are then written in the binary format to
+    // the cache. Reading that is much faster than the import on subsequent starts
+    std::unique_ptr<ghoul::modelgeometry::ModelGeometry> loadModel(
+                                                        const std::filesystem::path& file,
+                                                        bool forceRenderInvisible,
+                                                        bool notifyInvisibleDropped)
+    {
+        using ghoul::io::ModelReader;
+        const ModelReader::ForceRenderInvisible force(forceRenderInvisible);
+        const ModelReader::NotifyInvisibleDropped notify(notifyInvisibleDropped);
+
+        if (file.extension() == ".osmodel") {
+            return ModelReader::ref().loadModel(file, force, notify);
+        }
+
+        // The cached file is replaced whenever the model file changes
+        const std::string information = fmt::format(
+            "{}|{}|{}|{}",
+            std::filesystem::file_size(file),
+            std::filesystem::last_write_time(file).time_since_epoch().count(),
+            forceRenderInvisible,
+            notifyInvisibleDropped
+        );
+        std::filesystem::path cached = FileSys.cacheManager()->cachedFilename(
+            file,
+            information
+        );
+        cached.replace_extension(".osmodel");
+
+        if (std::filesystem::is_regular_file(cached)) {
+            try {
+                return ModelReader::ref().loadModel(cached, force, notify);
+            }
+            catch (const ghoul::RuntimeError& e) {
+                LWARNING(fmt::format(
+                    "Could not load cached model {}: {}", cached, e.message
+                ));
+                std::filesystem::remove(cached);
+            }
+        }
+
+        std::unique_ptr<ghoul::modelgeometry::ModelGeometry> geometry =
+            ModelReader::ref().loadModel(file, force, notify);
+        if (!geometry->saveToCacheFile(cached)) {
+            LWARNING(fmt::format("Could not write cached model {}", cached));
+        }
+        return geometry;
+    }
+
+    // The vertices and indices of a model are kept in main memory after they have been
+    // uploaded, so they count towards both the GPU buffers and the CPU data
+    using ModelGeometry = ghoul::modelgeometry::ModelGeometry;
+
+    openspace::Renderable::MemoryUsage geometryMemory(const ModelGeometry& geometry) {
+        using Vertex = ghoul::io::ModelMesh::Vertex;
+
+        openspace::Renderable::MemoryUsage usage;
+        for (const ghoul::io::ModelNode& node : geometry.nodes()) {
+            for (const ghoul::io::ModelMesh& mesh : node.meshes()) {
+                const size_t bytes = mesh.vertices().size() * sizeof(Vertex) +
+                    mesh.indices().size() * sizeof(unsigned int);
+                usage.gpuBuffers += bytes;
+                usage.cpuData += bytes;
+            }
+        }
+        using TextureEntry = ghoul::modelgeometry::ModelGeometry::TextureEntry;
+        for (const TextureEntry& entry : geometry.textureStorage()) {
+            if (entry.texture) {
+                usage.gpuTextures += entry.texture->expectedPixelDataSize();
+            }
+        }
+        return usage;
+    }
+
     struct [[codegen::Dictionary(RenderableModel)]] Parameters {
         // The file or files that should be loaded in this RenderableModel. The file can
         // contain filesystem tokens. This specifies the model that is rendered by
         // the Renderable.
         std::filesystem::path geometryFile;
 
+        struct LevelOfDetail {
+            // The model file that is rendered for this level of detail. It should be a
+            // simplified version of the GeometryFile
+            std::filesystem::path geometryFile;
+
+            // The diameter of the model on the screen, in pixels, below which this level
+            // of detail is used
+            double screenSize [[codegen::greater(0.0)]];
+        };
+        // A list of simplified versions of the model that are rendered instead of the
+        // GeometryFile when the model only covers a few pixels on the screen. If the
+        // model is smaller than the screen size of multiple levels, the one with the
+        // smallest screen size is used. Levels of detail are not used for animated
+        // models
+        std::optional<std::vector<LevelOfDetail>> levelsOfDetail;
+
         enum class [[codegen::map(openspace::DistanceUnit)]] ScaleUnit {
             Nanometer,
             Micrometer,
@@ -366,6 +467,29 @@ RenderableModel::RenderableModel(const ghoul::Dictionary& dictionary)
         throw ghoul::RuntimeError(fmt::format("Cannot find model file {}", _file));
     }
 
+    if (p.levelsOfDetail.has_value()) {
+        for (const Parameters::LevelOfDetail& lod : *p.levelsOfDetail) {
+            LevelOfDetail level;
+            level.file = absPath(lod.geometryFile.string());
+            if (!std::filesystem::exists(level.file)) {
+                throw ghoul::RuntimeError(fmt::format(
+                    "Cannot find model file {}", level.file
+                ));
+            }
+            level.screenSize = lod.screenSize;
+            _levelsOfDetail.push_back(std::move(level));
+        }
+
+        // Sorted from the most to the least detailed level
+        std::sort(
+            _levelsOfDetail.begin(),
+            _levelsOfDetail.end(),
+            [](const LevelOfDetail& lhs, const LevelOfDetail& rhs) {
+                return lhs.screenSize > rhs.screenSize;
+            }
+        );
+    }
+
     _invertModelScale = p.invertModelScale.value_or(_invertModelScale);
 
     if (p.modelScale.has_value()) {
@@ -550,11 +674,7 @@ void RenderableModel::initializeGL() {
     ZoneScoped;
 
     // Load model
-    _geometry = ghoul::io::ModelReader::ref().loadModel(
-        _file,
-        ghoul::io::ModelReader::ForceRenderInvisible(_forceRenderInvisible),
-        ghoul::io::ModelReader::NotifyInvisibleDropped(_notifyInvisibleDropped)
-    );
+    _geometry = loadModel(_file, _forceRenderInvisible, _notifyInvisibleDropped);
     _modelHasAnimation = _geometry->hasAnimation();
 
     // @TODO (abock, 2023-06-03) Leaving this here to address issue #2731. The
@@ -726,6 +846,22 @@ void RenderableModel::initializeGL() {
     _geometry->calculateBoundingRadius();
     setBoundingSphere(_geometry->boundingRadius() * _modelScale);
 
+    if (!_modelHasAnimation) {
+        for (LevelOfDetail& level : _levelsOfDetail) {
+            level.geometry = loadModel(
+                level.file,
+                _forceRenderInvisible,
+                _notifyInvisibleDropped
+            );
+            level.geometry->initialize();
+        }
+    }
+    else if (!_levelsOfDetail.empty()) {
+        LWARNING(fmt::format(
+            "Levels of detail are ignored for the animated model {}", _file
+        ));
+    }
+
     // Set Interaction sphere size to be 10% of the bounding sphere
     setInteractionSphere(boundingSphere() * 0.1);
 }
@@ -733,6 +869,13 @@ void RenderableModel::initializeGL() {
 void RenderableModel::deinitializeGL() {
     _geometry->deinitialize();
     _geometry.reset();
+    for (LevelOfDetail& level : _levelsOfDetail) {
+        if (level.geometry) {
+            level.geometry->deinitialize();
+            level.geometry.reset();
+        }
+    }
+    _currentLevelOfDetail = 0;
 
     glDeleteFramebuffers(1, &_framebuffer);
 
@@ -787,17 +930,23 @@ void RenderableModel::render(const RenderData& data, RendererTasks&) {
         return;
     }
 
+    // The diameter of the model in pixels determines the level of detail
+    const double screenSize = 2.0 * boundingSphere() *
+        glm::compMax(data.modelTransform.scale) / distanceToCamera *
+        data.camera.sgctInternal.projectionMatrix()[1][1] *
+        global::renderEngine->renderingResolution().y / 2.0;
+    ghoul::modelgeometry::ModelGeometry* geometry = levelOfDetail(screenSize);
+
     _program->activate();
 
-    // Model transform and view transform needs to be in double precision
-    const glm::dmat4 modelTransform =
-        glm::translate(glm::dmat4(1.0), glm::dvec3(_pivot.value())) *
-        glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
-        glm::dmat4(data.modelTransform.rotation) *
-        glm::scale(glm::dmat4(1.0), glm::dvec3(data.modelTransform.scale)) *
+    // The pivot is an offset in world space, so it is rotated into view space before it
+    // is added to the camera-relative transformation of the node
+    const glm::dvec3 pivot =
+        glm::dmat3(data.camera.combinedViewMatrix()) * glm::dvec3(_pivot.value());
+    const glm::dmat4 modelViewTransform =
+        glm::translate(glm::dmat4(1.0), pivot) *
+        data.modelViewTransform *
         glm::scale(_modelTransform.value(), glm::dvec3(_modelScale));
-    const glm::dmat4 modelViewTransform = data.camera.combinedViewMatrix() *
-        modelTransform;
 
     int nLightSources = 0;
     _lightIntensitiesBuffer.resize(_lightSources.size());
@@ -841,7 +990,9 @@ void RenderableModel::render(const RenderData& data, RendererTasks&) {
         glm::mat4(modelViewTransform)
     );
 
-    glm::dmat4 normalTransform = glm::transpose(glm::inverse(modelViewTransform));
+    // Only the rotational part is needed for the normals, which avoids a full 4x4 inverse
+    const glm::dmat3 normalTransform =
+        glm::transpose(glm::inverse(glm::dmat3(modelViewTransform)));
 
     _program->setUniform(
         _uniformCache.normalTransform,
@@ -895,7 +1046,7 @@ void RenderableModel::render(const RenderData& data, RendererTasks&) {
             _program->setUniform(_uniformCache.opacity, 1.f);
         }
 
-        _geometry->render(*_program);
+        geometry->render(*_program);
     }
     else {
         // Prepare framebuffer
@@ -952,7 +1103,7 @@ void RenderableModel::render(const RenderData& data, RendererTasks&) {
 
         // Render Pass 1
         // Render all parts of the model into the new framebuffer without opacity
-        _geometry->render(*_program);
+        geometry->render(*_program);
         _program->deactivate();
 
         // Render pass 2
@@ -1022,6 +1173,42 @@ void RenderableModel::render(const RenderData& data, RendererTasks&) {
     glActiveTexture(GL_TEXTURE0);
 }
 
+ghoul::modelgeometry::ModelGeometry* RenderableModel::levelOfDetail(double screenSize) {
+    int level = 0;
+    for (size_t i = 0; i < _levelsOfDetail.size(); i++) {
+        const LevelOfDetail& lod = _levelsOfDetail[i];
+        if (!lod.geometry) {
+            break;
+        }
+
+        // Switching to a coarser level requires the model to be a bit smaller than the
+        // threshold, switching back requires it to be a bit larger
+        const bool isCoarser = static_cast<int>(i) + 1 > _currentLevelOfDetail;
+        const double threshold = lod.screenSize *
+            (isCoarser ? 1.0 - LevelOfDetailHysteresis : 1.0 + LevelOfDetailHysteresis);
+        if (screenSize < threshold) {
+            level = static_cast<int>(i) + 1;
+        }
+    }
+
+    _currentLevelOfDetail = level;
+    return level == 0 ? _geometry.get() : _levelsOfDetail[level - 1].geometry.get();
+}
+
+Renderable::MemoryUsage RenderableModel::memoryUsage() const {
+    MemoryUsage usage;
+    if (_geometry) {
+        usage += geometryMemory(*_geometry);
+    }
+    for (const LevelOfDetail& level : _levelsOfDetail) {
+        if (level.geometry) {
+            usage += geometryMemory(*level.geometry);
+        }
+    }
+    usage.gpuBuffers += bufferMemory(_quadVbo);
+    return usage;
+}
+
 void RenderableModel::update(const UpdateData& data) {
     if (_program->isDirty()) {
         _program->rebuildFromFile();
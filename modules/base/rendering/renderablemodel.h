@@ -37,6 +37,7 @@
 #include <ghoul/io/model/modelreader.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <memory>
+#include <vector>
 
 namespace ghoul::opengl {
     class ProgramObject;
@@ -67,6 +68,8 @@ public:
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
 
+    MemoryUsage memoryUsage() const override;
+
     static documentation::Documentation Documentation();
 
 private:
@@ -78,8 +81,25 @@ private:
         BounceInfinitely
     };
 
+    /**
+     * Returns the geometry that should be rendered for a model whose diameter on the
+     * screen is \p screenSize pixels. Returns the full detail geometry if no level of
+     * detail is applicable.
+     */
+    ghoul::modelgeometry::ModelGeometry* levelOfDetail(double screenSize);
+
+    struct LevelOfDetail {
+        std::filesystem::path file;
+        double screenSize = 0.0;
+        std::unique_ptr<ghoul::modelgeometry::ModelGeometry> geometry;
+    };
+
     std::filesystem::path _file;
     std::unique_ptr<ghoul::modelgeometry::ModelGeometry> _geometry;
+    /// Sorted from the most to the least detailed level
+    std::vector<LevelOfDetail> _levelsOfDetail;
+    /// 0 is the full detail geometry, i > 0 refers to _levelsOfDetail[i - 1]
+    int _currentLevelOfDetail = 0;
     properties::DoubleProperty _modelScale;
     bool _invertModelScale = false;
     bool _forceRenderInvisible = false;
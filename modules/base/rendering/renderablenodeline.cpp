@@ -147,7 +147,7 @@ documentation::Documentation RenderableNodeLine::Documentation() {
 }
 
 RenderableNodeLine::RenderableNodeLine(const ghoul::Dictionary& dictionary)
-    : Renderable(dictionary)
+    : Renderable(dictionary, { .hasThreadSafeUpdate = true })
     , _start(StartNodeInfo, "Root")
     , _end(EndNodeInfo, "Root")
     , _lineColor(LineColorInfo, glm::vec3(1.f), glm::vec3(0.f), glm::vec3(1.f))
@@ -356,21 +356,12 @@ void RenderableNodeLine::updateVertexData() {
     _vertexArray.push_back(static_cast<float>(endPos.y));
     _vertexArray.push_back(static_cast<float>(endPos.z));
 
-    bindGL();
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        _vertexArray.size() * sizeof(float),
-        _vertexArray.data(),
-        GL_DYNAMIC_DRAW
-    );
-
-    // update vertex attributes
-    glVertexAttribPointer(_locVertex, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-
-    unbindGL();
+    _vertexDataIsDirty = true;
 }
 
 void RenderableNodeLine::update(const UpdateData&) {
+    // The vertex data is only computed here and uploaded in the render function so that
+    // this function does not touch any OpenGL state and can run on a worker thread
     updateVertexData();
 }
 
@@ -406,6 +397,23 @@ void RenderableNodeLine::render(const RenderData& data, RendererTasks&) {
 
     // Bind and draw
     bindGL();
+    if (_vertexDataIsDirty) {
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            _vertexArray.size() * sizeof(float),
+            _vertexArray.data(),
+            GL_DYNAMIC_DRAW
+        );
+        glVertexAttribPointer(
+            _locVertex,
+            3,
+            GL_FLOAT,
+            GL_FALSE,
+            3 * sizeof(float),
+            nullptr
+        );
+        _vertexDataIsDirty = false;
+    }
     glDrawArrays(GL_LINES, 0, 2);
 
     // Restore GL State
@@ -75,6 +75,7 @@ private:
     GLuint _vaoId = 0;
     GLuint _vBufferId = 0;
     std::vector<float> _vertexArray;
+    bool _vertexDataIsDirty = false;
 
     glm::dvec3 _startPos = glm::dvec3(0.0);
     glm::dvec3 _endPos = glm::dvec3(0.0);
@@ -27,7 +27,7 @@
 
 #include <modules/base/rendering/renderableplane.h>
 
-#include <openspace/engine/downloadmanager.h>
+#include <modules/base/rendering/onlineimageloader.h>
 
 namespace ghoul::filesystem { class File; }
 namespace ghoul::opengl { class Texture; }
@@ -53,12 +53,9 @@ protected:
     virtual void bindTexture() override;
 
 private:
-    std::future<DownloadManager::MemoryFile> downloadImageToMemory(
-        const std::string& url);
-
     properties::StringProperty _texturePath;
 
-    std::future<DownloadManager::MemoryFile> _imageFuture;
+    OnlineImageLoader _imageLoader;
     std::unique_ptr<ghoul::opengl::Texture> _texture;
     glm::vec2 _textureDimensions = glm::vec2(0.f);
     bool _textureIsDirty = false;
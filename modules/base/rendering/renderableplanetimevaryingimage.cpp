@@ -24,16 +24,15 @@
 
 #include <modules/base/rendering/renderableplanetimevaryingimage.h>
 
-#include <modules/base/basemodule.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scene.h>
+#include <openspace/util/timemanager.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
-#include <ghoul/io/texture/texturereader.h>
 #include <ghoul/logging/logmanager.h>
 #include <optional>
 
@@ -72,6 +71,11 @@ namespace {
 
         // [[codegen::verbatim(RenderTypeInfo.description)]]
         std::optional<RenderType> renderType;
+
+        // The number of images that are loaded ahead of the current one in the
+        // direction of time. Only these, the current image, and the previous image are
+        // kept in memory. The default is 2
+        std::optional<int> prefetchImages [[codegen::greaterequal(0)]];
     };
 #include "renderableplanetimevaryingimage_codegen.cpp"
 } // namespace
@@ -103,7 +107,8 @@ RenderablePlaneTimeVaryingImage::RenderablePlaneTimeVaryingImage(
     }
 
     addProperty(_sourceFolder);
-    _sourceFolder.onChange([this]() { _texture = loadTexture(); });
+    _sourceFolder.onChange([this]() { _textureIsDirty = true; });
+    _nPrefetchImages = p.prefetchImages.value_or(_nPrefetchImages);
 
     if (p.renderType.has_value()) {
         setRenderBin(codegen::map<Renderable::RenderBin>(*p.renderType));
@@ -120,8 +125,8 @@ RenderablePlaneTimeVaryingImage::RenderablePlaneTimeVaryingImage(
                 if (_enabled) {
                     _textureIsDirty = true;
                 }
-                else {
-                    BaseModule::TextureManager.release(_texture);
+                else if (_textureCache) {
+                    _textureCache->clear();
                     _texture = nullptr;
                 }
             });
@@ -142,19 +147,17 @@ void RenderablePlaneTimeVaryingImage::initialize() {
 void RenderablePlaneTimeVaryingImage::initializeGL() {
     RenderablePlane::initializeGL();
 
-    _textureFiles.resize(_sourceFiles.size());
-    for (size_t i = 0; i < _sourceFiles.size(); ++i) {
-        _textureFiles[i] = ghoul::io::TextureReader::ref().loadTexture(
-            absPath(_sourceFiles[i]).string(),
-            2
-        );
-        _textureFiles[i]->setInternalFormat(GL_COMPRESSED_RGBA);
-        _textureFiles[i]->uploadTexture();
-        _textureFiles[i]->setFilter(ghoul::opengl::Texture::FilterMode::Linear);
-        _textureFiles[i]->purgeFromRAM();
+    std::vector<std::string> paths;
+    paths.reserve(_sourceFiles.size());
+    for (const std::string& file : _sourceFiles) {
+        paths.push_back(absPath(file).string());
     }
+    _textureCache = std::make_unique<TextureSequenceCache>(
+        std::move(paths),
+        _nPrefetchImages
+    );
     if (!_isLoadingLazily) {
-        _texture = loadTexture();
+        _texture = loadTexture(1);
     }
 }
 
@@ -185,9 +188,8 @@ bool RenderablePlaneTimeVaryingImage::extractMandatoryInfoFromDictionary() {
 }
 
 void RenderablePlaneTimeVaryingImage::deinitializeGL() {
-    BaseModule::TextureManager.release(_texture);
-
-    _textureFiles.clear();
+    _texture = nullptr;
+    _textureCache = nullptr;
     RenderablePlane::deinitializeGL();
 }
 
@@ -204,7 +206,6 @@ void RenderablePlaneTimeVaryingImage::update(const UpdateData& data) {
     if (!_enabled || _startTimes.empty()) {
         return;
     }
-    bool needsUpdate = false;
     const double currentTime = data.time.j2000Seconds();
     bool isInInterval = (currentTime >= _startTimes[0]) &&
         (currentTime < _sequenceEndTime);
@@ -219,19 +220,16 @@ void RenderablePlaneTimeVaryingImage::update(const UpdateData& data) {
             (nextIdx < _sourceFiles.size() && currentTime >= _startTimes[nextIdx]))
         {
             _activeTriggerTimeIndex = updateActiveTriggerTimeIndex(currentTime);
-            needsUpdate = true;
         } // else we're still in same state as previous frame (no changes needed)
     }
     else {
         // not in interval => set everything to false
         _activeTriggerTimeIndex = -1;
-        needsUpdate = false;
     }
 
-    if (needsUpdate || _textureIsDirty) {
-        _texture = loadTexture();
-        _textureIsDirty = false;
-    }
+    // The cache is updated every frame as the images are loaded in the background
+    _texture = loadTexture(global::timeManager->deltaTime() < 0.0 ? -1 : 1);
+    _textureIsDirty = false;
 }
 
 void RenderablePlaneTimeVaryingImage::render(const RenderData& data, RendererTasks& t) {
@@ -291,10 +289,10 @@ void RenderablePlaneTimeVaryingImage::computeSequenceEndTime() {
     }
 }
 
-ghoul::opengl::Texture* RenderablePlaneTimeVaryingImage::loadTexture() const {
+ghoul::opengl::Texture* RenderablePlaneTimeVaryingImage::loadTexture(int direction) {
     ghoul::opengl::Texture* texture = nullptr;
-    if (_activeTriggerTimeIndex != -1) {
-        texture = _textureFiles[_activeTriggerTimeIndex].get();
+    if (_activeTriggerTimeIndex != -1 && _textureCache) {
+        texture = _textureCache->update(_activeTriggerTimeIndex, direction);
     }
     return texture;
 }
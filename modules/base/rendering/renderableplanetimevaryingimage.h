@@ -27,6 +27,8 @@
 
 #include <modules/base/rendering/renderableplane.h>
 
+#include <modules/base/rendering/texturesequencecache.h>
+
 namespace ghoul::filesystem { class File; }
 namespace ghoul::opengl { class Texture; }
 
@@ -54,7 +56,7 @@ protected:
     virtual void bindTexture() override;
 
 private:
-    ghoul::opengl::Texture* loadTexture() const;
+    ghoul::opengl::Texture* loadTexture(int direction);
     void extractTriggerTimesFromFileNames();
     bool extractMandatoryInfoFromDictionary();
     int updateActiveTriggerTimeIndex(double currenttime) const;
@@ -65,9 +67,12 @@ private:
     std::vector<std::string> _sourceFiles;
     std::vector<double> _startTimes;
     int _activeTriggerTimeIndex = 0;
+    // Number of images that are loaded ahead of the active one in the direction of time
+    int _nPrefetchImages = 2;
     properties::StringProperty _sourceFolder;
     ghoul::opengl::Texture* _texture = nullptr;
-    std::vector<std::unique_ptr<ghoul::opengl::Texture>> _textureFiles;
+    // Only keeps the textures around the active image on the GPU
+    std::unique_ptr<TextureSequenceCache> _textureCache;
     bool _isLoadingLazily = false;
     bool _textureIsDirty = false;
 };
@@ -205,13 +205,14 @@ void RenderableSphere::initializeGL() {
     _sphere = std::make_unique<Sphere>(_size, _segments);
     _sphere->initialize();
 
+    const std::pair<std::string, std::filesystem::path> program = renderProgram();
     _shader = BaseModule::ProgramObjectManager.request(
-        "Sphere",
-        []() -> std::unique_ptr<ghoul::opengl::ProgramObject> {
+        program.first,
+        [program]() -> std::unique_ptr<ghoul::opengl::ProgramObject> {
             return global::renderEngine->buildRenderProgram(
-                "Sphere",
+                program.first,
                 absPath("${MODULE_BASE}/shaders/sphere_vs.glsl"),
-                absPath("${MODULE_BASE}/shaders/sphere_fs.glsl")
+                absPath(program.second)
             );
         }
     );
@@ -223,7 +224,7 @@ void RenderableSphere::deinitializeGL() {
     _sphere = nullptr;
 
     BaseModule::ProgramObjectManager.release(
-        "Sphere",
+        renderProgram().first,
         [](ghoul::opengl::ProgramObject* p) {
             global::renderEngine->removeRenderProgram(p);
         }
@@ -383,4 +384,8 @@ void RenderableSphere::unbindTexture() {
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+std::pair<std::string, std::filesystem::path> RenderableSphere::renderProgram() const {
+    return { "Sphere", "${MODULE_BASE}/shaders/sphere_fs.glsl" };
+}
+
 } // namespace openspace
@@ -29,6 +29,9 @@
 
 #include <openspace/properties/optionproperty.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <filesystem>
+#include <string>
+#include <utility>
 
 namespace ghoul::opengl { class ProgramObject; }
 
@@ -58,6 +61,16 @@ protected:
     virtual void bindTexture() = 0;
     virtual void unbindTexture();
 
+    /**
+     * Returns the name of the program that renders the sphere and the path to its
+     * fragment shader. Subclasses that sample their texture in a different way can
+     * provide their own fragment shader, which has to declare the same uniforms as
+     * `sphere_fs.glsl`.
+     */
+    virtual std::pair<std::string, std::filesystem::path> renderProgram() const;
+
+    ghoul::opengl::ProgramObject* _shader = nullptr;
+
     properties::FloatProperty _size;
     properties::IntProperty _segments;
 
@@ -69,8 +82,6 @@ protected:
     properties::FloatProperty _fadeOutThreshold;
 
 private:
-    ghoul::opengl::ProgramObject* _shader = nullptr;
-
     std::unique_ptr<Sphere> _sphere;
     bool _sphereIsDirty = false;
 
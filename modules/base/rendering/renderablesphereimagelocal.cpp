@@ -24,12 +24,18 @@
 
 #include <modules/base/rendering/renderablesphereimagelocal.h>
 
+#include <modules/base/rendering/spherevirtualtexture.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/windowdelegate.h>
 #include <openspace/util/sphere.h>
+#include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/io/texture/texturereader.h>
+#include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/texture.h>
+#include <ghoul/opengl/textureunit.h>
 #include <optional>
 
 namespace {
@@ -51,6 +57,13 @@ namespace {
         // startup but rather when the image is shown for the first time. Additionally, if
         // the sphere is disabled, the image will automatically be unloaded
         std::optional<bool> lazyLoading;
+
+        // If this value is set to 'true', the image is not loaded into a single texture.
+        // Instead, it is split into tiles once, which are stored in the cache, and only
+        // the tiles that are visible are streamed in at the resolution that is needed.
+        // This makes it possible to use images that are larger than the maximum texture
+        // size or the available video memory
+        std::optional<bool> virtualTexture;
     };
 #include "renderablesphereimagelocal_codegen.cpp"
 } // namespace
@@ -68,6 +81,8 @@ RenderableSphereImageLocal::RenderableSphereImageLocal(
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
+    _useVirtualTexture = p.virtualTexture.value_or(_useVirtualTexture);
+
     _texturePath = p.texture;
     _texturePath.onChange([this]() {
         loadTexture();
@@ -75,8 +90,10 @@ RenderableSphereImageLocal::RenderableSphereImageLocal(
     addProperty(_texturePath);
 }
 
+RenderableSphereImageLocal::~RenderableSphereImageLocal() = default;
+
 bool RenderableSphereImageLocal::isReady() const {
-    return RenderableSphere::isReady() && _texture;
+    return RenderableSphere::isReady() && (_texture || _virtualTexture);
 }
 
 void RenderableSphereImageLocal::initializeGL() {
@@ -89,13 +106,55 @@ void RenderableSphereImageLocal::initializeGL() {
 
 void RenderableSphereImageLocal::deinitializeGL() {
     _texture = nullptr;
+    _virtualTexture = nullptr;
 
     RenderableSphere::deinitializeGL();
 }
 
+void RenderableSphereImageLocal::render(const RenderData& data,
+                                        RendererTasks& rendererTask)
+{
+    if (_virtualTexture) {
+        const glm::dmat4 modelTransform =
+            glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
+            glm::dmat4(data.modelTransform.rotation) *
+            glm::scale(
+                glm::dmat4(1.0),
+                glm::dvec3(data.modelTransform.scale) * static_cast<double>(_size)
+            );
+        const glm::dmat4 modelViewTransform =
+            data.camera.combinedViewMatrix() * modelTransform;
+        const glm::dmat4 modelViewProjection =
+            glm::dmat4(data.camera.projectionMatrix()) * modelViewTransform;
+        const glm::dvec3 cameraPosition = glm::dvec3(
+            glm::inverse(modelViewTransform) * glm::dvec4(0.0, 0.0, 0.0, 1.0)
+        );
+
+        _virtualTexture->requestVisibleTiles(
+            modelViewProjection,
+            cameraPosition,
+            global::windowDelegate->currentDrawBufferResolution(),
+            _mirrorTexture,
+            // Only the outside of the sphere is rendered
+            _orientation.value() == 0
+        );
+
+        // Until the coarsest tile has been loaded there is nothing to show
+        if (!_virtualTexture->isReady()) {
+            return;
+        }
+    }
+
+    RenderableSphere::render(data, rendererTask);
+}
+
 void RenderableSphereImageLocal::update(const UpdateData& data) {
     RenderableSphere::update(data);
 
+    if (_virtualTexture) {
+        _virtualTexture->update();
+    }
+
     if (_textureIsDirty) {
         loadTexture();
         _textureIsDirty = false;
@@ -103,7 +162,36 @@ void RenderableSphereImageLocal::update(const UpdateData& data) {
 }
 
 void RenderableSphereImageLocal::bindTexture() {
-    _texture->bind();
+    if (!_virtualTexture) {
+        _texture->bind();
+        return;
+    }
+
+    _virtualTexture->bindAtlas();
+
+    _pageTableUnit = std::make_unique<ghoul::opengl::TextureUnit>();
+    _pageTableUnit->activate();
+    _virtualTexture->bindPageTable();
+    _shader->setUniform("pageTable", *_pageTableUnit);
+    _shader->setUniform("tileSize", SphereVirtualTexture::TileSize);
+    _shader->setUniform("tileBorder", SphereVirtualTexture::TileBorder);
+}
+
+void RenderableSphereImageLocal::unbindTexture() {
+    _pageTableUnit = nullptr;
+    RenderableSphere::unbindTexture();
+}
+
+std::pair<std::string, std::filesystem::path>
+RenderableSphereImageLocal::renderProgram() const
+{
+    if (_useVirtualTexture) {
+        return {
+            "SphereVirtualTexture",
+            "${MODULE_BASE}/shaders/sphere_virtualtexture_fs.glsl"
+        };
+    }
+    return RenderableSphere::renderProgram();
 }
 
 void RenderableSphereImageLocal::loadTexture() {
@@ -111,6 +199,11 @@ void RenderableSphereImageLocal::loadTexture() {
         return;
     }
 
+    if (_useVirtualTexture) {
+        _virtualTexture = std::make_unique<SphereVirtualTexture>(absPath(_texturePath));
+        return;
+    }
+
     std::unique_ptr<ghoul::opengl::Texture> texture =
         ghoul::io::TextureReader::ref().loadTexture(_texturePath, 2);
 
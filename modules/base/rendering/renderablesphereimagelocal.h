@@ -27,10 +27,14 @@
 
 #include <modules/base/rendering/renderablesphere.h>
 
-namespace ghoul::opengl { class Texture; }
+namespace ghoul::opengl {
+    class Texture;
+    class TextureUnit;
+} // namespace ghoul::opengl
 
 namespace openspace {
 
+class SphereVirtualTexture;
 struct RenderData;
 struct UpdateData;
 
@@ -39,18 +43,22 @@ namespace documentation { struct Documentation; }
 class RenderableSphereImageLocal : public RenderableSphere {
 public:
     RenderableSphereImageLocal(const ghoul::Dictionary& dictionary);
+    ~RenderableSphereImageLocal() override;
 
     void initializeGL() override;
     void deinitializeGL() override;
 
     bool isReady() const override;
 
+    void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
 
     static documentation::Documentation Documentation();
 
 protected:
     void bindTexture() override;
+    void unbindTexture() override;
+    std::pair<std::string, std::filesystem::path> renderProgram() const override;
 
 private:
     void loadTexture();
@@ -60,6 +68,11 @@ private:
     std::unique_ptr<ghoul::opengl::Texture> _texture;
     bool _isLoadingLazily = false;
     bool _textureIsDirty = false;
+
+    // Only used if the image is streamed as a virtual texture
+    bool _useVirtualTexture = false;
+    std::unique_ptr<SphereVirtualTexture> _virtualTexture;
+    std::unique_ptr<ghoul::opengl::TextureUnit> _pageTableUnit;
 };
 
 } // namespace openspace
@@ -26,10 +26,8 @@
 
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
-#include <openspace/engine/globals.h>
 #include <openspace/util/sphere.h>
 #include <ghoul/filesystem/filesystem.h>
-#include <ghoul/io/texture/texturereader.h>
 #include <ghoul/opengl/texture.h>
 
 namespace {
@@ -79,56 +77,14 @@ void RenderableSphereImageOnline::deinitializeGL() {
 void RenderableSphereImageOnline::update(const UpdateData& data) {
     RenderableSphere::update(data);
 
-    if (!_textureIsDirty) {
-        return;
+    if (_textureIsDirty) {
+        _imageLoader.load(_textureUrl);
+        _textureIsDirty = false;
     }
 
-    if (!_imageFuture.valid()) {
-        std::future<DownloadManager::MemoryFile> future = downloadImageToMemory(
-            _textureUrl
-        );
-        if (future.valid()) {
-            _imageFuture = std::move(future);
-        }
-    }
-
-    if (_imageFuture.valid() && DownloadManager::futureReady(_imageFuture)) {
-        DownloadManager::MemoryFile imageFile = _imageFuture.get();
-
-        if (imageFile.corrupted) {
-            LERRORC(
-                "RenderableSphereImageOnline",
-                fmt::format("Error loading image from URL '{}'", _textureUrl)
-            );
-            return;
-        }
-
-        try {
-            std::unique_ptr<ghoul::opengl::Texture> texture =
-                ghoul::io::TextureReader::ref().loadTexture(
-                    reinterpret_cast<void*>(imageFile.buffer),
-                    imageFile.size,
-                    2,
-                    imageFile.format
-                );
-
-            if (texture) {
-                // Images don't need to start on 4-byte boundaries, for example if the
-                // image is only RGB
-                glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-                texture->uploadTexture();
-                texture->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
-                texture->purgeFromRAM();
-
-                _texture = std::move(texture);
-                _textureIsDirty = false;
-            }
-        }
-        catch (const ghoul::io::TextureReader::InvalidLoadException& e) {
-            _textureIsDirty = false;
-            LERRORC(e.component, e.message);
-        }
+    std::unique_ptr<ghoul::opengl::Texture> texture = _imageLoader.finishedTexture();
+    if (texture) {
+        _texture = std::move(texture);
     }
 }
 
@@ -141,24 +97,4 @@ void RenderableSphereImageOnline::bindTexture() {
     }
 }
 
-std::future<DownloadManager::MemoryFile>
-RenderableSphereImageOnline::downloadImageToMemory(const std::string& url)
-{
-    return global::downloadManager->fetchFile(
-        url,
-        [url](const DownloadManager::MemoryFile&) {
-            LDEBUGC(
-                "RenderableSphereImageOnline",
-                fmt::format("Download to memory finished for image '{}'", url)
-            );
-        },
-        [url](const std::string& err) {
-            LDEBUGC(
-                "RenderableSphereImageOnline",
-                fmt::format("Download to memory failed for image '{}': {}", url, err)
-            );
-        }
-    );
-}
-
 } // namespace openspace
@@ -27,7 +27,7 @@
 
 #include <modules/base/rendering/renderablesphere.h>
 
-#include <openspace/engine/downloadmanager.h>
+#include <modules/base/rendering/onlineimageloader.h>
 
 namespace ghoul::opengl { class Texture; }
 
@@ -52,12 +52,9 @@ protected:
     void bindTexture() override;
 
 private:
-    std::future<DownloadManager::MemoryFile> downloadImageToMemory(
-        const std::string& url);
-
     properties::StringProperty _textureUrl;
 
-    std::future<DownloadManager::MemoryFile> _imageFuture;
+    OnlineImageLoader _imageLoader;
     std::unique_ptr<ghoul::opengl::Texture> _texture;
     bool _textureIsDirty = false;
 };
@@ -26,11 +26,13 @@
 
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/engine/globals.h>
 #include <openspace/util/sphere.h>
+#include <openspace/util/timemanager.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
-#include <ghoul/io/texture/texturereader.h>
 #include <ghoul/misc/crc32.h>
+#include <optional>
 #include <ghoul/opengl/texture.h>
 
 namespace {
@@ -62,6 +64,11 @@ namespace {
     struct [[codegen::Dictionary(RenderableTimeVaryingSphere)]] Parameters {
         // [[codegen::verbatim(TextureSourceInfo.description)]]
         std::string textureSource;
+
+        // The number of images that are loaded ahead of the current one in the
+        // direction of time. Only these, the current image, and the previous image are
+        // kept in memory. The default is 2
+        std::optional<int> prefetchImages [[codegen::greaterequal(0)]];
     };
 #include "renderabletimevaryingsphere_codegen.cpp"
 } // namespace
@@ -80,6 +87,7 @@ RenderableTimeVaryingSphere::RenderableTimeVaryingSphere(
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
     _textureSourcePath = p.textureSource;
+    _nPrefetchImages = p.prefetchImages.value_or(_nPrefetchImages);
 }
 
 bool RenderableTimeVaryingSphere::isReady() const {
@@ -91,11 +99,22 @@ void RenderableTimeVaryingSphere::initializeGL() {
 
     extractMandatoryInfoFromSourceFolder();
     computeSequenceEndTime();
-    loadTexture();
+
+    std::vector<std::string> paths;
+    paths.reserve(_files.size());
+    for (const FileData& file : _files) {
+        paths.push_back(file.path);
+    }
+    _textureCache = std::make_unique<TextureSequenceCache>(
+        std::move(paths),
+        _nPrefetchImages
+    );
+    loadTexture(1);
 }
 
 void RenderableTimeVaryingSphere::deinitializeGL() {
     _texture = nullptr;
+    _textureCache = nullptr;
     _files.clear();
 
     RenderableSphere::deinitializeGL();
@@ -120,15 +139,7 @@ void RenderableTimeVaryingSphere::extractMandatoryInfoFromSourceFolder() {
         }
         std::string filePath = e.path().string();
         double time = extractTriggerTimeFromFileName(filePath);
-        std::unique_ptr<ghoul::opengl::Texture> t =
-            ghoul::io::TextureReader::ref().loadTexture(filePath, 2);
-
-        t->setInternalFormat(GL_COMPRESSED_RGBA);
-        t->uploadTexture();
-        t->setFilter(ghoul::opengl::Texture::FilterMode::Linear);
-        t->purgeFromRAM();
-
-        _files.push_back({ filePath, time, std::move(t) });
+        _files.push_back({ std::move(filePath), time });
     }
 
     std::sort(
@@ -161,17 +172,15 @@ void RenderableTimeVaryingSphere::update(const UpdateData& data) {
             (nextIdx < _files.size() && currentTime >= _files[nextIdx].time))
         {
             updateActiveTriggerTimeIndex(currentTime);
-            _textureIsDirty = true;
         } // else {we're still in same state as previous frame (no changes needed)}
     }
     else {
         // not in interval => set everything to false
         _activeTriggerTimeIndex = 0;
     }
-    if (_textureIsDirty) {
-        loadTexture();
-        _textureIsDirty = false;
-    }
+
+    // The cache is updated every frame as the images are loaded in the background
+    loadTexture(global::timeManager->deltaTime() < 0.0 ? -1 : 1);
 }
 
 void RenderableTimeVaryingSphere::bindTexture() {
@@ -216,9 +225,9 @@ void RenderableTimeVaryingSphere::computeSequenceEndTime() {
     }
 }
 
-void RenderableTimeVaryingSphere::loadTexture() {
+void RenderableTimeVaryingSphere::loadTexture(int direction) {
     if (_activeTriggerTimeIndex != -1) {
-        _texture = _files[_activeTriggerTimeIndex].texture.get();
+        _texture = _textureCache->update(_activeTriggerTimeIndex, direction);
     }
 }
 
@@ -27,6 +27,8 @@
 
 #include <modules/base/rendering/renderablesphere.h>
 
+#include <modules/base/rendering/texturesequencecache.h>
+
 namespace ghoul::opengl { class Texture; }
 
 namespace openspace {
@@ -56,9 +58,8 @@ private:
     struct FileData {
         std::string path;
         double time;
-        std::unique_ptr<ghoul::opengl::Texture> texture;
     };
-    void loadTexture();
+    void loadTexture(int direction);
     void extractMandatoryInfoFromSourceFolder();
     void updateActiveTriggerTimeIndex(double currenttime);
     void computeSequenceEndTime();
@@ -67,10 +68,13 @@ private:
     double _sequenceEndTime = std::numeric_limits<double>::max();
     std::vector<FileData> _files;
     int _activeTriggerTimeIndex = 0;
+    // Number of images that are loaded ahead of the active one in the direction of time
+    int _nPrefetchImages = 2;
 
     properties::StringProperty _textureSourcePath;
+    // Only keeps the textures around the active image on the GPU
+    std::unique_ptr<TextureSequenceCache> _textureCache;
     ghoul::opengl::Texture* _texture = nullptr;
-    bool _textureIsDirty = false;
 };
 
 } // namespace openspace
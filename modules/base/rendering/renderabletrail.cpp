@@ -197,7 +197,9 @@ RenderableTrail::Appearance::Appearance()
 }
 
 RenderableTrail::RenderableTrail(const ghoul::Dictionary& dictionary)
-    : Renderable(dictionary)
+    // The bounding sphere is derived from the extent of the trail, which is not
+    // necessarily centered on the node
+    : Renderable(dictionary, { .supportsCulling = false })
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -29,13 +29,18 @@
 #include <openspace/scene/translation.h>
 #include <openspace/util/updatestructures.h>
 #include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
 #include <openspace/events/event.h>
 #include <openspace/events/eventengine.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scripting/scriptengine.h>
 #include <openspace/scene/scene.h>
+#include <openspace/util/threadpool.h>
 
 #include <ghoul/opengl/programobject.h>
+#include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <algorithm>
+#include <cstring>
 #include <numeric>
 #include <optional>
 
@@ -135,6 +140,24 @@ namespace {
         std::optional<RenderableType> renderableType;
     };
 #include "renderabletrailorbit_codegen.cpp"
+
+    // Below this number of points, a full sweep is not worth distributing among threads
+    constexpr int MinPointsForParallelSweep = 2048;
+    constexpr size_t PointsPerSweepTask = 512;
+
+    constexpr GLbitfield PersistentMappingFlags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    // The storage also has to accept glBufferSubData for when all regions are busy
+    constexpr GLbitfield PersistentStorageFlags =
+        PersistentMappingFlags | GL_DYNAMIC_STORAGE_BIT;
+
+    // The number of copies of the vertices in the persistently mapped buffer. With three
+    // regions, the GPU can still be reading the last two frames while we write the next
+    constexpr int NumberOfMappedRegions = 3;
+
+    // If a region has fallen behind by more than this many ranges, it is cheaper to
+    // rewrite all of its vertices
+    constexpr size_t MaxPendingRanges = 16;
 } // namespace
 
 namespace openspace {
@@ -183,9 +206,26 @@ void RenderableTrailOrbit::initializeGL() {
     glGenVertexArrays(1, &_primaryRenderInformation._vaoID);
     glGenBuffers(1, &_primaryRenderInformation._vBufferID);
     glGenBuffers(1, &_primaryRenderInformation._iBufferID);
+
+    using namespace ghoul::systemcapabilities;
+    _usePersistentMapping = !(OpenGLCap.openGLVersion() < Version{ 4, 4, 0 }) ||
+                            OpenGLCap.isExtensionSupported("GL_ARB_buffer_storage");
 }
 
 void RenderableTrailOrbit::deinitializeGL() {
+    if (!_mappedRegions.empty()) {
+        for (MappedRegion& region : _mappedRegions) {
+            if (region.fence) {
+                glDeleteSync(region.fence);
+            }
+        }
+        _mappedRegions.clear();
+        glBindBuffer(GL_ARRAY_BUFFER, _primaryRenderInformation._vBufferID);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        _mappedCapacity = 0;
+    }
+
     glDeleteVertexArrays(1, &_primaryRenderInformation._vaoID);
     glDeleteBuffers(1, &_primaryRenderInformation._vBufferID);
     glDeleteBuffers(1, &_primaryRenderInformation._iBufferID);
@@ -222,17 +262,14 @@ void RenderableTrailOrbit::update(const UpdateData& data) {
     glBindVertexArray(_primaryRenderInformation._vaoID);
     glBindBuffer(GL_ARRAY_BUFFER, _primaryRenderInformation._vBufferID);
 
+    selectMappedRegion();
+
     // 3
     if (!report.permanentPointsNeedUpdate) {
         if (report.floatingPointNeedsUpdate) {
             // If no other values have been touched, we only need to upload the
             // floating value
-            glBufferSubData(
-                GL_ARRAY_BUFFER,
-                _primaryRenderInformation.first * sizeof(TrailVBOLayout),
-                sizeof(TrailVBOLayout),
-                _vertexArray.data() + _primaryRenderInformation.first
-            );
+            writeVertices(_primaryRenderInformation.first, 1);
         }
     }
     else {
@@ -240,40 +277,12 @@ void RenderableTrailOrbit::update(const UpdateData& data) {
         if (report.nUpdated == UpdateReport::All) {
             // If all of the values have been invalidated, we need to upload the entire
             // array
-            glBufferData(
-                GL_ARRAY_BUFFER,
-                _vertexArray.size() * sizeof(TrailVBOLayout),
-                _vertexArray.data(),
-                GL_STREAM_DRAW
-            );
-
-            if (_indexBufferDirty) {
-                // We only need to upload the index buffer if it has been invalidated
-                // by changing the number of values we want to represent
-                glBindBuffer(
-                    GL_ELEMENT_ARRAY_BUFFER,
-                    _primaryRenderInformation._iBufferID
-                );
-                glBufferData(
-                    GL_ELEMENT_ARRAY_BUFFER,
-                    _indexArray.size() * sizeof(unsigned int),
-                    _indexArray.data(),
-                    GL_STATIC_DRAW
-                );
-                _indexBufferDirty = false;
-            }
+            writeAllVertices();
         }
         else {
             // The lambda expression that will upload parts of the array starting at
             // begin and containing length number of elements
-            auto upload = [this](int begin, int length) {
-                glBufferSubData(
-                    GL_ARRAY_BUFFER,
-                    begin * sizeof(TrailVBOLayout),
-                    sizeof(TrailVBOLayout) * length,
-                    _vertexArray.data() + begin
-                );
-            };
+            auto upload = [this](int begin, int length) { writeVertices(begin, length); };
 
             // Only update the changed ones
             // Since we are using a ring buffer, the number of updated needed might be
@@ -332,12 +341,185 @@ void RenderableTrailOrbit::update(const UpdateData& data) {
         }
     }
 
+    // The draw calls read from the region that was written last
+    const size_t regionOffset = _currentRegion * _mappedCapacity * sizeof(TrailVBOLayout);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glVertexAttribPointer(
+        0,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        0,
+        reinterpret_cast<const void*>(regionOffset)
+    );
 
     glBindVertexArray(0);
 }
 
+void RenderableTrailOrbit::render(const RenderData& data, RendererTasks& rendererTask) {
+    RenderableTrail::render(data, rendererTask);
+
+    if (!_mappedRegions.empty()) {
+        MappedRegion& region = _mappedRegions[_currentRegion];
+        if (region.fence) {
+            glDeleteSync(region.fence);
+        }
+        region.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+void RenderableTrailOrbit::selectMappedRegion() {
+    if (_mappedRegions.empty()) {
+        return;
+    }
+
+    const int next = (_currentRegion + 1) % static_cast<int>(_mappedRegions.size());
+    MappedRegion& region = _mappedRegions[next];
+    if (region.fence) {
+        // Never block on the GPU here
+        const GLenum res = glClientWaitSync(region.fence, 0, 0);
+        if (res != GL_ALREADY_SIGNALED && res != GL_CONDITION_SATISFIED) {
+            // The GPU is still reading from the next region, so we keep using the
+            // current one. The driver orders glBufferSubData after the draw calls that
+            // might still read from it
+            _writeThroughDriver = true;
+            return;
+        }
+        glDeleteSync(region.fence);
+        region.fence = nullptr;
+    }
+
+    _currentRegion = next;
+    _writeThroughDriver = false;
+
+    // Catch up with all changes that happened while other regions were in use
+    if (region.isOutdated) {
+        std::memcpy(
+            region.vertices,
+            _vertexArray.data(),
+            _vertexArray.size() * sizeof(TrailVBOLayout)
+        );
+    }
+    else {
+        for (const std::pair<int, int>& range : region.pendingRanges) {
+            std::memcpy(
+                region.vertices + range.first,
+                _vertexArray.data() + range.first,
+                range.second * sizeof(TrailVBOLayout)
+            );
+        }
+    }
+    region.pendingRanges.clear();
+    region.isOutdated = false;
+}
+
+void RenderableTrailOrbit::writeVertices(int begin, int length) {
+    if (_mappedRegions.empty()) {
+        glBufferSubData(
+            GL_ARRAY_BUFFER,
+            begin * sizeof(TrailVBOLayout),
+            sizeof(TrailVBOLayout) * length,
+            _vertexArray.data() + begin
+        );
+        return;
+    }
+
+    // Remember the changes for all regions that are not written right now
+    for (int i = 0; i < static_cast<int>(_mappedRegions.size()); ++i) {
+        MappedRegion& region = _mappedRegions[i];
+        if (i == _currentRegion || region.isOutdated) {
+            continue;
+        }
+        if (static_cast<size_t>(length) == _mappedCapacity ||
+            region.pendingRanges.size() >= MaxPendingRanges)
+        {
+            region.isOutdated = true;
+            region.pendingRanges.clear();
+        }
+        else {
+            region.pendingRanges.emplace_back(begin, length);
+        }
+    }
+
+    if (_writeThroughDriver) {
+        glBufferSubData(
+            GL_ARRAY_BUFFER,
+            (_currentRegion * _mappedCapacity + begin) * sizeof(TrailVBOLayout),
+            sizeof(TrailVBOLayout) * length,
+            _vertexArray.data() + begin
+        );
+    }
+    else {
+        std::memcpy(
+            _mappedRegions[_currentRegion].vertices + begin,
+            _vertexArray.data() + begin,
+            length * sizeof(TrailVBOLayout)
+        );
+    }
+}
+
+void RenderableTrailOrbit::writeAllVertices() {
+    if (_usePersistentMapping) {
+        if (_mappedCapacity != _vertexArray.size()) {
+            // The storage of a buffer is immutable, so a different number of vertices
+            // requires a new buffer
+            if (!_mappedRegions.empty()) {
+                for (MappedRegion& region : _mappedRegions) {
+                    if (region.fence) {
+                        glDeleteSync(region.fence);
+                    }
+                }
+                _mappedRegions.clear();
+                glUnmapBuffer(GL_ARRAY_BUFFER);
+            }
+            glDeleteBuffers(1, &_primaryRenderInformation._vBufferID);
+            glGenBuffers(1, &_primaryRenderInformation._vBufferID);
+            glBindBuffer(GL_ARRAY_BUFFER, _primaryRenderInformation._vBufferID);
+
+            _mappedCapacity = _vertexArray.size();
+            const GLsizeiptr size =
+                NumberOfMappedRegions * _mappedCapacity * sizeof(TrailVBOLayout);
+            glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, PersistentStorageFlags);
+            TrailVBOLayout* vertices = reinterpret_cast<TrailVBOLayout*>(
+                glMapBufferRange(GL_ARRAY_BUFFER, 0, size, PersistentMappingFlags)
+            );
+
+            // The new buffer is not used by the GPU yet, so the first region can be
+            // written directly and the others are filled once they are needed
+            _mappedRegions.resize(NumberOfMappedRegions);
+            for (int i = 0; i < NumberOfMappedRegions; ++i) {
+                _mappedRegions[i].vertices = vertices + i * _mappedCapacity;
+                _mappedRegions[i].isOutdated = true;
+            }
+            _mappedRegions[0].isOutdated = false;
+            _currentRegion = 0;
+            _writeThroughDriver = false;
+        }
+        writeVertices(0, static_cast<int>(_vertexArray.size()));
+    }
+    else {
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            _vertexArray.size() * sizeof(TrailVBOLayout),
+            _vertexArray.data(),
+            GL_STREAM_DRAW
+        );
+    }
+
+    if (_indexBufferDirty) {
+        // We only need to upload the index buffer if it has been invalidated by changing
+        // the number of values we want to represent
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _primaryRenderInformation._iBufferID);
+        glBufferData(
+            GL_ELEMENT_ARRAY_BUFFER,
+            _indexArray.size() * sizeof(unsigned int),
+            _indexArray.data(),
+            GL_STATIC_DRAW
+        );
+        _indexBufferDirty = false;
+    }
+}
+
 RenderableTrailOrbit::UpdateReport RenderableTrailOrbit::updateTrails(
                                                                    const UpdateData& data)
 {
@@ -476,18 +658,35 @@ void RenderableTrailOrbit::fullSweep(double time) {
     using namespace std::chrono;
     const double periodSeconds = _period * duration_cast<seconds>(hours(24)).count();
     const double secondsPerPoint = periodSeconds / (_resolution - 1);
-    // starting at 1 because the first position is a floating current one
-    for (int i = 1; i < _resolution; ++i) {
-        const glm::vec3 p = _translation->position({ {}, Time(time), Time(0.0) });
-        _vertexArray[i] = { p.x, p.y, p.z };
+    auto sweep = [this, time, secondsPerPoint](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const double t = time - static_cast<double>(i - 1) * secondsPerPoint;
+            const glm::vec3 p = _translation->position({ {}, Time(t), Time(0.0) });
+            _vertexArray[i] = { p.x, p.y, p.z };
+        }
+    };
 
-        time -= secondsPerPoint;
+    // starting at 1 because the first position is a floating current one
+    const size_t nPoints = static_cast<size_t>(_resolution.value());
+    if (_resolution >= MinPointsForParallelSweep && _translation->isThreadSafe()) {
+        // The first point is computed on its own, as translations might lazily
+        // initialize some of their state in the first call
+        sweep(1, 2);
+        global::openSpaceEngine->threadPool().parallelFor(
+            2,
+            nPoints,
+            PointsPerSweepTask,
+            sweep
+        );
+    }
+    else {
+        sweep(1, nPoints);
     }
 
     _primaryRenderInformation.first = 0;
     _primaryRenderInformation.count = _resolution;
 
-    _firstPointTime = time + secondsPerPoint;
+    _firstPointTime = time - (_resolution - 2) * secondsPerPoint;
 
     // Updating bounding sphere
     glm::vec3 maxVertex(-std::numeric_limits<float>::max());
@@ -29,6 +29,8 @@
 
 #include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
+#include <utility>
+#include <vector>
 
 namespace openspace {
 
@@ -52,6 +54,7 @@ public:
     void deinitializeGL() override;
 
     void update(const UpdateData& data) override;
+    void render(const RenderData& data, RendererTasks& rendererTask) override;
 
     static documentation::Documentation Documentation();
 
@@ -87,6 +90,26 @@ private:
      */
     UpdateReport updateTrails(const UpdateData& data);
 
+    /**
+     * Makes the next mapped region the current one if the GPU has finished reading from
+     * it and brings its vertices up to date. If the GPU is still busy with it, the
+     * current region stays in use and is written through the driver instead.
+     */
+    void selectMappedRegion();
+
+    /**
+     * Writes \p length vertices starting at \p begin from the vertex array into the
+     * vertex buffer, which has to be bound.
+     */
+    void writeVertices(int begin, int length);
+
+    /**
+     * Writes the entire vertex array, and the index array if it changed, into the
+     * buffers. If the vertex buffer is mapped persistently and the number of vertices
+     * changed, a new buffer is created and bound.
+     */
+    void writeAllVertices();
+
     /// The orbital period of the RenderableTrail in days
     properties::DoubleProperty _period;
     /// The number of points that should be sampled between _period and now
@@ -105,6 +128,31 @@ private:
     double _lastPointTime = 0.0;
     /// The time stamp of when the last valid trail was generated.
     double _previousTime = 0.0;
+
+    /// One of the regions of the persistently mapped vertex buffer, each of which holds
+    /// a copy of all vertices
+    struct MappedRegion {
+        TrailVBOLayout* vertices = nullptr;
+        /// Signals when the last draw call that read from this region has finished
+        GLsync fence = nullptr;
+        /// The (begin, length) ranges of vertices that changed while this region was
+        /// not the current one
+        std::vector<std::pair<int, int>> pendingRanges;
+        /// If `true`, all vertices have to be rewritten before the region can be used
+        bool isOutdated = false;
+    };
+
+    /// If the OpenGL version supports it, the vertex buffer is split into regions that
+    /// are mapped persistently and the changed vertices are written into them directly
+    bool _usePersistentMapping = false;
+    std::vector<MappedRegion> _mappedRegions;
+    /// The number of vertices in each of the mapped regions
+    size_t _mappedCapacity = 0;
+    /// The region that the next draw calls will read from
+    int _currentRegion = 0;
+    /// Set if the current region might still be read by the GPU and has to be written
+    /// with glBufferSubData
+    bool _writeThroughDriver = false;
 };
 
 } // namespace openspace
@@ -29,6 +29,7 @@
 #include <openspace/scene/translation.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/updatestructures.h>
+#include <algorithm>
 #include <optional>
 
 // This class creates the entire trajectory at once and keeps it in memory the entire
@@ -37,7 +38,8 @@
 // Opposed to the RenderableTrailOrbit, no index buffer is needed as the vertex can be
 // written into the vertex buffer object continuously and then selected by using the
 // count variable from the RenderInformation struct to toggle rendering of the entire path
-// or subpath.
+// or subpath. The only exception is the adaptive sampling, which uses the index buffer to
+// skip the vertices that do not contribute to the shape of the trail.
 // In addition, this RenderableTrail implementation uses an additional RenderInformation
 // bucket that contains the line from the last shown point to the current location of the
 // object iff not the entire path is shown and the object is between _startTime and
@@ -89,6 +91,26 @@ namespace {
         openspace::properties::Property::Visibility::NoviceUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo AdaptiveSamplingInfo = {
+        "AdaptiveSampling",
+        "Adaptive Sampling",
+        "If this value is set to 'true', only the vertices that are necessary to keep "
+        "the shape of the trail are rendered. A vertex is kept whenever the trail has "
+        "turned by more than 'AdaptiveTolerance' degrees since the previously kept "
+        "vertex, which results in far fewer vertices for trails with long, mostly "
+        "straight sections",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo AdaptiveToleranceInfo = {
+        "AdaptiveTolerance",
+        "Adaptive Tolerance",
+        "The angle (in degrees) that the trail has to turn before another vertex is "
+        "kept if 'AdaptiveSampling' is enabled. Smaller values result in a more accurate "
+        "trail at the expense of more vertices",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo SweepChunkSizeInfo = {
         "SweepChunkSize",
         "Sweep Chunk Size",
@@ -117,6 +139,12 @@ namespace {
 
         // [[codegen::verbatim(SweepChunkSizeInfo.description)]]
         std::optional<int> sweepChunkSize;
+
+        // [[codegen::verbatim(AdaptiveSamplingInfo.description)]]
+        std::optional<bool> adaptiveSampling;
+
+        // [[codegen::verbatim(AdaptiveToleranceInfo.description)]]
+        std::optional<double> adaptiveTolerance [[codegen::greater(0.0)]];
     };
 #include "renderabletrailtrajectory_codegen.cpp"
 } // namespace
@@ -137,6 +165,8 @@ RenderableTrailTrajectory::RenderableTrailTrajectory(const ghoul::Dictionary& di
     , _sampleInterval(SampleIntervalInfo, 2.0, 2.0, 1e6)
     , _timeStampSubsamplingFactor(TimeSubSampleInfo, 1, 1, 1000000000)
     , _renderFullTrail(RenderFullPathInfo, false)
+    , _useAdaptiveSampling(AdaptiveSamplingInfo, false)
+    , _adaptiveTolerance(AdaptiveToleranceInfo, 0.5, 0.01, 45.0)
     , _maxVertex(glm::vec3(-std::numeric_limits<float>::max()))
     , _minVertex(glm::vec3(std::numeric_limits<float>::max()))
 {
@@ -164,6 +194,14 @@ RenderableTrailTrajectory::RenderableTrailTrajectory(const ghoul::Dictionary& di
     _renderFullTrail = p.showFullTrail.value_or(_renderFullTrail);
     addProperty(_renderFullTrail);
 
+    _useAdaptiveSampling = p.adaptiveSampling.value_or(_useAdaptiveSampling);
+    _useAdaptiveSampling.onChange([this] { _indexBufferIsDirty = true; });
+    addProperty(_useAdaptiveSampling);
+
+    _adaptiveTolerance = p.adaptiveTolerance.value_or(_adaptiveTolerance);
+    _adaptiveTolerance.onChange([this] { _indexBufferIsDirty = true; });
+    addProperty(_adaptiveTolerance);
+
     _sweepChunkSize = p.sweepChunkSize.value_or(_sweepChunkSize);
 
     // We store the vertices with ascending temporal order
@@ -173,7 +211,8 @@ RenderableTrailTrajectory::RenderableTrailTrajectory(const ghoul::Dictionary& di
 void RenderableTrailTrajectory::initializeGL() {
     RenderableTrail::initializeGL();
 
-    // We don't need an index buffer, so we keep it at the default value of 0
+    // The index buffer is only created if adaptive sampling is enabled, so we keep it at
+    // the default value of 0 for now
     glGenVertexArrays(1, &_primaryRenderInformation._vaoID);
     glGenBuffers(1, &_primaryRenderInformation._vBufferID);
 
@@ -187,6 +226,10 @@ void RenderableTrailTrajectory::initializeGL() {
 void RenderableTrailTrajectory::deinitializeGL() {
     glDeleteVertexArrays(1, &_primaryRenderInformation._vaoID);
     glDeleteBuffers(1, &_primaryRenderInformation._vBufferID);
+    if (_primaryRenderInformation._iBufferID != 0) {
+        glDeleteBuffers(1, &_primaryRenderInformation._iBufferID);
+        _primaryRenderInformation._iBufferID = 0;
+    }
 
     glDeleteVertexArrays(1, &_floatingRenderInformation._vaoID);
     glDeleteBuffers(1, &_floatingRenderInformation._vBufferID);
@@ -201,6 +244,63 @@ void RenderableTrailTrajectory::reset() {
     _minVertex = glm::vec3(std::numeric_limits<float>::max());
 }
 
+void RenderableTrailTrajectory::updateAdaptiveIndices() {
+    _indexArray.clear();
+
+    glBindVertexArray(_primaryRenderInformation._vaoID);
+    if (!_useAdaptiveSampling || _vertexArray.size() < 3) {
+        // Without adaptive sampling the base class draws the vertex buffer directly,
+        // which it detects by not having an index buffer
+        if (_primaryRenderInformation._iBufferID != 0) {
+            glDeleteBuffers(1, &_primaryRenderInformation._iBufferID);
+            _primaryRenderInformation._iBufferID = 0;
+        }
+        return;
+    }
+
+    auto position = [this](size_t i) {
+        return glm::dvec3(_vertexArray[i].x, _vertexArray[i].y, _vertexArray[i].z);
+    };
+
+    // Walk along the trail and accumulate the angle by which it turns at each vertex. As
+    // soon as that angle exceeds the tolerance, the vertex is kept and the accumulation
+    // starts over. The first and the last vertex are always kept
+    const double tolerance = glm::radians(static_cast<double>(_adaptiveTolerance));
+    double accumulatedAngle = 0.0;
+    _indexArray.push_back(0);
+    for (size_t i = 1; i < _vertexArray.size() - 1; i++) {
+        const glm::dvec3 incoming = position(i) - position(i - 1);
+        const glm::dvec3 outgoing = position(i + 1) - position(i);
+        const double lengths = glm::length(incoming) * glm::length(outgoing);
+        if (lengths == 0.0) {
+            continue;
+        }
+
+        const double cosAngle = std::clamp(
+            glm::dot(incoming, outgoing) / lengths,
+            -1.0,
+            1.0
+        );
+        accumulatedAngle += std::acos(cosAngle);
+        if (accumulatedAngle >= tolerance) {
+            _indexArray.push_back(static_cast<unsigned int>(i));
+            accumulatedAngle = 0.0;
+        }
+    }
+    _indexArray.push_back(static_cast<unsigned int>(_vertexArray.size() - 1));
+
+    if (_primaryRenderInformation._iBufferID == 0) {
+        glGenBuffers(1, &_primaryRenderInformation._iBufferID);
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _primaryRenderInformation._iBufferID);
+    glBufferData(
+        GL_ELEMENT_ARRAY_BUFFER,
+        _indexArray.size() * sizeof(unsigned int),
+        _indexArray.data(),
+        GL_STATIC_DRAW
+    );
+}
+
 void RenderableTrailTrajectory::update(const UpdateData& data) {
     if (_needsFullSweep) {
 
@@ -286,20 +386,28 @@ void RenderableTrailTrajectory::update(const UpdateData& data) {
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
 
-        // We clear the indexArray just in case. The base class will take care not to use
-        // it if it is empty
-        _indexArray.clear();
-
         _subsamplingIsDirty = true;
+        _indexBufferIsDirty = true;
         _needsFullSweep = false;
     }
 
+    if (_indexBufferIsDirty) {
+        updateAdaptiveIndices();
+        _indexBufferIsDirty = false;
+    }
+
+    // The number of elements that make up the full trail, which are vertices or indices
+    // depending on whether adaptive sampling is used
+    const GLsizei nElements = static_cast<GLsizei>(
+        _indexArray.empty() ? _vertexArray.size() : _indexArray.size()
+    );
+
     // This has to be done every update step;
     if (_renderFullTrail) {
         // If the full trail should be rendered at all times, we can directly render the
         // entire set
         _primaryRenderInformation.first = 0;
-        _primaryRenderInformation.count = static_cast<GLsizei>(_vertexArray.size());
+        _primaryRenderInformation.count = nElements;
     }
     else {
         // If only trail so far should be rendered, we need to find the corresponding time
@@ -316,9 +424,20 @@ void RenderableTrailTrajectory::update(const UpdateData& data) {
                     floor(_vertexArray.size() - 1) * t
                 )
                 );
+
+            if (!_indexArray.empty()) {
+                // Only the kept vertices up to the current time are rendered
+                const auto it = std::upper_bound(
+                    _indexArray.begin(),
+                    _indexArray.end(),
+                    static_cast<unsigned int>(_primaryRenderInformation.count - 1)
+                );
+                _primaryRenderInformation.count =
+                    static_cast<GLsizei>(std::distance(_indexArray.begin(), it));
+            }
         }
         else {
-            _primaryRenderInformation.count = static_cast<GLsizei>(_vertexArray.size());
+            _primaryRenderInformation.count = nElements;
         }
 
     }
@@ -331,11 +450,10 @@ void RenderableTrailTrajectory::update(const UpdateData& data) {
         ghoul_assert(_primaryRenderInformation.count > 0, "No vertices available");
 
         // Copy the last valid location
-        glm::dvec3 v0(
-            _vertexArray[_primaryRenderInformation.count - 1].x,
-            _vertexArray[_primaryRenderInformation.count - 1].y,
-            _vertexArray[_primaryRenderInformation.count - 1].z
-        );
+        const size_t last = _indexArray.empty() ?
+            _primaryRenderInformation.count - 1 :
+            _indexArray[_primaryRenderInformation.count - 1];
+        glm::dvec3 v0(_vertexArray[last].x, _vertexArray[last].y, _vertexArray[last].z);
 
         // And get the current location of the object
         const glm::dvec3 p = _translation->position(data);
@@ -47,6 +47,10 @@ namespace documentation { struct Documentation; }
  * trail in the future. If _renderFullTrail is false, the current position of the object
  * has to be updated constantly to make the trail connect to the object that has the
  * trail.
+ * If _useAdaptiveSampling is true, the uniformly sampled vertices are thinned out after
+ * the sweep by only keeping the vertices at which the trail has turned by more than
+ * _adaptiveTolerance degrees since the last kept vertex. The selected vertices are
+ * rendered through the index buffer.
  */
 class RenderableTrailTrajectory : public RenderableTrail {
 public:
@@ -64,6 +68,10 @@ private:
     /// Reset some variables to default state
     void reset();
 
+    /// Selects the vertices that are rendered when adaptive sampling is enabled and
+    /// uploads them into the index buffer
+    void updateAdaptiveIndices();
+
     /// The number of vertices that we calculate during each frame of the full sweep pass
     unsigned int _sweepChunkSize = 200;
 
@@ -78,6 +86,10 @@ private:
     properties::IntProperty _timeStampSubsamplingFactor;
     /// Determines whether the full trail should be rendered or the future trail removed
     properties::BoolProperty _renderFullTrail;
+    /// Determines whether the vertices are thinned out based on their angular deviation
+    properties::BoolProperty _useAdaptiveSampling;
+    /// The turning angle (in degrees) after which the next vertex is kept
+    properties::DoubleProperty _adaptiveTolerance;
 
     /// Dirty flag that determines whether the full vertex buffer needs to be resampled
     bool _needsFullSweep = true;
@@ -85,6 +97,9 @@ private:
     /// Dirty flag to determine whether the stride information needs to be changed
     bool _subsamplingIsDirty = true;
 
+    /// Dirty flag to determine whether the adaptive vertex selection has to be redone
+    bool _indexBufferIsDirty = false;
+
     std::array<TrailVBOLayout, 2> _auxiliaryVboData = {};
 
     /// The conversion of the _startTime into the internal time format
@@ -26,11 +26,7 @@
 
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
-#include <openspace/engine/globals.h>
-#include <openspace/engine/downloadmanager.h>
 #include <ghoul/filesystem/filesystem.h>
-#include <ghoul/io/texture/texturereader.h>
-#include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/programobject.h>
 #include <optional>
@@ -95,79 +91,15 @@ bool ScreenSpaceImageOnline::deinitializeGL() {
 
 void ScreenSpaceImageOnline::update() {
     if (_textureIsDirty) {
-        if (!_imageFuture.valid()) {
-            std::future<DownloadManager::MemoryFile> future = downloadImageToMemory(
-                _texturePath
-            );
-            if (future.valid()) {
-                _imageFuture = std::move(future);
-            }
-        }
-
-        if (_imageFuture.valid() && DownloadManager::futureReady(_imageFuture)) {
-            DownloadManager::MemoryFile imageFile = _imageFuture.get();
-
-            if (imageFile.corrupted) {
-                LERRORC(
-                    "ScreenSpaceImageOnline",
-                    fmt::format("Error loading image from URL '{}'", _texturePath)
-                );
-                return;
-            }
-
-            try {
-                std::unique_ptr<ghoul::opengl::Texture> texture =
-                    ghoul::io::TextureReader::ref().loadTexture(
-                        reinterpret_cast<void*>(imageFile.buffer),
-                        imageFile.size,
-                        2,
-                        imageFile.format
-                    );
-
-                if (texture) {
-                    // Images don't need to start on 4-byte boundaries, for example if the
-                    // image is only RGB
-                    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-                    if (texture->format() == ghoul::opengl::Texture::Format::Red) {
-                        texture->setSwizzleMask({ GL_RED, GL_RED, GL_RED, GL_ONE });
-                    }
-
-                    texture->uploadTexture();
-                    texture->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
-                    texture->purgeFromRAM();
-
-                    _texture = std::move(texture);
-                    _objectSize = _texture->dimensions();
-                    _textureIsDirty = false;
-                }
-            }
-            catch (const ghoul::io::TextureReader::InvalidLoadException& e) {
-                _textureIsDirty = false;
-                LERRORC(e.component, e.message);
-            }
-        }
+        _imageLoader.load(_texturePath);
+        _textureIsDirty = false;
     }
-}
 
-std::future<DownloadManager::MemoryFile> ScreenSpaceImageOnline::downloadImageToMemory(
-                                                                   const std::string& url)
-{
-    return global::downloadManager->fetchFile(
-        url,
-        [url](const DownloadManager::MemoryFile&) {
-            LDEBUGC(
-                "ScreenSpaceImageOnline",
-                "Download to memory finished for screen space image"
-            );
-        },
-        [url](const std::string& err) {
-            LDEBUGC(
-                "ScreenSpaceImageOnline",
-                "Download to memory failed for screen space image: " + err
-            );
-        }
-    );
+    std::unique_ptr<ghoul::opengl::Texture> texture = _imageLoader.finishedTexture();
+    if (texture) {
+        _texture = std::move(texture);
+        _objectSize = _texture->dimensions();
+    }
 }
 
 void ScreenSpaceImageOnline::bindTexture() {
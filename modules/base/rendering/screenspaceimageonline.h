@@ -27,7 +27,7 @@
 
 #include <openspace/rendering/screenspacerenderable.h>
 
-#include <openspace/engine/downloadmanager.h>
+#include <modules/base/rendering/onlineimageloader.h>
 #include <openspace/properties/stringproperty.h>
 
 namespace ghoul::opengl { class Texture; }
@@ -50,15 +50,12 @@ public:
 protected:
     bool _downloadImage = false;
     bool _textureIsDirty;
-    std::future<DownloadManager::MemoryFile> _imageFuture;
     properties::StringProperty _texturePath;
 
 private:
     void bindTexture() override;
 
-    std::future<DownloadManager::MemoryFile> downloadImageToMemory(
-        const std::string& url);
-
+    OnlineImageLoader _imageLoader;
     std::unique_ptr<ghoul::opengl::Texture> _texture;
 };
 
@@ -0,0 +1,650 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/base/rendering/spherevirtualtexture.h>
+
+#include <openspace/util/job.h>
+#include <openspace/util/stablehash.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <stb_image.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <string_view>
+
+namespace {
+    constexpr std::string_view _loggerCat = "SphereVirtualTexture";
+
+    using SphereVirtualTexture = openspace::SphereVirtualTexture;
+
+    // The size of a tile including its border
+    constexpr int SlotSize = SphereVirtualTexture::TileSize +
+                             2 * SphereVirtualTexture::TileBorder;
+    constexpr size_t TileBytes = static_cast<size_t>(SlotSize) * SlotSize * 4;
+
+    // The number of tiles along each side of the tile atlas
+    constexpr int AtlasTiles = 16;
+    constexpr int AtlasSize = AtlasTiles * SlotSize;
+
+    constexpr size_t MaxTileReadsInFlight = 16;
+    constexpr int MaxTileUploadsPerFrame = 8;
+
+    // The size of the image is rounded up to a power of two number of tiles, so that the
+    // tiles of one level cover exactly four tiles of the next finer level
+    int numberOfTiles(int size) {
+        int n = 1;
+        while (n * SphereVirtualTexture::TileSize < size) {
+            n *= 2;
+        }
+        return n;
+    }
+
+    uint64_t tileKey(int level, int x, int y) {
+        // The level is stored in the highest bits so that sorting the keys sorts the
+        // tiles by their level
+        return (static_cast<uint64_t>(level) << 48) | (static_cast<uint64_t>(y) << 24) |
+               static_cast<uint64_t>(x);
+    }
+
+    int tileLevel(uint64_t key) {
+        return static_cast<int>(key >> 48);
+    }
+
+    glm::ivec2 tilePosition(uint64_t key) {
+        return glm::ivec2(key & 0xFFFFFF, (key >> 24) & 0xFFFFFF);
+    }
+
+    std::filesystem::path levelFile(const std::filesystem::path& directory, int level) {
+        return directory / fmt::format("level{}.tiles", level);
+    }
+
+    // Resamples the RGBA \p image with bilinear filtering. The image wraps around
+    // horizontally since it covers the entire sphere
+    std::vector<uint8_t> resample(const uint8_t* image, glm::ivec2 size,
+                                  glm::ivec2 newSize)
+    {
+        std::vector<uint8_t> result(static_cast<size_t>(newSize.x) * newSize.y * 4);
+        const glm::dvec2 scale = glm::dvec2(size) / glm::dvec2(newSize);
+        for (int y = 0; y < newSize.y; y++) {
+            const double sy = std::clamp((y + 0.5) * scale.y - 0.5, 0.0, size.y - 1.0);
+            const int y0 = static_cast<int>(sy);
+            const int y1 = std::min(y0 + 1, size.y - 1);
+            const double fy = sy - y0;
+            for (int x = 0; x < newSize.x; x++) {
+                const double sx = std::max((x + 0.5) * scale.x - 0.5, 0.0);
+                const int x0 = static_cast<int>(sx) % size.x;
+                const int x1 = (x0 + 1) % size.x;
+                const double fx = sx - std::floor(sx);
+                for (int c = 0; c < 4; c++) {
+                    auto pixel = [&](int px, int py) {
+                        return static_cast<double>(
+                            image[(static_cast<size_t>(py) * size.x + px) * 4 + c]
+                        );
+                    };
+                    const double v =
+                        (pixel(x0, y0) * (1.0 - fx) + pixel(x1, y0) * fx) * (1.0 - fy) +
+                        (pixel(x0, y1) * (1.0 - fx) + pixel(x1, y1) * fx) * fy;
+                    result[(static_cast<size_t>(y) * newSize.x + x) * 4 + c] =
+                        static_cast<uint8_t>(std::clamp(v + 0.5, 0.0, 255.0));
+                }
+            }
+        }
+        return result;
+    }
+
+    // Reduces the size of the RGBA \p image by averaging \p factor pixels in each
+    // direction
+    std::vector<uint8_t> downsample(const std::vector<uint8_t>& image, glm::ivec2 size,
+                                    glm::ivec2 factor)
+    {
+        const glm::ivec2 newSize = size / factor;
+        std::vector<uint8_t> result(static_cast<size_t>(newSize.x) * newSize.y * 4);
+        const int nPixels = factor.x * factor.y;
+        for (int y = 0; y < newSize.y; y++) {
+            for (int x = 0; x < newSize.x; x++) {
+                for (int c = 0; c < 4; c++) {
+                    int sum = 0;
+                    for (int fy = 0; fy < factor.y; fy++) {
+                        for (int fx = 0; fx < factor.x; fx++) {
+                            const size_t i = (static_cast<size_t>(y * factor.y + fy) *
+                                size.x + x * factor.x + fx) * 4 + c;
+                            sum += image[i];
+                        }
+                    }
+                    result[(static_cast<size_t>(y) * newSize.x + x) * 4 + c] =
+                        static_cast<uint8_t>((sum + nPixels / 2) / nPixels);
+                }
+            }
+        }
+        return result;
+    }
+
+    // Writes all tiles of one level, including their borders, into the \p path
+    bool writeLevel(const std::filesystem::path& path, const std::vector<uint8_t>& image,
+                    glm::ivec2 nTiles)
+    {
+        constexpr int TileSize = SphereVirtualTexture::TileSize;
+        constexpr int TileBorder = SphereVirtualTexture::TileBorder;
+
+        const glm::ivec2 size = nTiles * TileSize;
+        std::ofstream file(path, std::ios::binary);
+        std::vector<uint8_t> tile(TileBytes);
+        for (int ty = 0; ty < nTiles.y; ty++) {
+            for (int tx = 0; tx < nTiles.x; tx++) {
+                for (int y = 0; y < SlotSize; y++) {
+                    const int sy =
+                        std::clamp(ty * TileSize - TileBorder + y, 0, size.y - 1);
+                    for (int x = 0; x < SlotSize; x++) {
+                        const int sx =
+                            (tx * TileSize - TileBorder + x + size.x) % size.x;
+                        const size_t src = (static_cast<size_t>(sy) * size.x + sx) * 4;
+                        const size_t dst = (static_cast<size_t>(y) * SlotSize + x) * 4;
+                        std::copy_n(&image[src], 4, &tile[dst]);
+                    }
+                }
+                file.write(reinterpret_cast<const char*>(tile.data()), tile.size());
+            }
+        }
+        return file.good();
+    }
+} // namespace
+
+namespace openspace {
+
+// Reading a single tile from the cache on the worker thread
+struct SphereVirtualTexture::ReadTileJob : public Job<Tile> {
+    ReadTileJob(std::filesystem::path file_, size_t offset_, uint64_t key)
+        : file(std::move(file_))
+        , offset(offset_)
+    {
+        result.key = key;
+    }
+
+    void execute() override {
+        std::ifstream stream(file, std::ios::binary);
+        stream.seekg(offset);
+        result.pixels.resize(TileBytes);
+        stream.read(reinterpret_cast<char*>(result.pixels.data()), TileBytes);
+        if (!stream.good()) {
+            result.pixels.clear();
+        }
+    }
+
+    Tile product() override {
+        return std::move(result);
+    }
+
+    const std::filesystem::path file;
+    const size_t offset;
+    Tile result;
+};
+
+SphereVirtualTexture::SphereVirtualTexture(std::filesystem::path image)
+    : _image(std::move(image))
+    , _tileReader(std::make_unique<ConcurrentJobManager<Tile>>(ThreadPool(1)))
+{
+    _layoutFuture = std::async(
+        std::launch::async,
+        &SphereVirtualTexture::createLayout,
+        _image,
+        absPath("${CACHE}/virtualtextures")
+    );
+}
+
+SphereVirtualTexture::~SphereVirtualTexture() {
+    glDeleteTextures(1, &_atlas);
+    glDeleteTextures(1, &_pageTable);
+}
+
+std::optional<SphereVirtualTexture::Layout>
+SphereVirtualTexture::createLayout(std::filesystem::path image,
+                                   std::filesystem::path cacheDirectory)
+{
+    std::error_code ec;
+    const auto modified = std::filesystem::last_write_time(image, ec);
+    const uintmax_t fileSize = ec ? 0 : std::filesystem::file_size(image, ec);
+    if (ec) {
+        LERROR(fmt::format("Could not open image {}: {}", image, ec.message()));
+        return std::nullopt;
+    }
+
+    // The tiles are stored in a directory that changes whenever the image does
+    const std::string id = fmt::format(
+        "{}|{}|{}", image, fileSize, modified.time_since_epoch().count()
+    );
+    Layout layout;
+    layout.directory = cacheDirectory / fmt::format("{:016x}", stableHash(id));
+
+    // The info file is written last, so if it exists all tiles are there as well
+    const std::filesystem::path infoFile = layout.directory / "tiles.info";
+    {
+        std::ifstream file(infoFile);
+        file >> layout.nTiles.x >> layout.nTiles.y >> layout.nLevels;
+        if (file.good() && layout.nLevels > 0) {
+            return layout;
+        }
+    }
+
+    LINFO(fmt::format("Creating tiles for virtual texture {}", image));
+    // stb_image returns the rows from the top of the image, but the texture coordinates
+    // of the sphere start at the bottom
+    stbi_set_flip_vertically_on_load_thread(1);
+    glm::ivec2 size = glm::ivec2(0);
+    int nChannels = 0;
+    stbi_uc* data = stbi_load(image.string().c_str(), &size.x, &size.y, &nChannels, 4);
+    if (!data) {
+        LERROR(fmt::format(
+            "Could not load image {}: {}", image, stbi_failure_reason()
+        ));
+        return std::nullopt;
+    }
+
+    layout.nTiles = glm::ivec2(numberOfTiles(size.x), numberOfTiles(size.y));
+    layout.nLevels = 1;
+    while ((std::max(layout.nTiles.x, layout.nTiles.y) >> (layout.nLevels - 1)) > 1) {
+        layout.nLevels++;
+    }
+
+    glm::ivec2 levelSize = layout.nTiles * TileSize;
+    std::vector<uint8_t> level = resample(data, size, levelSize);
+    stbi_image_free(data);
+
+    std::filesystem::create_directories(layout.directory, ec);
+    for (int l = 0; l < layout.nLevels; l++) {
+        const glm::ivec2 nTiles = glm::max(layout.nTiles >> l, glm::ivec2(1));
+        if (!writeLevel(levelFile(layout.directory, l), level, nTiles)) {
+            LERROR(fmt::format("Could not write tiles to {}", layout.directory));
+            return std::nullopt;
+        }
+
+        if (l + 1 < layout.nLevels) {
+            const glm::ivec2 factor =
+                nTiles / glm::max(layout.nTiles >> (l + 1), glm::ivec2(1));
+            level = downsample(level, levelSize, factor);
+            levelSize /= factor;
+        }
+    }
+
+    std::ofstream file(infoFile);
+    file << layout.nTiles.x << ' ' << layout.nTiles.y << ' ' << layout.nLevels << '\n';
+    return layout;
+}
+
+bool SphereVirtualTexture::isReady() const {
+    return _layout.has_value() &&
+           _residentTiles.contains(tileKey(_layout->nLevels - 1, 0, 0));
+}
+
+void SphereVirtualTexture::update() {
+    if (!_layout) {
+        if (!_layoutFuture.valid() ||
+            _layoutFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            return;
+        }
+
+        _layout = _layoutFuture.get();
+        if (!_layout) {
+            return;
+        }
+
+        glGenTextures(1, &_atlas);
+        glBindTexture(GL_TEXTURE_2D, _atlas);
+        glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            GL_RGBA8,
+            AtlasSize,
+            AtlasSize,
+            0,
+            GL_RGBA,
+            GL_UNSIGNED_BYTE,
+            nullptr
+        );
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glGenTextures(1, &_pageTable);
+        glBindTexture(GL_TEXTURE_2D, _pageTable);
+        glTexImage2D(
+            GL_TEXTURE_2D,
+            0,
+            GL_RGBA8UI,
+            _layout->nTiles.x,
+            _layout->nTiles.y,
+            0,
+            GL_RGBA_INTEGER,
+            GL_UNSIGNED_BYTE,
+            nullptr
+        );
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        for (int slot = AtlasTiles * AtlasTiles - 1; slot >= 0; slot--) {
+            _freeSlots.push_back(slot);
+        }
+
+        // The coarsest tile is the fallback for all other tiles
+        requestTile(tileKey(_layout->nLevels - 1, 0, 0));
+    }
+
+    int nUploads = 0;
+    while (nUploads < MaxTileUploadsPerFrame && _tileReader->numFinishedJobs() > 0) {
+        Tile tile = _tileReader->popFinishedJob()->product();
+        _requestedTiles.erase(tile.key);
+        if (tile.pixels.empty()) {
+            const glm::ivec2 p = tilePosition(tile.key);
+            LERROR(fmt::format(
+                "Could not read tile ({}, {}) on level {} of virtual texture {}",
+                p.x, p.y, tileLevel(tile.key), _image
+            ));
+            _failedTiles.insert(tile.key);
+            continue;
+        }
+        uploadTile(tile);
+        nUploads++;
+    }
+
+    if (_pageTableIsDirty) {
+        updatePageTable();
+    }
+}
+
+void SphereVirtualTexture::requestVisibleTiles(const glm::dmat4& modelViewProjection,
+                                               const glm::dvec3& cameraPosition,
+                                               const glm::ivec2& resolution,
+                                               bool isMirrored, bool cullBackfaces)
+{
+    if (!_layout) {
+        return;
+    }
+
+    _frame++;
+    _visibleTiles.clear();
+    collectTiles(
+        _layout->nLevels - 1,
+        0,
+        0,
+        modelViewProjection,
+        cameraPosition,
+        resolution,
+        isMirrored,
+        cullBackfaces
+    );
+
+    const int coarsestLevel = _layout->nLevels - 1;
+    std::vector<uint64_t> missingTiles;
+    for (uint64_t key : _visibleTiles) {
+        auto it = _residentTiles.find(key);
+        if (it != _residentTiles.end()) {
+            it->second.lastUsedFrame = _frame;
+        }
+        else if (!_requestedTiles.contains(key) && !_failedTiles.contains(key)) {
+            missingTiles.push_back(key);
+        }
+    }
+
+    // Only read as many tiles as there is space for in the atlas without replacing
+    // tiles that are visible right now
+    size_t nAvailableSlots = _freeSlots.size();
+    for (const auto& [key, tile] : _residentTiles) {
+        if (tile.lastUsedFrame != _frame && tileLevel(key) != coarsestLevel) {
+            nAvailableSlots++;
+        }
+    }
+
+    // Coarser tiles are read first as they act as the fallback for the finer tiles
+    std::sort(missingTiles.begin(), missingTiles.end(), std::greater<>());
+    for (uint64_t key : missingTiles) {
+        if (_requestedTiles.size() >= std::min(MaxTileReadsInFlight, nAvailableSlots)) {
+            break;
+        }
+        requestTile(key);
+    }
+}
+
+void SphereVirtualTexture::bindAtlas() const {
+    glBindTexture(GL_TEXTURE_2D, _atlas);
+}
+
+void SphereVirtualTexture::bindPageTable() const {
+    glBindTexture(GL_TEXTURE_2D, _pageTable);
+}
+
+glm::ivec2 SphereVirtualTexture::nTiles(int level) const {
+    return glm::max(_layout->nTiles >> level, glm::ivec2(1));
+}
+
+void SphereVirtualTexture::collectTiles(int level, int x, int y,
+                                        const glm::dmat4& modelViewProjection,
+                                        const glm::dvec3& cameraPosition,
+                                        const glm::ivec2& resolution, bool isMirrored,
+                                        bool cullBackfaces)
+{
+    const glm::ivec2 grid = nTiles(level);
+    const glm::dvec2 tileExtent = 1.0 / glm::dvec2(grid);
+
+    // Project a grid of points on the tile onto the screen to determine whether it is
+    // visible and how large it is
+    constexpr int NSamples = 3;
+    int commonOutside = 0b11111;
+    bool isFacing = false;
+    bool isBehind = false;
+    glm::dvec2 ndcMin = glm::dvec2(std::numeric_limits<double>::max());
+    glm::dvec2 ndcMax = glm::dvec2(std::numeric_limits<double>::lowest());
+    for (int sy = 0; sy < NSamples; sy++) {
+        for (int sx = 0; sx < NSamples; sx++) {
+            glm::dvec2 uv = (glm::dvec2(x, y) + glm::dvec2(sx, sy) / (NSamples - 1.0)) *
+                            tileExtent;
+            if (isMirrored) {
+                uv.x = 1.0 - uv.x;
+            }
+
+            // Same mapping from texture coordinates to positions as in the Sphere class
+            const double theta = (1.0 - uv.y) * glm::pi<double>();
+            const double phi = uv.x * glm::two_pi<double>();
+            const glm::dvec3 p = glm::dvec3(
+                std::sin(theta) * std::cos(phi),
+                std::sin(theta) * std::sin(phi),
+                std::cos(theta)
+            );
+            const glm::dvec4 clip = modelViewProjection * glm::dvec4(p, 1.0);
+
+            int outside = 0;
+            outside |= clip.x < -clip.w ? 0b00001 : 0;
+            outside |= clip.x > clip.w ? 0b00010 : 0;
+            outside |= clip.y < -clip.w ? 0b00100 : 0;
+            outside |= clip.y > clip.w ? 0b01000 : 0;
+            outside |= clip.w <= 0.0 ? 0b10000 : 0;
+            commonOutside &= outside;
+
+            isFacing |= glm::dot(p, cameraPosition - p) > 0.0;
+            if (clip.w > 0.0) {
+                const glm::dvec2 ndc = glm::clamp(
+                    glm::dvec2(clip) / clip.w,
+                    glm::dvec2(-1.5),
+                    glm::dvec2(1.5)
+                );
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+            else {
+                isBehind = true;
+            }
+        }
+    }
+
+    // The samples are too sparse on large tiles to conclude that they are invisible
+    const bool canCull = tileExtent.x <= 0.125 && tileExtent.y <= 0.125;
+    if (canCull && (commonOutside != 0 || (cullBackfaces && !isFacing))) {
+        return;
+    }
+
+    _visibleTiles.insert(tileKey(level, x, y));
+    if (level == 0) {
+        return;
+    }
+
+    // The tile needs more detail if it covers more pixels on screen than it has
+    const glm::dvec2 pixels = (ndcMax - ndcMin) * 0.5 * glm::dvec2(resolution);
+    const bool needsDetail = (!canCull && isBehind) ||
+                             std::max(pixels.x, pixels.y) > TileSize;
+    if (!needsDetail) {
+        return;
+    }
+
+    const glm::ivec2 factor = nTiles(level - 1) / grid;
+    for (int cy = 0; cy < factor.y; cy++) {
+        for (int cx = 0; cx < factor.x; cx++) {
+            collectTiles(
+                level - 1,
+                x * factor.x + cx,
+                y * factor.y + cy,
+                modelViewProjection,
+                cameraPosition,
+                resolution,
+                isMirrored,
+                cullBackfaces
+            );
+        }
+    }
+}
+
+void SphereVirtualTexture::requestTile(uint64_t key) {
+    const int level = tileLevel(key);
+    const glm::ivec2 p = tilePosition(key);
+    const size_t index = static_cast<size_t>(p.y) * nTiles(level).x + p.x;
+    _requestedTiles.insert(key);
+    _tileReader->enqueueJob(std::make_shared<ReadTileJob>(
+        levelFile(_layout->directory, level),
+        index * TileBytes,
+        key
+    ));
+}
+
+void SphereVirtualTexture::uploadTile(const Tile& tile) {
+    if (_residentTiles.contains(tile.key)) {
+        return;
+    }
+
+    int slot = 0;
+    if (!_freeSlots.empty()) {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else {
+        // Replace the tile that has not been visible for the longest time, but never a
+        // tile that is visible right now or the coarsest tile
+        auto replaced = _residentTiles.end();
+        for (auto it = _residentTiles.begin(); it != _residentTiles.end(); it++) {
+            if (it->second.lastUsedFrame == _frame ||
+                tileLevel(it->first) == _layout->nLevels - 1)
+            {
+                continue;
+            }
+            if (replaced == _residentTiles.end() ||
+                it->second.lastUsedFrame < replaced->second.lastUsedFrame)
+            {
+                replaced = it;
+            }
+        }
+        if (replaced == _residentTiles.end()) {
+            return;
+        }
+        slot = replaced->second.slot;
+        _residentTiles.erase(replaced);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, _atlas);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        (slot % AtlasTiles) * SlotSize,
+        (slot / AtlasTiles) * SlotSize,
+        SlotSize,
+        SlotSize,
+        GL_RGBA,
+        GL_UNSIGNED_BYTE,
+        tile.pixels.data()
+    );
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    _residentTiles[tile.key] = { slot, _frame };
+    _pageTableIsDirty = true;
+}
+
+void SphereVirtualTexture::updatePageTable() {
+    const glm::ivec2 size = _layout->nTiles;
+    std::vector<uint8_t> entries(static_cast<size_t>(size.x) * size.y * 4, 0);
+
+    // Coarser tiles are written first so that finer tiles replace them where they exist
+    std::vector<std::pair<uint64_t, ResidentTile>> tiles(
+        _residentTiles.begin(),
+        _residentTiles.end()
+    );
+    std::sort(
+        tiles.begin(),
+        tiles.end(),
+        [](const auto& a, const auto& b) { return a.first > b.first; }
+    );
+
+    for (const auto& [key, tile] : tiles) {
+        const int level = tileLevel(key);
+        const glm::ivec2 p = tilePosition(key);
+        const glm::ivec2 cover = size / nTiles(level);
+        for (int y = p.y * cover.y; y < (p.y + 1) * cover.y; y++) {
+            for (int x = p.x * cover.x; x < (p.x + 1) * cover.x; x++) {
+                uint8_t* entry = &entries[(static_cast<size_t>(y) * size.x + x) * 4];
+                entry[0] = static_cast<uint8_t>(tile.slot % AtlasTiles);
+                entry[1] = static_cast<uint8_t>(tile.slot / AtlasTiles);
+                entry[2] = static_cast<uint8_t>(level);
+                entry[3] = 255;
+            }
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, _pageTable);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        size.x,
+        size.y,
+        GL_RGBA_INTEGER,
+        GL_UNSIGNED_BYTE,
+        entries.data()
+    );
+    glBindTexture(GL_TEXTURE_2D, 0);
+    _pageTableIsDirty = false;
+}
+
+} // namespace openspace
@@ -0,0 +1,155 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_BASE___SPHEREVIRTUALTEXTURE___H__
+#define __OPENSPACE_MODULE_BASE___SPHEREVIRTUALTEXTURE___H__
+
+#include <openspace/util/concurrentjobmanager.h>
+#include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * A virtual texture for an equirectangular image that is mapped onto a sphere. Instead
+ * of uploading the whole image, the image is split into tiles of a mip pyramid once and
+ * stored in the cache. At runtime only the tiles that are visible from the camera are
+ * read from disk, at the level that matches their size on screen, and are placed into
+ * a tile atlas on the GPU. A page table texture with one texel per tile of the finest
+ * level stores which tile of the atlas and which level currently covers that part of
+ * the image, so that the fragment shader can fall back to a coarser tile until the
+ * finer one has been streamed in. The tile that covers the entire image is always kept
+ * in the atlas.
+ */
+class SphereVirtualTexture {
+public:
+    /// The number of pixels along the side of a tile, not counting the border
+    static constexpr int TileSize = 256;
+    /// The number of pixels on each side of a tile that are duplicated from the
+    /// neighboring tiles, so that the tiles can be sampled with bilinear filtering
+    static constexpr int TileBorder = 1;
+
+    /**
+     * Creates the virtual texture for the \p image. If the image has not been split into
+     * tiles before, this is done on a background thread.
+     */
+    explicit SphereVirtualTexture(std::filesystem::path image);
+    ~SphereVirtualTexture();
+
+    /**
+     * Returns `true` if the tile covering the entire image has been uploaded and the
+     * virtual texture can be rendered.
+     */
+    bool isReady() const;
+
+    /**
+     * Uploads the tiles that have been read since the last call into the tile atlas and
+     * updates the page table. Has to be called once per frame from the thread that owns
+     * the OpenGL context.
+     */
+    void update();
+
+    /**
+     * Determines which tiles are visible and which level they are needed at and starts
+     * reading those tiles that are not in the atlas yet.
+     *
+     * \param modelViewProjection The transformation from the model space of a unit
+     *        sphere into clip space
+     * \param cameraPosition The position of the camera in the model space of the unit
+     *        sphere
+     * \param resolution The resolution of the framebuffer in pixels
+     * \param isMirrored Whether the image is mirrored along the x-axis on the sphere
+     * \param cullBackfaces Whether tiles that face away from the camera are invisible
+     */
+    void requestVisibleTiles(const glm::dmat4& modelViewProjection,
+        const glm::dvec3& cameraPosition, const glm::ivec2& resolution, bool isMirrored,
+        bool cullBackfaces);
+
+    /// Binds the tile atlas to the currently active texture unit
+    void bindAtlas() const;
+
+    /// Binds the page table to the currently active texture unit
+    void bindPageTable() const;
+
+private:
+    struct Layout {
+        std::filesystem::path directory;
+        // The number of tiles on the finest level
+        glm::ivec2 nTiles = glm::ivec2(0);
+        int nLevels = 0;
+    };
+
+    struct Tile {
+        uint64_t key = 0;
+        std::vector<std::byte> pixels;
+    };
+    struct ReadTileJob;
+
+    struct ResidentTile {
+        int slot = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    static std::optional<Layout> createLayout(std::filesystem::path image,
+        std::filesystem::path cacheDirectory);
+
+    glm::ivec2 nTiles(int level) const;
+    void collectTiles(int level, int x, int y, const glm::dmat4& modelViewProjection,
+        const glm::dvec3& cameraPosition, const glm::ivec2& resolution, bool isMirrored,
+        bool cullBackfaces);
+    void requestTile(uint64_t key);
+    void uploadTile(const Tile& tile);
+    void updatePageTable();
+
+    const std::filesystem::path _image;
+    std::future<std::optional<Layout>> _layoutFuture;
+    std::optional<Layout> _layout;
+
+    // Reads the tiles from disk on a background thread
+    std::unique_ptr<ConcurrentJobManager<Tile>> _tileReader;
+
+    GLuint _atlas = 0;
+    GLuint _pageTable = 0;
+
+    std::unordered_map<uint64_t, ResidentTile> _residentTiles;
+    std::unordered_set<uint64_t> _requestedTiles;
+    std::unordered_set<uint64_t> _visibleTiles;
+    std::unordered_set<uint64_t> _failedTiles;
+    std::vector<int> _freeSlots;
+    uint64_t _frame = 0;
+    bool _pageTableIsDirty = false;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_BASE___SPHEREVIRTUALTEXTURE___H__
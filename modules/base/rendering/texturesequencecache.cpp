@@ -0,0 +1,211 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/base/rendering/texturesequencecache.h>
+
+#include <openspace/util/job.h>
+#include <ghoul/fmt.h>
+#include <ghoul/io/texture/texturereader.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <ghoul/opengl/texture.h>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+    constexpr std::string_view _loggerCat = "TextureSequenceCache";
+
+    // Only a few files are read ahead of time so that the queue doesn't fill up with
+    // files that are no longer needed when the time direction changes
+    constexpr size_t MaxLoadingFiles = 2;
+
+    bool contains(const std::vector<int>& v, int i) {
+        return std::find(v.begin(), v.end(), i) != v.end();
+    }
+} // namespace
+
+namespace openspace {
+
+// Reading a file from disk on the I/O thread
+struct TextureSequenceCache::ReadFileJob : public Job<ReadFile> {
+    ReadFileJob(int index, std::string path)
+        : filePath(std::move(path))
+    {
+        result.index = index;
+    }
+
+    void execute() override {
+        std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+        if (!file.good()) {
+            return;
+        }
+        result.buffer.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(result.buffer.data(), result.buffer.size());
+        result.success = file.good();
+    }
+
+    ReadFile product() override {
+        return std::move(result);
+    }
+
+    std::string filePath;
+    ReadFile result;
+};
+
+TextureSequenceCache::TextureSequenceCache(std::vector<std::string> files, int nPrefetch)
+    : _files(std::move(files))
+    , _nPrefetch(nPrefetch)
+    , _reader(std::make_unique<ConcurrentJobManager<ReadFile>>(ThreadPool(1)))
+{}
+
+TextureSequenceCache::~TextureSequenceCache() = default;
+
+ghoul::opengl::Texture* TextureSequenceCache::update(int active, int direction) {
+    while (_reader->numFinishedJobs() > 0) {
+        ReadFile file = _reader->popFinishedJob()->product();
+        std::erase(_loadingFiles, file.index);
+        if (file.success) {
+            _readFiles[file.index] = std::move(file);
+        }
+        else {
+            LWARNING(fmt::format("Could not read image '{}'", _files[file.index]));
+            _failedFiles.push_back(file.index);
+        }
+    }
+
+    const std::vector<int> indices = window(active, direction);
+
+    // The displayed texture is kept until the active one is available to not flicker
+    auto isNeeded = [&indices, this](int i) {
+        return i == _displayedIndex || contains(indices, i);
+    };
+    std::erase_if(_textures, [&isNeeded](const auto& p) { return !isNeeded(p.first); });
+    std::erase_if(_readFiles, [&isNeeded](const auto& p) { return !isNeeded(p.first); });
+
+    // Decoding and uploading is the expensive part on this thread, so only the first
+    // file in the order of the window is decoded in each frame
+    for (int index : indices) {
+        auto it = _readFiles.find(index);
+        if (it == _readFiles.end()) {
+            continue;
+        }
+        std::unique_ptr<ghoul::opengl::Texture> texture = decode(index, it->second);
+        _readFiles.erase(it);
+        if (texture) {
+            _textures[index] = std::move(texture);
+        }
+        else {
+            _failedFiles.push_back(index);
+        }
+        break;
+    }
+
+    for (int index : indices) {
+        if (_loadingFiles.size() >= MaxLoadingFiles) {
+            break;
+        }
+        if (_textures.contains(index) || _readFiles.contains(index) ||
+            contains(_loadingFiles, index) || contains(_failedFiles, index))
+        {
+            continue;
+        }
+        _loadingFiles.push_back(index);
+        _reader->enqueueJob(std::make_shared<ReadFileJob>(index, _files[index]));
+    }
+
+    if (_textures.contains(active)) {
+        _displayedIndex = active;
+    }
+    auto it = _textures.find(_displayedIndex);
+    return it != _textures.end() ? it->second.get() : nullptr;
+}
+
+void TextureSequenceCache::clear() {
+    _reader->clearEnqueuedJobs();
+    _textures.clear();
+    _readFiles.clear();
+    _loadingFiles.clear();
+    _failedFiles.clear();
+    _displayedIndex = -1;
+}
+
+std::vector<int> TextureSequenceCache::window(int active, int direction) const {
+    // The images we want to keep in the order in which they are needed: the active one,
+    // the upcoming ones in the direction of time, and the one that we just left so that
+    // small jumps back in time don't have to touch the disk
+    const int step = direction < 0 ? -1 : 1;
+    std::vector<int> result;
+    result.push_back(active);
+    for (int i = 1; i <= _nPrefetch; ++i) {
+        result.push_back(active + i * step);
+    }
+    result.push_back(active - step);
+    std::erase_if(
+        result,
+        [this](int i) { return i < 0 || i >= static_cast<int>(_files.size()); }
+    );
+    return result;
+}
+
+std::unique_ptr<ghoul::opengl::Texture> TextureSequenceCache::decode(int index,
+                                                                     ReadFile& file) const
+{
+    std::string format = std::filesystem::path(_files[index]).extension().string();
+    if (!format.empty()) {
+        format.erase(format.begin());
+    }
+    std::transform(
+        format.begin(),
+        format.end(),
+        format.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); }
+    );
+
+    try {
+        std::unique_ptr<ghoul::opengl::Texture> texture =
+            ghoul::io::TextureReader::ref().loadTexture(
+                reinterpret_cast<void*>(file.buffer.data()),
+                file.buffer.size(),
+                2,
+                format
+            );
+        if (!texture) {
+            return nullptr;
+        }
+        texture->setInternalFormat(GL_COMPRESSED_RGBA);
+        texture->uploadTexture();
+        texture->setFilter(ghoul::opengl::Texture::FilterMode::Linear);
+        texture->purgeFromRAM();
+        return texture;
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.message);
+        return nullptr;
+    }
+}
+
+} // namespace openspace
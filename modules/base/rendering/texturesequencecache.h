@@ -0,0 +1,97 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_BASE___TEXTURESEQUENCECACHE___H__
+#define __OPENSPACE_MODULE_BASE___TEXTURESEQUENCECACHE___H__
+
+#include <openspace/util/concurrentjobmanager.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ghoul::opengl { class Texture; }
+
+namespace openspace {
+
+/**
+ * Keeps the textures of an image sequence on the GPU only for a sliding window around
+ * the active image: the active one, a number of images ahead of it in the direction in
+ * which time is moving, and the one just before it. The image files are read on a
+ * background thread; decoding them into textures requires the OpenGL context, so this
+ * happens in #update, at most one image per frame. Textures that fall outside of the
+ * window are released.
+ */
+class TextureSequenceCache {
+public:
+    /**
+     * Creates a cache for the images in \p files, which have to be sorted in the order
+     * of the sequence. \p nPrefetch is the number of images ahead of the active one that
+     * are kept in the cache.
+     */
+    TextureSequenceCache(std::vector<std::string> files, int nPrefetch);
+    ~TextureSequenceCache();
+
+    /**
+     * Moves the window to the image with the index \p active, \p direction is negative
+     * if time is moving backwards. Returns the texture of the active image or, if it
+     * has not been loaded yet, the texture that was returned last, which might be
+     * `nullptr`. Has to be called from the thread that owns the OpenGL context.
+     */
+    ghoul::opengl::Texture* update(int active, int direction);
+
+    /// Releases all textures. Has to be called while the OpenGL context is current
+    void clear();
+
+private:
+    struct ReadFile {
+        int index = -1;
+        std::vector<char> buffer;
+        bool success = false;
+    };
+    struct ReadFileJob;
+
+    std::vector<int> window(int active, int direction) const;
+    std::unique_ptr<ghoul::opengl::Texture> decode(int index, ReadFile& file) const;
+
+    const std::vector<std::string> _files;
+    const int _nPrefetch;
+
+    // Reads the image files on a persistent I/O thread
+    std::unique_ptr<ConcurrentJobManager<ReadFile>> _reader;
+    // Files that have been read but not decoded yet, by their index
+    std::map<int, ReadFile> _readFiles;
+    // Uploaded textures around the active image, by their index
+    std::map<int, std::unique_ptr<ghoul::opengl::Texture>> _textures;
+    // Indices of the files that are being read
+    std::vector<int> _loadingFiles;
+    // Indices of the files that could not be read or decoded
+    std::vector<int> _failedFiles;
+    // The index of the texture that was returned last
+    int _displayedIndex = -1;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_BASE___TEXTURESEQUENCECACHE___H__
@@ -514,6 +514,12 @@ void FixedRotation::update(const UpdateData& data) {
     Rotation::update(data);
 }
 
+bool FixedRotation::isThreadSafe() const {
+    // The axes might depend on the world positions of arbitrary other scene graph nodes
+    // that are not necessarily declared as dependencies
+    return false;
+}
+
 glm::dmat3 FixedRotation::matrix(const UpdateData&) const {
     if (!_enabled) {
         return glm::dmat3();
@@ -49,6 +49,7 @@ public:
 
     void update(const UpdateData& data) override;
     glm::dmat3 matrix(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
 
 private:
     glm::vec3 xAxis() const;
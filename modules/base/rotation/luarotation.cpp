@@ -80,6 +80,11 @@ LuaRotation::LuaRotation(const ghoul::Dictionary& dictionary) : LuaRotation() {
     _luaScriptFile = absPath(p.script).string();
 }
 
+bool LuaRotation::isThreadSafe() const {
+    // The Lua state is not safe to be used from multiple threads concurrently
+    return false;
+}
+
 glm::dmat3 LuaRotation::matrix(const UpdateData& data) const {
     ghoul::lua::runScriptFile(_state, _luaScriptFile.value());
 
@@ -78,6 +78,16 @@ TimelineRotation::TimelineRotation(const ghoul::Dictionary& dictionary)
     addProperty(_shouldInterpolate);
 }
 
+bool TimelineRotation::isThreadSafe() const {
+    return std::all_of(
+        _timeline.keyframes().begin(),
+        _timeline.keyframes().end(),
+        [](const Keyframe<ghoul::mm_unique_ptr<Rotation>>& kf) {
+            return kf.data->isThreadSafe();
+        }
+    );
+}
+
 glm::dmat3 TimelineRotation::matrix(const UpdateData& data) const {
     const double now = data.time.j2000Seconds();
     using KeyframePointer = const Keyframe<ghoul::mm_unique_ptr<Rotation>>*;
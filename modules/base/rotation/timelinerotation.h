@@ -40,6 +40,7 @@ class TimelineRotation : public Rotation {
 public:
     TimelineRotation(const ghoul::Dictionary& dictionary);
     glm::dmat3 matrix(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
     static documentation::Documentation Documentation();
 
 private:
@@ -78,6 +78,11 @@ LuaScale::LuaScale(const ghoul::Dictionary& dictionary) : LuaScale() {
     _luaScriptFile = absPath(p.script).string();
 }
 
+bool LuaScale::isThreadSafe() const {
+    // The Lua state is not safe to be used from multiple threads concurrently
+    return false;
+}
+
 glm::dvec3 LuaScale::scaleValue(const UpdateData& data) const {
     ghoul::lua::runScriptFile(_state, _luaScriptFile.value());
 
@@ -0,0 +1,73 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "fragment.glsl"
+
+in vec4 vs_position;
+in vec2 vs_textureCoords;
+in vec3 vs_normal;
+in float vs_screenSpaceDepth;
+
+// The atlas that contains the tiles that are currently streamed in
+uniform sampler2D colorTexture;
+// One entry per tile of the finest level with the atlas slot and level of the tile that
+// covers it
+uniform usampler2D pageTable;
+uniform int tileSize;
+uniform int tileBorder;
+uniform float opacity;
+uniform bool mirrorTexture;
+
+
+Fragment getFragment() {
+  vec2 texCoord = vs_textureCoords;
+
+  Fragment frag;
+  if (mirrorTexture) {
+    texCoord.x = 1.0 - texCoord.x;
+  }
+
+  ivec2 pageTableSize = textureSize(pageTable, 0);
+  ivec2 page = clamp(ivec2(texCoord * vec2(pageTableSize)), ivec2(0), pageTableSize - 1);
+  uvec4 entry = texelFetch(pageTable, page, 0);
+  int level = int(entry.z);
+
+  // Position inside the tile on the level that is available
+  vec2 nTiles = vec2(max(pageTableSize >> level, ivec2(1)));
+  vec2 tile = min(floor(texCoord * nTiles), nTiles - 1.0);
+  vec2 tileCoord = clamp(texCoord * nTiles - tile, 0.0, 1.0);
+
+  float slotSize = float(tileSize + 2 * tileBorder);
+  vec2 atlasCoord = vec2(entry.xy) * slotSize + float(tileBorder) +
+    tileCoord * float(tileSize);
+  frag.color = texture(colorTexture, atlasCoord / vec2(textureSize(colorTexture, 0)));
+  frag.color.a *= opacity;
+  frag.depth = vs_screenSpaceDepth;
+
+  // G-Buffer
+  frag.gPosition = vs_position;
+  frag.gNormal = vec4(vs_normal, 1.0);
+
+  return frag;
+}
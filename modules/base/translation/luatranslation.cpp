@@ -82,6 +82,11 @@ LuaTranslation::LuaTranslation(const ghoul::Dictionary& dictionary) : LuaTransla
     _luaScriptFile = absPath(p.script).string();
 }
 
+bool LuaTranslation::isThreadSafe() const {
+    // The Lua state is not safe to be used from multiple threads concurrently
+    return false;
+}
+
 glm::dvec3 LuaTranslation::position(const UpdateData& data) const {
     ghoul::lua::runScriptFile(_state, _luaScriptFile.value());
 
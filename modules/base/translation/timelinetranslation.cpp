@@ -76,6 +76,16 @@ TimelineTranslation::TimelineTranslation(const ghoul::Dictionary& dictionary)
     addProperty(_shouldInterpolate);
 }
 
+bool TimelineTranslation::isThreadSafe() const {
+    return std::all_of(
+        _timeline.keyframes().begin(),
+        _timeline.keyframes().end(),
+        [](const Keyframe<ghoul::mm_unique_ptr<Translation>>& kf) {
+            return kf.data->isThreadSafe();
+        }
+    );
+}
+
 glm::dvec3 TimelineTranslation::position(const UpdateData& data) const {
     const double now = data.time.j2000Seconds();
     using KeyframePointer = const Keyframe<ghoul::mm_unique_ptr<Translation>>*;
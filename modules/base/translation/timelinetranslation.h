@@ -42,6 +42,7 @@ public:
     TimelineTranslation(const ghoul::Dictionary& dictionary);
 
     glm::dvec3 position(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
     static documentation::Documentation Documentation();
 
 private:
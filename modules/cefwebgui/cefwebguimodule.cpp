@@ -121,6 +121,7 @@ void CefWebGuiModule::startOrStopGui() {
         if (_visible) {
             webBrowserModule->attachEventHandler(_instance.get());
         }
+        _instance->setHidden(!_visible);
 
         _instance->setZoom(_guiScale);
 
@@ -179,6 +180,10 @@ void CefWebGuiModule::internalInitialize(const ghoul::Dictionary& configuration)
     _visible.onChange([this, webBrowserModule]() {
         ZoneScopedN("CefWebGuiModule::visible");
 
+        if (_instance) {
+            _instance->setHidden(!_visible);
+        }
+
         if (_visible && _instance) {
             webBrowserModule->attachEventHandler(_instance.get());
         }
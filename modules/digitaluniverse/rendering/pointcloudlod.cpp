@@ -0,0 +1,338 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/digitaluniverse/rendering/pointcloudlod.h>
+
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+namespace {
+    constexpr std::string_view _loggerCat = "PointCloudLod";
+
+    constexpr uint32_t CacheFileMagic = 0x444F4C50; // 'PLOD'
+    constexpr uint32_t CacheFileVersion = 1;
+
+    // Nodes with fewer points than this are not subdivided any further
+    constexpr uint32_t MaxPointsPerLeaf = 256;
+
+    // The number of points which represent a node when it is too small on screen
+    constexpr uint32_t RepresentativesPerNode = 64;
+
+    // Limits the depth for datasets in which many points share the same position
+    constexpr int MaxDepth = 21;
+
+    struct CacheHeader {
+        uint32_t magic = CacheFileMagic;
+        uint32_t version = CacheFileVersion;
+        uint64_t nPoints = 0;
+        uint64_t nNodes = 0;
+        uint64_t nIndices = 0;
+    };
+} // namespace
+
+namespace openspace {
+
+void PointCloudLod::build(std::span<const glm::vec3> positions,
+                          const std::filesystem::path& speckFile)
+{
+    ZoneScoped;
+
+    _nodes.clear();
+    _indices.clear();
+    if (positions.empty()) {
+        return;
+    }
+
+    std::filesystem::path cached = FileSys.cacheManager()->cachedFilename(
+        speckFile,
+        "PointCloudLod"
+    );
+    if (std::filesystem::exists(cached)) {
+        LINFO(fmt::format("Cached file {} used for file {}", cached, speckFile));
+        if (loadCachedFile(cached, positions.size())) {
+            return;
+        }
+        FileSys.cacheManager()->removeCacheFile(cached);
+    }
+
+    LINFO(fmt::format("Building level of detail structure for file {}", speckFile));
+    _indices.resize(positions.size());
+    std::iota(_indices.begin(), _indices.end(), 0);
+
+    std::vector<uint32_t> representatives;
+    buildNode(positions, 0, static_cast<uint32_t>(positions.size()), 0, representatives);
+
+    // The representative points are stored behind the points in octree order
+    _indices.insert(_indices.end(), representatives.begin(), representatives.end());
+
+    saveCachedFile(cached);
+}
+
+int32_t PointCloudLod::buildNode(std::span<const glm::vec3> positions, uint32_t first,
+                                 uint32_t count, int depth,
+                                 std::vector<uint32_t>& representatives)
+{
+    const auto begin = _indices.begin() + first;
+    const auto end = begin + count;
+
+    glm::vec3 minPosition = glm::vec3(std::numeric_limits<float>::max());
+    glm::vec3 maxPosition = glm::vec3(-std::numeric_limits<float>::max());
+    for (auto it = begin; it != end; ++it) {
+        minPosition = glm::min(minPosition, positions[*it]);
+        maxPosition = glm::max(maxPosition, positions[*it]);
+    }
+
+    Node node;
+    node.center = (minPosition + maxPosition) * 0.5f;
+    node.radius = glm::length(maxPosition - minPosition) * 0.5f;
+    node.first = first;
+    node.count = count;
+
+    const int32_t nodeIndex = static_cast<int32_t>(_nodes.size());
+    _nodes.push_back(node);
+
+    const bool isLeaf =
+        count <= MaxPointsPerLeaf || depth >= MaxDepth || node.radius == 0.f;
+    if (!isLeaf) {
+        // Split the range into the eight octants around the center, first along z, then
+        // along y, and finally along x
+        const glm::vec3 c = node.center;
+        std::array<std::vector<uint32_t>::iterator, 9> splits;
+        splits[0] = begin;
+        splits[8] = end;
+        splits[4] = std::partition(
+            begin, end,
+            [&](uint32_t i) { return positions[i].z < c.z; }
+        );
+        for (int i = 0; i < 8; i += 4) {
+            splits[i + 2] = std::partition(
+                splits[i], splits[i + 4],
+                [&](uint32_t j) { return positions[j].y < c.y; }
+            );
+        }
+        for (int i = 0; i < 8; i += 2) {
+            splits[i + 1] = std::partition(
+                splits[i], splits[i + 2],
+                [&](uint32_t j) { return positions[j].x < c.x; }
+            );
+        }
+
+        for (int i = 0; i < 8; ++i) {
+            const uint32_t childFirst =
+                static_cast<uint32_t>(std::distance(_indices.begin(), splits[i]));
+            const uint32_t childCount =
+                static_cast<uint32_t>(std::distance(splits[i], splits[i + 1]));
+            if (childCount > 0) {
+                const int32_t child = buildNode(
+                    positions,
+                    childFirst,
+                    childCount,
+                    depth + 1,
+                    representatives
+                );
+                _nodes[nodeIndex].children[i] = child;
+            }
+        }
+    }
+
+    // Pick the representative points evenly spread over the range. As the range is in
+    // octree order, they are also spread over the volume of the node. Small nodes are
+    // represented by all of their points
+    Node& n = _nodes[nodeIndex];
+    if (count <= RepresentativesPerNode) {
+        n.representativeFirst = first;
+        n.representativeCount = count;
+    }
+    else {
+        n.representativeFirst =
+            static_cast<uint32_t>(positions.size() + representatives.size());
+        n.representativeCount = RepresentativesPerNode;
+        for (uint32_t i = 0; i < RepresentativesPerNode; ++i) {
+            const uint64_t offset = static_cast<uint64_t>(i) * count /
+                RepresentativesPerNode;
+            representatives.push_back(_indices[first + offset]);
+        }
+    }
+    return nodeIndex;
+}
+
+bool PointCloudLod::loadCachedFile(const std::filesystem::path& path, size_t nPoints) {
+    std::ifstream file(path, std::ifstream::binary);
+    if (!file.good()) {
+        return false;
+    }
+
+    CacheHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(CacheHeader));
+    if (!file.good() || header.magic != CacheFileMagic ||
+        header.version != CacheFileVersion || header.nPoints != nPoints ||
+        header.nNodes == 0 || header.nIndices < nPoints)
+    {
+        return false;
+    }
+
+    _nodes.resize(header.nNodes);
+    file.read(reinterpret_cast<char*>(_nodes.data()), header.nNodes * sizeof(Node));
+    _indices.resize(header.nIndices);
+    file.read(
+        reinterpret_cast<char*>(_indices.data()),
+        header.nIndices * sizeof(uint32_t)
+    );
+    if (!file.good()) {
+        _nodes.clear();
+        _indices.clear();
+        return false;
+    }
+    return true;
+}
+
+void PointCloudLod::saveCachedFile(const std::filesystem::path& path) const {
+    std::ofstream file(path, std::ofstream::binary);
+    if (!file.good()) {
+        LWARNING(fmt::format("Could not write cache file {}", path));
+        return;
+    }
+
+    CacheHeader header;
+    // The root node covers all points
+    header.nPoints = _nodes.front().count;
+    header.nNodes = _nodes.size();
+    header.nIndices = _indices.size();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+    file.write(
+        reinterpret_cast<const char*>(_nodes.data()),
+        _nodes.size() * sizeof(Node)
+    );
+    file.write(
+        reinterpret_cast<const char*>(_indices.data()),
+        _indices.size() * sizeof(uint32_t)
+    );
+}
+
+void PointCloudLod::initializeGL() {
+    if (_indices.empty()) {
+        return;
+    }
+
+    if (_indexBuffer == 0) {
+        glGenBuffers(1, &_indexBuffer);
+    }
+    // Uploading through the array buffer target doesn't change the element buffer
+    // binding of whichever vertex array is currently bound
+    glBindBuffer(GL_ARRAY_BUFFER, _indexBuffer);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        _indices.size() * sizeof(uint32_t),
+        _indices.data(),
+        GL_STATIC_DRAW
+    );
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void PointCloudLod::deinitializeGL() {
+    glDeleteBuffers(1, &_indexBuffer);
+    _indexBuffer = 0;
+}
+
+bool PointCloudLod::isReady() const {
+    return _indexBuffer != 0 && !_nodes.empty();
+}
+
+void PointCloudLod::render(const glm::dvec3& cameraPosition, double pixelsPerUnitAngle,
+                           float pixelThreshold)
+{
+    ZoneScoped;
+
+    if (!isReady()) {
+        return;
+    }
+
+    _counts.clear();
+    _offsets.clear();
+    uint32_t lastEnd = 0;
+    auto addRange = [this, &lastEnd](uint32_t first, uint32_t count) {
+        if (!_counts.empty() && lastEnd == first) {
+            // Neighboring ranges are merged into a single draw
+            _counts.back() += static_cast<GLsizei>(count);
+        }
+        else {
+            _counts.push_back(static_cast<GLsizei>(count));
+            _offsets.push_back(
+                reinterpret_cast<const void*>(first * sizeof(uint32_t))
+            );
+        }
+        lastEnd = first + count;
+    };
+
+    std::vector<int32_t> stack = { 0 };
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+
+        const double distance = glm::distance(glm::dvec3(node.center), cameraPosition);
+        if (distance > node.radius) {
+            // The angular radius is approximated by its tangent
+            const double pixels = node.radius / distance * pixelsPerUnitAngle;
+            if (pixels < pixelThreshold) {
+                addRange(node.representativeFirst, node.representativeCount);
+                continue;
+            }
+        }
+
+        const bool isLeaf = std::all_of(
+            node.children.begin(), node.children.end(),
+            [](int32_t child) { return child == -1; }
+        );
+        if (isLeaf) {
+            addRange(node.first, node.count);
+            continue;
+        }
+
+        // Push the children in reverse so that they are traversed in octree order, which
+        // keeps neighboring ranges next to each other
+        for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+            if (*it != -1) {
+                stack.push_back(*it);
+            }
+        }
+    }
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _indexBuffer);
+    glMultiDrawElements(
+        GL_POINTS,
+        _counts.data(),
+        GL_UNSIGNED_INT,
+        _offsets.data(),
+        static_cast<GLsizei>(_counts.size())
+    );
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+} // namespace openspace
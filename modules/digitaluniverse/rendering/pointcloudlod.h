@@ -0,0 +1,109 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_DIGITALUNIVERSE___POINTCLOUDLOD___H__
+#define __OPENSPACE_MODULE_DIGITALUNIVERSE___POINTCLOUDLOD___H__
+
+#include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * A spatial level-of-detail structure for point clouds in which every point is drawn as
+ * a single vertex. The points are partitioned into an octree whose nodes cover a
+ * contiguous range of an index buffer. In addition, every inner node stores a small set
+ * of representative points that are drawn instead of its subtree when the node covers
+ * only a few pixels on screen, so that the number of drawn vertices depends on the
+ * screen coverage of the point cloud rather than on the number of points.
+ */
+class PointCloudLod {
+public:
+    /**
+     * Builds the structure for the \p positions or loads it from the cache if the
+     * structure has already been built for the \p speckFile before. The positions are
+     * the untransformed positions of the dataset in the order in which they are stored
+     * in the vertex buffer.
+     */
+    void build(std::span<const glm::vec3> positions,
+        const std::filesystem::path& speckFile);
+
+    /**
+     * Uploads the index buffer. Has to be called after #build and with an OpenGL
+     * context.
+     */
+    void initializeGL();
+    void deinitializeGL();
+
+    bool isReady() const;
+
+    /**
+     * Draws the points of the currently bound vertex array that are selected for the
+     * \p cameraPosition, which has to be in the same coordinate system as the positions
+     * that were passed to #build. A node is replaced by its representative points if its
+     * bounding sphere covers fewer than \p pixelThreshold pixels, where
+     * \p pixelsPerUnitAngle is the number of pixels covered by an object with an angular
+     * size of one radian.
+     */
+    void render(const glm::dvec3& cameraPosition, double pixelsPerUnitAngle,
+        float pixelThreshold);
+
+private:
+    struct Node {
+        glm::vec3 center = glm::vec3(0.f);
+        float radius = 0.f;
+        // The range of the points of the entire subtree in the index buffer
+        uint32_t first = 0;
+        uint32_t count = 0;
+        // The range of the representative points in the index buffer
+        uint32_t representativeFirst = 0;
+        uint32_t representativeCount = 0;
+        // The indices of the children into the list of nodes or -1 if there is none
+        std::array<int32_t, 8> children = { -1, -1, -1, -1, -1, -1, -1, -1 };
+    };
+
+    int32_t buildNode(std::span<const glm::vec3> positions, uint32_t first,
+        uint32_t count, int depth, std::vector<uint32_t>& representatives);
+    bool loadCachedFile(const std::filesystem::path& path, size_t nPoints);
+    void saveCachedFile(const std::filesystem::path& path) const;
+
+    std::vector<Node> _nodes;
+    // All points in octree order, followed by the representative points of all nodes
+    std::vector<uint32_t> _indices;
+
+    GLuint _indexBuffer = 0;
+
+    // Reused between frames to avoid reallocations
+    std::vector<GLsizei> _counts;
+    std::vector<const void*> _offsets;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_DIGITALUNIVERSE___POINTCLOUDLOD___H__
@@ -29,6 +29,7 @@
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
 #include <openspace/engine/windowdelegate.h>
+#include <openspace/util/memorymanager.h>
 #include <openspace/util/updatestructures.h>
 #include <openspace/rendering/renderengine.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -44,11 +45,15 @@
 #include <ghoul/opengl/textureunit.h>
 #include <glm/gtx/string_cast.hpp>
 #include <array>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <locale>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <string>
 
 namespace {
@@ -218,6 +223,108 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo SortByDepthInfo = {
+        "SortByDepth",
+        "Sort by Depth",
+        "If this value is set to 'true', the points are drawn back-to-front with normal "
+        "alpha blending instead of additive blending. The points are sorted by their "
+        "distance to the camera in the background, so the order might lag behind the "
+        "camera by a few frames",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo EnableLevelOfDetailInfo = {
+        "EnableLevelOfDetail",
+        "Enable Level of Detail",
+        "If this value is set to 'true', regions of the point cloud that only cover a "
+        "few pixels on screen are drawn using a small set of representative points "
+        "instead of all of their points. The level of detail structure is built the "
+        "first time this is enabled and cached for later runs. This has no effect "
+        "while the points are sorted by depth",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo LevelOfDetailThresholdInfo = {
+        "LevelOfDetailThreshold",
+        "Level of Detail Threshold",
+        "The radius in pixels below which a region of the point cloud is drawn using its "
+        "representative points",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    // Returns the indices of the points sorted by descending distance to the camera. The
+    // sort is a least-significant-digit radix sort on the bit pattern of the squared
+    // distances, which is stable and linear in the number of points
+    std::vector<GLuint> sortedIndices(const std::vector<glm::vec3>& positions,
+                                      glm::vec3 cameraPosition)
+    {
+        ZoneScoped;
+
+        const size_t nPoints = positions.size();
+        std::vector<uint32_t> keys(nPoints);
+        std::vector<GLuint> indices(nPoints);
+        for (size_t i = 0; i < nPoints; ++i) {
+            const glm::vec3 d = positions[i] - cameraPosition;
+            const float distanceSquared = glm::dot(d, d);
+            // The bit pattern of non-negative floats sorts in the same order as their
+            // values, inverting it yields a descending order
+            uint32_t bits = 0;
+            std::memcpy(&bits, &distanceSquared, sizeof(uint32_t));
+            keys[i] = ~bits;
+            indices[i] = static_cast<GLuint>(i);
+        }
+
+        std::vector<uint32_t> tmpKeys(nPoints);
+        std::vector<GLuint> tmpIndices(nPoints);
+        for (int shift = 0; shift < 32; shift += 8) {
+            std::array<size_t, 257> offsets = {};
+            for (uint32_t key : keys) {
+                offsets[((key >> shift) & 0xFF) + 1]++;
+            }
+            for (size_t i = 1; i < offsets.size(); ++i) {
+                offsets[i] += offsets[i - 1];
+            }
+            for (size_t i = 0; i < nPoints; ++i) {
+                const size_t dst = offsets[(keys[i] >> shift) & 0xFF]++;
+                tmpKeys[dst] = keys[i];
+                tmpIndices[dst] = indices[i];
+            }
+            std::swap(keys, tmpKeys);
+            std::swap(indices, tmpIndices);
+        }
+        return indices;
+    }
+
+    // Uploads the values of one vertex attribute into its own buffer and points the
+    // attribute to it. If there are no values, the attribute is disabled instead so that
+    // the shader receives the default value
+    void uploadAttribute(GLuint& vbo, std::span<const float> values, GLint attribute,
+                         GLint nComponents)
+    {
+        if (attribute == -1) {
+            return;
+        }
+
+        if (values.empty()) {
+            glDisableVertexAttribArray(attribute);
+            return;
+        }
+
+        if (vbo == 0) {
+            glGenBuffers(1, &vbo);
+            LDEBUG(fmt::format("Generating Vertex Buffer Object id '{}'", vbo));
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            values.size() * sizeof(float),
+            values.data(),
+            GL_STATIC_DRAW
+        );
+        glEnableVertexAttribArray(attribute);
+        glVertexAttribPointer(attribute, nComponents, GL_FLOAT, GL_FALSE, 0, nullptr);
+    }
+
     struct [[codegen::Dictionary(RenderableBillboardsCloud)]] Parameters {
         // The path to the SPECK file that contains information about the astronomical
         // object being rendered
@@ -305,6 +412,15 @@ namespace {
 
         // [[codegen::verbatim(UseLinearFiltering.description)]]
         std::optional<bool> useLinearFiltering;
+
+        // [[codegen::verbatim(SortByDepthInfo.description)]]
+        std::optional<bool> sortByDepth;
+
+        // [[codegen::verbatim(EnableLevelOfDetailInfo.description)]]
+        std::optional<bool> enableLevelOfDetail;
+
+        // [[codegen::verbatim(LevelOfDetailThresholdInfo.description)]]
+        std::optional<float> levelOfDetailThreshold;
     };
 #include "renderablebillboardscloud_codegen.cpp"
 }  // namespace
@@ -347,6 +463,9 @@ RenderableBillboardsCloud::RenderableBillboardsCloud(const ghoul::Dictionary& di
     , _useLinearFiltering(UseLinearFiltering, false)
     , _setRangeFromData(SetRangeFromData)
     , _renderOption(RenderOptionInfo, properties::OptionProperty::DisplayType::Dropdown)
+    , _sortByDepth(SortByDepthInfo, false)
+    , _enableLevelOfDetail(EnableLevelOfDetailInfo, false)
+    , _levelOfDetailThreshold(LevelOfDetailThresholdInfo, 2.f, 0.1f, 50.f)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -403,7 +522,7 @@ RenderableBillboardsCloud::RenderableBillboardsCloud(const ghoul::Dictionary& di
             }
         }
         _colorOption.onChange([this]() {
-            _dataIsDirty = true;
+            _colorDataIsDirty = true;
             const glm::vec2 colorRange = _colorRangeData[_colorOption.value()];
             _optionColorRangeData = colorRange;
             _colorOptionString = _optionConversionMap[_colorOption.value()];
@@ -417,7 +536,7 @@ RenderableBillboardsCloud::RenderableBillboardsCloud(const ghoul::Dictionary& di
         _optionColorRangeData.onChange([this]() {
             const glm::vec2 colorRange = _optionColorRangeData;
             _colorRangeData[_colorOption.value()] = colorRange;
-            _dataIsDirty = true;
+            _colorDataIsDirty = true;
         });
         addProperty(_optionColorRangeData);
 
@@ -442,7 +561,7 @@ RenderableBillboardsCloud::RenderableBillboardsCloud(const ghoul::Dictionary& di
         }
 
         _datavarSizeOption.onChange([this]() {
-            _dataIsDirty = true;
+            _sizeDataIsDirty = true;
             _datavarSizeOptionString = _optionConversionSizeMap[_datavarSizeOption];
         });
         addProperty(_datavarSizeOption);
@@ -494,8 +613,7 @@ RenderableBillboardsCloud::RenderableBillboardsCloud(const ghoul::Dictionary& di
 
         float minValue = std::numeric_limits<float>::max();
         float maxValue = -std::numeric_limits<float>::max();
-        for (const speck::Dataset::Entry& e : _dataset.entries) {
-            float color = e.data[colorMapInUse];
+        for (float color : _dataset.variable(colorMapInUse)) {
             minValue = std::min(minValue, color);
             maxValue = std::max(maxValue, color);
         }
@@ -504,16 +622,27 @@ RenderableBillboardsCloud::RenderableBillboardsCloud(const ghoul::Dictionary& di
     });
     addProperty(_setRangeFromData);
 
-    _useColorMap.onChange([this]() { _dataIsDirty = true; });
+    _useColorMap.onChange([this]() { _colorDataIsDirty = true; });
     addProperty(_useColorMap);
 
     _useLinearFiltering = p.useLinearFiltering.value_or(_useLinearFiltering);
-    _useLinearFiltering.onChange([this]() { _dataIsDirty = true; });
+    _useLinearFiltering.onChange([this]() { _colorDataIsDirty = true; });
     addProperty(_useLinearFiltering);
+
+    _sortByDepth = p.sortByDepth.value_or(_sortByDepth);
+    _sortByDepth.onChange([this]() { _sortedCameraPosition = std::nullopt; });
+    addProperty(_sortByDepth);
+
+    _enableLevelOfDetail = p.enableLevelOfDetail.value_or(_enableLevelOfDetail);
+    addProperty(_enableLevelOfDetail);
+
+    _levelOfDetailThreshold =
+        p.levelOfDetailThreshold.value_or(_levelOfDetailThreshold);
+    addProperty(_levelOfDetailThreshold);
 }
 
 bool RenderableBillboardsCloud::isReady() const {
-    bool isReady = _program && !_dataset.entries.empty();
+    bool isReady = _program && !_dataset.empty();
 
     // If we have labels, they also need to be loaded
     if (_hasLabels) {
@@ -582,8 +711,20 @@ void RenderableBillboardsCloud::initializeGL() {
 }
 
 void RenderableBillboardsCloud::deinitializeGL() {
+    if (_sortedIndices.valid()) {
+        _sortedIndices.wait();
+    }
+    glDeleteBuffers(1, &_sortedIndexBuffer);
+    _sortedIndexBuffer = 0;
+    _hasSortedIndices = false;
+    _lod.deinitializeGL();
+
     glDeleteBuffers(1, &_vbo);
     _vbo = 0;
+    glDeleteBuffers(1, &_colorVbo);
+    _colorVbo = 0;
+    glDeleteBuffers(1, &_sizeVbo);
+    _sizeVbo = 0;
     glDeleteVertexArrays(1, &_vao);
     _vao = 0;
 
@@ -618,7 +759,13 @@ void RenderableBillboardsCloud::renderBillboards(const RenderData& data,
     glDepthMask(false);
 
     glEnablei(GL_BLEND, 0);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    if (_sortByDepth) {
+        updateDepthSorting(data, modelMatrix);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    }
 
     _program->activate();
 
@@ -677,7 +824,34 @@ void RenderableBillboardsCloud::renderBillboards(const RenderData& data,
     _program->setUniform(_uniformCache.useColormap, _useColorMap);
 
     glBindVertexArray(_vao);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_dataset.entries.size()));
+    if (_sortByDepth && _hasSortedIndices) {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _sortedIndexBuffer);
+        glDrawElements(
+            GL_POINTS,
+            static_cast<GLsizei>(_dataset.size()),
+            GL_UNSIGNED_INT,
+            nullptr
+        );
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+    else if (_enableLevelOfDetail && _lod.isReady()) {
+        // The camera position in the coordinate system and unit of the dataset
+        const glm::dvec3 cameraPosition = glm::dvec3(
+            glm::inverse(_transformationMatrix) * glm::dvec4(
+                glm::dvec3(
+                    glm::inverse(modelMatrix) *
+                    glm::dvec4(data.camera.positionVec3(), 1.0)
+                ) / toMeter(_unit),
+                1.0
+            )
+        );
+        const double pixelsPerUnitAngle =
+            data.camera.projectionMatrix()[1][1] * viewport[3] / 2.0;
+        _lod.render(cameraPosition, pixelsPerUnitAngle, _levelOfDetailThreshold);
+    }
+    else {
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_dataset.size()));
+    }
     glBindVertexArray(0);
     _program->deactivate();
 
@@ -685,6 +859,62 @@ void RenderableBillboardsCloud::renderBillboards(const RenderData& data,
     global::renderEngine->openglStateCache().resetDepthState();
 }
 
+void RenderableBillboardsCloud::updateDepthSorting(const RenderData& data,
+                                                   const glm::dmat4& modelMatrix)
+{
+    ZoneScoped;
+
+    if (_sortedIndices.valid() &&
+        _sortedIndices.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        std::vector<GLuint> indices = _sortedIndices.get();
+        if (_sortedIndexBuffer == 0) {
+            glGenBuffers(1, &_sortedIndexBuffer);
+        }
+        // Uploading through the array buffer target doesn't change the element buffer
+        // binding of whichever vertex array is currently bound
+        glBindBuffer(GL_ARRAY_BUFFER, _sortedIndexBuffer);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            indices.size() * sizeof(GLuint),
+            indices.data(),
+            GL_STREAM_DRAW
+        );
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        _hasSortedIndices = true;
+    }
+
+    if (_sortedIndices.valid()) {
+        // The previous sort is still running
+        return;
+    }
+
+    if (_sortPositions.empty()) {
+        _sortPositions.reserve(_dataset.size());
+        for (size_t i = 0; i < _dataset.size(); ++i) {
+            _sortPositions.push_back(glm::vec3(
+                _transformationMatrix * glm::dvec4(_dataset.positions[i], 1.0)
+            ));
+        }
+    }
+
+    // The camera position in the coordinate system and unit of the dataset
+    const glm::dvec3 cameraPosition = glm::dvec3(
+        glm::inverse(modelMatrix) * glm::dvec4(data.camera.positionVec3(), 1.0)
+    ) / toMeter(_unit);
+    if (_sortedCameraPosition.has_value() && *_sortedCameraPosition == cameraPosition) {
+        return;
+    }
+    _sortedCameraPosition = cameraPosition;
+
+    _sortedIndices = std::async(
+        std::launch::async,
+        sortedIndices,
+        std::cref(_sortPositions),
+        glm::vec3(cameraPosition)
+    );
+}
+
 void RenderableBillboardsCloud::render(const RenderData& data, RendererTasks&) {
     float fadeInVar = 1.f;
     if (!_disableFadeInDistance) {
@@ -739,121 +969,48 @@ void RenderableBillboardsCloud::render(const RenderData& data, RendererTasks&) {
 void RenderableBillboardsCloud::update(const UpdateData&) {
     ZoneScoped;
 
-    if (_dataIsDirty && _hasSpeckFile) {
+    const bool isDirty = _dataIsDirty || _colorDataIsDirty || _sizeDataIsDirty;
+    if (isDirty && _hasSpeckFile) {
         ZoneScopedN("Data dirty");
         TracyGpuZone("Data dirty");
         LDEBUG("Regenerating data");
 
-        std::vector<float> slice = createDataSlice();
-
-        int size = static_cast<int>(slice.size());
-
         if (_vao == 0) {
             glGenVertexArrays(1, &_vao);
             LDEBUG(fmt::format("Generating Vertex Array id '{}'", _vao));
         }
-        if (_vbo == 0) {
-            glGenBuffers(1, &_vbo);
-            LDEBUG(fmt::format("Generating Vertex Buffer Object id '{}'", _vbo));
-        }
-
         glBindVertexArray(_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-        glBufferData(GL_ARRAY_BUFFER, size * sizeof(float), slice.data(), GL_STATIC_DRAW);
-        GLint positionAttrib = _program->attributeLocation("in_position");
-
-        if (_hasColorMapFile && _hasDatavarSize) {
-            glEnableVertexAttribArray(positionAttrib);
-            glVertexAttribPointer(
-                positionAttrib,
-                4,
-                GL_FLOAT,
-                GL_FALSE,
-                9 * sizeof(float),
-                nullptr
-            );
-
-            GLint colorMapAttrib = _program->attributeLocation("in_colormap");
-            glEnableVertexAttribArray(colorMapAttrib);
-            glVertexAttribPointer(
-                colorMapAttrib,
-                4,
-                GL_FLOAT,
-                GL_FALSE,
-                9 * sizeof(float),
-                reinterpret_cast<void*>(4 * sizeof(float))
-            );
 
-            GLint dvarScalingAttrib = _program->attributeLocation("in_dvarScaling");
-            glEnableVertexAttribArray(dvarScalingAttrib);
-            glVertexAttribPointer(
-                dvarScalingAttrib,
-                1,
-                GL_FLOAT,
-                GL_FALSE,
-                9 * sizeof(float),
-                reinterpret_cast<void*>(8 * sizeof(float))
-            );
+        if (_dataIsDirty) {
+            std::pmr::vector<float> slice = createPositionSlice();
+            uploadAttribute(_vbo, slice, _program->attributeLocation("in_position"), 4);
+            _dataIsDirty = false;
         }
-        else if (_hasColorMapFile) {
-            glEnableVertexAttribArray(positionAttrib);
-            glVertexAttribPointer(
-                positionAttrib,
-                4,
-                GL_FLOAT,
-                GL_FALSE,
-                8 * sizeof(float),
-                nullptr
-            );
 
-            GLint colorMapAttrib = _program->attributeLocation("in_colormap");
-            glEnableVertexAttribArray(colorMapAttrib);
-            glVertexAttribPointer(
-                colorMapAttrib,
-                4,
-                GL_FLOAT,
-                GL_FALSE,
-                8 * sizeof(float),
-                reinterpret_cast<void*>(4 * sizeof(float))
+        if (_colorDataIsDirty) {
+            std::pmr::vector<float> slice = createColorSlice();
+            uploadAttribute(
+                _colorVbo,
+                slice,
+                _program->attributeLocation("in_colormap"),
+                4
             );
+            _colorDataIsDirty = false;
         }
-        else if (_hasDatavarSize) {
-            glEnableVertexAttribArray(positionAttrib);
-            glVertexAttribPointer(
-                positionAttrib,
-                4,
-                GL_FLOAT,
-                GL_FALSE,
-                8 * sizeof(float),
-                nullptr
-            );
 
-            GLint dvarScalingAttrib = _program->attributeLocation("in_dvarScaling");
-            glEnableVertexAttribArray(dvarScalingAttrib);
-            glVertexAttribPointer(
-                dvarScalingAttrib,
-                1,
-                GL_FLOAT,
-                GL_FALSE,
-                5 * sizeof(float),
-                reinterpret_cast<void*>(4 * sizeof(float))
-            );
-        }
-        else {
-            glEnableVertexAttribArray(positionAttrib);
-            glVertexAttribPointer(
-                positionAttrib,
-                4,
-                GL_FLOAT,
-                GL_FALSE,
-                0,
-                nullptr
+        if (_sizeDataIsDirty) {
+            std::pmr::vector<float> slice = createSizeSlice();
+            uploadAttribute(
+                _sizeVbo,
+                slice,
+                _program->attributeLocation("in_dvarScaling"),
+                1
             );
+            _sizeDataIsDirty = false;
         }
 
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
         glBindVertexArray(0);
-
-        _dataIsDirty = false;
     }
 
     if (_hasSpriteTexture && _spriteTextureIsDirty && !_spriteTexturePath.value().empty())
@@ -884,173 +1041,191 @@ void RenderableBillboardsCloud::update(const UpdateData&) {
     }
 }
 
-std::vector<float> RenderableBillboardsCloud::createDataSlice() {
-    ZoneScoped;
-
-    if (_dataset.entries.empty()) {
-        return std::vector<float>();
-    }
-
-    std::vector<float> result;
-    if (_hasColorMapFile) {
-        result.reserve(8 * _dataset.entries.size());
-    }
-    else {
-        result.reserve(4 * _dataset.entries.size());
+Renderable::MemoryUsage RenderableBillboardsCloud::memoryUsage() const {
+    MemoryUsage usage;
+    usage.gpuBuffers = bufferMemory(_vbo) + bufferMemory(_colorVbo) +
+        bufferMemory(_sizeVbo) + bufferMemory(_polygonVbo) +
+        bufferMemory(_sortedIndexBuffer);
+    // The sprite texture is shared with other renderables through the texture manager,
+    // so only the polygon texture is owned by this renderable
+    if (_pTexture != 0) {
+        usage.gpuTextures = 256 * 256 * 4;
     }
+    usage.cpuData = _dataset.memoryUsage() + _sortPositions.size() * sizeof(glm::vec3);
+    return usage;
+}
 
-    // what datavar in use for the index color
-    int colorMapInUse =
-        _hasColorMapFile ? _dataset.index(_colorOptionString) : 0;
-
-    // what datavar in use for the size scaling (if present)
-    int sizeScalingInUse =
-        _hasDatavarSize ? _dataset.index(_datavarSizeOptionString) : -1;
+std::pmr::vector<float> RenderableBillboardsCloud::createPositionSlice() {
+    ZoneScoped;
 
-    float minColorIdx = std::numeric_limits<float>::max();
-    float maxColorIdx = -std::numeric_limits<float>::max();
-    for (const speck::Dataset::Entry& e : _dataset.entries) {
-        if (e.data.size() > 0) {
-            float color = e.data[colorMapInUse];
-            minColorIdx = std::min(color, minColorIdx);
-            maxColorIdx = std::max(color, maxColorIdx);
-        } else {
-            minColorIdx = 0;
-            maxColorIdx = 0;
-        }
+    // The slice is only needed until it has been uploaded to the GPU
+    std::pmr::vector<float> result(&global::memoryManager->TemporaryMemory);
+    if (_dataset.empty()) {
+        return result;
+    }
+    result.reserve(4 * _dataset.size());
+
+    float unitValue = 0.f;
+    // (abock, 2022-01-02)  This is vestigial from a previous rewrite. I just want to
+    // make it work for now and we can rewrite it properly later
+    switch (_unit) {
+        case DistanceUnit::Meter:
+            unitValue = 0.f;
+            break;
+        case DistanceUnit::Kilometer:
+            unitValue = 1.f;
+            break;
+        case DistanceUnit::Parsec:
+            unitValue = 2;
+            break;
+        case DistanceUnit::Kiloparsec:
+            unitValue = 3;
+            break;
+        case DistanceUnit::Megaparsec:
+            unitValue = 4;
+            break;
+        case DistanceUnit::Gigaparsec:
+            unitValue = 5;
+            break;
+        case DistanceUnit::Gigalightyear:
+            unitValue = 6;
+            break;
+        default:
+            throw ghoul::MissingCaseException();
     }
 
+    const double unitMeter = toMeter(_unit);
     double maxRadius = 0.0;
-
     float biggestCoord = -1.f;
-    for (const speck::Dataset::Entry& e : _dataset.entries) {
+    for (size_t i = 0; i < _dataset.size(); i++) {
         glm::vec3 transformedPos = glm::vec3(_transformationMatrix * glm::vec4(
-            e.position, 1.0
+            _dataset.positions[i], 1.0
         ));
 
-        float unitValue = 0.f;
-        // (abock, 2022-01-02)  This is vestigial from a previous rewrite. I just want to
-        // make it work for now and we can rewrite it properly later
-        switch (_unit) {
-            case DistanceUnit::Meter:
-                unitValue = 0.f;
-                break;
-            case DistanceUnit::Kilometer:
-                unitValue = 1.f;
-                break;
-            case DistanceUnit::Parsec:
-                unitValue = 2;
-                break;
-            case DistanceUnit::Kiloparsec:
-                unitValue = 3;
-                break;
-            case DistanceUnit::Megaparsec:
-                unitValue = 4;
-                break;
-            case DistanceUnit::Gigaparsec:
-                unitValue = 5;
-                break;
-            case DistanceUnit::Gigalightyear:
-                unitValue = 6;
-                break;
-            default:
-                throw ghoul::MissingCaseException();
-        }
-
         glm::vec4 position(transformedPos, unitValue);
 
-        const double unitMeter = toMeter(_unit);
         glm::dvec3 p = glm::dvec3(position) * unitMeter;
         const double r = glm::length(p);
         maxRadius = std::max(maxRadius, r);
+        biggestCoord = std::max(biggestCoord, glm::compMax(position));
+
+        for (int j = 0; j < 4; ++j) {
+            result.push_back(position[j]);
+        }
+    }
+    setBoundingSphere(maxRadius);
+    _fadeInDistances.setMaxValue(glm::vec2(10.f * biggestCoord));
+    return result;
+}
+
+std::pmr::vector<float> RenderableBillboardsCloud::createColorSlice() {
+    ZoneScoped;
+
+    // The slice is only needed until it has been uploaded to the GPU
+    std::pmr::vector<float> result(&global::memoryManager->TemporaryMemory);
+    if (_dataset.empty() || !_hasColorMapFile || !_useColorMap ||
+        _colorMap.entries.empty())
+    {
+        return result;
+    }
+    result.reserve(4 * _dataset.size());
+
+    // what datavar in use for the index color
+    int colorMapInUse = _dataset.index(_colorOptionString);
+    const std::span<const float> colors = _dataset.variable(colorMapInUse);
+
+    float minColorIdx = std::numeric_limits<float>::max();
+    float maxColorIdx = -std::numeric_limits<float>::max();
+    for (float color : colors) {
+        minColorIdx = std::min(color, minColorIdx);
+        maxColorIdx = std::max(color, maxColorIdx);
+    }
+    if (colors.empty()) {
+        minColorIdx = 0;
+        maxColorIdx = 0;
+    }
+
+    float cmax, cmin;
+    if (_colorRangeData.empty()) {
+        cmax = maxColorIdx; // Max value of datavar used for the index color
+        cmin = minColorIdx; // Min value of datavar used for the index color
+    }
+    else {
+        glm::vec2 currentColorRange = _colorRangeData[_colorOption.value()];
+        cmax = currentColorRange.y;
+        cmin = currentColorRange.x;
+    }
+
+    for (size_t i = 0; i < _dataset.size(); i++) {
+        // Note: if exact colormap option is not selected, the first color and the
+        // last color in the colormap file are the outliers colors.
+        float variableColor = colors[i];
 
-        if (_hasColorMapFile && _useColorMap && !_colorMap.entries.empty()) {
+        if (_isColorMapExact) {
+            int colorIndex = static_cast<int>(variableColor + cmin);
             for (int j = 0; j < 4; ++j) {
-                result.push_back(position[j]);
+                result.push_back(_colorMap.entries[colorIndex][j]);
             }
-            biggestCoord = std::max(biggestCoord, glm::compMax(position));
-            // Note: if exact colormap option is not selected, the first color and the
-            // last color in the colormap file are the outliers colors.
-            float variableColor = e.data[colorMapInUse];
-
-            float cmax, cmin;
-            if (_colorRangeData.empty()) {
-                cmax = maxColorIdx; // Max value of datavar used for the index color
-                cmin = minColorIdx; // Min value of datavar used for the index color
+        }
+        else {
+            if (_useLinearFiltering) {
+                float valueT = (variableColor - cmin) / (cmax - cmin); // in [0, 1)
+                valueT = std::clamp(valueT, 0.f, 1.f);
+
+                const float idx = valueT * (_colorMap.entries.size() - 1);
+                const int floorIdx = static_cast<int>(std::floor(idx));
+                const int ceilIdx = static_cast<int>(std::ceil(idx));
+
+                const glm::vec4 floorColor = _colorMap.entries[floorIdx];
+                const glm::vec4 ceilColor = _colorMap.entries[ceilIdx];
+
+                if (floorColor != ceilColor) {
+                    const glm::vec4 c = floorColor + idx * (ceilColor - floorColor);
+                    result.push_back(c.r);
+                    result.push_back(c.g);
+                    result.push_back(c.b);
+                    result.push_back(c.a);
+                }
+                else {
+                    result.push_back(floorColor.r);
+                    result.push_back(floorColor.g);
+                    result.push_back(floorColor.b);
+                    result.push_back(floorColor.a);
+                }
             }
             else {
-                glm::vec2 currentColorRange = _colorRangeData[_colorOption.value()];
-                cmax = currentColorRange.y;
-                cmin = currentColorRange.x;
-            }
+                float ncmap = static_cast<float>(_colorMap.entries.size());
+                float normalization = ((cmax != cmin) && (ncmap > 2.f)) ?
+                    (ncmap - 2.f) / (cmax - cmin) : 0;
+                int colorIndex = static_cast<int>(
+                    (variableColor - cmin) * normalization + 1.f
+                );
+                colorIndex = colorIndex < 0 ? 0 : colorIndex;
+                colorIndex = colorIndex >= ncmap ?
+                    static_cast<int>(ncmap - 1.f) : colorIndex;
 
-            if (_isColorMapExact) {
-                int colorIndex = static_cast<int>(variableColor + cmin);
                 for (int j = 0; j < 4; ++j) {
                     result.push_back(_colorMap.entries[colorIndex][j]);
                 }
             }
-            else {
-                if (_useLinearFiltering) {
-                    float valueT = (variableColor - cmin) / (cmax - cmin); // in [0, 1)
-                    valueT = std::clamp(valueT, 0.f, 1.f);
-
-                    const float idx = valueT * (_colorMap.entries.size() - 1);
-                    const int floorIdx = static_cast<int>(std::floor(idx));
-                    const int ceilIdx = static_cast<int>(std::ceil(idx));
-
-                    const glm::vec4 floorColor = _colorMap.entries[floorIdx];
-                    const glm::vec4 ceilColor = _colorMap.entries[ceilIdx];
-
-                    if (floorColor != ceilColor) {
-                        const glm::vec4 c = floorColor + idx * (ceilColor - floorColor);
-                        result.push_back(c.r);
-                        result.push_back(c.g);
-                        result.push_back(c.b);
-                        result.push_back(c.a);
-                    }
-                    else {
-                        result.push_back(floorColor.r);
-                        result.push_back(floorColor.g);
-                        result.push_back(floorColor.b);
-                        result.push_back(floorColor.a);
-                    }
-                }
-                else {
-                    float ncmap = static_cast<float>(_colorMap.entries.size());
-                    float normalization = ((cmax != cmin) && (ncmap > 2.f)) ?
-                        (ncmap - 2.f) / (cmax - cmin) : 0;
-                    int colorIndex = static_cast<int>(
-                        (variableColor - cmin) * normalization + 1.f
-                    );
-                    colorIndex = colorIndex < 0 ? 0 : colorIndex;
-                    colorIndex = colorIndex >= ncmap ?
-                        static_cast<int>(ncmap - 1.f) : colorIndex;
-
-                    for (int j = 0; j < 4; ++j) {
-                        result.push_back(_colorMap.entries[colorIndex][j]);
-                    }
-                }
-            }
-
-            if (_hasDatavarSize) {
-                result.push_back(e.data[sizeScalingInUse]);
-            }
-        }
-        else if (_hasDatavarSize) {
-            result.push_back(e.data[sizeScalingInUse]);
-            for (int j = 0; j < 4; ++j) {
-                result.push_back(position[j]);
-            }
-        }
-        else {
-            for (int j = 0; j < 4; ++j) {
-                result.push_back(position[j]);
-            }
         }
     }
-    setBoundingSphere(maxRadius);
-    _fadeInDistances.setMaxValue(glm::vec2(10.f * biggestCoord));
+    return result;
+}
+
+std::pmr::vector<float> RenderableBillboardsCloud::createSizeSlice() {
+    ZoneScoped;
+
+    // The slice is only needed until it has been uploaded to the GPU
+    std::pmr::vector<float> result(&global::memoryManager->TemporaryMemory);
+    if (_dataset.empty() || !_hasDatavarSize) {
+        return result;
+    }
+
+    // what datavar in use for the size scaling
+    int sizeScalingInUse = _dataset.index(_datavarSizeOptionString);
+    const std::span<const float> sizes = _dataset.variable(sizeScalingInUse);
+    result.assign(sizes.begin(), sizes.end());
     return result;
 }
 
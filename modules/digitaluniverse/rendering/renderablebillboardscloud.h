@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/digitaluniverse/rendering/pointcloudlod.h>
 #include <modules/space/labelscomponent.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/stringproperty.h>
@@ -40,6 +41,9 @@
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <functional>
+#include <future>
+#include <memory_resource>
+#include <optional>
 #include <unordered_map>
 
 namespace ghoul::filesystem { class File; }
@@ -66,11 +70,15 @@ public:
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
 
+    MemoryUsage memoryUsage() const override;
+
     static documentation::Documentation Documentation();
 
 private:
 
-    std::vector<float> createDataSlice();
+    std::pmr::vector<float> createPositionSlice();
+    std::pmr::vector<float> createColorSlice();
+    std::pmr::vector<float> createSizeSlice();
     void createPolygonTexture();
     void renderToTexture(GLuint textureToRenderTo, GLuint textureWidth,
         GLuint textureHeight);
@@ -78,9 +86,12 @@ private:
     void renderPolygonGeometry(GLuint vao);
     void renderBillboards(const RenderData& data, const glm::dmat4& modelMatrix,
         const glm::dvec3& orthoRight, const glm::dvec3& orthoUp, float fadeInVariable);
+    void updateDepthSorting(const RenderData& data, const glm::dmat4& modelMatrix);
 
     bool _hasSpeckFile = false;
     bool _dataIsDirty = true;
+    bool _colorDataIsDirty = true;
+    bool _sizeDataIsDirty = true;
     bool _hasSpriteTexture = false;
     bool _spriteTextureIsDirty = true;
     bool _hasColorMapFile = false;
@@ -110,6 +121,9 @@ private:
     properties::BoolProperty _useLinearFiltering;
     properties::TriggerProperty _setRangeFromData;
     properties::OptionProperty _renderOption;
+    properties::BoolProperty _sortByDepth;
+    properties::BoolProperty _enableLevelOfDetail;
+    properties::FloatProperty _levelOfDetailThreshold;
 
     ghoul::opengl::Texture* _polygonTexture = nullptr;
     ghoul::opengl::Texture* _spriteTexture = nullptr;
@@ -144,11 +158,25 @@ private:
     glm::dmat4 _transformationMatrix = glm::dmat4(1.0);
 
     GLuint _vao = 0;
+    // The positions, colors, and sizes are stored in separate buffers so that changing
+    // the color or size option only replaces the affected buffer
     GLuint _vbo = 0;
+    GLuint _colorVbo = 0;
+    GLuint _sizeVbo = 0;
 
     // For polygons
     GLuint _polygonVao = 0;
     GLuint _polygonVbo = 0;
+
+    PointCloudLod _lod;
+
+    // For depth sorting. The points are sorted on a background thread and drawn in the
+    // order of the last finished sort until the next one is available
+    GLuint _sortedIndexBuffer = 0;
+    bool _hasSortedIndices = false;
+    std::vector<glm::vec3> _sortPositions;
+    std::optional<glm::dvec3> _sortedCameraPosition;
+    std::future<std::vector<GLuint>> _sortedIndices;
 };
 
 } // namespace openspace
@@ -42,7 +42,9 @@
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -51,8 +53,8 @@
 namespace {
     constexpr std::string_view _loggerCat = "RenderableDUMeshes";
 
-    constexpr std::array<const char*, 4> UniformNames = {
-        "modelViewTransform", "projectionTransform", "alphaValue", "color"
+    constexpr std::array<const char*, 3> UniformNames = {
+        "modelViewTransform", "projectionTransform", "alphaValue"
     };
 
     constexpr int RenderOptionViewDirection = 0;
@@ -303,12 +305,10 @@ void RenderableDUMeshes::initializeGL() {
 }
 
 void RenderableDUMeshes::deinitializeGL() {
-    for (const std::pair<const int, RenderingMesh>& pair : _renderingMeshesMap) {
-        for (int i = 0; i < pair.second.numU; ++i) {
-            glDeleteVertexArrays(1, &pair.second.vaoArray[i]);
-            glDeleteBuffers(1, &pair.second.vboArray[i]);
-        }
-    }
+    glDeleteVertexArrays(1, &_vao);
+    _vao = 0;
+    glDeleteBuffers(1, &_vbo);
+    _vbo = 0;
 
     DigitalUniverseModule::ProgramObjectManager.release(
         "RenderableDUMeshes",
@@ -334,25 +334,24 @@ void RenderableDUMeshes::renderMeshes(const RenderData&,
     _program->setUniform(_uniformCache.projectionTransform, projectionMatrix);
     _program->setUniform(_uniformCache.alphaValue, opacity());
 
-    for (const std::pair<const int, RenderingMesh>& pair : _renderingMeshesMap) {
-        _program->setUniform(_uniformCache.color, _meshColorMap[pair.second.colorIndex]);
-        for (size_t i = 0; i < pair.second.vaoArray.size(); ++i) {
-            glBindVertexArray(pair.second.vaoArray[i]);
-            switch (pair.second.style) {
-                case Solid:
-                    break;
-                case Wire:
-                    glLineWidth(_lineWidth);
-                    glDrawArrays(GL_LINE_STRIP, 0, pair.second.numV);
-                    global::renderEngine->openglStateCache().resetLineState();
-                    break;
-                case Point:
-                    glDrawArrays(GL_POINTS, 0, pair.second.numV);
-                    break;
-                default:
-                    break;
-            }
-        }
+    glBindVertexArray(_vao);
+    if (!_lineStart.empty()) {
+        glLineWidth(_lineWidth);
+        glMultiDrawArrays(
+            GL_LINE_STRIP,
+            _lineStart.data(),
+            _lineCount.data(),
+            static_cast<GLsizei>(_lineStart.size())
+        );
+        global::renderEngine->openglStateCache().resetLineState();
+    }
+    if (!_pointStart.empty()) {
+        glMultiDrawArrays(
+            GL_POINTS,
+            _pointStart.data(),
+            _pointCount.data(),
+            static_cast<GLsizei>(_pointStart.size())
+        );
     }
 
     glBindVertexArray(0);
@@ -625,121 +624,87 @@ void RenderableDUMeshes::createMeshes() {
     }
     LDEBUG("Creating planes");
 
-    for (std::pair<const int, RenderingMesh>& p : _renderingMeshesMap) {
-        for (int i = 0; i < p.second.numU; ++i) {
-            GLuint vao;
-            glGenVertexArrays(1, &vao);
-            p.second.vaoArray.push_back(vao);
-
-            GLuint vbo;
-            glGenBuffers(1, &vbo);
-            p.second.vboArray.push_back(vbo);
-
-            glBindVertexArray(vao);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo);
-            //glBufferData(GL_ARRAY_BUFFER, it->second.numV * sizeof(GLfloat),
-            glBufferData(
-                GL_ARRAY_BUFFER,
-                p.second.vertices.size() * sizeof(GLfloat),
-                &p.second.vertices[0],
-                GL_STATIC_DRAW
-            );
-            // in_position
-            glEnableVertexAttribArray(0);
-            // (2022-03-23, emmbr) This code was actually never used. We only read three
-            // values per line and did not handle any texture cooridnates, even if there
-            // would have been some in the file
-            //// U and V may not be given by the user
-            //if (p.second.vertices.size() / (p.second.numU * p.second.numV) > 3) {
-            //    glVertexAttribPointer(
-            //        0,
-            //        3,
-            //        GL_FLOAT,
-            //        GL_FALSE,
-            //        sizeof(GLfloat) * 5,
-            //        reinterpret_cast<GLvoid*>(sizeof(GLfloat) * i * p.second.numV)
-            //    );
-
-            //    // texture coords
-            //    glEnableVertexAttribArray(1);
-            //    glVertexAttribPointer(
-            //        1,
-            //        2,
-            //        GL_FLOAT,
-            //        GL_FALSE,
-            //        sizeof(GLfloat) * 7,
-            //        reinterpret_cast<GLvoid*>(sizeof(GLfloat) * 3 * i * p.second.numV)
-            //    );
-            //}
-            //else { // no U and V:
-                glVertexAttribPointer(
-                    0,
-                    3,
-                    GL_FLOAT,
-                    GL_FALSE,
-                    0,
-                    reinterpret_cast<GLvoid*>(sizeof(GLfloat) * 3 * i * p.second.numV)
-                );
-            //}
+    // The rows of a mesh are stored as consecutive line strips, followed by a transposed
+    // copy of the vertices for the columns of a grid so that every line strip or point
+    // set is a contiguous range in the vertex buffer
+    std::vector<Vertex> vertices;
+    _lineStart.clear();
+    _lineCount.clear();
+    _pointStart.clear();
+    _pointCount.clear();
+
+    for (const std::pair<const int, RenderingMesh>& p : _renderingMeshesMap) {
+        const RenderingMesh& mesh = p.second;
+        if (mesh.style != Wire && mesh.style != Point) {
+            continue;
+        }
+        std::vector<GLint>& starts = mesh.style == Wire ? _lineStart : _pointStart;
+        std::vector<GLsizei>& counts = mesh.style == Wire ? _lineCount : _pointCount;
+
+        const glm::vec3 color = _meshColorMap[mesh.colorIndex];
+        const int nVertices = static_cast<int>(mesh.vertices.size() / 3);
+        auto vertex = [&](int index) {
+            return Vertex{
+                glm::vec3(
+                    mesh.vertices[3 * index],
+                    mesh.vertices[3 * index + 1],
+                    mesh.vertices[3 * index + 2]
+                ),
+                color
+            };
+        };
+
+        for (int u = 0; u < mesh.numU; ++u) {
+            const int first = u * mesh.numV;
+            const int count = std::min(mesh.numV, nVertices - first);
+            if (count <= 0) {
+                break;
+            }
+            starts.push_back(static_cast<GLint>(vertices.size()));
+            counts.push_back(count);
+            for (int v = 0; v < count; ++v) {
+                vertices.push_back(vertex(first + v));
+            }
         }
 
         // Grid: we need columns
-        if (p.second.numU > 1) {
-            for (int i = 0; i < p.second.numV; ++i) {
-                GLuint cvao;
-                glGenVertexArrays(1, &cvao);
-                p.second.vaoArray.push_back(cvao);
-
-                GLuint cvbo;
-                glGenBuffers(1, &cvbo);
-                p.second.vboArray.push_back(cvbo);
-
-                glBindVertexArray(cvao);
-                glBindBuffer(GL_ARRAY_BUFFER, cvbo);
-                glBufferData(
-                    GL_ARRAY_BUFFER,
-                    p.second.vertices.size() * sizeof(GLfloat),
-                    &p.second.vertices[0],
-                    GL_STATIC_DRAW
-                );
-                // in_position
-                glEnableVertexAttribArray(0);
-                // U and V may not be given by the user
-                if (p.second.vertices.size() / (p.second.numU * p.second.numV) > 3) {
-                    glVertexAttribPointer(
-                        0,
-                        3,
-                        GL_FLOAT,
-                        GL_FALSE,
-                        p.second.numV * sizeof(GLfloat) * 5,
-                        reinterpret_cast<GLvoid*>(sizeof(GLfloat) * i)
-                    );
-
-                    // texture coords
-                    glEnableVertexAttribArray(1);
-                    glVertexAttribPointer(
-                        1,
-                        2,
-                        GL_FLOAT,
-                        GL_FALSE,
-                        p.second.numV * sizeof(GLfloat) * 7,
-                        reinterpret_cast<GLvoid*>(sizeof(GLfloat) * 3 * i)
-                    );
-                }
-                else { // no U and V:
-                    glVertexAttribPointer(
-                        0,
-                        3,
-                        GL_FLOAT,
-                        GL_FALSE,
-                        p.second.numV * sizeof(GLfloat) * 3,
-                        reinterpret_cast<GLvoid*>(sizeof(GLfloat) * 3 * i)
-                    );
+        if (mesh.numU > 1 && nVertices == mesh.numU * mesh.numV) {
+            for (int v = 0; v < mesh.numV; ++v) {
+                starts.push_back(static_cast<GLint>(vertices.size()));
+                counts.push_back(mesh.numU);
+                for (int u = 0; u < mesh.numU; ++u) {
+                    vertices.push_back(vertex(u * mesh.numV + v));
                 }
             }
         }
     }
 
+    if (_vao == 0) {
+        glGenVertexArrays(1, &_vao);
+        glGenBuffers(1, &_vbo);
+    }
+    glBindVertexArray(_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        vertices.size() * sizeof(Vertex),
+        vertices.data(),
+        GL_STATIC_DRAW
+    );
+    // in_position
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
+    // in_color
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Vertex),
+        reinterpret_cast<GLvoid*>(offsetof(Vertex, color))
+    );
+
     glBindVertexArray(0);
 
     _dataIsDirty = false;
@@ -38,6 +38,7 @@
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <unordered_map>
+#include <vector>
 
 namespace ghoul::filesystem { class File; }
 namespace ghoul::fontrendering { class Font; }
@@ -89,11 +90,14 @@ private:
         int numU;
         int numV;
         MeshType style;
-        std::vector<GLuint> vaoArray;
-        std::vector<GLuint> vboArray;
         std::vector<GLfloat> vertices;
     };
 
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec3 color;
+    };
+
     void createMeshes();
     void renderMeshes(const RenderData& data, const glm::dmat4& modelViewMatrix,
         const glm::dmat4& projectionMatrix);
@@ -120,8 +124,7 @@ private:
     properties::OptionProperty _renderOption;
 
     ghoul::opengl::ProgramObject* _program = nullptr;
-    UniformCache(modelViewTransform, projectionTransform, alphaValue,
-        color) _uniformCache;
+    UniformCache(modelViewTransform, projectionTransform, alphaValue) _uniformCache;
     std::shared_ptr<ghoul::fontrendering::Font> _font = nullptr;
 
     std::string _speckFile;
@@ -134,6 +137,15 @@ private:
 
     std::unordered_map<int, glm::vec3> _meshColorMap;
     std::unordered_map<int, RenderingMesh> _renderingMeshesMap;
+
+    // All meshes are stored in a single vertex buffer and drawn with one call per style.
+    // The first vertex and the number of vertices of each line strip and point set
+    GLuint _vao = 0;
+    GLuint _vbo = 0;
+    std::vector<GLint> _lineStart;
+    std::vector<GLsizei> _lineCount;
+    std::vector<GLint> _pointStart;
+    std::vector<GLsizei> _pointCount;
 };
 } // namespace openspace
 
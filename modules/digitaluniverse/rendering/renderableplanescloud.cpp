@@ -38,21 +38,34 @@
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <optional>
+#include <span>
 #include <string>
 
 namespace {
     constexpr std::string_view _loggerCat = "RenderablePlanesCloud";
 
-    constexpr int PlanesVertexDataSize = 36;
+    constexpr std::array<const char*, 7> UniformNames = {
+        "modelViewProjectionTransform", "alphaValue", "fadeInValue", "galaxyTexture",
+        "scaleFactor", "viewportSize", "minPlaneSize"
+    };
 
-    constexpr std::array<const char*, 4> UniformNames = {
-        "modelViewProjectionTransform", "alphaValue", "fadeInValue", "galaxyTexture"
+    // The per-instance data of one plane. The u and v vectors span half the plane
+    struct PlaneInstance {
+        std::array<float, 3> position;
+        std::array<float, 3> u;
+        std::array<float, 3> v;
+        float layer;
     };
 
+    // Planes referencing this texture index have no texture and are not drawn
+    constexpr int UndefinedTextureIndex = 30;
+
     enum BlendMode {
         BlendModeNormal = 0,
         BlendModeAdditive
@@ -249,7 +262,8 @@ RenderablePlanesCloud::RenderablePlanesCloud(const ghoul::Dictionary& dictionary
 
     _scaleFactor = p.scaleFactor.value_or(_scaleFactor);
     addProperty(_scaleFactor);
-    _scaleFactor.onChange([this]() { _dataIsDirty = true; });
+    // The scale factor is applied in the shader, so only the bounds have to change
+    _scaleFactor.onChange([this]() { setBoundingSphere(_maxRadius * _scaleFactor); });
 
     if (p.labels.has_value()) {
         _labels = std::make_unique<LabelsComponent>(*p.labels);
@@ -310,7 +324,7 @@ RenderablePlanesCloud::RenderablePlanesCloud(const ghoul::Dictionary& dictionary
 }
 
 bool RenderablePlanesCloud::isReady() const {
-    bool isReady = _program && !_dataset.entries.empty();
+    bool isReady = _program && !_dataset.empty();
 
     // If we have labels, they also need to be loaded
     if (_hasLabels) {
@@ -324,7 +338,7 @@ void RenderablePlanesCloud::initialize() {
 
     if (_hasSpeckFile && std::filesystem::is_regular_file(_speckFile)) {
         _dataset = speck::data::loadFileWithCache(_speckFile);
-        if (_dataset.entries.empty()) {
+        if (_dataset.empty()) {
             throw ghoul::RuntimeError("Error loading data");
         }
     }
@@ -351,21 +365,29 @@ void RenderablePlanesCloud::initializeGL() {
 
     ghoul::opengl::updateUniformLocations(*_program, _uniformCache, UniformNames);
 
-    createPlanes();
+    // The planes need to know the texture array layers of their textures
     loadTextures();
+    createPlanes();
 }
 
 void RenderablePlanesCloud::deleteDataGPUAndCPU() {
-    for (std::unordered_map<int, PlaneAggregate>::reference pAMapItem : _planesMap) {
-        glDeleteBuffers(1, &pAMapItem.second.vbo);
-        glDeleteVertexArrays(1, &pAMapItem.second.vao);
-        pAMapItem.second.planesCoordinates.clear();
+    for (TextureArray& textureArray : _textureArrays) {
+        glDeleteVertexArrays(1, &textureArray.vao);
+        textureArray.vao = 0;
+        textureArray.firstInstance = 0;
+        textureArray.nInstances = 0;
     }
-    _planesMap.clear();
+    glDeleteBuffers(1, &_instanceBuffer);
+    _instanceBuffer = 0;
 }
 
 void RenderablePlanesCloud::deinitializeGL() {
     deleteDataGPUAndCPU();
+    for (const TextureArray& textureArray : _textureArrays) {
+        glDeleteTextures(1, &textureArray.texture);
+    }
+    _textureArrays.clear();
+    _textureLayers.clear();
 
     DigitalUniverseModule::ProgramObjectManager.release(
         "RenderablePlanesCloud",
@@ -394,33 +416,34 @@ void RenderablePlanesCloud::renderPlanes(const RenderData&,
     );
     _program->setUniform(_uniformCache.alphaValue, opacity());
     _program->setUniform(_uniformCache.fadeInValue, fadeInVariable);
+    _program->setUniform(_uniformCache.scaleFactor, _scaleFactor);
+    _program->setUniform(_uniformCache.minPlaneSize, _planeMinSize);
 
     glDisable(GL_CULL_FACE);
 
     GLint viewport[4];
     global::renderEngine->openglStateCache().viewport(viewport);
+    _program->setUniform(
+        _uniformCache.viewportSize,
+        glm::vec2(viewport[2], viewport[3])
+    );
 
     ghoul::opengl::TextureUnit unit;
     unit.activate();
     _program->setUniform(_uniformCache.galaxyTexture, unit);
-    int currentTextureIndex = -1;
 
-    for (std::unordered_map<int, PlaneAggregate>::reference pAMapItem : _planesMap) {
-        // For planes with undefined textures references
-        if (pAMapItem.first == 30) {
+    for (const TextureArray& textureArray : _textureArrays) {
+        if (textureArray.nInstances == 0) {
             continue;
         }
 
-        // We only bind a new texture when it is needed
-        if (currentTextureIndex != pAMapItem.first) {
-            _textureMap[pAMapItem.first]->bind();
-            currentTextureIndex = pAMapItem.first;
-        }
-        glBindVertexArray(pAMapItem.second.vao);
-        glDrawArrays(GL_TRIANGLES, 0, 6 * pAMapItem.second.numberOfPlanes);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.texture);
+        glBindVertexArray(textureArray.vao);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, textureArray.nInstances);
     }
 
     glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
     _program->deactivate();
 
     // Restores OpenGL Rendering State
@@ -490,7 +513,20 @@ void RenderablePlanesCloud::update(const UpdateData&) {
     }
 }
 
+Renderable::MemoryUsage RenderablePlanesCloud::memoryUsage() const {
+    MemoryUsage usage;
+    usage.gpuBuffers = bufferMemory(_instanceBuffer);
+    for (const TextureArray& textureArray : _textureArrays) {
+        // The RGBA8 layers plus their full mipmap chain
+        const size_t layerSize = textureArray.size.x * textureArray.size.y * 4;
+        usage.gpuTextures += layerSize * textureArray.nLayers * 4 / 3;
+    }
+    usage.cpuData = _dataset.memoryUsage();
+    return usage;
+}
+
 void RenderablePlanesCloud::loadTextures() {
+    std::vector<std::pair<int, std::unique_ptr<ghoul::opengl::Texture>>> textures;
     for (const speck::Dataset::Texture& tex : _dataset.textures) {
         std::filesystem::path fullPath = absPath(_texturesPath.string() + '/' + tex.file);
         std::filesystem::path pngPath = fullPath;
@@ -515,9 +551,6 @@ void RenderablePlanesCloud::loadTextures() {
 
         if (t) {
             LINFOC("RenderablePlanesCloud", fmt::format("Loaded texture {}", path));
-            t->uploadTexture();
-            t->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
-            t->purgeFromRAM();
         }
         else {
             // Same here, we won't be able to recover from this nullptr
@@ -526,8 +559,82 @@ void RenderablePlanesCloud::loadTextures() {
             ));
         }
 
-        _textureMap.insert(std::pair(tex.index, std::move(t)));
+        textures.emplace_back(tex.index, std::move(t));
+    }
+
+    // Assign each texture to a layer of the texture array with its size
+    for (const std::pair<int, std::unique_ptr<ghoul::opengl::Texture>>& t : textures) {
+        const glm::uvec2 size = glm::uvec2(t.second->dimensions());
+        auto it = std::find_if(
+            _textureArrays.begin(),
+            _textureArrays.end(),
+            [size](const TextureArray& textureArray) {
+                return textureArray.size == size;
+            }
+        );
+        if (it == _textureArrays.end()) {
+            TextureArray textureArray;
+            textureArray.size = size;
+            _textureArrays.push_back(textureArray);
+            it = _textureArrays.end() - 1;
+        }
+        const int array = static_cast<int>(std::distance(_textureArrays.begin(), it));
+        _textureLayers[t.first] = { array, it->nLayers };
+        it->nLayers++;
+    }
+
+    for (TextureArray& textureArray : _textureArrays) {
+        glGenTextures(1, &textureArray.texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.texture);
+        glTexImage3D(
+            GL_TEXTURE_2D_ARRAY,
+            0,
+            GL_RGBA8,
+            textureArray.size.x,
+            textureArray.size.y,
+            textureArray.nLayers,
+            0,
+            GL_RGBA,
+            GL_UNSIGNED_BYTE,
+            nullptr
+        );
+    }
+
+    // Images don't need to start on 4-byte boundaries, for example if they are RGB
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (const std::pair<int, std::unique_ptr<ghoul::opengl::Texture>>& t : textures) {
+        const std::pair<int, int> layer = _textureLayers[t.first];
+        const TextureArray& textureArray = _textureArrays[layer.first];
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.texture);
+        glTexSubImage3D(
+            GL_TEXTURE_2D_ARRAY,
+            0,
+            0,
+            0,
+            layer.second,
+            textureArray.size.x,
+            textureArray.size.y,
+            1,
+            static_cast<GLenum>(t.second->format()),
+            t.second->dataType(),
+            t.second->pixelData()
+        );
     }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    for (const TextureArray& textureArray : _textureArrays) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.texture);
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glTexParameteri(
+            GL_TEXTURE_2D_ARRAY,
+            GL_TEXTURE_MIN_FILTER,
+            GL_LINEAR_MIPMAP_LINEAR
+        );
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 }
 
 void RenderablePlanesCloud::createPlanes() {
@@ -538,9 +645,27 @@ void RenderablePlanesCloud::createPlanes() {
         LDEBUG("Creating planes...");
         float maxSize = 0.f;
         double maxRadius = 0.0;
-        for (const speck::Dataset::Entry& e : _dataset.entries) {
+
+        const std::span<const float> luminosities = _dataset.variable(lumIdx);
+        const std::span<const float> textures =
+            _dataset.variable(_dataset.textureDataIndex);
+        // The orientation is stored in 6 consecutive data values, xyz + uvw
+        std::array<std::span<const float>, 6> orientation;
+        for (int i = 0; i < 6; i++) {
+            orientation[i] = _dataset.variable(_dataset.orientationDataIndex + i);
+        }
+
+        // The instances are grouped by the texture array they use
+        std::vector<std::vector<PlaneInstance>> instances(_textureArrays.size());
+        for (size_t idx = 0; idx < _dataset.size(); idx++) {
+            const int textureIndex = static_cast<int>(textures[idx]);
+            const auto layer = _textureLayers.find(textureIndex);
+            if (textureIndex == UndefinedTextureIndex || layer == _textureLayers.end()) {
+                continue;
+            }
+
             const glm::vec4 transformedPos = glm::vec4(
-                _transformationMatrix * glm::dvec4(e.position, 1.0)
+                _transformationMatrix * glm::dvec4(_dataset.positions[idx], 1.0)
             );
 
             const double r = glm::length(glm::dvec3(transformedPos) * scale);
@@ -550,9 +675,9 @@ void RenderablePlanesCloud::createPlanes() {
             glm::vec4 u = glm::vec4(
                 _transformationMatrix *
                 glm::dvec4(
-                    e.data[_dataset.orientationDataIndex + 0],
-                    e.data[_dataset.orientationDataIndex + 1],
-                    e.data[_dataset.orientationDataIndex + 2],
+                    orientation[0][idx],
+                    orientation[1][idx],
+                    orientation[2][idx],
                     1.f
                 )
             );
@@ -562,9 +687,9 @@ void RenderablePlanesCloud::createPlanes() {
             glm::vec4 v = glm::vec4(
                 _transformationMatrix *
                 glm::dvec4(
-                    e.data[_dataset.orientationDataIndex + 3],
-                    e.data[_dataset.orientationDataIndex + 4],
-                    e.data[_dataset.orientationDataIndex + 5],
+                    orientation[3][idx],
+                    orientation[4][idx],
+                    orientation[5][idx],
                     1.f
                 )
             );
@@ -572,94 +697,82 @@ void RenderablePlanesCloud::createPlanes() {
             v.w = 0.f;
 
             if (!_luminosityVar.empty()) {
-                float lumS = e.data[lumIdx] * _sluminosity;
+                float lumS = luminosities[idx] * _sluminosity;
                 u *= lumS;
                 v *= lumS;
             }
 
-            u *= _scaleFactor;
-            v *= _scaleFactor;
-
-            glm::vec4 vertex0 = transformedPos - u - v; // same as 3
-            glm::vec4 vertex1 = transformedPos + u + v; // same as 5
-            glm::vec4 vertex2 = transformedPos - u + v;
-            glm::vec4 vertex4 = transformedPos + u - v;
-
+            // The scale factor is applied in the shader
+            const glm::vec4 scaledU = u * _scaleFactor.value();
+            const glm::vec4 scaledV = v * _scaleFactor.value();
             for (int i = 0; i < 3; ++i) {
-                maxSize = std::max(maxSize, vertex0[i]);
-                maxSize = std::max(maxSize, vertex1[i]);
-                maxSize = std::max(maxSize, vertex2[i]);
-                maxSize = std::max(maxSize, vertex4[i]);
+                const float extent = std::abs(scaledU[i]) + std::abs(scaledV[i]);
+                maxSize = std::max(maxSize, transformedPos[i] + extent);
             }
 
-            vertex0 = glm::vec4(glm::dvec4(vertex0) * scale);
-            vertex1 = glm::vec4(glm::dvec4(vertex1) * scale);
-            vertex2 = glm::vec4(glm::dvec4(vertex2) * scale);
-            vertex4 = glm::vec4(glm::dvec4(vertex4) * scale);
-
-            const std::array<GLfloat, 36> VertexData = {
-                //  x          y          z       w    s    t
-                vertex0.x, vertex0.y, vertex0.z, 1.f, 0.f, 0.f,
-                vertex1.x, vertex1.y, vertex1.z, 1.f, 1.f, 1.f,
-                vertex2.x, vertex2.y, vertex2.z, 1.f, 0.f, 1.f,
-                vertex0.x, vertex0.y, vertex0.z, 1.f, 0.f, 0.f,
-                vertex4.x, vertex4.y, vertex4.z, 1.f, 1.f, 0.f,
-                vertex1.x, vertex1.y, vertex1.z, 1.f, 1.f, 1.f,
-            };
+            const glm::vec3 position = glm::vec3(glm::dvec3(transformedPos) * scale);
+            const glm::vec3 uMeter = glm::vec3(glm::dvec3(u) * scale);
+            const glm::vec3 vMeter = glm::vec3(glm::dvec3(v) * scale);
+            instances[layer->second.first].push_back({
+                .position = { position.x, position.y, position.z },
+                .u = { uMeter.x, uMeter.y, uMeter.z },
+                .v = { vMeter.x, vMeter.y, vMeter.z },
+                .layer = static_cast<float>(layer->second.second)
+            });
+        }
 
-            int textureIndex = static_cast<int>(e.data[_dataset.textureDataIndex]);
-            std::unordered_map<int, PlaneAggregate>::iterator found =
-                _planesMap.find(textureIndex);
-            if (found != _planesMap.end()) {
-                for (int i = 0; i < PlanesVertexDataSize; ++i) {
-                    found->second.planesCoordinates.push_back(VertexData[i]);
-                }
-                found->second.numberOfPlanes++;
-            }
-            else {
-                PlaneAggregate pA;
-                pA.textureIndex = textureIndex;
-                glGenVertexArrays(1, &pA.vao);
-                glGenBuffers(1, &pA.vbo);
-                pA.numberOfPlanes = 1;
-                for (int i = 0; i < PlanesVertexDataSize; ++i) {
-                    pA.planesCoordinates.push_back(VertexData[i]);
-                }
-                _planesMap.insert(std::pair(textureIndex, pA));
-            }
+        std::vector<PlaneInstance> allInstances;
+        for (size_t i = 0; i < _textureArrays.size(); i++) {
+            _textureArrays[i].firstInstance = static_cast<GLint>(allInstances.size());
+            _textureArrays[i].nInstances = static_cast<GLsizei>(instances[i].size());
+            allInstances.insert(
+                allInstances.end(),
+                instances[i].begin(),
+                instances[i].end()
+            );
         }
 
         // Send data to GPU
-        for (const std::pair<const int, PlaneAggregate>& pAMapItem : _planesMap) {
-            glBindVertexArray(pAMapItem.second.vao);
-            glBindBuffer(GL_ARRAY_BUFFER, pAMapItem.second.vbo);
-            glBufferData(
-                GL_ARRAY_BUFFER,
-                sizeof(GLfloat) * PlanesVertexDataSize * pAMapItem.second.numberOfPlanes,
-                pAMapItem.second.planesCoordinates.data(),
-                GL_STATIC_DRAW
-            );
-            // in_position
-            glEnableVertexAttribArray(0);
-            glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), nullptr);
-
-            // texture coords
-            glEnableVertexAttribArray(1);
-            glVertexAttribPointer(
-                1,
-                2,
-                GL_FLOAT,
-                GL_FALSE,
-                6 * sizeof(GLfloat),
-                reinterpret_cast<GLvoid*>(4 * sizeof(GLfloat))
-            );
+        glGenBuffers(1, &_instanceBuffer);
+        glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            allInstances.size() * sizeof(PlaneInstance),
+            allInstances.data(),
+            GL_STATIC_DRAW
+        );
 
-            glBindVertexArray(0);
+        for (TextureArray& textureArray : _textureArrays) {
+            glGenVertexArrays(1, &textureArray.vao);
+            glBindVertexArray(textureArray.vao);
+            glBindBuffer(GL_ARRAY_BUFFER, _instanceBuffer);
+
+            // All attributes advance once per plane, starting at the first plane that
+            // uses this texture array
+            const size_t offset = textureArray.firstInstance * sizeof(PlaneInstance);
+            auto attribute = [offset](GLuint index, GLint size, size_t member) {
+                glEnableVertexAttribArray(index);
+                glVertexAttribPointer(
+                    index,
+                    size,
+                    GL_FLOAT,
+                    GL_FALSE,
+                    sizeof(PlaneInstance),
+                    reinterpret_cast<GLvoid*>(offset + member)
+                );
+                glVertexAttribDivisor(index, 1);
+            };
+            attribute(0, 3, offsetof(PlaneInstance, position));
+            attribute(1, 3, offsetof(PlaneInstance, u));
+            attribute(2, 3, offsetof(PlaneInstance, v));
+            attribute(3, 1, offsetof(PlaneInstance, layer));
         }
+        glBindVertexArray(0);
 
         _dataIsDirty = false;
 
-        setBoundingSphere(maxRadius * _scaleFactor);
+        _maxRadius = maxRadius;
+        setBoundingSphere(_maxRadius * _scaleFactor);
         _fadeInDistances.setMaxValue(glm::vec2(10.f * maxSize));
     }
 }
@@ -40,17 +40,14 @@
 #include <filesystem>
 #include <functional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ghoul::filesystem { class File; }
-namespace ghoul::opengl {
-    class ProgramObject;
-    class Texture;
-} // namespace ghoul::opengl
+namespace ghoul::opengl { class ProgramObject; }
 
 namespace openspace {
 
-// (x, y, z, w, s, t) * 6 = 36
-
 namespace documentation { struct Documentation; }
 
 class RenderablePlanesCloud : public Renderable {
@@ -67,15 +64,21 @@ public:
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
 
+    MemoryUsage memoryUsage() const override;
+
     static documentation::Documentation Documentation();
 
 private:
-    struct PlaneAggregate {
-        int textureIndex;
-        int numberOfPlanes;
-        GLuint vao;
-        GLuint vbo;
-        std::vector<GLfloat> planesCoordinates;
+    // All textures of the same size are stored as the layers of one texture array, and
+    // the planes using them are drawn as instances in a single draw call
+    struct TextureArray {
+        GLuint texture = 0;
+        glm::uvec2 size = glm::uvec2(0);
+        GLsizei nLayers = 0;
+
+        GLuint vao = 0;
+        GLint firstInstance = 0;
+        GLsizei nInstances = 0;
     };
 
     void deleteDataGPUAndCPU();
@@ -99,11 +102,14 @@ private:
 
     ghoul::opengl::ProgramObject* _program = nullptr;
     UniformCache(
-        modelViewProjectionTransform, alphaValue, fadeInValue, galaxyTexture
+        modelViewProjectionTransform, alphaValue, fadeInValue, galaxyTexture,
+        scaleFactor, viewportSize, minPlaneSize
     ) _uniformCache;
-    std::unordered_map<int, std::unique_ptr<ghoul::opengl::Texture>> _textureMap;
-    std::unordered_map<int, std::string> _textureFileMap;
-    std::unordered_map<int, PlaneAggregate> _planesMap;
+    std::vector<TextureArray> _textureArrays;
+    // The texture array and the layer in that array for each texture index
+    std::unordered_map<int, std::pair<int, int>> _textureLayers;
+    GLuint _instanceBuffer = 0;
+    double _maxRadius = 0.0;
 
     std::filesystem::path _speckFile;
     std::filesystem::path _texturesPath;
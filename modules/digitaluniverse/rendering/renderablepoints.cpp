@@ -29,6 +29,7 @@
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
 #include <openspace/rendering/renderengine.h>
+#include <openspace/util/memorymanager.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/io/texture/texturereader.h>
@@ -42,6 +43,7 @@
 #include <filesystem>
 #include <fstream>
 #include <locale>
+#include <memory_resource>
 #include <cstdint>
 #include <string>
 #include <optional>
@@ -83,6 +85,24 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo EnableLevelOfDetailInfo = {
+        "EnableLevelOfDetail",
+        "Enable Level of Detail",
+        "If this value is set to 'true', regions of the point cloud that only cover a "
+        "few pixels on screen are drawn using a small set of representative points "
+        "instead of all of their points. The level of detail structure is built the "
+        "first time this is enabled and cached for later runs",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo LevelOfDetailThresholdInfo = {
+        "LevelOfDetailThreshold",
+        "Level of Detail Threshold",
+        "The radius in pixels below which a region of the point cloud is drawn using its "
+        "representative points",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     struct [[codegen::Dictionary(RenderablePoints)]] Parameters {
         // The path to the SPECK file that contains information about the astronomical
         // object being rendered
@@ -110,6 +130,12 @@ namespace {
 
         // [[codegen::verbatim(ColorMapInfo.description)]]
         std::optional<std::string> colorMap;
+
+        // [[codegen::verbatim(EnableLevelOfDetailInfo.description)]]
+        std::optional<bool> enableLevelOfDetail;
+
+        // [[codegen::verbatim(LevelOfDetailThresholdInfo.description)]]
+        std::optional<float> levelOfDetailThreshold;
     };
 #include "renderablepoints_codegen.cpp"
 }  // namespace
@@ -130,6 +156,8 @@ RenderablePoints::RenderablePoints(const ghoul::Dictionary& dictionary)
         glm::vec3(1.f, 1.f, 1.f)
     )
     , _spriteTexturePath(SpriteTextureInfo)
+    , _enableLevelOfDetail(EnableLevelOfDetailInfo, false)
+    , _levelOfDetailThreshold(LevelOfDetailThresholdInfo, 2.f, 0.1f, 50.f)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -168,10 +196,17 @@ RenderablePoints::RenderablePoints(const ghoul::Dictionary& dictionary)
 
     _scaleFactor = p.scaleFactor.value_or(_scaleFactor);
     addProperty(_scaleFactor);
+
+    _enableLevelOfDetail = p.enableLevelOfDetail.value_or(_enableLevelOfDetail);
+    addProperty(_enableLevelOfDetail);
+
+    _levelOfDetailThreshold =
+        p.levelOfDetailThreshold.value_or(_levelOfDetailThreshold);
+    addProperty(_levelOfDetailThreshold);
 }
 
 bool RenderablePoints::isReady() const {
-    return _program && (!_dataset.entries.empty());
+    return _program && (!_dataset.empty());
 }
 
 void RenderablePoints::initialize() {
@@ -215,6 +250,8 @@ void RenderablePoints::initializeGL() {
 }
 
 void RenderablePoints::deinitializeGL() {
+    _lod.deinitializeGL();
+
     glDeleteBuffers(1, &_vbo);
     _vbo = 0;
     glDeleteVertexArrays(1, &_vao);
@@ -258,7 +295,16 @@ void RenderablePoints::render(const RenderData& data, RendererTasks&) {
 
     glEnable(GL_PROGRAM_POINT_SIZE);
     glBindVertexArray(_vao);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_dataset.entries.size()));
+    if (_enableLevelOfDetail && _lod.isReady()) {
+        // The points are stored in world space, so only the unit has to be removed
+        const glm::dvec3 cameraPosition = data.camera.positionVec3() / toMeter(_unit);
+        const double pixelsPerUnitAngle = data.camera.projectionMatrix()[1][1] *
+            global::renderEngine->renderingResolution().y / 2.0;
+        _lod.render(cameraPosition, pixelsPerUnitAngle, _levelOfDetailThreshold);
+    }
+    else {
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_dataset.size()));
+    }
 
     glDisable(GL_PROGRAM_POINT_SIZE);
     glBindVertexArray(0);
@@ -271,7 +317,7 @@ void RenderablePoints::update(const UpdateData&) {
     if (_dataIsDirty) {
         LDEBUG("Regenerating data");
 
-        std::vector<double> slice = createDataSlice();
+        std::pmr::vector<double> slice = createDataSlice();
 
         if (_vao == 0) {
             glGenVertexArrays(1, &_vao);
@@ -316,6 +362,11 @@ void RenderablePoints::update(const UpdateData&) {
         _dataIsDirty = false;
     }
 
+    if (_enableLevelOfDetail && !_lod.isReady() && !_dataset.empty()) {
+        _lod.build(_dataset.positions, _speckFile);
+        _lod.initializeGL();
+    }
+
     if (_hasSpriteTexture && _spriteTextureIsDirty) {
         LDEBUG("Reloading Sprite Texture");
         _spriteTexture = nullptr;
@@ -390,20 +441,21 @@ void RenderablePoints::readColorMapFile() {
     }
 }
 
-std::vector<double> RenderablePoints::createDataSlice() {
-    std::vector<double> slice;
+std::pmr::vector<double> RenderablePoints::createDataSlice() {
+    // The slice is only needed until it has been uploaded to the GPU
+    std::pmr::vector<double> slice(&global::memoryManager->TemporaryMemory);
     if (_hasColorMapFile) {
-        slice.reserve(8 * _dataset.entries.size());
+        slice.reserve(8 * _dataset.size());
     }
     else {
-        slice.reserve(4 * _dataset.entries.size());
+        slice.reserve(4 * _dataset.size());
     }
 
     double maxRadius = 0.0;
 
     int colorIndex = 0;
-    for (const speck::Dataset::Entry& e : _dataset.entries) {
-        glm::dvec3 p = e.position;
+    for (const glm::vec3& pos : _dataset.positions) {
+        glm::dvec3 p = pos;
         double scale = toMeter(_unit);
         p *= scale;
 
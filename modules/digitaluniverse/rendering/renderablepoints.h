@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/digitaluniverse/rendering/pointcloudlod.h>
 #include <modules/space/speckloader.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/stringproperty.h>
@@ -37,6 +38,7 @@
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <filesystem>
+#include <memory_resource>
 
 namespace ghoul::filesystem { class File; }
 
@@ -66,7 +68,7 @@ public:
     static documentation::Documentation Documentation();
 
 private:
-    std::vector<double> createDataSlice();
+    std::pmr::vector<double> createDataSlice();
 
     void readColorMapFile();
 
@@ -78,6 +80,8 @@ private:
     properties::FloatProperty _scaleFactor;
     properties::Vec3Property _pointColor;
     properties::StringProperty _spriteTexturePath;
+    properties::BoolProperty _enableLevelOfDetail;
+    properties::FloatProperty _levelOfDetailThreshold;
 
     std::unique_ptr<ghoul::opengl::Texture> _spriteTexture;
     std::unique_ptr<ghoul::filesystem::File> _spriteTextureFile;
@@ -94,6 +98,7 @@ private:
 
     speck::Dataset _dataset;
     std::vector<glm::vec4> _colorMapData;
+    PointCloudLod _lod;
 
     //int _nValuesPerAstronomicalObject = 0;
 
@@ -26,8 +26,10 @@
 
 in float vs_screenSpaceDepth;
 in vec2 vs_st;
+flat in float vs_layer;
+in float vs_fade;
 
-uniform sampler2D galaxyTexture;
+uniform sampler2DArray galaxyTexture;
 uniform float alphaValue;
 uniform float fadeInValue;
 
@@ -35,10 +37,10 @@ uniform float fadeInValue;
 Fragment getFragment() {
   Fragment frag;
 
-  frag.color = texture(galaxyTexture, vs_st);
+  frag.color = texture(galaxyTexture, vec3(vs_st, vs_layer));
   frag.color *= alphaValue;
 
-  frag.color *= fadeInValue;
+  frag.color *= fadeInValue * vs_fade;
 
   if (frag.color.a == 0.0) {
     discard;
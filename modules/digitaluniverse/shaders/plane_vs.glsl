@@ -26,18 +26,65 @@
 
 #include "PowerScaling/powerScaling_vs.hglsl"
 
-layout(location = 0) in vec4 in_position;
-layout(location = 1) in vec2 in_st;
+// Each plane is one instance, and its quad is built from the vertex index
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_u;
+layout(location = 2) in vec3 in_v;
+layout(location = 3) in float in_layer;
 
 out vec2 vs_st;
+flat out float vs_layer;
+out float vs_fade;
 out float vs_screenSpaceDepth;
 
 uniform dmat4 modelViewProjectionTransform;
+uniform float scaleFactor;
+uniform vec2 viewportSize;
+uniform float minPlaneSize;
 
 
+// Returns the number of pixels that a plane at \p center covers along the \p axis, which
+// is half of the plane's extent in that direction
+float screenSize(vec4 centerClipSpace, vec3 center, vec3 axis) {
+  vec4 edgeClipSpace = vec4(modelViewProjectionTransform * dvec4(center + axis, 1.0));
+  if (centerClipSpace.w <= 0.0 || edgeClipSpace.w <= 0.0) {
+    // The plane reaches behind the camera, so it is certainly large enough
+    return 1e30;
+  }
+  vec2 edgeNdc = edgeClipSpace.xy / edgeClipSpace.w;
+  vec2 centerNdc = centerClipSpace.xy / centerClipSpace.w;
+  // The normalized device coordinates span two units across the viewport
+  return length((edgeNdc - centerNdc) * 0.5 * viewportSize);
+}
+
 void main() {
-  vs_st = in_st;
-  vec4 positionClipSpace = vec4(modelViewProjectionTransform * dvec4(in_position));
+  // (0, 0), (1, 0), (0, 1), (1, 1) as a triangle strip
+  vs_st = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+  vs_layer = in_layer;
+
+  vec3 u = in_u * scaleFactor;
+  vec3 v = in_v * scaleFactor;
+
+  // Planes that are smaller than the minimum size on screen are culled, and they fade in
+  // until they are twice as large
+  vs_fade = 1.0;
+  if (minPlaneSize > 0.0) {
+    vec4 centerClipSpace = vec4(modelViewProjectionTransform * dvec4(in_position, 1.0));
+    float size = 2.0 * max(
+      screenSize(centerClipSpace, in_position, u),
+      screenSize(centerClipSpace, in_position, v)
+    );
+    vs_fade = clamp((size - minPlaneSize) / minPlaneSize, 0.0, 1.0);
+    if (vs_fade == 0.0) {
+      // Place all vertices outside of the view volume so nothing is rasterized
+      gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+      vs_screenSpaceDepth = 0.0;
+      return;
+    }
+  }
+
+  vec3 position = in_position + (2.0 * vs_st.x - 1.0) * u + (2.0 * vs_st.y - 1.0) * v;
+  vec4 positionClipSpace = vec4(modelViewProjectionTransform * dvec4(position, 1.0));
   vec4 positionScreenSpace = z_normalization(positionClipSpace);
 
   vs_screenSpaceDepth = positionScreenSpace.w;
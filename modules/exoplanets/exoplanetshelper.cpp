@@ -33,13 +33,8 @@
 #include <ghoul/logging/logmanager.h>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/transform.hpp>
+#include <algorithm>
 #include <string_view>
-#include <fstream>
-#include <sstream>
-
-namespace {
-    constexpr std::string_view _loggerCat = "ExoplanetsModule";
-} // namespace
 
 namespace openspace::exoplanets {
 
@@ -59,44 +54,15 @@ bool hasSufficientData(const ExoplanetDataEntry& p) {
 
 glm::vec3 computeStarColor(float bv) {
     const ExoplanetsModule* module = global::moduleEngine->module<ExoplanetsModule>();
-    const std::string bvColormapPath = module->bvColormapPath();
-
-    std::ifstream colorMap(absPath(bvColormapPath), std::ios::in);
-
-    if (!colorMap.good()) {
-        LERROR(fmt::format(
-            "Failed to open colormap data file: {}", absPath(bvColormapPath)
-        ));
+    const std::vector<glm::vec3>& colorMap = module->bvColormap();
+    if (colorMap.empty()) {
         return glm::vec3(0.f);
     }
 
-    // Interpret the colormap cmap file
-    std::string line;
-    while (std::getline(colorMap, line)) {
-        if (line.empty() || (line[0] == '#')) {
-            continue;
-        }
-        break;
-    }
-
-    // The first line is the width of the image, i.e number of values
-    std::istringstream ss(line);
-    int nValues;
-    ss >> nValues;
-
-    // Find the line matching the input B-V value (B-V is in [-0.4,2.0])
+    // Find the color matching the input B-V value (B-V is in [-0.4,2.0])
+    const int nValues = static_cast<int>(colorMap.size());
     const int t = static_cast<int>(round(((bv + 0.4) / (2.0 + 0.4)) * (nValues - 1)));
-    std::string color;
-    for (int i = 0; i < t + 1; i++) {
-        std::getline(colorMap, color);
-    }
-    colorMap.close();
-
-    std::istringstream colorStream(color);
-    float r, g, b;
-    colorStream >> r >> g >> b;
-
-    return glm::vec3(r, g, b);
+    return colorMap[std::clamp(t, 0, nValues - 1)];
 }
 
 glm::dmat4 computeOrbitPlaneRotationMatrix(float i, float bigom, float omega) {
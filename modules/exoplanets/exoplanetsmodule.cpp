@@ -43,6 +43,7 @@
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -213,6 +214,7 @@ ExoplanetsModule::ExoplanetsModule()
     addProperty(_enabled);
 
     addProperty(_exoplanetsDataFolder);
+    _bvColorMapPath.onChange([this]() { _bvColormap = std::nullopt; });
     addProperty(_bvColorMapPath);
     addProperty(_starTexturePath);
     addProperty(_starGlareTexturePath);
@@ -295,6 +297,141 @@ float ExoplanetsModule::habitableZoneOpacity() const {
     return _habitableZoneOpacity;
 }
 
+ExoplanetSystem ExoplanetsModule::findExoplanetSystem(std::string_view starName) const {
+    if (!_hasLoadedData) {
+        loadData();
+    }
+
+    ExoplanetSystem system;
+    const auto it = _systems.find(starName);
+    if (it == _systems.end()) {
+        return system;
+    }
+
+    for (const PlanetEntry& planet : it->second) {
+        std::string name = planet.name;
+        sanitizeNameString(name);
+
+        if (!hasSufficientData(planet.data)) {
+            LWARNING(fmt::format("Insufficient data for exoplanet: '{}'", name));
+            continue;
+        }
+
+        system.planetNames.push_back(name);
+        system.planetsData.push_back(planet.data);
+
+        updateStarDataFromNewPlanet(system.starData, planet.data);
+    }
+
+    system.starName = starName;
+    return system;
+}
+
+const std::vector<std::string>& ExoplanetsModule::hostStarsWithSufficientData() const {
+    if (!_hasLoadedData) {
+        loadData();
+    }
+    return _hostStarsWithSufficientData;
+}
+
+const std::vector<glm::vec3>& ExoplanetsModule::bvColormap() const {
+    if (_bvColormap.has_value()) {
+        return *_bvColormap;
+    }
+
+    _bvColormap = std::vector<glm::vec3>();
+    std::ifstream colorMap(absPath(_bvColorMapPath.value()), std::ios::in);
+    if (!colorMap.good()) {
+        LERROR(fmt::format(
+            "Failed to open colormap data file: {}", absPath(_bvColorMapPath.value())
+        ));
+        return *_bvColormap;
+    }
+
+    // Interpret the colormap cmap file
+    std::string line;
+    while (std::getline(colorMap, line)) {
+        if (line.empty() || (line[0] == '#')) {
+            continue;
+        }
+        break;
+    }
+
+    // The first line is the width of the image, i.e number of values
+    std::istringstream ss(line);
+    int nValues = 0;
+    ss >> nValues;
+
+    _bvColormap->reserve(nValues);
+    for (int i = 0; i < nValues && std::getline(colorMap, line); ++i) {
+        std::istringstream colorStream(line);
+        glm::vec3 color = glm::vec3(0.f);
+        colorStream >> color.r >> color.g >> color.b;
+        _bvColormap->push_back(color);
+    }
+
+    return *_bvColormap;
+}
+
+void ExoplanetsModule::loadData() const {
+    // Even if the files can't be read, we don't want to try again on every call
+    _hasLoadedData = true;
+
+    if (!hasDataFiles()) {
+        return;
+    }
+
+    const std::string binPath = exoplanetsDataPath();
+    std::ifstream data(binPath, std::ios::in | std::ios::binary);
+    if (!data.good()) {
+        LERROR(fmt::format("Failed to open exoplanets data file: '{}'", binPath));
+        return;
+    }
+
+    const std::string lutPath = lookUpTablePath();
+    std::ifstream lut(lutPath);
+    if (!lut.good()) {
+        LERROR(fmt::format("Failed to open exoplanets look-up table: '{}'", lutPath));
+        return;
+    }
+
+    std::string line;
+    while (std::getline(lut, line)) {
+        std::istringstream ss(line);
+        std::string name;
+        std::getline(ss, name, ',');
+        if (name.size() < 2) {
+            continue;
+        }
+
+        std::string location_s;
+        std::getline(ss, location_s);
+        long location = std::stol(location_s.c_str());
+
+        PlanetEntry planet;
+        data.seekg(location);
+        data.read(reinterpret_cast<char*>(&planet.data), sizeof(ExoplanetDataEntry));
+
+        // Remove the last two characters, that specify the planet
+        std::string starName = name.substr(0, name.size() - 2);
+        planet.name = std::move(name);
+        _systems[std::move(starName)].push_back(std::move(planet));
+    }
+
+    // Don't want to list systems where there is not enough data to visualize. The map
+    // is sorted, so the resulting list is sorted as well
+    for (const std::pair<const std::string, std::vector<PlanetEntry>>& p : _systems) {
+        const bool hasData = std::any_of(
+            p.second.begin(),
+            p.second.end(),
+            [](const PlanetEntry& planet) { return hasSufficientData(planet.data); }
+        );
+        if (hasData) {
+            _hostStarsWithSufficientData.push_back(p.first);
+        }
+    }
+}
+
 void ExoplanetsModule::internalInitialize(const ghoul::Dictionary& dict) {
     const Parameters p = codegen::bake<Parameters>(dict);
 
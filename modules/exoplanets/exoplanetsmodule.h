@@ -27,10 +27,14 @@
 
 #include <openspace/util/openspacemodule.h>
 
+#include <modules/exoplanets/exoplanetshelper.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/stringproperty.h>
+#include <map>
+#include <optional>
+#include <string_view>
 
 namespace openspace {
 
@@ -56,6 +60,23 @@ public:
     bool useOptimisticZone() const;
     float habitableZoneOpacity() const;
 
+    /**
+     * Returns the exoplanet system with the host star \p starName. The system has no
+     * planets if the star is not part of the data files. The data files are only read
+     * the first time this function or #hostStarsWithSufficientData is called and kept
+     * in memory afterwards.
+     */
+    exoplanets::ExoplanetSystem findExoplanetSystem(std::string_view starName) const;
+
+    /**
+     * Returns the sorted names of all host stars that have at least one planet with
+     * sufficient data to be visualized.
+     */
+    const std::vector<std::string>& hostStarsWithSufficientData() const;
+
+    /// Returns the colors of the B-V colormap, which is only read on the first call
+    const std::vector<glm::vec3>& bvColormap() const;
+
     scripting::LuaLibrary luaLibrary() const override;
     std::vector<documentation::Documentation> documentations() const override;
 
@@ -76,6 +97,21 @@ protected:
     properties::BoolProperty _useOptimisticZone;
 
     properties::FloatProperty _habitableZoneOpacity;
+
+private:
+    struct PlanetEntry {
+        std::string name;
+        exoplanets::ExoplanetDataEntry data;
+    };
+
+    // Reads the lookup table and the data file into memory
+    void loadData() const;
+
+    mutable bool _hasLoadedData = false;
+    // Host star name -> planets of the system in the order of the lookup table
+    mutable std::map<std::string, std::vector<PlanetEntry>, std::less<>> _systems;
+    mutable std::vector<std::string> _hostStarsWithSufficientData;
+    mutable std::optional<std::vector<glm::vec3>> _bvColormap;
 };
 
 } // namespace openspace
@@ -46,62 +46,8 @@ openspace::exoplanets::ExoplanetSystem findExoplanetSystemInData(
                                                                 std::string_view starName)
 {
     using namespace openspace;
-    using namespace exoplanets;
-
     const ExoplanetsModule* module = global::moduleEngine->module<ExoplanetsModule>();
-
-    const std::string binPath = module->exoplanetsDataPath();
-    std::ifstream data(absPath(binPath), std::ios::in | std::ios::binary);
-    if (!data.good()) {
-        LERROR(fmt::format("Failed to open exoplanets data file: '{}'", binPath));
-        return ExoplanetSystem();
-    }
-
-    const std::string lutPath = module->lookUpTablePath();
-    std::ifstream lut(absPath(lutPath));
-    if (!lut.good()) {
-        LERROR(fmt::format("Failed to open exoplanets look-up table: '{}'", lutPath));
-        return ExoplanetSystem();
-    }
-
-    ExoplanetSystem system;
-
-    // 1. search lut for the starname and return the corresponding location
-    // 2. go to that location in the data file
-    // 3. read sizeof(exoplanet) bytes into an exoplanet object.
-    ExoplanetDataEntry p;
-    std::string line;
-    while (std::getline(lut, line)) {
-        std::istringstream ss(line);
-        std::string name;
-        std::getline(ss, name, ',');
-
-        if (name.substr(0, name.length() - 2) != starName) {
-            continue;
-        }
-
-        std::string location_s;
-        std::getline(ss, location_s);
-        long location = std::stol(location_s.c_str());
-
-        data.seekg(location);
-        data.read(reinterpret_cast<char*>(&p), sizeof(ExoplanetDataEntry));
-
-        sanitizeNameString(name);
-
-        if (!hasSufficientData(p)) {
-            LWARNING(fmt::format("Insufficient data for exoplanet: '{}'", name));
-            continue;
-        }
-
-        system.planetNames.push_back(name);
-        system.planetsData.push_back(p);
-
-        updateStarDataFromNewPlanet(system.starData, p);
-    }
-
-    system.starName = starName;
-    return system;
+    return module->findExoplanetSystem(starName);
 }
 
 void createExoplanetSystem(const std::string& starName,
@@ -537,58 +483,7 @@ std::vector<std::string> hostStarsWithSufficientData() {
         return {};
     }
 
-    const std::string lutPath = module->lookUpTablePath();
-    std::ifstream lookupTableFile(absPath(lutPath));
-    if (!lookupTableFile.good()) {
-        LERROR(fmt::format("Failed to open lookup table file '{}'", lutPath));
-        return {};
-    }
-
-    const std::string binPath = module->exoplanetsDataPath();
-    std::ifstream data(absPath(binPath), std::ios::in | std::ios::binary);
-    if (!data.good()) {
-        LERROR(fmt::format("Failed to open data file '{}'", binPath));
-        return {};
-    }
-
-    std::vector<std::string> names;
-    std::string line;
-
-    // Read number of lines
-    int nExoplanets = 0;
-    while (std::getline(lookupTableFile, line)) {
-        ++nExoplanets;
-    }
-    lookupTableFile.clear();
-    lookupTableFile.seekg(0);
-    names.reserve(nExoplanets);
-
-    ExoplanetDataEntry p;
-    while (std::getline(lookupTableFile, line)) {
-        std::stringstream ss(line);
-        std::string name;
-        std::getline(ss, name, ',');
-        // Remove the last two characters, that specify the planet
-        name = name.substr(0, name.size() - 2);
-
-        // Don't want to list systems where there is not enough data to visualize.
-        // So, test if there is before adding the name to the list.
-        std::string location_s;
-        std::getline(ss, location_s);
-        long location = std::stol(location_s.c_str());
-
-        data.seekg(location);
-        data.read(reinterpret_cast<char*>(&p), sizeof(ExoplanetDataEntry));
-
-        if (hasSufficientData(p)) {
-            names.push_back(name);
-        }
-    }
-
-    // For easier read, sort by names and remove duplicates
-    std::sort(names.begin(), names.end());
-    names.erase(std::unique(names.begin(), names.end()), names.end());
-    return names;
+    return module->hostStarsWithSufficientData();
 }
 
 /**
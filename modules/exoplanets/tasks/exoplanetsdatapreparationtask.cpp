@@ -87,6 +87,14 @@ std::string ExoplanetsDataPreparationTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> ExoplanetsDataPreparationTask::inputFiles() const {
+    return { _inputDataPath, _inputSpeckPath, _teffToBvFilePath };
+}
+
+std::vector<std::filesystem::path> ExoplanetsDataPreparationTask::outputFiles() const {
+    return { _outputBinPath, _outputLutPath };
+}
+
 void ExoplanetsDataPreparationTask::perform(
                                            const Task::ProgressCallback& progressCallback)
 {
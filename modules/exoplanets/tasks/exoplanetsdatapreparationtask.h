@@ -47,6 +47,8 @@ public:
     ExoplanetsDataPreparationTask(const ghoul::Dictionary& dictionary);
     std::string description() override;
     void perform(const Task::ProgressCallback& progressCallback) override;
+    std::vector<std::filesystem::path> inputFiles() const override;
+    std::vector<std::filesystem::path> outputFiles() const override;
     static documentation::Documentation documentation();
 
     /**
@@ -32,6 +32,7 @@
 #include <openspace/navigation/orbitalnavigator.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scene.h>
+#include <openspace/util/job.h>
 #include <openspace/util/timemanager.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -39,11 +40,11 @@
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/textureunit.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <map>
 #include <optional>
-#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "RenderableFieldlinesSequence";
@@ -226,6 +227,10 @@ namespace {
         // Set to true if you are streaming data during runtime
         std::optional<bool> loadAtRuntime;
 
+        // The number of states that are read ahead of the current one in the direction
+        // of time when streaming data during runtime. The default is 3
+        std::optional<int> prefetchStates [[codegen::greaterequal(0)]];
+
         // [[codegen::verbatim(ColorUniformInfo.description)]]
         std::optional<glm::vec4> color [[codegen::color()]];
 
@@ -290,10 +295,6 @@ namespace {
 
 namespace openspace {
 fls::Model stringToModel(std::string str);
-std::unordered_map<std::string, std::vector<glm::vec3>>
-    extractSeedPointsFromFiles(std::filesystem::path);
-std::vector<std::string>
-    extractMagnitudeVarsFromStrings(std::vector<std::string> extrVars);
 
 documentation::Documentation RenderableFieldlinesSequence::Documentation() {
     return codegen::doc<Parameters>("fieldlinessequence_renderablefieldlinessequence");
@@ -484,6 +485,7 @@ RenderableFieldlinesSequence::RenderableFieldlinesSequence(
         LWARNING("Load at run time is only supported for osfls file type");
         _loadingStatesDynamically = false;
     }
+    _nPrefetchStates = p.prefetchStates.value_or(_nPrefetchStates);
 
     if (p.maskingRanges.has_value()) {
         _maskingRanges = *p.maskingRanges;
@@ -561,8 +563,10 @@ void RenderableFieldlinesSequence::initializeGL() {
 
     glGenVertexArrays(1, &_vertexArrayObject);
     glGenBuffers(1, &_vertexPositionBuffer);
-    glGenBuffers(1, &_vertexColorBuffer);
-    glGenBuffers(1, &_vertexMaskingBuffer);
+    glGenBuffers(1, &_extraQuantitiesBuffer);
+    _extraQuantitiesBinding = std::make_unique<ghoul::opengl::BufferBinding<
+        ghoul::opengl::bufferbinding::Buffer::ShaderStorage>
+    >();
 
     // Needed for additive blending
     setRenderBin(Renderable::RenderBin::Overlay);
@@ -611,6 +615,12 @@ bool RenderableFieldlinesSequence::prepareForOsflsStreaming() {
         // loading dynamicaly is not nessesary if only having one set in the sequence
         _loadingStatesDynamically = false;
     }
+    else {
+        _stateLoader = std::make_unique<ConcurrentJobManager<LoadedState>>(
+            ThreadPool(1)
+        );
+        _displayedStateIndex = 0;
+    }
     _activeStateIndex = 0;
     return true;
 }
@@ -712,7 +722,6 @@ void RenderableFieldlinesSequence::definePropertyCallbackFunctions() {
     bool hasExtras = (_states[0].nExtraQuantities() > 0);
     if (hasExtras) {
         _colorQuantity.onChange([this]() {
-            _shouldUpdateColorBuffer = true;
             _colorQuantityMinMax = _colorTableRanges[_colorQuantity];
             _colorTablePath = _colorTablePaths[_colorQuantity];
         });
@@ -726,7 +735,6 @@ void RenderableFieldlinesSequence::definePropertyCallbackFunctions() {
         });
 
         _maskingQuantity.onChange([this]() {
-            _shouldUpdateMaskingBuffer = true;
             _maskingMinMax = _maskingRanges[_maskingQuantity];
         });
 
@@ -824,132 +832,33 @@ void RenderableFieldlinesSequence::addStateToSequence(FieldlinesState& state) {
 }
 
 bool RenderableFieldlinesSequence::getStatesFromCdfFiles() {
-    std::vector<std::string> extraMagVars = extractMagnitudeVarsFromStrings(_extraVars);
+    std::vector<std::string> extraMagVars =
+        fls::extractMagnitudeVarsFromStrings(_extraVars);
 
     std::unordered_map<std::string, std::vector<glm::vec3>> seedsPerFiles =
-        extractSeedPointsFromFiles(_seedPointDirectory);
+        fls::extractSeedPointsFromFiles(_seedPointDirectory);
     if (seedsPerFiles.empty()) {
         LERROR("No seed files found");
         return false;
     }
 
-    for (const std::string& cdfPath : _sourceFiles) {
-        FieldlinesState newState;
-        bool isSuccessful = fls::convertCdfToFieldlinesState(
-            newState,
-            cdfPath,
-            seedsPerFiles,
-            _manualTimeOffset,
-            _tracingVariable,
-            _extraVars,
-            extraMagVars
-        );
-
-        if (isSuccessful) {
-            addStateToSequence(newState);
-            if (!_outputFolderPath.empty()) {
-                newState.saveStateToOsfls(_outputFolderPath);
-            }
+    std::vector<FieldlinesState> states = fls::convertCdfsToFieldlinesStates(
+        _sourceFiles,
+        seedsPerFiles,
+        _manualTimeOffset,
+        _tracingVariable,
+        _extraVars,
+        extraMagVars
+    );
+    for (FieldlinesState& state : states) {
+        addStateToSequence(state);
+        if (!_outputFolderPath.empty()) {
+            state.saveStateToOsfls(_outputFolderPath);
         }
     }
     return true;
 }
 
-std::unordered_map<std::string, std::vector<glm::vec3>>
-    extractSeedPointsFromFiles(std::filesystem::path filePath)
-{
-    std::unordered_map<std::string, std::vector<glm::vec3>> outMap;
-
-    if (!std::filesystem::is_directory(filePath)) {
-        LERROR(fmt::format(
-            "The specified seed point directory: '{}' does not exist", filePath
-        ));
-        return outMap;
-    }
-
-    namespace fs = std::filesystem;
-    for (const fs::directory_entry& spFile : fs::directory_iterator(filePath)) {
-        std::string seedFilePath = spFile.path().string();
-        if (!spFile.is_regular_file() ||
-            seedFilePath.substr(seedFilePath.find_last_of('.') + 1) != "txt")
-        {
-            continue;
-        }
-
-        std::ifstream seedFile(seedFilePath);
-        if (!seedFile.good()) {
-            LERROR(fmt::format("Could not open seed points file '{}'", seedFilePath));
-            outMap.clear();
-            return {};
-        }
-
-        LDEBUG(fmt::format("Reading seed points from file '{}'", seedFilePath));
-        std::string line;
-        std::vector<glm::vec3> outVec;
-        while (std::getline(seedFile, line)) {
-            std::stringstream ss(line);
-            glm::vec3 point;
-            ss >> point.x;
-            ss >> point.y;
-            ss >> point.z;
-            outVec.push_back(std::move(point));
-        }
-
-        if (outVec.empty()) {
-            LERROR(fmt::format("Found no seed points in: {}", seedFilePath));
-            outMap.clear();
-            return {};
-        }
-
-        size_t lastIndex = seedFilePath.find_last_of('.');
-        std::string name = seedFilePath.substr(0, lastIndex);   // remove file extention
-        size_t dateAndTimeSeperator = name.find_last_of('_');
-        std::string time = name.substr(dateAndTimeSeperator + 1, name.length());
-        std::string date = name.substr(dateAndTimeSeperator - 8, 8);    // 8 for yyyymmdd
-        std::string dateAndTime = date + time;
-
-        // add outVec as value and time stamp as int as key
-        outMap[dateAndTime] = outVec;
-    }
-    return outMap;
-}
-
-std::vector<std::string>
-    extractMagnitudeVarsFromStrings(std::vector<std::string> extrVars)
-{
-    std::vector<std::string> extraMagVars;
-    for (int i = 0; i < static_cast<int>(extrVars.size()); i++) {
-        const std::string& str = extrVars[i];
-        // Check if string is in the format specified for magnitude variables
-        if (str.substr(0, 2) == "|(" && str.substr(str.size() - 2, 2) == ")|") {
-            std::istringstream ss(str.substr(2, str.size() - 4));
-            std::string magVar;
-            size_t counter = 0;
-            while (std::getline(ss, magVar, ',')) {
-                magVar.erase(
-                    std::remove_if(
-                        magVar.begin(),
-                        magVar.end(),
-                        ::isspace
-                    ),
-                    magVar.end()
-                );
-                extraMagVars.push_back(magVar);
-                counter++;
-                if (counter == 3) {
-                    break;
-                }
-            }
-            if (counter != 3 && counter > 0) {
-                extraMagVars.erase(extraMagVars.end() - counter, extraMagVars.end());
-            }
-            extrVars.erase(extrVars.begin() + i);
-            i--;
-        }
-    }
-    return extraMagVars;
-}
-
 void RenderableFieldlinesSequence::deinitializeGL() {
     glDeleteVertexArrays(1, &_vertexArrayObject);
     _vertexArrayObject = 0;
@@ -957,26 +866,24 @@ void RenderableFieldlinesSequence::deinitializeGL() {
     glDeleteBuffers(1, &_vertexPositionBuffer);
     _vertexPositionBuffer = 0;
 
-    glDeleteBuffers(1, &_vertexColorBuffer);
-    _vertexColorBuffer = 0;
-
-    glDeleteBuffers(1, &_vertexMaskingBuffer);
-    _vertexMaskingBuffer = 0;
+    glDeleteBuffers(1, &_extraQuantitiesBuffer);
+    _extraQuantitiesBuffer = 0;
+    _extraQuantitiesBinding = nullptr;
 
     if (_shaderProgram) {
         global::renderEngine->removeRenderProgram(_shaderProgram.get());
         _shaderProgram = nullptr;
     }
 
-    // Stall main thread until thread that's loading states is done
-    bool printedWarning = false;
-    while (_isLoadingStateFromDisk) {
-        if (!printedWarning) {
-            LWARNING("Trying to destroy class when an active thread is still using it");
-            printedWarning = true;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    // The jobs only reference the states they are reading into, so a job that is still
+    // running can finish on its own while the loader shuts down
+    if (_stateLoader) {
+        _stateLoader->clearEnqueuedJobs();
+        _stateLoader = nullptr;
     }
+    _stateCache.clear();
+    _loadingStates.clear();
+    _unusedStates.clear();
 }
 
 bool RenderableFieldlinesSequence::isReady() const {
@@ -1000,20 +907,47 @@ void RenderableFieldlinesSequence::render(const RenderData& data, RendererTasks&
     _shaderProgram->setUniform("modelViewProjection",
             data.camera.sgctInternal.projectionMatrix() * glm::mat4(modelViewMat));
 
-    _shaderProgram->setUniform("colorMethod", _colorMethod);
+    const FieldlinesState& state = _states[_activeStateIndex];
+    const bool hasExtras = state.nExtraQuantities() > 0;
+    const bool colorByQuantity =
+        hasExtras && _colorMethod == static_cast<int>(ColorMethod::ByQuantity);
+    const bool usingMasking = hasExtras && _maskingEnabled;
+
+    _shaderProgram->setUniform(
+        "colorMethod",
+        static_cast<int>(colorByQuantity ? ColorMethod::ByQuantity : ColorMethod::Uniform)
+    );
     _shaderProgram->setUniform("lineColor", _colorUniform);
     _shaderProgram->setUniform("usingDomain", _domainEnabled);
-    _shaderProgram->setUniform("usingMasking", _maskingEnabled);
+    _shaderProgram->setUniform("usingMasking", usingMasking);
+
+    if (hasExtras) {
+        glBindBufferBase(
+            GL_SHADER_STORAGE_BUFFER,
+            _extraQuantitiesBinding->bindingNumber(),
+            _extraQuantitiesBuffer
+        );
+        _shaderProgram->setSsboBinding(
+            "extraQuantities",
+            _extraQuantitiesBinding->bindingNumber()
+        );
+        _shaderProgram->setUniform(
+            "nVertices",
+            static_cast<int>(state.vertexPositions().size())
+        );
+    }
 
-    if (_colorMethod == static_cast<int>(ColorMethod::ByQuantity)) {
+    if (colorByQuantity) {
         ghoul::opengl::TextureUnit textureUnit;
         textureUnit.activate();
         _transferFunction->bind(); // Calls update internally
         _shaderProgram->setUniform("colorTable", textureUnit);
+        _shaderProgram->setUniform("colorQuantity", _colorQuantity.value());
         _shaderProgram->setUniform("colorTableRange", _colorTableRanges[_colorQuantity]);
     }
 
-    if (_maskingEnabled) {
+    if (usingMasking) {
+        _shaderProgram->setUniform("maskingQuantity", _maskingQuantity.value());
         _shaderProgram->setUniform("maskingRange", _maskingRanges[_maskingQuantity]);
     }
 
@@ -1051,9 +985,9 @@ void RenderableFieldlinesSequence::render(const RenderData& data, RendererTasks&
 
     glMultiDrawArrays(
         GL_LINE_STRIP,
-        _states[_activeStateIndex].lineStart().data(),
-        _states[_activeStateIndex].lineCount().data(),
-        static_cast<GLsizei>(_states[_activeStateIndex].lineStart().size())
+        state.lineStart().data(),
+        state.lineCount().data(),
+        static_cast<GLsizei>(state.lineStart().size())
     );
 
     glBindVertexArray(0);
@@ -1070,9 +1004,6 @@ void RenderableFieldlinesSequence::update(const UpdateData& data) {
     if (_shaderProgram->isDirty()) {
         _shaderProgram->rebuildFromFile();
     }
-    // True if new 'runtime-state' must be loaded from disk.
-    // False => the previous frame's state should still be shown
-    bool mustLoadNewStateFromDisk = false;
     // True if new 'in-RAM-state'  must be loaded.
     // False => the previous frame's state should still be shown
     bool needUpdate = false;
@@ -1093,10 +1024,8 @@ void RenderableFieldlinesSequence::update(const UpdateData& data) {
         {
             updateActiveTriggerTimeIndex(currentTime);
 
-            if (_loadingStatesDynamically) {
-                mustLoadNewStateFromDisk = true;
-            }
-            else {
+            // 'runtime-states' are swapped in by updateStateCache once they are read
+            if (!_loadingStatesDynamically) {
                 needUpdate = true;
                 _activeStateIndex = _activeTriggerTimeIndex;
             }
@@ -1108,11 +1037,7 @@ void RenderableFieldlinesSequence::update(const UpdateData& data) {
         _activeStateIndex = 0;
         if (!_hasBeenUpdated) {
             updateVertexPositionBuffer();
-        }
-
-        if (_states[_activeStateIndex].nExtraQuantities() > 0) {
-            _shouldUpdateColorBuffer = true;
-            _shouldUpdateMaskingBuffer = true;
+            updateExtraQuantitiesBuffer();
         }
 
         _hasBeenUpdated = true;
@@ -1120,49 +1045,19 @@ void RenderableFieldlinesSequence::update(const UpdateData& data) {
     else {
         // Not in interval => set everything to false
         _activeTriggerTimeIndex = -1;
-        mustLoadNewStateFromDisk = false;
         needUpdate = false;
     }
 
-    if (mustLoadNewStateFromDisk) {
-        if (!_isLoadingStateFromDisk && !_newStateIsReady) {
-            _isLoadingStateFromDisk = true;
-            mustLoadNewStateFromDisk  = false;
-            std::string filePath = _sourceFiles[_activeTriggerTimeIndex];
-            std::thread readBinaryThread([this, f = std::move(filePath)]() {
-                readNewState(f);
-            });
-            readBinaryThread.detach();
-        }
+    if (_loadingStatesDynamically && _activeTriggerTimeIndex != -1) {
+        needUpdate = updateStateCache();
     }
 
-    if (needUpdate || _newStateIsReady) {
-        if (_loadingStatesDynamically) {
-            _states[0] = std::move(*_newState);
-        }
-
+    if (needUpdate) {
         updateVertexPositionBuffer();
-
-        if (_states[_activeStateIndex].nExtraQuantities() > 0) {
-            _shouldUpdateColorBuffer = true;
-            _shouldUpdateMaskingBuffer = true;
-        }
+        updateExtraQuantitiesBuffer();
 
         // Everything is set and ready for rendering
         needUpdate = false;
-        _newStateIsReady = false;
-    }
-
-    if (_colorMethod == 1) { //By quantity
-        if (_shouldUpdateColorBuffer) {
-            updateVertexColorBuffer();
-            _shouldUpdateColorBuffer = false;
-        }
-
-        if (_shouldUpdateMaskingBuffer) {
-            updateVertexMaskingBuffer();
-            _shouldUpdateMaskingBuffer = false;
-        }
     }
 }
 
@@ -1187,13 +1082,109 @@ void RenderableFieldlinesSequence::updateActiveTriggerTimeIndex(double currentTi
     }
 }
 
-// Reading state from disk. Must be thread safe
-void RenderableFieldlinesSequence::readNewState(const std::string& filePath) {
-    _newState = std::make_unique<FieldlinesState>();
-    if (_newState->loadStateFromOsfls(filePath)) {
-        _newStateIsReady = true;
+// Reading state from disk on the I/O thread. Only touches the state it reads into
+struct RenderableFieldlinesSequence::LoadStateJob : public Job<LoadedState> {
+    LoadStateJob(int index, std::string path, std::shared_ptr<FieldlinesState> state)
+        : filePath(std::move(path))
+    {
+        result.index = index;
+        result.state = std::move(state);
     }
-    _isLoadingStateFromDisk = false;
+
+    void execute() override {
+        result.success = result.state->loadStateFromOsfls(filePath);
+    }
+
+    LoadedState product() override {
+        return std::move(result);
+    }
+
+    std::string filePath;
+    LoadedState result;
+};
+
+bool RenderableFieldlinesSequence::updateStateCache() {
+    while (_stateLoader->numFinishedJobs() > 0) {
+        LoadedState loaded = _stateLoader->popFinishedJob()->product();
+        std::erase(_loadingStates, loaded.index);
+        if (loaded.success) {
+            _stateCache[loaded.index] = std::move(loaded.state);
+        }
+        else {
+            _failedStates.push_back(loaded.index);
+            _unusedStates.push_back(std::move(loaded.state));
+        }
+    }
+
+    const int active = _activeTriggerTimeIndex;
+    const int direction = global::timeManager->deltaTime() < 0.0 ? -1 : 1;
+
+    // The states we want to keep in the order in which they are needed: the active one,
+    // the upcoming ones in the direction of time, and the one that we just left so that
+    // small jumps back in time don't have to touch the disk
+    std::vector<int> window;
+    window.push_back(active);
+    for (int i = 1; i <= _nPrefetchStates; ++i) {
+        window.push_back(active + i * direction);
+    }
+    window.push_back(active - direction);
+    std::erase_if(
+        window,
+        [this](int i) { return i < 0 || i >= static_cast<int>(_nStates); }
+    );
+
+    bool hasNewState = false;
+    auto activeIt = _stateCache.find(active);
+    if (_displayedStateIndex != active && activeIt != _stateCache.end()) {
+        // Swapping keeps the previously displayed state, and its buffers, in the cache
+        std::swap(_states[0], *activeIt->second);
+        auto node = _stateCache.extract(activeIt);
+        node.key() = _displayedStateIndex;
+        _stateCache.insert(std::move(node));
+        _displayedStateIndex = active;
+        hasNewState = true;
+    }
+
+    for (auto it = _stateCache.begin(); it != _stateCache.end();) {
+        if (std::find(window.begin(), window.end(), it->first) == window.end()) {
+            _unusedStates.push_back(std::move(it->second));
+            it = _stateCache.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // Only a few jobs are queued at a time so that the queue doesn't fill up with states
+    // that are no longer needed when the time direction changes
+    constexpr size_t MaxLoadingStates = 2;
+    auto contains = [](const std::vector<int>& v, int i) {
+        return std::find(v.begin(), v.end(), i) != v.end();
+    };
+    for (int index : window) {
+        if (_loadingStates.size() >= MaxLoadingStates) {
+            break;
+        }
+        if (index == _displayedStateIndex || _stateCache.contains(index) ||
+            contains(_loadingStates, index) || contains(_failedStates, index))
+        {
+            continue;
+        }
+
+        std::shared_ptr<FieldlinesState> state;
+        if (!_unusedStates.empty()) {
+            state = std::move(_unusedStates.back());
+            _unusedStates.pop_back();
+        }
+        else {
+            state = std::make_shared<FieldlinesState>();
+        }
+        _loadingStates.push_back(index);
+        _stateLoader->enqueueJob(
+            std::make_shared<LoadStateJob>(index, _sourceFiles[index], std::move(state))
+        );
+    }
+    return hasNewState;
 }
 
 // Unbind buffers and arrays
@@ -1202,18 +1193,30 @@ void unbindGL() {
     glBindVertexArray(0);
 }
 
+// Uploads the data into the buffer that is bound to GL_ARRAY_BUFFER. The storage of the
+// buffer is only reallocated if the data doesn't fit into it
+void uploadArrayBuffer(const void* data, GLsizeiptr size, GLsizeiptr& bufferSize) {
+    if (size > bufferSize) {
+        glBufferData(GL_ARRAY_BUFFER, size, data, GL_DYNAMIC_DRAW);
+        bufferSize = size;
+    }
+    else if (size > 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+    }
+}
+
 void RenderableFieldlinesSequence::updateVertexPositionBuffer() {
     if (_activeStateIndex == -1) { return; }
     glBindVertexArray(_vertexArrayObject);
     glBindBuffer(GL_ARRAY_BUFFER, _vertexPositionBuffer);
 
-    const std::vector<glm::vec3>& vertPos = _states[_activeStateIndex].vertexPositions();
+    const std::span<const glm::vec3> vertPos =
+        _states[_activeStateIndex].vertexPositions();
 
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        vertPos.size() * sizeof(glm::vec3),
+    uploadArrayBuffer(
         vertPos.data(),
-        GL_STATIC_DRAW
+        static_cast<GLsizeiptr>(vertPos.size_bytes()),
+        _vertexPositionBufferSize
     );
 
     glEnableVertexAttribArray(0);
@@ -1222,56 +1225,40 @@ void RenderableFieldlinesSequence::updateVertexPositionBuffer() {
     unbindGL();
 }
 
-void RenderableFieldlinesSequence::updateVertexColorBuffer() {
+// Uploads all extra quantities of the active state into the shader storage buffer, one
+// quantity after the other. Changing the quantity or range used for coloring or masking
+// only changes the uniforms in the render function
+void RenderableFieldlinesSequence::updateExtraQuantitiesBuffer() {
     if (_activeStateIndex == -1) { return; }
-    glBindVertexArray(_vertexArrayObject);
-    glBindBuffer(GL_ARRAY_BUFFER, _vertexColorBuffer);
-
-    bool isSuccessful;
-    const std::vector<float>& quantities = _states[_activeStateIndex].extraQuantity(
-        _colorQuantity,
-        isSuccessful
-    );
-
-    if (isSuccessful) {
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            quantities.size() * sizeof(float),
-            quantities.data(),
-            GL_STATIC_DRAW
-        );
-
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 0, 0);
-
-        unbindGL();
+    const FieldlinesState& state = _states[_activeStateIndex];
+    const size_t nExtras = state.nExtraQuantities();
+    if (nExtras == 0) {
+        return;
     }
-}
 
-void RenderableFieldlinesSequence::updateVertexMaskingBuffer() {
-    if (_activeStateIndex == -1) { return; }
-    glBindVertexArray(_vertexArrayObject);
-    glBindBuffer(GL_ARRAY_BUFFER, _vertexMaskingBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _extraQuantitiesBuffer);
 
-    bool isSuccessful;
-    const std::vector<float>& maskings = _states[_activeStateIndex].extraQuantity(
-        _maskingQuantity,
-        isSuccessful
+    const GLsizeiptr quantitySize = static_cast<GLsizeiptr>(
+        state.vertexPositions().size() * sizeof(float)
     );
+    const GLsizeiptr size = static_cast<GLsizeiptr>(nExtras) * quantitySize;
+    if (size > _extraQuantitiesBufferSize) {
+        glBufferData(GL_SHADER_STORAGE_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+        _extraQuantitiesBufferSize = size;
+    }
 
-    if (isSuccessful) {
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            maskings.size() * sizeof(float),
-            maskings.data(),
-            GL_STATIC_DRAW
+    for (size_t i = 0; i < nExtras; ++i) {
+        bool isSuccessful;
+        const std::span<const float> quantity = state.extraQuantity(i, isSuccessful);
+        glBufferSubData(
+            GL_SHADER_STORAGE_BUFFER,
+            static_cast<GLintptr>(i) * quantitySize,
+            std::min(static_cast<GLsizeiptr>(quantity.size_bytes()), quantitySize),
+            quantity.data()
         );
-
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 0, 0);
-
-        unbindGL();
     }
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
 } // namespace openspace
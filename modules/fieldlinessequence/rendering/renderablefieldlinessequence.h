@@ -35,7 +35,10 @@
 #include <openspace/properties/vector/vec2property.h>
 #include <openspace/properties/vector/vec4property.h>
 #include <openspace/rendering/transferfunction.h>
-#include <atomic>
+#include <openspace/util/concurrentjobmanager.h>
+#include <ghoul/opengl/bufferbinding.h>
+#include <map>
+#include <memory>
 
 namespace openspace {
 
@@ -54,6 +57,14 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    /// The result of reading a 'runtime-state' on the I/O thread
+    struct LoadedState {
+        int index = -1;
+        std::shared_ptr<FieldlinesState> state;
+        bool success = false;
+    };
+    struct LoadStateJob;
+
     void addStateToSequence(FieldlinesState& STATE);
     void computeSequenceEndTime();
     void definePropertyCallbackFunctions();
@@ -65,11 +76,15 @@ private:
     void setupProperties();
     bool prepareForOsflsStreaming();
 
-    void readNewState(const std::string& filePath);
+    /**
+     * Collects the 'runtime-states' that have been read since the last call, swaps the
+     * state at the active trigger time into `_states[0]` if it is available and enqueues
+     * the states that should be loaded next. Returns `true` if `_states[0]` changed.
+     */
+    bool updateStateCache();
     void updateActiveTriggerTimeIndex(double currentTime);
     void updateVertexPositionBuffer();
-    void updateVertexColorBuffer();
-    void updateVertexMaskingBuffer();
+    void updateExtraQuantitiesBuffer();
 
     // Used to determine if lines should be colored UNIFORMLY or by an extraQuantity
     enum class ColorMethod {
@@ -93,20 +108,14 @@ private:
     // optional except when using json input
     std::string _modelStr;
 
-    // Used for 'runtime-states'. True when loading a new state from disk on another
-    // thread.
-    std::atomic_bool _isLoadingStateFromDisk = false;
     // False => states are stored in RAM (using 'in-RAM-states'), True => states are
     // loaded from disk during runtime (using 'runtime-states')
     bool _loadingStatesDynamically  = false;
-    // Used for 'runtime-states'. True when finished loading a new state from disk on
-    // another thread.
-    std::atomic_bool _newStateIsReady = false;
-    // True when new state is loaded or user change which quantity to color the lines by
-    bool _shouldUpdateColorBuffer   = false;
-    // True when new state is loaded or user change which quantity used for masking out
-    // line segments
-    bool _shouldUpdateMaskingBuffer = false;
+    // Used for 'runtime-states'. Number of states that are read ahead of the active one
+    // in the direction in which time is moving
+    int _nPrefetchStates = 3;
+    // Used for 'runtime-states'. Index of _startTimes of the state in _states[0]
+    int _displayedStateIndex = -1;
     // note Elon: rework the case of only one state
     // hasBeenUpdated only gets sets once, first iteration of update function, to
     // guarantee the vertext position buffer to be initialized.
@@ -130,18 +139,31 @@ private:
     double _sequenceEndTime = std::numeric_limits<double>::max();
     // OpenGL Vertex Array Object
     GLuint _vertexArrayObject = 0;
-    // OpenGL Vertex Buffer Object containing the extraQuantity values used for coloring
-    // the lines
-    GLuint _vertexColorBuffer = 0;
-    // OpenGL Vertex Buffer Object containing the extraQuantity values used for masking
-    // out segments of the lines
-    GLuint _vertexMaskingBuffer = 0;
+    // OpenGL Shader Storage Buffer Object containing all extraQuantity values of the
+    // active state, one quantity after the other. The quantities used for coloring and
+    // masking the lines are picked in the vertex shader
+    GLuint _extraQuantitiesBuffer = 0;
+    std::unique_ptr<ghoul::opengl::BufferBinding<
+        ghoul::opengl::bufferbinding::Buffer::ShaderStorage>
+    > _extraQuantitiesBinding;
     // OpenGL Vertex Buffer Object containing the vertex positions
     GLuint _vertexPositionBuffer = 0;
-
-    // The Lua-Modfile-Dictionary used during initialization
-    // Used for 'runtime-states' when switching out current state to a new state
-    std::unique_ptr<FieldlinesState> _newState;
+    // Allocated sizes, in bytes, of the two buffer objects above. States that fit into
+    // the current storage are written into it without reallocating it
+    GLsizeiptr _extraQuantitiesBufferSize = 0;
+    GLsizeiptr _vertexPositionBufferSize = 0;
+
+    // Used for 'runtime-states'. Reads the states on a persistent I/O thread
+    std::unique_ptr<ConcurrentJobManager<LoadedState>> _stateLoader;
+    // Used for 'runtime-states'. Decoded states around the active one, by their index
+    std::map<int, std::shared_ptr<FieldlinesState>> _stateCache;
+    // Used for 'runtime-states'. Indices of the states that are being read
+    std::vector<int> _loadingStates;
+    // Used for 'runtime-states'. Indices of the states that could not be read
+    std::vector<int> _failedStates;
+    // Used for 'runtime-states'. States that are no longer needed. They are reused when
+    // reading new states so that their buffers don't have to be reallocated
+    std::vector<std::shared_ptr<FieldlinesState>> _unusedStates;
     std::unique_ptr<ghoul::opengl::ProgramObject> _shaderProgram;
     // Transfer function used to color lines when _pColorMethod is set to BY_QUANTITY
     std::unique_ptr<TransferFunction> _transferFunction;
@@ -26,8 +26,12 @@
 
 // Inputs
 layout(location = 0) in vec3 in_position;        // Should be provided in meters
-layout(location = 1) in float in_color_scalar;   // The extra value used to color lines.
-layout(location = 2) in float in_masking_scalar; // The extra value used to mask out parts of lines.
+
+// All extra quantities of the state, one after the other. Each quantity has one value
+// per vertex
+layout(std430) buffer extraQuantities {
+  float quantities[];
+};
 
 out vec4 vs_color;
 out float vs_depth;
@@ -37,8 +41,11 @@ out float vs_depth;
 uniform vec4 lineColor;
 uniform mat4 modelViewProjection;
 
+uniform int nVertices;
+
 // Uniforms needed to color by quantity
 uniform int colorMethod;
+uniform int colorQuantity;
 uniform sampler1D colorTable;
 uniform vec2 colorTableRange;
 
@@ -52,6 +59,7 @@ uniform bool usingParticles;
 
 // Masking Uniforms
 uniform bool usingMasking;
+uniform int maskingQuantity;
 uniform vec2 maskingRange;
 
 // Domain Uniforms
@@ -66,10 +74,15 @@ const int uniformColor = 0;
 const int colorByQuantity = 1;
 
 
+float extraQuantity(int quantity) {
+  return quantities[quantity * nVertices + gl_VertexID];
+}
+
 vec4 getTransferFunctionColor() {
   // Remap the color scalar to a [0,1] range
+  float colorScalar = extraQuantity(colorQuantity);
   float lookUpVal =
-    (in_color_scalar - colorTableRange.x) / (colorTableRange.y - colorTableRange.x);
+    (colorScalar - colorTableRange.x) / (colorTableRange.y - colorTableRange.x);
   return texture(colorTable, lookUpVal);
 }
 
@@ -84,10 +97,11 @@ bool isPartOfParticle(double time, int vertexId, int particleSize, int particleS
 void main() {
   bool hasColor = true;
 
-  if (usingMasking && (in_masking_scalar < maskingRange.x ||
-                        in_masking_scalar > maskingRange.y))
-  {
-    hasColor = false;
+  if (usingMasking) {
+    float maskingScalar = extraQuantity(maskingQuantity);
+    if (maskingScalar < maskingRange.x || maskingScalar > maskingRange.y) {
+      hasColor = false;
+    }
   }
 
   if (usingDomain && hasColor) {
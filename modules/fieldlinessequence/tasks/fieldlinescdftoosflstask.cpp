@@ -0,0 +1,144 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/fieldlinessequence/tasks/fieldlinescdftoosflstask.h>
+
+#include <modules/fieldlinessequence/util/fieldlinesstate.h>
+#include <modules/fieldlinessequence/util/kameleonfieldlinehelper.h>
+#include <openspace/documentation/verifier.h>
+#include <ghoul/fmt.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <optional>
+
+namespace {
+    constexpr std::string_view _loggerCat = "FieldlinesCdfToOsflsTask";
+
+    struct [[codegen::Dictionary(FieldlinesCdfToOsflsTask)]] Parameters {
+        // Path to the folder containing the .cdf files that are converted
+        std::filesystem::path inputFolder [[codegen::directory()]];
+
+        // Path to the folder containing the .txt files with the seed points. Files need
+        // the time stamp in the file name like so: yyyymmdd_hhmmss.txt
+        std::filesystem::path seedPointDirectory [[codegen::directory()]];
+
+        // Path to the folder into which the .osfls states are written
+        std::filesystem::path outputFolder [[codegen::directory()]];
+
+        // Which variable in the CDF files to trace. b is default for fieldlines
+        std::optional<std::string> tracingVariable;
+
+        // Extra variables such as rho, p or t
+        std::optional<std::vector<std::string>> extraVariables;
+
+        // If data sets parameter start_time differ from start of run,
+        // elapsed_time_in_seconds might be in relation to start of run.
+        // ManuelTimeOffset will be added to trigger time.
+        std::optional<double> manualTimeOffset;
+    };
+#include "fieldlinescdftoosflstask_codegen.cpp"
+} // namespace
+
+namespace openspace {
+
+documentation::Documentation FieldlinesCdfToOsflsTask::documentation() {
+    return codegen::doc<Parameters>("fieldlinessequence_cdf_to_osfls_task");
+}
+
+FieldlinesCdfToOsflsTask::FieldlinesCdfToOsflsTask(const ghoul::Dictionary& dictionary) {
+    const Parameters p = codegen::bake<Parameters>(dictionary);
+
+    _inputFolder = absPath(p.inputFolder.string());
+    _seedPointDirectory = absPath(p.seedPointDirectory.string());
+    _outputFolder = absPath(p.outputFolder.string());
+    _tracingVariable = p.tracingVariable.value_or("b");
+    _extraVariables = p.extraVariables.value_or(_extraVariables);
+    _manualTimeOffset = p.manualTimeOffset.value_or(_manualTimeOffset);
+}
+
+std::string FieldlinesCdfToOsflsTask::description() {
+    return fmt::format(
+        "Trace the '{}' field lines of all cdf files in {} from the seed points in {} "
+        "and write the states into {}",
+        _tracingVariable, _inputFolder, _seedPointDirectory, _outputFolder
+    );
+}
+
+std::vector<std::filesystem::path> FieldlinesCdfToOsflsTask::inputFiles() const {
+    return { _inputFolder, _seedPointDirectory };
+}
+
+std::vector<std::filesystem::path> FieldlinesCdfToOsflsTask::outputFiles() const {
+    return { _outputFolder };
+}
+
+void FieldlinesCdfToOsflsTask::perform(const Task::ProgressCallback& progressCallback) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> cdfPaths;
+    for (const fs::directory_entry& e : fs::directory_iterator(_inputFolder)) {
+        if (e.is_regular_file() && e.path().extension() == ".cdf") {
+            cdfPaths.push_back(e.path().string());
+        }
+    }
+    std::sort(cdfPaths.begin(), cdfPaths.end());
+    if (cdfPaths.empty()) {
+        LERROR(fmt::format("Found no cdf files in '{}'", _inputFolder));
+        return;
+    }
+
+    const std::unordered_map<std::string, std::vector<glm::vec3>> seedsPerFiles =
+        fls::extractSeedPointsFromFiles(_seedPointDirectory);
+    if (seedsPerFiles.empty()) {
+        LERROR("No seed files found");
+        return;
+    }
+
+    const std::vector<std::string> extraMagVars =
+        fls::extractMagnitudeVarsFromStrings(_extraVariables);
+
+    std::vector<FieldlinesState> states = fls::convertCdfsToFieldlinesStates(
+        cdfPaths,
+        seedsPerFiles,
+        _manualTimeOffset,
+        _tracingVariable,
+        _extraVariables,
+        extraMagVars
+    );
+    progressCallback(0.9f);
+
+    // The file name is appended directly to the folder
+    const std::string outputFolder = (_outputFolder / "").string();
+    for (FieldlinesState& state : states) {
+        state.saveStateToOsfls(outputFolder);
+    }
+    LINFO(fmt::format(
+        "Converted {} of {} cdf files into '{}'",
+        states.size(), cdfPaths.size(), _outputFolder
+    ));
+
+    progressCallback(1.f);
+}
+
+} // namespace openspace
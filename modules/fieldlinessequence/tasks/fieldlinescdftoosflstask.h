@@ -0,0 +1,64 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_FIELDLINESSEQUENCE___FIELDLINESCDFTOOSFLSTASK___H__
+#define __OPENSPACE_MODULE_FIELDLINESSEQUENCE___FIELDLINESCDFTOOSFLSTASK___H__
+
+#include <openspace/util/task.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * Traces the field lines of all CDF files in a folder and writes each of them as an
+ * .osfls state, which a RenderableFieldlinesSequence can load without having to trace
+ * the field lines at startup.
+ */
+class FieldlinesCdfToOsflsTask : public Task {
+public:
+    FieldlinesCdfToOsflsTask(const ghoul::Dictionary& dictionary);
+
+    std::string description() override;
+    void perform(const Task::ProgressCallback& progressCallback) override;
+    std::vector<std::filesystem::path> inputFiles() const override;
+    std::vector<std::filesystem::path> outputFiles() const override;
+
+    static documentation::Documentation documentation();
+
+private:
+    std::filesystem::path _inputFolder;
+    std::filesystem::path _seedPointDirectory;
+    std::filesystem::path _outputFolder;
+
+    std::string _tracingVariable;
+    std::vector<std::string> _extraVariables;
+    double _manualTimeOffset = 0.0;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_FIELDLINESSEQUENCE___FIELDLINESCDFTOOSFLSTASK___H__
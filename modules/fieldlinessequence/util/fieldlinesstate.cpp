@@ -25,16 +25,50 @@
 #include <modules/fieldlinessequence/util/fieldlinesstate.h>
 
 #include <openspace/json.h>
+#include <openspace/util/memorymappedfile.h>
 #include <openspace/util/time.h>
 #include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 
 namespace {
     constexpr std::string_view _loggerCat = "FieldlinesState";
-    constexpr int CurrentVersion = 0;
+    constexpr int CurrentVersion = 1;
     using json = nlohmann::json;
+
+    // Each section of a version 1 file starts at a multiple of this alignment
+    constexpr uint64_t OsflsAlignment = 256;
+
+    // A version 1 file starts with this header, followed by the sections for the line
+    // starts, line counts, vertex positions, extra quantities, and extra quantity names.
+    // The version has to be the first value to be compatible with version 0 files
+    struct OsflsHeader {
+        int32_t version = 1;
+        int32_t model = 0;
+        double triggerTime = -1.0;
+        uint8_t isMorphable = 0;
+        uint8_t padding[7] = {};
+        uint64_t fileSize = 0;
+        uint64_t nLines = 0;
+        uint64_t nPoints = 0;
+        uint64_t nExtras = 0;
+        uint64_t lineStartOffset = 0;
+        uint64_t lineCountOffset = 0;
+        uint64_t positionsOffset = 0;
+        uint64_t extrasOffset = 0;
+        uint64_t extrasStride = 0;
+        uint64_t namesOffset = 0;
+        uint64_t namesSize = 0;
+    };
+    static_assert(sizeof(OsflsHeader) == 112);
+
+    uint64_t alignedOffset(uint64_t offset) {
+        return (offset + OsflsAlignment - 1) / OsflsAlignment * OsflsAlignment;
+    }
 } // namespace
 
 namespace openspace {
@@ -45,6 +79,7 @@ namespace openspace {
  * expected to be in degrees. scale is an optional scaling factor.
  */
 void FieldlinesState::convertLatLonToCartesian(float scale) {
+    copyMappedData();
     for (glm::vec3& p : _vertexPositions) {
         const float r = p.x * scale;
         const float lat = glm::radians(p.y);
@@ -56,6 +91,7 @@ void FieldlinesState::convertLatLonToCartesian(float scale) {
 }
 
 void FieldlinesState::scalePositions(float scale) {
+    copyMappedData();
     for (glm::vec3& p : _vertexPositions) {
         p *= scale;
     }
@@ -73,13 +109,22 @@ bool FieldlinesState::loadStateFromOsfls(const std::string& pathToOsflsFile) {
 
     switch (binFileVersion) {
         case 0:
-            // No need to put everything in this scope now, as only version 0 exists!
+            // Version 0 files are read into the vectors below
             break;
+        case 1:
+            ifs.close();
+            return loadStateFromMappedOsfls(pathToOsflsFile);
         default:
             LERROR("VERSION OF BINARY FILE WAS NOT RECOGNIZED");
             return false;
     }
 
+    _mappedFile = nullptr;
+    _mappedExtraQuantities.clear();
+    _mappedLineCount = {};
+    _mappedLineStart = {};
+    _mappedVertexPositions = {};
+
     // Define tmp variables to store meta data in
     size_t nLines;
     size_t nPoints;
@@ -133,6 +178,105 @@ bool FieldlinesState::loadStateFromOsfls(const std::string& pathToOsflsFile) {
     return true;
 }
 
+bool FieldlinesState::loadStateFromMappedOsfls(const std::string& pathToOsflsFile) {
+    std::shared_ptr<const MemoryMappedFile> file =
+        std::make_shared<const MemoryMappedFile>(pathToOsflsFile);
+    const size_t fileSize = file->size();
+    if (fileSize < sizeof(OsflsHeader)) {
+        LERROR(fmt::format("Couldn't map file: {}", pathToOsflsFile));
+        return false;
+    }
+    // The whole file is uploaded to the GPU, so the reading can start right away
+    file->advise(MemoryMappedFile::Usage::WillNeed);
+    const std::byte* data = file->data();
+
+    OsflsHeader header;
+    std::memcpy(&header, data, sizeof(OsflsHeader));
+
+    // Checks that a section is aligned and lies completely within the file
+    auto isValidSection = [fileSize](uint64_t offset, uint64_t byteSize) {
+        return offset % OsflsAlignment == 0 && offset <= fileSize &&
+               byteSize <= fileSize - offset;
+    };
+    const bool isValid =
+        header.fileSize == fileSize &&
+        header.extrasStride >= header.nPoints * sizeof(float) &&
+        isValidSection(header.lineStartOffset, header.nLines * sizeof(GLint)) &&
+        isValidSection(header.lineCountOffset, header.nLines * sizeof(GLsizei)) &&
+        isValidSection(header.positionsOffset, header.nPoints * sizeof(glm::vec3)) &&
+        isValidSection(header.extrasOffset, header.nExtras * header.extrasStride) &&
+        isValidSection(header.namesOffset, header.namesSize);
+    if (!isValid) {
+        LERROR(fmt::format("Corrupt fieldlines state file: {}", pathToOsflsFile));
+        return false;
+    }
+
+    _triggerTime = header.triggerTime;
+    _model = static_cast<fls::Model>(header.model);
+    _isMorphable = header.isMorphable != 0;
+
+    _mappedLineStart = std::span<const GLint>(
+        reinterpret_cast<const GLint*>(data + header.lineStartOffset),
+        header.nLines
+    );
+    _mappedLineCount = std::span<const GLsizei>(
+        reinterpret_cast<const GLsizei*>(data + header.lineCountOffset),
+        header.nLines
+    );
+    _mappedVertexPositions = std::span<const glm::vec3>(
+        reinterpret_cast<const glm::vec3*>(data + header.positionsOffset),
+        header.nPoints
+    );
+    _mappedExtraQuantities.clear();
+    for (uint64_t i = 0; i < header.nExtras; ++i) {
+        _mappedExtraQuantities.emplace_back(
+            reinterpret_cast<const float*>(
+                data + header.extrasOffset + i * header.extrasStride
+            ),
+            header.nPoints
+        );
+    }
+
+    // Names are stored as consecutive c-strings
+    _extraQuantityNames.clear();
+    const char* names = reinterpret_cast<const char*>(data + header.namesOffset);
+    size_t offset = 0;
+    for (uint64_t i = 0; i < header.nExtras; ++i) {
+        const size_t length = strnlen(names + offset, header.namesSize - offset);
+        _extraQuantityNames.emplace_back(names + offset, length);
+        offset = std::min<size_t>(offset + length + 1, header.namesSize);
+    }
+
+    // The vectors keep their capacity in case a version 0 file is loaded into this state
+    _extraQuantities.clear();
+    _lineCount.clear();
+    _lineStart.clear();
+    _vertexPositions.clear();
+    _mappedFile = std::move(file);
+    return true;
+}
+
+// Copies the data of a memory-mapped state into the vectors so that it can be modified
+void FieldlinesState::copyMappedData() {
+    if (!_mappedFile) {
+        return;
+    }
+
+    _lineStart.assign(_mappedLineStart.begin(), _mappedLineStart.end());
+    _lineCount.assign(_mappedLineCount.begin(), _mappedLineCount.end());
+    _vertexPositions.assign(_mappedVertexPositions.begin(), _mappedVertexPositions.end());
+    _extraQuantities.clear();
+    for (std::span<const float> quantity : _mappedExtraQuantities) {
+        _extraQuantities.emplace_back(quantity.begin(), quantity.end());
+    }
+
+    _mappedFile = nullptr;
+    _mappedExtraQuantities.clear();
+    _mappedLineCount = {};
+    _mappedLineStart = {};
+    _mappedVertexPositions = {};
+}
+
 bool FieldlinesState::loadStateFromJson(const std::string& pathToJsonFile,
                                         fls::Model Model, float coordToMeters)
 {
@@ -219,28 +363,23 @@ bool FieldlinesState::loadStateFromJson(const std::string& pathToJsonFile,
 /**
  * \param absPath must be the path to the file (incl. filename but excl. extension!)
  * Directory must exist! File is created (or overwritten if already existing).
- * File is structured like this: (for version 0)
- *  0. int                    - version number of binary state file! (in case something
- *                              needs to be altered in the future, then increase
- *                              CurrentVersion)
- *  1. double                 - _triggerTime
- *  2. int                    - _model
- *  3. bool                   - _isMorphable
- *  4. size_t                 - Number of lines in the state  == _lineStart.size()
- *                                                            == _lineCount.size()
- *  5. size_t                 - Total number of vertex points == _vertexPositions.size()
- *                                                           == _extraQuantities[i].size()
- *  6. size_t                 - Number of extra quantites     == _extraQuantities.size()
- *                                                           == _extraQuantityNames.size()
- *  7. site_t                 - Number of total bytes that ALL _extraQuantityNames
- *                              consists of (Each such name is stored as a c_str which
- *                              means it ends with the null char '\0' )
- *  7. std::vector<GLint>     - _lineStart
- *  8. std::vector<GLsizei>   - _lineCount
- *  9. std::vector<glm::vec3> - _vertexPositions
- * 10. std::vector<float>     - _extraQuantities
- * 11. array of c_str         - Strings naming the extra quantities (elements of
+ * File is structured like this: (for version 1)
+ *  0. OsflsHeader            - Starts with the version number of the binary state file
+ *                              (in case something needs to be altered in the future, then
+ *                              increase CurrentVersion) followed by _triggerTime, _model,
+ *                              _isMorphable, the number of lines, vertex points and extra
+ *                              quantities, and the offset of each of the sections below
+ *  1. std::vector<GLint>     - _lineStart
+ *  2. std::vector<GLsizei>   - _lineCount
+ *  3. std::vector<glm::vec3> - _vertexPositions
+ *  4. std::vector<float>     - _extraQuantities, one section per quantity
+ *  5. array of c_str         - Strings naming the extra quantities (elements of
  *                              _extraQuantityNames). Each string ends with null char '\0'
+ *
+ * Every section starts at a multiple of OsflsAlignment bytes and is stored exactly as it
+ * is uploaded to the vertex buffers, so that loaded files can be memory-mapped and used
+ * in place. Version 0 files stored the same data tightly packed behind a shorter header
+ * and can still be loaded.
  */
 void FieldlinesState::saveStateToOsfls(const std::string& absPath) {
     // ------------------------------- Create the file ------------------------------- //
@@ -264,37 +403,68 @@ void FieldlinesState::saveStateToOsfls(const std::string& absPath) {
         allExtraQuantityNamesInOne += str + '\0'; // Add null char '\0' for easier reading
     }
 
-    const size_t nLines = _lineStart.size();
-    const size_t nPoints = _vertexPositions.size();
-    const size_t nExtras = _extraQuantities.size();
-    const size_t nStringBytes = allExtraQuantityNamesInOne.size();
+    const std::span<const GLint> lineStarts = lineStart();
+    const std::span<const GLsizei> lineCounts = lineCount();
+    const std::span<const glm::vec3> positions = vertexPositions();
+    const size_t nLines = lineStarts.size();
+    const size_t nPoints = positions.size();
+    const size_t nExtras = nExtraQuantities();
+
+    // ---------------------------- Compute section layout ---------------------------- //
+    OsflsHeader header;
+    header.version = CurrentVersion;
+    header.model = static_cast<int32_t>(_model);
+    header.triggerTime = _triggerTime;
+    header.isMorphable = _isMorphable ? 1 : 0;
+    header.nLines = nLines;
+    header.nPoints = nPoints;
+    header.nExtras = nExtras;
+    header.lineStartOffset = alignedOffset(sizeof(OsflsHeader));
+    header.lineCountOffset = alignedOffset(
+        header.lineStartOffset + nLines * sizeof(GLint)
+    );
+    header.positionsOffset = alignedOffset(
+        header.lineCountOffset + nLines * sizeof(GLsizei)
+    );
+    header.extrasOffset = alignedOffset(
+        header.positionsOffset + nPoints * sizeof(glm::vec3)
+    );
+    header.extrasStride = alignedOffset(nPoints * sizeof(float));
+    header.namesOffset = header.extrasOffset + nExtras * header.extrasStride;
+    header.namesSize = allExtraQuantityNamesInOne.size();
+    header.fileSize = header.namesOffset + header.namesSize;
 
     //----------------------------- WRITE EVERYTHING TO FILE -----------------------------
-    // VERSION OF BINARY FIELDLINES STATE FILE - IN CASE STRUCTURE CHANGES IN THE FUTURE
-    ofs.write(reinterpret_cast<const char*>(&CurrentVersion), sizeof(int));
-
-    //-------------------- WRITE META DATA FOR STATE --------------------------------
-    ofs.write(reinterpret_cast<const char*>(&_triggerTime), sizeof(_triggerTime));
-    ofs.write(reinterpret_cast<const char*>(&_model), sizeof(int32_t));
-    ofs.write(reinterpret_cast<const char*>(&_isMorphable), sizeof(bool));
-
-    ofs.write(reinterpret_cast<const char*>(&nLines), sizeof(uint64_t));
-    ofs.write(reinterpret_cast<const char*>(&nPoints), sizeof(uint64_t));
-    ofs.write(reinterpret_cast<const char*>(&nExtras), sizeof(uint64_t));
-    ofs.write(reinterpret_cast<const char*>(&nStringBytes), sizeof(uint64_t));
-
-    //---------------------- WRITE ALL ARRAYS OF DATA --------------------------------
-    ofs.write(reinterpret_cast<char*>(_lineStart.data()), sizeof(int32_t) * nLines);
-    ofs.write(reinterpret_cast<char*>(_lineCount.data()), sizeof(uint32_t) * nLines);
+    // Pads the file with zeros up to the start of the next section
+    const std::vector<char> zeros(OsflsAlignment, 0);
+    auto padTo = [&ofs, &zeros](uint64_t offset) {
+        const uint64_t position = static_cast<uint64_t>(ofs.tellp());
+        ofs.write(zeros.data(), static_cast<std::streamsize>(offset - position));
+    };
+
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(OsflsHeader));
+
+    padTo(header.lineStartOffset);
+    ofs.write(reinterpret_cast<const char*>(lineStarts.data()), sizeof(GLint) * nLines);
+    padTo(header.lineCountOffset);
+    ofs.write(reinterpret_cast<const char*>(lineCounts.data()), sizeof(GLsizei) * nLines);
+    padTo(header.positionsOffset);
     ofs.write(
-        reinterpret_cast<char*>(_vertexPositions.data()),
-        3 * sizeof(float) * nPoints
+        reinterpret_cast<const char*>(positions.data()),
+        sizeof(glm::vec3) * nPoints
     );
-    // Write the data for each vector in _extraQuantities
-    for (std::vector<float>& vec : _extraQuantities) {
-        ofs.write(reinterpret_cast<char*>(vec.data()), sizeof(float) * nPoints);
+    // Write the data for each of the extra quantities
+    for (size_t i = 0; i < nExtras; ++i) {
+        bool isSuccessful;
+        const std::span<const float> quantity = extraQuantity(i, isSuccessful);
+        padTo(header.extrasOffset + i * header.extrasStride);
+        ofs.write(
+            reinterpret_cast<const char*>(quantity.data()),
+            sizeof(float) * nPoints
+        );
     }
-    ofs.write(allExtraQuantityNamesInOne.c_str(), nStringBytes);
+    padTo(header.namesOffset);
+    ofs.write(allExtraQuantityNamesInOne.c_str(), header.namesSize);
 }
 
 // TODO: This should probably be rewritten, but this is the way the files were structured
@@ -341,19 +511,26 @@ void FieldlinesState::saveStateToJson(const std::string& absPath) {
     json jFile;
 
     std::string_view timeStr = Time(_triggerTime).ISO8601();
-    const size_t nLines = _lineStart.size();
-    // const size_t nPoints      = _vertexPositions.size();
-    const size_t nExtras = _extraQuantities.size();
+    const std::span<const GLsizei> lineCounts = lineCount();
+    const std::span<const glm::vec3> positions = vertexPositions();
+    const size_t nLines = lineCounts.size();
+    const size_t nExtras = nExtraQuantities();
+
+    std::vector<std::span<const float>> extras;
+    for (size_t extraIndex = 0; extraIndex < nExtras; ++extraIndex) {
+        bool isSuccessful;
+        extras.push_back(extraQuantity(extraIndex, isSuccessful));
+    }
 
     size_t pointIndex = 0;
     for (size_t lineIndex = 0; lineIndex < nLines; ++lineIndex) {
         json jData = json::array();
-        for (GLsizei i = 0; i < _lineCount[lineIndex]; i++, ++pointIndex) {
-            const glm::vec3 pos = _vertexPositions[pointIndex];
+        for (GLsizei i = 0; i < lineCounts[lineIndex]; i++, ++pointIndex) {
+            const glm::vec3 pos = positions[pointIndex];
             json jDataElement = { pos.x, pos.y, pos.z };
 
             for (size_t extraIndex = 0; extraIndex < nExtras; ++extraIndex) {
-                jDataElement.push_back(_extraQuantities[extraIndex][pointIndex]);
+                jDataElement.push_back(extras[extraIndex][pointIndex]);
             }
             jData.push_back(jDataElement);
         }
@@ -384,10 +561,14 @@ void FieldlinesState::setTriggerTime(double t) {
 
 // Returns one of the extra quantity vectors, _extraQuantities[index].
 // If index is out of scope an empty vector is returned and the referenced bool is false.
-std::vector<float> FieldlinesState::extraQuantity(size_t index, bool& isSuccessful) const
+std::span<const float> FieldlinesState::extraQuantity(size_t index,
+                                                      bool& isSuccessful) const
 {
-    if (index < _extraQuantities.size()) {
+    if (index < nExtraQuantities()) {
         isSuccessful = true;
+        if (_mappedFile) {
+            return _mappedExtraQuantities[index];
+        }
         return _extraQuantities[index];
     }
     else {
@@ -401,6 +582,7 @@ std::vector<float> FieldlinesState::extraQuantity(size_t index, bool& isSuccessf
 // _lineStart & _lineCount accordingly.
 
 void FieldlinesState::addLine(std::vector<glm::vec3>& line) {
+    copyMappedData();
     const size_t nNewPoints = line.size();
     const size_t nOldPoints = _vertexPositions.size();
     _lineStart.push_back(static_cast<GLint>(nOldPoints));
@@ -415,27 +597,31 @@ void FieldlinesState::addLine(std::vector<glm::vec3>& line) {
 }
 
 void FieldlinesState::appendToExtra(size_t idx, float val) {
+    copyMappedData();
     _extraQuantities[idx].push_back(val);
 }
 
 void FieldlinesState::setExtraQuantityNames(std::vector<std::string> names) {
+    copyMappedData();
     _extraQuantityNames = std::move(names);
     _extraQuantities.resize(_extraQuantityNames.size());
 }
 
-const std::vector<std::vector<float>>& FieldlinesState::extraQuantities() const {
-    return _extraQuantities;
-}
-
 const std::vector<std::string>& FieldlinesState::extraQuantityNames() const {
     return _extraQuantityNames;
 }
 
-const std::vector<GLsizei>& FieldlinesState::lineCount() const {
+std::span<const GLsizei> FieldlinesState::lineCount() const {
+    if (_mappedFile) {
+        return _mappedLineCount;
+    }
     return _lineCount;
 }
 
-const std::vector<GLint>& FieldlinesState::lineStart() const {
+std::span<const GLint> FieldlinesState::lineStart() const {
+    if (_mappedFile) {
+        return _mappedLineStart;
+    }
     return _lineStart;
 }
 
@@ -444,6 +630,9 @@ fls::Model FieldlinesState::FieldlinesState::model() const {
 }
 
 size_t FieldlinesState::nExtraQuantities() const {
+    if (_mappedFile) {
+        return _mappedExtraQuantities.size();
+    }
     return _extraQuantities.size();
 }
 
@@ -451,7 +640,10 @@ double FieldlinesState::triggerTime() const {
     return _triggerTime;
 }
 
-const std::vector<glm::vec3>& FieldlinesState::vertexPositions() const {
+std::span<const glm::vec3> FieldlinesState::vertexPositions() const {
+    if (_mappedFile) {
+        return _mappedVertexPositions;
+    }
     return _vertexPositions;
 }
 
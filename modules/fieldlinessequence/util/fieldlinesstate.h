@@ -28,11 +28,21 @@
 #include <modules/fieldlinessequence/util/commons.h>
 #include <ghoul/glm.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace openspace {
 
+class MemoryMappedFile;
+
+/**
+ * The vertex data of one time step of a fieldline sequence. States that are loaded from
+ * an .osfls file of version 1 or later are memory-mapped and their getters return views
+ * directly into the mapped file, which is laid out in the same way as the vertex buffers
+ * of the RenderableFieldlinesSequence. All other states own their data.
+ */
 class FieldlinesState {
 public:
     void convertLatLonToCartesian(float scale = 1.f);
@@ -45,18 +55,17 @@ public:
         float coordToMeters);
     void saveStateToJson(const std::string& pathToJsonFile);
 
-    const std::vector<std::vector<float>>& extraQuantities() const;
     const std::vector<std::string>& extraQuantityNames() const;
-    const std::vector<GLsizei>& lineCount() const;
-    const std::vector<GLint>& lineStart() const;
+    std::span<const GLsizei> lineCount() const;
+    std::span<const GLint> lineStart() const;
 
     fls::Model model() const;
     size_t nExtraQuantities() const;
     double triggerTime() const;
-    const std::vector<glm::vec3>& vertexPositions() const;
+    std::span<const glm::vec3> vertexPositions() const;
 
     // Special getter. Returns extraQuantities[index].
-    std::vector<float> extraQuantity(size_t index, bool& isSuccesful) const;
+    std::span<const float> extraQuantity(size_t index, bool& isSuccesful) const;
 
     void setModel(fls::Model m);
     void setTriggerTime(double t);
@@ -66,6 +75,9 @@ public:
     void appendToExtra(size_t idx, float val);
 
 private:
+    bool loadStateFromMappedOsfls(const std::string& pathToOsflsFile);
+    void copyMappedData();
+
     bool _isMorphable = false;
     double _triggerTime = -1.0;
     fls::Model _model;
@@ -75,6 +87,14 @@ private:
     std::vector<GLsizei> _lineCount;
     std::vector<GLint> _lineStart;
     std::vector<glm::vec3> _vertexPositions;
+
+    // Only set for memory-mapped states, in which case the views below point into the
+    // file and the vectors above, apart from the names, are empty
+    std::shared_ptr<const MemoryMappedFile> _mappedFile;
+    std::vector<std::span<const float>> _mappedExtraQuantities;
+    std::span<const GLsizei> _mappedLineCount;
+    std::span<const GLint> _mappedLineStart;
+    std::span<const glm::vec3> _mappedVertexPositions;
 };
 
 } // namespace openspace
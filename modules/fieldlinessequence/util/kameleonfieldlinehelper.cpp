@@ -26,10 +26,18 @@
 
 #include <modules/fieldlinessequence/util/commons.h>
 #include <modules/fieldlinessequence/util/fieldlinesstate.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
 #include <openspace/util/spicemanager.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <fstream>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
 
 #ifdef OPENSPACE_MODULE_KAMELEON_ENABLED
 
@@ -57,6 +65,10 @@ namespace {
     constexpr std::string_view JParallelB  = "Current: mag(J||B)";
     // [nPa]/[amu/cm^3] * ToKelvin => Temperature in Kelvin
     constexpr float ToKelvin = 72429735.6984f;
+
+    // Opening the CDF files and converting their times into ephemeris time goes through
+    // libraries that are not thread safe, so only one file is opened at a time
+    std::mutex OpenFileMutex;
 } // namespace
 
 namespace openspace::fls {
@@ -64,7 +76,7 @@ namespace openspace::fls {
 // -------------------- DECLARE FUNCTIONS USED (ONLY) IN THIS FILE -------------------- //
 #ifdef OPENSPACE_MODULE_KAMELEON_ENABLED
     bool addLinesToState(ccmc::Kameleon* kameleon, const std::vector<glm::vec3>& seeds,
-        const std::string& tracingVar, FieldlinesState& state);
+        const std::string& tracingVar, FieldlinesState& state, ThreadPool* pool);
     void addExtraQuantities(ccmc::Kameleon* kameleon,
         std::vector<std::string>& extraScalarVars, std::vector<std::string>& extraMagVars,
         FieldlinesState& state);
@@ -88,6 +100,8 @@ namespace openspace::fls {
  * \param extraMagVars, variables which should be used for extracting magnitudes, must be
  *        a multiple of 3; e.g. "ux", "uy" & "uz" to get the magnitude of the velocity
  *        vector at each line vertex
+ * \param pool, if provided, the field lines of the seed points are traced in parallel
+ *        on this pool
  */
 bool convertCdfToFieldlinesState(FieldlinesState& state, const std::string& cdfPath,
                                  const std::unordered_map<std::string,
@@ -95,29 +109,44 @@ bool convertCdfToFieldlinesState(FieldlinesState& state, const std::string& cdfP
                                  double manualTimeOffset,
                                  const std::string& tracingVar,
                                  std::vector<std::string>& extraVars,
-                                 std::vector<std::string>& extraMagVars)
+                                 std::vector<std::string>& extraMagVars,
+                                 ThreadPool* pool)
 {
 #ifndef OPENSPACE_MODULE_KAMELEON_ENABLED
     LERROR("CDF inputs provided but Kameleon module is deactivated");
     return false;
 #else // OPENSPACE_MODULE_KAMELEON_ENABLED
-    // Create Kameleon object and open CDF file!
-    std::unique_ptr<ccmc::Kameleon> kameleon = kameleonHelper::createKameleonObject(
-        cdfPath
-    );
+    std::unique_ptr<ccmc::Kameleon> kameleon;
+    std::string cdfStringTime;
+    {
+        std::lock_guard lock(OpenFileMutex);
 
-    state.setModel(fls::stringToModel(kameleon->getModelName()));
-    double cdfDoubleTime = kameleonHelper::getTime(kameleon.get(), manualTimeOffset);
-    state.setTriggerTime(cdfDoubleTime);
+        // Create Kameleon object and open CDF file!
+        kameleon = kameleonHelper::createKameleonObject(cdfPath);
 
-    // get time as string.
-    std::string cdfStringTime = SpiceManager::ref().dateFromEphemerisTime(
-        cdfDoubleTime, "YYYYMMDDHRMNSC::RND"
-    );
+        state.setModel(fls::stringToModel(kameleon->getModelName()));
+        double cdfDoubleTime = kameleonHelper::getTime(kameleon.get(), manualTimeOffset);
+        state.setTriggerTime(cdfDoubleTime);
+
+        // get time as string.
+        cdfStringTime = SpiceManager::ref().dateFromEphemerisTime(
+            cdfDoubleTime, "YYYYMMDDHRMNSC::RND"
+        );
+    }
 
     // use time as string for picking seedpoints from seedm
-    std::vector<glm::vec3> seedPoints = seedMap.at(cdfStringTime);
-    bool success = addLinesToState(kameleon.get(), seedPoints, tracingVar, state);
+    auto seedPoints = seedMap.find(cdfStringTime);
+    if (seedPoints == seedMap.end()) {
+        LERROR(fmt::format("No seed points found for '{}'", cdfPath));
+        return false;
+    }
+    bool success = addLinesToState(
+        kameleon.get(),
+        seedPoints->second,
+        tracingVar,
+        state,
+        pool
+    );
     if (success) {
         // The line points are in their RAW format (unscaled & maybe spherical)
         // Before we scale to meters (and maybe cartesian) we must extract
@@ -147,10 +176,13 @@ bool convertCdfToFieldlinesState(FieldlinesState& state, const std::string& cdfP
  * Vertices are not scaled to meters nor converted from spherical into cartesian
  * coordinates.
  * Note that extraQuantities will NOT be set!
+ * If a pool is provided, the lines are traced in parallel and added in the order of the
+ * seed points.
  */
 bool addLinesToState(ccmc::Kameleon* kameleon, const std::vector<glm::vec3>& seedPoints,
-                     const std::string& tracingVar, FieldlinesState& state) {
-
+                     const std::string& tracingVar, FieldlinesState& state,
+                     ThreadPool* pool)
+{
     float innerBoundaryLimit;
 
     switch (state.model()) {
@@ -174,34 +206,49 @@ bool addLinesToState(ccmc::Kameleon* kameleon, const std::vector<glm::vec3>& see
         return false;
     }
 
-    bool success = false;
     LINFO("Tracing field lines");
-    // LOOP THROUGH THE SEED POINTS, TRACE LINES, CONVERT POINTS TO glm::vec3 AND STORE //
-    for (const glm::vec3& seed : seedPoints) {
-        //--------------------------------------------------------------------------//
-        // We have to create a new tracer (or actually a new interpolator) for each //
-        // new line, otherwise some issues occur                                    //
-        //--------------------------------------------------------------------------//
-        auto interpolator = std::make_unique<ccmc::KameleonInterpolator>(kameleon->model);
-        ccmc::Tracer tracer(kameleon, interpolator.get());
-        tracer.setInnerBoundary(innerBoundaryLimit); // TODO specify in Lua?
-        ccmc::Fieldline ccmcFieldline = tracer.bidirectionalTrace(
-            tracingVar,
-            seed.x,
-            seed.y,
-            seed.z
-        );
-        const std::vector<ccmc::Point3f>& positions = ccmcFieldline.getPositions();
-
-        const size_t nLinePoints = positions.size();
+    // TRACE THE LINES OF ALL SEED POINTS AND CONVERT THEIR POINTS TO glm::vec3. All
+    // variables have been loaded at this point, so the kameleon object is only read from
+    std::vector<std::vector<glm::vec3>> lines(seedPoints.size());
+    auto traceLines = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const glm::vec3& seed = seedPoints[i];
+            //----------------------------------------------------------------------//
+            // We have to create a new tracer (or actually a new interpolator) for  //
+            // each new line, otherwise some issues occur                           //
+            //----------------------------------------------------------------------//
+            auto interpolator = std::make_unique<ccmc::KameleonInterpolator>(
+                kameleon->model
+            );
+            ccmc::Tracer tracer(kameleon, interpolator.get());
+            tracer.setInnerBoundary(innerBoundaryLimit); // TODO specify in Lua?
+            ccmc::Fieldline ccmcFieldline = tracer.bidirectionalTrace(
+                tracingVar,
+                seed.x,
+                seed.y,
+                seed.z
+            );
+            const std::vector<ccmc::Point3f>& positions = ccmcFieldline.getPositions();
 
-        std::vector<glm::vec3> vertices;
-        vertices.reserve(nLinePoints);
-        for (const ccmc::Point3f& p : positions) {
-            vertices.emplace_back(p.component1, p.component2, p.component3);
+            std::vector<glm::vec3>& vertices = lines[i];
+            vertices.reserve(positions.size());
+            for (const ccmc::Point3f& p : positions) {
+                vertices.emplace_back(p.component1, p.component2, p.component3);
+            }
         }
+    };
+    if (pool) {
+        pool->parallelFor(0, seedPoints.size(), 1, traceLines);
+    }
+    else {
+        traceLines(0, seedPoints.size());
+    }
+
+    // STORE THE LINES IN THE ORDER OF THEIR SEED POINTS
+    bool success = false;
+    for (std::vector<glm::vec3>& vertices : lines) {
+        success |= !vertices.empty();
         state.addLine(vertices);
-        success |= (nLinePoints > 0);
     }
 
     return success;
@@ -393,4 +440,151 @@ void prepareStateAndKameleonForExtras(ccmc::Kameleon* kameleon,
 }
 #endif // OPENSPACE_MODULE_KAMELEON_ENABLED
 
+/**
+ * Converts all of the provided cdf files into FieldlinesStates, see
+ * convertCdfToFieldlinesState. The files are converted in parallel, each with its own
+ * Kameleon object, and the field lines within each file are traced in parallel as well.
+ * Returns the states of all files that were converted successfully, in the order of
+ * \p cdfPaths.
+ */
+std::vector<FieldlinesState> convertCdfsToFieldlinesStates(
+                                     const std::vector<std::string>& cdfPaths,
+                                     const std::unordered_map<std::string,
+                                     std::vector<glm::vec3>>& seedMap,
+                                     double manualTimeOffset,
+                                     const std::string& tracingVar,
+                                     const std::vector<std::string>& extraVars,
+                                     const std::vector<std::string>& extraMagVars)
+{
+    ThreadPool& pool = global::openSpaceEngine->threadPool();
+
+    std::vector<std::optional<FieldlinesState>> states(cdfPaths.size());
+    pool.parallelFor(0, cdfPaths.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            // The variables that fail to load are removed from these, so every file
+            // needs its own copy
+            std::vector<std::string> fileExtraVars = extraVars;
+            std::vector<std::string> fileExtraMagVars = extraMagVars;
+
+            FieldlinesState state;
+            const bool isSuccessful = convertCdfToFieldlinesState(
+                state,
+                cdfPaths[i],
+                seedMap,
+                manualTimeOffset,
+                tracingVar,
+                fileExtraVars,
+                fileExtraMagVars,
+                &pool
+            );
+            if (isSuccessful) {
+                states[i] = std::move(state);
+            }
+        }
+    });
+
+    std::vector<FieldlinesState> result;
+    for (std::optional<FieldlinesState>& state : states) {
+        if (state.has_value()) {
+            result.push_back(std::move(*state));
+        }
+    }
+    return result;
+}
+
+std::unordered_map<std::string, std::vector<glm::vec3>> extractSeedPointsFromFiles(
+                                                          std::filesystem::path filePath)
+{
+    std::unordered_map<std::string, std::vector<glm::vec3>> outMap;
+
+    if (!std::filesystem::is_directory(filePath)) {
+        LERROR(fmt::format(
+            "The specified seed point directory: '{}' does not exist", filePath
+        ));
+        return outMap;
+    }
+
+    namespace fs = std::filesystem;
+    for (const fs::directory_entry& spFile : fs::directory_iterator(filePath)) {
+        std::string seedFilePath = spFile.path().string();
+        if (!spFile.is_regular_file() ||
+            seedFilePath.substr(seedFilePath.find_last_of('.') + 1) != "txt")
+        {
+            continue;
+        }
+
+        std::ifstream seedFile(seedFilePath);
+        if (!seedFile.good()) {
+            LERROR(fmt::format("Could not open seed points file '{}'", seedFilePath));
+            outMap.clear();
+            return {};
+        }
+
+        LDEBUG(fmt::format("Reading seed points from file '{}'", seedFilePath));
+        std::string line;
+        std::vector<glm::vec3> outVec;
+        while (std::getline(seedFile, line)) {
+            std::stringstream ss(line);
+            glm::vec3 point;
+            ss >> point.x;
+            ss >> point.y;
+            ss >> point.z;
+            outVec.push_back(std::move(point));
+        }
+
+        if (outVec.empty()) {
+            LERROR(fmt::format("Found no seed points in: {}", seedFilePath));
+            outMap.clear();
+            return {};
+        }
+
+        size_t lastIndex = seedFilePath.find_last_of('.');
+        std::string name = seedFilePath.substr(0, lastIndex);   // remove file extention
+        size_t dateAndTimeSeperator = name.find_last_of('_');
+        std::string time = name.substr(dateAndTimeSeperator + 1, name.length());
+        std::string date = name.substr(dateAndTimeSeperator - 8, 8);    // 8 for yyyymmdd
+        std::string dateAndTime = date + time;
+
+        // add outVec as value and time stamp as int as key
+        outMap[dateAndTime] = outVec;
+    }
+    return outMap;
+}
+
+std::vector<std::string> extractMagnitudeVarsFromStrings(
+                                                       std::vector<std::string> extrVars)
+{
+    std::vector<std::string> extraMagVars;
+    for (int i = 0; i < static_cast<int>(extrVars.size()); i++) {
+        const std::string& str = extrVars[i];
+        // Check if string is in the format specified for magnitude variables
+        if (str.substr(0, 2) == "|(" && str.substr(str.size() - 2, 2) == ")|") {
+            std::istringstream ss(str.substr(2, str.size() - 4));
+            std::string magVar;
+            size_t counter = 0;
+            while (std::getline(ss, magVar, ',')) {
+                magVar.erase(
+                    std::remove_if(
+                        magVar.begin(),
+                        magVar.end(),
+                        ::isspace
+                    ),
+                    magVar.end()
+                );
+                extraMagVars.push_back(magVar);
+                counter++;
+                if (counter == 3) {
+                    break;
+                }
+            }
+            if (counter != 3 && counter > 0) {
+                extraMagVars.erase(extraMagVars.end() - counter, extraMagVars.end());
+            }
+            extrVars.erase(extrVars.begin() + i);
+            i--;
+        }
+    }
+    return extraMagVars;
+}
+
 } // namespace openspace::fls
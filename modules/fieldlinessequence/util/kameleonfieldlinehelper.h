@@ -26,6 +26,7 @@
 #define __OPENSPACE_MODULE_FIELDLINESSEQUENCE___KAMELEONFIELDLINEHELPER___H__
 
 #include <ghoul/glm.h>
+#include <filesystem>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -33,13 +34,28 @@
 namespace openspace {
 
 class FieldlinesState;
+class ThreadPool;
 
 namespace fls {
 
 bool convertCdfToFieldlinesState(FieldlinesState& state, const std::string& cdfPath,
     const std::unordered_map<std::string, std::vector<glm::vec3>>& seedMap,
     double manualTimeOffset, const std::string& tracingVar,
-    std::vector<std::string>& extraVars, std::vector<std::string>& extraMagVars);
+    std::vector<std::string>& extraVars, std::vector<std::string>& extraMagVars,
+    ThreadPool* pool = nullptr);
+
+std::vector<FieldlinesState> convertCdfsToFieldlinesStates(
+    const std::vector<std::string>& cdfPaths,
+    const std::unordered_map<std::string, std::vector<glm::vec3>>& seedMap,
+    double manualTimeOffset, const std::string& tracingVar,
+    const std::vector<std::string>& extraVars,
+    const std::vector<std::string>& extraMagVars);
+
+std::unordered_map<std::string, std::vector<glm::vec3>> extractSeedPointsFromFiles(
+    std::filesystem::path filePath);
+
+std::vector<std::string> extractMagnitudeVarsFromStrings(
+    std::vector<std::string> extrVars);
 
 } // namespace fls
 } // namespace openspace
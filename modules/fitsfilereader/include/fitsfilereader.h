@@ -28,7 +28,7 @@
 #include <filesystem>
 #include <string>
 #include <memory>
-#include <mutex>
+#include <optional>
 #include <unordered_map>
 #include <valarray>
 #include <vector>
@@ -58,6 +58,15 @@ struct TableData {
     std::string name;
 };
 
+template<typename T>
+struct ColumnData {
+    /// The values of each column, in the order in which the columns were requested
+    std::vector<std::vector<T>> columns;
+
+    /// The number of rows that were read into each of the columns
+    long int nRows = 0;
+};
+
 class FitsFileReader {
 public:
     FitsFileReader(bool verboseMode);
@@ -83,6 +92,23 @@ public:
         const std::vector<std::string>& columnNames, int startRow = 1, int endRow = 10,
         int hduIdx = 1, bool readAll = false);
 
+    /**
+     * Reads the columns with the provided \p columnNames of the rows in the range
+     * [\p firstRow, \p lastRow] from the table in the HDU with index \p hduIdx. If
+     * \p lastRow is smaller than \p firstRow, all rows until the end of the table are
+     * read. Instead of reading one column after another, the columns are read in blocks
+     * of the optimal number of rows for the file, so that the file is only read once.
+     * The files are opened by each call and this function can be called from multiple
+     * threads, but the reading itself is serialized as CFITSIO is not reentrant.
+     *
+     * \return The contents of the columns or `std::nullopt` if the file could not be
+     *         read
+     */
+    template<typename T>
+    static std::optional<ColumnData<T>> readColumns(const std::filesystem::path& path,
+        const std::vector<std::string>& columnNames, long int firstRow = 1,
+        long int lastRow = 0, int hduIdx = 1);
+
     /**
      * Reads a single FITS file with pre-defined columns (defined for Viennas TGAS-file).
      * Returns a vector with all read stars with `nValuesPerStar`.
@@ -109,8 +135,6 @@ private:
     const std::shared_ptr<ImageData<T>> readImageInternal(CCfits::PHDU& image);
     template<typename T>
     const std::shared_ptr<ImageData<T>> readImageInternal(CCfits::ExtHDU& image);
-
-    mutable std::mutex _mutex;
 };
 
 } // namespace openspace
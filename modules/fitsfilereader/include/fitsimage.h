@@ -0,0 +1,111 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_FITSFILEREADER___FITSIMAGE___H__
+#define __OPENSPACE_MODULE_FITSFILEREADER___FITSIMAGE___H__
+
+#include <modules/fitsfilereader/include/fitsfilereader.h>
+
+#include <ghoul/glm.h>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+namespace ghoul::opengl { class Texture; }
+
+namespace openspace {
+
+class MemoryMappedFile;
+
+/**
+ * Provides access to the image stored in a FITS file without reading the entire image
+ * into memory. The file is mapped into memory and only the pages that contain the
+ * requested region are read by the operating system. The first HDU that contains a two
+ * or three dimensional image is used; for three dimensional images only the first
+ * plane is accessible. The rows are stored bottom to top in FITS files, which is the
+ * same order that OpenGL expects, so regions can be uploaded without flipping them.
+ */
+class FitsImage {
+public:
+    /**
+     * Maps the FITS file at the provided \p path and parses the header of the image.
+     *
+     * \throw ghoul::RuntimeError If the file could not be mapped or does not contain
+     *        an uncompressed image
+     */
+    explicit FitsImage(std::filesystem::path path);
+
+    /// Returns the width and height of the full image in pixels
+    glm::uvec2 dimensions() const;
+
+    /**
+     * Returns the range of physical values in the image as stored in the `DATAMIN`
+     * and `DATAMAX` keywords, or `std::nullopt` if the header does not contain them.
+     */
+    std::optional<glm::vec2> valueRange() const;
+
+    /**
+     * Reads the region of the image that starts at the pixel \p offset and has the
+     * provided \p size. Only every \p stride pixel in each direction is read, which
+     * makes it possible to read a lower resolution version of the region while only
+     * touching the rows that are needed. The values are converted into the physical
+     * values using the `BZERO` and `BSCALE` keywords and blank pixels are returned as
+     * NaN.
+     *
+     * \pre \p offset + \p size must be inside the image
+     * \pre \p stride must be positive
+     */
+    ImageData<float> readRegion(glm::uvec2 offset, glm::uvec2 size,
+        unsigned int stride = 1) const;
+
+    /**
+     * Reads the region of the image in the same way as #readRegion and creates a single
+     * channel floating point texture from it. The values are normalized into [0, 1]
+     * using the provided \p range, the range stored in the header, or the range of the
+     * region, in that order. Blank pixels are mapped to 0. The texture is uploaded to
+     * the GPU before it is returned and its pixel data is not kept in RAM.
+     *
+     * \pre Must be called from a thread with an active OpenGL context
+     */
+    std::unique_ptr<ghoul::opengl::Texture> createTexture(glm::uvec2 offset,
+        glm::uvec2 size, unsigned int stride = 1,
+        std::optional<glm::vec2> range = std::nullopt) const;
+
+private:
+    std::filesystem::path _path;
+    std::shared_ptr<const MemoryMappedFile> _mapping;
+    const std::byte* _pixels = nullptr;
+
+    glm::uvec2 _dimensions = glm::uvec2(0);
+    int _bitpix = 0;
+    double _bzero = 0.0;
+    double _bscale = 1.0;
+    std::optional<long long> _blank;
+    std::optional<glm::vec2> _valueRange;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_FITSFILEREADER___FITSIMAGE___H__
@@ -28,7 +28,9 @@
 #include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionary.h>
+#include <algorithm>
 #include <fstream>
+#include <mutex>
 
 #ifdef WIN32
 #pragma warning (push)
@@ -48,6 +50,13 @@ using namespace CCfits;
 
 namespace {
     constexpr std::string_view _loggerCat = "FitsFileReader";
+
+    // CCfits and CFITSIO are not built to be reentrant, so only one file can be accessed
+    // at a time by all readers together
+    std::mutex& fitsMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
 } // namespace
 
 namespace openspace {
@@ -146,7 +155,7 @@ std::shared_ptr<TableData<T>> FitsFileReader::readTable(const std::filesystem::p
 {
     // We need to lock reading when using multithreads because CCfits can't handle
     // multiple I/O drivers.
-    std::lock_guard g(_mutex);
+    std::lock_guard g(fitsMutex());
 
     try {
         _infile = std::make_unique<FITS>(path.string(), Read, readAll);
@@ -169,7 +178,7 @@ std::shared_ptr<TableData<T>> FitsFileReader::readTable(const std::filesystem::p
                 std::vector<T> columnData;
                 //LINFO("Read column: " + columnNames[i]);
                 table.column(columnNames[i]).read(columnData, firstRow, endRow);
-                contents[columnNames[i]] = columnData;
+                contents[columnNames[i]] = std::move(columnData);
             }
 
             // Create TableData object of table contents.
@@ -180,7 +189,7 @@ std::shared_ptr<TableData<T>> FitsFileReader::readTable(const std::filesystem::p
                 .name = table.name()
             };
 
-            return std::make_shared<TableData<T>>(loadedTable);
+            return std::make_shared<TableData<T>>(std::move(loadedTable));
         }
     }
     catch (FitsException& e) {
@@ -192,6 +201,70 @@ std::shared_ptr<TableData<T>> FitsFileReader::readTable(const std::filesystem::p
     return nullptr;
 }
 
+template<typename T>
+std::optional<ColumnData<T>> FitsFileReader::readColumns(
+                                                        const std::filesystem::path& path,
+                                              const std::vector<std::string>& columnNames,
+                                                                        long int firstRow,
+                                                                         long int lastRow,
+                                                                               int hduIdx)
+{
+    std::lock_guard g(fitsMutex());
+
+    try {
+        FITS file(path.string(), Read, false);
+        if (file.extension().empty()) {
+            LERROR(fmt::format("File {} does not contain a table", path));
+            return std::nullopt;
+        }
+
+        ExtHDU& table = file.extension(hduIdx);
+        firstRow = std::max(firstRow, 1L);
+        if (lastRow < firstRow || lastRow > table.rows()) {
+            lastRow = table.rows();
+        }
+
+        std::vector<Column*> columns;
+        columns.reserve(columnNames.size());
+        for (const std::string& name : columnNames) {
+            columns.push_back(&table.column(name));
+        }
+
+        ColumnData<T> res;
+        res.nRows = std::max(lastRow - firstRow + 1, 0L);
+        res.columns.resize(columns.size());
+        for (std::vector<T>& column : res.columns) {
+            column.reserve(res.nRows);
+        }
+
+        // CFITSIO stores tables row by row and buffers the optimal number of rows, so
+        // reading all columns for one block of rows at a time avoids reading the file
+        // once for every column
+        const long int blockSize = std::max(table.getRowsize(), 1L);
+        std::vector<T> block;
+        for (long int first = firstRow; first <= lastRow; first += blockSize) {
+            const long int last = std::min(first + blockSize - 1, lastRow);
+            for (size_t i = 0; i < columns.size(); i++) {
+                columns[i]->read(block, first, last);
+                res.columns[i].insert(res.columns[i].end(), block.begin(), block.end());
+            }
+        }
+        return res;
+    }
+    catch (const FitsException& e) {
+        LERROR(fmt::format("Could not read FITS table {}: {}", path, e.message()));
+        return std::nullopt;
+    }
+}
+
+template std::optional<ColumnData<float>> FitsFileReader::readColumns<float>(
+    const std::filesystem::path&, const std::vector<std::string>&, long int, long int,
+    int);
+
+template std::optional<ColumnData<double>> FitsFileReader::readColumns<double>(
+    const std::filesystem::path&, const std::vector<std::string>&, long int, long int,
+    int);
+
 std::vector<float> FitsFileReader::readFitsFile(std::filesystem::path filePath,
                                                 int& nValuesPerStar, int firstRow,
                                                 int lastRow,
@@ -239,18 +312,18 @@ std::vector<float> FitsFileReader::readFitsFile(std::filesystem::path filePath,
     LINFO(allNames);
 
     // Read columns from FITS file. If rows aren't specified then full table will be read.
-    std::shared_ptr<TableData<float>> table = readTable<float>(
+    std::optional<ColumnData<float>> table = readColumns<float>(
         filePath,
         allColumnNames,
         firstRow,
         lastRow
     );
 
-    if (!table) {
+    if (!table.has_value()) {
         throw ghoul::RuntimeError(fmt::format("Failed to open Fits file {}", filePath));
     }
 
-    int nStars = table->readRows - firstRow + 1;
+    const int nStars = static_cast<int>(table->nRows);
 
     int nNullArr = 0;
     int nColumnsRead = static_cast<int>(allColumnNames.size());
@@ -262,34 +335,37 @@ std::vector<float> FitsFileReader::readFitsFile(std::filesystem::path filePath,
     // Declare how many values to save per star
     nValuesPerStar = nColumnsRead + 1; // +1 for B-V color value.
 
-    // Copy columns to local variables.
-    std::unordered_map<std::string, std::vector<float>>& tableContent = table->contents;
+    // The columns are in the order in which they were requested
+    const std::vector<std::vector<float>>& cols = table->columns;
 
     // Default render parameters!
-    std::vector<float> posXcol = std::move(tableContent[allColumnNames[0]]);
-    std::vector<float> posYcol = std::move(tableContent[allColumnNames[1]]);
-    std::vector<float> posZcol = std::move(tableContent[allColumnNames[2]]);
-    std::vector<float> velXcol = std::move(tableContent[allColumnNames[3]]);
-    std::vector<float> velYcol = std::move(tableContent[allColumnNames[4]]);
-    std::vector<float> velZcol = std::move(tableContent[allColumnNames[5]]);
-    std::vector<float> parallax = std::move(tableContent[allColumnNames[6]]);
-    std::vector<float> magCol = std::move(tableContent[allColumnNames[7]]);
-    std::vector<float> tycho_b = std::move(tableContent[allColumnNames[8]]);
-    std::vector<float> tycho_v = std::move(tableContent[allColumnNames[9]]);
+    const std::vector<float>& posXcol = cols[0];
+    const std::vector<float>& posYcol = cols[1];
+    const std::vector<float>& posZcol = cols[2];
+    const std::vector<float>& velXcol = cols[3];
+    const std::vector<float>& velYcol = cols[4];
+    const std::vector<float>& velZcol = cols[5];
+    const std::vector<float>& parallax = cols[6];
+    const std::vector<float>& magCol = cols[7];
+    const std::vector<float>& tycho_b = cols[8];
+    const std::vector<float>& tycho_v = cols[9];
 
     // Default filter parameters
     // Additional filter parameters are handled as well but slows down reading
-    std::vector<float> parallax_err = std::move(tableContent[allColumnNames[10]]);
-    std::vector<float> pr_mot_ra = std::move(tableContent[allColumnNames[11]]);
-    std::vector<float> pr_mot_ra_err = std::move(tableContent[allColumnNames[12]]);
-    std::vector<float> pr_mot_dec = std::move(tableContent[allColumnNames[13]]);
-    std::vector<float> pr_mot_dec_err = std::move(tableContent[allColumnNames[14]]);
-    std::vector<float> tycho_b_err = std::move(tableContent[allColumnNames[15]]);
-    std::vector<float> tycho_v_err = std::move(tableContent[allColumnNames[16]]);
+    const std::vector<float>& parallax_err = cols[10];
+    const std::vector<float>& pr_mot_ra = cols[11];
+    const std::vector<float>& pr_mot_ra_err = cols[12];
+    const std::vector<float>& pr_mot_dec = cols[13];
+    const std::vector<float>& pr_mot_dec_err = cols[14];
+    const std::vector<float>& tycho_b_err = cols[15];
+    const std::vector<float>& tycho_v_err = cols[16];
+
+    fullData.reserve(static_cast<size_t>(nStars) * multiplier * nValuesPerStar);
 
     // Construct data array. OBS: ORDERING IS IMPORTANT! This is where slicing happens.
+    std::vector<float> values(nValuesPerStar);
     for (int i = 0; i < nStars * multiplier; ++i) {
-        std::vector<float> values(nValuesPerStar);
+        const int star = i % nStars;
         size_t idx = 0;
 
         // Default order for rendering:
@@ -299,9 +375,9 @@ std::vector<float> FitsFileReader::readFitsFile(std::filesystem::path filePath,
         // Velocity [X, Y, Z]
 
         // Store positions.
-        values[idx++] = posXcol[i % nStars];
-        values[idx++] = posYcol[i % nStars];
-        values[idx++] = posZcol[i % nStars];
+        values[idx++] = posXcol[star];
+        values[idx++] = posYcol[star];
+        values[idx++] = posZcol[star];
 
         // Return early if star doesn't have a measured position.
         if (values[0] == -999 && values[1] == -999 && values[2] == -999) {
@@ -310,39 +386,29 @@ std::vector<float> FitsFileReader::readFitsFile(std::filesystem::path filePath,
         }
 
         // Store color values.
-        values[idx++] = magCol[i % nStars] == -999 ? 20.f : magCol[i % nStars];
-        values[idx++] = tycho_b[i % nStars] - tycho_v[i % nStars];
+        values[idx++] = magCol[star] == -999 ? 20.f : magCol[star];
+        values[idx++] = tycho_b[star] - tycho_v[star];
 
         // Store velocity. Convert it to m/s with help by parallax.
-        values[idx++] = convertMasPerYearToMeterPerSecond(
-            velXcol[i % nStars],
-            parallax[i % nStars]
-        );
-        values[idx++] = convertMasPerYearToMeterPerSecond(
-            velYcol[i % nStars],
-            parallax[i % nStars]
-        );
-        values[idx++] = convertMasPerYearToMeterPerSecond(
-            velZcol[i % nStars],
-            parallax[i % nStars]
-        );
+        values[idx++] = convertMasPerYearToMeterPerSecond(velXcol[star], parallax[star]);
+        values[idx++] = convertMasPerYearToMeterPerSecond(velYcol[star], parallax[star]);
+        values[idx++] = convertMasPerYearToMeterPerSecond(velZcol[star], parallax[star]);
 
         // Store additional parameters to filter by.
-        values[idx++] = parallax[i % nStars];
-        values[idx++] = parallax_err[i % nStars];
-        values[idx++] = pr_mot_ra[i % nStars];
-        values[idx++] = pr_mot_ra_err[i % nStars];
-        values[idx++] = pr_mot_dec[i % nStars];
-        values[idx++] = pr_mot_dec_err[i % nStars];
-        values[idx++] = tycho_b[i % nStars];
-        values[idx++] = tycho_b_err[i % nStars];
-        values[idx++] = tycho_v[i % nStars];
-        values[idx++] = tycho_v_err[i % nStars];
-
-        // Read extra columns, if any. This will slow down the sorting tremendously!
+        values[idx++] = parallax[star];
+        values[idx++] = parallax_err[star];
+        values[idx++] = pr_mot_ra[star];
+        values[idx++] = pr_mot_ra_err[star];
+        values[idx++] = pr_mot_dec[star];
+        values[idx++] = pr_mot_dec_err[star];
+        values[idx++] = tycho_b[star];
+        values[idx++] = tycho_b_err[star];
+        values[idx++] = tycho_v[star];
+        values[idx++] = tycho_v_err[star];
+
+        // Read extra columns, if any
         for (int col = defaultCols; col < nColumnsRead; ++col) {
-            std::vector<float> vecData = std::move(tableContent[allColumnNames[col]]);
-            values[idx++] = vecData[i];
+            values[idx++] = cols[col][star];
         }
 
         for (int j = 0; j < nValuesPerStar; ++j) {
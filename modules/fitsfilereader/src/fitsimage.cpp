@@ -0,0 +1,338 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/fitsfilereader/include/fitsimage.h>
+
+#include <openspace/util/memorymappedfile.h>
+#include <ghoul/fmt.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+#include <ghoul/opengl/texture.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <string_view>
+
+namespace {
+    // FITS files consist of blocks of 2880 bytes and each header is a list of 80
+    // character long keyword records
+    constexpr size_t BlockSize = 2880;
+    constexpr size_t CardSize = 80;
+
+    std::string_view trimmed(std::string_view s) {
+        const size_t begin = s.find_first_not_of(' ');
+        if (begin == std::string_view::npos) {
+            return std::string_view();
+        }
+        const size_t end = s.find_last_not_of(' ');
+        return s.substr(begin, end - begin + 1);
+    }
+
+    struct Header {
+        std::map<std::string, std::string, std::less<>> values;
+        size_t size = 0;
+
+        std::optional<double> number(std::string_view key) const {
+            auto it = values.find(key);
+            if (it == values.end() || it->second.empty()) {
+                return std::nullopt;
+            }
+            try {
+                return std::stod(it->second);
+            }
+            catch (const std::exception&) {
+                return std::nullopt;
+            }
+        }
+
+        std::string string(std::string_view key) const {
+            auto it = values.find(key);
+            if (it == values.end()) {
+                return "";
+            }
+            // Trailing spaces in strings are not significant
+            return std::string(trimmed(it->second));
+        }
+    };
+
+    // Parses the header that starts at the beginning of the provided data. Returns
+    // std::nullopt if the data ends before the END keyword
+    std::optional<Header> parseHeader(const char* data, size_t size) {
+        Header header;
+        for (size_t card = 0; (card + 1) * CardSize <= size; card++) {
+            const std::string_view record(data + card * CardSize, CardSize);
+            const std::string_view keyword = trimmed(record.substr(0, 8));
+            if (keyword == "END") {
+                const size_t end = (card + 1) * CardSize;
+                header.size = (end + BlockSize - 1) / BlockSize * BlockSize;
+                return header;
+            }
+            if (record.substr(8, 2) != "= ") {
+                continue;
+            }
+            std::string_view value = trimmed(record.substr(10));
+            if (value.starts_with('\'')) {
+                // Strings are enclosed in single quotes and might contain a '/'
+                value = value.substr(1, value.find('\'', 1) - 1);
+            }
+            else {
+                value = trimmed(value.substr(0, value.find('/')));
+            }
+            header.values[std::string(keyword)] = std::string(value);
+        }
+        return std::nullopt;
+    }
+
+    // The samples in FITS files are always stored in big endian byte order
+    template <typename T>
+    T readSample(const std::byte* data) {
+        std::array<std::byte, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), data, sizeof(T));
+        if constexpr (std::endian::native == std::endian::little) {
+            std::reverse(bytes.begin(), bytes.end());
+        }
+        return std::bit_cast<T>(bytes);
+    }
+
+    struct Conversion {
+        double bzero = 0.0;
+        double bscale = 1.0;
+        std::optional<long long> blank;
+    };
+
+    template <typename T>
+    void convertRegion(const std::byte* pixels, size_t imageWidth, glm::uvec2 offset,
+                       glm::uvec2 size, unsigned int stride, const Conversion& conv,
+                       float* result)
+    {
+        const size_t width = (size.x + stride - 1) / stride;
+        const size_t height = (size.y + stride - 1) / stride;
+        for (size_t j = 0; j < height; j++) {
+            const size_t y = offset.y + j * stride;
+            const std::byte* row = pixels + (y * imageWidth + offset.x) * sizeof(T);
+            for (size_t i = 0; i < width; i++) {
+                const T raw = readSample<T>(row + i * stride * sizeof(T));
+                bool isBlank = false;
+                if constexpr (std::is_integral_v<T>) {
+                    isBlank = conv.blank == static_cast<long long>(raw);
+                }
+                result[j * width + i] = isBlank ?
+                    std::numeric_limits<float>::quiet_NaN() :
+                    static_cast<float>(conv.bzero + conv.bscale * raw);
+            }
+        }
+    }
+} // namespace
+
+namespace openspace {
+
+FitsImage::FitsImage(std::filesystem::path path)
+    : _path(std::move(path))
+{
+    _mapping = std::make_shared<const MemoryMappedFile>(_path);
+    if (!_mapping->isValid()) {
+        throw ghoul::RuntimeError(fmt::format("Could not map FITS file {}", _path));
+    }
+    // Usually only a region of the image is accessed, so reading ahead of the accessed
+    // pages would mostly read data that is not needed
+    _mapping->advise(MemoryMappedFile::Usage::Random);
+    const size_t fileSize = _mapping->size();
+    const char* data = reinterpret_cast<const char*>(_mapping->data());
+
+    // Find the first HDU that contains an image. The primary HDU of files that store
+    // their images in extensions has no data
+    size_t offset = 0;
+    while (offset < fileSize) {
+        std::optional<Header> header = parseHeader(data + offset, fileSize - offset);
+        if (!header.has_value()) {
+            break;
+        }
+        const size_t dataOffset = offset + header->size;
+
+        const int bitpix = static_cast<int>(header->number("BITPIX").value_or(0));
+        const int nAxis = static_cast<int>(header->number("NAXIS").value_or(0));
+        size_t nSamples = nAxis > 0 ? 1 : 0;
+        for (int i = 1; i <= nAxis; i++) {
+            const std::string key = fmt::format("NAXIS{}", i);
+            nSamples *= static_cast<size_t>(header->number(key).value_or(0));
+        }
+
+        const bool isImage = offset == 0 || header->string("XTENSION") == "IMAGE";
+        if (isImage && (nAxis == 2 || nAxis == 3) && nSamples > 0) {
+            _bitpix = bitpix;
+            _dimensions = glm::uvec2(
+                static_cast<unsigned int>(*header->number("NAXIS1")),
+                static_cast<unsigned int>(*header->number("NAXIS2"))
+            );
+            _bzero = header->number("BZERO").value_or(0.0);
+            _bscale = header->number("BSCALE").value_or(1.0);
+            if (std::optional<double> blank = header->number("BLANK"); blank.has_value())
+            {
+                _blank = static_cast<long long>(*blank);
+            }
+            std::optional<double> min = header->number("DATAMIN");
+            std::optional<double> max = header->number("DATAMAX");
+            if (min.has_value() && max.has_value()) {
+                _valueRange = glm::vec2(*min, *max);
+            }
+
+            const size_t bytes = static_cast<size_t>(std::abs(_bitpix)) / 8;
+            const size_t planeSize = bytes * _dimensions.x * _dimensions.y;
+            if (dataOffset + planeSize > fileSize) {
+                throw ghoul::RuntimeError(fmt::format(
+                    "FITS file {} is truncated", _path
+                ));
+            }
+            _pixels = reinterpret_cast<const std::byte*>(data + dataOffset);
+            break;
+        }
+
+        // Skip the data of this HDU, which might be a table or an empty primary HDU
+        const size_t bytes = static_cast<size_t>(std::abs(bitpix)) / 8;
+        const size_t gCount = static_cast<size_t>(header->number("GCOUNT").value_or(1));
+        const size_t pCount = static_cast<size_t>(header->number("PCOUNT").value_or(0));
+        const size_t dataSize = bytes * gCount * (pCount + nSamples);
+        offset = dataOffset + (dataSize + BlockSize - 1) / BlockSize * BlockSize;
+    }
+
+    const bool hasValidType = _bitpix == 8 || _bitpix == 16 || _bitpix == 32 ||
+        _bitpix == 64 || _bitpix == -32 || _bitpix == -64;
+    if (!_pixels || !hasValidType) {
+        throw ghoul::RuntimeError(fmt::format(
+            "FITS file {} does not contain an uncompressed image", _path
+        ));
+    }
+}
+
+glm::uvec2 FitsImage::dimensions() const {
+    return _dimensions;
+}
+
+std::optional<glm::vec2> FitsImage::valueRange() const {
+    return _valueRange;
+}
+
+ImageData<float> FitsImage::readRegion(glm::uvec2 offset, glm::uvec2 size,
+                                       unsigned int stride) const
+{
+    ghoul_assert(stride > 0, "Stride must be positive");
+    ghoul_assert(
+        offset.x + size.x <= _dimensions.x && offset.y + size.y <= _dimensions.y,
+        "Region must be inside the image"
+    );
+
+    ImageData<float> result;
+    result.width = static_cast<long int>((size.x + stride - 1) / stride);
+    result.height = static_cast<long int>((size.y + stride - 1) / stride);
+    result.contents.resize(static_cast<size_t>(result.width * result.height));
+    if (result.contents.size() == 0) {
+        return result;
+    }
+
+    const Conversion conv = { _bzero, _bscale, _blank };
+    float* dst = &result.contents[0];
+    const size_t w = _dimensions.x;
+    switch (_bitpix) {
+        case 8:
+            convertRegion<uint8_t>(_pixels, w, offset, size, stride, conv, dst);
+            break;
+        case 16:
+            convertRegion<int16_t>(_pixels, w, offset, size, stride, conv, dst);
+            break;
+        case 32:
+            convertRegion<int32_t>(_pixels, w, offset, size, stride, conv, dst);
+            break;
+        case 64:
+            convertRegion<int64_t>(_pixels, w, offset, size, stride, conv, dst);
+            break;
+        case -32:
+            convertRegion<float>(_pixels, w, offset, size, stride, conv, dst);
+            break;
+        case -64:
+            convertRegion<double>(_pixels, w, offset, size, stride, conv, dst);
+            break;
+        default:
+            throw ghoul::MissingCaseException();
+    }
+    return result;
+}
+
+std::unique_ptr<ghoul::opengl::Texture> FitsImage::createTexture(
+                                                                        glm::uvec2 offset,
+                                                                          glm::uvec2 size,
+                                                                      unsigned int stride,
+                                                     std::optional<glm::vec2> range) const
+{
+    ImageData<float> image = readRegion(offset, size, stride);
+    std::valarray<float>& values = image.contents;
+
+    if (!range.has_value()) {
+        range = _valueRange;
+    }
+    if (!range.has_value()) {
+        glm::vec2 r = glm::vec2(
+            std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::lowest()
+        );
+        for (float v : values) {
+            if (!std::isnan(v)) {
+                r.x = std::min(r.x, v);
+                r.y = std::max(r.y, v);
+            }
+        }
+        range = r;
+    }
+
+    const float extent = range->y - range->x;
+    for (float& v : values) {
+        v = (std::isnan(v) || extent <= 0.f) ?
+            0.f :
+            std::clamp((v - range->x) / extent, 0.f, 1.f);
+    }
+
+    auto texture = std::make_unique<ghoul::opengl::Texture>(
+        glm::uvec3(image.width, image.height, 1),
+        GL_TEXTURE_2D,
+        ghoul::opengl::Texture::Format::Red,
+        GL_R32F,
+        GL_FLOAT,
+        ghoul::opengl::Texture::FilterMode::Linear,
+        ghoul::opengl::Texture::WrappingMode::ClampToEdge
+    );
+    if (values.size() > 0) {
+        texture->setPixelData(&values[0], ghoul::opengl::Texture::TakeOwnership::No);
+        texture->uploadTexture();
+    }
+    // The values are owned by the image that goes out of scope here
+    texture->purgeFromRAM();
+    return texture;
+}
+
+} // namespace openspace
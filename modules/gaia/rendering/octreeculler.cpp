@@ -46,14 +46,14 @@ OctreeCuller::OctreeCuller(globebrowsing::AABB3 viewFrustum)
     : _viewFrustum(std::move(viewFrustum))
 {}
 
-bool OctreeCuller::isVisible(const std::vector<glm::dvec4>& corners,
+bool OctreeCuller::isVisible(std::span<const glm::dvec4> corners,
                              const glm::dmat4& mvp)
 {
     createNodeBounds(corners, mvp);
     return intersects(_viewFrustum, _nodeBounds);
 }
 
-glm::vec2 OctreeCuller::getNodeSizeInPixels(const std::vector<glm::dvec4>& corners,
+glm::vec2 OctreeCuller::getNodeSizeInPixels(std::span<const glm::dvec4> corners,
                                             const glm::dmat4& mvp,
                                             const glm::vec2& screenSize)
 {
@@ -66,14 +66,14 @@ glm::vec2 OctreeCuller::getNodeSizeInPixels(const std::vector<glm::dvec4>& corne
     return glm::vec2(size.x * screenSize.x, size.y * screenSize.y);
 }
 
-void OctreeCuller::createNodeBounds(const std::vector<glm::dvec4>& corners,
+void OctreeCuller::createNodeBounds(std::span<const glm::dvec4> corners,
                                     const glm::dmat4& mvp)
 {
     // Create a bounding box in clipping space from node boundaries.
     _nodeBounds = globebrowsing::AABB3();
 
-    for (size_t i = 0; i < 8; ++i) {
-        glm::dvec4 cornerClippingSpace = mvp * corners[i];
+    for (const glm::dvec4& corner : corners) {
+        glm::dvec4 cornerClippingSpace = mvp * corner;
         glm::dvec4 ndc = (1.f / glm::abs(cornerClippingSpace.w)) * cornerClippingSpace;
         expand(_nodeBounds, glm::dvec3(ndc));
     }
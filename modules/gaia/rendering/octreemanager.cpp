@@ -29,11 +29,73 @@
 #include <ghoul/fmt.h>
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <fstream>
+#include <limits>
 #include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "OctreeManager";
+
+    // The number of frames ahead that the camera position is extrapolated to find the
+    // nodes that should be read ahead of time
+    constexpr double PredictionFrames = 30.0;
+
+    // Node files with quantized data start with this value where other node files store
+    // the number of values, which is never negative
+    constexpr int32_t QuantizedNodeFileMarker = -1;
+    constexpr int32_t QuantizedNodeFileVersion = 1;
+
+    // The quantized value that represents a NaN. All other values are mapped linearly
+    // onto [0, MaxQuantizedValue] between the smallest and the largest value of a channel
+    constexpr uint16_t QuantizedNaN = std::numeric_limits<uint16_t>::max();
+    constexpr float MaxQuantizedValue = static_cast<float>(QuantizedNaN - 1);
+
+    struct QuantizationRange {
+        float min = 0.f;
+        float scale = 0.f;
+    };
+
+    // Returns the range of the channel that starts at \p first and contains every
+    // \p stride value of \p values
+    QuantizationRange quantizationRange(const std::vector<float>& values, size_t first,
+                                        size_t stride)
+    {
+        float minValue = std::numeric_limits<float>::max();
+        float maxValue = -std::numeric_limits<float>::max();
+        for (size_t i = first; i < values.size(); i += stride) {
+            if (!std::isnan(values[i])) {
+                minValue = std::min(minValue, values[i]);
+                maxValue = std::max(maxValue, values[i]);
+            }
+        }
+        if (minValue > maxValue) {
+            // Only NaNs in this channel
+            return QuantizationRange();
+        }
+        return { minValue, (maxValue - minValue) / MaxQuantizedValue };
+    }
+
+    uint16_t quantize(float value, const QuantizationRange& range) {
+        if (std::isnan(value)) {
+            return QuantizedNaN;
+        }
+        if (range.scale == 0.f) {
+            return 0;
+        }
+        const float q = std::round((value - range.min) / range.scale);
+        return static_cast<uint16_t>(std::clamp(q, 0.f, MaxQuantizedValue));
+    }
+
+    float dequantize(uint16_t value, const QuantizationRange& range) {
+        if (value == QuantizedNaN) {
+            return std::numeric_limits<float>::quiet_NaN();
+        }
+        return range.min + static_cast<float>(value) * range.scale;
+    }
 } // namespace
 
 namespace openspace {
@@ -45,6 +107,10 @@ void OctreeManager::initOctree(long long cpuRamBudget, int maxDist, int maxStars
     }
 
     LDEBUG("Initializing new Octree");
+    if (_ioThreadPool) {
+        // Don't fetch any nodes that belong to the previous Octree
+        _ioThreadPool->clearTasks();
+    }
     _root = std::make_shared<OctreeNode>();
     _root->octreePositionIndex = 8;
 
@@ -64,6 +130,8 @@ void OctreeManager::initOctree(long long cpuRamBudget, int maxDist, int maxStars
     _maxCpuRamBudget = cpuRamBudget;
     _cpuRamBudget = cpuRamBudget;
     _parentNodeOfCamera = 8;
+    _predictedParentNodeOfCamera = 8;
+    _previousCameraPos = std::nullopt;
 
     if (maxDist > 0) {
         MAX_DIST = static_cast<size_t>(maxDist);
@@ -150,6 +218,15 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
                                           size_t chunkSizeInBytes,
                                           const glm::ivec2& additionalNodes)
 {
+    if (!_ioThreadPool) {
+        // Reading the files is bound by the disk, so a few threads are enough
+        const unsigned int nThreads = std::clamp(
+            std::thread::hardware_concurrency() / 2,
+            2u,
+            8u
+        );
+        _ioThreadPool = std::make_unique<ThreadPool>(nThreads);
+    }
 
     // If entire dataset fits in RAM then load the entire dataset asynchronously now.
     // Nodes will be rendered when they've been made available.
@@ -165,18 +242,69 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
                     continue;
                 }
 
-                // Use multithreading to load files and detach thread from main execution
-                // so it can execute independently. Thread will be destroyed when
-                // finished!
-                std::thread([this, n = _root->Children[i]]() {
+                // Load the files of each branch on the I/O threads
+                _ioThreadPool->enqueue([this, n = _root->Children[i]]() {
                     fetchChildrenNodes(*n, -1);
-                }).detach();
+                });
             }
             _parentNodeOfCamera = 0;
         }
         return;
     }
 
+    // Extrapolate the camera motion and read the nodes around the position the camera
+    // is heading to before they are needed
+    const glm::dvec3 predictedPos = _previousCameraPos.has_value() ?
+        cameraPos + (cameraPos - *_previousCameraPos) * PredictionFrames :
+        cameraPos;
+    _previousCameraPos = cameraPos;
+
+    const unsigned long long firstParentId = firstParentOfPosition(cameraPos);
+    const unsigned long long predictedParentId = firstParentOfPosition(predictedPos);
+
+    // Nothing new has to be fetched if camera resides in the same first parent as
+    // before! Otherwise camera has moved and may need to load more nodes!
+    if (_parentNodeOfCamera != firstParentId) {
+        _parentNodeOfCamera = firstParentId;
+        fetchNeighborhood(firstParentId, additionalNodes, ThreadPool::Priority::Normal);
+    }
+
+    if (predictedParentId != firstParentId &&
+        predictedParentId != _predictedParentNodeOfCamera)
+    {
+        // Only the closest nodes are read ahead as the prediction might be wrong
+        fetchNeighborhood(
+            predictedParentId,
+            glm::ivec2(0, additionalNodes.y),
+            ThreadPool::Priority::Low
+        );
+    }
+    _predictedParentNodeOfCamera = predictedParentId;
+
+    // Check if we should remove any nodes from RAM.
+    long long tenthOfRamBudget = _maxCpuRamBudget / 10;
+    if (_cpuRamBudget < tenthOfRamBudget) {
+        long long bytesToTenthOfRam = tenthOfRamBudget - _cpuRamBudget;
+        size_t nNodesToRemove = static_cast<size_t>(bytesToTenthOfRam / chunkSizeInBytes);
+        std::vector<unsigned long long> nodesToRemove;
+        std::lock_guard g(_leastRecentlyFetchedNodesMutex);
+        while (nNodesToRemove > 0 && !_leastRecentlyFetchedNodes.empty()) {
+            // Dequeue nodes that were least recently fetched by findAndFetchNeighborNode.
+            nodesToRemove.push_back(_leastRecentlyFetchedNodes.front());
+            _leastRecentlyFetchedNodes.pop();
+            nNodesToRemove--;
+        }
+        // Use asynchronous removal, before any other nodes are read.
+        if (!nodesToRemove.empty()) {
+            _ioThreadPool->enqueue(
+                [this, nodesToRemove]() { removeNodesFromRam(nodesToRemove); },
+                ThreadPool::Priority::High
+            );
+        }
+    }
+}
+
+unsigned long long OctreeManager::firstParentOfPosition(const glm::dvec3& cameraPos) {
     // Get leaf node in which the camera resides.
     glm::vec3 fCameraPos = static_cast<glm::vec3>(
         cameraPos / (1000.0 * distanceconstants::Parsec)
@@ -195,15 +323,14 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
         );
         node = node->Children[idx];
     }
-    unsigned long long leafId = node->octreePositionIndex;
-    unsigned long long firstParentId = leafId / 10;
+    return node->octreePositionIndex / 10;
+}
 
-    // Return early if camera resides in the same first parent as before!
-    // Otherwise camera has moved and may need to load more nodes!
-    if (_parentNodeOfCamera == firstParentId) {
-        return;
-    }
-    _parentNodeOfCamera = firstParentId;
+void OctreeManager::fetchNeighborhood(unsigned long long firstParentId,
+                                      const glm::ivec2& additionalNodes,
+                                      ThreadPool::Priority priority)
+{
+    const unsigned long long leafId = firstParentId * 10;
 
     // Each parent level may be root, make sure to propagate it in that case!
     unsigned long long secondParentId = (firstParentId == 8) ? 8 : leafId / 100;
@@ -215,7 +342,7 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
     int additionalLevelsToFetch = additionalNodes.y;
 
     // Get more descendants when closer to root.
-    if (_parentNodeOfCamera < 80000) {
+    if (firstParentId < 80000) {
         additionalLevelsToFetch++;
     }
 
@@ -229,7 +356,8 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
                     x,
                     y,
                     z,
-                    additionalLevelsToFetch
+                    additionalLevelsToFetch,
+                    priority
                 );
                 // Fetch LOD stars from 208 parents one and two layer(s) up.
                 if (x != 0 || y != 0 || z != 0) {
@@ -239,7 +367,8 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
                             x,
                             y,
                             z,
-                            additionalLevelsToFetch
+                            additionalLevelsToFetch,
+                            priority
                         );
                     }
                     if (additionalNodes.x > 1) {
@@ -248,7 +377,8 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
                             x,
                             y,
                             z,
-                            additionalLevelsToFetch
+                            additionalLevelsToFetch,
+                            priority
                         );
                     }
                     if (additionalNodes.x > 2) {
@@ -257,7 +387,8 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
                             x,
                             y,
                             z,
-                            additionalLevelsToFetch
+                            additionalLevelsToFetch,
+                            priority
                         );
                     }
                     if (additionalNodes.x > 3) {
@@ -266,35 +397,19 @@ void OctreeManager::fetchSurroundingNodes(const glm::dvec3& cameraPos,
                             x,
                             y,
                             z,
-                            additionalLevelsToFetch
+                            additionalLevelsToFetch,
+                            priority
                         );
                     }
                 }
             }
         }
     }
-
-    // Check if we should remove any nodes from RAM.
-    long long tenthOfRamBudget = _maxCpuRamBudget / 10;
-    if (_cpuRamBudget < tenthOfRamBudget) {
-        long long bytesToTenthOfRam = tenthOfRamBudget - _cpuRamBudget;
-        size_t nNodesToRemove = static_cast<size_t>(bytesToTenthOfRam / chunkSizeInBytes);
-        std::vector<unsigned long long> nodesToRemove;
-        while (nNodesToRemove > 0) {
-            // Dequeue nodes that were least recently fetched by findAndFetchNeighborNode.
-            nodesToRemove.push_back(_leastRecentlyFetchedNodes.front());
-            _leastRecentlyFetchedNodes.pop();
-            nNodesToRemove--;
-        }
-        // Use asynchronous removal.
-        if (!nodesToRemove.empty()) {
-            std::thread(&OctreeManager::removeNodesFromRam, this, nodesToRemove).detach();
-        }
-    }
 }
 
 void OctreeManager::findAndFetchNeighborNode(unsigned long long firstParentId, int x,
-                                             int y, int z, int additionalLevelsToFetch)
+                                             int y, int z, int additionalLevelsToFetch,
+                                             ThreadPool::Priority priority)
 {
     unsigned long long parentId = firstParentId;
     std::stack<int> indexStack;
@@ -384,23 +499,27 @@ void OctreeManager::findAndFetchNeighborNode(unsigned long long firstParentId, i
         indexStack.pop();
     }
 
-    // Fetch all children nodes from found parent. Use multithreading to load files
-    // asynchronously! Detach thread from main execution so it can execute independently.
-    // Thread will then be destroyed when it has finished!
-    std::thread([this, node, additionalLevelsToFetch]() {
-        fetchChildrenNodes(*node, additionalLevelsToFetch);
-    }).detach();
+    // Fetch all children nodes from found parent on the I/O threads
+    _ioThreadPool->enqueue(
+        [this, node, additionalLevelsToFetch]() {
+            fetchChildrenNodes(*node, additionalLevelsToFetch);
+        },
+        priority
+    );
 }
 
 std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4& mvp,
                                                               const glm::vec2& screenSize,
                                                               int& deltaStars,
                                                               gaia::RenderMode mode,
-                                                              float lodPixelThreshold)
+                                                              float lodPixelThreshold,
+                                                              size_t maxNodeUploads)
 {
     std::map<int, std::vector<float>> renderData;
     bool innerRebuild = false;
     _minTotalPixelsLod = lodPixelThreshold;
+    _limitNodeUploads = maxNodeUploads > 0 && _streamOctree && !_datasetFitInMemory;
+    _remainingNodeUploads = maxNodeUploads;
 
     // Reclaim indices from previous render call.
     for (auto removedKey = _removedKeysInPrevCall.rbegin();
@@ -435,7 +554,7 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
     }
 
     // Check if entire tree is too small to see, and if so remove it.
-    std::vector<glm::dvec4> corners(8);
+    std::array<glm::dvec4, 8> corners;
     float fMaxDist = static_cast<float>(MAX_DIST);
     for (int i = 0; i < 8; ++i) {
         float x = (i % 2 == 0) ? fMaxDist : -fMaxDist;
@@ -452,11 +571,7 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
     if (totalPixels < _minTotalPixelsLod * 2) {
         // Remove LOD from first layer of children.
         for (int i = 0; i < 8; ++i) {
-            std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                *_root->Children[i],
-                deltaStars
-            );
-            renderData.insert(tmpData.begin(), tmpData.end());
+            removeNodeFromCache(*_root->Children[i], deltaStars, renderData);
         }
         return renderData;
     }
@@ -466,12 +581,13 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
             continue;
         }
 
-        std::map<int, std::vector<float>> tmpData = checkNodeIntersection(
+        checkNodeIntersection(
             *_root->Children[i],
             mvp,
             screenSize,
             deltaStars,
-            mode
+            mode,
+            renderData
         );
 
         // Avoid freezing when switching render mode for large datasets by only fetching
@@ -482,9 +598,6 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
             //break;
         }
 
-        // Observe that if there exists identical keys in renderData then those values in
-        // tmpData will be ignored! Thus we store the removed keys until next render call!
-        renderData.insert(tmpData.begin(), tmpData.end());
     }
 
     if (_rebuildBuffer) {
@@ -697,6 +810,26 @@ void OctreeManager::writeToMultipleFiles(const std::string& outFolderPath,
     clearNodeData(*_root->Children[branchIndex]);
 }
 
+void OctreeManager::mergeBranch(OctreeManager& other, size_t branchIndex) {
+    ghoul_assert(branchIndex < 8, "Branch index must be smaller than 8");
+    ghoul_assert(MAX_DIST == other.MAX_DIST, "Octrees must cover the same volume");
+
+    size_t nLeafNodes = 0;
+    size_t nInnerNodes = 0;
+    countNodes(*_root->Children[branchIndex], nLeafNodes, nInnerNodes);
+    _numLeafNodes -= nLeafNodes;
+    _numInnerNodes -= nInnerNodes;
+
+    nLeafNodes = 0;
+    nInnerNodes = 0;
+    countNodes(*other._root->Children[branchIndex], nLeafNodes, nInnerNodes);
+    _numLeafNodes += nLeafNodes;
+    _numInnerNodes += nInnerNodes;
+    _totalDepth = std::max(_totalDepth, other._totalDepth);
+
+    std::swap(_root->Children[branchIndex], other._root->Children[branchIndex]);
+}
+
 void OctreeManager::writeNodeToMultipleFiles(const std::string& outFilePrefix,
                                              OctreeNode& node, bool threadWrites)
 {
@@ -712,7 +845,11 @@ void OctreeManager::writeNodeToMultipleFiles(const std::string& outFilePrefix,
         // Use Morton code to name file (placement in Octree).
         std::string outPath = outFilePrefix + BINARY_SUFFIX;
         std::ofstream outFileStream(outPath, std::ofstream::binary);
-        if (outFileStream.good()) {
+        if (outFileStream.good() && _quantizeNodeFiles) {
+            writeQuantizedNodeData(outFileStream, node);
+            outFileStream.close();
+        }
+        else if (outFileStream.good()) {
             // LINFO("Write " + std::to_string(nDataSize) + " values to " + outPath);
             outFileStream.write(
                 reinterpret_cast<const char*>(&nDataSize),
@@ -758,7 +895,7 @@ void OctreeManager::fetchChildrenNodes(OctreeNode& parentNode,
                                        int additionalLevelsToFetch)
 {
     // Lock node to make sure nobody else are trying to load the same children.
-    std::lock_guard lock(parentNode.loadingLock);
+    std::lock_guard lock(parentNode.fetchingLock);
 
     for (int i = 0; i < 8; ++i) {
         // Fetch node data if we're streaming and it doesn't exist in RAM yet.
@@ -795,22 +932,46 @@ void OctreeManager::fetchNodeDataFromFile(OctreeNode& node) {
         // Otherwise don't call this function!
         inFileStream.read(reinterpret_cast<char*>(&nDataSize), sizeof(int32_t));
 
-        std::vector<float> readData(nDataSize, 0.f);
-        int nBytes = nDataSize * sizeof(readData[0]);
-        if (nDataSize > 0) {
-            inFileStream.read(reinterpret_cast<char*>(&readData[0]), nBytes);
+        std::vector<float> posData;
+        std::vector<float> colData;
+        std::vector<float> velData;
+        if (nDataSize == QuantizedNodeFileMarker) {
+            readQuantizedNodeData(inFileStream, posData, colData, velData);
+            nDataSize = static_cast<int32_t>(
+                posData.size() + colData.size() + velData.size()
+            );
+        }
+        else {
+            // The file contains the positions of all stars followed by all colors and
+            // all velocities, so each block is read directly into the vector that keeps
+            // it
+            size_t starsInNode = nDataSize / _valuesPerStar;
+            posData.resize(starsInNode * POS_SIZE);
+            colData.resize(starsInNode * COL_SIZE);
+            velData.resize(starsInNode * VEL_SIZE);
+            for (std::vector<float>* data : { &posData, &colData, &velData }) {
+                inFileStream.read(
+                    reinterpret_cast<char*>(data->data()),
+                    data->size() * sizeof(float)
+                );
+            }
+        }
+        int nBytes = nDataSize * sizeof(float);
+        if (!inFileStream.good()) {
+            LERROR("Error reading node data file: " + inFilePath);
+            return;
         }
-
-        int starsInNode = static_cast<int>(nDataSize / _valuesPerStar);
-        auto posEnd = readData.begin() + (starsInNode * POS_SIZE);
-        auto colEnd = posEnd + (starsInNode * COL_SIZE);
-        auto velEnd = colEnd + (starsInNode * VEL_SIZE);
-        node.posData = std::vector<float>(readData.begin(), posEnd);
-        node.colData = std::vector<float>(posEnd, colEnd);
-        node.velData = std::vector<float>(colEnd, velEnd);
 
         // Keep track of nodes that are loaded and update CPU RAM budget.
-        node.isLoaded = true;
+        {
+            // Make sure the node isn't checked for its isLoaded flag while the data is
+            // swapped in
+            std::lock_guard lock(node.loadingLock);
+            node.posData = std::move(posData);
+            node.colData = std::move(colData);
+            node.velData = std::move(velData);
+            node.isLoaded = true;
+        }
         if (!_datasetFitInMemory) {
             std::lock_guard g(_leastRecentlyFetchedNodesMutex);
             _leastRecentlyFetchedNodes.push(node.octreePositionIndex);
@@ -822,6 +983,103 @@ void OctreeManager::fetchNodeDataFromFile(OctreeNode& node) {
     }
 }
 
+void OctreeManager::setQuantizeNodeFiles(bool quantize) {
+    _quantizeNodeFiles = quantize;
+}
+
+void OctreeManager::writeQuantizedNodeData(std::ofstream& outFileStream,
+                                           const OctreeNode& node) const
+{
+    const int32_t nStars = static_cast<int32_t>(node.posData.size() / POS_SIZE);
+    outFileStream.write(
+        reinterpret_cast<const char*>(&QuantizedNodeFileMarker),
+        sizeof(int32_t)
+    );
+    outFileStream.write(
+        reinterpret_cast<const char*>(&QuantizedNodeFileVersion),
+        sizeof(int32_t)
+    );
+    outFileStream.write(reinterpret_cast<const char*>(&nStars), sizeof(int32_t));
+
+    // Every component of the positions, colors, and velocities is quantized with its own
+    // range, which is stored in front of the quantized values
+    std::vector<uint16_t> quantized;
+    quantized.reserve(nStars * (POS_SIZE + COL_SIZE + VEL_SIZE));
+    const std::array<std::pair<const std::vector<float>*, size_t>, 3> blocks = {
+        std::pair(&node.posData, POS_SIZE),
+        std::pair(&node.colData, COL_SIZE),
+        std::pair(&node.velData, VEL_SIZE)
+    };
+    for (const auto& [data, nComponents] : blocks) {
+        std::vector<QuantizationRange> ranges(nComponents);
+        for (size_t c = 0; c < nComponents; c++) {
+            ranges[c] = quantizationRange(*data, c, nComponents);
+        }
+        outFileStream.write(
+            reinterpret_cast<const char*>(ranges.data()),
+            ranges.size() * sizeof(QuantizationRange)
+        );
+
+        for (size_t i = 0; i < data->size(); i++) {
+            quantized.push_back(quantize((*data)[i], ranges[i % nComponents]));
+        }
+    }
+    outFileStream.write(
+        reinterpret_cast<const char*>(quantized.data()),
+        quantized.size() * sizeof(uint16_t)
+    );
+}
+
+void OctreeManager::readQuantizedNodeData(std::ifstream& inFileStream,
+                                          std::vector<float>& posData,
+                                          std::vector<float>& colData,
+                                          std::vector<float>& velData) const
+{
+    int32_t version = 0;
+    inFileStream.read(reinterpret_cast<char*>(&version), sizeof(int32_t));
+    if (version != QuantizedNodeFileVersion) {
+        LERROR(fmt::format("Unsupported version {} of quantized node file", version));
+        inFileStream.setstate(std::ios::failbit);
+        return;
+    }
+
+    int32_t nStars = 0;
+    inFileStream.read(reinterpret_cast<char*>(&nStars), sizeof(int32_t));
+
+    std::array<QuantizationRange, 8> ranges;
+    static_assert(ranges.size() == 3 + 2 + 3);
+    inFileStream.read(
+        reinterpret_cast<char*>(ranges.data()),
+        ranges.size() * sizeof(QuantizationRange)
+    );
+
+    std::vector<uint16_t> quantized(nStars * (POS_SIZE + COL_SIZE + VEL_SIZE));
+    inFileStream.read(
+        reinterpret_cast<char*>(quantized.data()),
+        quantized.size() * sizeof(uint16_t)
+    );
+
+    // Decode each block directly into the vector that keeps it
+    size_t offset = 0;
+    size_t firstRange = 0;
+    const std::array<std::pair<std::vector<float>*, size_t>, 3> blocks = {
+        std::pair(&posData, POS_SIZE),
+        std::pair(&colData, COL_SIZE),
+        std::pair(&velData, VEL_SIZE)
+    };
+    for (const auto& [data, nComponents] : blocks) {
+        data->resize(nStars * nComponents);
+        for (size_t i = 0; i < data->size(); i++) {
+            (*data)[i] = dequantize(
+                quantized[offset + i],
+                ranges[firstRange + i % nComponents]
+            );
+        }
+        offset += data->size();
+        firstRange += nComponents;
+    }
+}
+
 void OctreeManager::removeNodesFromRam(
                                      const std::vector<unsigned long long>& nodesToRemove)
 {
@@ -1098,16 +1356,13 @@ std::string OctreeManager::printStarsPerNode(const OctreeNode& node,
     }
 }
 
-std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNode& node,
-                                                                    const glm::dmat4& mvp,
-                                                              const glm::vec2& screenSize,
-                                                                          int& deltaStars,
-                                                                    gaia::RenderMode mode)
+void OctreeManager::checkNodeIntersection(OctreeNode& node, const glm::dmat4& mvp,
+                                          const glm::vec2& screenSize, int& deltaStars,
+                                          gaia::RenderMode mode,
+                                          std::map<int, std::vector<float>>& renderData)
 {
-    std::map<int, std::vector<float>> fetchedData;
-
     // Calculate the corners of the node.
-    std::vector<glm::dvec4> corners(8);
+    std::array<glm::dvec4, 8> corners;
     for (int i = 0; i < 8; ++i) {
         const float x = (i % 2 == 0) ?
             node.originX + node.halfDimension :
@@ -1126,8 +1381,8 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
     if (!(_culler->isVisible(corners, mvp))) {
         // Check if this node or any of its children existed in cache previously.
         // If so, then remove them from cache and add those indices to stack.
-        fetchedData = removeNodeFromCache(node, deltaStars);
-        return fetchedData;
+        removeNodeFromCache(node, deltaStars, renderData);
+        return;
     }
 
     // Remove node if it has been unloaded while still in view.
@@ -1135,8 +1390,8 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
     if (node.bufferIndex != DEFAULT_INDEX && !node.isLoaded && _streamOctree &&
         !_datasetFitInMemory)
     {
-        fetchedData = removeNodeFromCache(node, deltaStars);
-        return fetchedData;
+        removeNodeFromCache(node, deltaStars, renderData);
+        return;
     }
 
     // Take care of inner nodes.
@@ -1156,26 +1411,21 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
             if ((node.bufferIndex == DEFAULT_INDEX) || _rebuildBuffer) {
                 // Return empty if we couldn't claim a buffer stream index.
                 if (!updateBufferIndex(node)) {
-                    return fetchedData;
+                    return;
                 }
 
                 // We're in an inner node, remove indices from potential children in cache
                 for (int i = 0; i < 8; ++i) {
-                    std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                        *node.Children[i],
-                        deltaStars
-                    );
-                    fetchedData.insert(tmpData.begin(), tmpData.end());
+                    removeNodeFromCache(*node.Children[i], deltaStars, renderData);
                 }
 
                 // Insert data and adjust stars added in this frame.
-                fetchedData[node.bufferIndex] = constructInsertData(
-                    node,
-                    mode,
-                    deltaStars
+                renderData.insert_or_assign(
+                    node.bufferIndex,
+                    constructInsertData(node, mode, deltaStars)
                 );
             }
-            return fetchedData;
+            return;
         }
     }
     // Return node data if node is a leaf.
@@ -1184,45 +1434,39 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
         if ((node.bufferIndex == DEFAULT_INDEX) || _rebuildBuffer) {
             // Return empty if we couldn't claim a buffer stream index.
             if (!updateBufferIndex(node)) {
-                return fetchedData;
+                return;
             }
 
             // Insert data and adjust stars added in this frame.
-            fetchedData[node.bufferIndex] = constructInsertData(
-                node,
-                mode,
-                deltaStars
+            renderData.insert_or_assign(
+                node.bufferIndex,
+                constructInsertData(node, mode, deltaStars)
             );
         }
-        return fetchedData;
+        return;
     }
 
     // We're in a big, visible inner node -> remove it from cache if it existed.
     // But not its children -> set recursive check to false.
-    fetchedData = removeNodeFromCache(node, deltaStars, false);
+    removeNodeFromCache(node, deltaStars, renderData, false);
 
     // Recursively check if children should be rendered.
     for (size_t i = 0; i < 8; ++i) {
-        // Observe that if there exists identical keys in fetchedData then those values in
-        // tmpData will be ignored! Thus we store the removed keys until next render call!
-        std::map<int, std::vector<float>> tmpData = checkNodeIntersection(
+        checkNodeIntersection(
             *node.Children[i],
             mvp,
             screenSize,
             deltaStars,
-            mode
+            mode,
+            renderData
         );
-        fetchedData.insert(tmpData.begin(), tmpData.end());
     }
-    return fetchedData;
 }
 
-std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode& node,
-                                                                     int& deltaStars,
-                                                                     bool recursive)
+void OctreeManager::removeNodeFromCache(OctreeNode& node, int& deltaStars,
+                                        std::map<int, std::vector<float>>& renderData,
+                                        bool recursive)
 {
-    std::map<int, std::vector<float>> keysToRemove;
-
     // If we're in rebuilding mode then there is no need to remove any nodes.
     //if (_rebuildBuffer) return keysToRemove;
 
@@ -1232,8 +1476,10 @@ std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode&
         // Reclaim that index. We need to wait until next render call to use it again!
         _removedKeysInPrevCall.insert(node.bufferIndex);
 
-        // Insert dummy node at offset index that should be removed from render.
-        keysToRemove[node.bufferIndex] = std::vector<float>();
+        // Insert dummy node at offset index that should be removed from render. Observe
+        // that an existing entry for the same index is not overwritten! Thus we store the
+        // removed keys until next render call!
+        renderData.try_emplace(node.bufferIndex);
 
         // Reset index and adjust stars removed this frame.
         node.bufferIndex = DEFAULT_INDEX;
@@ -1243,14 +1489,9 @@ std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode&
     // Check children recursively if we're in an inner node.
     if (!(node.isLeaf) && recursive) {
         for (int i = 0; i < 8; ++i) {
-            std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                *node.Children[i],
-                deltaStars
-            );
-            keysToRemove.insert(tmpData.begin(), tmpData.end());
+            removeNodeFromCache(*node.Children[i], deltaStars, renderData);
         }
     }
-    return keysToRemove;
 }
 
 std::vector<float> OctreeManager::getNodeData(const OctreeNode& node,
@@ -1329,6 +1570,20 @@ void OctreeManager::createNodeChildren(OctreeNode& node) {
     _numInnerNodes++;
 }
 
+void OctreeManager::countNodes(const OctreeNode& node, size_t& nLeafNodes,
+                               size_t& nInnerNodes) const
+{
+    if (node.isLeaf) {
+        nLeafNodes++;
+        return;
+    }
+
+    nInnerNodes++;
+    for (size_t i = 0; i < 8; ++i) {
+        countNodes(*node.Children[i], nLeafNodes, nInnerNodes);
+    }
+}
+
 bool OctreeManager::updateBufferIndex(OctreeNode& node) {
     if (node.bufferIndex != DEFAULT_INDEX) {
         // If we're rebuilding Buffer Index Cache then store indices to overwrite later.
@@ -1346,6 +1601,15 @@ bool OctreeManager::updateBufferIndex(OctreeNode& node) {
         return false;
     }
 
+    // Defer new nodes to the next render call if the upload budget has been used up.
+    // Nodes that are moved while rebuilding the buffer are not affected
+    if (_limitNodeUploads && !_rebuildBuffer) {
+        if (_remainingNodeUploads == 0) {
+            return false;
+        }
+        _remainingNodeUploads--;
+    }
+
     // Get correct insert index from stack.
     node.bufferIndex = _freeSpotsInBuffer.top();
     _freeSpotsInBuffer.pop();
@@ -26,10 +26,12 @@
 #define __OPENSPACE_MODULE_GAIA___OCTREEMANAGER___H__
 
 #include <modules/gaia/rendering/gaiaoptions.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/glm.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <stack>
 #include <vector>
@@ -55,6 +57,10 @@ public:
         bool isLoaded;
         bool hasLoadedDescendant;
         std::mutex loadingLock;
+        // Held while the children of this node are fetched from disk so that they are
+        // only fetched once. Separate from the loadingLock so that the render thread is
+        // never blocked by file I/O
+        std::mutex fetchingLock;
         int bufferIndex;
         unsigned long long octreePositionIndex;
     };
@@ -104,6 +110,9 @@ public:
      * unloaded. If entire dataset fits in RAM then the whole dataset will be loaded
      * asynchronously. Otherwise only nodes close to the camera will be fetched.
      * When RAM stars to fill up least-recently used nodes will start to unload.
+     * The nodes are read on background I/O threads. The nodes around the position that
+     * the camera is predicted to reach based on its current motion are read ahead of
+     * time with a lower priority.
      * Calls `findAndFetchNeighborNode()` and `removeNodesFromRam()` internally.
      */
     void fetchSurroundingNodes(const glm::dvec3& cameraPos, size_t chunkSizeInBytes,
@@ -115,11 +124,13 @@ public:
      * The corresponding integer key is the index where chunk should be inserted into
      * streaming buffer. Calls `checkNodeIntersection()` for every branch.
      * \pdeltaStars keeps track of how many stars that were added/removed this render
-     * call.
+     * call. If \p maxNodeUploads is not 0 and nodes are streamed from files, at most
+     * that many nodes are newly inserted into the streaming buffer per call and the
+     * remaining nodes are inserted in the following calls.
      */
     std::map<int, std::vector<float>> traverseData(const glm::dmat4& mvp,
         const glm::vec2& screenSize, int& deltaStars, gaia::RenderMode mode,
-        float lodPixelThreshold);
+        float lodPixelThreshold, size_t maxNodeUploads = 0);
 
     /**
      * Builds full render data structure by traversing all leaves in the Octree.
@@ -157,6 +168,22 @@ public:
      */
     void writeToMultipleFiles(const std::string& outFolderPath, size_t branchIndex);
 
+    /**
+     * Sets whether `writeToMultipleFiles()` stores the star data quantized to 16 bits
+     * per value. Each component is mapped linearly onto the range of values within the
+     * node, which halves the size of the files. Quantized files are detected and decoded
+     * automatically when they are streamed.
+     */
+    void setQuantizeNodeFiles(bool quantize);
+
+    /**
+     * Replaces the branch with index \p branchIndex with the corresponding branch of
+     * \p other, which has to be initialized with the same maximum distance. The node
+     * counters and the depth of the Octree are updated accordingly. Used to combine
+     * branches that have been constructed in separate Octrees.
+     */
+    void mergeBranch(OctreeManager& other, size_t branchIndex);
+
     /**
      * Getters.
      */
@@ -235,25 +262,41 @@ private:
     std::string printStarsPerNode(const OctreeNode& node,
         const std::string& prefix) const;
 
+    /**
+     * \returns the index of the parent of the leaf node in which the position
+     *          \p cameraPos is located.
+     */
+    unsigned long long firstParentOfPosition(const glm::dvec3& cameraPos);
+
+    /**
+     * Fetches the nodes around the leaf node with the parent \p firstParentId with the
+     * \p priority. See `fetchSurroundingNodes()` for the meaning of
+     * \p additionalNodes.
+     */
+    void fetchNeighborhood(unsigned long long firstParentId,
+        const glm::ivec2& additionalNodes, ThreadPool::Priority priority);
+
     /**
      * Private help function for `traverseData()`. Recursively checks which
      * nodes intersect with the view frustum (interpreted as an AABB) and decides if data
      * should be optimized away or not. Keeps track of which nodes that are visible and
      * loaded (if streaming). \param deltaStars keeps track of how many stars that were
-     * added/removed this render call.
+     * added/removed this render call. The data of the nodes that should be inserted or
+     * removed is added directly to \p renderData.
      */
-    std::map<int, std::vector<float>> checkNodeIntersection(OctreeNode& node,
-        const glm::dmat4& mvp, const glm::vec2& screenSize, int& deltaStars,
-        gaia::RenderMode mode);
+    void checkNodeIntersection(OctreeNode& node, const glm::dmat4& mvp,
+        const glm::vec2& screenSize, int& deltaStars, gaia::RenderMode mode,
+        std::map<int, std::vector<float>>& renderData);
 
     /**
      * Checks if specified node existed in cache, and removes it if that's the case.
      * If node is an inner node then all children will be checked recursively as well as
      * long as \param recursive is not set to false. \param deltaStars keeps track of how
-     * many stars that were removed.
+     * many stars that were removed. An empty entry is added to \p renderData for every
+     * removed node unless it already contains an entry for that index.
      */
-    std::map<int, std::vector<float>> removeNodeFromCache(OctreeNode& node,
-        int& deltaStars, bool recursive = true);
+    void removeNodeFromCache(OctreeNode& node, int& deltaStars,
+        std::map<int, std::vector<float>>& renderData, bool recursive = true);
 
     /**
      * Get data in node and its descendants regardless if they are visible or not.
@@ -270,6 +313,12 @@ private:
      */
     void createNodeChildren(OctreeNode& node);
 
+    /**
+     * Counts the number of leaf and inner nodes in the subtree of \p node.
+     */
+    void countNodes(const OctreeNode& node, size_t& nLeafNodes,
+        size_t& nInnerNodes) const;
+
     /**
      * Checks if node should be inserted into stream or not. \returns true if it should,
      * (i.e. it doesn't already exists, there is room for it in the buffer and node data
@@ -309,14 +358,30 @@ private:
     void writeNodeToMultipleFiles(const std::string& outFilePrefix, OctreeNode& node,
         bool threadWrites);
 
+    /**
+     * Writes the data of \p node in the quantized format to \p outFileStream.
+     */
+    void writeQuantizedNodeData(std::ofstream& outFileStream,
+        const OctreeNode& node) const;
+
+    /**
+     * Reads the data of a node in the quantized format from \p inFileStream, after the
+     * marker at the beginning of the file has been read, and decodes it directly into
+     * \p posData, \p colData, and \p velData.
+     */
+    void readQuantizedNodeData(std::ifstream& inFileStream, std::vector<float>& posData,
+        std::vector<float>& colData, std::vector<float>& velData) const;
+
     /**
      * Finds the neighboring node on the same level (or a higher level if there is no
      * corresponding level) in the specified direction. Also fetches data from found node
      * if it's not already loaded. \param additionalLevelsToFetch determines if any
-     * descendants of the found node should be fetched as well (if they exists).
+     * descendants of the found node should be fetched as well (if they exists). The data
+     * is fetched on the I/O threads with the provided \p priority.
      */
     void findAndFetchNeighborNode(unsigned long long firstParentId, int x, int y, int z,
-        int additionalLevelsToFetch);
+        int additionalLevelsToFetch,
+        ThreadPool::Priority priority = ThreadPool::Priority::Normal);
 
     /**
      * Fetches data from all children of \param parentNode, as long as it's not already
@@ -374,12 +439,25 @@ private:
     bool _useVBO = false;
     bool _streamOctree = false;
     bool _datasetFitInMemory = false;
+    bool _quantizeNodeFiles = false;
     long long _cpuRamBudget = 0;
     long long _maxCpuRamBudget = 0;
     unsigned long long _parentNodeOfCamera = 8;
     std::string _streamFolderPath;
     size_t _traversedBranchesInRenderCall = 0;
 
+    // Used to predict where the camera will be when streaming nodes
+    std::optional<glm::dvec3> _previousCameraPos;
+    unsigned long long _predictedParentNodeOfCamera = 8;
+
+    // The number of nodes that can still be inserted into the buffer in this render call
+    size_t _remainingNodeUploads = 0;
+    bool _limitNodeUploads = false;
+
+    // The threads on which nodes are read from files. This is the last member so that
+    // all tasks are finished before any of the other members are destroyed
+    std::unique_ptr<ThreadPool> _ioThreadPool;
+
 }; // class OctreeManager
 
 }  // namespace openspace
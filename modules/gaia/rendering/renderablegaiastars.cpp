@@ -43,6 +43,7 @@
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/systemcapabilities/generalcapabilitiescomponent.h>
+#include <algorithm>
 #include <array>
 #include <fstream>
 #include <cstdint>
@@ -183,6 +184,15 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo MaxNodeUploadsInfo = {
+        "MaxNodeUploadsPerFrame",
+        "Max Node Uploads Per Frame",
+        "The maximum number of nodes that are uploaded to the GPU in a single frame "
+        "while streaming nodes from disk. Nodes above this limit are uploaded in the "
+        "following frames. A value of 0 means that there is no limit",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo TmPointPxThresholdInfo = {
         "PixelWeightThreshold",
         "Pixel Weight Threshold",
@@ -408,6 +418,9 @@ namespace {
         // [codegen::verbatim(AdditionalNodesInfo.description)]]
         std::optional<glm::ivec2> additionalNodes;
 
+        // [codegen::verbatim(MaxNodeUploadsInfo.description)]]
+        std::optional<int> maxNodeUploadsPerFrame [[codegen::greaterequal(0)]];
+
         // [codegen::verbatim(TmPointPxThresholdInfo.description)]]
         std::optional<float> pixelWeightThreshold;
 
@@ -473,6 +486,7 @@ RenderableGaiaStars::RenderableGaiaStars(const ghoul::Dictionary& dictionary)
     , _tmPointFilterSize(TmPointFilterSizeInfo, 7, 1, 19)
     , _tmPointSigma(TmPointSigmaInfo, 0.7f, 0.1f, 3.f)
     , _additionalNodes(AdditionalNodesInfo, glm::ivec2(1), glm::ivec2(0), glm::ivec2(4))
+    , _maxNodeUploads(MaxNodeUploadsInfo, 32, 0, 1024)
     , _tmPointPixelWeightThreshold(TmPointPxThresholdInfo, 0.001f, 0.000001f, 0.01f)
     , _lodPixelThreshold(LodPixelThresholdInfo, 250.f, 0.f, 5000.f)
     , _posXThreshold(FilterPosXInfo, glm::vec2(0.f), glm::vec2(-10.f), glm::vec2(10.f))
@@ -590,6 +604,7 @@ RenderableGaiaStars::RenderableGaiaStars(const ghoul::Dictionary& dictionary)
     _tmPointPixelWeightThreshold =
         p.pixelWeightThreshold.value_or(_tmPointPixelWeightThreshold);
     _additionalNodes = p.additionalNodes.value_or(_additionalNodes);
+    _maxNodeUploads = p.maxNodeUploadsPerFrame.value_or(_maxNodeUploads);
     _lodPixelThreshold = p.lodPixelThreshold.value_or(_lodPixelThreshold);
 
     _maxGpuMemoryPercent = p.maxGpuMemoryPercent.value_or(_maxGpuMemoryPercent);
@@ -1003,7 +1018,8 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
         screenSize,
         deltaStars,
         gaia::RenderMode(renderOption),
-        _lodPixelThreshold
+        _lodPixelThreshold,
+        static_cast<size_t>(_maxNodeUploads)
     );
 
     // Update number of rendered stars.
@@ -1385,6 +1401,32 @@ void RenderableGaiaStars::checkGlErrors(const std::string& identifier) const {
     }
 }
 
+Renderable::MemoryUsage RenderableGaiaStars::memoryUsage() const {
+    MemoryUsage usage;
+    usage.gpuBuffers = bufferMemory(_vboPos) + bufferMemory(_vboCol) +
+        bufferMemory(_vboVel) + bufferMemory(_ssboIdx) + bufferMemory(_ssboData) +
+        bufferMemory(_vboQuad);
+    usage.gpuTextures = textureMemory(_pointSpreadFunctionTexture.get()) +
+        textureMemory(_colorTexture.get()) + textureMemory(_fboTexture.get());
+    // The octree keeps track of the CPU budget that is left for its nodes
+    const long long remaining = _octreeManager.cpuRamBudget();
+    usage.cpuData = static_cast<size_t>(
+        std::max(_cpuRamBudgetInBytes - remaining, 0LL)
+    );
+    return usage;
+}
+
+bool RenderableGaiaStars::reduceMemoryUsage() {
+    // Lowering the share of the GPU memory shrinks the streaming buffers, which are
+    // recreated with the new budget in the next update
+    constexpr float MinGpuMemoryPercent = 0.05f;
+    if (_maxGpuMemoryPercent <= MinGpuMemoryPercent) {
+        return false;
+    }
+    _maxGpuMemoryPercent = std::max(_maxGpuMemoryPercent * 0.75f, MinGpuMemoryPercent);
+    return true;
+}
+
 void RenderableGaiaStars::update(const UpdateData&) {
     const int shaderOption = _shaderOption;
     const int renderOption = _renderMode;
@@ -1749,9 +1791,11 @@ void RenderableGaiaStars::update(const UpdateData&) {
 
         if (!datasetFitInMemory && !hasProperty(&_additionalNodes)) {
             addProperty(_additionalNodes);
+            addProperty(_maxNodeUploads);
         }
         else if (hasProperty(&_additionalNodes)) {
             removeProperty(_additionalNodes);
+            removeProperty(_maxNodeUploads);
         }
 
         LDEBUG(fmt::format(
@@ -63,6 +63,9 @@ public:
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
 
+    MemoryUsage memoryUsage() const override;
+    bool reduceMemoryUsage() override;
+
     static documentation::Documentation Documentation();
 
 private:
@@ -140,6 +143,7 @@ private:
     properties::IntProperty _tmPointFilterSize;
     properties::FloatProperty _tmPointSigma;
     properties::IVec2Property _additionalNodes;
+    properties::IntProperty _maxNodeUploads;
     properties::FloatProperty _tmPointPixelWeightThreshold;
     properties::FloatProperty _lodPixelThreshold;
 
@@ -30,8 +30,12 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionary.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <thread>
 
 namespace {
@@ -59,6 +63,23 @@ namespace {
         // folder and output multiple files for the Octree
         std::optional<bool> singleFileInput;
 
+        // If true then the star data in the multiple output files is quantized to 16
+        // bits per value relative to the range of values within each node, which halves
+        // the size of the files at a small loss of precision. This has no effect if
+        // SingleFileInput is set to true
+        std::optional<bool> quantizeData;
+
+        // The maximum number of branches that are constructed in parallel if the input is
+        // a folder. Defaults to the number of hardware threads, but at most 8
+        std::optional<int> maxThreads [[codegen::greater(0)]];
+
+        // The approximate amount of memory in MB that may be used for constructing
+        // branches in parallel, estimated by the sizes of the input files. A branch is
+        // only started while the in-progress branches stay within this budget, but at
+        // least one branch is always constructed. If this value is 0, no limit is
+        // applied. This has no effect if SingleFileInput is set to true
+        std::optional<int> memoryBudget [[codegen::greaterequal(0)]];
+
         // If defined then only stars with Position X values between [min, max] will be
         // inserted into Octree (if min is set to 0.0 it is read as -Inf, if max is set to
         // 0.0 it is read as +Inf). If min = max then all values equal min|max will be
@@ -216,6 +237,11 @@ ConstructOctreeTask::ConstructOctreeTask(const ghoul::Dictionary& dictionary) {
     _maxDist = p.maxDist.value_or(_maxDist);
     _maxStarsPerNode = p.maxStarsPerNode.value_or(_maxStarsPerNode);
     _singleFileInput = p.singleFileInput.value_or(_singleFileInput);
+    _quantizeData = p.quantizeData.value_or(_quantizeData);
+    _maxThreads = p.maxThreads.value_or(
+        std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 8)
+    );
+    _memoryBudget = p.memoryBudget.value_or(_memoryBudget);
 
     _octreeManager = std::make_shared<OctreeManager>();
     _indexOctreeManager = std::make_shared<OctreeManager>();
@@ -301,6 +327,14 @@ std::string ConstructOctreeTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> ConstructOctreeTask::inputFiles() const {
+    return { _inFileOrFolderPath };
+}
+
+std::vector<std::filesystem::path> ConstructOctreeTask::outputFiles() const {
+    return { _outFileOrFolderPath };
+}
+
 void ConstructOctreeTask::perform(const Task::ProgressCallback& onProgress) {
     onProgress(0.f);
 
@@ -434,162 +468,120 @@ void ConstructOctreeTask::constructOctreeFromSingleFile(
 void ConstructOctreeTask::constructOctreeFromFolder(
                                            const Task::ProgressCallback& progressCallback)
 {
-    int32_t nStars = 0;
-    int32_t nValuesPerStar = 0;
-    size_t nFilteredStars = 0;
-    //float maxRadius = 0.0;
-    //int starsOutside10 = 0;
-    //int starsOutside25 = 0;
-    //int starsOutside50 = 0;
-    //int starsOutside75 = 0;
-    //int starsOutside100 = 0;
-    //int starsOutside200 = 0;
-    //int starsOutside300 = 0;
-    //int starsOutside400 = 0;
-    //int starsOutside500 = 0;
-    //int starsOutside750 = 0;
-    //int starsOutside1000 = 0;
-    //int starsOutside1500 = 0;
-    //int starsOutside2000 = 0;
-    //int starsOutside5000 = 0;
-
     std::vector<std::filesystem::path> allInputFiles;
     if (std::filesystem::is_directory(_inFileOrFolderPath)) {
         namespace fs = std::filesystem;
         for (const fs::directory_entry& e : fs::directory_iterator(_inFileOrFolderPath)) {
-            if (!e.is_regular_file()) {
+            if (e.is_regular_file()) {
                 allInputFiles.push_back(e.path());
             }
         }
     }
 
-    std::vector<float> filterValues;
-    auto writeThreads = std::vector<std::thread>(8);
+    if (allInputFiles.size() > 8) {
+        LWARNING(fmt::format(
+            "Found {} input files but the Octree only has 8 branches. Only the first 8 "
+            "files are used", allInputFiles.size()
+        ));
+        allInputFiles.resize(8);
+    }
 
     _indexOctreeManager->initOctree(0, _maxDist, _maxStarsPerNode);
-
-    float processOneFile = 1.f / allInputFiles.size();
+    _indexOctreeManager->setQuantizeNodeFiles(_quantizeData);
 
     LINFO(fmt::format(
         "MAX DIST: {} - MAX STARS PER NODE: {}",
         _indexOctreeManager->maxDist(), _indexOctreeManager->maxStarsPerNode()
     ));
 
-    for (size_t idx = 0; idx < allInputFiles.size(); ++idx) {
-        std::filesystem::path inFilePath = allInputFiles[idx];
-        int nStarsInfile = 0;
-
-        LINFO(fmt::format("Reading data file: {}", inFilePath));
-
-        std::ifstream inFileStream(inFilePath, std::ifstream::binary);
-        if (inFileStream.good()) {
-            inFileStream.read(reinterpret_cast<char*>(&nValuesPerStar), sizeof(int32_t));
-            filterValues.resize(nValuesPerStar, 0.f);
+    // Each input file contains the stars of one branch, so the branches are built in
+    // parallel, each in its own Octree, and written to disk independently. Only the
+    // structure of the branches remains in memory afterwards, which is then merged into
+    // the index Octree
+    const size_t nFiles = allInputFiles.size();
+    std::vector<std::unique_ptr<OctreeManager>> branchOctrees(nFiles);
+    std::vector<uintmax_t> fileSizes(nFiles, 0);
+    for (size_t idx = 0; idx < nFiles; ++idx) {
+        std::error_code ec;
+        fileSizes[idx] = std::filesystem::file_size(allInputFiles[idx], ec);
+    }
 
-            while (inFileStream.read(
-                reinterpret_cast<char*>(filterValues.data()),
-                nValuesPerStar * sizeof(filterValues[0])
-            ))
+    // The size of the input file is used as the estimate for how much memory is needed
+    // to build a branch. A branch is always started if no other branch is built, even
+    // if it doesn't fit into the budget
+    const uintmax_t memoryBudget = static_cast<uintmax_t>(_memoryBudget) * 1024 * 1024;
+    std::mutex mutex;
+    std::condition_variable branchFinished;
+    size_t nextFile = 0;
+    size_t nFinishedFiles = 0;
+    uintmax_t bytesInProgress = 0;
+
+    std::atomic<int32_t> nStars = 0;
+    std::atomic<size_t> nFilteredStars = 0;
+
+    auto buildBranches = [&]() {
+        while (true) {
+            size_t idx = 0;
             {
-                // Filter data by parameters.
-                if (checkAllFilters(filterValues)) {
-                    nFilteredStars++;
-                    continue;
+                std::unique_lock lock(mutex);
+                branchFinished.wait(lock, [&]() {
+                    return nextFile >= nFiles || bytesInProgress == 0 ||
+                        memoryBudget == 0 ||
+                        bytesInProgress + fileSizes[nextFile] <= memoryBudget;
+                });
+                if (nextFile >= nFiles) {
+                    return;
                 }
-                // Generate a 50/12,5 dataset (gMag <=13/>13).
-                //if ((filterStar(glm::vec2(20.0), filterValues[3], 20.f)) ||
-                //    (filterStar(glm::vec2(0.0), filterValues[16])) ||
-                //    (filterValues[3] > 13.0 && filterValues[17] > 0.125) ||
-                //    (filterValues[3] <= 13.0 && filterValues[17] > 0.5)) {
-                //    nFilteredStars++;
-                //    continue;
-                //}
-
-                // If all filters passed then insert render values into Octree.
-                std::vector<float> renderValues(
-                    filterValues.begin(),
-                    filterValues.begin() + RENDER_VALUES
-                );
-
-                _indexOctreeManager->insert(renderValues);
-                nStarsInfile++;
-
-                //float maxVal = fmax(fmax(fabs(renderValues[0]), fabs(renderValues[1])),
-                //    fabs(renderValues[2]));
-                //if (maxVal > maxRadius) maxRadius = maxVal;
-                //// Calculate how many stars are outside of different thresholds.
-                //if (maxVal > 10) starsOutside10++;
-                //if (maxVal > 25) starsOutside25++;
-                //if (maxVal > 50) starsOutside50++;
-                //if (maxVal > 75) starsOutside75++;
-                //if (maxVal > 100) starsOutside100++;
-                //if (maxVal > 200) starsOutside200++;
-                //if (maxVal > 300) starsOutside300++;
-                //if (maxVal > 400) starsOutside400++;
-                //if (maxVal > 500) starsOutside500++;
-                //if (maxVal > 750) starsOutside750++;
-                //if (maxVal > 1000) starsOutside1000++;
-                //if (maxVal > 1500) starsOutside1500++;
-                //if (maxVal > 2000) starsOutside2000++;
-                //if (maxVal > 5000) starsOutside5000++;
+                idx = nextFile;
+                nextFile++;
+                bytesInProgress += fileSizes[idx];
             }
-            inFileStream.close();
-        }
-        else {
-            LERROR(fmt::format(
-                "Error opening file {} for loading preprocessed file", inFilePath
-            ));
-        }
 
-        // Slice LOD data.
-        LINFO("Slicing LOD data");
-        _indexOctreeManager->sliceLodData(idx);
+            std::unique_ptr<OctreeManager> octree = std::make_unique<OctreeManager>();
+            octree->initOctree(0, _maxDist, _maxStarsPerNode);
+            octree->setQuantizeNodeFiles(_quantizeData);
 
-        progressCallback((idx + 1) * processOneFile);
-        nStars += nStarsInfile;
+            const auto [nStarsInFile, nFilteredInFile] = constructBranchFromFile(
+                allInputFiles[idx],
+                idx,
+                *octree
+            );
+            nStars += nStarsInFile;
+            nFilteredStars += nFilteredInFile;
+            branchOctrees[idx] = std::move(octree);
 
-        LINFO(fmt::format("Writing {} stars to octree files", nStarsInfile));
-        LINFO(fmt::format(
-            "Number leaf nodes: {}\n Number inner nodes: {}\n Total depth of tree: {}",
-            _indexOctreeManager->numLeafNodes(),
-            _indexOctreeManager->numInnerNodes(),
-            _indexOctreeManager->totalDepth()
-        ));
+            {
+                std::lock_guard lock(mutex);
+                bytesInProgress -= fileSizes[idx];
+                nFinishedFiles++;
+                progressCallback(static_cast<float>(nFinishedFiles) / nFiles);
+            }
+            branchFinished.notify_all();
+        }
+    };
 
-        // Write to 8 separate files in a separate thread. Data will be cleared after it
-        // has been written. Store joinable thread for later sync.
-        std::thread t(
-            &OctreeManager::writeToMultipleFiles,
-            _indexOctreeManager,
-            _outFileOrFolderPath.string(),
-            idx
-        );
-        writeThreads[idx] = std::move(t);
+    const size_t nThreads = std::min<size_t>(_maxThreads, nFiles);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < nThreads; ++i) {
+        workers.emplace_back(buildBranches);
+    }
+    // The calling thread builds branches as well
+    buildBranches();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // Merge the structure of all branches into the index Octree
+    for (size_t idx = 0; idx < nFiles; ++idx) {
+        _indexOctreeManager->mergeBranch(*branchOctrees[idx], idx);
     }
 
     LINFO(fmt::format(
         "A total of {} stars were read from files and distributed into {} total nodes",
-        nStars, _indexOctreeManager->totalNodes()
+        nStars.load(), _indexOctreeManager->totalNodes()
     ));
     LINFO(std::to_string(nFilteredStars) + " stars were filtered");
 
-    //LINFO("Max radius of dataset is: " + std::to_string(maxRadius) +
-    //    "\n Number of stars outside of:" +
-    //    " - 10kPc is " + std::to_string(starsOutside10) + "\n" +
-    //    " - 25kPc is " + std::to_string(starsOutside25) + "\n" +
-    //    " - 50kPc is " + std::to_string(starsOutside50) + "\n" +
-    //    " - 75kPc is " + std::to_string(starsOutside75) + "\n" +
-    //    " - 100kPc is " + std::to_string(starsOutside100) + "\n" +
-    //    " - 200kPc is " + std::to_string(starsOutside200) + "\n" +
-    //    " - 300kPc is " + std::to_string(starsOutside300) + "\n" +
-    //    " - 400kPc is " + std::to_string(starsOutside400) + "\n" +
-    //    " - 500kPc is " + std::to_string(starsOutside500) + "\n" +
-    //    " - 750kPc is " + std::to_string(starsOutside750) + "\n" +
-    //    " - 1000kPc is " + std::to_string(starsOutside1000) + "\n" +
-    //    " - 1500kPc is " + std::to_string(starsOutside1500) + "\n" +
-    //    " - 2000kPc is " + std::to_string(starsOutside2000) + "\n" +
-    //    " - 5000kPc is " + std::to_string(starsOutside5000));
-
     // Write index file of Octree structure.
     std::filesystem::path indexFileOutPath = fmt::format(
         "{}/index.bin", _outFileOrFolderPath.string()
@@ -606,11 +598,71 @@ void ConstructOctreeTask::constructOctreeFromFolder(
             "Error opening file: {} as index output file", indexFileOutPath
         ));
     }
+}
+
+std::pair<int32_t, size_t> ConstructOctreeTask::constructBranchFromFile(
+                                                 const std::filesystem::path& inFilePath,
+                                                                      size_t branchIndex,
+                                                            OctreeManager& octreeManager)
+{
+    int32_t nStarsInFile = 0;
+    size_t nFilteredStars = 0;
+
+    LINFO(fmt::format("Reading data file: {}", inFilePath));
+
+    std::ifstream inFileStream(inFilePath, std::ifstream::binary);
+    if (inFileStream.good()) {
+        int32_t nValuesPerStar = 0;
+        inFileStream.read(reinterpret_cast<char*>(&nValuesPerStar), sizeof(int32_t));
+        std::vector<float> filterValues(nValuesPerStar, 0.f);
+        std::vector<float> renderValues(RENDER_VALUES, 0.f);
+
+        while (inFileStream.read(
+            reinterpret_cast<char*>(filterValues.data()),
+            nValuesPerStar * sizeof(filterValues[0])
+        ))
+        {
+            // Filter data by parameters.
+            if (checkAllFilters(filterValues)) {
+                nFilteredStars++;
+                continue;
+            }
 
-    // Make sure all threads are done.
-    for (int i = 0; i < 8; ++i) {
-        writeThreads[i].join();
+            // If all filters passed then insert render values into Octree.
+            std::copy(
+                filterValues.begin(),
+                filterValues.begin() + RENDER_VALUES,
+                renderValues.begin()
+            );
+            octreeManager.insert(renderValues);
+            nStarsInFile++;
+        }
+        inFileStream.close();
     }
+    else {
+        LERROR(fmt::format(
+            "Error opening file {} for loading preprocessed file", inFilePath
+        ));
+    }
+
+    // Slice LOD data.
+    LINFO(fmt::format("Slicing LOD data of branch {}", branchIndex));
+    octreeManager.sliceLodData(branchIndex);
+
+    LINFO(fmt::format(
+        "Writing {} stars to octree files of branch {}", nStarsInFile, branchIndex
+    ));
+    LINFO(fmt::format(
+        "Number leaf nodes: {}\n Number inner nodes: {}\n Total depth of tree: {}",
+        octreeManager.numLeafNodes(),
+        octreeManager.numInnerNodes(),
+        octreeManager.totalDepth()
+    ));
+
+    // Data will be cleared after it has been written
+    octreeManager.writeToMultipleFiles(_outFileOrFolderPath.string(), branchIndex);
+
+    return { nStarsInFile, nFilteredStars };
 }
 
 bool ConstructOctreeTask::checkAllFilters(const std::vector<float>& filterValues) {
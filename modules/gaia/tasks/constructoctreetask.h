@@ -42,6 +42,8 @@ public:
 
     std::string description() override;
     void perform(const Task::ProgressCallback& onProgress) override;
+    std::vector<std::filesystem::path> inputFiles() const override;
+    std::vector<std::filesystem::path> outputFiles() const override;
     static documentation::Documentation Documentation();
 
 private:
@@ -63,6 +65,18 @@ private:
      */
     void constructOctreeFromFolder(const Task::ProgressCallback& progressCallback);
 
+    /**
+     * Reads the binary star data of a single preprocessed file and inserts the stars
+     * that pass all defined filters into \p octreeManager. The LOD data of the branch
+     * \p branchIndex is sliced and the branch is written to one file per node.
+     * Afterwards, only the structure of the branch remains in \p octreeManager.
+     *
+     * \returns the number of inserted stars and the number of filtered stars
+     */
+    std::pair<int32_t, size_t> constructBranchFromFile(
+        const std::filesystem::path& inFilePath, size_t branchIndex,
+        OctreeManager& octreeManager);
+
     /**
      * Checks all defined filter ranges and \returns true if any of the corresponding
      * `filterValues` are outside of the defined range.
@@ -86,6 +100,9 @@ private:
     int _maxDist = 0;
     int _maxStarsPerNode = 0;
     bool _singleFileInput = false;
+    bool _quantizeData = false;
+    int _maxThreads = 1;
+    int _memoryBudget = 0;
 
     std::shared_ptr<OctreeManager> _octreeManager;
     std::shared_ptr<OctreeManager> _indexOctreeManager;
@@ -37,33 +37,34 @@ namespace openspace::gaia {
 
 ReadFileJob::ReadFileJob(std::string filePath, std::vector<std::string> allColumns,
                          int firstRow, int lastRow, size_t nDefaultCols,
-                         int nValuesPerStar, std::shared_ptr<FitsFileReader> fitsReader)
+                         int nValuesPerStar)
     : _inFilePath(std::move(filePath))
     , _firstRow(firstRow)
     , _lastRow(lastRow)
     , _nDefaultCols(nDefaultCols)
     , _nValuesPerStar(nValuesPerStar)
     , _allColumns(std::move(allColumns))
-    , _fitsFileReader(std::move(fitsReader))
     , _octants(8)
 {}
 
 void ReadFileJob::execute() {
     // Read columns from FITS file. If rows aren't specified then full table will be read.
-    std::shared_ptr<TableData<float>> table = _fitsFileReader->readTable<float>(
+    // Only the reading itself is serialized between the jobs, the conversion below runs
+    // concurrently for all files
+    std::optional<ColumnData<float>> table = FitsFileReader::readColumns<float>(
         _inFilePath,
         _allColumns,
         _firstRow,
         _lastRow
     );
 
-    if (!table) {
+    if (!table.has_value()) {
         throw ghoul::RuntimeError(
             fmt::format("Failed to open Fits file '{}'", _inFilePath
         ));
     }
 
-    int nStars = table->readRows - _firstRow + 1;
+    const int nStars = static_cast<int>(table->nRows);
 
     int nNullArr = 0;
     size_t nColumnsRead = _allColumns.size();
@@ -74,35 +75,32 @@ void ReadFileJob::execute() {
         );
     }
 
-    // Copy columns to local variables.
-    std::unordered_map<std::string, std::vector<float>>& tableContent = table->contents;
+    // The columns are in the order in which they were requested
+    std::vector<std::vector<float>>& cols = table->columns;
 
     // Default columns parameters.
-    //std::vector<float> l_longitude = std::move(tableContent[_allColumns[0]]);
-    //std::vector<float> b_latitude = std::move(tableContent[_allColumns[1]]);
-    std::vector<float> ra = std::move(tableContent[_allColumns[0]]);
-    std::vector<float> ra_err = std::move(tableContent[_allColumns[1]]);
-    std::vector<float> dec = std::move(tableContent[_allColumns[2]]);
-    std::vector<float> dec_err = std::move(tableContent[_allColumns[3]]);
-    std::vector<float> parallax = std::move(tableContent[_allColumns[4]]);
-    std::vector<float> parallax_err = std::move(tableContent[_allColumns[5]]);
-    std::vector<float> pmra = std::move(tableContent[_allColumns[6]]);
-    std::vector<float> pmra_err = std::move(tableContent[_allColumns[7]]);
-    std::vector<float> pmdec = std::move(tableContent[_allColumns[8]]);
-    std::vector<float> pmdec_err = std::move(tableContent[_allColumns[9]]);
-    std::vector<float> meanMagG = std::move(tableContent[_allColumns[10]]);
-    std::vector<float> meanMagBp = std::move(tableContent[_allColumns[11]]);
-    std::vector<float> meanMagRp = std::move(tableContent[_allColumns[12]]);
-    std::vector<float> bp_rp = std::move(tableContent[_allColumns[13]]);
-    std::vector<float> bp_g = std::move(tableContent[_allColumns[14]]);
-    std::vector<float> g_rp = std::move(tableContent[_allColumns[15]]);
-    std::vector<float> radial_vel = std::move(tableContent[_allColumns[16]]);
-    std::vector<float> radial_vel_err = std::move(tableContent[_allColumns[17]]);
-
+    const std::vector<float>& ra = cols[0];
+    const std::vector<float>& ra_err = cols[1];
+    const std::vector<float>& dec = cols[2];
+    const std::vector<float>& dec_err = cols[3];
+    const std::vector<float>& parallax = cols[4];
+    const std::vector<float>& parallax_err = cols[5];
+    std::vector<float>& pmra = cols[6];
+    const std::vector<float>& pmra_err = cols[7];
+    std::vector<float>& pmdec = cols[8];
+    const std::vector<float>& pmdec_err = cols[9];
+    const std::vector<float>& meanMagG = cols[10];
+    const std::vector<float>& meanMagBp = cols[11];
+    const std::vector<float>& meanMagRp = cols[12];
+    const std::vector<float>& bp_rp = cols[13];
+    const std::vector<float>& bp_g = cols[14];
+    const std::vector<float>& g_rp = cols[15];
+    std::vector<float>& radial_vel = cols[16];
+    const std::vector<float>& radial_vel_err = cols[17];
 
     // Construct data array. OBS: ORDERING IS IMPORTANT! This is where slicing happens.
+    std::vector<float> values(_nValuesPerStar);
     for (int i = 0; i < nStars; ++i) {
-        std::vector<float> values(_nValuesPerStar);
         size_t idx = 0;
 
         // Default order for rendering:
@@ -241,10 +239,9 @@ void ReadFileJob::execute() {
         values[idx++] = radial_vel[i];
         values[idx++] = std::isnan(radial_vel_err[i]) ? 0.f : radial_vel_err[i];
 
-        // Read extra columns, if any. This will slow down the sorting tremendously!
+        // Read extra columns, if any
         for (size_t col = _nDefaultCols; col < nColumnsRead; ++col) {
-            std::vector<float> vecData = std::move(tableContent[_allColumns[col]]);
-            values[idx++] = std::isnan(vecData[col]) ? 0.f : vecData[col];
+            values[idx++] = std::isnan(cols[col][i]) ? 0.f : cols[col][i];
         }
 
         size_t index = 0;
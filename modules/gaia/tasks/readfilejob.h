@@ -45,8 +45,7 @@ struct ReadFileJob : public Job<std::vector<std::vector<float>>> {
      * \param nValuesPerStar defines how many values that will be stored per star.
      */
     ReadFileJob(std::string filePath, std::vector<std::string> allColumns, int firstRow,
-        int lastRow, size_t nDefaultCols, int nValuesPerStar,
-        std::shared_ptr<FitsFileReader> fitsReader);
+        int lastRow, size_t nDefaultCols, int nValuesPerStar);
 
     ~ReadFileJob() override = default;
 
@@ -62,7 +61,6 @@ private:
     int _nValuesPerStar;
     std::vector<std::string> _allColumns;
 
-    std::shared_ptr<FitsFileReader> _fitsFileReader;
     std::vector<std::vector<float>> _octants;
 };
 
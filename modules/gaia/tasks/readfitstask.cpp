@@ -113,6 +113,14 @@ std::string ReadFitsTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> ReadFitsTask::inputFiles() const {
+    return { _inFileOrFolderPath };
+}
+
+std::vector<std::filesystem::path> ReadFitsTask::outputFiles() const {
+    return { _outFileOrFolderPath };
+}
+
 void ReadFitsTask::perform(const Task::ProgressCallback& onProgress) {
     onProgress(0.f);
 
@@ -241,7 +249,6 @@ void ReadFitsTask::readAllFitsFilesFromFolder(const Task::ProgressCallback&) {
     // Declare how many values to save for each star.
     int32_t nValuesPerStar = 24;
     size_t nDefaultColumns = defaultColumnNames.size();
-    auto fitsFileReader = std::make_shared<FitsFileReader>(false);
 
     // Divide all files into ReadFilejobs and then delegate them onto several threads!
     while (!allInputFiles.empty()) {
@@ -255,8 +262,7 @@ void ReadFitsTask::readAllFitsFilesFromFolder(const Task::ProgressCallback&) {
             _firstRow,
             _lastRow,
             nDefaultColumns,
-            nValuesPerStar,
-            fitsFileReader
+            nValuesPerStar
         );
         jobManager.enqueueJob(readFileJob);
     }
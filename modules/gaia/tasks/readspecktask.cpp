@@ -64,6 +64,14 @@ std::string ReadSpeckTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> ReadSpeckTask::inputFiles() const {
+    return { _inFilePath };
+}
+
+std::vector<std::filesystem::path> ReadSpeckTask::outputFiles() const {
+    return { _outFilePath };
+}
+
 void ReadSpeckTask::perform(const Task::ProgressCallback& onProgress) {
     onProgress(0.f);
 
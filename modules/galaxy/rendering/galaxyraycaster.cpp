@@ -114,7 +114,7 @@ void GalaxyRaycaster::preRaycast(const RaycastData& data,
                                                     std::to_string(data.id);
 
     program.setUniform(volumeAspectUniformName, _aspect);
-    program.setUniform(stepSizeUniformName, _stepSize);
+    program.setUniform(stepSizeUniformName, _stepSize * stepSizeScale());
     program.setUniform(opacityCoefficientUniformName, _opacityCoefficient);
     program.setUniform(absorptionMultiplyUniformName, _absorptionMultiply);
     program.setUniform(emissionMultiplyUniformName, _emissionMultiply);
@@ -140,6 +140,12 @@ bool GalaxyRaycaster::isCameraInside(const RenderData& data, glm::vec3& localPos
         localPosition.z > 0 && localPosition.z < 1);
 }
 
+std::optional<glm::vec4> GalaxyRaycaster::screenSpaceBounds(const RenderData& data) {
+    return boxScreenSpaceBounds(
+        glm::dmat4(data.camera.projectionMatrix()) * modelViewTransform(data)
+    );
+}
+
 std::string GalaxyRaycaster::boundsVertexShaderPath() const {
     return std::string(GlslBoundsVsPath);
 }
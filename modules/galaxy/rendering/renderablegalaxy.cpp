@@ -195,6 +195,13 @@ namespace {
 
             // [[codegen::verbatim(DownscaleVolumeRenderingInfo.description)]]
             std::optional<float> downscale;
+
+            // If this value is true, the volume is stored in a BC7 (BPTC) compressed
+            // texture on the GPU, which uses a quarter of the memory of the uncompressed
+            // volume at a slight loss in quality. The compression is applied by the
+            // driver when the volume is uploaded, which increases the loading time.
+            // Defaults to false
+            std::optional<bool> compress;
         };
         Volume volume;
 
@@ -301,6 +308,7 @@ RenderableGalaxy::RenderableGalaxy(const ghoul::Dictionary& dictionary)
     _volumeSize = p.volume.size;
     _numberOfRayCastingSteps = p.volume.steps.value_or(_numberOfRayCastingSteps);
     _downScaleVolumeRendering = p.volume.downscale.value_or(_downScaleVolumeRendering);
+    _compressVolume = p.volume.compress.value_or(_compressVolume);
 
     _pointsFilename = p.points.filename.string();
     _enabledPointsRatio = p.points.enabledPointsRatio.value_or(_enabledPointsRatio);
@@ -401,7 +409,7 @@ void RenderableGalaxy::initializeGL() {
         _volumeDimensions,
         GL_TEXTURE_3D,
         ghoul::opengl::Texture::Format::RGBA,
-        GL_RGBA,
+        _compressVolume ? GL_COMPRESSED_RGBA_BPTC_UNORM : GL_RGBA,
         GL_UNSIGNED_BYTE,
         ghoul::opengl::Texture::FilterMode::Linear,
         ghoul::opengl::Texture::WrappingMode::ClampToEdge,
@@ -86,6 +86,7 @@ private:
 
     std::string _volumeFilename;
     glm::ivec3 _volumeDimensions = glm::ivec3(0);
+    bool _compressVolume = false;
     std::string _pointsFilename;
     std::string _pointSpreadFunctionTexturePath;
 
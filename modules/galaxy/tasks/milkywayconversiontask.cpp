@@ -24,15 +24,15 @@
 
 #include <modules/galaxy/tasks/milkywayconversiontask.h>
 
-#include <modules/volume/textureslicevolumereader.h>
+#include <modules/volume/rawvolume.h>
 #include <modules/volume/rawvolumewriter.h>
-#include <modules/volume/volumesampler.h>
 #include <modules/volume/textureslicevolumereader.h>
-
-#include <modules/volume/rawvolumewriter.h>
+#include <modules/volume/volumesampler.h>
 #include <openspace/documentation/documentation.h>
-
+#include <openspace/util/threadpool.h>
 #include <ghoul/misc/dictionary.h>
+#include <algorithm>
+#include <cmath>
 
 namespace {
     constexpr std::string_view KeyInFilenamePrefix = "InFilenamePrefix";
@@ -41,6 +41,10 @@ namespace {
     constexpr std::string_view KeyInNSlices = "InNSlices";
     constexpr std::string_view KeyOutFilename = "OutFilename";
     constexpr std::string_view KeyOutDimensions = "OutDimensions";
+
+    // The number of output slices that each thread samples per slab. Only the input
+    // slices that are needed for the current slab are kept in memory
+    constexpr unsigned int SlicesPerThread = 2;
 } // namespace
 
 namespace openspace {
@@ -75,6 +79,7 @@ std::string MilkywayConversionTask::description() {
 
 void MilkywayConversionTask::perform(const Task::ProgressCallback& onProgress) {
     using namespace openspace::volume;
+    using Voxel = glm::tvec4<GLfloat>;
 
     std::vector<std::string> filenames;
     for (size_t i = 0; i < _inNSlices; i++) {
@@ -83,28 +88,69 @@ void MilkywayConversionTask::perform(const Task::ProgressCallback& onProgress) {
         );
     }
 
-    TextureSliceVolumeReader<glm::tvec4<GLfloat>> sliceReader(filenames, _inNSlices, 10);
+    const glm::uvec3 outDimensions = glm::uvec3(_outDimensions);
+    // The task's Threads budget includes the thread that performs it, which takes part
+    // in the work of the pool
+    const unsigned int nThreads =
+        static_cast<unsigned int>(std::max(scheduling().nThreads, 1));
+    ThreadPool pool(nThreads - 1);
+    const unsigned int slabDepth = nThreads * SlicesPerThread;
+
+    // The sampler reads up to half of its filter size plus one slice for the
+    // interpolation on either side of a sampled position. The cache has to hold all of
+    // the input slices that are needed for one slab
+    const float ratioZ = static_cast<float>(_inNSlices) / outDimensions.z;
+    const int margin = static_cast<int>(std::ceil(ratioZ / 2.f)) + 1;
+    const size_t cacheSize = static_cast<size_t>(std::ceil(slabDepth * ratioZ)) +
+        2 * margin + 2;
+
+    TextureSliceVolumeReader<Voxel> sliceReader(filenames, cacheSize);
     sliceReader.initialize();
 
-    RawVolumeWriter<glm::tvec4<GLfloat>> rawWriter(_outFilename);
-    rawWriter.setDimensions(_outDimensions);
+    RawVolumeWriter<Voxel> rawWriter(_outFilename);
+    rawWriter.setDimensions(outDimensions);
 
     const glm::vec3 resolutionRatio = static_cast<glm::vec3>(sliceReader.dimensions()) /
                                       static_cast<glm::vec3>(rawWriter.dimensions());
 
-    VolumeSampler<TextureSliceVolumeReader<glm::tvec4<GLfloat>>> sampler(
+    VolumeSampler<TextureSliceVolumeReader<Voxel>> sampler(
         &sliceReader,
         resolutionRatio
     );
-    std::function<glm::tvec4<GLfloat>(glm::ivec3)> sampleFunction =
-        [resolutionRatio, sampler](glm::ivec3 outCoord) {
-            const glm::vec3 inCoord = ((glm::vec3(outCoord) + glm::vec3(0.5f)) *
-                                      resolutionRatio) - glm::vec3(0.5f);
-            const glm::tvec4<GLfloat> value = sampler.sample(inCoord);
-            return value;
-        };
-
-    rawWriter.write(sampleFunction, onProgress);
+    auto inCoord = [resolutionRatio](glm::uvec3 outCoord) {
+        return (glm::vec3(outCoord) + glm::vec3(0.5f)) * resolutionRatio -
+            glm::vec3(0.5f);
+    };
+
+    rawWriter.writeSlabs(
+        [&](RawVolume<Voxel>& slab, unsigned int firstSlice) {
+            const glm::uvec3 slabDims = slab.dimensions();
+            const unsigned int lastSlice = firstSlice + slabDims.z - 1;
+            sliceReader.preload(
+                static_cast<int>(std::floor(inCoord(glm::uvec3(0, 0, firstSlice)).z)) -
+                    margin,
+                static_cast<int>(std::floor(inCoord(glm::uvec3(0, 0, lastSlice)).z)) +
+                    margin,
+                pool
+            );
+
+            // The rows of the slab are sampled concurrently, which only reads from the
+            // slices that were loaded above
+            const size_t nRows = static_cast<size_t>(slabDims.y) * slabDims.z;
+            pool.parallelFor(0, nRows, 1, [&](size_t begin, size_t end) {
+                for (size_t row = begin; row < end; row++) {
+                    const unsigned int y = static_cast<unsigned int>(row % slabDims.y);
+                    const unsigned int z = static_cast<unsigned int>(row / slabDims.y);
+                    for (unsigned int x = 0; x < slabDims.x; x++) {
+                        const glm::vec3 p = inCoord(glm::uvec3(x, y, firstSlice + z));
+                        slab.set(glm::uvec3(x, y, z), sampler.sample(p));
+                    }
+                }
+            });
+        },
+        slabDepth,
+        onProgress
+    );
 }
 
 documentation::Documentation MilkywayConversionTask::Documentation() {
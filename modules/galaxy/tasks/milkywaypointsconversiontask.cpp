@@ -25,69 +25,84 @@
 #include <modules/galaxy/tasks/milkywaypointsconversiontask.h>
 
 #include <openspace/documentation/documentation.h>
-
+#include <ghoul/fmt.h>
+#include <ghoul/misc/dictionary.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
 #include <fstream>
-#include <iostream>
 #include <vector>
 
-namespace openspace {
+namespace {
+    constexpr std::string_view KeyInFilename = "InFilename";
+    constexpr std::string_view KeyOutFilename = "OutFilename";
+
+    // The number of points that are converted and written at a time, so that only a
+    // single block of points has to be kept in memory
+    constexpr int64_t PointsPerBlock = 1 << 16;
 
-/*MilkywayPointsConversionTask::MilkywayPointsConversionTask(
-    const std::string& inFilename,
-    const std::string& outFilename)
-    : _inFilename(inFilename)
-    , _outFilename(outFilename) {}*/
+    constexpr int64_t ValuesPerPoint = 7;
+} // namespace
+
+namespace openspace {
 
-MilkywayPointsConversionTask::MilkywayPointsConversionTask(const ghoul::Dictionary&) {}
+MilkywayPointsConversionTask::MilkywayPointsConversionTask(
+                                                      const ghoul::Dictionary& dictionary)
+{
+    if (dictionary.hasKey(KeyInFilename)) {
+        _inFilename = dictionary.value<std::string>(KeyInFilename);
+    }
+    if (dictionary.hasKey(KeyOutFilename)) {
+        _outFilename = dictionary.value<std::string>(KeyOutFilename);
+    }
+}
 
 std::string MilkywayPointsConversionTask::description() {
     return std::string();
 }
 
+std::vector<std::filesystem::path> MilkywayPointsConversionTask::inputFiles() const {
+    return { _inFilename };
+}
+
+std::vector<std::filesystem::path> MilkywayPointsConversionTask::outputFiles() const {
+    return { _outFilename };
+}
+
 void MilkywayPointsConversionTask::perform(const Task::ProgressCallback& progressCallback)
 {
     std::ifstream in(_inFilename, std::ios::in);
+    if (!in.good()) {
+        throw ghoul::RuntimeError(fmt::format("Could not open file {}", _inFilename));
+    }
     std::ofstream out(_outFilename, std::ios::out | std::ios::binary);
+    if (!out.good()) {
+        throw ghoul::RuntimeError(fmt::format("Could not create file {}", _outFilename));
+    }
 
     std::string format;
-    int64_t nPoints;
+    int64_t nPoints = 0;
     in >> format >> nPoints;
+    out.write(reinterpret_cast<char*>(&nPoints), sizeof(int64_t));
 
-    size_t nFloats = nPoints * 7;
-
-    std::vector<float> pointData(nFloats);
-
-    float x;
-    float y;
-    float z;
-    float r;
-    float g;
-    float b;
-    float a;
-
-    for (int64_t i = 0; i < nPoints; ++i) {
-        in >> x >> y >> z >> r >> g >> b >> a;
-        if (in.good()) {
-            pointData[i * 7 + 0] = x;
-            pointData[i * 7 + 1] = y;
-            pointData[i * 7 + 2] = z;
-            pointData[i * 7 + 3] = r;
-            pointData[i * 7 + 4] = g;
-            pointData[i * 7 + 5] = b;
-            pointData[i * 7 + 6] = a;
-            progressCallback(static_cast<float>(i + 1) / nPoints);
+    std::vector<float> block(PointsPerBlock * ValuesPerPoint);
+    for (int64_t first = 0; first < nPoints; first += PointsPerBlock) {
+        const int64_t n = std::min(PointsPerBlock, nPoints - first);
+        const int64_t nValues = n * ValuesPerPoint;
+        for (int64_t i = 0; i < nValues; i++) {
+            in >> block[i];
         }
-        else {
-            std::cout << "Failed to convert point data";
-            return;
+        if (in.fail()) {
+            throw ghoul::RuntimeError(fmt::format(
+                "Failed to convert point data in {}", _inFilename
+            ));
         }
-    }
 
-    out.write(reinterpret_cast<char*>(&nPoints), sizeof(int64_t));
-    out.write(reinterpret_cast<char*>(pointData.data()), nFloats * sizeof(float));
-
-    in.close();
-    out.close();
+        out.write(
+            reinterpret_cast<char*>(block.data()),
+            nValues * sizeof(float)
+        );
+        progressCallback(static_cast<float>(first + n) / nPoints);
+    }
 }
 
 documentation::Documentation MilkywayPointsConversionTask::Documentation() {
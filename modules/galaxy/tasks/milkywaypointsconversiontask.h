@@ -46,6 +46,8 @@ public:
 
     std::string description() override;
     void perform(const Task::ProgressCallback& progressCallback) override;
+    std::vector<std::filesystem::path> inputFiles() const override;
+    std::vector<std::filesystem::path> outputFiles() const override;
 
     static documentation::Documentation Documentation();
 
@@ -24,6 +24,7 @@
 
 #include <modules/globebrowsing/globebrowsingmodule.h>
 
+#include <modules/globebrowsing/src/asynctiledataprovider.h>
 #include <modules/globebrowsing/src/basictypes.h>
 #include <modules/globebrowsing/src/dashboarditemglobelocation.h>
 #include <modules/globebrowsing/src/gdalwrapper.h>
@@ -50,10 +51,12 @@
 #include <modules/globebrowsing/src/tileprovider/tileprovider.h>
 #include <modules/globebrowsing/src/tileprovider/tileproviderbyindex.h>
 #include <modules/globebrowsing/src/tileprovider/tileproviderbylevel.h>
+#include <modules/globebrowsing/src/tilewarmcache.h>
 #include <openspace/camera/camera.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
 #include <openspace/engine/globalscallbacks.h>
+#include <openspace/engine/openspaceengine.h>
 #include <openspace/engine/moduleengine.h>
 #include <openspace/navigation/navigationhandler.h>
 #include <openspace/navigation/navigationstate.h>
@@ -65,6 +68,7 @@
 #include <openspace/scene/scenegraphnode.h>
 #include <openspace/scripting/lualibrary.h>
 #include <openspace/util/factorymanager.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
@@ -73,6 +77,7 @@
 #include <ghoul/misc/templatefactory.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/systemcapabilities/generalcapabilitiescomponent.h>
+#include <algorithm>
 #include <vector>
 
 #include <gdal.h>
@@ -123,6 +128,14 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo ParallelChunkUpdateInfo = {
+        "ParallelChunkUpdate",
+        "Parallel Chunk Update",
+        "If this value is enabled, the culling and level-of-detail selection of the "
+        "chunks of all globes are distributed across a number of worker threads",
+        openspace::properties::Property::Visibility::Developer
+    };
+
     openspace::GlobeBrowsingModule::Capabilities
     parseSubDatasets(char** subDatasets, int nSubdatasets)
     {
@@ -192,6 +205,14 @@ namespace {
 
         // [[codegen::verbatim(MRFCacheLocationInfo.description)]]
         std::optional<std::string> mrfCacheLocation [[codegen::key("MRFCacheLocation")]];
+
+        // If this value is true, all finished tiles are also stored in a persistent
+        // cache in the MRF cache location. The tiles that were shown in one session are
+        // then loaded from that cache at the start of the next session
+        std::optional<bool> warmCacheEnabled;
+
+        // The maximum size of the persistent tile cache in MB
+        std::optional<int> warmCacheSize [[codegen::greater(0)]];
     };
 #include "globebrowsingmodule_codegen.cpp"
 } // namespace
@@ -204,6 +225,7 @@ GlobeBrowsingModule::GlobeBrowsingModule()
     , _defaultGeoPointTexturePath(DefaultGeoPointTextureInfo)
     , _mrfCacheEnabled(MRFCacheEnabledInfo, false)
     , _mrfCacheLocation(MRFCacheLocationInfo, "${BASE}/cache_mrf")
+    , _parallelChunkUpdate(ParallelChunkUpdateInfo, true)
 {
     addProperty(_tileCacheSizeMB);
 
@@ -211,6 +233,8 @@ GlobeBrowsingModule::GlobeBrowsingModule()
 
     addProperty(_mrfCacheEnabled);
     addProperty(_mrfCacheLocation);
+
+    addProperty(_parallelChunkUpdate);
 }
 
 void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary& dict) {
@@ -243,6 +267,14 @@ void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary& dict) {
     _mrfCacheEnabled = p.mrfCacheEnabled.value_or(_mrfCacheEnabled);
     _mrfCacheLocation = p.mrfCacheLocation.value_or(_mrfCacheLocation);
 
+    if (p.warmCacheEnabled.value_or(false)) {
+        const size_t size = static_cast<size_t>(p.warmCacheSize.value_or(4096));
+        _tileWarmCache = std::make_unique<TileWarmCache>(
+            absPath(_mrfCacheLocation.value()) / "warmcache",
+            size * 1024 * 1024
+        );
+    }
+
     // Initialize
     global::callback::initializeGL->emplace_back([this]() {
         ZoneScopedN("GlobeBrowsingModule");
@@ -260,10 +292,11 @@ void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary& dict) {
         addPropertySubOwner(GdalWrapper::ref());
     });
 
-    global::callback::deinitializeGL->emplace_back([]() {
+    global::callback::deinitializeGL->emplace_back([this]() {
         ZoneScopedN("GlobeBrowsingModule");
 
         TileProvider::deinitializeDefaultTile();
+        _tileCache->deinitializeGL();
     });
 
     // Render
@@ -274,9 +307,10 @@ void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary& dict) {
     });
 
     // Deinitialize
-    global::callback::deinitialize->emplace_back([]() {
+    global::callback::deinitialize->emplace_back([this]() {
         ZoneScopedN("GlobeBrowsingModule");
 
+        _tileWarmCache = nullptr;
         GdalWrapper::destroy();
     });
 
@@ -319,6 +353,10 @@ void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary& dict) {
     fDashboard->registerClass<DashboardItemGlobeLocation>("DashboardItemGlobeLocation");
 }
 
+globebrowsing::TileWarmCache* GlobeBrowsingModule::tileWarmCache() {
+    return _tileWarmCache.get();
+}
+
 globebrowsing::cache::MemoryAwareTileCache* GlobeBrowsingModule::tileCache() {
     return _tileCache.get();
 }
@@ -686,6 +724,66 @@ std::string_view GlobeBrowsingModule::defaultGeoPointTexture() const {
     return _defaultGeoPointTexturePath;
 }
 
+void GlobeBrowsingModule::registerTileTelemetry(
+                                          const globebrowsing::TileTelemetry* telemetry)
+{
+    _tileTelemetries.push_back(telemetry);
+}
+
+void GlobeBrowsingModule::unregisterTileTelemetry(
+                                          const globebrowsing::TileTelemetry* telemetry)
+{
+    std::erase(_tileTelemetries, telemetry);
+}
+
+const std::vector<const globebrowsing::TileTelemetry*>&
+GlobeBrowsingModule::tileTelemetries() const
+{
+    return _tileTelemetries;
+}
+
+GlobeBrowsingModule::SharedTileDataProvider GlobeBrowsingModule::sharedTileDataProvider(
+                                                                   const std::string& key,
+                                                   const TileDataProviderFactory& create)
+{
+    ZoneScoped;
+
+    using globebrowsing::AsyncTileDataProvider;
+
+    // Datasets whose last tile provider was destroyed are forgotten
+    std::erase_if(
+        _sharedDatasets,
+        [](const std::pair<const std::string, SharedDataset>& p) {
+            return p.second.provider.expired();
+        }
+    );
+
+    const auto it = _sharedDatasets.find(key);
+    if (it != _sharedDatasets.end()) {
+        std::shared_ptr<AsyncTileDataProvider> provider = it->second.provider.lock();
+        if (provider->shouldBeDeleted()) {
+            // The first tile provider that notices that the shared data provider was
+            // reset creates the replacement that all other tile providers switch to
+            provider = create();
+            it->second.provider = provider;
+        }
+        return { std::move(provider), it->second.cacheIdentifier };
+    }
+
+    // The cache identifier is taken from the same range as the identifiers of the tile
+    // providers so that it can't collide with the tiles of any other tile provider
+    const uint16_t id =
+        static_cast<uint16_t>(globebrowsing::TileProvider::NumTileProviders++);
+    std::shared_ptr<AsyncTileDataProvider> provider = create();
+    _sharedDatasets[key] = { .provider = provider, .cacheIdentifier = id };
+    return { std::move(provider), id };
+}
+
+ThreadPool* GlobeBrowsingModule::chunkUpdateThreadPool() {
+    // The calling thread participates in the update alongside the engine's workers
+    return _parallelChunkUpdate ? &global::openSpaceEngine->threadPool() : nullptr;
+}
+
 scripting::LuaLibrary GlobeBrowsingModule::luaLibrary() const {
     return {
         .name = "globebrowsing",
@@ -31,6 +31,8 @@
 #include <openspace/util/openspacemodule.h>
 
 #include <ghoul/glm.h>
+#include <functional>
+#include <map>
 #include <memory>
 #include <future>
 
@@ -39,6 +41,9 @@ namespace openspace::globebrowsing {
     struct TileIndex;
     struct Geodetic2;
     struct Geodetic3;
+    class TileTelemetry;
+    class AsyncTileDataProvider;
+    class TileWarmCache;
 
     namespace cache { class MemoryAwareTileCache; }
 } // namespace openspace::globebrowsing
@@ -46,6 +51,7 @@ namespace openspace::globebrowsing {
 namespace openspace {
 
 class Camera;
+class ThreadPool;
 
 class GlobeBrowsingModule : public OpenSpaceModule {
 public:
@@ -66,6 +72,11 @@ public:
     glm::dvec3 geoPosition() const;
 
     globebrowsing::cache::MemoryAwareTileCache* tileCache();
+
+    /**
+     * Returns the persistent cache of finished tiles or `nullptr` if it is disabled.
+     */
+    globebrowsing::TileWarmCache* tileWarmCache();
     scripting::LuaLibrary luaLibrary() const override;
     std::vector<documentation::Documentation> documentations() const override;
 
@@ -98,6 +109,41 @@ public:
     bool hasDefaultGeoPointTexture() const;
     std::string_view defaultGeoPointTexture() const;
 
+    /**
+     * Registers the tile loading telemetry of a tile provider so that it can be
+     * inspected from outside the property tree. The \p telemetry must be unregistered
+     * before it is destroyed.
+     */
+    void registerTileTelemetry(const globebrowsing::TileTelemetry* telemetry);
+    void unregisterTileTelemetry(const globebrowsing::TileTelemetry* telemetry);
+    const std::vector<const globebrowsing::TileTelemetry*>& tileTelemetries() const;
+
+    using TileDataProviderFactory =
+        std::function<std::unique_ptr<globebrowsing::AsyncTileDataProvider>()>;
+    struct SharedTileDataProvider {
+        std::shared_ptr<globebrowsing::AsyncTileDataProvider> provider;
+        // The identifier under which the tiles of the provider are stored in the tile
+        // cache. It is the same for all tile providers sharing the data provider
+        uint16_t cacheIdentifier = 0;
+    };
+
+    /**
+     * Returns the data provider for the dataset that is described by the \p key, which
+     * has to contain the dataset path and all settings that influence the decoded
+     * tiles. Tile providers requesting the same key share the GDAL dataset handles, the
+     * decoding of the tiles, and the tiles in the tile cache. If no data provider for
+     * the key exists, or the existing one is waiting to be deleted after a reset, a new
+     * one is created by calling \p create.
+     */
+    SharedTileDataProvider sharedTileDataProvider(const std::string& key,
+        const TileDataProviderFactory& create);
+
+    /**
+     * Returns the thread pool on which the globes evaluate their chunk trees or
+     * `nullptr` if the chunk trees should be evaluated on the calling thread only.
+     */
+    ThreadPool* chunkUpdateThreadPool();
+
 protected:
     void internalInitialize(const ghoul::Dictionary&) override;
 
@@ -119,8 +165,10 @@ private:
     properties::StringProperty _defaultGeoPointTexturePath;
     properties::BoolProperty _mrfCacheEnabled;
     properties::StringProperty _mrfCacheLocation;
+    properties::BoolProperty _parallelChunkUpdate;
 
     std::unique_ptr<globebrowsing::cache::MemoryAwareTileCache> _tileCache;
+    std::unique_ptr<globebrowsing::TileWarmCache> _tileWarmCache;
 
     // name -> capabilities
     std::map<std::string, std::future<Capabilities>> _inFlightCapabilitiesMap;
@@ -129,6 +177,15 @@ private:
 
     std::multimap<std::string, UrlInfo> _urlList;
 
+    std::vector<const globebrowsing::TileTelemetry*> _tileTelemetries;
+
+    struct SharedDataset {
+        std::weak_ptr<globebrowsing::AsyncTileDataProvider> provider;
+        uint16_t cacheIdentifier = 0;
+    };
+    // dataset key -> data provider used by all tile providers of that dataset
+    std::map<std::string, SharedDataset> _sharedDatasets;
+
     bool _hasDefaultGeoPointTexture = false;
 };
 
@@ -24,6 +24,11 @@
 
 #version __CONTEXT__
 
+// The tile cache can pass the height tiles as bindless texture handles
+#ifdef GL_ARB_bindless_texture
+#extension GL_ARB_bindless_texture : enable
+#endif // GL_ARB_bindless_texture
+
 #include "PowerScaling/powerScaling_vs.hglsl"
 #include <${MODULE_GLOBEBROWSING}/shaders/tile.glsl>
 #include <${MODULE_GLOBEBROWSING}/shaders/texturetilemapping.glsl>
@@ -24,6 +24,7 @@
 
 #include <modules/globebrowsing/src/asynctiledataprovider.h>
 
+#include <modules/globebrowsing/globebrowsingmodule.h>
 #include <modules/globebrowsing/src/memoryawaretilecache.h>
 #include <modules/globebrowsing/src/rawtiledatareader.h>
 #include <modules/globebrowsing/src/tileloadjob.h>
@@ -43,7 +44,10 @@ AsyncTileDataProvider::AsyncTileDataProvider(std::string name,
                                     std::unique_ptr<RawTileDataReader> rawTileDataReader)
     : _name(std::move(name))
     , _rawTileDataReader(std::move(rawTileDataReader))
-    , _concurrentJobManager(LRUThreadPool<TileIndex::TileHashKey>(1, 10))
+    , _concurrentJobManager(LRUThreadPool<TileIndex::TileHashKey>(
+        _rawTileDataReader->maxConcurrentReads(),
+        10
+    ))
 {
     ZoneScoped;
 
@@ -58,7 +62,13 @@ bool AsyncTileDataProvider::enqueueTileIO(const TileIndex& tileIndex) {
     ZoneScoped;
 
     if (_resetMode == ResetMode::ShouldNotReset && satisfiesEnqueueCriteria(tileIndex)) {
-        auto job = std::make_unique<TileLoadJob>(*_rawTileDataReader, tileIndex);
+        cache::MemoryAwareTileCache* tileCache =
+            global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
+        auto job = std::make_unique<TileLoadJob>(
+            *_rawTileDataReader,
+            tileIndex,
+            tileCache->pixelBufferRing()
+        );
         _concurrentJobManager.enqueueJob(std::move(job), tileIndex.hashKey());
         _enqueuedTileRequests.insert(tileIndex.hashKey());
         return true;
@@ -73,6 +83,27 @@ void AsyncTileDataProvider::clearTiles() {
     }
 }
 
+bool AsyncTileDataProvider::prefetchTileIO(const TileIndex& tileIndex) {
+    ZoneScoped;
+
+    // _enqueuedTileRequests contains both the waiting and the running jobs
+    const TileIndex::TileHashKey key = tileIndex.hashKey();
+    if (_resetMode != ResetMode::ShouldNotReset || _enqueuedTileRequests.contains(key)) {
+        return false;
+    }
+
+    cache::MemoryAwareTileCache* tileCache =
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
+    auto job = std::make_unique<TileLoadJob>(
+        *_rawTileDataReader,
+        tileIndex,
+        tileCache->pixelBufferRing()
+    );
+    _concurrentJobManager.enqueueLowPriorityJob(std::move(job), key);
+    _enqueuedTileRequests.insert(key);
+    return true;
+}
+
 std::optional<RawTile> AsyncTileDataProvider::popFinishedRawTile() {
     if (_concurrentJobManager.numFinishedJobs() > 0) {
         // Now the tile load job looses ownerwhip of the data pointer
@@ -81,7 +112,7 @@ std::optional<RawTile> AsyncTileDataProvider::popFinishedRawTile() {
         const TileIndex::TileHashKey key = product.tileIndex.hashKey();
         // No longer enqueued. Remove from set of enqueued tiles
         _enqueuedTileRequests.erase(key);
-        // Pbo is still mapped. Set the id for the raw tile
+        // A failed tile hands its pixel buffer slot back to the ring on destruction
         if (product.error != RawTile::ReadError::None) {
             product.imageData = nullptr;
             return std::nullopt;
@@ -119,6 +150,7 @@ void AsyncTileDataProvider::endUnfinishedJobs() {
         // When erasing the job before
         _enqueuedTileRequests.erase(unfinishedJob);
     }
+    _numDroppedTiles += unfinishedJobs.size();
 }
 
 void AsyncTileDataProvider::endEnqueuedJobs() {
@@ -202,4 +234,12 @@ float AsyncTileDataProvider::noDataValueAsFloat() const {
     return _rawTileDataReader->noDataValueAsFloat();
 }
 
+int AsyncTileDataProvider::numberOfQueuedTiles() {
+    return static_cast<int>(_concurrentJobManager.numQueuedJobs());
+}
+
+uint64_t AsyncTileDataProvider::numberOfDroppedTiles() const {
+    return _numDroppedTiles;
+}
+
 } // namespace openspace::globebrowsing
@@ -29,6 +29,7 @@
 #include <modules/globebrowsing/src/rawtiledatareader.h>
 #include <modules/globebrowsing/src/tileindex.h>
 #include <ghoul/misc/boolean.h>
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <set>
@@ -55,6 +56,14 @@ public:
      */
     bool enqueueTileIO(const TileIndex& tileIndex);
 
+    /**
+     * Creates a job which asynchronously loads a raw tile that is expected to be needed
+     * soon. The job is only worked on when no tile from `enqueueTileIO` is waiting and
+     * is dropped first if too many tiles are requested. Unlike `enqueueTileIO`, this
+     * does not change the priority of a tile that is already enqueued.
+     */
+    bool prefetchTileIO(const TileIndex& tileIndex);
+
     /**
      * Get one finished job.
      */
@@ -69,6 +78,12 @@ public:
     const RawTileDataReader& rawTileDataReader() const;
     float noDataValueAsFloat() const;
 
+    /// Returns the number of tiles that are enqueued but not yet being loaded
+    int numberOfQueuedTiles();
+
+    /// Returns the total number of enqueued tiles that were dropped before being loaded
+    uint64_t numberOfDroppedTiles() const;
+
 protected:
     BooleanType(ResetRawTileDataReader);
 
@@ -106,6 +121,7 @@ private:
         _concurrentJobManager;
 
     std::set<TileIndex::TileHashKey> _enqueuedTileRequests;
+    uint64_t _numDroppedTiles = 0;
 
     ResetMode _resetMode = ResetMode::ShouldResetAllButRawTileDataReader;
     bool _shouldBeDeleted = false;
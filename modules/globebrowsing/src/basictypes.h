@@ -27,6 +27,7 @@
 
 #include <ghoul/glm.h>
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -147,6 +148,20 @@ public:
     ghoul::opengl::Texture* texture = nullptr;
     std::optional<TileMetaData> metaData = std::nullopt;
     Status status = Status::Unavailable;
+
+    /**
+     * The resident bindless handle of the texture, if the texture is owned by the tile
+     * cache and the cache uses bindless textures. If this value is 0, the texture has to
+     * be bound to a texture unit instead
+     */
+    uint64_t textureHandle = 0;
+
+    /**
+     * If this is `true`, the texture was upsampled from the parent tile while the data
+     * of this tile is still loading. Provisional tiles are only meant for rendering and
+     * their texture does not have any pixel data on the CPU
+     */
+    bool isProvisional = false;
 };
 
 
@@ -0,0 +1,251 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/blockcompression.h>
+
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+    // Each 4x4 block consists of 8 bytes of alpha followed by 8 bytes of color
+    constexpr size_t BytesPerBlock = 16;
+
+    using Block = std::array<glm::ivec4, 16>;
+
+    uint16_t toRgb565(const glm::ivec3& c) {
+        return static_cast<uint16_t>(((c.r >> 3) << 11) | ((c.g >> 2) << 5) | (c.b >> 3));
+    }
+
+    glm::ivec3 fromRgb565(uint16_t c) {
+        const int r = (c >> 11) & 0x1F;
+        const int g = (c >> 5) & 0x3F;
+        const int b = c & 0x1F;
+        // Replicate the high bits so that the endpoints cover the full [0, 255] range
+        return glm::ivec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+    }
+
+    void compressAlpha(const Block& block, std::byte* destination) {
+        int minAlpha = 255;
+        int maxAlpha = 0;
+        for (const glm::ivec4& p : block) {
+            minAlpha = std::min(minAlpha, p.a);
+            maxAlpha = std::max(maxAlpha, p.a);
+        }
+
+        // With alpha0 > alpha1 the block uses eight interpolated values. If both are the
+        // same, every index 0 resolves to that value regardless of the mode
+        std::array<int, 8> palette;
+        palette[0] = maxAlpha;
+        palette[1] = minAlpha;
+        for (int i = 1; i < 7; i++) {
+            palette[i + 1] = ((7 - i) * maxAlpha + i * minAlpha) / 7;
+        }
+
+        uint64_t indices = 0;
+        if (maxAlpha > minAlpha) {
+            for (size_t i = 0; i < block.size(); i++) {
+                uint64_t best = 0;
+                int bestError = std::numeric_limits<int>::max();
+                for (size_t j = 0; j < palette.size(); j++) {
+                    const int error = std::abs(block[i].a - palette[j]);
+                    if (error < bestError) {
+                        bestError = error;
+                        best = j;
+                    }
+                }
+                indices |= best << (3 * i);
+            }
+        }
+
+        destination[0] = static_cast<std::byte>(maxAlpha);
+        destination[1] = static_cast<std::byte>(minAlpha);
+        for (int i = 0; i < 6; i++) {
+            destination[2 + i] = static_cast<std::byte>((indices >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void compressColor(const Block& block, std::byte* destination) {
+        glm::ivec3 minColor = glm::ivec3(255);
+        glm::ivec3 maxColor = glm::ivec3(0);
+        for (const glm::ivec4& p : block) {
+            minColor = glm::min(minColor, glm::ivec3(p));
+            maxColor = glm::max(maxColor, glm::ivec3(p));
+        }
+
+        // Insetting the bounding box slightly reduces the error of the colors that lie
+        // between the endpoints, which are much more common than the extremes
+        const glm::ivec3 inset = (maxColor - minColor) / 16;
+        minColor = glm::min(minColor + inset, glm::ivec3(255));
+        maxColor = glm::max(maxColor - inset, glm::ivec3(0));
+
+        // As the maximum is larger than the minimum in every channel, color0 >= color1.
+        // BC3 always interprets the color block in four-color mode regardless
+        const uint16_t color0 = toRgb565(maxColor);
+        const uint16_t color1 = toRgb565(minColor);
+
+        std::array<glm::ivec3, 4> palette;
+        palette[0] = fromRgb565(color0);
+        palette[1] = fromRgb565(color1);
+        palette[2] = (2 * palette[0] + palette[1]) / 3;
+        palette[3] = (palette[0] + 2 * palette[1]) / 3;
+
+        uint32_t indices = 0;
+        for (size_t i = 0; i < block.size(); i++) {
+            uint32_t best = 0;
+            int bestError = std::numeric_limits<int>::max();
+            for (size_t j = 0; j < palette.size(); j++) {
+                const glm::ivec3 d = glm::ivec3(block[i]) - palette[j];
+                const int error = d.r * d.r + d.g * d.g + d.b * d.b;
+                if (error < bestError) {
+                    bestError = error;
+                    best = static_cast<uint32_t>(j);
+                }
+            }
+            indices |= best << (2 * i);
+        }
+
+        destination[0] = static_cast<std::byte>(color0 & 0xFF);
+        destination[1] = static_cast<std::byte>(color0 >> 8);
+        destination[2] = static_cast<std::byte>(color1 & 0xFF);
+        destination[3] = static_cast<std::byte>(color1 >> 8);
+        for (int i = 0; i < 4; i++) {
+            destination[4 + i] = static_cast<std::byte>((indices >> (8 * i)) & 0xFF);
+        }
+    }
+
+    void compressLevel(const std::vector<glm::ivec4>& pixels, glm::ivec2 size,
+                       std::byte* destination)
+    {
+        for (int by = 0; by < size.y; by += 4) {
+            for (int bx = 0; bx < size.x; bx += 4) {
+                // Levels smaller than a block repeat their last row and column
+                Block block;
+                for (int y = 0; y < 4; y++) {
+                    for (int x = 0; x < 4; x++) {
+                        const int px = std::min(bx + x, size.x - 1);
+                        const int py = std::min(by + y, size.y - 1);
+                        block[y * 4 + x] = pixels[py * size.x + px];
+                    }
+                }
+
+                compressAlpha(block, destination);
+                compressColor(block, destination + 8);
+                destination += BytesPerBlock;
+            }
+        }
+    }
+
+    std::vector<glm::ivec4> downsample(const std::vector<glm::ivec4>& pixels,
+                                       glm::ivec2 size)
+    {
+        const glm::ivec2 half = glm::max(size / 2, glm::ivec2(1));
+        std::vector<glm::ivec4> res(static_cast<size_t>(half.x) * half.y);
+        for (int y = 0; y < half.y; y++) {
+            for (int x = 0; x < half.x; x++) {
+                const int x0 = std::min(2 * x, size.x - 1);
+                const int x1 = std::min(2 * x + 1, size.x - 1);
+                const int y0 = std::min(2 * y, size.y - 1);
+                const int y1 = std::min(2 * y + 1, size.y - 1);
+                const glm::ivec4 sum =
+                    pixels[y0 * size.x + x0] + pixels[y0 * size.x + x1] +
+                    pixels[y1 * size.x + x0] + pixels[y1 * size.x + x1];
+                res[y * half.x + x] = (sum + glm::ivec4(2)) / 4;
+            }
+        }
+        return res;
+    }
+} // namespace
+
+namespace openspace::globebrowsing {
+
+int numberOfMipLevels(glm::ivec2 size) {
+    ghoul_assert(size.x > 0 && size.y > 0, "Size must be positive");
+
+    int largest = std::max(size.x, size.y);
+    int nLevels = 1;
+    while (largest > 1) {
+        largest /= 2;
+        nLevels++;
+    }
+    return nLevels;
+}
+
+size_t bc3LevelSize(glm::ivec2 size, int level) {
+    ghoul_assert(level < numberOfMipLevels(size), "Level out of range");
+
+    const glm::ivec2 levelSize = glm::max(size >> level, glm::ivec2(1));
+    const glm::ivec2 nBlocks = (levelSize + glm::ivec2(3)) / 4;
+    return static_cast<size_t>(nBlocks.x) * nBlocks.y * BytesPerBlock;
+}
+
+size_t bc3CompressedSize(glm::ivec2 size) {
+    size_t res = 0;
+    const int nLevels = numberOfMipLevels(size);
+    for (int level = 0; level < nLevels; level++) {
+        res += bc3LevelSize(size, level);
+    }
+    return res;
+}
+
+void compressBC3(const std::byte* image, glm::ivec2 size, bool isBgra,
+                 std::byte* destination)
+{
+    ZoneScoped;
+    ghoul_assert(image, "Image must not be nullptr");
+    ghoul_assert(destination, "Destination must not be nullptr");
+
+    const int red = isBgra ? 2 : 0;
+    const int blue = isBgra ? 0 : 2;
+
+    std::vector<glm::ivec4> pixels(static_cast<size_t>(size.x) * size.y);
+    for (size_t i = 0; i < pixels.size(); i++) {
+        const std::byte* p = image + i * 4;
+        pixels[i] = glm::ivec4(
+            std::to_integer<int>(p[red]),
+            std::to_integer<int>(p[1]),
+            std::to_integer<int>(p[blue]),
+            std::to_integer<int>(p[3])
+        );
+    }
+
+    const int nLevels = numberOfMipLevels(size);
+    glm::ivec2 levelSize = size;
+    for (int level = 0; level < nLevels; level++) {
+        compressLevel(pixels, levelSize, destination);
+        destination += bc3LevelSize(size, level);
+
+        if (level + 1 < nLevels) {
+            pixels = downsample(pixels, levelSize);
+            levelSize = glm::max(levelSize / 2, glm::ivec2(1));
+        }
+    }
+}
+
+} // namespace openspace::globebrowsing
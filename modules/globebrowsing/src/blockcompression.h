@@ -0,0 +1,69 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___BLOCKCOMPRESSION___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___BLOCKCOMPRESSION___H__
+
+#include <ghoul/glm.h>
+#include <cstddef>
+
+namespace openspace::globebrowsing {
+
+/**
+ * Returns the number of levels in a complete mip chain of an image with the provided
+ * \p size, including the base level.
+ */
+int numberOfMipLevels(glm::ivec2 size);
+
+/**
+ * Returns the number of bytes of mip level \p level of a BC3 (DXT5) compressed image
+ * with the base level \p size. Every level occupies at least one 4x4 block.
+ */
+size_t bc3LevelSize(glm::ivec2 size, int level);
+
+/**
+ * Returns the number of bytes of a BC3 (DXT5) compressed image with the base level
+ * \p size including its complete mip chain.
+ */
+size_t bc3CompressedSize(glm::ivec2 size);
+
+/**
+ * Compresses the 8-bit four channel \p image of the provided \p size into BC3 (DXT5)
+ * blocks. The complete mip chain is created by successive box filtering and all levels
+ * are written one after the other into \p destination, which has to provide room for
+ * at least bc3CompressedSize(size) bytes. The blocks of each level are written in the
+ * same row order as the pixels of the \p image, matching the layout expected by
+ * glCompressedTexSubImage2D.
+ *
+ * \param image The pixels of the image, as four bytes per pixel
+ * \param size The size of the image in pixels
+ * \param isBgra If `true`, the channels of \p image are in BGRA order, otherwise RGBA
+ * \param destination The memory into which the compressed blocks are written
+ */
+void compressBC3(const std::byte* image, glm::ivec2 size, bool isBgra,
+    std::byte* destination);
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___BLOCKCOMPRESSION___H__
@@ -53,6 +53,17 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo MaxRequestsPerHostInfo = {
+        "MaxRequestsPerHost",
+        "Maximum Requests per Host",
+        "The maximum number of tile requests that all remote layers together send to "
+        "the same server at the same time. With HTTP/2, these requests share a small "
+        "number of connections",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr int DefaultMaxRequestsPerHost = 8;
+
     void gdalErrorHandler(CPLErr eErrClass, int, const char* msg) {
         // No need to try to do this check earlier and only install this method as an
         // error handler if the logging is desired as the default behavior of GDAL is to
@@ -90,6 +101,10 @@ bool GdalWrapper::logGdalErrors() const {
     return _logGdalErrors;
 }
 
+HostRequestLimiter& GdalWrapper::hostRequestLimiter() {
+    return _hostRequestLimiter;
+}
+
 GdalWrapper::GdalWrapper(size_t maximumCacheSize, size_t maximumMaximumCacheSize)
     : PropertyOwner({ "GdalWrapper", "Gdal Wrapper" })
     , _logGdalErrors(LogGdalErrorInfo, false)
@@ -100,12 +115,19 @@ GdalWrapper::GdalWrapper(size_t maximumCacheSize, size_t maximumMaximumCacheSize
         static_cast<int>(maximumMaximumCacheSize / (1024ULL * 1024ULL)), // Maximum
         1                                           // Step: One MB
     )
+    , _maxRequestsPerHost(MaxRequestsPerHostInfo, DefaultMaxRequestsPerHost, 1, 64)
+    , _hostRequestLimiter(DefaultMaxRequestsPerHost)
 {
     ZoneScoped;
 
     addProperty(_logGdalErrors);
     addProperty(_gdalMaximumCacheSize);
 
+    _maxRequestsPerHost.onChange([this]() {
+        _hostRequestLimiter.setMaxRequestsPerHost(_maxRequestsPerHost);
+    });
+    addProperty(_maxRequestsPerHost);
+
     GDALAllRegister();
     CPLSetConfigOption(
         "GDAL_DATA",
@@ -117,6 +139,13 @@ GdalWrapper::GdalWrapper(size_t maximumCacheSize, size_t maximumMaximumCacheSize
     CPLSetConfigOption("GDAL_HTTP_TIMEOUT", "3"); // 3 seconds
     CPLSetConfigOption("CURLOPT_TIMEOUT", "3"); // 3 seconds
 
+    // Negotiate HTTP/2 for HTTPS servers so that the requests of all readers of the same
+    // server are multiplexed onto few connections, which are kept alive between tiles.
+    // Servers that do not support HTTP/2 fall back to HTTP/1.1
+    CPLSetConfigOption("GDAL_HTTP_VERSION", "2TLS");
+    CPLSetConfigOption("GDAL_HTTP_MULTIPLEX", "YES");
+    CPLSetConfigOption("GDAL_HTTP_TCP_KEEPALIVE", "YES");
+
     setGdalProxyConfiguration();
     CPLSetErrorHandler(gdalErrorHandler);
 
@@ -27,6 +27,7 @@
 
 #include <openspace/properties/propertyowner.h>
 
+#include <modules/globebrowsing/src/hostrequestlimiter.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
 
@@ -53,6 +54,12 @@ public:
 
     bool logGdalErrors() const;
 
+    /**
+     * Returns the limiter that all tile readers of remote datasets use to restrict the
+     * number of simultaneous requests to the same server.
+     */
+    HostRequestLimiter& hostRequestLimiter();
+
 private:
     GdalWrapper(size_t maximumCacheSize, size_t maximumMaximumCacheSize);
     ~GdalWrapper() override = default;
@@ -61,6 +68,9 @@ private:
 
     properties::BoolProperty _logGdalErrors;
     properties::IntProperty _gdalMaximumCacheSize;
+    properties::IntProperty _maxRequestsPerHost;
+
+    HostRequestLimiter _hostRequestLimiter;
 
     static GdalWrapper* _singleton;
 };
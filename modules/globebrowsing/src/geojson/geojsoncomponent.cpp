@@ -36,15 +36,19 @@
 #include <openspace/scene/scenegraphnode.h>
 #include <openspace/scripting/scriptengine.h>
 #include <openspace/util/updatestructures.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/programobject.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <iterator>
 #include <optional>
+#include <thread>
 
 namespace geos_nlohmann = nlohmann;
 #include <geos/geom/Geometry.h>
@@ -239,6 +243,133 @@ namespace {
             [[codegen::reference("core_light_source")]];
     };
 #include "geojsoncomponent_codegen.cpp"
+
+    constexpr int8_t CacheFileVersion = 1;
+
+    // The GeoJson file is read in blocks of this many bytes
+    constexpr size_t ReadBufferSize = 1 << 20;
+
+    /**
+     * Reads the GeoJson text from the \p stream and calls \p onFeature with the text of
+     * each element of the top-level `features` array as soon as that element has been
+     * read. This way, only a single feature has to be kept in memory at a time rather
+     * than the whole feature collection. Parsing stops early if \p onFeature returns
+     * `false`. Returns `false` if the file does not contain a top-level `features`
+     * array, for example because it only contains a single feature or geometry.
+     */
+    bool streamFeatures(std::istream& stream,
+                        const std::function<bool(std::string)>& onFeature)
+    {
+        // The depth counts the currently open objects and arrays. The feature objects
+        // are at depth 2 (inside the top-level object and the `features` array)
+        int depth = 0;
+        bool isInString = false;
+        bool isEscaped = false;
+        // The last string that was read in the top-level object
+        std::string key;
+        bool isInFeatures = false;
+        bool hasFeatures = false;
+        std::string feature;
+
+        std::vector<char> buffer(ReadBufferSize);
+        while (stream.read(buffer.data(), buffer.size()) || stream.gcount() > 0) {
+            const size_t nRead = static_cast<size_t>(stream.gcount());
+            for (size_t i = 0; i < nRead; ++i) {
+                const char c = buffer[i];
+                if (isInFeatures && depth > 2) {
+                    feature.push_back(c);
+                }
+
+                if (isInString) {
+                    if (isEscaped) {
+                        isEscaped = false;
+                    }
+                    else if (c == '\\') {
+                        isEscaped = true;
+                    }
+                    else if (c == '"') {
+                        isInString = false;
+                    }
+                    else if (depth == 1) {
+                        key.push_back(c);
+                    }
+                    continue;
+                }
+
+                switch (c) {
+                    case '"':
+                        isInString = true;
+                        if (depth == 1) {
+                            key.clear();
+                        }
+                        break;
+                    case '[':
+                        if (depth == 1 && key == "features") {
+                            isInFeatures = true;
+                            hasFeatures = true;
+                        }
+                        depth++;
+                        break;
+                    case '{':
+                        if (isInFeatures && depth == 2) {
+                            feature = "{";
+                        }
+                        depth++;
+                        break;
+                    case '}':
+                    case ']':
+                        depth--;
+                        if (isInFeatures && depth == 2 && c == '}') {
+                            if (!onFeature(std::move(feature))) {
+                                return true;
+                            }
+                            feature.clear();
+                        }
+                        else if (isInFeatures && depth == 1) {
+                            isInFeatures = false;
+                        }
+                        break;
+                }
+            }
+        }
+        return hasFeatures;
+    }
+
+    std::pair<glm::vec2, glm::vec4> featureBounds(const geos::geom::Geometry* geometry) {
+        std::unique_ptr<geos::geom::Point> centroid = geometry->getCentroid();
+        // Using `auto` here as on MacOS `getCoordinate` returns:
+        // geos::geom::Coordinate
+        // but on Windows it returns
+        // geos::geom::CoordinateXY
+        auto centroidCoord = *centroid->getCoordinate();
+        glm::vec2 centroidLatLong = glm::vec2(centroidCoord.y, centroidCoord.x);
+
+        std::unique_ptr<geos::geom::Geometry> boundingbox = geometry->getEnvelope();
+        std::unique_ptr<geos::geom::CoordinateSequence> coords =
+            boundingbox->getCoordinates();
+        glm::vec4 boundingboxLatLong;
+        if (boundingbox->isRectangle()) {
+            // A rectangle has 5 coordinates, where the first and third are two corners
+            boundingboxLatLong = glm::vec4(
+                (*coords)[0].y,
+                (*coords)[0].x,
+                (*coords)[2].y,
+                (*coords)[2].x
+            );
+        }
+        else {
+            // Invalid boundingbox. Can happen e.g. for single points.
+            // Just add a degree to every direction from the centroid
+            boundingboxLatLong = glm::vec4(
+                centroidLatLong.x - 1.f,
+                centroidLatLong.y - 1.f,
+                centroidLatLong.x + 1.f,
+                centroidLatLong.y + 1.f
+            );
+        }
+
+        return { centroidLatLong, boundingboxLatLong };
+    }
 } // namespace
 
 namespace openspace::globebrowsing {
@@ -317,6 +448,7 @@ GeoJsonComponent::GeoJsonComponent(const ghoul::Dictionary& dictionary,
     , _deletePropertyOwner({ "Deletion", "Deletion" })
     , _lightSourcePropertyOwner({ "LightSources", "Light Sources" })
     , _featuresPropertyOwner({ "Features", "Features" })
+    , _tessellationPool(std::max(std::thread::hardware_concurrency() / 2, 1u))
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -448,7 +580,20 @@ GeoJsonComponent::GeoJsonComponent(const ghoul::Dictionary& dictionary,
     addPropertySubOwner(_featuresPropertyOwner);
 }
 
-GeoJsonComponent::~GeoJsonComponent() {}
+GeoJsonComponent::~GeoJsonComponent() {
+    // The loading thread accesses the members of this component, so we have to wait for
+    // it to finish before they are destroyed
+    _stopLoading = true;
+    if (_loadingTask.valid()) {
+        _loadingTask.wait();
+    }
+}
+
+void GeoJsonComponent::LoadedFeature::writeToCache(std::ostream& file) const {
+    feature.writeToCache(file);
+    file.write(reinterpret_cast<const char*>(&centroidLatLong), sizeof(glm::vec2));
+    file.write(reinterpret_cast<const char*>(&boundingboxLatLong), sizeof(glm::vec4));
+}
 
 bool GeoJsonComponent::enabled() const {
     return _enabled;
@@ -534,12 +679,21 @@ void GeoJsonComponent::render(const RenderData& data) {
         _lightsourceRenderData
     };
 
+    // The uniforms that are shared by all features are only set once, after which all
+    // features are rendered with the same program before switching to the other one
+    _linesAndPolygonsProgram->activate();
+    GlobeGeometryFeature::setLinesAndPolygonsUniforms(
+        *_linesAndPolygonsProgram,
+        data,
+        _globeNode,
+        extraRenderdata
+    );
+
     // Do two render passes, to properly render opacity of overlaying objects
     for (int renderPass = 0; renderPass < 2; ++renderPass) {
         for (size_t i = 0; i < _geometryFeatures.size(); ++i) {
             if (_features[i]->enabled && _features[i]->isVisible()) {
-                _geometryFeatures[i].render(
-                    data,
+                _geometryFeatures[i].renderLinesAndPolygons(
                     renderPass,
                     opacity() * _features[i]->opacity(),
                     extraRenderdata
@@ -547,6 +701,22 @@ void GeoJsonComponent::render(const RenderData& data) {
             }
         }
     }
+    _linesAndPolygonsProgram->deactivate();
+
+    _pointsProgram->activate();
+    GlobeGeometryFeature::setPointsUniforms(
+        *_pointsProgram,
+        data,
+        _globeNode,
+        extraRenderdata
+    );
+    for (size_t i = 0; i < _geometryFeatures.size(); ++i) {
+        GlobeGeometryFeature& g = _geometryFeatures[i];
+        if (g.isPoints() && _features[i]->enabled && _features[i]->isVisible()) {
+            g.renderPointFeatures(opacity() * _features[i]->opacity(), extraRenderdata);
+        }
+    }
+    _pointsProgram->deactivate();
 
     if (_drawWireframe) {
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
@@ -562,6 +732,24 @@ void GeoJsonComponent::render(const RenderData& data) {
 }
 
 void GeoJsonComponent::update() {
+    addLoadedFeatures();
+
+    if (_loadingTask.valid() &&
+        _loadingTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        _loadingTask.get();
+        // The loading thread might have added features since the last call
+        addLoadedFeatures();
+
+        if (_geometryFeatures.empty()) {
+            LWARNING(fmt::format(
+                "No GeoJson features could be successfully created for GeoJson layer "
+                "with identifier '{}'. Disabling layer.", identifier()
+            ));
+            _enabled = false;
+        }
+    }
+
     if (!_enabled || !isVisible()) {
         return;
     }
@@ -582,7 +770,7 @@ void GeoJsonComponent::update() {
             g.updateTexture();
         }
 
-        g.update(_dataIsDirty, _preventUpdatesFromHeightMap);
+        g.update(_dataIsDirty, _preventUpdatesFromHeightMap, _tessellationPool);
     }
 
     _textureIsDirty = false;
@@ -590,54 +778,166 @@ void GeoJsonComponent::update() {
 }
 
 void GeoJsonComponent::readFile() {
-    std::ifstream file(_geoJsonFile);
-
-    if (!file.good()) {
+    const std::filesystem::path path = absPath(_geoJsonFile.value());
+    if (!std::filesystem::is_regular_file(path)) {
         LERROR(fmt::format("Failed to open GeoJSON file: {}", _geoJsonFile));
         return;
     }
 
-    _geometryFeatures.clear();
+    std::error_code ec;
+    const uintmax_t size = std::filesystem::file_size(path, ec);
+    const auto time = std::filesystem::last_write_time(path, ec).time_since_epoch();
+    const std::filesystem::path cachePath = FileSys.cacheManager()->cachedFilename(
+        path,
+        fmt::format("{}|{}|{}", size, time.count(), _ignoreHeightsFromFile)
+    );
 
-    std::string content(
-        (std::istreambuf_iterator<char>(file)),
-        (std::istreambuf_iterator<char>())
+    _loadingTask = std::async(
+        std::launch::async,
+        [this, path, cachePath]() { loadFeatures(path, cachePath); }
     );
+}
+
+void GeoJsonComponent::loadFeatures(std::filesystem::path path,
+                                    std::filesystem::path cachePath)
+{
+    if (std::filesystem::is_regular_file(cachePath)) {
+        if (loadCachedFeatures(cachePath)) {
+            return;
+        }
+        LINFO(fmt::format("Regenerating GeoJson cache file '{}'", cachePath));
+    }
+
+    std::ifstream file(path);
+    if (!file.good()) {
+        LERROR(fmt::format("Failed to open GeoJSON file: {}", path));
+        return;
+    }
+
+    // The cache is written while parsing, but only moved into place once the entire
+    // file has been read successfully
+    std::filesystem::path partialCachePath = cachePath;
+    partialCachePath += ".partial";
+    std::ofstream cache(partialCachePath, std::ofstream::binary);
+    cache.write(reinterpret_cast<const char*>(&CacheFileVersion), sizeof(int8_t));
+
+    int count = 1;
+    int nFeatures = 0;
+    bool success = true;
 
     // Parse GeoJSON string into GeoJSON objects
     using namespace geos::io;
     GeoJSONReader reader;
-
-    try {
+    auto parseFeatures = [&](std::string content) {
         GeoJSONFeatureCollection fc = reader.readFeatures(content);
-
-        int count = 1;
         for (const GeoJSONFeature& feature : fc.getFeatures()) {
-            parseSingleFeature(feature, count);
+            std::vector<LoadedFeature> loaded =
+                parseSingleFeature(feature, count, nFeatures);
             count++;
+            nFeatures += static_cast<int>(loaded.size());
+
+            for (const LoadedFeature& f : loaded) {
+                const uint8_t hasFeature = 1;
+                cache.write(reinterpret_cast<const char*>(&hasFeature), sizeof(uint8_t));
+                f.writeToCache(cache);
+            }
+
+            std::lock_guard lock(_loadedFeaturesMutex);
+            _loadedFeatures.insert(
+                _loadedFeatures.end(),
+                std::make_move_iterator(loaded.begin()),
+                std::make_move_iterator(loaded.end())
+            );
         }
+        return !_stopLoading;
+    };
 
-        if (_geometryFeatures.empty()) {
-            LWARNING(fmt::format(
-                "No GeoJson features could be successfully created for GeoJson layer "
-                "with identifier '{}'. Disabling layer.", identifier()
-            ));
-            _enabled = false;
+    try {
+        const bool isCollection = streamFeatures(file, parseFeatures);
+        if (!isCollection) {
+            // The file only contains a single feature or geometry, which the GeoJSON
+            // reader can handle directly
+            file.clear();
+            file.seekg(0);
+            std::string content(
+                (std::istreambuf_iterator<char>(file)),
+                (std::istreambuf_iterator<char>())
+            );
+            parseFeatures(std::move(content));
         }
     }
     catch (const geos::util::GEOSException& e) {
         LERROR(fmt::format(
             "Error creating GeoJson layer with identifier '{}'. Problem reading "
-            "GeoJson file '{}'. Error: '{}'", identifier(), _geoJsonFile, e.what()
+            "GeoJson file '{}'. Error: '{}'", identifier(), path, e.what()
         ));
+        success = false;
     }
 
-    computeMainFeatureMetaPropeties();
+    const uint8_t end = 0;
+    cache.write(reinterpret_cast<const char*>(&end), sizeof(uint8_t));
+    cache.close();
+
+    std::error_code ec;
+    if (success && !_stopLoading && cache.good()) {
+        std::filesystem::rename(partialCachePath, cachePath, ec);
+    }
+    else {
+        std::filesystem::remove(partialCachePath, ec);
+    }
+}
+
+bool GeoJsonComponent::loadCachedFeatures(const std::filesystem::path& cachePath) {
+    std::ifstream file(cachePath, std::ifstream::binary);
+    if (!file.good()) {
+        return false;
+    }
+
+    int8_t version = 0;
+    file.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+    if (version != CacheFileVersion) {
+        // Incompatible version and we won't be able to read the file
+        return false;
+    }
+
+    // Read all features before handing them over, so that a broken cache file does not
+    // lead to features being added twice once we fall back to the GeoJson file
+    std::vector<LoadedFeature> loaded;
+    uint8_t hasFeature = 0;
+    file.read(reinterpret_cast<char*>(&hasFeature), sizeof(uint8_t));
+    while (hasFeature == 1 && !_stopLoading) {
+        std::optional<GlobeGeometryFeature> feature =
+            GlobeGeometryFeature::createFromCache(file, _globeNode, _defaultProperties);
+        if (!feature.has_value()) {
+            return false;
+        }
+
+        LoadedFeature f = { .feature = std::move(*feature) };
+        file.read(reinterpret_cast<char*>(&f.centroidLatLong), sizeof(glm::vec2));
+        file.read(reinterpret_cast<char*>(&f.boundingboxLatLong), sizeof(glm::vec4));
+        loaded.push_back(std::move(f));
+
+        file.read(reinterpret_cast<char*>(&hasFeature), sizeof(uint8_t));
+    }
+
+    if (!file.good() || hasFeature != 0) {
+        return _stopLoading;
+    }
+
+    std::lock_guard lock(_loadedFeaturesMutex);
+    _loadedFeatures.insert(
+        _loadedFeatures.end(),
+        std::make_move_iterator(loaded.begin()),
+        std::make_move_iterator(loaded.end())
+    );
+    return true;
 }
 
-void GeoJsonComponent::parseSingleFeature(const geos::io::GeoJSONFeature& feature,
-                                          int indexInFile
-) {
+std::vector<GeoJsonComponent::LoadedFeature> GeoJsonComponent::parseSingleFeature(
+                                                 const geos::io::GeoJSONFeature& feature,
+                                                                          int indexInFile,
+                                                                           int firstIndex)
+{
     // Read the geometry
     const geos::geom::Geometry* geom = feature.getGeometry();
 
@@ -670,33 +970,19 @@ void GeoJsonComponent::parseSingleFeature(const geos::io::GeoJSONFeature& featur
 
     // Split other collection features into multiple individual rendered components
 
+    std::vector<LoadedFeature> result;
     for (const geos::geom::Geometry* geometry : geomsToAdd) {
-        const int index = static_cast<int>(_geometryFeatures.size());
+        const int index = firstIndex + static_cast<int>(result.size());
         try {
             GlobeGeometryFeature g(_globeNode, _defaultProperties, propsFromFile);
             g.createFromSingleGeosGeometry(geometry, index, _ignoreHeightsFromFile);
-            g.initializeGL(_pointsProgram.get(), _linesAndPolygonsProgram.get());
-            _geometryFeatures.push_back(std::move(g));
-
-            std::string name = _geometryFeatures.back().key();
-            std::string identifier = makeIdentifier(name);
 
-            // If there is already an owner with that name as an identifier, make a
-            // unique one
-            if (_featuresPropertyOwner.hasPropertySubOwner(identifier)) {
-                identifier = fmt::format("Feature{}-", index, identifier);
-            }
-
-            properties::PropertyOwner::PropertyOwnerInfo info = {
-                identifier,
-                name
-                // @TODO: Use description from file, if any
-            };
-            _features.push_back(std::make_unique<SubFeatureProps>(info));
-
-            addMetaPropertiesToFeature(*_features.back(), index, geometry);
-
-            _featuresPropertyOwner.addPropertySubOwner(_features.back().get());
+            std::pair<glm::vec2, glm::vec4> bounds = featureBounds(geometry);
+            result.push_back({
+                .feature = std::move(g),
+                .centroidLatLong = bounds.first,
+                .boundingboxLatLong = bounds.second
+            });
         }
         catch (const ghoul::RuntimeError& error) {
             LERROR(fmt::format(
@@ -708,44 +994,64 @@ void GeoJsonComponent::parseSingleFeature(const geos::io::GeoJSONFeature& featur
             // Do nothing
         }
     }
+    return result;
 }
 
-void GeoJsonComponent::addMetaPropertiesToFeature(SubFeatureProps& feature, int index,
-                                                  const geos::geom::Geometry* geometry)
-{
-    std::unique_ptr<geos::geom::Point> centroid = geometry->getCentroid();
-    // Using `auto` here as on MacOS `getCoordinate` returns:
-    // geos::geom::Coordinate
-    // but on Windows it returns
-    // geos::geom::CoordinateXY
-    auto centroidCoord = *centroid->getCoordinate();
-    glm::vec2 centroidLatLong = glm::vec2(centroidCoord.y, centroidCoord.x);
-    feature.centroidLatLong = centroidLatLong;
+void GeoJsonComponent::addLoadedFeatures() {
+    std::vector<LoadedFeature> loaded;
+    {
+        std::lock_guard lock(_loadedFeaturesMutex);
+        std::swap(loaded, _loadedFeatures);
+    }
 
-    std::unique_ptr<geos::geom::Geometry> boundingbox = geometry->getEnvelope();
-    std::unique_ptr<geos::geom::CoordinateSequence> coords =
-        boundingbox->getCoordinates();
-    glm::vec4 boundingboxLatLong;
-    if (boundingbox->isRectangle()) {
-        // A rectangle has 5 coordinates, where the first and third are two corners
-        boundingboxLatLong = glm::vec4(
-            (*coords)[0].y,
-            (*coords)[0].x,
-            (*coords)[2].y,
-            (*coords)[2].x
-        );
+    if (loaded.empty()) {
+        return;
     }
-    else {
-        // Invalid boundingbox. Can happen e.g. for single points.
-        // Just add a degree to every direction from the centroid
-        boundingboxLatLong = glm::vec4(
-            centroidLatLong.x - 1.f,
-            centroidLatLong.y - 1.f,
-            centroidLatLong.x + 1.f,
-            centroidLatLong.y + 1.f
+
+    const glm::vec3 offsets = glm::vec3(_latLongOffset.value(), _heightOffset);
+    for (LoadedFeature& f : loaded) {
+        const int index = static_cast<int>(_geometryFeatures.size());
+
+        GlobeGeometryFeature& g = f.feature;
+        g.initializeGL(_pointsProgram.get(), _linesAndPolygonsProgram.get());
+        g.setOffsets(offsets);
+        g.updateGeometry(_tessellationPool);
+        _geometryFeatures.push_back(std::move(g));
+
+        std::string name = _geometryFeatures.back().key();
+        std::string identifier = makeIdentifier(name);
+
+        // If there is already an owner with that name as an identifier, make a
+        // unique one
+        if (_featuresPropertyOwner.hasPropertySubOwner(identifier)) {
+            identifier = fmt::format("Feature{}-", index, identifier);
+        }
+
+        properties::PropertyOwner::PropertyOwnerInfo info = {
+            identifier,
+            name
+            // @TODO: Use description from file, if any
+        };
+        _features.push_back(std::make_unique<SubFeatureProps>(info));
+
+        addMetaPropertiesToFeature(
+            *_features.back(),
+            index,
+            f.centroidLatLong,
+            f.boundingboxLatLong
         );
+
+        _featuresPropertyOwner.addPropertySubOwner(_features.back().get());
     }
 
+    computeMainFeatureMetaPropeties();
+}
+
+void GeoJsonComponent::addMetaPropertiesToFeature(SubFeatureProps& feature, int index,
+                                                  glm::vec2 centroidLatLong,
+                                                  glm::vec4 boundingboxLatLong)
+{
+    feature.centroidLatLong = centroidLatLong;
     feature.boundingboxLatLong = boundingboxLatLong;
 
     // Compute the diagonal distance of the bounding box
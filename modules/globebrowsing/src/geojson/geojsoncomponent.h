@@ -40,9 +40,16 @@
 #include <openspace/properties/vector/vec2property.h>
 #include <openspace/properties/vector/vec4property.h>
 #include <openspace/rendering/helper.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/glm.h>
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <istream>
+#include <mutex>
 #include <optional>
+#include <ostream>
 #include <vector>
 
 namespace openspace {
@@ -97,15 +104,38 @@ private:
         float boundingBoxDiagonal = 0.f;
     };
 
+    /// A feature that has been read on the loading thread, but not yet been added
+    struct LoadedFeature {
+        GlobeGeometryFeature feature;
+        glm::vec2 centroidLatLong = glm::vec2(0.f);
+        glm::vec4 boundingboxLatLong = glm::vec4(0.f);
+
+        void writeToCache(std::ostream& file) const;
+    };
+
+    /// Starts loading the features from the GeoJson file on a separate thread
     void readFile();
-    void parseSingleFeature(const geos::io::GeoJSONFeature& feature, int indexInFile);
+
+    /**
+     * Reads the features from the GeoJson file at \p path, or from the binary
+     * \p cachePath if it exists, and hands them to the main thread as soon as they have
+     * been created. This function runs on the loading thread
+     */
+    void loadFeatures(std::filesystem::path path, std::filesystem::path cachePath);
+    bool loadCachedFeatures(const std::filesystem::path& cachePath);
+
+    std::vector<LoadedFeature> parseSingleFeature(const geos::io::GeoJSONFeature& feature,
+        int indexInFile, int firstIndex);
+
+    /// Adds the features that have been loaded since the last call to the component
+    void addLoadedFeatures();
 
     /**
      * Add meta properties to the feature, to allow things like flying to it,
      * identifying its location, etc
      */
     void addMetaPropertiesToFeature(SubFeatureProps& feature, int index,
-        const geos::geom::Geometry* geometry);
+        glm::vec2 centroidLatLong, glm::vec4 boundingboxLatLong);
 
     void computeMainFeatureMetaPropeties();
 
@@ -162,6 +192,16 @@ private:
 
     std::unique_ptr<ghoul::opengl::ProgramObject> _linesAndPolygonsProgram = nullptr;
     std::unique_ptr<ghoul::opengl::ProgramObject> _pointsProgram = nullptr;
+
+    // The features are tessellated on these threads so that large data sets don't block
+    // the rendering while the tessellation settings are changed
+    ThreadPool _tessellationPool;
+
+    // The features that have been loaded but not been added to the component yet
+    std::vector<LoadedFeature> _loadedFeatures;
+    std::mutex _loadedFeaturesMutex;
+    std::atomic_bool _stopLoading = false;
+    std::future<void> _loadingTask;
 };
 
 } // namespace openspace::globebrowsing
@@ -33,6 +33,7 @@
 #include <openspace/query/query.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scenegraphnode.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/fmt.h>
@@ -50,6 +51,71 @@ namespace {
     constexpr const char* _loggerCat = "GlobeGeometryFeature";
 
     constexpr std::chrono::milliseconds HeightUpdateInterval(10000);
+
+    // The number of tessellations that are kept around for each feature, so that going
+    // back to a previous offset or tessellation setting does not require a new one
+    constexpr size_t MaxCachedTessellations = 4;
+
+    template <typename T>
+    void write(std::ostream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write(std::ostream& file, const std::string& value) {
+        write(file, static_cast<uint32_t>(value.size()));
+        file.write(value.data(), value.size());
+    }
+
+    template <typename T>
+    void write(std::ostream& file, const std::vector<T>& value) {
+        write(file, static_cast<uint32_t>(value.size()));
+        file.write(
+            reinterpret_cast<const char*>(value.data()),
+            value.size() * sizeof(T)
+        );
+    }
+
+    template <typename T>
+    void write(std::ostream& file, const std::optional<T>& value) {
+        write(file, static_cast<uint8_t>(value.has_value() ? 1 : 0));
+        if (value.has_value()) {
+            write(file, *value);
+        }
+    }
+
+    template <typename T>
+    void read(std::istream& file, T& value) {
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    void read(std::istream& file, std::string& value) {
+        uint32_t size = 0;
+        read(file, size);
+        value.resize(size);
+        file.read(value.data(), size);
+    }
+
+    template <typename T>
+    void read(std::istream& file, std::vector<T>& value) {
+        uint32_t size = 0;
+        read(file, size);
+        value.resize(size);
+        file.read(reinterpret_cast<char*>(value.data()), size * sizeof(T));
+    }
+
+    template <typename T>
+    void read(std::istream& file, std::optional<T>& value) {
+        uint8_t hasValue = 0;
+        read(file, hasValue);
+        if (hasValue == 1) {
+            T v;
+            read(file, v);
+            value = std::move(v);
+        }
+        else {
+            value = std::nullopt;
+        }
+    }
 } // namespace
 
 namespace openspace::globebrowsing {
@@ -283,16 +349,89 @@ void GlobeGeometryFeature::createFromSingleGeosGeometry(const geos::geom::Geomet
     }
 }
 
-void GlobeGeometryFeature::render(const RenderData& renderData, int pass,
-                                  float mainOpacity,
-                                  const ExtraRenderData& extraRenderData)
+void GlobeGeometryFeature::writeToCache(std::ostream& file) const {
+    const GeoJsonOverrideProperties& props = _properties.overrideValues;
+    write(file, props.name);
+    write(file, props.opacity);
+    write(file, props.color);
+    write(file, props.fillOpacity);
+    write(file, props.fillColor);
+    write(file, props.lineWidth);
+    write(file, props.pointSize);
+    write(file, props.pointTexture);
+    write(file, props.pointTextureAnchor);
+    write(file, props.extrude);
+    write(file, props.performShading);
+    write(file, props.altitudeMode);
+    write(file, props.tessellationEnabled);
+    write(file, props.useTessellationLevel);
+    write(file, props.tessellationLevel);
+    write(file, props.tessellationDistance);
+
+    write(file, static_cast<int8_t>(_type));
+    write(file, _key);
+    write(file, static_cast<uint32_t>(_geoCoordinates.size()));
+    for (const std::vector<Geodetic3>& coordinates : _geoCoordinates) {
+        write(file, coordinates);
+    }
+    write(file, _triangleCoordinates);
+    write(file, _heightUpdateReferencePoints);
+}
+
+std::optional<GlobeGeometryFeature> GlobeGeometryFeature::createFromCache(
+                                                                     std::istream& file,
+                                                             const RenderableGlobe& globe,
+                                                     GeoJsonProperties& defaultProperties)
 {
-    ghoul_assert(pass >= 0 && pass < 2, "Render pass variable out of accepted range");
+    GeoJsonOverrideProperties props;
+    read(file, props.name);
+    read(file, props.opacity);
+    read(file, props.color);
+    read(file, props.fillOpacity);
+    read(file, props.fillColor);
+    read(file, props.lineWidth);
+    read(file, props.pointSize);
+    read(file, props.pointTexture);
+    read(file, props.pointTextureAnchor);
+    read(file, props.extrude);
+    read(file, props.performShading);
+    read(file, props.altitudeMode);
+    read(file, props.tessellationEnabled);
+    read(file, props.useTessellationLevel);
+    read(file, props.tessellationLevel);
+    read(file, props.tessellationDistance);
+
+    GlobeGeometryFeature feature(globe, defaultProperties, props);
+
+    int8_t type = 0;
+    read(file, type);
+    feature._type = static_cast<GeometryType>(type);
+    read(file, feature._key);
+    uint32_t nCoordinateLists = 0;
+    read(file, nCoordinateLists);
+    if (!file.good()) {
+        return std::nullopt;
+    }
+    feature._geoCoordinates.resize(nCoordinateLists);
+    for (std::vector<Geodetic3>& coordinates : feature._geoCoordinates) {
+        read(file, coordinates);
+    }
+    read(file, feature._triangleCoordinates);
+    read(file, feature._heightUpdateReferencePoints);
 
-    float opacity = mainOpacity * _properties.opacity();
-    float fillOpacity = mainOpacity * _properties.fillOpacity();
+    if (!file.good()) {
+        return std::nullopt;
+    }
+    return feature;
+}
 
-    const glm::dmat4 globeModelTransform = _globe.modelTransform();
+void GlobeGeometryFeature::setLinesAndPolygonsUniforms(
+                                                   ghoul::opengl::ProgramObject& program,
+                                                             const RenderData& renderData,
+                                                             const RenderableGlobe& globe,
+                                                   const ExtraRenderData& extraRenderData)
+{
+    const glm::dmat4 globeModelTransform = globe.modelTransform();
     const glm::dmat4 modelViewTransform =
         renderData.camera.combinedViewMatrix() * globeModelTransform;
 
@@ -300,7 +439,64 @@ void GlobeGeometryFeature::render(const RenderData& renderData, int pass,
         glm::transpose(glm::inverse(modelViewTransform))
     );
 
-    const glm::dmat4 projectionTransform = renderData.camera.projectionMatrix();
+    program.setUniform("modelTransform", globeModelTransform);
+    program.setUniform("viewTransform", renderData.camera.combinedViewMatrix());
+    program.setUniform("projectionTransform", renderData.camera.projectionMatrix());
+
+    const rendering::helper::LightSourceRenderData& ls = extraRenderData.lightSourceData;
+    program.setUniform("normalTransform", normalTransform);
+    program.setUniform("nLightSources", ls.nLightSources);
+    program.setUniform("lightIntensities", ls.intensitiesBuffer);
+    program.setUniform("lightDirectionsViewSpace", ls.directionsViewSpaceBuffer);
+}
+
+void GlobeGeometryFeature::setPointsUniforms(ghoul::opengl::ProgramObject& program,
+                                             const RenderData& renderData,
+                                             const RenderableGlobe& globe,
+                                             const ExtraRenderData& extraRenderData)
+{
+    program.setUniform("modelTransform", globe.modelTransform());
+    program.setUniform("viewTransform", renderData.camera.combinedViewMatrix());
+    program.setUniform("projectionTransform", renderData.camera.projectionMatrix());
+
+    program.setUniform(
+        "renderMode",
+        static_cast<int>(extraRenderData.pointRenderMode)
+    );
+
+    // Points are rendered as billboards
+    glm::dvec3 cameraViewDirectionWorld = -renderData.camera.viewDirectionWorldSpace();
+    glm::dvec3 cameraUpDirectionWorld = renderData.camera.lookUpVectorWorldSpace();
+    glm::dvec3 orthoRight = glm::normalize(
+        glm::cross(cameraUpDirectionWorld, cameraViewDirectionWorld)
+    );
+    if (orthoRight == glm::dvec3(0.0)) {
+        // For some reason, the up vector and camera view vecter were the same. Use a
+        // slightly different vector
+        glm::dvec3 otherVector = glm::vec3(
+            cameraUpDirectionWorld.y,
+            cameraUpDirectionWorld.x,
+            cameraUpDirectionWorld.z
+        );
+        orthoRight = glm::normalize(glm::cross(otherVector, cameraViewDirectionWorld));
+    }
+    glm::dvec3 orthoUp = glm::normalize(glm::cross(cameraViewDirectionWorld, orthoRight));
+
+    program.setUniform("cameraUp", glm::vec3(orthoUp));
+    program.setUniform("cameraRight", glm::vec3(orthoRight));
+
+    glm::dvec3 cameraPositionWorld = renderData.camera.positionVec3();
+    program.setUniform("cameraPosition", cameraPositionWorld);
+    program.setUniform("cameraLookUp", glm::vec3(cameraUpDirectionWorld));
+}
+
+void GlobeGeometryFeature::renderLinesAndPolygons(int pass, float mainOpacity,
+                                                  const ExtraRenderData& extraRenderData)
+{
+    ghoul_assert(pass >= 0 && pass < 2, "Render pass variable out of accepted range");
+
+    float opacity = mainOpacity * _properties.opacity();
+    float fillOpacity = mainOpacity * _properties.fillOpacity();
 
 #ifndef __APPLE__
     glLineWidth(_properties.lineWidth() * extraRenderData.lineWidthScale);
@@ -309,6 +505,10 @@ void GlobeGeometryFeature::render(const RenderData& renderData, int pass,
 #endif
 
     for (const RenderFeature& r : _renderFeatures) {
+        if (r.type == RenderType::Points) {
+            continue;
+        }
+
         if (r.isExtrusionFeature && !_properties.extrude()) {
             continue;
         }
@@ -320,63 +520,48 @@ void GlobeGeometryFeature::render(const RenderData& renderData, int pass,
             continue;
         }
 
-        ghoul::opengl::ProgramObject* shader = (r.type == RenderType::Points) ?
-            _pointsProgram : _linesAndPolygonsProgram;
-
-        shader->activate();
-        shader->setUniform("modelTransform", globeModelTransform);
-        shader->setUniform("viewTransform", renderData.camera.combinedViewMatrix());
-        shader->setUniform("projectionTransform", projectionTransform);
-
-        shader->setUniform("heightOffset", _offsets.z);
-        shader->setUniform("useHeightMapData", useHeightMap());
-
-        if (shader == _linesAndPolygonsProgram) {
-            const rendering::helper::LightSourceRenderData& ls =
-                extraRenderData.lightSourceData;
-            shader->setUniform("normalTransform", normalTransform);
-            shader->setUniform("nLightSources", ls.nLightSources);
-            shader->setUniform("lightIntensities", ls.intensitiesBuffer);
-            shader->setUniform("lightDirectionsViewSpace", ls.directionsViewSpaceBuffer);
-        }
+        _linesAndPolygonsProgram->setUniform("heightOffset", _offsets.z);
+        _linesAndPolygonsProgram->setUniform("useHeightMapData", useHeightMap());
 
         glBindVertexArray(r.vaoId);
 
         switch (r.type) {
             case RenderType::Lines:
-                shader->setUniform(
+                _linesAndPolygonsProgram->setUniform(
                     "opacity",
                     r.isExtrusionFeature ? fillOpacity : opacity
                 );
                 renderLines(r);
                 break;
-            case RenderType::Points: {
-                shader->setUniform("opacity", opacity);
-                float scale = extraRenderData.pointSizeScale;
-                renderPoints(r, renderData, extraRenderData.pointRenderMode, scale);
-                break;
-            }
             case RenderType::Polygon: {
-                shader->setUniform("opacity", fillOpacity);
+                _linesAndPolygonsProgram->setUniform("opacity", fillOpacity);
                 renderPolygons(r, shouldRenderTwice, pass);
                 break;
             }
             default:
                 throw ghoul::MissingCaseException();
         }
-
-        shader->deactivate();
     }
+}
 
-    glBindVertexArray(0);
+void GlobeGeometryFeature::renderPointFeatures(float mainOpacity,
+                                               const ExtraRenderData& extraRenderData)
+{
+    for (const RenderFeature& r : _renderFeatures) {
+        if (r.type != RenderType::Points) {
+            continue;
+        }
+
+        _pointsProgram->setUniform("heightOffset", _offsets.z);
+        _pointsProgram->setUniform("useHeightMapData", useHeightMap());
+        _pointsProgram->setUniform("opacity", mainOpacity * _properties.opacity());
 
-    // Reset when we're done rendering all the polygon features
-    global::renderEngine->openglStateCache().resetPolygonAndClippingState();
+        glBindVertexArray(r.vaoId);
+        renderPoints(r, extraRenderData.pointSizeScale);
+    }
 }
 
 void GlobeGeometryFeature::renderPoints(const RenderFeature& feature,
-                                        const RenderData& renderData,
-                                        const PointRenderMode& renderMode,
                                         float sizeScale) const
 {
     ghoul_assert(feature.type == RenderType::Points, "Trying to render faulty geometry");
@@ -386,39 +571,12 @@ void GlobeGeometryFeature::renderPoints(const RenderFeature& feature,
     float size = 0.001f * sizeScale * _properties.pointSize() * bs;
     _pointsProgram->setUniform("pointSize", size);
 
-    _pointsProgram->setUniform("renderMode", static_cast<int>(renderMode));
-
     using TextureAnchor = GeoJsonProperties::PointTextureAnchor;
     _pointsProgram->setUniform(
         "useBottomAnchorPoint",
         _properties.pointTextureAnchor() != TextureAnchor::Center
     );
 
-    // Points are rendered as billboards
-    glm::dvec3 cameraViewDirectionWorld = -renderData.camera.viewDirectionWorldSpace();
-    glm::dvec3 cameraUpDirectionWorld = renderData.camera.lookUpVectorWorldSpace();
-    glm::dvec3 orthoRight = glm::normalize(
-        glm::cross(cameraUpDirectionWorld, cameraViewDirectionWorld)
-    );
-    if (orthoRight == glm::dvec3(0.0)) {
-        // For some reason, the up vector and camera view vecter were the same. Use a
-        // slightly different vector
-        glm::dvec3 otherVector = glm::vec3(
-            cameraUpDirectionWorld.y,
-            cameraUpDirectionWorld.x,
-            cameraUpDirectionWorld.z
-        );
-        orthoRight = glm::normalize(glm::cross(otherVector, cameraViewDirectionWorld));
-    }
-    glm::dvec3 orthoUp = glm::normalize(glm::cross(cameraViewDirectionWorld, orthoRight));
-
-    _pointsProgram->setUniform("cameraUp", glm::vec3(orthoUp));
-    _pointsProgram->setUniform("cameraRight", glm::vec3(orthoRight));
-
-    glm::dvec3 cameraPositionWorld = renderData.camera.positionVec3();
-    _pointsProgram->setUniform("cameraPosition", cameraPositionWorld);
-    _pointsProgram->setUniform("cameraLookUp", glm::vec3(cameraUpDirectionWorld));
-
     if (_pointTexture && _hasTexture) {
         ghoul::opengl::TextureUnit unit;
         unit.activate();
@@ -508,12 +666,27 @@ bool GlobeGeometryFeature::shouldUpdateDueToHeightMapChange() const {
     return false;
 }
 
-void GlobeGeometryFeature::update(bool dataIsDirty, bool preventHeightUpdates) {
-    if (!preventHeightUpdates && shouldUpdateDueToHeightMapChange()) {
-        updateHeightsFromHeightMap();
+void GlobeGeometryFeature::update(bool dataIsDirty, bool preventHeightUpdates,
+                                  ThreadPool& pool)
+{
+    if (dataIsDirty) {
+        updateGeometry(pool);
+    }
+
+    const bool hasFinishedTessellation = _pendingTessellation.valid() &&
+        _pendingTessellation.wait_for(std::chrono::seconds(0)) ==
+        std::future_status::ready;
+
+    if (hasFinishedTessellation) {
+        std::shared_ptr<const Tessellation> tessellation = _pendingTessellation.get();
+        _tessellationCache.emplace_back(_pendingTessellationKey, tessellation);
+        if (_tessellationCache.size() > MaxCachedTessellations) {
+            _tessellationCache.erase(_tessellationCache.begin());
+        }
+        applyTessellation(*tessellation);
     }
-    else if (dataIsDirty) {
-        updateGeometry();
+    else if (!preventHeightUpdates && shouldUpdateDueToHeightMapChange()) {
+        updateHeightsFromHeightMap();
     }
 
     if (_pointTexture) {
@@ -521,21 +694,54 @@ void GlobeGeometryFeature::update(bool dataIsDirty, bool preventHeightUpdates) {
     }
 }
 
-void GlobeGeometryFeature::updateGeometry() {
-    // Update vertex data and compute model coordinates based on globe
-    _renderFeatures.clear();
+void GlobeGeometryFeature::updateGeometry(ThreadPool& pool) {
+    const TessellationKey key = currentTessellationKey();
 
-    if (_type == GeometryType::Point) {
-        createPointGeometry();
+    auto it = std::find_if(
+        _tessellationCache.begin(),
+        _tessellationCache.end(),
+        [&key](const std::pair<TessellationKey, std::shared_ptr<const Tessellation>>& p) {
+            return p.first == key;
+        }
+    );
+    if (it != _tessellationCache.end()) {
+        // Move the tessellation to the back as it is now the most recently used one
+        std::shared_ptr<const Tessellation> tessellation = it->second;
+        _tessellationCache.erase(it);
+        _tessellationCache.emplace_back(key, tessellation);
+
+        // Any tessellation that is still running is outdated now
+        _pendingTessellation = {};
+        applyTessellation(*tessellation);
+        return;
     }
-    else {
-        std::vector<std::vector<glm::vec3>> edgeVertices = createLineGeometry();
-        createExtrudedGeometry(edgeVertices);
-        createPolygonGeometry();
+
+    if (_pendingTessellation.valid() && _pendingTessellationKey == key) {
+        // We are already computing this one
+        return;
     }
 
-    // Compute new heights - to see if height map changed
-    _lastControlHeights = getCurrentReferencePointsHeights();
+    // The task gets its own copy of the coordinates so that it does not depend on the
+    // lifetime of this feature
+    using Result = std::shared_ptr<const Tessellation>;
+    auto promise = std::make_shared<std::promise<Result>>();
+    _pendingTessellation = promise->get_future();
+    _pendingTessellationKey = key;
+
+    pool.enqueue(
+        [promise, &globe = _globe, type = _type, geoCoordinates = _geoCoordinates,
+         triangleCoordinates = _triangleCoordinates, key]()
+        {
+            try {
+                promise->set_value(std::make_shared<const Tessellation>(
+                    tessellate(globe, type, geoCoordinates, triangleCoordinates, key)
+                ));
+            }
+            catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        }
+    );
 }
 
 void GlobeGeometryFeature::updateHeightsFromHeightMap() {
@@ -551,28 +757,93 @@ void GlobeGeometryFeature::updateHeightsFromHeightMap() {
     _lastHeightUpdateTime = std::chrono::system_clock::now();
 }
 
-std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry() {
+GlobeGeometryFeature::Tessellation GlobeGeometryFeature::tessellate(
+                                       const RenderableGlobe& globe, GeometryType type,
+                               const std::vector<std::vector<Geodetic3>>& geoCoordinates,
+                                        const std::vector<Geodetic3>& triangleCoordinates,
+                                                               const TessellationKey& key)
+{
+    Tessellation result;
+    if (type == GeometryType::Point) {
+        createPointGeometry(globe, geoCoordinates, key, result);
+    }
+    else {
+        std::vector<std::vector<glm::vec3>> edgeVertices =
+            createLineGeometry(globe, geoCoordinates, key, result);
+        createExtrudedGeometry(globe, edgeVertices, result);
+        createPolygonGeometry(globe, triangleCoordinates, key, result);
+    }
+    return result;
+}
+
+GlobeGeometryFeature::TessellationKey GlobeGeometryFeature::currentTessellationKey() const
+{
+    return {
+        .latLongOffset = glm::vec2(_offsets.x, _offsets.y),
+        .isTessellated = _properties.tessellationEnabled(),
+        .stepSize = tessellationStepSize()
+    };
+}
+
+void GlobeGeometryFeature::applyTessellation(const Tessellation& tessellation) {
+    for (const RenderFeature& r : _renderFeatures) {
+        glDeleteVertexArrays(1, &r.vaoId);
+        glDeleteBuffers(1, &r.vboId);
+    }
+    _renderFeatures.clear();
+    _renderFeatures.reserve(tessellation.size());
+
+    for (const TessellatedPart& part : tessellation) {
+        RenderFeature feature;
+        feature.type = part.type;
+        feature.isExtrusionFeature = part.isExtrusionFeature;
+        feature.nVertices = part.vertices.size();
+
+        // Get height map heights. These depend on the currently loaded height tiles and
+        // can thus not be part of the tessellation
+        feature.vertices = part.geodetics;
+        feature.heights = geometryhelper::heightMapHeightsFromGeodetic2List(
+            _globe,
+            feature.vertices
+        );
+
+        // Generate buffers and buffer data
+        feature.initializeBuffers();
+        bufferVertexData(feature, part.vertices);
+        _renderFeatures.push_back(std::move(feature));
+    }
+
+    // Compute new heights - to see if height map changed
+    _lastControlHeights = getCurrentReferencePointsHeights();
+}
+
+std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry(
+                                                             const RenderableGlobe& globe,
+                               const std::vector<std::vector<Geodetic3>>& geoCoordinates,
+                                                               const TessellationKey& key,
+                                                                     Tessellation& result)
+{
     std::vector<std::vector<glm::vec3>> resultPositions;
-    resultPositions.reserve(_geoCoordinates.size());
+    resultPositions.reserve(geoCoordinates.size());
 
-    for (size_t i = 0; i < _geoCoordinates.size(); ++i) {
+    for (size_t i = 0; i < geoCoordinates.size(); ++i) {
         std::vector<Vertex> vertices;
         std::vector<glm::vec3> positions;
         // TODO: this is not correct anymore
-        vertices.reserve(_geoCoordinates[i].size() * 3);
+        vertices.reserve(geoCoordinates[i].size() * 3);
         // TODO: this is not correct anymore
-        positions.reserve(_geoCoordinates[i].size() * 3);
+        positions.reserve(geoCoordinates[i].size() * 3);
 
         glm::dvec3 lastPos = glm::dvec3(0.0);
         double lastHeightValue = 0.0;
 
         bool isFirst = true;
-        for (const Geodetic3& geodetic : _geoCoordinates[i]) {
+        for (const Geodetic3& geodetic : geoCoordinates[i]) {
             glm::dvec3 v = geometryhelper::computeOffsetedModelCoordinate(
                 geodetic,
-                _globe,
-                _offsets.x,
-                _offsets.y
+                globe,
+                key.latLongOffset.x,
+                key.latLongOffset.y
             );
 
             auto addLinePos = [&vertices, &positions](glm::vec3 pos) {
@@ -588,19 +859,16 @@ std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry() {
                 continue;
             }
 
-            if (_properties.tessellationEnabled()) {
-                // Tessellate.
-                // But first, determine the step size for the tessellation (larger
-                // features will not be tesselated)
-                float stepSize = tessellationStepSize();
-
+            if (key.isTessellated) {
+                // Tessellate, using the step size that was determined from the
+                // properties (larger features will not be tesselated)
                 std::vector<geometryhelper::PosHeightPair> subdividedPositions =
                     geometryhelper::subdivideLine(
                         lastPos,
                         v,
                         lastHeightValue,
                         geodetic.height,
-                        stepSize
+                        key.stepSize
                     );
 
                 // Don't add the first position. Has been added as last in previous step
@@ -619,12 +887,7 @@ std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry() {
         }
 
         vertices.shrink_to_fit();
-
-        RenderFeature feature;
-        feature.nVertices = vertices.size();
-        feature.type = RenderType::Lines;
-        initializeRenderFeature(feature, vertices);
-        _renderFeatures.push_back(std::move(feature));
+        addTessellatedPart(globe, RenderType::Lines, false, std::move(vertices), result);
 
         positions.shrink_to_fit();
         resultPositions.push_back(std::move(positions));
@@ -634,24 +897,24 @@ std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry() {
     return resultPositions;
 }
 
-void GlobeGeometryFeature::createPointGeometry() {
-    if (_type != GeometryType::Point) {
-        return;
-    }
-
-    for (size_t i = 0; i < _geoCoordinates.size(); ++i) {
+void GlobeGeometryFeature::createPointGeometry(const RenderableGlobe& globe,
+                               const std::vector<std::vector<Geodetic3>>& geoCoordinates,
+                                                       const TessellationKey& key,
+                                                       Tessellation& result)
+{
+    for (size_t i = 0; i < geoCoordinates.size(); ++i) {
         std::vector<Vertex> vertices;
-        vertices.reserve(_geoCoordinates[i].size());
+        vertices.reserve(geoCoordinates[i].size());
 
         std::vector<Vertex> extrudedLineVertices;
-        extrudedLineVertices.reserve(2 * _geoCoordinates[i].size());
+        extrudedLineVertices.reserve(2 * geoCoordinates[i].size());
 
-        for (const Geodetic3& geodetic : _geoCoordinates[i]) {
+        for (const Geodetic3& geodetic : geoCoordinates[i]) {
             glm::dvec3 v = geometryhelper::computeOffsetedModelCoordinate(
                 geodetic,
-                _globe,
-                _offsets.x,
-                _offsets.y
+                globe,
+                key.latLongOffset.x,
+                key.latLongOffset.y
             );
 
             glm::vec3 vf = static_cast<glm::vec3>(v);
@@ -668,24 +931,22 @@ void GlobeGeometryFeature::createPointGeometry() {
         vertices.shrink_to_fit();
         extrudedLineVertices.shrink_to_fit();
 
-        RenderFeature feature;
-        feature.nVertices = vertices.size();
-        feature.type = RenderType::Points;
-        initializeRenderFeature(feature, vertices);
-        _renderFeatures.push_back(std::move(feature));
+        addTessellatedPart(globe, RenderType::Points, false, std::move(vertices), result);
 
         // Create extrusion feature
-        RenderFeature extrudeFeature;
-        extrudeFeature.nVertices = extrudedLineVertices.size();
-        extrudeFeature.type = RenderType::Lines;
-        extrudeFeature.isExtrusionFeature = true;
-        initializeRenderFeature(extrudeFeature, extrudedLineVertices);
-        _renderFeatures.push_back(std::move(extrudeFeature));
+        addTessellatedPart(
+            globe,
+            RenderType::Lines,
+            true,
+            std::move(extrudedLineVertices),
+            result
+        );
     }
 }
 
-void GlobeGeometryFeature::createExtrudedGeometry(
-                                 const std::vector<std::vector<glm::vec3>>& edgeVertices)
+void GlobeGeometryFeature::createExtrudedGeometry(const RenderableGlobe& globe,
+                                const std::vector<std::vector<glm::vec3>>& edgeVertices,
+                                                          Tessellation& result)
 {
     if (edgeVertices.empty()) {
         return;
@@ -694,16 +955,15 @@ void GlobeGeometryFeature::createExtrudedGeometry(
     std::vector<Vertex> vertices =
         geometryhelper::createExtrudedGeometryVertices(edgeVertices);
 
-    RenderFeature feature;
-    feature.type = RenderType::Polygon;
-    feature.nVertices = vertices.size();
-    feature.isExtrusionFeature = true;
-    initializeRenderFeature(feature, vertices);
-    _renderFeatures.push_back(std::move(feature));
+    addTessellatedPart(globe, RenderType::Polygon, true, std::move(vertices), result);
 }
 
-void GlobeGeometryFeature::createPolygonGeometry() {
-    if (_triangleCoordinates.empty()) {
+void GlobeGeometryFeature::createPolygonGeometry(const RenderableGlobe& globe,
+                                        const std::vector<Geodetic3>& triangleCoordinates,
+                                                         const TessellationKey& key,
+                                                         Tessellation& result)
+{
+    if (triangleCoordinates.empty()) {
         return;
     }
 
@@ -713,12 +973,12 @@ void GlobeGeometryFeature::createPolygonGeometry() {
     int triIndex = 0;
     std::array<glm::vec3, 3> triPositions;
     std::array<double, 3> triHeights;
-    for (const Geodetic3& geodetic : _triangleCoordinates) {
+    for (const Geodetic3& geodetic : triangleCoordinates) {
         const glm::vec3 vert = geometryhelper::computeOffsetedModelCoordinate(
             geodetic,
-            _globe,
-            _offsets.x,
-            _offsets.y
+            globe,
+            key.latLongOffset.x,
+            key.latLongOffset.y
         );
         triPositions[triIndex] = vert;
         triHeights[triIndex] = geodetic.height;
@@ -736,16 +996,14 @@ void GlobeGeometryFeature::createPolygonGeometry() {
             double h1 = triHeights[1];
             double h2 = triHeights[2];
 
-            if (_properties.tessellationEnabled()) {
-                // First determine the step size for the tessellation (larger features
+            if (key.isTessellated) {
+                // The step size was determined from the properties (larger features
                 // will not be tesselated)
-                float stepSize = tessellationStepSize();
-
                 std::vector<Vertex> verts = geometryhelper::subdivideTriangle(
                     v0, v1, v2,
                     h0, h1, h2,
-                    stepSize,
-                    _globe
+                    key.stepSize,
+                    globe
                 );
                 polyVertices.insert(polyVertices.end(), verts.begin(), verts.end());
             }
@@ -759,26 +1017,27 @@ void GlobeGeometryFeature::createPolygonGeometry() {
         }
     }
 
-    RenderFeature triFeature;
-    triFeature.type = RenderType::Polygon;
-    triFeature.nVertices = polyVertices.size();
-    initializeRenderFeature(triFeature, polyVertices);
-    _renderFeatures.push_back(std::move(triFeature));
+    addTessellatedPart(
+        globe,
+        RenderType::Polygon,
+        false,
+        std::move(polyVertices),
+        result
+    );
 }
 
-void GlobeGeometryFeature::initializeRenderFeature(RenderFeature& feature,
-                                                   const std::vector<Vertex>& vertices)
+void GlobeGeometryFeature::addTessellatedPart(const RenderableGlobe& globe,
+                                              RenderType type, bool isExtrusionFeature,
+                                              std::vector<Vertex> vertices,
+                                              Tessellation& result)
 {
-    // Get height map heights
-    feature.vertices = geometryhelper::geodetic2FromVertexList(_globe, vertices);
-    feature.heights = geometryhelper::heightMapHeightsFromGeodetic2List(
-        _globe,
-        feature.vertices
-    );
-
-    // Generate buffers and buffer data
-    feature.initializeBuffers();
-    bufferVertexData(feature, vertices);
+    TessellatedPart part;
+    part.type = type;
+    part.isExtrusionFeature = isExtrusionFeature;
+    // Store the geodetic coordinates so we can quickly look up the height map heights
+    part.geodetics = geometryhelper::geodetic2FromVertexList(globe, vertices);
+    part.vertices = std::move(vertices);
+    result.push_back(std::move(part));
 }
 
 float GlobeGeometryFeature::tessellationStepSize() const {
@@ -794,19 +1053,18 @@ float GlobeGeometryFeature::tessellationStepSize() const {
 }
 
 std::vector<double> GlobeGeometryFeature::getCurrentReferencePointsHeights() const {
-    std::vector<double> newHeights;
-    newHeights.reserve(_heightUpdateReferencePoints.size());
+    std::vector<glm::dvec3> positions;
+    positions.reserve(_heightUpdateReferencePoints.size());
     for (const Geodetic3& geo : _heightUpdateReferencePoints) {
-        const glm::dvec3 p = geometryhelper::computeOffsetedModelCoordinate(
+        positions.push_back(geometryhelper::computeOffsetedModelCoordinate(
             geo,
             _globe,
             _offsets.x,
             _offsets.y
-        );
-        const SurfacePositionHandle handle = _globe.calculateSurfacePositionHandle(p);
-        newHeights.push_back(handle.heightToSurface);
+        ));
     }
-    return newHeights;
+    const std::vector<float> heights = _globe.heights(positions);
+    return std::vector<double>(heights.begin(), heights.end());
 }
 
 void GlobeGeometryFeature::bufferVertexData(const RenderFeature& feature,
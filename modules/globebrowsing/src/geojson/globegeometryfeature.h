@@ -34,8 +34,15 @@
 #include <ghoul/glm.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <chrono>
+#include <future>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <utility>
 #include <vector>
 
+namespace openspace { class ThreadPool; }
 namespace openspace::documentation { struct Documentation; }
 namespace rendering::helper {
     struct LightSourceRenderData;
@@ -129,19 +136,93 @@ public:
     void createFromSingleGeosGeometry(const geos::geom::Geometry* geo, int index,
         bool ignoreHeights);
 
-    // 2 pass rendering to get correct culling for polygons
-    void render(const RenderData& renderData, int pass, float mainOpacity,
+    /**
+     * Writes the coordinates that were created in #createFromSingleGeosGeometry together
+     * with the properties that were read from the GeoJson file to the binary \p file.
+     */
+    void writeToCache(std::ostream& file) const;
+
+    /**
+     * Creates a feature from the binary \p file that was written by #writeToCache.
+     * Returns `std::nullopt` if the feature could not be read from the file.
+     */
+    static std::optional<GlobeGeometryFeature> createFromCache(std::istream& file,
+        const RenderableGlobe& globe, GeoJsonProperties& defaultProperties);
+
+    /**
+     * Sets the uniforms of the \p program that are the same for all features of the
+     * \p globe. This has to be called once per frame before the lines and polygons of
+     * the features are rendered with #renderLinesAndPolygons.
+     */
+    static void setLinesAndPolygonsUniforms(ghoul::opengl::ProgramObject& program,
+        const RenderData& renderData, const RenderableGlobe& globe,
         const ExtraRenderData& extraRenderData);
 
+    /**
+     * Sets the uniforms of the \p program that are the same for all features of the
+     * \p globe. This has to be called once per frame before the points of the features
+     * are rendered with #renderPointFeatures.
+     */
+    static void setPointsUniforms(ghoul::opengl::ProgramObject& program,
+        const RenderData& renderData, const RenderableGlobe& globe,
+        const ExtraRenderData& extraRenderData);
+
+    // 2 pass rendering to get correct culling for polygons. Expects the lines and
+    // polygons program to be active
+    void renderLinesAndPolygons(int pass, float mainOpacity,
+        const ExtraRenderData& extraRenderData);
+
+    // Expects the points program to be active
+    void renderPointFeatures(float mainOpacity, const ExtraRenderData& extraRenderData);
+
     bool shouldUpdateDueToHeightMapChange() const;
 
-    void update(bool dataIsDirty, bool preventHeightUpdates);
-    void updateGeometry();
+    /**
+     * Updates the heights and the geometry of the feature. If \p dataIsDirty, the
+     * feature is tessellated again on one of the threads of the \p pool, unless the
+     * result for the current settings is already cached. The new geometry replaces the
+     * old geometry as soon as the tessellation has finished.
+     */
+    void update(bool dataIsDirty, bool preventHeightUpdates, ThreadPool& pool);
+    void updateGeometry(ThreadPool& pool);
     void updateHeightsFromHeightMap();
 
 private:
-    void renderPoints(const RenderFeature& feature, const RenderData& renderData,
-        const PointRenderMode& renderMode, float sizeScale) const;
+    /// The settings that the tessellated geometry of the feature depends on
+    struct TessellationKey {
+        glm::vec2 latLongOffset = glm::vec2(0.f);
+        bool isTessellated = false;
+        float stepSize = 0.f;
+
+        bool operator==(const TessellationKey&) const = default;
+    };
+
+    /// The vertices for a single render feature before they are uploaded to the GPU
+    struct TessellatedPart {
+        RenderType type = RenderType::Uninitialized;
+        bool isExtrusionFeature = false;
+        std::vector<Vertex> vertices;
+
+        // The geodetic lat long coordinates of each vertex
+        std::vector<Geodetic2> geodetics;
+    };
+    using Tessellation = std::vector<TessellatedPart>;
+
+    /**
+     * Creates the vertices for all parts of a feature with the provided \p type and
+     * coordinates using the settings in the \p key. This function does not touch any
+     * OpenGL or height map state and can therefore be called from any thread.
+     */
+    static Tessellation tessellate(const RenderableGlobe& globe, GeometryType type,
+        const std::vector<std::vector<Geodetic3>>& geoCoordinates,
+        const std::vector<Geodetic3>& triangleCoordinates, const TessellationKey& key);
+
+    TessellationKey currentTessellationKey() const;
+
+    /// Replaces the render features with the ones from the \p tessellation
+    void applyTessellation(const Tessellation& tessellation);
+
+    void renderPoints(const RenderFeature& feature, float sizeScale) const;
 
     void renderLines(const RenderFeature& feature) const;
 
@@ -152,27 +233,35 @@ private:
      * Create the vertex information for any line parts of the feature.
      * Returns the resulting vertex positions, so we can use them for extrusion
      */
-    std::vector<std::vector<glm::vec3>> createLineGeometry();
+    static std::vector<std::vector<glm::vec3>> createLineGeometry(
+        const RenderableGlobe& globe,
+        const std::vector<std::vector<Geodetic3>>& geoCoordinates,
+        const TessellationKey& key, Tessellation& result);
 
     /**
      * Create the vertex information for any point parts of the feature. Also creates
      * the features for extruded lines for the points
      */
-    void createPointGeometry();
+    static void createPointGeometry(const RenderableGlobe& globe,
+        const std::vector<std::vector<Geodetic3>>& geoCoordinates,
+        const TessellationKey& key, Tessellation& result);
 
     /**
      * Create the triangle geometry for the extruded edges of lines/polygons
      */
-    void createExtrudedGeometry(const std::vector<std::vector<glm::vec3>>& edgeVertices);
+    static void createExtrudedGeometry(const RenderableGlobe& globe,
+        const std::vector<std::vector<glm::vec3>>& edgeVertices, Tessellation& result);
 
     /**
      * Create the triangle geometry for the polygon part of the feature (the area
      * contained by the shape)
      */
-    void createPolygonGeometry();
+    static void createPolygonGeometry(const RenderableGlobe& globe,
+        const std::vector<Geodetic3>& triangleCoordinates, const TessellationKey& key,
+        Tessellation& result);
 
-    void initializeRenderFeature(RenderFeature& feature,
-        const std::vector<Vertex>& vertices);
+    static void addTessellatedPart(const RenderableGlobe& globe, RenderType type,
+        bool isExtrusionFeature, std::vector<Vertex> vertices, Tessellation& result);
 
     /// Get the distance that shall be used for tessellation, based on the properties
     float tessellationStepSize() const;
@@ -210,6 +299,12 @@ private:
     std::vector<double> _lastControlHeights;
     std::chrono::system_clock::time_point _lastHeightUpdateTime;
 
+    // The most recently used tessellations, with the most recent one last
+    std::vector<std::pair<TessellationKey, std::shared_ptr<const Tessellation>>>
+        _tessellationCache;
+    TessellationKey _pendingTessellationKey;
+    std::future<std::shared_ptr<const Tessellation>> _pendingTessellation;
+
     bool _hasTexture = false;
     std::unique_ptr<TextureComponent> _pointTexture;
 
@@ -214,6 +214,12 @@ void GlobeRotation::update(const UpdateData& data) {
     Rotation::update(data);
 }
 
+bool GlobeRotation::isThreadSafe() const {
+    // We are sampling the height map of the attached globe, which might be updated by
+    // the globe at the same time
+    return false;
+}
+
 glm::dmat3 GlobeRotation::matrix(const UpdateData&) const {
     if (!_globeNode) {
         // @TODO(abock): The const cast should be removed on a redesign of the rotation
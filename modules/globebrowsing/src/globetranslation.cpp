@@ -208,6 +208,12 @@ void GlobeTranslation::update(const UpdateData& data) {
     Translation::update(data);
 }
 
+bool GlobeTranslation::isThreadSafe() const {
+    // We are sampling the height map of the attached globe, which might be updated by
+    // the globe at the same time
+    return false;
+}
+
 glm::dvec3 GlobeTranslation::position(const UpdateData&) const {
     if (!_attachedNode) {
         // @TODO(abock): The const cast should be removed on a redesign of the translation
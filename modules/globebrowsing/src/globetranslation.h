@@ -41,6 +41,7 @@ public:
 
     void update(const UpdateData& data) override;
     glm::dvec3 position(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
 
     static documentation::Documentation Documentation();
 
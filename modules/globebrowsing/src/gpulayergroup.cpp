@@ -32,8 +32,8 @@
 
 namespace openspace::globebrowsing {
 
-void GPULayerGroup::setValue(ghoul::opengl::ProgramObject& program,
-                             const LayerGroup& layerGroup, const TileIndex& tileIndex)
+void GPULayerGroup::setLayerValues(ghoul::opengl::ProgramObject& program,
+                                   const LayerGroup& layerGroup)
 {
     ZoneScoped;
 
@@ -75,27 +75,9 @@ void GPULayerGroup::setValue(ghoul::opengl::ProgramObject& program,
             case layers::Layer::ID::TemporalTileProvider:
             case layers::Layer::ID::TileIndexTileProvider:
             case layers::Layer::ID::TileProviderByIndex:
-            case layers::Layer::ID::TileProviderByLevel: {
-                const ChunkTilePile& ctp = al.chunkTilePile(
-                    tileIndex,
-                    layerGroup.pileSize()
-                );
-                for (size_t j = 0; j < _gpuActiveLayers[i].gpuChunkTiles.size(); ++j) {
-                    GPULayer::GPUChunkTile& t = _gpuActiveLayers[i].gpuChunkTiles[j];
-                    ghoul_assert(ctp[j].has_value(), "Wrong ChunkTiles number in pile");
-                    const ChunkTile& ct = *ctp[j];
-
-                    t.texUnit.activate();
-                    if (ct.tile.texture) {
-                        ct.tile.texture->bind();
-                    }
-                    program.setUniform(t.uniformCache.texture, t.texUnit);
-
-                    program.setUniform(t.uniformCache.uvOffset, ct.uvTransform.uvOffset);
-                    program.setUniform(t.uniformCache.uvScale, ct.uvTransform.uvScale);
-                }
+            case layers::Layer::ID::TileProviderByLevel:
+                // The textures are set for each chunk in setChunkValues
                 break;
-            }
             case layers::Layer::ID::SolidColor:
                 program.setUniform(galuc.color, al.solidColor());
                 break;
@@ -110,6 +92,50 @@ void GPULayerGroup::setValue(ghoul::opengl::ProgramObject& program,
     }
 }
 
+void GPULayerGroup::setChunkValues(ghoul::opengl::ProgramObject& program,
+                                   const LayerGroup& layerGroup,
+                                   const TileIndex& tileIndex)
+{
+    ZoneScoped;
+
+    ghoul_assert(
+        layerGroup.activeLayers().size() == _gpuActiveLayers.size(),
+        "GPU and CPU active layers must have same size"
+    );
+
+    const std::vector<Layer*>& activeLayers = layerGroup.activeLayers();
+    for (unsigned int i = 0; i < activeLayers.size(); ++i) {
+        const Layer& al = *activeLayers[i];
+        if (al.type() == layers::Layer::ID::SolidColor) {
+            // Solid colors do not have any tiles
+            continue;
+        }
+
+        const ChunkTilePile& ctp = al.chunkTilePile(tileIndex, layerGroup.pileSize());
+        for (size_t j = 0; j < _gpuActiveLayers[i].gpuChunkTiles.size(); ++j) {
+            GPULayer::GPUChunkTile& t = _gpuActiveLayers[i].gpuChunkTiles[j];
+            ghoul_assert(ctp[j].has_value(), "Wrong ChunkTiles number in pile");
+            const ChunkTile& ct = *ctp[j];
+
+            if (ct.tile.textureHandle != 0) {
+                // Resident bindless textures are passed directly to the sampler of the
+                // active program without occupying a texture unit
+                glUniformHandleui64ARB(t.uniformCache.texture, ct.tile.textureHandle);
+            }
+            else {
+                t.texUnit.activate();
+                if (ct.tile.texture) {
+                    ct.tile.texture->bind();
+                }
+                program.setUniform(t.uniformCache.texture, t.texUnit);
+            }
+
+            program.setUniform(t.uniformCache.uvOffset, ct.uvTransform.uvOffset);
+            program.setUniform(t.uniformCache.uvScale, ct.uvTransform.uvScale);
+        }
+    }
+}
+
 void GPULayerGroup::bind(ghoul::opengl::ProgramObject& p, const LayerGroup& layerGroup) {
     const std::vector<Layer*>& activeLayers = layerGroup.activeLayers();
     _gpuActiveLayers.resize(activeLayers.size());
@@ -50,10 +50,22 @@ struct TileIndex;
 class GPULayerGroup {
 public:
     /**
-     * Sets the value of `LayerGroup` to its corresponding GPU struct. OBS! Users must
-     * ensure bind has been called before setting using this method.
+     * Sets the values of the `LayerGroup` that do not depend on the rendered chunk to
+     * its corresponding GPU struct. This only has to be done once before rendering any
+     * number of chunks. OBS! Users must ensure bind has been called before setting using
+     * this method.
      */
-    void setValue(ghoul::opengl::ProgramObject& programObject,
+    void setLayerValues(ghoul::opengl::ProgramObject& programObject,
+        const LayerGroup& layerGroup);
+
+    /**
+     * Binds the tile textures and sets the texture transforms of the `LayerGroup` for
+     * the chunk with the provided \p tileIndex. Tiles that have a bindless texture handle
+     * are passed to the shader directly, all other tiles are bound to a texture unit.
+     * OBS! Users must ensure that setLayerValues has been called before setting using
+     * this method.
+     */
+    void setChunkValues(ghoul::opengl::ProgramObject& programObject,
         const LayerGroup& layerGroup, const TileIndex& tileIndex);
 
     /**
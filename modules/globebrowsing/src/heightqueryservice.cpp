@@ -0,0 +1,417 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/heightqueryservice.h>
+
+#include <modules/globebrowsing/src/geodeticpatch.h>
+#include <modules/globebrowsing/src/layer.h>
+#include <modules/globebrowsing/src/layergroupid.h>
+#include <modules/globebrowsing/src/tileprovider/tileprovider.h>
+#include <openspace/properties/property.h>
+#include <openspace/util/memorymappedfile.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <ghoul/opengl/texture.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace {
+    constexpr std::string_view _loggerCat = "HeightQueryService";
+
+    // Identifies the files that are written by this service ('OSHT')
+    constexpr uint32_t FileMagic = 0x5448534F;
+    constexpr uint32_t FileVersion = 1;
+
+    struct FileHeader {
+        uint32_t magic = FileMagic;
+        uint32_t version = FileVersion;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    // Converting a tile reads every texel and writes the result to disk, so the number
+    // of conversions per frame is limited to not cause a spike when many new positions
+    // are queried at once
+    constexpr int MaxConvertedTilesPerUpdate = 4;
+    constexpr size_t MaxPendingTiles = 256;
+    constexpr size_t MaxResidentTiles = 4096;
+
+    // Same cut-off as is used in the shader and in the sampling of the tiles. No data
+    // values are assumed to be smaller than this value
+    constexpr float NoDataCutoff = -100000.f;
+
+    std::string datasetKey(const openspace::globebrowsing::Layer& layer) {
+        using namespace openspace;
+        globebrowsing::TileProvider* tileProvider = layer.tileProvider();
+        properties::Property* p =
+            tileProvider ? tileProvider->property("FilePath") : nullptr;
+        return p ? p->stringValue() : std::string();
+    }
+} // namespace
+
+namespace openspace::globebrowsing {
+
+struct HeightQueryService::HeightTile {
+    static std::unique_ptr<HeightTile> map(const std::filesystem::path& file);
+    static std::unique_ptr<HeightTile> convert(const Tile& tile,
+        const TileDepthTransform& depthTransform, float noDataValue);
+
+    /**
+     * Bilinearly interpolates the heights at the normalized position \p uv. Returns NaN
+     * if any of the used heights is not available.
+     */
+    float sample(const glm::vec2& uv) const;
+
+    glm::uvec2 size = glm::uvec2(0);
+    const float* heights = nullptr;
+    uint64_t lastUsed = 0;
+
+    // Either the heights are backed by a memory-mapped file or by the storage if the
+    // tile was converted in this session
+    MemoryMappedFile mapping;
+    std::vector<float> storage;
+};
+
+std::unique_ptr<HeightQueryService::HeightTile> HeightQueryService::HeightTile::map(
+                                                        const std::filesystem::path& file)
+{
+    ZoneScoped;
+
+    MemoryMappedFile mapping = MemoryMappedFile(file);
+    if (mapping.size() < sizeof(FileHeader)) {
+        return nullptr;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, mapping.data(), sizeof(FileHeader));
+    const size_t nHeights = static_cast<size_t>(header.width) * header.height;
+    if (header.magic != FileMagic || header.version != FileVersion ||
+        mapping.size() != sizeof(FileHeader) + nHeights * sizeof(float))
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<HeightTile> tile = std::make_unique<HeightTile>();
+    tile->size = glm::uvec2(header.width, header.height);
+    tile->heights = reinterpret_cast<const float*>(mapping.data() + sizeof(FileHeader));
+    tile->mapping = std::move(mapping);
+    return tile;
+}
+
+std::unique_ptr<HeightQueryService::HeightTile>
+HeightQueryService::HeightTile::convert(const Tile& tile,
+                                        const TileDepthTransform& depthTransform,
+                                        float noDataValue)
+{
+    ZoneScoped;
+
+    ghoul_assert(tile.texture, "No texture");
+
+    const glm::uvec2 size = glm::uvec2(tile.texture->dimensions());
+    std::unique_ptr<HeightTile> res = std::make_unique<HeightTile>();
+    res->size = size;
+    res->storage.resize(static_cast<size_t>(size.x) * size.y);
+    for (unsigned int y = 0; y < size.y; y++) {
+        for (unsigned int x = 0; x < size.x; x++) {
+            const float s = tile.texture->texelAsFloat(glm::uvec2(x, y)).x;
+            const bool isNoData = std::isnan(s) || s == noDataValue || s < NoDataCutoff;
+            res->storage[y * size.x + x] = isNoData ?
+                std::numeric_limits<float>::quiet_NaN() :
+                depthTransform.offset + depthTransform.scale * s;
+        }
+    }
+    res->heights = res->storage.data();
+    return res;
+}
+
+float HeightQueryService::HeightTile::sample(const glm::vec2& uv) const {
+    const glm::vec2 maxPos = glm::vec2(size - glm::uvec2(1));
+
+    // The same half texel offset as in the sampling of the height layer tiles (#2696)
+    const glm::vec2 samplePos = uv * glm::vec2(size) - glm::vec2(0.5f);
+    const glm::vec2 pos00 = glm::clamp(glm::floor(samplePos), glm::vec2(0.f), maxPos);
+    const glm::vec2 fract =
+        glm::clamp(samplePos - pos00, glm::vec2(0.f), glm::vec2(1.f));
+
+    const glm::uvec2 p00 = glm::uvec2(pos00);
+    const glm::uvec2 p11 = glm::min(p00 + glm::uvec2(1), glm::uvec2(maxPos));
+
+    const float h00 = heights[p00.y * size.x + p00.x];
+    const float h10 = heights[p00.y * size.x + p11.x];
+    const float h01 = heights[p11.y * size.x + p00.x];
+    const float h11 = heights[p11.y * size.x + p11.x];
+
+    // NaNs of missing heights propagate through the interpolation
+    const float h0 = h00 * (1.f - fract.x) + h10 * fract.x;
+    const float h1 = h01 * (1.f - fract.x) + h11 * fract.x;
+    return h0 * (1.f - fract.y) + h1 * fract.y;
+}
+
+HeightQueryService::HeightQueryService(std::filesystem::path cacheFolder)
+    : _cacheFolder(std::move(cacheFolder))
+{}
+
+HeightQueryService::~HeightQueryService() = default;
+
+bool HeightQueryService::supportsLayer(const Layer& layer) {
+    // Only the tiles of the default tile provider are guaranteed to always be the same
+    // for a specific tile index
+    return layer.type() == layers::Layer::ID::DefaultTileProvider &&
+        layer.tileProvider() && !datasetKey(layer).empty();
+}
+
+TileIndex HeightQueryService::tileIndex(const Geodetic2& position, int level) {
+    ghoul_assert(level < std::numeric_limits<uint8_t>::max(), "Too high level");
+
+    const int numIndicesAtLevel = 1 << level;
+    const double u = 0.5 + position.lon / glm::two_pi<double>();
+    const double v = 0.25 - position.lat / glm::two_pi<double>();
+    const double xIndexSpace = u * numIndicesAtLevel;
+    const double yIndexSpace = v * numIndicesAtLevel;
+
+    const int x = static_cast<int>(floor(xIndexSpace));
+    const int y = static_cast<int>(floor(yIndexSpace));
+    return TileIndex(x, y, static_cast<uint8_t>(level));
+}
+
+glm::vec2 HeightQueryService::positionInTile(const Geodetic2& position,
+                                             const TileIndex& index)
+{
+    const GeodeticPatch patch = GeodeticPatch(index);
+    const Geodetic2 northEast = patch.corner(Quad::NORTH_EAST);
+    const Geodetic2 southWest = patch.corner(Quad::SOUTH_WEST);
+
+    return glm::vec2(
+        (position.lon - southWest.lon) / (northEast.lon - southWest.lon),
+        (position.lat - southWest.lat) / (northEast.lat - southWest.lat)
+    );
+}
+
+void HeightQueryService::sample(const Layer& layer, std::span<const Query> queries,
+                                std::span<float> heights)
+{
+    ZoneScoped;
+
+    ghoul_assert(supportsLayer(layer), "Layer is not supported");
+    ghoul_assert(queries.size() == heights.size(), "Mismatching number of heights");
+
+    const std::string key = datasetKey(layer);
+    Pyramid& pyramid = _pyramids[key];
+    if (pyramid.folder.empty()) {
+        pyramid.folder = _cacheFolder / std::to_string(std::hash<std::string>{}(key));
+    }
+
+    const int maxLevel = std::max(layer.tileProvider()->maxLevel(), 1);
+    for (size_t i = 0; i < queries.size(); i++) {
+        const Query& q = queries[i];
+        const int level = std::clamp(q.level, 1, maxLevel);
+
+        const TileIndex desired = tileIndex(q.position, level);
+        const TileIndex::TileHashKey desiredKey = desired.hashKey();
+        if (!pyramid.tiles.contains(desiredKey) &&
+            !pyramid.unavailable.contains(desiredKey) &&
+            pyramid.pending.size() < MaxPendingTiles)
+        {
+            pyramid.pending.emplace(desiredKey, desired);
+        }
+
+        // Use the most detailed tile that is available
+        for (int l = level; l >= 1; l--) {
+            const TileIndex index = l == level ? desired : tileIndex(q.position, l);
+            const auto it = pyramid.tiles.find(index.hashKey());
+            if (it == pyramid.tiles.end()) {
+                continue;
+            }
+
+            it->second->lastUsed = _frame;
+            const float h = it->second->sample(positionInTile(q.position, index));
+            if (!std::isnan(h)) {
+                // Make sure that the height value follows the layer settings. For example
+                // if the multiplier is set to a value bigger than one, the sampled height
+                // should be modified as well
+                heights[i] = layer.renderSettings().performLayerSettings(h);
+            }
+            break;
+        }
+    }
+}
+
+void HeightQueryService::update(const std::vector<Layer*>& layers) {
+    ZoneScoped;
+
+    _frame++;
+
+    std::vector<std::string> keys;
+    keys.reserve(layers.size());
+    for (const Layer* layer : layers) {
+        if (supportsLayer(*layer)) {
+            keys.push_back(datasetKey(*layer));
+        }
+        else {
+            keys.emplace_back();
+        }
+    }
+
+    std::erase_if(
+        _pyramids,
+        [&keys](const std::pair<const std::string, Pyramid>& p) {
+            return std::find(keys.begin(), keys.end(), p.first) == keys.end();
+        }
+    );
+
+    for (size_t i = 0; i < layers.size(); i++) {
+        const auto it = _pyramids.find(keys[i]);
+        if (keys[i].empty() || it == _pyramids.end()) {
+            continue;
+        }
+
+        loadPendingTiles(*layers[i], it->second);
+        evictUnusedTiles(it->second);
+    }
+}
+
+void HeightQueryService::loadPendingTiles(const Layer& layer, Pyramid& pyramid) {
+    ZoneScoped;
+
+    TileProvider* tileProvider = layer.tileProvider();
+    int nConverted = 0;
+    for (auto it = pyramid.pending.begin(); it != pyramid.pending.end();) {
+        const TileIndex::TileHashKey key = it->first;
+        const TileIndex index = it->second;
+        const std::filesystem::path file = tileFile(pyramid, index);
+
+        // A tile that was stored in a previous run only has to be mapped
+        if (std::filesystem::exists(file)) {
+            std::unique_ptr<HeightTile> tile = HeightTile::map(file);
+            if (tile) {
+                tile->lastUsed = _frame;
+                pyramid.tiles[key] = std::move(tile);
+                it = pyramid.pending.erase(it);
+                continue;
+            }
+            LDEBUG(fmt::format("Discarding invalid height tile {}", file));
+            std::error_code ec;
+            std::filesystem::remove(file, ec);
+        }
+
+        const Tile::Status status = tileProvider->tileStatus(index);
+        if (status == Tile::Status::OutOfRange || status == Tile::Status::IOError) {
+            pyramid.unavailable.insert(key);
+            it = pyramid.pending.erase(it);
+            continue;
+        }
+
+        if (nConverted >= MaxConvertedTilesPerUpdate) {
+            it++;
+            continue;
+        }
+
+        // Requesting the tile also enqueues it for loading if it is not loaded yet
+        const Tile tile = tileProvider->tile(index);
+        if (tile.status != Tile::Status::OK || !tile.texture || tile.isProvisional) {
+            it++;
+            continue;
+        }
+
+        std::unique_ptr<HeightTile> heightTile = HeightTile::convert(
+            tile,
+            tileProvider->depthTransform(),
+            tileProvider->noDataValueAsFloat()
+        );
+        nConverted++;
+
+        {
+            ZoneScopedN("Write height tile");
+
+            std::error_code ec;
+            std::filesystem::create_directories(file.parent_path(), ec);
+            // Writing to a temporary file first prevents a crash from leaving a partially
+            // written tile in the cache
+            std::filesystem::path tmp = file;
+            tmp += ".tmp";
+            FileHeader header;
+            header.width = heightTile->size.x;
+            header.height = heightTile->size.y;
+            std::ofstream out(tmp, std::ofstream::binary);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+            out.write(
+                reinterpret_cast<const char*>(heightTile->storage.data()),
+                heightTile->storage.size() * sizeof(float)
+            );
+            out.close();
+            if (out.good()) {
+                std::filesystem::rename(tmp, file, ec);
+            }
+            if (!out.good() || ec) {
+                LDEBUG(fmt::format("Failed to write height tile {}", file));
+                std::filesystem::remove(tmp, ec);
+            }
+        }
+
+        heightTile->lastUsed = _frame;
+        pyramid.tiles[key] = std::move(heightTile);
+        it = pyramid.pending.erase(it);
+    }
+}
+
+void HeightQueryService::evictUnusedTiles(Pyramid& pyramid) const {
+    if (pyramid.tiles.size() <= MaxResidentTiles) {
+        return;
+    }
+
+    ZoneScoped;
+
+    // Remove the quarter of the tiles that have not been used for the longest time. The
+    // tiles stay on disk and are mapped again if they are needed
+    std::vector<uint64_t> lastUsed;
+    lastUsed.reserve(pyramid.tiles.size());
+    for (const auto& [key, tile] : pyramid.tiles) {
+        lastUsed.push_back(tile->lastUsed);
+    }
+    const size_t nRemoved = pyramid.tiles.size() / 4;
+    std::nth_element(lastUsed.begin(), lastUsed.begin() + nRemoved, lastUsed.end());
+    const uint64_t threshold = lastUsed[nRemoved];
+
+    std::erase_if(
+        pyramid.tiles,
+        [threshold](const std::pair<const TileIndex::TileHashKey,
+                                    std::unique_ptr<HeightTile>>& p)
+        {
+            return p.second->lastUsed < threshold;
+        }
+    );
+}
+
+std::filesystem::path HeightQueryService::tileFile(const Pyramid& pyramid,
+                                                   const TileIndex& index) const
+{
+    return pyramid.folder / std::to_string(index.level) /
+        fmt::format("{}_{}.height", index.x, index.y);
+}
+
+} // namespace openspace::globebrowsing
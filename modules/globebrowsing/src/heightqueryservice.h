@@ -0,0 +1,127 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___HEIGHTQUERYSERVICE___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___HEIGHTQUERYSERVICE___H__
+
+#include <modules/globebrowsing/src/basictypes.h>
+#include <modules/globebrowsing/src/tileindex.h>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace openspace::globebrowsing {
+
+class Layer;
+
+/**
+ * Answers height queries of a globe from a CPU-side pyramid of elevation tiles that is
+ * independent of the GPU tile cache. Every height tile that was loaded once is stored as
+ * a plain array of heights in a local cache folder and is memory-mapped from there on
+ * subsequent runs. A query never waits for a tile to be loaded. Instead it is answered
+ * from the most detailed tile that is resident and the missing tile is requested from the
+ * layer in the next call to `update`. All functions have to be called from the main
+ * thread.
+ */
+class HeightQueryService {
+public:
+    /// A single position on the globe at which the height is requested
+    struct Query {
+        Geodetic2 position;
+        /// The level of the tile that should be used to answer the query
+        int level = 1;
+    };
+
+    /**
+     * Creates a service that stores the height tiles in subfolders of \p cacheFolder.
+     */
+    explicit HeightQueryService(std::filesystem::path cacheFolder);
+    ~HeightQueryService();
+
+    /**
+     * Returns whether the heights of the \p layer can be provided by this service. This
+     * is only the case for layers whose tiles do not change over time, as the tiles are
+     * persisted on disk.
+     */
+    static bool supportsLayer(const Layer& layer);
+
+    /**
+     * Returns the index of the tile at the \p level that contains the \p position.
+     */
+    static TileIndex tileIndex(const Geodetic2& position, int level);
+
+    /**
+     * Returns the normalized position of the \p position inside of the tile with the
+     * \p index.
+     */
+    static glm::vec2 positionInTile(const Geodetic2& position, const TileIndex& index);
+
+    /**
+     * Samples the heights of the \p layer for all \p queries and writes the results in
+     * meters into the corresponding entries of \p heights. Entries for which the layer
+     * does not provide any data are left unchanged. The layer settings of the \p layer
+     * are applied to the sampled heights.
+     *
+     * \pre The \p layer must be supported by this service
+     * \pre \p queries and \p heights must have the same size
+     */
+    void sample(const Layer& layer, std::span<const Query> queries,
+        std::span<float> heights);
+
+    /**
+     * Moves the tiles that were requested in previous calls to `sample` into the pyramid
+     * of the \p layers, either by mapping a previously stored tile or by converting the
+     * tile once it has been loaded by the layer. The pyramids of datasets that are not
+     * used by any of the \p layers anymore are removed.
+     */
+    void update(const std::vector<Layer*>& layers);
+
+private:
+    struct HeightTile;
+
+    struct Pyramid {
+        std::filesystem::path folder;
+        std::unordered_map<TileIndex::TileHashKey, std::unique_ptr<HeightTile>> tiles;
+        std::unordered_map<TileIndex::TileHashKey, TileIndex> pending;
+        std::unordered_set<TileIndex::TileHashKey> unavailable;
+    };
+
+    void loadPendingTiles(const Layer& layer, Pyramid& pyramid);
+    void evictUnusedTiles(Pyramid& pyramid) const;
+    std::filesystem::path tileFile(const Pyramid& pyramid, const TileIndex& index) const;
+
+    std::filesystem::path _cacheFolder;
+    // The pyramids are identified by the dataset of the layer so that a layer that is
+    // removed and added again reuses the existing tiles
+    std::unordered_map<std::string, Pyramid> _pyramids;
+    uint64_t _frame = 0;
+};
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___HEIGHTQUERYSERVICE___H__
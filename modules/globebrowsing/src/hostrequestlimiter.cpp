@@ -0,0 +1,79 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/hostrequestlimiter.h>
+
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+
+namespace openspace::globebrowsing {
+
+HostRequestLimiter::Request::Request(HostRequestLimiter& limiter, std::string host)
+    : _limiter(limiter)
+    , _host(std::move(host))
+{
+    if (!_host.empty()) {
+        _limiter.acquire(_host);
+    }
+}
+
+HostRequestLimiter::Request::~Request() {
+    if (!_host.empty()) {
+        _limiter.release(_host);
+    }
+}
+
+HostRequestLimiter::HostRequestLimiter(int maxRequestsPerHost)
+    : _maxRequestsPerHost(std::max(maxRequestsPerHost, 1))
+{}
+
+void HostRequestLimiter::setMaxRequestsPerHost(int maxRequestsPerHost) {
+    {
+        std::lock_guard lock(_mutex);
+        _maxRequestsPerHost = std::max(maxRequestsPerHost, 1);
+    }
+    _condition.notify_all();
+}
+
+void HostRequestLimiter::acquire(const std::string& host) {
+    ZoneScoped;
+
+    std::unique_lock lock(_mutex);
+    _condition.wait(lock, [this, &host]() {
+        return _nRequests[host] < _maxRequestsPerHost;
+    });
+    _nRequests[host]++;
+}
+
+void HostRequestLimiter::release(const std::string& host) {
+    {
+        std::lock_guard lock(_mutex);
+        ghoul_assert(_nRequests[host] > 0, "No request in flight for this host");
+        _nRequests[host]--;
+    }
+    _condition.notify_all();
+}
+
+} // namespace openspace::globebrowsing
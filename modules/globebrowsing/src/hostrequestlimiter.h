@@ -0,0 +1,76 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___HOSTREQUESTLIMITER___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___HOSTREQUESTLIMITER___H__
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace openspace::globebrowsing {
+
+/**
+ * Limits the number of requests that are in flight to the same remote host at the same
+ * time, across all tile readers. A request is in flight for as long as a Request object
+ * for its host exists; the constructor of the Request blocks until the number of
+ * requests for the host falls below the limit.
+ */
+class HostRequestLimiter {
+public:
+    class Request {
+    public:
+        /**
+         * Blocks until a new request to the \p host is allowed by the \p limiter. If the
+         * \p host is empty, the request is not limited.
+         */
+        Request(HostRequestLimiter& limiter, std::string host);
+        ~Request();
+
+        Request(const Request&) = delete;
+        Request& operator=(const Request&) = delete;
+
+    private:
+        HostRequestLimiter& _limiter;
+        const std::string _host;
+    };
+
+    explicit HostRequestLimiter(int maxRequestsPerHost);
+
+    void setMaxRequestsPerHost(int maxRequestsPerHost);
+
+private:
+    void acquire(const std::string& host);
+    void release(const std::string& host);
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::unordered_map<std::string, int> _nRequests;
+    int _maxRequestsPerHost;
+};
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___HOSTREQUESTLIMITER___H__
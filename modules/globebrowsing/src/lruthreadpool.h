@@ -25,7 +25,7 @@
 #ifndef __OPENSPACE_MODULE_GLOBEBROWSING___LRU_THREAD_POOL___H__
 #define __OPENSPACE_MODULE_GLOBEBROWSING___LRU_THREAD_POOL___H__
 
-#include <modules/globebrowsing/src/lrucache.h>
+#include <openspace/util/lrucache.h>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
@@ -66,7 +66,14 @@ public:
     ~LRUThreadPool();
 
     void enqueue(std::function<void()> f, KeyType key);
+
+    /**
+     * Enqueues a task that is only executed after all tasks that were enqueued with
+     * `enqueue`. If the queue is full, this task is the first to be removed from it.
+     */
+    void enqueueWithLowPriority(std::function<void()> f, KeyType key);
     bool touch(KeyType key);
+    size_t numQueuedTasks();
     std::vector<KeyType> getQueuedTasksKeys();
     std::vector<KeyType> getUnqueuedTasksKeys();
     void clearEnqueuedTasks();
@@ -80,7 +87,7 @@ private:
     friend class LRUThreadPoolWorker<KeyType>;
 
     std::vector<std::thread> _workers;
-    cache::LRUCache<KeyType, std::function<void()>, DefaultHasher> _queuedTasks;
+    LruCache<KeyType, std::function<void()>, DefaultHasher> _queuedTasks;
     std::vector<KeyType> _unqueuedTasks;
     std::mutex _queueMutex;
     std::condition_variable _condition;
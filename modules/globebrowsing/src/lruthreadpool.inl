@@ -107,12 +107,37 @@ void LRUThreadPool<KeyType>::enqueue(std::function<void()> f, KeyType key) {
     _condition.notify_one();
 }
 
+template<typename KeyType>
+void LRUThreadPool<KeyType>::enqueueWithLowPriority(std::function<void()> f, KeyType key)
+{
+    {
+        std::unique_lock<std::mutex> lock(_queueMutex);
+
+        const std::vector<std::pair<KeyType, std::function<void()>>>& unfinishedTasks =
+            _queuedTasks.putBackAndFetchPopped(key, f);
+        for (const std::pair<KeyType, std::function<void()>>& unfinishedTask :
+             unfinishedTasks)
+        {
+            _unqueuedTasks.push_back(unfinishedTask.first);
+        }
+    }
+
+    // wake up one thread
+    _condition.notify_one();
+}
+
 template<typename KeyType>
 bool LRUThreadPool<KeyType>::touch(KeyType key) {
     std::unique_lock<std::mutex> lock(_queueMutex);
     return _queuedTasks.touch(key);
 }
 
+template<typename KeyType>
+size_t LRUThreadPool<KeyType>::numQueuedTasks() {
+    std::unique_lock<std::mutex> lock(_queueMutex);
+    return _queuedTasks.size();
+}
+
 template<typename KeyType>
 std::vector<KeyType> LRUThreadPool<KeyType>::getUnqueuedTasksKeys() {
     std::vector<KeyType> toReturn = _unqueuedTasks;
@@ -25,11 +25,16 @@
 #include <modules/globebrowsing/src/memoryawaretilecache.h>
 
 #include <modules/globebrowsing/src/basictypes.h>
+#include <modules/globebrowsing/src/blockcompression.h>
 #include <modules/globebrowsing/src/layermanager.h>
+#include <modules/globebrowsing/src/pixelbufferring.h>
 #include <modules/globebrowsing/src/rawtile.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/systemcapabilities/generalcapabilitiescomponent.h>
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <algorithm>
 #include <numeric>
 
 namespace {
@@ -72,6 +77,54 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo UseBindlessTexturesInfo = {
+        "UseBindlessTextures",
+        "Use bindless textures",
+        "If this value is enabled, the textures of the tile cache are made resident as "
+        "bindless textures (GL_ARB_bindless_texture). Chunks then pass the handles of "
+        "their tiles to the shader instead of binding each tile to a texture unit. "
+        "Changing this value clears the tile cache. This setting is only available if "
+        "the graphics driver supports the extension",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr std::string_view BindlessTextureExtension = "GL_ARB_bindless_texture";
+
+    constexpr openspace::properties::Property::PropertyInfo UploadBudgetInfo = {
+        "UploadBudget",
+        "Upload budget (MB per frame)",
+        "The maximum number of megabytes of tile data that is uploaded to the GPU in a "
+        "single frame. Tiles that are finished loading after the budget is exhausted "
+        "are uploaded in the following frames instead. A large number of uploads in a "
+        "single frame otherwise causes a noticeable stutter. A value of 0 disables the "
+        "limit",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo ProvisionalTileBudgetInfo = {
+        "ProvisionalTileBudget",
+        "Provisional tile budget (tiles per frame)",
+        "The maximum number of provisional tiles that are created in a single frame. "
+        "While a tile is loading, a provisional tile is created by upsampling the part "
+        "of the already loaded parent tile that it covers, which is then shown until "
+        "the actual tile is available. A value of 0 disables the provisional tiles",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    // The number of persistently mapped pixel buffers that tiles can be loaded into.
+    // Tiles that are loaded while all buffers are in use are read into CPU memory
+    constexpr int NumPixelBuffers = 32;
+
+    ghoul::opengl::Texture::FilterMode tileFilterMode() {
+        // Hi there, I know someone will be tempted to change this to a Linear filtering
+        // mode at some point. This will introduce rendering artifacts when looking at the
+        // globe at oblique angles (see #2752)
+        using namespace ghoul::systemcapabilities;
+        return OpenGLCap.gpuVendor() == OpenGLCapabilitiesComponent::Vendor::AmdATI ?
+            ghoul::opengl::Texture::FilterMode::Linear :
+            ghoul::opengl::Texture::FilterMode::AnisotropicMipMap;
+    }
+
     GLenum toGlTextureFormat(GLenum glType, ghoul::opengl::Texture::Format format) {
         switch (format) {
             case ghoul::opengl::Texture::Format::Red:
@@ -188,6 +241,73 @@ namespace {
         }
     }
 
+    // Block compressed textures get immutable storage for their complete mip chain, as
+    // the mip levels are uploaded together with the base level rather than generated
+    void allocateCompressedStorage(ghoul::opengl::Texture& texture,
+                                   const openspace::globebrowsing::TileTextureInitData& d,
+                                   ghoul::opengl::Texture::FilterMode mode)
+    {
+        const glm::ivec2 size = glm::ivec2(d.dimensions);
+        texture.bind();
+        glTexStorage2D(
+            GL_TEXTURE_2D,
+            openspace::globebrowsing::numberOfMipLevels(size),
+            GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+            size.x,
+            size.y
+        );
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        if (mode == ghoul::opengl::Texture::FilterMode::AnisotropicMipMap) {
+            GLfloat maxAnisotropy = 1.f;
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+            glTexParameteri(
+                GL_TEXTURE_2D,
+                GL_TEXTURE_MIN_FILTER,
+                GL_LINEAR_MIPMAP_LINEAR
+            );
+            glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, maxAnisotropy);
+        }
+        else {
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        }
+    }
+
+    // Uploads all mip levels of the block compressed tile. If pixelBuffer is not 0, the
+    // blocks are sourced from that buffer and data is ignored
+    void uploadCompressedLevels(ghoul::opengl::Texture& texture,
+                                const openspace::globebrowsing::TileTextureInitData& d,
+                                const std::byte* data, GLuint pixelBuffer)
+    {
+        using namespace openspace::globebrowsing;
+
+        const glm::ivec2 size = glm::ivec2(d.dimensions);
+        texture.bind();
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+        size_t offset = 0;
+        for (int level = 0; level < numberOfMipLevels(size); level++) {
+            const glm::ivec2 levelSize = glm::max(size >> level, glm::ivec2(1));
+            const size_t nBytes = bc3LevelSize(size, level);
+            const void* src = pixelBuffer ?
+                reinterpret_cast<const void*>(offset) :
+                static_cast<const void*>(data + offset);
+            glCompressedTexSubImage2D(
+                GL_TEXTURE_2D,
+                level,
+                0,
+                0,
+                levelSize.x,
+                levelSize.y,
+                GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+                static_cast<GLsizei>(nBytes),
+                src
+            );
+            offset += nBytes;
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
 
 } // namespace
 
@@ -197,9 +317,11 @@ namespace openspace::globebrowsing::cache {
 // TextureContainer
 //
 MemoryAwareTileCache::TextureContainer::TextureContainer(TileTextureInitData initData,
-                                                         size_t numTextures)
+                                                         size_t numTextures,
+                                                         bool useBindlessTextures)
     : _initData(std::move(initData))
     , _numTextures(numTextures)
+    , _useBindlessTextures(useBindlessTextures)
 {
     ZoneScoped;
 
@@ -207,10 +329,25 @@ MemoryAwareTileCache::TextureContainer::TextureContainer(TileTextureInitData ini
     reset();
 }
 
+MemoryAwareTileCache::TextureContainer::~TextureContainer() {
+    releaseTextures();
+}
+
+void MemoryAwareTileCache::TextureContainer::releaseTextures() {
+    // The handles have to be non-resident before their textures can be deleted
+    for (const std::pair<const ghoul::opengl::Texture* const, uint64_t>& p :
+         _textureHandles)
+    {
+        glMakeTextureHandleNonResidentARB(p.second);
+    }
+    _textureHandles.clear();
+    _textures.clear();
+}
+
 void MemoryAwareTileCache::TextureContainer::reset() {
     ZoneScoped;
 
-    _textures.clear();
+    releaseTextures();
     _freeTexture = 0;
 
     using namespace ghoul::systemcapabilities;
@@ -235,8 +372,21 @@ void MemoryAwareTileCache::TextureContainer::reset() {
         );
 
         tex->setDataOwnership(Texture::TakeOwnership::Yes);
-        tex->uploadTexture();
-        tex->setFilter(mode);
+        if (_initData.blockCompression == TileTextureInitData::BlockCompression::None) {
+            tex->uploadTexture();
+            tex->setFilter(mode);
+        }
+        else {
+            allocateCompressedStorage(*tex, _initData, mode);
+        }
+
+        if (_useBindlessTextures) {
+            // After this point the storage and the parameters of the texture are fixed,
+            // only its contents can be changed
+            const GLuint64 handle = glGetTextureHandleARB(*tex);
+            glMakeTextureHandleResidentARB(handle);
+            _textureHandles[tex.get()] = handle;
+        }
 
         _textures.push_back(std::move(tex));
     }
@@ -249,6 +399,16 @@ void MemoryAwareTileCache::TextureContainer::reset(size_t numTextures) {
     reset();
 }
 
+void MemoryAwareTileCache::TextureContainer::reset(size_t numTextures,
+                                                   bool useBindlessTextures)
+{
+    ZoneScoped;
+
+    _numTextures = numTextures;
+    _useBindlessTextures = useBindlessTextures;
+    reset();
+}
+
 ghoul::opengl::Texture* MemoryAwareTileCache::TextureContainer::getTextureIfFree() {
     if (_freeTexture < _textures.size()) {
         ghoul::opengl::Texture* texture = _textures[_freeTexture].get();
@@ -270,6 +430,17 @@ size_t MemoryAwareTileCache::TextureContainer::size() const {
     return _textures.size();
 }
 
+uint64_t MemoryAwareTileCache::TextureContainer::textureHandle(
+                                              const ghoul::opengl::Texture* texture) const
+{
+    const auto it = _textureHandles.find(texture);
+    return it != _textureHandles.end() ? it->second : 0;
+}
+
+bool MemoryAwareTileCache::TextureContainer::usesBindlessTextures() const {
+    return _useBindlessTextures;
+}
+
 //
 // MemoryAwareTileCache
 //
@@ -282,14 +453,49 @@ MemoryAwareTileCache::MemoryAwareTileCache(int tileCacheSize)
     , _tileCacheSize(TileCacheSizeInfo, tileCacheSize, 128, 16384, 1)
     , _applyTileCacheSize(ApplyTileCacheInfo)
     , _clearTileCache(ClearTileCacheInfo)
+    , _useBindlessTextures(UseBindlessTexturesInfo, false)
+    , _uploadBudget(UploadBudgetInfo, 32, 0, 1024)
+    , _provisionalTileBudget(ProvisionalTileBudgetInfo, 16, 0, 256)
 {
     ZoneScoped;
 
     createDefaultTextureContainers();
 
+    if (PixelBufferRing::isSupported()) {
+        // The buffers are large enough for the tiles of all default layer groups
+        size_t slotSize = 0;
+        for (const layers::Group& gi : layers::Groups) {
+            slotSize = std::max(slotSize, tileTextureInitData(gi.id).totalNumBytes);
+        }
+        _pixelBufferRing = std::make_unique<PixelBufferRing>(NumPixelBuffers, slotSize);
+    }
+    else {
+        LINFO("Persistently mapped pixel buffers are not supported");
+    }
+
+    addProperty(_uploadBudget);
+    addProperty(_provisionalTileBudget);
+
     _clearTileCache.onChange([this]() { clear(); });
     addProperty(_clearTileCache);
 
+    _useBindlessTextures.onChange([this]() {
+        using namespace ghoul::systemcapabilities;
+        const bool isSupported = OpenGLCap.isExtensionSupported(
+            std::string(BindlessTextureExtension)
+        );
+        if (_useBindlessTextures && !isSupported) {
+            LWARNING(fmt::format(
+                "Bindless textures are not available as {} is not supported",
+                BindlessTextureExtension
+            ));
+            _useBindlessTextures = false;
+            return;
+        }
+        setUseBindlessTextures(_useBindlessTextures);
+    });
+    addProperty(_useBindlessTextures);
+
     _applyTileCacheSize.onChange([this](){
         setSizeEstimated(uint64_t(_tileCacheSize) * 1024ul * 1024ul);
     });
@@ -315,6 +521,20 @@ MemoryAwareTileCache::MemoryAwareTileCache(int tileCacheSize)
     setSizeEstimated(uint64_t(_tileCacheSize) * 1024ul * 1024ul);
 }
 
+MemoryAwareTileCache::~MemoryAwareTileCache() = default;
+
+void MemoryAwareTileCache::deinitializeGL() {
+    if (_pixelBufferRing) {
+        _pixelBufferRing->deinitializeGL();
+    }
+    if (_provisionalReadFramebuffer != 0) {
+        glDeleteFramebuffers(1, &_provisionalReadFramebuffer);
+        glDeleteFramebuffers(1, &_provisionalDrawFramebuffer);
+        _provisionalReadFramebuffer = 0;
+        _provisionalDrawFramebuffer = 0;
+    }
+}
+
 void MemoryAwareTileCache::clear() {
     LINFO("Clearing tile cache");
     _numTextureBytesAllocatedOnCPU = 0;
@@ -324,6 +544,7 @@ void MemoryAwareTileCache::clear() {
         p.second.first->reset();
         p.second.second->clear();
     }
+    _numBytesPerProvider.clear();
     LINFO("Tile cache cleared");
 }
 
@@ -343,11 +564,17 @@ void MemoryAwareTileCache::assureTextureContainerExists(
 
     TileTextureInitData::HashKey initDataKey = initData.hashKey;
     if (_textureContainerMap.find(initDataKey) == _textureContainerMap.end()) {
-        // For now create 500 textures of this type
+        // For now create 500 textures of this type. Every cached tile uses one of the
+        // textures, so the tile cache never needs to hold more tiles than that
+        constexpr size_t NumTextures = 500;
         _textureContainerMap.emplace(initDataKey,
             TextureContainerTileCache(
-                std::make_unique<TextureContainer>(initData, 500),
-                std::make_unique<TileCache>(std::numeric_limits<std::size_t>::max())
+                std::make_unique<TextureContainer>(
+                    initData,
+                    NumTextures,
+                    _useBindlessTextures
+                ),
+                std::make_unique<TileCache>(NumTextures)
             )
         );
     }
@@ -389,7 +616,32 @@ void MemoryAwareTileCache::resetTextureContainerSize(size_t numTexturesPerTextur
     {
         p.second.first->reset(numTexturesPerTextureType);
         p.second.second->clear();
+        p.second.second->setMaximumCacheSize(numTexturesPerTextureType);
     }
+    _numBytesPerProvider.clear();
+}
+
+void MemoryAwareTileCache::setUseBindlessTextures(bool useBindlessTextures) {
+    ZoneScoped;
+
+    LINFO(fmt::format(
+        "{} bindless textures for the tile cache",
+        useBindlessTextures ? "Enabling" : "Disabling"
+    ));
+
+    // Textures can not be changed or stop being bindless once a handle was created for
+    // them, so all textures are recreated and all cached tiles are lost
+    _numTextureBytesAllocatedOnCPU = 0;
+    for (std::pair<const TileTextureInitData::HashKey,
+        TextureContainerTileCache>& p : _textureContainerMap)
+    {
+        if (p.second.first->usesBindlessTextures() == useBindlessTextures) {
+            continue;
+        }
+        p.second.first->reset(p.second.first->size(), useBindlessTextures);
+        p.second.second->clear();
+    }
+    _numBytesPerProvider.clear();
 }
 
 bool MemoryAwareTileCache::exist(const ProviderTileKey& key) const {
@@ -405,6 +657,17 @@ bool MemoryAwareTileCache::exist(const ProviderTileKey& key) const {
     return result != _textureContainerMap.cend();
 }
 
+bool MemoryAwareTileCache::hasLoadedTile(const ProviderTileKey& key) const {
+    for (const std::pair<const TileTextureInitData::HashKey,
+                         TextureContainerTileCache>& p : _textureContainerMap)
+    {
+        if (p.second.second->exist(key)) {
+            return !p.second.second->peek(key).isProvisional;
+        }
+    }
+    return false;
+}
+
 Tile MemoryAwareTileCache::get(const ProviderTileKey& key) {
     ZoneScoped;
 
@@ -437,9 +700,13 @@ ghoul::opengl::Texture* MemoryAwareTileCache::texture(const TileTextureInitData&
         _textureContainerMap[initDataKey].first->getTextureIfFree();
     // Second option. No more textures available. Pop from the LRU cache
     if (!texture) {
-        Tile oldTile = _textureContainerMap[initDataKey].second->popLRU().second;
+        std::pair<ProviderTileKey, Tile> oldTile =
+            _textureContainerMap[initDataKey].second->popLRU();
+        _numEvictions[oldTile.first.providerID]++;
+        size_t& nBytes = _numBytesPerProvider[oldTile.first.providerID];
+        nBytes -= std::min(nBytes, initData.totalNumBytes);
         // Use the old tile's texture
-        texture = oldTile.texture;
+        texture = oldTile.second.texture;
     }
     return texture;
 }
@@ -452,22 +719,36 @@ void MemoryAwareTileCache::createTileAndPut(ProviderTileKey key, RawTile rawTile
     }
     else {
         const TileTextureInitData& initData = *rawTile.textureInitData;
-        Texture* tex = texture(initData);
+        assureTextureContainerExists(initData);
+        const TileCache& tileCache = *_textureContainerMap[initData.hashKey].second;
+        // The actual data of a tile is uploaded into the texture of the provisional tile
+        // that was shown in its place while it was loading
+        Texture* tex =
+            tileCache.exist(key) && tileCache.peek(key).isProvisional ?
+            tileCache.peek(key).texture :
+            texture(initData);
+
+        const bool isCompressed =
+            initData.blockCompression != TileTextureInitData::BlockCompression::None;
 
         // Re-upload texture, either using PBO or by using RAM data
-        if (rawTile.pbo != 0) {
-            tex->reUploadTextureFromPBO(rawTile.pbo);
-            if (initData.shouldAllocateDataOnCPU) {
-                if (!tex->dataOwnership()) {
-                    _numTextureBytesAllocatedOnCPU += initData.totalNumBytes;
-                }
-                tex->setPixelData(
-                    rawTile.imageData.release(),
-                    Texture::TakeOwnership::Yes
-                );
-                rawTile.imageData = nullptr;
+        if (isCompressed) {
+            uploadCompressedLevels(
+                *tex,
+                initData,
+                rawTile.imageData.get(),
+                rawTile.pixelBuffer.buffer()
+            );
+            if (rawTile.pixelBuffer) {
+                _pixelBufferRing->retire(std::move(rawTile.pixelBuffer));
             }
         }
+        else if (rawTile.pixelBuffer) {
+            ghoul_assert(_pixelBufferRing, "Pixel buffer without a ring");
+            tex->reUploadTextureFromPBO(rawTile.pixelBuffer.buffer());
+            // The buffer can only be reused once the GPU has finished the transfer
+            _pixelBufferRing->retire(std::move(rawTile.pixelBuffer));
+        }
         else {
             size_t previousExpectedDataSize = tex->expectedPixelDataSize();
             ghoul_assert(
@@ -482,19 +763,28 @@ void MemoryAwareTileCache::createTileAndPut(ProviderTileKey key, RawTile rawTile
             _numTextureBytesAllocatedOnCPU += numBytes - previousExpectedDataSize;
             tex->reUploadTexture();
         }
-        // Hi there, I know someone will be tempted to change this to a Linear filtering
-        // mode at some point. This will introduce rendering artifacts when looking at the
-        // globe at oblique angles (see #2752)
-        using namespace ghoul::systemcapabilities;
-        ghoul::opengl::Texture::FilterMode mode =
-            OpenGLCap.gpuVendor() == OpenGLCapabilitiesComponent::Vendor::AmdATI ?
-            ghoul::opengl::Texture::FilterMode::Linear :
-            ghoul::opengl::Texture::FilterMode::AnisotropicMipMap;
+        const ghoul::opengl::Texture::FilterMode mode = tileFilterMode();
 
-        tex->setFilter(mode);
-        Tile tile{ tex, std::move(rawTile.tileMetaData), Tile::Status::OK };
         TileTextureInitData::HashKey initDataKey = initData.hashKey;
-        _textureContainerMap[initDataKey].second->put(std::move(key), std::move(tile));
+        const TextureContainer& container = *_textureContainerMap[initDataKey].first;
+        if (isCompressed) {
+            // The filter mode and all mip levels were set on creation and upload
+        }
+        else if (container.usesBindlessTextures()) {
+            // The texture parameters can not be changed once the texture has a bindless
+            // handle, but they are already set and only the mipmaps need to be updated
+            if (mode == ghoul::opengl::Texture::FilterMode::AnisotropicMipMap) {
+                tex->bind();
+                glGenerateMipmap(GL_TEXTURE_2D);
+            }
+        }
+        else {
+            tex->setFilter(mode);
+        }
+        _numBytesUploadedThisFrame += initData.totalNumBytes;
+
+        Tile tile{ tex, std::move(rawTile.tileMetaData), Tile::Status::OK };
+        put(key, initDataKey, std::move(tile));
     }
 }
 
@@ -502,10 +792,145 @@ void MemoryAwareTileCache::put(const ProviderTileKey& key,
                                const TileTextureInitData::HashKey& initDataKey,
                                Tile tile)
 {
-    _textureContainerMap[initDataKey].second->put(key, std::move(tile));
+    TextureContainerTileCache& p = _textureContainerMap[initDataKey];
+    tile.textureHandle = p.first->textureHandle(tile.texture);
+    const size_t nBytes = p.first->tileTextureInitData().totalNumBytes;
+    if (!p.second->exist(key)) {
+        _numBytesPerProvider[key.providerID] += nBytes;
+    }
+    // The cache holds as many tiles as there are textures, so tiles should only be
+    // evicted here if a texture was handed out without being put into the cache
+    std::vector<std::pair<ProviderTileKey, Tile>> popped =
+        p.second->putAndFetchPopped(key, std::move(tile));
+    for (const std::pair<ProviderTileKey, Tile>& oldTile : popped) {
+        _numEvictions[oldTile.first.providerID]++;
+        size_t& n = _numBytesPerProvider[oldTile.first.providerID];
+        n -= std::min(n, nBytes);
+    }
+}
+
+Tile MemoryAwareTileCache::createProvisionalTile(const ProviderTileKey& key) {
+    ZoneScoped;
+
+    using ghoul::opengl::Texture;
+
+    if (key.tileIndex.level == 0 ||
+        _numProvisionalTilesThisFrame >= _provisionalTileBudget)
+    {
+        return Tile();
+    }
+
+    const ProviderTileKey parentKey = {
+        .tileIndex = TileIndex(
+            key.tileIndex.x / 2,
+            key.tileIndex.y / 2,
+            static_cast<uint8_t>(key.tileIndex.level - 1)
+        ),
+        .providerID = key.providerID
+    };
+    const auto it = std::find_if(
+        _textureContainerMap.begin(),
+        _textureContainerMap.end(),
+        [&parentKey](const std::pair<const TileTextureInitData::HashKey,
+                                     TextureContainerTileCache>& p)
+        {
+            return p.second.second->exist(parentKey);
+        }
+    );
+    if (it == _textureContainerMap.end()) {
+        return Tile();
+    }
+
+    // Block compressed textures can't be rendered to and the CPU copy of the pixels,
+    // which is used for height queries, would not match the upsampled texture
+    const TileTextureInitData& initData = it->second.first->tileTextureInitData();
+    if (initData.blockCompression != TileTextureInitData::BlockCompression::None ||
+        initData.shouldAllocateDataOnCPU)
+    {
+        return Tile();
+    }
+
+    // Getting the parent also makes it the most recently used tile so that it can't be
+    // evicted to make room for the provisional tile
+    const Tile parent = it->second.second->get(parentKey);
+    if (parent.status != Tile::Status::OK || !parent.texture) {
+        return Tile();
+    }
+
+    if (_provisionalReadFramebuffer == 0) {
+        glGenFramebuffers(1, &_provisionalReadFramebuffer);
+        glGenFramebuffers(1, &_provisionalDrawFramebuffer);
+    }
+
+    GLint prevReadFramebuffer = 0;
+    GLint prevDrawFramebuffer = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFramebuffer);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevDrawFramebuffer);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _provisionalReadFramebuffer);
+    glFramebufferTexture2D(
+        GL_READ_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D,
+        *parent.texture,
+        0
+    );
+    // The provisional tile has the same format as the parent, so if the parent can be
+    // attached, so can the provisional tile
+    if (glCheckFramebufferStatus(GL_READ_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFramebuffer);
+        return Tile();
+    }
+
+    Texture* tex = texture(initData);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _provisionalDrawFramebuffer);
+    glFramebufferTexture2D(
+        GL_DRAW_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D,
+        *tex,
+        0
+    );
+
+    // The same quadrant of the parent that the shader would sample with the uv transform
+    // of the parent tile is stretched over the whole provisional tile
+    const glm::ivec2 size = glm::ivec2(initData.dimensions);
+    const glm::ivec2 offset =
+        glm::ivec2(key.tileIndex.positionRelativeParent() * glm::vec2(size));
+    glBlitFramebuffer(
+        offset.x, offset.y, offset.x + size.x / 2, offset.y + size.y / 2,
+        0, 0, size.x, size.y,
+        GL_COLOR_BUFFER_BIT,
+        GL_LINEAR
+    );
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFramebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevDrawFramebuffer);
+
+    const Texture::FilterMode mode = tileFilterMode();
+    if (mode == Texture::FilterMode::AnisotropicMipMap) {
+        tex->bind();
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    if (!it->second.first->usesBindlessTextures()) {
+        tex->setFilter(mode);
+    }
+    _numProvisionalTilesThisFrame++;
+
+    // The height range of the parent contains the height range of any of its quadrants
+    Tile tile = { tex, parent.metaData, Tile::Status::OK };
+    tile.isProvisional = true;
+    put(key, initData.hashKey, tile);
+    return it->second.second->peek(key);
 }
 
 void MemoryAwareTileCache::update() {
+    _numBytesUploadedThisFrame = 0;
+    _numProvisionalTilesThisFrame = 0;
+    if (_pixelBufferRing) {
+        _pixelBufferRing->collectRetired();
+    }
+
     const size_t dataSizeCPU = cpuAllocatedDataSize();
     const size_t dataSizeGPU = gpuAllocatedDataSize();
 
@@ -530,6 +955,32 @@ size_t MemoryAwareTileCache::gpuAllocatedDataSize() const {
     );
 }
 
+bool MemoryAwareTileCache::hasUploadBudget() const {
+    if (_numBytesUploadedThisFrame == 0) {
+        // At least one tile is uploaded per frame so that tiles continue to load even if
+        // the frame on its own exceeds the frame budget
+        return true;
+    }
+
+    const size_t budget = static_cast<size_t>(_uploadBudget) * 1024 * 1024;
+    const bool hasByteBudget = budget == 0 || _numBytesUploadedThisFrame < budget;
+    return hasByteBudget && global::openSpaceEngine->frameBudget().hasTimeRemaining();
+}
+
+PixelBufferRing* MemoryAwareTileCache::pixelBufferRing() {
+    return _pixelBufferRing.get();
+}
+
+uint64_t MemoryAwareTileCache::numberOfEvictions(uint16_t providerId) const {
+    const auto it = _numEvictions.find(providerId);
+    return it != _numEvictions.end() ? it->second : 0;
+}
+
+size_t MemoryAwareTileCache::numberOfBytes(uint16_t providerId) const {
+    const auto it = _numBytesPerProvider.find(providerId);
+    return it != _numBytesPerProvider.end() ? it->second : 0;
+}
+
 size_t MemoryAwareTileCache::cpuAllocatedDataSize() const {
     const size_t dataSize = std::accumulate(
         _textureContainerMap.cbegin(),
@@ -25,18 +25,20 @@
 #ifndef __OPENSPACE_MODULE_GLOBEBROWSING___MEMORY_AWARE_TILE_CACHE___H__
 #define __OPENSPACE_MODULE_GLOBEBROWSING___MEMORY_AWARE_TILE_CACHE___H__
 
-#include <modules/globebrowsing/src/lrucache.h>
 #include <modules/globebrowsing/src/tileindex.h>
 #include <modules/globebrowsing/src/tiletextureinitdata.h>
 #include <openspace/properties/propertyowner.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/triggerproperty.h>
+#include <openspace/util/lrucache.h>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 namespace openspace::globebrowsing {
+    class PixelBufferRing;
     struct RawTile;
     class Tile;
 } // namespace openspace::globebrowsing
@@ -85,13 +87,33 @@ struct ProviderTileHasher {
 class MemoryAwareTileCache : public properties::PropertyOwner {
 public:
     explicit MemoryAwareTileCache(int tileCacheSize = 1024);
+    ~MemoryAwareTileCache() override;
+
+    void deinitializeGL();
 
     void clear();
     void setSizeEstimated(size_t estimatedSize);
     bool exist(const ProviderTileKey& key) const;
+
+    /**
+     * Returns whether the tile for the \p key is in the cache and was created from the
+     * actual data of the tile rather than being a provisional tile.
+     */
+    bool hasLoadedTile(const ProviderTileKey& key) const;
     Tile get(const ProviderTileKey& key);
     ghoul::opengl::Texture* texture(const TileTextureInitData& initData);
     void createTileAndPut(ProviderTileKey key, RawTile rawTile);
+
+    /**
+     * Creates a provisional tile for the \p key by upsampling the quadrant of the cached
+     * parent tile that covers it on the GPU. The provisional tile is used for rendering
+     * until the actual tile is put into the cache, which replaces it. This avoids that
+     * chunks have to sample their parent's tile with a uv transform while their own
+     * tile is loading. Returns an unavailable Tile if the parent tile is not cached, its
+     * texture format can't be rendered to or is needed on the CPU, or if the budget of
+     * provisional tiles for this frame is exhausted.
+     */
+    Tile createProvisionalTile(const ProviderTileKey& key);
     void put(const ProviderTileKey& key,
         const TileTextureInitData::HashKey& initDataKey, Tile tile);
     void update();
@@ -99,6 +121,32 @@ public:
     size_t gpuAllocatedDataSize() const;
     size_t cpuAllocatedDataSize() const;
 
+    /**
+     * Returns whether there is remaining upload budget in the current frame, both in
+     * terms of the uploaded bytes and of the OpenSpaceEngine's frame budget. If this
+     * returns `false`, finished tiles should be kept until the next frame rather than
+     * being passed to createTileAndPut.
+     */
+    bool hasUploadBudget() const;
+
+    /**
+     * Returns the persistently mapped pixel buffers that tile load jobs can read their
+     * pixels into or `nullptr` if these are not supported on this system.
+     */
+    PixelBufferRing* pixelBufferRing();
+
+    /**
+     * Returns the total number of tiles of the provider with the \p providerId that
+     * were evicted from the cache to make room for other tiles.
+     */
+    uint64_t numberOfEvictions(uint16_t providerId) const;
+
+    /**
+     * Returns the number of bytes of texture memory that are currently occupied by the
+     * cached tiles of the provider with the \p providerId.
+     */
+    size_t numberOfBytes(uint16_t providerId) const;
+
 private:
     /**
      * Owner of texture data used for tiles. Instead of dynamically allocating textures
@@ -110,12 +158,14 @@ private:
          * \param initData is the description of the texture type.
          * \param numTextures is the number of textures to allocate.
          */
-        TextureContainer(TileTextureInitData initData, size_t numTextures);
+        TextureContainer(TileTextureInitData initData, size_t numTextures,
+            bool useBindlessTextures);
 
-        ~TextureContainer() = default;
+        ~TextureContainer();
 
         void reset();
         void reset(size_t numTextures);
+        void reset(size_t numTextures, bool useBindlessTextures);
 
         /**
          * \return A pointer to a texture if there is one texture never used before. If
@@ -131,20 +181,33 @@ private:
          */
         size_t size() const;
 
+        /**
+         * \return The resident bindless handle for the \p texture or 0 if this container
+         *         does not use bindless textures or does not own the \p texture
+         */
+        uint64_t textureHandle(const ghoul::opengl::Texture* texture) const;
+
+        bool usesBindlessTextures() const;
+
     private:
+        void releaseTextures();
+
         std::vector<std::unique_ptr<ghoul::opengl::Texture>> _textures;
+        std::unordered_map<const ghoul::opengl::Texture*, uint64_t> _textureHandles;
 
         const TileTextureInitData _initData;
         size_t _freeTexture = 0;
         size_t _numTextures;
+        bool _useBindlessTextures;
     };
 
 
     void createDefaultTextureContainers();
     void assureTextureContainerExists(const TileTextureInitData& initData);
     void resetTextureContainerSize(size_t numTexturesPerTextureType);
+    void setUseBindlessTextures(bool useBindlessTextures);
 
-    using TileCache = LRUCache<ProviderTileKey, Tile, ProviderTileHasher>;
+    using TileCache = LruCache<ProviderTileKey, Tile, ProviderTileHasher>;
     using TextureContainerTileCache = std::pair<
         std::unique_ptr<TextureContainer>,
         std::unique_ptr<TileCache>
@@ -157,12 +220,26 @@ private:
     TextureContainerMap _textureContainerMap;
     size_t _numTextureBytesAllocatedOnCPU;
 
+    std::unique_ptr<PixelBufferRing> _pixelBufferRing;
+    size_t _numBytesUploadedThisFrame = 0;
+    std::unordered_map<uint16_t, uint64_t> _numEvictions;
+    std::unordered_map<uint16_t, size_t> _numBytesPerProvider;
+
     // Properties
     properties::IntProperty _cpuAllocatedTileData;
     properties::IntProperty _gpuAllocatedTileData;
     properties::IntProperty _tileCacheSize;
     properties::TriggerProperty _applyTileCacheSize;
     properties::TriggerProperty _clearTileCache;
+    properties::BoolProperty _useBindlessTextures;
+    properties::IntProperty _uploadBudget;
+    properties::IntProperty _provisionalTileBudget;
+
+    int _numProvisionalTilesThisFrame = 0;
+    // Framebuffers that the parent and the provisional tile are attached to in order to
+    // upsample one into the other
+    GLuint _provisionalReadFramebuffer = 0;
+    GLuint _provisionalDrawFramebuffer = 0;
 };
 
 } // namespace openspace::globebrowsing::cache
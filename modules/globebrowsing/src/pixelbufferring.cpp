@@ -0,0 +1,213 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/pixelbufferring.h>
+
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <algorithm>
+#include <utility>
+
+namespace openspace::globebrowsing {
+
+PixelBufferRing::Slot::Slot(PixelBufferRing* ring, int index)
+    : _ring(ring)
+    , _index(index)
+{}
+
+PixelBufferRing::Slot::Slot(Slot&& other) noexcept
+    : _ring(std::exchange(other._ring, nullptr))
+    , _index(std::exchange(other._index, -1))
+{}
+
+PixelBufferRing::Slot& PixelBufferRing::Slot::operator=(Slot&& other) noexcept {
+    if (this != &other) {
+        if (_ring) {
+            _ring->release(_index);
+        }
+        _ring = std::exchange(other._ring, nullptr);
+        _index = std::exchange(other._index, -1);
+    }
+    return *this;
+}
+
+PixelBufferRing::Slot::~Slot() {
+    if (_ring) {
+        _ring->release(_index);
+    }
+}
+
+std::byte* PixelBufferRing::Slot::data() const {
+    return _ring ? _ring->_buffers[_index].data : nullptr;
+}
+
+GLuint PixelBufferRing::Slot::buffer() const {
+    return _ring ? _ring->_buffers[_index].buffer : 0;
+}
+
+PixelBufferRing::Slot::operator bool() const {
+    return _ring != nullptr;
+}
+
+bool PixelBufferRing::isSupported() {
+    using namespace ghoul::systemcapabilities;
+    return !(OpenGLCap.openGLVersion() < Version{ 4, 4, 0 }) ||
+           OpenGLCap.isExtensionSupported("GL_ARB_buffer_storage");
+}
+
+PixelBufferRing::PixelBufferRing(int nSlots, size_t slotSize)
+    : _slotSize(slotSize)
+{
+    ZoneScoped;
+
+    ghoul_assert(nSlots > 0, "Need at least one slot");
+    ghoul_assert(slotSize > 0, "Slots must not be empty");
+
+    constexpr GLbitfield Flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    _buffers.resize(nSlots);
+    _freeSlots.reserve(nSlots);
+    _retiredSlots.reserve(nSlots);
+    for (int i = 0; i < nSlots; ++i) {
+        Buffer& b = _buffers[i];
+        glGenBuffers(1, &b.buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, b.buffer);
+        glBufferStorage(
+            GL_PIXEL_UNPACK_BUFFER,
+            static_cast<GLsizeiptr>(_slotSize),
+            nullptr,
+            Flags
+        );
+        b.data = reinterpret_cast<std::byte*>(glMapBufferRange(
+            GL_PIXEL_UNPACK_BUFFER,
+            0,
+            static_cast<GLsizeiptr>(_slotSize),
+            Flags
+        ));
+        _freeSlots.push_back(i);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    _isInitialized = true;
+}
+
+PixelBufferRing::~PixelBufferRing() {
+    ghoul_assert(!_isInitialized, "deinitializeGL must be called before destruction");
+}
+
+void PixelBufferRing::deinitializeGL() {
+    ZoneScoped;
+
+    std::lock_guard lock(_mutex);
+    if (!_isInitialized) {
+        return;
+    }
+    for (Buffer& b : _buffers) {
+        if (b.fence) {
+            glDeleteSync(b.fence);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, b.buffer);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glDeleteBuffers(1, &b.buffer);
+        b = Buffer();
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    // Slots that are still alive keep their index, but will never be handed out again
+    _freeSlots.clear();
+    _retiredSlots.clear();
+    _isInitialized = false;
+}
+
+PixelBufferRing::Slot PixelBufferRing::acquire(size_t nBytes) {
+    if (nBytes > _slotSize) {
+        return Slot();
+    }
+
+    std::lock_guard lock(_mutex);
+    if (!_isInitialized || _freeSlots.empty()) {
+        return Slot();
+    }
+    const int index = _freeSlots.back();
+    _freeSlots.pop_back();
+    return Slot(this, index);
+}
+
+void PixelBufferRing::retire(Slot slot) {
+    if (!slot) {
+        return;
+    }
+    ghoul_assert(slot._ring == this, "Slot belongs to a different ring");
+
+    const int index = std::exchange(slot._index, -1);
+    slot._ring = nullptr;
+
+    std::lock_guard lock(_mutex);
+    if (!_isInitialized) {
+        return;
+    }
+    _buffers[index].fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _retiredSlots.push_back(index);
+}
+
+void PixelBufferRing::collectRetired() {
+    ZoneScoped;
+
+    std::lock_guard lock(_mutex);
+    const auto it = std::remove_if(
+        _retiredSlots.begin(),
+        _retiredSlots.end(),
+        [this](int index) {
+            Buffer& b = _buffers[index];
+            const GLenum res = glClientWaitSync(b.fence, 0, 0);
+            if (res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED) {
+                glDeleteSync(b.fence);
+                b.fence = nullptr;
+                _freeSlots.push_back(index);
+                return true;
+            }
+            return false;
+        }
+    );
+    _retiredSlots.erase(it, _retiredSlots.end());
+}
+
+size_t PixelBufferRing::slotSize() const {
+    return _slotSize;
+}
+
+int PixelBufferRing::numberOfSlots() const {
+    return static_cast<int>(_buffers.size());
+}
+
+void PixelBufferRing::release(int index) {
+    std::lock_guard lock(_mutex);
+    if (!_isInitialized) {
+        return;
+    }
+    _freeSlots.push_back(index);
+}
+
+} // namespace openspace::globebrowsing
@@ -0,0 +1,136 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___PIXELBUFFERRING___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___PIXELBUFFERRING___H__
+
+#include <ghoul/opengl/ghoul_gl.h>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace openspace::globebrowsing {
+
+/**
+ * A fixed number of pixel buffer objects that are persistently mapped into client memory
+ * so that the tile load jobs can write the decoded pixels of a tile directly into memory
+ * that the GPU can transfer from asynchronously. Each buffer is handed out as a Slot
+ * that can be acquired from any thread. When a slot is destroyed without being used, it
+ * is immediately available again. After the pixels have been used for a texture upload,
+ * the slot is retired instead and only becomes available again once the GPU has
+ * finished reading from it.
+ *
+ * The constructor, retire, collectRetired, and deinitializeGL have to be called from
+ * the thread that owns the OpenGL context.
+ */
+class PixelBufferRing {
+public:
+    /**
+     * A reservation of one of the pixel buffers of the ring. A default constructed Slot,
+     * or one that was moved from, does not reference any buffer.
+     */
+    class Slot {
+    public:
+        Slot() = default;
+        Slot(Slot&& other) noexcept;
+        Slot& operator=(Slot&& other) noexcept;
+        Slot(const Slot&) = delete;
+        Slot& operator=(const Slot&) = delete;
+        ~Slot();
+
+        /// Returns the mapped memory of the buffer or `nullptr` if this Slot is empty
+        std::byte* data() const;
+
+        /// Returns the name of the pixel buffer object or 0 if this Slot is empty
+        GLuint buffer() const;
+
+        explicit operator bool() const;
+
+    private:
+        friend class PixelBufferRing;
+        Slot(PixelBufferRing* ring, int index);
+
+        PixelBufferRing* _ring = nullptr;
+        int _index = -1;
+    };
+
+    /**
+     * Returns whether persistently mapped buffers (OpenGL 4.4 or GL_ARB_buffer_storage)
+     * are supported by the current OpenGL context.
+     */
+    static bool isSupported();
+
+    /**
+     * Creates \p nSlots pixel buffers of \p slotSize bytes each and maps them.
+     */
+    PixelBufferRing(int nSlots, size_t slotSize);
+    ~PixelBufferRing();
+
+    /**
+     * Unmaps and deletes all buffers. Afterwards, no more slots can be acquired.
+     */
+    void deinitializeGL();
+
+    /**
+     * Returns a Slot that can hold \p nBytes bytes. If all buffers are in use or if the
+     * buffers are too small, the returned Slot is empty. This function can be called
+     * from any thread.
+     */
+    Slot acquire(size_t nBytes);
+
+    /**
+     * Marks the \p slot as being read by all previously issued OpenGL commands. The
+     * buffer is available again once these commands have completed on the GPU.
+     */
+    void retire(Slot slot);
+
+    /**
+     * Makes all retired slots whose OpenGL commands have completed available again. This
+     * should be called once per frame.
+     */
+    void collectRetired();
+
+    size_t slotSize() const;
+    int numberOfSlots() const;
+
+private:
+    void release(int index);
+
+    struct Buffer {
+        GLuint buffer = 0;
+        std::byte* data = nullptr;
+        GLsync fence = nullptr;
+    };
+    std::vector<Buffer> _buffers;
+    const size_t _slotSize;
+
+    std::mutex _mutex;
+    std::vector<int> _freeSlots;
+    std::vector<int> _retiredSlots;
+    bool _isInitialized = false;
+};
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___PIXELBUFFERRING___H__
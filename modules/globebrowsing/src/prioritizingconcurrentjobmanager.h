@@ -49,6 +49,13 @@ public:
      */
     void enqueueJob(std::shared_ptr<Job<P>> job, KeyType key);
 
+    /**
+     * Enqueues a job which is only worked on when no job enqueued with `enqueueJob` is
+     * waiting. Low priority jobs are also the first ones to be marked as unfinished when
+     * the queue is full
+     */
+    void enqueueLowPriorityJob(std::shared_ptr<Job<P>> job, KeyType key);
+
     /**
      * The keys returned by this function have been popped from the queue and corresponds
      * to jobs that will not be executed and therefore marked as unfinished. Calling this
@@ -82,6 +89,11 @@ public:
 
     size_t numFinishedJobs() const;
 
+    /**
+     * \returns the number of jobs that are enqueued but not yet worked on
+     */
+    size_t numQueuedJobs();
+
 private:
     ConcurrentQueue<std::shared_ptr<Job<P>>> _finishedJobs;
     std::mutex _finishedJobsMutex;
@@ -34,7 +34,7 @@ PrioritizingConcurrentJobManager<P, KeyType>::PrioritizingConcurrentJobManager(
 
 template <typename P, typename KeyType>
 void PrioritizingConcurrentJobManager<P, KeyType>::enqueueJob(std::shared_ptr<Job<P>> job,
-                                                              KeyType key)
+                                                                              KeyType key)
 {
     _threadPool.enqueue([this, job]() {
         job->execute();
@@ -43,6 +43,18 @@ void PrioritizingConcurrentJobManager<P, KeyType>::enqueueJob(std::shared_ptr<Jo
     }, key);
 }
 
+template <typename P, typename KeyType>
+void PrioritizingConcurrentJobManager<P, KeyType>::enqueueLowPriorityJob(
+                                                              std::shared_ptr<Job<P>> job,
+                                                                              KeyType key)
+{
+    _threadPool.enqueueWithLowPriority([this, job]() {
+        job->execute();
+        std::lock_guard lock(_finishedJobsMutex);
+        _finishedJobs.push(job);
+    }, key);
+}
+
 template <typename P, typename KeyType>
 std::vector<KeyType>
 PrioritizingConcurrentJobManager<P, KeyType>::keysToUnfinishedJobs() {
@@ -79,4 +91,9 @@ size_t PrioritizingConcurrentJobManager<P, KeyType>::numFinishedJobs() const {
     return _finishedJobs.size();
 }
 
+template <typename P, typename KeyType>
+size_t PrioritizingConcurrentJobManager<P, KeyType>::numQueuedJobs() {
+    return _threadPool.numQueuedTasks();
+}
+
 } // namespace openspace::globebrowsing
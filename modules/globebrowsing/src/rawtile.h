@@ -26,10 +26,12 @@
 #define __OPENSPACE_MODULE_GLOBEBROWSING___RAWTILE___H__
 
 #include <modules/globebrowsing/src/basictypes.h>
+#include <modules/globebrowsing/src/pixelbufferring.h>
 #include <modules/globebrowsing/src/tileindex.h>
 #include <modules/globebrowsing/src/tiletextureinitdata.h>
 #include <ghoul/glm.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <optional>
@@ -52,7 +54,14 @@ struct RawTile {
     std::optional<TileTextureInitData> textureInitData;
     TileIndex tileIndex = TileIndex(0, 0, 0);
     ReadError error = ReadError::None;
-    GLuint pbo = 0;
+
+    // If this is not empty, the pixels were read directly into this pixel buffer and
+    // imageData is empty
+    PixelBufferRing::Slot pixelBuffer;
+
+    // The time it took to read the tile from its source and to process it afterwards
+    std::chrono::microseconds readDuration = std::chrono::microseconds(0);
+    std::chrono::microseconds processDuration = std::chrono::microseconds(0);
 };
 
 } // namespace openspace::globebrowsing
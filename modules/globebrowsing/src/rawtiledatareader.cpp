@@ -25,15 +25,20 @@
 #include <modules/globebrowsing/src/rawtiledatareader.h>
 
 #include <modules/globebrowsing/globebrowsingmodule.h>
+#include <modules/globebrowsing/src/blockcompression.h>
+#include <modules/globebrowsing/src/gdalwrapper.h>
 #include <modules/globebrowsing/src/geodeticpatch.h>
+#include <modules/globebrowsing/src/tilewarmcache.h>
 #include <openspace/engine/globals.h>
 #include <openspace/engine/moduleengine.h>
 #include <ghoul/fmt.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/defer.h>
 #include <ghoul/misc/exception.h>
 #include <ghoul/misc/profiling.h>
+#include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
 
 #ifdef _MSC_VER
 #pragma warning (push)
@@ -52,8 +57,10 @@
 #endif // _MSC_VER
 
 #include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <filesystem>
+#include <iterator>
 #include <system_error>
 
 namespace openspace::globebrowsing {
@@ -61,6 +68,9 @@ namespace openspace::globebrowsing {
 namespace {
     constexpr std::string_view _loggerCat = "RawTileDataReader";
 
+    // The number of tiles of a remote dataset that are read at the same time
+    constexpr int RemoteConcurrentReads = 4;
+
 enum class Side {
     Left = 0,
     Top,
@@ -361,6 +371,40 @@ RawTile::ReadError postProcessErrorCheck(const RawTile& rawTile,
     return RawTile::ReadError::None;
 }
 
+// Returns the name of the server from which the dataset is loaded or an empty string if
+// the dataset is local. The dataset can be a URL, an inline XML description, or the path
+// to an XML description such as a GDAL WMS file
+std::string remoteHost(const std::string& dataset) {
+    constexpr uintmax_t MaxDescriptionSize = 64 * 1024;
+
+    std::string content = dataset;
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(dataset, ec) &&
+        std::filesystem::file_size(dataset, ec) < MaxDescriptionSize)
+    {
+        std::ifstream file(dataset);
+        content = std::string(std::istreambuf_iterator<char>(file), {});
+        const size_t first = content.find_first_not_of(" \t\r\n");
+        if (first == std::string::npos || content[first] != '<') {
+            // Not an XML description, so this is a local image file
+            return "";
+        }
+    }
+
+    size_t begin = content.find("://");
+    if (begin == std::string::npos || begin < 4) {
+        return "";
+    }
+    const bool isHttp = content.compare(begin - 4, 4, "http") == 0;
+    const bool isHttps = begin >= 5 && content.compare(begin - 5, 5, "https") == 0;
+    if (!isHttp && !isHttps) {
+        return "";
+    }
+    begin += 3;
+    const size_t end = content.find_first_of("/:?<\"' \t\r\n", begin);
+    return content.substr(begin, end - begin);
+}
+
 } // namespace
 
 
@@ -376,14 +420,18 @@ RawTileDataReader::RawTileDataReader(std::string filePath,
     ZoneScoped;
 
     initialize();
+    if (_cacheProperties.blockCompression) {
+        initializeBlockCompression();
+    }
+
+    _warmCacheIdentifier = TileWarmCache::datasetIdentifier(fmt::format(
+        "{}|{}|{}", _datasetFilePath, _initData.hashKey, static_cast<bool>(_preprocess)
+    ));
 }
 
 RawTileDataReader::~RawTileDataReader() {
     std::lock_guard lockGuard(_datasetLock);
-    if (_dataset) {
-        GDALClose(_dataset);
-        _dataset = nullptr;
-    }
+    closeDatasets();
 }
 
 std::optional<std::string> RawTileDataReader::mrfCache() {
@@ -499,6 +547,48 @@ std::optional<std::string> RawTileDataReader::mrfCache() {
     }
 }
 
+void RawTileDataReader::initializeBlockCompression() {
+    ZoneScoped;
+
+    // The compressed blocks replace the pixels entirely, so the tiles must not be needed
+    // on the CPU and have to consist of whole blocks of 8-bit colors
+    const bool isCompressible =
+        _initData.glType == GL_UNSIGNED_BYTE && _initData.nRasters == 4 &&
+        !_initData.shouldAllocateDataOnCPU && !_preprocess &&
+        _initData.dimensions.x % 4 == 0 && _initData.dimensions.y % 4 == 0;
+    if (!isCompressible) {
+        LWARNING(fmt::format(
+            "Block compression is only supported for 8-bit color tiles without "
+            "preprocessing. Dataset: {}", _datasetFilePath
+        ));
+        return;
+    }
+
+    using namespace ghoul::systemcapabilities;
+    if (!OpenGLCap.isExtensionSupported("GL_EXT_texture_compression_s3tc")) {
+        LWARNING(fmt::format(
+            "Block compression requires GL_EXT_texture_compression_s3tc. Dataset: {}",
+            _datasetFilePath
+        ));
+        return;
+    }
+
+    GlobeBrowsingModule& module = *global::moduleEngine->module<GlobeBrowsingModule>();
+    std::string datasetIdentifier =
+        std::to_string(std::hash<std::string>{}(_datasetFilePath));
+    _compressedTileCache = absPath(fmt::format("{}/{}/{}/bc3/",
+        module.mrfCacheLocation(), _cacheProperties.path, datasetIdentifier));
+
+    _compressedInitData.emplace(
+        _initData.dimensions.x,
+        _initData.dimensions.y,
+        _initData.glType,
+        _initData.ghoulTextureFormat,
+        TileTextureInitData::ShouldAllocateDataOnCPU::No,
+        TileTextureInitData::BlockCompression::BC3
+    );
+}
+
 void RawTileDataReader::initialize() {
     ZoneScoped;
 
@@ -526,6 +616,9 @@ void RawTileDataReader::initialize() {
             ));
         }
     }
+    _openedDataset = content;
+    _remoteHost = remoteHost(_datasetFilePath);
+    _freeDatasets = { _dataset };
 
     // Assume all raster bands have the same data type
     _rasterCount = _dataset->GetRasterCount();
@@ -578,14 +671,64 @@ void RawTileDataReader::initialize() {
 void RawTileDataReader::reset() {
     std::lock_guard lockGuard(_datasetLock);
     _maxChunkLevel = -1;
+    closeDatasets();
+    initialize();
+}
+
+void RawTileDataReader::closeDatasets() {
+    ghoul_assert(
+        _freeDatasets.size() == _additionalDatasets.size() + (_dataset ? 1 : 0),
+        "All datasets must be released before they are closed"
+    );
+
+    for (GDALDataset* dataset : _additionalDatasets) {
+        GDALClose(dataset);
+    }
+    _additionalDatasets.clear();
+    _freeDatasets.clear();
+
     if (_dataset) {
         GDALClose(_dataset);
         _dataset = nullptr;
     }
-    initialize();
 }
 
-RawTile::ReadError RawTileDataReader::rasterRead(int rasterBand,
+GDALDataset* RawTileDataReader::acquireDataset() const {
+    {
+        std::lock_guard lockGuard(_datasetLock);
+        if (!_freeDatasets.empty()) {
+            GDALDataset* dataset = _freeDatasets.back();
+            _freeDatasets.pop_back();
+            return dataset;
+        }
+    }
+
+    // All handles are used by other threads, so we need another one. GDAL handles must
+    // not be shared between threads
+    ZoneScopedN("GDALOpen");
+    GDALDataset* dataset = static_cast<GDALDataset*>(
+        GDALOpen(_openedDataset.c_str(), GA_ReadOnly)
+    );
+    if (dataset) {
+        std::lock_guard lockGuard(_datasetLock);
+        _additionalDatasets.push_back(dataset);
+    }
+    return dataset;
+}
+
+void RawTileDataReader::releaseDataset(GDALDataset* dataset) const {
+    std::lock_guard lockGuard(_datasetLock);
+    _freeDatasets.push_back(dataset);
+}
+
+int RawTileDataReader::maxConcurrentReads() const {
+    // Concurrent writes to the MRF cache from several handles would corrupt it, so only
+    // datasets that are read directly are read concurrently
+    const bool readsDirectly = _openedDataset == _datasetFilePath;
+    return !_remoteHost.empty() && readsDirectly ? RemoteConcurrentReads : 1;
+}
+
+RawTile::ReadError RawTileDataReader::rasterRead(GDALDataset* dataset, int rasterBand,
                                                  const IODescription& io,
                                                  char* dataDestination) const
 {
@@ -612,7 +755,7 @@ RawTile::ReadError RawTileDataReader::rasterRead(int rasterBand,
     dataDest -= io.write.region.start.y * io.write.bytesPerLine;
     dataDest += io.write.region.start.x * _initData.bytesPerPixel;
 
-    GDALRasterBand* gdalRasterBand = _dataset->GetRasterBand(rasterBand);
+    GDALRasterBand* gdalRasterBand = dataset->GetRasterBand(rasterBand);
     CPLErr readError = CE_Failure;
     readError = gdalRasterBand->RasterIO(
         GF_Read,
@@ -639,20 +782,54 @@ RawTile::ReadError RawTileDataReader::rasterRead(int rasterBand,
     }
 }
 
-RawTile RawTileDataReader::readTileData(TileIndex tileIndex) const {
+RawTile RawTileDataReader::readTileData(TileIndex tileIndex,
+                                        PixelBufferRing* pixelBuffers) const
+{
+    if (_compressedInitData.has_value()) {
+        return readCompressedTileData(std::move(tileIndex), pixelBuffers);
+    }
+
     size_t numBytes = _initData.totalNumBytes;
 
     RawTile rawTile;
-    rawTile.imageData = std::unique_ptr<std::byte[]>(new std::byte[numBytes]);
-    memset(rawTile.imageData.get(), 0xFF, numBytes);
+    // The preprocessing reads the pixels back, which is slow from mapped memory
+    const bool needsCpuData = _initData.shouldAllocateDataOnCPU || _preprocess;
+    if (pixelBuffers && !needsCpuData) {
+        rawTile.pixelBuffer = pixelBuffers->acquire(numBytes);
+    }
+
+    std::byte* imageData = rawTile.pixelBuffer.data();
+    if (!imageData) {
+        rawTile.imageData = std::unique_ptr<std::byte[]>(new std::byte[numBytes]);
+        imageData = rawTile.imageData.get();
+    }
+
+    rawTile.tileIndex = tileIndex;
+    rawTile.textureInitData = _initData;
+    const auto readStart = std::chrono::steady_clock::now();
+
+    // Tiles in the warm cache are already processed and can be uploaded right away
+    TileWarmCache* warmCache =
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileWarmCache();
+    if (warmCache && warmCache->read(_warmCacheIdentifier, tileIndex, _initData,
+                                     imageData, rawTile.tileMetaData))
+    {
+        rawTile.readDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - readStart
+        );
+        return rawTile;
+    }
+
+    memset(imageData, 0xFF, numBytes);
 
     IODescription io = ioDescription(tileIndex);
     RawTile::ReadError worstError = RawTile::ReadError::None;
-    readImageData(io, worstError, reinterpret_cast<char*>(rawTile.imageData.get()));
+    readImageData(io, worstError, reinterpret_cast<char*>(imageData));
+    const auto readEnd = std::chrono::steady_clock::now();
+    rawTile.readDuration =
+        std::chrono::duration_cast<std::chrono::microseconds>(readEnd - readStart);
 
     rawTile.error = worstError;
-    rawTile.tileIndex = std::move(tileIndex);
-    rawTile.textureInitData = _initData;
 
     if (_preprocess) {
         rawTile.tileMetaData = tileMetaData(rawTile, io.write.region);
@@ -660,21 +837,138 @@ RawTile RawTileDataReader::readTileData(TileIndex tileIndex) const {
             rawTile.error,
             postProcessErrorCheck(rawTile, _initData.nRasters, noDataValueAsFloat())
         );
+        rawTile.processDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - readEnd
+        );
+    }
+
+    if (warmCache && rawTile.error == RawTile::ReadError::None) {
+        warmCache->write(
+            _warmCacheIdentifier,
+            rawTile.tileIndex,
+            _initData,
+            imageData,
+            rawTile.tileMetaData
+        );
+    }
+
+    return rawTile;
+}
+
+RawTile RawTileDataReader::readCompressedTileData(TileIndex tileIndex,
+                                                  PixelBufferRing* pixelBuffers) const
+{
+    ZoneScoped;
+
+    const TileTextureInitData& initData = *_compressedInitData;
+    const size_t numBytes = initData.totalNumBytes;
+
+    RawTile rawTile;
+    rawTile.tileIndex = tileIndex;
+    rawTile.textureInitData = initData;
+    if (pixelBuffers) {
+        rawTile.pixelBuffer = pixelBuffers->acquire(numBytes);
+    }
+    std::byte* blocks = rawTile.pixelBuffer.data();
+    if (!blocks) {
+        rawTile.imageData = std::unique_ptr<std::byte[]>(new std::byte[numBytes]);
+        blocks = rawTile.imageData.get();
+    }
+
+    const std::filesystem::path file = compressedTileFile(tileIndex);
+    const auto readStart = std::chrono::steady_clock::now();
+    std::error_code ec;
+    if (std::filesystem::file_size(file, ec) == numBytes && !ec) {
+        ZoneScopedN("Read cached blocks");
+
+        std::ifstream in(file, std::ifstream::binary);
+        in.read(reinterpret_cast<char*>(blocks), numBytes);
+        if (in.good()) {
+            rawTile.readDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - readStart
+            );
+            return rawTile;
+        }
+    }
+
+    // The tile has not been compressed before, so it is read from the dataset first
+    std::unique_ptr<std::byte[]> pixels =
+        std::unique_ptr<std::byte[]>(new std::byte[_initData.totalNumBytes]);
+    memset(pixels.get(), 0xFF, _initData.totalNumBytes);
+
+    IODescription io = ioDescription(tileIndex);
+    RawTile::ReadError worstError = RawTile::ReadError::None;
+    readImageData(io, worstError, reinterpret_cast<char*>(pixels.get()));
+    const auto readEnd = std::chrono::steady_clock::now();
+    rawTile.readDuration =
+        std::chrono::duration_cast<std::chrono::microseconds>(readEnd - readStart);
+    rawTile.error = worstError;
+    if (worstError != RawTile::ReadError::None) {
+        // Tiles with errors are discarded, so they should not end up in the cache either
+        return rawTile;
+    }
+
+    compressBC3(
+        pixels.get(),
+        glm::ivec2(_initData.dimensions),
+        _initData.ghoulTextureFormat == ghoul::opengl::Texture::Format::BGRA,
+        blocks
+    );
+    rawTile.processDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - readEnd
+    );
+
+    {
+        ZoneScopedN("Write cached blocks");
+
+        std::filesystem::create_directories(file.parent_path(), ec);
+        // Writing to a temporary file first prevents other readers or a crash from
+        // leaving a partially written tile in the cache
+        std::filesystem::path tmp = file;
+        tmp += ".tmp";
+        std::ofstream out(tmp, std::ofstream::binary);
+        out.write(reinterpret_cast<const char*>(blocks), numBytes);
+        out.close();
+        if (out.good()) {
+            std::filesystem::rename(tmp, file, ec);
+        }
+        if (!out.good() || ec) {
+            LDEBUG(fmt::format("Failed to write compressed tile {}", file));
+            std::filesystem::remove(tmp, ec);
+        }
     }
 
     return rawTile;
 }
 
+std::filesystem::path RawTileDataReader::compressedTileFile(
+                                                       const TileIndex& tileIndex) const
+{
+    return _compressedTileCache / std::to_string(tileIndex.level) /
+        fmt::format("{}_{}.bc3", tileIndex.x, tileIndex.y);
+}
+
 void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& worstError,
                                       char* imageDataDest) const
 {
+    const HostRequestLimiter::Request request(
+        GdalWrapper::ref().hostRequestLimiter(),
+        _remoteHost
+    );
+    GDALDataset* dataset = acquireDataset();
+    if (!dataset) {
+        worstError = RawTile::ReadError::Failure;
+        return;
+    }
+    defer { releaseDataset(dataset); };
+
     // Only read the minimum number of rasters
     int nRastersToRead = std::min(_rasterCount, static_cast<int>(_initData.nRasters));
 
     switch (_initData.ghoulTextureFormat) {
         case ghoul::opengl::Texture::Format::Red: {
             char* dest = imageDataDest;
-            const RawTile::ReadError err = rasterRead(1, io, dest);
+            const RawTile::ReadError err = rasterRead(dataset, 1, io, dest);
             worstError = std::max(worstError, err);
             break;
         }
@@ -686,7 +980,7 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(1, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, 1, io, dest);
                     worstError = std::max(worstError, err);
                 }
             }
@@ -695,12 +989,12 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(1, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, 1, io, dest);
                     worstError = std::max(worstError, err);
                 }
                 // Last read is the alpha channel
                 char* dest = imageDataDest + (3 * _initData.bytesPerDatum);
-                const RawTile::ReadError err = rasterRead(2, io, dest);
+                const RawTile::ReadError err = rasterRead(dataset, 2, io, dest);
                 worstError = std::max(worstError, err);
             }
             else { // Three or more rasters
@@ -708,7 +1002,7 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(i + 1, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, i + 1, io, dest);
                     worstError = std::max(worstError, err);
                 }
             }
@@ -721,7 +1015,7 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(1, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, 1, io, dest);
                     worstError = std::max(worstError, err);
                 }
             }
@@ -730,12 +1024,12 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(1, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, 1, io, dest);
                     worstError = std::max(worstError, err);
                 }
                 // Last read is the alpha channel
                 char* dest = imageDataDest + (3 * _initData.bytesPerDatum);
-                const RawTile::ReadError err = rasterRead(2, io, dest);
+                const RawTile::ReadError err = rasterRead(dataset, 2, io, dest);
                 worstError = std::max(worstError, err);
             }
             else { // Three or more rasters
@@ -743,14 +1037,14 @@ void RawTileDataReader::readImageData(IODescription& io, RawTile::ReadError& wor
                     // The final destination pointer is offsetted by one datum byte size
                     // for every raster (or data channel, i.e. R in RGB)
                     char* dest = imageDataDest + (i * _initData.bytesPerDatum);
-                    const RawTile::ReadError err = rasterRead(3 - i, io, dest);
+                    const RawTile::ReadError err = rasterRead(dataset, 3 - i, io, dest);
                     worstError = std::max(worstError, err);
                 }
             }
             if (nRastersToRead > 3) { // Alpha channel exists
                 // Last read is the alpha channel
                 char* dest = imageDataDest + (3 * _initData.bytesPerDatum);
-                const RawTile::ReadError err = rasterRead(4, io, dest);
+                const RawTile::ReadError err = rasterRead(dataset, 4, io, dest);
                 worstError = std::max(worstError, err);
             }
             break;
@@ -852,6 +1146,10 @@ TileMetaData RawTileDataReader::tileMetaData(RawTile& rawTile,
     return ppData;
 }
 
+uint64_t RawTileDataReader::warmCacheIdentifier() const {
+    return _warmCacheIdentifier;
+}
+
 int RawTileDataReader::maxChunkLevel() const {
     return _maxChunkLevel;
 }
@@ -30,8 +30,11 @@
 #include <modules/globebrowsing/src/tiletextureinitdata.h>
 #include <modules/globebrowsing/src/tilecacheproperties.h>
 #include <ghoul/misc/boolean.h>
+#include <filesystem>
 #include <string>
 #include <mutex>
+#include <optional>
+#include <vector>
 #include <gdal.h>
 
 class GDALDataset;
@@ -62,7 +65,30 @@ public:
     int maxChunkLevel() const;
     float noDataValueAsFloat() const;
 
-    RawTile readTileData(TileIndex tileIndex) const;
+    /**
+     * Reads the tile with the provided \p tileIndex. If \p pixelBuffers is provided and
+     * has a free slot, the pixels are read directly into it, unless the data is needed
+     * on the CPU, in which case it is read into the RawTile's imageData instead.
+     *
+     * If block compression is enabled in the cache properties, the returned tile
+     * contains BC3 compressed blocks instead, which are read from the on-disk cache or
+     * compressed and stored there when the tile is read for the first time.
+     */
+    RawTile readTileData(TileIndex tileIndex,
+        PixelBufferRing* pixelBuffers = nullptr) const;
+
+    /**
+     * Returns the number of threads that should call readTileData at the same time.
+     * Local datasets are read by a single thread, while remote datasets are read by
+     * several threads so that the latency of the requests overlaps.
+     */
+    int maxConcurrentReads() const;
+
+    /**
+     * Returns the identifier of the tiles of this reader in the TileWarmCache, which
+     * stays the same across sessions.
+     */
+    uint64_t warmCacheIdentifier() const;
     const TileDepthTransform& depthTransform() const;
     glm::ivec2 fullPixelSize() const;
 
@@ -70,9 +96,23 @@ private:
     std::optional<std::string> mrfCache();
 
     void initialize();
+    void initializeBlockCompression();
+
+    RawTile readCompressedTileData(TileIndex tileIndex,
+        PixelBufferRing* pixelBuffers) const;
+    std::filesystem::path compressedTileFile(const TileIndex& tileIndex) const;
 
-    RawTile::ReadError rasterRead(int rasterBand, const IODescription& io,
-        char* dataDestination) const;
+    RawTile::ReadError rasterRead(GDALDataset* dataset, int rasterBand,
+        const IODescription& io, char* dataDestination) const;
+
+    /**
+     * Returns a handle to the dataset that is not used by any other thread, opening a
+     * new one if necessary, or `nullptr` if the dataset could not be opened. The handle
+     * has to be returned with releaseDataset.
+     */
+    GDALDataset* acquireDataset() const;
+    void releaseDataset(GDALDataset* dataset) const;
+    void closeDatasets();
 
     void readImageData(IODescription& io, RawTile::ReadError& worstError,
         char* imageDataDest) const;
@@ -84,6 +124,16 @@ private:
     const std::string _datasetFilePath;
     GDALDataset* _dataset = nullptr;
 
+    // The file or XML description that was opened, which is either the dataset itself
+    // or its MRF cache
+    std::string _openedDataset;
+    // The server from which the dataset is loaded or empty if it is a local dataset
+    std::string _remoteHost;
+    // The handles that were opened in addition to _dataset for concurrent reads
+    mutable std::vector<GDALDataset*> _additionalDatasets;
+    // The handles, including _dataset, that are currently not used by any thread
+    mutable std::vector<GDALDataset*> _freeDatasets;
+
     // Dataset parameters
     int _rasterCount;
     int _rasterXSize;
@@ -97,6 +147,11 @@ private:
     const TileCacheProperties _cacheProperties;
     const PerformPreprocessing _preprocess;
     TileDepthTransform _depthTransform = { .scale = 0.f, .offset = 0.f };
+    uint64_t _warmCacheIdentifier = 0;
+
+    // Only has a value if the tiles of this reader are block compressed
+    std::optional<TileTextureInitData> _compressedInitData;
+    std::filesystem::path _compressedTileCache;
 
     mutable std::mutex _datasetLock;
 };
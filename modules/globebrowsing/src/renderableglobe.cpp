@@ -25,8 +25,10 @@
 #include <modules/globebrowsing/src/renderableglobe.h>
 
 #include <modules/debugging/rendering/debugrenderer.h>
+#include <modules/globebrowsing/globebrowsingmodule.h>
 #include <modules/globebrowsing/src/basictypes.h>
 #include <modules/globebrowsing/src/gpulayergroup.h>
+#include <modules/globebrowsing/src/heightqueryservice.h>
 #include <modules/globebrowsing/src/layer.h>
 #include <modules/globebrowsing/src/layergroup.h>
 #include <modules/globebrowsing/src/renderableglobe.h>
@@ -34,12 +36,18 @@
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
+#include <openspace/engine/moduleengine.h>
+#include <openspace/engine/windowdelegate.h>
 #include <openspace/interaction/sessionrecording.h>
+#include <openspace/navigation/navigationhandler.h>
+#include <openspace/navigation/path.h>
+#include <openspace/navigation/pathnavigator.h>
+#include <openspace/rendering/eclipseshadow.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scenegraphnode.h>
 #include <openspace/scene/scene.h>
 #include <openspace/util/memorymanager.h>
-#include <openspace/util/spicemanager.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/time.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -52,6 +60,7 @@
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
 #include <numeric>
+#include <optional>
 #include <queue>
 #include <vector>
 
@@ -99,6 +108,10 @@ namespace {
     constexpr int UnknownDesiredLevel = -1;
     constexpr int DefaultHeightTileResolution = 512;
 
+    // The minimum number of chunks that are handed to a worker thread as one job when
+    // the chunks are evaluated in parallel. Smaller trees are evaluated in one job
+    constexpr size_t MinChunksPerEvaluationJob = 64;
+
     const openspace::globebrowsing::GeodeticPatch Coverage =
         openspace::globebrowsing::GeodeticPatch(0, 0, 90, 180);
 
@@ -270,6 +283,29 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
+    constexpr openspace::properties::Property::PropertyInfo PrefetchTilesInfo = {
+        "PrefetchTiles",
+        "Prefetch Tiles",
+        "If this value is enabled, the tiles for the locations where the camera will be "
+        "in the near future are requested ahead of time with a low priority, so that "
+        "they are already loaded when the camera arrives. The locations are taken from "
+        "the camera path if one is playing or are extrapolated from the current camera "
+        "velocity otherwise",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo PrefetchLookAheadInfo = {
+        "PrefetchLookAhead",
+        "Prefetch Look Ahead (s)",
+        "The number of seconds that the current camera velocity is extrapolated to find "
+        "the tiles to prefetch. This value is not used while a camera path is playing",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    // The number of positions along the remainder of a camera path for which tiles are
+    // prefetched
+    constexpr int NumberPathPrefetchSamples = 4;
+
     struct [[codegen::Dictionary(RenderableGlobe)]] Parameters {
         // Specifies the radii for this planet. If the Double version of this is used, all
         // three radii are assumed to be equal
@@ -343,6 +379,116 @@ const Chunk& findChunkNode(const Chunk& node, const Geodetic2& location) {
     return *n;
 }
 
+// Samples the height in meters of the \p layer from the tile that is currently loaded by
+// the layer's tile provider
+std::optional<float> sampleHeight(Layer& layer, const HeightQueryService::Query& query) {
+    ZoneScoped;
+
+    TileProvider* tileProvider = layer.tileProvider();
+    const Geodetic2& position = query.position;
+    const TileIndex tileIndex = HeightQueryService::tileIndex(position, query.level);
+    const glm::vec2 patchUV = HeightQueryService::positionInTile(position, tileIndex);
+
+    // Transform the uv coordinates to the current tile texture
+    const ChunkTile chunkTile = tileProvider->chunkTile(tileIndex);
+    const Tile& tile = chunkTile.tile;
+    const TileUvTransform& uvTransform = chunkTile.uvTransform;
+    const TileDepthTransform& depthTransform = tileProvider->depthTransform();
+    if (tile.status != Tile::Status::OK) {
+        return std::nullopt;
+    }
+
+    ghoul::opengl::Texture* tileTexture = tile.texture;
+    if (!tileTexture) {
+        return std::nullopt;
+    }
+
+    glm::vec2 transformedUv = layer.tileUvToTextureSamplePosition(
+        uvTransform,
+        patchUV,
+        glm::uvec2(tileTexture->dimensions())
+    );
+
+    // Sample and do linear interpolation
+    // (could possibly be moved as a function in ghoul texture)
+    // Suggestion: a function in ghoul::opengl::Texture that takes uv coordinates
+    // in range [0,1] and uses the set interpolation method and clamping.
+
+    const glm::uvec3 dimensions = tileTexture->dimensions();
+
+    glm::vec2 samplePos = transformedUv * glm::vec2(dimensions);
+    // @TODO (emmbr, 2023-06-14) This 0.5f offset was added as a bandaid for issue
+    // #2696. It seems to improve the behavior, but I am not certain of why. And the
+    // underlying problem is still there and should at some point be looked at again
+    samplePos -= glm::vec2(0.5f);
+
+    glm::uvec2 samplePos00 = samplePos;
+    samplePos00 = glm::clamp(
+        samplePos00,
+        glm::uvec2(0, 0),
+        glm::uvec2(dimensions) - glm::uvec2(1)
+    );
+    const glm::vec2 samplePosFract = samplePos - glm::vec2(samplePos00);
+
+    const glm::uvec2 samplePos10 = glm::min(
+        samplePos00 + glm::uvec2(1, 0),
+        glm::uvec2(dimensions) - glm::uvec2(1)
+    );
+    const glm::uvec2 samplePos01 = glm::min(
+        samplePos00 + glm::uvec2(0, 1),
+        glm::uvec2(dimensions) - glm::uvec2(1)
+    );
+    const glm::uvec2 samplePos11 = glm::min(
+        samplePos00 + glm::uvec2(1, 1),
+        glm::uvec2(dimensions) - glm::uvec2(1)
+    );
+
+    const float sample00 = tileTexture->texelAsFloat(samplePos00).x;
+    const float sample10 = tileTexture->texelAsFloat(samplePos10).x;
+    const float sample01 = tileTexture->texelAsFloat(samplePos01).x;
+    const float sample11 = tileTexture->texelAsFloat(samplePos11).x;
+
+    // In case the texture has NaN or no data values don't use this height map.
+    const bool anySampleIsNaN =
+        std::isnan(sample00) ||
+        std::isnan(sample01) ||
+        std::isnan(sample10) ||
+        std::isnan(sample11);
+
+    const bool anySampleIsNoData =
+        sample00 == tileProvider->noDataValueAsFloat() ||
+        sample01 == tileProvider->noDataValueAsFloat() ||
+        sample10 == tileProvider->noDataValueAsFloat() ||
+        sample11 == tileProvider->noDataValueAsFloat();
+
+    if (anySampleIsNaN || anySampleIsNoData) {
+        return std::nullopt;
+    }
+
+    const float sample0 = sample00 * (1.f - samplePosFract.x) +
+        sample10 * samplePosFract.x;
+    const float sample1 = sample01 * (1.f - samplePosFract.x) +
+        sample11 * samplePosFract.x;
+
+    const float sample = sample0 * (1.f - samplePosFract.y) +
+        sample1 * samplePosFract.y;
+
+    // Same as is used in the shader. This is not a perfect solution but
+    // if the sample is actually a no-data-value (min_float) the interpolated
+    // value might not be. Therefore we have a cut-off. Assuming no data value
+    // is smaller than -100000
+    if (sample <= -100000) {
+        return std::nullopt;
+    }
+
+    // Perform depth transform to get the value in meters
+    const float height = depthTransform.offset + depthTransform.scale * sample;
+    // Make sure that the height value follows the layer settings.
+    // For example if the multiplier is set to a value bigger than one,
+    // the sampled height should be modified as well.
+    return layer.renderSettings().performLayerSettings(height);
+}
+
 #if defined(__APPLE__) || (defined(__linux__) && defined(__clang__))
 using ChunkTileVector = std::vector<std::pair<ChunkTile, const LayerRenderSettings*>>;
 #else
@@ -567,7 +713,9 @@ RenderableGlobe::RenderableGlobe(const ghoul::Dictionary& dictionary)
         FloatProperty(CurrentLodScaleFactorInfo, 15.f, 1.f, 50.f),
         FloatProperty(OrenNayarRoughnessInfo, 0.f, 0.f, 1.f),
         FloatProperty(AmbientIntensityInfo, 0.05f, 0.f, 1.f),
-        IntProperty(NActiveLayersInfo, 0, 0, OpenGLCap.maxTextureUnits() / 3)
+        IntProperty(NActiveLayersInfo, 0, 0, OpenGLCap.maxTextureUnits() / 3),
+        BoolProperty(PrefetchTilesInfo, true),
+        FloatProperty(PrefetchLookAheadInfo, 3.f, 0.f, 30.f)
     })
     , _debugPropertyOwner({ "Debug" })
     , _shadowMappingPropertyOwner({ "ShadowMapping" })
@@ -579,6 +727,11 @@ RenderableGlobe::RenderableGlobe(const ghoul::Dictionary& dictionary)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
+    GlobeBrowsingModule* module = global::moduleEngine->module<GlobeBrowsingModule>();
+    _heightQueryService = std::make_unique<HeightQueryService>(
+        absPath(fmt::format("{}/heights", module->mrfCacheLocation()))
+    );
+
     _generalProperties.currentLodScaleFactor.setReadOnly(true);
 
     // Read the radii in to its own dictionary
@@ -653,6 +806,8 @@ RenderableGlobe::RenderableGlobe(const ghoul::Dictionary& dictionary)
     addProperty(_generalProperties.ambientIntensity);
     _generalProperties.nActiveLayers.setReadOnly(true);
     addProperty(_generalProperties.nActiveLayers);
+    addProperty(_generalProperties.prefetchTiles);
+    addProperty(_generalProperties.prefetchLookAhead);
 
     _debugPropertyOwner.addProperty(_debugProperties.showChunkEdges);
     _debugPropertyOwner.addProperty(_debugProperties.levelByProjectedAreaElseDistance);
@@ -770,6 +925,10 @@ bool RenderableGlobe::isReady() const {
 }
 
 void RenderableGlobe::render(const RenderData& data, RendererTasks& rendererTask) {
+    // The prefetching has to happen even if the globe is too far away to be rendered, as
+    // the camera might be on its way towards it
+    prefetchTiles(data);
+
     const double distanceToCamera = distance(
         data.camera.positionVec3(),
         data.modelTransform.translation
@@ -786,25 +945,39 @@ void RenderableGlobe::render(const RenderData& data, RendererTasks& rendererTask
     if ((distanceToCamera < distance) || (_generalProperties.renderAtDistance)) {
         try {
             if (_hasShadows && _shadowComponent.isEnabled()) {
-                // Set matrices and other GL states
-                RenderData lightRenderData(_shadowComponent.begin(data));
+                const bool hasVisibleRings = _hasRings &&
+                    _ringsComponent.isEnabled() && _ringsComponent.isVisible();
+
+                // The shadow map is only rendered again if the light moved relative to
+                // the globe or if there is new geometry, such as newly loaded height
+                // tiles, that might cast a different shadow
+                const bool hasChangedGeometry =
+                    !_allChunksAvailable || hasVisibleRings != _shadowMapHasRings;
+                if (_shadowComponent.needsUpdate(
+                        data,
+                        boundingSphere(),
+                        hasChangedGeometry
+                    ))
+                {
+                    // Set matrices and other GL states
+                    RenderData lightRenderData(_shadowComponent.begin(data));
 
-                glDisable(GL_BLEND);
+                    glDisable(GL_BLEND);
 
-                // Render from light source point of view
-                renderChunks(lightRenderData, rendererTask, {}, true);
-                if (_hasRings && _ringsComponent.isEnabled() &&
-                    _ringsComponent.isVisible())
-                {
-                    _ringsComponent.draw(
-                        lightRenderData,
-                        RingsComponent::RenderPass::GeometryOnly
-                    );
-                }
+                    // Render from light source point of view
+                    renderChunks(lightRenderData, rendererTask, {}, true);
+                    if (hasVisibleRings) {
+                        _ringsComponent.draw(
+                            lightRenderData,
+                            RingsComponent::RenderPass::GeometryOnly
+                        );
+                    }
 
-                glEnable(GL_BLEND);
+                    glEnable(GL_BLEND);
 
-                _shadowComponent.end();
+                    _shadowComponent.end();
+                    _shadowMapHasRings = hasVisibleRings;
+                }
 
                 // Render again from original point of view
                 renderChunks(data, rendererTask, _shadowComponent.shadowMapData());
@@ -876,6 +1049,21 @@ void RenderableGlobe::renderSecondary(const RenderData& data, RendererTasks&) {
     }
 }
 
+Renderable::MemoryUsage RenderableGlobe::memoryUsage() const {
+    // The tile textures are owned by the shared tile cache, but each tile provider knows
+    // how much of the cache is occupied by its tiles. Layers that are disabled can still
+    // have tiles in the cache until they are evicted, so all layers are counted
+    MemoryUsage usage;
+    for (const LayerGroup* layerGroup : _layerManager.layerGroups()) {
+        for (const Layer* layer : layerGroup->layers()) {
+            if (layer->tileProvider()) {
+                usage.gpuTextures += layer->tileProvider()->numberOfCachedBytes();
+            }
+        }
+    }
+    return usage;
+}
+
 void RenderableGlobe::update(const UpdateData& data) {
     ZoneScoped;
 
@@ -955,6 +1143,10 @@ void RenderableGlobe::update(const UpdateData& data) {
     //                           // LayerManager hasn't updated yet :o
     _layerManagerDirty = true;
 
+    _heightQueryService->update(
+        _layerManager.layerGroup(layers::Group::ID::HeightLayers).activeLayers()
+    );
+
     _geoJsonManager.update();
 }
 
@@ -1107,13 +1299,16 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
 
     // Calculate the MVP matrix
     const glm::dmat4& viewTransform = data.camera.combinedViewMatrix();
-    const glm::dmat4 vp = glm::dmat4(data.camera.sgctInternal.projectionMatrix()) *
-        viewTransform;
-    const glm::dmat4 mvp = vp * _cachedModelTransform;
+    const glm::dmat4 mvp = glm::dmat4(data.camera.sgctInternal.projectionMatrix()) *
+        data.modelViewTransform;
 
     _allChunksAvailable = true;
-    updateChunkTree(_leftRoot, data, mvp);
-    updateChunkTree(_rightRoot, data, mvp);
+    _chunkEvaluations.clear();
+    gatherChunks(_leftRoot);
+    gatherChunks(_rightRoot);
+    evaluateChunks(data, mvp);
+    updateChunkTree(_leftRoot);
+    updateChunkTree(_rightRoot);
     _chunkCornersDirty = false;
     _iterationsOfAvailableData =
         (_allChunksAvailable ? _iterationsOfAvailableData + 1 : 0);
@@ -1135,7 +1330,7 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
         _globalRenderer.program->setUniform("cameraPosition", glm::vec3(cameraPosition));
     }
 
-    const glm::mat4 modelViewTransform = glm::mat4(viewTransform * _cachedModelTransform);
+    const glm::mat4 modelViewTransform = data.modelViewTransformf();
     const glm::mat4 modelViewProjectionTransform =
         data.camera.sgctInternal.projectionMatrix() * modelViewTransform;
 
@@ -1193,6 +1388,16 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
         data.camera.sgctInternal.projectionMatrix()
     );
 
+    if (hasHeightLayer) {
+        // Apply an extra scaling to the height if the object is scaled
+        _localRenderer.program->setUniform(
+            "heightScale",
+            static_cast<float>(
+                glm::compMax(data.modelTransform.scale) * data.camera.scaling()
+            )
+        );
+    }
+
     if (nightLayersActive || waterLayersActive || _generalProperties.performShading) {
         const glm::dvec3 directionToSunWorldSpace =
             length(data.modelTransform.translation) > 0.0 ?
@@ -1271,20 +1476,55 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
         _traversalMemory
     );
 
-    // Render all chunks that want to be rendered globally
-    _globalRenderer.program->activate();
-    for (int i = 0; i < globalCount; ++i) {
-        renderChunkGlobally(*_globalChunkBuffer[i], data, shadowData, renderGeomOnly);
+    // The state that is shared between all chunks is only set once per program, so
+    // that each chunk only has to bind its tile textures and set its geometry
+    glEnable(GL_DEPTH_TEST);
+    if (!renderGeomOnly) {
+        glEnable(GL_CULL_FACE);
+        glCullFace(GL_BACK);
     }
-    _globalRenderer.program->deactivate();
 
+    // Render all chunks that want to be rendered globally
+    if (globalCount > 0) {
+        _globalRenderer.program->activate();
+        ghoul::opengl::TextureUnit shadowMapUnit;
+        setChunkIndependentState(
+            *_globalRenderer.program,
+            _globalRenderer.gpuLayerGroups,
+            data,
+            shadowData,
+            ShadowCompType::GLOBAL_SHADOW,
+            shadowMapUnit
+        );
+        for (int i = 0; i < globalCount; ++i) {
+            renderChunkGlobally(*_globalChunkBuffer[i], data);
+        }
+        for (GPULayerGroup& l : _globalRenderer.gpuLayerGroups) {
+            l.deactivate();
+        }
+        _globalRenderer.program->deactivate();
+    }
 
     // Render all chunks that need to be rendered locally
-    _localRenderer.program->activate();
-    for (int i = 0; i < localCount; ++i) {
-        renderChunkLocally(*_localChunkBuffer[i], data, shadowData, renderGeomOnly);
+    if (localCount > 0) {
+        _localRenderer.program->activate();
+        ghoul::opengl::TextureUnit shadowMapUnit;
+        setChunkIndependentState(
+            *_localRenderer.program,
+            _localRenderer.gpuLayerGroups,
+            data,
+            shadowData,
+            ShadowCompType::LOCAL_SHADOW,
+            shadowMapUnit
+        );
+        for (int i = 0; i < localCount; ++i) {
+            renderChunkLocally(*_localChunkBuffer[i], data);
+        }
+        for (GPULayerGroup& l : _localRenderer.gpuLayerGroups) {
+            l.deactivate();
+        }
+        _localRenderer.program->deactivate();
     }
-    _localRenderer.program->deactivate();
 
     if (global::sessionRecording->isSavingFramesDuringPlayback() &&
         global::sessionRecording->shouldWaitForTileLoading())
@@ -1317,20 +1557,67 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
     }
 }
 
-void RenderableGlobe::renderChunkGlobally(const Chunk& chunk, const RenderData& data,
+void RenderableGlobe::setChunkIndependentState(ghoul::opengl::ProgramObject& program,
+                  std::array<GPULayerGroup, LayerManager::NumLayerGroups>& gpuLayerGroups,
+                                                                   const RenderData& data,
                                          const ShadowComponent::ShadowMapData& shadowData,
-                                                                      bool renderGeomOnly)
+                                                                ShadowCompType shadowType,
+                                                ghoul::opengl::TextureUnit& shadowMapUnit)
 {
     ZoneScoped;
+
+    const std::array<LayerGroup*, LayerManager::NumLayerGroups>& layerGroups =
+        _layerManager.layerGroups();
+    for (size_t i = 0; i < layerGroups.size(); ++i) {
+        gpuLayerGroups[i].setLayerValues(program, *layerGroups[i]);
+    }
+
+    if (_generalProperties.eclipseShadowsEnabled &&
+        !_ellipsoid.shadowConfigurationArray().empty())
+    {
+        calculateEclipseShadows(program, data, shadowType);
+    }
+
+    // Shadow Mapping
+    if (_generalProperties.shadowMapping && shadowData.shadowDepthTexture != 0) {
+        // Adding the model transformation to the final shadow matrix so we have a
+        // complete transformation from the model coordinates to the clip space of the
+        // light position.
+        program.setUniform(
+            "shadowMatrix",
+            shadowData.shadowMatrix * modelTransform()
+        );
+
+        shadowMapUnit.activate();
+        glBindTexture(GL_TEXTURE_2D, shadowData.shadowDepthTexture);
+
+        program.setUniform("shadowMapTexture", shadowMapUnit);
+        program.setUniform("zFightingPercentage", _generalProperties.zFightingPercentage);
+    }
+    else if (_generalProperties.shadowMapping) {
+        shadowMapUnit.activate();
+        // JCC: Avoiding a to recompiling the shaders or having more than one
+        // set of shaders for this step.
+        glBindTexture(GL_TEXTURE_2D, _shadowComponent.dDepthTexture());
+        program.setUniform("shadowMapTexture", shadowMapUnit);
+    }
+}
+
+void RenderableGlobe::renderChunkGlobally(const Chunk& chunk, const RenderData& data) {
+    ZoneScoped;
     TracyGpuZone("renderChunkGlobally");
 
     const TileIndex& tileIndex = chunk.tileIndex;
     ghoul::opengl::ProgramObject& program = *_globalRenderer.program;
 
-    std::array<LayerGroup*, LayerManager::NumLayerGroups> layerGroups =
+    const std::array<LayerGroup*, LayerManager::NumLayerGroups>& layerGroups =
         _layerManager.layerGroups();
     for (size_t i = 0; i < layerGroups.size(); ++i) {
-        _globalRenderer.gpuLayerGroups[i].setValue(program, *layerGroups[i], tileIndex);
+        _globalRenderer.gpuLayerGroups[i].setChunkValues(
+            program,
+            *layerGroups[i],
+            tileIndex
+        );
     }
 
     // The length of the skirts is proportional to its size
@@ -1363,66 +1650,24 @@ void RenderableGlobe::renderChunkGlobally(const Chunk& chunk, const RenderData&
 
     setCommonUniforms(program, chunk, data);
 
-    if (_generalProperties.eclipseShadowsEnabled &&
-        !_ellipsoid.shadowConfigurationArray().empty())
-    {
-        calculateEclipseShadows(program, data, ShadowCompType::GLOBAL_SHADOW);
-    }
-
-    // Shadow Mapping
-    ghoul::opengl::TextureUnit shadowMapUnit;
-    if (_generalProperties.shadowMapping && shadowData.shadowDepthTexture != 0) {
-        // Adding the model transformation to the final shadow matrix so we have a
-        // complete transformation from the model coordinates to the clip space of the
-        // light position.
-        program.setUniform(
-            "shadowMatrix",
-            shadowData.shadowMatrix * modelTransform()
-        );
-
-        shadowMapUnit.activate();
-        glBindTexture(GL_TEXTURE_2D, shadowData.shadowDepthTexture);
-
-        program.setUniform("shadowMapTexture", shadowMapUnit);
-        program.setUniform("zFightingPercentage", _generalProperties.zFightingPercentage);
-    }
-    else if (_generalProperties.shadowMapping) {
-        shadowMapUnit.activate();
-        // JCC: Avoiding a to recompiling the shaders or having more than one
-        // set of shaders for this step.
-        glBindTexture(GL_TEXTURE_2D, _shadowComponent.dDepthTexture());
-        program.setUniform("shadowMapTexture", shadowMapUnit);
-    }
-
-    glEnable(GL_DEPTH_TEST);
-
-    if (!renderGeomOnly) {
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
-    }
-
     _grid.drawUsingActiveProgram();
-
-    for (GPULayerGroup& l : _globalRenderer.gpuLayerGroups) {
-        l.deactivate();
-    }
 }
 
-void RenderableGlobe::renderChunkLocally(const Chunk& chunk, const RenderData& data,
-                                         const ShadowComponent::ShadowMapData& shadowData,
-                                         bool renderGeomOnly)
-{
+void RenderableGlobe::renderChunkLocally(const Chunk& chunk, const RenderData& data) {
     ZoneScoped;
     TracyGpuZone("renderChunkLocally");
 
-    //PerfMeasure("locally");
     const TileIndex& tileIndex = chunk.tileIndex;
     ghoul::opengl::ProgramObject& program = *_localRenderer.program;
 
     const std::array<LayerGroup*, LayerManager::NumLayerGroups>& layerGroups =
         _layerManager.layerGroups();
     for (size_t i = 0; i < layerGroups.size(); ++i) {
-        _localRenderer.gpuLayerGroups[i].setValue(program, *layerGroups[i], tileIndex);
+        _localRenderer.gpuLayerGroups[i].setChunkValues(
+            program,
+            *layerGroups[i],
+            tileIndex
+        );
     }
 
     // The length of the skirts is proportional to its size
@@ -1442,8 +1687,7 @@ void RenderableGlobe::renderChunkLocally(const Chunk& chunk, const RenderData& d
 
     // Calculate other uniform variables needed for rendering
     // Send the matrix inverse to the fragment for the global and local shader (JCC)
-    const glm::dmat4 viewTransform = data.camera.combinedViewMatrix();
-    const glm::dmat4 modelViewTransform = viewTransform * _cachedModelTransform;
+    const glm::dmat4& modelViewTransform = data.modelViewTransform;
 
     std::array<glm::dvec3, 4> cornersCameraSpace;
     std::array<glm::dvec3, 4> cornersModelSpace;
@@ -1489,61 +1733,9 @@ void RenderableGlobe::renderChunkLocally(const Chunk& chunk, const RenderData& d
         patchNormalCameraSpace
     );
 
-    using namespace layers;
-    if (!_layerManager.layerGroup(Group::ID::HeightLayers).activeLayers().empty()) {
-        // Apply an extra scaling to the height if the object is scaled
-        program.setUniform(
-            "heightScale",
-            static_cast<float>(
-                glm::compMax(data.modelTransform.scale) * data.camera.scaling()
-            )
-        );
-    }
-
     setCommonUniforms(program, chunk, data);
 
-    if (_generalProperties.eclipseShadowsEnabled &&
-        !_ellipsoid.shadowConfigurationArray().empty())
-    {
-        calculateEclipseShadows(program, data, ShadowCompType::LOCAL_SHADOW);
-    }
-
-    // Shadow Mapping
-    ghoul::opengl::TextureUnit shadowMapUnit;
-    if (_generalProperties.shadowMapping && shadowData.shadowDepthTexture != 0) {
-        // Adding the model transformation to the final shadow matrix so we have a
-        // complete transformation from the model coordinates to the clip space of the
-        // light position.
-        program.setUniform(
-            "shadowMatrix",
-            shadowData.shadowMatrix * modelTransform()
-        );
-
-        shadowMapUnit.activate();
-        glBindTexture(GL_TEXTURE_2D, shadowData.shadowDepthTexture);
-
-        program.setUniform("shadowMapTexture", shadowMapUnit);
-        program.setUniform("zFightingPercentage", _generalProperties.zFightingPercentage);
-    }
-    else if (_generalProperties.shadowMapping) {
-        shadowMapUnit.activate();
-        // JCC: Avoiding a to recompiling the shaders or having more than one
-        // set of shaders for this step.
-        glBindTexture(GL_TEXTURE_2D, _shadowComponent.dDepthTexture());
-        program.setUniform("shadowMapTexture", shadowMapUnit);
-    }
-
-    glEnable(GL_DEPTH_TEST);
-    if (!renderGeomOnly) {
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
-    }
-
     _grid.drawUsingActiveProgram();
-
-    for (GPULayerGroup& l : _localRenderer.gpuLayerGroups) {
-        l.deactivate();
-    }
 }
 
 void RenderableGlobe::debugRenderChunk(const Chunk& chunk, const glm::dmat4& mvp,
@@ -1605,9 +1797,7 @@ void RenderableGlobe::setCommonUniforms(ghoul::opengl::ProgramObject& programObj
             chunk.surfacePatch.corner(Quad::NORTH_EAST)
         );
 
-        const glm::mat4 modelViewTransform = glm::mat4(
-            data.camera.combinedViewMatrix() * _cachedModelTransform
-        );
+        const glm::mat4 modelViewTransform = data.modelViewTransformf();
 
         const glm::mat3& modelViewTransformMat3 = glm::mat3(modelViewTransform);
 
@@ -1892,25 +2082,26 @@ SurfacePositionHandle RenderableGlobe::calculateSurfacePositionHandle(
 }
 
 bool RenderableGlobe::testIfCullable(const Chunk& chunk,
-                                     const RenderData& renderData,
+                                     const glm::dvec3& cameraPosition,
                                      const BoundingHeights& heights,
                                      const glm::dmat4& mvp) const
 {
     ZoneScoped;
 
-    return (PreformHorizonCulling && isCullableByHorizon(chunk, renderData, heights)) ||
-           (_debugProperties.performFrustumCulling && isCullableByFrustum(chunk, renderData, mvp));
+    return
+        (PreformHorizonCulling && isCullableByHorizon(chunk, cameraPosition, heights)) ||
+        (_debugProperties.performFrustumCulling && isCullableByFrustum(chunk, mvp));
 }
 
-int RenderableGlobe::desiredLevel(const Chunk& chunk, const RenderData& renderData,
-                                  const BoundingHeights& heights) const
+int RenderableGlobe::desiredLevel(const Chunk& chunk, const glm::dvec3& cameraPosition,
+                                  const BoundingHeights& heights,
+                                  int levelByAvailableData) const
 {
     ZoneScoped;
 
     const int desiredLevel = _debugProperties.levelByProjectedAreaElseDistance ?
-        desiredLevelByProjectedArea(chunk, renderData, heights) :
-        desiredLevelByDistance(chunk, renderData, heights);
-    const int levelByAvailableData = desiredLevelByAvailableTileData(chunk);
+        desiredLevelByProjectedArea(chunk, cameraPosition, heights) :
+        desiredLevelByDistance(chunk, cameraPosition, heights);
 
     if (LimitLevelByAvailableData && (levelByAvailableData != UnknownDesiredLevel)) {
         const int l = glm::min(desiredLevel, levelByAvailableData);
@@ -1922,156 +2113,63 @@ int RenderableGlobe::desiredLevel(const Chunk& chunk, const RenderData& renderDa
 }
 
 float RenderableGlobe::getHeight(const glm::dvec3& position) const {
-    ZoneScoped;
-
-    float height = 0;
-
-    // Get the uv coordinates to sample from
-    const Geodetic2 geodeticPosition = _ellipsoid.cartesianToGeodetic2(position);
-    const Chunk& node = geodeticPosition.lon < Coverage.center().lon ?
-        findChunkNode(_leftRoot, geodeticPosition) :
-        findChunkNode(_rightRoot, geodeticPosition);
-    const int chunkLevel = node.tileIndex.level;
-
-
-    const int numIndicesAtLevel = 1 << chunkLevel;
-    const double u = 0.5 + geodeticPosition.lon / glm::two_pi<double>();
-    const double v = 0.25 - geodeticPosition.lat / glm::two_pi<double>();
-    const double xIndexSpace = u * numIndicesAtLevel;
-    const double yIndexSpace = v * numIndicesAtLevel;
+    float height = 0.f;
+    getHeights(std::span(&position, 1), std::span(&height, 1));
+    return height;
+}
 
-    const int x = static_cast<int>(floor(xIndexSpace));
-    const int y = static_cast<int>(floor(yIndexSpace));
+std::vector<float> RenderableGlobe::heights(
+                                           const std::vector<glm::dvec3>& positions) const
+{
+    std::vector<float> res(positions.size());
+    getHeights(positions, res);
+    return res;
+}
 
-    ghoul_assert(chunkLevel < std::numeric_limits<uint8_t>::max(), "Too high level");
-    const TileIndex tileIndex(x, y, static_cast<uint8_t>(chunkLevel));
-    const GeodeticPatch patch = GeodeticPatch(tileIndex);
+void RenderableGlobe::getHeights(std::span<const glm::dvec3> positions,
+                                 std::span<float> heights) const
+{
+    ZoneScoped;
 
-    const Geodetic2 northEast = patch.corner(Quad::NORTH_EAST);
-    const Geodetic2 southWest = patch.corner(Quad::SOUTH_WEST);
+    ghoul_assert(positions.size() == heights.size(), "Mismatching number of heights");
 
-    const Geodetic2 geoDiffPatch = {
-        .lat = northEast.lat - southWest.lat,
-        .lon = northEast.lon - southWest.lon
-    };
+    std::fill(heights.begin(), heights.end(), 0.f);
 
-    const Geodetic2 geoDiffPoint = {
-        .lat = geodeticPosition.lat - southWest.lat,
-        .lon = geodeticPosition.lon - southWest.lon
-    };
-    const glm::vec2 patchUV = glm::vec2(
-        geoDiffPoint.lon / geoDiffPatch.lon,
-        geoDiffPoint.lat / geoDiffPatch.lat
-    );
+    // The heights are sampled from the tiles at the level of the chunk that is currently
+    // covering each position
+    std::vector<HeightQueryService::Query> queries;
+    queries.reserve(positions.size());
+    for (const glm::dvec3& position : positions) {
+        const Geodetic2 geodeticPosition = _ellipsoid.cartesianToGeodetic2(position);
+        const Chunk& node = geodeticPosition.lon < Coverage.center().lon ?
+            findChunkNode(_leftRoot, geodeticPosition) :
+            findChunkNode(_rightRoot, geodeticPosition);
+        queries.push_back({ geodeticPosition, node.tileIndex.level });
+    }
 
     // Get the tile providers for the height maps
     const std::vector<Layer*>& heightMapLayers =
         _layerManager.layerGroup(layers::Group::ID::HeightLayers).activeLayers();
 
     for (Layer* layer : heightMapLayers) {
-        TileProvider* tileProvider = layer->tileProvider();
-        if (!tileProvider) {
+        if (!layer->tileProvider()) {
             continue;
         }
-        // Transform the uv coordinates to the current tile texture
-        const ChunkTile chunkTile = tileProvider->chunkTile(tileIndex);
-        const Tile& tile = chunkTile.tile;
-        const TileUvTransform& uvTransform = chunkTile.uvTransform;
-        const TileDepthTransform& depthTransform = tileProvider->depthTransform();
-        if (tile.status != Tile::Status::OK) {
-            return 0;
-        }
-
-        ghoul::opengl::Texture* tileTexture = tile.texture;
-        if (!tileTexture) {
-            return 0;
-        }
-
-        glm::vec2 transformedUv = layer->tileUvToTextureSamplePosition(
-            uvTransform,
-            patchUV,
-            glm::uvec2(tileTexture->dimensions())
-        );
-
-        // Sample and do linear interpolation
-        // (could possibly be moved as a function in ghoul texture)
-        // Suggestion: a function in ghoul::opengl::Texture that takes uv coordinates
-        // in range [0,1] and uses the set interpolation method and clamping.
-
-        const glm::uvec3 dimensions = tileTexture->dimensions();
-
-        glm::vec2 samplePos = transformedUv * glm::vec2(dimensions);
-        // @TODO (emmbr, 2023-06-14) This 0.5f offset was added as a bandaid for issue
-        // #2696. It seems to improve the behavior, but I am not certain of why. And the
-        // underlying problem is still there and should at some point be looked at again
-        samplePos -= glm::vec2(0.5f);
-
-        glm::uvec2 samplePos00 = samplePos;
-        samplePos00 = glm::clamp(
-            samplePos00,
-            glm::uvec2(0, 0),
-            glm::uvec2(dimensions) - glm::uvec2(1)
-        );
-        const glm::vec2 samplePosFract = samplePos - glm::vec2(samplePos00);
-
-        const glm::uvec2 samplePos10 = glm::min(
-            samplePos00 + glm::uvec2(1, 0),
-            glm::uvec2(dimensions) - glm::uvec2(1)
-        );
-        const glm::uvec2 samplePos01 = glm::min(
-            samplePos00 + glm::uvec2(0, 1),
-            glm::uvec2(dimensions) - glm::uvec2(1)
-        );
-        const glm::uvec2 samplePos11 = glm::min(
-            samplePos00 + glm::uvec2(1, 1),
-            glm::uvec2(dimensions) - glm::uvec2(1)
-        );
 
-        const float sample00 = tileTexture->texelAsFloat(samplePos00).x;
-        const float sample10 = tileTexture->texelAsFloat(samplePos10).x;
-        const float sample01 = tileTexture->texelAsFloat(samplePos01).x;
-        const float sample11 = tileTexture->texelAsFloat(samplePos11).x;
-
-        // In case the texture has NaN or no data values don't use this height map.
-        const bool anySampleIsNaN =
-            std::isnan(sample00) ||
-            std::isnan(sample01) ||
-            std::isnan(sample10) ||
-            std::isnan(sample11);
-
-        const bool anySampleIsNoData =
-            sample00 == tileProvider->noDataValueAsFloat() ||
-            sample01 == tileProvider->noDataValueAsFloat() ||
-            sample10 == tileProvider->noDataValueAsFloat() ||
-            sample11 == tileProvider->noDataValueAsFloat();
-
-        if (anySampleIsNaN || anySampleIsNoData) {
+        if (HeightQueryService::supportsLayer(*layer)) {
+            _heightQueryService->sample(*layer, queries, heights);
             continue;
         }
 
-        const float sample0 = sample00 * (1.f - samplePosFract.x) +
-            sample10 * samplePosFract.x;
-        const float sample1 = sample01 * (1.f - samplePosFract.x) +
-            sample11 * samplePosFract.x;
-
-        const float sample = sample0 * (1.f - samplePosFract.y) +
-            sample1 * samplePosFract.y;
-
-        // Same as is used in the shader. This is not a perfect solution but
-        // if the sample is actually a no-data-value (min_float) the interpolated
-        // value might not be. Therefore we have a cut-off. Assuming no data value
-        // is smaller than -100000
-        if (sample > -100000) {
-            // Perform depth transform to get the value in meters
-            height = depthTransform.offset + depthTransform.scale * sample;
-            // Make sure that the height value follows the layer settings.
-            // For example if the multiplier is set to a value bigger than one,
-            // the sampled height should be modified as well.
-            height = layer->renderSettings().performLayerSettings(height);
+        // The tiles of all other layers might change over time, so they are sampled
+        // directly from the tiles that are currently loaded
+        for (size_t i = 0; i < queries.size(); i++) {
+            const std::optional<float> height = sampleHeight(*layer, queries[i]);
+            if (height.has_value()) {
+                heights[i] = *height;
+            }
         }
     }
-    // Return the result
-    return height;
 }
 
 void RenderableGlobe::calculateEclipseShadows(ghoul::opengl::ProgramObject& programObject,
@@ -2085,43 +2183,21 @@ void RenderableGlobe::calculateEclipseShadows(ghoul::opengl::ProgramObject& prog
         !_ellipsoid.shadowConfigurationArray().empty(),
         "Needs to have eclipse shadows enabled"
     );
-    // Shadow calculations..
-    std::vector<ShadowRenderingStruct> shadowDataArray;
-    std::vector<Ellipsoid::ShadowConfiguration> shadowConfArray =
+    // The shadow cones only depend on the source and caster and are shared with all
+    // other receivers of the frame, only the test whether this globe is inside is local
+    const std::vector<Ellipsoid::ShadowConfiguration>& shadowConfArray =
         _ellipsoid.shadowConfigurationArray();
+    std::vector<ShadowRenderingStruct> shadowDataArray;
     shadowDataArray.reserve(shadowConfArray.size());
-    double lt;
-    for (const auto& shadowConf : shadowConfArray) {
-        // TO REMEMBER: all distances and lengths in world coordinates are in
-        // meters!!! We need to move this to view space...
-        // Getting source and caster:
-        glm::dvec3 sourcePos = SpiceManager::ref().targetPosition(
+    for (const Ellipsoid::ShadowConfiguration& shadowConf : shadowConfArray) {
+        std::optional<EclipseShadow> shadow = eclipseShadow(
             shadowConf.source.first,
-            "SSB",
-            "GALACTIC",
-            {},
-            data.time.j2000Seconds(),
-            lt
-        );
-        sourcePos *= KM_TO_M; // converting to meters
-        glm::dvec3 casterPos = SpiceManager::ref().targetPosition(
+            shadowConf.source.second,
             shadowConf.caster.first,
-            "SSB",
-            "GALACTIC",
-            {},
-            data.time.j2000Seconds(),
-            lt
+            shadowConf.caster.second,
+            data.time.j2000Seconds()
         );
-        casterPos *= KM_TO_M; // converting to meters
-
-        const std::string source = shadowConf.source.first;
-        SceneGraphNode* sourceNode =
-            global::renderEngine->scene()->sceneGraphNode(source);
-        const std::string caster = shadowConf.caster.first;
-        SceneGraphNode* casterNode =
-            global::renderEngine->scene()->sceneGraphNode(caster);
-
-        if ((sourceNode == nullptr) || (casterNode == nullptr)) {
+        if (!shadow.has_value()) {
             LERRORC(
                 "Renderableglobe",
                 "Invalid scenegraph node for the shadow's caster or shadow's receiver"
@@ -2129,66 +2205,23 @@ void RenderableGlobe::calculateEclipseShadows(ghoul::opengl::ProgramObject& prog
             return;
         }
 
-        const double sourceRadiusScale = std::max(
-            glm::compMax(sourceNode->scale()),
-            1.0
-        );
-
-        const double casterRadiusScale = std::max(
-            glm::compMax(casterNode->scale()),
-            1.0
-        );
-
-        // First we determine if the caster is shadowing the current planet (all
-        // calculations in World Coordinates):
-        const glm::dvec3 planetCasterVec = casterPos - data.modelTransform.translation;
-        const glm::dvec3 sourceCasterVec = casterPos - sourcePos;
-
-        const double sc_length = glm::length(sourceCasterVec);
-        const glm::dvec3 planetCaster_proj =
-            (glm::dot(planetCasterVec, sourceCasterVec) / (sc_length*sc_length)) *
-            sourceCasterVec;
-
-        const double d_test  = glm::length(planetCasterVec - planetCaster_proj);
-        const double xp_test = shadowConf.caster.second * casterRadiusScale *
-                sc_length / (shadowConf.source.second * sourceRadiusScale +
-                             shadowConf.caster.second * casterRadiusScale);
-        const double rp_test = shadowConf.caster.second * casterRadiusScale *
-            (glm::length(planetCaster_proj) + xp_test) / xp_test;
-
-        const glm::dvec3 sunPos = SpiceManager::ref().targetPosition(
-            "SUN",
-            "SSB",
-            "GALACTIC",
-            {},
-            data.time.j2000Seconds(),
-            lt
-        );
-        const double casterDistSun = glm::length(casterPos - sunPos);
-        const double planetDistSun =
-            glm::length(data.modelTransform.translation - sunPos);
-
         ShadowRenderingStruct shadowData;
         shadowData.isShadowing = false;
 
-        // Eclipse shadows considers planets and moons as spheres
-        if (((d_test - rp_test) < (_ellipsoid.radii().x * KM_TO_M)) &&
-            (casterDistSun < planetDistSun))
-        {
+        const double radius = _ellipsoid.radii().x * KM_TO_M;
+        if (shadow->isShadowing(data.modelTransform.translation, radius)) {
             // The current caster is shadowing the current planet
             shadowData.isShadowing       = true;
-            shadowData.rs                = shadowConf.source.second * sourceRadiusScale;
-            shadowData.rc                = shadowConf.caster.second * casterRadiusScale;
-            shadowData.sourceCasterVec   = glm::normalize(sourceCasterVec);
-            shadowData.xp                = xp_test;
-            shadowData.xu                = shadowData.rc * sc_length /
-                                          (shadowData.rs - shadowData.rc);
-            shadowData.casterPositionVec = casterPos;
+            shadowData.rs                = shadow->radiusSource;
+            shadowData.rc                = shadow->radiusCaster;
+            shadowData.sourceCasterVec   = glm::normalize(shadow->sourceCasterVec);
+            shadowData.xp                = shadow->penumbra;
+            shadowData.xu                = shadow->umbra;
+            shadowData.casterPositionVec = shadow->casterPosition;
         }
         shadowDataArray.push_back(shadowData);
     }
 
-    const std::string uniformVarName("shadowDataArray[");
     unsigned int counter = 0;
     for (const ShadowRenderingStruct& sd : shadowDataArray) {
         constexpr std::string_view NameIsShadowing = "shadowDataArray[{}].isShadowing";
@@ -2237,17 +2270,12 @@ void RenderableGlobe::calculateEclipseShadows(ghoul::opengl::ProgramObject& prog
 //////////////////////////////////////////////////////////////////////////////////////////
 
 int RenderableGlobe::desiredLevelByDistance(const Chunk& chunk,
-                                            const RenderData& data,
+                                            const glm::dvec3& cameraPosition,
                                             const BoundingHeights& heights) const
 {
     ZoneScoped;
 
-    // Calculations are done in the reference frame of the globe
-    // (model space). Hence, the camera position needs to be transformed
-    // with the inverse model matrix
-    const glm::dvec3 cameraPosition = glm::dvec3(_cachedInverseModelTransform *
-        glm::dvec4(data.camera.positionVec3(), 1.0));
-
+    // Calculations are done in the reference frame of the globe (model space)
     const Geodetic2 pointOnPatch = chunk.surfacePatch.closestPoint(
         _ellipsoid.cartesianToGeodetic2(cameraPosition)
     );
@@ -2273,17 +2301,12 @@ int RenderableGlobe::desiredLevelByDistance(const Chunk& chunk,
 }
 
 int RenderableGlobe::desiredLevelByProjectedArea(const Chunk& chunk,
-                                                 const RenderData& data,
+                                                 const glm::dvec3& cameraPosition,
                                                  const BoundingHeights& heights) const
 {
     ZoneScoped;
 
-    // Calculations are done in the reference frame of the globe
-    // (model space). Hence, the camera position needs to be transformed
-    // with the inverse model matrix
-    const glm::dvec3 cameraPosition = glm::dvec3(
-        _cachedInverseModelTransform * glm::dvec4(data.camera.positionVec3(), 1.0)
-    );
+    // Calculations are done in the reference frame of the globe (model space)
 
     // Approach:
     // The projected area of the chunk will be calculated based on a small area that
@@ -2377,47 +2400,145 @@ int RenderableGlobe::desiredLevelByAvailableTileData(const Chunk& chunk) const {
     return currLevel - 1;
 }
 
+void RenderableGlobe::prefetchTiles(const RenderData& data) {
+    ZoneScoped;
+
+    // Calculations are done in the model space of the globe, which also accounts for the
+    // rotation of the globe when extrapolating the camera position
+    const glm::dvec3 cameraPosition = glm::dvec3(_cachedInverseModelTransform *
+        glm::dvec4(data.camera.positionVec3(), 1.0));
+    const std::optional<glm::dvec3> previousPosition = _previousCameraPosition;
+    _previousCameraPosition = cameraPosition;
+
+    if (!_generalProperties.prefetchTiles) {
+        return;
+    }
+
+    std::vector<glm::dvec3> positions;
+    const interaction::PathNavigator& navigator =
+        global::navigationHandler->pathNavigator();
+    if (navigator.isPlayingPath() && navigator.currentPath()) {
+        // The end of the path is included, as that is typically where the camera is
+        // closest to the surface and needs the highest resolution tiles
+        const interaction::Path& path = *navigator.currentPath();
+        const double traveled = path.traveledDistance();
+        const double remaining = path.pathLength() - traveled;
+        for (int i = 1; i <= NumberPathPrefetchSamples; i++) {
+            const double distance = traveled + remaining * i / NumberPathPrefetchSamples;
+            const glm::dvec3 p = path.interpolatedPose(distance).position;
+            positions.push_back(
+                glm::dvec3(_cachedInverseModelTransform * glm::dvec4(p, 1.0))
+            );
+        }
+    }
+    else if (previousPosition.has_value()) {
+        const double dt = global::windowDelegate->deltaTime();
+        const double lookAhead = _generalProperties.prefetchLookAhead;
+        if (dt > 0.0 && lookAhead > 0.0 && cameraPosition != *previousPosition) {
+            const glm::dvec3 velocity = (cameraPosition - *previousPosition) / dt;
+            positions.push_back(cameraPosition + velocity * lookAhead);
+        }
+    }
+
+    const double scaleFactor = _generalProperties.currentLodScaleFactor *
+        _ellipsoid.minimumRadius();
+    for (const glm::dvec3& position : positions) {
+        const Geodetic2 geodetic = _ellipsoid.cartesianToGeodetic2(position);
+        const glm::dvec3 surface = _ellipsoid.cartesianSurfacePosition(geodetic);
+        const double altitude = std::max(glm::distance(position, surface), 1.0);
+
+        // This matches the distance based level of the chunk right below the position
+        const int level = glm::clamp(
+            static_cast<int>(ceil(log2(scaleFactor / altitude))),
+            MinSplitDepth,
+            MaxSplitDepth
+        );
+        if (level == MinSplitDepth) {
+            // The position is far away from this globe and the lowest levels are always
+            // loaded anyway
+            continue;
+        }
+
+        const int nIndices = 1 << level;
+        const double u = 0.5 + geodetic.lon / glm::two_pi<double>();
+        const double v = 0.25 - geodetic.lat / glm::two_pi<double>();
+        const int x = static_cast<int>(floor(u * nIndices));
+        const int y = static_cast<int>(floor(v * nIndices));
+
+        // Prefetch the tile below the position and its neighbors, wrapping around in
+        // longitude. There are half as many tiles in latitude as in longitude
+        for (int dy = -1; dy <= 1; dy++) {
+            const int ty = y + dy;
+            if (ty < 0 || ty >= nIndices / 2) {
+                continue;
+            }
+            for (int dx = -1; dx <= 1; dx++) {
+                const int tx = (x + dx + nIndices) % nIndices;
+                const TileIndex tileIndex(tx, ty, static_cast<uint8_t>(level));
+
+                for (const layers::Group& gi : layers::Groups) {
+                    const LayerGroup& group = _layerManager.layerGroup(gi.id);
+                    for (Layer* layer : group.activeLayers()) {
+                        TileProvider* provider = layer->tileProvider();
+                        if (provider) {
+                            provider->prefetch(tileIndex);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //  Culling
 //////////////////////////////////////////////////////////////////////////////////////////
 
 bool RenderableGlobe::isCullableByFrustum(const Chunk& chunk,
-                                          const RenderData&,
                                           const glm::dmat4& mvp) const
 {
     ZoneScoped;
 
     const std::array<glm::dvec4, 8>& corners = chunk.corners;
 
+    // The corners are transformed into a structure of arrays with one fixed-length
+    // loop per step, all of which the compiler can vectorize across the corners
+    std::array<double, 8> x;
+    std::array<double, 8> y;
+    std::array<double, 8> z;
+    std::array<double, 8> invW;
+    for (size_t i = 0; i < 8; ++i) {
+        const glm::dvec4& c = corners[i];
+        x[i] = mvp[0][0] * c.x + mvp[1][0] * c.y + mvp[2][0] * c.z + mvp[3][0] * c.w;
+        y[i] = mvp[0][1] * c.x + mvp[1][1] * c.y + mvp[2][1] * c.z + mvp[3][1] * c.w;
+        z[i] = mvp[0][2] * c.x + mvp[1][2] * c.y + mvp[2][2] * c.z + mvp[3][2] * c.w;
+        invW[i] = 1.0 / std::abs(
+            mvp[0][3] * c.x + mvp[1][3] * c.y + mvp[2][3] * c.z + mvp[3][3] * c.w
+        );
+    }
+
     // Create a bounding box that fits the patch corners
     AABB3 bounds; // in screen space
     for (size_t i = 0; i < 8; ++i) {
-        const glm::dvec4 cornerClippingSpace = mvp * corners[i];
-        const glm::dvec3 ndc = glm::dvec3(
-            (1.f / glm::abs(cornerClippingSpace.w)) * cornerClippingSpace
-        );
-        expand(bounds, ndc);
+        expand(bounds, glm::vec3(x[i] * invW[i], y[i] * invW[i], z[i] * invW[i]));
     }
 
     return !(intersects(CullingFrustum, bounds));
 }
 
 bool RenderableGlobe::isCullableByHorizon(const Chunk& chunk,
-                                          const RenderData& renderData,
+                                          const glm::dvec3& cameraPosition,
                                           const BoundingHeights& heights) const
 {
     ZoneScoped;
 
-    // Calculations are done in the reference frame of the globe. Hence, the camera
-    // position needs to be transformed with the inverse model matrix
+    // Calculations are done in the reference frame of the globe (model space)
     const GeodeticPatch& patch = chunk.surfacePatch;
     const float maxHeight = heights.max;
     const glm::dvec3 globePos = glm::dvec3(0.0, 0.0, 0.0); // In model space it is 0
     const double minimumGlobeRadius = _ellipsoid.minimumRadius();
 
-    const glm::dvec3 cameraPos = glm::dvec3(
-        _cachedInverseModelTransform * glm::dvec4(renderData.camera.positionVec3(), 1.0)
-    );
+    const glm::dvec3& cameraPos = cameraPosition;
 
     const glm::dvec3 globeToCamera = cameraPos;
 
@@ -2530,11 +2651,101 @@ void RenderableGlobe::mergeChunkNode(Chunk& cn) {
     cn.children.fill(nullptr);
 }
 
-bool RenderableGlobe::updateChunkTree(Chunk& cn, const RenderData& data,
-                                      const glm::dmat4& mvp)
+void RenderableGlobe::gatherChunks(Chunk& cn) {
+    ZoneScoped;
+
+    // The children are gathered before their parent, which keeps the order in which
+    // the tiles are requested from the tile providers
+    if (!isLeaf(cn)) {
+        for (Chunk* child : cn.children) {
+            gatherChunks(*child);
+        }
+    }
+
+    ChunkEvaluation evaluation;
+    evaluation.chunk = &cn;
+    evaluation.heights = boundingHeightsForChunk(cn, _layerManager);
+    evaluation.levelByAvailableData = desiredLevelByAvailableTileData(cn);
+    cn.heightTileOK = evaluation.heights.tileOK;
+    cn.colorTileOK = colorAvailableForChunk(cn, _layerManager);
+
+    if (_chunkCornersDirty) {
+        cn.corners = boundingCornersForChunk(cn, _ellipsoid, evaluation.heights);
+
+        // The flag gets set to false globally after the updateChunkTree calls
+    }
+
+    _chunkEvaluations.push_back(evaluation);
+}
+
+void RenderableGlobe::evaluateChunks(const RenderData& data, const glm::dmat4& mvp) {
+    ZoneScoped;
+
+    // Calculations are done in the reference frame of the globe. Hence, the camera
+    // position needs to be transformed with the inverse model matrix
+    const glm::dvec3 cameraPosition = glm::dvec3(
+        _cachedInverseModelTransform * glm::dvec4(data.camera.positionVec3(), 1.0)
+    );
+
+    auto evaluateRange = [this, &cameraPosition, &mvp](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            evaluateChunk(_chunkEvaluations[i], cameraPosition, mvp);
+        }
+    };
+
+    ThreadPool* pool =
+        global::moduleEngine->module<GlobeBrowsingModule>()->chunkUpdateThreadPool();
+    if (!pool || _chunkEvaluations.size() < 2 * MinChunksPerEvaluationJob) {
+        evaluateRange(0, _chunkEvaluations.size());
+        return;
+    }
+
+    const size_t nWorkers = pool->numberOfThreads() + 1;
+    const size_t jobSize = std::max(
+        MinChunksPerEvaluationJob,
+        (_chunkEvaluations.size() + nWorkers - 1) / nWorkers
+    );
+    pool->parallelFor(0, _chunkEvaluations.size(), jobSize, evaluateRange);
+}
+
+void RenderableGlobe::evaluateChunk(ChunkEvaluation& evaluation,
+                                    const glm::dvec3& cameraPosition,
+                                    const glm::dmat4& mvp) const
 {
     ZoneScoped;
 
+    Chunk& chunk = *evaluation.chunk;
+    const BoundingHeights& heights = evaluation.heights;
+
+    if (testIfCullable(chunk, cameraPosition, heights, mvp)) {
+        chunk.isVisible = false;
+        chunk.status = Chunk::Status::WantMerge;
+    }
+    else {
+        chunk.isVisible = true;
+    }
+
+    const int dl = desiredLevel(
+        chunk,
+        cameraPosition,
+        heights,
+        evaluation.levelByAvailableData
+    );
+
+    if (dl < chunk.tileIndex.level) {
+        chunk.status = Chunk::Status::WantMerge;
+    }
+    else if (chunk.tileIndex.level < dl) {
+        chunk.status = Chunk::Status::WantSplit;
+    }
+    else {
+        chunk.status = Chunk::Status::DoNothing;
+    }
+}
+
+bool RenderableGlobe::updateChunkTree(Chunk& cn) {
+    ZoneScoped;
+
     // abock:  I tried turning this into a queue and use iteration, rather than recursion
     //         but that made the code harder to understand as the breadth-first traversal
     //         requires parents to be passed through the pipe twice (first to add the
@@ -2542,7 +2753,6 @@ bool RenderableGlobe::updateChunkTree(Chunk& cn, const RenderData& data,
     //         In addition, this didn't even improve performance ---  2018-10-04
     if (isLeaf(cn)) {
         ZoneScopedN("leaf");
-        updateChunk(cn, data, mvp);
 
         if (cn.status == Chunk::Status::WantSplit) {
             splitChunkNode(cn, 1);
@@ -2558,13 +2768,12 @@ bool RenderableGlobe::updateChunkTree(Chunk& cn, const RenderData& data,
         ZoneScopedN("!leaf");
         char requestedMergeMask = 0;
         for (int i = 0; i < 4; ++i) {
-            if (updateChunkTree(*cn.children[i], data, mvp)) {
+            if (updateChunkTree(*cn.children[i])) {
                 requestedMergeMask |= (1 << i);
             }
         }
 
         const bool allChildrenWantsMerge = requestedMergeMask == 0xf;
-        updateChunk(cn, data, mvp);
 
         if (allChildrenWantsMerge && (cn.status != Chunk::Status::WantSplit)) {
             mergeChunkNode(cn);
@@ -2580,40 +2789,4 @@ bool RenderableGlobe::updateChunkTree(Chunk& cn, const RenderData& data,
     }
 }
 
-void RenderableGlobe::updateChunk(Chunk& chunk, const RenderData& data,
-                                  const glm::dmat4& mvp) const
-{
-    ZoneScoped;
-
-    const BoundingHeights& heights = boundingHeightsForChunk(chunk, _layerManager);
-    chunk.heightTileOK = heights.tileOK;
-    chunk.colorTileOK = colorAvailableForChunk(chunk, _layerManager);
-
-    if (_chunkCornersDirty) {
-        chunk.corners = boundingCornersForChunk(chunk, _ellipsoid, heights);
-
-        // The flag gets set to false globally after the updateChunkTree calls
-    }
-
-    if (testIfCullable(chunk, data, heights, mvp)) {
-        chunk.isVisible = false;
-        chunk.status = Chunk::Status::WantMerge;
-    }
-    else {
-        chunk.isVisible = true;
-    }
-
-    const int dl = desiredLevel(chunk, data, heights);
-
-    if (dl < chunk.tileIndex.level) {
-        chunk.status = Chunk::Status::WantMerge;
-    }
-    else if (chunk.tileIndex.level < dl) {
-        chunk.status = Chunk::Status::WantSplit;
-    }
-    else {
-        chunk.status = Chunk::Status::DoNothing;
-    }
-}
-
 } // namespace openspace::globebrowsing
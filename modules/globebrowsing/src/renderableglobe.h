@@ -32,6 +32,7 @@
 #include <modules/globebrowsing/src/geojson/geojsonmanager.h>
 #include <modules/globebrowsing/src/globelabelscomponent.h>
 #include <modules/globebrowsing/src/gpulayergroup.h>
+#include <modules/globebrowsing/src/heightqueryservice.h>
 #include <modules/globebrowsing/src/layermanager.h>
 #include <modules/globebrowsing/src/ringscomponent.h>
 #include <modules/globebrowsing/src/shadowcomponent.h>
@@ -43,6 +44,9 @@
 #include <ghoul/misc/memorypool.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
 
 namespace openspace::documentation { struct Documentation; }
 
@@ -106,12 +110,23 @@ public:
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void renderSecondary(const RenderData& data, RendererTasks&) override;
     void update(const UpdateData& data) override;
+    MemoryUsage memoryUsage() const override;
 
     SurfacePositionHandle calculateSurfacePositionHandle(
         const glm::dvec3& targetModelSpace) const override;
 
     bool renderedWithDesiredData() const override;
 
+    /**
+     * Calculates the heights of the height mapped surface above the reference ellipsoid
+     * for all \p positions, which must be in cartesian model space. The result is the
+     * same as the `heightToSurface` of `calculateSurfacePositionHandle` for each of the
+     * positions, but the lookup of the layers is only done once for all positions.
+     * Positions for which no height tile is loaded yet use the most detailed tile that
+     * is available instead of waiting for the tile.
+     */
+    std::vector<float> heights(const std::vector<glm::dvec3>& positions) const;
+
     const Ellipsoid& ellipsoid() const;
     const LayerManager& layerManager() const;
     LayerManager& layerManager();
@@ -149,20 +164,33 @@ private:
         properties::FloatProperty orenNayarRoughness;
         properties::FloatProperty ambientIntensity;
         properties::IntProperty   nActiveLayers;
+        properties::BoolProperty  prefetchTiles;
+        properties::FloatProperty prefetchLookAhead;
     } _generalProperties;
 
     properties::PropertyOwner _debugPropertyOwner;
 
     properties::PropertyOwner _shadowMappingPropertyOwner;
 
+    /**
+     * The state of a chunk that is gathered from the tile providers on the main thread
+     * before the chunk is evaluated, potentially on a different thread.
+     */
+    struct ChunkEvaluation {
+        Chunk* chunk = nullptr;
+        BoundingHeights heights;
+        int levelByAvailableData = 0;
+    };
+
     /**
      * Test if a specific chunk can safely be culled without affecting the rendered
      * image.
      *
      * Goes through all available `ChunkCuller`s and check if any of them
-     * allows culling of the `Chunk`s in question.
+     * allows culling of the `Chunk`s in question. The \p cameraPosition is provided in
+     * model space.
      */
-    bool testIfCullable(const Chunk& chunk, const RenderData& renderData,
+    bool testIfCullable(const Chunk& chunk, const glm::dvec3& cameraPosition,
         const BoundingHeights& heights, const glm::dmat4& mvp) const;
 
     /**
@@ -173,10 +201,11 @@ private:
      * lower than the current level of the `Chunks`s
      * `TileIndex`. If the desired level is higher than that of the
      * `Chunk`, it wants to split. If it is lower, it wants to merge with
-     * its siblings.
+     * its siblings. The \p levelByAvailableData is the result of
+     * desiredLevelByAvailableTileData, which has to be called on the main thread.
      */
-    int desiredLevel(const Chunk& chunk, const RenderData& renderData,
-        const BoundingHeights& heights) const;
+    int desiredLevel(const Chunk& chunk, const glm::dvec3& cameraPosition,
+        const BoundingHeights& heights, int levelByAvailableData) const;
 
     /**
      * Calculates the height from the surface of the reference ellipsoid to the
@@ -191,6 +220,13 @@ private:
      */
     float getHeight(const glm::dvec3& position) const;
 
+    /**
+     * Calculates the heights of all \p positions in the same way as `getHeight` and
+     * stores them in \p heights, which must have the same size as \p positions.
+     */
+    void getHeights(std::span<const glm::dvec3> positions,
+        std::span<float> heights) const;
+
     void renderChunks(const RenderData& data, RendererTasks& rendererTask,
         const ShadowComponent::ShadowMapData& shadowData = {}, bool renderGeomOnly = false
     );
@@ -203,9 +239,7 @@ private:
      * point precision by doing this which means that the camera too close to a global
      * tile will lead to jagging. We only render global chunks for lower chunk levels.
      */
-    void renderChunkGlobally(const Chunk& chunk, const RenderData& data,
-        const ShadowComponent::ShadowMapData& shadowData = {}, bool renderGeomOnly = false
-    );
+    void renderChunkGlobally(const Chunk& chunk, const RenderData& data);
 
     /**
      * Local rendering of chunks are done using linear interpolation in camera space.
@@ -218,24 +252,41 @@ private:
      * levels) the better the approximation becomes. This is why we only render local
      * chunks for higher chunk levels.
      */
-    void renderChunkLocally(const Chunk& chunk, const RenderData& data,
-        const ShadowComponent::ShadowMapData& shadowData = {}, bool renderGeomOnly = false
-    );
+    void renderChunkLocally(const Chunk& chunk, const RenderData& data);
+
+    /**
+     * Sets all state of the \p program that is shared between all chunks that are
+     * rendered with it, such as the layer settings, the eclipse shadows, and the shadow
+     * map, which is bound to the \p shadowMapUnit. This has to be called once before the
+     * chunks are rendered with renderChunkGlobally or renderChunkLocally. Afterwards,
+     * the \p gpuLayerGroups have to be deactivated.
+     */
+    void setChunkIndependentState(ghoul::opengl::ProgramObject& program,
+        std::array<GPULayerGroup, LayerManager::NumLayerGroups>& gpuLayerGroups,
+        const RenderData& data, const ShadowComponent::ShadowMapData& shadowData,
+        ShadowCompType shadowType, ghoul::opengl::TextureUnit& shadowMapUnit);
 
     void debugRenderChunk(const Chunk& chunk, const glm::dmat4& mvp,
         bool renderBounds) const;
 
-    bool isCullableByFrustum(const Chunk& chunk, const RenderData& renderData,
-        const glm::dmat4& mvp) const;
-    bool isCullableByHorizon(const Chunk& chunk, const RenderData& renderData,
+    bool isCullableByFrustum(const Chunk& chunk, const glm::dmat4& mvp) const;
+    bool isCullableByHorizon(const Chunk& chunk, const glm::dvec3& cameraPosition,
         const BoundingHeights& heights) const;
 
-    int desiredLevelByDistance(const Chunk& chunk, const RenderData& data,
+    int desiredLevelByDistance(const Chunk& chunk, const glm::dvec3& cameraPosition,
         const BoundingHeights& heights) const;
-    int desiredLevelByProjectedArea(const Chunk& chunk, const RenderData& data,
+    int desiredLevelByProjectedArea(const Chunk& chunk, const glm::dvec3& cameraPosition,
         const BoundingHeights& heights) const;
     int desiredLevelByAvailableTileData(const Chunk& chunk) const;
 
+    /**
+     * Requests the tiles around the positions where the camera is expected to be in the
+     * near future with a low priority, so that they are already loaded once the camera
+     * arrives. If a camera path is playing, the remainder of the path is sampled.
+     * Otherwise, the current velocity of the camera is extrapolated.
+     */
+    void prefetchTiles(const RenderData& data);
+
 
     void calculateEclipseShadows(ghoul::opengl::ProgramObject& programObject,
         const RenderData& data, ShadowCompType stype);
@@ -249,13 +300,26 @@ private:
 
     void splitChunkNode(Chunk& cn, int depth);
     void mergeChunkNode(Chunk& cn);
-    bool updateChunkTree(Chunk& cn, const RenderData& data, const glm::dmat4& mvp);
-    void updateChunk(Chunk& chunk, const RenderData& data, const glm::dmat4& mvp) const;
+
+    /**
+     * The chunk tree is updated in three steps. First, all chunks are collected in
+     * gatherChunks together with the information from the tile providers, which are
+     * not thread-safe. Then evaluateChunks performs the culling and level-of-detail
+     * selection for all collected chunks, which only depends on the chunk itself and is
+     * distributed across the module's chunk update thread pool. Lastly,
+     * updateChunkTree splits and merges the chunks according to their evaluation.
+     */
+    void gatherChunks(Chunk& cn);
+    void evaluateChunks(const RenderData& data, const glm::dmat4& mvp);
+    void evaluateChunk(ChunkEvaluation& evaluation, const glm::dvec3& cameraPosition,
+        const glm::dmat4& mvp) const;
+    bool updateChunkTree(Chunk& cn);
     void freeChunkNode(Chunk* n);
 
     Ellipsoid _ellipsoid;
     SkirtedGrid _grid;
     LayerManager _layerManager;
+    std::unique_ptr<HeightQueryService> _heightQueryService;
 
     GeoJsonManager _geoJsonManager;
 
@@ -267,6 +331,7 @@ private:
     std::vector<const Chunk*> _globalChunkBuffer;
     std::vector<const Chunk*> _localChunkBuffer;
     std::vector<const Chunk*> _traversalMemory;
+    std::vector<ChunkEvaluation> _chunkEvaluations;
 
 
     Chunk _leftRoot;  // Covers all negative longitudes
@@ -296,6 +361,8 @@ private:
     bool _nLayersIsDirty = true;
     bool _allChunksAvailable = true;
     bool _layerManagerDirty = true;
+    // The camera position of the previous frame in model space, used for prefetching
+    std::optional<glm::dvec3> _previousCameraPosition;
     size_t _iterationsOfAvailableData = 0;
     size_t _iterationsOfUnavailableData = 0;
     Layer* _lastChangedLayer = nullptr;
@@ -305,6 +372,8 @@ private:
     ShadowComponent _shadowComponent;
     bool _hasRings = false;
     bool _hasShadows = false;
+    // Whether the rings were drawn into the currently cached shadow map
+    bool _shadowMapHasRings = false;
 
     // Labels
     GlobeLabelsComponent _globeLabelsComponent;
@@ -34,6 +34,7 @@
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scene.h>
+#include <openspace/scene/worldtransformcache.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
@@ -47,6 +48,7 @@
 #include <ghoul/font/fontmanager.h>
 #include <ghoul/font/fontrenderer.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <array>
 #include <fstream>
 #include <cstdlib>
 #include <locale>
@@ -86,6 +88,16 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo UpdateThresholdInfo = {
+        "UpdateThreshold",
+        "Update Threshold",
+        "The distance in texels that any point of the globe may move in the shadow map, "
+        "due to changes in the light direction or the globe's transformation, before the "
+        "shadow map is rendered again. A value of 0 renders the shadow map every frame",
+        // @VISIBILITY(3.67)
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr GLfloat ShadowBorder[] = { 1.f, 1.f, 1.f, 1.f };
 
     void checkFrameBufferState(const std::string& codePosition) {
@@ -157,6 +169,9 @@ namespace {
 
         // [[codegen::verbatim(DepthMapSizeInfo.description)]]
         std::optional<glm::ivec2> depthMapSize;
+
+        // [[codegen::verbatim(UpdateThresholdInfo.description)]]
+        std::optional<float> updateThreshold [[codegen::greaterequal(0.f)]];
     };
 #include "shadowcomponent_codegen.cpp"
 } // namespace
@@ -172,6 +187,7 @@ ShadowComponent::ShadowComponent(const ghoul::Dictionary& dictionary)
     , _saveDepthTexture(SaveDepthTextureInfo)
     , _distanceFraction(DistanceFractionInfo, 20, 1, 10000)
     , _enabled(EnabledInfo, true)
+    , _updateThreshold(UpdateThresholdInfo, 0.5f, 0.f, 16.f)
 {
     using ghoul::filesystem::File;
 
@@ -191,6 +207,9 @@ ShadowComponent::ShadowComponent(const ghoul::Dictionary& dictionary)
     _distanceFraction = p.distanceFraction.value_or(_distanceFraction);
     addProperty(_distanceFraction);
 
+    _updateThreshold = p.updateThreshold.value_or(_updateThreshold);
+    addProperty(_updateThreshold);
+
     _saveDepthTexture.onChange([this]() { _executeDepthTextureSave = true; });
 
     if (p.depthMapSize.has_value()) {
@@ -230,16 +249,57 @@ void ShadowComponent::deinitializeGL() {
     glDeleteFramebuffers(1, &_shadowFBO);
 }
 
-RenderData ShadowComponent::begin(const RenderData& data) {
-    glm::ivec2 renderingResolution = global::renderEngine->renderingResolution();
-    if (_dynamicDepthTextureRes && ((_shadowDepthTextureWidth != renderingResolution.x) ||
-        (_shadowDepthTextureHeight != renderingResolution.y)))
+bool ShadowComponent::needsUpdate(const RenderData& data, double radius,
+                                  bool hasChangedGeometry)
+{
+    if (!_hasValidShadowMap || hasChangedGeometry || _updateThreshold == 0.f) {
+        return true;
+    }
+
+    const glm::ivec2 renderingResolution = global::renderEngine->renderingResolution();
+    if (_dynamicDepthTextureRes &&
+        (_shadowDepthTextureWidth != renderingResolution.x * 2 ||
+         _shadowDepthTextureHeight != renderingResolution.y * 2))
     {
-        _shadowDepthTextureWidth = renderingResolution.x * 2;
-        _shadowDepthTextureHeight = renderingResolution.y * 2;
-        updateDepthTexture();
+        return true;
+    }
+
+    const glm::dmat4 globeTransform =
+        glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
+        glm::dmat4(data.modelTransform.rotation);
+    const glm::dmat4 lightMatrix = updateLightCamera(data) * globeTransform;
+
+    // Compare where the center and the extreme points of the globe end up in the cached
+    // and the current shadow map
+    const glm::dvec2 size =
+        glm::dvec2(_shadowDepthTextureWidth, _shadowDepthTextureHeight);
+    constexpr std::array<glm::dvec3, 7> Probes = {
+        glm::dvec3( 0.0,  0.0,  0.0),
+        glm::dvec3( 1.0,  0.0,  0.0), glm::dvec3(-1.0,  0.0,  0.0),
+        glm::dvec3( 0.0,  1.0,  0.0), glm::dvec3( 0.0, -1.0,  0.0),
+        glm::dvec3( 0.0,  0.0,  1.0), glm::dvec3( 0.0,  0.0, -1.0)
+    };
+    for (const glm::dvec3& probe : Probes) {
+        const glm::dvec4 p = glm::dvec4(probe * radius, 1.0);
+        const glm::dvec4 current = lightMatrix * p;
+        const glm::dvec4 cached = _cachedLightMatrix * p;
+        if (current.w <= 0.0 || cached.w <= 0.0) {
+            return true;
+        }
+
+        const glm::dvec2 offset =
+            (glm::dvec2(current) / current.w - glm::dvec2(cached) / cached.w) * size;
+        if (glm::length(offset) > static_cast<double>(_updateThreshold)) {
+            return true;
+        }
     }
 
+    // The cached shadow map is still good enough, so we move it along with the globe
+    _shadowData.shadowMatrix = _cachedLightMatrix * glm::inverse(globeTransform);
+    return false;
+}
+
+glm::dmat4 ShadowComponent::updateLightCamera(const RenderData& data) {
     // ===========================================
     // Builds light's ModelViewProjectionMatrix:
     // ===========================================
@@ -311,10 +371,28 @@ RenderData ShadowComponent::begin(const RenderData& data) {
 
     // The model transformation missing in the final shadow matrix is add when rendering
     // each object (using its transformations provided by the RenderData structure)
-    _shadowData.shadowMatrix =
-        _toTextureCoordsMatrix * lightProjectionMatrix *
+    return _toTextureCoordsMatrix * lightProjectionMatrix *
         _lightCamera->combinedViewMatrix();
+}
+
+RenderData ShadowComponent::begin(const RenderData& data) {
+    glm::ivec2 renderingResolution = global::renderEngine->renderingResolution();
+    if (_dynamicDepthTextureRes &&
+        ((_shadowDepthTextureWidth != renderingResolution.x * 2) ||
+         (_shadowDepthTextureHeight != renderingResolution.y * 2)))
+    {
+        _shadowDepthTextureWidth = renderingResolution.x * 2;
+        _shadowDepthTextureHeight = renderingResolution.y * 2;
+        updateDepthTexture();
+    }
+
+    _shadowData.shadowMatrix = updateLightCamera(data);
 
+    const glm::dmat4 globeTransform =
+        glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
+        glm::dmat4(data.modelTransform.rotation);
+    _cachedLightMatrix = _shadowData.shadowMatrix * globeTransform;
+    _hasValidShadowMap = true;
 
     // Saves current state
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_currentFBO);
@@ -343,7 +421,14 @@ RenderData ShadowComponent::begin(const RenderData& data) {
         *_lightCamera,
         data.time,
         data.renderBinMask,
-        data.modelTransform
+        data.modelTransform,
+        WorldTransformCache::modelViewTransform(
+            data.modelTransform.translation,
+            data.modelTransform.rotation,
+            data.modelTransform.scale,
+            _lightCamera->positionVec3(),
+            _lightCamera->cameraRelativeViewMatrix()
+        )
     };
 
     return lightRenderData;
@@ -67,6 +67,16 @@ public:
 
     bool isReady() const;
 
+    /**
+     * Returns whether the shadow map has to be rendered again before it can be used for
+     * the provided \p data. The previously rendered shadow map is reused as long as the
+     * light source, relative to the globe, did not move by more than the update threshold
+     * for any point on a sphere of the provided \p radius around the globe and if the
+     * \p hasChangedGeometry is `false`. If the shadow map is reused, the shadow matrix is
+     * adjusted so that the cached map follows the current globe transformation.
+     */
+    bool needsUpdate(const RenderData& data, double radius, bool hasChangedGeometry);
+
     RenderData begin(const RenderData& data);
     void end();
     void update(const UpdateData& data);
@@ -84,6 +94,7 @@ private:
     void createShadowFBO();
     void updateDepthTexture();
     void buildDDepthTexture();
+    glm::dmat4 updateLightCamera(const RenderData& data);
 
     // Debug
     void saveDepthBuffer();
@@ -102,6 +113,7 @@ private:
     properties::TriggerProperty _saveDepthTexture;
     properties::IntProperty _distanceFraction;
     properties::BoolProperty _enabled;
+    properties::FloatProperty _updateThreshold;
 
     int _shadowDepthTextureHeight = 4096;
     int _shadowDepthTextureWidth = 4096;
@@ -133,6 +145,11 @@ private:
 
     std::unique_ptr<Camera> _lightCamera;
 
+    // The light matrix of the last rendered shadow map, including the globe's translation
+    // and rotation at that time, so that it maps globe-local coordinates into the map
+    glm::dmat4 _cachedLightMatrix = glm::dmat4(1.0);
+    bool _hasValidShadowMap = false;
+
     // DEBUG
     bool _executeDepthTextureSave = false;
 };
@@ -35,6 +35,10 @@ struct TileCacheProperties {
     std::string path;
     int quality;
     int blockSize;
+
+    // If this is true, color tiles are compressed into GPU texture blocks once and are
+    // stored on disk in that form
+    bool blockCompression = false;
 };
 
 } // namespace openspace::globebrowsing
@@ -28,8 +28,10 @@
 
 namespace openspace::globebrowsing {
 
-TileLoadJob::TileLoadJob(RawTileDataReader& rawTileDataReader, TileIndex tileIndex)
+TileLoadJob::TileLoadJob(RawTileDataReader& rawTileDataReader, TileIndex tileIndex,
+                         PixelBufferRing* pixelBuffers)
     : _rawTileDataReader(rawTileDataReader)
+    , _pixelBuffers(pixelBuffers)
     , _chunkIndex(std::move(tileIndex))
 {}
 
@@ -40,7 +42,7 @@ TileLoadJob::~TileLoadJob() {
 }
 
 void TileLoadJob::execute() {
-    _rawTile = _rawTileDataReader.readTileData(_chunkIndex);
+    _rawTile = _rawTileDataReader.readTileData(_chunkIndex, _pixelBuffers);
     _hasTile = true;
 }
 
@@ -32,6 +32,7 @@
 
 namespace openspace::globebrowsing {
 
+class PixelBufferRing;
 class RawTileDataReader;
 
 struct TileLoadJob : public Job<RawTile> {
@@ -39,9 +40,11 @@ struct TileLoadJob : public Job<RawTile> {
      * Allocates enough data for one tile. When calling `product()`, the
      * ownership of this data will be released. If `product()` has not been
      * called before the TileLoadJob is finished, the data will be deleted as it has not
-     * been exposed outside of this object.
+     * been exposed outside of this object. If \p pixelBuffers is provided, the data is
+     * read into one of its pixel buffers if one is available.
      */
-    TileLoadJob(RawTileDataReader& rawTileDataReader, TileIndex tileIndex);
+    TileLoadJob(RawTileDataReader& rawTileDataReader, TileIndex tileIndex,
+        PixelBufferRing* pixelBuffers = nullptr);
 
     /**
      * Destroys the allocated data pointer if it has been allocated and the TileLoadJob
@@ -65,6 +68,7 @@ struct TileLoadJob : public Job<RawTile> {
 
 protected:
     RawTileDataReader& _rawTileDataReader;
+    PixelBufferRing* _pixelBuffers = nullptr;
     RawTile _rawTile;
     const TileIndex _chunkIndex;
     bool _hasTile = false;
@@ -26,9 +26,13 @@
 
 #include <modules/globebrowsing/globebrowsingmodule.h>
 #include <modules/globebrowsing/src/memoryawaretilecache.h>
+#include <modules/globebrowsing/src/tilewarmcache.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/engine/globals.h>
 #include <openspace/engine/moduleengine.h>
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
 #include <optional>
 
 namespace {
@@ -104,6 +108,13 @@ namespace {
 
             // The block-size of the MRF cache
             std::optional<int> blockSize [[codegen::greater(0)]];
+
+            // If this value is true, the tiles are compressed into BC3 (DXT5) blocks
+            // the first time they are loaded and are stored in that form on disk. The
+            // compressed tiles are uploaded as-is and use a quarter of the GPU memory
+            // of uncompressed tiles. This is only supported for 8-bit color tiles that
+            // are not preprocessed
+            std::optional<bool> blockCompression;
         };
         // Specifies the cache settings that should be applied to this layer
         std::optional<CacheSettings> cacheSettings;
@@ -113,6 +124,37 @@ namespace {
 
     };
 #include "defaulttileprovider_codegen.cpp"
+
+    // Returns the key that identifies the decoded tiles of a dataset. The path is
+    // normalized if it refers to a file so that different spellings of the same file
+    // share their tiles. Everything else, such as URLs or GDAL XML descriptions, has to
+    // match exactly. The cache location is not part of the key as the cached tiles of
+    // the same dataset are identical regardless of where they are stored
+    std::string datasetKey(const std::string& filePath,
+                           const openspace::globebrowsing::TileTextureInitData& initData,
+                           const openspace::globebrowsing::TileCacheProperties& cache,
+                           bool performPreProcessing)
+    {
+        std::string path = filePath;
+        std::error_code ec;
+        if (std::filesystem::is_regular_file(path, ec)) {
+            std::filesystem::path p = std::filesystem::weakly_canonical(path, ec);
+            if (!ec) {
+                path = p.string();
+            }
+        }
+
+        return fmt::format(
+            "{}|{}|{}|{}|{}|{}|{}|{}",
+            path, initData.hashKey, performPreProcessing, cache.enabled,
+            cache.compression, cache.quality, cache.blockSize, cache.blockCompression
+        );
+    }
+
+    // The maximum number of tiles from the previous session that are loaded from the
+    // warm cache and the number of them that are requested per frame
+    constexpr size_t MaxPrewarmTiles = 512;
+    constexpr size_t NumPrewarmTilesPerFrame = 4;
 } // namespace
 
 namespace openspace::globebrowsing {
@@ -172,6 +214,7 @@ DefaultTileProvider::DefaultTileProvider(const ghoul::Dictionary& dictionary)
         Compression::JPEG;
     int quality = 75;
     int blockSize = 1024;
+    bool blockCompression = false;
     if (p.cacheSettings.has_value()) {
         enabled = p.cacheSettings->enabled.value_or(enabled);
         if (p.cacheSettings->compression.has_value()) {
@@ -179,6 +222,7 @@ DefaultTileProvider::DefaultTileProvider(const ghoul::Dictionary& dictionary)
         }
         quality = p.cacheSettings->quality.value_or(quality);
         blockSize = p.cacheSettings->blockSize.value_or(blockSize);
+        blockCompression = p.cacheSettings->blockCompression.value_or(blockCompression);
     }
 
     _cacheProperties.enabled = enabled;
@@ -186,6 +230,7 @@ DefaultTileProvider::DefaultTileProvider(const ghoul::Dictionary& dictionary)
     _cacheProperties.quality = quality;
     _cacheProperties.blockSize = blockSize;
     _cacheProperties.compression = codegen::toString(compression);
+    _cacheProperties.blockCompression = blockCompression;
 
     TileTextureInitData initData(
         tileTextureInitData(_layerGroupID, pixelSize)
@@ -193,8 +238,31 @@ DefaultTileProvider::DefaultTileProvider(const ghoul::Dictionary& dictionary)
     _tilePixelSize = initData.dimensions.x;
     initAsyncTileDataReader(initData, _cacheProperties);
 
+    if (TileWarmCache* warmCache = module.tileWarmCache()) {
+        const RawTileDataReader& reader = _asyncTextureDataProvider->rawTileDataReader();
+        _prewarmTiles = warmCache->hotTiles(reader.warmCacheIdentifier());
+        if (_prewarmTiles.size() > MaxPrewarmTiles) {
+            _prewarmTiles.resize(MaxPrewarmTiles);
+        }
+        // The tiles are sorted by level, but are requested from the back
+        std::reverse(_prewarmTiles.begin(), _prewarmTiles.end());
+    }
+
     addProperty(_filePath);
     addProperty(_tilePixelSize);
+
+    _telemetry = std::make_unique<TileTelemetry>(
+        fmt::format("{}/{}/{}", enclosing, layerGroup, identifier)
+    );
+    addPropertySubOwner(_telemetry.get());
+    module.registerTileTelemetry(_telemetry.get());
+}
+
+DefaultTileProvider::~DefaultTileProvider() {
+    GlobeBrowsingModule* module = global::moduleEngine->module<GlobeBrowsingModule>();
+    if (module) {
+        module->unregisterTileTelemetry(_telemetry.get());
+    }
 }
 
 void DefaultTileProvider::initAsyncTileDataReader(TileTextureInitData initData,
@@ -202,15 +270,29 @@ void DefaultTileProvider::initAsyncTileDataReader(TileTextureInitData initData,
 {
     ZoneScoped;
 
-    _asyncTextureDataProvider = std::make_unique<AsyncTileDataProvider>(
-        name,
-        std::make_unique<RawTileDataReader>(
-            _filePath,
-            initData,
-            cacheProperties,
-            RawTileDataReader::PerformPreprocessing(_performPreProcessing)
-        )
-    );
+    // Release the previous data provider first so that the module can detect whether
+    // anyone else is still using it
+    _asyncTextureDataProvider = nullptr;
+
+    const std::string key =
+        datasetKey(_filePath, initData, cacheProperties, _performPreProcessing);
+    GlobeBrowsingModule::SharedTileDataProvider shared =
+        global::moduleEngine->module<GlobeBrowsingModule>()->sharedTileDataProvider(
+            key,
+            [&]() {
+                return std::make_unique<AsyncTileDataProvider>(
+                    name,
+                    std::make_unique<RawTileDataReader>(
+                        _filePath,
+                        initData,
+                        cacheProperties,
+                        RawTileDataReader::PerformPreprocessing(_performPreProcessing)
+                    )
+                );
+            }
+        );
+    _asyncTextureDataProvider = std::move(shared.provider);
+    _tileCacheIdentifier = shared.cacheIdentifier;
 }
 
 Tile DefaultTileProvider::tile(const TileIndex& tileIndex) {
@@ -222,14 +304,18 @@ Tile DefaultTileProvider::tile(const TileIndex& tileIndex) {
     }
     const cache::ProviderTileKey key = {
         .tileIndex = tileIndex,
-        .providerID = uniqueIdentifier
+        .providerID = _tileCacheIdentifier
     };
     cache::MemoryAwareTileCache* tileCache =
         global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
     Tile tile = tileCache->get(key);
-    if (!tile.texture) {
+    _telemetry->recordCacheLookup(tile.texture != nullptr && !tile.isProvisional);
+    if (!tile.texture || tile.isProvisional) {
         _asyncTextureDataProvider->enqueueTileIO(tileIndex);
     }
+    if (!tile.texture && tileIndex.level > minLevel()) {
+        tile = tileCache->createProvisionalTile(key);
+    }
 
     return tile;
 }
@@ -244,11 +330,36 @@ Tile::Status DefaultTileProvider::tileStatus(const TileIndex& index) {
 
     const cache::ProviderTileKey key = {
         .tileIndex = index,
-        .providerID = uniqueIdentifier
+        .providerID = _tileCacheIdentifier
+    };
+    cache::MemoryAwareTileCache* tileCache =
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
+    // A provisional tile does not provide any more detail than its parent, so the chunk
+    // tree should not refine the chunk because of it
+    const Tile tile = tileCache->get(key);
+    return tile.isProvisional ? Tile::Status::Unavailable : tile.status;
+}
+
+void DefaultTileProvider::prefetch(const TileIndex& tileIndex) {
+    ZoneScoped;
+
+    ghoul_assert(_asyncTextureDataProvider, "No data provider");
+
+    // Chunks beyond the resolution of the dataset use the tile of the highest level
+    TileIndex index = tileIndex;
+    while (index.level > 0 && index.level > maxLevel()) {
+        const uint8_t parentLevel = static_cast<uint8_t>(index.level - 1);
+        index = TileIndex(index.x / 2, index.y / 2, parentLevel);
+    }
+    const cache::ProviderTileKey key = {
+        .tileIndex = index,
+        .providerID = _tileCacheIdentifier
     };
     cache::MemoryAwareTileCache* tileCache =
         global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
-    return tileCache->get(key).status;
+    if (!tileCache->hasLoadedTile(key)) {
+        _asyncTextureDataProvider->prefetchTileIO(index);
+    }
 }
 
 TileDepthTransform DefaultTileProvider::depthTransform() {
@@ -260,19 +371,53 @@ void DefaultTileProvider::update() {
     ghoul_assert(_asyncTextureDataProvider, "No data provider");
     _asyncTextureDataProvider->update();
 
-    std::optional<RawTile> tile = _asyncTextureDataProvider->popFinishedRawTile();
+    cache::MemoryAwareTileCache* tileCache =
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
+
+    // Finished tiles stay with the provider until there is budget left to upload them
+    std::optional<RawTile> tile = tileCache->hasUploadBudget() ?
+        _asyncTextureDataProvider->popFinishedRawTile() :
+        std::nullopt;
     if (tile) {
         const cache::ProviderTileKey key = {
             .tileIndex = tile->tileIndex,
-            .providerID = uniqueIdentifier
+            .providerID = _tileCacheIdentifier
         };
-        cache::MemoryAwareTileCache* tileCache =
-            global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
-        ghoul_assert(!tileCache->exist(key), "Tile must not be existing in cache");
+        ghoul_assert(!tileCache->hasLoadedTile(key), "Tile must not be loaded already");
+        _telemetry->recordLoadedTile(tile->readDuration, tile->processDuration);
+
+        const auto uploadStart = std::chrono::steady_clock::now();
         tileCache->createTileAndPut(key, std::move(*tile));
+        _telemetry->recordUpload(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - uploadStart
+        ));
+    }
+
+    // Request the tiles that were visible in the previous session while the provider is
+    // otherwise idle, so that they are read from the warm cache ahead of time
+    for (size_t i = 0; i < NumPrewarmTilesPerFrame && !_prewarmTiles.empty(); i++) {
+        if (_asyncTextureDataProvider->numberOfQueuedTiles() > NumPrewarmTilesPerFrame) {
+            break;
+        }
+        const TileIndex index = _prewarmTiles.back();
+        _prewarmTiles.pop_back();
+        const cache::ProviderTileKey key = {
+            .tileIndex = index,
+            .providerID = _tileCacheIdentifier
+        };
+        if (!tileCache->hasLoadedTile(key)) {
+            _asyncTextureDataProvider->prefetchTileIO(index);
+        }
     }
 
+    _telemetry->update(
+        _asyncTextureDataProvider->numberOfQueuedTiles(),
+        _numDroppedTilesBeforeReset + _asyncTextureDataProvider->numberOfDroppedTiles(),
+        tileCache->numberOfEvictions(_tileCacheIdentifier)
+    );
+
     if (_asyncTextureDataProvider->shouldBeDeleted()) {
+        _numDroppedTilesBeforeReset += _asyncTextureDataProvider->numberOfDroppedTiles();
         initAsyncTileDataReader(
             tileTextureInitData(_layerGroupID, _tilePixelSize),
             _cacheProperties
@@ -301,4 +446,14 @@ float DefaultTileProvider::noDataValueAsFloat() {
     return _asyncTextureDataProvider->noDataValueAsFloat();
 }
 
+size_t DefaultTileProvider::numberOfCachedBytes() const {
+    const cache::MemoryAwareTileCache* tileCache =
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
+    return tileCache->numberOfBytes(_tileCacheIdentifier);
+}
+
+uint16_t DefaultTileProvider::tileCacheIdentifier() const {
+    return _tileCacheIdentifier;
+}
+
 } // namespace openspace::globebrowsing
@@ -28,16 +28,22 @@
 #include <modules/globebrowsing/src/tileprovider/tileprovider.h>
 #include <modules/globebrowsing/src/tilecacheproperties.h>
 #include <modules/globebrowsing/src/asynctiledataprovider.h>
+#include <modules/globebrowsing/src/tiletelemetry.h>
 #include <memory>
+#include <vector>
 
 namespace openspace::globebrowsing {
 
 class DefaultTileProvider : public TileProvider {
 public:
     DefaultTileProvider(const ghoul::Dictionary& dictionary);
+    DefaultTileProvider(DefaultTileProvider&&) = default;
+    ~DefaultTileProvider() override;
 
     Tile tile(const TileIndex& tileIndex) override final;
     Tile::Status tileStatus(const TileIndex& index) override final;
+    void prefetch(const TileIndex& tileIndex) override final;
+    size_t numberOfCachedBytes() const override final;
     TileDepthTransform depthTransform() override final;
     void update() override final;
     void reset() override final;
@@ -45,6 +51,13 @@ public:
     int maxLevel() override final;
     float noDataValueAsFloat() override final;
 
+    /**
+     * Returns the identifier under which the tiles of this tile provider are stored in
+     * the tile cache. Tile providers that load the same dataset with the same settings
+     * share their tiles and thus also this identifier.
+     */
+    uint16_t tileCacheIdentifier() const;
+
     static documentation::Documentation Documentation();
 
 private:
@@ -54,10 +67,17 @@ private:
     properties::StringProperty _filePath;
     properties::IntProperty _tilePixelSize;
 
-    std::unique_ptr<AsyncTileDataProvider> _asyncTextureDataProvider;
+    std::shared_ptr<AsyncTileDataProvider> _asyncTextureDataProvider;
+    uint16_t _tileCacheIdentifier = 0;
     layers::Group::ID _layerGroupID = layers::Group::ID::Unknown;
     bool _performPreProcessing = false;
     TileCacheProperties _cacheProperties;
+
+    std::unique_ptr<TileTelemetry> _telemetry;
+    // The tiles of the previous session that have not been requested from the warm cache
+    std::vector<TileIndex> _prewarmTiles;
+    // The tiles dropped by previous data providers that have since been replaced
+    uint64_t _numDroppedTilesBeforeReset = 0;
 };
 
 } // namespace openspace::globebrowsing
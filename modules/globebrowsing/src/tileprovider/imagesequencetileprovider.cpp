@@ -118,6 +118,12 @@ Tile::Status ImageSequenceTileProvider::tileStatus(const TileIndex& index) {
         Tile::Status::Unavailable;
 }
 
+void ImageSequenceTileProvider::prefetch(const TileIndex& tileIndex) {
+    if (_currentTileProvider) {
+        _currentTileProvider->prefetch(tileIndex);
+    }
+}
+
 TileDepthTransform ImageSequenceTileProvider::depthTransform() {
     if (_currentTileProvider) {
         return _currentTileProvider->depthTransform();
@@ -46,6 +46,11 @@
 namespace {
     constexpr std::string_view TimePlaceholder = "${OpenSpaceTimeId}";
 
+    // Upper limit for the number of timesteps of a prototyped dataset whose times and
+    // identifiers are computed up front. Longer datasets, for example minute resolution
+    // over decades, fall back to quantizing the time every frame
+    constexpr size_t MaxPrecomputedTimesteps = 50000;
+
     constexpr openspace::properties::Property::PropertyInfo UseFixedTimeInfo = {
         "UseFixedTime",
         "Use Fixed Time",
@@ -63,6 +68,25 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo PreloadTimestepsInfo = {
+        "PreloadTimesteps",
+        "Preload Timesteps",
+        "The number of timesteps ahead of the current time, in the direction in which "
+        "the time is currently changing, whose tiles are loaded in the background so "
+        "that they are available once the time reaches them. A value of 0 disables the "
+        "preloading",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo PreloadMemoryCapInfo = {
+        "PreloadMemoryCap",
+        "Preload Memory Cap (MB)",
+        "The maximum amount of tile memory that the timesteps of this layer should "
+        "occupy. If the tiles of all timesteps exceed this value, the timesteps furthest "
+        "behind the current time are removed. A value of 0 removes the limit",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     struct [[codegen::Dictionary(TemporalTileProvider)]] Parameters {
         // [[codegen::verbatim(UseFixedTimeInfo.description)]]
         std::optional<bool> useFixedTime;
@@ -70,6 +94,12 @@ namespace {
         // [[codegen::verbatim(FixedTimeInfo.description)]]
         std::optional<std::string> fixedTime;
 
+        // [[codegen::verbatim(PreloadTimestepsInfo.description)]]
+        std::optional<int> preloadTimesteps [[codegen::inrange(0, 16)]];
+
+        // [[codegen::verbatim(PreloadMemoryCapInfo.description)]]
+        std::optional<int> preloadMemoryCap [[codegen::greaterequal(0)]];
+
         enum class Mode {
             Prototyped,
             Folder
@@ -166,6 +196,8 @@ TemporalTileProvider::TemporalTileProvider(const ghoul::Dictionary& dictionary)
     : _initDict(dictionary)
     , _useFixedTime(UseFixedTimeInfo, false)
     , _fixedTime(FixedTimeInfo)
+    , _preloadTimesteps(PreloadTimestepsInfo, 2, 0, 16)
+    , _preloadMemoryCap(PreloadMemoryCapInfo, 512, 0, 16384)
 {
     ZoneScoped;
 
@@ -192,6 +224,12 @@ TemporalTileProvider::TemporalTileProvider(const ghoul::Dictionary& dictionary)
     _fixedTime.onChange([this]() { _fixedTimeDirty = true; });
     addProperty(_fixedTime);
 
+    _preloadTimesteps = p.preloadTimesteps.value_or(_preloadTimesteps);
+    addProperty(_preloadTimesteps);
+
+    _preloadMemoryCap = p.preloadMemoryCap.value_or(_preloadMemoryCap);
+    addProperty(_preloadMemoryCap);
+
     _colormap = p.colormap.value_or(_colormap);
 
     if (p.prototyped.has_value()) {
@@ -230,6 +268,18 @@ TemporalTileProvider::TemporalTileProvider(const ghoul::Dictionary& dictionary)
         }
         _prototyped.timeFormat = p.prototyped->timeFormat;
         _prototyped.prototype = p.prototyped->prototype;
+
+        // Format the identifiers of all timesteps once so that the per-frame lookup is
+        // a binary search without any string conversions
+        const std::vector<double> times =
+            _prototyped.timeQuantizer.quantizedTimes(MaxPrecomputedTimesteps);
+        _prototyped.timesteps.reserve(times.size());
+        for (double t : times) {
+            _prototyped.timesteps.emplace_back(
+                t,
+                std::string(timeStringify(_prototyped.timeFormat, Time(t)))
+            );
+        }
     }
 
     if (p.folder.has_value()) {
@@ -321,7 +371,15 @@ Tile TemporalTileProvider::tile(const TileIndex& tileIndex) {
         update();
     }
 
-    return _currentTileProvider->tile(tileIndex);
+    Tile tile = _currentTileProvider->tile(tileIndex);
+    if (tile.status == Tile::Status::OK) {
+        // Request the same tile for the upcoming timesteps so that it is available by
+        // the time the playhead reaches them
+        for (DefaultTileProvider* tp : _preloadedTileProviders) {
+            tp->prefetch(tileIndex);
+        }
+    }
+    return tile;
 }
 
 Tile::Status TemporalTileProvider::tileStatus(const TileIndex& index) {
@@ -332,6 +390,22 @@ Tile::Status TemporalTileProvider::tileStatus(const TileIndex& index) {
     return _currentTileProvider->tileStatus(index);
 }
 
+void TemporalTileProvider::prefetch(const TileIndex& tileIndex) {
+    // Only the tiles of the current time step are prefetched
+    if (_currentTileProvider) {
+        _currentTileProvider->prefetch(tileIndex);
+    }
+}
+
+size_t TemporalTileProvider::numberOfCachedBytes() const {
+    // Tiles of all time steps remain in the cache until they are evicted
+    size_t res = 0;
+    for (const std::pair<const double, DefaultTileProvider>& p : _tileProviderMap) {
+        res += p.second.numberOfCachedBytes();
+    }
+    return res;
+}
+
 TileDepthTransform TemporalTileProvider::depthTransform() {
     if (!_currentTileProvider) {
         update();
@@ -341,9 +415,11 @@ TileDepthTransform TemporalTileProvider::depthTransform() {
 }
 
 void TemporalTileProvider::update() {
+    const bool usesFixedTime = _useFixedTime && !_fixedTime.value().empty();
+
     TileProvider* newCurr = nullptr;
     try {
-        if (_useFixedTime && !_fixedTime.value().empty()) {
+        if (usesFixedTime) {
             if (_fixedTimeDirty) {
                 std::string fixedTime = _fixedTime.value();
                 double et = SpiceManager::ref().ephemerisTimeFromDate(fixedTime);
@@ -365,6 +441,13 @@ void TemporalTileProvider::update() {
     if (_currentTileProvider) {
         _currentTileProvider->update();
     }
+
+    if (usesFixedTime) {
+        _preloadedTileProviders.clear();
+    }
+    else {
+        preloadTimesteps(global::timeManager->time());
+    }
 }
 
 void TemporalTileProvider::reset() {
@@ -436,8 +519,20 @@ DefaultTileProvider* TemporalTileProvider::retrieveTileProvider(const Time& t) {
 
     std::string_view timeStr = [this, time]() {
         switch (_mode) {
-            case Mode::Prototype:
+            case Mode::Prototype: {
+                auto it = std::lower_bound(
+                    _prototyped.timesteps.cbegin(),
+                    _prototyped.timesteps.cend(),
+                    time,
+                    [](const std::pair<double, std::string>& p, double sec) {
+                        return p.first < sec;
+                    }
+                );
+                if (it != _prototyped.timesteps.cend() && it->first == time) {
+                    return std::string_view(it->second);
+                }
                 return timeStringify(_prototyped.timeFormat, Time(time));
+            }
             case Mode::Folder: {
                 // Yes this will have to be done twice since we do the check previously
                 // but it is only happening when the images change, so I think that should
@@ -535,7 +630,7 @@ TemporalTileProvider::tileProvider<TemporalTileProvider::Mode::Prototype, false>
                                                                          const Time& time)
 {
     Time tCopy(time);
-    if (_prototyped.timeQuantizer.quantize(tCopy, true)) {
+    if (quantizePrototyped(tCopy)) {
         return retrieveTileProvider(tCopy);
     }
     else {
@@ -543,13 +638,224 @@ TemporalTileProvider::tileProvider<TemporalTileProvider::Mode::Prototype, false>
     }
 }
 
+std::vector<std::pair<double, std::string>>::const_iterator
+TemporalTileProvider::prototypedTimestep(double time) const
+{
+    ghoul_assert(!_prototyped.timesteps.empty(), "No precomputed timesteps");
+
+    // The timestep containing the time is the last one that starts before it. Times
+    // outside of the dataset are clamped to its first or last timestep
+    using It = std::vector<std::pair<double, std::string>>::const_iterator;
+    It it = std::upper_bound(
+        _prototyped.timesteps.begin(),
+        _prototyped.timesteps.end(),
+        time,
+        [](double t, const std::pair<double, std::string>& p) {
+            return t < p.first;
+        }
+    );
+    if (it != _prototyped.timesteps.begin()) {
+        it -= 1;
+    }
+    return it;
+}
+
+bool TemporalTileProvider::quantizePrototyped(Time& time) {
+    if (_prototyped.timesteps.empty()) {
+        return _prototyped.timeQuantizer.quantize(time, true);
+    }
+
+    time.setTime(prototypedTimestep(time.j2000Seconds())->first);
+    return true;
+}
+
+std::vector<double> TemporalTileProvider::upcomingTimesteps(double time, int n,
+                                                            bool forward) const
+{
+    std::vector<double> res;
+    switch (_mode) {
+        case Mode::Prototype: {
+            if (!_prototyped.timesteps.empty()) {
+                using It = std::vector<std::pair<double, std::string>>::const_iterator;
+                const It it = prototypedTimestep(time);
+                const ptrdiff_t curr = std::distance(_prototyped.timesteps.begin(), it);
+                const ptrdiff_t nSteps =
+                    static_cast<ptrdiff_t>(_prototyped.timesteps.size());
+                for (int i = 1; i <= n; i++) {
+                    const ptrdiff_t idx = forward ? curr + i : curr - i;
+                    if (idx < 0 || idx >= nSteps) {
+                        break;
+                    }
+                    res.push_back(_prototyped.timesteps[idx].first);
+                }
+                break;
+            }
+
+            // Stepping by one and a half (or half) of the resolution past the quantized
+            // time ends up inside the next (or previous) timestep, which absorbs the
+            // differing lengths of months and years
+            TimeQuantizer quantizer = _prototyped.timeQuantizer;
+            const double resolution = quantizer.resolution();
+            Time t = Time(time);
+            if (resolution <= 0.0 || !quantizer.quantize(t, true)) {
+                break;
+            }
+            double current = t.j2000Seconds();
+            for (int i = 0; i < n; i++) {
+                Time next = Time(current + (forward ? 1.5 : -0.5) * resolution);
+                if (!quantizer.quantize(next, true) || next.j2000Seconds() == current) {
+                    // We reached the beginning or end of the dataset
+                    break;
+                }
+                current = next.j2000Seconds();
+                res.push_back(current);
+            }
+            break;
+        }
+        case Mode::Folder: {
+            // Same lookup of the current timestep as in the non-interpolating case
+            using It = std::vector<std::pair<double, std::string>>::const_iterator;
+            It it = std::lower_bound(
+                _folder.files.begin(),
+                _folder.files.end(),
+                time,
+                [](const std::pair<double, std::string>& p, double t) {
+                    return p.first < t;
+                }
+            );
+            if (it != _folder.files.begin()) {
+                it -= 1;
+            }
+            const ptrdiff_t curr = std::distance(_folder.files.begin(), it);
+            const ptrdiff_t nFiles = static_cast<ptrdiff_t>(_folder.files.size());
+            for (int i = 1; i <= n; i++) {
+                const ptrdiff_t idx = forward ? curr + i : curr - i;
+                if (idx < 0 || idx >= nFiles) {
+                    break;
+                }
+                res.push_back(_folder.files[idx].first);
+            }
+            break;
+        }
+    }
+    return res;
+}
+
+void TemporalTileProvider::preloadTimesteps(const Time& time) {
+    ZoneScoped;
+
+    _preloadedTileProviders.clear();
+    const bool forward = global::timeManager->deltaTime() >= 0.0;
+
+    // Only a single new timestep is opened per frame as creating a tile provider opens
+    // the dataset, which can take a while for remote datasets
+    bool hasCreated = false;
+    const std::vector<double> timesteps =
+        upcomingTimesteps(time.j2000Seconds(), _preloadTimesteps, forward);
+    for (double t : timesteps) {
+        if (_failedTimesteps.contains(t)) {
+            continue;
+        }
+
+        const auto it = _tileProviderMap.find(t);
+        if (it != _tileProviderMap.end()) {
+            _preloadedTileProviders.push_back(&it->second);
+            continue;
+        }
+        if (hasCreated) {
+            continue;
+        }
+
+        hasCreated = true;
+        try {
+            _preloadedTileProviders.push_back(retrieveTileProvider(Time(t)));
+        }
+        catch (const ghoul::RuntimeError& e) {
+            LWARNINGC(
+                "TemporalTileProvider",
+                fmt::format("Could not preload timestep: {}", e.message)
+            );
+            _failedTimesteps.insert(t);
+        }
+    }
+
+    if (_preloadMemoryCap > 0) {
+        evictTimesteps(time.j2000Seconds(), forward);
+    }
+
+    for (DefaultTileProvider* tp : _preloadedTileProviders) {
+        if (tp != _currentTileProvider) {
+            tp->update();
+        }
+    }
+}
+
+void TemporalTileProvider::evictTimesteps(double time, bool forward) {
+    ZoneScoped;
+
+    cache::MemoryAwareTileCache* tileCache =
+        global::moduleEngine->module<GlobeBrowsingModule>()->tileCache();
+
+    size_t nBytes = 0;
+    for (const std::pair<const double, DefaultTileProvider>& p : _tileProviderMap) {
+        nBytes += tileCache->numberOfBytes(p.second.tileCacheIdentifier());
+    }
+
+    const size_t cap = static_cast<size_t>(_preloadMemoryCap) * 1024 * 1024;
+    while (nBytes > cap) {
+        auto isInUse = [this](const TileProvider* tp) {
+            if (tp == _currentTileProvider) {
+                return true;
+            }
+            if (_isInterpolating && _interpolateTileProvider) {
+                const InterpolateTileProvider& ip = *_interpolateTileProvider;
+                if (tp == ip.before || tp == ip.t1 || tp == ip.t2 || tp == ip.future) {
+                    return true;
+                }
+            }
+            return std::find(
+                _preloadedTileProviders.begin(),
+                _preloadedTileProviders.end(),
+                tp
+            ) != _preloadedTileProviders.end();
+        };
+
+        // The timestep that is the furthest behind the playhead is evicted first
+        using It = std::unordered_map<double, DefaultTileProvider>::iterator;
+        It victim = _tileProviderMap.end();
+        for (It it = _tileProviderMap.begin(); it != _tileProviderMap.end(); it++) {
+            const bool isBehind = forward ? it->first < time : it->first > time;
+            if (!isBehind || isInUse(&it->second)) {
+                continue;
+            }
+            if (victim == _tileProviderMap.end() ||
+                (forward ? it->first < victim->first : it->first > victim->first))
+            {
+                victim = it;
+            }
+        }
+
+        if (victim == _tileProviderMap.end()) {
+            // Everything that is left is currently needed
+            break;
+        }
+
+        // The cached tiles of the evicted timestep are not used anymore and will be the
+        // first to be reused by the tile cache
+        const uint16_t id = victim->second.tileCacheIdentifier();
+        nBytes -= std::min(nBytes, tileCache->numberOfBytes(id));
+        victim->second.deinitialize();
+        _tileProviderMap.erase(victim);
+    }
+}
+
 template <>
 TileProvider*
 TemporalTileProvider::tileProvider<TemporalTileProvider::Mode::Prototype, true>(
                                                                          const Time& time)
 {
     Time tCopy(time);
-    if (!_prototyped.timeQuantizer.quantize(tCopy, true)) {
+    if (!quantizePrototyped(tCopy)) {
         return nullptr;
     }
 
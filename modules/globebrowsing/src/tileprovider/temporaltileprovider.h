@@ -29,6 +29,7 @@
 
 #include <modules/globebrowsing/src/tileprovider/defaulttileprovider.h>
 #include <modules/globebrowsing/src/tileprovider/singleimagetileprovider.h>
+#include <set>
 
 namespace openspace::globebrowsing {
 
@@ -48,6 +49,8 @@ public:
 
     Tile tile(const TileIndex& tileIndex) override final;
     Tile::Status tileStatus(const TileIndex& index) override final;
+    void prefetch(const TileIndex& tileIndex) override final;
+    size_t numberOfCachedBytes() const override final;
     TileDepthTransform depthTransform() override final;
     void update() override final;
     void reset() override final;
@@ -96,6 +99,35 @@ private:
 
     TileProvider* tileProvider(const Time& time);
 
+    /**
+     * Returns the keys of the (at most) \p n timesteps that follow the timestep that
+     * contains the \p time in the direction of the playback, which is forward in time if
+     * \p forward is `true` and backward otherwise.
+     */
+    std::vector<double> upcomingTimesteps(double time, int n, bool forward) const;
+
+    /**
+     * Returns the precomputed timestep of a prototyped dataset that contains the
+     * \p time, clamped to the first and last timestep of the dataset. Must only be
+     * called if the timesteps were precomputed.
+     */
+    std::vector<std::pair<double, std::string>>::const_iterator
+        prototypedTimestep(double time) const;
+
+    /**
+     * Quantizes the \p time to the start of the timestep of the prototyped dataset that
+     * contains it, using the precomputed timesteps if they are available.
+     */
+    bool quantizePrototyped(Time& time);
+
+    /**
+     * Creates the tile providers for the timesteps that will be shown next when the
+     * time continues to change with the current delta time and evicts the tile providers
+     * behind the playhead if the tiles of all timesteps exceed the memory cap.
+     */
+    void preloadTimesteps(const Time& time);
+    void evictTimesteps(double time, bool forward);
+
     Mode _mode;
 
     struct {
@@ -106,6 +138,10 @@ private:
         std::string timeFormat;
         TimeQuantizer timeQuantizer;
         std::string prototype;
+
+        // All timesteps of the dataset with their formatted time identifiers. Empty if
+        // the dataset contains too many timesteps to be precomputed
+        std::vector<std::pair<double, std::string>> timesteps;
     } _prototyped;
 
     struct {
@@ -119,9 +155,14 @@ private:
     properties::BoolProperty _useFixedTime;
     properties::StringProperty _fixedTime;
     bool _fixedTimeDirty = true;
+    properties::IntProperty _preloadTimesteps;
+    properties::IntProperty _preloadMemoryCap;
 
     TileProvider* _currentTileProvider = nullptr;
     std::unordered_map<double, DefaultTileProvider> _tileProviderMap;
+    std::vector<DefaultTileProvider*> _preloadedTileProviders;
+    // Timesteps whose tile provider could not be created are not retried while preloading
+    std::set<double> _failedTimesteps;
 
     bool _isInterpolating = false;
 
@@ -194,6 +194,12 @@ ChunkTile TileProvider::traverseTree(TileIndex tileIndex, int parents, int maxPa
 void TileProvider::internalInitialize() {}
 void TileProvider::internalDeinitialize() {}
 
+void TileProvider::prefetch(const TileIndex&) {}
+
+size_t TileProvider::numberOfCachedBytes() const {
+    return 0;
+}
+
 ChunkTile TileProvider::chunkTile(TileIndex tileIndex, int parents, int maxParents) {
     ZoneScoped;
 
@@ -95,6 +95,21 @@ struct TileProvider : public properties::PropertyOwner {
      */
     virtual Tile::Status tileStatus(const TileIndex& index) = 0;
 
+    /**
+     * Requests the `Tile` for the provided \p tileIndex ahead of time as it is expected
+     * to be needed soon. The request has a lower priority than the tiles requested
+     * through `tile`. The default implementation does nothing, which is the correct
+     * behavior for all TileProviders that do not load their tiles asynchronously.
+     */
+    virtual void prefetch(const TileIndex& tileIndex);
+
+    /**
+     * Returns the number of bytes of texture memory that are occupied by the tiles of
+     * this TileProvider in the tile cache. The default implementation returns 0, which
+     * is the correct value for all TileProviders that do not store tiles in the cache.
+     */
+    virtual size_t numberOfCachedBytes() const;
+
     /**
      * Get the associated depth transform for this TileProvider. This is necessary for
      * TileProviders serving height map data, in order to correcly map pixel values to
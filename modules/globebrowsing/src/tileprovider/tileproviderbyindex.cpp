@@ -120,6 +120,21 @@ Tile::Status TileProviderByIndex::tileStatus(const TileIndex& index) {
     return hasProvider ? it->second->tileStatus(index) : Tile::Status::Unavailable;
 }
 
+void TileProviderByIndex::prefetch(const TileIndex& tileIndex) {
+    const auto it = _providers.find(tileIndex.hashKey());
+    if (it != _providers.end()) {
+        it->second->prefetch(tileIndex);
+    }
+}
+
+size_t TileProviderByIndex::numberOfCachedBytes() const {
+    size_t res = _defaultTileProvider->numberOfCachedBytes();
+    for (const auto& [key, provider] : _providers) {
+        res += provider->numberOfCachedBytes();
+    }
+    return res;
+}
+
 TileDepthTransform TileProviderByIndex::depthTransform() {
     return _defaultTileProvider->depthTransform();
 }
@@ -35,6 +35,8 @@ public:
 
     Tile tile(const TileIndex& tileIndex) override final;
     Tile::Status tileStatus(const TileIndex& index) override final;
+    void prefetch(const TileIndex& tileIndex) override final;
+    size_t numberOfCachedBytes() const override final;
     TileDepthTransform depthTransform() override final;
     void update() override final;
     void reset() override final;
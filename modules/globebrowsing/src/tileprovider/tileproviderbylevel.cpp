@@ -130,6 +130,21 @@ Tile::Status TileProviderByLevel::tileStatus(const TileIndex& index) {
     return provider ? provider->tileStatus(index) : Tile::Status::Unavailable;
 }
 
+void TileProviderByLevel::prefetch(const TileIndex& tileIndex) {
+    TileProvider* provider = levelProvider(tileIndex.level);
+    if (provider) {
+        provider->prefetch(tileIndex);
+    }
+}
+
+size_t TileProviderByLevel::numberOfCachedBytes() const {
+    size_t res = 0;
+    for (const std::unique_ptr<TileProvider>& provider : _levelTileProviders) {
+        res += provider->numberOfCachedBytes();
+    }
+    return res;
+}
+
 TileProvider* TileProviderByLevel::levelProvider(int level) const {
     ZoneScoped;
 
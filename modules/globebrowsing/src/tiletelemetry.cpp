@@ -0,0 +1,261 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/tiletelemetry.h>
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace {
+    constexpr openspace::properties::Property::PropertyInfo QueueDepthInfo = {
+        "QueueDepth",
+        "Queue Depth",
+        "The number of tiles that are currently waiting to be read by the loading "
+        "threads",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo ReadLatencyInfo = {
+        "ReadLatency",
+        "Read Latency (ms)",
+        "The average time in milliseconds that it took to read a tile from its data "
+        "source during the last second",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo ProcessTimeInfo = {
+        "DecodeTime",
+        "Decode Time (ms)",
+        "The average time in milliseconds that it took to process a tile after it was "
+        "read during the last second. This includes the preprocessing of height tiles "
+        "and the block compression of color tiles",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo UploadTimeInfo = {
+        "UploadTime",
+        "Upload Time (ms)",
+        "The average time in milliseconds that it took to upload a tile to the graphics "
+        "card during the last second",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CacheHitRateInfo = {
+        "CacheHitRate",
+        "Cache Hit Rate",
+        "The fraction of tile requests during the last second that were served from the "
+        "tile cache",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo EvictionRateInfo = {
+        "EvictionRate",
+        "Eviction Rate (1/s)",
+        "The number of tiles of this provider that were evicted from the tile cache "
+        "during the last second",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo DropRateInfo = {
+        "DropRate",
+        "Drop Rate (1/s)",
+        "The number of enqueued tiles that were dropped during the last second because "
+        "they were no longer needed before they were loaded",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr std::chrono::seconds WindowLength = std::chrono::seconds(1);
+
+    float averageMs(std::chrono::microseconds total, uint64_t count) {
+        if (count == 0) {
+            return 0.f;
+        }
+        return static_cast<float>(static_cast<double>(total.count()) / count / 1000.0);
+    }
+} // namespace
+
+namespace openspace::globebrowsing {
+
+void TileTelemetry::Histogram::record(std::chrono::microseconds duration) {
+    using namespace std::chrono;
+
+    // Bucket i holds the durations in (2^(i-1), 2^i] ms, bucket 0 everything <= 1 ms
+    const uint64_t ms = static_cast<uint64_t>(
+        std::max<microseconds::rep>(ceil<milliseconds>(duration).count(), 0)
+    );
+    const int bucket = ms <= 1 ? 0 : static_cast<int>(std::bit_width(ms - 1));
+    _buckets[std::min(bucket, NumBuckets - 1)]++;
+    _count++;
+    _total += duration;
+}
+
+const std::array<uint64_t, TileTelemetry::Histogram::NumBuckets>&
+TileTelemetry::Histogram::buckets() const
+{
+    return _buckets;
+}
+
+uint64_t TileTelemetry::Histogram::count() const {
+    return _count;
+}
+
+std::chrono::microseconds TileTelemetry::Histogram::total() const {
+    return _total;
+}
+
+int TileTelemetry::Histogram::bucketUpperBound(int bucket) {
+    return bucket < NumBuckets - 1 ? 1 << bucket : 0;
+}
+
+TileTelemetry::TileTelemetry(std::string source)
+    : properties::PropertyOwner({ "Telemetry" })
+    , _source(std::move(source))
+    , _windowStartTime(std::chrono::steady_clock::now())
+    , _queueDepthProperty(QueueDepthInfo, 0, 0, std::numeric_limits<int>::max())
+    , _readLatencyProperty(ReadLatencyInfo, 0.f, 0.f, 10000.f)
+    , _processTimeProperty(ProcessTimeInfo, 0.f, 0.f, 10000.f)
+    , _uploadTimeProperty(UploadTimeInfo, 0.f, 0.f, 10000.f)
+    , _cacheHitRateProperty(CacheHitRateInfo, 0.f, 0.f, 1.f)
+    , _evictionRateProperty(EvictionRateInfo, 0.f, 0.f, 100000.f)
+    , _dropRateProperty(DropRateInfo, 0.f, 0.f, 100000.f)
+{
+    _queueDepthProperty.setReadOnly(true);
+    addProperty(_queueDepthProperty);
+    _readLatencyProperty.setReadOnly(true);
+    addProperty(_readLatencyProperty);
+    _processTimeProperty.setReadOnly(true);
+    addProperty(_processTimeProperty);
+    _uploadTimeProperty.setReadOnly(true);
+    addProperty(_uploadTimeProperty);
+    _cacheHitRateProperty.setReadOnly(true);
+    addProperty(_cacheHitRateProperty);
+    _evictionRateProperty.setReadOnly(true);
+    addProperty(_evictionRateProperty);
+    _dropRateProperty.setReadOnly(true);
+    addProperty(_dropRateProperty);
+}
+
+void TileTelemetry::recordCacheLookup(bool isHit) {
+    if (isHit) {
+        _cacheHits++;
+    }
+    else {
+        _cacheMisses++;
+    }
+}
+
+void TileTelemetry::recordLoadedTile(std::chrono::microseconds readDuration,
+                                     std::chrono::microseconds processDuration)
+{
+    _readLatency.record(readDuration);
+    _processTime.record(processDuration);
+}
+
+void TileTelemetry::recordUpload(std::chrono::microseconds duration) {
+    _uploadTime.record(duration);
+}
+
+void TileTelemetry::update(int queueDepth, uint64_t nDroppedTiles, uint64_t nEvictions) {
+    _queueDepth = queueDepth;
+    _droppedTiles = nDroppedTiles;
+    _evictions = nEvictions;
+
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const std::chrono::duration<float> window = now - _windowStartTime;
+    if (window < WindowLength) {
+        return;
+    }
+
+    const Counters c = counters();
+    const uint64_t nHits = c.cacheHits - _windowStart.cacheHits;
+    const uint64_t nLookups = nHits + (c.cacheMisses - _windowStart.cacheMisses);
+    const float hitRate = nLookups > 0 ? static_cast<float>(nHits) / nLookups : 0.f;
+
+    _queueDepthProperty = _queueDepth;
+    _readLatencyProperty =
+        averageMs(c.read - _windowStart.read, c.nReads - _windowStart.nReads);
+    _processTimeProperty =
+        averageMs(c.process - _windowStart.process, c.nReads - _windowStart.nReads);
+    _uploadTimeProperty =
+        averageMs(c.upload - _windowStart.upload, c.nUploads - _windowStart.nUploads);
+    _cacheHitRateProperty = hitRate;
+    _evictionRateProperty = (c.evictions - _windowStart.evictions) / window.count();
+    _dropRateProperty = (c.droppedTiles - _windowStart.droppedTiles) / window.count();
+
+    _windowStart = c;
+    _windowStartTime = now;
+}
+
+TileTelemetry::Counters TileTelemetry::counters() const {
+    Counters c;
+    c.cacheHits = _cacheHits;
+    c.cacheMisses = _cacheMisses;
+    c.droppedTiles = _droppedTiles;
+    c.evictions = _evictions;
+    c.nReads = _readLatency.count();
+    c.nUploads = _uploadTime.count();
+    c.read = _readLatency.total();
+    c.process = _processTime.total();
+    c.upload = _uploadTime.total();
+    return c;
+}
+
+const std::string& TileTelemetry::source() const {
+    return _source;
+}
+
+int TileTelemetry::queueDepth() const {
+    return _queueDepth;
+}
+
+uint64_t TileTelemetry::cacheHits() const {
+    return _cacheHits;
+}
+
+uint64_t TileTelemetry::cacheMisses() const {
+    return _cacheMisses;
+}
+
+uint64_t TileTelemetry::droppedTiles() const {
+    return _droppedTiles;
+}
+
+uint64_t TileTelemetry::evictions() const {
+    return _evictions;
+}
+
+const TileTelemetry::Histogram& TileTelemetry::readLatency() const {
+    return _readLatency;
+}
+
+const TileTelemetry::Histogram& TileTelemetry::processTime() const {
+    return _processTime;
+}
+
+const TileTelemetry::Histogram& TileTelemetry::uploadTime() const {
+    return _uploadTime;
+}
+
+} // namespace openspace::globebrowsing
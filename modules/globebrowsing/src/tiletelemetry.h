@@ -0,0 +1,142 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___TILETELEMETRY___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___TILETELEMETRY___H__
+
+#include <openspace/properties/propertyowner.h>
+
+#include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace openspace::globebrowsing {
+
+/**
+ * Counters and latency histograms of the tile loading pipeline of a single tile
+ * provider. All values are cumulative since the provider was created. In addition, the
+ * properties of this class show the averages and rates over the last second. All
+ * functions have to be called from the main thread; the timings of the reader threads
+ * are passed along with the RawTile instead.
+ */
+class TileTelemetry : public properties::PropertyOwner {
+public:
+    /**
+     * A histogram of durations. The upper bounds of the buckets are the powers of two
+     * from 1 ms to 1024 ms and the last bucket contains everything that is slower.
+     */
+    class Histogram {
+    public:
+        static constexpr int NumBuckets = 12;
+
+        void record(std::chrono::microseconds duration);
+
+        const std::array<uint64_t, NumBuckets>& buckets() const;
+        uint64_t count() const;
+        std::chrono::microseconds total() const;
+
+        /// Returns the upper bound of the \p bucket in milliseconds or 0 for the last one
+        static int bucketUpperBound(int bucket);
+
+    private:
+        std::array<uint64_t, NumBuckets> _buckets = {};
+        uint64_t _count = 0;
+        std::chrono::microseconds _total = std::chrono::microseconds(0);
+    };
+
+    /**
+     * \param source A description of where the tiles come from, which is used to
+     *        identify the telemetry of the provider
+     */
+    explicit TileTelemetry(std::string source);
+
+    void recordCacheLookup(bool isHit);
+    void recordLoadedTile(std::chrono::microseconds readDuration,
+        std::chrono::microseconds processDuration);
+    void recordUpload(std::chrono::microseconds duration);
+
+    /**
+     * Takes over the values that are counted elsewhere and updates the properties once
+     * every second. This should be called once per frame.
+     *
+     * \param queueDepth The number of tiles that are currently waiting to be loaded
+     * \param nDroppedTiles The total number of enqueued tiles that were dropped before
+     *        they were loaded
+     * \param nEvictions The total number of tiles that were evicted from the tile cache
+     */
+    void update(int queueDepth, uint64_t nDroppedTiles, uint64_t nEvictions);
+
+    const std::string& source() const;
+    int queueDepth() const;
+    uint64_t cacheHits() const;
+    uint64_t cacheMisses() const;
+    uint64_t droppedTiles() const;
+    uint64_t evictions() const;
+    const Histogram& readLatency() const;
+    const Histogram& processTime() const;
+    const Histogram& uploadTime() const;
+
+private:
+    struct Counters {
+        uint64_t cacheHits = 0;
+        uint64_t cacheMisses = 0;
+        uint64_t droppedTiles = 0;
+        uint64_t evictions = 0;
+        uint64_t nReads = 0;
+        uint64_t nUploads = 0;
+        std::chrono::microseconds read = std::chrono::microseconds(0);
+        std::chrono::microseconds process = std::chrono::microseconds(0);
+        std::chrono::microseconds upload = std::chrono::microseconds(0);
+    };
+    Counters counters() const;
+
+    const std::string _source;
+    int _queueDepth = 0;
+    uint64_t _cacheHits = 0;
+    uint64_t _cacheMisses = 0;
+    uint64_t _droppedTiles = 0;
+    uint64_t _evictions = 0;
+    Histogram _readLatency;
+    Histogram _processTime;
+    Histogram _uploadTime;
+
+    // The counters at the beginning of the window that the properties are showing
+    Counters _windowStart;
+    std::chrono::steady_clock::time_point _windowStartTime;
+
+    properties::IntProperty _queueDepthProperty;
+    properties::FloatProperty _readLatencyProperty;
+    properties::FloatProperty _processTimeProperty;
+    properties::FloatProperty _uploadTimeProperty;
+    properties::FloatProperty _cacheHitRateProperty;
+    properties::FloatProperty _evictionRateProperty;
+    properties::FloatProperty _dropRateProperty;
+};
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___TILETELEMETRY___H__
@@ -24,6 +24,8 @@
 
 #include <modules/globebrowsing/src/tiletextureinitdata.h>
 
+#include <modules/globebrowsing/src/blockcompression.h>
+
 namespace {
 
 size_t numberOfRasters(ghoul::opengl::Texture::Format format) {
@@ -77,7 +79,8 @@ unsigned int uniqueIdForTextureFormat(ghoul::opengl::Texture::Format textureForm
 openspace::globebrowsing::TileTextureInitData::HashKey calculateHashKey(
                                                              const glm::ivec3& dimensions,
                                              const ghoul::opengl::Texture::Format& format,
-                                                                     const GLenum& glType)
+                                                                    const GLenum& glType,
+             openspace::globebrowsing::TileTextureInitData::BlockCompression compression)
 {
     ghoul_assert(dimensions.x > 0, "Incorrect dimension");
     ghoul_assert(dimensions.y > 0, "Incorrect dimension");
@@ -93,6 +96,7 @@ openspace::globebrowsing::TileTextureInitData::HashKey calculateHashKey(
     res |= dimensions.y << 10;
     res |= static_cast<std::underlying_type_t<GLenum>>(glType) << (10 + 16);
     res |= formatId << (10 + 16 + 4);
+    res |= static_cast<uint64_t>(compression) << (10 + 16 + 4 + 8);
 
     return res;
 }
@@ -159,7 +163,8 @@ TileTextureInitData tileTextureInitData(layers::Group::ID id,
 
 TileTextureInitData::TileTextureInitData(size_t width, size_t height, GLenum type,
                                          ghoul::opengl::Texture::Format textureFormat,
-                                         ShouldAllocateDataOnCPU allocCpu)
+                                         ShouldAllocateDataOnCPU allocCpu,
+                                         BlockCompression compression)
     : dimensions(width, height, 1)
     , glType(type)
     , ghoulTextureFormat(textureFormat)
@@ -167,9 +172,14 @@ TileTextureInitData::TileTextureInitData(size_t width, size_t height, GLenum typ
     , bytesPerDatum(numberOfBytes(glType))
     , bytesPerPixel(nRasters * bytesPerDatum)
     , bytesPerLine(bytesPerPixel * width)
-    , totalNumBytes(bytesPerLine * height)
+    , totalNumBytes(
+        compression == BlockCompression::BC3 ?
+        bc3CompressedSize(glm::ivec2(dimensions)) :
+        bytesPerLine * height
+    )
     , shouldAllocateDataOnCPU(allocCpu)
-    , hashKey(calculateHashKey(dimensions, ghoulTextureFormat, glType))
+    , blockCompression(compression)
+    , hashKey(calculateHashKey(dimensions, ghoulTextureFormat, glType, blockCompression))
 {}
 
 TileTextureInitData TileTextureInitData::operator=(const TileTextureInitData& rhs) {
@@ -40,9 +40,19 @@ public:
     using HashKey = uint64_t;
     BooleanType(ShouldAllocateDataOnCPU);
 
+    /**
+     * The GPU block compression of the texture. Block compressed textures are uploaded
+     * with their complete mip chain and #totalNumBytes is the size of all mip levels.
+     */
+    enum class BlockCompression {
+        None = 0,
+        BC3
+    };
+
     TileTextureInitData(size_t width, size_t height, GLenum type,
         ghoul::opengl::Texture::Format textureFormat,
-        ShouldAllocateDataOnCPU allocCpu = ShouldAllocateDataOnCPU::No);
+        ShouldAllocateDataOnCPU allocCpu = ShouldAllocateDataOnCPU::No,
+        BlockCompression compression = BlockCompression::None);
 
     TileTextureInitData(const TileTextureInitData& original) = default;
     TileTextureInitData(TileTextureInitData&& original) = default;
@@ -61,6 +71,7 @@ public:
     const size_t bytesPerLine;
     const size_t totalNumBytes;
     const bool shouldAllocateDataOnCPU;
+    const BlockCompression blockCompression;
     const HashKey hashKey;
 };
 
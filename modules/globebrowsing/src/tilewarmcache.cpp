@@ -0,0 +1,386 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/tilewarmcache.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+
+namespace {
+    constexpr std::string_view _loggerCat = "TileWarmCache";
+
+    constexpr std::string_view PackFile = "tiles.pack";
+    constexpr std::string_view IndexFile = "tiles.index";
+
+    constexpr uint32_t IndexMagic = 0x4357534F; // OSWC
+    constexpr uint32_t IndexVersion = 1;
+
+    // If the pack file is larger than this fraction of the maximum size when the cache
+    // is closed, it is compacted to the second fraction of the maximum size so that the
+    // next session can add new tiles
+    constexpr double CompactionThreshold = 0.9;
+    constexpr double CompactionTarget = 0.75;
+
+    template <typename T>
+    void writeValue(std::ostream& stream, const T& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void readValue(std::istream& stream, T& value) {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+} // namespace
+
+namespace openspace::globebrowsing {
+
+size_t TileWarmCache::KeyHasher::operator()(const Key& key) const {
+    return static_cast<size_t>(key.dataset ^ (key.tile * 0x9E3779B97F4A7C15ULL));
+}
+
+TileWarmCache::TileWarmCache(std::filesystem::path directory, size_t maximumSize)
+    : _directory(std::move(directory))
+    , _maximumSize(maximumSize)
+{
+    ZoneScoped;
+
+    std::error_code ec;
+    std::filesystem::create_directories(_directory, ec);
+
+    loadIndex();
+
+    const std::filesystem::path pack = _directory / PackFile;
+    if (!_entries.empty()) {
+        _pack.open(pack, std::ios::in | std::ios::out | std::ios::binary);
+    }
+    if (!_pack.is_open()) {
+        _entries.clear();
+        _hotTiles.clear();
+        _packSize = 0;
+        _pack.open(
+            pack,
+            std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc
+        );
+    }
+    if (!_pack.is_open()) {
+        LERROR(fmt::format("Could not open tile warm cache {}", pack));
+        return;
+    }
+
+    LINFO(fmt::format(
+        "Opened tile warm cache with {} tiles ({} MB)",
+        _entries.size(), _packSize / (1024 * 1024)
+    ));
+}
+
+TileWarmCache::~TileWarmCache() {
+    ZoneScoped;
+
+    std::lock_guard lock(_mutex);
+    if (!_pack.is_open()) {
+        return;
+    }
+
+    if (_packSize > _maximumSize * CompactionThreshold) {
+        compact();
+    }
+    _pack.flush();
+    saveIndex();
+}
+
+uint64_t TileWarmCache::datasetIdentifier(std::string_view description) {
+    // 64-bit FNV-1a
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (char c : description) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+bool TileWarmCache::read(uint64_t dataset, const TileIndex& tileIndex,
+                         const TileTextureInitData& initData, std::byte* destination,
+                         TileMetaData& metaData)
+{
+    ZoneScoped;
+
+    std::lock_guard lock(_mutex);
+    const auto it = _entries.find(Key{ dataset, tileIndex.hashKey() });
+    if (it == _entries.end()) {
+        return false;
+    }
+
+    Entry& e = it->second;
+    if (e.initData != initData.hashKey || e.size != initData.totalNumBytes) {
+        return false;
+    }
+
+    _pack.clear();
+    _pack.seekg(e.offset);
+    _pack.read(reinterpret_cast<char*>(destination), e.size);
+    if (!_pack.good()) {
+        _pack.clear();
+        return false;
+    }
+
+    metaData = e.metaData;
+    e.lastSession = _session;
+    return true;
+}
+
+void TileWarmCache::write(uint64_t dataset, const TileIndex& tileIndex,
+                          const TileTextureInitData& initData, const std::byte* data,
+                          const TileMetaData& metaData)
+{
+    ZoneScoped;
+
+    std::lock_guard lock(_mutex);
+    const Key key = { dataset, tileIndex.hashKey() };
+    const size_t size = initData.totalNumBytes;
+    if (!_pack.is_open() || _packSize + size > _maximumSize || _entries.contains(key)) {
+        return;
+    }
+
+    _pack.clear();
+    _pack.seekp(_packSize);
+    _pack.write(reinterpret_cast<const char*>(data), size);
+    if (!_pack.good()) {
+        _pack.clear();
+        return;
+    }
+
+    Entry e;
+    e.x = tileIndex.x;
+    e.y = tileIndex.y;
+    e.level = tileIndex.level;
+    e.offset = _packSize;
+    e.size = size;
+    e.initData = initData.hashKey;
+    e.lastSession = _session;
+    e.metaData = metaData;
+    _entries[key] = e;
+    _packSize += size;
+}
+
+std::vector<TileIndex> TileWarmCache::hotTiles(uint64_t dataset) const {
+    std::lock_guard lock(_mutex);
+    const auto it = _hotTiles.find(dataset);
+    return it != _hotTiles.end() ? it->second : std::vector<TileIndex>();
+}
+
+void TileWarmCache::loadIndex() {
+    ZoneScoped;
+
+    std::ifstream in(_directory / IndexFile, std::ifstream::binary);
+    if (!in.good()) {
+        return;
+    }
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t session = 0;
+    uint64_t nEntries = 0;
+    readValue(in, magic);
+    readValue(in, version);
+    readValue(in, session);
+    readValue(in, nEntries);
+    if (!in.good() || magic != IndexMagic || version != IndexVersion) {
+        LWARNING("Discarding tile warm cache with an invalid index");
+        return;
+    }
+
+    std::error_code ec;
+    const uintmax_t packFileSize = std::filesystem::file_size(_directory / PackFile, ec);
+    if (ec) {
+        return;
+    }
+
+    for (uint64_t i = 0; i < nEntries; i++) {
+        Key key;
+        Entry e;
+        readValue(in, key.dataset);
+        readValue(in, e.x);
+        readValue(in, e.y);
+        readValue(in, e.level);
+        readValue(in, e.offset);
+        readValue(in, e.size);
+        readValue(in, e.initData);
+        readValue(in, e.lastSession);
+        readValue(in, e.metaData.maxValues);
+        readValue(in, e.metaData.minValues);
+        readValue(in, e.metaData.hasMissingData);
+        readValue(in, e.metaData.nValues);
+        if (!in.good()) {
+            LWARNING("Discarding tile warm cache with a truncated index");
+            _entries.clear();
+            _hotTiles.clear();
+            _packSize = 0;
+            return;
+        }
+
+        if (e.offset + e.size > packFileSize) {
+            // The pack file was not completely written in the previous session
+            continue;
+        }
+
+        const TileIndex tileIndex = TileIndex(e.x, e.y, e.level);
+        key.tile = tileIndex.hashKey();
+        if (e.lastSession == session) {
+            _hotTiles[key.dataset].push_back(tileIndex);
+        }
+        _packSize = std::max(_packSize, e.offset + e.size);
+        _entries[key] = e;
+    }
+
+    for (std::pair<const uint64_t, std::vector<TileIndex>>& p : _hotTiles) {
+        std::sort(
+            p.second.begin(),
+            p.second.end(),
+            [](const TileIndex& lhs, const TileIndex& rhs) {
+                return lhs.level < rhs.level;
+            }
+        );
+    }
+    _session = session + 1;
+}
+
+void TileWarmCache::saveIndex() {
+    ZoneScoped;
+
+    // Writing to a temporary file first prevents a crash from leaving a partially
+    // written index behind
+    const std::filesystem::path file = _directory / IndexFile;
+    std::filesystem::path tmp = file;
+    tmp += ".tmp";
+    std::ofstream out(tmp, std::ofstream::binary);
+    writeValue(out, IndexMagic);
+    writeValue(out, IndexVersion);
+    writeValue(out, _session);
+    writeValue(out, static_cast<uint64_t>(_entries.size()));
+    for (const std::pair<const Key, Entry>& p : _entries) {
+        const Entry& e = p.second;
+        writeValue(out, p.first.dataset);
+        writeValue(out, e.x);
+        writeValue(out, e.y);
+        writeValue(out, e.level);
+        writeValue(out, e.offset);
+        writeValue(out, e.size);
+        writeValue(out, e.initData);
+        writeValue(out, e.lastSession);
+        writeValue(out, e.metaData.maxValues);
+        writeValue(out, e.metaData.minValues);
+        writeValue(out, e.metaData.hasMissingData);
+        writeValue(out, e.metaData.nValues);
+    }
+    out.close();
+
+    std::error_code ec;
+    if (out.good()) {
+        std::filesystem::rename(tmp, file, ec);
+    }
+    if (!out.good() || ec) {
+        LWARNING(fmt::format("Failed to write tile warm cache index {}", file));
+        std::filesystem::remove(tmp, ec);
+    }
+}
+
+void TileWarmCache::compact() {
+    ZoneScoped;
+
+    // The tiles that were used most recently are kept, and of those the ones with the
+    // lowest levels as they are needed first when approaching a globe
+    using Item = std::pair<const Key, Entry>;
+    std::vector<Item*> order;
+    order.reserve(_entries.size());
+    for (Item& p : _entries) {
+        order.push_back(&p);
+    }
+    std::sort(
+        order.begin(),
+        order.end(),
+        [](const Item* lhs, const Item* rhs) {
+            if (lhs->second.lastSession != rhs->second.lastSession) {
+                return lhs->second.lastSession > rhs->second.lastSession;
+            }
+            return lhs->second.level < rhs->second.level;
+        }
+    );
+
+    const std::filesystem::path file = _directory / PackFile;
+    std::filesystem::path tmp = file;
+    tmp += ".tmp";
+    std::ofstream out(tmp, std::ofstream::binary);
+
+    const uint64_t target = static_cast<uint64_t>(_maximumSize * CompactionTarget);
+    std::unordered_map<Key, Entry, KeyHasher> entries;
+    std::vector<char> buffer;
+    uint64_t offset = 0;
+    for (const Item* p : order) {
+        Entry e = p->second;
+        if (offset + e.size > target) {
+            break;
+        }
+
+        buffer.resize(e.size);
+        _pack.clear();
+        _pack.seekg(e.offset);
+        _pack.read(buffer.data(), e.size);
+        if (!_pack.good()) {
+            continue;
+        }
+        out.write(buffer.data(), e.size);
+
+        e.offset = offset;
+        offset += e.size;
+        entries[p->first] = e;
+    }
+    out.close();
+
+    std::error_code ec;
+    if (!out.good()) {
+        LWARNING(fmt::format("Failed to compact tile warm cache {}", file));
+        std::filesystem::remove(tmp, ec);
+        return;
+    }
+
+    _pack.close();
+    std::filesystem::rename(tmp, file, ec);
+    if (ec) {
+        LWARNING(fmt::format("Failed to compact tile warm cache {}", file));
+        std::filesystem::remove(tmp, ec);
+        _pack.open(file, std::ios::in | std::ios::out | std::ios::binary);
+        return;
+    }
+
+    _pack.open(file, std::ios::in | std::ios::out | std::ios::binary);
+    LINFO(fmt::format(
+        "Compacted tile warm cache from {} to {} tiles", _entries.size(), entries.size()
+    ));
+    _entries = std::move(entries);
+    _packSize = offset;
+}
+
+} // namespace openspace::globebrowsing
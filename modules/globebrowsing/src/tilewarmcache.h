@@ -0,0 +1,143 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___TILEWARMCACHE___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___TILEWARMCACHE___H__
+
+#include <modules/globebrowsing/src/basictypes.h>
+#include <modules/globebrowsing/src/tileindex.h>
+#include <modules/globebrowsing/src/tiletextureinitdata.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace openspace::globebrowsing {
+
+/**
+ * A persistent cache of finished tiles that is shared by all tile providers and that is
+ * kept between sessions. The pixels of the tiles are stored after all processing, such
+ * that they can be uploaded without any further work, and are appended to a single pack
+ * file. The index of the pack file is kept in memory and written to disk when the cache
+ * is destroyed. The tiles are identified by a dataset identifier that is stable across
+ * sessions and their TileIndex.
+ *
+ * Tiles are only added as long as the pack file is smaller than the maximum size. When
+ * the cache is destroyed with a pack file that is close to the maximum size, the tiles
+ * that have not been used for the most sessions are removed from it.
+ *
+ * All functions can be called from any thread.
+ */
+class TileWarmCache {
+public:
+    /**
+     * Opens the cache stored in the \p directory, which is created if it does not exist.
+     * An invalid or missing index discards all tiles of the cache.
+     *
+     * \param directory The directory that contains the pack and the index file
+     * \param maximumSize The maximum number of bytes of tile data in the pack file
+     */
+    TileWarmCache(std::filesystem::path directory, size_t maximumSize);
+    ~TileWarmCache();
+
+    /**
+     * Returns the identifier for a dataset with the \p description, which has to contain
+     * everything that influences the pixels of the tiles. Unlike std::hash, the returned
+     * value is the same in every session.
+     */
+    static uint64_t datasetIdentifier(std::string_view description);
+
+    /**
+     * Reads the tile with the \p tileIndex of the \p dataset into the \p destination,
+     * which has to be large enough for a tile described by the \p initData. Returns
+     * `false` if the tile is not in the cache or was stored with different texture
+     * settings.
+     */
+    bool read(uint64_t dataset, const TileIndex& tileIndex,
+        const TileTextureInitData& initData, std::byte* destination,
+        TileMetaData& metaData);
+
+    /**
+     * Adds the tile with the \p tileIndex of the \p dataset to the cache, unless it
+     * already contains the tile or has reached its maximum size.
+     */
+    void write(uint64_t dataset, const TileIndex& tileIndex,
+        const TileTextureInitData& initData, const std::byte* data,
+        const TileMetaData& metaData);
+
+    /**
+     * Returns the tiles of the \p dataset that were used in the previous session, the
+     * tiles with the lowest level first.
+     */
+    std::vector<TileIndex> hotTiles(uint64_t dataset) const;
+
+private:
+    struct Key {
+        uint64_t dataset;
+        TileIndex::TileHashKey tile;
+
+        bool operator==(const Key& rhs) const = default;
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint8_t level = 0;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        TileTextureInitData::HashKey initData = 0;
+        // The last session in which the tile was read or written
+        uint32_t lastSession = 0;
+        TileMetaData metaData;
+    };
+
+    void loadIndex();
+    void saveIndex();
+    void compact();
+
+    const std::filesystem::path _directory;
+    const size_t _maximumSize;
+
+    std::unordered_map<Key, Entry, KeyHasher> _entries;
+    // dataset -> tiles used in the previous session
+    std::map<uint64_t, std::vector<TileIndex>> _hotTiles;
+    uint32_t _session = 1;
+
+    std::fstream _pack;
+    uint64_t _packSize = 0;
+    mutable std::mutex _mutex;
+};
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___TILEWARMCACHE___H__
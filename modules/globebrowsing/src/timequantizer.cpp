@@ -369,6 +369,10 @@ void TimeQuantizer::setResolution(const std::string& resolutionString) {
     verifyStartTimeRestrictions();
 }
 
+double TimeQuantizer::resolution() const {
+    return _resolution;
+}
+
 void TimeQuantizer::verifyStartTimeRestrictions() {
     // If monthly time resolution then restrict to 28 days so every month is consistent
     int dayUpperLimit;
@@ -646,4 +650,29 @@ std::vector<std::string> TimeQuantizer::quantized(Time& start, Time& end) {
     return result;
 }
 
+std::vector<double> TimeQuantizer::quantizedTimes(size_t maxCount) const {
+    ZoneScoped;
+
+    const double end = Time::convertTime(std::string(_timerange.end()));
+
+    std::vector<double> result;
+    DateTime itr = DateTime(_timerange.start());
+    double t = itr.J2000();
+    while (t <= end) {
+        if (result.size() == maxCount) {
+            return std::vector<double>();
+        }
+        result.push_back(t);
+
+        itr.incrementOnce(static_cast<int>(_resolutionValue), _resolutionUnit);
+        const double next = itr.J2000();
+        if (next <= t) {
+            // A resolution of 0 would otherwise never reach the end of the range
+            break;
+        }
+        t = next;
+    }
+    return result;
+}
+
 } // namespace openspace::globebrowsing
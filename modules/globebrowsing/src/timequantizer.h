@@ -328,6 +328,12 @@ public:
     */
     double parseTimeResolutionStr(const std::string& resolutionStr);
 
+    /**
+    * Returns the time resolution in seconds. Resolutions given in months are
+    * approximated with months that are 30.4 days long.
+    */
+    double resolution() const;
+
     /**
     * Quantizes a OpenSpace Time into descrete values. If the provided Time \p t is
     * outside the time range, it will be clamped to the the time range.
@@ -348,6 +354,17 @@ public:
     */
     std::vector<std::string> quantized(Time& start, Time& end);
 
+    /**
+    * Returns the J2000 seconds of all valid quantized times in the time range in
+    * ascending order, which are the values that #quantize maps the times inside the
+    * range onto. As the list grows linearly with the length of the time range, an empty
+    * list is returned if the range contains more than \p maxCount quantized times.
+    *
+    * \param maxCount The maximum number of quantized times that are computed
+    * \return The sorted list of quantized times or an empty list if there are too many
+    */
+    std::vector<double> quantizedTimes(size_t maxCount) const;
+
 private:
     void verifyStartTimeRestrictions();
     void verifyResolutionRestrictions(const int value, const char unit);
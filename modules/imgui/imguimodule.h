@@ -29,6 +29,7 @@
 
 #include <modules/imgui/include/guiactioncomponent.h>
 #include <modules/imgui/include/guifilepathcomponent.h>
+#include <modules/imgui/include/guiframeprofilercomponent.h>
 #include <modules/imgui/include/guigibscomponent.h>
 #include <modules/imgui/include/guiglobebrowsingcomponent.h>
 #include <modules/imgui/include/guihelpcomponent.h>
@@ -92,6 +93,7 @@ private:
     gui::GuiGIBSComponent _gibs;
     gui::GuiMissionComponent _mission;
     gui::GuiMemoryComponent _memoryComponent;
+    gui::GuiFrameProfilerComponent _frameProfiler;
     gui::GuiSceneComponent _sceneView;
     gui::GuiFilePathComponent _filePath;
     gui::GuiHelpComponent _help;
@@ -100,7 +102,7 @@ private:
     properties::FloatProperty _helpTextDelay;
 
     // The ordering of this array determines the order of components in the in-game menu
-    static constexpr int nComponents = 13;
+    static constexpr int nComponents = 14;
     std::array<gui::GuiComponent*, nComponents> _components = {
         &_sceneProperty,
         &_property,
@@ -112,6 +114,7 @@ private:
         &_gibs,
         &_mission,
         &_memoryComponent,
+        &_frameProfiler,
         &_sceneView,
         &_filePath,
         &_help
@@ -22,40 +22,20 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
-#ifndef __OPENSPACE_MODULE_VOLUME___LRUCACHE___H__
-#define __OPENSPACE_MODULE_VOLUME___LRUCACHE___H__
+#ifndef __OPENSPACE_MODULE_IMGUI___GUIFRAMEPROFILERCOMPONENT___H__
+#define __OPENSPACE_MODULE_IMGUI___GUIFRAMEPROFILERCOMPONENT___H__
 
-#include <ghoul/glm.h>
-#include <list>
-#include <iterator>
+#include <modules/imgui/include/guicomponent.h>
 
-namespace openspace::volume {
+namespace openspace::gui {
 
-template<
-    typename KeyType,
-    typename ValueType,
-    template<typename...> class ContainerType
->
-class LruCache {
+class GuiFrameProfilerComponent : public GuiComponent {
 public:
-    LruCache(size_t capacity);
+    GuiFrameProfilerComponent();
 
-    bool has(const KeyType& key);
-    void set(const KeyType& key, ValueType value);
-    ValueType& use(const KeyType& key);
-    ValueType& get(const KeyType& key);
-    void evict();
-    size_t capacity() const;
-
-private:
-    void insert(const KeyType& key, const ValueType& value);
-    ContainerType<
-        KeyType, std::pair<ValueType, typename std::list<KeyType>::iterator>
-    > _cache;
-    std::list<KeyType> _tracker;
-    size_t _capacity;
+    void render() override;
 };
 
-} // namespace openspace::volume
+} // namespace openspace::gui
 
-#endif // __OPENSPACE_MODULE_VOLUME___LRUCACHE___H__
+#endif // __OPENSPACE_MODULE_IMGUI___GUIFRAMEPROFILERCOMPONENT___H__
@@ -31,6 +31,7 @@
 #include <openspace/properties/scalar/boolproperty.h>
 #include <ghoul/misc/boolean.h>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -41,12 +42,15 @@ namespace openspace::properties {
 
 namespace openspace::gui {
 
+struct PropertyTreeNode;
+
 class GuiPropertyComponent : public GuiComponent {
 public:
     BooleanType(UseTreeLayout);
 
     GuiPropertyComponent(std::string identifier, std::string guiName,
         UseTreeLayout useTree = UseTreeLayout::No);
+    ~GuiPropertyComponent() override;
 
     void setPropertyOwners(std::vector<properties::PropertyOwner*> propertyOwners);
     void setPropertyOwnerFunction(
@@ -58,11 +62,46 @@ protected:
     void renderPropertyOwner(properties::PropertyOwner* owner);
     void renderProperty(properties::Property* prop, properties::PropertyOwner* owner);
 
+    /**
+     * Sorts the \p owners and builds the tree of their GUI paths, unless the owners,
+     * their names, and the layout settings are the same as the last time.
+     */
+    void updateLayout(std::vector<properties::PropertyOwner*> owners,
+        bool showHiddenNodes);
+
+    /**
+     * Renders the #_layoutOwners with headers, skipping the closed headers that are not
+     * visible in the window.
+     */
+    void renderClippedOwners(
+        const std::function<void(properties::PropertyOwner*)>& renderFunc);
+
     std::vector<properties::PropertyOwner*> _propertyOwners;
     std::function<std::vector<properties::PropertyOwner*>()> _propertyOwnerFunction;
 
     properties::BoolProperty _useTreeLayout;
     properties::StringListProperty _treeOrdering;
+
+private:
+    struct LayoutKey {
+        properties::PropertyOwner* owner = nullptr;
+        std::string guiName;
+        std::string guiPath;
+        bool isHidden = false;
+
+        bool operator==(const LayoutKey&) const = default;
+    };
+
+    // The state from which the current layout was built
+    std::vector<LayoutKey> _layoutKeys;
+    std::vector<std::string> _layoutOrdering;
+    bool _layoutUsesTree = false;
+    bool _layoutShowsHidden = false;
+
+    /// The owners that are shown outside of the tree, in the order they are shown in
+    std::vector<properties::PropertyOwner*> _layoutOwners;
+    /// The tree of GUI paths, if the tree layout is used and the owners have GUI paths
+    std::unique_ptr<PropertyTreeNode> _tree;
 };
 
 } // namespace openspace::gui
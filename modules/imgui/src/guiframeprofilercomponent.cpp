@@ -0,0 +1,104 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/imgui/include/guiframeprofilercomponent.h>
+
+#include <modules/imgui/include/imgui_include.h>
+#include <openspace/engine/globals.h>
+#include <openspace/util/frameprofiler.h>
+#include <ghoul/filesystem/filesystem.h>
+
+namespace {
+    const ImVec2 Size = ImVec2(500, 500);
+
+    void renderPhases(const std::vector<openspace::FrameProfiler::PhaseStatistics>& stats,
+                      bool isGpu)
+    {
+        ImGui::Columns(4);
+        ImGui::Text("%s", "Phase");
+        ImGui::NextColumn();
+        ImGui::Text("%s", "Last (ms)");
+        ImGui::NextColumn();
+        ImGui::Text("%s", "Average (ms)");
+        ImGui::NextColumn();
+        ImGui::Text("%s", "Max (ms)");
+        ImGui::NextColumn();
+        ImGui::Separator();
+
+        for (const openspace::FrameProfiler::PhaseStatistics& s : stats) {
+            if (s.isGpu != isGpu) {
+                continue;
+            }
+
+            ImGui::Text("%*s%s", 2 * s.depth, "", s.name);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", s.lastMs);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", s.averageMs);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", s.maxMs);
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+    }
+} // namespace
+
+namespace openspace::gui {
+
+GuiFrameProfilerComponent::GuiFrameProfilerComponent()
+    : GuiComponent("FrameProfiler", "Frame Profiler")
+{}
+
+void GuiFrameProfilerComponent::render() {
+    ImGui::SetNextWindowCollapsed(_isCollapsed);
+
+    bool v = _isEnabled;
+    ImGui::SetNextWindowSize(Size, ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowBgAlpha(0.75f);
+    ImGui::Begin("Frame Profiler", &v);
+    _isEnabled = v;
+    _isCollapsed = ImGui::IsWindowCollapsed();
+
+    FrameProfiler& profiler = *global::frameProfiler;
+    bool isRecording = profiler.isEnabled();
+    if (ImGui::Checkbox("Record", &isRecording)) {
+        profiler.setEnabled(isRecording);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Save Chrome Trace")) {
+        profiler.saveChromeTrace(absPath("${TEMPORARY}/frameprofile.json"));
+    }
+
+    const std::vector<FrameProfiler::PhaseStatistics> stats = profiler.phaseStatistics();
+    if (ImGui::CollapsingHeader("CPU", ImGuiTreeNodeFlags_DefaultOpen)) {
+        renderPhases(stats, false);
+    }
+    if (ImGui::CollapsingHeader("GPU", ImGuiTreeNodeFlags_DefaultOpen)) {
+        renderPhases(stats, true);
+    }
+
+    ImGui::End();
+}
+
+} // namespace openspace::gui
@@ -26,6 +26,8 @@
 
 #include <modules/imgui/include/imgui_include.h>
 #include <openspace/engine/globals.h>
+#include <openspace/rendering/memoryaccounting.h>
+#include <openspace/rendering/renderengine.h>
 #include <openspace/util/memorymanager.h>
 
 namespace {
@@ -68,8 +70,28 @@ void GuiMemoryComponent::render() {
     ImGui::Text("%s", "Persistent Memory Pool");
     renderMemoryPoolInformation(global::memoryManager->PersistentMemory);
 
-    //ImGui::Text("%s", "Temporary Memory Pool");
-    //renderMemoryPoolInformation(global::memoryManager.TemporaryMemory);
+    ImGui::Text("%s", "Temporary Memory");
+    const FrameArena& temporary = global::memoryManager->TemporaryMemory;
+    ImGui::Text("  Used: %.2f kiB", temporary.usedBytes() / 1024.f);
+    ImGui::Text("  High-water mark: %.2f kiB", temporary.highWaterMark() / 1024.f);
+    ImGui::Text("  Capacity: %.2f kiB", temporary.capacity() / 1024.f);
+
+    ImGui::Text("%s", "Renderables (GPU buffers / GPU textures / CPU data)");
+    const std::vector<MemoryAccounting::Entry>& entries =
+        global::renderEngine->memoryAccounting().entries();
+    for (const MemoryAccounting::Entry& e : entries) {
+        const Renderable::MemoryUsage& u = e.usage;
+        if (u.gpuBuffers == 0 && u.gpuTextures == 0 && u.cpuData == 0) {
+            continue;
+        }
+        ImGui::Text(
+            "  %s: %.2f / %.2f / %.2f MiB",
+            e.identifier.c_str(),
+            u.gpuBuffers / (1024.f * 1024.f),
+            u.gpuTextures / (1024.f * 1024.f),
+            u.cpuData / (1024.f * 1024.f)
+        );
+    }
     ImGui::End();
 }
 
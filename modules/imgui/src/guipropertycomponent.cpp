@@ -31,9 +31,37 @@
 #include <openspace/scene/scenegraphnode.h>
 #include <ghoul/misc/misc.h>
 #include <algorithm>
+#include <iterator>
 
 //#define Debugging_ImGui_TreeNode_Indices
 
+namespace openspace::gui {
+
+struct PropertyTreeNode {
+    explicit PropertyTreeNode(std::string p)
+        : path(std::move(p))
+#ifdef Debugging_ImGui_TreeNode_Indices
+        , index(nextIndex++)
+#endif // Debugging_ImGui_TreeNode_Indices
+    {}
+
+    std::string path;
+    std::vector<std::unique_ptr<PropertyTreeNode>> children;
+    std::vector<SceneGraphNode*> nodes;
+#ifdef Debugging_ImGui_TreeNode_Indices
+    int index = 0;
+    static int nextIndex;
+#endif // Debugging_ImGui_TreeNode_Indices
+};
+
+#ifdef Debugging_ImGui_TreeNode_Indices
+
+int PropertyTreeNode::nextIndex = 0;
+
+#endif // Debugging_ImGui_TreeNode_Indices
+
+} // namespace openspace::gui
+
 namespace {
     const ImVec2 Size = ImVec2(350, 500);
 
@@ -57,20 +85,30 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
-    int nVisibleProperties(const std::vector<openspace::properties::Property*>& props)
+    // Returns whether the owner or any of its sub owners has a property that is visible
+    // with the current visibility setting. Unlike counting the properties returned by
+    // propertiesRecursive, this doesn't allocate and stops at the first visible property
+    bool hasVisibleProperties(const openspace::properties::PropertyOwner* owner,
+                              openspace::properties::Property::Visibility filter)
     {
-        using Visibility = openspace::properties::Property::Visibility;
-        Visibility visibilityFilter = openspace::global::openSpaceEngine->visibility();
-
-        return static_cast<int>(std::count_if(
-            props.begin(),
-            props.end(),
-            [visibilityFilter](openspace::properties::Property* p) {
-                using V = openspace::properties::Property::Visibility;
-                return static_cast<std::underlying_type_t<V>>(visibilityFilter) >=
-                       static_cast<std::underlying_type_t<V>>(p->visibility());
+        using V = openspace::properties::Property::Visibility;
+        const auto f = static_cast<std::underlying_type_t<V>>(filter);
+        for (const openspace::properties::Property* p : owner->properties()) {
+            if (f >= static_cast<std::underlying_type_t<V>>(p->visibility())) {
+                return true;
+            }
+        }
+        for (const openspace::properties::PropertyOwner* o : owner->propertySubOwners()) {
+            if (hasVisibleProperties(o, filter)) {
+                return true;
             }
-        ));
+        }
+        return false;
+    }
+
+    bool hasVisibleProperties(const openspace::properties::PropertyOwner* owner) {
+        using namespace openspace;
+        return hasVisibleProperties(owner, global::openSpaceEngine->visibility());
     }
 
     void renderTooltip(openspace::properties::PropertyOwner* propOwner) {
@@ -82,31 +120,9 @@ namespace {
         }
     }
 
-    struct TreeNode {
-        explicit TreeNode(std::string p)
-            : path(std::move(p))
-#ifdef Debugging_ImGui_TreeNode_Indices
-            , index(nextIndex++)
-#endif // Debugging_ImGui_TreeNode_Indices
-        {}
-
-        std::string path;
-        std::vector<std::unique_ptr<TreeNode>> children;
-        std::vector<openspace::SceneGraphNode*> nodes;
-#ifdef Debugging_ImGui_TreeNode_Indices
-        int index = 0;
-        static int nextIndex;
-#endif // Debugging_ImGui_TreeNode_Indices
-
-    };
-
-#ifdef Debugging_ImGui_TreeNode_Indices
-
-    int TreeNode::nextIndex = 0;
+    using openspace::gui::PropertyTreeNode;
 
-#endif // Debugging_ImGui_TreeNode_Indices
-
-    void addPathToTree(TreeNode& node, const std::vector<std::string>& path,
+    void addPathToTree(PropertyTreeNode& node, const std::vector<std::string>& path,
                        openspace::SceneGraphNode* owner)
     {
         if (path.empty()) {
@@ -119,19 +135,19 @@ namespace {
         const auto it = std::find_if(
             node.children.begin(),
             node.children.end(),
-            [p = *path.begin()](const std::unique_ptr<TreeNode>& c) {
+            [p = *path.begin()](const std::unique_ptr<PropertyTreeNode>& c) {
                 return c->path == p;
             }
         );
 
-        TreeNode* n;
+        PropertyTreeNode* n;
         if (it != node.children.end()) {
             // We have a child, so we use it
             n = it->get();
         }
         else {
             // We don't have a child, so we must generate it
-            auto newNode = std::make_unique<TreeNode>(*path.begin());
+            auto newNode = std::make_unique<PropertyTreeNode>(*path.begin());
             n = newNode.get();
             node.children.push_back(std::move(newNode));
         }
@@ -144,28 +160,28 @@ namespace {
         );
     }
 
-    void simplifyTree(TreeNode& node) {
+    void simplifyTree(PropertyTreeNode& node) {
         // Merging consecutive nodes if they only have a single child
 
-        for (const std::unique_ptr<TreeNode>& c : node.children) {
+        for (const std::unique_ptr<PropertyTreeNode>& c : node.children) {
             simplifyTree(*c);
         }
 
         if ((node.children.size() == 1) && (node.nodes.empty())) {
             node.path = node.path + "/" + node.children[0]->path;
             node.nodes = std::move(node.children[0]->nodes);
-            std::vector<std::unique_ptr<TreeNode>> children = std::move(
+            std::vector<std::unique_ptr<PropertyTreeNode>> children = std::move(
                 node.children[0]->children
             );
             node.children = std::move(children);
         }
     }
 
-    void renderTree(const TreeNode& node,
+    void renderTree(const PropertyTreeNode& node,
             const std::function<void (openspace::properties::PropertyOwner*)>& renderFunc)
     {
         if (node.path.empty() || ImGui::TreeNode(node.path.c_str())) {
-            for (const std::unique_ptr<TreeNode>& c : node.children) {
+            for (const std::unique_ptr<PropertyTreeNode>& c : node.children) {
                 renderTree(*c, renderFunc);
             }
 
@@ -192,6 +208,8 @@ GuiPropertyComponent::GuiPropertyComponent(std::string identifier, std::string g
     addProperty(_treeOrdering);
 }
 
+GuiPropertyComponent::~GuiPropertyComponent() = default;
+
 void GuiPropertyComponent::setPropertyOwners(
                                    std::vector<properties::PropertyOwner*> propertyOwners)
 {
@@ -207,20 +225,27 @@ void GuiPropertyComponent::setPropertyOwnerFunction(
 void GuiPropertyComponent::renderPropertyOwner(properties::PropertyOwner* owner) {
     using namespace properties;
 
-    if (owner->propertiesRecursive().empty()) {
+    const Property::Visibility visibility = global::openSpaceEngine->visibility();
+    if (!hasVisibleProperties(owner, visibility)) {
         return;
     }
 
-    const int nThisProperty = nVisibleProperties(owner->properties());
+    const bool hasOwnProperties = std::any_of(
+        owner->properties().begin(),
+        owner->properties().end(),
+        [visibility](Property* p) {
+            using V = Property::Visibility;
+            return static_cast<std::underlying_type_t<V>>(visibility) >=
+                   static_cast<std::underlying_type_t<V>>(p->visibility());
+        }
+    );
     ImGui::PushID(owner->identifier().c_str());
     const std::vector<PropertyOwner*>& subOwners = owner->propertySubOwners();
     for (PropertyOwner* subOwner : subOwners) {
-        const std::vector<Property*>& properties = subOwner->propertiesRecursive();
-        int count = nVisibleProperties(properties);
-        if (count == 0) {
+        if (!hasVisibleProperties(subOwner, visibility)) {
             continue;
         }
-        if (subOwners.size() == 1 && (nThisProperty == 0)) {
+        if (subOwners.size() == 1 && !hasOwnProperties) {
             renderPropertyOwner(subOwner);
         }
         else {
@@ -272,21 +297,35 @@ void GuiPropertyComponent::renderPropertyOwner(properties::PropertyOwner* owner)
     ImGui::PopID();
 }
 
-void GuiPropertyComponent::render() {
-    ImGui::SetNextWindowCollapsed(_isCollapsed);
-
-    bool v = _isEnabled;
-    ImGui::SetNextWindowSize(Size, ImGuiCond_FirstUseEver);
-    ImGui::SetNextWindowBgAlpha(0.75f);
-    ImGui::Begin(guiName().c_str(), &v);
-    _isEnabled = v;
-    bool showHiddenNode = openspace::global::openSpaceEngine->showHiddenSceneGraphNodes();
-
-    _isCollapsed = ImGui::IsWindowCollapsed();
+void GuiPropertyComponent::updateLayout(std::vector<properties::PropertyOwner*> owners,
+                                        bool showHiddenNodes)
+{
     using namespace properties;
 
-    std::vector<properties::PropertyOwner*> owners =
-        _propertyOwnerFunction ? _propertyOwnerFunction() : _propertyOwners;
+    // The sorting and the tree only depend on the owners and their names and GUI paths,
+    // which rarely change, so they are only rebuilt if any of those have changed
+    std::vector<LayoutKey> keys;
+    keys.reserve(owners.size());
+    for (PropertyOwner* owner : owners) {
+        SceneGraphNode* node = dynamic_cast<SceneGraphNode*>(owner);
+        keys.push_back({
+            .owner = owner,
+            .guiName = owner->guiName(),
+            .guiPath = node ? node->guiPath() : "",
+            .isHidden = node && node->hasGuiHintHidden()
+        });
+    }
+    const std::vector<std::string>& ordering = _treeOrdering;
+    const bool isUnchanged = keys == _layoutKeys && ordering == _layoutOrdering &&
+        _useTreeLayout == _layoutUsesTree && showHiddenNodes == _layoutShowsHidden;
+    if (isUnchanged) {
+        return;
+    }
+    _layoutKeys = std::move(keys);
+    _layoutOrdering = ordering;
+    _layoutUsesTree = _useTreeLayout;
+    _layoutShowsHidden = showHiddenNodes;
+    _tree = nullptr;
 
     std::sort(
         owners.begin(),
@@ -308,7 +347,6 @@ void GuiPropertyComponent::render() {
         // Sort:
         // if guigrouping, sort by name and shortest first, but respect the user specified
         // ordering then all w/o guigroup
-        const std::vector<std::string>& ordering = _treeOrdering;
         std::stable_sort(
             owners.begin(),
             owners.end(),
@@ -367,37 +405,8 @@ void GuiPropertyComponent::render() {
                              (dynamic_cast<SceneGraphNode*>(*owners.begin()) &&
                        dynamic_cast<SceneGraphNode*>(*owners.begin())->guiPath().empty());
 
-    auto renderProp = [this, owners](properties::PropertyOwner* pOwner) {
-        const int count = nVisibleProperties(pOwner->propertiesRecursive());
-
-        if (count == 0) {
-            return;
-        }
-
-        auto header = [&owners, &pOwner]() -> bool {
-            if (owners.size() > 1) {
-                // Create a header in case we have multiple owners
-                return ImGui::CollapsingHeader(pOwner->guiName().c_str());
-            }
-            else if (!pOwner->identifier().empty()) {
-                // If the owner has a name, print it first
-                ImGui::Text("%s", pOwner->guiName().c_str());
-                ImGui::Spacing();
-                return true;
-            }
-            else {
-                // Otherwise, do nothing
-                return true;
-            }
-        };
-
-        if (header()) {
-            renderPropertyOwner(pOwner);
-        }
-    };
-
     if (!_useTreeLayout || noGuiGroups) {
-        if (!showHiddenNode) {
+        if (!showHiddenNodes) {
             // Remove all of the nodes that we want hidden first
             owners.erase(
                 std::remove_if(
@@ -411,15 +420,14 @@ void GuiPropertyComponent::render() {
                 owners.end()
             );
         }
-        std::for_each(owners.begin(), owners.end(), renderProp);
     }
     else { // _useTreeLayout && gui groups exist
-        TreeNode root("");
+        _tree = std::make_unique<PropertyTreeNode>("");
 
         for (properties::PropertyOwner* pOwner : owners) {
             // We checked above that pOwner is a SceneGraphNode
             SceneGraphNode* nOwner = static_cast<SceneGraphNode*>(pOwner);
-            if (!showHiddenNode && nOwner->hasGuiHintHidden()) {
+            if (!showHiddenNodes && nOwner->hasGuiHintHidden()) {
                 continue;
             }
             const std::string gui = nOwner->guiPath();
@@ -428,30 +436,131 @@ void GuiPropertyComponent::render() {
                 break;
             }
             std::vector<std::string> paths = ghoul::tokenizeString(gui.substr(1), '/');
-            addPathToTree(root, paths, nOwner);
+            addPathToTree(*_tree, paths, nOwner);
         }
 
-        simplifyTree(root);
+        simplifyTree(*_tree);
 
-        renderTree(root, renderProp);
+        // Only the owners without a GUI path are shown outside of the tree
+        owners.erase(
+            std::remove_if(
+                owners.begin(),
+                owners.end(),
+                [](properties::PropertyOwner* p) {
+                    return !static_cast<SceneGraphNode*>(p)->guiPath().empty();
+                }
+            ),
+            owners.end()
+        );
+    }
+    _layoutOwners = std::move(owners);
+}
 
-        ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 20.f);
+void GuiPropertyComponent::render() {
+    ImGui::SetNextWindowCollapsed(_isCollapsed);
 
-        for (properties::PropertyOwner* pOwner : owners) {
-            // We checked above that pOwner is a SceneGraphNode
-            SceneGraphNode* nOwner = static_cast<SceneGraphNode*>(pOwner);
+    bool v = _isEnabled;
+    ImGui::SetNextWindowSize(Size, ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowBgAlpha(0.75f);
+    ImGui::Begin(guiName().c_str(), &v);
+    _isEnabled = v;
+    bool showHiddenNode = openspace::global::openSpaceEngine->showHiddenSceneGraphNodes();
 
-            if (!nOwner->guiPath().empty()) {
-                continue;
+    _isCollapsed = ImGui::IsWindowCollapsed();
+    using namespace properties;
+
+    std::vector<properties::PropertyOwner*> owners =
+        _propertyOwnerFunction ? _propertyOwnerFunction() : _propertyOwners;
+    const size_t nOwners = owners.size();
+    updateLayout(std::move(owners), showHiddenNode);
+
+    auto renderProp = [this, nOwners](properties::PropertyOwner* pOwner) {
+        if (!hasVisibleProperties(pOwner)) {
+            return;
+        }
+
+        auto header = [nOwners, &pOwner]() -> bool {
+            if (nOwners > 1) {
+                // Create a header in case we have multiple owners
+                return ImGui::CollapsingHeader(pOwner->guiName().c_str());
             }
+            else if (!pOwner->identifier().empty()) {
+                // If the owner has a name, print it first
+                ImGui::Text("%s", pOwner->guiName().c_str());
+                ImGui::Spacing();
+                return true;
+            }
+            else {
+                // Otherwise, do nothing
+                return true;
+            }
+        };
 
-            renderProp(pOwner);
+        if (header()) {
+            renderPropertyOwner(pOwner);
         }
+    };
+
+    if (_tree) {
+        renderTree(*_tree, renderProp);
+        ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 20.f);
+    }
+
+    if (nOwners <= 1) {
+        std::for_each(_layoutOwners.begin(), _layoutOwners.end(), renderProp);
+    }
+    else {
+        renderClippedOwners(renderProp);
     }
 
     ImGui::End();
 }
 
+void GuiPropertyComponent::renderClippedOwners(
+                       const std::function<void(properties::PropertyOwner*)>& renderFunc)
+{
+    using namespace properties;
+
+    // Owners without visible properties are skipped, so that all closed headers have the
+    // same height. Runs of closed headers are then clipped to the rows that are visible
+    // in the window, so that the cost only depends on what is shown on screen
+    std::vector<PropertyOwner*> visibleOwners;
+    visibleOwners.reserve(_layoutOwners.size());
+    std::copy_if(
+        _layoutOwners.begin(),
+        _layoutOwners.end(),
+        std::back_inserter(visibleOwners),
+        [](PropertyOwner* p) { return hasVisibleProperties(p); }
+    );
+    auto isOpen = [](PropertyOwner* p) {
+        return ImGui::TreeNodeBehaviorIsOpen(ImGui::GetID(p->guiName().c_str()));
+    };
+
+    size_t i = 0;
+    while (i < visibleOwners.size()) {
+        if (isOpen(visibleOwners[i])) {
+            renderFunc(visibleOwners[i]);
+            i++;
+            continue;
+        }
+
+        size_t end = i + 1;
+        while (end < visibleOwners.size() && !isOpen(visibleOwners[end])) {
+            end++;
+        }
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(end - i));
+        while (clipper.Step()) {
+            for (int j = clipper.DisplayStart; j < clipper.DisplayEnd; j++) {
+                renderFunc(visibleOwners[i + j]);
+            }
+        }
+        clipper.End();
+        i = end;
+    }
+}
+
 void GuiPropertyComponent::renderProperty(properties::Property* prop,
                                           properties::PropertyOwner* owner)
 {
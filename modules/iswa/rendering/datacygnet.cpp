@@ -28,11 +28,14 @@
 #include <modules/iswa/util/dataprocessor.h>
 #include <modules/iswa/util/iswamanager.h>
 #include <openspace/rendering/transferfunction.h>
+#include <ghoul/fmt.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 
 namespace {
@@ -113,53 +116,177 @@ DataCygnet::DataCygnet(const ghoul::Dictionary& dictionary)
 
 DataCygnet::~DataCygnet() {}
 
+void DataCygnet::deinitializeGL() {
+    cancelTextureData();
+
+    glDeleteBuffers(1, &_pixelBuffer);
+    _pixelBuffer = 0;
+
+    IswaCygnet::deinitializeGL();
+}
+
+void DataCygnet::update(const UpdateData& data) {
+    if (_textureData.valid() && DownloadManager::futureReady(_textureData)) {
+        uploadTextureData(_textureData.get());
+
+        if (_textureDataOutdated) {
+            _textureDataOutdated = false;
+            updateTexture();
+        }
+    }
+
+    IswaCygnet::update(data);
+}
+
 bool DataCygnet::updateTexture() {
-    const std::vector<float*>& data = textureData();
+    if (_textureData.valid()) {
+        _textureDataOutdated = true;
+        return false;
+    }
 
-    if (data.empty()) {
+    if (!prepareTextureData()) {
         return false;
     }
 
-    bool texturesReady = false;
-    const std::set<std::string>& selectedOptions = _dataOptions;
-    const std::vector<std::string>& options = _dataOptions.options();
-    std::vector<int> selectedOptionsIndices;
-    for (const std::string& option : selectedOptions) {
-        auto it = std::find(options.begin(), options.end(), option);
-        ghoul_assert(it != options.end(), "Selected option must be in all options");
-        int idx = static_cast<int>(std::distance(options.begin(), it));
-        selectedOptionsIndices.push_back(idx);
+    // The worker gets its own copy of everything it needs that can be changed on the
+    // main thread while it is running
+    std::vector<std::string> options = _dataOptions.options();
+    std::set<std::string> selectedOptions = _dataOptions.value();
+    const glm::size3_t dimensions = _textureDimensions;
+
+    auto promise = std::make_shared<std::promise<TextureData>>();
+    _textureData = promise->get_future();
+    IswaManager::ref().processingPool().enqueue(
+        [this, promise, options = std::move(options),
+         selectedOptions = std::move(selectedOptions), dimensions]()
+        {
+            TextureData data;
+            data.dimensions = dimensions;
+            {
+                std::lock_guard lock(_dataProcessor->mutex());
+                data.values = textureData(options, selectedOptions);
+            }
+            promise->set_value(std::move(data));
+        }
+    );
+
+    return true;
+}
+
+void DataCygnet::cancelTextureData() {
+    if (!_textureData.valid()) {
+        return;
     }
 
-    for (int option : selectedOptionsIndices) {
-        float* values = data[option];
-        if (!values) {
+    TextureData data = _textureData.get();
+    for (float* values : data.values) {
+        delete[] values;
+    }
+}
+
+bool DataCygnet::prepareTextureData() {
+    return true;
+}
+
+void DataCygnet::uploadTextureData(TextureData data) {
+    const size_t textureSize = data.dimensions.x * data.dimensions.y * sizeof(float);
+    const size_t nTextures = std::count_if(
+        data.values.begin(),
+        data.values.end(),
+        [](float* values) { return values != nullptr; }
+    );
+    if (nTextures == 0 || textureSize == 0) {
+        for (float* values : data.values) {
+            delete[] values;
+        }
+        return;
+    }
+
+    // Create the storage for the textures that don't have any before the pixel buffer is
+    // bound, as the texture would otherwise be initialized from the buffer's contents
+    for (size_t option = 0; option < data.values.size(); option++) {
+        if (!data.values[option] || option >= _textures.size()) {
             continue;
         }
 
-        if (!_textures[option]) {
-            auto texture = std::make_unique<ghoul::opengl::Texture>(
-                values,
-                _textureDimensions,
+        std::unique_ptr<ghoul::opengl::Texture>& texture = _textures[option];
+        if (!texture || texture->dimensions() != glm::uvec3(data.dimensions)) {
+            texture = std::make_unique<ghoul::opengl::Texture>(
+                glm::uvec3(data.dimensions),
                 GL_TEXTURE_2D,
                 ghoul::opengl::Texture::Format::Red,
                 GL_RED,
                 GL_FLOAT,
                 ghoul::opengl::Texture::FilterMode::Linear,
-                ghoul::opengl::Texture::WrappingMode::ClampToEdge
+                ghoul::opengl::Texture::WrappingMode::ClampToEdge,
+                ghoul::opengl::Texture::AllocateData::No,
+                ghoul::opengl::Texture::TakeOwnership::No
             );
-
             texture->uploadTexture();
             texture->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
-            _textures[option] = std::move(texture);
         }
-        else {
-            _textures[option]->setPixelData(values);
-            _textures[option]->uploadTexture();
+    }
+
+    // All values are copied into a single pixel buffer from which the textures are
+    // updated. This way the driver can perform the transfers asynchronously instead of
+    // stalling the frame until each of the textures has been uploaded
+    if (_pixelBuffer == 0) {
+        glGenBuffers(1, &_pixelBuffer);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffer);
+    const GLsizeiptr bufferSize = static_cast<GLsizeiptr>(nTextures * textureSize);
+    // Orphan the previous storage so that we don't wait for its transfer to finish
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, bufferSize, nullptr, GL_STREAM_DRAW);
+    std::byte* buffer = reinterpret_cast<std::byte*>(glMapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER,
+        0,
+        bufferSize,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+    ));
+
+    std::vector<std::pair<size_t, size_t>> offsets;
+    offsets.reserve(nTextures);
+    for (size_t option = 0; option < data.values.size(); option++) {
+        float* values = data.values[option];
+        if (!values) {
+            continue;
+        }
+
+        if (buffer && option < _textures.size()) {
+            const size_t offset = offsets.size() * textureSize;
+            std::memcpy(buffer + offset, values, textureSize);
+            offsets.emplace_back(option, offset);
         }
-        texturesReady = true;
+        delete[] values;
+    }
+
+    if (!buffer || !glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER)) {
+        LERROR(fmt::format("Could not upload the data of cygnet '{}'", identifier()));
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return;
+    }
+
+    for (const std::pair<size_t, size_t>& p : offsets) {
+        _textures[p.first]->bind();
+        glTexSubImage2D(
+            GL_TEXTURE_2D,
+            0,
+            0,
+            0,
+            static_cast<GLsizei>(data.dimensions.x),
+            static_cast<GLsizei>(data.dimensions.y),
+            GL_RED,
+            GL_FLOAT,
+            reinterpret_cast<void*>(p.second)
+        );
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (_updateBackgroundValues) {
+        _updateBackgroundValues = false;
+        _backgroundValues = _dataProcessor->filterValues();
     }
-    return texturesReady;
 }
 
 bool DataCygnet::downloadTextureResource(double timestamp) {
@@ -181,6 +308,11 @@ bool DataCygnet::downloadTextureResource(double timestamp) {
 }
 
 bool DataCygnet::updateTextureResource() {
+    if (_textureData.valid()) {
+        // The worker is still reading the current data, so we hold on to the new one
+        return false;
+    }
+
     DownloadManager::MemoryFile dataFile = _futureObject.get();
 
     if (dataFile.corrupted) {
@@ -327,9 +459,8 @@ void DataCygnet::setPropertyCallbacks() {
     _useHistogram.onChange([this]() {
         _dataProcessor->useHistogram(_useHistogram);
         updateTexture();
-        if (_autoFilter) {
-            _backgroundValues = _dataProcessor->filterValues();
-        }
+        // The filter values are only known after the data has been processed again
+        _updateBackgroundValues = _autoFilter;
     });
 
     _dataOptions.onChange([this]() {
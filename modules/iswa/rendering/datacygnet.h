@@ -30,7 +30,12 @@
 #include <openspace/properties/selectionproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/vector/vec2property.h>
+#include <ghoul/opengl/ghoul_gl.h>
 #include <glm/gtx/std_based_type.hpp>
+#include <future>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace openspace {
 
@@ -46,7 +51,15 @@ public:
     DataCygnet(const ghoul::Dictionary& dictionary);
     ~DataCygnet();
 
+    void deinitializeGL() override;
+    void update(const UpdateData& data) override;
+
 protected:
+    /**
+     * Starts processing the current data on one of the IswaManager's worker threads.
+     * The textures are updated in #update once the processing has finished. If the data
+     * is already being processed, it is processed again after that has finished.
+     */
     bool updateTexture() override;
     void fillOptions(const std::string& source);
 
@@ -79,7 +92,27 @@ protected:
      */
     virtual bool updateTextureResource() override;
 
-    virtual std::vector<float*> textureData() = 0;
+    /**
+     * Waits for the data that is currently being processed, if any, and discards it.
+     * This has to be called before changing anything that #textureData depends on
+     * outside of the main thread's usual update.
+     */
+    void cancelTextureData();
+
+    /**
+     * Is called on the main thread before the data is processed and can be used to
+     * prepare the options and data processor.
+     *
+     * \return `false` if the data should not be processed at this time
+     */
+    virtual bool prepareTextureData();
+
+    /**
+     * Is called on a worker thread with the mutex of the _dataProcessor held and creates
+     * the values for each of the \p selectedOptions.
+     */
+    virtual std::vector<float*> textureData(const std::vector<std::string>& options,
+        const std::set<std::string>& selectedOptions) = 0;
 
     properties::SelectionProperty _dataOptions;
     properties::StringProperty _transferFunctionsFile;
@@ -94,8 +127,19 @@ protected:
     glm::size3_t _textureDimensions = glm::size3_t(0);
 
 private:
+    struct TextureData {
+        std::vector<float*> values;
+        glm::size3_t dimensions = glm::size3_t(0);
+    };
+
     bool readyToRender() const override;
     bool downloadTextureResource(double timestamp) override;
+    void uploadTextureData(TextureData data);
+
+    std::future<TextureData> _textureData;
+    bool _textureDataOutdated = false;
+    bool _updateBackgroundValues = false;
+    GLuint _pixelBuffer = 0;
 };
 
 } //namespace openspace
@@ -144,28 +144,38 @@ void DataPlane::setUniforms() {
     _shader->setUniform("transparency", _alpha);
 }
 
-std::vector<float*> DataPlane::textureData(){
+bool DataPlane::prepareTextureData() {
     // if the buffer in the datafile is empty, do not proceed
     if (_dataBuffer.empty()) {
-        return std::vector<float*>();
+        return false;
     }
 
     if (!_dataOptions.options().size()) { // load options for value selection
         fillOptions(_dataBuffer);
-        _dataProcessor->addDataValues(_dataBuffer, _dataOptions);
+        {
+            std::lock_guard lock(_dataProcessor->mutex());
+            _dataProcessor->addDataValues(_dataBuffer, _dataOptions);
+        }
 
         // if this datacygnet has added new values then reload texture
         // for the whole group, including this datacygnet, and return after.
         if (_group) {
             _group->updateGroup();
-            return std::vector<float*>();
+            return false;
         }
     }
+    return true;
+}
+
+std::vector<float*> DataPlane::textureData(const std::vector<std::string>& options,
+                                           const std::set<std::string>& selectedOptions)
+{
     // _textureDimensions = _dataProcessor->setDimensions();
 
     std::vector<float*> d = _dataProcessor->processData(
         _dataBuffer,
-        _dataOptions,
+        options,
+        selectedOptions,
         _textureDimensions
     );
 
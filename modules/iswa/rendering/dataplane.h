@@ -52,7 +52,9 @@ private:
     bool destroyGeometry() override;
     void renderGeometry() const override;
     void setUniforms() override;
-    std::vector<float*> textureData() override;
+    bool prepareTextureData() override;
+    std::vector<float*> textureData(const std::vector<std::string>& options,
+        const std::set<std::string>& selectedOptions) override;
 
     GLuint _quad;
     GLuint _vertexPositionBuffer;
@@ -51,7 +51,9 @@ protected:
     bool destroyGeometry() override;
     void renderGeometry() const override;
     void setUniforms() override;
-    std::vector<float*> textureData() override;
+    bool prepareTextureData() override;
+    std::vector<float*> textureData(const std::vector<std::string>& options,
+        const std::set<std::string>& selectedOptions) override;
 
     std::unique_ptr<Sphere> _sphere;
     float _radius;
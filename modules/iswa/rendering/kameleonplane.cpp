@@ -114,6 +114,7 @@ KameleonPlane::KameleonPlane(const ghoul::Dictionary& dictionary)
 KameleonPlane::~KameleonPlane() {}
 
 void KameleonPlane::deinitializeGL() {
+    DataCygnet::deinitializeGL();
     IswaCygnet::deinitialize();
     _fieldlines = std::set<std::string>();
 }
@@ -169,13 +170,14 @@ void KameleonPlane::initializeGL() {
 
     // Set Property callback specific to KameleonPlane
     _resolution.onChange([this]() {
+        // The worker must not be using the dimensions while they change
+        cancelTextureData();
         for (size_t i = 0; i < _textures.size(); i++) {
             _textures[i] = nullptr;
         }
 
-        updateTextureResource();
         setDimensions();
-
+        updateTextureResource();
     });
 
     _slice.onChange([this]() { updateTextureResource(); });
@@ -185,7 +187,10 @@ void KameleonPlane::initializeGL() {
     std::dynamic_pointer_cast<DataProcessorKameleon>(_dataProcessor)->setDimensions(
         _dimensions
     );
-    _dataProcessor->addDataValues(_kwPath, _dataOptions);
+    {
+        std::lock_guard lock(_dataProcessor->mutex());
+        _dataProcessor->addDataValues(_kwPath, _dataOptions);
+    }
     // if this datacygnet has added new values then reload texture
     // for the whole group, including this datacygnet, and return after.
     if (_group) {
@@ -251,10 +256,18 @@ void KameleonPlane::renderGeometry() const {
     glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
-std::vector<float*> KameleonPlane::textureData() {
+bool KameleonPlane::prepareTextureData() {
+    // The slice property must not be read from the worker thread
+    _processedSlice = _slice;
+    return true;
+}
+
+std::vector<float*> KameleonPlane::textureData(const std::vector<std::string>& options,
+                                            const std::set<std::string>& selectedOptions)
+{
     DataProcessorKameleon* p = dynamic_cast<DataProcessorKameleon*>(_dataProcessor.get());
-    p->setSlice(_slice);
-    return p->processData(_kwPath, _dataOptions, _dimensions);
+    p->setSlice(_processedSlice);
+    return p->processData(_kwPath, options, selectedOptions, _dimensions);
 }
 
 bool KameleonPlane::updateTextureResource() {
@@ -406,6 +419,7 @@ void KameleonPlane::setDimensions() {
 }
 
 void KameleonPlane::changeKwPath(std::string kwPath) {
+    cancelTextureData();
     _kwPath = std::move(kwPath);
 }
 
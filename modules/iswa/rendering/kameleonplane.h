@@ -56,7 +56,9 @@ private:
     bool updateTextureResource() override;
     void renderGeometry() const override;
     void setUniforms() override;
-    std::vector<float*> textureData() override;
+    bool prepareTextureData() override;
+    std::vector<float*> textureData(const std::vector<std::string>& options,
+        const std::set<std::string>& selectedOptions) override;
 
     void setDimensions();
 
@@ -88,6 +90,8 @@ private:
     float* _dataSlice = nullptr;
     std::string _var;
     float _scale = 0.f;
+    // The slice that is passed to the data processor on the worker thread
+    float _processedSlice = 0.f;
 
     glm::vec3 _origOffset = glm::vec3(0.f);
 
@@ -32,14 +32,17 @@
 namespace openspace {
 
 void DataProcessor::useLog(bool useLog) {
+    std::lock_guard lock(_mutex);
     _useLog = useLog;
 }
 
 void DataProcessor::useHistogram(bool useHistogram) {
+    std::lock_guard lock(_mutex);
     _useHistogram = useHistogram;
 }
 
 void DataProcessor::normValues(glm::vec2 normValues) {
+    std::lock_guard lock(_mutex);
     _normValues = normValues;
 }
 
@@ -48,9 +51,14 @@ glm::size3_t DataProcessor::dimensions() const {
 }
 
 glm::vec2 DataProcessor::filterValues() const {
+    std::lock_guard lock(_mutex);
     return _filterValues;
 }
 
+std::mutex& DataProcessor::mutex() {
+    return _mutex;
+}
+
 void DataProcessor::clear() {
     _min.clear();
     _max.clear();
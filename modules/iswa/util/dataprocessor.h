@@ -28,6 +28,7 @@
 #include <ghoul/glm.h>
 #include <glm/gtx/std_based_type.hpp>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -51,8 +52,15 @@ public:
     virtual void addDataValues(const std::string& data,
         properties::SelectionProperty& dataOptions) = 0;
 
+    /**
+     * Creates the normalized values for all of the \p selectedOptions. The returned
+     * vector has one entry per option in \p options, which is `nullptr` for the options
+     * that were not selected. As this function is executed on worker threads, the
+     * options are passed by value rather than through the property they belong to.
+     */
     virtual std::vector<float*> processData(const std::string& data,
-        properties::SelectionProperty& dataOptions, glm::size3_t& dimensions) = 0;
+        const std::vector<std::string>& options,
+        const std::set<std::string>& selectedOptions, glm::size3_t& dimensions) = 0;
 
     void useLog(bool useLog);
     void useHistogram(bool useHistogram);
@@ -62,6 +70,13 @@ public:
 
     void clear();
 
+    /**
+     * The mutex that has to be held while calling #addDataValues or #processData, as a
+     * processor is shared between all cygnets of a group, which process their data on
+     * different threads.
+     */
+    std::mutex& mutex();
+
 protected:
     float processDataPoint(float value, int option);
 
@@ -91,6 +106,8 @@ protected:
     std::set<std::string> _coordinateVariables = { "x", "y", "z", "phi", "theta" };
 
     glm::vec2 _histNormValues = glm::vec2(10.f);
+
+    mutable std::mutex _mutex;
 };
 
 } // namespace openspace
@@ -98,7 +98,8 @@ void DataProcessorJson::addDataValues(const std::string& data,
 }
 
 std::vector<float*> DataProcessorJson::processData(const std::string& data,
-                                                properties::SelectionProperty& optionProp,
+                                                 const std::vector<std::string>& options,
+                                             const std::set<std::string>& selectedOptions,
                                                                  glm::size3_t& dimensions)
 {
     if (data.empty()) {
@@ -107,8 +108,6 @@ std::vector<float*> DataProcessorJson::processData(const std::string& data,
     const json& j = json::parse(data);
     json variables = j["variables"];
 
-    const std::set<std::string>& selectedOptions = optionProp;
-    const std::vector<std::string>& options = optionProp.options();
     std::vector<int> selectedOptionsIndices;
     for (const std::string& option : selectedOptions) {
         auto it = std::find(options.begin(), options.end(), option);
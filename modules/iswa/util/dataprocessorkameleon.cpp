@@ -24,6 +24,8 @@
 
 #include <modules/iswa/util/dataprocessorkameleon.h>
 
+#include <modules/iswa/util/iswamanager.h>
+#include <modules/kameleon/include/kameleonmetadata.h>
 #include <modules/kameleon/include/kameleonwrapper.h>
 #include <openspace/properties/selectionproperty.h>
 #include <openspace/util/histogram.h>
@@ -32,6 +34,7 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <algorithm>
 #include <filesystem>
+#include <optional>
 
 namespace openspace {
 
@@ -46,22 +49,22 @@ std::vector<std::string> DataProcessorKameleon::readMetadata(const std::string&
         return std::vector<std::string>();
     }
 
-    if ((path != _kwPath) || !_kw) {
-        initializeKameleonWrapper(path);
+    // The variables are listed from the cached metadata so that the file only has to be
+    // opened once its data is sampled
+    std::optional<KameleonMetadata> metadata = kameleonMetadata(absPath(path));
+    if (!metadata.has_value()) {
+        return std::vector<std::string>();
     }
 
-    std::vector<std::string> opts = _kw->variables();
-    opts.erase(
-        std::remove_if(
-            opts.begin(),
-            opts.end(),
-            [this](const std::string& opt) {
-                    return (opt.size() > 3 ||
-                        _coordinateVariables.find(opt) != _coordinateVariables.end());
-                }
-        ),
-        opts.end()
-    );
+    std::vector<std::string> opts;
+    for (const KameleonMetadata::Variable& variable : metadata->variables) {
+        const std::string& opt = variable.name;
+        if (opt.size() <= 3 &&
+            _coordinateVariables.find(opt) == _coordinateVariables.end())
+        {
+            opts.push_back(opt);
+        }
+    }
     return opts;
 }
 
@@ -90,7 +93,8 @@ void DataProcessorKameleon::addDataValues(const std::string& path,
         float* values = _kw->uniformSliceValues(
             options[i],
             _dimensions,
-            0.5f
+            0.5f,
+            &IswaManager::ref().processingPool()
         );
 
         for (int j=0; j<numValues; j++) {
@@ -107,10 +111,11 @@ void DataProcessorKameleon::addDataValues(const std::string& path,
 }
 
 std::vector<float*> DataProcessorKameleon::processData(const std::string& path,
-                                                properties::SelectionProperty& optionProp,
+                                                 const std::vector<std::string>& options,
+                                             const std::set<std::string>& selectedOptions,
                                                                  glm::size3_t& dimensions)
 {
-    const int numOptions = static_cast<int>(optionProp.options().size());
+    const int numOptions = static_cast<int>(options.size());
 
     if (path.empty()) {
         return std::vector<float*>(numOptions, nullptr);
@@ -120,8 +125,6 @@ std::vector<float*> DataProcessorKameleon::processData(const std::string& path,
         initializeKameleonWrapper(path);
     }
 
-    const std::set<std::string>& selectedOptions = optionProp;
-    const std::vector<std::string>& options = optionProp.options();
     std::vector<int> selectedOptionsIndices;
     for (const std::string& option : selectedOptions) {
         auto it = std::find(options.begin(), options.end(), option);
@@ -137,7 +140,8 @@ std::vector<float*> DataProcessorKameleon::processData(const std::string& path,
         dataOptions[option] = _kw->uniformSliceValues(
             options[option],
             dimensions,
-            _slice
+            _slice,
+            &IswaManager::ref().processingPool()
         );
 
         for (int i = 0; i < numValues; i++) {
@@ -43,7 +43,9 @@ public:
         properties::SelectionProperty& dataOptions) override;
 
     virtual std::vector<float*> processData(const std::string& path,
-        properties::SelectionProperty& dataOptions, glm::size3_t& dimensions) override;
+        const std::vector<std::string>& options,
+        const std::set<std::string>& selectedOptions,
+        glm::size3_t& dimensions) override;
 
     void setSlice(float slice);
 
@@ -27,7 +27,77 @@
 #include <openspace/properties/selectionproperty.h>
 #include <openspace/util/histogram.h>
 #include <algorithm>
-#include <sstream>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <string_view>
+
+namespace {
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    // Removes and returns the next whitespace-separated token from the front of the
+    // line. The returned token is empty if there are no more tokens in the line
+    std::string_view nextToken(std::string_view& line) {
+        size_t first = 0;
+        while (first < line.size() && isSpace(line[first])) {
+            first++;
+        }
+        size_t last = first;
+        while (last < line.size() && !isSpace(line[last])) {
+            last++;
+        }
+        std::string_view token = line.substr(first, last - first);
+        line.remove_prefix(last);
+        return token;
+    }
+
+    // Parses a single value and returns 0 if the token is not a number. Some of the
+    // values in the files are "NaN", which are also replaced by 0
+    float parseValue(std::string_view token) noexcept {
+        const char* first = token.data();
+        const char* last = token.data() + token.size();
+        if (first != last && *first == '+') {
+            first++;
+        }
+        float value = 0.f;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto [p, ec] = std::from_chars(first, last, value);
+        if (ec != std::errc() || p == first) {
+            return 0.f;
+        }
+#else // ^^^^ __cpp_lib_to_chars // !__cpp_lib_to_chars vvvv
+        // Standard libraries without floating point support in from_chars. The token is
+        // always followed by whitespace or the end of the null-terminated data string, so
+        // strtof does not read past the end of it
+        char* p = nullptr;
+        value = std::strtof(first, &p);
+        if (p == first) {
+            return 0.f;
+        }
+#endif // __cpp_lib_to_chars
+        return std::isnan(value) ? 0.f : value;
+    }
+
+    // Calls the function with every line of the data that is not a comment
+    template <typename Func>
+    void forEachDataLine(std::string_view data, Func func) {
+        while (!data.empty()) {
+            const size_t end = data.find('\n');
+            std::string_view line = data.substr(0, end);
+            data.remove_prefix(end == std::string_view::npos ? data.size() : end + 1);
+
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            func(line);
+        }
+    }
+
+    // The first three values on every line are the coordinates of the data point
+    constexpr int NumCoordinates = 3;
+} // namespace
 
 namespace openspace {
 
@@ -49,31 +119,38 @@ std::vector<std::string> DataProcessorText::readMetadata(const std::string& data
     // The string where the interesting data begins
     constexpr std::string_view info = "# Output data: field with ";
     std::vector<std::string> options;
-    std::string line;
-    std::stringstream memorystream(data);
-    while (getline(memorystream, line)) {
-        if (line.find(info) == 0) {
-            line = line.substr(info.size());
-            std::stringstream ss(line);
-
-            std::string token;
-            getline(ss, token, 'x');
-            const int x = std::stoi(token);
-
-            getline(ss, token, '=');
-            const int y = std::stoi(token);
-
-            dimensions = glm::size3_t(x, y, 1);
-
-            getline(memorystream, line);
-            line = line.substr(1); //because of the # char
-
-            ss = std::stringstream(line);
-            std::string option;
-            while (ss >> option) {
-                if (_coordinateVariables.find(option) == _coordinateVariables.end()) {
-                    options.push_back(option);
-                }
+    std::string_view memory = data;
+    while (!memory.empty()) {
+        size_t end = memory.find('\n');
+        std::string_view line = memory.substr(0, end);
+        memory.remove_prefix(end == std::string_view::npos ? memory.size() : end + 1);
+
+        if (!line.starts_with(info)) {
+            continue;
+        }
+        line.remove_prefix(info.size());
+
+        int x = 0;
+        int y = 0;
+        const char* last = line.data() + line.size();
+        auto [px, ecx] = std::from_chars(line.data(), last, x);
+        if (ecx != std::errc() || px == last || *px != 'x') {
+            continue;
+        }
+        std::from_chars(px + 1, last, y);
+        dimensions = glm::size3_t(x, y, 1);
+
+        end = memory.find('\n');
+        line = memory.substr(0, end);
+        memory.remove_prefix(end == std::string_view::npos ? memory.size() : end + 1);
+        if (!line.empty()) {
+            line.remove_prefix(1); //because of the # char
+        }
+
+        for (std::string_view o = nextToken(line); !o.empty(); o = nextToken(line)) {
+            std::string option = std::string(o);
+            if (_coordinateVariables.find(option) == _coordinateVariables.end()) {
+                options.push_back(std::move(option));
             }
         }
     }
@@ -90,56 +167,43 @@ void DataProcessorText::addDataValues(const std::string& data,
         return;
     }
 
-    std::string line;
-    std::stringstream memorystream(data);
-
     // for standard diviation in the add() function
     std::vector<float> sum(numOptions, 0.f);
     std::vector<std::vector<float>> optionValues(numOptions);
+    const size_t numLines = std::count(data.begin(), data.end(), '\n') + 1;
+    for (std::vector<float>& values : optionValues) {
+        values.reserve(numLines);
+    }
 
-    // for each data point
-    while (getline(memorystream, line)) {
-        if (!line.empty() && line[0] == '#') {
-            continue;
+    // The values are parsed and the statistics are gathered in the same pass
+    forEachDataLine(data, [&](std::string_view line) {
+        for (int i = 0; i < NumCoordinates; i++) {
+            nextToken(line);
         }
 
-        std::vector<float> values;
-        std::istringstream ss(line);
-        std::string val;
-        int skip = 0;
-        //for each data option (variable)
-        while (ss >> val) {
-            // first three values are coordinates
-            if (skip < 3) {
-                skip++;
-                continue;
-            }
-
-            float v = std::stof(val);
-            // Some values are "NaN", use 0 instead
-            values.push_back(std::isnan(v) ? v : 0.f);
-            val.clear();
-        }
-
-        if (values.empty()) {
-            continue;
+        std::string_view token = nextToken(line);
+        if (token.empty()) {
+            return;
         }
 
         for (int i = 0; i < numOptions; ++i) {
-            const float value = values[i];
+            const float value = parseValue(token);
 
             optionValues[i].push_back(value);
             _min[i] = std::min(_min[i], value);
             _max[i] = std::max(_max[i], value);
             sum[i] += value;
+
+            token = nextToken(line);
         }
-    }
+    });
 
     add(optionValues, sum);
 }
 
 std::vector<float*> DataProcessorText::processData(const std::string& data,
-                                                   properties::SelectionProperty& options,
+                                              const std::vector<std::string>& allOptions,
+                                             const std::set<std::string>& selectedOptions,
                                                                  glm::size3_t& dimensions)
 {
     // The update of the selection properties broke this and we don't have the data to
@@ -150,14 +214,10 @@ std::vector<float*> DataProcessorText::processData(const std::string& data,
         return std::vector<float*>();
     }
 
-    std::string line;
-    std::stringstream memorystream(data);
-
-    const std::set<std::string>& selectedOptions = options.value();
-    const std::vector<std::string>& allOptions = options.options();
     std::vector<int> selectedOptionsIndices;
 
-    std::vector<float*> dataOptions(options.options().size(), nullptr);
+    const size_t numPoints = dimensions.x * dimensions.y;
+    std::vector<float*> dataOptions(allOptions.size(), nullptr);
     for (const std::string& o : selectedOptions) {
         auto it = std::find(allOptions.begin(), allOptions.end(), o);
         ghoul_assert(
@@ -166,39 +226,41 @@ std::vector<float*> DataProcessorText::processData(const std::string& data,
         );
         int idx = static_cast<int>(std::distance(allOptions.begin(), it));
         selectedOptionsIndices.push_back(idx);
-        dataOptions[idx] = new float[dimensions.x * dimensions.y] { 0.f };
+        dataOptions[idx] = new float[numPoints] { 0.f };
     }
 
-    int numValues = 0;
-    while (getline(memorystream, line)) {
-        if (!line.empty() && line[0] == '#') {
-            continue;
-        }
+    // None of the values after the last selected option are needed, so each line is
+    // only tokenized up to that point
+    const int lastOption = selectedOptionsIndices.empty() ?
+        -1 :
+        *std::max_element(selectedOptionsIndices.begin(), selectedOptionsIndices.end());
 
-        int last = 0;
-        int option = -3;
-        int lineSize = static_cast<int>(line.size());
+    size_t numValues = 0;
+    forEachDataLine(data, [&](std::string_view line) {
+        if (numValues >= numPoints) {
+            return;
+        }
 
-        while (last < lineSize) {
-            const int first = static_cast<int>(line.find_first_not_of(" \t", last));
-            last = static_cast<int>(line.find_first_of(" \t", first));
-            last = (last > 0)? last : lineSize;
+        for (int i = 0; i < NumCoordinates; i++) {
+            nextToken(line);
+        }
 
-            const auto it = std::find(
-                selectedOptionsIndices.begin(),
-                selectedOptionsIndices.end(),
-                option
-            );
-            if (option >= 0 && it != selectedOptionsIndices.end()) {
-                const float value = std::stof(line.substr(first, last));
-                dataOptions[option][numValues] = processDataPoint(value, option);
+        for (int option = 0; option <= lastOption; option++) {
+            std::string_view token = nextToken(line);
+            if (token.empty()) {
+                break;
             }
 
-            option++;
+            if (dataOptions[option]) {
+                dataOptions[option][numValues] = processDataPoint(
+                    parseValue(token),
+                    option
+                );
+            }
         }
 
         numValues++;
-    }
+    });
 
     calculateFilterValues(selectedOptionsIndices);
 
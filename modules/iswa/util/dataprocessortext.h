@@ -41,7 +41,9 @@ public:
         properties::SelectionProperty& dataOptions) override;
 
     virtual std::vector<float*> processData(const std::string& data,
-        properties::SelectionProperty& dataOptions, glm::size3_t& dimensions) override;
+        const std::vector<std::string>& options,
+        const std::set<std::string>& selectedOptions,
+        glm::size3_t& dimensions) override;
 };
 
 } // namespace openspace
@@ -0,0 +1,321 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/iswa/util/iswafetcher.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace {
+    constexpr std::string_view _loggerCat = "IswaFetcher";
+
+    // The responses are mostly limited by their total size, but the cache also needs an
+    // upper bound for the number of responses
+    constexpr size_t MaxCachedResponses = 1024;
+
+    struct Response {
+        std::vector<char> data;
+        std::string etag;
+        std::string lastModified;
+    };
+
+    std::string hostFromUrl(std::string_view url) {
+        const size_t scheme = url.find("://");
+        const size_t begin = scheme == std::string_view::npos ? 0 : scheme + 3;
+        const size_t end = url.find_first_of("/?", begin);
+        return std::string(url.substr(begin, end - begin));
+    }
+
+    void parseHeader(Response& response, std::string_view line) {
+        if (line.starts_with("HTTP/")) {
+            // A new status line means that we were redirected and the headers we have
+            // collected so far belong to the previous response
+            response.etag.clear();
+            response.lastModified.clear();
+            return;
+        }
+
+        const size_t colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            return;
+        }
+
+        std::string key = std::string(line.substr(0, colon));
+        std::transform(
+            key.begin(),
+            key.end(),
+            key.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); }
+        );
+        std::string_view value = line.substr(colon + 1);
+        const size_t first = value.find_first_not_of(" \t");
+        const size_t last = value.find_last_not_of(" \t\r\n");
+        value = first == std::string_view::npos ?
+            std::string_view() :
+            value.substr(first, last - first + 1);
+
+        if (key == "etag") {
+            response.etag = value;
+        }
+        else if (key == "last-modified") {
+            response.lastModified = value;
+        }
+    }
+
+    openspace::DownloadManager::MemoryFile memoryFile(const std::vector<char>& data,
+                                                      const std::string& format)
+    {
+        openspace::DownloadManager::MemoryFile file;
+        file.buffer = new char[data.size() + 1];
+        std::memcpy(file.buffer, data.data(), data.size());
+        file.buffer[data.size()] = '\0';
+        file.size = data.size();
+        file.format = format;
+        return file;
+    }
+} // namespace
+
+namespace openspace {
+
+IswaFetcher::IswaFetcher(int maxRequestsPerHost, size_t cacheSize)
+    : _maxRequestsPerHost(maxRequestsPerHost)
+    , _cache(MaxCachedResponses, cacheSize)
+{
+    ghoul_assert(maxRequestsPerHost > 0, "Need at least one request per host");
+}
+
+IswaFetcher::~IswaFetcher() {
+    std::unique_lock lock(_mutex);
+    _shouldStop = true;
+    // If the HttpEngine has already been shut down, it has finished all transfers
+    if (HttpEngine::isInitialized()) {
+        for (const std::pair<const std::string, HttpEngine::TransferId>& t :
+             _activeTransfers)
+        {
+            HttpEngine::ref().cancel(t.second);
+        }
+        // The callbacks of the transfers reference this object, so we have to wait
+        // until the HttpEngine has finished all of them
+        _hasFinishedRequest.wait(lock, [this]() { return _activeTransfers.empty(); });
+    }
+
+    // Anything still in the queue will never be downloaded, but the cygnets waiting for
+    // it should not end up with a broken promise
+    for (const std::shared_ptr<Request>& request : _queue) {
+        for (std::promise<DownloadManager::MemoryFile>& promise : request->promises) {
+            DownloadManager::MemoryFile file;
+            file.corrupted = true;
+            promise.set_value(std::move(file));
+        }
+    }
+}
+
+std::future<DownloadManager::MemoryFile> IswaFetcher::fetch(const std::string& url) {
+    std::promise<DownloadManager::MemoryFile> promise;
+    std::future<DownloadManager::MemoryFile> future = promise.get_future();
+
+    std::lock_guard lock(_mutex);
+    auto it = _pending.find(url);
+    if (it != _pending.end()) {
+        // Another cygnet is already waiting for the same resource, so we piggyback on
+        // that request instead of issuing a new one
+        it->second->promises.push_back(std::move(promise));
+        return future;
+    }
+
+    LDEBUG(fmt::format("Scheduling download of '{}'", url));
+    auto request = std::make_shared<Request>();
+    request->url = url;
+    request->host = hostFromUrl(url);
+    request->promises.push_back(std::move(promise));
+    _pending[url] = request;
+    _queue.push_back(std::move(request));
+    startRequests();
+
+    return future;
+}
+
+void IswaFetcher::startRequests() {
+    if (_shouldStop) {
+        return;
+    }
+
+    // Start the oldest requests whose server is not yet saturated
+    auto it = _queue.begin();
+    while (it != _queue.end()) {
+        int& nActive = _activeRequestsPerHost[(*it)->host];
+        if (nActive < _maxRequestsPerHost) {
+            nActive++;
+            submit(*it);
+            it = _queue.erase(it);
+        }
+        else {
+            it++;
+        }
+    }
+}
+
+void IswaFetcher::submit(std::shared_ptr<Request> request) {
+    std::shared_ptr<const CachedResponse> cached = cachedResponse(request->url);
+
+    std::vector<std::string> headers;
+    if (cached) {
+        if (!cached->etag.empty()) {
+            headers.push_back(fmt::format("If-None-Match: {}", cached->etag));
+        }
+        if (!cached->lastModified.empty()) {
+            headers.push_back(fmt::format("If-Modified-Since: {}", cached->lastModified));
+        }
+    }
+
+    auto response = std::make_shared<Response>();
+
+    // The callbacks are only called on the thread of the HttpEngine and the onFinish
+    // callback has to acquire the mutex that we are currently holding, so it is safe to
+    // store the identifier after the transfer has been submitted
+    const HttpEngine::TransferId id = HttpEngine::ref().submit({
+        .url = request->url,
+        .timeout = std::chrono::seconds(5),
+        // The cygnets are shown as soon as their data has arrived
+        .priority = HttpEngine::Priority::High,
+        .verifyPeer = false,
+        .requestHeaders = std::move(headers),
+        .onHeader = [response](char* buffer, size_t size) {
+            parseHeader(*response, std::string_view(buffer, size));
+            return true;
+        },
+        .onData = [response](char* buffer, size_t size) {
+            response->data.insert(response->data.end(), buffer, buffer + size);
+            return true;
+        },
+        .onFinish = [this, request, response, cached](const HttpEngine::Result& res) {
+            const std::string& url = request->url;
+            if (!res.isComplete) {
+                LDEBUG(fmt::format("Error downloading '{}': {}", url, res.error));
+                finish(request, nullptr);
+                return;
+            }
+            if (res.responseCode == 304) {
+                if (cached) {
+                    LDEBUG(fmt::format("Using cached version of '{}'", url));
+                }
+                else {
+                    LDEBUG(fmt::format(
+                        "Received 304 for '{}' without a cached version", url
+                    ));
+                }
+                finish(request, cached);
+                return;
+            }
+            if (res.responseCode >= 400) {
+                LDEBUG(fmt::format(
+                    "Error downloading '{}': HTTP code {}", url, res.responseCode
+                ));
+                finish(request, nullptr);
+                return;
+            }
+
+            auto result = std::make_shared<CachedResponse>();
+            result->data = std::move(response->data);
+            result->etag = std::move(response->etag);
+            result->lastModified = std::move(response->lastModified);
+
+            if (!res.contentType.empty()) {
+                std::string_view ct = res.contentType;
+                const size_t slash = ct.find('/');
+                result->format = slash == std::string_view::npos ?
+                    std::string() :
+                    std::string(ct.substr(slash + 1));
+            }
+            else {
+                LWARNING(fmt::format(
+                    "Could not get extension from file downloaded from '{}'", url
+                ));
+            }
+
+            LDEBUG(fmt::format("Download to memory finished for '{}'", url));
+            finish(request, std::move(result));
+        }
+    });
+    _activeTransfers[request->url] = id;
+}
+
+void IswaFetcher::finish(const std::shared_ptr<Request>& request,
+                         std::shared_ptr<const CachedResponse> response)
+{
+    std::vector<std::promise<DownloadManager::MemoryFile>> promises;
+    {
+        std::lock_guard lock(_mutex);
+        if (response && (!response->etag.empty() || !response->lastModified.empty())) {
+            storeResponse(request->url, response);
+        }
+        _activeRequestsPerHost[request->host]--;
+        _activeTransfers.erase(request->url);
+        _pending.erase(request->url);
+        promises = std::move(request->promises);
+
+        // A slot for this host has been freed up, so a request that was held back
+        // might be ready to go now
+        startRequests();
+    }
+    _hasFinishedRequest.notify_all();
+
+    for (std::promise<DownloadManager::MemoryFile>& promise : promises) {
+        if (response) {
+            promise.set_value(memoryFile(response->data, response->format));
+        }
+        else {
+            DownloadManager::MemoryFile file;
+            file.corrupted = true;
+            promise.set_value(std::move(file));
+        }
+    }
+}
+
+std::shared_ptr<const IswaFetcher::CachedResponse> IswaFetcher::cachedResponse(
+                                                                   const std::string& url)
+{
+    return _cache.touch(url) ? _cache.peek(url) : nullptr;
+}
+
+void IswaFetcher::storeResponse(const std::string& url,
+                                std::shared_ptr<const CachedResponse> response)
+{
+    if (response->data.size() > _cache.maximumWeight()) {
+        return;
+    }
+    if (_cache.exist(url) && _cache.peek(url) == response) {
+        // The server confirmed that our cached version is still current
+        return;
+    }
+
+    const size_t size = response->data.size();
+    _cache.put(url, std::move(response), size);
+}
+
+} // namespace openspace
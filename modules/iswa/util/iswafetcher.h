@@ -0,0 +1,115 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_ISWA___ISWAFETCHER___H__
+#define __OPENSPACE_MODULE_ISWA___ISWAFETCHER___H__
+
+#include <openspace/engine/downloadmanager.h>
+#include <openspace/util/httpengine.h>
+#include <openspace/util/lrucache.h>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * Shared scheduler for all cygnet downloads. The transfers are performed by the
+ * HttpEngine, which reuses the connections to the iSWA servers, and no more than a fixed
+ * number of requests are in flight to the same host at any time. Requests for a URL that
+ * is already queued or being downloaded are coalesced into the same transfer, and
+ * responses are cached together with their ETag and Last-Modified headers so that a
+ * repeated request can be answered by the server with a 304 Not Modified rather than the
+ * full payload.
+ */
+class IswaFetcher {
+public:
+    IswaFetcher(int maxRequestsPerHost, size_t cacheSize);
+
+    /**
+     * Cancels all transfers that are still running and waits for them to finish.
+     */
+    ~IswaFetcher();
+
+    /**
+     * Schedules the download of the provided \p url. The returned MemoryFile owns its
+     * buffer, which has to be released with `delete[]` by the caller. If the download
+     * failed, the MemoryFile is marked as corrupted.
+     */
+    std::future<DownloadManager::MemoryFile> fetch(const std::string& url);
+
+private:
+    struct CachedResponse {
+        std::vector<char> data;
+        std::string format;
+        std::string etag;
+        std::string lastModified;
+    };
+
+    struct Request {
+        std::string url;
+        std::string host;
+        std::vector<std::promise<DownloadManager::MemoryFile>> promises;
+    };
+
+    /// Submits the oldest queued requests whose server is not yet saturated to the
+    /// HttpEngine. The _mutex has to be locked when calling this function
+    void startRequests();
+
+    /// Submits the transfer for the \p request. The _mutex has to be locked
+    void submit(std::shared_ptr<Request> request);
+
+    /// Fulfills the promises of the \p request with the \p response, or marks them as
+    /// corrupted if there is no response, and starts the next requests
+    void finish(const std::shared_ptr<Request>& request,
+                std::shared_ptr<const CachedResponse> response);
+
+    /// The _mutex has to be locked when calling these functions
+    std::shared_ptr<const CachedResponse> cachedResponse(const std::string& url);
+    void storeResponse(const std::string& url, std::shared_ptr<const CachedResponse> r);
+
+    const int _maxRequestsPerHost;
+
+    std::mutex _mutex;
+    std::condition_variable _hasFinishedRequest;
+    bool _shouldStop = false;
+
+    std::deque<std::shared_ptr<Request>> _queue;
+    std::map<std::string, std::shared_ptr<Request>> _pending;
+    std::map<std::string, int> _activeRequestsPerHost;
+    /// The transfers that were submitted to the HttpEngine, by their URL
+    std::map<std::string, HttpEngine::TransferId> _activeTransfers;
+
+    /// The responses by their URL, weighted by the size of their data
+    LruCache<std::string, std::shared_ptr<const CachedResponse>> _cache;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_ISWA___ISWAFETCHER___H__
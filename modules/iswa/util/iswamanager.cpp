@@ -32,7 +32,8 @@
 #include <modules/iswa/rendering/iswadatagroup.h>
 #include <modules/iswa/rendering/iswakameleongroup.h>
 #include <modules/iswa/rendering/textureplane.h>
-#include <modules/kameleon/include/kameleonwrapper.h>
+#include <modules/iswa/util/iswafetcher.h>
+#include <modules/kameleon/include/kameleonmetadata.h>
 #include <openspace/json.h>
 #include <openspace/engine/globals.h>
 #include <openspace/rendering/renderengine.h>
@@ -44,8 +45,11 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/constexpr.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <optional>
+#include <thread>
 
 #include "iswamanager_lua.inl"
 
@@ -67,6 +71,11 @@
 namespace {
     constexpr std::string_view _loggerCat = "IswaManager";
 
+    // All cygnet downloads are limited to this many concurrent requests to the same
+    // server
+    constexpr int MaxRequestsPerHost = 2;
+    constexpr size_t ResponseCacheSize = 64 * 1024 * 1024;
+
     constexpr std::string_view monthNumber(std::string_view month) {
         if (month == "JAN") return "01";
         else if (month == "FEB") return "02";
@@ -99,6 +108,8 @@ IswaManager* IswaManager::_instance = nullptr;
 IswaManager::IswaManager()
     : properties::PropertyOwner({ "IswaManager", "Iswa Manager" })
     , _baseUrl("https://iswa-demo-server.herokuapp.com/")
+    , _fetcher(std::make_unique<IswaFetcher>(MaxRequestsPerHost, ResponseCacheSize))
+    , _processingPool(std::max(std::thread::hardware_concurrency(), 1u))
 {
     _type[CygnetType::Texture] = "Texture";
     _type[CygnetType::Data] = "Data";
@@ -221,41 +232,17 @@ void IswaManager::addKameleonCdf(std::string groupName, int pos) {
 std::future<DownloadManager::MemoryFile> IswaManager::fetchImageCygnet(int id,
                                                                        double timestamp)
 {
-    return global::downloadManager->fetchFile(
-            iswaUrl(id, timestamp, "image"),
-            [id](const DownloadManager::MemoryFile&) {
-                LDEBUG(
-                    "Download to memory finished for image cygnet with id: " +
-                    std::to_string(id)
-                );
-            },
-            [id](const std::string& err) {
-                LDEBUG(
-                    "Download to memory was aborted for image cygnet with id " +
-                    std::to_string(id) + ": " + err
-                );
-            }
-        );
+    return _fetcher->fetch(iswaUrl(id, timestamp, "image"));
 }
 
 std::future<DownloadManager::MemoryFile> IswaManager::fetchDataCygnet(int id,
                                                                       double timestamp)
 {
-    return global::downloadManager->fetchFile(
-            iswaUrl(id, timestamp, "data"),
-            [id](const DownloadManager::MemoryFile&) {
-                LDEBUG(
-                    "Download to memory finished for data cygnet with id: " +
-                    std::to_string(id)
-                );
-            },
-            [id](const std::string& err) {
-                LDEBUG(
-                    "Download to memory was aborted for data cygnet with id " +
-                    std::to_string(id) + ": " + err
-                );
-            }
-        );
+    return _fetcher->fetch(iswaUrl(id, timestamp, "data"));
+}
+
+ThreadPool& IswaManager::processingPool() {
+    return _processingPool;
 }
 
 std::string IswaManager::iswaUrl(int id, double timestamp, const std::string& type) {
@@ -411,15 +398,16 @@ std::string IswaManager::parseKWToLuaTable(const CdfInfo& info, const std::strin
 
     std::filesystem::path ext = std::filesystem::path(absPath(info.path)).extension();
     if (ext == ".cdf") {
-        KameleonWrapper kw = KameleonWrapper(absPath(info.path).string());
-
-        std::string parent = kw.parent();
-        std::string frame = kw.frame();
-        glm::vec3 min = kw.gridMin();
-        glm::vec3 max = kw.gridMax();
-
+        std::optional<KameleonMetadata> metadata = kameleonMetadata(absPath(info.path));
+        if (!metadata.has_value()) {
+            return "";
+        }
 
-        std::array<std::string, 3> gridUnits = kw.gridUnits();
+        const std::string& parent = metadata->parent;
+        const std::string& frame = metadata->frame;
+        const glm::vec3& min = metadata->gridMin;
+        const glm::vec3& max = metadata->gridMax;
+        const std::array<std::string, 3>& gridUnits = metadata->gridUnits;
 
         glm::vec4 spatialScale = glm::vec4(0.f);
         std::string coordinateType;
@@ -732,6 +720,12 @@ void IswaManager::addCdfFiles(std::string cdfpath) {
                         date,
                         fieldlineSeedsIndexFile
                     });
+
+                    // Read the metadata in the background so that it is available by
+                    // the time the file is added to the scene
+                    if (std::filesystem::path(path).extension() == ".cdf") {
+                        kameleonMetadataAsync(absPath(path));
+                    }
                 }
             }
 
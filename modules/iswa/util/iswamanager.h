@@ -28,8 +28,10 @@
 #include <openspace/properties/propertyowner.h>
 
 #include <openspace/engine/downloadmanager.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/designpattern/event.h>
 #include <future>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -41,6 +43,7 @@ namespace scripting { struct LuaLibrary; }
 
 class IswaBaseGroup;
 class IswaCygnet;
+class IswaFetcher;
 
 struct CdfInfo {
     std::string name;
@@ -89,6 +92,12 @@ public:
     std::future<DownloadManager::MemoryFile> fetchDataCygnet(int id, double timestamp);
     std::string iswaUrl(int id, double timestamp, const std::string& type = "image");
 
+    /**
+     * Returns the pool on which the cygnets process their downloaded data so that the
+     * main thread only has to upload the finished textures.
+     */
+    ThreadPool& processingPool();
+
     IswaBaseGroup* iswaGroup(const std::string& name);
 
     std::map<int, std::shared_ptr<CygnetInfo>>& cygnetInformation();
@@ -129,6 +138,9 @@ private:
 
     std::string _baseUrl;
 
+    std::unique_ptr<IswaFetcher> _fetcher;
+    ThreadPool _processingPool;
+
     static IswaManager* _instance;
 };
 
@@ -0,0 +1,83 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_KAMELEON___KAMELEONMETADATA___H__
+#define __OPENSPACE_MODULE_KAMELEON___KAMELEONMETADATA___H__
+
+#include <modules/kameleon/include/kameleonwrapper.h>
+
+#include <ghoul/glm.h>
+#include <array>
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * The information about a CDF file that is needed to list it and to set up the
+ * renderables showing it, without having to keep the file open.
+ */
+struct KameleonMetadata {
+    struct Variable {
+        std::string name;
+        std::string unit;
+        float min = 0.f;
+        float max = 0.f;
+    };
+
+    KameleonWrapper::Model model = KameleonWrapper::Model::Unknown;
+    KameleonWrapper::GridType gridType = KameleonWrapper::GridType::Unknown;
+    std::array<std::string, 3> gridVariables;
+    std::array<std::string, 3> gridUnits;
+    glm::vec3 gridMin = glm::vec3(0.f);
+    glm::vec3 gridMax = glm::vec3(0.f);
+    std::string parent;
+    std::string frame;
+    std::vector<Variable> variables;
+};
+
+/**
+ * Returns the metadata of the CDF file at \p path. The metadata is kept in memory and in
+ * the cache folder, keyed by the path, size, and modification time of the file, so that
+ * the file is only opened the first time its metadata is requested or after it changed.
+ *
+ * \return The metadata of the file or `std::nullopt` if the file could not be opened
+ */
+std::optional<KameleonMetadata> kameleonMetadata(const std::filesystem::path& path);
+
+/**
+ * Returns the metadata of the CDF file at \p path the same way as #kameleonMetadata, but
+ * opens the file on a separate thread if the metadata is not cached. Concurrent requests
+ * for the same file share the same future, so this can be used to warm the cache for
+ * files that will be needed later.
+ */
+std::shared_future<std::optional<KameleonMetadata>> kameleonMetadataAsync(
+    const std::filesystem::path& path);
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_KAMELEON___KAMELEONMETADATA___H__
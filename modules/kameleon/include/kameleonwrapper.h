@@ -28,6 +28,7 @@
 #include <ghoul/glm.h>
 #include <glm/gtx/std_based_type.hpp>
 #include <array>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -39,6 +40,8 @@ namespace ccmc {
 
 namespace openspace {
 
+class ThreadPool;
+
 struct LinePoint {
     glm::vec3 position = glm::vec3(0.f);
     glm::vec4 color = glm::vec4(0.f);
@@ -83,15 +86,43 @@ public:
 
     bool open(const std::string& filename);
     void close();
-
+    bool isOpen() const;
+
+    /**
+     * Loads the \p variable and returns the handle with which it can be passed to
+     * #interpolate, which avoids looking up the variable by name for every sample.
+     */
+    long variableHandle(const std::string& variable) const;
+
+    /**
+     * Samples the variable with the provided handle at each of the \p positions, which
+     * are in the coordinate system of the model's interpolator, and writes the results
+     * to \p values, which must have the same size. The positions are split into chunks
+     * that are sampled in parallel on the \p pool, each with its own interpolator as the
+     * Kameleon interpolators cannot be shared between threads.
+     *
+     * \param variable The handle of the variable as returned by #variableHandle
+     * \param positions The positions at which the variable is sampled
+     * \param values The destination of the sampled values
+     * \param pool The pool on which the positions are sampled
+     */
+    void interpolate(long variable, std::span<const glm::vec3> positions,
+        std::span<float> values, ThreadPool& pool) const;
+
+    /**
+     * The following functions sample the model on a uniform grid with the provided
+     * dimensions. The samples are interpolated in parallel on the \p pool, or on a pool
+     * that is created for the call if none is provided.
+     */
     float* uniformSampledValues(const std::string& var,
-        const glm::size3_t& outDimensions) const;
+        const glm::size3_t& outDimensions, ThreadPool* pool = nullptr) const;
 
     float* uniformSliceValues(const std::string& var, const glm::size3_t& outDimensions,
-        float zSlice) const;
+        float zSlice, ThreadPool* pool = nullptr) const;
 
     float* uniformSampledVectorValues(const std::string& xVar, const std::string& yVar,
-        const std::string& zVar, const glm::size3_t& outDimensions) const;
+        const std::string& zVar, const glm::size3_t& outDimensions,
+        ThreadPool* pool = nullptr) const;
 
     Fieldlines classifiedFieldLines(const std::string& xVar, const std::string& yVar,
         const std::string& zVar, const std::vector<glm::vec3>& seedPoints,
@@ -112,6 +143,12 @@ public:
     const glm::vec3& gridMin() const;
     std::string variableUnit(const std::string& variable) const;
 
+    /**
+     * Returns the minimum and maximum value of the \p variable as they are stored in the
+     * attributes of the file, which does not require the variable to be loaded.
+     */
+    glm::vec2 variableRange(const std::string& variable) const;
+
     std::array<std::string, 3> gridUnits() const;
 
     std::array<std::string, 3> gridVariables() const;
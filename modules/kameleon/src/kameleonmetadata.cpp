@@ -0,0 +1,214 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/kameleon/include/kameleonmetadata.h>
+
+#include <openspace/json.h>
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/crc32.h>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+namespace {
+    constexpr std::string_view _loggerCat = "KameleonMetadata";
+
+    // Has to be increased whenever the layout of the cached files changes
+    constexpr int CacheVersion = 1;
+
+    using MetadataFuture =
+        std::shared_future<std::optional<openspace::KameleonMetadata>>;
+
+    std::mutex MetadataMutex;
+    std::map<unsigned int, MetadataFuture> MetadataCache;
+
+    unsigned int cacheKey(const std::filesystem::path& path) {
+        // Hashing the contents of the files, which can be several gigabytes large, would
+        // be as expensive as opening them, so the key is derived from the attributes that
+        // change whenever a file is replaced instead
+        std::error_code ec;
+        const uintmax_t size = std::filesystem::file_size(path, ec);
+        const std::filesystem::file_time_type time =
+            std::filesystem::last_write_time(path, ec);
+        return ghoul::hashCRC32(fmt::format(
+            "{}|{}|{}", path.string(), size, time.time_since_epoch().count()
+        ));
+    }
+
+    openspace::KameleonWrapper::GridType gridType(const std::array<std::string, 3>& v) {
+        using GridType = openspace::KameleonWrapper::GridType;
+        if (v[0] == "x" && v[1] == "y" && v[2] == "z") {
+            return GridType::Cartesian;
+        }
+        if (v[0] == "r" && v[1] == "theta" && v[2] == "phi") {
+            return GridType::Spherical;
+        }
+        return GridType::Unknown;
+    }
+
+    nlohmann::json toJson(const openspace::KameleonMetadata& metadata) {
+        nlohmann::json variables = nlohmann::json::array();
+        for (const openspace::KameleonMetadata::Variable& v : metadata.variables) {
+            variables.push_back({
+                { "name", v.name },
+                { "unit", v.unit },
+                { "min", v.min },
+                { "max", v.max }
+            });
+        }
+
+        return {
+            { "version", CacheVersion },
+            { "model", static_cast<int>(metadata.model) },
+            { "gridType", static_cast<int>(metadata.gridType) },
+            { "gridVariables", metadata.gridVariables },
+            { "gridUnits", metadata.gridUnits },
+            { "gridMin", { metadata.gridMin.x, metadata.gridMin.y, metadata.gridMin.z } },
+            { "gridMax", { metadata.gridMax.x, metadata.gridMax.y, metadata.gridMax.z } },
+            { "parent", metadata.parent },
+            { "frame", metadata.frame },
+            { "variables", variables }
+        };
+    }
+
+    openspace::KameleonMetadata fromJson(const nlohmann::json& json) {
+        using namespace openspace;
+
+        KameleonMetadata metadata;
+        metadata.model = static_cast<KameleonWrapper::Model>(json.at("model").get<int>());
+        metadata.gridType =
+            static_cast<KameleonWrapper::GridType>(json.at("gridType").get<int>());
+        metadata.gridVariables =
+            json.at("gridVariables").get<std::array<std::string, 3>>();
+        metadata.gridUnits = json.at("gridUnits").get<std::array<std::string, 3>>();
+        const std::array<float, 3> min = json.at("gridMin").get<std::array<float, 3>>();
+        metadata.gridMin = glm::vec3(min[0], min[1], min[2]);
+        const std::array<float, 3> max = json.at("gridMax").get<std::array<float, 3>>();
+        metadata.gridMax = glm::vec3(max[0], max[1], max[2]);
+        metadata.parent = json.at("parent").get<std::string>();
+        metadata.frame = json.at("frame").get<std::string>();
+        for (const nlohmann::json& v : json.at("variables")) {
+            metadata.variables.push_back({
+                .name = v.at("name").get<std::string>(),
+                .unit = v.at("unit").get<std::string>(),
+                .min = v.at("min").get<float>(),
+                .max = v.at("max").get<float>()
+            });
+        }
+        return metadata;
+    }
+
+    std::optional<openspace::KameleonMetadata> readMetadata(
+                                                        const std::filesystem::path& path)
+    {
+        openspace::KameleonWrapper kw(path.string());
+        if (!kw.isOpen()) {
+            LERROR(fmt::format("Could not open {} to read its metadata", path));
+            return std::nullopt;
+        }
+
+        openspace::KameleonMetadata metadata;
+        metadata.model = kw.model();
+        metadata.gridVariables = kw.gridVariables();
+        metadata.gridType = gridType(metadata.gridVariables);
+        metadata.gridUnits = kw.gridUnits();
+        metadata.gridMin = kw.gridMin();
+        metadata.gridMax = kw.gridMax();
+        metadata.parent = kw.parent();
+        metadata.frame = kw.frame();
+        for (const std::string& variable : kw.variables()) {
+            const glm::vec2 range = kw.variableRange(variable);
+            metadata.variables.push_back({
+                .name = variable,
+                .unit = kw.variableUnit(variable),
+                .min = range.x,
+                .max = range.y
+            });
+        }
+        return metadata;
+    }
+
+    std::optional<openspace::KameleonMetadata> loadMetadata(std::filesystem::path path,
+                                                            unsigned int key)
+    {
+        if (!FileSys.cacheManager()) {
+            return readMetadata(path);
+        }
+
+        std::filesystem::path cached = FileSys.cacheManager()->cachedFilename(
+            path.stem(),
+            fmt::format("{:08x}", key)
+        );
+
+        if (std::filesystem::is_regular_file(cached)) {
+            try {
+                std::ifstream file(cached);
+                nlohmann::json json = nlohmann::json::parse(file);
+                if (json.value("version", 0) == CacheVersion) {
+                    LDEBUG(fmt::format("Using cached metadata {} for {}", cached, path));
+                    return fromJson(json);
+                }
+            }
+            catch (const nlohmann::json::exception& e) {
+                LWARNING(fmt::format(
+                    "Discarding corrupt metadata cache {}: {}", cached, e.what()
+                ));
+            }
+        }
+
+        std::optional<openspace::KameleonMetadata> metadata = readMetadata(path);
+        if (metadata.has_value()) {
+            std::ofstream file(cached);
+            file << toJson(*metadata).dump();
+        }
+        return metadata;
+    }
+} // namespace
+
+namespace openspace {
+
+std::optional<KameleonMetadata> kameleonMetadata(const std::filesystem::path& path) {
+    return kameleonMetadataAsync(path).get();
+}
+
+std::shared_future<std::optional<KameleonMetadata>> kameleonMetadataAsync(
+                                                        const std::filesystem::path& path)
+{
+    const unsigned int key = cacheKey(path);
+
+    std::lock_guard lock(MetadataMutex);
+    auto it = MetadataCache.find(key);
+    if (it != MetadataCache.end()) {
+        return it->second;
+    }
+
+    MetadataFuture metadata = std::async(std::launch::async, loadMetadata, path, key);
+    MetadataCache[key] = metadata;
+    return metadata;
+}
+
+} // namespace openspace
@@ -30,8 +30,13 @@
 #include <ghoul/fmt.h>
 #include <ghoul/glm.h>
 #include <ghoul/misc/assert.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/misc/misc.h>
+#include <algorithm>
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <thread>
 
 #ifdef WIN32
 #pragma warning (push)
@@ -54,6 +59,21 @@
 namespace {
     constexpr std::string_view _loggerCat = "KameleonWrapper";
     constexpr float RE_TO_METER = 6371000;
+
+    // Every chunk of sample points gets its own interpolator, so the chunks have to be
+    // large enough to make up for creating it
+    constexpr size_t InterpolationGrainSize = 2048;
+
+    // Returns the provided pool or, if there is none, a pool that is created for the
+    // duration of the current sampling
+    openspace::ThreadPool& threadPool(openspace::ThreadPool* pool,
+                                      std::optional<openspace::ThreadPool>& localPool)
+    {
+        if (pool) {
+            return *pool;
+        }
+        return localPool.emplace(std::max(std::thread::hardware_concurrency(), 1u));
+    }
 } // namespace
 
 namespace openspace {
@@ -181,9 +201,45 @@ void KameleonWrapper::close() {
     _gridType = GridType::Unknown;
 }
 
+bool KameleonWrapper::isOpen() const {
+    return _model != nullptr;
+}
+
+long KameleonWrapper::variableHandle(const std::string& variable) const {
+    ghoul_assert(_model, "Model must exist");
+
+    // The variable has to be loaded before the interpolators are used concurrently as
+    // they would otherwise try to load it lazily from each thread
+    _model->loadVariable(variable);
+    return _model->getVariableID(variable);
+}
+
+void KameleonWrapper::interpolate(long variable, std::span<const glm::vec3> positions,
+                                  std::span<float> values, ThreadPool& pool) const
+{
+    ghoul_assert(_model, "Model must exist");
+    ghoul_assert(positions.size() == values.size(), "Need one value per position");
+
+    pool.parallelFor(
+        0,
+        positions.size(),
+        InterpolationGrainSize,
+        [&](size_t begin, size_t end) {
+            std::unique_ptr<ccmc::Interpolator> interpolator =
+                std::unique_ptr<ccmc::Interpolator>(_model->createNewInterpolator());
+
+            for (size_t i = begin; i < end; ++i) {
+                const glm::vec3& p = positions[i];
+                values[i] = interpolator->interpolate(variable, p.x, p.y, p.z);
+            }
+        }
+    );
+}
+
 // This method returns new'd memory,  turn into std::vector<float> instead?
 float* KameleonWrapper::uniformSampledValues(const std::string& var,
-                                             const glm::size3_t& outDimensions) const
+                                             const glm::size3_t& outDimensions,
+                                             ThreadPool* pool) const
 {
     ghoul_assert(_model && _interpolator, "Model and interpolator must exist");
 
@@ -191,7 +247,7 @@ float* KameleonWrapper::uniformSampledValues(const std::string& var,
 
     const size_t size = outDimensions.x * outDimensions.y * outDimensions.z;
     float* data = new float[size];
-    std::vector<double> doubleData(size);
+    std::vector<double> doubleData(size, 0.0);
 
 
     const double varMin =
@@ -214,7 +270,12 @@ float* KameleonWrapper::uniformSampledValues(const std::string& var,
         return glm::clamp(izerotoone, 0, NBins - 1);
     };
 
-    // ProgressBar pb(static_cast<int>(outDimensions.x));
+    // First collect the positions of all sample points that are inside the domain in
+    // the coordinate system of the interpolator so that they can be sampled at once
+    std::vector<glm::vec3> positions;
+    std::vector<size_t> indices;
+    positions.reserve(size);
+    indices.reserve(size);
     for (size_t x = 0; x < outDimensions.x; ++x) {
         for (size_t y = 0; y < outDimensions.y; ++y) {
             for (size_t z = 0; z < outDimensions.z; ++z) {
@@ -242,7 +303,6 @@ float* KameleonWrapper::uniformSampledValues(const std::string& var,
                     const double phiPh = _min.z + phiNorm /
                                     glm::two_pi<double>() * (_max.z - _min.z - 0.000001);
 
-                    double value = 0.0;
                     // See if sample point is inside domain
                     if (rPh < _min.x || rPh > _max.x || thetaPh < _min.y ||
                         thetaPh > _max.y || phiPh < _min.z || phiPh > _max.z)
@@ -261,17 +321,10 @@ float* KameleonWrapper::uniformSampledValues(const std::string& var,
                                                     glm::pi<double>() + 90.f;
                         // Convert from [0, 2pi] rad to [0, 360] degrees
                         const double localPhiPh = phiPh * 180.f / glm::pi<double>();
-                        // Sample
-                        value = _interpolator->interpolate(
-                            var,
-                            static_cast<float>(localRPh),
-                            static_cast<float>(localThetaPh),
-                            static_cast<float>(localPhiPh)
-                        );
-                    }
 
-                    doubleData[index] = value;
-                    histogram[mapToHistogram(value)]++;
+                        positions.emplace_back(localRPh, localThetaPh, localPhiPh);
+                        indices.push_back(index);
+                    }
                 }
                 else {
                     // Assume cartesian for fallback purpose
@@ -286,21 +339,24 @@ float* KameleonWrapper::uniformSampledValues(const std::string& var,
                     const double yPos = _min.y + stepY * y;
                     const double zPos = _min.z + stepZ * z;
 
-                    // get interpolated data value for (xPos, yPos, zPos)
                     // swap yPos and zPos because model has Z as up
-                    double value = _interpolator->interpolate(
-                        var,
-                        static_cast<float>(xPos),
-                        static_cast<float>(zPos),
-                        static_cast<float>(yPos)
-                    );
-                    doubleData[index] = value;
-                    histogram[mapToHistogram(value)]++;
+                    positions.emplace_back(xPos, zPos, yPos);
+                    indices.push_back(index);
                 }
             }
         }
     }
 
+    std::vector<float> values(positions.size());
+    std::optional<ThreadPool> localPool;
+    interpolate(variableHandle(var), positions, values, threadPool(pool, localPool));
+    for (size_t i = 0; i < values.size(); ++i) {
+        doubleData[indices[i]] = values[i];
+    }
+    for (double value : doubleData) {
+        histogram[mapToHistogram(value)]++;
+    }
+
     int sum = 0;
     int stop = 0;
     constexpr float TruncationLimit = 0.9f;
@@ -334,7 +390,7 @@ float* KameleonWrapper::uniformSampledValues(const std::string& var,
 // This method returns new'd memory,  turn into std::vector<float> instead?
 float* KameleonWrapper::uniformSliceValues(const std::string& var,
                                            const glm::size3_t& outDimensions,
-                                           float slice) const
+                                           float slice, ThreadPool* pool) const
 {
     ghoul_assert(_model && _interpolator, "Model and interpolator must exist");
     LINFO(fmt::format(
@@ -343,10 +399,9 @@ float* KameleonWrapper::uniformSliceValues(const std::string& var,
     ));
 
     const size_t size = outDimensions.x * outDimensions.y * outDimensions.z;
-    float* data = new float[size];
-    std::vector<double> doubleData(size);
+    float* data = new float[size] { 0.f };
 
-    _model->loadVariable(var);
+    const long variable = variableHandle(var);
 
     const double varMin =
         _model->getVariableAttribute(var, "actual_min").getAttributeFloat();
@@ -368,11 +423,14 @@ float* KameleonWrapper::uniformSliceValues(const std::string& var,
     LDEBUG(fmt::format("{} min: {}", var, varMin));
     LDEBUG(fmt::format("{} max: {}", var, varMax));
 
-    //double maxValue = 0.0;
-    //double minValue = std::numeric_limits<double>::max();
-
     float missingValue = _model->getMissingValue();
 
+    // First collect the positions of all sample points that are inside the domain in
+    // the coordinate system of the interpolator so that they can be sampled at once
+    std::vector<glm::vec3> positions;
+    std::vector<size_t> indices;
+    positions.reserve(size);
+    indices.reserve(size);
     for (size_t x = 0; x < outDimensions.x; ++x) {
         for (size_t y = 0; y < outDimensions.y; ++y) {
             for(size_t z = 0; z < outDimensions.z; ++z){
@@ -381,11 +439,9 @@ float* KameleonWrapper::uniformSliceValues(const std::string& var,
                 const float yi = (hasYSlice) ? slice : y;
                 const float zi = (hasZSlice) ? slice : z;
 
-                double value = 0;
                 const size_t index = x + y * outDimensions.x +
                                      z * outDimensions.x * outDimensions.y;
                 if (_gridType == GridType::Spherical) {
-                        // int z = zSlice;
                         // Put r in the [0..sqrt(3)] range
                         const double rNorm = glm::root_three<double>() * xi / xDim;
 
@@ -423,13 +479,9 @@ float* KameleonWrapper::uniformSliceValues(const std::string& var,
                                                         glm::pi<double>() + 90.f;
                             // Convert from [0, 2pi] rad to [0, 360] degrees
                             const double localPhiPh = phiPh * 180.f / glm::pi<double>();
-                            // Sample
-                            value = _interpolator->interpolate(
-                                var,
-                                static_cast<float>(localRPh),
-                                static_cast<float>(localPhiPh),
-                                static_cast<float>(localThetaPh)
-                            );
+
+                            positions.emplace_back(localRPh, localPhiPh, localThetaPh);
+                            indices.push_back(index);
                         }
 
                 }
@@ -438,33 +490,31 @@ float* KameleonWrapper::uniformSliceValues(const std::string& var,
                     const double yPos = _min.y + stepY * yi;
                     const double zPos = _min.z + stepZ * zi;
 
-                    // std::cout << zPos << ", " << zpos << std::endl;
                     // Should y and z be flipped?
-                    value = _interpolator->interpolate(
-                        var,
-                        static_cast<float>(xPos),
-                        static_cast<float>(zPos),
-                        static_cast<float>(yPos));
-                }
-
-                if (value != missingValue) {
-                    doubleData[index] = value;
-                    data[index] = static_cast<float>(value);
-                }
-                else {
-                    doubleData[index] = 0;
+                    positions.emplace_back(xPos, zPos, yPos);
+                    indices.push_back(index);
                 }
             }
         }
     }
 
+    std::vector<float> values(positions.size());
+    std::optional<ThreadPool> localPool;
+    interpolate(variable, positions, values, threadPool(pool, localPool));
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (values[i] != missingValue) {
+            data[indices[i]] = values[i];
+        }
+    }
+
     return data;
 }
 
 float* KameleonWrapper::uniformSampledVectorValues(const std::string& xVar,
                                                    const std::string& yVar,
                                                    const std::string& zVar,
-                                                  const glm::size3_t& outDimensions) const
+                                                const glm::size3_t& outDimensions,
+                                                                 ThreadPool* pool) const
 {
     ghoul_assert(_model && _interpolator, "Model and interpolator must exist");
 
@@ -476,9 +526,18 @@ float* KameleonWrapper::uniformSampledVectorValues(const std::string& xVar,
     ));
 
     constexpr int NumChannels = 4;
-    const size_t size = NumChannels * outDimensions.x * outDimensions.y * outDimensions.z;
+    const size_t nPoints = outDimensions.x * outDimensions.y * outDimensions.z;
+    const size_t size = NumChannels * nPoints;
     float* data = new float[size];
 
+    if (_gridType != GridType::Cartesian) {
+        LERROR(
+            "Only cartesian grid supported for "
+            "uniformSampledVectorValues (for now)"
+        );
+        return data;
+    }
+
     float varXMin = _model->getVariableAttribute(xVar, "actual_min").getAttributeFloat();
     float varXMax = _model->getVariableAttribute(xVar, "actual_max").getAttributeFloat();
     float varYMin = _model->getVariableAttribute(yVar, "actual_min").getAttributeFloat();
@@ -490,49 +549,40 @@ float* KameleonWrapper::uniformSampledVectorValues(const std::string& xVar,
     const float stepY = (_max.y - _min.y) / (static_cast<float>(outDimensions.y));
     const float stepZ = (_max.z - _min.z) / (static_cast<float>(outDimensions.z));
 
-    //LDEBUG(xVar << "Min: " << varXMin);
-    //LDEBUG(xVar << "Max: " << varXMax);
-    //LDEBUG(yVar << "Min: " << varYMin);
-    //LDEBUG(yVar << "Max: " << varYMax);
-    //LDEBUG(zVar << "Min: " << varZMin);
-    //LDEBUG(zVar << "Max: " << varZMax);
-
-    //ProgressBar pb(static_cast<int>(outDimensions.x));
+    std::vector<glm::vec3> positions(nPoints);
     for (size_t x = 0; x < outDimensions.x; ++x) {
-        //pb.print(x);
         for (size_t y = 0; y < outDimensions.y; ++y) {
             for (size_t z = 0; z < outDimensions.z; ++z) {
-                const size_t index = x * NumChannels + y * NumChannels * outDimensions.x +
-                                     z * NumChannels * outDimensions.x * outDimensions.y;
-
-                if (_gridType == GridType::Cartesian) {
-                    const float xPos = _min.x + stepX * x;
-                    const float yPos = _min.y + stepY * y;
-                    const float zPos = _min.z + stepZ * z;
-
-                    // get interpolated data value for (xPos, yPos, zPos)
-                    const float xVal = _interpolator->interpolate(xVar, xPos, yPos, zPos);
-                    const float yVal = _interpolator->interpolate(yVar, xPos, yPos, zPos);
-                    const float zVal = _interpolator->interpolate(zVar, xPos, yPos, zPos);
-
-                    // scale to [0,1]
-                    data[index]     = (xVal - varXMin) / (varXMax - varXMin); // R
-                    data[index + 1] = (yVal - varYMin) / (varYMax - varYMin); // G
-                    data[index + 2] = (zVal - varZMin) / (varZMax - varZMin); // B
-                    // GL_RGB refuses to work. Workaround doing a GL_RGBA  hardcoded alpha
-                    data[index + 3] = 1.f;
-                }
-                else {
-                    LERROR(
-                        "Only cartesian grid supported for "
-                        "uniformSampledVectorValues (for now)"
-                    );
-                    return data;
-                }
+                const size_t index = x + y * outDimensions.x +
+                                     z * outDimensions.x * outDimensions.y;
+                positions[index] = glm::vec3(
+                    _min.x + stepX * x,
+                    _min.y + stepY * y,
+                    _min.z + stepZ * z
+                );
             }
         }
     }
 
+    std::optional<ThreadPool> localPool;
+    ThreadPool& threads = threadPool(pool, localPool);
+    std::vector<float> xValues(nPoints);
+    interpolate(variableHandle(xVar), positions, xValues, threads);
+    std::vector<float> yValues(nPoints);
+    interpolate(variableHandle(yVar), positions, yValues, threads);
+    std::vector<float> zValues(nPoints);
+    interpolate(variableHandle(zVar), positions, zValues, threads);
+
+    for (size_t i = 0; i < nPoints; ++i) {
+        const size_t index = i * NumChannels;
+        // scale to [0,1]
+        data[index]     = (xValues[i] - varXMin) / (varXMax - varXMin); // R
+        data[index + 1] = (yValues[i] - varYMin) / (varYMax - varYMin); // G
+        data[index + 2] = (zValues[i] - varZMin) / (varZMax - varZMin); // B
+        // GL_RGB refuses to work. Workaround doing a GL_RGBA  hardcoded alpha
+        data[index + 3] = 1.f;
+    }
+
     return data;
 }
 
@@ -763,6 +813,13 @@ std::string KameleonWrapper::variableUnit(const std::string& variable) const {
     return _model->getVariableAttribute(variable, "units").getAttributeString();
 }
 
+glm::vec2 KameleonWrapper::variableRange(const std::string& variable) const {
+    return glm::vec2(
+        _model->getVariableAttribute(variable, "actual_min").getAttributeFloat(),
+        _model->getVariableAttribute(variable, "actual_max").getAttributeFloat()
+    );
+}
+
 std::array<std::string, 3> KameleonWrapper::gridUnits() const {
     return {
         variableUnit(_xCoordVar),
@@ -26,6 +26,9 @@
 
 #include <modules/kameleon/include/kameleonwrapper.h>
 #include <modules/volume/rawvolume.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/fmt.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -76,7 +79,10 @@ namespace {
 
 namespace openspace::kameleonvolume {
 
-KameleonVolumeReader::KameleonVolumeReader(std::string path) : _path(std::move(path)) {
+KameleonVolumeReader::KameleonVolumeReader(std::string path)
+    : _path(std::move(path))
+    , _kameleon(std::make_unique<ccmc::Kameleon>())
+{
     if (!std::filesystem::is_regular_file(_path)) {
         throw ghoul::FileNotFoundError(_path);
     }
@@ -86,11 +92,6 @@ KameleonVolumeReader::KameleonVolumeReader(std::string path) : _path(std::move(p
         LERROR(fmt::format("Failed to open file '{}' with Kameleon", _path));
         throw ghoul::RuntimeError("Failed to open file: " + _path + " with Kameleon");
     }
-
-    // Possibly use a kameleon interpolator instead of a model interpolator?
-    _interpolator = std::unique_ptr<ccmc::Interpolator>(
-        _kameleon->model->createNewInterpolator()
-    );
 }
 
 KameleonVolumeReader::~KameleonVolumeReader() {}
@@ -125,26 +126,84 @@ std::unique_ptr<volume::RawVolume<float>> KameleonVolumeReader::readFloatVolume(
 
     auto volume = std::make_unique<volume::RawVolume<float>>(dimensions);
 
-    const glm::vec3 dims = volume->dimensions();
+    ThreadPool& pool = global::openSpaceEngine->threadPool();
+    readFloatVolumeSlab(
+        *volume,
+        0,
+        dimensions,
+        variable,
+        lowerBound,
+        upperBound,
+        pool,
+        minValue,
+        maxValue
+    );
+
+    return volume;
+}
+
+void KameleonVolumeReader::readFloatVolumeSlab(volume::RawVolume<float>& slab,
+                                                                  unsigned int firstSlice,
+                                                             const glm::uvec3& dimensions,
+                                                              const std::string& variable,
+                                                              const glm::vec3& lowerBound,
+                                                              const glm::vec3& upperBound,
+                                                                         ThreadPool& pool,
+                                                                          float& minValue,
+                                                                    float& maxValue) const
+{
+    // The variable has to be loaded before the interpolators are used concurrently as
+    // they would otherwise try to load it lazily from each thread
+    _kameleon->loadVariable(variable);
+
+    const glm::uvec3 slabDims = slab.dimensions();
+    const glm::vec3 dims = dimensions;
     const glm::vec3 diff = upperBound - lowerBound;
+    const size_t sliceSize = static_cast<size_t>(slabDims.x) * slabDims.y;
 
-    auto interpolate = [this](const std::string& var, const glm::vec3& coords) {
-        return _interpolator->interpolate(var, coords[0], coords[1], coords[2]);
-    };
+    std::vector<glm::vec2> sliceRanges(
+        slabDims.z,
+        glm::vec2(std::numeric_limits<float>::max(), -std::numeric_limits<float>::max())
+    );
 
-    float* data = volume->data();
-    for (size_t index = 0; index < volume->nCells(); ++index) {
-        const glm::vec3 coords = volume->indexToCoords(index);
-        const glm::vec3 coordsZeroToOne = coords / dims;
-        const glm::vec3 volumeCoords = lowerBound + diff * coordsZeroToOne;
+    float* data = slab.data();
+    pool.parallelFor(0, slabDims.z, 1, [&](size_t begin, size_t end) {
+        std::unique_ptr<ccmc::Interpolator> interpolator =
+            std::unique_ptr<ccmc::Interpolator>(
+                _kameleon->model->createNewInterpolator()
+            );
 
-        data[index] = interpolate(variable, volumeCoords);
+        for (size_t z = begin; z < end; ++z) {
+            glm::vec2& range = sliceRanges[z];
+            float* slice = data + z * sliceSize;
+            for (unsigned int y = 0; y < slabDims.y; ++y) {
+                for (unsigned int x = 0; x < slabDims.x; ++x) {
+                    const glm::vec3 coords = glm::vec3(
+                        x,
+                        y,
+                        firstSlice + static_cast<unsigned int>(z)
+                    );
+                    const glm::vec3 coordsZeroToOne = coords / dims;
+                    const glm::vec3 volumeCoords = lowerBound + diff * coordsZeroToOne;
+
+                    const float value = interpolator->interpolate(
+                        variable,
+                        volumeCoords[0],
+                        volumeCoords[1],
+                        volumeCoords[2]
+                    );
+                    slice[y * slabDims.x + x] = value;
+                    range.x = glm::min(range.x, value);
+                    range.y = glm::max(range.y, value);
+                }
+            }
+        }
+    });
 
-        minValue = glm::min(minValue, data[index]);
-        maxValue = glm::max(maxValue, data[index]);
+    for (const glm::vec2& range : sliceRanges) {
+        minValue = glm::min(minValue, range.x);
+        maxValue = glm::max(maxValue, range.y);
     }
-
-    return volume;
 }
 
 std::vector<std::string> KameleonVolumeReader::variableNames() const {
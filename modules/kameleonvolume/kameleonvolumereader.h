@@ -37,6 +37,7 @@ namespace ccmc {
 } // namespce ccmc
 
 namespace ghoul { class Dictionary; }
+namespace openspace { class ThreadPool; }
 namespace openspace::volume { template <typename T> class RawVolume; }
 
 namespace openspace::kameleonvolume {
@@ -55,6 +56,18 @@ public:
         const glm::vec3& lowerBound, const glm::vec3& upperBound, float& minValue,
         float& maxValue) const;
 
+    /**
+     * Samples the \p variable into the \p slab, which contains the slices of a volume
+     * with the provided \p dimensions starting at slice \p firstSlice. The slices are
+     * sampled in parallel on the \p pool, each task with its own interpolator as the
+     * Kameleon interpolators cannot be shared between threads. The \p minValue and
+     * \p maxValue are updated with the values of the slab.
+     */
+    void readFloatVolumeSlab(volume::RawVolume<float>& slab, unsigned int firstSlice,
+        const glm::uvec3& dimensions, const std::string& variable,
+        const glm::vec3& lowerBound, const glm::vec3& upperBound, ThreadPool& pool,
+        float& minValue, float& maxValue) const;
+
     ghoul::Dictionary readMetaData() const;
 
     std::string time() const;
@@ -77,7 +90,6 @@ private:
 
     std::string _path;
     std::unique_ptr<ccmc::Kameleon> _kameleon;
-    std::unique_ptr<ccmc::Interpolator> _interpolator;
 };
 
 } // namespace openspace::kameleonvolume
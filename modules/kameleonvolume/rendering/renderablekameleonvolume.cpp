@@ -36,7 +36,9 @@
 #include <modules/volume/rendering/volumeclipplanes.h>
 #include <modules/volume/transferfunctionhandler.h>
 #include <modules/volume/volumegridtype.h>
+#include <modules/volume/volumemodule.h>
 #include <openspace/engine/globals.h>
+#include <openspace/engine/moduleengine.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/rendering/raycastermanager.h>
 #include <openspace/util/updatestructures.h>
@@ -267,8 +269,7 @@ RenderableKameleonVolume::~RenderableKameleonVolume() {}
 
 void RenderableKameleonVolume::initializeGL() {
     load();
-
-    _volumeTexture->uploadTexture();
+    uploadVolumeTexture();
 
     _raycaster = std::make_unique<volume::BasicVolumeRaycaster>(
         _volumeTexture,
@@ -433,6 +434,22 @@ void RenderableKameleonVolume::updateTextureFromVolume() {
     for (size_t i = 0; i < _normalizedVolume->nCells(); ++i) {
         out[i] = glm::clamp((in[i] - min) / diff, 0.f, 1.f);
     }
+}
+
+void RenderableKameleonVolume::uploadVolumeTexture() {
+    // The normalized volume stays in RAM so that the texture can be recreated after it
+    // has been evicted from the texture cache while the volume was not visible
+    const uint64_t size = static_cast<uint64_t>(_normalizedVolume->nCells()) *
+        sizeof(GLfloat);
+    volume::VolumeTextureCache& cache =
+        global::moduleEngine->module<VolumeModule>()->textureCache();
+    _cacheHandle = cache.allocate(size, [this]() {
+        _volumeTexture = nullptr;
+        if (_raycaster) {
+            _raycaster->setVolumeTexture(nullptr);
+        }
+        _cacheHandle = volume::VolumeTextureCache::InvalidHandle;
+    });
 
     _volumeTexture = std::make_shared<ghoul::opengl::Texture>(
         _dimensions,
@@ -446,6 +463,11 @@ void RenderableKameleonVolume::updateTextureFromVolume() {
 
     void* data = reinterpret_cast<void*>(_normalizedVolume->data());
     _volumeTexture->setPixelData(data, ghoul::opengl::Texture::TakeOwnership::No);
+    _volumeTexture->uploadTexture();
+
+    if (_raycaster) {
+        _raycaster->setVolumeTexture(_volumeTexture);
+    }
 }
 
 void RenderableKameleonVolume::storeRaw(const std::filesystem::path& path) {
@@ -454,6 +476,10 @@ void RenderableKameleonVolume::storeRaw(const std::filesystem::path& path) {
 }
 
 void RenderableKameleonVolume::deinitializeGL() {
+    global::moduleEngine->module<VolumeModule>()->textureCache().release(_cacheHandle);
+    _cacheHandle = volume::VolumeTextureCache::InvalidHandle;
+    _volumeTexture = nullptr;
+
     if (_raycaster) {
         global::raycasterManager->detachRaycaster(*_raycaster.get());
         _raycaster = nullptr;
@@ -466,11 +492,19 @@ bool RenderableKameleonVolume::isReady() const {
 
 void RenderableKameleonVolume::update(const UpdateData&) {
     if (_raycaster) {
+        if (!_volumeTexture) {
+            // The texture was evicted from the texture cache while it was not visible
+            uploadVolumeTexture();
+        }
         _raycaster->setStepSize(_stepSize);
     }
 }
 
 void RenderableKameleonVolume::render(const RenderData& data, RendererTasks& tasks) {
+    if (!_volumeTexture) {
+        return;
+    }
+    global::moduleEngine->module<VolumeModule>()->textureCache().use(_cacheHandle);
     tasks.raycasterTasks.push_back({ _raycaster.get(), data });
 }
 
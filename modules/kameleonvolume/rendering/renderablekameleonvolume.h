@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/volume/volumetexturecache.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/vector/uvec3property.h>
@@ -68,6 +69,7 @@ private:
 
     std::string cacheSuffix() const;
     void updateTextureFromVolume();
+    void uploadVolumeTexture();
     void updateRaycasterModelTransform();
 
     properties::UVec3Property _dimensions;
@@ -97,6 +99,8 @@ private:
     std::unique_ptr<volume::BasicVolumeRaycaster> _raycaster;
 
     std::shared_ptr<ghoul::opengl::Texture> _volumeTexture;
+    volume::VolumeTextureCache::Handle _cacheHandle =
+        volume::VolumeTextureCache::InvalidHandle;
     std::shared_ptr<openspace::TransferFunction> _transferFunction;
 };
 
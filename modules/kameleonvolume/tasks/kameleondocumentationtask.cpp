@@ -70,6 +70,14 @@ std::string KameleonDocumentationTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> KameleonDocumentationTask::inputFiles() const {
+    return { _inputPath };
+}
+
+std::vector<std::filesystem::path> KameleonDocumentationTask::outputFiles() const {
+    return { _outputPath };
+}
+
 void KameleonDocumentationTask::perform(const Task::ProgressCallback & progressCallback) {
     KameleonVolumeReader reader(_inputPath.string());
     ghoul::Dictionary kameleonDictionary = reader.readMetaData();
@@ -64,6 +64,14 @@ std::string KameleonMetadataToJsonTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> KameleonMetadataToJsonTask::inputFiles() const {
+    return { _inputPath };
+}
+
+std::vector<std::filesystem::path> KameleonMetadataToJsonTask::outputFiles() const {
+    return { _outputPath };
+}
+
 void KameleonMetadataToJsonTask::perform(const Task::ProgressCallback& progressCallback) {
     KameleonVolumeReader reader(_inputPath.string());
     ghoul::Dictionary dictionary = reader.readMetaData();
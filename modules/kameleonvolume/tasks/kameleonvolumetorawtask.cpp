@@ -25,16 +25,24 @@
 #include <modules/kameleonvolume/tasks/kameleonvolumetorawtask.h>
 
 #include <modules/kameleonvolume/kameleonvolumereader.h>
+#include <modules/volume/rawvolume.h>
 #include <modules/volume/rawvolumewriter.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/fmt.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/misc/dictionaryluaformatter.h>
+#include <algorithm>
 #include <array>
 #include <filesystem>
+#include <limits>
 #include <optional>
 
 namespace {
+    // The number of slices that each thread samples per slab. Only a single slab is kept
+    // in memory at a time, which bounds the memory use for large volumes
+    constexpr unsigned int SlicesPerThread = 4;
+
     struct [[codegen::Dictionary(KameleonVolumeToRawTask)]] Parameters {
         // The cdf file to extract data from
         std::filesystem::path input;
@@ -104,6 +112,14 @@ std::string KameleonVolumeToRawTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> KameleonVolumeToRawTask::inputFiles() const {
+    return { _inputPath };
+}
+
+std::vector<std::filesystem::path> KameleonVolumeToRawTask::outputFiles() const {
+    return { _rawVolumeOutputPath, _dictionaryOutputPath };
+}
+
 void KameleonVolumeToRawTask::perform(const Task::ProgressCallback& progressCallback) {
     KameleonVolumeReader reader(_inputPath.string());
 
@@ -123,19 +139,34 @@ void KameleonVolumeToRawTask::perform(const Task::ProgressCallback& progressCall
         );
     }
 
-    std::unique_ptr<volume::RawVolume<float>> rawVolume = reader.readFloatVolume(
-        _dimensions,
-        _variable,
-        _lowerDomainBound,
-        _upperDomainBound
-    );
-
-    progressCallback(0.5f);
+    // The task's Threads budget includes the thread that performs it, which takes part
+    // in the work of the pool
+    const unsigned int nThreads =
+        static_cast<unsigned int>(std::max(scheduling().nThreads, 1));
+    ThreadPool pool(nThreads - 1);
 
+    // The volume is sampled and written one slab at a time
+    float minValue = std::numeric_limits<float>::max();
+    float maxValue = -std::numeric_limits<float>::max();
     volume::RawVolumeWriter<float> writer(_rawVolumeOutputPath.string());
-    writer.write(*rawVolume);
-
-    progressCallback(0.9f);
+    writer.setDimensions(_dimensions);
+    writer.writeSlabs(
+        [&](volume::RawVolume<float>& slab, unsigned int firstSlice) {
+            reader.readFloatVolumeSlab(
+                slab,
+                firstSlice,
+                _dimensions,
+                _variable,
+                _lowerDomainBound,
+                _upperDomainBound,
+                pool,
+                minValue,
+                maxValue
+            );
+        },
+        nThreads * SlicesPerThread,
+        [&progressCallback](float progress) { progressCallback(0.9f * progress); }
+    );
 
     ghoul::Dictionary inputMetadata = reader.readMetaData();
     ghoul::Dictionary outputMetadata;
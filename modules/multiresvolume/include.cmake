@@ -0,0 +1,3 @@
+set (OPENSPACE_DEPENDENCIES
+  volume
+)
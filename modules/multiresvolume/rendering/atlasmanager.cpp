@@ -27,12 +27,20 @@
 #include <modules/multiresvolume/rendering/tsp.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/texture.h>
+#include <chrono>
 #include <cstring>
 
 namespace openspace {
 
 AtlasManager::AtlasManager(TSP* tsp) : _tsp(tsp) {}
 
+AtlasManager::~AtlasManager() {
+    // The I/O thread accesses our members, so it has to finish before we are destroyed
+    if (_pendingRead.valid()) {
+        _pendingRead.wait();
+    }
+}
+
 bool AtlasManager::initialize() {
     TSP::Header header = _tsp->header();
 
@@ -66,6 +74,21 @@ bool AtlasManager::initialize() {
 
     glGenBuffers(2, _pboHandle);
 
+    // The staging buffer is mapped persistently so that the I/O thread can write the
+    // bricks directly into memory that the atlas upload reads from
+    constexpr GLbitfield Flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pboHandle[EVEN]);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, _volumeSize, nullptr, Flags);
+    _mappedBuffer = reinterpret_cast<float*>(
+        glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, _volumeSize, Flags)
+    );
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (!_mappedBuffer) {
+        LERRORC("AtlasManager", "Failed to map PBO");
+        return false;
+    }
+
     glGenBuffers(1, &_atlasMapBuffer);
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, _atlasMapBuffer);
     glBufferData(
@@ -87,7 +110,32 @@ unsigned int AtlasManager::atlasMapBuffer() const {
     return _atlasMapBuffer;
 }
 
-void AtlasManager::updateAtlas(BufferIndex bufferIndex, std::vector<int>& brickIndices) {
+void AtlasManager::updateAtlas(BufferIndex, std::vector<int>& brickIndices) {
+    if (!_mappedBuffer) {
+        return;
+    }
+
+    if (_pendingRead.valid()) {
+        if (_pendingRead.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            // The previous brick selection is still being read, so we keep rendering
+            // with the current atlas rather than blocking the frame on the disk
+            return;
+        }
+        _pendingRead.get();
+        finishUpload();
+    }
+
+    if (_uploadFence) {
+        const GLenum res = glClientWaitSync(_uploadFence, 0, 0);
+        if (res != GL_ALREADY_SIGNALED && res != GL_CONDITION_SATISFIED) {
+            // The GPU is still reading the staging buffer from the last upload
+            return;
+        }
+        glDeleteSync(_uploadFence);
+        _uploadFence = nullptr;
+    }
+
     size_t nBrickIndices = brickIndices.size();
 
     _requiredBricks.clear();
@@ -106,17 +154,7 @@ void AtlasManager::updateAtlas(BufferIndex bufferIndex, std::vector<int>& brickI
     _nStreamedBricks = 0;
     _nDiskReads = 0;
 
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pboHandle[bufferIndex]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, _volumeSize, nullptr, GL_STREAM_DRAW);
-    float* mappedBuffer = reinterpret_cast<float*>(
-        glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY)
-    );
-
-    if (!mappedBuffer) {
-        LERRORC("AtlasManager", "Failed to map PBO");
-        return;
-    }
-
+    std::vector<BrickRead> reads;
     for (auto itStart = _requiredBricks.begin(); itStart != _requiredBricks.end();) {
         int firstBrick = *itStart;
         int lastBrick = firstBrick;
@@ -130,33 +168,32 @@ void AtlasManager::updateAtlas(BufferIndex bufferIndex, std::vector<int>& brickI
             lastBrick = *itEnd;
         }
 
-        addToAtlas(firstBrick, lastBrick, mappedBuffer);
+        addToAtlas(firstBrick, lastBrick, reads);
 
         itStart = itEnd;
     }
 
-    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
-
+    _pendingAtlasMap = _atlasMap;
     for (size_t i = 0; i < nBrickIndices; i++) {
-        _atlasMap[i] = _brickMap[brickIndices[i]];
+        _pendingAtlasMap[i] = _brickMap[brickIndices[i]];
     }
 
     std::swap(_prevRequiredBricks, _requiredBricks);
 
-    pboToAtlas(bufferIndex);
+    if (reads.empty()) {
+        // Nothing new has to be read, but the atlas map might still have changed
+        finishUpload();
+        return;
+    }
 
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _atlasMapBuffer);
-    GLint* to = reinterpret_cast<GLint*>(
-        glMapBuffer(GL_SHADER_STORAGE_BUFFER, GL_WRITE_ONLY)
+    _pendingRead = std::async(
+        std::launch::async,
+        [this, r = std::move(reads)]() { readBricks(r); }
     );
-    memcpy(to, _atlasMap.data(), sizeof(GLint)*_atlasMap.size());
-    glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
-    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
 void AtlasManager::addToAtlas(int firstBrickIndex, int lastBrickIndex,
-                              float* mappedBuffer)
+                              std::vector<BrickRead>& reads)
 {
     while (_brickMap.count(firstBrickIndex) && firstBrickIndex <= lastBrickIndex) {
         firstBrickIndex++;
@@ -168,16 +205,14 @@ void AtlasManager::addToAtlas(int firstBrickIndex, int lastBrickIndex,
         return;
     }
 
-    int sequenceLength = lastBrickIndex - firstBrickIndex + 1;
-    float* sequenceBuffer = new float[sequenceLength*_nBrickVals];
-    size_t bufferSize = sequenceLength * _brickSize;
-
-    long long offset = TSP::dataPosition() + static_cast<long long>(firstBrickIndex) *
-                       static_cast<long long>(_brickSize);
-    _tsp->file().seekg(offset);
-    _tsp->file().read(reinterpret_cast<char*>(sequenceBuffer), bufferSize);
+    BrickRead read;
+    read.firstBrick = firstBrickIndex;
+    read.lastBrick = lastBrickIndex;
+    read.atlasCoords.reserve(lastBrickIndex - firstBrickIndex + 1);
     _nDiskReads++;
 
+    // The atlas coordinates are assigned here so that the brick map is only ever
+    // modified on the main thread. The I/O thread only copies the data
     for (int brickIndex = firstBrickIndex; brickIndex <= lastBrickIndex; brickIndex++) {
         if (!_brickMap.count(brickIndex)) {
             unsigned int atlasCoords = _freeAtlasCoords.back();
@@ -189,15 +224,54 @@ void AtlasManager::addToAtlas(int firstBrickIndex, int lastBrickIndex,
             unsigned int atlasData = (level << 28) + atlasCoords;
             _brickMap.emplace(brickIndex, atlasData);
             _nStreamedBricks++;
-            fillVolume(
-                &sequenceBuffer[_nBrickVals*(brickIndex - firstBrickIndex)],
-                mappedBuffer,
-                atlasCoords
-            );
+            read.atlasCoords.push_back(atlasCoords);
+        }
+        else {
+            read.atlasCoords.push_back(NotUsedIndex);
+        }
+    }
+    reads.push_back(std::move(read));
+}
+
+void AtlasManager::readBricks(const std::vector<BrickRead>& reads) {
+    std::vector<float> sequenceBuffer;
+    for (const BrickRead& read : reads) {
+        int sequenceLength = read.lastBrick - read.firstBrick + 1;
+        sequenceBuffer.resize(static_cast<size_t>(sequenceLength) * _nBrickVals);
+        size_t bufferSize = sequenceLength * _brickSize;
+
+        long long offset = TSP::dataPosition() +
+            static_cast<long long>(read.firstBrick) * static_cast<long long>(_brickSize);
+        _tsp->file().seekg(offset);
+        _tsp->file().read(reinterpret_cast<char*>(sequenceBuffer.data()), bufferSize);
+
+        for (int i = 0; i < sequenceLength; i++) {
+            if (read.atlasCoords[i] != NotUsedIndex) {
+                fillVolume(
+                    &sequenceBuffer[_nBrickVals * i],
+                    _mappedBuffer,
+                    read.atlasCoords[i]
+                );
+            }
         }
     }
+}
 
-    delete[] sequenceBuffer;
+void AtlasManager::finishUpload() {
+    _atlasMap = std::move(_pendingAtlasMap);
+    _pendingAtlasMap.clear();
+
+    // There is only a single, persistently mapped staging buffer
+    pboToAtlas(EVEN);
+    _uploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, _atlasMapBuffer);
+    GLint* to = reinterpret_cast<GLint*>(
+        glMapBuffer(GL_SHADER_STORAGE_BUFFER, GL_WRITE_ONLY)
+    );
+    memcpy(to, _atlasMap.data(), sizeof(GLint)*_atlasMap.size());
+    glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
 void AtlasManager::removeFromAtlas(int brickIndex) {
@@ -26,7 +26,9 @@
 #define __OPENSPACE_MODULE_MULTIRESVOLUME___ATLASMANAGER___H__
 
 #include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
 #include <glm/gtx/std_based_type.hpp>
+#include <future>
 #include <map>
 #include <set>
 #include <string>
@@ -46,10 +48,17 @@ public:
     };
 
     AtlasManager(TSP* tsp);
-    ~AtlasManager() = default;
-
+    ~AtlasManager();
+
+    /**
+     * Requests that the atlas contains the bricks in \p brickIndices. The bricks that
+     * are not already in the atlas are read from disk on a separate thread into a
+     * persistently mapped staging buffer. Until that read has finished and the staging
+     * buffer has been uploaded into the atlas, the previous atlas stays in use, and
+     * requests that are made in the meantime are ignored. The \p bufferIndex is ignored
+     * as there is only a single staging buffer.
+     */
     void updateAtlas(BufferIndex bufferIndex, std::vector<int>& brickIndices);
-    void addToAtlas(int firstBrickIndex, int lastBrickIndex, float* mappedBuffer);
     void removeFromAtlas(int brickIndex);
     bool initialize();
     const std::vector<unsigned int>& atlasMap() const;
@@ -65,8 +74,22 @@ public:
     glm::size3_t textureSize() const;
 
 private:
+    /// A range of consecutive bricks in the TSP file that is read by the I/O thread
+    struct BrickRead {
+        int firstBrick = 0;
+        int lastBrick = 0;
+        /// The atlas coordinates for each brick in the range, or NotUsedIndex for bricks
+        /// that are already in the atlas
+        std::vector<unsigned int> atlasCoords;
+    };
+
     const unsigned int NotUsedIndex = std::numeric_limits<unsigned int>::max();
 
+    void addToAtlas(int firstBrickIndex, int lastBrickIndex,
+        std::vector<BrickRead>& reads);
+    void readBricks(const std::vector<BrickRead>& reads);
+    void finishUpload();
+
     TSP* _tsp;
     unsigned int _pboHandle[2];
     unsigned int _atlasMapBuffer;
@@ -79,6 +102,15 @@ private:
 
     ghoul::opengl::Texture* _textureAtlas;
 
+    // The staging buffer that the I/O thread writes into, which is mapped for the
+    // lifetime of the atlas manager. As it keeps its contents, only the bricks that are
+    // new to the atlas have to be written
+    float* _mappedBuffer = nullptr;
+    // Signalled once the GPU has finished reading the staging buffer for an upload
+    GLsync _uploadFence = nullptr;
+    std::future<void> _pendingRead;
+    std::vector<unsigned int> _pendingAtlasMap;
+
     // Stats
     unsigned int _nUsedBricks;
     unsigned int _nStreamedBricks;
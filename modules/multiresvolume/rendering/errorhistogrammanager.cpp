@@ -25,7 +25,9 @@
 #include <modules/multiresvolume/rendering/errorhistogrammanager.h>
 
 #include <modules/multiresvolume/rendering/tsp.h>
-#include <openspace/util/progressbar.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/fmt.h>
 
@@ -36,8 +38,8 @@ ErrorHistogramManager::ErrorHistogramManager(TSP* tsp) : _tsp(tsp) {}
 bool ErrorHistogramManager::buildHistograms(int numBins) {
     _numBins = numBins;
 
-    _file = &(_tsp->file());
-    if (!_file->is_open()) {
+    const TSP::MappedVoxels voxels(*_tsp);
+    if (!voxels.isValid()) {
         return false;
     }
     _minBin = 0.f; // Should be calculated from tsp file
@@ -56,127 +58,105 @@ bool ErrorHistogramManager::buildHistograms(int numBins) {
         fmt::format("Build {} histograms with {} bins each", _numInnerNodes, numBins)
     );
 
-    // All TSP Leaves
-    int numOtNodes = _tsp->numOTNodes();
-    int otOffset = static_cast<int>((pow(8, numOtLevels - 1) - 1) / 7);
-
-    int numBstNodes = _tsp->numBSTNodes();
-    int bstOffset = numBstNodes / 2;
-
-    int numberOfLeaves = (numBstNodes - bstOffset) * (numOtNodes - otOffset);
-    ProgressBar pb(numberOfLeaves);
-    int processedLeaves = 0;
-    bool success = true;
-    for (int bst = bstOffset; bst < numBstNodes; bst++) {
-        for (int ot = otOffset; ot < numOtNodes; ot++) {
-            success &= buildFromLeaf(bst, ot);
-            if (!success) {
-                return false;
-            }
-            pb.print(++processedLeaves);
+    // Each inner node collects the errors of all TSP leaves below it, so the histograms
+    // do not depend on each other and can be built concurrently. The root comes first
+    // and has the most leaves, so the largest tasks are started first
+    ThreadPool& pool = global::openSpaceEngine->threadPool();
+    pool.parallelFor(0, _numInnerNodes, 1, [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; i++) {
+            buildInnerNode(voxels, static_cast<unsigned int>(i));
         }
-    }
+    });
 
-    return success;
+    return true;
 }
 
-bool ErrorHistogramManager::buildFromLeaf(unsigned int bstOffset,
-                                          unsigned int octreeOffset)
+void ErrorHistogramManager::buildInnerNode(const TSP::MappedVoxels& voxels,
+                                           unsigned int innerNodeIndex)
 {
-    // Traverse all ancestors of leaf and add errors to their histograms
-
-    unsigned int brickDim = _tsp->brickDim();
-    unsigned int paddedBrickDim = _tsp->paddedBrickDim();
-    unsigned int padding = (paddedBrickDim - brickDim) / 2;
-
-    int numOtNodes = _tsp->numOTNodes();
-    unsigned int leafIndex = bstOffset * numOtNodes + octreeOffset;
-    std::vector<float> leafValues = readValues(leafIndex);
-//    int numVoxels = leafValues.size();
-
-    int bstNode = bstOffset;
-    bool bstRightOnly = true;
-    unsigned int bstLevel = 0;
-
-    do {
-        glm::vec3 leafOffset(0.f); // Leaf offset in leaf sized voxels
-        unsigned int octreeLevel = 0;
-        unsigned int octreeNode = octreeOffset;
-        bool octreeLastOnly = true;
-        do {
-            // Visit ancestor
-            if (bstNode != static_cast<int>(bstOffset) || octreeNode != octreeOffset) {
-                // Is actually an ancestor
-
-                std::vector<float> ancestorVoxels;
-                unsigned int ancestorBrickIndex = bstNode * numOtNodes + octreeNode;
-                unsigned int innerNodeIndex = brickToInnerNodeIndex(ancestorBrickIndex);
-                auto it = _voxelCache.find(innerNodeIndex);
-                if (it == _voxelCache.end()) {
-                    // First visit
-                    _histograms[innerNodeIndex] = Histogram(_minBin, _maxBin, _numBins);
-                    ancestorVoxels = readValues(ancestorBrickIndex);
-                    _voxelCache[innerNodeIndex] = ancestorVoxels;
-                }
-                else {
-                    ancestorVoxels = it->second;
-                }
-
-                float voxelScale = static_cast<float>(pow(2.f, octreeLevel));
-                float invVoxelScale = 1.f / voxelScale;
-
-                // Calculate leaf offset in ancestor sized voxels
-                glm::vec3 ancestorOffset = (leafOffset * invVoxelScale) +
-                                           glm::vec3(padding - 0.5f);
-
-                for (int z = 0; z < static_cast<int>(brickDim); z++) {
-                    for (int y = 0; y < static_cast<int>(brickDim); y++) {
-                        for (int x = 0; x < static_cast<int>(brickDim); x++) {
-                            glm::vec3 leafSamplePoint = glm::vec3(x, y, z) +
-                                                   glm::vec3(static_cast<float>(padding));
-                            glm::vec3 ancestorSamplePoint = ancestorOffset +
-                                (glm::vec3(x, y, z) + glm::vec3(0.5)) * invVoxelScale;
-                            float leafValue = leafValues[linearCoords(leafSamplePoint)];
-                            float ancestorValue = interpolate(
-                                ancestorSamplePoint,
-                                ancestorVoxels
-                            );
-
-                            _histograms[innerNodeIndex].addRectangle(
-                                leafValue,
-                                ancestorValue,
-                                std::abs(leafValue - ancestorValue)
-                            );
-                        }
-                    }
-                }
+    const unsigned int brickDim = _tsp->brickDim();
+    const unsigned int paddedBrickDim = _tsp->paddedBrickDim();
+    const unsigned int padding = (paddedBrickDim - brickDim) / 2;
 
-                if (bstRightOnly && octreeLastOnly) {
-                    _voxelCache.erase(innerNodeIndex);
-                }
-            }
+    const unsigned int numOtNodes = _tsp->numOTNodes();
+    const unsigned int brickIndex = innerNodeToBrickIndex(innerNodeIndex);
+    const unsigned int bstNode = brickIndex / numOtNodes;
+    const unsigned int octreeNode = brickIndex % numOtNodes;
+
+    // The leaves below a node form a consecutive range in the last level of each tree
+    const unsigned int numBstInnerNodes = _tsp->numBSTNodes() / 2;
+    unsigned int firstBstLeaf = bstNode;
+    unsigned int lastBstLeaf = bstNode;
+    while (firstBstLeaf < numBstInnerNodes) {
+        firstBstLeaf = 2 * firstBstLeaf + 1;
+        lastBstLeaf = 2 * lastBstLeaf + 2;
+    }
 
-            // Traverse to next octree ancestor
-            int octreeChild = (octreeNode - 1) % 8;
-            octreeLastOnly &= octreeChild == 7;
-            octreeNode = parentOffset(octreeNode, 8);
+    const unsigned int numOtInnerNodes =
+        static_cast<unsigned int>((pow(8, _tsp->numOTLevels() - 1) - 1) / 7);
+    unsigned int firstOctreeLeaf = octreeNode;
+    unsigned int lastOctreeLeaf = octreeNode;
+    unsigned int octreeLevel = 0;
+    while (firstOctreeLeaf < numOtInnerNodes) {
+        firstOctreeLeaf = 8 * firstOctreeLeaf + 1;
+        lastOctreeLeaf = 8 * lastOctreeLeaf + 8;
+        octreeLevel++;
+    }
 
-            int childSize = static_cast<int>(pow(2, octreeLevel) * brickDim);
+    Histogram histogram(_minBin, _maxBin, _numBins);
+    const float* ancestorVoxels = voxels.brick(brickIndex);
+    const float voxelScale = static_cast<float>(pow(2.f, octreeLevel));
+    const float invVoxelScale = 1.f / voxelScale;
+
+    for (unsigned int octreeLeaf = firstOctreeLeaf; octreeLeaf <= lastOctreeLeaf;
+         octreeLeaf++)
+    {
+        // Leaf offset in leaf sized voxels. Each octal digit of the position of the leaf
+        // within the range is the child index on the path, starting at the leaf level
+        glm::vec3 leafOffset(0.f);
+        unsigned int path = octreeLeaf - firstOctreeLeaf;
+        for (unsigned int level = 0; level < octreeLevel; level++) {
+            const unsigned int octreeChild = path % 8;
+            path /= 8;
+
+            const int childSize = static_cast<int>(pow(2, level) * brickDim);
             leafOffset.x += (octreeChild % 2) * childSize;
             leafOffset.y += ((octreeChild / 2) % 2) * childSize;
             leafOffset.z += (octreeChild / 4) * childSize;
+        }
 
-            octreeLevel++;
-        // @TODO(emiax):  This does not make sense? unsigned int check against -1
-        } while (octreeNode != -1);
+        // Calculate leaf offset in ancestor sized voxels
+        const glm::vec3 ancestorOffset = (leafOffset * invVoxelScale) +
+                                         glm::vec3(padding - 0.5f);
 
-        bstRightOnly &= (bstNode % 2 == 0);
-        bstNode = parentOffset(bstNode, 2);
+        for (unsigned int bstLeaf = firstBstLeaf; bstLeaf <= lastBstLeaf; bstLeaf++) {
+            const float* leafValues = voxels.brick(bstLeaf * numOtNodes + octreeLeaf);
 
-        bstLevel++;
-    } while (bstNode != -1);
+            for (int z = 0; z < static_cast<int>(brickDim); z++) {
+                for (int y = 0; y < static_cast<int>(brickDim); y++) {
+                    for (int x = 0; x < static_cast<int>(brickDim); x++) {
+                        glm::vec3 leafSamplePoint = glm::vec3(x, y, z) +
+                                                   glm::vec3(static_cast<float>(padding));
+                        glm::vec3 ancestorSamplePoint = ancestorOffset +
+                            (glm::vec3(x, y, z) + glm::vec3(0.5)) * invVoxelScale;
+                        float leafValue = leafValues[linearCoords(leafSamplePoint)];
+                        float ancestorValue = interpolate(
+                            ancestorSamplePoint,
+                            ancestorVoxels
+                        );
+
+                        histogram.addRectangle(
+                            leafValue,
+                            ancestorValue,
+                            std::abs(leafValue - ancestorValue)
+                        );
+                    }
+                }
+            }
+        }
+    }
 
-    return true;
+    _histograms[innerNodeIndex] = std::move(histogram);
 }
 
 bool ErrorHistogramManager::loadFromFile(const std::filesystem::path& filename) {
@@ -251,7 +231,7 @@ unsigned int ErrorHistogramManager::linearCoords(const glm::ivec3& coords) const
 }
 
 float ErrorHistogramManager::interpolate(const glm::vec3& samplePoint,
-                                         const std::vector<float>& voxels) const
+                                         const float* voxels) const
 {
     const int lowX = static_cast<int>(samplePoint.x);
     const int lowY = static_cast<int>(samplePoint.y);
@@ -296,43 +276,6 @@ const Histogram* ErrorHistogramManager::histogram(unsigned int brickIndex) const
     }
 }
 
-int ErrorHistogramManager::parentOffset(int offset, int base) const {
-    if (offset == 0) {
-        return -1;
-    }
-    const int depth = static_cast<int>(
-        floor(log1p(((base - 1) * offset)) / log(base))
-    );
-    const int firstInLevel = static_cast<int>((pow(base, depth) - 1) / (base - 1));
-    const int inLevelOffset = offset - firstInLevel;
-
-    const int parentDepth = depth - 1;
-    const int firstInParentLevel = static_cast<int>(
-        (pow(base, parentDepth) - 1) / (base - 1)
-    );
-    const int parentInLevelOffset = inLevelOffset / base;
-
-    const int parentOffset = firstInParentLevel + parentInLevelOffset;
-    return parentOffset;
-}
-
-std::vector<float> ErrorHistogramManager::readValues(unsigned int brickIndex) const {
-    const unsigned int paddedBrickDim = _tsp->paddedBrickDim();
-    const unsigned int numBrickVals = paddedBrickDim * paddedBrickDim * paddedBrickDim;
-    std::vector<float> voxelValues(numBrickVals);
-
-    std::streampos offset = _tsp->dataPosition() +
-        static_cast<long long>(brickIndex*numBrickVals*sizeof(float));
-    _file->seekg(offset);
-
-    _file->read(
-        reinterpret_cast<char*>(voxelValues.data()),
-        static_cast<size_t>(numBrickVals)*sizeof(float)
-    );
-
-    return voxelValues;
-}
-
 unsigned int ErrorHistogramManager::brickToInnerNodeIndex(unsigned int brickIndex) const {
     const unsigned int numOtNodes = _tsp->numOTNodes();
     const unsigned int numBstLevels = _tsp->numBSTLevels();
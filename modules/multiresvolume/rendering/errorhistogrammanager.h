@@ -25,16 +25,13 @@
 #ifndef __OPENSPACE_MODULE_MULTIRESVOLUME___ERRORHISTOGRAMMANAGER___H__
 #define __OPENSPACE_MODULE_MULTIRESVOLUME___ERRORHISTOGRAMMANAGER___H__
 
+#include <modules/multiresvolume/rendering/tsp.h>
 #include <openspace/util/histogram.h>
 #include <ghoul/glm.h>
 #include <filesystem>
-#include <iosfwd>
-#include <map>
 
 namespace openspace {
 
-class TSP;
-
 class ErrorHistogramManager {
 public:
     ErrorHistogramManager(TSP* tsp);
@@ -48,7 +45,6 @@ public:
 
 private:
     TSP* _tsp;
-    std::ifstream* _file;
 
     std::vector<Histogram> _histograms;
     unsigned int _numInnerNodes;
@@ -56,12 +52,7 @@ private:
     float _maxBin;
     int _numBins;
 
-    std::map<unsigned int, std::vector<float>> _voxelCache;
-
-    bool buildFromLeaf(unsigned int bstOffset, unsigned int octreeOffset);
-    std::vector<float> readValues(unsigned int brickIndex) const;
-
-    int parentOffset(int offset, int base) const;
+    void buildInnerNode(const TSP::MappedVoxels& voxels, unsigned int innerNodeIndex);
 
     unsigned int brickToInnerNodeIndex(unsigned int brickIndex) const;
     unsigned int innerNodeToBrickIndex(unsigned int innerNodeIndex) const;
@@ -69,8 +60,7 @@ private:
     unsigned int linearCoords(int x, int y, int z) const;
     unsigned int linearCoords(const glm::ivec3& coords) const;
 
-    float interpolate(const glm::vec3& samplePoint,
-        const std::vector<float>& voxels) const;
+    float interpolate(const glm::vec3& samplePoint, const float* voxels) const;
 };
 
 } // namespace openspace
@@ -25,26 +25,62 @@
 #include <modules/multiresvolume/rendering/histogrammanager.h>
 
 #include <modules/multiresvolume/rendering/tsp.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
+#include <openspace/util/threadpool.h>
 #include <cstring>
 #include <string>
 
+namespace {
+    // The number of bricks that are processed by a single task
+    constexpr size_t BrickGrainSize = 16;
+} // namespace
+
 namespace openspace {
 
 bool HistogramManager::buildHistograms(TSP* tsp, int numBins) {
     _numBins = numBins;
 
-    std::ifstream& file = tsp->file();
-    if (!file.is_open()) {
+    const TSP::MappedVoxels voxels(*tsp);
+    if (!voxels.isValid()) {
         return false;
     }
     _minBin = 0.f; // Should be calculated from tsp file
     _maxBin = 1.f; // Should be calculated from tsp file
 
-    const int numTotalNodes = tsp->numTotalNodes();
+    const unsigned int numTotalNodes = tsp->numTotalNodes();
     _histograms = std::vector<Histogram>(numTotalNodes);
 
-    const bool success = buildHistogram(tsp, 0);
-    return success;
+    // Almost all of the time is spent in the TSP leaves, whose histograms are built from
+    // their own voxels only, so they can be built concurrently
+    const unsigned int paddedBrickDim = tsp->paddedBrickDim();
+    const unsigned int numBrickVals = paddedBrickDim * paddedBrickDim * paddedBrickDim;
+    ThreadPool& pool = global::openSpaceEngine->threadPool();
+    pool.parallelFor(0, numTotalNodes, BrickGrainSize, [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; i++) {
+            const unsigned int brickIndex = static_cast<unsigned int>(i);
+            if (!tsp->isBstLeaf(brickIndex) || !tsp->isOctreeLeaf(brickIndex)) {
+                continue;
+            }
+
+            Histogram histogram(_minBin, _maxBin, _numBins);
+            const float* voxelValues = voxels.brick(brickIndex);
+            for (unsigned int v = 0; v < numBrickVals; v++) {
+                histogram.add(voxelValues[v], 1.0);
+            }
+            _histograms[brickIndex] = std::move(histogram);
+        }
+    });
+
+    // The children of a brick always have a larger index than the brick itself, so the
+    // histograms of the inner nodes can be merged bottom-up in reverse order
+    for (unsigned int brickIndex = numTotalNodes; brickIndex-- > 0;) {
+        if (!buildHistogram(tsp, brickIndex)) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 Histogram* HistogramManager::histogram(unsigned int brickIndex) {
@@ -52,49 +88,32 @@ Histogram* HistogramManager::histogram(unsigned int brickIndex) {
 }
 
 bool HistogramManager::buildHistogram(TSP* tsp, unsigned int brickIndex) {
-    Histogram histogram(_minBin, _maxBin, _numBins);
     const bool isBstLeaf = tsp->isBstLeaf(brickIndex);
     const bool isOctreeLeaf = tsp->isOctreeLeaf(brickIndex);
-
     if (isBstLeaf && isOctreeLeaf) {
-        // TSP leaf, read from file and build histogram
-        std::vector<float> voxelValues = readValues(tsp, brickIndex);
-        size_t numVoxels = voxelValues.size();
+        // TSP leaf, already built from the voxels
+        return _histograms[brickIndex].isValid();
+    }
 
-        for (size_t v = 0; v < numVoxels; ++v) {
-            histogram.add(voxelValues[v], 1.0);
-        }
+    // If the node has both BST and Octree children, only the BST ones are added
+    std::vector<unsigned int> children;
+    if (!isBstLeaf) {
+        children.push_back(tsp->bstLeft(brickIndex));
+        children.push_back(tsp->bstRight(brickIndex));
     }
     else {
-        // Has children
-        std::vector<unsigned int> children;
-
-        if (!isBstLeaf) {
-            // Push BST children
-            children.push_back(tsp->bstLeft(brickIndex));
-            children.push_back(tsp->bstRight(brickIndex));
-        }
-        if (!isOctreeLeaf) {
-            // Push Octree children
-            const unsigned int firstChild = tsp->firstOctreeChild(brickIndex);
-            for (int c = 0; c < 8; c++) {
-                children.push_back(firstChild + c);
-            }
+        const unsigned int firstChild = tsp->firstOctreeChild(brickIndex);
+        for (unsigned int c = 0; c < 8; c++) {
+            children.push_back(firstChild + c);
         }
-        size_t numChildren = children.size();
-        for (size_t c = 0; c < numChildren; c++) {
-            // Visit child
-            const unsigned int childIndex = children[c];
-            if (_histograms[childIndex].isValid() || buildHistogram(tsp, childIndex)) {
-                if (numChildren <= 8 || c < 2) {
-                    // If node has both BST and Octree children, only add BST ones
-                    histogram.add(_histograms[childIndex]);
-                }
-            }
-            else {
-                return false;
-            }
+    }
+
+    Histogram histogram(_minBin, _maxBin, _numBins);
+    for (unsigned int childIndex : children) {
+        if (!_histograms[childIndex].isValid()) {
+            return false;
         }
+        histogram.add(_histograms[childIndex]);
     }
 
     //histogram.normalize();
@@ -103,24 +122,6 @@ bool HistogramManager::buildHistogram(TSP* tsp, unsigned int brickIndex) {
     return true;
 }
 
-std::vector<float> HistogramManager::readValues(TSP* tsp, unsigned int brickIndex) {
-    const unsigned int paddedBrickDim = tsp->paddedBrickDim();
-    const unsigned int numBrickVals = paddedBrickDim * paddedBrickDim * paddedBrickDim;
-    std::vector<float> voxelValues(numBrickVals);
-
-    std::streampos offset = tsp->dataPosition() +
-                            static_cast<long long>(brickIndex*numBrickVals*sizeof(float));
-    std::ifstream& file = tsp->file();
-    file.seekg(offset);
-
-    file.read(
-        reinterpret_cast<char*>(voxelValues.data()),
-        static_cast<size_t>(numBrickVals)*sizeof(float)
-    );
-
-    return voxelValues;
-}
-
 bool HistogramManager::loadFromFile(const std::filesystem::path& filename) {
     std::ifstream file(filename, std::ios::in | std::ios::binary);
     if (!file.is_open()) {
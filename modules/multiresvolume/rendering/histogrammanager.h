@@ -41,7 +41,6 @@ public:
 
 private:
     bool buildHistogram(TSP* tsp, unsigned int brickIndex);
-    std::vector<float> readValues(TSP* tsp, unsigned int brickIndex);
 
     std::vector<Histogram> _histograms;
     float _minBin = 0.f;
@@ -25,16 +25,13 @@
 #ifndef __OPENSPACE_MODULE_MULTIRESVOLUME___LOCALERRORHISTOGRAMMANAGER___H__
 #define __OPENSPACE_MODULE_MULTIRESVOLUME___LOCALERRORHISTOGRAMMANAGER___H__
 
+#include <modules/multiresvolume/rendering/tsp.h>
 #include <openspace/util/histogram.h>
 #include <ghoul/glm.h>
 #include <filesystem>
-#include <iosfwd>
-#include <map>
 
 namespace openspace {
 
-class TSP;
-
 class LocalErrorHistogramManager {
 public:
     LocalErrorHistogramManager(TSP* tsp);
@@ -48,7 +45,6 @@ public:
 
 private:
     TSP* _tsp = nullptr;
-    std::ifstream* _file;
 
     std::vector<Histogram> _spatialHistograms;
     std::vector<Histogram> _temporalHistograms;
@@ -57,14 +53,10 @@ private:
     float _maxBin = 0.f;
     int _numBins = 0;
 
-    std::map<unsigned int, std::vector<float>> _voxelCache;
-
-    bool buildFromOctreeChild(unsigned int bstOffset, unsigned int octreeOffset);
-    bool buildFromBstChild(unsigned int bstOffset, unsigned int octreeOffset);
-
-    std::vector<float> readValues(unsigned int brickIndex) const;
-
-    int parentOffset(int offset, int base) const;
+    Histogram buildSpatialHistogram(const TSP::MappedVoxels& voxels,
+        unsigned int innerNodeIndex) const;
+    Histogram buildTemporalHistogram(const TSP::MappedVoxels& voxels,
+        unsigned int innerNodeIndex) const;
 
     unsigned int brickToInnerNodeIndex(unsigned int brickIndex) const;
     unsigned int innerNodeToBrickIndex(unsigned int innerNodeIndex) const;
@@ -72,7 +64,7 @@ private:
     unsigned int linearCoords(int x, int y, int z) const;
     unsigned int linearCoords(glm::ivec3 coords) const;
 
-    float interpolate(glm::vec3 samplePoint, const std::vector<float>& voxels) const;
+    float interpolate(glm::vec3 samplePoint, const float* voxels) const;
 };
 
 } // namespace openspace
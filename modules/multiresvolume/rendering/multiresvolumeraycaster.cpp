@@ -101,7 +101,10 @@ void MultiresVolumeRaycaster::preRaycast(const RaycastData& data,
 {
     std::string id = std::to_string(data.id);
     //program.setUniform("opacity_" + std::to_string(id), visible ? 1.0f : 0.0f);
-    program.setUniform("stepSizeCoefficient_" + id, _stepSizeCoefficient);
+    program.setUniform(
+        "stepSizeCoefficient_" + id,
+        _stepSizeCoefficient * stepSizeScale()
+    );
 
     _tfUnit = std::make_unique<ghoul::opengl::TextureUnit>();
     _tfUnit->activate();
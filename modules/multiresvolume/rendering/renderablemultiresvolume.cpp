@@ -35,7 +35,9 @@
 #include <modules/multiresvolume/rendering/simpletfbrickselector.h>
 #include <modules/multiresvolume/rendering/tfbrickselector.h>
 #include <modules/multiresvolume/rendering/tsp.h>
+#include <modules/volume/volumemodule.h>
 #include <openspace/engine/globals.h>
+#include <openspace/engine/moduleengine.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/rendering/raycastermanager.h>
 #include <openspace/rendering/transferfunction.h>
@@ -68,6 +70,10 @@ namespace {
     constexpr std::string_view KeyStartTime = "StartTime";
     constexpr std::string_view KeyEndTime = "EndTime";
 
+    // Delay after the last transfer function change before the bricks are reselected, so
+    // that dragging an envelope doesn't recompute the brick errors in every frame
+    constexpr std::chrono::milliseconds TfChangeDelay = std::chrono::milliseconds(250);
+
     constexpr openspace::properties::Property::PropertyInfo StepSizeCoefficientInfo = {
         "StepSizeCoefficient",
         "Stepsize Coefficient",
@@ -338,7 +344,8 @@ void RenderableMultiresVolume::setSelectorType(Selector selector) {
                     _streamingBudget
                 );
                 _transferFunction->setCallback([this](const TransferFunction&) {
-                    _tfBrickSelector->calculateBrickErrors();
+                    _hasPendingTfChange = true;
+                    _lastTfChange = std::chrono::steady_clock::now();
                 });
                 if (initializeSelector()) {
                     _tfBrickSelector->calculateBrickErrors();
@@ -358,7 +365,8 @@ void RenderableMultiresVolume::setSelectorType(Selector selector) {
                     _streamingBudget
                 );
                 _transferFunction->setCallback([this](const TransferFunction&) {
-                    _simpleTfBrickSelector->calculateBrickImportances();
+                    _hasPendingTfChange = true;
+                    _lastTfChange = std::chrono::steady_clock::now();
                 });
                 if (initializeSelector()) {
                     _simpleTfBrickSelector->calculateBrickImportances();
@@ -379,7 +387,8 @@ void RenderableMultiresVolume::setSelectorType(Selector selector) {
                     _streamingBudget
                 );
                 _transferFunction->setCallback([this](const TransferFunction&) {
-                    _localTfBrickSelector->calculateBrickErrors();
+                    _hasPendingTfChange = true;
+                    _lastTfChange = std::chrono::steady_clock::now();
                 });
                 if (initializeSelector()) {
                     _localTfBrickSelector->calculateBrickErrors();
@@ -390,6 +399,26 @@ void RenderableMultiresVolume::setSelectorType(Selector selector) {
     }
 }
 
+void RenderableMultiresVolume::updateBrickSelection() {
+    switch (_selector) {
+        case Selector::TF:
+            if (_tfBrickSelector) {
+                _tfBrickSelector->calculateBrickErrors();
+            }
+            break;
+        case Selector::SIMPLE:
+            if (_simpleTfBrickSelector) {
+                _simpleTfBrickSelector->calculateBrickImportances();
+            }
+            break;
+        case Selector::LOCAL:
+            if (_localTfBrickSelector) {
+                _localTfBrickSelector->calculateBrickErrors();
+            }
+            break;
+    }
+}
+
 void RenderableMultiresVolume::initializeGL() {
     bool success = _tsp && _tsp->load();
 
@@ -427,6 +456,14 @@ void RenderableMultiresVolume::initializeGL() {
     }
 
     success &= _atlasManager && _atlasManager->initialize();
+    if (_atlasManager) {
+        // The atlas has a fixed size and the bricks are streamed into it, so it can't be
+        // evicted, but it still counts against the budget shared by all volumes
+        const glm::size3_t size = _atlasManager->textureSize();
+        const uint64_t bytes = static_cast<uint64_t>(size.x) * size.y * size.z * 4;
+        _atlasCacheHandle = global::moduleEngine->module<VolumeModule>()->textureCache()
+            .allocate(bytes, nullptr);
+    }
 
     _transferFunction->update();
 
@@ -458,6 +495,10 @@ void RenderableMultiresVolume::initializeGL() {
 }
 
 void RenderableMultiresVolume::deinitializeGL() {
+    global::moduleEngine->module<VolumeModule>()->textureCache().release(
+        _atlasCacheHandle
+    );
+    _atlasCacheHandle = volume::VolumeTextureCache::InvalidHandle;
     _tsp = nullptr;
     _transferFunction = nullptr;
 }
@@ -638,6 +679,13 @@ void RenderableMultiresVolume::update(const UpdateData& data) {
     _timestep++;
     _time = data.time.j2000Seconds();
 
+    if (_hasPendingTfChange &&
+        std::chrono::steady_clock::now() - _lastTfChange > TfChangeDelay)
+    {
+        updateBrickSelection();
+        _hasPendingTfChange = false;
+    }
+
     if (_gatheringStats) {
         std::chrono::system_clock::time_point frameEnd = std::chrono::system_clock::now();
         std::chrono::duration<double> frameDuration = frameEnd - _frameStart;
@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/volume/volumetexturecache.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
@@ -70,6 +71,10 @@ public:
     void setSelectorType(Selector selector);
     bool initializeSelector();
 
+    /// Recomputes the brick errors or importances of the current selector after the
+    /// transfer function has changed
+    void updateBrickSelection();
+
     void initializeGL() override;
     void deinitializeGL() override;
 
@@ -131,6 +136,8 @@ private:
     std::vector<int> _brickIndices;
 
     std::shared_ptr<AtlasManager> _atlasManager;
+    volume::VolumeTextureCache::Handle _atlasCacheHandle =
+        volume::VolumeTextureCache::InvalidHandle;
 
     std::unique_ptr<MultiresVolumeRaycaster> _raycaster;
 
@@ -140,6 +147,11 @@ private:
 
     Selector _selector;
 
+    /// Set when the transfer function changes, the brick selection is only updated once
+    /// the transfer function has stopped changing for a short while
+    bool _hasPendingTfChange = false;
+    std::chrono::steady_clock::time_point _lastTfChange;
+
     std::unique_ptr<HistogramManager> _histogramManager;
     std::unique_ptr<ErrorHistogramManager> _errorHistogramManager;
     std::unique_ptr<LocalErrorHistogramManager> _localErrorHistogramManager;
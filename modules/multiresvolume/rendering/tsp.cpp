@@ -30,16 +30,77 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/logging/logmanager.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
+#include <openspace/util/threadpool.h>
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <numeric>
 #include <queue>
 
 namespace {
     constexpr std::string_view _loggerCat = "TSP";
+
+    // The number of bricks that are processed by a single task of the error passes
+    constexpr size_t BrickGrainSize = 16;
+
+    // Returns the sum of the squared differences between the values and the mean. The
+    // sum is split into independent lanes so that the compiler can vectorize the loop
+    float sumSquaredDifferences(const float* values, size_t n, float mean) {
+        constexpr size_t NLanes = 8;
+        std::array<float, NLanes> lanes = {};
+        size_t i = 0;
+        for (; i + NLanes <= n; i += NLanes) {
+            for (size_t l = 0; l < NLanes; l++) {
+                const float d = values[i + l] - mean;
+                lanes[l] += d * d;
+            }
+        }
+        float sum = std::accumulate(lanes.begin(), lanes.end(), 0.f);
+        for (; i < n; i++) {
+            const float d = values[i] - mean;
+            sum += d * d;
+        }
+        return sum;
+    }
+
+    // Adds the squared difference of each value in the brick to the corresponding mean
+    // to the sums
+    void accumulateSquaredDifferences(const float* values, const float* means,
+                                      float* sums, size_t n)
+    {
+        for (size_t i = 0; i < n; i++) {
+            const float d = values[i] - means[i];
+            sums[i] += d * d;
+        }
+    }
 } // namespace
 
 namespace openspace {
 
+TSP::MappedVoxels::MappedVoxels(const TSP& tsp)
+    : _mapping(tsp._filename)
+    , _numBrickVals(
+        static_cast<size_t>(tsp._paddedBrickDim) * tsp._paddedBrickDim *
+        tsp._paddedBrickDim
+    )
+{
+    const size_t expectedSize = dataPosition() +
+        static_cast<size_t>(tsp._numTotalNodes) * _numBrickVals * sizeof(float);
+    _isValid = _mapping.size() >= expectedSize;
+}
+
+bool TSP::MappedVoxels::isValid() const {
+    return _isValid;
+}
+
+const float* TSP::MappedVoxels::brick(unsigned int brickIndex) const {
+    const float* voxels =
+        reinterpret_cast<const float*>(_mapping.data() + dataPosition());
+    return voxels + static_cast<size_t>(brickIndex) * _numBrickVals;
+}
+
 TSP::TSP(const std::string& filename)
     : _filename(filename)
 {
@@ -269,83 +330,72 @@ GLuint TSP::ssbo() const {
 bool TSP::calculateSpatialError() {
     unsigned int numBrickVals = _paddedBrickDim*_paddedBrickDim*_paddedBrickDim;
 
-    if (!_file.is_open()) {
+    const MappedVoxels voxels(*this);
+    if (!voxels.isValid()) {
+        LERROR(fmt::format("Could not map {}", _filename));
         return false;
     }
+    auto brickData = [&voxels](unsigned int brick) { return voxels.brick(brick); };
 
-    std::vector<float> buffer(numBrickVals);
     std::vector<float> averages(_numTotalNodes);
     std::vector<float> stdDevs(_numTotalNodes);
 
+    ThreadPool& pool = global::openSpaceEngine->threadPool();
+
     // First pass: Calculate average color for each brick
     LDEBUG("Calculating spatial error, first pass");
-    for (unsigned int brick = 0; brick<_numTotalNodes; ++brick) {
-        // Offset in file
-        std::streampos offset = dataPosition() +
-                                static_cast<long long>(brick*numBrickVals*sizeof(float));
-        _file.seekg(offset);
-
-        _file.read(
-            reinterpret_cast<char*>(&buffer[0]),
-            static_cast<size_t>(numBrickVals) * sizeof(float)
-        );
-
-        double average = std::accumulate(
-            buffer.begin(),
-            buffer.end(),
-            0.0,
-            [](double a, float b) { return a + static_cast<double>(b); }
-        );
-        averages[brick] = static_cast<float>(average / static_cast<double>(numBrickVals));
-    }
-
-    // Spatial SNR stats
-    float minError = 1e20f;
-    float maxError = 0.f;
-    std::vector<float> medianArray(_numTotalNodes);
+    pool.parallelFor(0, _numTotalNodes, BrickGrainSize, [&](size_t b, size_t e) {
+        for (size_t brick = b; brick < e; ++brick) {
+            const float* data = brickData(static_cast<unsigned int>(brick));
+            double average = std::accumulate(
+                data,
+                data + numBrickVals,
+                0.0,
+                [](double a, float v) { return a + static_cast<double>(v); }
+            );
+            averages[brick] = static_cast<float>(
+                average / static_cast<double>(numBrickVals)
+            );
+        }
+    });
 
     // Second pass: For each brick, compare the covered leaf voxels with
     // the brick average
     LDEBUG("Calculating spatial error, second pass");
-    for (unsigned int brick = 0; brick < _numTotalNodes; ++brick) {
-        // Fetch mean intensity
-        float brickAvg = averages[brick];
-
-        // Sum  for std dev computation
-        float stdDev = 0.f;
-
-        // Get a list of leaf bricks that the current brick covers
-        std::list<unsigned int> leafBricksCovered = coveredLeafBricks(brick);
-
-        // If the brick is already a leaf, assign a negative error.
-        // Ad hoc "hack" to distinguish leafs from other nodes that happens
-        // to get a zero error due to rounding errors or other reasons.
-        if (leafBricksCovered.size() == 1) {
-            stdDev = -0.1f;
-        }
-        else {
+    pool.parallelFor(0, _numTotalNodes, BrickGrainSize, [&](size_t b, size_t e) {
+        for (size_t brick = b; brick < e; ++brick) {
+            // Fetch mean intensity
+            float brickAvg = averages[brick];
+
+            // Get a list of leaf bricks that the current brick covers
+            std::list<unsigned int> leafBricksCovered =
+                coveredLeafBricks(static_cast<unsigned int>(brick));
+
+            // If the brick is already a leaf, assign a negative error.
+            // Ad hoc "hack" to distinguish leafs from other nodes that happens
+            // to get a zero error due to rounding errors or other reasons.
+            if (leafBricksCovered.size() == 1) {
+                stdDevs[brick] = -0.1f;
+                continue;
+            }
 
             // Calculate "standard deviation" corresponding to leaves
-            for (auto lb = leafBricksCovered.begin(); lb != leafBricksCovered.end(); ++lb)
-            {
-                // Read brick
-                std::streampos offset = dataPosition() +
-                                 static_cast<long long>((*lb)*numBrickVals*sizeof(float));
-                _file.seekg(offset);
-
-                _file.read(reinterpret_cast<char*>(&buffer[0]),
-                    static_cast<size_t>(numBrickVals)*sizeof(float));
-
-                // Add to sum
-                for (auto v = buffer.begin(); v != buffer.end(); ++v) {
-                    stdDev += pow(*v - brickAvg, 2.f);
-                }
+            float stdDev = 0.f;
+            for (unsigned int lb : leafBricksCovered) {
+                stdDev += sumSquaredDifferences(brickData(lb), numBrickVals, brickAvg);
             }
-
             stdDev /= static_cast<float>(leafBricksCovered.size()*numBrickVals);
-            stdDev = sqrt(stdDev);
-        } // if not leaf
+            stdDevs[brick] = sqrt(stdDev);
+        }
+    });
 
+    // Spatial SNR stats
+    float minError = 1e20f;
+    float maxError = 0.f;
+    std::vector<float> medianArray(_numTotalNodes);
+
+    for (unsigned int brick = 0; brick < _numTotalNodes; ++brick) {
+        const float stdDev = stdDevs[brick];
         if (stdDev < minError) {
             minError = stdDev;
         }
@@ -353,7 +403,6 @@ bool TSP::calculateSpatialError() {
             maxError = stdDev;
         }
 
-        stdDevs[brick] = stdDev;
         medianArray[brick] = stdDev;
     }
 
@@ -393,9 +442,14 @@ bool TSP::calculateSpatialError() {
 }
 
 bool TSP::calculateTemporalError() {
-    if (!_file.is_open()) {
+    const unsigned int numBrickVals = _paddedBrickDim * _paddedBrickDim * _paddedBrickDim;
+
+    const MappedVoxels voxels(*this);
+    if (!voxels.isValid()) {
+        LERROR(fmt::format("Could not map {}", _filename));
         return false;
     }
+    auto brickData = [&voxels](unsigned int brick) { return voxels.brick(brick); };
 
     LDEBUG("Calculating temporal error");
 
@@ -408,67 +462,53 @@ bool TSP::calculateTemporalError() {
     std::vector<float> errors(_numTotalNodes);
 
     // Calculate temporal error for one brick at a time
-    for (unsigned int brick = 0; brick<_numTotalNodes; ++brick) {
-        unsigned int numBrickVals = _paddedBrickDim * _paddedBrickDim * _paddedBrickDim;
-
-        // Save the individual voxel's average over timesteps. Because the
-        // BSTs are built by averaging leaf nodes, we only need to sample
-        // the brick at the correct coordinate.
-        std::vector<float> voxelAverages(numBrickVals);
-        std::vector<float> voxelStdDevs(numBrickVals);
-
-        // Read the whole brick to fill the averages
-        std::streampos offset = dataPosition() +
-                                static_cast<long long>(brick*numBrickVals*sizeof(float));
-        _file.seekg(offset);
-
-        _file.read(
-            reinterpret_cast<char*>(voxelAverages.data()),
-            static_cast<size_t>(numBrickVals)*sizeof(float)
-        );
-
-        // Build a list of the BST leaf bricks (within the same octree level) that
-        // this brick covers
-        std::list<unsigned int> coveredBricks = coveredBSTLeafBricks(brick);
-
-        // If the brick is at the lowest BST level, automatically set the error
-        // to -0.1 (enables using -1 as a marker for "no error accepted");
-        // Somewhat ad hoc to get around the fact that the error could be
-        // 0.0 higher up in the tree
-        if (coveredBricks.size() == 1) {
-            errors[brick] = -0.1f;
-        }
-        else {
-            // Calculate standard deviation per voxel, average over brick
-            float avgStdDev = 0.f;
-            for (unsigned int voxel = 0; voxel<numBrickVals; ++voxel) {
-                float stdDev = 0.f;
-                for (auto leaf = coveredBricks.begin();
-                    leaf != coveredBricks.end(); ++leaf)
-                {
-                    // Sample the leaves at the corresponding voxel position
-                    _file.seekg(dataPosition() +
-                        static_cast<long long>(
-                            (*leaf * numBrickVals + voxel) * sizeof(float)
-                        )
-                    );
-
-                    float sample;
-                    _file.read(reinterpret_cast<char*>(&sample), sizeof(float));
+    ThreadPool& pool = global::openSpaceEngine->threadPool();
+    pool.parallelFor(0, _numTotalNodes, BrickGrainSize, [&](size_t b, size_t e) {
+        std::vector<float> sums(numBrickVals);
+        for (size_t brick = b; brick < e; ++brick) {
+            // The individual voxel's average over timesteps. Because the BSTs are
+            // built by averaging leaf nodes, we only need to sample the brick at the
+            // correct coordinate.
+            const float* voxelAverages = brickData(static_cast<unsigned int>(brick));
+
+            // Build a list of the BST leaf bricks (within the same octree level) that
+            // this brick covers
+            std::list<unsigned int> coveredBricks =
+                coveredBSTLeafBricks(static_cast<unsigned int>(brick));
+
+            // If the brick is at the lowest BST level, automatically set the error
+            // to -0.1 (enables using -1 as a marker for "no error accepted");
+            // Somewhat ad hoc to get around the fact that the error could be
+            // 0.0 higher up in the tree
+            if (coveredBricks.size() == 1) {
+                errors[brick] = -0.1f;
+                continue;
+            }
 
-                    stdDev += pow(sample - voxelAverages[voxel], 2.f);
-                }
-                stdDev /= static_cast<float>(coveredBricks.size());
-                stdDev = sqrt(stdDev);
+            // Accumulate the squared differences one leaf at a time so that each leaf
+            // brick is read sequentially
+            std::fill(sums.begin(), sums.end(), 0.f);
+            for (unsigned int leaf : coveredBricks) {
+                accumulateSquaredDifferences(
+                    brickData(leaf),
+                    voxelAverages,
+                    sums.data(),
+                    numBrickVals
+                );
+            }
 
-                avgStdDev += stdDev;
-            } // for voxel
+            // Calculate standard deviation per voxel, average over brick
+            float avgStdDev = 0.f;
+            const float nCovered = static_cast<float>(coveredBricks.size());
+            for (unsigned int voxel = 0; voxel < numBrickVals; ++voxel) {
+                avgStdDev += sqrt(sums[voxel] / nCovered);
+            }
 
             avgStdDev /= static_cast<float>(numBrickVals);
             meanArray[brick] = avgStdDev;
             errors[brick] = avgStdDev;
         }
-    } // for all bricks
+    });
 
     std::sort(meanArray.begin(), meanArray.end());
     //float medErr = meanArray[meanArray.size()/2];
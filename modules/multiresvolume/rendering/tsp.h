@@ -25,7 +25,9 @@
 #ifndef __OPENSPACE_MODULE_MULTIRESVOLUME___TSP___H__
 #define __OPENSPACE_MODULE_MULTIRESVOLUME___TSP___H__
 
+#include <openspace/util/memorymappedfile.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <cstddef>
 #include <fstream>
 #include <list>
 #include <string>
@@ -55,6 +57,28 @@ public:
         NUM_DATA
     };
 
+    /**
+     * A read-only view of the voxel data of a TSP file. The error and histogram
+     * calculations access the bricks in an order that is very different from the file
+     * layout, which makes memory mapping much faster than seeking and reading through a
+     * stream. The view can be shared between threads.
+     */
+    class MappedVoxels {
+    public:
+        explicit MappedVoxels(const TSP& tsp);
+
+        /// Returns whether the file could be mapped and contains all bricks
+        bool isValid() const;
+
+        /// Returns the padded voxels of the brick with the \p brickIndex
+        const float* brick(unsigned int brickIndex) const;
+
+    private:
+        MemoryMappedFile _mapping;
+        size_t _numBrickVals = 0;
+        bool _isValid = false;
+    };
+
     TSP(const std::string& filename);
     ~TSP();
 
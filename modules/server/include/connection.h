@@ -25,11 +25,14 @@
 #ifndef __OPENSPACE_MODULE_SERVER___CONNECTION___H__
 #define __OPENSPACE_MODULE_SERVER___CONNECTION___H__
 
+#include <modules/server/include/topics/topic.h>
 #include <ghoul/misc/templatefactory.h>
 #include <openspace/json.h>
+#include <openspace/util/concurrentqueue.h>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace ghoul::io { class Socket; }
 
@@ -37,8 +40,6 @@ namespace openspace {
 
 using TopicId = size_t;
 
-class Topic;
-
 // @TODO (abock, 2022-05-06) This is not really elegant as there is no need for a
 // Connection to be held by a shared_ptr, but there was a problem with the LuaScriptTopic
 // otherwise (issue #1940).
@@ -53,13 +54,25 @@ class Connection : public std::enable_shared_from_this<Connection> {
 public:
     Connection(std::unique_ptr<ghoul::io::Socket> s, std::string address,
         bool authorized = false, const std::string& password = "");
+    ~Connection();
 
     void handleMessage(const std::string& message);
     void sendMessage(const std::string& message);
     void handleJson(const nlohmann::json& json);
     void sendJson(const nlohmann::json& json);
+    void sendMessage(const OutgoingMessage& message);
     void setAuthorized(bool status);
 
+    /**
+     * Collects the messages that the topics of this connection have coalesced since the
+     * last call and hands them as a single batch to the send thread, which serializes
+     * and writes them to the socket. This function has to be called on the main thread.
+     */
+    void flushTopics();
+
+    /// Stops the send thread after all previously flushed messages have been sent
+    void stopSendThread();
+
     bool isAuthorized() const;
 
     ghoul::io::Socket* socket();
@@ -72,6 +85,10 @@ private:
     std::unique_ptr<ghoul::io::Socket> _socket;
     std::thread _thread;
 
+    /// Batches of messages that are waiting to be sent; an empty batch stops the thread
+    ConcurrentQueue<std::vector<OutgoingMessage>> _sendQueue;
+    std::thread _sendThread;
+
     std::string _address;
     bool _isAuthorized = false;
     std::map<TopicId, std::string> _messageQueue;
@@ -0,0 +1,85 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SERVER___BATCH_SUBSCRIPTION_TOPIC___H__
+#define __OPENSPACE_MODULE_SERVER___BATCH_SUBSCRIPTION_TOPIC___H__
+
+#include <modules/server/include/topics/topic.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace openspace::properties { class Property; }
+
+namespace openspace {
+
+/**
+ * A topic that subscribes to a list of properties at once, given explicitly by their URIs
+ * and/or by a URI pattern that can contain wildcards. The first message contains the
+ * full description and value of each property; every following message only contains
+ * the values that have changed since the previous message. Messages are sent at most
+ * once per `interval` milliseconds and can be encoded as JSON text, CBOR, or
+ * MessagePack.
+ */
+class BatchSubscriptionTopic : public Topic {
+public:
+    BatchSubscriptionTopic() = default;
+    ~BatchSubscriptionTopic() override;
+
+    void handleJson(const nlohmann::json& json) override;
+    bool isDone() const override;
+
+    void collectMessages(std::vector<OutgoingMessage>& messages) override;
+
+private:
+    static constexpr int UnsetCallbackHandle = -1;
+
+    struct Entry {
+        properties::Property* prop = nullptr;
+        std::string uri;
+        int onChangeHandle = UnsetCallbackHandle;
+        int onDeleteHandle = UnsetCallbackHandle;
+        /// The JSON value that was last sent to the client
+        std::string lastValue;
+        bool isDirty = true;
+        bool wasRemoved = false;
+    };
+
+    void subscribe(const nlohmann::json& json);
+    void resetCallbacks();
+
+    bool _isSubscribedTo = false;
+    bool _hasSentDescriptions = false;
+    bool _isDirty = false;
+    std::vector<Entry> _entries;
+    OutgoingMessage::Encoding _encoding = OutgoingMessage::Encoding::Json;
+
+    std::chrono::system_clock::time_point _lastUpdateTime;
+    std::chrono::milliseconds _updateInterval = std::chrono::milliseconds(0);
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SERVER___BATCH_SUBSCRIPTION_TOPIC___H__
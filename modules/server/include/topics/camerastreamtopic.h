@@ -0,0 +1,84 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SERVER___CAMERASTREAMTOPIC___H__
+#define __OPENSPACE_MODULE_SERVER___CAMERASTREAMTOPIC___H__
+
+#include <modules/server/include/topics/topic.h>
+
+#include <modules/server/include/udpsender.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace openspace {
+
+/**
+ * A topic that streams the camera state as fixed-layout binary frames instead of JSON.
+ * Each frame is a CameraStreamTopic::Frame in little-endian byte order and is sent at
+ * most `rate` times per second, but not more often than once per rendered frame. If a
+ * `udp` destination is provided, the frames are sent as UDP datagrams to that peer
+ * instead of over the connection of the topic.
+ */
+class CameraStreamTopic : public Topic {
+public:
+    /// The binary layout of a single frame; keep in sync with the client implementations
+    struct Frame {
+        /// Always 'OSCF' to identify the stream
+        uint32_t magic;
+        uint32_t version;
+        uint64_t topic;
+        /// Increased by one for every frame, which lets UDP peers detect dropped frames
+        uint64_t sequence;
+        /// The simulation time in seconds past the J2000 epoch
+        double simulationTime;
+        /// The camera position in world coordinates, in meters
+        double position[3];
+        /// The camera rotation as a quaternion in the order x, y, z, w
+        double rotation[4];
+        /// The identifier of the focus node, padded with null characters
+        char focus[64];
+    };
+
+    CameraStreamTopic() = default;
+
+    void handleJson(const nlohmann::json& json) override;
+    bool isDone() const override;
+
+    void collectMessages(std::vector<OutgoingMessage>& messages) override;
+
+private:
+    bool _isDone = false;
+    bool _isStreaming = false;
+    uint64_t _sequence = 0;
+
+    std::chrono::steady_clock::time_point _lastUpdateTime;
+    std::chrono::steady_clock::duration _updateInterval =
+        std::chrono::steady_clock::duration::zero();
+    std::unique_ptr<UdpSender> _udp;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SERVER___CAMERASTREAMTOPIC___H__
@@ -27,6 +27,8 @@
 
 #include <modules/server/include/topics/topic.h>
 
+#include <chrono>
+
 namespace openspace::properties { class Property; }
 
 namespace openspace {
@@ -39,6 +41,12 @@ public:
     void handleJson(const nlohmann::json& json) override;
     bool isDone() const override;
 
+    /**
+     * Adds the current value of the property if it changed since it was last sent and if
+     * the rate requested by the client allows it.
+     */
+    void collectMessages(std::vector<OutgoingMessage>& messages) override;
+
 private:
     void resetCallbacks();
 
@@ -49,6 +57,13 @@ private:
     int _onChangeHandle = UnsetCallbackHandle;
     int _onDeleteHandle = UnsetCallbackHandle;
     properties::Property* _prop = nullptr;
+
+    /// Set by the onChange callback; the value is sent at most once per frame
+    bool _isDirty = false;
+    std::chrono::system_clock::time_point _lastUpdateTime;
+    /// The minimum time between two updates, as requested by the client with 'maxRate'
+    std::chrono::system_clock::duration _minUpdateInterval =
+        std::chrono::system_clock::duration::zero();
 };
 
 } // namespace openspace
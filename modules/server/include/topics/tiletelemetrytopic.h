@@ -22,39 +22,34 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
-#ifndef __OPENSPACE_MODULE_VOLUME___LINEARLRUCACHE___H__
-#define __OPENSPACE_MODULE_VOLUME___LINEARLRUCACHE___H__
+#ifndef __OPENSPACE_MODULE_SERVER___TILETELEMETRYTOPIC___H__
+#define __OPENSPACE_MODULE_SERVER___TILETELEMETRYTOPIC___H__
 
-#include <ghoul/glm.h>
-#include <list>
-#include <iterator>
+#include <modules/server/include/topics/topic.h>
+#include <chrono>
 
-namespace openspace::volume {
+namespace openspace {
 
-template <typename ValueType>
-class LinearLruCache {
+class TileTelemetryTopic : public Topic {
 public:
-    LinearLruCache(size_t capacity, size_t nIndices);
+    TileTelemetryTopic();
+    ~TileTelemetryTopic() override;
 
-    bool has(size_t key) const;
-    void set(size_t key, ValueType value);
+    void handleJson(const nlohmann::json& json) override;
+    bool isDone() const override;
 
-    ValueType& use(size_t key);
-    ValueType& get(size_t key);
+private:
+    const int UnsetOnChangeHandle = -1;
 
-    void evict();
-    size_t capacity() const;
+    void sendTelemetry();
 
-private:
-    void insert(size_t key, const ValueType& value);
+    int _dataCallbackHandle = UnsetOnChangeHandle;
+    bool _isDone = false;
+    std::chrono::system_clock::time_point _lastUpdateTime;
 
-    std::list<size_t> _tracker;
-    std::vector<std::pair<ValueType, typename std::list<size_t>::iterator>> _cache;
-    size_t _capacity;
+    std::chrono::milliseconds _telemetryUpdateTime = std::chrono::milliseconds(1000);
 };
 
-} // namespace openspace::volume
-
-#include "linearlrucache.inl"
+} // namespace openspace
 
-#endif // __OPENSPACE_MODULE_VOLUME___LINEARLRUCACHE___H__
+#endif // __OPENSPACE_MODULE_SERVER___TILETELEMETRYTOPIC___H__
@@ -26,11 +26,30 @@
 #define __OPENSPACE_MODULE_SERVER___TOPIC___H__
 
 #include <openspace/json.h>
+#include <string>
+#include <vector>
 
 namespace openspace {
 
 class Connection;
 
+/**
+ * A message that is sent to the client after it has been encoded using `encoding`. For
+ * the `Binary` encoding, the bytes in `data` are sent unchanged and `json` is ignored.
+ */
+struct OutgoingMessage {
+    enum class Encoding {
+        Json,
+        Cbor,
+        MessagePack,
+        Binary
+    };
+
+    nlohmann::json json;
+    Encoding encoding = Encoding::Json;
+    std::string data;
+};
+
 class Topic {
 public:
     virtual ~Topic() = default;
@@ -42,6 +61,13 @@ public:
     virtual void handleJson(const nlohmann::json& json) = 0;
     virtual bool isDone() const = 0;
 
+    /**
+     * Called once per frame on the main thread to give the topic the chance to add the
+     * messages that it has coalesced since the last frame to \p messages. The messages
+     * are serialized and sent to the client on a separate thread.
+     */
+    virtual void collectMessages(std::vector<OutgoingMessage>& messages);
+
 protected:
     size_t _topicId = 0;
     std::shared_ptr<Connection> _connection;
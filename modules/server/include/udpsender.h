@@ -22,69 +22,46 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
-#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___LRU_CACHE___H__
-#define __OPENSPACE_MODULE_GLOBEBROWSING___LRU_CACHE___H__
+#ifndef __OPENSPACE_MODULE_SERVER___UDPSENDER___H__
+#define __OPENSPACE_MODULE_SERVER___UDPSENDER___H__
 
-#include <list>
-#include <unordered_map>
-#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 
-namespace openspace::globebrowsing::cache {
+namespace openspace {
 
 /**
- * Templated class implementing a Least-Recently-Used Cache.
- * `KeyType` needs to be an enumerable type.
+ * A minimal connectionless UDP socket that sends datagrams to a single peer. It is used
+ * for streams that favor latency over reliability, such as camera poses sent to other
+ * applications on the local network.
  */
-template <typename KeyType, typename ValueType, typename HasherType>
-class LRUCache {
+class UdpSender {
 public:
-    using Item = std::pair<KeyType, ValueType>;
-    using Items = std::list<Item>;
-
     /**
-     * \param size is the maximum size of the cache given in number of cached items.
+     * Creates a UDP socket that sends to \p port on the host with the name or IPv4
+     * address \p address.
+     *
+     * \throw ghoul::RuntimeError If the address cannot be resolved or the socket cannot
+     *        be created
      */
-    LRUCache(size_t size);
-
-    void put(KeyType key, ValueType value);
-    std::vector<Item> putAndFetchPopped(KeyType key, ValueType value);
-    void clear();
-    bool exist(const KeyType& key) const;
+    UdpSender(const std::string& address, int port);
+    ~UdpSender();
 
-    /**
-     * If value exists, the value is bumped to the front of the queue.
-     * \returns true if value of this key exists.
-     */
-    bool touch(const KeyType& key);
-    bool isEmpty() const;
-    ValueType get(const KeyType& key);
+    UdpSender(const UdpSender&) = delete;
+    UdpSender& operator=(const UdpSender&) = delete;
 
     /**
-     * Pops the front of the queue.
+     * Sends \p size bytes of \p data as a single datagram. Failures are silently ignored
+     * as the next datagram supersedes the current one anyway.
      */
-    Item popMRU();
-
-    /**
-     * Pops the back of the queue.
-     */
-    Item popLRU();
-    size_t size() const;
-    size_t maximumCacheSize() const;
+    void send(const void* data, size_t size);
 
 private:
-    void putWithoutCleaning(KeyType key, ValueType value);
-    void clean();
-
-    std::vector<Item> cleanAndFetchPopped();
-
-    Items _itemList;
-    std::unordered_map<KeyType, typename Items::const_iterator, HasherType> _itemMap;
-
-    size_t _maximumCacheSize;
+    std::intptr_t _socket;
+    std::string _address;
 };
 
-} // namespace openspace::globebrowsing::cache
-
-#include <modules/globebrowsing/src/lrucache.inl>
+} // namespace openspace
 
-#endif // __OPENSPACE_MODULE_GLOBEBROWSING___LRU_CACHE___H__
+#endif // __OPENSPACE_MODULE_SERVER___UDPSENDER___H__
@@ -39,15 +39,21 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/misc/templatefactory.h>
+#include <thread>
 
 namespace {
     constexpr std::string_view KeyInterfaces = "Interfaces";
+
+    // The number of received messages that can be waiting for the main thread. If the
+    // queue is full, the socket threads stop reading until the main thread caught up
+    constexpr size_t MessageQueueCapacity = 4096;
 } // namespace
 
 namespace openspace {
 
 ServerModule::ServerModule()
     : OpenSpaceModule(ServerModule::Name)
+    , _messageQueue(MessageQueueCapacity)
     , _interfaceOwner({"Interfaces", "Interfaces", "Server Interfaces"})
 {
     addPropertySubOwner(_interfaceOwner);
@@ -93,6 +99,13 @@ void ServerModule::internalInitialize(const ghoul::Dictionary& configuration) {
         preSync();
     });
 
+    if (configuration.hasValue<double>("MessageBudget")) {
+        // The budget is specified in milliseconds
+        _messageBudget = std::chrono::microseconds(static_cast<long long>(
+            configuration.value<double>("MessageBudget") * 1000.0
+        ));
+    }
+
     if (!configuration.hasValue<ghoul::Dictionary>(KeyInterfaces)) {
         return;
     }
@@ -168,6 +181,14 @@ void ServerModule::preSync() {
     // Consume all messages put into the message queue by the socket threads.
     consumeMessages();
 
+    // Send the messages that the topics have coalesced during this frame
+    for (ConnectionData& connectionData : _connections) {
+        Connection& connection = *connectionData.connection;
+        if (connection.socket() && connection.socket()->isConnected()) {
+            connection.flushTopics();
+        }
+    }
+
     // Join threads for sockets that disconnected.
     cleanUpFinishedThreads();
 }
@@ -180,6 +201,7 @@ void ServerModule::cleanUpFinishedThreads() {
         if (!connection.socket() || !connection.socket()->isConnected()) {
             if (connection.thread().joinable()) {
                 connection.thread().join();
+                connection.stopSendThread();
                 connectionData.isMarkedForRemoval = true;
             }
         }
@@ -216,21 +238,37 @@ void ServerModule::handleConnection(std::shared_ptr<Connection> connection) {
     std::string messageString;
     messageString.reserve(256);
     while (connection->socket()->getMessage(messageString)) {
-        std::lock_guard lock(_messageQueueMutex);
-        _messageQueue.push_back({ connection, messageString });
+        Message message = { connection, messageString };
+        while (!_messageQueue.tryPush(std::move(message))) {
+            if (!connection->socket()->isConnected()) {
+                // The main thread joins the threads of disconnected sockets without
+                // consuming more messages, so we must not wait for room in the queue
+                return;
+            }
+            // The main thread has fallen behind, so we wait for it to consume messages
+            // instead of reading more from the socket
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
     }
 }
 
 void ServerModule::consumeMessages() {
     ZoneScoped;
 
-    std::lock_guard lock(_messageQueueMutex);
-    while (!_messageQueue.empty()) {
-        const Message& m = _messageQueue.front();
+    // Messages are handled until the queue is empty or the budget for this frame is
+    // used up, in which case the remaining messages are handled in the next frame. At
+    // least one message is handled every frame so that the queue always makes progress
+    const auto start = std::chrono::steady_clock::now();
+    Message m;
+    while (_messageQueue.tryPop(m)) {
         if (std::shared_ptr<Connection> c = m.connection.lock()) {
             c->handleMessage(m.messageString);
         }
-        _messageQueue.pop_front();
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        if (_messageBudget.count() > 0 && elapsed > _messageBudget) {
+            break;
+        }
     }
 }
 
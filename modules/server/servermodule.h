@@ -29,9 +29,9 @@
 
 #include <modules/server/include/serverinterface.h>
 
-#include <deque>
+#include <openspace/util/boundedconcurrentqueue.h>
+#include <chrono>
 #include <memory>
-#include <mutex>
 
 namespace openspace {
 
@@ -77,8 +77,10 @@ private:
     void disconnectAll();
     void preSync();
 
-    std::mutex _messageQueueMutex;
-    std::deque<Message> _messageQueue;
+    /// Messages received by the socket threads that are consumed on the main thread
+    BoundedConcurrentQueue<Message> _messageQueue;
+    /// The time per frame that may be spent handling messages; 0 means no limit
+    std::chrono::microseconds _messageBudget = std::chrono::microseconds(0);
 
     std::vector<ConnectionData> _connections;
     std::vector<std::unique_ptr<ServerInterface>> _interfaces;
@@ -25,7 +25,9 @@
 #include <modules/server/include/connection.h>
 
 #include <modules/server/include/topics/authorizationtopic.h>
+#include <modules/server/include/topics/batchsubscriptiontopic.h>
 #include <modules/server/include/topics/bouncetopic.h>
+#include <modules/server/include/topics/camerastreamtopic.h>
 #include <modules/server/include/topics/cameratopic.h>
 #include <modules/server/include/topics/documentationtopic.h>
 #include <modules/server/include/topics/enginemodetopic.h>
@@ -38,6 +40,7 @@
 #include <modules/server/include/topics/shortcuttopic.h>
 #include <modules/server/include/topics/skybrowsertopic.h>
 #include <modules/server/include/topics/subscriptiontopic.h>
+#include <modules/server/include/topics/tiletelemetrytopic.h>
 #include <modules/server/include/topics/timetopic.h>
 #include <modules/server/include/topics/topic.h>
 #include <modules/server/include/topics/triggerpropertytopic.h>
@@ -48,6 +51,7 @@
 #include <ghoul/io/socket/tcpsocketserver.h>
 #include <ghoul/io/socket/websocketserver.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
 #include <ghoul/misc/profiling.h>
 #include <fmt/format.h>
 
@@ -92,6 +96,7 @@ Connection::Connection(std::unique_ptr<ghoul::io::Socket> s, std::string address
     _topicFactory.registerClass<SetPropertyTopic>("set");
     _topicFactory.registerClass<ShortcutTopic>("shortcuts");
     _topicFactory.registerClass<SubscriptionTopic>("subscribe");
+    _topicFactory.registerClass<BatchSubscriptionTopic>("subscribeBatch");
     _topicFactory.registerClass<TimeTopic>("time");
     _topicFactory.registerClass<TriggerPropertyTopic>("trigger");
     _topicFactory.registerClass<BounceTopic>("bounce");
@@ -99,6 +104,12 @@ Connection::Connection(std::unique_ptr<ghoul::io::Socket> s, std::string address
     _topicFactory.registerClass<VersionTopic>("version");
     _topicFactory.registerClass<SkyBrowserTopic>("skybrowser");
     _topicFactory.registerClass<CameraTopic>("camera");
+    _topicFactory.registerClass<CameraStreamTopic>("cameraStream");
+    _topicFactory.registerClass<TileTelemetryTopic>("tileTelemetry");
+}
+
+Connection::~Connection() {
+    stopSendThread();
 }
 
 void Connection::handleMessage(const std::string& message) {
@@ -210,6 +221,66 @@ void Connection::sendJson(const nlohmann::json& json) {
     sendMessage(json.dump());
 }
 
+void Connection::flushTopics() {
+    ZoneScoped;
+
+    std::vector<OutgoingMessage> messages;
+    for (const std::pair<const TopicId, std::unique_ptr<Topic>>& topic : _topics) {
+        topic.second->collectMessages(messages);
+    }
+    if (messages.empty()) {
+        return;
+    }
+
+    if (!_sendThread.joinable()) {
+        _sendThread = std::thread([this]() {
+            while (true) {
+                std::vector<OutgoingMessage> batch = _sendQueue.pop();
+                if (batch.empty()) {
+                    // An empty batch is the signal to stop sending
+                    return;
+                }
+                for (const OutgoingMessage& message : batch) {
+                    sendMessage(message);
+                }
+            }
+        });
+    }
+    _sendQueue.push(std::move(messages));
+}
+
+void Connection::stopSendThread() {
+    if (_sendThread.joinable()) {
+        _sendQueue.push(std::vector<OutgoingMessage>());
+        _sendThread.join();
+    }
+}
+
+void Connection::sendMessage(const OutgoingMessage& message) {
+    ZoneScoped;
+
+    switch (message.encoding) {
+        case OutgoingMessage::Encoding::Json:
+            sendJson(message.json);
+            break;
+        case OutgoingMessage::Encoding::Cbor: {
+            const std::vector<uint8_t> data = nlohmann::json::to_cbor(message.json);
+            sendMessage(std::string(data.begin(), data.end()));
+            break;
+        }
+        case OutgoingMessage::Encoding::MessagePack: {
+            const std::vector<uint8_t> data = nlohmann::json::to_msgpack(message.json);
+            sendMessage(std::string(data.begin(), data.end()));
+            break;
+        }
+        case OutgoingMessage::Encoding::Binary:
+            sendMessage(message.data);
+            break;
+        default:
+            throw ghoul::MissingCaseException();
+    }
+}
+
 bool Connection::isAuthorized() const {
     return _isAuthorized;
 }
@@ -0,0 +1,225 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/server/include/topics/batchsubscriptiontopic.h>
+
+#include <modules/server/include/connection.h>
+#include <modules/server/include/jsonconverters.h>
+#include <openspace/properties/property.h>
+#include <openspace/query/query.h>
+#include <openspace/scene/scene.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <algorithm>
+
+namespace {
+    constexpr std::string_view _loggerCat = "BatchSubscriptionTopic";
+
+    constexpr std::string_view StartSubscription = "start_subscription";
+    constexpr std::string_view StopSubscription = "stop_subscription";
+
+    constexpr std::string_view PropertiesKey = "properties";
+    constexpr std::string_view PatternKey = "pattern";
+    constexpr std::string_view IntervalKey = "interval";
+    constexpr std::string_view EncodingKey = "encoding";
+} // namespace
+
+using nlohmann::json;
+
+namespace openspace {
+
+BatchSubscriptionTopic::~BatchSubscriptionTopic() {
+    resetCallbacks();
+}
+
+bool BatchSubscriptionTopic::isDone() const {
+    return !_isSubscribedTo;
+}
+
+void BatchSubscriptionTopic::resetCallbacks() {
+    for (Entry& entry : _entries) {
+        if (!entry.prop) {
+            continue;
+        }
+        if (entry.onChangeHandle != UnsetCallbackHandle) {
+            entry.prop->removeOnChange(entry.onChangeHandle);
+            entry.onChangeHandle = UnsetCallbackHandle;
+        }
+        if (entry.onDeleteHandle != UnsetCallbackHandle) {
+            entry.prop->removeOnDelete(entry.onDeleteHandle);
+            entry.onDeleteHandle = UnsetCallbackHandle;
+        }
+    }
+    _entries.clear();
+}
+
+void BatchSubscriptionTopic::handleJson(const nlohmann::json& json) {
+    const std::string& event = json.at("event").get<std::string>();
+
+    if (event == StartSubscription) {
+        subscribe(json);
+    }
+    if (event == StopSubscription) {
+        _isSubscribedTo = false;
+        resetCallbacks();
+    }
+}
+
+void BatchSubscriptionTopic::subscribe(const nlohmann::json& json) {
+    resetCallbacks();
+
+    std::vector<properties::Property*> props;
+    auto uris = json.find(PropertiesKey);
+    if (uris != json.end() && uris->is_array()) {
+        for (const nlohmann::json& uri : *uris) {
+            const std::string key = uri.get<std::string>();
+            properties::Property* prop = property(key);
+            if (prop) {
+                props.push_back(prop);
+            }
+            else {
+                LWARNING(fmt::format(
+                    "Could not subscribe. Property '{}' not found", key
+                ));
+            }
+        }
+    }
+    auto pattern = json.find(PatternKey);
+    if (pattern != json.end() && pattern->is_string() && sceneGraph()) {
+        std::vector<properties::Property*> matches =
+            sceneGraph()->propertiesMatchingRegex(pattern->get<std::string>());
+        props.insert(props.end(), matches.begin(), matches.end());
+    }
+
+    // Remove the properties that were both listed and matched by the pattern
+    std::sort(props.begin(), props.end());
+    props.erase(std::unique(props.begin(), props.end()), props.end());
+
+    auto interval = json.find(IntervalKey);
+    if (interval != json.end() && interval->is_number()) {
+        _updateInterval = std::chrono::milliseconds(
+            std::max(0, static_cast<int>(interval->get<double>()))
+        );
+    }
+
+    auto encoding = json.find(EncodingKey);
+    if (encoding != json.end() && encoding->is_string()) {
+        const std::string e = encoding->get<std::string>();
+        if (e == "cbor") {
+            _encoding = OutgoingMessage::Encoding::Cbor;
+        }
+        else if (e == "msgpack") {
+            _encoding = OutgoingMessage::Encoding::MessagePack;
+        }
+        else if (e == "json") {
+            _encoding = OutgoingMessage::Encoding::Json;
+        }
+        else {
+            LWARNING(fmt::format("Unknown encoding '{}', using 'json' instead", e));
+        }
+    }
+
+    // The entries must not be reallocated after the callbacks have been registered, as
+    // the callbacks refer to them by their index
+    _entries.resize(props.size());
+    for (size_t i = 0; i < props.size(); i++) {
+        Entry& entry = _entries[i];
+        entry.prop = props[i];
+        entry.uri = props[i]->fullyQualifiedIdentifier();
+        entry.onChangeHandle = entry.prop->onChange([this, i]() {
+            _entries[i].isDirty = true;
+            _isDirty = true;
+        });
+        entry.onDeleteHandle = entry.prop->onDelete([this, i]() {
+            Entry& e = _entries[i];
+            e.prop = nullptr;
+            e.onChangeHandle = UnsetCallbackHandle;
+            e.onDeleteHandle = UnsetCallbackHandle;
+            e.wasRemoved = true;
+            _isDirty = true;
+        });
+    }
+
+    _isSubscribedTo = true;
+    _hasSentDescriptions = false;
+    _isDirty = true;
+    _lastUpdateTime = std::chrono::system_clock::time_point();
+}
+
+void BatchSubscriptionTopic::collectMessages(std::vector<OutgoingMessage>& messages) {
+    if (!_isSubscribedTo || !_isDirty) {
+        return;
+    }
+
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    if (now - _lastUpdateTime < _updateInterval) {
+        return;
+    }
+
+    // The first message contains the full description of the properties, all following
+    // messages only contain the values that have actually changed
+    nlohmann::json values = nlohmann::json::object();
+    nlohmann::json removed = nlohmann::json::array();
+    for (Entry& entry : _entries) {
+        if (entry.wasRemoved) {
+            removed.push_back(entry.uri);
+            entry.wasRemoved = false;
+            continue;
+        }
+        if (!entry.prop || !entry.isDirty) {
+            continue;
+        }
+        entry.isDirty = false;
+
+        std::string value = entry.prop->jsonValue();
+        if (value == entry.lastValue) {
+            continue;
+        }
+
+        if (_hasSentDescriptions) {
+            values[entry.uri] = nlohmann::json::parse(value);
+        }
+        else {
+            values[entry.uri] = entry.prop;
+        }
+        entry.lastValue = std::move(value);
+    }
+    _isDirty = false;
+    _lastUpdateTime = now;
+
+    if (values.empty() && removed.empty() && _hasSentDescriptions) {
+        return;
+    }
+
+    const std::string key = _hasSentDescriptions ? "values" : "properties";
+    nlohmann::json payload = { { key, values } };
+    if (!removed.empty()) {
+        payload["removed"] = removed;
+    }
+    _hasSentDescriptions = true;
+
+    messages.push_back({ wrappedPayload(payload), _encoding });
+}
+
+} // namespace openspace
@@ -0,0 +1,160 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/server/include/topics/camerastreamtopic.h>
+
+#include <modules/server/include/connection.h>
+#include <openspace/camera/camera.h>
+#include <openspace/engine/globals.h>
+#include <openspace/navigation/navigationhandler.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <openspace/util/timemanager.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+    constexpr std::string_view _loggerCat = "CameraStreamTopic";
+
+    constexpr std::string_view StartSubscription = "start_subscription";
+    constexpr std::string_view StopSubscription = "stop_subscription";
+
+    constexpr std::string_view RateKey = "rate";
+    constexpr std::string_view UdpKey = "udp";
+
+    constexpr uint32_t FrameMagic = 0x4643534F; // 'OSCF' in little-endian
+    constexpr uint32_t FrameVersion = 1;
+    constexpr double DefaultRate = 120.0;
+
+    using Frame = openspace::CameraStreamTopic::Frame;
+    static_assert(std::is_trivially_copyable_v<Frame>);
+    static_assert(std::is_standard_layout_v<Frame>);
+    static_assert(sizeof(Frame) == 152, "Frame layout changed");
+} // namespace
+
+namespace openspace {
+
+bool CameraStreamTopic::isDone() const {
+    return _isDone;
+}
+
+void CameraStreamTopic::handleJson(const nlohmann::json& json) {
+    const std::string& event = json.at("event").get<std::string>();
+
+    if (event == StopSubscription) {
+        _isStreaming = false;
+        _isDone = true;
+        return;
+    }
+
+    if (event != StartSubscription) {
+        LWARNING(fmt::format("Unknown event '{}'", event));
+        return;
+    }
+
+    double rate = DefaultRate;
+    auto rateIt = json.find(RateKey);
+    if (rateIt != json.end() && rateIt->is_number() && rateIt->get<double>() > 0.0) {
+        rate = rateIt->get<double>();
+    }
+    _updateInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / rate)
+    );
+
+    auto udp = json.find(UdpKey);
+    if (udp != json.end() && udp->is_object()) {
+        const std::string address = udp->at("address").get<std::string>();
+        const int port = udp->at("port").get<int>();
+        try {
+            _udp = std::make_unique<UdpSender>(address, port);
+        }
+        catch (const ghoul::RuntimeError& e) {
+            LERROR(fmt::format(
+                "Could not stream camera over UDP: {}", e.message
+            ));
+            _udp = nullptr;
+        }
+    }
+
+    _isStreaming = true;
+    _lastUpdateTime = std::chrono::steady_clock::time_point();
+}
+
+void CameraStreamTopic::collectMessages(std::vector<OutgoingMessage>& messages) {
+    if (!_isStreaming) {
+        return;
+    }
+
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - _lastUpdateTime < _updateInterval) {
+        return;
+    }
+    _lastUpdateTime = now;
+
+    const Camera* camera = global::navigationHandler->camera();
+    if (!camera) {
+        return;
+    }
+
+    Frame frame;
+    std::memset(&frame, 0, sizeof(Frame));
+    frame.magic = FrameMagic;
+    frame.version = FrameVersion;
+    frame.topic = static_cast<uint64_t>(_topicId);
+    frame.sequence = _sequence++;
+    frame.simulationTime = global::timeManager->time().j2000Seconds();
+
+    const glm::dvec3& position = camera->positionVec3();
+    frame.position[0] = position.x;
+    frame.position[1] = position.y;
+    frame.position[2] = position.z;
+
+    const glm::dquat& rotation = camera->rotationQuaternion();
+    frame.rotation[0] = rotation.x;
+    frame.rotation[1] = rotation.y;
+    frame.rotation[2] = rotation.z;
+    frame.rotation[3] = rotation.w;
+
+    if (const SceneGraphNode* anchor = global::navigationHandler->anchorNode()) {
+        const std::string& identifier = anchor->identifier();
+        // The last character is always kept as the null terminator
+        const size_t length = std::min(identifier.size(), sizeof(frame.focus) - 1);
+        std::memcpy(frame.focus, identifier.data(), length);
+    }
+
+    if (_udp) {
+        _udp->send(&frame, sizeof(Frame));
+    }
+    else {
+        OutgoingMessage message;
+        message.encoding = OutgoingMessage::Encoding::Binary;
+        message.data = std::string(reinterpret_cast<const char*>(&frame), sizeof(Frame));
+        messages.push_back(std::move(message));
+    }
+}
+
+} // namespace openspace
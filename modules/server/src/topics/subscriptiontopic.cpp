@@ -37,6 +37,9 @@ namespace {
 
     constexpr std::string_view StartSubscription = "start_subscription";
     constexpr std::string_view StopSubscription = "stop_subscription";
+
+    // Optional maximum number of updates per second that the client wants to receive
+    constexpr std::string_view MaxRateKey = "maxRate";
 } // namespace
 
 using nlohmann::json;
@@ -65,6 +68,22 @@ void SubscriptionTopic::resetCallbacks() {
     }
 }
 
+void SubscriptionTopic::collectMessages(std::vector<OutgoingMessage>& messages) {
+    if (!_isSubscribedTo || !_isDirty || !_prop) {
+        return;
+    }
+
+    const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    if (now - _lastUpdateTime < _minUpdateInterval) {
+        // The value stays dirty and is sent once enough time has passed
+        return;
+    }
+
+    messages.push_back({ wrappedPayload(_prop) });
+    _isDirty = false;
+    _lastUpdateTime = now;
+}
+
 void SubscriptionTopic::handleJson(const nlohmann::json& json) {
     const std::string& event = json.at("event").get<std::string>();
 
@@ -77,19 +96,28 @@ void SubscriptionTopic::handleJson(const nlohmann::json& json) {
         if (_prop) {
             _requestedResourceIsSubscribable = true;
             _isSubscribedTo = true;
-            auto onChange = [this, k = std::move(key)]() {
-                _connection->sendJson(wrappedPayload(_prop));
-            };
 
-            _onChangeHandle = _prop->onChange(onChange);
+            auto maxRate = json.find(MaxRateKey);
+            if (maxRate != json.end() && maxRate->is_number() && *maxRate > 0.0) {
+                using namespace std::chrono;
+                _minUpdateInterval = duration_cast<system_clock::duration>(
+                    duration<double>(1.0 / maxRate->get<double>())
+                );
+            }
+
+            // Changes are only recorded here and sent when the connection is flushed,
+            // so that a property that changes many times per frame is only serialized
+            // and sent once
+            _onChangeHandle = _prop->onChange([this]() { _isDirty = true; });
             _onDeleteHandle = _prop->onDelete([this]() {
                 _onChangeHandle = UnsetCallbackHandle;
                 _onDeleteHandle = UnsetCallbackHandle;
                 _isSubscribedTo = false;
             });
 
-            // immediately send the value
-            onChange();
+            // Send the value with the next flush
+            _isDirty = true;
+            _lastUpdateTime = std::chrono::system_clock::time_point();
         }
         else {
             LWARNING(fmt::format("Could not subscribe. Property '{}' not found", key));
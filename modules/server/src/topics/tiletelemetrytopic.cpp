@@ -0,0 +1,129 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include "modules/server/include/topics/tiletelemetrytopic.h"
+
+#include <modules/server/include/connection.h>
+#include <modules/server/servermodule.h>
+#include <modules/globebrowsing/globebrowsingmodule.h>
+#include <modules/globebrowsing/src/tiletelemetry.h>
+#include <openspace/engine/moduleengine.h>
+#include <openspace/engine/globals.h>
+
+namespace {
+    constexpr std::string_view SubscribeEvent = "start_subscription";
+
+    nlohmann::json histogramJson(
+                            const openspace::globebrowsing::TileTelemetry::Histogram& h)
+    {
+        using Histogram = openspace::globebrowsing::TileTelemetry::Histogram;
+
+        nlohmann::json buckets = nlohmann::json::array();
+        for (int i = 0; i < Histogram::NumBuckets; i++) {
+            buckets.push_back({
+                // A bound of 0 marks the last bucket, which has no upper bound
+                { "upperBoundMs", Histogram::bucketUpperBound(i) },
+                { "count", h.buckets()[i] }
+            });
+        }
+
+        const double averageMs = h.count() > 0 ?
+            static_cast<double>(h.total().count()) / h.count() / 1000.0 :
+            0.0;
+        return {
+            { "count", h.count() },
+            { "averageMs", averageMs },
+            { "buckets", buckets }
+        };
+    }
+} // namespace
+
+using nlohmann::json;
+
+namespace openspace {
+
+TileTelemetryTopic::TileTelemetryTopic()
+    : _lastUpdateTime(std::chrono::system_clock::now())
+{}
+
+TileTelemetryTopic::~TileTelemetryTopic() {
+    if (_dataCallbackHandle != UnsetOnChangeHandle) {
+        ServerModule* module = global::moduleEngine->module<ServerModule>();
+        if (module) {
+            module->removePreSyncCallback(_dataCallbackHandle);
+        }
+    }
+}
+
+bool TileTelemetryTopic::isDone() const {
+    return _isDone;
+}
+
+void TileTelemetryTopic::handleJson(const nlohmann::json& json) {
+    std::string event = json.at("event").get<std::string>();
+
+    if (event != SubscribeEvent) {
+        _isDone = true;
+        return;
+    }
+
+    ServerModule* module = global::moduleEngine->module<ServerModule>();
+    _dataCallbackHandle = module->addPreSyncCallback(
+        [this]() {
+            std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+            if (now - _lastUpdateTime > _telemetryUpdateTime) {
+                sendTelemetry();
+                _lastUpdateTime = std::chrono::system_clock::now();
+            }
+        }
+    );
+}
+
+void TileTelemetryTopic::sendTelemetry() {
+    using namespace globebrowsing;
+
+    GlobeBrowsingModule* module = global::moduleEngine->module<GlobeBrowsingModule>();
+    if (!module) {
+        return;
+    }
+
+    nlohmann::json providers = nlohmann::json::array();
+    for (const TileTelemetry* telemetry : module->tileTelemetries()) {
+        providers.push_back({
+            { "source", telemetry->source() },
+            { "queueDepth", telemetry->queueDepth() },
+            { "cacheHits", telemetry->cacheHits() },
+            { "cacheMisses", telemetry->cacheMisses() },
+            { "evictions", telemetry->evictions() },
+            { "droppedTiles", telemetry->droppedTiles() },
+            { "readLatency", histogramJson(telemetry->readLatency()) },
+            { "decodeTime", histogramJson(telemetry->processTime()) },
+            { "uploadTime", histogramJson(telemetry->uploadTime()) }
+        });
+    }
+
+    _connection->sendJson(wrappedPayload({ { "providers", providers } }));
+}
+
+} // namespace openspace
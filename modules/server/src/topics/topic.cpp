@@ -35,6 +35,8 @@ void Topic::initialize(std::shared_ptr<Connection> connection, size_t topicId) {
     _topicId = topicId;
 }
 
+void Topic::collectMessages(std::vector<OutgoingMessage>&) {}
+
 nlohmann::json Topic::wrappedPayload(const nlohmann::json& payload) const {
     ZoneScoped;
 
@@ -0,0 +1,140 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/server/include/udpsender.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/misc/exception.h>
+#include <cstring>
+
+#ifdef WIN32
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#else // ^^^ WIN32 / !WIN32 vvv
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif // WIN32
+
+namespace {
+#ifdef WIN32
+    constexpr std::intptr_t InvalidSocket = static_cast<std::intptr_t>(INVALID_SOCKET);
+
+    void closeSocket(std::intptr_t s) {
+        closesocket(static_cast<SOCKET>(s));
+    }
+#else // ^^^ WIN32 / !WIN32 vvv
+    constexpr std::intptr_t InvalidSocket = -1;
+
+    void closeSocket(std::intptr_t s) {
+        close(static_cast<int>(s));
+    }
+#endif // WIN32
+} // namespace
+
+namespace openspace {
+
+UdpSender::UdpSender(const std::string& address, int port)
+    : _socket(InvalidSocket)
+{
+#ifdef WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        throw ghoul::RuntimeError("Could not initialize Winsock", "UdpSender");
+    }
+#endif // WIN32
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(addrinfo));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_protocol = IPPROTO_UDP;
+
+    addrinfo* result = nullptr;
+    const std::string service = std::to_string(port);
+    if (getaddrinfo(address.c_str(), service.c_str(), &hints, &result) != 0) {
+        throw ghoul::RuntimeError(
+            fmt::format("Could not resolve address '{}'", address),
+            "UdpSender"
+        );
+    }
+
+    _socket = static_cast<std::intptr_t>(
+        socket(result->ai_family, result->ai_socktype, result->ai_protocol)
+    );
+    if (_socket == InvalidSocket) {
+        freeaddrinfo(result);
+        throw ghoul::RuntimeError("Could not create UDP socket", "UdpSender");
+    }
+
+    // Connecting a UDP socket only fixes the destination, which saves the address lookup
+    // in the kernel for every datagram
+#ifdef WIN32
+    const int res = connect(
+        static_cast<SOCKET>(_socket),
+        result->ai_addr,
+        static_cast<int>(result->ai_addrlen)
+    );
+#else // ^^^ WIN32 / !WIN32 vvv
+    const int res = connect(
+        static_cast<int>(_socket),
+        result->ai_addr,
+        result->ai_addrlen
+    );
+#endif // WIN32
+    freeaddrinfo(result);
+    if (res != 0) {
+        closeSocket(_socket);
+        throw ghoul::RuntimeError(
+            fmt::format("Could not connect UDP socket to '{}:{}'", address, port),
+            "UdpSender"
+        );
+    }
+    _address = fmt::format("{}:{}", address, port);
+}
+
+UdpSender::~UdpSender() {
+    if (_socket != InvalidSocket) {
+        closeSocket(_socket);
+    }
+#ifdef WIN32
+    WSACleanup();
+#endif // WIN32
+}
+
+void UdpSender::send(const void* data, size_t size) {
+#ifdef WIN32
+    ::send(
+        static_cast<SOCKET>(_socket),
+        reinterpret_cast<const char*>(data),
+        static_cast<int>(size),
+        0
+    );
+#else // ^^^ WIN32 / !WIN32 vvv
+    ::send(static_cast<int>(_socket), data, size, 0);
+#endif // WIN32
+}
+
+} // namespace openspace
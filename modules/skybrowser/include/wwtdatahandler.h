@@ -26,10 +26,11 @@
 #define __OPENSPACE_MODULE_SKYBROWSER___WWTDATAHANDLER___H__
 
 #include <filesystem>
+#include <future>
+#include <map>
 #include <memory>
 #include <optional>
-
-namespace tinyxml2 { class XMLElement; }
+#include <vector>
 
 namespace openspace {
 
@@ -51,16 +52,56 @@ struct ImageData {
 
 class WwtDataHandler {
 public:
+    /**
+     * Loads the image collection whose root is at the \p root URL. If a parsed copy of
+     * the collection has been cached in the \p directory before, it is used right away
+     * and the remote collection is checked for changes in the background. Otherwise the
+     * collection is downloaded into the \p directory and parsed before returning.
+     */
     void loadImages(const std::string& root, const std::filesystem::path& directory);
+
+    /**
+     * Replaces the loaded images with the refreshed collection once the background
+     * check started by #loadImages has found and loaded a newer version of it.
+     *
+     * \return `true` if the images have been replaced
+     */
+    bool update();
+
     int nLoadedImages() const;
     std::optional<const ImageData> image(const std::string& imageUrl) const;
     const std::map<std::string, ImageData>& images() const;
 
+    /**
+     * Returns all images with celestial coordinates that lie within \p angle radians of
+     * the equatorial Cartesian \p direction, ordered by increasing angular distance.
+     */
+    std::vector<const ImageData*> imagesWithinAngle(const glm::dvec3& direction,
+        double angle) const;
+
+    /**
+     * Returns the image with celestial coordinates that is closest to the equatorial
+     * Cartesian \p direction, or `nullptr` if no such image has been loaded.
+     */
+    const ImageData* closestImage(const glm::dvec3& direction) const;
+
 private:
-    void saveImagesFromXml(const tinyxml2::XMLElement* root, std::string collection);
+    struct IndexedImage {
+        glm::dvec3 position;
+        const ImageData* image;
+    };
+
+    void buildSpatialIndex();
 
     // Images
     std::map<std::string, ImageData> _images;
+
+    // The collection that is loaded in the background if the remote one has changed
+    std::future<std::optional<std::map<std::string, ImageData>>> _refreshedImages;
+
+    // The images with celestial coordinates, ordered as an implicit kd-tree over their
+    // normalized equatorial positions
+    std::vector<IndexedImage> _spatialIndex;
 };
 } // namespace openspace
 
@@ -210,6 +210,9 @@ SkyBrowserModule::SkyBrowserModule()
     global::callback::preSync->emplace_back([this]() {
         constexpr double SolarSystemRadius = 30.0 * distanceconstants::AstronomicalUnit;
 
+        // Pick up the image collection if it was updated in the background
+        _dataHandler.update();
+
         // Disable browser and targets when camera is outside of solar system
         bool camWasInSolarSystem = _isCameraInSolarSystem;
         glm::dvec3 cameraPos = global::navigationHandler->camera()->positionVec3();
@@ -563,7 +566,9 @@ scripting::LuaLibrary SkyBrowserModule::luaLibrary() const {
             codegen::lua::WwtImageCollectionUrlDeprecated,
             codegen::lua::StopAnimations,
             codegen::lua::SetBorderRadius,
-            codegen::lua::ReloadDisplayCopyOnNode
+            codegen::lua::ReloadDisplayCopyOnNode,
+            codegen::lua::ImagesInTarget,
+            codegen::lua::ClosestImageToTarget
         }
     };
 }
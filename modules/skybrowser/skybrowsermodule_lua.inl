@@ -894,6 +894,61 @@ ghoul::Dictionary wwtImageCollectionUrlDeprecated()
     pair->stopAnimations();
 }
 
+/**
+ * Takes an identifier to a sky browser or a sky target. Returns a list of the urls of the
+ * images whose center lies within the vertical field of view of the target, ordered by
+ * increasing distance to the center of the target.
+ */
+[[codegen::luawrap]] std::vector<std::string> imagesInTarget(std::string identifier) {
+    using namespace openspace;
+
+    SkyBrowserModule* module = global::moduleEngine->module<SkyBrowserModule>();
+    TargetBrowserPair* pair = module->pair(identifier);
+    if (!pair) {
+        throw ghoul::lua::LuaError(fmt::format(
+            "Could not find sky browser or target '{}'", identifier
+        ));
+    }
+
+    glm::dvec3 direction = skybrowser::sphericalToCartesian(
+        pair->targetDirectionEquatorial()
+    );
+    double angle = glm::radians(pair->verticalFov()) / 2.0;
+
+    std::vector<const ImageData*> images =
+        module->wwtDataHandler().imagesWithinAngle(direction, angle);
+
+    std::vector<std::string> urls;
+    urls.reserve(images.size());
+    for (const ImageData* img : images) {
+        urls.push_back(img->imageUrl);
+    }
+    return urls;
+}
+
+/**
+ * Takes an identifier to a sky browser or a sky target. Returns the url of the image
+ * whose center is closest to the center of the target, or an empty string if no images
+ * with celestial coordinates have been loaded.
+ */
+[[codegen::luawrap]] std::string closestImageToTarget(std::string identifier) {
+    using namespace openspace;
+
+    SkyBrowserModule* module = global::moduleEngine->module<SkyBrowserModule>();
+    TargetBrowserPair* pair = module->pair(identifier);
+    if (!pair) {
+        throw ghoul::lua::LuaError(fmt::format(
+            "Could not find sky browser or target '{}'", identifier
+        ));
+    }
+
+    glm::dvec3 direction = skybrowser::sphericalToCartesian(
+        pair->targetDirectionEquatorial()
+    );
+    const ImageData* img = module->wwtDataHandler().closestImage(direction);
+    return img ? img->imageUrl : "";
+}
+
 #include "skybrowsermodule_lua_codegen.cpp"
 
 } // namespace
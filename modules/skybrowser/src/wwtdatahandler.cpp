@@ -27,7 +27,11 @@
 #include <modules/skybrowser/include/utility.h>
 #include <openspace/util/httprequest.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <fstream>
+#include <limits>
 #include <string_view>
+#include <vector>
 #include <tinyxml2.h>
 
 namespace {
@@ -246,6 +250,290 @@ namespace {
             ""
         };
     }
+
+    using ImageMap = std::map<std::string, openspace::ImageData>;
+
+    void saveImagesFromXml(const tinyxml2::XMLElement* root,
+                           const std::string& collection, ImageMap& images)
+    {
+        // Get direct child of node called Place
+        const tinyxml2::XMLElement* node = root->FirstChildElement();
+
+        // Iterate through all siblings of node. If sibling is folder, open recursively.
+        // If sibling is image, save it.
+        while (node) {
+            const std::string name = node->Name();
+            // If node is an image or place, load it
+            if (name == ImageSet || name == Place) {
+                std::optional<openspace::ImageData> image = loadImageFromNode(
+                    node, collection
+                );
+                if (image.has_value()) {
+                    images.insert({ image.value().imageUrl, std::move(*image) });
+                }
+
+            }
+            // If node is another folder, open recursively
+            else if (name == Folder) {
+                std::string nodeName = attribute(node, Name);
+                std::string newCollectionName =
+                    fmt::format("{}/{}", collection, nodeName);
+                saveImagesFromXml(node, newCollectionName, images);
+            }
+            node = node->NextSiblingElement();
+        }
+    }
+
+    ImageMap parseImages(const std::filesystem::path& directory) {
+        using namespace openspace;
+
+        ImageMap images;
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            // Only the downloaded collections are XML files
+            if (entry.path().extension() != ".aspx") {
+                continue;
+            }
+
+            tinyxml2::XMLDocument document;
+            std::string path = entry.path().string();
+            tinyxml2::XMLError successCode = document.LoadFile(path.c_str());
+
+            if (successCode == tinyxml2::XMLError::XML_SUCCESS) {
+                tinyxml2::XMLElement* rootNode = document.FirstChildElement();
+                std::string collectionName = attribute(rootNode, Name);
+                saveImagesFromXml(rootNode, collectionName, images);
+            }
+        }
+
+        // Set the identifiers to the order of the images when sorted by name
+        std::vector<ImageData*> sorted;
+        sorted.reserve(images.size());
+        for (auto& [id, img] : images) {
+            sorted.push_back(&img);
+        }
+        std::sort(
+            sorted.begin(), sorted.end(),
+            [](const ImageData* lhs, const ImageData* rhs) {
+                return lhs->name < rhs->name;
+            }
+        );
+        for (size_t i = 0; i < sorted.size(); i++) {
+            sorted[i]->identifier = std::to_string(i);
+        }
+        return images;
+    }
+
+    std::string downloadRemoteHash(const std::string& root,
+                                   const std::filesystem::path& directory)
+    {
+        // Get the hash from the remote. If no such hash exists, the remoteHash will be
+        // empty
+        std::string remoteHash;
+        std::string remoteHashFile = root.substr(0, root.find_last_of('/')) + "/hash.md5";
+        bool success = downloadFile(remoteHashFile, directory / "hash.tmp");
+        // The hash download might fail if the provided 'root' does not have a hash
+        // in which case we assume that the underlying data has not changed
+        if (success) {
+            std::ifstream(directory / "hash.tmp") >> remoteHash;
+            std::filesystem::remove(directory / "hash.tmp");
+        }
+        return remoteHash;
+    }
+
+    // Cache of the parsed image collection so that the XML files don't have to be parsed
+    // on every start. The cache is tied to the hash of the collection it was created from
+    constexpr std::string_view CacheFile = "images.cache";
+    constexpr int8_t CacheFileVersion = 1;
+
+    template <typename T>
+    void write(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write(std::ofstream& file, const std::string& value) {
+        const uint32_t size = static_cast<uint32_t>(value.size());
+        write(file, size);
+        file.write(value.data(), size);
+    }
+
+    template <typename T>
+    void read(std::ifstream& file, T& value) {
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    void read(std::ifstream& file, std::string& value) {
+        uint32_t size = 0;
+        read(file, size);
+        value.resize(size);
+        file.read(value.data(), size);
+    }
+
+    void writeCache(const std::filesystem::path& file, const std::string& hash,
+                    const ImageMap& images)
+    {
+        std::ofstream stream(file, std::ofstream::binary);
+
+        write(stream, CacheFileVersion);
+        write(stream, hash);
+        write(stream, static_cast<uint32_t>(images.size()));
+        for (const auto& [id, img] : images) {
+            write(stream, img.name);
+            write(stream, img.thumbnailUrl);
+            write(stream, img.imageUrl);
+            write(stream, img.credits);
+            write(stream, img.creditsUrl);
+            write(stream, img.collection);
+            write(stream, static_cast<uint8_t>(img.hasCelestialCoords ? 1 : 0));
+            write(stream, img.fov);
+            write(stream, img.equatorialSpherical);
+            write(stream, img.equatorialCartesian);
+            write(stream, img.identifier);
+        }
+    }
+
+    std::optional<ImageMap> readCache(const std::filesystem::path& file,
+                                      const std::string& hash)
+    {
+        std::ifstream stream(file, std::ifstream::binary);
+        if (!stream.good()) {
+            return std::nullopt;
+        }
+
+        int8_t version = 0;
+        read(stream, version);
+        if (version != CacheFileVersion) {
+            // Incompatible version and we won't be able to read the file
+            return std::nullopt;
+        }
+
+        std::string cachedHash;
+        read(stream, cachedHash);
+        if (cachedHash != hash) {
+            // The cache was created from a different version of the collection
+            return std::nullopt;
+        }
+
+        ImageMap images;
+        uint32_t nImages = 0;
+        read(stream, nImages);
+        for (uint32_t i = 0; i < nImages; i++) {
+            openspace::ImageData img;
+            read(stream, img.name);
+            read(stream, img.thumbnailUrl);
+            read(stream, img.imageUrl);
+            read(stream, img.credits);
+            read(stream, img.creditsUrl);
+            read(stream, img.collection);
+            uint8_t hasCelestialCoords = 0;
+            read(stream, hasCelestialCoords);
+            img.hasCelestialCoords = hasCelestialCoords == 1;
+            read(stream, img.fov);
+            read(stream, img.equatorialSpherical);
+            read(stream, img.equatorialCartesian);
+            read(stream, img.identifier);
+            std::string imageUrl = img.imageUrl;
+            images.emplace(std::move(imageUrl), std::move(img));
+        }
+
+        if (!stream.good()) {
+            // The file was truncated
+            return std::nullopt;
+        }
+        return images;
+    }
+
+    // Downloads the collection into the empty 'directory', parses it, and caches the
+    // result
+    ImageMap downloadImages(const std::string& root,
+                            const std::filesystem::path& directory,
+                            const std::string& remoteHash)
+    {
+        using namespace openspace;
+
+        LINFO("Loading images from url");
+        downloadWtmlFiles(directory, root, "root");
+        std::ofstream(directory / "hash.md5") << remoteHash;
+
+        LINFO("Loading images from directory");
+        ImageMap images = parseImages(directory);
+        writeCache(directory / CacheFile, remoteHash, images);
+        return images;
+    }
+
+    // Sorts the nodes in [begin, end) into an implicit kd-tree in which the median of
+    // each range along the current axis is the root of that range
+    template <typename It>
+    void buildKdTree(It begin, It end, int axis) {
+        if (end - begin <= 1) {
+            return;
+        }
+
+        It mid = begin + (end - begin) / 2;
+        std::nth_element(
+            begin, mid, end,
+            [axis](const auto& lhs, const auto& rhs) {
+                return lhs.position[axis] < rhs.position[axis];
+            }
+        );
+        buildKdTree(begin, mid, (axis + 1) % 3);
+        buildKdTree(mid + 1, end, (axis + 1) % 3);
+    }
+
+    // Calls 'callback' for all nodes that are within 'radius' of 'point'
+    template <typename It, typename Callback>
+    void findInKdTree(It begin, It end, int axis, const glm::dvec3& point,
+                      double radius, const Callback& callback)
+    {
+        if (begin == end) {
+            return;
+        }
+
+        It mid = begin + (end - begin) / 2;
+        if (glm::distance(point, mid->position) <= radius) {
+            callback(*mid);
+        }
+
+        const double diff = point[axis] - mid->position[axis];
+        if (diff <= radius) {
+            findInKdTree(begin, mid, (axis + 1) % 3, point, radius, callback);
+        }
+        if (diff >= -radius) {
+            findInKdTree(mid + 1, end, (axis + 1) % 3, point, radius, callback);
+        }
+    }
+
+    template <typename It>
+    void closestInKdTree(It begin, It end, int axis, const glm::dvec3& point,
+                         It& closest, double& closestDistance)
+    {
+        if (begin == end) {
+            return;
+        }
+
+        It mid = begin + (end - begin) / 2;
+        const double distance = glm::distance(point, mid->position);
+        if (distance < closestDistance) {
+            closest = mid;
+            closestDistance = distance;
+        }
+
+        // Visit the side that contains the point first so that the other side can be
+        // skipped in most cases
+        const int next = (axis + 1) % 3;
+        const double diff = point[axis] - mid->position[axis];
+        if (diff < 0.0) {
+            closestInKdTree(begin, mid, next, point, closest, closestDistance);
+            if (-diff < closestDistance) {
+                closestInKdTree(mid + 1, end, next, point, closest, closestDistance);
+            }
+        }
+        else {
+            closestInKdTree(mid + 1, end, next, point, closest, closestDistance);
+            if (diff < closestDistance) {
+                closestInKdTree(begin, mid, next, point, closest, closestDistance);
+            }
+        }
+    }
 } //namespace
 
 namespace openspace {
@@ -255,8 +543,9 @@ void WwtDataHandler::loadImages(const std::string& root,
 {
     // Steps to download new images
     // 1. Create the target directory if it doesn't already exist
-    // 2. If the 'root' has an associated hash file, download and compare it with the
-    //    local file. If the hash has changed, nuke the folder
+    // 2. If there is a cache from the local collection, use it and check the remote
+    //    hash in the background. Otherwise compare the remote hash with the local one
+    //    and nuke the folder if it has changed
     // 3. If the folder is empty, download files
 
     // 1.
@@ -265,19 +554,6 @@ void WwtDataHandler::loadImages(const std::string& root,
         std::filesystem::create_directory(directory);
     }
 
-    // Get the hash from the remote. If no such hash exists, the remoteHash will be empty
-    std::string remoteHash;
-    {
-        std::string remoteHashFile = root.substr(0, root.find_last_of('/')) + "/hash.md5";
-        bool success = downloadFile(remoteHashFile, directory / "hash.tmp");
-        // The hash download might fail if the provided 'root' does not have a hash
-        // in which case we assume that the underlying data has not changed
-        if (success) {
-            std::ifstream(directory / "hash.tmp") >> remoteHash;
-            std::filesystem::remove(directory / "hash.tmp");
-        }
-    }
-
     // Load the local hash. If no such hash exists, the localHash will be empty
     std::string localHash;
     std::filesystem::path localHashFile = directory / "hash.md5";
@@ -285,6 +561,37 @@ void WwtDataHandler::loadImages(const std::string& root,
         std::ifstream(localHashFile) >> localHash;
     }
 
+    // 2.
+    std::optional<ImageMap> cached = readCache(directory / CacheFile, localHash);
+    if (cached.has_value()) {
+        _images = std::move(*cached);
+        LINFO(fmt::format(
+            "Loaded {} WorldWide Telescope images from cache", _images.size()
+        ));
+
+        _refreshedImages = std::async(
+            std::launch::async,
+            [root, directory, localHash]() -> std::optional<ImageMap> {
+                std::string remoteHash = downloadRemoteHash(root, directory);
+                if (remoteHash.empty() || remoteHash == localHash) {
+                    return std::nullopt;
+                }
+
+                LINFO(fmt::format(
+                    "Local hash '{}' differs from remote hash '{}'. Updating images",
+                    localHash, remoteHash
+                ));
+                std::filesystem::remove_all(directory);
+                std::filesystem::create_directory(directory);
+                return downloadImages(root, directory, remoteHash);
+            }
+        );
+        buildSpatialIndex();
+        return;
+    }
+
+    std::string remoteHash = downloadRemoteHash(root, directory);
+
     // Check if the hash has changed. This will be ignored if either the local of remote
     // hash does not exist
     if (!localHash.empty() && !remoteHash.empty() && localHash != remoteHash) {
@@ -297,44 +604,93 @@ void WwtDataHandler::loadImages(const std::string& root,
         std::filesystem::create_directory(directory);
     }
 
+    // 3.
     // If there is no directory (either because it is the first start, or the previous
     // contents were deleted because of a change in hash) we have to download the files
     if (std::filesystem::is_empty(directory)) {
-        LINFO("Loading images from url");
-        downloadWtmlFiles(directory, root, "root");
-        std::ofstream(localHashFile) << remoteHash;
+        _images = downloadImages(root, directory, remoteHash);
+    }
+    else {
+        // Finally, we can load the files that are now on disk
+        LINFO("Loading images from directory");
+        _images = parseImages(directory);
+        writeCache(directory / CacheFile, localHash, _images);
     }
 
-    // Finally, we can load the files that are now on disk
-    LINFO("Loading images from directory");
-    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
-        tinyxml2::XMLDocument document;
-        std::string path = entry.path().string();
-        tinyxml2::XMLError successCode = document.LoadFile(path.c_str());
+    LINFO(fmt::format("Loaded {} WorldWide Telescope images", _images.size()));
+    buildSpatialIndex();
+}
 
-        if (successCode == tinyxml2::XMLError::XML_SUCCESS) {
-            tinyxml2::XMLElement* rootNode = document.FirstChildElement();
-            std::string collectionName = attribute(rootNode, Name);
-            saveImagesFromXml(rootNode, collectionName);
-        }
+bool WwtDataHandler::update() {
+    const bool isReady = _refreshedImages.valid() &&
+        _refreshedImages.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    if (!isReady) {
+        return false;
     }
-    // Sort images. Copy images to vector
-    std::vector<ImageData> _imageVector;
-    for (const auto& [id, img] : _images) {
-        _imageVector.push_back(img);
+
+    std::optional<ImageMap> images = _refreshedImages.get();
+    if (!images.has_value()) {
+        return false;
     }
-    // Sort
-    std::sort(_imageVector.begin(), _imageVector.end(),
-        [](const ImageData& lhs, const ImageData& rhs) {
-            return lhs.name < rhs.name;
+
+    _images = std::move(*images);
+    LINFO(fmt::format("Updated to {} WorldWide Telescope images", _images.size()));
+    buildSpatialIndex();
+    return true;
+}
+
+void WwtDataHandler::buildSpatialIndex() {
+    _spatialIndex.clear();
+    for (const std::pair<const std::string, ImageData>& pair : _images) {
+        if (pair.second.hasCelestialCoords) {
+            glm::dvec3 position = glm::normalize(pair.second.equatorialCartesian);
+            _spatialIndex.push_back({ position, &pair.second });
+        }
+    }
+    buildKdTree(_spatialIndex.begin(), _spatialIndex.end(), 0);
+}
+
+std::vector<const ImageData*> WwtDataHandler::imagesWithinAngle(
+                                                             const glm::dvec3& direction,
+                                                                      double angle) const
+{
+    // All positions are on the unit sphere, so the angle corresponds to a chord length
+    const glm::dvec3 point = glm::normalize(direction);
+    const double radius = 2.0 * std::sin(std::clamp(angle, 0.0, glm::pi<double>()) / 2.0);
+
+    std::vector<std::pair<double, const ImageData*>> found;
+    findInKdTree(
+        _spatialIndex.begin(), _spatialIndex.end(), 0, point, radius,
+        [&found, &point](const IndexedImage& node) {
+            found.emplace_back(glm::distance(point, node.position), node.image);
         }
     );
-    // Set the identifiers to the correct order
-    for (size_t i = 0; i < _imageVector.size(); i++) {
-        _images[_imageVector[i].imageUrl].identifier = std::to_string(i);
+    std::sort(found.begin(), found.end());
+
+    std::vector<const ImageData*> result;
+    result.reserve(found.size());
+    for (const std::pair<double, const ImageData*>& f : found) {
+        result.push_back(f.second);
     }
+    return result;
+}
 
-    LINFO(fmt::format("Loaded {} WorldWide Telescope images", _images.size()));
+const ImageData* WwtDataHandler::closestImage(const glm::dvec3& direction) const {
+    if (_spatialIndex.empty()) {
+        return nullptr;
+    }
+
+    auto closest = _spatialIndex.begin();
+    double closestDistance = std::numeric_limits<double>::max();
+    closestInKdTree(
+        _spatialIndex.begin(),
+        _spatialIndex.end(),
+        0,
+        glm::normalize(direction),
+        closest,
+        closestDistance
+    );
+    return closest->image;
 }
 
 int WwtDataHandler::nLoadedImages() const {
@@ -353,34 +709,4 @@ const std::map<std::string, ImageData>& WwtDataHandler::images() const {
     return _images;
 }
 
-void WwtDataHandler::saveImagesFromXml(const tinyxml2::XMLElement* root,
-                                       std::string collection)
-{
-    // Get direct child of node called Place
-    const tinyxml2::XMLElement* node = root->FirstChildElement();
-
-    // Iterate through all siblings of node. If sibling is folder, open recursively.
-    // If sibling is image, save it.
-    while (node) {
-        const std::string name = node->Name();
-        // If node is an image or place, load it
-        if (name == ImageSet || name == Place) {
-            std::optional<ImageData> image = loadImageFromNode(
-                node, collection
-            );
-            if (image.has_value()) {
-                _images.insert({ image.value().imageUrl, std::move(*image) });
-            }
-
-        }
-        // If node is another folder, open recursively
-        else if (name == Folder) {
-            std::string nodeName = attribute(node, Name);
-            std::string newCollectionName = fmt::format("{}/{}", collection, nodeName);
-            saveImagesFromXml(node, newCollectionName);
-        }
-        node = node->NextSiblingElement();
-    }
-}
-
 } // namespace openspace
@@ -0,0 +1,246 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/space/ephemeristable.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/glm.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace {
+    constexpr uint32_t Magic = 0x4f455048; // 'OEPH'
+    constexpr int8_t CurrentVersion = 1;
+
+    template <typename T>
+    void write(std::ofstream& stream, const T& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T read(std::ifstream& stream) {
+        T value = T();
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return value;
+    }
+} // namespace
+
+namespace openspace {
+
+EphemerisTable EphemerisTable::create(std::vector<std::string> identifiers,
+                                      int nComponents, double start, double end,
+                                      double segmentLength, int degree,
+                                const std::function<void(double, std::span<double>)>& f)
+{
+    ghoul_assert(nComponents > 0, "Need at least one component");
+    ghoul_assert(end > start, "End must be after start");
+    ghoul_assert(segmentLength > 0.0, "Segment length must be positive");
+    ghoul_assert(degree >= 0, "Degree must not be negative");
+
+    EphemerisTable table;
+    table._identifiers = std::move(identifiers);
+    table._nComponents = nComponents;
+    table._degree = degree;
+    table._start = start;
+    table._end = end;
+    table._segmentLength = segmentLength;
+
+    const size_t nSegments =
+        static_cast<size_t>(std::ceil((end - start) / segmentLength));
+    const size_t nCoefficients = static_cast<size_t>(degree) + 1;
+    table._coefficients.resize(nSegments * nComponents * nCoefficients, 0.0);
+
+    // The function is sampled at the Chebyshev nodes of each segment, which makes the
+    // interpolating polynomial close to the best uniform approximation
+    std::vector<double> samples(nCoefficients * nComponents);
+    for (size_t s = 0; s < nSegments; s++) {
+        const double mid = start + (static_cast<double>(s) + 0.5) * segmentLength;
+        const double halfLength = 0.5 * segmentLength;
+
+        for (size_t k = 0; k < nCoefficients; k++) {
+            const double x = std::cos(
+                glm::pi<double>() * (static_cast<double>(k) + 0.5) /
+                static_cast<double>(nCoefficients)
+            );
+            f(
+                mid + halfLength * x,
+                std::span<double>(samples.data() + k * nComponents, nComponents)
+            );
+        }
+
+        double* segment = table._coefficients.data() + s * nComponents * nCoefficients;
+        for (int c = 0; c < nComponents; c++) {
+            double* coefficients = segment + c * nCoefficients;
+            for (size_t j = 0; j < nCoefficients; j++) {
+                double sum = 0.0;
+                for (size_t k = 0; k < nCoefficients; k++) {
+                    const double angle = glm::pi<double>() *
+                        static_cast<double>(j) * (static_cast<double>(k) + 0.5) /
+                        static_cast<double>(nCoefficients);
+                    sum += samples[k * nComponents + c] * std::cos(angle);
+                }
+                coefficients[j] = 2.0 * sum / static_cast<double>(nCoefficients);
+            }
+            coefficients[0] *= 0.5;
+        }
+    }
+
+    return table;
+}
+
+EphemerisTable EphemerisTable::load(const std::filesystem::path& file) {
+    std::ifstream stream(file, std::ifstream::binary);
+    if (!stream.good()) {
+        throw ghoul::RuntimeError(fmt::format("Could not open ephemeris table {}", file));
+    }
+
+    if (read<uint32_t>(stream) != Magic) {
+        throw ghoul::RuntimeError(fmt::format("File {} is no ephemeris table", file));
+    }
+    const int8_t version = read<int8_t>(stream);
+    if (version != CurrentVersion) {
+        throw ghoul::RuntimeError(fmt::format(
+            "Ephemeris table {} has version {}, expected {}",
+            file, version, CurrentVersion
+        ));
+    }
+
+    EphemerisTable table;
+    const uint32_t nIdentifiers = read<uint32_t>(stream);
+    for (uint32_t i = 0; i < nIdentifiers; i++) {
+        const uint32_t length = read<uint32_t>(stream);
+        std::string identifier;
+        identifier.resize(length);
+        stream.read(identifier.data(), length);
+        table._identifiers.push_back(std::move(identifier));
+    }
+    table._nComponents = read<int32_t>(stream);
+    table._degree = read<int32_t>(stream);
+    table._start = read<double>(stream);
+    table._end = read<double>(stream);
+    table._segmentLength = read<double>(stream);
+    const uint64_t nCoefficients = read<uint64_t>(stream);
+    if (!stream.good() || table._nComponents <= 0 || table._degree < 0 ||
+        table._segmentLength <= 0.0 || table._end <= table._start)
+    {
+        throw ghoul::RuntimeError(fmt::format("Ephemeris table {} is corrupt", file));
+    }
+
+    const uint64_t nSegments = static_cast<uint64_t>(
+        std::ceil((table._end - table._start) / table._segmentLength)
+    );
+    if (nCoefficients != nSegments * table._nComponents * (table._degree + 1)) {
+        throw ghoul::RuntimeError(fmt::format("Ephemeris table {} is corrupt", file));
+    }
+    table._coefficients.resize(nCoefficients);
+    stream.read(
+        reinterpret_cast<char*>(table._coefficients.data()),
+        nCoefficients * sizeof(double)
+    );
+    if (!stream.good()) {
+        throw ghoul::RuntimeError(fmt::format("Ephemeris table {} is truncated", file));
+    }
+    return table;
+}
+
+void EphemerisTable::save(const std::filesystem::path& file) const {
+    std::ofstream stream(file, std::ofstream::binary);
+    write(stream, Magic);
+    write(stream, CurrentVersion);
+
+    write(stream, static_cast<uint32_t>(_identifiers.size()));
+    for (const std::string& identifier : _identifiers) {
+        write(stream, static_cast<uint32_t>(identifier.size()));
+        stream.write(identifier.data(), identifier.size());
+    }
+    write(stream, static_cast<int32_t>(_nComponents));
+    write(stream, static_cast<int32_t>(_degree));
+    write(stream, _start);
+    write(stream, _end);
+    write(stream, _segmentLength);
+    write(stream, static_cast<uint64_t>(_coefficients.size()));
+    stream.write(
+        reinterpret_cast<const char*>(_coefficients.data()),
+        _coefficients.size() * sizeof(double)
+    );
+}
+
+bool EphemerisTable::contains(double time) const {
+    return time >= _start && time <= _end;
+}
+
+void EphemerisTable::evaluate(double time, std::span<double> result) const {
+    ghoul_assert(contains(time), "Time outside of the table");
+    ghoul_assert(result.size() == static_cast<size_t>(_nComponents), "Wrong size");
+
+    const size_t nCoefficients = static_cast<size_t>(_degree) + 1;
+    const size_t nSegments = _coefficients.size() / (_nComponents * nCoefficients);
+    // The end of the window belongs to the last segment
+    const size_t s = std::min(
+        static_cast<size_t>((time - _start) / _segmentLength),
+        nSegments - 1
+    );
+    const double mid = _start + (static_cast<double>(s) + 0.5) * _segmentLength;
+    const double x = (time - mid) / (0.5 * _segmentLength);
+
+    const double* segment = _coefficients.data() + s * _nComponents * nCoefficients;
+    for (int c = 0; c < _nComponents; c++) {
+        // Clenshaw's recurrence for the sum of the Chebyshev series
+        const double* coefficients = segment + c * nCoefficients;
+        double b1 = 0.0;
+        double b2 = 0.0;
+        for (size_t j = nCoefficients - 1; j > 0; j--) {
+            const double b0 = 2.0 * x * b1 - b2 + coefficients[j];
+            b2 = b1;
+            b1 = b0;
+        }
+        result[c] = x * b1 - b2 + coefficients[0];
+    }
+}
+
+const std::vector<std::string>& EphemerisTable::identifiers() const {
+    return _identifiers;
+}
+
+int EphemerisTable::nComponents() const {
+    return _nComponents;
+}
+
+double EphemerisTable::start() const {
+    return _start;
+}
+
+double EphemerisTable::end() const {
+    return _end;
+}
+
+std::mutex& cspiceFallbackMutex() {
+    static std::mutex Mutex;
+    return Mutex;
+}
+
+} // namespace openspace
@@ -0,0 +1,122 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SPACE___EPHEMERISTABLE___H__
+#define __OPENSPACE_MODULE_SPACE___EPHEMERISTABLE___H__
+
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * An EphemerisTable approximates a vector-valued function of time, such as the position
+ * of a SPICE body or the elements of a rotation matrix, between a start and an end time.
+ * The time window is split into segments of equal length and each component of the
+ * function is represented by a Chebyshev polynomial in each segment. A table is immutable
+ * after it has been created or loaded, so it can be evaluated from any number of threads
+ * concurrently, unlike CSPICE itself.
+ *
+ * The table also stores up to three identifiers that describe what was sampled, for
+ * example the target, observer, and frame of a position. These are used to verify that a
+ * table fits the transformation it is used for.
+ */
+class EphemerisTable {
+public:
+    /**
+     * Creates a table by sampling the function \p f between \p start and \p end. Each
+     * call to \p f receives a time and a span of \p nComponents values to fill.
+     *
+     * \param identifiers The identifiers that describe what was sampled
+     * \param nComponents The number of components of the function
+     * \param start The start of the time window in seconds past the J2000 epoch
+     * \param end The end of the time window in seconds past the J2000 epoch
+     * \param segmentLength The length of each segment in seconds
+     * \param degree The degree of the Chebyshev polynomials in each segment
+     * \param f The function that is sampled
+     *
+     * \pre \p nComponents must be positive
+     * \pre \p end must be larger than \p start
+     * \pre \p segmentLength must be positive
+     */
+    static EphemerisTable create(std::vector<std::string> identifiers, int nComponents,
+        double start, double end, double segmentLength, int degree,
+        const std::function<void(double, std::span<double>)>& f);
+
+    /**
+     * Loads a table that was previously written with #save.
+     *
+     * \throw ghoul::RuntimeError If \p file is not a valid ephemeris table
+     */
+    static EphemerisTable load(const std::filesystem::path& file);
+
+    /**
+     * Writes this table to the provided \p file in a binary format.
+     */
+    void save(const std::filesystem::path& file) const;
+
+    /**
+     * Returns `true` if the \p time lies within the time window of this table.
+     */
+    bool contains(double time) const;
+
+    /**
+     * Evaluates all components of the table at the provided \p time into \p result.
+     *
+     * \pre \p time must lie within the time window of the table
+     * \pre \p result must have as many values as the table has components
+     */
+    void evaluate(double time, std::span<double> result) const;
+
+    const std::vector<std::string>& identifiers() const;
+    int nComponents() const;
+    double start() const;
+    double end() const;
+
+private:
+    std::vector<std::string> _identifiers;
+    int _nComponents = 0;
+    int _degree = 0;
+    double _start = 0.0;
+    double _end = 0.0;
+    double _segmentLength = 0.0;
+
+    /// All coefficients ordered by segment, then component, then degree
+    std::vector<double> _coefficients;
+};
+
+/**
+ * Returns the mutex that SPICE-based transformations that use an EphemerisTable have to
+ * hold while they fall back to CSPICE outside of the time window of the table. These
+ * transformations are updated on worker threads, but CSPICE is not reentrant.
+ */
+std::mutex& cspiceFallbackMutex();
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SPACE___EPHEMERISTABLE___H__
@@ -30,9 +30,15 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/crc32.h>
 #include <ghoul/misc/misc.h>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 
 using json = nlohmann::json;
 
@@ -53,6 +59,87 @@ namespace {
     constexpr std::string_view StartTime = "&START_TIME=";
     constexpr std::string_view StopTime = "&STOP_TIME=";
     constexpr std::string_view StepSize = "&STEP_SIZE=";
+
+    // Markers for the start and end of the data in a Horizons result
+    constexpr std::string_view StartOfData = "$$SOE";
+    constexpr std::string_view EndOfData = "$$EOE";
+
+    // Maximum number of chunks of a chunked request that are downloaded at the same time
+    constexpr size_t MaxParallelChunks = 4;
+
+    // Parses a time in the format "YYYY-MM-DD hh:mm:ss" that is used in the requests
+    std::optional<std::chrono::sys_seconds> parseRequestTime(const std::string& time) {
+        int year = 0;
+        unsigned int month = 0;
+        unsigned int day = 0;
+        int hour = 0;
+        int minute = 0;
+        int second = 0;
+        const int n = std::sscanf(
+            time.c_str(),
+            "%d-%u-%u %d:%d:%d",
+            &year, &month, &day, &hour, &minute, &second
+        );
+        if (n < 3) {
+            return std::nullopt;
+        }
+
+        const std::chrono::year_month_day date =
+            std::chrono::year(year) / std::chrono::month(month) / std::chrono::day(day);
+        if (!date.ok()) {
+            return std::nullopt;
+        }
+
+        return std::chrono::sys_days(date) + std::chrono::hours(hour) +
+            std::chrono::minutes(minute) + std::chrono::seconds(second);
+    }
+
+    std::string formatRequestTime(std::chrono::sys_seconds time) {
+        const std::chrono::sys_days days = std::chrono::floor<std::chrono::days>(time);
+        const std::chrono::year_month_day date = std::chrono::year_month_day(days);
+        const std::chrono::hh_mm_ss<std::chrono::seconds> t =
+            std::chrono::hh_mm_ss<std::chrono::seconds>(time - days);
+
+        return fmt::format(
+            "{:04}-{:02}-{:02} {:02}:{:02}:{:02}",
+            static_cast<int>(date.year()),
+            static_cast<unsigned int>(date.month()),
+            static_cast<unsigned int>(date.day()),
+            t.hours().count(), t.minutes().count(), t.seconds().count()
+        );
+    }
+
+    // Returns the length of one step of the provided unit, or 0 if the length of a step
+    // is not fixed
+    std::chrono::seconds unitLength(const std::string& unit) {
+        if (unit == "m") {
+            return std::chrono::minutes(1);
+        }
+        else if (unit == "h") {
+            return std::chrono::hours(1);
+        }
+        else if (unit == "d") {
+            return std::chrono::days(1);
+        }
+        else {
+            return std::chrono::seconds(0);
+        }
+    }
+
+    // Returns the answer stored in the file, or nothing if it does not contain an answer
+    std::optional<json> readHorizonsAnswer(const std::filesystem::path& file) {
+        if (!std::filesystem::is_regular_file(file)) {
+            return std::nullopt;
+        }
+
+        try {
+            return openspace::convertHorizonsDownloadToJson(file);
+        }
+        catch (const json::exception&) {
+            // A partial or interrupted download
+            return std::nullopt;
+        }
+    }
 } // namespace
 
 namespace openspace {
@@ -141,6 +228,194 @@ json sendHorizonsRequest(const std::string& url, std::filesystem::path filePath)
     return convertHorizonsDownloadToJson(filePath);
 }
 
+json sendChunkedHorizonsRequest(HorizonsType type, const std::string& target,
+                                const std::string& observer,
+                                const std::string& startTime,
+                                const std::string& stopTime, const std::string& stepSize,
+                                const std::string& unit, std::filesystem::path filePath,
+                                int maxStepsPerChunk, int nRetries)
+{
+    const std::optional<std::chrono::sys_seconds> start = parseRequestTime(startTime);
+    const std::optional<std::chrono::sys_seconds> stop = parseRequestTime(stopTime);
+    int step = 0;
+    std::from_chars(stepSize.data(), stepSize.data() + stepSize.size(), step);
+    const std::chrono::seconds stepLength = step * unitLength(unit);
+
+    const bool canSplit = start.has_value() && stop.has_value() && *start < *stop &&
+        stepLength.count() > 0 && maxStepsPerChunk > 1;
+    const int64_t nSteps = canSplit ? (*stop - *start) / stepLength : 0;
+    if (nSteps <= maxStepsPerChunk) {
+        std::string url = constructHorizonsUrl(
+            type, target, observer, startTime, stopTime, stepSize, unit
+        );
+        return sendHorizonsRequest(url, std::move(filePath));
+    }
+
+    // Each chunk starts one step after the previous chunk ended so that no step is
+    // requested twice. The last chunk ends at the requested stop time and is extended
+    // instead of leaving a remainder of a single step, as a request needs a time range
+    struct Chunk {
+        std::string url;
+        std::filesystem::path file;
+    };
+    std::vector<Chunk> chunks;
+    for (int64_t first = 0; first < nSteps; first += maxStepsPerChunk) {
+        int64_t last = first + maxStepsPerChunk - 1;
+        if (last + 1 >= nSteps) {
+            last = nSteps;
+        }
+
+        std::string url = constructHorizonsUrl(
+            type,
+            target,
+            observer,
+            formatRequestTime(*start + first * stepLength),
+            last == nSteps ? stopTime : formatRequestTime(*start + last * stepLength),
+            stepSize,
+            unit
+        );
+
+        // The chunk files are named after their request so that they can only be reused
+        // for the exact same request
+        std::filesystem::path file = filePath;
+        file.replace_filename(fmt::format(
+            "{}_{:08x}.part", filePath.stem().string(), ghoul::hashCRC32(url)
+        ));
+        chunks.push_back({ std::move(url), std::move(file) });
+
+        if (last == nSteps) {
+            break;
+        }
+    }
+
+    // Reuse the chunks of a previous attempt that were successfully downloaded
+    std::vector<json> answers = std::vector<json>(chunks.size());
+    size_t nResumed = 0;
+    for (size_t i = 0; i < chunks.size(); i++) {
+        std::optional<json> answer = readHorizonsAnswer(chunks[i].file);
+        if (answer.has_value() &&
+            isValidHorizonsAnswer(*answer) == HorizonsResultCode::Valid)
+        {
+            answers[i] = std::move(*answer);
+            nResumed++;
+        }
+    }
+    LINFO(fmt::format(
+        "Requesting {} steps from Horizons in {} chunks ({} already downloaded)",
+        nSteps, chunks.size(), nResumed
+    ));
+
+    for (int attempt = 0; attempt <= nRetries; attempt++) {
+        std::vector<size_t> missing;
+        for (size_t i = 0; i < chunks.size(); i++) {
+            if (answers[i].is_null()) {
+                missing.push_back(i);
+            }
+        }
+        if (missing.empty()) {
+            break;
+        }
+        if (attempt > 0) {
+            LWARNING(fmt::format(
+                "Retrying {} failed Horizons chunks (attempt {} of {})",
+                missing.size(), attempt, nRetries
+            ));
+        }
+
+        for (size_t b = 0; b < missing.size(); b += MaxParallelChunks) {
+            const size_t e = std::min(b + MaxParallelChunks, missing.size());
+
+            std::vector<std::unique_ptr<HttpFileDownload>> downloads;
+            for (size_t i = b; i < e; i++) {
+                const Chunk& chunk = chunks[missing[i]];
+                downloads.push_back(std::make_unique<HttpFileDownload>(
+                    chunk.url,
+                    chunk.file,
+                    HttpFileDownload::Overwrite::Yes
+                ));
+                downloads.back()->start();
+            }
+
+            for (size_t i = b; i < e; i++) {
+                if (!downloads[i - b]->wait()) {
+                    LWARNING(fmt::format(
+                        "Error downloading horizons chunk with URL {}",
+                        downloads[i - b]->url()
+                    ));
+                    continue;
+                }
+
+                std::optional<json> answer = readHorizonsAnswer(chunks[missing[i]].file);
+                if (!answer.has_value()) {
+                    continue;
+                }
+
+                // Errors reported by Horizons will not go away by retrying the request
+                if (isValidHorizonsAnswer(*answer) != HorizonsResultCode::Valid) {
+                    return *answer;
+                }
+                answers[missing[i]] = std::move(*answer);
+            }
+        }
+    }
+
+    std::vector<std::string> results;
+    results.reserve(answers.size());
+    for (const json& answer : answers) {
+        if (answer.is_null()) {
+            LERROR("Could not download all chunks of the Horizons request");
+            return json();
+        }
+
+        auto it = answer.find("result");
+        if (it == answer.end() || !it->is_string()) {
+            LERROR(fmt::format("Malformed Horizons answer '{}'", answer.dump()));
+            return json();
+        }
+        results.push_back(*it);
+    }
+
+    std::string merged = mergeHorizonsResults(results);
+    if (merged.empty()) {
+        LERROR("Could not merge the chunks of the Horizons request");
+        return json();
+    }
+
+    json answer = std::move(answers.front());
+    answer["result"] = std::move(merged);
+
+    // Store the merged answer in the same way as a single request would
+    std::ofstream(filePath) << answer.dump();
+    for (const Chunk& chunk : chunks) {
+        std::filesystem::remove(chunk.file);
+    }
+    return answer;
+}
+
+std::string mergeHorizonsResults(const std::vector<std::string>& results) {
+    std::string merged;
+    for (size_t i = 0; i < results.size(); i++) {
+        const std::string result = ghoul::replaceAll(results[i], "\\n", "\n");
+        const size_t soe = result.find(StartOfData);
+        const size_t eoe = result.find(EndOfData);
+        if (soe == std::string::npos || eoe == std::string::npos || eoe < soe) {
+            return "";
+        }
+
+        // The data starts on the line after the start marker
+        const size_t dataBegin = std::min(result.find('\n', soe), eoe - 1) + 1;
+
+        if (i == 0) {
+            merged.append(result, 0, dataBegin);
+        }
+        merged.append(result, dataBegin, eoe - dataBegin);
+        if (i == results.size() - 1) {
+            merged.append(result, eoe);
+        }
+    }
+    return merged;
+}
+
 nlohmann::json convertHorizonsDownloadToJson(std::filesystem::path filePath) {
     // Read the entire file into a string
     constexpr size_t readSize = std::size_t(4096);
@@ -128,6 +128,34 @@ std::string constructHorizonsUrl(HorizonsType type, const std::string& target,
     const std::string& unit);
 nlohmann::json sendHorizonsRequest(const std::string& url,
     std::filesystem::path filePath);
+
+/**
+ * Sends the same request as #constructHorizonsUrl would describe, but splits the time
+ * range into consecutive chunks of at most \p maxStepsPerChunk steps each that are
+ * downloaded in parallel. This makes it possible to request long trajectories that
+ * would otherwise exceed the maximum output length of the Horizons API. Each chunk is
+ * stored in a file next to \p filePath that is named after the chunk's url, and a chunk
+ * that already has a valid answer on disk is not downloaded again, so an interrupted
+ * download can be resumed by calling this function again with the same parameters. A
+ * chunk that could not be downloaded is retried up to \p nRetries times. Only the step
+ * units "m", "h", and "d" can be split; for any other unit or if the request fits in a
+ * single chunk, this function behaves like #sendHorizonsRequest.
+ *
+ * \return The answer of the first chunk with the `result` replaced by the merged result
+ *         of all chunks, or the first answer that was not valid
+ */
+nlohmann::json sendChunkedHorizonsRequest(HorizonsType type, const std::string& target,
+    const std::string& observer, const std::string& startTime,
+    const std::string& stopTime, const std::string& stepSize, const std::string& unit,
+    std::filesystem::path filePath, int maxStepsPerChunk = 20000, int nRetries = 3);
+
+/**
+ * Merges the results of several Horizons requests that cover consecutive time ranges
+ * into a single result. The header is taken from the first result, the data between the
+ * `$$SOE` and `$$EOE` markers is concatenated in order, and the footer is taken from the
+ * last result. Returns an empty string if any of the results is missing the markers.
+ */
+std::string mergeHorizonsResults(const std::vector<std::string>& results);
 nlohmann::json convertHorizonsDownloadToJson(std::filesystem::path filePath);
 HorizonsResultCode isValidHorizonsAnswer(const nlohmann::json& answer);
 HorizonsResultCode isValidHorizonsFile(std::filesystem::path file);
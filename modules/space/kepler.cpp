@@ -27,9 +27,12 @@
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
 #include <ghoul/misc/misc.h>
 #include <scn/scn.h>
 #include <scn/tuple_return.h>
+#include <glm/gtx/transform.hpp>
+#include <cmath>
 #include <fstream>
 #include <optional>
 #include <sstream>
@@ -727,11 +730,35 @@ std::optional<std::vector<Parameters>> loadCache(std::filesystem::path file) {
         res.push_back(std::move(param));
     }
 
+    if (!stream.good()) {
+        // The file was truncated, for example as the application was terminated while
+        // the cache was written
+        LWARNING(fmt::format("Cache file {} is incomplete", file));
+        return std::nullopt;
+    }
+
     return res;
 }
 
+std::string cacheSettings(const std::filesystem::path& file, Format format) {
+    // The same file can be interpreted in different formats, and the cache has to be
+    // invalidated if the file is changed in place
+    std::string_view formatName;
+    switch (format) {
+        case Format::TLE:  formatName = "TLE";  break;
+        case Format::OMM:  formatName = "OMM";  break;
+        case Format::SBDB: formatName = "SBDB"; break;
+        default:           throw ghoul::MissingCaseException();
+    }
+    const auto modified = std::filesystem::last_write_time(file).time_since_epoch();
+    return fmt::format("{}|{}", formatName, modified.count());
+}
+
 std::vector<Parameters> readFile(std::filesystem::path file, Format format) {
-    std::filesystem::path cachedFile = FileSys.cacheManager()->cachedFilename(file);
+    std::filesystem::path cachedFile = FileSys.cacheManager()->cachedFilename(
+        file,
+        cacheSettings(file, format)
+    );
     if (std::filesystem::is_regular_file(cachedFile)) {
         LINFO(fmt::format(
             "Cached file {} used for Kepler file {}", cachedFile, file
@@ -765,4 +792,105 @@ std::vector<Parameters> readFile(std::filesystem::path file, Format format) {
     return res;
 }
 
+void eccentricAnomalies(double eccentricity, std::span<const double> meanAnomalies,
+                        std::span<double> result)
+{
+    ghoul_assert(
+        meanAnomalies.size() == result.size(),
+        "Mean anomalies and result must have the same size"
+    );
+
+    // The solvers run for a fixed number of iterations. Each iteration updates all values
+    // in a loop without dependencies between the values, which the compiler can map onto
+    // vector instructions
+    const double e = eccentricity;
+    const size_t n = meanAnomalies.size();
+    if (e == 0.0) {
+        // In a circular orbit, the eccentric anomaly = mean anomaly
+        std::copy(meanAnomalies.begin(), meanAnomalies.end(), result.begin());
+    }
+    else if (e < 0.2) {
+        // For low eccentricity, using a first order solver sufficient
+        std::copy(meanAnomalies.begin(), meanAnomalies.end(), result.begin());
+        for (int iteration = 0; iteration < 5; iteration++) {
+            for (size_t i = 0; i < n; i++) {
+                result[i] = meanAnomalies[i] + e * std::sin(result[i]);
+            }
+        }
+    }
+    else if (e < 0.9) {
+        std::copy(meanAnomalies.begin(), meanAnomalies.end(), result.begin());
+        for (int iteration = 0; iteration < 6; iteration++) {
+            for (size_t i = 0; i < n; i++) {
+                const double x = result[i];
+                const double m = meanAnomalies[i];
+                result[i] = x + (m + e * std::sin(x) - x) / (1.0 - e * std::cos(x));
+            }
+        }
+    }
+    else if (e < 1.0) {
+        auto sign = [](double val) -> double {
+            return val > 0.0 ? 1.0 : ((val < 0.0) ? -1.0 : 0.0);
+        };
+
+        for (size_t i = 0; i < n; i++) {
+            result[i] = meanAnomalies[i] + 0.85 * e * sign(std::sin(meanAnomalies[i]));
+        }
+        for (int iteration = 0; iteration < 8; iteration++) {
+            for (size_t i = 0; i < n; i++) {
+                const double x = result[i];
+                const double s = e * std::sin(x);
+                const double c = e * std::cos(x);
+                const double f = x - s - meanAnomalies[i];
+                const double f1 = 1 - c;
+                const double f2 = s;
+                result[i] = x + (-5 * f / (f1 + sign(f1) *
+                    std::sqrt(std::abs(16 * f1 * f1 - 20 * f * f2))));
+            }
+        }
+    }
+    else {
+        ghoul_assert(false, "Eccentricity must not be >= 1.0");
+        LERRORC("Kepler", "Eccentricity must not be >= 1.0");
+        std::fill(result.begin(), result.end(), 0.0);
+    }
+}
+
+double eccentricAnomaly(double eccentricity, double meanAnomaly) {
+    double result = 0.0;
+    eccentricAnomalies(
+        eccentricity,
+        std::span<const double>(&meanAnomaly, 1),
+        std::span<double>(&result, 1)
+    );
+    return result;
+}
+
+glm::dmat3 orbitPlaneRotation(double inclination, double ascendingNode,
+                              double argumentOfPeriapsis)
+{
+    // We assume the following coordinate system:
+    // z = axis of rotation
+    // x = pointing towards the first point of Aries
+    // y completes the righthanded coordinate system
+
+    // Perform three rotations:
+    // 1. Around the z axis to place the location of the ascending node
+    // 2. Around the x axis (now aligned with the ascending node) to get the correct
+    // inclination
+    // 3. Around the new z axis to place the closest approach to the correct location
+
+    const glm::dvec3 ascendingNodeAxisRot = glm::dvec3(0.0, 0.0, 1.0);
+    const glm::dvec3 inclinationAxisRot = glm::dvec3(1.0, 0.0, 0.0);
+    const glm::dvec3 argPeriapsisAxisRot = glm::dvec3(0.0, 0.0, 1.0);
+
+    const double asc = glm::radians(ascendingNode);
+    const double inc = glm::radians(inclination);
+    const double per = glm::radians(argumentOfPeriapsis);
+
+    return glm::rotate(asc, ascendingNodeAxisRot) *
+           glm::rotate(inc, inclinationAxisRot) *
+           glm::rotate(per, argPeriapsisAxisRot);
+}
+
 } // namespace openspace::kepler
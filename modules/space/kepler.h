@@ -25,7 +25,9 @@
 #ifndef __OPENSPACE_MODULE_SPACE___KEPLER___H__
 #define __OPENSPACE_MODULE_SPACE___KEPLER___H__
 
+#include <ghoul/glm.h>
 #include <filesystem>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -105,6 +107,36 @@ enum class Format {
  */
 std::vector<Parameters> readFile(std::filesystem::path file, Format format);
 
+/**
+ * Computes the eccentric anomaly (the location of the object taking the eccentricity of
+ * the orbit into account) for each of the \p meanAnomalies (the location assuming an
+ * eccentricity of 0.0) using the solver that is most efficient for the regime of the
+ * \p eccentricity. All values are solved together, one iteration at a time, so that the
+ * compiler can vectorize the computation.
+ *
+ * \param eccentricity The eccentricity of the orbit, which must be in [0, 1)
+ * \param meanAnomalies The mean anomalies in radians
+ * \param result The eccentric anomalies in radians for each of the \p meanAnomalies
+ *
+ * \pre \p result must have the same size as \p meanAnomalies
+ */
+void eccentricAnomalies(double eccentricity, std::span<const double> meanAnomalies,
+    std::span<double> result);
+
+/**
+ * Computes the eccentric anomaly for a single \p meanAnomaly in radians. See
+ * #eccentricAnomalies for more information.
+ */
+double eccentricAnomaly(double eccentricity, double meanAnomaly);
+
+/**
+ * Returns the rotation that transforms a position in the plane of an orbit, in which the
+ * x-axis points towards the periapsis, into the reference frame of the central body. All
+ * angles are provided in degrees.
+ */
+glm::dmat3 orbitPlaneRotation(double inclination, double ascendingNode,
+    double argumentOfPeriapsis);
+
 } // namespace openspace::kepler
 
 #endif // __OPENSPACE_MODULE_SPACE___KEPLER___H__
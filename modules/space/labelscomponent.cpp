@@ -27,10 +27,12 @@
 #include <openspace/engine/globals.h>
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/documentation/documentation.h>
+#include <openspace/rendering/renderengine.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/font/fontmanager.h>
 #include <ghoul/font/fontrenderer.h>
+#include <cmath>
 #include <optional>
 
 namespace {
@@ -273,6 +275,14 @@ void LabelsComponent::render(const RenderData& data,
 
     glm::vec4 textColor = glm::vec4(glm::vec3(_color), opacity() * fadeInVariable);
 
+    // The font renderer lays out every label it is given, so we discard all labels that
+    // are behind the camera or so far outside the view frustum that even a label of the
+    // maximum size could not reach into it. The extent is measured in normalized device
+    // coordinates and assumes that a character is never wider than it is tall
+    const glm::dvec2 pixelSize =
+        2.0 / glm::dvec2(global::renderEngine->renderingResolution());
+    const double maxSize = static_cast<double>(_minMaxSize.value().y);
+
     for (const speck::Labelset::Entry& e : _labelset.entries) {
         if (!e.isEnabled) {
             continue;
@@ -283,6 +293,21 @@ void LabelsComponent::render(const RenderData& data,
         glm::vec3 scaledPos(transformedPos);
         scaledPos *= scale;
 
+        const glm::dvec4 clipPos =
+            modelViewProjectionMatrix * glm::dvec4(glm::dvec3(scaledPos), 1.0);
+        if (clipPos.w <= 0.0) {
+            continue;
+        }
+        const glm::dvec2 extent = glm::dvec2(
+            maxSize * static_cast<double>(e.text.size() + 1) * pixelSize.x,
+            maxSize * pixelSize.y
+        );
+        if (std::abs(clipPos.x) > clipPos.w * (1.0 + extent.x) ||
+            std::abs(clipPos.y) > clipPos.w * (1.0 + extent.y))
+        {
+            continue;
+        }
+
         ghoul::fontrendering::FontRenderer::defaultProjectionRenderer().render(
             *_font,
             scaledPos,
@@ -200,11 +200,12 @@ void RenderableConstellationBounds::render(const RenderData& data, RendererTasks
     glLineWidth(_lineWidth);
 
     glBindVertexArray(_vao);
-    for (const ConstellationBound& bound : _constellationBounds) {
-        if (bound.isEnabled) {
-            glDrawArrays(GL_LINE_LOOP, bound.startIndex, bound.nVertices);
-        }
-    }
+    glMultiDrawArrays(
+        GL_LINE_LOOP,
+        _boundStart.data(),
+        _boundCount.data(),
+        static_cast<GLsizei>(_boundStart.size())
+    );
     glBindVertexArray(0);
     _program->deactivate();
 
@@ -315,6 +316,7 @@ bool RenderableConstellationBounds::loadVertexFile() {
     );
     _constellationBounds.push_back(currentBound);
 
+    updateBoundRanges();
     return true;
 }
 
@@ -331,6 +333,19 @@ void RenderableConstellationBounds::selectionPropertyHasChanged() {
             b.isEnabled = _selection.isSelected(b.constellationFullName);
         }
     }
+
+    updateBoundRanges();
+}
+
+void RenderableConstellationBounds::updateBoundRanges() {
+    _boundStart.clear();
+    _boundCount.clear();
+    for (const ConstellationBound& b : _constellationBounds) {
+        if (b.isEnabled && b.nVertices > 0) {
+            _boundStart.push_back(b.startIndex);
+            _boundCount.push_back(b.nVertices);
+        }
+    }
 }
 
 } // namespace openspace
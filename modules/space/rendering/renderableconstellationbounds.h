@@ -76,6 +76,9 @@ private:
     bool loadVertexFile();
     bool loadData();
 
+    /// Updates the list of line loops that are drawn from the enabled constellations
+    void updateBoundRanges();
+
     /**
      * Callback method that gets triggered when `_constellationSelection` changes.
      */
@@ -101,6 +104,10 @@ private:
 
     GLuint _vao = 0;
     GLuint _vbo = 0;
+
+    // The first vertex and number of vertices of each enabled constellation bound
+    std::vector<GLint> _boundStart;
+    std::vector<GLsizei> _boundCount;
 };
 
 } // namespace openspace
@@ -36,6 +36,7 @@
 #include <ghoul/opengl/programobject.h>
 #include <scn/scn.h>
 #include <array>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <optional>
@@ -43,8 +44,8 @@
 namespace {
     constexpr std::string_view _loggerCat = "RenderableConstellationLines";
 
-    constexpr std::array<const char*, 4> UniformNames = {
-        "modelViewTransform", "projectionTransform", "opacity", "color"
+    constexpr std::array<const char*, 3> UniformNames = {
+        "modelViewTransform", "projectionTransform", "opacity"
     };
 
     constexpr openspace::properties::Property::PropertyInfo SpeckInfo = {
@@ -165,6 +166,8 @@ void RenderableConstellationLines::selectionPropertyHasChanged() {
             }
         }
     }
+
+    updateLineRanges();
 }
 
 bool RenderableConstellationLines::isReady() const {
@@ -227,12 +230,10 @@ void RenderableConstellationLines::initializeGL() {
 }
 
 void RenderableConstellationLines::deinitializeGL() {
-    using ConstellationKeyValuePair = std::pair<const int, ConstellationLine>;
-    for (const ConstellationKeyValuePair& pair : _renderingConstellationsMap)
-    {
-        glDeleteVertexArrays(1, &pair.second.vaoArray);
-        glDeleteBuffers(1, &pair.second.vboArray);
-    }
+    glDeleteVertexArrays(1, &_vao);
+    _vao = 0;
+    glDeleteBuffers(1, &_vbo);
+    _vbo = 0;
 
     if (_program) {
         global::renderEngine->removeRenderProgram(_program.get());
@@ -255,25 +256,15 @@ void RenderableConstellationLines::renderConstellations(const RenderData&,
     _program->setUniform(_uniformCache.projectionTransform, projectionMatrix);
     _program->setUniform(_uniformCache.opacity, opacity());
 
-    using ConstellationKeyValuePair = std::pair<const int, ConstellationLine>;
-    for (const ConstellationKeyValuePair& pair : _renderingConstellationsMap)
-    {
-        if (!pair.second.isEnabled) {
-            continue;
-        }
-
-        _program->setUniform(
-            _uniformCache.color,
-            _constellationColorMap[pair.second.colorIndex]
-        );
-
-        glBindVertexArray(pair.second.vaoArray);
-
-        glLineWidth(_lineWidth);
-        glDrawArrays(GL_LINE_STRIP, 0, pair.second.numV);
-        global::renderEngine->openglStateCache().resetLineState();
-    }
-
+    glBindVertexArray(_vao);
+    glLineWidth(_lineWidth);
+    glMultiDrawArrays(
+        GL_LINE_STRIP,
+        _lineStart.data(),
+        _lineCount.data(),
+        static_cast<GLsizei>(_lineStart.size())
+    );
+    global::renderEngine->openglStateCache().resetLineState();
     glBindVertexArray(0);
     _program->deactivate();
 
@@ -447,29 +438,61 @@ bool RenderableConstellationLines::readSpeckFile() {
 void RenderableConstellationLines::createConstellations() {
     LDEBUG("Creating constellations");
 
+    std::vector<Vertex> vertices;
     for (std::pair<const int, ConstellationLine>& p : _renderingConstellationsMap) {
-        GLuint vao;
-        glGenVertexArrays(1, &vao);
-        p.second.vaoArray = vao;
-
-        GLuint vbo;
-        glGenBuffers(1, &vbo);
-        p.second.vboArray = vbo;
-
-        glBindVertexArray(vao);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            p.second.vertices.size() * sizeof(GLfloat),
-            p.second.vertices.data(),
-            GL_STATIC_DRAW
-        );
-        // in_position
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+        p.second.startIndex = static_cast<GLint>(vertices.size());
+        const glm::vec3 color = _constellationColorMap[p.second.colorIndex];
+        for (size_t i = 0; i + 2 < p.second.vertices.size(); i += 3) {
+            const glm::vec3 position = glm::vec3(
+                p.second.vertices[i],
+                p.second.vertices[i + 1],
+                p.second.vertices[i + 2]
+            );
+            vertices.push_back({ position, color });
+        }
+    }
+
+    if (_vao == 0) {
+        glGenVertexArrays(1, &_vao);
+        glGenBuffers(1, &_vbo);
     }
+    glBindVertexArray(_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        vertices.size() * sizeof(Vertex),
+        vertices.data(),
+        GL_STATIC_DRAW
+    );
+    // in_position
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), nullptr);
+    // in_color
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Vertex),
+        reinterpret_cast<GLvoid*>(offsetof(Vertex, color))
+    );
 
     glBindVertexArray(0);
+
+    updateLineRanges();
+}
+
+void RenderableConstellationLines::updateLineRanges() {
+    _lineStart.clear();
+    _lineCount.clear();
+    for (const std::pair<const int, ConstellationLine>& p : _renderingConstellationsMap) {
+        const GLsizei nVertices = static_cast<GLsizei>(p.second.vertices.size() / 3);
+        if (p.second.isEnabled && nVertices > 0) {
+            _lineStart.push_back(p.second.startIndex);
+            _lineCount.push_back(nVertices);
+        }
+    }
 }
 
 } // namespace openspace
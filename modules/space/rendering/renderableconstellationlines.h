@@ -29,6 +29,7 @@
 
 #include <ghoul/opengl/uniformcache.h>
 #include <unordered_map>
+#include <vector>
 
 namespace ghoul::filesystem { class File; }
 namespace ghoul::fontrendering { class Font; }
@@ -64,12 +65,20 @@ private:
         int lineIndex;
         int colorIndex;
         int numV;
-        GLuint vaoArray;
-        GLuint vboArray;
+        // The index of the first vertex of this line in the shared vertex buffer
+        GLint startIndex = 0;
         std::vector<GLfloat> vertices;
     };
 
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec3 color;
+    };
+
     void createConstellations();
+
+    /// Updates the list of line strips that are drawn from the enabled constellations
+    void updateLineRanges();
     void renderConstellations(const RenderData& data, const glm::dmat4& modelViewMatrix,
         const glm::dmat4& projectionMatrix);
 
@@ -84,8 +93,7 @@ private:
     properties::BoolProperty _drawElements;
 
     std::unique_ptr<ghoul::opengl::ProgramObject> _program = nullptr;
-    UniformCache(modelViewTransform, projectionTransform, opacity,
-        color) _uniformCache;
+    UniformCache(modelViewTransform, projectionTransform, opacity) _uniformCache;
 
     properties::StringProperty _speckFile;
 
@@ -95,6 +103,13 @@ private:
 
     std::unordered_map<int, glm::vec3> _constellationColorMap;
     std::unordered_map<int, ConstellationLine> _renderingConstellationsMap;
+
+    // All constellations are stored in a single vertex buffer. Changing the selection
+    // only changes which ranges of that buffer are drawn
+    GLuint _vao = 0;
+    GLuint _vbo = 0;
+    std::vector<GLint> _lineStart;
+    std::vector<GLsizei> _lineCount;
 };
 } // namespace openspace
 
@@ -276,16 +276,9 @@ void RenderableEclipseCone::render(const RenderData& data, RendererTasks&) {
 
     _shader->activate();
 
-    // Model transform and view transform needs to be in double precision
-    const glm::dmat4 modelTransform =
-        glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
-        glm::dmat4(data.modelTransform.rotation) *
-        glm::scale(glm::dmat4(1.0), glm::dvec3(data.modelTransform.scale));
-    glm::dmat4 modelViewTransform = data.camera.combinedViewMatrix() * modelTransform;
-
     _shader->setUniform(
         _uniformCache.modelViewProjectionTransform,
-        data.camera.projectionMatrix() * glm::mat4(modelViewTransform)
+        data.modelViewProjectionTransform()
     );
 
     _shader->setUniform(_uniformCache.opacity, opacity());
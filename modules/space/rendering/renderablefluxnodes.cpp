@@ -39,6 +39,8 @@
 #include <ghoul/logging/visualstudiooutputlog.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/textureunit.h>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <optional>
@@ -276,9 +278,19 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
+    // The positions file starts with the number of nodes per timestep and the number of
+    // timesteps. The fluxes and radiuses files contain only the values
+    constexpr size_t PositionsHeaderSize = 2 * sizeof(uint32_t);
+
     struct [[codegen::Dictionary(RenderableFluxNodes)]] Parameters {
         // path to source folder with the 3 binary files in it
         std::filesystem::path sourceFolder [[codegen::directory()]];
+        // Set to true to memory-map the binary files and only page in the timesteps
+        // around the current time instead of reading all of them at initialization
+        std::optional<bool> loadAtRuntime;
+        // The number of timesteps before and after the current one that are read ahead
+        // when loading at runtime. The default is 2
+        std::optional<int> prefetchStates [[codegen::greaterequal(0)]];
         // [[codegen::verbatim(ColorTablePathInfo.description)]]
         std::string colorTablePath;
         // [[codegen::verbatim(GoesEnergyBinsInfo.description)]]
@@ -343,6 +355,8 @@ RenderableFluxNodes::RenderableFluxNodes(const ghoul::Dictionary& dictionary)
     _colorTablePath = p.colorTablePath;
     _transferFunction = std::make_unique<TransferFunction>(_colorTablePath);
     _colorTableRange = p.colorTableRange.value_or(_colorTableRange);
+    _isStreaming = p.loadAtRuntime.value_or(_isStreaming);
+    _nStreamingWindowStates = p.prefetchStates.value_or(_nStreamingWindowStates);
 
     _binarySourceFolderPath = p.sourceFolder;
     if (std::filesystem::is_directory(_binarySourceFolderPath)) {
@@ -435,8 +449,6 @@ void RenderableFluxNodes::definePropertyCallbackFunctions() {
 }
 
 void RenderableFluxNodes::loadNodeData(int energybinOption) {
-    LDEBUG("Loading in binary files directly from sync folder");
-
     std::string energybin;
     switch (energybinOption) {
         case 0:
@@ -447,9 +459,28 @@ void RenderableFluxNodes::loadNodeData(int energybinOption) {
             break;
     }
 
-    std::string file = _binarySourceFolderPath.string() + "\\positions" + energybin;
-    std::string file2 = _binarySourceFolderPath.string() + "\\fluxes" + energybin;
-    std::string file3 = _binarySourceFolderPath.string() + "\\radiuses" + energybin;
+    namespace fs = std::filesystem;
+    const fs::path file = _binarySourceFolderPath / ("positions" + energybin);
+    const fs::path file2 = _binarySourceFolderPath / ("fluxes" + energybin);
+    const fs::path file3 = _binarySourceFolderPath / ("radiuses" + energybin);
+
+    _statesColor.clear();
+    _statesPos.clear();
+    _statesRadius.clear();
+    _mappedPositions = MemoryMappedFile();
+    _mappedFluxes = MemoryMappedFile();
+    _mappedRadiuses = MemoryMappedFile();
+    _nNodesPerTimestep = 0;
+    _uploadedStateIndex = -1;
+    _nUploadedNodes = 0;
+
+    if (_isStreaming) {
+        LDEBUG("Mapping binary files from sync folder");
+        mapNodeData(file, file2, file3);
+        return;
+    }
+
+    LDEBUG("Loading in binary files directly from sync folder");
 
     std::ifstream fileStream(file, std::ifstream::binary);
     std::ifstream fileStream2(file2, std::ifstream::binary);
@@ -474,37 +505,148 @@ void RenderableFluxNodes::loadNodeData(int energybinOption) {
         );
         return;
     }
-
-    _statesColor.clear();
-    _statesPos.clear();
-    _statesRadius.clear();
+    _nNodesPerTimestep = nNodesPerTimestep;
 
     for (unsigned int i = 0; i < _nStates; ++i) {
-        _vertexPositions.resize(nNodesPerTimestep);
+        std::vector<glm::vec3> vertexPositions(nNodesPerTimestep);
         fileStream.read(reinterpret_cast<char*>(
-            _vertexPositions.data()), nNodesPerTimestep * sizeof(glm::vec3)
+            vertexPositions.data()), nNodesPerTimestep * sizeof(glm::vec3)
         );
 
-        _statesPos.push_back(_vertexPositions);
-        _vertexPositions.clear();
+        _statesPos.push_back(std::move(vertexPositions));
     }
     for (unsigned int i = 0; i < _nStates; ++i) {
-        _vertexColor.resize(nNodesPerTimestep);
+        std::vector<float> vertexColor(nNodesPerTimestep);
         fileStream2.read(reinterpret_cast<char*>(
-            _vertexColor.data()), nNodesPerTimestep * sizeof(float)
+            vertexColor.data()), nNodesPerTimestep * sizeof(float)
         );
 
-        _statesColor.push_back(_vertexColor);
-        _vertexColor.clear();
+        _statesColor.push_back(std::move(vertexColor));
     }
     for (unsigned int i = 0; i < _nStates; ++i) {
-        _vertexRadius.resize(nNodesPerTimestep);
+        std::vector<float> vertexRadius(nNodesPerTimestep);
         fileStream3.read(reinterpret_cast<char*>(
-            _vertexRadius.data()), nNodesPerTimestep * sizeof(float)
+            vertexRadius.data()), nNodesPerTimestep * sizeof(float)
         );
 
-        _statesRadius.push_back(_vertexRadius);
-        _vertexRadius.clear();
+        _statesRadius.push_back(std::move(vertexRadius));
+    }
+}
+
+bool RenderableFluxNodes::mapNodeData(const std::filesystem::path& positionsFile,
+                                      const std::filesystem::path& fluxesFile,
+                                      const std::filesystem::path& radiusesFile)
+{
+    MemoryMappedFile positions = MemoryMappedFile(positionsFile);
+    if (positions.size() < PositionsHeaderSize) {
+        LERROR(fmt::format("Could not read file '{}'", positionsFile));
+        return false;
+    }
+
+    uint32_t nNodesPerTimestep = 0;
+    uint32_t nTimeSteps = 0;
+    const std::byte* header = positions.data();
+    std::memcpy(&nNodesPerTimestep, header, sizeof(uint32_t));
+    std::memcpy(&nTimeSteps, header + sizeof(uint32_t), sizeof(uint32_t));
+    _nStates = nTimeSteps;
+
+    if (_nStates != _startTimes.size()) {
+        LERROR(
+            "Number of states, _nStates, and number of start times, _startTimes, "
+            "do not match"
+        );
+        return false;
+    }
+
+    MemoryMappedFile fluxes = MemoryMappedFile(fluxesFile);
+    MemoryMappedFile radiuses = MemoryMappedFile(radiusesFile);
+
+    // All timesteps have to be in the files, as they are read in place
+    const size_t nValues = static_cast<size_t>(nNodesPerTimestep) * nTimeSteps;
+    if (positions.size() < PositionsHeaderSize + nValues * sizeof(glm::vec3)) {
+        LERROR(fmt::format("File '{}' is missing nodes", positionsFile));
+        return false;
+    }
+    if (!fluxes.isValid() || fluxes.size() < nValues * sizeof(float)) {
+        LERROR(fmt::format("Could not read all nodes from file '{}'", fluxesFile));
+        return false;
+    }
+    if (!radiuses.isValid() || radiuses.size() < nValues * sizeof(float)) {
+        LERROR(fmt::format("Could not read all nodes from file '{}'", radiusesFile));
+        return false;
+    }
+
+    _nNodesPerTimestep = nNodesPerTimestep;
+    _mappedPositions = std::move(positions);
+    _mappedFluxes = std::move(fluxes);
+    _mappedRadiuses = std::move(radiuses);
+    return true;
+}
+
+RenderableFluxNodes::StateData RenderableFluxNodes::stateData(int index) const {
+    if (index < 0 || index >= static_cast<int>(_nStates)) {
+        return StateData();
+    }
+
+    if (!_isStreaming) {
+        if (index >= static_cast<int>(_statesPos.size())) {
+            return StateData();
+        }
+        return { _statesPos[index], _statesColor[index], _statesRadius[index] };
+    }
+
+    if (!_mappedPositions.isValid()) {
+        return StateData();
+    }
+    const size_t n = _nNodesPerTimestep;
+    const size_t first = static_cast<size_t>(index) * n;
+    const std::byte* positions = _mappedPositions.data() + PositionsHeaderSize;
+    return {
+        std::span<const glm::vec3>(
+            reinterpret_cast<const glm::vec3*>(positions) + first,
+            n
+        ),
+        std::span<const float>(
+            reinterpret_cast<const float*>(_mappedFluxes.data()) + first,
+            n
+        ),
+        std::span<const float>(
+            reinterpret_cast<const float*>(_mappedRadiuses.data()) + first,
+            n
+        )
+    };
+}
+
+// Pages in the states around the new index and releases those that were only around the
+// old index
+void RenderableFluxNodes::adviseStreamingWindow(int oldIndex, int newIndex) {
+    auto advise = [this](int index, bool willNeed) {
+        const StateData state = stateData(index);
+        if (state.positions.empty()) {
+            return;
+        }
+
+        using Usage = MemoryMappedFile::Usage;
+        const Usage usage = willNeed ? Usage::WillNeed : Usage::DontNeed;
+        _mappedPositions.advise(
+            usage,
+            state.positions.data(),
+            state.positions.size_bytes()
+        );
+        _mappedFluxes.advise(usage, state.fluxes.data(), state.fluxes.size_bytes());
+        _mappedRadiuses.advise(usage, state.radiuses.data(), state.radiuses.size_bytes());
+    };
+    const int window = _nStreamingWindowStates;
+
+    if (oldIndex != -1) {
+        for (int i = oldIndex - window; i <= oldIndex + window; ++i) {
+            if (std::abs(i - newIndex) > window) {
+                advise(i, false);
+            }
+        }
+    }
+    for (int i = newIndex - window; i <= newIndex + window; ++i) {
+        advise(i, true);
     }
 }
 
@@ -758,11 +900,7 @@ void RenderableFluxNodes::render(const RenderData& data, RendererTasks&) {
 
     glBindVertexArray(_vertexArrayObject);
 
-    glDrawArrays(
-        GL_POINTS,
-        0,
-        static_cast<GLsizei>(_vertexPositions.size())
-    );
+    glDrawArrays(GL_POINTS, 0, _nUploadedNodes);
 
     glBindVertexArray(0);
     _shaderProgram->deactivate();
@@ -816,14 +954,20 @@ void RenderableFluxNodes::update(const UpdateData& data) {
         needsUpdate = false;
     }
 
-    if (needsUpdate && !_statesPos[_activeTriggerTimeIndex].empty()) {
-        _vertexPositions = _statesPos[_activeTriggerTimeIndex];
-        _vertexColor = _statesColor[_activeTriggerTimeIndex];
-        _vertexRadius = _statesRadius[_activeTriggerTimeIndex];
+    // The buffers only change when another state becomes active or the data is reloaded
+    if (needsUpdate && _activeTriggerTimeIndex != _uploadedStateIndex) {
+        const StateData state = stateData(_activeTriggerTimeIndex);
+        if (!state.positions.empty()) {
+            if (_isStreaming) {
+                adviseStreamingWindow(_uploadedStateIndex, _activeTriggerTimeIndex);
+            }
+            updatePositionBuffer(state.positions);
+            updateVertexColorBuffer(state.fluxes);
+            updateVertexFilteringBuffer(state.radiuses);
+            _nUploadedNodes = static_cast<GLsizei>(state.positions.size());
+            _uploadedStateIndex = _activeTriggerTimeIndex;
+        }
         needsUpdate = false;
-        updatePositionBuffer();
-        updateVertexColorBuffer();
-        updateVertexFilteringBuffer();
     }
 
     if (_shaderProgram->isDirty()) {
@@ -836,14 +980,14 @@ void RenderableFluxNodes::update(const UpdateData& data) {
     }
 }
 
-void RenderableFluxNodes::updatePositionBuffer() {
+void RenderableFluxNodes::updatePositionBuffer(std::span<const glm::vec3> positions) {
     glBindVertexArray(_vertexArrayObject);
     glBindBuffer(GL_ARRAY_BUFFER, _vertexPositionBuffer);
 
     glBufferData(
         GL_ARRAY_BUFFER,
-        _vertexPositions.size() * sizeof(glm::vec3),
-        _vertexPositions.data(),
+        positions.size_bytes(),
+        positions.data(),
         GL_STATIC_DRAW
     );
 
@@ -855,16 +999,11 @@ void RenderableFluxNodes::updatePositionBuffer() {
     glBindVertexArray(0);
 }
 
-void RenderableFluxNodes::updateVertexColorBuffer() {
+void RenderableFluxNodes::updateVertexColorBuffer(std::span<const float> fluxes) {
     glBindVertexArray(_vertexArrayObject);
     glBindBuffer(GL_ARRAY_BUFFER, _vertexColorBuffer);
 
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        _vertexColor.size() * sizeof(float),
-        _vertexColor.data(),
-        GL_STATIC_DRAW
-    );
+    glBufferData(GL_ARRAY_BUFFER, fluxes.size_bytes(), fluxes.data(), GL_STATIC_DRAW);
 
     glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 0, nullptr);
@@ -873,14 +1012,14 @@ void RenderableFluxNodes::updateVertexColorBuffer() {
     glBindVertexArray(0);
 }
 
-void RenderableFluxNodes::updateVertexFilteringBuffer() {
+void RenderableFluxNodes::updateVertexFilteringBuffer(std::span<const float> radiuses) {
     glBindVertexArray(_vertexArrayObject);
     glBindBuffer(GL_ARRAY_BUFFER, _vertexFilteringBuffer);
 
     glBufferData(
         GL_ARRAY_BUFFER,
-        _vertexRadius.size() * sizeof(float),
-        _vertexRadius.data(),
+        radiuses.size_bytes(),
+        radiuses.data(),
         GL_STATIC_DRAW
     );
 
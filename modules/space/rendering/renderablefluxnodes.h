@@ -34,8 +34,11 @@
 #include <openspace/properties/vector/vec2property.h>
 #include <openspace/properties/vector/vec4property.h>
 #include <openspace/rendering/transferfunction.h>
+#include <openspace/util/memorymappedfile.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <atomic>
+#include <memory>
+#include <span>
 
 namespace openspace {
 
@@ -55,6 +58,13 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    /// The nodes of a single timestep, either in RAM or in the memory-mapped files
+    struct StateData {
+        std::span<const glm::vec3> positions;
+        std::span<const float> fluxes;
+        std::span<const float> radiuses;
+    };
+
     void definePropertyCallbackFunctions();
     void populateStartTimes();
     void computeSequenceEndTime();
@@ -62,9 +72,14 @@ private:
     void updateActiveTriggerTimeIndex(double currentTime);
 
     void loadNodeData(int energybinOption);
-    void updatePositionBuffer();
-    void updateVertexColorBuffer();
-    void updateVertexFilteringBuffer();
+    bool mapNodeData(const std::filesystem::path& positionsFile,
+        const std::filesystem::path& fluxesFile,
+        const std::filesystem::path& radiusesFile);
+    StateData stateData(int index) const;
+    void adviseStreamingWindow(int oldIndex, int newIndex);
+    void updatePositionBuffer(std::span<const glm::vec3> positions);
+    void updateVertexColorBuffer(std::span<const float> fluxes);
+    void updateVertexFilteringBuffer(std::span<const float> radiuses);
 
     std::vector<GLsizei> _lineCount;
     std::vector<GLint> _lineStart;
@@ -109,8 +124,25 @@ private:
 
     // Active index of _startTimes
     int _activeTriggerTimeIndex = -1;
+    // Index of the state whose nodes are in the vertex buffers
+    int _uploadedStateIndex = -1;
     // Number of states in the sequence
     uint32_t _nStates = 0;
+    // Number of nodes in each of the states
+    uint32_t _nNodesPerTimestep = 0;
+    // Number of nodes in the vertex buffers
+    GLsizei _nUploadedNodes = 0;
+
+    // True => the binary files are memory-mapped and only the states around the active
+    // one are paged in. False => all states are read into RAM at initialization
+    bool _isStreaming = false;
+    // Number of states before and after the active one that are prefetched when
+    // streaming
+    int _nStreamingWindowStates = 2;
+    // Memory-mapped binary files, only used when streaming
+    MemoryMappedFile _mappedPositions;
+    MemoryMappedFile _mappedFluxes;
+    MemoryMappedFile _mappedRadiuses;
 
     // Estimated end of sequence.
     double _sequenceEndTime;
@@ -132,12 +164,6 @@ private:
     std::vector<std::string> _binarySourceFiles;
     // Contains the _triggerTimes for all streams in the sequence
     std::vector<double> _startTimes;
-    // Contains vertexPositions
-    std::vector<glm::vec3> _vertexPositions;
-    // Contains vertex flux values for color
-    std::vector<float> _vertexColor;
-    // Contains radius of vertices
-    std::vector<float> _vertexRadius;
     // Stores the states position
     std::vector<std::vector<glm::vec3>> _statesPos;
     // Stores the states color
@@ -31,16 +31,21 @@
 #include <openspace/engine/globals.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
-#include <openspace/util/time.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/misc/csvreader.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/logging/logmanager.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <cmath>
 #include <fstream>
 #include <math.h>
+#include <numeric>
 #include <random>
 #include <vector>
 
@@ -112,6 +117,26 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
+    constexpr openspace::properties::Property::PropertyInfo EvaluateOnGpuInfo = {
+        "EvaluateOnGpu",
+        "Evaluate on GPU",
+        "If enabled, only the orbital elements of each object are uploaded and the "
+        "orbits are evaluated in the vertex shader while rendering. This reduces the "
+        "memory use to a small, fixed amount per object and makes changes to the "
+        "segment quality free. The vertices are spaced evenly in eccentric anomaly "
+        "rather than in time, which spaces them more densely close to the periapsis",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo ShowPositionsInfo = {
+        "ShowPositions",
+        "Show Positions",
+        "If enabled, the current position of each object is drawn as a point using the "
+        "point size of the appearance. This is only available if the orbits are "
+        "evaluated on the GPU",
+        openspace::properties::Property::Visibility::User
+    };
+
     struct [[codegen::Dictionary(RenderableOrbitalKepler)]] Parameters {
         // [[codegen::verbatim(PathInfo.description)]]
         std::filesystem::path path;
@@ -147,6 +172,12 @@ namespace {
 
         // [[codegen::verbatim(ContiguousModeInfo.description)]]
         std::optional<bool> contiguousMode;
+
+        // [[codegen::verbatim(EvaluateOnGpuInfo.description)]]
+        std::optional<bool> evaluateOnGpu;
+
+        // [[codegen::verbatim(ShowPositionsInfo.description)]]
+        std::optional<bool> showPositions;
     };
 #include "renderableorbitalkepler_codegen.cpp"
 } // namespace
@@ -158,19 +189,27 @@ documentation::Documentation RenderableOrbitalKepler::Documentation() {
 }
 
 RenderableOrbitalKepler::RenderableOrbitalKepler(const ghoul::Dictionary& dict)
-    : Renderable(dict)
+    // The bounding sphere is based on the semi-major axes, which eccentric orbits exceed
+    : Renderable(dict, { .supportsCulling = false })
     , _segmentQuality(SegmentQualityInfo, 2, 1, 10)
     , _startRenderIdx(StartRenderIdxInfo, 0, 0, 1)
     , _sizeRender(RenderSizeInfo, 1, 1, 2)
     , _path(PathInfo)
     , _contiguousMode(ContiguousModeInfo, false)
+    , _evaluateOnGpu(EvaluateOnGpuInfo, false)
+    , _showPositions(ShowPositionsInfo, false)
 {
     const Parameters p = codegen::bake<Parameters>(dict);
 
     addProperty(Fadeable::_opacity);
 
     _segmentQuality = static_cast<unsigned int>(p.segmentQuality);
-    _segmentQuality.onChange([this]() { updateBuffers(); });
+    _segmentQuality.onChange([this]() {
+        // The number of segments is only a uniform if the orbits are evaluated on the GPU
+        if (!_evaluateOnGpu) {
+            updateBuffers();
+        }
+    });
     addProperty(_segmentQuality);
 
     _appearance.lineColor = p.color;
@@ -179,7 +218,10 @@ RenderableOrbitalKepler::RenderableOrbitalKepler(const ghoul::Dictionary& dict)
     addPropertySubOwner(_appearance);
 
     _path = p.path.string();
-    _path.onChange([this]() { updateBuffers(); });
+    _path.onChange([this]() {
+        _parametersAreDirty = true;
+        updateBuffers();
+    });
     addProperty(_path);
 
     _format = codegen::map<kepler::Format>(p.format);
@@ -209,6 +251,13 @@ RenderableOrbitalKepler::RenderableOrbitalKepler(const ghoul::Dictionary& dict)
     _contiguousMode = p.contiguousMode.value_or(false);
     _contiguousMode.onChange([this]() { _updateDataBuffersAtNextRender = true; });
     addProperty(_contiguousMode);
+
+    _evaluateOnGpu = p.evaluateOnGpu.value_or(_evaluateOnGpu);
+    _evaluateOnGpu.onChange([this]() { _updateDataBuffersAtNextRender = true; });
+    addProperty(_evaluateOnGpu);
+
+    _showPositions = p.showPositions.value_or(_showPositions);
+    addProperty(_showPositions);
 }
 
 void RenderableOrbitalKepler::initializeGL() {
@@ -235,12 +284,45 @@ void RenderableOrbitalKepler::initializeGL() {
     _uniformCache.color = _programObject->uniformLocation("color");
     _uniformCache.opacity = _programObject->uniformLocation("opacity");
 
+    glGenVertexArrays(1, &_gpuVertexArray);
+    glGenBuffers(1, &_gpuVertexBuffer);
+    _gpuProgramObject = SpaceModule::ProgramObjectManager.request(
+        "OrbitalKeplerGpu",
+        []() -> std::unique_ptr<ghoul::opengl::ProgramObject> {
+            return global::renderEngine->buildRenderProgram(
+                "OrbitalKeplerGpu",
+                absPath("${MODULE_SPACE}/shaders/debrisVizGpu_vs.glsl"),
+                absPath("${MODULE_SPACE}/shaders/debrisViz_fs.glsl")
+            );
+        }
+    );
+    ghoul::opengl::updateUniformLocations(
+        *_gpuProgramObject,
+        _gpuUniformCache,
+        {
+            "modelViewTransform", "projectionTransform", "lineFade", "inGameTime",
+            "color", "opacity", "numberOfSegments", "renderPositions"
+        }
+    );
+
     updateBuffers();
 }
 
 void RenderableOrbitalKepler::deinitializeGL() {
     glDeleteBuffers(1, &_vertexBuffer);
     glDeleteVertexArrays(1, &_vertexArray);
+    glDeleteBuffers(1, &_gpuVertexBuffer);
+    _gpuVertexBuffer = 0;
+    glDeleteVertexArrays(1, &_gpuVertexArray);
+    _gpuVertexArray = 0;
+
+    SpaceModule::ProgramObjectManager.release(
+        "OrbitalKeplerGpu",
+        [](ghoul::opengl::ProgramObject* p) {
+            global::renderEngine->removeRenderProgram(p);
+        }
+    );
+    _gpuProgramObject = nullptr;
 
     SpaceModule::ProgramObjectManager.release(
         "OrbitalKepler",
@@ -263,6 +345,16 @@ void RenderableOrbitalKepler::update(const UpdateData&) {
 }
 
 void RenderableOrbitalKepler::render(const RenderData& data, RendererTasks&) {
+    const glm::dmat4 modelTransform =
+        glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
+        glm::dmat4(data.modelTransform.rotation) *
+        glm::scale(glm::dmat4(1.0), glm::dvec3(data.modelTransform.scale));
+
+    if (_evaluateOnGpu) {
+        renderGpuOrbits(data, modelTransform);
+        return;
+    }
+
     if (_vertexBufferData.empty()) {
         return;
     }
@@ -271,11 +363,6 @@ void RenderableOrbitalKepler::render(const RenderData& data, RendererTasks&) {
     _programObject->setUniform(_uniformCache.opacity, opacity());
     _programObject->setUniform(_uniformCache.inGameTime, data.time.j2000Seconds());
 
-    glm::dmat4 modelTransform =
-        glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
-        glm::dmat4(data.modelTransform.rotation) *
-        glm::scale(glm::dmat4(1.0), glm::dvec3(data.modelTransform.scale));
-
     _programObject->setUniform(
         _uniformCache.modelView,
         data.camera.combinedViewMatrix() * modelTransform
@@ -304,12 +391,12 @@ void RenderableOrbitalKepler::render(const RenderData& data, RendererTasks&) {
 }
 
 void RenderableOrbitalKepler::updateBuffers() {
-    std::vector<kepler::Parameters> parameters = kepler::readFile(
-       _path.value(),
-        _format
-    );
+    if (_parametersAreDirty) {
+        _parameters = kepler::readFile(_path.value(), _format);
+        _parametersAreDirty = false;
+    }
 
-    _numObjects = parameters.size();
+    _numObjects = _parameters.size();
 
     if (_startRenderIdx >= _numObjects) {
         throw ghoul::RuntimeError(fmt::format(
@@ -331,34 +418,68 @@ void RenderableOrbitalKepler::updateBuffers() {
         _sizeRender = static_cast<unsigned int>(_numObjects);
     }
 
+    std::vector<kepler::Parameters> parameters;
     if (_contiguousMode) {
-        if (_startRenderIdx >= parameters.size() ||
-            (_startRenderIdx + _sizeRender) >= parameters.size())
+        if (_startRenderIdx >= _parameters.size() ||
+            (_startRenderIdx + _sizeRender) >= _parameters.size())
         {
             throw ghoul::RuntimeError(fmt::format(
                 "Tried to load {} objects but only {} are available",
-                _startRenderIdx + _sizeRender, parameters.size()
+                _startRenderIdx + _sizeRender, _parameters.size()
             ));
         }
 
         // Extract subset that starts at _startRenderIdx and contains _sizeRender obejcts
         parameters = std::vector<kepler::Parameters>(
-            parameters.begin() + _startRenderIdx,
-            parameters.begin() + _startRenderIdx + _sizeRender
+            _parameters.begin() + _startRenderIdx,
+            _parameters.begin() + _startRenderIdx + _sizeRender
         );
     }
     else {
-        // First shuffle the whole array
+        // First shuffle the indices of the whole array. This results in the same
+        // permutation as shuffling the objects themselves, but doesn't copy all of them
+        std::vector<size_t> indices(_parameters.size());
+        std::iota(indices.begin(), indices.end(), size_t(0));
         std::default_random_engine rng;
-        std::shuffle(parameters.begin(), parameters.end(), rng);
+        std::shuffle(indices.begin(), indices.end(), rng);
 
         // Then take the first _sizeRender values
-        parameters = std::vector<kepler::Parameters>(
-            parameters.begin(),
-            parameters.begin() + _sizeRender
-        );
+        const size_t nObjects = std::min<size_t>(_sizeRender, indices.size());
+        parameters.reserve(nObjects);
+        for (size_t i = 0; i < nObjects; i++) {
+            parameters.push_back(_parameters[indices[i]]);
+        }
+    }
+
+    // Validate the orbits up front in the same way as KeplerTranslation does, as the
+    // tessellation below runs on multiple threads
+    for (const kepler::Parameters& orbit : parameters) {
+        if (orbit.eccentricity < 0.0 || orbit.eccentricity > 1.0) {
+            throw KeplerTranslation::RangeError("Eccentricity");
+        }
+        if (orbit.inclination < 0.0 || orbit.inclination > 360.0) {
+            throw KeplerTranslation::RangeError("Inclination");
+        }
     }
 
+    double maxSemiMajorAxis = 0.0;
+    for (const kepler::Parameters& kp : parameters) {
+        if (kp.semiMajorAxis > maxSemiMajorAxis) {
+            maxSemiMajorAxis = kp.semiMajorAxis;
+        }
+    }
+    setBoundingSphere(maxSemiMajorAxis * 1000);
+
+    if (_evaluateOnGpu) {
+        // Free the memory of the tessellated orbits, they are not needed anymore
+        _vertexBufferData = std::vector<TrailVBOLayout>();
+        _segmentSize.clear();
+        _startIndex.clear();
+        updateGpuBuffers(parameters);
+        return;
+    }
+    _nGpuOrbits = 0;
+
     _segmentSize.clear();
     _startIndex.clear();
     _startIndex.push_back(0);
@@ -380,42 +501,79 @@ void RenderableOrbitalKepler::updateBuffers() {
     }
     _vertexBufferData.resize(nVerticesTotal);
 
-    size_t vertexBufIdx = 0;
-    KeplerTranslation keplerTranslator;
-    for (int orbitIdx = 0; orbitIdx < numOrbits; ++orbitIdx) {
-        const kepler::Parameters& orbit = parameters[orbitIdx];
-
-        keplerTranslator.setKeplerElements(
-            orbit.eccentricity,
-            orbit.semiMajorAxis,
-            orbit.inclination,
-            orbit.ascendingNode,
-            orbit.argumentOfPeriapsis,
-            orbit.meanAnomaly,
-            orbit.period,
-            orbit.epoch
-        );
-
-        for (size_t j = 0 ; j < (_segmentSize[orbitIdx] + 1); ++j) {
-            double timeOffset = orbit.period *
-                static_cast<double>(j) / static_cast<double>(_segmentSize[orbitIdx]);
-
-            glm::dvec3 position = keplerTranslator.position({
-                {},
-                Time(timeOffset + orbit.epoch),
-                Time(0.0)
-            });
-
-            _vertexBufferData[vertexBufIdx].x = static_cast<float>(position.x);
-            _vertexBufferData[vertexBufIdx].y = static_cast<float>(position.y);
-            _vertexBufferData[vertexBufIdx].z = static_cast<float>(position.z);
-            _vertexBufferData[vertexBufIdx].time = static_cast<float>(timeOffset);
-            _vertexBufferData[vertexBufIdx].epoch = orbit.epoch;
-            _vertexBufferData[vertexBufIdx].period = orbit.period;
+    // The index of the first vertex of each orbit
+    std::vector<size_t> vertexOffsets(numOrbits);
+    for (int i = 1; i < numOrbits; ++i) {
+        vertexOffsets[i] = vertexOffsets[i - 1] + _segmentSize[i - 1] + 1;
+    }
 
-            vertexBufIdx++;
+    auto tessellateOrbits = [&](size_t begin, size_t end) {
+        std::vector<double> meanAnomalies;
+        std::vector<double> eccentricAnomalies;
+        for (size_t orbitIdx = begin; orbitIdx < end; ++orbitIdx) {
+            const kepler::Parameters& orbit = parameters[orbitIdx];
+            const size_t nSegments = _segmentSize[orbitIdx];
+            const size_t nVertices = nSegments + 1;
+
+            // Computes the same values as KeplerTranslation::position, but solves the
+            // Kepler equation for all vertices of the orbit at once
+            const glm::dmat3 rotation = kepler::orbitPlaneRotation(
+                orbit.inclination,
+                orbit.ascendingNode,
+                orbit.argumentOfPeriapsis
+            );
+            const double meanMotion = glm::two_pi<double>() / orbit.period;
+            const double meanAnomalyAtEpoch = glm::radians(orbit.meanAnomaly);
+
+            meanAnomalies.resize(nVertices);
+            eccentricAnomalies.resize(nVertices);
+            for (size_t j = 0; j < nVertices; ++j) {
+                const double timeOffset = orbit.period *
+                    static_cast<double>(j) / static_cast<double>(nSegments);
+                // Going through the absolute time keeps the rounding identical to the
+                // evaluation at Time(timeOffset + epoch)
+                const double t = (timeOffset + orbit.epoch) - orbit.epoch;
+                meanAnomalies[j] = meanAnomalyAtEpoch + t * meanMotion;
+            }
+            kepler::eccentricAnomalies(
+                orbit.eccentricity,
+                meanAnomalies,
+                eccentricAnomalies
+            );
+
+            const double semiMajorAxis = orbit.semiMajorAxis * 1000.0;
+            const double ecc = orbit.eccentricity;
+            const double minorAxisFactor = std::sqrt(1.0 - ecc * ecc);
+            for (size_t j = 0; j < nVertices; ++j) {
+                const double timeOffset = orbit.period *
+                    static_cast<double>(j) / static_cast<double>(nSegments);
+
+                const double e = eccentricAnomalies[j];
+                const glm::dvec3 position = rotation * glm::dvec3(
+                    semiMajorAxis * (std::cos(e) - ecc),
+                    semiMajorAxis * std::sin(e) * minorAxisFactor,
+                    0.0
+                );
+
+                TrailVBOLayout& vertex = _vertexBufferData[vertexOffsets[orbitIdx] + j];
+                vertex.x = static_cast<float>(position.x);
+                vertex.y = static_cast<float>(position.y);
+                vertex.z = static_cast<float>(position.z);
+                vertex.time = static_cast<float>(timeOffset);
+                vertex.epoch = orbit.epoch;
+                vertex.period = orbit.period;
+            }
         }
-    }
+    };
+
+    // The orbits are independent, so they are split among the threads
+    constexpr size_t OrbitsPerTask = 64;
+    global::openSpaceEngine->threadPool().parallelFor(
+        0,
+        parameters.size(),
+        OrbitsPerTask,
+        tessellateOrbits
+    );
 
     glBindVertexArray(_vertexArray);
 
@@ -441,14 +599,135 @@ void RenderableOrbitalKepler::updateBuffers() {
     );
 
     glBindVertexArray(0);
+}
 
-    double maxSemiMajorAxis = 0.0;
-    for (const kepler::Parameters& kp : parameters) {
-        if (kp.semiMajorAxis > maxSemiMajorAxis) {
-            maxSemiMajorAxis = kp.semiMajorAxis;
-        }
+void RenderableOrbitalKepler::updateGpuBuffers(
+                                        const std::vector<kepler::Parameters>& parameters)
+{
+    std::vector<GpuOrbitLayout> orbits;
+    orbits.reserve(parameters.size());
+    for (const kepler::Parameters& p : parameters) {
+        GpuOrbitLayout orbit;
+        orbit.eccentricity = static_cast<float>(p.eccentricity);
+        orbit.semiMajorAxis = static_cast<float>(p.semiMajorAxis * 1000.0);
+        // Solving the Kepler equation once for the epoch means that the vertices of the
+        // orbit can be placed directly in eccentric anomaly
+        orbit.eccentricAnomalyAtEpoch = static_cast<float>(
+            kepler::eccentricAnomaly(p.eccentricity, glm::radians(p.meanAnomaly))
+        );
+        orbit.epoch = p.epoch;
+        orbit.period = p.period;
+
+        const glm::mat3 rotation = glm::mat3(kepler::orbitPlaneRotation(
+            p.inclination,
+            p.ascendingNode,
+            p.argumentOfPeriapsis
+        ));
+        std::memcpy(
+            orbit.orbitPlaneRotation.data(),
+            glm::value_ptr(rotation),
+            sizeof(orbit.orbitPlaneRotation)
+        );
+        orbits.push_back(orbit);
     }
-    setBoundingSphere(maxSemiMajorAxis * 1000);
+    _nGpuOrbits = orbits.size();
+
+    glBindVertexArray(_gpuVertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, _gpuVertexBuffer);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        orbits.size() * sizeof(GpuOrbitLayout),
+        orbits.data(),
+        GL_STATIC_DRAW
+    );
+
+    // All attributes advance once per object
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(GpuOrbitLayout), nullptr);
+    glVertexAttribDivisor(0, 1);
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1,
+        2,
+        GL_DOUBLE,
+        GL_FALSE,
+        sizeof(GpuOrbitLayout),
+        reinterpret_cast<GLvoid*>(offsetof(GpuOrbitLayout, epoch))
+    );
+    glVertexAttribDivisor(1, 1);
+
+    // The rotation matrix occupies one attribute location per column
+    for (GLuint i = 0; i < 3; ++i) {
+        glEnableVertexAttribArray(2 + i);
+        glVertexAttribPointer(
+            2 + i,
+            3,
+            GL_FLOAT,
+            GL_FALSE,
+            sizeof(GpuOrbitLayout),
+            reinterpret_cast<GLvoid*>(
+                offsetof(GpuOrbitLayout, orbitPlaneRotation) + i * 3 * sizeof(float)
+            )
+        );
+        glVertexAttribDivisor(2 + i, 1);
+    }
+
+    glBindVertexArray(0);
+}
+
+void RenderableOrbitalKepler::renderGpuOrbits(const RenderData& data,
+                                              const glm::dmat4& modelTransform)
+{
+    if (_nGpuOrbits == 0) {
+        return;
+    }
+
+    _gpuProgramObject->activate();
+    _gpuProgramObject->setUniform(_gpuUniformCache.opacity, opacity());
+    _gpuProgramObject->setUniform(
+        _gpuUniformCache.inGameTime,
+        data.time.j2000Seconds()
+    );
+    _gpuProgramObject->setUniform(
+        _gpuUniformCache.modelView,
+        data.camera.combinedViewMatrix() * modelTransform
+    );
+
+    // Because we want the property to work similar to the planet trails
+    const float fade = pow(_appearance.lineFade.maxValue() - _appearance.lineFade, 2.f);
+
+    _gpuProgramObject->setUniform(
+        _gpuUniformCache.projection,
+        data.camera.projectionMatrix()
+    );
+    _gpuProgramObject->setUniform(_gpuUniformCache.color, _appearance.lineColor);
+    _gpuProgramObject->setUniform(_gpuUniformCache.lineFade, fade);
+
+    // Corresponds to the number of segments of a circular orbit in the tessellated mode
+    const GLsizei nSegments = static_cast<GLsizei>(_segmentQuality) * 20;
+    _gpuProgramObject->setUniform(_gpuUniformCache.numberOfSegments, nSegments);
+
+    glBindVertexArray(_gpuVertexArray);
+
+    _gpuProgramObject->setUniform(_gpuUniformCache.renderPositions, false);
+    glLineWidth(_appearance.lineWidth);
+    glDrawArraysInstanced(
+        GL_LINE_STRIP,
+        0,
+        nSegments + 1,
+        static_cast<GLsizei>(_nGpuOrbits)
+    );
+
+    if (_showPositions) {
+        _gpuProgramObject->setUniform(_gpuUniformCache.renderPositions, true);
+        glPointSize(static_cast<float>(_appearance.pointSize));
+        glDrawArraysInstanced(GL_POINTS, 0, 1, static_cast<GLsizei>(_nGpuOrbits));
+    }
+
+    glBindVertexArray(0);
+    _gpuProgramObject->deactivate();
 }
 
+
 } // namespace opensapce
@@ -31,10 +31,12 @@
 #include <modules/space/kepler.h>
 #include <modules/space/translation/keplertranslation.h>
 #include <openspace/properties/stringproperty.h>
+#include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/uintproperty.h>
 #include <ghoul/glm.h>
 #include <ghoul/misc/objectmanager.h>
 #include <ghoul/opengl/programobject.h>
+#include <array>
 
 namespace openspace {
 
@@ -55,8 +57,13 @@ public:
 
 private:
     void updateBuffers();
+    void updateGpuBuffers(const std::vector<kepler::Parameters>& parameters);
+    void renderGpuOrbits(const RenderData& data, const glm::dmat4& modelTransform);
 
     bool _updateDataBuffersAtNextRender = false;
+    /// All objects of the file, kept so that a new subset does not load the file again
+    std::vector<kepler::Parameters> _parameters;
+    bool _parametersAreDirty = true;
     std::streamoff _numObjects;
     std::vector<GLint> _segmentSize;
     std::vector<GLint> _startIndex;
@@ -80,9 +87,29 @@ private:
     GLuint _vertexArray;
     GLuint _vertexBuffer;
 
+    /// The layout of the VBO when the orbits are evaluated on the GPU, one per object
+    struct GpuOrbitLayout {
+        float eccentricity = 0.f;
+        float semiMajorAxis = 0.f;
+        float eccentricAnomalyAtEpoch = 0.f;
+        float padding = 0.f;
+        double epoch = 0.0;
+        double period = 0.0;
+        std::array<float, 9> orbitPlaneRotation = {};
+    };
+
+    size_t _nGpuOrbits = 0;
+    GLuint _gpuVertexArray = 0;
+    GLuint _gpuVertexBuffer = 0;
+    ghoul::opengl::ProgramObject* _gpuProgramObject = nullptr;
+    UniformCache(modelView, projection, lineFade, inGameTime, color, opacity,
+        numberOfSegments, renderPositions) _gpuUniformCache;
+
     ghoul::opengl::ProgramObject* _programObject;
     properties::StringProperty _path;
     properties::BoolProperty _contiguousMode;
+    properties::BoolProperty _evaluateOnGpu;
+    properties::BoolProperty _showPositions;
     kepler::Format _format;
     RenderableTrail::Appearance _appearance;
 
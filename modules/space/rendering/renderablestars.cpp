@@ -28,6 +28,7 @@
 #include <openspace/documentation/verifier.h>
 #include <openspace/util/updatestructures.h>
 #include <openspace/util/distanceconstants.h>
+#include <openspace/util/memorymanager.h>
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/engine/globals.h>
 #include <openspace/rendering/renderengine.h>
@@ -45,6 +46,8 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory_resource>
+#include <span>
 #include <type_traits>
 
 namespace {
@@ -80,7 +83,6 @@ namespace {
     constexpr double PARSEC = 0.308567756E17;
 
     struct ColorVBOLayout {
-        std::array<float, 3> position;
         float value;
         float luminance;
         float absoluteMagnitude;
@@ -88,7 +90,6 @@ namespace {
     };
 
     struct VelocityVBOLayout {
-        std::array<float, 3> position;
         float value;
         float luminance;
         float absoluteMagnitude;
@@ -100,7 +101,6 @@ namespace {
     };
 
     struct SpeedVBOLayout {
-        std::array<float, 3> position;
         float value;
         float luminance;
         float absoluteMagnitude;
@@ -110,7 +110,6 @@ namespace {
     };
 
     struct OtherDataLayout {
-        std::array<float, 3> position;
         float value;
         float luminance;
         float absoluteMagnitude;
@@ -883,6 +882,8 @@ void RenderableStars::initializeGL() {
 }
 
 void RenderableStars::deinitializeGL() {
+    glDeleteBuffers(1, &_positionVbo);
+    _positionVbo = 0;
     glDeleteBuffers(1, &_vbo);
     _vbo = 0;
     glDeleteVertexArrays(1, &_vao);
@@ -1030,7 +1031,7 @@ void RenderableStars::renderPSFToTexture() {
 }
 
 void RenderableStars::render(const RenderData& data, RendererTasks&) {
-    if (_dataset.entries.empty()) {
+    if (_dataset.empty()) {
         return;
     }
 
@@ -1130,7 +1131,7 @@ void RenderableStars::render(const RenderData& data, RendererTasks&) {
 
 
     glBindVertexArray(_vao);
-    const GLsizei nStars = static_cast<GLsizei>(_dataset.entries.size());
+    const GLsizei nStars = static_cast<GLsizei>(_dataset.size());
     glDrawArrays(GL_POINTS, 0, nStars);
 
     glBindVertexArray(0);
@@ -1145,22 +1146,50 @@ void RenderableStars::update(const UpdateData&) {
     if (_speckFileIsDirty) {
         loadData();
         _speckFileIsDirty = false;
+        _positionDataIsDirty = true;
         _dataIsDirty = true;
     }
 
-    if (_dataset.entries.empty()) {
+    if (_dataset.empty()) {
         return;
     }
 
-    if (_dataIsDirty) {
-        const int value = _colorOption;
-        LDEBUG("Regenerating data");
+    if (_positionDataIsDirty) {
+        LDEBUG("Regenerating positions");
 
-        std::vector<float> slice = createDataSlice(ColorOption(value));
+        std::pmr::vector<float> slice = createPositionSlice();
 
         if (_vao == 0) {
             glGenVertexArrays(1, &_vao);
         }
+        if (_positionVbo == 0) {
+            glGenBuffers(1, &_positionVbo);
+        }
+        glBindVertexArray(_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, _positionVbo);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            slice.size() * sizeof(GLfloat),
+            slice.data(),
+            GL_STATIC_DRAW
+        );
+
+        GLint positionAttrib = _program->attributeLocation("in_position");
+        glEnableVertexAttribArray(positionAttrib);
+        glVertexAttribPointer(positionAttrib, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+
+        _positionDataIsDirty = false;
+    }
+
+    if (_dataIsDirty) {
+        const int value = _colorOption;
+        LDEBUG("Regenerating data");
+
+        std::pmr::vector<float> slice = createDataSlice(ColorOption(value));
+
         if (_vbo == 0) {
             glGenBuffers(1, &_vbo);
         }
@@ -1173,31 +1202,21 @@ void RenderableStars::update(const UpdateData&) {
             GL_STATIC_DRAW
         );
 
-        GLint positionAttrib = _program->attributeLocation("in_position");
         // bvLumAbsMagAppMag = bv color, luminosity, abs magnitude and app magnitude
         GLint bvLumAbsMagAppMagAttrib = _program->attributeLocation(
             "in_bvLumAbsMagAppMag"
         );
 
-        const size_t nStars = _dataset.entries.size();
+        const size_t nStars = _dataset.size();
         const size_t nValues = slice.size() / nStars;
 
         GLsizei stride = static_cast<GLsizei>(sizeof(GLfloat) * nValues);
 
-        glEnableVertexAttribArray(positionAttrib);
         glEnableVertexAttribArray(bvLumAbsMagAppMagAttrib);
         const int colorOption = _colorOption;
         switch (colorOption) {
             case ColorOption::Color:
             case ColorOption::FixedColor:
-                glVertexAttribPointer(
-                    positionAttrib,
-                    3,
-                    GL_FLOAT,
-                    GL_FALSE,
-                    stride,
-                    nullptr // = offsetof(ColorVBOLayout, position)
-                );
                 glVertexAttribPointer(
                     bvLumAbsMagAppMagAttrib,
                     4,
@@ -1210,14 +1229,6 @@ void RenderableStars::update(const UpdateData&) {
                 break;
             case ColorOption::Velocity:
             {
-                glVertexAttribPointer(
-                    positionAttrib,
-                    3,
-                    GL_FLOAT,
-                    GL_FALSE,
-                    stride,
-                    nullptr // = offsetof(VelocityVBOLayout, position)
-                );
                 glVertexAttribPointer(
                     bvLumAbsMagAppMagAttrib,
                     4,
@@ -1242,14 +1253,6 @@ void RenderableStars::update(const UpdateData&) {
             }
             case ColorOption::Speed:
             {
-                glVertexAttribPointer(
-                    positionAttrib,
-                    3,
-                    GL_FLOAT,
-                    GL_FALSE,
-                    stride,
-                    nullptr // = offsetof(SpeedVBOLayout, position)
-                );
                 glVertexAttribPointer(
                     bvLumAbsMagAppMagAttrib,
                     4,
@@ -1273,14 +1276,6 @@ void RenderableStars::update(const UpdateData&) {
             }
             case ColorOption::OtherData:
             {
-                glVertexAttribPointer(
-                    positionAttrib,
-                    3,
-                    GL_FLOAT,
-                    GL_FALSE,
-                    stride,
-                    nullptr // = offsetof(OtherDataLayout, position)
-                );
                 glVertexAttribPointer(
                     bvLumAbsMagAppMagAttrib,
                     4,
@@ -1352,6 +1347,17 @@ void RenderableStars::update(const UpdateData&) {
     }
 }
 
+Renderable::MemoryUsage RenderableStars::memoryUsage() const {
+    MemoryUsage usage;
+    usage.gpuBuffers = bufferMemory(_positionVbo) + bufferMemory(_vbo) +
+        bufferMemory(_psfVbo);
+    usage.gpuTextures = textureMemory(_colorTexture.get()) +
+        textureMemory(_otherDataColorMapTexture.get()) +
+        textureMemory(_pointSpreadFunctionTexture.get());
+    usage.cpuData = _dataset.memoryUsage();
+    return usage;
+}
+
 void RenderableStars::loadData() {
     std::filesystem::path file = absPath(_speckFile);
     if (!std::filesystem::is_regular_file(file)) {
@@ -1359,7 +1365,7 @@ void RenderableStars::loadData() {
     }
 
     _dataset = speck::data::loadFileWithCache(file);
-    if (_dataset.entries.empty()) {
+    if (_dataset.empty()) {
         return;
     }
 
@@ -1376,7 +1382,26 @@ void RenderableStars::loadData() {
     }
 }
 
-std::vector<float> RenderableStars::createDataSlice(ColorOption option) {
+std::pmr::vector<float> RenderableStars::createPositionSlice() {
+    // The slice is only needed until it has been uploaded to the GPU
+    std::pmr::vector<float> result(&global::memoryManager->TemporaryMemory);
+    result.reserve(_dataset.size() * 3);
+
+    double maxRadius = 0.0;
+    for (const glm::vec3& p : _dataset.positions) {
+        const glm::dvec3 position = glm::dvec3(p) * distanceconstants::Parsec;
+        maxRadius = std::max(maxRadius, glm::length(position));
+
+        result.push_back(static_cast<float>(position.x));
+        result.push_back(static_cast<float>(position.y));
+        result.push_back(static_cast<float>(position.z));
+    }
+
+    setBoundingSphere(maxRadius);
+    return result;
+}
+
+std::pmr::vector<float> RenderableStars::createDataSlice(ColorOption option) {
     const int bvIdx = std::max(_dataset.index(_dataMapping.bvColor.value()), 0);
     const int lumIdx = std::max(_dataset.index(_dataMapping.luminance.value()), 0);
     const int absMagIdx = std::max(
@@ -1397,15 +1422,25 @@ std::vector<float> RenderableStars::createDataSlice(ColorOption option) {
         -std::numeric_limits<float>::max()
     );
 
-    double maxRadius = 0.0;
-
-    std::vector<float> result;
-    // 7 for the default Color option of 3 positions + bv + lum + abs + app magnitude
-    result.reserve(_dataset.entries.size() * 7);
-    for (const speck::Dataset::Entry& e : _dataset.entries) {
-        glm::dvec3 position = glm::dvec3(e.position) * distanceconstants::Parsec;
-        maxRadius = std::max(maxRadius, glm::length(position));
+    // Every data value is stored contiguously, so each of them is read as a linear
+    // stream while the slice is interleaved
+    const std::span<const float> bv = _dataset.variable(bvIdx);
+    const std::span<const float> lum = _dataset.variable(lumIdx);
+    const std::span<const float> absMag = _dataset.variable(absMagIdx);
+    const std::span<const float> appMag = _dataset.variable(appMagIdx);
+    const std::span<const float> vx = _dataset.variable(vxIdx);
+    const std::span<const float> vy = _dataset.variable(vyIdx);
+    const std::span<const float> vz = _dataset.variable(vzIdx);
+    const std::span<const float> speed = _dataset.variable(speedIdx);
+    const std::span<const float> otherData = _dataset.variable(
+        _otherDataOption.value()
+    );
 
+    // The slice is only needed until it has been uploaded to the GPU
+    std::pmr::vector<float> result(&global::memoryManager->TemporaryMemory);
+    // 4 for the default Color option of bv + lum + abs + app magnitude
+    result.reserve(_dataset.size() * 4);
+    for (size_t i = 0; i < _dataset.size(); i++) {
         switch (option) {
             case ColorOption::Color:
             case ColorOption::FixedColor:
@@ -1415,16 +1450,10 @@ std::vector<float> RenderableStars::createDataSlice(ColorOption option) {
                     std::array<float, sizeof(ColorVBOLayout) / sizeof(float)> data;
                 } layout;
 
-                layout.value.position = { {
-                    static_cast<float>(position[0]),
-                    static_cast<float>(position[1]),
-                    static_cast<float>(position[2])
-                }};
-
-                layout.value.value = e.data[bvIdx];
-                layout.value.luminance = e.data[lumIdx];
-                layout.value.absoluteMagnitude = e.data[absMagIdx];
-                layout.value.apparentMagnitude = e.data[appMagIdx];
+                layout.value.value = bv[i];
+                layout.value.luminance = lum[i];
+                layout.value.absoluteMagnitude = absMag[i];
+                layout.value.apparentMagnitude = appMag[i];
 
                 result.insert(result.end(), layout.data.begin(), layout.data.end());
                 break;
@@ -1436,20 +1465,14 @@ std::vector<float> RenderableStars::createDataSlice(ColorOption option) {
                     std::array<float, sizeof(VelocityVBOLayout) / sizeof(float)> data;
                 } layout;
 
-                layout.value.position = {{
-                    static_cast<float>(position[0]),
-                    static_cast<float>(position[1]),
-                    static_cast<float>(position[2])
-                }};
-
-                layout.value.value = e.data[bvIdx];
-                layout.value.luminance = e.data[lumIdx];
-                layout.value.absoluteMagnitude = e.data[absMagIdx];
-                layout.value.apparentMagnitude = e.data[appMagIdx];
+                layout.value.value = bv[i];
+                layout.value.luminance = lum[i];
+                layout.value.absoluteMagnitude = absMag[i];
+                layout.value.apparentMagnitude = appMag[i];
 
-                layout.value.vx = e.data[vxIdx];
-                layout.value.vy = e.data[vyIdx];
-                layout.value.vz = e.data[vzIdx];
+                layout.value.vx = vx[i];
+                layout.value.vy = vy[i];
+                layout.value.vz = vz[i];
 
                 result.insert(result.end(), layout.data.begin(), layout.data.end());
                 break;
@@ -1461,17 +1484,11 @@ std::vector<float> RenderableStars::createDataSlice(ColorOption option) {
                     std::array<float, sizeof(SpeedVBOLayout) / sizeof(float)> data;
                 } layout;
 
-                layout.value.position = {{
-                    static_cast<float>(position[0]),
-                    static_cast<float>(position[1]),
-                    static_cast<float>(position[2])
-                }};
-
-                layout.value.value = e.data[bvIdx];
-                layout.value.luminance = e.data[lumIdx];
-                layout.value.absoluteMagnitude = e.data[absMagIdx];
-                layout.value.apparentMagnitude = e.data[appMagIdx];
-                layout.value.speed = e.data[speedIdx];
+                layout.value.value = bv[i];
+                layout.value.luminance = lum[i];
+                layout.value.absoluteMagnitude = absMag[i];
+                layout.value.apparentMagnitude = appMag[i];
+                layout.value.speed = speed[i];
 
                 result.insert(result.end(), layout.data.begin(), layout.data.end());
                 break;
@@ -1480,20 +1497,13 @@ std::vector<float> RenderableStars::createDataSlice(ColorOption option) {
             {
                 union {
                     OtherDataLayout value;
-                    std::array<float, sizeof(OtherDataLayout)> data;
+                    std::array<float, sizeof(OtherDataLayout) / sizeof(float)> data;
                 } layout = {};
 
-                layout.value.position = {{
-                    static_cast<float>(position[0]),
-                    static_cast<float>(position[1]),
-                    static_cast<float>(position[2])
-                }};
-
-                int index = _otherDataOption.value();
-                // plus 3 because of the position
-                layout.value.value = e.data[index];
+                layout.value.value = otherData[i];
 
-                if (_staticFilterValue.has_value() && e.data[index] == _staticFilterValue)
+                if (_staticFilterValue.has_value() &&
+                    otherData[i] == _staticFilterValue)
                 {
                     layout.value.value = _staticFilterReplacementValue;
                 }
@@ -1505,17 +1515,15 @@ std::vector<float> RenderableStars::createDataSlice(ColorOption option) {
                 _otherDataRange.setMinValue(glm::vec2(range.x));
                 _otherDataRange.setMaxValue(glm::vec2(range.y));
 
-                layout.value.luminance = e.data[lumIdx];
-                layout.value.absoluteMagnitude = e.data[absMagIdx];
-                layout.value.apparentMagnitude = e.data[appMagIdx];
+                layout.value.luminance = lum[i];
+                layout.value.absoluteMagnitude = absMag[i];
+                layout.value.apparentMagnitude = appMag[i];
 
                 result.insert(result.end(), layout.data.begin(), layout.data.end());
                 break;
             }
         }
     }
-
-    setBoundingSphere(maxRadius);
     return result;
 }
 
@@ -37,6 +37,7 @@
 #include <openspace/properties/vector/vec3property.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <memory_resource>
 #include <optional>
 
 namespace ghoul::filesystem { class File; }
@@ -64,6 +65,8 @@ public:
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
 
+    MemoryUsage memoryUsage() const override;
+
     static documentation::Documentation Documentation();
 
 private:
@@ -76,7 +79,8 @@ private:
     };
 
     void loadData();
-    std::vector<float> createDataSlice(ColorOption option);
+    std::pmr::vector<float> createPositionSlice();
+    std::pmr::vector<float> createDataSlice(ColorOption option);
 
     properties::StringProperty _speckFile;
 
@@ -140,6 +144,7 @@ private:
     bool _pointSpreadFunctionTextureIsDirty = true;
     bool _colorTextureIsDirty = true;
     //bool _shapeTextureIsDirty = true;
+    bool _positionDataIsDirty = true;
     bool _dataIsDirty = true;
     bool _otherDataColorMapIsDirty = true;
 
@@ -151,6 +156,9 @@ private:
     float _staticFilterReplacementValue = 0.f;
 
     GLuint _vao = 0;
+    // The positions are stored separately from the other values so that changing the
+    // color option or the data mapping doesn't upload the positions again
+    GLuint _positionVbo = 0;
     GLuint _vbo = 0;
     GLuint _psfVao = 0;
     GLuint _psfVbo = 0;
@@ -115,7 +115,7 @@ documentation::Documentation RenderableTravelSpeed::Documentation() {
 }
 
 RenderableTravelSpeed::RenderableTravelSpeed(const ghoul::Dictionary& dictionary)
-    : Renderable(dictionary)
+    : Renderable(dictionary, { .hasThreadSafeUpdate = true })
     , _targetName(TargetInfo)
     , _travelSpeed(
         SpeedInfo,
@@ -238,8 +238,6 @@ void RenderableTravelSpeed::calculateVerticesPositions() {
 }
 
 void RenderableTravelSpeed::updateVertexData() {
-    calculateVerticesPositions();
-
     glBindVertexArray(_vaoId);
     glBindBuffer(GL_ARRAY_BUFFER, _vBufferId);
     glBufferData(
@@ -283,14 +281,14 @@ void RenderableTravelSpeed::update(const UpdateData& data) {
     if (_initiationTime < currentTime && _arrivalTime > currentTime) {
         _timeSinceStart = currentTime - _initiationTime;
         calculateDirectionVector();
-        updateVertexData();
+        // The vertex positions are uploaded in the render function so that this
+        // function does not touch any OpenGL state and can run on a worker thread
+        calculateVerticesPositions();
+        _vertexDataIsDirty = true;
     }
     else { // in case we've reached the target
         reinitiateTravel();
     }
-
-    _shaderProgram->setUniform("lineColor", _lineColor);
-    _shaderProgram->setUniform("opacity", opacity());
 }
 
 void RenderableTravelSpeed::render(const RenderData& data, RendererTasks&) {
@@ -309,6 +307,13 @@ void RenderableTravelSpeed::render(const RenderData& data, RendererTasks&) {
 
     _shaderProgram->setUniform("modelViewTransform", glm::mat4(modelViewTransform));
     _shaderProgram->setUniform("projectionTransform", data.camera.projectionMatrix());
+    _shaderProgram->setUniform("lineColor", _lineColor);
+    _shaderProgram->setUniform("opacity", opacity());
+
+    if (_vertexDataIsDirty) {
+        updateVertexData();
+        _vertexDataIsDirty = false;
+    }
 
 #ifndef __APPLE__
     glLineWidth(_lineWidth);
@@ -74,6 +74,7 @@ private:
         glm::vec3 headOfLight;
     };
     VertexPositions _vertexPositions;
+    bool _vertexDataIsDirty = false;
 
     glm::dvec3 _sourcePosition;
     glm::dvec3 _targetPosition;
@@ -29,6 +29,9 @@
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/time.h>
 #include <openspace/util/updatestructures.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/logging/logmanager.h>
+#include <glm/gtx/orthonormalize.hpp>
 #include <optional>
 
 namespace {
@@ -81,6 +84,12 @@ namespace {
         // [[codegen::verbatim(FixedDateInfo.description)]]
         std::optional<std::string> fixedDate
             [[codegen::annotation("A time to lock the rotation to")]];
+
+        // An ephemeris table created by the GenerateEphemerisTableTask for the same
+        // source and destination frames. Within the time window of the table, the
+        // rotation is evaluated from the table, which allows this rotation to be updated
+        // on a worker thread. Outside of the window, SPICE is used as usual
+        std::optional<std::filesystem::path> ephemerisTable;
     };
 #include "spicerotation_codegen.cpp"
 } // namespace
@@ -136,9 +145,41 @@ SpiceRotation::SpiceRotation(const ghoul::Dictionary& dictionary)
     addProperty(_sourceFrame);
     addProperty(_destinationFrame);
 
-    _sourceFrame.onChange([this]() { requireUpdate(); });
-    _destinationFrame.onChange([this]() { requireUpdate(); });
+    if (p.ephemerisTable.has_value()) {
+        _ephemerisTable = EphemerisTable::load(absPath(p.ephemerisTable->string()));
+        if (_ephemerisTable->nComponents() != 9) {
+            throw ghoul::RuntimeError(fmt::format(
+                "Ephemeris table {} does not contain rotations", *p.ephemerisTable
+            ));
+        }
+    }
+    auto updateUseEphemerisTable = [this]() {
+        _useEphemerisTable = _ephemerisTable.has_value() &&
+            _ephemerisTable->identifiers() ==
+            std::vector<std::string>{ _sourceFrame.value(), _destinationFrame.value() };
+    };
+    updateUseEphemerisTable();
+    if (_ephemerisTable.has_value() && !_useEphemerisTable) {
+        LWARNINGC("SpiceRotation", fmt::format(
+            "Ephemeris table {} was created for different frames", *p.ephemerisTable
+        ));
+    }
+
+    _sourceFrame.onChange([this, updateUseEphemerisTable]() {
+        updateUseEphemerisTable();
+        requireUpdate();
+    });
+    _destinationFrame.onChange([this, updateUseEphemerisTable]() {
+        updateUseEphemerisTable();
+        requireUpdate();
+    });
+}
 
+bool SpiceRotation::isThreadSafe() const {
+    // CSPICE is not reentrant, so all calls into it have to happen on the main thread.
+    // With an ephemeris table, the calls into CSPICE outside of its window are
+    // serialized instead
+    return _ephemerisTable.has_value();
 }
 
 glm::dmat3 SpiceRotation::matrix(const UpdateData& data) const {
@@ -149,6 +190,19 @@ glm::dmat3 SpiceRotation::matrix(const UpdateData& data) const {
     if (_fixedEphemerisTime.has_value()) {
         time = *_fixedEphemerisTime;
     }
+
+    if (_useEphemerisTable && _ephemerisTable->contains(time)) {
+        glm::dmat3 rotation = glm::dmat3(1.0);
+        _ephemerisTable->evaluate(time, std::span<double>(glm::value_ptr(rotation), 9));
+        // The interpolated matrix is not exactly orthonormal anymore
+        return glm::orthonormalize(rotation);
+    }
+
+    std::unique_lock<std::mutex> lock;
+    if (_ephemerisTable.has_value()) {
+        lock = std::unique_lock(cspiceFallbackMutex());
+    }
+
     return SpiceManager::ref().positionTransformMatrix(
         _sourceFrame,
         _destinationFrame,
@@ -27,6 +27,7 @@
 
 #include <openspace/scene/rotation.h>
 
+#include <modules/space/ephemeristable.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/scene/timeframe.h>
 #include <optional>
@@ -41,6 +42,7 @@ public:
 
     const glm::dmat3& matrix() const;
     glm::dmat3 matrix(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
 
     static documentation::Documentation Documentation();
 
@@ -51,6 +53,11 @@ private:
 
     ghoul::mm_unique_ptr<TimeFrame> _timeFrame;
     std::optional<double> _fixedEphemerisTime;
+
+    // A precomputed table that is used instead of SPICE within its time window. It is
+    // only used while it matches the current source and destination frames
+    std::optional<EphemerisTable> _ephemerisTable;
+    bool _useEphemerisTable = false;
 };
 
 } // namespace openspace
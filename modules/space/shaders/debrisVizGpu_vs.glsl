@@ -0,0 +1,100 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#version __CONTEXT__
+
+#include "PowerScaling/powerScalingMath.hglsl"
+
+// 1: eccentricity, 2: semi-major axis (m), 3: eccentric anomaly at epoch, 4: unused
+layout (location = 0) in vec4 orbitElements;
+layout (location = 1) in vec2 orbitData; // 1: epoch, 2: period
+layout (location = 2) in mat3 orbitPlaneRotation;
+
+out vec4 viewSpacePosition;
+out float viewSpaceDepth;
+out float periodFraction;
+out float offsetPeriods;
+
+uniform dmat4 modelViewTransform;
+uniform mat4 projectionTransform;
+uniform double inGameTime;
+uniform int numberOfSegments;
+uniform bool renderPositions;
+
+const float TwoPi = 6.28318530718;
+
+
+float meanAnomaly(float eccentricAnomaly, float eccentricity) {
+  return eccentricAnomaly - eccentricity * sin(eccentricAnomaly);
+}
+
+void main() {
+  float eccentricity = orbitElements.x;
+  float semiMajorAxis = orbitElements.y;
+  float eccentricAnomalyAtEpoch = orbitElements.z;
+
+  // If orbit_data is doubles, cast to float first
+  float epoch = orbitData.x;
+  float period = orbitData.y;
+
+  // Same as in debrisViz_vs.glsl; how far into the current revolution the object is
+  double nrOfRevolutions = (inGameTime - epoch) / period;
+  double frac = double(int(nrOfRevolutions));
+  double periodFractiond = nrOfRevolutions - frac;
+  if (periodFractiond < 0.0) {
+    periodFractiond += 1.0;
+  }
+  periodFraction = float(periodFractiond);
+
+  float meanAnomalyAtEpoch = meanAnomaly(eccentricAnomalyAtEpoch, eccentricity);
+
+  float e;
+  if (renderPositions) {
+    // Solve the Kepler equation for the current position of the object. The iteration
+    // count matches the worst case of the CPU solver for highly eccentric orbits
+    float m = meanAnomalyAtEpoch + TwoPi * periodFraction;
+    e = m + eccentricity * sin(m);
+    for (int i = 0; i < 8; i++) {
+      e -= (meanAnomaly(e, eccentricity) - m) / (1.0 - eccentricity * cos(e));
+    }
+    offsetPeriods = periodFraction;
+  }
+  else {
+    // The vertices are spaced evenly in eccentric anomaly, which needs no iteration and
+    // places more vertices close to the periapsis where the curvature is the largest
+    e = eccentricAnomalyAtEpoch + TwoPi * float(gl_VertexID) / float(numberOfSegments);
+    offsetPeriods = (meanAnomaly(e, eccentricity) - meanAnomalyAtEpoch) / TwoPi;
+  }
+
+  vec3 position = orbitPlaneRotation * vec3(
+    semiMajorAxis * (cos(e) - eccentricity),
+    semiMajorAxis * sin(e) * sqrt(1.0 - eccentricity * eccentricity),
+    0.0
+  );
+
+  viewSpacePosition = vec4(modelViewTransform * dvec4(position, 1.0));
+  vec4 vs_position = z_normalization(projectionTransform * viewSpacePosition);
+  gl_Position = vs_position;
+  viewSpaceDepth = vs_position.w;
+}
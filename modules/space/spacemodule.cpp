@@ -39,6 +39,7 @@
 #include <modules/space/translation/gptranslation.h>
 #include <modules/space/translation/horizonstranslation.h>
 #include <modules/space/rotation/spicerotation.h>
+#include <modules/space/tasks/generateephemeristabletask.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/rendering/renderable.h>
 #include <openspace/rendering/screenspacerenderable.h>
@@ -46,6 +47,7 @@
 #include <openspace/util/coordinateconversion.h>
 #include <openspace/util/factorymanager.h>
 #include <openspace/util/spicemanager.h>
+#include <openspace/util/task.h>
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/templatefactory.h>
 
@@ -109,6 +111,11 @@ void SpaceModule::internalInitialize(const ghoul::Dictionary& dictionary) {
 
     fRotation->registerClass<SpiceRotation>("SpiceRotation");
 
+    ghoul::TemplateFactory<Task>* fTask = FactoryManager::ref().factory<Task>();
+    ghoul_assert(fTask, "Task factory was not created");
+
+    fTask->registerClass<GenerateEphemerisTableTask>("GenerateEphemerisTableTask");
+
     if (dictionary.hasValue<bool>(SpiceExceptionInfo.identifier)) {
         _showSpiceExceptions = dictionary.value<bool>(SpiceExceptionInfo.identifier);
     }
@@ -120,6 +127,7 @@ void SpaceModule::internalDeinitializeGL() {
 
 std::vector<documentation::Documentation> SpaceModule::documentations() const {
     return {
+        GenerateEphemerisTableTask::documentation(),
         HorizonsTranslation::Documentation(),
         KeplerTranslation::Documentation(),
         RenderableConstellationBounds::Documentation(),
@@ -24,19 +24,32 @@
 
 #include <modules/space/speckloader.h>
 
+#include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
+#include <openspace/util/memorymappedfile.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/fmt.h>
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <array>
 #include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <functional>
+#include <sstream>
 #include <string_view>
 
 namespace {
-    constexpr int8_t DataCacheFileVersion = 10;
+    constexpr uint32_t DataCacheFileMagic = 0x4B435053; // "SPCK"
+    constexpr uint32_t DataCacheFileVersion = 12;
     constexpr int8_t LabelCacheFileVersion = 11;
     constexpr int8_t ColorCacheFileVersion = 10;
 
@@ -77,6 +90,214 @@ namespace {
         }
     }
 
+    // Each of the blocks in a data cache file starts at a multiple of this alignment
+    constexpr uint64_t DataCacheAlignment = 64;
+
+    // The data cache file starts with this header. It is followed by the variables and
+    // textures and then by the blocks of positions, values, comment offsets, and
+    // comments, each stored in the same layout as in memory. That way, the blocks can be
+    // used in place after the file has been memory-mapped
+    struct DataCacheHeader {
+        uint32_t magic = DataCacheFileMagic;
+        uint32_t version = DataCacheFileVersion;
+        uint64_t fileSize = 0;
+        uint64_t nEntries = 0;
+        uint32_t nValuesPerEntry = 0;
+        int32_t textureDataIndex = -1;
+        int32_t orientationDataIndex = -1;
+        uint32_t padding = 0;
+        uint64_t metadataOffset = 0;
+        uint64_t metadataSize = 0;
+        uint64_t positionsOffset = 0;
+        uint64_t valuesOffset = 0;
+        uint64_t commentOffsetsOffset = 0;
+        uint64_t commentsOffset = 0;
+        uint64_t commentsSize = 0;
+    };
+    static_assert(sizeof(DataCacheHeader) == 96);
+
+    // Reads consecutive values out of the metadata section of a mapped data cache file
+    struct MemoryReader {
+        template <typename T>
+        bool read(T& value) {
+            if (offset + sizeof(T) > size) {
+                return false;
+            }
+            std::memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+            return true;
+        }
+
+        bool read(std::string& value, size_t length) {
+            if (offset + length > size) {
+                return false;
+            }
+            value.assign(reinterpret_cast<const char*>(data + offset), length);
+            offset += length;
+            return true;
+        }
+
+        const std::byte* data = nullptr;
+        size_t size = 0;
+        size_t offset = 0;
+    };
+
+    // The data section of speck files is split into chunks of roughly this many bytes
+    // that are parsed concurrently
+    constexpr size_t DataChunkSize = 1 << 20;
+
+    bool isSpace(char c) noexcept {
+        return c == ' ' || c == '\t';
+    }
+
+    // Same as strip, but without modifying the underlying string
+    std::string_view stripped(std::string_view line) noexcept {
+        while (!line.empty() && isSpace(line.front())) {
+            line.remove_prefix(1);
+        }
+
+        if (!line.empty() && line.front() == '#') {
+            line.remove_prefix(1);
+        }
+
+        while (!line.empty() && isSpace(line.front())) {
+            line.remove_prefix(1);
+        }
+
+        while (!line.empty() && isSpace(line.back())) {
+            line.remove_suffix(1);
+        }
+        return line;
+    }
+
+    // Parses the floating point value in [first, last) and returns whether it was
+    // successful. Trailing characters that are not part of the value are ignored
+    bool parseFloat(const char* first, const char* last, float& value) noexcept {
+        if (first != last && *first == '+') {
+            first++;
+        }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto [p, ec] = std::from_chars(first, last, value);
+        return ec == std::errc() && p != first;
+#else // ^^^^ __cpp_lib_to_chars // !__cpp_lib_to_chars vvvv
+        // Standard libraries without floating point support in from_chars. The value
+        // is always followed by whitespace, a line ending, or the end of the string, so
+        // strtof does not read past the end of it
+        char* p = nullptr;
+        value = std::strtof(first, &p);
+        return p != first && p <= last;
+#endif // __cpp_lib_to_chars
+    }
+
+    // The entries of a consecutive range of lines of the data section of a speck file
+    struct DataChunk {
+        enum class Error {
+            None = 0,
+            Intermixed,
+            Position,
+            Value
+        };
+
+        std::vector<glm::vec3> positions;
+        // The values are stored per entry and are transposed when merging the chunks
+        std::vector<float> values;
+        std::string comments;
+        std::vector<uint64_t> commentEnds;
+
+        // The number of lines that have been parsed
+        size_t nLines = 0;
+
+        // Parsing stops at the first line that contains an error
+        Error error = Error::None;
+        int errorValue = 0;
+    };
+
+    void parseDataChunk(std::string_view text, int nDataValues,
+                        openspace::speck::SkipAllZeroLines skipAllZeroLines,
+                        DataChunk& chunk)
+    {
+        ZoneScoped;
+
+        std::vector<float> lineValues(nDataValues);
+        size_t lineBegin = 0;
+        while (lineBegin < text.size()) {
+            size_t lineEnd = text.find('\n', lineBegin);
+            if (lineEnd == std::string_view::npos) {
+                lineEnd = text.size();
+            }
+            std::string_view line = text.substr(lineBegin, lineEnd - lineBegin);
+            lineBegin = lineEnd + 1;
+            chunk.nLines++;
+
+            // Guard against wrong line endings (copying files from Windows to Mac)
+            // causes lines to have a final \r
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+
+            // Ignore empty line or commented-out lines
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            line = stripped(line);
+            if (line.empty()) {
+                continue;
+            }
+
+            // If the first character is a digit, we have left the preamble and are in
+            // the data section of the file
+            if (!std::isdigit(line[0]) && line[0] != '-') {
+                chunk.error = DataChunk::Error::Intermixed;
+                return;
+            }
+
+            const char* p = line.data();
+            const char* const last = line.data() + line.size();
+            // Parses the next whitespace-separated value of the line
+            auto nextValue = [&p, last](float& value) {
+                while (p != last && isSpace(*p)) {
+                    p++;
+                }
+                const char* tokenEnd = p;
+                while (tokenEnd != last && !isSpace(*tokenEnd)) {
+                    tokenEnd++;
+                }
+                const bool success = p != tokenEnd && parseFloat(p, tokenEnd, value);
+                p = tokenEnd;
+                return success;
+            };
+
+            glm::vec3 position = glm::vec3(0.f);
+            if (!nextValue(position.x) || !nextValue(position.y) ||
+                !nextValue(position.z))
+            {
+                chunk.error = DataChunk::Error::Position;
+                return;
+            }
+            bool allZero = (position == glm::vec3(0.f));
+
+            for (int i = 0; i < nDataValues; i += 1) {
+                if (!nextValue(lineValues[i])) {
+                    chunk.error = DataChunk::Error::Value;
+                    chunk.errorValue = i;
+                    return;
+                }
+                allZero &= std::isnan(lineValues[i]) || lineValues[i] == 0.f;
+            }
+
+            if (skipAllZeroLines && allZero) {
+                continue;
+            }
+
+            chunk.comments += stripped(std::string_view(p, last));
+            chunk.commentEnds.push_back(chunk.comments.size());
+
+            chunk.positions.push_back(position);
+            chunk.values.insert(chunk.values.end(), lineValues.begin(), lineValues.end());
+        }
+    }
+
     template <typename T>
     using LoadCacheFunc = std::function<std::optional<T>(std::filesystem::path)>;
 
@@ -113,7 +334,7 @@ namespace {
             std::optional<T> dataset = loadCacheFunction(cached);
             if (dataset.has_value()) {
                 // We could load the cache file and we are now done with this
-                return *dataset;
+                return std::move(*dataset);
             }
             else {
                 FileSys.cacheManager()->removeCacheFile(cached);
@@ -122,9 +343,27 @@ namespace {
         LINFOC("SpeckLoader", fmt::format("Loading file {}", speckPath));
         T dataset = loadSpeckFunction(speckPath, skipAllZeroLines);
 
-        if (!dataset.entries.empty()) {
+        bool isEmpty = false;
+        if constexpr (std::is_same_v<T, openspace::speck::Dataset>) {
+            isEmpty = dataset.empty();
+        }
+        else {
+            isEmpty = dataset.entries.empty();
+        }
+
+        if (!isEmpty) {
             LINFOC("SpeckLoader", "Saving cache");
             saveCacheFunction(dataset, cached);
+
+            if constexpr (std::is_same_v<T, openspace::speck::Dataset>) {
+                // Use the cache file that was just written instead of the parsed data
+                // so that the memory is shared with other processes loading the same
+                // file
+                std::optional<T> mapped = loadCacheFunction(cached);
+                if (mapped.has_value()) {
+                    return std::move(*mapped);
+                }
+            }
         }
         return dataset;
     }
@@ -132,6 +371,24 @@ namespace {
 
 namespace openspace::speck {
 
+struct Dataset::Storage {
+    // Used if the dataset was loaded from a speck file
+    std::vector<glm::vec3> positions;
+    std::vector<float> values;
+    std::string comments;
+    std::vector<uint64_t> commentOffsets;
+
+    // Used if the dataset was loaded from a cache file. The mapping is private and
+    // copy-on-write, so the pages are shared with all other mappings of the same file
+    // until they are written to
+    MemoryMappedFile mapping;
+};
+
+Dataset::Dataset() = default;
+Dataset::Dataset(Dataset&&) noexcept = default;
+Dataset& Dataset::operator=(Dataset&&) noexcept = default;
+Dataset::~Dataset() = default;
+
 namespace data {
 
 Dataset loadFile(std::filesystem::path path, SkipAllZeroLines skipAllZeroLines) {
@@ -146,6 +403,7 @@ Dataset loadFile(std::filesystem::path path, SkipAllZeroLines skipAllZeroLines)
 
     int nDataValues = 0;
     int currentLineNumber = 0;
+    bool foundData = false;
 
     std::string line;
     // First phase: Loading the header information
@@ -168,6 +426,7 @@ Dataset loadFile(std::filesystem::path path, SkipAllZeroLines skipAllZeroLines)
         // If the first character is a digit, we have left the preamble and are in the
         // data section of the file
         if (std::isdigit(line[0]) || line[0] == '-') {
+            foundData = true;
             break;
         }
 
@@ -294,287 +553,341 @@ Dataset loadFile(std::filesystem::path path, SkipAllZeroLines skipAllZeroLines)
         }
     );
 
-    // For the first line, we already loaded it and rejected it above, so if we do another
-    // std::getline, we'd miss the first data value line
-    bool isFirst = true;
-    while (isFirst || std::getline(file, line)) {
-        currentLineNumber++;
-        isFirst = false;
-
-        // Ignore empty line or commented-out lines
-        if (line.empty() || line[0] == '#') {
-            continue;
-        }
-
-        // Guard against wrong line endings (copying files from Windows to Mac) causes
-        // lines to have a final \r
-        if (line.back() == '\r') {
-            line = line.substr(0, line.length() - 1);
-        }
-
-        strip(line);
-
-        if (line.empty()) {
-            continue;
-        }
+    res.nValuesPerEntry = nDataValues;
 
-        // If the first character is a digit, we have left the preamble and are in the
-        // data section of the file
-        if (!std::isdigit(line[0]) && line[0] != '-') {
-            throw ghoul::RuntimeError(fmt::format(
-                "Error loading speck file {}: Header information and datasegment "
-                "intermixed", path
-            ));
-        }
-
-        bool allZero = true;
-
-        std::stringstream str(line);
-        Dataset::Entry entry;
-        str >> entry.position.x >> entry.position.y >> entry.position.z;
-        allZero &= (entry.position == glm::vec3(0.0));
+    // Second phase: Loading the data section. The remainder of the file is split into
+    // chunks on line boundaries which are parsed concurrently and then merged
+    std::string data;
+    if (foundData) {
+        std::ostringstream rest;
+        rest << file.rdbuf();
+        // We already loaded the first data line above, so it has to be added back in
+        data = line + '\n' + rest.str();
+    }
 
-        if (!str.good()) {
-            // Need to subtract one of the line number here as we increase the current
-            // line count in the beginning of the while loop we are currently in
-            throw ghoul::RuntimeError(fmt::format(
-                "Error loading position information out of data line {} in file {}. "
-                "Value was not a number",
-                currentLineNumber - 1, path
-            ));
-        }
+    std::vector<std::string_view> chunkTexts;
+    size_t chunkBegin = 0;
+    while (chunkBegin < data.size()) {
+        const size_t minChunkEnd = std::min(chunkBegin + DataChunkSize, data.size());
+        size_t chunkEnd = data.find('\n', minChunkEnd);
+        chunkEnd = (chunkEnd == std::string::npos) ? data.size() : chunkEnd + 1;
+        chunkTexts.push_back(
+            std::string_view(data).substr(chunkBegin, chunkEnd - chunkBegin)
+        );
+        chunkBegin = chunkEnd;
+    }
 
-        entry.data.resize(nDataValues);
-        std::stringstream valueStream;
-        for (int i = 0; i < nDataValues; i += 1) {
-            std::string value;
-            str >> value;
-            if (value == "nan" || value == "NaN") {
-                entry.data[i] = std::numeric_limits<float>::quiet_NaN();
-            }
-            else {
-                valueStream.clear();
-                valueStream.str(value);
-                valueStream >> entry.data[i];
-
-                allZero &= (entry.data[i] == 0.0);
-                if (valueStream.fail()) {
-                    // Need to subtract one of the line number here as we increase the
-                    // current line count in the beginning of the while loop we are
-                    // currently in
-                    throw ghoul::RuntimeError(fmt::format(
-                        "Error loading data value {} out of data line {} in file {}. "
-                        "Value was not a number",
-                        i, currentLineNumber - 1, path
-                    ));
+    ThreadPool& pool = global::openSpaceEngine->threadPool();
+    auto forEachChunk = [&pool, &chunkTexts](const auto& func) {
+        pool.parallelFor(
+            0,
+            chunkTexts.size(),
+            1,
+            [&func](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    func(i);
                 }
             }
-        }
-
-        if (skipAllZeroLines && allZero) {
+        );
+    };
+
+    std::vector<DataChunk> chunks(chunkTexts.size());
+    forEachChunk([&](size_t i) {
+        parseDataChunk(chunkTexts[i], nDataValues, skipAllZeroLines, chunks[i]);
+    });
+
+    // Report the first error in the file, if there is any
+    int lineNumber = currentLineNumber;
+    for (const DataChunk& chunk : chunks) {
+        if (chunk.error == DataChunk::Error::None) {
+            lineNumber += static_cast<int>(chunk.nLines);
             continue;
         }
 
-        std::string rest;
-        std::getline(str, rest);
-        if (!rest.empty()) {
-
-            strip(rest);
-            entry.comment = rest;
+        lineNumber += static_cast<int>(chunk.nLines) - 1;
+        switch (chunk.error) {
+            case DataChunk::Error::Intermixed:
+                throw ghoul::RuntimeError(fmt::format(
+                    "Error loading speck file {}: Header information and datasegment "
+                    "intermixed", path
+                ));
+            case DataChunk::Error::Position:
+                throw ghoul::RuntimeError(fmt::format(
+                    "Error loading position information out of data line {} in file {}. "
+                    "Value was not a number",
+                    lineNumber, path
+                ));
+            case DataChunk::Error::Value:
+                throw ghoul::RuntimeError(fmt::format(
+                    "Error loading data value {} out of data line {} in file {}. "
+                    "Value was not a number",
+                    chunk.errorValue, lineNumber, path
+                ));
+            case DataChunk::Error::None:
+                break;
         }
-
-        res.entries.push_back(std::move(entry));
     }
 
-#ifdef _DEBUG
-    if (!res.entries.empty()) {
-        size_t nValues = res.entries[0].data.size();
-        ghoul_assert(nDataValues == nValues, "nDataValues calculation went wrong");
-        for (const Dataset::Entry& e : res.entries) {
-            ghoul_assert(
-                e.data.size() == nDataValues,
-                "Row had different number of data values"
-            );
-        }
+    // Merge the chunks. The positions and comments are concatenated, while the values
+    // are transposed into the per-variable layout, so that each chunk writes to a
+    // disjoint range of the final arrays
+    std::vector<size_t> chunkOffsets(chunks.size() + 1, 0);
+    std::vector<size_t> chunkCommentOffsets(chunks.size() + 1, 0);
+    for (size_t i = 0; i < chunks.size(); i++) {
+        chunkOffsets[i + 1] = chunkOffsets[i] + chunks[i].positions.size();
+        chunkCommentOffsets[i + 1] = chunkCommentOffsets[i] + chunks[i].comments.size();
     }
-#endif
+    const size_t nEntries = chunkOffsets.back();
+
+    std::vector<glm::vec3> positions(nEntries);
+    std::vector<float> values(nEntries * nDataValues);
+    std::string comments(chunkCommentOffsets.back(), '\0');
+    std::vector<uint64_t> commentOffsets(nEntries + 1, 0);
+    forEachChunk([&](size_t c) {
+        const DataChunk& chunk = chunks[c];
+        const size_t base = chunkOffsets[c];
+        const size_t commentBase = chunkCommentOffsets[c];
+
+        std::copy(
+            chunk.positions.begin(),
+            chunk.positions.end(),
+            positions.begin() + base
+        );
+        std::copy(
+            chunk.comments.begin(),
+            chunk.comments.end(),
+            comments.begin() + commentBase
+        );
+        for (size_t i = 0; i < chunk.positions.size(); i++) {
+            commentOffsets[base + i + 1] = commentBase + chunk.commentEnds[i];
+            for (int v = 0; v < nDataValues; v++) {
+                values[v * nEntries + base + i] = chunk.values[i * nDataValues + v];
+            }
+        }
+    });
+
+    res.storage = std::make_unique<Dataset::Storage>();
+    res.storage->positions = std::move(positions);
+    res.storage->values = std::move(values);
+    res.storage->comments = std::move(comments);
+    res.storage->commentOffsets = std::move(commentOffsets);
+    res.positions = res.storage->positions;
+    res.values = res.storage->values;
+    res.comments = res.storage->comments;
+    res.commentOffsets = res.storage->commentOffsets;
 
     return res;
 }
 
 std::optional<Dataset> loadCachedFile(std::filesystem::path path) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file.good()) {
+    MemoryMappedFile file = MemoryMappedFile(path, MemoryMappedFile::Mode::CopyOnWrite);
+    if (!file.isValid()) {
         return std::nullopt;
     }
 
     Dataset result;
+    result.storage = std::make_unique<Dataset::Storage>();
+    result.storage->mapping = std::move(file);
+    MemoryMappedFile& mapping = result.storage->mapping;
+    const size_t mappingSize = mapping.size();
 
-    int8_t fileVersion;
-    file.read(reinterpret_cast<char*>(&fileVersion), sizeof(int8_t));
-    if (fileVersion != DataCacheFileVersion) {
+    DataCacheHeader header;
+    if (mappingSize < sizeof(DataCacheHeader)) {
+        return std::nullopt;
+    }
+    std::memcpy(&header, mapping.data(), sizeof(DataCacheHeader));
+    if (header.magic != DataCacheFileMagic || header.version != DataCacheFileVersion) {
         // Incompatible version and we won't be able to read the file
         return std::nullopt;
     }
 
+    const uint64_t nEntries = header.nEntries;
+    const uint64_t nValues = nEntries * header.nValuesPerEntry;
+    auto isValidBlock = [&header](uint64_t offset, uint64_t size) {
+        return offset % DataCacheAlignment == 0 && offset + size <= header.fileSize;
+    };
+    if (header.fileSize != mappingSize ||
+        !isValidBlock(header.metadataOffset, header.metadataSize) ||
+        !isValidBlock(header.positionsOffset, nEntries * sizeof(glm::vec3)) ||
+        !isValidBlock(header.valuesOffset, nValues * sizeof(float)) ||
+        !isValidBlock(header.commentOffsetsOffset, (nEntries + 1) * sizeof(uint64_t)) ||
+        !isValidBlock(header.commentsOffset, header.commentsSize))
+    {
+        return std::nullopt;
+    }
+
+    std::byte* data = mapping.data();
+
     //
-    // Read variables
-    uint16_t nVariables;
-    file.read(reinterpret_cast<char*>(&nVariables), sizeof(uint16_t));
+    // Read variables and textures
+    MemoryReader reader = {
+        .data = data + header.metadataOffset,
+        .size = header.metadataSize
+    };
+
+    uint16_t nVariables = 0;
+    if (!reader.read(nVariables)) {
+        return std::nullopt;
+    }
     result.variables.resize(nVariables);
-    for (int i = 0; i < nVariables; i += 1) {
-        Dataset::Variable var;
-
-        int16_t idx;
-        file.read(reinterpret_cast<char*>(&idx), sizeof(int16_t));
+    for (Dataset::Variable& var : result.variables) {
+        int16_t idx = 0;
+        uint16_t len = 0;
+        if (!reader.read(idx) || !reader.read(len) || !reader.read(var.name, len)) {
+            return std::nullopt;
+        }
         var.index = idx;
-
-        uint16_t len;
-        file.read(reinterpret_cast<char*>(&len), sizeof(uint16_t));
-        var.name.resize(len);
-        file.read(var.name.data(), len);
-
-        result.variables[i] = std::move(var);
     }
 
-    //
-    // Read textures
-    uint16_t nTextures;
-    file.read(reinterpret_cast<char*>(&nTextures), sizeof(uint16_t));
+    uint16_t nTextures = 0;
+    if (!reader.read(nTextures)) {
+        return std::nullopt;
+    }
     result.textures.resize(nTextures);
-    for (int i = 0; i < nTextures; i += 1) {
-        Dataset::Texture tex;
-
-        int16_t idx;
-        file.read(reinterpret_cast<char*>(&idx), sizeof(int16_t));
+    for (Dataset::Texture& tex : result.textures) {
+        int16_t idx = 0;
+        uint16_t len = 0;
+        if (!reader.read(idx) || !reader.read(len) || !reader.read(tex.file, len)) {
+            return std::nullopt;
+        }
         tex.index = idx;
-
-        uint16_t len;
-        file.read(reinterpret_cast<char*>(&len), sizeof(uint16_t));
-        tex.file.resize(len);
-        file.read(tex.file.data(), len);
-
-        result.textures[i] = std::move(tex);
     }
 
-    //
-    // Read indices
-    int16_t texDataIdx;
-    file.read(reinterpret_cast<char*>(&texDataIdx), sizeof(int16_t));
-    result.textureDataIndex = texDataIdx;
-
-    int16_t oriDataIdx;
-    file.read(reinterpret_cast<char*>(&oriDataIdx), sizeof(int16_t));
-    result.orientationDataIndex = oriDataIdx;
+    result.textureDataIndex = header.textureDataIndex;
+    result.orientationDataIndex = header.orientationDataIndex;
+    result.nValuesPerEntry = static_cast<int>(header.nValuesPerEntry);
 
     //
-    // Read entries
-    uint64_t nEntries;
-    file.read(reinterpret_cast<char*>(&nEntries), sizeof(uint64_t));
-    result.entries.reserve(nEntries);
-    for (uint64_t i = 0; i < nEntries; i += 1) {
-        Dataset::Entry e;
-        file.read(reinterpret_cast<char*>(&e.position.x), sizeof(float));
-        file.read(reinterpret_cast<char*>(&e.position.y), sizeof(float));
-        file.read(reinterpret_cast<char*>(&e.position.z), sizeof(float));
-
-        uint16_t nValues;
-        file.read(reinterpret_cast<char*>(&nValues), sizeof(uint16_t));
-        e.data.resize(nValues);
-        file.read(reinterpret_cast<char*>(e.data.data()), nValues * sizeof(float));
-
-        uint16_t len;
-        file.read(reinterpret_cast<char*>(&len), sizeof(uint16_t));
-        if (len > 0) {
-            std::string comment;
-            comment.resize(len);
-            file.read(comment.data(), len);
-            e.comment = std::move(comment);
-        }
-
-        result.entries.push_back(std::move(e));
+    // Use the blocks of entries in place
+    result.positions = std::span(
+        reinterpret_cast<glm::vec3*>(data + header.positionsOffset),
+        nEntries
+    );
+    result.values = std::span(
+        reinterpret_cast<float*>(data + header.valuesOffset),
+        nValues
+    );
+    result.commentOffsets = std::span(
+        reinterpret_cast<const uint64_t*>(data + header.commentOffsetsOffset),
+        nEntries + 1
+    );
+    result.comments = std::string_view(
+        reinterpret_cast<const char*>(data + header.commentsOffset),
+        header.commentsSize
+    );
+    if (result.commentOffsets.back() != header.commentsSize) {
+        return std::nullopt;
     }
 
     return result;
 }
 
 void saveCachedFile(const Dataset& dataset, std::filesystem::path path) {
-    std::ofstream file(path, std::ofstream::binary);
-
-    file.write(reinterpret_cast<const char*>(&DataCacheFileVersion), sizeof(int8_t));
-
     //
-    // Store variables
+    // Store variables and textures
+    std::ostringstream metadata;
+
     checkSize<uint16_t>(dataset.variables.size(), "Too many variables");
     uint16_t nVariables = static_cast<uint16_t>(dataset.variables.size());
-    file.write(reinterpret_cast<const char*>(&nVariables), sizeof(uint16_t));
+    metadata.write(reinterpret_cast<const char*>(&nVariables), sizeof(uint16_t));
     for (const Dataset::Variable& var : dataset.variables) {
         checkSize<int16_t>(var.index, "Variable index too large");
         int16_t idx = static_cast<int16_t>(var.index);
-        file.write(reinterpret_cast<const char*>(&idx), sizeof(int16_t));
+        metadata.write(reinterpret_cast<const char*>(&idx), sizeof(int16_t));
 
         checkSize<uint16_t>(var.name.size(), "Variable name too long");
         uint16_t len = static_cast<uint16_t>(var.name.size());
-        file.write(reinterpret_cast<const char*>(&len), sizeof(uint16_t));
-        file.write(var.name.data(), len);
+        metadata.write(reinterpret_cast<const char*>(&len), sizeof(uint16_t));
+        metadata.write(var.name.data(), len);
     }
 
-    //
-    // Store textures
     checkSize<uint16_t>(dataset.textures.size(), "Too many textures");
     uint16_t nTextures = static_cast<uint16_t>(dataset.textures.size());
-    file.write(reinterpret_cast<const char*>(&nTextures), sizeof(uint16_t));
+    metadata.write(reinterpret_cast<const char*>(&nTextures), sizeof(uint16_t));
     for (const Dataset::Texture& tex : dataset.textures) {
         checkSize<int16_t>(tex.index, "Texture index too large");
         int16_t idx = static_cast<int16_t>(tex.index);
-        file.write(reinterpret_cast<const char*>(&idx), sizeof(int16_t));
-
+        metadata.write(reinterpret_cast<const char*>(&idx), sizeof(int16_t));
 
         checkSize<uint16_t>(tex.file.size(), "Texture file too long");
         uint16_t len = static_cast<uint16_t>(tex.file.size());
-        file.write(reinterpret_cast<const char*>(&len), sizeof(uint16_t));
-        file.write(tex.file.data(), len);
+        metadata.write(reinterpret_cast<const char*>(&len), sizeof(uint16_t));
+        metadata.write(tex.file.data(), len);
     }
+    const std::string meta = metadata.str();
 
     //
-    // Store indices
-    checkSize<int16_t>(dataset.textureDataIndex, "Texture index too large");
-    int16_t texIdx = static_cast<int16_t>(dataset.textureDataIndex);
-    file.write(reinterpret_cast<const char*>(&texIdx), sizeof(int16_t));
-
-    checkSize<int16_t>(dataset.orientationDataIndex, "Orientation index too large");
-    int16_t orientationIdx = static_cast<int16_t>(dataset.orientationDataIndex);
-    file.write(reinterpret_cast<const char*>(&orientationIdx), sizeof(int16_t));
+    // Compute the layout of the file
+    DataCacheHeader header;
+    header.nEntries = static_cast<uint64_t>(dataset.size());
+    header.nValuesPerEntry = static_cast<uint32_t>(dataset.nValuesPerEntry);
+    header.textureDataIndex = static_cast<int32_t>(dataset.textureDataIndex);
+    header.orientationDataIndex = static_cast<int32_t>(dataset.orientationDataIndex);
+
+    uint64_t offset = sizeof(DataCacheHeader);
+    auto nextBlock = [&offset](uint64_t size) {
+        const uint64_t begin =
+            (offset + DataCacheAlignment - 1) / DataCacheAlignment * DataCacheAlignment;
+        offset = begin + size;
+        return begin;
+    };
+    header.metadataSize = meta.size();
+    header.metadataOffset = nextBlock(meta.size());
+    header.positionsOffset = nextBlock(dataset.positions.size_bytes());
+    header.valuesOffset = nextBlock(dataset.values.size_bytes());
+    header.commentOffsetsOffset = nextBlock(dataset.commentOffsets.size_bytes());
+    header.commentsSize = dataset.comments.size();
+    header.commentsOffset = nextBlock(dataset.comments.size());
+    header.fileSize = offset;
 
     //
-    // Store entries
-    checkSize<uint64_t>(dataset.entries.size(), "Too many entries");
-    uint64_t nEntries = static_cast<uint64_t>(dataset.entries.size());
-    file.write(reinterpret_cast<const char*>(&nEntries), sizeof(uint64_t));
-    for (const Dataset::Entry& e : dataset.entries) {
-        file.write(reinterpret_cast<const char*>(&e.position.x), sizeof(float));
-        file.write(reinterpret_cast<const char*>(&e.position.y), sizeof(float));
-        file.write(reinterpret_cast<const char*>(&e.position.z), sizeof(float));
-
-        checkSize<uint16_t>(e.data.size(), "Too many data variables");
-        uint16_t nValues = static_cast<uint16_t>(e.data.size());
-        file.write(reinterpret_cast<const char*>(&nValues), sizeof(uint16_t));
-        file.write(
-            reinterpret_cast<const char*>(e.data.data()),
-            e.data.size() * sizeof(float)
+    // Store the file. It is written to a temporary file first so that other processes
+    // never map a partially written cache file
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream file(tmp, std::ofstream::binary);
+
+        uint64_t written = 0;
+        auto writeBlock = [&file, &written](uint64_t begin, const void* d, size_t size) {
+            constexpr std::array<char, DataCacheAlignment> Padding = {};
+            file.write(Padding.data(), begin - written);
+            file.write(reinterpret_cast<const char*>(d), size);
+            written = begin + size;
+        };
+        writeBlock(0, &header, sizeof(DataCacheHeader));
+        writeBlock(header.metadataOffset, meta.data(), meta.size());
+        writeBlock(
+            header.positionsOffset,
+            dataset.positions.data(),
+            dataset.positions.size_bytes()
+        );
+        writeBlock(
+            header.valuesOffset,
+            dataset.values.data(),
+            dataset.values.size_bytes()
+        );
+        writeBlock(
+            header.commentOffsetsOffset,
+            dataset.commentOffsets.data(),
+            dataset.commentOffsets.size_bytes()
         );
+        writeBlock(header.commentsOffset, dataset.comments.data(), header.commentsSize);
 
-        if (e.comment.has_value()) {
-            checkSize<uint16_t>(e.comment->size(), "Comment too long");
-        }
-        uint16_t commentLen = e.comment.has_value() ?
-            static_cast<uint16_t>(e.comment->size()) :
-            0;
-        file.write(reinterpret_cast<const char*>(&commentLen), sizeof(uint16_t));
-        if (e.comment.has_value()) {
-            file.write(e.comment->data(), e.comment->size());
+        if (!file.good()) {
+            throw ghoul::RuntimeError(fmt::format("Error saving file {}", path));
         }
     }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        LWARNINGC(
+            "SpeckLoader",
+            fmt::format("Could not store cache file {}: {}", path, ec.message())
+        );
+        std::filesystem::remove(tmp, ec);
+    }
 }
 
 Dataset loadFileWithCache(std::filesystem::path speckPath,
@@ -940,6 +1253,39 @@ ColorMap loadFileWithCache(std::filesystem::path path, SkipAllZeroLines skipAllZ
 
 } // namespace color
 
+size_t Dataset::size() const {
+    return positions.size();
+}
+
+bool Dataset::empty() const {
+    return positions.empty();
+}
+
+size_t Dataset::memoryUsage() const {
+    return positions.size_bytes() + values.size_bytes() + comments.size() +
+        commentOffsets.size_bytes();
+}
+
+std::span<const float> Dataset::variable(int index) const {
+    if (index < 0 || index >= nValuesPerEntry) {
+        return std::span<const float>();
+    }
+    return values.subspan(index * positions.size(), positions.size());
+}
+
+std::span<float> Dataset::variable(int index) {
+    if (index < 0 || index >= nValuesPerEntry) {
+        return std::span<float>();
+    }
+    return values.subspan(index * positions.size(), positions.size());
+}
+
+std::string_view Dataset::comment(size_t entry) const {
+    ghoul_assert(entry < positions.size(), "Entry out of range");
+    const size_t begin = commentOffsets[entry];
+    return comments.substr(begin, commentOffsets[entry + 1] - begin);
+}
+
 int Dataset::index(std::string_view variableName) const {
     for (const Dataset::Variable& v : variables) {
         if (v.name == variableName) {
@@ -963,15 +1309,16 @@ bool Dataset::normalizeVariable(std::string_view variableName) {
         return false;
     }
 
+    std::span<float> vs = variable(*idx);
     float minValue = std::numeric_limits<float>::max();
     float maxValue = -std::numeric_limits<float>::max();
-    for (Dataset::Entry& e : entries) {
-        minValue = std::min(minValue, e.data[*idx]);
-        maxValue = std::max(maxValue, e.data[*idx]);
+    for (float v : vs) {
+        minValue = std::min(minValue, v);
+        maxValue = std::max(maxValue, v);
     }
 
-    for (Dataset::Entry& e : entries) {
-        e.data[*idx] = (e.data[*idx] - minValue) / (maxValue - minValue);
+    for (float& v : vs) {
+        v = (v - minValue) / (maxValue - minValue);
     }
 
     return true;
@@ -28,8 +28,11 @@
 #include <ghoul/glm.h>
 #include <ghoul/misc/boolean.h>
 #include <filesystem>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace openspace::speck {
@@ -37,6 +40,11 @@ namespace openspace::speck {
 BooleanType(SkipAllZeroLines);
 
 struct Dataset {
+    Dataset();
+    Dataset(Dataset&&) noexcept;
+    Dataset& operator=(Dataset&&) noexcept;
+    ~Dataset();
+
     struct Variable {
         int index = -1;
         std::string name;
@@ -52,12 +60,44 @@ struct Dataset {
     int textureDataIndex = -1;
     int orientationDataIndex = -1;
 
-    struct Entry {
-        glm::vec3 position = glm::vec3(0.f);
-        std::vector<float> data;
-        std::optional<std::string> comment;
-    };
-    std::vector<Entry> entries;
+    /// The number of data values that every entry has
+    int nValuesPerEntry = 0;
+
+    /// The positions of all entries
+    std::span<glm::vec3> positions;
+
+    /// The data values of all entries in a single block. All values of the same data
+    /// value index are stored contiguously, so the value `v` of the entry `i` is located
+    /// at `values[v * positions.size() + i]`
+    std::span<float> values;
+
+    /// The comments of all entries stored back-to-back. The comment of the entry `i`
+    /// starts at `commentOffsets[i]` and ends at `commentOffsets[i + 1]`
+    std::string_view comments;
+    std::span<const uint64_t> commentOffsets;
+
+    /// The memory that the positions, values, and comments point into. If the dataset
+    /// was loaded from a cache file, this is a copy-on-write mapping of that file, which
+    /// shares its pages with every other process that maps the same file until one of
+    /// the values is changed
+    struct Storage;
+    std::unique_ptr<Storage> storage;
+
+    /// Returns the number of entries in this dataset
+    size_t size() const;
+    bool empty() const;
+
+    /// Returns the number of bytes used by the positions, values, and comments
+    size_t memoryUsage() const;
+
+    /// Returns the values of all entries for the data value with the \p index or an
+    /// empty span if there is no such data value
+    std::span<const float> variable(int index) const;
+    std::span<float> variable(int index);
+
+    /// Returns the comment of the entry with the index \p entry, which is empty if that
+    /// entry does not have a comment
+    std::string_view comment(size_t entry) const;
 
     int index(std::string_view variableName) const;
     bool normalizeVariable(std::string_view variableName);
@@ -28,14 +28,17 @@
 #include <modules/volume/rawvolumemetadata.h>
 #include <modules/volume/rawvolumewriter.h>
 #include <openspace/util/spicemanager.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/documentation/verifier.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/defer.h>
 #include <ghoul/misc/dictionaryluaformatter.h>
+#include <algorithm>
 #include <fstream>
-#include <queue>
+#include <limits>
+#include <mutex>
 
 namespace {
     constexpr std::string_view ProgramName = "RenderableSatellites";
@@ -52,6 +55,9 @@ namespace {
 
      constexpr std::string_view KeyLowerDomainBound = "LowerDomainBound";
      constexpr std::string_view KeyUpperDomainBound = "UpperDomainBound";
+
+    // The number of objects that are propagated by a single task
+    constexpr size_t ObjectsPerTask = 1024;
 } // namespace
 
 namespace openspace {
@@ -375,67 +381,32 @@ glm::dvec3 cartesianToSphericalCoord(glm::dvec3 position){
     return sphericalPosition;
 }
 
-std::vector<glm::dvec3> getPositionBuffer(std::vector<KeplerParameters> tleData,
-                                          double timeInSeconds, std::string gridType)
+glm::dvec3 objectPosition(KeplerTranslation& keplerTranslator,
+                          const KeplerParameters& orbit, double timeInSeconds,
+                          const std::string& gridType)
 {
-    float minTheta = 0.0;
-    float minPhi = 0.0;
-    float maxTheta = 0.0;
-    float maxPhi = 0.0;
-
-    std::vector<glm::dvec3> positionBuffer;
-    for(const auto& orbit : tleData) {
-        KeplerTranslation keplerTranslator;
-        keplerTranslator.setKeplerElements(
-            orbit.eccentricity,
-            orbit.semiMajorAxis,
-            orbit.inclination,
-            orbit.ascendingNode,
-            orbit.argumentOfPeriapsis,
-            orbit.meanAnomaly,
-            orbit.period,
-            orbit.epoch
-        );
-        glm::dvec3 position = keplerTranslator.position({
-            {},
-            Time(timeInSeconds),
-            Time(0.0),
-            false
-        });
-        // LINFO(fmt::format("cart: {} ", position));
-        glm::dvec3 sphPos;
-        if (gridType == "Spherical"){
-            sphPos = cartesianToSphericalCoord(position);
-
-            if (sphPos.y < minTheta){
-                minTheta = sphPos.y;
-            }
-            if (sphPos.z < minPhi){
-                minPhi = sphPos.z;
-            }
-            if (sphPos.y > maxTheta){
-                maxTheta = sphPos.y;
-            }
-            if (sphPos.z > maxPhi){
-                maxPhi = sphPos.z;
-            }
-            // LINFO(fmt::format("pos: {} ", sphPos));
-            positionBuffer.push_back(sphPos);
-
-        }
-        else
-        {
-            positionBuffer.push_back(position);
-        }
-
-
+    keplerTranslator.setKeplerElements(
+        orbit.eccentricity,
+        orbit.semiMajorAxis,
+        orbit.inclination,
+        orbit.ascendingNode,
+        orbit.argumentOfPeriapsis,
+        orbit.meanAnomaly,
+        orbit.period,
+        orbit.epoch
+    );
+    glm::dvec3 position = keplerTranslator.position({
+        {},
+        Time(timeInSeconds),
+        Time(0.0),
+        false
+    });
+    if (gridType == "Spherical") {
+        return cartesianToSphericalCoord(position);
+    }
+    else {
+        return position;
     }
-    LINFO(fmt::format("max theta: {} ", maxTheta));
-    LINFO(fmt::format("max phi: {} ", maxPhi));
-    LINFO(fmt::format("min theta: {} ", minTheta));
-    LINFO(fmt::format("min phi: {} ", minPhi));
-
-    return positionBuffer;
 }
 
 // std::vector<glm::dvec3> generatePositions(int numberOfPositions) {
@@ -531,15 +502,11 @@ double getVoxelVolume(int index, RawVolume<float>& raw, glm::uvec3 dim, float ma
 
 }
 
-double* mapDensityToVoxels(double* densityArray, std::vector<glm::dvec3> positions,
-                           glm::uvec3 dim, float maxApogee, std::string gridType,
-                           RawVolume<float>& raw)
+void mapDensityToVoxels(std::vector<double>& densityArray,
+                        const std::vector<int>& indices, glm::uvec3 dim, float maxApogee,
+                        const std::string& gridType, RawVolume<float>& raw)
 {
-
-    for (const glm::dvec3& position : positions) {
-        //LINFO(fmt::format("pos: {} ", position));
-        int index = getIndexFromPosition(position, dim, maxApogee, gridType);
-        //LINFO(fmt::format("index: {} ", index));
+    for (int index : indices) {
         if (gridType == "Cartesian"){
             ++densityArray[index];
         }
@@ -549,8 +516,6 @@ double* mapDensityToVoxels(double* densityArray, std::vector<glm::dvec3> positio
             densityArray[index] += 1/voxelVolume;
         }
     }
-
-    return densityArray;
 }
 
 GenerateDebrisVolumeTask::GenerateDebrisVolumeTask(const ghoul::Dictionary& dictionary)
@@ -585,6 +550,14 @@ std::string GenerateDebrisVolumeTask::description() {
     return "todo:: description";
 }
 
+std::vector<std::filesystem::path> GenerateDebrisVolumeTask::inputFiles() const {
+    return { _inputPath };
+}
+
+std::vector<std::filesystem::path> GenerateDebrisVolumeTask::outputFiles() const {
+    return { _rawVolumeOutputPath, _dictionaryOutputPath };
+}
+
 void GenerateDebrisVolumeTask::perform(const Task::ProgressCallback& progressCallback) {
     SpiceManager::KernelHandle kernel =
     SpiceManager::ref().loadKernel(absPath("${DATA}/assets/spice/naif0012.tls"));
@@ -665,72 +638,86 @@ void GenerateDebrisVolumeTask::perform(const Task::ProgressCallback& progressCal
      int numberOfIterations = static_cast<int>(timeSpan/timeStep);
     LINFO(fmt::format("timestep: {} ", numberOfIterations));
 
-    std::queue<volume::RawVolume<float>> rawVolumeQueue = {};
-    const int size = _dimensions.x *_dimensions.y *_dimensions.z;
+    const size_t size =
+        static_cast<size_t>(_dimensions.x) * _dimensions.y * _dimensions.z;
+    const size_t nTimesteps = static_cast<size_t>(numberOfIterations) + 1;
+    const size_t nObjects = _TLEDataVector.size();
+    const size_t nChunks =
+        std::max<size_t>((nObjects + ObjectsPerTask - 1) / ObjectsPerTask, 1);
     float minVal = std::numeric_limits<float>::max();
     float maxVal = std::numeric_limits<float>::min();
-    // 2.
-    for (int i=0 ; i<=numberOfIterations ; ++i) {
-        std::vector<glm::dvec3> startPositionBuffer = getPositionBuffer(
-            _TLEDataVector,
-            startTimeInSeconds + (i * timeStep),
-            _gridType
-        );   //+(i*timeStep)
-        //LINFO(fmt::format("pos: {} ", startPositionBuffer[4]));
-
-        double *densityArrayp = new double[size]();
-        //densityArrayp = mapDensityToVoxels(
-        //    densityArrayp,
-        //    generatedPositions,
-        //    _dimensions,
-        //    maxApogee
-        //);
-        volume::RawVolume<float> rawVolume(_dimensions);
-
-        densityArrayp = mapDensityToVoxels(
-            densityArrayp,
-            startPositionBuffer,
-            _dimensions,
-            _maxApogee,
-            _gridType,
-            rawVolume
-        );
-        /*std::vector<glm::dvec3> testBuffer;
-        testBuffer.push_back(glm::dvec3(0,0,0));
-        testBuffer.push_back(glm::dvec3(1,1.5,1.5));
-        testBuffer.push_back(glm::dvec3(1,3,3));
-        testBuffer.push_back(glm::dvec3(3,5,3));
-        //testBuffer.push_back(glm::dvec3(10000,1000000000,1000000000));
-
-
-        densityArrayp = mapDensityToVoxels(
-            densityArrayp,
-            testBuffer,
-            _dimensions,
-            _maxApogee,
-            _gridType
-        );
-        */
-        // create object rawVolume
 
-        //glm::vec3 domainSize = _upperDomainBound - _lowerDomainBound;
-
-        // TODO: Create a forEachSatallite and set(cell, value) to combine
-        //       mapDensityToVoxel and forEachVoxel for less time complexity.
-        rawVolume.forEachVoxel([&](glm::uvec3 cell, float) {
-        //     glm::vec3 coord = _lowerDomainBound +
-        //        glm::vec3(cell) / glm::vec3(_dimensions) * domainSize;
-            float value = getDensityAt(cell, densityArrayp, rawVolume);   // (coord)
+    // The task's Threads budget includes the thread that performs it, which takes part
+    // in the work of the pool
+    const size_t nThreads = static_cast<size_t>(std::max(scheduling().nThreads, 1));
+    ThreadPool pool(nThreads - 1);
+
+    // Only used to convert voxel indices into coordinates for the spherical grid
+    volume::RawVolume<float> voxelVolume(_dimensions);
+
+    // 2. The timesteps are processed in batches with one timestep per thread, so that
+    // only the density arrays of a single batch are in memory at the same time. Each
+    // task propagates a chunk of the objects for one timestep and bins them into its
+    // own partial list of voxels, which is then merged into the density of the timestep
+    std::vector<volume::RawVolume<float>> rawVolumes;
+    rawVolumes.reserve(nTimesteps);
+    for (size_t batchBegin = 0; batchBegin < nTimesteps; batchBegin += nThreads) {
+        const size_t batchSize = std::min(nThreads, nTimesteps - batchBegin);
+
+        std::vector<std::vector<double>> densities(batchSize, std::vector<double>(size));
+        std::vector<std::mutex> mutexes(batchSize);
+
+        pool.parallelFor(0, batchSize * nChunks, 1, [&](size_t begin, size_t end) {
+            KeplerTranslation keplerTranslator;
+            std::vector<int> indices;
+            for (size_t task = begin; task < end; ++task) {
+                const size_t t = task / nChunks;
+                const size_t chunk = task % nChunks;
+                const double time = startTimeInSeconds + ((batchBegin + t) * timeStep);
+
+                const size_t first = chunk * ObjectsPerTask;
+                const size_t last = std::min(first + ObjectsPerTask, nObjects);
+                indices.clear();
+                for (size_t i = first; i < last; ++i) {
+                    glm::dvec3 position = objectPosition(
+                        keplerTranslator,
+                        _TLEDataVector[i],
+                        time,
+                        _gridType
+                    );
+                    indices.push_back(
+                        getIndexFromPosition(position, _dimensions, _maxApogee, _gridType)
+                    );
+                }
+
+                std::lock_guard lock(mutexes[t]);
+                mapDensityToVoxels(
+                    densities[t],
+                    indices,
+                    _dimensions,
+                    _maxApogee,
+                    _gridType,
+                    voxelVolume
+                );
+            }
+        });
 
-            rawVolume.set(cell, value);
+        // create object rawVolume
+        for (size_t t = 0; t < batchSize; ++t) {
+            volume::RawVolume<float> rawVolume(_dimensions);
+            float* data = rawVolume.data();
+            for (size_t i = 0; i < size; ++i) {
+                const float value = static_cast<float>(densities[t][i]);
+                data[i] = value;
+                minVal = std::min(minVal, value);
+                maxVal = std::max(maxVal, value);
+            }
+            rawVolumes.push_back(std::move(rawVolume));
+        }
 
-            minVal = std::min(minVal, value);
-            maxVal = std::max(maxVal, value);
-            /*LINFO(fmt::format("min: {} ", minVal));
-            LINFO(fmt::format("max: {} ", maxVal));*/
-        });
-        rawVolumeQueue.push(rawVolume);
-        delete[] densityArrayp;
+        progressCallback(
+            0.9f * static_cast<float>(batchBegin + batchSize) / nTimesteps
+        );
     }
 
     // two loops is used to get a global min and max value for voxels.
@@ -755,8 +742,7 @@ void GenerateDebrisVolumeTask::perform(const Task::ProgressCallback& progressCal
         }
 
         volume::RawVolumeWriter<float> writer(rawOutputName);
-        writer.write(rawVolumeQueue.front());
-        rawVolumeQueue.pop();
+        writer.write(rawVolumes[i]);
 
         RawVolumeMetadata metadata;
         // alternatively metadata.hasTime = false;
@@ -0,0 +1,227 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/space/tasks/generateephemeristabletask.h>
+
+#include <modules/space/ephemeristable.h>
+#include <openspace/documentation/documentation.h>
+#include <openspace/documentation/verifier.h>
+#include <openspace/util/spicemanager.h>
+#include <ghoul/fmt.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+namespace {
+    constexpr std::string_view _loggerCat = "GenerateEphemerisTableTask";
+
+    struct [[codegen::Dictionary(GenerateEphemerisTableTask)]] Parameters {
+        // The SPICE kernels that are loaded before the values are sampled
+        std::vector<std::filesystem::path> kernels;
+
+        // The SPICE name of the body whose position is sampled. Either a target and
+        // an observer, or a source and a destination frame have to be provided
+        std::optional<std::string> target;
+
+        // The SPICE name of the body relative to which the position is sampled
+        std::optional<std::string> observer;
+
+        // The reference frame of the sampled position. The default value is GALACTIC,
+        // the same as for the SpiceTranslation
+        std::optional<std::string> frame;
+
+        // The SPICE frame from which the sampled rotation transforms
+        std::optional<std::string> sourceFrame;
+
+        // The SPICE frame into which the sampled rotation transforms
+        std::optional<std::string> destinationFrame;
+
+        // The beginning of the time window that is sampled
+        std::string startTime [[codegen::annotation("A valid date in ISO 8601 format")]];
+
+        // The end of the time window that is sampled
+        std::string endTime [[codegen::annotation("A valid date in ISO 8601 format")]];
+
+        // The length of each segment of the table in seconds. Shorter segments are more
+        // accurate for quickly changing values, such as the positions of spacecraft
+        // during a flyby. The default value is one day
+        std::optional<double> segmentLength [[codegen::greater(0.0)]];
+
+        // The degree of the Chebyshev polynomials in each segment. The default value is
+        // 12
+        std::optional<int> degree [[codegen::inrange(1, 30)]];
+
+        // The file to which the table is written
+        std::string output [[codegen::annotation("A valid filepath")]];
+    };
+#include "generateephemeristabletask_codegen.cpp"
+} // namespace
+
+namespace openspace {
+
+documentation::Documentation GenerateEphemerisTableTask::documentation() {
+    return codegen::doc<Parameters>("space_generate_ephemeris_table_task");
+}
+
+GenerateEphemerisTableTask::GenerateEphemerisTableTask(
+                                                      const ghoul::Dictionary& dictionary)
+{
+    const Parameters p = codegen::bake<Parameters>(dictionary);
+
+    for (const std::filesystem::path& kernel : p.kernels) {
+        _kernels.push_back(absPath(kernel.string()));
+    }
+    _target = p.target.value_or("");
+    _observer = p.observer.value_or("");
+    _frame = p.frame.value_or("GALACTIC");
+    _sourceFrame = p.sourceFrame.value_or("");
+    _destinationFrame = p.destinationFrame.value_or("");
+    _startTime = p.startTime;
+    _endTime = p.endTime;
+    _segmentLength = p.segmentLength.value_or(86400.0);
+    _degree = p.degree.value_or(12);
+    _outputPath = absPath(p.output);
+
+    const bool isPosition = !_target.empty() && !_observer.empty();
+    const bool isRotation = !_sourceFrame.empty() && !_destinationFrame.empty();
+    if (isPosition == isRotation) {
+        throw ghoul::RuntimeError(
+            "Either 'Target' and 'Observer' or 'SourceFrame' and 'DestinationFrame' have "
+            "to be specified"
+        );
+    }
+}
+
+std::string GenerateEphemerisTableTask::description() {
+    if (!_target.empty()) {
+        return fmt::format(
+            "Sample the position of '{}' relative to '{}' in frame '{}' between {} and "
+            "{} into ephemeris table {}",
+            _target, _observer, _frame, _startTime, _endTime, _outputPath
+        );
+    }
+    else {
+        return fmt::format(
+            "Sample the rotation from '{}' to '{}' between {} and {} into ephemeris "
+            "table {}",
+            _sourceFrame, _destinationFrame, _startTime, _endTime, _outputPath
+        );
+    }
+}
+
+std::vector<std::filesystem::path> GenerateEphemerisTableTask::inputFiles() const {
+    return _kernels;
+}
+
+std::vector<std::filesystem::path> GenerateEphemerisTableTask::outputFiles() const {
+    return { _outputPath };
+}
+
+void GenerateEphemerisTableTask::perform(const Task::ProgressCallback& progressCallback) {
+    std::vector<SpiceManager::KernelHandle> kernels;
+    for (const std::filesystem::path& kernel : _kernels) {
+        kernels.push_back(SpiceManager::ref().loadKernel(kernel.string()));
+    }
+
+    const double start = SpiceManager::ref().ephemerisTimeFromDate(_startTime);
+    const double end = SpiceManager::ref().ephemerisTimeFromDate(_endTime);
+    if (end <= start) {
+        throw ghoul::RuntimeError("The end time has to be after the start time");
+    }
+
+    std::function<void(double, std::span<double>)> sample;
+    std::vector<std::string> identifiers;
+    int nComponents = 0;
+    if (!_target.empty()) {
+        identifiers = { _target, _observer, _frame };
+        nComponents = 3;
+        sample = [this](double time, std::span<double> result) {
+            const glm::dvec3 position = SpiceManager::ref().targetPosition(
+                _target,
+                _observer,
+                _frame,
+                {},
+                time
+            );
+            std::copy_n(glm::value_ptr(position), 3, result.begin());
+        };
+    }
+    else {
+        identifiers = { _sourceFrame, _destinationFrame };
+        nComponents = 9;
+        sample = [this](double time, std::span<double> result) {
+            const glm::dmat3 rotation = SpiceManager::ref().positionTransformMatrix(
+                _sourceFrame,
+                _destinationFrame,
+                time
+            );
+            std::copy_n(glm::value_ptr(rotation), 9, result.begin());
+        };
+    }
+
+    const EphemerisTable table = EphemerisTable::create(
+        identifiers,
+        nComponents,
+        start,
+        end,
+        _segmentLength,
+        _degree,
+        [&](double time, std::span<double> result) {
+            sample(time, result);
+            progressCallback(static_cast<float>(
+                std::clamp((time - start) / (end - start), 0.0, 1.0)
+            ));
+        }
+    );
+
+    // The approximation is exact at the sampling nodes, so we estimate the error in
+    // between them by comparing against SPICE at a few additional points per segment
+    double maxError = 0.0;
+    std::vector<double> expected(nComponents);
+    std::vector<double> approximated(nComponents);
+    constexpr int TestsPerSegment = 7;
+    const double step = _segmentLength / TestsPerSegment;
+    for (double time = start + 0.5 * step; time < end; time += step) {
+        sample(time, expected);
+        table.evaluate(time, approximated);
+        for (int i = 0; i < nComponents; i++) {
+            maxError = std::max(maxError, std::abs(expected[i] - approximated[i]));
+        }
+    }
+    LINFO(fmt::format(
+        "Largest deviation of the ephemeris table from SPICE: {} {}",
+        maxError, _target.empty() ? "" : "km"
+    ));
+
+    table.save(_outputPath);
+    progressCallback(1.f);
+
+    for (SpiceManager::KernelHandle kernel : kernels) {
+        SpiceManager::ref().unloadKernel(kernel);
+    }
+}
+
+} // namespace openspace
@@ -0,0 +1,69 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SPACE___GENERATEEPHEMERISTABLETASK___H__
+#define __OPENSPACE_MODULE_SPACE___GENERATEEPHEMERISTABLETASK___H__
+
+#include <openspace/util/task.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * This task samples the position of a SPICE body or the rotation between two SPICE
+ * frames over a time window and stores the result as an EphemerisTable. A
+ * SpiceTranslation or SpiceRotation that is provided with the table evaluates it instead
+ * of calling into CSPICE within the time window.
+ */
+class GenerateEphemerisTableTask : public Task {
+public:
+    GenerateEphemerisTableTask(const ghoul::Dictionary& dictionary);
+
+    std::string description() override;
+    void perform(const Task::ProgressCallback& progressCallback) override;
+    std::vector<std::filesystem::path> inputFiles() const override;
+    std::vector<std::filesystem::path> outputFiles() const override;
+
+    static documentation::Documentation documentation();
+
+private:
+    std::vector<std::filesystem::path> _kernels;
+    std::string _target;
+    std::string _observer;
+    std::string _frame;
+    std::string _sourceFrame;
+    std::string _destinationFrame;
+    std::string _startTime;
+    std::string _endTime;
+    double _segmentLength = 0.0;
+    int _degree = 0;
+    std::filesystem::path _outputPath;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SPACE___GENERATEEPHEMERISTABLETASK___H__
@@ -33,13 +33,18 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/lua/ghoul_lua.h>
 #include <ghoul/lua/lua_helper.h>
+#include <ghoul/misc/crc32.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <type_traits>
 
 namespace {
     constexpr std::string_view _loggerCat = "HorizonsTranslation";
-    constexpr int8_t CurrentCacheVersion = 2;
+    constexpr int8_t CurrentCacheVersion = 3;
+
+    // The number of keyframes that are stored in each section of the cache file
+    constexpr size_t SectionSize = 4096;
 } // namespace
 
 namespace {
@@ -113,35 +118,87 @@ HorizonsTranslation::HorizonsTranslation(const ghoul::Dictionary& dictionary)
 }
 
 glm::dvec3 HorizonsTranslation::position(const UpdateData& data) const {
-    glm::dvec3 interpolatedPos = glm::dvec3(0.0);
+    const double time = data.time.j2000Seconds();
+
+    std::lock_guard lock(_mutex);
+
+    // Find the last keyframe at or before the requested time and the first one after it
+    // across all files. If multiple files contain the same timestamp, the earlier file
+    // takes precedence
+    const CacheKeyframe* lastBefore = nullptr;
+    const CacheKeyframe* firstAfter = nullptr;
+    for (const KeyframeFile& file : _files) {
+        // The section that contains the requested time is the last one starting before it
+        const auto it = std::upper_bound(
+            file.sections.begin(),
+            file.sections.end(),
+            time,
+            [](double t, const CacheSection& s) { return t < s.start; }
+        );
+        const size_t next = std::distance(file.sections.begin(), it);
+
+        const CacheKeyframe* before = nullptr;
+        const CacheKeyframe* after = nullptr;
+        if (next > 0) {
+            const std::vector<CacheKeyframe>& kfs = section(file, next - 1);
+            const auto kf = std::upper_bound(
+                kfs.begin(),
+                kfs.end(),
+                time,
+                [](double t, const CacheKeyframe& k) { return t < k.timestamp; }
+            );
+            if (kf != kfs.begin()) {
+                before = &*(kf - 1);
+            }
+            if (kf != kfs.end()) {
+                after = &*kf;
+            }
+        }
+        if (!after && next < file.sections.size()) {
+            const std::vector<CacheKeyframe>& kfs = section(file, next);
+            if (!kfs.empty()) {
+                after = &kfs.front();
+            }
+        }
 
-    const Keyframe<glm::dvec3>* lastBefore =
-        _timeline.lastKeyframeBefore(data.time.j2000Seconds(), true);
-    const Keyframe<glm::dvec3>* firstAfter =
-        _timeline.firstKeyframeAfter(data.time.j2000Seconds(), false);
+        if (before && (!lastBefore || before->timestamp > lastBefore->timestamp)) {
+            lastBefore = before;
+        }
+        if (after && (!firstAfter || after->timestamp < firstAfter->timestamp)) {
+            firstAfter = after;
+        }
+    }
 
+    auto toVec = [](const CacheKeyframe& kf) {
+        return glm::dvec3(kf.position[0], kf.position[1], kf.position[2]);
+    };
+
+    glm::dvec3 interpolatedPos = glm::dvec3(0.0);
     if (lastBefore && firstAfter) {
         // We're inbetween first and last value.
         double timelineDiff = firstAfter->timestamp - lastBefore->timestamp;
-        double timeDiff = data.time.j2000Seconds() - lastBefore->timestamp;
+        double timeDiff = time - lastBefore->timestamp;
         double diff = (timelineDiff > DBL_EPSILON) ? timeDiff / timelineDiff : 0.0;
 
-        glm::dvec3 dir = firstAfter->data - lastBefore->data;
-        interpolatedPos = lastBefore->data + dir * diff;
+        glm::dvec3 dir = toVec(*firstAfter) - toVec(*lastBefore);
+        interpolatedPos = toVec(*lastBefore) + dir * diff;
     }
     else if (lastBefore) {
         // Requesting a time after last value. Return last known position.
-        interpolatedPos = lastBefore->data;
+        interpolatedPos = toVec(*lastBefore);
     }
     else if (firstAfter) {
         // Requesting a time before first value. Return last known position.
-        interpolatedPos = firstAfter->data;
+        interpolatedPos = toVec(*firstAfter);
     }
 
     return interpolatedPos;
 }
 
 void HorizonsTranslation::loadData() {
+    std::lock_guard lock(_mutex);
+    _files.clear();
+
     for (const std::string& filePath : _horizonsTextFiles.value()) {
         std::filesystem::path file = absPath(filePath);
         if (!std::filesystem::is_regular_file(file)) {
@@ -149,18 +206,24 @@ void HorizonsTranslation::loadData() {
             return;
         }
 
-        std::filesystem::path cachedFile = FileSys.cacheManager()->cachedFilename(file);
+        // The cache is keyed by the contents of the file so that it gets invalidated if
+        // the file is replaced by a new result from Horizons
+        const std::string hash = std::to_string(ghoul::hashCRC32File(file));
+        std::filesystem::path cachedFile =
+            FileSys.cacheManager()->cachedFilename(file, hash);
         bool hasCachedFile = std::filesystem::is_regular_file(cachedFile);
         if (hasCachedFile) {
             LINFO(fmt::format(
                 "Cached file '{}' used for Horizon file '{}'", cachedFile, file
             ));
 
-            if (loadCachedFile(cachedFile)) {
+            KeyframeFile cached;
+            if (loadCachedFile(cachedFile, cached)) {
+                _files.push_back(std::move(cached));
                 continue;
             }
             else {
-                FileSys.cacheManager()->removeCacheFile(file);
+                FileSys.cacheManager()->removeCacheFile(file, hash);
                 // Intentional fall-through to the 'else' computation to generate the
                 // cache file for the next run
             }
@@ -171,42 +234,87 @@ void HorizonsTranslation::loadData() {
         LINFO(fmt::format("Loading Horizon file '{}'", file));
 
         HorizonsFile horizonsFile(file);
-        if (!readHorizonsTextFile(horizonsFile)) {
+        KeyframeFile parsed;
+        parsed.cacheFile = cachedFile;
+        if (!readHorizonsTextFile(horizonsFile, parsed)) {
             LERROR(fmt::format("Could not read data from Horizons file '{}'", file));
             return;
         }
 
         LINFO("Saving cache");
-        saveCachedFile(cachedFile);
+        saveCachedFile(parsed);
+        _files.push_back(std::move(parsed));
     }
 }
 
-bool HorizonsTranslation::readHorizonsTextFile(HorizonsFile& horizonsFile) {
-    HorizonsResult result = readHorizonsFile(horizonsFile.file());
-    if (result.errorCode != HorizonsResultCode::Valid) {
-        horizonsFile.displayErrorMessage(result.errorCode);
+bool HorizonsTranslation::readHorizonsTextFile(HorizonsFile& horizonsFile,
+                                               KeyframeFile& result) const
+{
+    HorizonsResult res = readHorizonsFile(horizonsFile.file());
+    if (res.errorCode != HorizonsResultCode::Valid) {
+        horizonsFile.displayErrorMessage(res.errorCode);
+        return false;
+    }
+    if (res.data.empty()) {
         return false;
     }
 
-    for (HorizonsKeyframe& keyframe : result.data) {
-        // Search if the keyframe already exist in the timeline
-        auto it = std::find_if(
-            _timeline.keyframes().begin(),
-            _timeline.keyframes().end(),
-            [keyframe](const Keyframe<glm::dvec3>& kf) {
-                return kf.timestamp == keyframe.time;
+    // Sort the keyframes and remove duplicates, keeping the first occurrence
+    std::stable_sort(
+        res.data.begin(),
+        res.data.end(),
+        [](const HorizonsKeyframe& a, const HorizonsKeyframe& b) {
+            return a.time < b.time;
+        }
+    );
+    res.data.erase(
+        std::unique(
+            res.data.begin(),
+            res.data.end(),
+            [](const HorizonsKeyframe& a, const HorizonsKeyframe& b) {
+                return a.time == b.time;
             }
-        );
+        ),
+        res.data.end()
+    );
 
-        // If it doesn't exist in the timeline then add it, prevent duplicates
-        if (it == _timeline.keyframes().end()) {
-            _timeline.addKeyframe(keyframe.time, std::move(keyframe.position));
+    // Split the keyframes into sections; the sections are stored after the header and
+    // the section table in the cache file
+    const size_t nSections = (res.data.size() + SectionSize - 1) / SectionSize;
+    int64_t offset = static_cast<int64_t>(
+        sizeof(int8_t) + 2 * sizeof(int32_t) + nSections * sizeof(CacheSection)
+    );
+    result.sections.clear();
+    result.keyframes.clear();
+    for (size_t i = 0; i < res.data.size(); i += SectionSize) {
+        const size_t end = std::min(i + SectionSize, res.data.size());
+
+        std::vector<CacheKeyframe> keyframes;
+        keyframes.reserve(end - i);
+        for (size_t j = i; j < end; j++) {
+            const HorizonsKeyframe& kf = res.data[j];
+            keyframes.push_back({
+                kf.time,
+                { kf.position.x, kf.position.y, kf.position.z }
+            });
         }
+
+        CacheSection section;
+        section.start = keyframes.front().timestamp;
+        section.end = keyframes.back().timestamp;
+        section.offset = offset;
+        section.nKeyframes = static_cast<int32_t>(keyframes.size());
+        offset += section.nKeyframes * sizeof(CacheKeyframe);
+
+        result.sections.push_back(section);
+        result.keyframes.push_back(std::move(keyframes));
     }
     return true;
 }
 
-bool HorizonsTranslation::loadCachedFile(const std::filesystem::path& file) {
+bool HorizonsTranslation::loadCachedFile(const std::filesystem::path& file,
+                                         KeyframeFile& result) const
+{
     std::ifstream fileStream(file, std::ifstream::binary);
 
     if (!fileStream.good()) {
@@ -219,47 +327,54 @@ bool HorizonsTranslation::loadCachedFile(const std::filesystem::path& file) {
     fileStream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
     if (version != CurrentCacheVersion) {
         LINFO("The format of the cached file has changed: deleting old cache");
-        fileStream.close();
-        FileSys.cacheManager()->removeCacheFile(file);
         return false;
     }
 
-    // Read how many keyframes to read
+    // Read how many keyframes and sections there are
     int32_t nKeyframes = 0;
-
     fileStream.read(reinterpret_cast<char*>(&nKeyframes), sizeof(int32_t));
-    if (nKeyframes == 0) {
-        throw ghoul::RuntimeError("Error reading cache: No values were loaded");
+    int32_t nSections = 0;
+    fileStream.read(reinterpret_cast<char*>(&nSections), sizeof(int32_t));
+    if (nKeyframes <= 0 || nSections <= 0) {
+        LWARNING(fmt::format("Error reading cache {}: No values were loaded", file));
+        return false;
     }
 
-    // Read all data in one go
-    std::vector<CacheKeyframe> cacheKeyframes;
-    cacheKeyframes.resize(nKeyframes);
+    // Only the section table is read here, the keyframes are loaded on demand
+    result.cacheFile = file;
+    result.sections.resize(nSections);
     fileStream.read(
-        reinterpret_cast<char*>(cacheKeyframes.data()),
-        sizeof(CacheKeyframe) * nKeyframes
+        reinterpret_cast<char*>(result.sections.data()),
+        sizeof(CacheSection) * nSections
     );
+    result.keyframes.clear();
+    result.keyframes.resize(nSections);
 
-    // Extract the data from the cache Keyframe vector
-    for (int i = 0; i < nKeyframes; ++i) {
-        // Add keyframe in timeline
-        _timeline.addKeyframe(
-            std::move(cacheKeyframes[i].timestamp),
-            {
-                cacheKeyframes[i].position[0],
-                cacheKeyframes[i].position[1],
-                cacheKeyframes[i].position[2]
-            }
-        );
+    if (!fileStream.good()) {
+        LWARNING(fmt::format("Cache file {} is incomplete", file));
+        return false;
+    }
+
+    // The file was truncated, for example as the application was terminated while the
+    // cache was written
+    const CacheSection& last = result.sections.back();
+    const uintmax_t expectedSize = static_cast<uintmax_t>(
+        last.offset + last.nKeyframes * sizeof(CacheKeyframe)
+    );
+    if (std::filesystem::file_size(file) < expectedSize) {
+        LWARNING(fmt::format("Cache file {} is incomplete", file));
+        return false;
     }
 
-    return fileStream.good();
+    return true;
 }
 
-void HorizonsTranslation::saveCachedFile(const std::filesystem::path& file) const {
-    std::ofstream fileStream(file, std::ofstream::binary);
+void HorizonsTranslation::saveCachedFile(const KeyframeFile& data) const {
+    std::ofstream fileStream(data.cacheFile, std::ofstream::binary);
     if (!fileStream.good()) {
-        LERROR(fmt::format("Error opening file {} for save cache file", file));
+        LERROR(fmt::format(
+            "Error opening file {} for save cache file", data.cacheFile
+        ));
         return;
     }
 
@@ -269,37 +384,60 @@ void HorizonsTranslation::saveCachedFile(const std::filesystem::path& file) cons
         sizeof(int8_t)
     );
 
-    // Write how many keyframes are to be written
-    int32_t nKeyframes = static_cast<int32_t>(_timeline.nKeyframes());
+    // Write how many keyframes and sections are to be written
+    int32_t nKeyframes = 0;
+    for (const CacheSection& section : data.sections) {
+        nKeyframes += section.nKeyframes;
+    }
     if (nKeyframes == 0) {
         throw ghoul::RuntimeError("Error writing cache: No values were loaded");
     }
     fileStream.write(reinterpret_cast<const char*>(&nKeyframes), sizeof(int32_t));
-
-    // Transfer all data to a cache key frame vector, write it all in one go
-    std::deque<Keyframe<glm::dvec3>> keyframes = _timeline.keyframes();
-    std::vector<CacheKeyframe> cachKeyframes;
-    cachKeyframes.reserve(nKeyframes);
-    for (int i = 0; i < nKeyframes; i++) {
-        CacheKeyframe cacheKeyframe;
-        cacheKeyframe.timestamp = keyframes[i].timestamp;
-        cacheKeyframe.position[0] = keyframes[i].data.x;
-        cacheKeyframe.position[1] = keyframes[i].data.y;
-        cacheKeyframe.position[2] = keyframes[i].data.z;
-
-        cachKeyframes.push_back(cacheKeyframe);
-    }
+    const int32_t nSections = static_cast<int32_t>(data.sections.size());
+    fileStream.write(reinterpret_cast<const char*>(&nSections), sizeof(int32_t));
 
     // Write of entire vector will only work if the data is plain old data type,
     // is_pod is depricated in C++20 and replaced with both is_trivial and
     // is_standard_layout
     static_assert(std::is_trivial_v<CacheKeyframe>);
     static_assert(std::is_standard_layout_v<CacheKeyframe>);
+    static_assert(std::is_trivial_v<CacheSection>);
+    static_assert(std::is_standard_layout_v<CacheSection>);
 
-    // Write data
+    // Write the section table followed by the keyframes of each section
     fileStream.write(
-        reinterpret_cast<const char*>(cachKeyframes.data()),
-        sizeof(CacheKeyframe) * nKeyframes
+        reinterpret_cast<const char*>(data.sections.data()),
+        sizeof(CacheSection) * nSections
     );
+    for (const std::vector<CacheKeyframe>& keyframes : data.keyframes) {
+        fileStream.write(
+            reinterpret_cast<const char*>(keyframes.data()),
+            sizeof(CacheKeyframe) * keyframes.size()
+        );
+    }
 }
+
+const std::vector<HorizonsTranslation::CacheKeyframe>&
+HorizonsTranslation::section(const KeyframeFile& file, size_t i) const
+{
+    std::vector<CacheKeyframe>& keyframes = file.keyframes[i];
+    if (!keyframes.empty()) {
+        return keyframes;
+    }
+
+    const CacheSection& section = file.sections[i];
+    std::ifstream fileStream(file.cacheFile, std::ifstream::binary);
+    fileStream.seekg(section.offset);
+    keyframes.resize(section.nKeyframes);
+    fileStream.read(
+        reinterpret_cast<char*>(keyframes.data()),
+        sizeof(CacheKeyframe) * section.nKeyframes
+    );
+    if (!fileStream.good()) {
+        LERROR(fmt::format("Error reading section {} of cache {}", i, file.cacheFile));
+        keyframes.clear();
+    }
+    return keyframes;
+}
+
 } // namespace openspace
@@ -28,11 +28,11 @@
 #include <openspace/scene/translation.h>
 
 #include <openspace/properties/list/stringlistproperty.h>
-#include <openspace/util/timeline.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/lua/luastate.h>
 #include <modules/space/horizonsfile.h>
 #include <memory>
+#include <mutex>
 
 namespace openspace {
 
@@ -65,6 +65,10 @@ namespace documentation { struct Documentation; }
  *    "Observer range & range-rate" and "Galactic longitude & latitude"
  * 2. Change "Range units" to "kilometers (km)" instead of "astronomical units (au)"
  * 3. Check the "Suppress range-rate" option
+ *
+ * The parsed keyframes of each file are stored in a binary cache that is keyed by the
+ * contents of the file. The cache is split into sections of consecutive keyframes and
+ * only the sections that are needed to answer a position request are read from disk.
  */
 class HorizonsTranslation : public Translation {
 public:
@@ -81,14 +85,35 @@ private:
         std::array<double, 3> position;
     };
 
+    /// A range of consecutive keyframes that is stored at `offset` in the cache file
+    struct CacheSection {
+        double start;
+        double end;
+        int64_t offset;
+        int32_t nKeyframes;
+    };
+
+    /// The keyframes of a single Horizons file, sorted by their timestamp
+    struct KeyframeFile {
+        std::filesystem::path cacheFile;
+        std::vector<CacheSection> sections;
+        /// The keyframes of each section, which are empty until they are first needed
+        mutable std::vector<std::vector<CacheKeyframe>> keyframes;
+    };
+
     void loadData();
-    bool readHorizonsTextFile(HorizonsFile& horizonsFile);
-    bool loadCachedFile(const std::filesystem::path& file);
-    void saveCachedFile(const std::filesystem::path& file) const;
+    bool readHorizonsTextFile(HorizonsFile& horizonsFile, KeyframeFile& result) const;
+    bool loadCachedFile(const std::filesystem::path& file, KeyframeFile& result) const;
+    void saveCachedFile(const KeyframeFile& data) const;
+
+    /// Returns the keyframes of section \p i of \p file, loading them if necessary. The
+    /// _mutex has to be locked by the caller
+    const std::vector<CacheKeyframe>& section(const KeyframeFile& file, size_t i) const;
 
     properties::StringListProperty _horizonsTextFiles;
     ghoul::lua::LuaState _state;
-    Timeline<glm::dvec3> _timeline;
+    std::vector<KeyframeFile> _files;
+    mutable std::mutex _mutex;
 };
 
 } // namespace openspace
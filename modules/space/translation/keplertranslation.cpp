@@ -24,28 +24,13 @@
 
 #include <modules/space/translation/keplertranslation.h>
 
+#include <modules/space/kepler.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/logging/logmanager.h>
-#include <glm/gtx/transform.hpp>
 
 namespace {
-    template <typename T, typename Func>
-    T solveIteration(const Func& function, T x0, const T& err = 0.0, int maxIter = 100) {
-        T x2 = x0;
-
-        for (int i = 0; i < maxIter; ++i) {
-            T x = x2;
-            x2 = function(x);
-            if (std::abs(x2 - x) < err) {
-                return x2;
-            }
-        }
-
-        return x2;
-    }
-
     constexpr openspace::properties::Property::PropertyInfo EccentricityInfo = {
         "Eccentricity",
         "Eccentricity",
@@ -210,50 +195,7 @@ KeplerTranslation::KeplerTranslation(const ghoul::Dictionary& dictionary)
 }
 
 double KeplerTranslation::eccentricAnomaly(double meanAnomaly) const {
-    // Compute the eccentric anomaly (the location of the spacecraft taking the
-    // eccentricity of the orbit into account) using different solves for the regimes in
-    // which they are most efficient
-
-    if (_eccentricity == 0.0) {
-        // In a circular orbit, the eccentric anomaly = mean anomaly
-        return meanAnomaly;
-    }
-    else if (_eccentricity < 0.2) {
-        auto solver = [this, &meanAnomaly](double x) -> double {
-            // For low eccentricity, using a first order solver sufficient
-            return meanAnomaly + _eccentricity * sin(x);
-        };
-        return solveIteration(solver, meanAnomaly, 0.0, 5);
-    }
-    else if (_eccentricity < 0.9) {
-        auto solver = [this, &meanAnomaly](double x) -> double {
-            const double e = _eccentricity;
-            return x + (meanAnomaly + e * sin(x) - x) / (1.0 - e * cos(x));
-        };
-        return solveIteration(solver, meanAnomaly, 0.0, 6);
-    }
-    else if (_eccentricity < 1.0) {
-        auto sign = [](double val) -> double {
-            return val > 0.0 ? 1.0 : ((val < 0.0) ? -1.0 : 0.0);
-        };
-        double e = meanAnomaly + 0.85 * _eccentricity * sign(sin(meanAnomaly));
-
-        auto solver = [this, &meanAnomaly, &sign](double x) -> double {
-            const double s = _eccentricity * sin(x);
-            const double c = _eccentricity * cos(x);
-            const double f = x - s - meanAnomaly;
-            const double f1 = 1 - c;
-            const double f2 = s;
-            return x + (-5 * f / (f1 + sign(f1) *
-                sqrt(std::abs(16 * f1 * f1 - 20 * f * f2))));
-        };
-        return solveIteration(solver, e, 0.0, 8);
-    }
-    else {
-        ghoul_assert(false, "Eccentricity must not be >= 1.0");
-        LERRORC("KeplerTranslation", "Eccentricity must not be >= 1.0");
-        return 0.0;
-    }
+    return kepler::eccentricAnomaly(_eccentricity, meanAnomaly);
 }
 
 glm::dvec3 KeplerTranslation::position(const UpdateData& data) const {
@@ -277,28 +219,11 @@ glm::dvec3 KeplerTranslation::position(const UpdateData& data) const {
 }
 
 void KeplerTranslation::computeOrbitPlane() const {
-    // We assume the following coordinate system:
-    // z = axis of rotation
-    // x = pointing towards the first point of Aries
-    // y completes the righthanded coordinate system
-
-    // Perform three rotations:
-    // 1. Around the z axis to place the location of the ascending node
-    // 2. Around the x axis (now aligned with the ascending node) to get the correct
-    // inclination
-    // 3. Around the new z axis to place the closest approach to the correct location
-
-    const glm::vec3 ascendingNodeAxisRot = glm::vec3(0.f, 0.f, 1.f);
-    const glm::vec3 inclinationAxisRot = glm::vec3(1.f, 0.f, 0.f);
-    const glm::vec3 argPeriapsisAxisRot = glm::vec3(0.f, 0.f, 1.f);
-
-    const double asc = glm::radians(_ascendingNode.value());
-    const double inc = glm::radians(_inclination.value());
-    const double per = glm::radians(_argumentOfPeriapsis.value());
-
-    _orbitPlaneRotation = glm::rotate(asc, glm::dvec3(ascendingNodeAxisRot)) *
-                          glm::rotate(inc, glm::dvec3(inclinationAxisRot)) *
-                          glm::rotate(per, glm::dvec3(argPeriapsisAxisRot));
+    _orbitPlaneRotation = kepler::orbitPlaneRotation(
+        _inclination.value(),
+        _ascendingNode.value(),
+        _argumentOfPeriapsis.value()
+    );
 
     notifyObservers();
     _orbitPlaneDirty = false;
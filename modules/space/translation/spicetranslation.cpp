@@ -92,6 +92,12 @@ namespace {
         // A single kernel or list of kernels that this SpiceTranslation depends on. All
         // provided kernels will be loaded before any other operation is performed
         std::optional<std::variant<std::vector<std::string>, std::string>> kernels;
+
+        // An ephemeris table created by the GenerateEphemerisTableTask for the same
+        // target, observer, and frame. Within the time window of the table, the position
+        // is evaluated from the table, which allows this translation to be updated on a
+        // worker thread. Outside of the window, SPICE is used as usual
+        std::optional<std::filesystem::path> ephemerisTable;
     };
 #include "spicetranslation_codegen.cpp"
 } // namespace
@@ -137,22 +143,39 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
         }
     }
 
-    _target.onChange([this]() {
+    if (p.ephemerisTable.has_value()) {
+        _ephemerisTable = EphemerisTable::load(absPath(p.ephemerisTable->string()));
+        if (_ephemerisTable->nComponents() != 3) {
+            throw ghoul::RuntimeError(fmt::format(
+                "Ephemeris table {} does not contain positions", *p.ephemerisTable
+            ));
+        }
+    }
+    auto updateUseEphemerisTable = [this]() {
+        _useEphemerisTable = _ephemerisTable.has_value() &&
+            _ephemerisTable->identifiers() ==
+            std::vector<std::string>{ _cachedTarget, _cachedObserver, _cachedFrame };
+    };
+
+    _target.onChange([this, updateUseEphemerisTable]() {
         _cachedTarget = _target;
+        updateUseEphemerisTable();
         requireUpdate();
         notifyObservers();
     });
     addProperty(_target);
 
-    _observer.onChange([this]() {
+    _observer.onChange([this, updateUseEphemerisTable]() {
         _cachedObserver = _observer;
+        updateUseEphemerisTable();
         requireUpdate();
         notifyObservers();
     });
     addProperty(_observer);
 
-    _frame.onChange([this]() {
+    _frame.onChange([this, updateUseEphemerisTable]() {
         _cachedFrame = _frame;
+        updateUseEphemerisTable();
         requireUpdate();
         notifyObservers();
     });
@@ -184,15 +207,40 @@ SpiceTranslation::SpiceTranslation(const ghoul::Dictionary& dictionary)
     }
 
     _frame = p.frame.value_or(_frame);
+
+    if (_ephemerisTable.has_value() && !_useEphemerisTable) {
+        LWARNINGC("SpiceTranslation", fmt::format(
+            "Ephemeris table {} was created for a different target, observer, or frame",
+            *p.ephemerisTable
+        ));
+    }
 }
 
-glm::dvec3 SpiceTranslation::position(const UpdateData& data) const {
-    double lightTime = 0.0;
+bool SpiceTranslation::isThreadSafe() const {
+    // CSPICE is not reentrant, so all calls into it have to happen on the main thread.
+    // With an ephemeris table, the calls into CSPICE outside of its window are
+    // serialized instead
+    return _ephemerisTable.has_value();
+}
 
+glm::dvec3 SpiceTranslation::position(const UpdateData& data) const {
     double time = data.time.j2000Seconds();
     if (_fixedEphemerisTime.has_value()) {
         time = *_fixedEphemerisTime;
     }
+
+    if (_useEphemerisTable && _ephemerisTable->contains(time)) {
+        glm::dvec3 position = glm::dvec3(0.0);
+        _ephemerisTable->evaluate(time, std::span<double>(glm::value_ptr(position), 3));
+        return position * 1000.0;
+    }
+
+    std::unique_lock<std::mutex> lock;
+    if (_ephemerisTable.has_value()) {
+        lock = std::unique_lock(cspiceFallbackMutex());
+    }
+
+    double lightTime = 0.0;
     return SpiceManager::ref().targetPosition(
         _cachedTarget,
         _cachedObserver,
@@ -27,6 +27,7 @@
 
 #include <openspace/scene/translation.h>
 
+#include <modules/space/ephemeristable.h>
 #include <openspace/properties/stringproperty.h>
 #include <optional>
 
@@ -37,6 +38,7 @@ public:
     SpiceTranslation(const ghoul::Dictionary& dictionary);
 
     glm::dvec3 position(const UpdateData& data) const override;
+    bool isThreadSafe() const override;
 
     static documentation::Documentation Documentation();
 
@@ -55,6 +57,11 @@ private:
     std::string _cachedFrame;
     std::optional<double> _fixedEphemerisTime;
 
+    // A precomputed table that is used instead of SPICE within its time window. It is
+    // only used while it matches the current target, observer, and frame
+    std::optional<EphemerisTable> _ephemerisTable;
+    bool _useEphemerisTable = false;
+
     glm::dvec3 _position = glm::dvec3(0.0);
 };
 
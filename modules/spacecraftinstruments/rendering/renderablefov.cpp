@@ -35,6 +35,7 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <glm/gtx/projection.hpp>
+#include <cmath>
 #include <optional>
 
 namespace {
@@ -443,42 +444,131 @@ bool RenderableFov::isReady() const {
     return _program != nullptr && !_instrument.bounds.empty();
 }
 
-// Orthogonal projection next to planets surface
-glm::dvec3 RenderableFov::orthogonalProjection(const glm::dvec3& vecFov, double time,
-                                               const std::string& target) const
+RenderableFov::InterceptFrame RenderableFov::interceptFrame(double time,
+                                                          const std::string& target) const
 {
-    const glm::dvec3 vecToTarget = SpiceManager::ref().targetPosition(
+    InterceptFrame frame;
+    frame.instrumentToReference = SpiceManager::ref().frameTransformationMatrix(
+        _instrument.name,
+        _instrument.referenceFrame,
+        time
+    );
+
+    double lightTime = 0.0;
+    frame.targetPosition = SpiceManager::ref().targetPosition(
         target,
         _instrument.spacecraft,
         _instrument.referenceFrame,
         _instrument.aberrationCorrection,
-        time
+        time,
+        lightTime
     );
-    const glm::dvec3 fov = SpiceManager::ref().frameTransformationMatrix(
-        _instrument.name,
-        _instrument.referenceFrame,
-        time
-    ) * vecFov;
-    const glm::dvec3 p = glm::proj(vecToTarget, fov);
+
+    if (SpiceManager::ref().hasValue(target, "RADII")) {
+        glm::dvec3 radii = glm::dvec3(0.0);
+        SpiceManager::ref().getValue(target, "RADII", radii);
+        if (radii.x > 0.0 && radii.y > 0.0 && radii.z > 0.0) {
+            SpacecraftInstrumentsModule* m =
+                global::moduleEngine->module<SpacecraftInstrumentsModule>();
+
+            // Just as SPICE does, the orientation of the target is evaluated at the
+            // time the light left the target
+            frame.radii = radii;
+            frame.referenceToBody = SpiceManager::ref().frameTransformationMatrix(
+                _instrument.referenceFrame,
+                m->frameFromBody(target),
+                time - lightTime
+            );
+        }
+    }
+
+    return frame;
+}
+
+std::optional<glm::dvec3> RenderableFov::surfaceIntercept(const InterceptFrame& frame,
+                                                          const glm::dvec3& bound,
+                                                          double time,
+                                                     const std::string& target) const
+{
+    if (!frame.radii.has_value()) {
+        // Without the radii we can't intersect the ellipsoid ourselves and have to ask
+        // SPICE instead
+        const bool isBodyFixed =
+            _instrument.referenceFrame.find("IAU_") != std::string::npos;
+        SpacecraftInstrumentsModule* m =
+            global::moduleEngine->module<SpacecraftInstrumentsModule>();
+        const std::string ref =
+            isBodyFixed ? _instrument.referenceFrame : m->frameFromBody(target);
+
+        SpiceManager::SurfaceInterceptResult r = SpiceManager::ref().surfaceIntercept(
+            target,
+            _instrument.spacecraft,
+            _instrument.name,
+            ref,
+            _instrument.aberrationCorrection,
+            time,
+            bound
+        );
+        if (!r.interceptFound) {
+            return std::nullopt;
+        }
+
+        // If we had to convert the reference frame into a body-fixed frame, we need to
+        // apply this change here:
+        if (!isBodyFixed) {
+            r.surfaceVector = SpiceManager::ref().frameTransformationMatrix(
+                ref,
+                _instrument.referenceFrame,
+                time
+            ) * r.surfaceVector;
+        }
+
+        // Convert the KM scale that SPICE uses to meter
+        // Standoff distance, we would otherwise end up *exactly* on the surface
+        return r.surfaceVector * 1000.0 * _standOffDistance.value();
+    }
+
+    // Intersect the ray from the spacecraft with the target's ellipsoid. Everything is
+    // scaled by the radii so that the ellipsoid becomes the unit sphere
+    const glm::dvec3 direction = frame.instrumentToReference * bound;
+    const glm::dvec3 o = frame.referenceToBody * -frame.targetPosition / *frame.radii;
+    const glm::dvec3 d = frame.referenceToBody * direction / *frame.radii;
+
+    const double a = glm::dot(d, d);
+    const double b = glm::dot(o, d);
+    const double c = glm::dot(o, o) - 1.0;
+    const double discriminant = b * b - a * c;
+    if (a == 0.0 || c < 0.0 || discriminant < 0.0) {
+        // No intersection or the spacecraft is inside the target
+        return std::nullopt;
+    }
+
+    const double t = (-b - std::sqrt(discriminant)) / a;
+    if (t < 0.0) {
+        // The target is behind the instrument
+        return std::nullopt;
+    }
+
+    // Convert the KM scale that SPICE uses to meter
+    // Standoff distance, we would otherwise end up *exactly* on the surface
+    return direction * t * 1000.0 * _standOffDistance.value();
+}
+
+// Orthogonal projection next to planets surface
+glm::dvec3 RenderableFov::orthogonalProjection(const glm::dvec3& vecFov,
+                                               const InterceptFrame& frame) const
+{
+    const glm::dvec3 fov = frame.instrumentToReference * vecFov;
+    const glm::dvec3 p = glm::proj(frame.targetPosition, fov);
     return p  * 1000.0; // km -> m
 }
 
 void RenderableFov::computeIntercepts(double time, const std::string& target,
                                       bool isInFov)
 {
-    auto makeBodyFixedReferenceFrame =
-        [&target](std::string ref) -> std::pair<std::string, bool>
-    {
-        const bool convert = (ref.find("IAU_") == std::string::npos);
-        if (convert) {
-            SpacecraftInstrumentsModule* m =
-                global::moduleEngine->module<SpacecraftInstrumentsModule>();
-            return { m->frameFromBody(target), true };
-        }
-        else {
-            return { ref, false };
-        }
-    };
+    // The target's position and all frame transformations are the same for every
+    // boundary vector, so we only ask SPICE for them once per frame
+    const InterceptFrame frame = interceptFrame(time, target);
 
     // First we fill the field-of-view bounds array by testing each bounds vector against
     // the object. We need to test it against the object (rather than using a fixed
@@ -499,7 +589,7 @@ void RenderableFov::computeIntercepts(double time, const std::string& target,
         if (!isInFov) {
             // If the target is not in the field of view, we don't need to perform any
             // surface intercepts
-            const glm::vec3 o = orthogonalProjection(bound, time, target);
+            const glm::vec3 o = orthogonalProjection(bound, frame);
 
             second = {
                 .position = { o.x, o.y, o.z },
@@ -509,40 +599,14 @@ void RenderableFov::computeIntercepts(double time, const std::string& target,
         else {
             // The target is in the field of view, but not the entire field of view has to
             // be filled by the target
-            std::pair<std::string, bool> ref = makeBodyFixedReferenceFrame(
-                _instrument.referenceFrame
-            );
+            const std::optional<glm::dvec3> icpt =
+                surfaceIntercept(frame, bound, time, target);
 
-            SpiceManager::SurfaceInterceptResult r = SpiceManager::ref().surfaceIntercept(
-                target,
-                _instrument.spacecraft,
-                _instrument.name,
-                ref.first,
-                _instrument.aberrationCorrection,
-                time,
-                bound
-            );
-
-            if (r.interceptFound) {
+            if (icpt.has_value()) {
                 // This point intersected the target
                 first.color = RenderInformation::VertexColorTypeIntersectionStart;
 
-                // If we had to convert the reference frame into a body-fixed frame, we
-                // need to apply this change here:
-                if (ref.second) {
-                    r.surfaceVector = SpiceManager::ref().frameTransformationMatrix(
-                        ref.first,
-                        _instrument.referenceFrame,
-                        time
-                    ) * r.surfaceVector;
-                }
-
-                // Convert the KM scale that SPICE uses to meter
-                glm::vec3 srfVec = r.surfaceVector * 1000.0;
-
-                // Standoff distance, we would otherwise end up *exactly* on the surface
-                srfVec *= _standOffDistance;
-
+                const glm::vec3 srfVec = *icpt;
                 second = {
                     .position = { srfVec.x, srfVec.y, srfVec.z },
                     .color = RenderInformation::VertexColorTypeIntersectionEnd
@@ -550,7 +614,7 @@ void RenderableFov::computeIntercepts(double time, const std::string& target,
             }
             else {
                 // This point did not intersect the target though others did
-                const glm::vec3 o = orthogonalProjection(bound, time, target);
+                const glm::vec3 o = orthogonalProjection(bound, frame);
                 second = {
                     .position = { o.x, o.y, o.z },
                     .color = RenderInformation::VertexColorTypeInFieldOfView
@@ -592,64 +656,19 @@ void RenderableFov::computeIntercepts(double time, const std::string& target,
             const glm::dvec3& iBound = _instrument.bounds[i];
             const glm::dvec3& jBound = _instrument.bounds[j];
 
-            auto intercepts = [&](const glm::dvec3& probe) -> bool {
-                return SpiceManager::ref().surfaceIntercept(
-                    target,
-                    _instrument.spacecraft,
-                    _instrument.name,
-                    makeBodyFixedReferenceFrame(_instrument.referenceFrame).first,
-                    _instrument.aberrationCorrection,
-                    time,
-                    probe
-                ).interceptFound;
-            };
-
-            // Computes the intercept vector between the 'probe' and the target
-            // the intercept vector is in meter and contains a standoff distance offset
-            auto interceptVector = [&](const glm::dvec3& probe) -> glm::dvec3 {
-                auto ref = makeBodyFixedReferenceFrame(_instrument.referenceFrame);
-                SpiceManager::SurfaceInterceptResult r =
-                    SpiceManager::ref().surfaceIntercept(
-                        target,
-                        _instrument.spacecraft,
-                        _instrument.name,
-                        ref.first,
-                        _instrument.aberrationCorrection,
-                        time,
-                        probe
-                    );
-
-                if (ref.second) {
-                    r.surfaceVector = SpiceManager::ref().frameTransformationMatrix(
-                        ref.first,
-                        _instrument.referenceFrame,
-                        time
-                    ) * r.surfaceVector;
-                }
-
-                // Convert the KM scale that SPICE uses to meter
-                // Standoff distance, we would otherwise end up *exactly* on the surface
-                return r.surfaceVector * 1000.0 * _standOffDistance.value();
-            };
-
             for (size_t m = 0; m < InterpolationSteps; ++m) {
                 const double t = static_cast<double>(m) / (InterpolationSteps);
                 const glm::dvec3 tBound = glm::mix(iBound, jBound, t);
 
-                if (intercepts(tBound)) {
-                    const glm::vec3 icpt = interceptVector(tBound);
-                    _orthogonalPlane.data[indexForBounds(i) + m] = {
-                        .position = { icpt.x, icpt.y, icpt.z },
-                        .color = RenderInformation::VertexColorTypeSquare
-                    };
-                }
-                else {
-                    const glm::vec3 o = orthogonalProjection(tBound, time, target);
-                    _orthogonalPlane.data[indexForBounds(i) + m] = {
-                        .position = { o.x, o.y, o.z },
-                        .color = RenderInformation::VertexColorTypeSquare
-                    };
-                }
+                const std::optional<glm::dvec3> icpt =
+                    surfaceIntercept(frame, tBound, time, target);
+                const glm::vec3 p = icpt.has_value() ?
+                    glm::vec3(*icpt) :
+                    glm::vec3(orthogonalProjection(tBound, frame));
+                _orthogonalPlane.data[indexForBounds(i) + m] = {
+                    .position = { p.x, p.y, p.z },
+                    .color = RenderInformation::VertexColorTypeSquare
+                };
             }
         }
     }
@@ -35,6 +35,7 @@
 #include <ghoul/glm.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <optional>
 
 namespace ghoul::opengl {
     class ProgramObject;
@@ -71,8 +72,26 @@ private:
     void computeIntercepts(double time, const std::string& target,
         bool isInFov);
 
-    glm::dvec3 orthogonalProjection(const glm::dvec3& vecFov, double time,
-        const std::string& target) const;
+    // Values that are shared by all boundary vectors of the instrument in one frame
+    struct InterceptFrame {
+        // Rotation from the instrument frame into the instrument's reference frame
+        glm::dmat3 instrumentToReference = glm::dmat3(1.0);
+        // Position of the target relative to the spacecraft in km
+        glm::dvec3 targetPosition = glm::dvec3(0.0);
+        // Radii of the target's ellipsoid in km, if they are known to SPICE
+        std::optional<glm::dvec3> radii;
+        // Rotation from the reference frame into the target's body-fixed frame
+        glm::dmat3 referenceToBody = glm::dmat3(1.0);
+    };
+    InterceptFrame interceptFrame(double time, const std::string& target) const;
+
+    // Returns the vector from the spacecraft to the point where the \p bound vector
+    // hits the surface of the \p target in meters, including the standoff distance
+    std::optional<glm::dvec3> surfaceIntercept(const InterceptFrame& frame,
+        const glm::dvec3& bound, double time, const std::string& target) const;
+
+    glm::dvec3 orthogonalProjection(const glm::dvec3& vecFov,
+        const InterceptFrame& frame) const;
 
     // properties
     properties::FloatProperty _lineWidth;
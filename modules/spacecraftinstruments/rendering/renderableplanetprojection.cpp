@@ -37,6 +37,8 @@
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureconversion.h>
 #include <ghoul/opengl/textureunit.h>
+#include <algorithm>
+#include <optional>
 
 namespace {
     constexpr std::array<const char*, 12> MainUniformNames = {
@@ -45,11 +47,14 @@ namespace {
         "projectionFading", "baseTexture", "projectionTexture", "heightTexture"
     };
 
-    constexpr std::array<const char*, 6> FboUniformNames = {
-        "projectionTexture", "ProjectorMatrix", "ModelTransform",
-        "boresight", "radius", "segments"
+    constexpr std::array<const char*, 4> FboUniformNames = {
+        "nProjections", "ModelTransform", "radius", "segments"
     };
 
+    // The number of images that are projected in a single pass. This value has to match
+    // the MaxProjections in the renderablePlanetProjection_fs.glsl shader
+    constexpr size_t MaxProjectionsPerPass = 8;
+
     constexpr std::string_view NoImageText = "No Image";
 
     constexpr openspace::properties::Property::PropertyInfo ColorTexturePathsInfo = {
@@ -399,22 +404,39 @@ bool RenderablePlanetProjection::isReady() const {
     return _programObject && _projectionComponent.isReady();
 }
 
-void RenderablePlanetProjection::imageProjectGPU(
-                                          const ghoul::opengl::Texture& projectionTexture,
-                                                         const glm::mat4& projectorMatrix)
-{
+void RenderablePlanetProjection::imageProjectGPU(std::span<const Projection> projections) {
+    ghoul_assert(
+        projections.size() <= MaxProjectionsPerPass,
+        "Too many projections for a single pass"
+    );
+
     _projectionComponent.imageProjectBegin();
 
     _fboProgramObject->activate();
 
-    ghoul::opengl::TextureUnit unitFbo;
-    unitFbo.activate();
-    projectionTexture.bind();
-    _fboProgramObject->setUniform(_fboUniformCache.projectionTexture, unitFbo);
+    std::array<ghoul::opengl::TextureUnit, MaxProjectionsPerPass> units;
+    for (size_t i = 0; i < projections.size(); i++) {
+        units[i].activate();
+        projections[i].texture->bind();
+        _fboProgramObject->setUniform(
+            fmt::format("projectionTextures[{}]", i),
+            units[i]
+        );
+        _fboProgramObject->setUniform(
+            fmt::format("ProjectorMatrices[{}]", i),
+            projections[i].projectorMatrix
+        );
+        _fboProgramObject->setUniform(
+            fmt::format("boresights[{}]", i),
+            projections[i].boresight
+        );
+    }
+    _fboProgramObject->setUniform(
+        _fboUniformCache.nProjections,
+        static_cast<int>(projections.size())
+    );
 
-    _fboProgramObject->setUniform(_fboUniformCache.projectorMatrix, projectorMatrix);
     _fboProgramObject->setUniform(_fboUniformCache.modelTransform, _transform);
-    _fboProgramObject->setUniform(_fboUniformCache.boresight, _boresight);
     _fboProgramObject->setUniform(_fboUniformCache.radius, _radius);
     _fboProgramObject->setUniform(_fboUniformCache.segments, _segments);
 
@@ -481,24 +503,44 @@ void RenderablePlanetProjection::render(const RenderData& data, RendererTasks&)
 
     glm::vec3 up = data.camera.lookUpVectorCameraSpace();
     if (_projectionComponent.doesPerformProjection()) {
-        int nProjections = 0;
+        std::vector<Projection> projections;
+        size_t nImages = 0;
         for (const Image& img : _imageTimes) {
-            if (nProjections >= _maxProjectionsPerFrame) {
+            if (static_cast<int>(nImages) >= _maxProjectionsPerFrame) {
                 break;
             }
+            // Images have to be projected in order, so if the next image is still being
+            // read from disk, all remaining projections are deferred to a later frame
+            if (!_projectionComponent.isProjectionTextureReady(img.path)) {
+                break;
+            }
+            nImages++;
             try {
-                glm::mat4 projectorMatrix = attitudeParameters(img.timeRange.start, up);
-                std::shared_ptr<ghoul::opengl::Texture> t =
-                    _projectionComponent.loadProjectionTexture(img.path);
-                imageProjectGPU(*t, projectorMatrix);
-                ++nProjections;
+                Projection projection;
+                projection.projectorMatrix = attitudeParameters(img.timeRange.start, up);
+                projection.boresight = _boresight;
+                projection.texture = _projectionComponent.loadProjectionTexture(img.path);
+                projections.push_back(std::move(projection));
             }
             catch (const SpiceManager::SpiceException& e) {
                 LERRORC(e.component, e.what());
             }
         }
-        _imageTimes.erase(_imageTimes.begin(), _imageTimes.begin() + nProjections);
+
+        // Project the images in as few passes as possible
+        std::span<const Projection> remaining = projections;
+        while (!remaining.empty()) {
+            const size_t n = std::min(remaining.size(), MaxProjectionsPerPass);
+            imageProjectGPU(remaining.first(n));
+            remaining = remaining.subspan(n);
+        }
+
+        _imageTimes.erase(_imageTimes.begin(), _imageTimes.begin() + nImages);
         _projectionsInBuffer = static_cast<int>(_imageTimes.size());
+
+        if (_imageTimes.empty()) {
+            _projectionComponent.updateCheckpoints(data.time.j2000Seconds());
+        }
     }
     try {
         attitudeParameters(data.time.j2000Seconds(), up);
@@ -605,6 +647,28 @@ void RenderablePlanetProjection::update(const UpdateData& data) {
     const double time = data.time.j2000Seconds();
     const double integrateFromTime = data.previousFrameTime.j2000Seconds();
 
+    // If the time jumped backwards past an image capture, the projection layer is reset
+    // to the latest checkpoint before the new time and the images since then are
+    // projected again
+    if (time < integrateFromTime && ImageSequencer::ref().isReady() &&
+        _projectionComponent.doesPerformProjection() &&
+        ImageSequencer::ref().prevCaptureTime(integrateFromTime) > time)
+    {
+        std::optional<double> checkpoint = _projectionComponent.restoreCheckpoint(time);
+        if (checkpoint.has_value()) {
+            _imageTimes = ImageSequencer::ref().imagePaths(
+                _projectionComponent.projecteeId(),
+                _projectionComponent.instrumentId(),
+                time,
+                *checkpoint
+            );
+            for (const Image& image : _imageTimes) {
+                _projectionComponent.prefetchProjectionTexture(image.path);
+            }
+            _projectionsInBuffer = static_cast<int>(_imageTimes.size());
+        }
+    }
+
     // Only project new images if time changed since last update.
     if (time > integrateFromTime && ImageSequencer::ref().isReady() &&
         _projectionComponent.doesPerformProjection())
@@ -631,7 +695,11 @@ void RenderablePlanetProjection::update(const UpdateData& data) {
                 _imageTimes.erase(it, _imageTimes.end());
             }
 
-            // Now, insert the new images to the buffer
+            // Now, insert the new images to the buffer and start reading them from disk
+            // so that they are available by the time they are projected
+            for (const Image& image : newImageTimes) {
+                _projectionComponent.prefetchProjectionTexture(image.path);
+            }
             _imageTimes.insert(
                 _imageTimes.end(),
                 newImageTimes.begin(),
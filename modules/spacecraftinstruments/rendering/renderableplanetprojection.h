@@ -33,6 +33,7 @@
 #include <openspace/properties/triggerproperty.h>
 #include <openspace/properties/vector/vec3property.h>
 #include <ghoul/opengl/uniformcache.h>
+#include <span>
 
 namespace openspace {
 
@@ -59,13 +60,18 @@ public:
     static documentation::Documentation Documentation();
 
 private:
+    struct Projection {
+        std::shared_ptr<ghoul::opengl::Texture> texture;
+        glm::mat4 projectorMatrix = glm::mat4(1.f);
+        glm::vec3 boresight = glm::vec3(0.f);
+    };
+
     void loadColorTexture();
     void loadHeightTexture();
     void createSphere();
 
     glm::mat4 attitudeParameters(double time, const glm::vec3& up);
-    void imageProjectGPU(const ghoul::opengl::Texture& projectionTexture,
-        const glm::mat4& projectorMatrix);
+    void imageProjectGPU(std::span<const Projection> projections);
 
     ProjectionComponent _projectionComponent;
 
@@ -84,8 +90,7 @@ private:
         projectionFading, baseTexture, projectionTexture, heightTexture)
         _mainUniformCache;
 
-    UniformCache(projectionTexture, projectorMatrix, modelTransform, boresight,
-        radius, segments) _fboUniformCache;
+    UniformCache(nProjections, modelTransform, radius, segments) _fboUniformCache;
 
     std::unique_ptr<ghoul::opengl::Texture> _baseTexture;
     std::unique_ptr<ghoul::opengl::Texture> _heightMapTexture;
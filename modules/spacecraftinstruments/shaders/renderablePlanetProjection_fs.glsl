@@ -31,12 +31,16 @@ in vec2 vs_position;
 layout (location = 0) out vec4 color;
 layout (location = 1) out vec4 stencil;
 
-uniform sampler2D projectionTexture;
-uniform mat4 ProjectorMatrix;
+// Has to match the MaxProjectionsPerPass in renderableplanetprojection.cpp
+const int MaxProjections = 8;
+
+uniform sampler2D projectionTextures[MaxProjections];
+uniform mat4 ProjectorMatrices[MaxProjections];
+uniform vec3 boresights[MaxProjections];
+uniform int nProjections;
 uniform mat4 ModelTransform;
 uniform vec3 radius;
 uniform int segments;
-uniform vec3 boresight;
 
 const float M_PI = 3.14159265358979323846;
 
@@ -66,25 +70,29 @@ void main() {
   vec4 vertex = uvToModel(uv, radius, segments);
 
   vec4 raw_pos = psc_to_meter(vertex, vec2(1.0, 0.0));
-  vec4 projected = ProjectorMatrix * ModelTransform * raw_pos;
+  vec3 normal = normalize((ModelTransform * vec4(vertex.xyz, 0.0)).xyz);
 
-  projected.x /= projected.w;
-  projected.y /= projected.w;
+  color = vec4(0.0);
+  stencil = vec4(0.0);
 
-  projected = projected * 0.5 + vec4(0.5);
+  // The images are sorted by time, so the last image that covers this point is the one
+  // that would have ended up on top if the images were projected one after another
+  for (int i = nProjections - 1; i >= 0; i--) {
+    vec4 projected = ProjectorMatrices[i] * ModelTransform * raw_pos;
 
-  vec3 normal = normalize((ModelTransform * vec4(vertex.xyz, 0.0)).xyz);
+    projected.x /= projected.w;
+    projected.y /= projected.w;
 
-  vec3 v_b = normalize(boresight);
+    projected = projected * 0.5 + vec4(0.5);
 
-  if ((inRange(projected.x, 0.0, 1.0) && inRange(projected.y, 0.0, 1.0)) &&
-      dot(v_b, normal) < 0.0)
-  {
-    color = texture(projectionTexture, vec2(projected.x, projected.y));
-    stencil = vec4(1.0);
-  }
-  else {
-    color = vec4(0.0);
-    stencil = vec4(0.0);
+    vec3 v_b = normalize(boresights[i]);
+
+    if ((inRange(projected.x, 0.0, 1.0) && inRange(projected.y, 0.0, 1.0)) &&
+        dot(v_b, normal) < 0.0)
+    {
+      color = texture(projectionTextures[i], vec2(projected.x, projected.y));
+      stencil = vec4(1.0);
+      break;
+    }
   }
 }
@@ -155,6 +155,21 @@ bool HongKangParser::create() {
         return true;
     }
 
+    std::string settings = fmt::format(
+        "{}|{}|{}", _spacecraft, _metRef, _defaultCaptureImage
+    );
+    for (const std::string& target : _potentialTargets) {
+        settings += ',' + target;
+    }
+    const std::filesystem::path cache = cacheFile(
+        absPath(_fileName),
+        { absPath(_fileName) },
+        settings
+    );
+    if (loadCachedData(cache)) {
+        return true;
+    }
+
     std::ifstream file;
     file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
     file.open(absPath(_fileName));
@@ -273,6 +288,7 @@ bool HongKangParser::create() {
         }
     }
 
+    saveCachedData(cache);
     return true;
 }
 
@@ -28,6 +28,7 @@
 #include <openspace/util/timemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
 
 namespace {
     constexpr std::string_view _loggerCat = "ImageSequencer";
@@ -162,43 +163,45 @@ std::vector<std::pair<std::string, bool>> ImageSequencer::activeInstruments(doub
 
 bool ImageSequencer::isInstrumentActive(double time, const std::string& instrument) const
 {
-    for (const std::pair<std::string, TimeRange>& i : _instrumentTimes) {
-        // check if this instrument is in range
-        if (!i.second.includes(time)) {
-            continue;
-        }
-
-        // if so, then get the corresponding spiceID
-        const std::vector<std::string>& is = _fileTranslation.at(i.first)->translations();
-        // check which specific subinstrument is firing
-        const auto it = std::find(is.begin(), is.end(), instrument);
-        if (it != is.end()) {
-            return true;
-        }
-    }
-    return false;
+    return activeTimeRange(time, instrument) != nullptr;
 }
 
 float ImageSequencer::instrumentActiveTime(double time,
                                            const std::string& instrumentID) const
 {
-    for (const std::pair<std::string, TimeRange>& i : _instrumentTimes) {
-        // check if this instrument is in range
-        if (!i.second.includes(time)) {
-            continue;
+    const TimeRange* range = activeTimeRange(time, instrumentID);
+    if (!range) {
+        return -1.f;
+    }
+    return static_cast<float>((time - range->start) / (range->end - range->start));
+}
+
+const TimeRange* ImageSequencer::activeTimeRange(double time,
+                                                 const std::string& instrument) const
+{
+    const auto it = _instrumentRanges.find(instrument);
+    if (it == _instrumentRanges.end()) {
+        return nullptr;
+    }
+    const InstrumentRanges& ir = it->second;
+
+    // All ranges before this one start before the requested time. Walking backwards,
+    // we can stop as soon as none of the remaining ranges ends after the time
+    const auto first = std::upper_bound(
+        ir.ranges.begin(),
+        ir.ranges.end(),
+        time,
+        [](double t, const TimeRange& range) { return t < range.start; }
+    );
+    for (size_t i = std::distance(ir.ranges.begin(), first); i > 0; i--) {
+        if (ir.latestEnd[i - 1] < time) {
+            break;
         }
-        // if so, then get the corresponding spiceID
-        const std::vector<std::string>& is = _fileTranslation.at(i.first)->translations();
-
-        // check which specific subinstrument is firing
-        const auto it = std::find(is.begin(), is.end(), instrumentID);
-        if (it != is.end()) {
-            return static_cast<float>(
-                (time - i.second.start) / (i.second.end - i.second.start)
-            );
+        if (ir.ranges[i - 1].includes(time)) {
+            return &ir.ranges[i - 1];
         }
     }
-    return -1.f;
+    return nullptr;
 }
 
 std::vector<Image> ImageSequencer::imagePaths(const std::string& projectee,
@@ -315,6 +318,24 @@ void ImageSequencer::sortData() {
             return a.second.start < b.second.start;
         }
     );
+
+    // Build the per-instrument index. As the instrument times are sorted, the ranges for
+    // each instrument end up sorted by their start time as well
+    _instrumentRanges.clear();
+    for (const std::pair<std::string, TimeRange>& i : _instrumentTimes) {
+        const auto it = _fileTranslation.find(i.first);
+        if (it == _fileTranslation.end()) {
+            continue;
+        }
+        for (const std::string& instrument : it->second->translations()) {
+            InstrumentRanges& ir = _instrumentRanges[instrument];
+            const double end = ir.latestEnd.empty() ?
+                i.second.end :
+                std::max(ir.latestEnd.back(), i.second.end);
+            ir.ranges.push_back(i.second);
+            ir.latestEnd.push_back(end);
+        }
+    }
 }
 
 void ImageSequencer::runSequenceParser(SequenceParser& parser) {
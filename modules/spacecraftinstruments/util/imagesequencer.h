@@ -137,6 +137,12 @@ public:
 private:
     void sortData();
 
+    /**
+     * Returns the time range in which the instrument with the SPICE name \p instrument is
+     * active at the provided \p time, or `nullptr` if the instrument is not active.
+     */
+    const TimeRange* activeTimeRange(double time, const std::string& instrument) const;
+
     /**
      * This handles any types of ambiguities between the data and SPICE calls. This map is
      * composed of a key that is a string in the data to be translated and a Decoder that
@@ -172,6 +178,18 @@ private:
      */
     std::vector<std::pair<std::string, TimeRange>> _instrumentTimes;
 
+    /**
+     * The same time ranges as in _instrumentTimes, but keyed by each SPICE instrument
+     * name that the data-file instrument translates to and sorted by their start time.
+     * The latestEnd holds the latest end time of all ranges up to and including each
+     * index, which bounds how far back a search for a range containing a time has to go.
+     */
+    struct InstrumentRanges {
+        std::vector<TimeRange> ranges;
+        std::vector<double> latestEnd;
+    };
+    std::map<std::string, InstrumentRanges> _instrumentRanges;
+
     /**
      * Each consecutive images capture time, for easier traversal.
      */
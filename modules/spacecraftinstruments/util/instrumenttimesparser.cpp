@@ -78,6 +78,20 @@ bool InstrumentTimesParser::create() {
 
     using K = std::string;
     using V = std::vector<std::string>;
+
+    std::string settings = _target;
+    std::vector<std::filesystem::path> files;
+    for (const std::pair<const K, V>& p : _instrumentFiles) {
+        settings += '|' + p.first;
+        for (const std::string& filename : p.second) {
+            files.push_back(sequenceDir / filename);
+        }
+    }
+    const std::filesystem::path cache = cacheFile(sequenceDir, files, settings);
+    if (loadCachedData(cache)) {
+        return true;
+    }
+
     for (const std::pair<const K, V>& p : _instrumentFiles) {
         const std::string& instrumentID = p.first;
         for (std::string filename : p.second) {
@@ -154,6 +168,7 @@ bool InstrumentTimesParser::create() {
         }
     );
 
+    saveCachedData(cache);
     return true;
 }
 
@@ -31,8 +31,10 @@
 #include <ghoul/io/texture/texturereader.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionary.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <set>
 
 namespace {
     constexpr std::string_view _loggerCat = "LabelParser";
@@ -140,14 +142,38 @@ bool LabelParser::create() {
         return false;
     }
 
-    std::string lblName;
     namespace fs = std::filesystem;
+
+    // All files are part of the cache key as the label files refer to the image files
+    std::vector<fs::path> files;
     for (const fs::directory_entry& e : fs::recursive_directory_iterator(sequenceDir)) {
-        if (!e.is_regular_file()) {
-            continue;
+        if (e.is_regular_file()) {
+            files.push_back(e.path());
         }
+    }
+    std::sort(files.begin(), files.end());
+
+    std::string settings;
+    for (const std::string& spec : _specsOfInterest) {
+        settings += spec + ',';
+    }
+    const fs::path cache = cacheFile(sequenceDir, files, settings);
+    if (loadCachedData(cache)) {
+        return true;
+    }
 
-        std::string path = e.path().string();
+    // Looking up the image files that belong to a label in the list of files avoids
+    // asking the file system for every supported extension
+    std::set<std::string> fileNames;
+    for (const fs::path& f : files) {
+        fileNames.insert(f.string());
+    }
+    const std::vector<std::string> extensions =
+        ghoul::io::TextureReader::ref().supportedExtensions();
+
+    std::string lblName;
+    for (const fs::path& f : files) {
+        std::string path = f.string();
 
         size_t position = path.find_last_of('.') + 1;
         if (position == 0 || position == std::string::npos) {
@@ -257,16 +283,13 @@ bool LabelParser::create() {
                 }
             }
             if (count == static_cast<int>(_specsOfInterest.size())) {
-                const std::vector<std::string> extensions =
-                    ghoul::io::TextureReader::ref().supportedExtensions();
-
                 count = 0;
 
                 using namespace std::literals;
                 std::string p = path.substr(0, path.size() - ("lbl"s).size());
                 for (const std::string& ext : extensions) {
                     std::string imagePath = p + ext;
-                    if (std::filesystem::is_regular_file(imagePath)) {
+                    if (fileNames.contains(imagePath)) {
                         std::vector<std::string> spiceInstrument;
                         spiceInstrument.push_back(_instrumentID);
 
@@ -283,10 +306,6 @@ bool LabelParser::create() {
                         _subsetMap[image.target]._range.include(startTime);
 
                         _captureProgression.push_back(startTime);
-                        std::stable_sort(
-                            _captureProgression.begin(),
-                            _captureProgression.end()
-                        );
 
                         break;
                     }
@@ -294,6 +313,7 @@ bool LabelParser::create() {
             }
         } while (!file.eof());
     }
+    std::stable_sort(_captureProgression.begin(), _captureProgression.end());
 
     std::vector<Image> tmp;
     for (const std::pair<const std::string, ImageSubset>& key : _subsetMap) {
@@ -316,21 +336,15 @@ bool LabelParser::create() {
         }
 
         previousTarget = image.target;
+        // The images are sorted by time, so the target times are sorted as well
         _targetTimes.emplace_back(image.timeRange.start , image.target);
-        std::sort(
-            _targetTimes.begin(),
-            _targetTimes.end(),
-            [](const std::pair<double, std::string>& a,
-               const std::pair<double, std::string>& b) -> bool
-            {
-                return a.first < b.first;
-            }
-        );
     }
 
     for (const std::pair<const std::string, ImageSubset>& target : _subsetMap) {
         _instrumentTimes.emplace_back(lblName, _subsetMap[target.first]._range);
     }
+
+    saveCachedData(cache);
     return true;
 }
 
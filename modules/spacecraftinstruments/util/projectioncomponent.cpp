@@ -39,6 +39,10 @@
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/opengl/texture.h>
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
 #include <optional>
 
 namespace {
@@ -92,6 +96,86 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo CheckpointIntervalInfo = {
+        "CheckpointInterval",
+        "Checkpoint Interval",
+        "The minimum simulation time in seconds between two snapshots of the projection "
+        "layer. When the time jumps backwards past an image capture, the latest earlier "
+        "snapshot is restored and only the images after it are projected again. A value "
+        "of 0 disables the snapshots",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo MaxCheckpointsInfo = {
+        "MaxCheckpoints",
+        "Maximum Checkpoints",
+        "The maximum number of snapshots of the projection layer that are kept in "
+        "memory. If there are more, the snapshot that is closest to its predecessor is "
+        "removed",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    // The checkpoints are compressed with a run-length encoding as the projection layer
+    // consists of large areas without any projections. Each block starts with a header
+    // whose highest bit is set if the following single pixel is repeated and unset if
+    // the block consists of the following pixels, and the remaining bits hold the count
+    constexpr uint32_t RepeatFlag = 1u << 31;
+    constexpr uint32_t MaxBlockLength = RepeatFlag - 1;
+
+    std::vector<uint32_t> compress(const std::vector<uint32_t>& pixels) {
+        std::vector<uint32_t> result;
+        size_t i = 0;
+        while (i < pixels.size()) {
+            // Count how often the current pixel is repeated
+            size_t run = 1;
+            while (i + run < pixels.size() && pixels[i + run] == pixels[i] &&
+                   run < MaxBlockLength)
+            {
+                run++;
+            }
+
+            if (run > 2) {
+                result.push_back(RepeatFlag | static_cast<uint32_t>(run));
+                result.push_back(pixels[i]);
+                i += run;
+                continue;
+            }
+
+            // Collect pixels until the next repetition starts
+            size_t end = i;
+            while (end < pixels.size() && end - i < MaxBlockLength &&
+                   !(end + 2 < pixels.size() && pixels[end] == pixels[end + 1] &&
+                     pixels[end] == pixels[end + 2]))
+            {
+                end++;
+            }
+            result.push_back(static_cast<uint32_t>(end - i));
+            result.insert(result.end(), pixels.begin() + i, pixels.begin() + end);
+            i = end;
+        }
+        return result;
+    }
+
+    std::vector<uint32_t> decompress(const std::vector<uint32_t>& data, size_t size) {
+        std::vector<uint32_t> result;
+        result.reserve(size);
+        size_t i = 0;
+        while (i < data.size()) {
+            const uint32_t header = data[i];
+            const uint32_t count = header & MaxBlockLength;
+            if (header & RepeatFlag) {
+                result.insert(result.end(), count, data[i + 1]);
+                i += 2;
+            }
+            else {
+                auto begin = data.begin() + i + 1;
+                result.insert(result.end(), begin, begin + count);
+                i += 1 + count;
+            }
+        }
+        return result;
+    }
+
     struct [[codegen::Dictionary(ProjectionComponent)]] Parameters {
         // This value specifies one or more directories from which images are being used
         // for image projections. If the sequence type is set to 'playbook', this value is
@@ -163,6 +247,12 @@ namespace {
         std::optional<ghoul::Dictionary> dataInputTranslation;
 
         std::optional<ghoul::Dictionary> timesDataInputTranslation;
+
+        // [[codegen::verbatim(CheckpointIntervalInfo.description)]]
+        std::optional<double> checkpointInterval [[codegen::greaterequal(0.0)]];
+
+        // [[codegen::verbatim(MaxCheckpointsInfo.description)]]
+        std::optional<int> maxCheckpoints [[codegen::greater(0)]];
     };
 #include "projectioncomponent_codegen.cpp"
 } // namespace
@@ -180,6 +270,9 @@ ProjectionComponent::ProjectionComponent()
     , _projectionFading(FadingInfo, 1.f, 0.f, 1.f)
     , _textureSize(TextureSizeInfo, glm::ivec2(16), glm::ivec2(16), glm::ivec2(32768))
     , _applyTextureSize(ApplyTextureSizeInfo)
+    , _checkpointInterval(CheckpointIntervalInfo, 0.0, 0.0, 31536000.0)
+    , _maxCheckpoints(MaxCheckpointsInfo, 16, 1, 256)
+    , _imageReadPool(2)
 {
     addProperty(_performProjection);
     addProperty(_clearAllProjections);
@@ -188,6 +281,9 @@ ProjectionComponent::ProjectionComponent()
     addProperty(_textureSize);
     addProperty(_applyTextureSize);
     _applyTextureSize.onChange([this]() { _textureSizeDirty = true; });
+
+    addProperty(_checkpointInterval);
+    addProperty(_maxCheckpoints);
 }
 
 void ProjectionComponent::initialize(const std::string& identifier,
@@ -207,6 +303,8 @@ void ProjectionComponent::initialize(const std::string& identifier,
     _dilation.isEnabled = p.textureMap.value_or(_dilation.isEnabled);
     _shadowing.isEnabled = p.shadowMap.value_or(_shadowing.isEnabled);
     _projectionTextureAspectRatio = p.aspectRatio.value_or(_projectionTextureAspectRatio);
+    _checkpointInterval = p.checkpointInterval.value_or(_checkpointInterval);
+    _maxCheckpoints = p.maxCheckpoints.value_or(_maxCheckpoints);
 
 
     if (!p.sequence.has_value()) {
@@ -656,6 +754,7 @@ void ProjectionComponent::imageProjectEnd() {
     glViewport(_viewport[0], _viewport[1], _viewport[2], _viewport[3]);
 
     _mipMapDirty = true;
+    _hasProjectedSinceCheckpoint = true;
 }
 
 void ProjectionComponent::update() {
@@ -836,6 +935,13 @@ float ProjectionComponent::aspectRatio() const {
 }
 
 void ProjectionComponent::clearAllProjections() {
+    // Images that have been read ahead will not be projected anymore and the
+    // checkpoints would bring back the projections that were just removed
+    _imageReadPool.clearTasks();
+    _prefetchedImages.clear();
+    _checkpoints.clear();
+    _lastCheckpointTime = -std::numeric_limits<double>::max();
+
     // keep handle to the current bound FBO
     GLint defaultFBO;
     glGetIntegerv(GL_FRAMEBUFFER_BINDING, &defaultFBO);
@@ -872,6 +978,111 @@ void ProjectionComponent::generateMipMap() {
     _mipMapDirty = false;
 }
 
+void ProjectionComponent::updateCheckpoints(double time) {
+    if (_checkpointInterval == 0.0 || !_hasProjectedSinceCheckpoint ||
+        std::abs(time - _lastCheckpointTime) < _checkpointInterval)
+    {
+        return;
+    }
+
+    const glm::ivec2 size = glm::ivec2(
+        _projectionTexture->width(),
+        _projectionTexture->height()
+    );
+    std::vector<uint32_t> pixels(static_cast<size_t>(size.x) * size.y);
+    _projectionTexture->bind();
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    _checkpoints[time] = { size, compress(pixels) };
+    _lastCheckpointTime = time;
+    _hasProjectedSinceCheckpoint = false;
+
+    // Remove the checkpoint that is closest to its predecessor to keep the remaining
+    // ones spread out over the mission
+    while (_checkpoints.size() > static_cast<size_t>(_maxCheckpoints)) {
+        auto closest = std::next(_checkpoints.begin());
+        for (auto it = closest; it != _checkpoints.end(); it++) {
+            if (it->first - std::prev(it)->first <
+                closest->first - std::prev(closest)->first)
+            {
+                closest = it;
+            }
+        }
+        _checkpoints.erase(closest);
+    }
+}
+
+std::optional<double> ProjectionComponent::restoreCheckpoint(double time) {
+    // Find the latest checkpoint that is not later than the requested time
+    auto it = _checkpoints.upper_bound(time);
+    if (it == _checkpoints.begin()) {
+        return std::nullopt;
+    }
+    it = std::prev(it);
+
+    const Checkpoint& checkpoint = it->second;
+    const glm::ivec2 size = glm::ivec2(
+        _projectionTexture->width(),
+        _projectionTexture->height()
+    );
+    if (checkpoint.size != size) {
+        // The projection texture has been resized since this checkpoint was taken
+        _checkpoints.erase(it);
+        return std::nullopt;
+    }
+
+    // Images that have been read ahead belong to the time before the jump
+    _imageReadPool.clearTasks();
+    _prefetchedImages.clear();
+
+    std::vector<uint32_t> pixels = decompress(
+        checkpoint.data,
+        static_cast<size_t>(size.x) * size.y
+    );
+
+    // Going through the regular projection steps applies the dilation to the restored
+    // projection layer
+    imageProjectBegin();
+
+    _projectionTexture->bind();
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0, 0,
+        size.x, size.y,
+        GL_RGBA,
+        GL_UNSIGNED_BYTE,
+        pixels.data()
+    );
+
+    if (_dilation.isEnabled) {
+        // Every pixel that has received a projection is opaque, which is what the
+        // stencil texture records
+        std::vector<GLubyte> stencil(pixels.size());
+        for (size_t i = 0; i < pixels.size(); i++) {
+            stencil[i] = reinterpret_cast<const GLubyte*>(&pixels[i])[3] > 0 ? 255 : 0;
+        }
+        _dilation.stencilTexture->bind();
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(
+            GL_TEXTURE_2D,
+            0,
+            0, 0,
+            size.x, size.y,
+            GL_RED,
+            GL_UNSIGNED_BYTE,
+            stencil.data()
+        );
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    imageProjectEnd();
+
+    _lastCheckpointTime = it->first;
+    _hasProjectedSinceCheckpoint = false;
+    return it->first;
+}
+
 std::shared_ptr<ghoul::opengl::Texture> ProjectionComponent::loadProjectionTexture(
                                                            const std::string& texturePath,
                                                            bool isPlaceholder)
@@ -882,10 +1093,38 @@ std::shared_ptr<ghoul::opengl::Texture> ProjectionComponent::loadProjectionTextu
         return _placeholderTexture;
     }
 
-    std::unique_ptr<Texture> texture = ghoul::io::TextureReader::ref().loadTexture(
-        absPath(texturePath).string(),
-        2
-    );
+    std::unique_ptr<Texture> texture;
+    auto it = _prefetchedImages.find(texturePath);
+    if (it != _prefetchedImages.end()) {
+        std::vector<char> buffer = it->second.get();
+        _prefetchedImages.erase(it);
+
+        if (!buffer.empty()) {
+            std::string format = absPath(texturePath).extension().string();
+            if (!format.empty()) {
+                // Remove the leading '.'
+                format = format.substr(1);
+            }
+            std::transform(
+                format.begin(), format.end(),
+                format.begin(),
+                [](char c) { return static_cast<char>(std::tolower(c)); }
+            );
+            texture = ghoul::io::TextureReader::ref().loadTexture(
+                buffer.data(),
+                buffer.size(),
+                2,
+                format
+            );
+        }
+    }
+
+    if (!texture) {
+        texture = ghoul::io::TextureReader::ref().loadTexture(
+            absPath(texturePath).string(),
+            2
+        );
+    }
     if (texture) {
         if (texture->format() == Texture::Format::Red) {
             ghoul::opengl::convertTextureFormat(*texture, Texture::Format::RGB);
@@ -899,6 +1138,37 @@ std::shared_ptr<ghoul::opengl::Texture> ProjectionComponent::loadProjectionTextu
     return texture;
 }
 
+void ProjectionComponent::prefetchProjectionTexture(const std::string& texturePath) {
+    if (_prefetchedImages.find(texturePath) != _prefetchedImages.end()) {
+        return;
+    }
+
+    auto promise = std::make_shared<std::promise<std::vector<char>>>();
+    _prefetchedImages[texturePath] = promise->get_future();
+
+    std::filesystem::path path = absPath(texturePath);
+    _imageReadPool.enqueue([promise, path]() {
+        // An empty buffer makes loadProjectionTexture fall back to reading the file
+        // itself, which also takes care of reporting the error
+        std::vector<char> buffer;
+        std::ifstream file(path, std::ifstream::binary | std::ifstream::ate);
+        if (file.good()) {
+            buffer.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            if (!file.read(buffer.data(), buffer.size())) {
+                buffer.clear();
+            }
+        }
+        promise->set_value(std::move(buffer));
+    });
+}
+
+bool ProjectionComponent::isProjectionTextureReady(const std::string& texturePath) const {
+    auto it = _prefetchedImages.find(texturePath);
+    return it == _prefetchedImages.end() ||
+        it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
 bool ProjectionComponent::generateProjectionLayerTexture(const glm::ivec2& size) {
     LINFO(fmt::format("Creating projection texture of size '{}, {}'", size.x, size.y));
 
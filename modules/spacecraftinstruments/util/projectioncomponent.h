@@ -29,10 +29,17 @@
 
 #include <openspace/properties/triggerproperty.h>
 #include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/vector/ivec2property.h>
 #include <openspace/util/spicemanager.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <future>
+#include <limits>
+#include <map>
+#include <optional>
 
 namespace ghoul { class Dictionary; }
 namespace ghoul::opengl {
@@ -68,6 +75,19 @@ public:
     std::shared_ptr<ghoul::opengl::Texture> loadProjectionTexture(
         const std::string& texturePath, bool isPlaceholder = false);
 
+    /**
+     * Starts reading the image file at \p texturePath into memory on a worker thread, so
+     * that a later call to #loadProjectionTexture for the same file only has to decode
+     * and upload the image instead of waiting for the disk.
+     */
+    void prefetchProjectionTexture(const std::string& texturePath);
+
+    /**
+     * Returns `true` if calling #loadProjectionTexture for \p texturePath will not wait
+     * for a file that is still being read by #prefetchProjectionTexture.
+     */
+    bool isProjectionTextureReady(const std::string& texturePath) const;
+
     glm::mat4 computeProjectorMatrix(const glm::vec3 loc, glm::dvec3 aim,
         const glm::vec3 up, const glm::dmat3& instrumentMatrix, float fieldOfViewY,
         float aspectRatio, float nearPlane, float farPlane, glm::vec3& boreSight);
@@ -82,6 +102,22 @@ public:
     void clearAllProjections();
     void generateMipMap();
 
+    /**
+     * Stores a compressed snapshot of the projection layer as the state at the simulation
+     * \p time if images have been projected since the last checkpoint and that
+     * checkpoint is at least the checkpoint interval away from \p time. This function
+     * must only be called when all images up to \p time have been projected.
+     */
+    void updateCheckpoints(double time);
+
+    /**
+     * Restores the projection layer from the latest checkpoint that is not later than
+     * \p time and returns the time of that checkpoint. The images between the returned
+     * time and \p time have to be projected again by the caller. If there is no such
+     * checkpoint, the projection layer is not changed and `std::nullopt` is returned.
+     */
+    std::optional<double> restoreCheckpoint(double time);
+
     ghoul::opengl::Texture& projectionTexture() const;
 
     std::string projectorId() const;
@@ -105,12 +141,27 @@ protected:
 
     properties::IVec2Property _textureSize;
     properties::TriggerProperty _applyTextureSize;
+    properties::DoubleProperty _checkpointInterval;
+    properties::IntProperty _maxCheckpoints;
     bool _textureSizeDirty = false;
     bool _mipMapDirty = false;
 
     std::unique_ptr<ghoul::opengl::Texture> _projectionTexture;
     std::shared_ptr<ghoul::opengl::Texture> _placeholderTexture;
 
+    // The contents of the image files that are read ahead of their projection
+    ThreadPool _imageReadPool;
+    std::map<std::string, std::future<std::vector<char>>> _prefetchedImages;
+
+    // Run-length encoded snapshots of the projection layer keyed by simulation time
+    struct Checkpoint {
+        glm::ivec2 size = glm::ivec2(0);
+        std::vector<uint32_t> data;
+    };
+    std::map<double, Checkpoint> _checkpoints;
+    double _lastCheckpointTime = -std::numeric_limits<double>::max();
+    bool _hasProjectedSinceCheckpoint = false;
+
     float _projectionTextureAspectRatio = 1.f;
 
     std::string _instrumentID;
@@ -26,7 +26,48 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/util/spicemanager.h>
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
+#include <fstream>
+#include <functional>
+
+namespace {
+    constexpr int8_t CacheFileVersion = 1;
+
+    template <typename T>
+    void write(std::ofstream& file, const T& value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write(std::ofstream& file, const std::string& value) {
+        const uint32_t size = static_cast<uint32_t>(value.size());
+        write(file, size);
+        file.write(value.data(), size);
+    }
+
+    void write(std::ofstream& file, const openspace::TimeRange& value) {
+        write(file, value.start);
+        write(file, value.end);
+    }
+
+    template <typename T>
+    void read(std::ifstream& file, T& value) {
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    void read(std::ifstream& file, std::string& value) {
+        uint32_t size = 0;
+        read(file, size);
+        value.resize(size);
+        file.read(value.data(), size);
+    }
+
+    void read(std::ifstream& file, openspace::TimeRange& value) {
+        read(file, value.start);
+        read(file, value.end);
+    }
+} // namespace
 
 namespace openspace {
 
@@ -51,4 +92,149 @@ std::map<std::string, std::unique_ptr<Decoder>>& SequenceParser::translations()
     return _fileTranslation;
 }
 
+std::filesystem::path SequenceParser::cacheFile(const std::filesystem::path& source,
+                                     const std::vector<std::filesystem::path>& files,
+                                                std::string_view settings) const
+{
+    std::string key = std::string(settings);
+    for (const std::pair<const std::string, std::unique_ptr<Decoder>>& t :
+         _fileTranslation)
+    {
+        key += '|' + t.first;
+        for (const std::string& translation : t.second->translations()) {
+            key += ',' + translation;
+        }
+    }
+    for (const std::filesystem::path& f : files) {
+        std::error_code ec;
+        const uintmax_t size = std::filesystem::file_size(f, ec);
+        const auto time = std::filesystem::last_write_time(f, ec).time_since_epoch();
+        key += fmt::format("|{}:{}:{}", f, size, time.count());
+    }
+
+    return FileSys.cacheManager()->cachedFilename(
+        source,
+        fmt::format("{:x}", std::hash<std::string>()(key))
+    );
+}
+
+bool SequenceParser::loadCachedData(const std::filesystem::path& file) {
+    std::ifstream stream(file, std::ifstream::binary);
+    if (!stream.good()) {
+        return false;
+    }
+
+    int8_t version = 0;
+    read(stream, version);
+    if (version != CacheFileVersion) {
+        // Incompatible version and we won't be able to read the file
+        return false;
+    }
+
+    std::map<std::string, ImageSubset> subsetMap;
+    uint32_t nSubsets = 0;
+    read(stream, nSubsets);
+    for (uint32_t i = 0; i < nSubsets; i++) {
+        std::string target;
+        read(stream, target);
+        ImageSubset& subset = subsetMap[target];
+        read(stream, subset._range);
+
+        uint32_t nImages = 0;
+        read(stream, nImages);
+        subset._subset.resize(nImages);
+        for (Image& image : subset._subset) {
+            read(stream, image.timeRange);
+            read(stream, image.path);
+            uint32_t nInstruments = 0;
+            read(stream, nInstruments);
+            image.activeInstruments.resize(nInstruments);
+            for (std::string& instrument : image.activeInstruments) {
+                read(stream, instrument);
+            }
+            read(stream, image.target);
+            read(stream, image.isPlaceholder);
+        }
+    }
+
+    std::vector<std::pair<std::string, TimeRange>> instrumentTimes;
+    uint32_t nInstrumentTimes = 0;
+    read(stream, nInstrumentTimes);
+    instrumentTimes.resize(nInstrumentTimes);
+    for (std::pair<std::string, TimeRange>& i : instrumentTimes) {
+        read(stream, i.first);
+        read(stream, i.second);
+    }
+
+    std::vector<std::pair<double, std::string>> targetTimes;
+    uint32_t nTargetTimes = 0;
+    read(stream, nTargetTimes);
+    targetTimes.resize(nTargetTimes);
+    for (std::pair<double, std::string>& t : targetTimes) {
+        read(stream, t.first);
+        read(stream, t.second);
+    }
+
+    std::vector<double> captureProgression;
+    uint32_t nCaptures = 0;
+    read(stream, nCaptures);
+    captureProgression.resize(nCaptures);
+    stream.read(
+        reinterpret_cast<char*>(captureProgression.data()),
+        nCaptures * sizeof(double)
+    );
+
+    if (!stream.good()) {
+        return false;
+    }
+
+    _subsetMap = std::move(subsetMap);
+    _instrumentTimes = std::move(instrumentTimes);
+    _targetTimes = std::move(targetTimes);
+    _captureProgression = std::move(captureProgression);
+    return true;
+}
+
+void SequenceParser::saveCachedData(const std::filesystem::path& file) const {
+    std::ofstream stream(file, std::ofstream::binary);
+
+    write(stream, CacheFileVersion);
+
+    write(stream, static_cast<uint32_t>(_subsetMap.size()));
+    for (const std::pair<const std::string, ImageSubset>& subset : _subsetMap) {
+        write(stream, subset.first);
+        write(stream, subset.second._range);
+
+        write(stream, static_cast<uint32_t>(subset.second._subset.size()));
+        for (const Image& image : subset.second._subset) {
+            write(stream, image.timeRange);
+            write(stream, image.path);
+            write(stream, static_cast<uint32_t>(image.activeInstruments.size()));
+            for (const std::string& instrument : image.activeInstruments) {
+                write(stream, instrument);
+            }
+            write(stream, image.target);
+            write(stream, image.isPlaceholder);
+        }
+    }
+
+    write(stream, static_cast<uint32_t>(_instrumentTimes.size()));
+    for (const std::pair<std::string, TimeRange>& i : _instrumentTimes) {
+        write(stream, i.first);
+        write(stream, i.second);
+    }
+
+    write(stream, static_cast<uint32_t>(_targetTimes.size()));
+    for (const std::pair<double, std::string>& t : _targetTimes) {
+        write(stream, t.first);
+        write(stream, t.second);
+    }
+
+    write(stream, static_cast<uint32_t>(_captureProgression.size()));
+    stream.write(
+        reinterpret_cast<const char*>(_captureProgression.data()),
+        _captureProgression.size() * sizeof(double)
+    );
+}
+
 } // namespace openspace
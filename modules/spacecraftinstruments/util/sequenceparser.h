@@ -28,6 +28,7 @@
 #include <modules/spacecraftinstruments/util/decoder.h>
 #include <modules/spacecraftinstruments/util/image.h>
 #include <openspace/util/timerange.h>
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <string>
@@ -47,6 +48,26 @@ public:
     const std::vector<double>& captureProgression() const;
 
 protected:
+    /**
+     * Returns the path of the file in which the data parsed from the input \p files is
+     * cached. The path depends on the \p source, the names, sizes, and modification
+     * times of all \p files, the translations of this parser, and the parser specific
+     * \p settings, so that a change to any of them results in a different cache file.
+     */
+    std::filesystem::path cacheFile(const std::filesystem::path& source,
+        const std::vector<std::filesystem::path>& files, std::string_view settings) const;
+
+    /**
+     * Replaces the parsed data with the content of the cache \p file. Returns `false` if
+     * the file does not exist or is not compatible, in which case the data is untouched.
+     */
+    bool loadCachedData(const std::filesystem::path& file);
+
+    /**
+     * Stores the parsed data in the cache \p file.
+     */
+    void saveCachedData(const std::filesystem::path& file) const;
+
     std::map<std::string, ImageSubset> _subsetMap;
     std::vector<std::pair<std::string, TimeRange>> _instrumentTimes;
     std::vector<std::pair<double, std::string>> _targetTimes;
@@ -0,0 +1,282 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/sync/contentstore.h>
+
+#include <openspace/json.h>
+#include <openspace/util/stablehash.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <fstream>
+
+namespace {
+    constexpr std::string_view _loggerCat = "ContentStore";
+
+    // Returns the key of the blob that stores the contents of the provided file. The
+    // key is made up of a stable hash of the contents and the size of the file
+    std::optional<std::string> hashFile(const std::filesystem::path& file) {
+        const std::optional<openspace::StableFileHash> hash =
+            openspace::stableHashFile(file);
+        if (!hash.has_value()) {
+            return std::nullopt;
+        }
+        return fmt::format("{:016x}-{}", hash->hash, hash->size);
+    }
+
+    // Returns the time of the last modification of the file or 0 if it can't be read
+    int64_t modificationTime(const std::filesystem::path& file) {
+        std::error_code ec;
+        const std::filesystem::file_time_type time =
+            std::filesystem::last_write_time(file, ec);
+        return ec ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    // Creates the destination as a hard link to the blob and falls back to copying the
+    // blob if the file system does not support hard links
+    bool linkBlob(const std::filesystem::path& blob,
+                  const std::filesystem::path& destination)
+    {
+        std::error_code ec;
+        std::filesystem::create_hard_link(blob, destination, ec);
+        if (!ec) {
+            return true;
+        }
+
+        std::filesystem::copy_file(blob, destination, ec);
+        if (ec) {
+            LERROR(fmt::format(
+                "Error creating file {} from {}: {}", destination, blob, ec.message()
+            ));
+            return false;
+        }
+        return true;
+    }
+} // namespace
+
+namespace openspace {
+
+ContentStore::ContentStore(std::filesystem::path root)
+    : _root(std::move(root))
+{
+    std::filesystem::create_directories(_root);
+}
+
+ContentStore::Manifest ContentStore::addDirectory(const std::filesystem::path& directory)
+{
+    Manifest manifest;
+    if (!std::filesystem::is_directory(directory)) {
+        return manifest;
+    }
+
+    namespace fs = std::filesystem;
+    for (const fs::directory_entry& e : fs::recursive_directory_iterator(directory)) {
+        if (!e.is_regular_file()) {
+            continue;
+        }
+
+        std::optional<Entry> entry = add(e.path());
+        if (entry.has_value()) {
+            entry->path = fs::relative(e.path(), directory);
+            // The file might have been replaced by a link, which has the modification
+            // time of the blob
+            entry->modificationTime = modificationTime(e.path());
+            manifest.push_back(std::move(*entry));
+        }
+    }
+    return manifest;
+}
+
+std::optional<ContentStore::Entry> ContentStore::add(const std::filesystem::path& file) {
+    std::optional<std::string> hash = hashFile(file);
+    if (!hash.has_value()) {
+        LWARNING(fmt::format("Could not read file {}", file));
+        return std::nullopt;
+    }
+
+    Entry entry;
+    entry.hash = *hash;
+    entry.size = std::filesystem::file_size(file);
+
+    const std::filesystem::path blob = blobPath(entry.hash);
+
+    std::lock_guard lock(_mutex);
+    std::error_code ec;
+    if (std::filesystem::exists(blob)) {
+        if (std::filesystem::equivalent(file, blob, ec)) {
+            // The file is already linked to its blob
+            return entry;
+        }
+        // Another synchronization has already stored the same contents, so we replace
+        // our copy with a link to the existing blob
+        std::filesystem::remove(file, ec);
+    }
+    else {
+        std::filesystem::create_directories(blob.parent_path(), ec);
+        std::filesystem::rename(file, blob, ec);
+        if (ec) {
+            // The store might live on a different volume than the synchronization, in
+            // which case the file can not be moved. It is still usable where it is
+            LWARNING(fmt::format(
+                "Could not move file {} into the content store: {}", file, ec.message()
+            ));
+            return entry;
+        }
+    }
+
+    if (!linkBlob(blob, file)) {
+        return std::nullopt;
+    }
+    return entry;
+}
+
+bool ContentStore::validate(const Manifest& manifest,
+                            const std::filesystem::path& directory)
+{
+    bool isValid = true;
+    for (const Entry& entry : manifest) {
+        const std::filesystem::path file = directory / entry.path;
+
+        std::error_code ec;
+        const uintmax_t size = std::filesystem::file_size(file, ec);
+        if (!ec && size == entry.size) {
+            // Manifests from older versions did not store the modification time
+            const int64_t time = modificationTime(file);
+            if (entry.modificationTime == 0 || time == entry.modificationTime) {
+                continue;
+            }
+
+            // The file was touched, but that does not mean that its contents changed
+            if (hashFile(file) == entry.hash) {
+                continue;
+            }
+        }
+
+        if (restore(entry.hash, file)) {
+            LINFO(fmt::format("Restored file {} from the content store", file));
+        }
+        else {
+            isValid = false;
+        }
+    }
+    return isValid;
+}
+
+bool ContentStore::restore(const std::string& hash,
+                           const std::filesystem::path& destination)
+{
+    const std::filesystem::path blob = blobPath(hash);
+    if (!std::filesystem::is_regular_file(blob)) {
+        return false;
+    }
+
+    // If the file was modified in place, the blob that it is linked to has changed too
+    const std::optional<std::string> blobHash = hashFile(blob);
+
+    std::lock_guard lock(_mutex);
+    std::error_code ec;
+    if (blobHash != hash) {
+        LWARNING(fmt::format("Removing modified blob {} from the content store", blob));
+        std::filesystem::remove(blob, ec);
+        return false;
+    }
+
+    std::filesystem::remove(destination, ec);
+    std::filesystem::create_directories(destination.parent_path(), ec);
+    return linkBlob(blob, destination);
+}
+
+std::filesystem::path ContentStore::blobPath(const std::string& hash) const {
+    return _root / hash.substr(0, 2) / hash;
+}
+
+std::filesystem::path ContentStore::manifestPath(const std::filesystem::path& directory)
+{
+    std::filesystem::path path = directory;
+    path.replace_extension("osmanifest");
+    return path;
+}
+
+std::optional<ContentStore::Manifest> ContentStore::loadManifest(
+                                                        const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    if (!file.good()) {
+        return std::nullopt;
+    }
+
+    nlohmann::json json = nlohmann::json::parse(file, nullptr, false);
+    if (json.is_discarded() || !json.contains("files")) {
+        LWARNING(fmt::format("Ignoring malformed manifest {}", path));
+        return std::nullopt;
+    }
+
+    try {
+        Manifest manifest;
+        for (const nlohmann::json& f : json["files"]) {
+            Entry entry;
+            entry.path = std::filesystem::path(f["path"].get<std::string>());
+            entry.hash = f["hash"].get<std::string>();
+            entry.size = f["size"].get<uint64_t>();
+            entry.modificationTime = f.value("modificationTime", int64_t(0));
+            entry.url = f.value("url", "");
+            entry.etag = f.value("etag", "");
+            entry.lastModified = f.value("lastModified", "");
+            manifest.push_back(std::move(entry));
+        }
+        return manifest;
+    }
+    catch (const nlohmann::json::exception& e) {
+        LWARNING(fmt::format("Ignoring malformed manifest {}: {}", path, e.what()));
+        return std::nullopt;
+    }
+}
+
+void ContentStore::saveManifest(const Manifest& manifest,
+                                const std::filesystem::path& path)
+{
+    nlohmann::json files = nlohmann::json::array();
+    for (const Entry& entry : manifest) {
+        nlohmann::json f = {
+            { "path", entry.path.generic_string() },
+            { "hash", entry.hash },
+            { "size", entry.size },
+            { "modificationTime", entry.modificationTime }
+        };
+        if (!entry.url.empty()) {
+            f["url"] = entry.url;
+        }
+        if (!entry.etag.empty()) {
+            f["etag"] = entry.etag;
+        }
+        if (!entry.lastModified.empty()) {
+            f["lastModified"] = entry.lastModified;
+        }
+        files.push_back(std::move(f));
+    }
+
+    std::ofstream file(path);
+    file << nlohmann::json({ { "files", files } }).dump(2);
+}
+
+} // namespace openspace
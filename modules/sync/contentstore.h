@@ -0,0 +1,144 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_SYNC___CONTENTSTORE___H__
+#define __OPENSPACE_MODULE_SYNC___CONTENTSTORE___H__
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * A content-addressed store for the files downloaded by the resource synchronizations.
+ * Every file is stored once as a blob that is named after a hash of its contents and its
+ * size. The files in the synchronization directories are hard links to these blobs, so
+ * a file that is used by multiple synchronizations, or by multiple versions of the same
+ * synchronization, only takes up space on disk once. If hard links are not supported by
+ * the file system, the blob is copied instead.
+ *
+ * In addition to the blobs, each synchronization stores a Manifest next to its directory
+ * that lists all files of the synchronization together with their hashes. When starting,
+ * a synchronization compares its directory against the manifest and restores missing or
+ * modified files from the store rather than downloading them again. The manifest also
+ * records the URL and the cache validators of each file, so that later synchronizations
+ * can request only those files that have changed.
+ *
+ * The hash is not cryptographically secure. It only serves to identify identical files
+ * that were downloaded by the application, not to protect against tampering.
+ */
+class ContentStore {
+public:
+    /// Information about a single file of a synchronization
+    struct Entry {
+        /// The path of the file relative to the synchronization's directory
+        std::filesystem::path path;
+
+        /// The key of the blob that contains the contents of the file
+        std::string hash;
+
+        /// The size of the file in bytes
+        uint64_t size = 0;
+
+        /// The time of the last modification of the file in ticks of the file clock, or
+        /// 0 if it is not known
+        int64_t modificationTime = 0;
+
+        /// The URL from which the file was downloaded, if it is known
+        std::string url;
+
+        /// The `ETag` header of the response that the file was downloaded with
+        std::string etag;
+
+        /// The `Last-Modified` header of the response that the file was downloaded with
+        std::string lastModified;
+    };
+
+    /// The list of all files that make up one synchronization
+    using Manifest = std::vector<Entry>;
+
+    /**
+     * Creates a store that keeps its blobs in the \p root folder, which is created if it
+     * does not exist.
+     */
+    explicit ContentStore(std::filesystem::path root);
+
+    /**
+     * Moves all files in the \p directory into the store, replaces them with links to
+     * their blobs, and returns the manifest describing them. Files that are already
+     * linked to a blob are only hashed. This function can be called from multiple
+     * threads at the same time.
+     */
+    Manifest addDirectory(const std::filesystem::path& directory);
+
+    /**
+     * Checks whether all files of the \p manifest exist in the \p directory with the
+     * expected size and modification time. If the modification time differs, the file is
+     * hashed to find out whether its contents have changed. Files that are missing or
+     * have changed are restored from the store if their blob is available.
+     *
+     * \return `true` if the \p directory contains all files of the \p manifest after
+     *         this call, `false` if at least one file could not be restored
+     */
+    bool validate(const Manifest& manifest, const std::filesystem::path& directory);
+
+    /**
+     * Creates the file at \p destination with the contents of the blob with the provided
+     * \p hash. An existing file at \p destination is replaced. As the files are hard
+     * links to their blobs, a file that was modified in place also modifies its blob, so
+     * the blob is hashed first and removed from the store if its contents do not match.
+     *
+     * \return `true` if the blob exists and the file was created, `false` otherwise
+     */
+    bool restore(const std::string& hash, const std::filesystem::path& destination);
+
+    /// Returns the path of the manifest that belongs to the synchronization \p directory
+    static std::filesystem::path manifestPath(const std::filesystem::path& directory);
+
+    /// Loads the manifest at \p path or returns `std::nullopt` if it is not valid
+    static std::optional<Manifest> loadManifest(const std::filesystem::path& path);
+
+    /// Writes the \p manifest to the provided \p path
+    static void saveManifest(const Manifest& manifest, const std::filesystem::path& path);
+
+private:
+    /// Returns the path of the blob with the provided \p hash
+    std::filesystem::path blobPath(const std::string& hash) const;
+
+    /// Moves the \p file into the store and replaces it with a link to its blob
+    std::optional<Entry> add(const std::filesystem::path& file);
+
+    const std::filesystem::path _root;
+
+    /// Prevents multiple synchronizations from moving the same blob at the same time
+    std::mutex _mutex;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SYNC___CONTENTSTORE___H__
@@ -69,6 +69,7 @@ void SyncModule::internalInitialize(const ghoul::Dictionary& configuration) {
     }
 
     _synchronizationRoot = absPath(p.synchronizationRoot);
+    _contentStore = std::make_unique<ContentStore>(_synchronizationRoot / "blobs");
 
     ghoul::TemplateFactory<ResourceSynchronization>* fSynchronization =
         FactoryManager::ref().factory<ResourceSynchronization>();
@@ -82,14 +83,16 @@ void SyncModule::internalInitialize(const ghoul::Dictionary& configuration) {
                 return new (ptr) HttpSynchronization(
                     dictionary,
                     _synchronizationRoot,
-                    _synchronizationRepositories
+                    _synchronizationRepositories,
+                    _contentStore.get()
                 );
             }
             else {
                 return new HttpSynchronization(
                     dictionary,
                     _synchronizationRoot,
-                    _synchronizationRepositories
+                    _synchronizationRepositories,
+                    _contentStore.get()
                 );
             }
         }
@@ -100,10 +103,18 @@ void SyncModule::internalInitialize(const ghoul::Dictionary& configuration) {
         [this](bool, const ghoul::Dictionary& dictionary, ghoul::MemoryPoolBase* pool) {
             if (pool) {
                 void* ptr = pool->allocate(sizeof(UrlSynchronization));
-                return new (ptr) UrlSynchronization(dictionary, _synchronizationRoot);
+                return new (ptr) UrlSynchronization(
+                    dictionary,
+                    _synchronizationRoot,
+                    _contentStore.get()
+                );
             }
             else {
-                return new UrlSynchronization(dictionary, _synchronizationRoot);
+                return new UrlSynchronization(
+                    dictionary,
+                    _synchronizationRoot,
+                    _contentStore.get()
+                );
             }
         }
     );
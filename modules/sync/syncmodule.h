@@ -27,7 +27,9 @@
 
 #include <openspace/util/openspacemodule.h>
 
+#include <modules/sync/contentstore.h>
 #include <filesystem>
+#include <memory>
 
 namespace openspace {
 
@@ -49,6 +51,7 @@ protected:
 private:
     std::vector<std::string> _synchronizationRepositories;
     std::filesystem::path _synchronizationRoot;
+    std::unique_ptr<ContentStore> _contentStore;
 };
 
 } // namespace openspace
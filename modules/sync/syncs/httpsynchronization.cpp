@@ -24,11 +24,17 @@
 
 #include <modules/sync/syncs/httpsynchronization.h>
 
+#include <modules/sync/contentstore.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/openspaceengine.h>
 #include <openspace/util/httprequest.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/ext/assimp/contrib/zip/src/zip.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <algorithm>
 #include <unordered_map>
 
 namespace {
@@ -55,6 +61,112 @@ namespace {
         std::optional<std::string> unzipFilesDestination;
     };
 #include "httpsynchronization_codegen.cpp"
+
+    // Extracts all entries of the zip file at the source into the destination folder.
+    // The entries are distributed over multiple threads, each of which decompresses
+    // through its own handle to the archive
+    bool extractZip(const std::string& source, const std::filesystem::path& destination) {
+        zip_t* z = zip_open(source.c_str(), 0, 'r');
+        if (!z) {
+            LERROR(fmt::format("Error opening {}", source));
+            return false;
+        }
+        const int nEntries = zip_total_entries(z);
+        zip_close(z);
+        if (nEntries < 0) {
+            LERROR(fmt::format("Error {} while reading entries of {}", nEntries, source));
+            return false;
+        }
+
+        // Every job opens the archive on its own and extracts every nJobs-th entry, so
+        // there is one job for each thread that can take part in the work
+        openspace::ThreadPool& pool = openspace::global::openSpaceEngine->threadPool();
+        const int nJobs = std::clamp(
+            static_cast<int>(pool.numberOfThreads()) + 1,
+            1,
+            std::max(nEntries, 1)
+        );
+
+        const std::filesystem::path root = destination.lexically_normal();
+        std::atomic_bool success = true;
+        auto extractEntries = [&](int first) {
+            zip_t* zip = zip_open(source.c_str(), 0, 'r');
+            if (!zip) {
+                success = false;
+                return;
+            }
+
+            for (int i = first; i < nEntries && success; i += nJobs) {
+                if (zip_entry_openbyindex(zip, i) != 0) {
+                    success = false;
+                    break;
+                }
+
+                // Entries must not be written outside of the destination folder
+                const std::filesystem::path name = zip_entry_name(zip);
+                const std::filesystem::path path = (root / name).lexically_normal();
+                const std::filesystem::path relative = path.lexically_relative(root);
+                if (name.is_absolute() || relative.empty() || *relative.begin() == "..") {
+                    LERROR(fmt::format("Skipping entry {} of {}", name, source));
+                    zip_entry_close(zip);
+                    continue;
+                }
+
+                std::error_code ec;
+                if (zip_entry_isdir(zip)) {
+                    std::filesystem::create_directories(path, ec);
+                }
+                else {
+                    std::filesystem::create_directories(path.parent_path(), ec);
+                    const int ret = zip_entry_fread(zip, path.string().c_str());
+                    if (ret != 0) {
+                        LERROR(fmt::format("Error {} while unzipping {}", ret, path));
+                        success = false;
+                    }
+                }
+                zip_entry_close(zip);
+            }
+            zip_close(zip);
+        };
+
+        pool.parallelFor(0, nJobs, 1, [&extractEntries](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                extractEntries(static_cast<int>(i));
+            }
+        });
+        return success;
+    }
+
+    // Returns the files of all other versions of the synchronization whose directory is
+    // provided, indexed by the URL from which they were downloaded
+    std::unordered_map<std::string, openspace::ContentStore::Entry> filesOfOtherVersions(
+                                                  const std::filesystem::path& directory)
+    {
+        using namespace openspace;
+
+        std::unordered_map<std::string, ContentStore::Entry> res;
+        const std::filesystem::path ownManifest = ContentStore::manifestPath(directory);
+        std::error_code ec;
+        for (const std::filesystem::directory_entry& e :
+             std::filesystem::directory_iterator(directory.parent_path(), ec))
+        {
+            if (e.path().extension() != ".osmanifest" || e.path() == ownManifest) {
+                continue;
+            }
+
+            std::optional<ContentStore::Manifest> manifest =
+                ContentStore::loadManifest(e.path());
+            if (!manifest.has_value()) {
+                continue;
+            }
+            for (ContentStore::Entry& entry : *manifest) {
+                if (!entry.url.empty()) {
+                    res[entry.url] = std::move(entry);
+                }
+            }
+        }
+        return res;
+    }
 } // namespace
 
 namespace openspace {
@@ -65,11 +177,14 @@ documentation::Documentation HttpSynchronization::Documentation() {
 
 HttpSynchronization::HttpSynchronization(const ghoul::Dictionary& dict,
                                          std::filesystem::path synchronizationRoot,
-                                      std::vector<std::string> synchronizationRepositories
-)
+                                     std::vector<std::string> synchronizationRepositories,
+                                         ContentStore* contentStore)
     : ResourceSynchronization(std::move(synchronizationRoot))
     , _syncRepositories(std::move(synchronizationRepositories))
+    , _contentStore(contentStore)
 {
+    ghoul_assert(_contentStore, "ContentStore must not be nullptr");
+
     const Parameters p = codegen::bake<Parameters>(dict);
 
     _identifier = p.identifier;
@@ -97,11 +212,26 @@ void HttpSynchronization::start() {
     }
     _state = State::Syncing;
 
-    if (hasSyncFile()) {
+    // Files that were removed or modified since the last synchronization are restored
+    // from the content store rather than being downloaded again
+    std::optional<ContentStore::Manifest> manifest =
+        ContentStore::loadManifest(ContentStore::manifestPath(directory()));
+    if (hasSyncFile() &&
+        (!manifest.has_value() || _contentStore->validate(*manifest, directory())))
+    {
         _state = State::Resolved;
         return;
     }
 
+    if (manifest.has_value()) {
+        // The files are links to blobs in the content store and the unzipping would
+        // otherwise write into those blobs
+        for (const ContentStore::Entry& entry : *manifest) {
+            std::error_code ec;
+            std::filesystem::remove(directory() / entry.path, ec);
+        }
+    }
+
     std::string query = fmt::format(
         "?identifier={}&file_version={}&application_version={}",
         _identifier, _version, ApplicationVersion
@@ -164,6 +294,14 @@ bool HttpSynchronization::trySyncFromUrl(std::string listUrl) {
 
     std::atomic_bool startedAllDownloads = false;
 
+    // Files that are already part of another version of this synchronization are taken
+    // from the content store instead of being downloaded again
+    const std::unordered_map<std::string, ContentStore::Entry> otherVersions =
+        filesOfOtherVersions(directory());
+
+    // The URLs from which the files were downloaded, indexed by the file's name
+    std::unordered_map<std::string, std::string> sources;
+
     // Yes, it should be possible to store this in a std::vector<HttpFileDownload> but
     // C++ really doesn't like that even though all of the move constructors, move
     // assignments and everything is automatically constructed
@@ -184,6 +322,14 @@ bool HttpSynchronization::trySyncFromUrl(std::string listUrl) {
             continue;
         }
 
+        sources[filename] = line;
+        auto it = otherVersions.find(line);
+        if (it != otherVersions.end() &&
+            _contentStore->restore(it->second.hash, directory() / filename))
+        {
+            continue;
+        }
+
         auto download = std::make_unique<HttpFileDownload>(
             line,
             destination,
@@ -267,9 +413,8 @@ bool HttpSynchronization::trySyncFromUrl(std::string listUrl) {
                 continue;
             }
 
-            int ret = zip_extract(source.c_str(), dest.c_str(), nullptr, nullptr);
-            if (ret != 0) {
-                LERROR(fmt::format("Error {} while unzipping {}", ret, source));
+            // The extraction overlaps with the downloads that are still in progress
+            if (!extractZip(source, dest)) {
                 continue;
             }
 
@@ -281,6 +426,16 @@ bool HttpSynchronization::trySyncFromUrl(std::string listUrl) {
             d->cancel();
         }
     }
+    else {
+        ContentStore::Manifest files = _contentStore->addDirectory(directory());
+        for (ContentStore::Entry& file : files) {
+            auto it = sources.find(file.path.generic_string());
+            if (it != sources.end()) {
+                file.url = it->second;
+            }
+        }
+        ContentStore::saveManifest(files, ContentStore::manifestPath(directory()));
+    }
     return !failed;
 }
 
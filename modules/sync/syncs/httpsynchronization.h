@@ -33,6 +33,8 @@
 
 namespace openspace {
 
+class ContentStore;
+
 /**
  * A concreate ResourceSynchronization that will request a list of files from a central
  * server (the server list is provided in the constructor) by asking for a specific
@@ -62,10 +64,14 @@ public:
      *        path is constructed
      * \param synchronizationRepositories The list of repositories that will be asked to
      *        resolve the identifier request
+     * \param contentStore The store into which the downloaded files are deduplicated
+     *
+     * \pre \p contentStore must not be nullptr
      */
     HttpSynchronization(const ghoul::Dictionary& dict,
         std::filesystem::path synchronizationRoot,
-        std::vector<std::string> synchronizationRepositories);
+        std::vector<std::string> synchronizationRepositories,
+        ContentStore* contentStore);
 
     /// Destructor that will close the asynchronous file transfer, if it is still ongoing
     ~HttpSynchronization() override;
@@ -108,6 +114,9 @@ private:
     // The list of all repositories that we'll try to sync from
     const std::vector<std::string> _syncRepositories;
 
+    // The store that contains the blobs for all downloaded files
+    ContentStore* _contentStore = nullptr;
+
     // The thread that will be doing the synchronization
     std::thread _syncThread;
 };
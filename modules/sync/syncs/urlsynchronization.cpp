@@ -24,10 +24,12 @@
 
 #include <modules/sync/syncs/urlsynchronization.h>
 
+#include <modules/sync/contentstore.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/util/httprequest.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
 #include <numeric>
 #include <mutex>
 #include <optional>
@@ -73,9 +75,13 @@ documentation::Documentation UrlSynchronization::Documentation() {
 }
 
 UrlSynchronization::UrlSynchronization(const ghoul::Dictionary& dictionary,
-                                       std::filesystem::path synchronizationRoot)
+                                       std::filesystem::path synchronizationRoot,
+                                       ContentStore* contentStore)
     : ResourceSynchronization(std::move(synchronizationRoot))
+    , _contentStore(contentStore)
 {
+    ghoul_assert(_contentStore, "ContentStore must not be nullptr");
+
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
     if (std::holds_alternative<std::string>(p.url)) {
@@ -132,12 +138,29 @@ void UrlSynchronization::start() {
     }
     _state = State::Syncing;
 
-    if (hasSyncFile() && !_forceOverride) {
+    // Files that were removed or modified since the last synchronization are restored
+    // from the content store rather than being downloaded again
+    std::optional<ContentStore::Manifest> manifest =
+        ContentStore::loadManifest(ContentStore::manifestPath(directory()));
+    const bool isValid =
+        !manifest.has_value() || _contentStore->validate(*manifest, directory());
+
+    if (hasSyncFile() && isValid && !_forceOverride) {
         _state = State::Resolved;
         return;
     }
 
-    _syncThread = std::thread([this]() {
+    // Previously downloaded files are only requested again if they have changed
+    std::unordered_map<std::string, ContentStore::Entry> previousEntries;
+    if (manifest.has_value()) {
+        for (ContentStore::Entry& entry : *manifest) {
+            if (!entry.url.empty()) {
+                previousEntries[entry.url] = std::move(entry);
+            }
+        }
+    }
+
+    _syncThread = std::thread([this, previousEntries = std::move(previousEntries)]() {
         std::unordered_map<std::string, size_t> fileSizes;
         std::mutex fileSizeMutex;
         size_t nDownloads = 0;
@@ -167,6 +190,23 @@ void UrlSynchronization::start() {
             );
             HttpFileDownload* dl = download.get();
 
+            auto it = previousEntries.find(url);
+            if (it != previousEntries.end() &&
+                it->second.path == _filename &&
+                std::filesystem::is_regular_file(directory() / _filename))
+            {
+                std::vector<std::string> headers;
+                if (!it->second.etag.empty()) {
+                    headers.push_back(fmt::format("If-None-Match: {}", it->second.etag));
+                }
+                if (!it->second.lastModified.empty()) {
+                    headers.push_back(
+                        fmt::format("If-Modified-Since: {}", it->second.lastModified)
+                    );
+                }
+                dl->setRequestHeaders(std::move(headers));
+            }
+
             downloads.push_back(std::move(download));
 
             ++nDownloads;
@@ -200,6 +240,9 @@ void UrlSynchronization::start() {
 
         startedAllDownloads = true;
 
+        // The URL and cache validators of each file, indexed by the file's name
+        std::unordered_map<std::string, ContentStore::Entry> sources;
+
         bool failed = false;
         for (const std::unique_ptr<HttpFileDownload>& d : downloads) {
             d->wait();
@@ -216,6 +259,18 @@ void UrlSynchronization::start() {
             // Remove the .tmp extension
             originalName.replace_extension("");
 
+            ContentStore::Entry& source = sources[originalName.filename().string()];
+            auto previous = previousEntries.find(d->url());
+            if (d->responseCode() == 304 && previous != previousEntries.end()) {
+                // The file has not changed since it was downloaded last time
+                std::filesystem::remove(tempName);
+                source = previous->second;
+                continue;
+            }
+            source.url = d->url();
+            source.etag = d->responseHeader("ETag").value_or("");
+            source.lastModified = d->responseHeader("Last-Modified").value_or("");
+
             if (std::filesystem::is_regular_file(originalName)) {
                 std::filesystem::remove(originalName);
             }
@@ -233,6 +288,16 @@ void UrlSynchronization::start() {
         }
 
         if (!failed) {
+            ContentStore::Manifest files = _contentStore->addDirectory(directory());
+            for (ContentStore::Entry& file : files) {
+                auto it = sources.find(file.path.generic_string());
+                if (it != sources.end()) {
+                    file.url = it->second.url;
+                    file.etag = it->second.etag;
+                    file.lastModified = it->second.lastModified;
+                }
+            }
+            ContentStore::saveManifest(files, ContentStore::manifestPath(directory()));
             createSyncFile();
         }
         else {
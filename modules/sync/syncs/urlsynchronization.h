@@ -35,6 +35,8 @@
 
 namespace openspace {
 
+class ContentStore;
+
 /**
  * The UrlSynchronization will download one or more files by directly being provided with
  * the list of URLs to the files that should be downloaded. The `Override` option in the
@@ -52,9 +54,12 @@ public:
      *        UrlSynchronization needs to download the provided files
      * \param synchronizationRoot The base location based off which the final placement
      *        is calculated
+     * \param contentStore The store into which the downloaded files are deduplicated
+     *
+     * \pre \p contentStore must not be nullptr
      */
     UrlSynchronization(const ghoul::Dictionary& dictionary,
-        std::filesystem::path synchronizationRoot);
+        std::filesystem::path synchronizationRoot, ContentStore* contentStore);
 
     /// Contructor that will terminate the synchronization thread if it is still running
     ~UrlSynchronization() override;
@@ -88,6 +93,9 @@ private:
     /// valid if a single URL is specified
     std::string _filename;
 
+    /// The store that contains the blobs for all downloaded files
+    ContentStore* _contentStore = nullptr;
+
     /// Contains a flag whether the current transfer should be cancelled
     std::atomic_bool _shouldCancel = false;
 
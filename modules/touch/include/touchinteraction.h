@@ -120,6 +120,14 @@ private:
      */
     void directControl(const std::vector<TouchInputHolder>& list);
 
+    /**
+     * Returns the touch points extrapolated along their recent motion by the average
+     * frame time, limited by the MaxInputPrediction, so that direct manipulation keeps
+     * up with the fingers rather than lagging a frame behind them.
+     */
+    std::vector<TouchInputHolder> predictedInputs(
+        const std::vector<TouchInputHolder>& list) const;
+
     /**
      * Traces each contact point into the scene as a ray and find the intersection
      * points on the surface of the current anchor node, if any. Saves the input id
@@ -185,6 +193,7 @@ private:
 
     properties::BoolProperty _enableDirectManipulation;
     properties::FloatProperty _directTouchDistanceThreshold;
+    properties::FloatProperty _maxInputPrediction;
 
 #ifdef TOUCH_DEBUG_PROPERTIES
     struct DebugProperties : PropertyOwner {
@@ -43,6 +43,7 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/invariants.h>
 #include <glm/gtx/quaternion.hpp>
+#include <algorithm>
 #include <cmath>
 #include <functional>
 #include <fstream>
@@ -267,6 +268,21 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo MaxInputPredictionInfo = {
+        "MaxInputPrediction",
+        "Max input prediction (s)",
+        "In direct manipulation, the touch points are extrapolated along their recent "
+        "motion by the average frame time, to compensate for the time between the input "
+        "and the frame being shown. This value limits how far ahead, in seconds, the "
+        "points are predicted, which matters when the frame rate drops. A value of 0 "
+        "disables the prediction",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    // The time window, in seconds, over which the velocity of a touch point is estimated
+    // for the prediction. Longer windows are smoother but respond slower to changes
+    constexpr double PredictionVelocityWindow = 0.05;
+
     // Compute coefficient of decay based on current frametime; if frametime has been
     // longer than usual then multiple decay steps may be applied to keep the decay
     // relative to user time
@@ -340,6 +356,7 @@ TouchInteraction::TouchInteraction()
     // projDiffLength/diffLength.
     , _enableDirectManipulation(EnableDirectManipulationInfo, true)
     , _directTouchDistanceThreshold(DirectManipulationThresholdInfo, 5.f, 0.f, 10.f)
+    , _maxInputPrediction(MaxInputPredictionInfo, 0.05f, 0.f, 0.2f)
 {
     addProperty(_disableZoom);
     addProperty(_disableRoll);
@@ -367,6 +384,7 @@ TouchInteraction::TouchInteraction()
 
     addProperty(_enableDirectManipulation);
     addProperty(_directTouchDistanceThreshold);
+    addProperty(_maxInputPrediction);
 
 #ifdef TOUCH_DEBUG_PROPERTIES
     addPropertySubOwner(_debugProperties);
@@ -480,7 +498,7 @@ void TouchInteraction::directControl(const std::vector<TouchInputHolder>& list)
     par[0] = _lastVel.orbit.x; // use _lastVel for orbit
     par[1] = _lastVel.orbit.y;
     bool lmSuccess = _directInputSolver.solve(
-        list,
+        predictedInputs(list),
         _selectedNodeSurfacePoints,
         &par,
         *_camera
@@ -515,6 +533,48 @@ void TouchInteraction::directControl(const std::vector<TouchInputHolder>& list)
     }
 }
 
+std::vector<TouchInputHolder> TouchInteraction::predictedInputs(
+                                         const std::vector<TouchInputHolder>& list) const
+{
+    const double horizon = std::min(
+        _frameTimeAvg.averageFrameTime(),
+        static_cast<double>(_maxInputPrediction)
+    );
+    if (horizon <= 0.0) {
+        return list;
+    }
+
+    std::vector<TouchInputHolder> result;
+    result.reserve(list.size());
+    for (const TouchInputHolder& holder : list) {
+        // The inputs are ordered from newest to oldest. The velocity is estimated from
+        // the oldest input within the window to smooth out the jitter of the device
+        const std::deque<TouchInput>& inputs = holder.peekInputs();
+        const TouchInput& latest = inputs.front();
+        const TouchInput* oldest = &latest;
+        for (const TouchInput& input : inputs) {
+            if (latest.timestamp - input.timestamp > PredictionVelocityWindow) {
+                break;
+            }
+            oldest = &input;
+        }
+
+        TouchInput predicted = latest;
+        const double dt = latest.timestamp - oldest->timestamp;
+        if (dt > 0.0) {
+            const double t = horizon / dt;
+            predicted.x = std::clamp(
+                static_cast<float>(latest.x + (latest.x - oldest->x) * t), 0.f, 1.f
+            );
+            predicted.y = std::clamp(
+                static_cast<float>(latest.y + (latest.y - oldest->y) * t), 0.f, 1.f
+            );
+        }
+        result.emplace_back(predicted);
+    }
+    return result;
+}
+
 void TouchInteraction::updateNodeSurfacePoints(const std::vector<TouchInputHolder>& list)
 {
     _selectedNodeSurfacePoints.clear();
@@ -107,7 +107,7 @@ void ToyVolumeRaycaster::preRaycast(const RaycastData& data,
     const std::string& timeUniformName = "time" + std::to_string(data.id);
     const std::string& stepSizeUniformName = "maxStepSize" + std::to_string(data.id);
     program.setUniform(colorUniformName, _color);
-    program.setUniform(stepSizeUniformName, _stepSize);
+    program.setUniform(stepSizeUniformName, _stepSize * stepSizeScale());
     program.setUniform(timeUniformName, static_cast<float>(std::fmod(_time, 3600.0)));
 }
 
@@ -125,6 +125,12 @@ bool ToyVolumeRaycaster::isCameraInside(const RenderData& data, glm::vec3& local
             localPosition.z > 0 && localPosition.z < 1);
 }
 
+std::optional<glm::vec4> ToyVolumeRaycaster::screenSpaceBounds(const RenderData& data) {
+    return boxScreenSpaceBounds(
+        glm::dmat4(data.camera.projectionMatrix()) * modelViewTransform(data)
+    );
+}
+
 std::string ToyVolumeRaycaster::boundsVertexShaderPath() const {
     return absPath(GlslBoundsVsPath).string();
 }
@@ -57,6 +57,7 @@ public:
     void postRaycast(const RaycastData& data,
         ghoul::opengl::ProgramObject& program) override;
     bool isCameraInside(const RenderData& data, glm::vec3& localPosition) override;
+    std::optional<glm::vec4> screenSpaceBounds(const RenderData& data) override;
 
     std::string boundsVertexShaderPath() const override;
     std::string boundsFragmentShaderPath() const override;
@@ -45,6 +45,8 @@ public:
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
 
+    MemoryUsage memoryUsage() const override;
+
     static documentation::Documentation Documentation();
 
 protected:
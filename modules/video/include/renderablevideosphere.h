@@ -28,6 +28,8 @@
 #include <modules/base/rendering/renderablesphere.h>
 
 #include <modules/video/include/videoplayer.h>
+#include <memory>
+#include <vector>
 
 namespace openspace {
 
@@ -45,13 +47,37 @@ public:
     void render(const RenderData& data, RendererTasks& rendererTask) override;
     void update(const UpdateData& data) override;
 
+    MemoryUsage memoryUsage() const override;
+
     static documentation::Documentation Documentation();
 
 protected:
     void bindTexture() override;
 
 private:
-    VideoPlayer _videoPlayer;
+    struct VideoTile {
+        std::unique_ptr<VideoPlayer> player;
+        /// The inclination (x) and azimuth (y) ranges of the sphere covered by the tile
+        glm::dvec2 inclination = glm::dvec2(0.0);
+        glm::dvec2 azimuth = glm::dvec2(0.0);
+        bool isVisible = true;
+        bool isDecoding = true;
+    };
+
+    void updateTileVisibility(const RenderData& data);
+    void updateMosaic();
+
+    /// The player for the video when it is not split into tiles
+    std::unique_ptr<VideoPlayer> _videoPlayer;
+
+    /// The number of columns and rows that a tiled video is split into
+    glm::ivec2 _tileLayout = glm::ivec2(0);
+    std::vector<VideoTile> _tiles;
+
+    /// The texture into which the tiles are combined when the video is tiled
+    std::unique_ptr<ghoul::opengl::Texture> _mosaic;
+    GLuint _mosaicFramebuffer = 0;
+    GLuint _tileFramebuffer = 0;
 };
 
 } // namespace openspace
@@ -65,12 +65,25 @@ public:
     void toggleMute();
 
     const std::unique_ptr<ghoul::opengl::Texture>& frameTexture() const;
+
+    /**
+     * Returns a number that is incremented every time a new frame has been rendered
+     * into the frame texture.
+     */
+    uint64_t frameNumber() const;
     bool isInitialized() const;
 
     void reload();
     void destroy();
     void update();
 
+    /**
+     * Enables or disables the decoding of new frames. While disabled, the video is
+     * paused and is not kept in sync with the master node. Once it is enabled again,
+     * the video resumes and catches up with the current playback time.
+     */
+    void setDecodingEnabled(bool isEnabled);
+
     virtual void preSync(bool isMaster) override;
     virtual void encode(SyncBuffer* syncBuffer) override;
     virtual void decode(SyncBuffer* syncBuffer) override;
@@ -92,7 +105,8 @@ private:
         Mute,
         Command,
         Seek,
-        Loop
+        Loop,
+        Speed
     };
     // Framebuffer
     void createTexture(glm::ivec2 size);
@@ -113,6 +127,7 @@ private:
     void setPropertyAsyncMpv(const char* value, MpvKey key);
     void setPropertyAsyncMpv(double value, MpvKey key);
     void getPropertyAsyncMpv(MpvKey key);
+    void setPlaybackSpeed(double speed);
 
     // Map to simulation time functions
     double correctVideoPlaybackTime() const;
@@ -134,6 +149,7 @@ private:
     double _videoDuration = 0.0;
     glm::ivec2 _videoResolution = glm::ivec2(2048, 1024); // Used for the fbos
     bool _isPaused = false;
+    double _playbackSpeed = 1.0;
     PlaybackMode _playbackMode = PlaybackMode::RealTimeLoop; // Default is to loop
 
     // Maps for keeping track of libmpv commands and formats
@@ -148,15 +164,22 @@ private:
     double _endJ200Time = 0.0;
     double _frameDuration = 0.0;
 
+    // Decoding options that are passed to libmpv on initialization
+    std::string _hardwareDecoding = "auto";
+    int _decodeAheadFrames = 0;
+
     // Libmpv
     mpv_handle* _mpvHandle = nullptr;
     mpv_render_context* _mpvRenderContext = nullptr;
     std::unique_ptr<ghoul::opengl::Texture> _frameTexture;
     GLuint _fbo = 0; // Our opengl framebuffer where mpv renders to
     int _wakeup = 0; // Signals when libmpv has a new frame ready
+    uint64_t _frameNumber = 0; // Incremented for every frame rendered into the texture
     bool _isInitialized = false; // If libmpv has been inititalized
     bool _isSeeking = false; // Prevent seeking while already seeking
     bool _isDestroying = false;
+    bool _isDecodingEnabled = true;
+    bool _resumeAfterDecoding = false; // If the video should play once decoding resumes
     double _seekThreshold = 1.0; // Threshold to ensure we seek to a different time
 };
 } // namespace video::globebrowsing
@@ -63,8 +63,11 @@ private:
     void internalDeinitialize() override final;
 
     // Tile handling
-    // Cache for rendering 1 frame
+    // Cache of the tiles requested for the current frame. Every tile refers to the same
+    // frame texture and only differs in which part of it is sampled, so the cache is
+    // cleared when a new frame is available instead of growing with every tile index
     std::map<TileIndex::TileHashKey, Tile> _tileCache;
+    uint64_t _cachedFrameNumber = 0;
     bool _tileIsReady = false;
 
     VideoPlayer _videoPlayer;
@@ -97,6 +97,12 @@ void RenderableVideoPlane::update(const UpdateData& data) {
     RenderablePlane::update(data);
 }
 
+Renderable::MemoryUsage RenderableVideoPlane::memoryUsage() const {
+    MemoryUsage usage;
+    usage.gpuTextures = textureMemory(_videoPlayer.frameTexture().get());
+    return usage;
+}
+
 void RenderableVideoPlane::bindTexture() {
     _videoPlayer.frameTexture()->bind();
 }
@@ -26,7 +26,36 @@
 
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/engine/globals.h>
+#include <openspace/engine/windowdelegate.h>
 #include <openspace/util/sphere.h>
+#include <openspace/util/updatestructures.h>
+#include <ghoul/fmt.h>
+#include <ghoul/misc/exception.h>
+#include <ghoul/opengl/framebufferobject.h>
+#include <optional>
+
+namespace {
+    // The number of samples along each side of a tile that are used to determine
+    // whether the tile is visible
+    constexpr int VisibilitySamples = 5;
+
+    // Widens the view frustum when testing the tile visibility to account for the
+    // curvature of the sphere between the samples
+    constexpr double VisibilityMargin = 1.1;
+
+    struct [[codegen::Dictionary(RenderableVideoSphere)]] Parameters {
+        // If this value is specified, the video is split into this many columns (x) and
+        // rows (y) of separate video files, each of which covers an equal part of the
+        // sphere. The 'Video' is then used as a pattern for the file names, where '{0}'
+        // is replaced with the column and '{1}' with the row of the tile, counting from
+        // the top left corner. Each node in a cluster only decodes the tiles that are
+        // visible in its views, with the exception of the master node which decodes all
+        // tiles as the other nodes synchronize their playback with it
+        std::optional<glm::ivec2> tileLayout;
+    };
+#include "renderablevideosphere_codegen.cpp"
+} // namespace
 
 namespace openspace {
 
@@ -38,46 +67,280 @@ documentation::Documentation RenderableVideoSphere::Documentation() {
     documentation::Documentation vp = VideoPlayer::Documentation();
     doc.entries.insert(doc.entries.end(), vp.entries.begin(), vp.entries.end());
 
+    documentation::Documentation tiles =
+        codegen::doc<Parameters>("video_renderablevideosphere");
+    doc.entries.insert(doc.entries.end(), tiles.entries.begin(), tiles.entries.end());
+
     return doc;
 }
 
 RenderableVideoSphere::RenderableVideoSphere(const ghoul::Dictionary& dictionary)
     : RenderableSphere(dictionary)
-    , _videoPlayer(dictionary)
 {
-    addPropertySubOwner(_videoPlayer);
+    const Parameters p = codegen::bake<Parameters>(dictionary);
+
+    if (!p.tileLayout.has_value()) {
+        _videoPlayer = std::make_unique<VideoPlayer>(dictionary);
+        addPropertySubOwner(_videoPlayer.get());
+        return;
+    }
+
+    _tileLayout = *p.tileLayout;
+    if (_tileLayout.x < 1 || _tileLayout.y < 1) {
+        throw ghoul::RuntimeError(fmt::format(
+            "Invalid tile layout ({}, {}) for video sphere", _tileLayout.x, _tileLayout.y
+        ));
+    }
+
+    const std::string pattern = dictionary.value<std::string>("Video");
+    for (int row = 0; row < _tileLayout.y; ++row) {
+        for (int column = 0; column < _tileLayout.x; ++column) {
+            ghoul::Dictionary tileDictionary = dictionary;
+            try {
+                tileDictionary.setValue(
+                    "Video",
+                    fmt::format(fmt::runtime(pattern), column, row)
+                );
+            }
+            catch (const fmt::format_error& e) {
+                throw ghoul::RuntimeError(fmt::format(
+                    "Invalid tile pattern '{}' for video sphere: {}", pattern, e.what()
+                ));
+            }
+
+            VideoTile tile;
+            tile.player = std::make_unique<VideoPlayer>(tileDictionary);
+            tile.player->setIdentifier(fmt::format("VideoPlayer_{}_{}", column, row));
+            tile.inclination = glm::dvec2(
+                glm::pi<double>() * row / _tileLayout.y,
+                glm::pi<double>() * (row + 1) / _tileLayout.y
+            );
+            tile.azimuth = glm::dvec2(
+                glm::two_pi<double>() * column / _tileLayout.x,
+                glm::two_pi<double>() * (column + 1) / _tileLayout.x
+            );
+            addPropertySubOwner(tile.player.get());
+            _tiles.push_back(std::move(tile));
+        }
+    }
 }
 
 bool RenderableVideoSphere::isReady() const {
-    return RenderableSphere::isReady() && _videoPlayer.isInitialized();
+    if (_videoPlayer) {
+        return RenderableSphere::isReady() && _videoPlayer->isInitialized();
+    }
+    else {
+        return RenderableSphere::isReady() && _mosaic != nullptr;
+    }
 }
 
 void RenderableVideoSphere::initializeGL() {
     RenderableSphere::initializeGL();
-    _videoPlayer.initialize();
+    if (_videoPlayer) {
+        _videoPlayer->initialize();
+    }
+    else {
+        glGenFramebuffers(1, &_mosaicFramebuffer);
+        glGenFramebuffers(1, &_tileFramebuffer);
+        for (VideoTile& tile : _tiles) {
+            tile.player->initialize();
+        }
+    }
 }
 
 void RenderableVideoSphere::deinitializeGL() {
-    _videoPlayer.destroy();
+    if (_videoPlayer) {
+        _videoPlayer->destroy();
+    }
+    else {
+        for (VideoTile& tile : _tiles) {
+            tile.player->destroy();
+        }
+        _mosaic = nullptr;
+        glDeleteFramebuffers(1, &_mosaicFramebuffer);
+        glDeleteFramebuffers(1, &_tileFramebuffer);
+    }
     RenderableSphere::deinitializeGL();
 }
 
 void RenderableVideoSphere::render(const RenderData& data, RendererTasks& rendererTask) {
-    if (_videoPlayer.isInitialized()) {
-        RenderableSphere::render(data, rendererTask);
+    if (_videoPlayer) {
+        if (_videoPlayer->isInitialized()) {
+            RenderableSphere::render(data, rendererTask);
+        }
+    }
+    else {
+        updateTileVisibility(data);
+        if (_mosaic) {
+            RenderableSphere::render(data, rendererTask);
+        }
     }
 }
 
 void RenderableVideoSphere::update(const UpdateData&) {
-    if (!_videoPlayer.isInitialized()) {
+    if (_videoPlayer) {
+        if (_videoPlayer->isInitialized()) {
+            _videoPlayer->update();
+        }
         return;
     }
 
-    _videoPlayer.update();
+    // The visibility was gathered from all of the views that were rendered during the
+    // last frame. The master node decodes all tiles as it provides the playback time
+    // that the other nodes are synchronized to
+    const bool isMaster = global::windowDelegate->isMaster();
+    for (VideoTile& tile : _tiles) {
+        tile.isDecoding = isMaster || tile.isVisible;
+        tile.isVisible = false;
+
+        if (tile.player->isInitialized()) {
+            tile.player->setDecodingEnabled(tile.isDecoding);
+            tile.player->update();
+        }
+    }
+
+    updateMosaic();
 }
 
 void RenderableVideoSphere::bindTexture() {
-    _videoPlayer.frameTexture().get()->bind();
+    if (_videoPlayer) {
+        _videoPlayer->frameTexture()->bind();
+    }
+    else {
+        _mosaic->bind();
+    }
+}
+
+Renderable::MemoryUsage RenderableVideoSphere::memoryUsage() const {
+    MemoryUsage usage;
+    if (_videoPlayer) {
+        usage.gpuTextures += textureMemory(_videoPlayer->frameTexture().get());
+    }
+    for (const VideoTile& tile : _tiles) {
+        usage.gpuTextures += textureMemory(tile.player->frameTexture().get());
+    }
+    usage.gpuTextures += textureMemory(_mosaic.get());
+    return usage;
+}
+
+void RenderableVideoSphere::updateTileVisibility(const RenderData& data) {
+    const glm::dmat4 modelTransform =
+        glm::translate(glm::dmat4(1.0), data.modelTransform.translation) *
+        glm::dmat4(data.modelTransform.rotation) *
+        glm::scale(glm::dmat4(1.0), glm::dvec3(data.modelTransform.scale));
+    const glm::dmat4 modelViewProjection =
+        glm::dmat4(data.camera.projectionMatrix()) *
+        data.camera.combinedViewMatrix() * modelTransform;
+    const double radius = static_cast<double>(_size);
+
+    for (VideoTile& tile : _tiles) {
+        if (tile.isVisible) {
+            // Already seen in another view during this frame
+            continue;
+        }
+
+        // The tile is invisible if all of its samples are outside of the same plane of
+        // the view frustum. The far plane is ignored as the sphere is usually far larger
+        // than the scene it surrounds
+        int outside = 0b11111;
+        for (int i = 0; i < VisibilitySamples && outside != 0; ++i) {
+            for (int j = 0; j < VisibilitySamples && outside != 0; ++j) {
+                const double s = static_cast<double>(i) / (VisibilitySamples - 1);
+                const double t = static_cast<double>(j) / (VisibilitySamples - 1);
+                const double theta = glm::mix(tile.inclination.x, tile.inclination.y, s);
+                double phi = glm::mix(tile.azimuth.x, tile.azimuth.y, t);
+                if (_mirrorTexture) {
+                    phi = glm::two_pi<double>() - phi;
+                }
+
+                // Same parameterization as the Sphere geometry
+                const glm::dvec4 position = glm::dvec4(
+                    radius * std::sin(theta) * std::cos(phi),
+                    radius * std::sin(theta) * std::sin(phi),
+                    radius * std::cos(theta),
+                    1.0
+                );
+                const glm::dvec4 clip = modelViewProjection * position;
+                const double w = VisibilityMargin * clip.w;
+
+                int flags = 0;
+                flags |= (clip.x < -w) ? 0b00001 : 0;
+                flags |= (clip.x > w) ? 0b00010 : 0;
+                flags |= (clip.y < -w) ? 0b00100 : 0;
+                flags |= (clip.y > w) ? 0b01000 : 0;
+                flags |= (clip.z < -clip.w) ? 0b10000 : 0;
+                outside &= flags;
+            }
+        }
+        tile.isVisible = (outside == 0);
+    }
+}
+
+void RenderableVideoSphere::updateMosaic() {
+    const std::unique_ptr<ghoul::opengl::Texture>& first =
+        _tiles.front().player->frameTexture();
+    if (!first) {
+        return;
+    }
+
+    // All tiles are expected to have the same resolution, but they are scaled to the
+    // size of the first one in case they don't
+    const glm::ivec2 tileSize = glm::ivec2(first->dimensions());
+    const glm::ivec2 size = tileSize * _tileLayout;
+    if (!_mosaic || glm::ivec2(_mosaic->dimensions()) != size) {
+        _mosaic = std::make_unique<ghoul::opengl::Texture>(
+            glm::uvec3(size, 1),
+            GL_TEXTURE_2D
+        );
+        _mosaic->uploadTexture();
+    }
+
+    const GLint defaultFbo = ghoul::opengl::FramebufferObject::getActiveObject();
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _mosaicFramebuffer);
+    glFramebufferTexture2D(
+        GL_DRAW_FRAMEBUFFER,
+        GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D,
+        *_mosaic,
+        0
+    );
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _tileFramebuffer);
+
+    for (size_t i = 0; i < _tiles.size(); ++i) {
+        const VideoTile& tile = _tiles[i];
+        const std::unique_ptr<ghoul::opengl::Texture>& texture =
+            tile.player->frameTexture();
+        if (!tile.isDecoding || !texture) {
+            // Tiles that are not decoded are not visible, so their stale content is
+            // never seen
+            continue;
+        }
+
+        glFramebufferTexture2D(
+            GL_READ_FRAMEBUFFER,
+            GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D,
+            *texture,
+            0
+        );
+
+        // The rows are counted from the top of the video, but the texture origin is in
+        // the bottom left corner
+        const int column = static_cast<int>(i) % _tileLayout.x;
+        const int row = static_cast<int>(i) / _tileLayout.x;
+        const glm::ivec2 offset =
+            glm::ivec2(column, _tileLayout.y - row - 1) * tileSize;
+        const glm::ivec2 textureSize = glm::ivec2(texture->dimensions());
+        glBlitFramebuffer(
+            0, 0, textureSize.x, textureSize.y,
+            offset.x, offset.y, offset.x + tileSize.x, offset.y + tileSize.y,
+            GL_COLOR_BUFFER_BIT,
+            GL_LINEAR
+        );
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, defaultFbo);
 }
 
 } // namespace openspace
@@ -39,6 +39,12 @@
 namespace {
     constexpr std::string_view _loggerCat = "VideoPlayer";
 
+    // The maximum relative change in playback speed used to catch up with the master
+    constexpr double MaxSpeedCorrection = 0.05;
+
+    // Changes in playback speed smaller than this are not sent to libmpv
+    constexpr double SpeedCorrectionThreshold = 0.005;
+
     constexpr openspace::properties::Property::PropertyInfo VideoInfo = {
         "Video",
         "Video",
@@ -121,6 +127,25 @@ namespace {
         // The mode of how the video should be played back.
         // Default is video is played back according to the set start and end times.
         std::optional<PlaybackMode> playbackMode;
+
+        enum class HardwareDecoding {
+            Interop = 0,
+            Copy,
+            Disabled
+        };
+
+        // Determines how the video is decoded. 'Interop' decodes the video on the GPU
+        // and hands the decoded frames directly to the OpenGL renderer without copying
+        // them through system memory, which is needed for very high resolution videos.
+        // 'Copy' also decodes on the GPU but copies the frames back to system memory,
+        // which works with more drivers. 'Disabled' decodes the video on the CPU. The
+        // default is 'Interop', which falls back to CPU decoding if it is unavailable
+        std::optional<HardwareDecoding> hardwareDecoding;
+
+        // The number of decoded frames that are buffered ahead of the current playback
+        // position. Buffering frames evens out the cost of decoding large videos, at the
+        // expense of video memory. If this value is 0, no extra frames are buffered
+        std::optional<int> decodeAheadFrames [[codegen::inrange(0, 120)]];
     };
 #include "videoplayer_codegen.cpp"
 } // namespace
@@ -260,6 +285,23 @@ VideoPlayer::VideoPlayer(const ghoul::Dictionary& dictionary)
 
     _videoFile = p.video;
     _loopVideo = p.loopVideo.value_or(_loopVideo);
+    _decodeAheadFrames = p.decodeAheadFrames.value_or(_decodeAheadFrames);
+
+    if (p.hardwareDecoding.has_value()) {
+        switch (*p.hardwareDecoding) {
+            case Parameters::HardwareDecoding::Interop:
+                _hardwareDecoding = "auto";
+                break;
+            case Parameters::HardwareDecoding::Copy:
+                _hardwareDecoding = "auto-copy";
+                break;
+            case Parameters::HardwareDecoding::Disabled:
+                _hardwareDecoding = "no";
+                break;
+            default:
+                throw ghoul::MissingCaseException();
+        }
+    }
 
     _reload.onChange([this]() { reload(); });
     addProperty(_reload);
@@ -321,7 +363,8 @@ VideoPlayer::VideoPlayer(const ghoul::Dictionary& dictionary)
         { MpvKey::IsSeeking, "seeking" },
         { MpvKey::Mute, "mute" },
         { MpvKey::Seek, "seek" },
-        { MpvKey::Loop, "loop-file" }
+        { MpvKey::Loop, "loop-file" },
+        { MpvKey::Speed, "speed" }
     };
 
     formats = {
@@ -334,7 +377,8 @@ VideoPlayer::VideoPlayer(const ghoul::Dictionary& dictionary)
         { MpvKey::Fps, MPV_FORMAT_DOUBLE },
         { MpvKey::IsSeeking, MPV_FORMAT_FLAG },
         { MpvKey::Mute, MPV_FORMAT_STRING },
-        { MpvKey::Loop, MPV_FORMAT_STRING }
+        { MpvKey::Loop, MPV_FORMAT_STRING },
+        { MpvKey::Speed, MPV_FORMAT_DOUBLE }
     };
 }
 
@@ -344,11 +388,19 @@ VideoPlayer::~VideoPlayer() {
 }
 
 void VideoPlayer::pause() {
+    if (!_isDecodingEnabled) {
+        _resumeAfterDecoding = false;
+        return;
+    }
     int isPaused = 1;
     setPropertyAsyncMpv(isPaused, MpvKey::Pause);
 }
 
 void VideoPlayer::play() {
+    if (!_isDecodingEnabled) {
+        _resumeAfterDecoding = true;
+        return;
+    }
     int isPaused = 0;
     setPropertyAsyncMpv(isPaused, MpvKey::Pause);
 }
@@ -386,9 +438,21 @@ void VideoPlayer::initializeMpv() {
     // https://mpv.io/manual/stable/#options-keep-open
     setPropertyStringMpv("keep-open", "yes");
 
-    // Enable hardware decoding
+    // Enable hardware decoding. With "auto", libmpv only picks decoders that can map
+    // their frames directly into the OpenGL renderer without a copy to system memory
     // https://mpv.io/manual/master/#options-hwdec
-    setPropertyStringMpv("hwdec", "auto");
+    setPropertyStringMpv("hwdec", _hardwareDecoding.c_str());
+
+    if (_decodeAheadFrames > 0) {
+        // Decode frames on a separate thread ahead of when they are displayed. The
+        // hardware decoder needs additional surfaces to be able to hold these frames
+        // https://mpv.io/manual/master/#options-vd-queue-enable
+        // https://mpv.io/manual/master/#options-hwdec-extra-frames
+        const std::string nFrames = std::to_string(_decodeAheadFrames);
+        setPropertyStringMpv("vd-queue-enable", "yes");
+        setPropertyStringMpv("vd-queue-max-samples", nFrames.c_str());
+        setPropertyStringMpv("hwdec-extra-frames", nFrames.c_str());
+    }
 
     // Enable direct rendering (default: auto). If this is set to yes, the video will be
     // decoded directly to GPU video memory (or staging buffers).
@@ -500,6 +564,14 @@ void VideoPlayer::update() {
     if (_isDestroying) {
         return;
     }
+    if (!_isDecodingEnabled) {
+        // Keep processing the events so that the state stays up to date, but don't
+        // seek or render as both of those would decode frames
+        if (_mpvHandle) {
+            handleMpvEvents();
+        }
+        return;
+    }
     if (_playbackMode == PlaybackMode::MapToSimulationTime) {
         seekToTime(correctVideoPlaybackTime());
     }
@@ -508,7 +580,31 @@ void VideoPlayer::update() {
     }
 }
 
+void VideoPlayer::setDecodingEnabled(bool isEnabled) {
+    if (isEnabled == _isDecodingEnabled) {
+        return;
+    }
+
+    if (isEnabled) {
+        _isDecodingEnabled = true;
+        // The playback time is corrected by the regular seeking in update or postSync
+        if (_resumeAfterDecoding) {
+            play();
+        }
+    }
+    else {
+        _resumeAfterDecoding = !_isPaused;
+        int isPaused = 1;
+        setPropertyAsyncMpv(isPaused, MpvKey::Pause);
+        _isDecodingEnabled = false;
+    }
+}
+
 void VideoPlayer::renderMpv() {
+    // Let libmpv know that the previous frame has been presented so that it can time
+    // the next frame against the actual display rate
+    mpv_render_context_report_swap(_mpvRenderContext);
+
     handleMpvEvents();
 
     // Renders a frame libmpv has been updated
@@ -545,6 +641,7 @@ void VideoPlayer::renderFrame() {
     // This "renders" to the video_framebuffer "linked by ID" in the
     // params_fbo
     mpv_render_context_render(_mpvRenderContext, params);
+    _frameNumber++;
 
     // We have to set the Viewport on every cycle because
     // mpv_render_context_render internally rescales the fb of the context(?!)...
@@ -768,16 +865,33 @@ void VideoPlayer::decode(SyncBuffer* syncBuffer) {
 }
 
 void VideoPlayer::postSync(bool isMaster) {
-    if (_correctPlaybackTime < 0.0) {
+    if (_correctPlaybackTime < 0.0 || isMaster || !_isDecodingEnabled) {
         return;
     }
     // Ensure the nodes have the same time as the master node
-    bool isMappingTime = _playbackMode == PlaybackMode::MapToSimulationTime;
-    if (!isMaster) {
-        if ((_correctPlaybackTime - _currentVideoTime) > glm::epsilon<double>()) {
-            seekToTime(_correctPlaybackTime, PauseAfterSeek(isMappingTime));
-        }
+    const bool isMappingTime = _playbackMode == PlaybackMode::MapToSimulationTime;
+    const double drift = _correctPlaybackTime - _currentVideoTime;
+    if (std::abs(drift) > _seekThreshold) {
+        seekToTime(_correctPlaybackTime, PauseAfterSeek(isMappingTime));
+        setPlaybackSpeed(1.0);
+        return;
+    }
+
+    // Seeking causes a visible hitch, so smaller differences are instead evened out by
+    // playing slightly faster or slower until the node has caught up with the master
+    if (!isMappingTime && !_isPaused) {
+        const double correction =
+            glm::clamp(drift, -MaxSpeedCorrection, MaxSpeedCorrection);
+        setPlaybackSpeed(1.0 + correction);
+    }
+}
+
+void VideoPlayer::setPlaybackSpeed(double speed) {
+    if (std::abs(speed - _playbackSpeed) < SpeedCorrectionThreshold) {
+        return;
     }
+    _playbackSpeed = speed;
+    setPropertyAsyncMpv(speed, MpvKey::Speed);
 }
 
 const std::unique_ptr<ghoul::opengl::Texture>& VideoPlayer::frameTexture() const {
@@ -790,9 +904,14 @@ void VideoPlayer::reload() {
     }
     destroy();
     _isDestroying = false;
+    _playbackSpeed = 1.0;
     initializeMpv();
 }
 
+uint64_t VideoPlayer::frameNumber() const {
+    return _frameNumber;
+}
+
 bool VideoPlayer::isInitialized() const {
     return _isInitialized;
 }
@@ -35,10 +35,6 @@
 #include <openspace/util/timemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 
-namespace {
-    constexpr std::string_view _loggerCat = "VideoTileProvider";
-} // namespace
-
 namespace openspace::globebrowsing {
 
 documentation::Documentation VideoTileProvider::Documentation() {
@@ -60,29 +56,24 @@ VideoTileProvider::~VideoTileProvider() {}
 globebrowsing::Tile VideoTileProvider::tile(const globebrowsing::TileIndex& tileIndex) {
     ZoneScoped;
 
-    if (!_videoPlayer.isInitialized()) {
+    if (!_videoPlayer.isInitialized() || !_videoPlayer.frameTexture()) {
         return Tile();
     }
 
-    // Always check that our framebuffer is ok
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-        LINFO("Framebuffer is not complete");
+    // The frame number changes whenever libmpv rendered into the texture, which also
+    // happens when the texture has been recreated after a change in resolution
+    if (_videoPlayer.frameNumber() != _cachedFrameNumber) {
+        _tileCache.clear();
+        _cachedFrameNumber = _videoPlayer.frameNumber();
     }
 
-    // For now, don't use the cache as we're trying to debug the problem w playback
-    uint64_t hash = tileIndex.hashKey();
-    auto foundTile = _tileCache.find(hash);
-    bool textureChanged = foundTile != _tileCache.end() &&
-        foundTile->second.texture != _videoPlayer.frameTexture().get();
-
-    if (foundTile == _tileCache.end() || textureChanged) {
-        _tileCache[hash] = Tile {
-            _videoPlayer.frameTexture().get(),
-            std::nullopt,
-            Tile::Status::OK
-        };
-    }
-    return _tileCache[hash];
+    // The tile always shows the entire frame; the part of the frame that belongs to the
+    // tile index is selected on the GPU through the uv transform from chunkTile
+    const auto [it, _] = _tileCache.try_emplace(
+        tileIndex.hashKey(),
+        Tile { _videoPlayer.frameTexture().get(), std::nullopt, Tile::Status::OK }
+    );
+    return it->second;
 }
 
 Tile::Status VideoTileProvider::tileStatus(const TileIndex& tileIndex) {
@@ -0,0 +1,92 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/volume/minmaxgrid.h>
+
+#include <modules/volume/rawvolume.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Returns the first and the last voxel (inclusive) along one axis that a linear
+    // interpolation at any texture coordinate of the cell might access
+    std::pair<unsigned int, unsigned int> voxelRange(unsigned int cell,
+                                                     unsigned int nCells,
+                                                     unsigned int nVoxels)
+    {
+        const double scale = static_cast<double>(nVoxels) / nCells;
+        const double begin = std::floor(cell * scale - 0.5);
+        const double end = std::floor((cell + 1) * scale - 0.5) + 1.0;
+        return {
+            static_cast<unsigned int>(std::clamp(begin, 0.0, nVoxels - 1.0)),
+            static_cast<unsigned int>(std::clamp(end, 0.0, nVoxels - 1.0))
+        };
+    }
+} // namespace
+
+namespace openspace::volume {
+
+MinMaxGrid createMinMaxGrid(const RawVolume<float>& volume, unsigned int cellSize) {
+    const glm::uvec3 dims = volume.dimensions();
+    const unsigned int size = std::max(cellSize, 1u);
+
+    MinMaxGrid grid;
+    grid.dimensions = glm::max((dims + glm::uvec3(size - 1)) / size, glm::uvec3(1));
+    grid.values.resize(
+        static_cast<size_t>(grid.dimensions.x) * grid.dimensions.y * grid.dimensions.z
+    );
+    if (volume.nCells() == 0) {
+        return grid;
+    }
+
+    const float* data = volume.data();
+    size_t i = 0;
+    for (unsigned int cz = 0; cz < grid.dimensions.z; ++cz) {
+        const auto [z0, z1] = voxelRange(cz, grid.dimensions.z, dims.z);
+        for (unsigned int cy = 0; cy < grid.dimensions.y; ++cy) {
+            const auto [y0, y1] = voxelRange(cy, grid.dimensions.y, dims.y);
+            for (unsigned int cx = 0; cx < grid.dimensions.x; ++cx) {
+                const auto [x0, x1] = voxelRange(cx, grid.dimensions.x, dims.x);
+
+                float minValue = std::numeric_limits<float>::max();
+                float maxValue = std::numeric_limits<float>::lowest();
+                for (unsigned int z = z0; z <= z1; ++z) {
+                    for (unsigned int y = y0; y <= y1; ++y) {
+                        const float* row = data + volume.coordsToIndex({ 0, y, z });
+                        for (unsigned int x = x0; x <= x1; ++x) {
+                            minValue = std::min(minValue, row[x]);
+                            maxValue = std::max(maxValue, row[x]);
+                        }
+                    }
+                }
+                grid.values[i] = glm::vec2(minValue, maxValue);
+                i++;
+            }
+        }
+    }
+    return grid;
+}
+
+} // namespace openspace::volume
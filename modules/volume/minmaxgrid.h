@@ -22,64 +22,37 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
-namespace openspace::volume {
-
-template <typename ValueType>
-LinearLruCache<ValueType>::LinearLruCache(size_t capacity, size_t nIndices)
-    : _tracker()
-    , _cache(nIndices, { nullptr, _tracker.end() })
-    , _capacity(capacity)
-{}
-
-template <typename ValueType>
-bool LinearLruCache<ValueType>::has(size_t key) const {
-    return _cache[key].first != nullptr;
-}
-
-template <typename ValueType>
-void LinearLruCache<ValueType>::set(size_t key, ValueType value) {
-    auto prev = _cache[key];
-    if (prev.first != nullptr) {
-        prev.first = value;
-        const std::list<size_t>::iterator trackerIter = prev.second;
-        _tracker.splice(_tracker.end(), _tracker, trackerIter);
-    }
-    else {
-        insert(key, value);
-    }
-}
+#ifndef __OPENSPACE_MODULE_VOLUME___MINMAXGRID___H__
+#define __OPENSPACE_MODULE_VOLUME___MINMAXGRID___H__
 
-template <typename ValueType>
-ValueType& LinearLruCache<ValueType>::use(size_t key) {
-    auto& pair = _cache[key];
-    const std::list<size_t>::iterator trackerIter = pair.second;
-    _tracker.splice(_tracker.end(), _tracker, trackerIter);
-    return pair.first;
-}
+#include <ghoul/glm.h>
+#include <vector>
 
-template <typename ValueType>
-ValueType& LinearLruCache<ValueType>::get(size_t key) {
-    return _cache[key].first;
-}
-
-template <typename ValueType>
-void LinearLruCache<ValueType>::evict() {
-    _cache[_tracker.front()] = make_pair(nullptr, _tracker.end());
-    _tracker.pop_front();
-}
-
-template <typename ValueType>
-size_t LinearLruCache<ValueType>::capacity() const {
-    return _capacity;
-}
+namespace openspace::volume {
 
-template <typename ValueType>
-void LinearLruCache<ValueType>::insert(size_t key, const ValueType& value) {
-    if (_tracker.size() == _capacity) {
-        evict();
-    }
-    auto iter = _tracker.insert(_tracker.end(), key);
-    _cache[key] = { value, iter };
-}
+template <typename Type> class RawVolume;
+
+/**
+ * A coarse grid that stores the minimum and maximum voxel value of a volume for each of
+ * its cells. The cells evenly divide the texture coordinate range [0, 1] of the volume
+ * and include all voxels that a linearly interpolated sample inside the cell can touch.
+ * Combined with a transfer function, this grid tells which parts of a volume are
+ * completely transparent and can be skipped by a raycaster.
+ */
+struct MinMaxGrid {
+    /// The number of cells along each axis
+    glm::uvec3 dimensions = glm::uvec3(0);
+
+    /// The minimum (x) and maximum (y) value for each cell with x varying fastest
+    std::vector<glm::vec2> values;
+};
+
+/**
+ * Creates the MinMaxGrid for the provided \p volume, where each cell covers roughly
+ * \p cellSize voxels along each axis.
+ */
+MinMaxGrid createMinMaxGrid(const RawVolume<float>& volume, unsigned int cellSize);
 
 } // namespace openspace::volume
+
+#endif // __OPENSPACE_MODULE_VOLUME___MINMAXGRID___H__
@@ -45,6 +45,18 @@ public:
                const std::function<void(float)>& onProgress = [](float) {});
     void write(const RawVolume<VoxelType>& volume);
 
+    /**
+     * Writes the volume as a sequence of slabs, each of which is \p slabDepth slices (in
+     * z) deep, apart from the last one which might be thinner. The function \p fn is
+     * called for each slab in order with a volume that has to be filled and the index of
+     * the first slice that the slab corresponds to. Only a single slab is kept in memory
+     * at any time.
+     */
+    void writeSlabs(
+        const std::function<void(RawVolume<VoxelType>&, unsigned int)>& fn,
+        unsigned int slabDepth,
+        const std::function<void(float)>& onProgress = [](float) {});
+
     size_t coordsToIndex(const glm::uvec3& coords) const;
     glm::ivec3 indexToCoords(size_t linear) const;
 
@@ -26,6 +26,7 @@
 #include <modules/volume/volumeutils.h>
 #include <ghoul/misc/exception.h>
 #include <ghoul/fmt.h>
+#include <algorithm>
 #include <fstream>
 
 namespace openspace::volume {
@@ -107,4 +108,36 @@ void RawVolumeWriter<VoxelType>::write(const RawVolume<VoxelType>& volume) {
     file.close();
 }
 
+template <typename VoxelType>
+void RawVolumeWriter<VoxelType>::writeSlabs(
+                       const std::function<void(RawVolume<VoxelType>&, unsigned int)>& fn,
+                                                                   unsigned int slabDepth,
+                                             const std::function<void(float)>& onProgress)
+{
+    const glm::uvec3 dims = dimensions();
+    const unsigned int depth = std::max(slabDepth, 1u);
+
+    std::ofstream file(_path, std::ios::binary);
+    if (!file.good()) {
+        throw ghoul::RuntimeError(fmt::format("Could not create file {}", _path));
+    }
+
+    RawVolume<VoxelType> slab(glm::uvec3(dims.x, dims.y, std::min(depth, dims.z)));
+    for (unsigned int z = 0; z < dims.z; z += depth) {
+        const unsigned int nSlices = std::min(depth, dims.z - z);
+        if (slab.dimensions().z != nSlices) {
+            slab.setDimensions(glm::uvec3(dims.x, dims.y, nSlices));
+        }
+
+        fn(slab, z);
+
+        file.write(
+            reinterpret_cast<const char*>(slab.data()),
+            slab.nCells() * sizeof(VoxelType)
+        );
+        onProgress(static_cast<float>(z + nSlices) / dims.z);
+    }
+    file.close();
+}
+
 } // namespace openspace::volume
@@ -24,6 +24,7 @@
 
 #include <modules/volume/rendering/basicvolumeraycaster.h>
 
+#include <modules/volume/minmaxgrid.h>
 #include <modules/volume/rendering/volumeclipplanes.h>
 #include <modules/volume/transferfunctionhandler.h>
 #include <openspace/rendering/renderable.h>
@@ -35,6 +36,8 @@
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/textureunit.h>
 #include <ghoul/opengl/texture.h>
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 
 namespace {
@@ -52,17 +55,24 @@ BasicVolumeRaycaster::BasicVolumeRaycaster(
                                              std::shared_ptr<VolumeClipPlanes> clipPlanes)
     : _clipPlanes(clipPlanes)
     , _volumeTexture(volumeTexture)
-    , _transferFunction(transferFunction)
     , _boundingBox(glm::vec3(1.0))
-{}
+{
+    setTransferFunction(std::move(transferFunction));
+}
 
-BasicVolumeRaycaster::~BasicVolumeRaycaster() {}
+BasicVolumeRaycaster::~BasicVolumeRaycaster() {
+    if (_transferFunction) {
+        _transferFunction->setCallback(openspace::TransferFunction::TfChangedCallback());
+    }
+}
 
 void BasicVolumeRaycaster::initialize() {
     _boundingBox.initialize();
 }
 
-void BasicVolumeRaycaster::deinitialize() {}
+void BasicVolumeRaycaster::deinitialize() {
+    _occupancyTexture = nullptr;
+}
 
 void BasicVolumeRaycaster::renderEntryPoints(const RenderData& data,
                                              ghoul::opengl::ProgramObject& program)
@@ -113,7 +123,7 @@ void BasicVolumeRaycaster::preRaycast(const RaycastData& data,
     }
 
     std::string stepSizeUniformName = "maxStepSize" + std::to_string(data.id);
-    program.setUniform(stepSizeUniformName, _stepSize);
+    program.setUniform(stepSizeUniformName, _stepSize * stepSizeScale());
 
     std::string id = std::to_string(data.id);
 
@@ -130,6 +140,25 @@ void BasicVolumeRaycaster::preRaycast(const RaycastData& data,
 
     program.setUniform("gridType_" + id, static_cast<int>(_gridType));
 
+    // Empty space skipping is only done for cartesian grids as the distances in a
+    // spherical grid are not linear in the texture coordinates
+    const bool skipEmptySpace = _useEmptySpaceSkipping && _minMaxGrid &&
+                                _gridType == VolumeGridType::Cartesian;
+    if (skipEmptySpace && _occupancyIsDirty) {
+        updateOccupancyTexture();
+    }
+    program.setUniform("useEmptySpaceSkipping_" + id, skipEmptySpace);
+    if (skipEmptySpace) {
+        _occupancyUnit = std::make_unique<ghoul::opengl::TextureUnit>();
+        _occupancyUnit->activate();
+        _occupancyTexture->bind();
+        program.setUniform("occupancyTexture_" + id, _occupancyUnit->unitNumber());
+        program.setUniform(
+            "occupancyDimensions_" + id,
+            glm::vec3(_minMaxGrid->dimensions)
+        );
+    }
+
     std::vector<glm::vec3> clipNormals = _clipPlanes->normals();
     std::vector<glm::vec2> clipOffsets = _clipPlanes->offsets();
     int nClips = static_cast<int>(clipNormals.size());
@@ -146,6 +175,49 @@ void BasicVolumeRaycaster::postRaycast(const RaycastData&, ghoul::opengl::Progra
 {
     _textureUnit = nullptr;
     _tfUnit = nullptr;
+    _occupancyUnit = nullptr;
+}
+
+void BasicVolumeRaycaster::updateOccupancyTexture() {
+    // The number of opaque texels up to each position in the transfer function, which
+    // turns the test for a value range into two lookups
+    const size_t width = _transferFunction->width();
+    std::vector<size_t> nOpaque(width + 1, 0);
+    for (size_t i = 0; i < width; ++i) {
+        const bool isOpaque = _transferFunction->sample(i).a > 0.f;
+        nOpaque[i + 1] = nOpaque[i] + (isOpaque ? 1 : 0);
+    }
+
+    // Returns the transfer function texel for a value, taking the linear interpolation
+    // between neighboring texels into account
+    auto texel = [width](float value, float offset) {
+        const float t = std::floor(glm::clamp(value, 0.f, 1.f) * width - 0.5f) + offset;
+        return static_cast<size_t>(std::clamp(t, 0.f, static_cast<float>(width - 1)));
+    };
+
+    _occupancy.resize(_minMaxGrid->values.size());
+    for (size_t i = 0; i < _minMaxGrid->values.size(); ++i) {
+        const glm::vec2 range = _minMaxGrid->values[i];
+        const size_t first = texel(range.x, 0.f);
+        const size_t last = texel(range.y, 1.f);
+        _occupancy[i] = nOpaque[last + 1] > nOpaque[first] ? 255 : 0;
+    }
+
+    _occupancyTexture = std::make_unique<ghoul::opengl::Texture>(
+        _minMaxGrid->dimensions,
+        GL_TEXTURE_3D,
+        ghoul::opengl::Texture::Format::Red,
+        GL_R8,
+        GL_UNSIGNED_BYTE,
+        ghoul::opengl::Texture::FilterMode::Nearest,
+        ghoul::opengl::Texture::WrappingMode::ClampToEdge
+    );
+    _occupancyTexture->setPixelData(
+        _occupancy.data(),
+        ghoul::opengl::Texture::TakeOwnership::No
+    );
+    _occupancyTexture->uploadTexture();
+    _occupancyIsDirty = false;
 }
 
 bool BasicVolumeRaycaster::isCameraInside(const RenderData& data,
@@ -161,6 +233,12 @@ bool BasicVolumeRaycaster::isCameraInside(const RenderData& data,
             localPosition.z > 0 && localPosition.z < 1);
 }
 
+std::optional<glm::vec4> BasicVolumeRaycaster::screenSpaceBounds(const RenderData& data) {
+    return boxScreenSpaceBounds(
+        glm::dmat4(data.camera.projectionMatrix()) * modelViewTransform(data)
+    );
+}
+
 std::string BasicVolumeRaycaster::boundsVertexShaderPath() const {
     return absPath(GlslBoundsVs).string();
 }
@@ -180,7 +258,16 @@ std::string BasicVolumeRaycaster::helperPath() const {
 void BasicVolumeRaycaster::setTransferFunction(
                             std::shared_ptr<openspace::TransferFunction> transferFunction)
 {
+    if (_transferFunction) {
+        _transferFunction->setCallback(openspace::TransferFunction::TfChangedCallback());
+    }
     _transferFunction = std::move(transferFunction);
+    if (_transferFunction) {
+        _transferFunction->setCallback(
+            [this](const openspace::TransferFunction&) { _occupancyIsDirty = true; }
+        );
+    }
+    _occupancyIsDirty = true;
 }
 
 void BasicVolumeRaycaster::setVolumeTexture(
@@ -193,6 +280,17 @@ std::shared_ptr<ghoul::opengl::Texture> BasicVolumeRaycaster::volumeTexture() co
     return _volumeTexture;
 }
 
+void BasicVolumeRaycaster::setMinMaxGrid(std::shared_ptr<const MinMaxGrid> minMaxGrid) {
+    if (minMaxGrid != _minMaxGrid) {
+        _minMaxGrid = std::move(minMaxGrid);
+        _occupancyIsDirty = true;
+    }
+}
+
+void BasicVolumeRaycaster::setEmptySpaceSkipping(bool enabled) {
+    _useEmptySpaceSkipping = enabled;
+}
+
 void BasicVolumeRaycaster::setStepSize(float stepSize) {
     _stepSize = stepSize;
 }
@@ -29,6 +29,7 @@
 
 #include <openspace/util/boxgeometry.h>
 #include <modules/volume/volumegridtype.h>
+#include <vector>
 
 namespace ghoul::opengl {
     class Texture;
@@ -46,6 +47,7 @@ namespace openspace::volume {
 
 class TransferFunctionHandler;
 class VolumeClipPlanes;
+struct MinMaxGrid;
 
 class BasicVolumeRaycaster : public VolumeRaycaster {
 public:
@@ -67,6 +69,7 @@ public:
     void postRaycast(const RaycastData& data,
         ghoul::opengl::ProgramObject& program) override;
     bool isCameraInside(const RenderData& data, glm::vec3& localPosition) override;
+    std::optional<glm::vec4> screenSpaceBounds(const RenderData& data) override;
 
     std::string boundsVertexShaderPath() const override;
     std::string boundsFragmentShaderPath() const override;
@@ -79,6 +82,14 @@ public:
     void setTransferFunction(std::shared_ptr<openspace::TransferFunction>
         transferFunction);
 
+    /**
+     * Sets the coarse grid of value ranges for the current volume texture. Together
+     * with the transfer function it is used to skip the parts of the volume that are
+     * completely transparent. Passing \c nullptr samples the whole volume.
+     */
+    void setMinMaxGrid(std::shared_ptr<const MinMaxGrid> minMaxGrid);
+    void setEmptySpaceSkipping(bool enabled);
+
     void setStepSize(float stepSize);
     float brightness() const;
     void setBrightness(float brightness);
@@ -93,6 +104,12 @@ public:
 private:
     glm::dmat4 modelViewTransform(const RenderData& data);
 
+    /**
+     * Recreates the occupancy texture from the current MinMaxGrid and transfer function.
+     * A cell is occupied if any value in its range maps to a non-zero opacity.
+     */
+    void updateOccupancyTexture();
+
     std::shared_ptr<VolumeClipPlanes> _clipPlanes;
     std::shared_ptr<ghoul::opengl::Texture> _volumeTexture;
     std::shared_ptr<openspace::TransferFunction> _transferFunction;
@@ -103,8 +120,15 @@ private:
     float _rNormalization = 0.f;
     float _rUpperBound = 1.f;
 
+    std::shared_ptr<const MinMaxGrid> _minMaxGrid;
+    bool _useEmptySpaceSkipping = true;
+    bool _occupancyIsDirty = true;
+    std::vector<uint8_t> _occupancy;
+    std::unique_ptr<ghoul::opengl::Texture> _occupancyTexture;
+
     std::unique_ptr<ghoul::opengl::TextureUnit> _tfUnit;
     std::unique_ptr<ghoul::opengl::TextureUnit> _textureUnit;
+    std::unique_ptr<ghoul::opengl::TextureUnit> _occupancyUnit;
     float _stepSize = 0.f;
 };
 
@@ -27,12 +27,15 @@
 #include <modules/volume/rendering/basicvolumeraycaster.h>
 #include <modules/volume/rendering/volumeclipplanes.h>
 #include <modules/volume/transferfunctionhandler.h>
+#include <modules/volume/minmaxgrid.h>
 #include <modules/volume/rawvolume.h>
 #include <modules/volume/rawvolumereader.h>
 #include <modules/volume/volumegridtype.h>
+#include <modules/volume/volumemodule.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
+#include <openspace/engine/moduleengine.h>
 #include <openspace/rendering/raycastermanager.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/util/histogram.h>
@@ -44,14 +47,26 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/texture.h>
+#include <algorithm>
 #include <filesystem>
+#include <functional>
 #include <optional>
+#include <tuple>
 
 namespace {
     constexpr std::string_view _loggerCat = "RenderableTimeVaryingVolume";
 
     const float SecondsInOneDay = 60 * 60 * 24;
 
+    // The number of timesteps that can be read by the streaming thread at the same time.
+    // The timesteps are requested in the order of priority, so keeping this number low
+    // means that the most important timestep is never waiting behind less relevant ones
+    constexpr int MaxStreamingJobs = 2;
+
+    // The number of voxels along each axis that are covered by one cell of the grid that
+    // is used for empty space skipping
+    constexpr unsigned int MinMaxGridCellSize = 8;
+
     constexpr openspace::properties::Property::PropertyInfo StepSizeInfo = {
         "StepSize",
         "Step Size",
@@ -60,6 +75,15 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo EmptySpaceSkippingInfo = {
+        "EmptySpaceSkipping",
+        "Empty Space Skipping",
+        "If enabled, the raycaster steps over the parts of the volume that are "
+        "completely transparent with the current transfer function instead of "
+        "sampling them. This only applies to volumes with a cartesian grid",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo GridTypeInfo = {
         "GridType",
         "Grid Type",
@@ -136,6 +160,60 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo StreamingMemoryLimitInfo = {
+        "StreamingMemoryLimit",
+        "Streaming Memory Limit (MB)",
+        "The maximum amount of memory in megabytes that the timesteps of a streamed "
+        "volume are allowed to use on the GPU. The timestep at the current time is "
+        "always loaded, even if it exceeds this limit, and the remaining memory is used "
+        "to preload timesteps in the direction in which time is moving",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    template <typename P>
+    struct FunctionJob : public openspace::Job<P> {
+        explicit FunctionJob(std::function<P()> f) : function(std::move(f)) {}
+
+        void execute() override { result = function(); }
+        P product() override { return std::move(result); }
+
+        std::function<P()> function;
+        P result;
+    };
+
+    std::tuple<
+        std::shared_ptr<openspace::volume::RawVolume<float>>,
+        std::shared_ptr<openspace::Histogram>,
+        std::shared_ptr<openspace::volume::MinMaxGrid>
+    > readTimestep(const std::string& path,
+                   const openspace::volume::RawVolumeMetadata& metadata, bool invertZ)
+    {
+        using namespace openspace;
+
+        volume::RawVolumeReader<float> reader(path, metadata.dimensions);
+        std::shared_ptr<volume::RawVolume<float>> rawVolume = reader.read(invertZ);
+
+        float min = metadata.minValue;
+        float diff = metadata.maxValue - metadata.minValue;
+        float* data = rawVolume->data();
+        for (size_t i = 0; i < rawVolume->nCells(); ++i) {
+            data[i] = glm::clamp((data[i] - min) / diff, 0.f, 1.f);
+        }
+
+        std::shared_ptr<Histogram> histogram = std::make_shared<Histogram>(0.f, 1.f, 100);
+        for (size_t i = 0; i < rawVolume->nCells(); ++i) {
+            histogram->add(data[i]);
+        }
+        // TODO: handle normalization properly for different timesteps + transfer function
+
+        std::shared_ptr<volume::MinMaxGrid> minMaxGrid =
+            std::make_shared<volume::MinMaxGrid>(
+                volume::createMinMaxGrid(*rawVolume, MinMaxGridCellSize)
+            );
+
+        return { std::move(rawVolume), std::move(histogram), std::move(minMaxGrid) };
+    }
+
     struct [[codegen::Dictionary(RenderableTimeVaryingVolume)]] Parameters {
         // [[codegen::verbatim(SourceDirectoryInfo.description)]]
         std::string sourceDirectory;
@@ -158,11 +236,35 @@ namespace {
         // [[codegen::verbatim(StepSizeInfo.description)]]
         std::optional<float> stepSize;
 
+        // [[codegen::verbatim(EmptySpaceSkippingInfo.description)]]
+        std::optional<bool> emptySpaceSkipping;
+
+        enum class TextureFormat {
+            Float32,
+            Float16,
+            UNorm8
+        };
+        // The format in which the normalized volume is stored on the GPU. 'Float16'
+        // halves and 'UNorm8' quarters the graphics memory of each timestep compared to
+        // 'Float32', at the cost of precision. With less memory per timestep, more
+        // timesteps fit into the StreamingMemoryLimit. Defaults to 'Float32'
+        std::optional<TextureFormat> textureFormat;
+
         // [[codegen::verbatim(GridTypeInfo.description)]]
         std::optional<std::string> gridType;
 
         // @TODO Missing documentation
         std::optional<ghoul::Dictionary> clipPlanes;
+
+        // If this value is 'true', the timesteps are not loaded when the renderable is
+        // initialized. Instead, they are read on a background thread around the current
+        // time and only as many timesteps as fit into the 'StreamingMemoryLimit' are
+        // kept on the GPU. This makes it possible to show sequences that would not fit
+        // into the graphics memory
+        std::optional<bool> streaming;
+
+        // [[codegen::verbatim(StreamingMemoryLimitInfo.description)]]
+        std::optional<int> streamingMemoryLimit [[codegen::greater(0)]];
     };
 #include "renderabletimevaryingvolume_codegen.cpp"
 } // namespace
@@ -178,6 +280,7 @@ RenderableTimeVaryingVolume::RenderableTimeVaryingVolume(
     : Renderable(dictionary)
     , _gridType(GridTypeInfo, properties::OptionProperty::DisplayType::Dropdown)
     , _stepSize(StepSizeInfo, 0.02f, 0.001f, 0.1f)
+    , _emptySpaceSkipping(EmptySpaceSkippingInfo, true)
     , _brightness(BrightnessInfo, 0.33f, 0.f, 1.f)
     , _rNormalization(rNormalizationInfo, 0.f, 0.f, 2.f)
     , _rUpperBound(rUpperBoundInfo, 1.f, 0.f, 2.f)
@@ -187,6 +290,7 @@ RenderableTimeVaryingVolume::RenderableTimeVaryingVolume(
     , _transferFunctionPath(TransferFunctionInfo)
     , _triggerTimeJump(TriggerTimeJumpInfo)
     , _jumpToTimestep(JumpToTimestepInfo, 0, 0, 256)
+    , _streamingMemoryLimit(StreamingMemoryLimitInfo, 1024, 64, 32768)
     , _invertDataAtZ(false)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
@@ -199,6 +303,8 @@ RenderableTimeVaryingVolume::RenderableTimeVaryingVolume(
     );
 
     _invertDataAtZ = p.invertDataAtZ.value_or(_invertDataAtZ);
+    _isStreaming = p.streaming.value_or(_isStreaming);
+    _streamingMemoryLimit = p.streamingMemoryLimit.value_or(_streamingMemoryLimit);
 
     _gridType.addOptions({
         { static_cast<int>(volume::VolumeGridType::Cartesian), "Cartesian grid" },
@@ -207,6 +313,23 @@ RenderableTimeVaryingVolume::RenderableTimeVaryingVolume(
     _gridType = static_cast<int>(volume::VolumeGridType::Cartesian);
 
     _stepSize = p.stepSize.value_or(_stepSize);
+    _emptySpaceSkipping = p.emptySpaceSkipping.value_or(_emptySpaceSkipping);
+    if (p.textureFormat.has_value()) {
+        switch (*p.textureFormat) {
+            case Parameters::TextureFormat::Float32:
+                _textureFormat = GL_RED;
+                _bytesPerVoxel = sizeof(float);
+                break;
+            case Parameters::TextureFormat::Float16:
+                _textureFormat = GL_R16F;
+                _bytesPerVoxel = sizeof(uint16_t);
+                break;
+            case Parameters::TextureFormat::UNorm8:
+                _textureFormat = GL_R8;
+                _bytesPerVoxel = sizeof(uint8_t);
+                break;
+        }
+    }
 
     _brightness = p.brightness.value_or(_brightness);
     _secondsBefore = p.secondsBefore.value_or(_secondsBefore);
@@ -243,43 +366,23 @@ void RenderableTimeVaryingVolume::initializeGL() {
         }
     }
 
-    // TODO: defer loading of data to later (separate thread or at least not when loading)
-    for (std::pair<const double, Timestep>& p : _volumeTimesteps) {
-        Timestep& t = p.second;
-        std::string path = fmt::format(
-            "{}/{}.rawvolume", _sourceDirectory.value(), t.baseName
+    if (_isStreaming) {
+        // The timesteps are loaded in the update function once we know the time
+        _streamingJobManager = std::make_unique<ConcurrentJobManager<LoadedTimestep>>(
+            ThreadPool(1)
         );
-        RawVolumeReader<float> reader(path, t.metadata.dimensions);
-        t.rawVolume = reader.read(_invertDataAtZ);
-
-        float min = t.metadata.minValue;
-        float diff = t.metadata.maxValue - t.metadata.minValue;
-        float* data = t.rawVolume->data();
-        for (size_t i = 0; i < t.rawVolume->nCells(); ++i) {
-            data[i] = glm::clamp((data[i] - min) / diff, 0.f, 1.f);
-        }
-
-        t.histogram = std::make_shared<Histogram>(0.f, 1.f, 100);
-        for (size_t i = 0; i < t.rawVolume->nCells(); ++i) {
-            t.histogram->add(data[i]);
+        addProperty(_streamingMemoryLimit);
+    }
+    else {
+        for (std::pair<const double, Timestep>& p : _volumeTimesteps) {
+            Timestep& t = p.second;
+            std::string path = fmt::format(
+                "{}/{}.rawvolume", _sourceDirectory.value(), t.baseName
+            );
+            std::tie(t.rawVolume, t.histogram, t.minMaxGrid) =
+                readTimestep(path, t.metadata, _invertDataAtZ);
+            uploadTimestep(t);
         }
-        // TODO: handle normalization properly for different timesteps + transfer function
-
-        t.texture = std::make_shared<ghoul::opengl::Texture>(
-            t.metadata.dimensions,
-            GL_TEXTURE_3D,
-            ghoul::opengl::Texture::Format::Red,
-            GL_RED,
-            GL_FLOAT,
-            ghoul::opengl::Texture::FilterMode::Linear,
-            ghoul::opengl::Texture::WrappingMode::Clamp
-        );
-
-        t.texture->setPixelData(
-            reinterpret_cast<void*>(data),
-            ghoul::opengl::Texture::TakeOwnership::No
-        );
-        t.texture->uploadTexture();
     }
 
     _clipPlanes->initialize();
@@ -311,6 +414,7 @@ void RenderableTimeVaryingVolume::initializeGL() {
     _jumpToTimestep.setMaxValue(lastTimestep);
 
     addProperty(_stepSize);
+    addProperty(_emptySpaceSkipping);
     addProperty(_transferFunctionPath);
     addProperty(_sourceDirectory);
     addPropertySubOwner(_clipPlanes.get());
@@ -358,6 +462,151 @@ void RenderableTimeVaryingVolume::loadTimestepMetadata(const std::string& path)
     _volumeTimesteps[t.metadata.time] = std::move(t);
 }
 
+void RenderableTimeVaryingVolume::uploadTimestep(Timestep& t) {
+    // Register the texture first so that other volumes' textures can be evicted before
+    // the new one is created. On eviction we keep the data in RAM so that the timestep
+    // can be uploaded again once it is needed
+    const glm::uvec3 dim = t.metadata.dimensions;
+    const uint64_t size = static_cast<uint64_t>(dim.x) * dim.y * dim.z * _bytesPerVoxel;
+    VolumeTextureCache& cache =
+        global::moduleEngine->module<VolumeModule>()->textureCache();
+    t.cacheHandle = cache.allocate(size, [&t]() {
+        t.texture = nullptr;
+        t.onGpu = false;
+        t.cacheHandle = VolumeTextureCache::InvalidHandle;
+    });
+
+    // The data is always normalized floats on the CPU and is converted by the driver into
+    // the requested format during the upload
+    t.texture = std::make_shared<ghoul::opengl::Texture>(
+        t.metadata.dimensions,
+        GL_TEXTURE_3D,
+        ghoul::opengl::Texture::Format::Red,
+        _textureFormat,
+        GL_FLOAT,
+        ghoul::opengl::Texture::FilterMode::Linear,
+        ghoul::opengl::Texture::WrappingMode::Clamp
+    );
+
+    t.texture->setPixelData(
+        reinterpret_cast<void*>(t.rawVolume->data()),
+        ghoul::opengl::Texture::TakeOwnership::No
+    );
+    t.texture->uploadTexture();
+    t.inRam = true;
+    t.onGpu = true;
+}
+
+void RenderableTimeVaryingVolume::unloadTimestep(Timestep& t) {
+    global::moduleEngine->module<VolumeModule>()->textureCache().release(t.cacheHandle);
+    t.cacheHandle = VolumeTextureCache::InvalidHandle;
+    t.texture = nullptr;
+    t.rawVolume = nullptr;
+    t.histogram = nullptr;
+    t.minMaxGrid = nullptr;
+    t.inRam = false;
+    t.onGpu = false;
+}
+
+void RenderableTimeVaryingVolume::updateStreaming() {
+    while (_streamingJobManager->numFinishedJobs() > 0) {
+        LoadedTimestep loaded = _streamingJobManager->popFinishedJob()->product();
+        _nStreamingJobs--;
+
+        Timestep& t = *loaded.timestep;
+        t.isLoading = false;
+        if (loaded.rawVolume) {
+            t.rawVolume = std::move(loaded.rawVolume);
+            t.histogram = std::move(loaded.histogram);
+            t.minMaxGrid = std::move(loaded.minMaxGrid);
+            uploadTimestep(t);
+        }
+    }
+
+    Timestep* current = currentTimestep();
+    if (!current) {
+        // We are outside of the sequence, so we keep whatever is loaded in case the time
+        // moves back into the sequence
+        return;
+    }
+
+    std::vector<Timestep*> timesteps;
+    timesteps.reserve(_volumeTimesteps.size());
+    for (std::pair<const double, Timestep>& p : _volumeTimesteps) {
+        timesteps.push_back(&p.second);
+    }
+    const int currentIndex = timestepIndex(current);
+    const int direction = global::timeManager->deltaTime() < 0.0 ? -1 : 1;
+
+    // Collect the timesteps that should be resident in the order of their priority. The
+    // current timestep is always included, followed by the next one in the direction
+    // of time, the previous one, and then as many upcoming ones as the memory allows
+    const uint64_t limit = static_cast<uint64_t>(_streamingMemoryLimit) * 1024 * 1024;
+    uint64_t usedMemory = 0;
+    std::vector<Timestep*> residents;
+    auto addResident = [&](int index) {
+        if (index < 0 || index >= static_cast<int>(timesteps.size())) {
+            return false;
+        }
+        Timestep* t = timesteps[index];
+        const glm::uvec3 dim = t->metadata.dimensions;
+        const uint64_t size =
+            static_cast<uint64_t>(dim.x) * dim.y * dim.z * _bytesPerVoxel;
+        if (!residents.empty() && usedMemory + size > limit) {
+            return false;
+        }
+        usedMemory += size;
+        residents.push_back(t);
+        return true;
+    };
+
+    addResident(currentIndex);
+    bool hasMemory = addResident(currentIndex + direction);
+    hasMemory &= addResident(currentIndex - direction);
+    for (int i = 2; hasMemory; i++) {
+        hasMemory = addResident(currentIndex + i * direction);
+    }
+
+    for (Timestep* t : timesteps) {
+        const bool isResident =
+            std::find(residents.begin(), residents.end(), t) != residents.end();
+        if ((t->onGpu || t->rawVolume) && !isResident) {
+            unloadTimestep(*t);
+        }
+    }
+
+    for (Timestep* t : residents) {
+        if (_nStreamingJobs >= MaxStreamingJobs) {
+            break;
+        }
+        // Timesteps whose texture was evicted by the texture cache still have their data
+        // and are uploaded again when they become the current timestep
+        if (t->onGpu || t->rawVolume || t->isLoading) {
+            continue;
+        }
+
+        t->isLoading = true;
+        _nStreamingJobs++;
+        std::string path = fmt::format(
+            "{}/{}.rawvolume", _sourceDirectory.value(), t->baseName
+        );
+        _streamingJobManager->enqueueJob(std::make_shared<FunctionJob<LoadedTimestep>>(
+            [t, path, metadata = t->metadata, invertZ = _invertDataAtZ]() {
+                LoadedTimestep result;
+                result.timestep = t;
+                try {
+                    std::tie(result.rawVolume, result.histogram, result.minMaxGrid) =
+                        readTimestep(path, metadata, invertZ);
+                }
+                catch (const ghoul::RuntimeError& e) {
+                    LERRORC(e.component, e.message);
+                }
+                return result;
+            }
+        ));
+    }
+}
+
 RenderableTimeVaryingVolume::Timestep* RenderableTimeVaryingVolume::currentTimestep() {
     if (_volumeTimesteps.empty()) {
         return nullptr;
@@ -430,8 +679,16 @@ void RenderableTimeVaryingVolume::jumpToTimestep(int target) {
 void RenderableTimeVaryingVolume::update(const UpdateData&) {
     _transferFunction->update();
 
+    if (_streamingJobManager) {
+        updateStreaming();
+    }
+
     if (_raycaster) {
         Timestep* t = currentTimestep();
+        if (t && t->rawVolume && !t->texture) {
+            // The texture was evicted from the texture cache while it was not visible
+            uploadTimestep(*t);
+        }
 
         // Set scale and translation matrices:
         // The original data cube is a unit cube centered in 0
@@ -459,11 +716,14 @@ void RenderableTimeVaryingVolume::update(const UpdateData&) {
                 );
             }
             _raycaster->setVolumeTexture(t->texture);
+            _raycaster->setMinMaxGrid(t->minMaxGrid);
         }
         else {
             _raycaster->setVolumeTexture(nullptr);
+            _raycaster->setMinMaxGrid(nullptr);
         }
         _raycaster->setStepSize(_stepSize);
+        _raycaster->setEmptySpaceSkipping(_emptySpaceSkipping);
         _raycaster->setBrightness(_brightness * opacity());
         _raycaster->setRNormalization(_rNormalization);
         _raycaster->setRUpperBound(_rUpperBound);
@@ -472,15 +732,63 @@ void RenderableTimeVaryingVolume::update(const UpdateData&) {
 
 void RenderableTimeVaryingVolume::render(const RenderData& data, RendererTasks& tasks) {
     if (_raycaster && _raycaster->volumeTexture()) {
+        Timestep* t = currentTimestep();
+        if (t) {
+            global::moduleEngine->module<VolumeModule>()->textureCache().use(
+                t->cacheHandle
+            );
+        }
         tasks.raycasterTasks.push_back({ _raycaster.get(), data });
     }
 }
 
+Renderable::MemoryUsage RenderableTimeVaryingVolume::memoryUsage() const {
+    MemoryUsage usage;
+    for (const std::pair<const double, Timestep>& p : _volumeTimesteps) {
+        const Timestep& t = p.second;
+        if (t.onGpu) {
+            usage.gpuTextures += textureMemory(t.texture.get());
+        }
+        if (t.inRam && t.rawVolume) {
+            usage.cpuData += t.rawVolume->nCells() * sizeof(float);
+        }
+    }
+    return usage;
+}
+
+bool RenderableTimeVaryingVolume::reduceMemoryUsage() {
+    // Without streaming, all timesteps have to be resident
+    if (!_isStreaming || _streamingMemoryLimit <= _streamingMemoryLimit.minValue()) {
+        return false;
+    }
+    // The timesteps that no longer fit are unloaded in the next update
+    _streamingMemoryLimit = std::max(
+        _streamingMemoryLimit * 3 / 4,
+        _streamingMemoryLimit.minValue()
+    );
+    return true;
+}
+
 bool RenderableTimeVaryingVolume::isReady() const {
     return true;
 }
 
 void RenderableTimeVaryingVolume::deinitializeGL() {
+    if (_streamingJobManager) {
+        _streamingJobManager->clearEnqueuedJobs();
+        _streamingJobManager = nullptr;
+        _nStreamingJobs = 0;
+    }
+
+    VolumeTextureCache& cache =
+        global::moduleEngine->module<VolumeModule>()->textureCache();
+    for (std::pair<const double, Timestep>& p : _volumeTimesteps) {
+        cache.release(p.second.cacheHandle);
+        p.second.cacheHandle = VolumeTextureCache::InvalidHandle;
+        p.second.texture = nullptr;
+        p.second.onGpu = false;
+    }
+
     if (_raycaster) {
         global::raycasterManager->detachRaycaster(*_raycaster.get());
         _raycaster = nullptr;
@@ -28,12 +28,16 @@
 #include <openspace/rendering/renderable.h>
 
 #include <modules/volume/rawvolumemetadata.h>
+#include <modules/volume/volumetexturecache.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/stringproperty.h>
+#include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/triggerproperty.h>
 #include <openspace/rendering/transferfunction.h>
+#include <openspace/util/concurrentjobmanager.h>
+#include <ghoul/opengl/ghoul_gl.h>
 
 namespace openspace {
     class Histogram;
@@ -44,6 +48,7 @@ namespace openspace::volume {
 
 //class TransferFunction;
 class BasicVolumeRaycaster;
+struct MinMaxGrid;
 template <typename T> class RawVolume;
 class VolumeClipPlanes;
 
@@ -58,6 +63,9 @@ public:
     void render(const RenderData& data, RendererTasks& tasks) override;
     void update(const UpdateData& data) override;
 
+    MemoryUsage memoryUsage() const override;
+    bool reduceMemoryUsage() override;
+
     static documentation::Documentation Documentation();
 
 private:
@@ -65,10 +73,23 @@ private:
         std::string baseName;
         bool inRam;
         bool onGpu;
+        /// Only used in streaming mode, `true` while a background job reads the volume
+        bool isLoading = false;
         RawVolumeMetadata metadata;
         std::shared_ptr<RawVolume<float>> rawVolume;
         std::shared_ptr<ghoul::opengl::Texture> texture;
         std::shared_ptr<Histogram> histogram;
+        std::shared_ptr<MinMaxGrid> minMaxGrid;
+        /// The handle of the texture in the VolumeModule's texture cache
+        VolumeTextureCache::Handle cacheHandle = VolumeTextureCache::InvalidHandle;
+    };
+
+    /// The result of reading a single timestep on the streaming thread
+    struct LoadedTimestep {
+        Timestep* timestep = nullptr;
+        std::shared_ptr<RawVolume<float>> rawVolume;
+        std::shared_ptr<Histogram> histogram;
+        std::shared_ptr<MinMaxGrid> minMaxGrid;
     };
 
     Timestep* currentTimestep();
@@ -77,11 +98,22 @@ private:
     void jumpToTimestep(int i);
 
     void loadTimestepMetadata(const std::string& path);
+    void uploadTimestep(Timestep& t);
+    void unloadTimestep(Timestep& t);
+
+    /**
+     * Uploads the timesteps that have been read by the streaming thread since the last
+     * call and decides which timesteps should be resident on the GPU. Starting at the
+     * current timestep, timesteps in the direction of time are requested until the
+     * memory limit is reached, all other timesteps are unloaded.
+     */
+    void updateStreaming();
 
     properties::OptionProperty _gridType;
     std::shared_ptr<VolumeClipPlanes> _clipPlanes;
 
     properties::FloatProperty _stepSize;
+    properties::BoolProperty _emptySpaceSkipping;
     properties::FloatProperty _brightness;
     properties::FloatProperty _rNormalization;
     properties::FloatProperty _rUpperBound;
@@ -93,10 +125,19 @@ private:
     properties::TriggerProperty _triggerTimeJump;
     properties::IntProperty _jumpToTimestep;
 
+    properties::IntProperty _streamingMemoryLimit;
+
     std::map<double, Timestep> _volumeTimesteps;
     std::unique_ptr<BasicVolumeRaycaster> _raycaster;
     bool _invertDataAtZ;
 
+    /// The internal format of the timestep textures and the GPU memory per voxel
+    GLenum _textureFormat = GL_RED;
+    unsigned int _bytesPerVoxel = sizeof(float);
+    bool _isStreaming = false;
+    std::unique_ptr<ConcurrentJobManager<LoadedTimestep>> _streamingJobManager;
+    int _nStreamingJobs = 0;
+
     std::shared_ptr<openspace::TransferFunction> _transferFunction;
 };
 
@@ -43,10 +43,29 @@ uniform float rNormalization_#{id} = 0.0;
 
 uniform float rUpperBound_#{id} = 1.0;
 
+// Coarse grid that marks the cells that contain at least one visible value under the
+// current transfer function. Empty cells are skipped in a single step
+uniform bool useEmptySpaceSkipping_#{id} = false;
+uniform sampler3D occupancyTexture_#{id};
+uniform vec3 occupancyDimensions_#{id} = vec3(1.0);
+
 
 void sample#{id}(vec3 samplePos, vec3 dir, inout vec3 accumulatedColor,
                  inout vec3 accumulatedAlpha, inout float stepSize)
 {
+  if (useEmptySpaceSkipping_#{id} && texture(occupancyTexture_#{id}, samplePos).r < 0.5) {
+    // Step to the exit of the empty cell. The next step starts at most half a step
+    // ahead of this sample due to the jittering, so that distance is subtracted to
+    // never step over the beginning of the next cell
+    vec3 cell = floor(samplePos * occupancyDimensions_#{id});
+    vec3 bound = (cell + step(vec3(0.0), dir)) / occupancyDimensions_#{id};
+    vec3 safeDir = mix(dir, vec3(1e-6), equal(dir, vec3(0.0)));
+    vec3 distances = (bound - samplePos) / safeDir;
+    float exitDistance = min(min(distances.x, distances.y), distances.z);
+    stepSize = max(exitDistance - 0.5 * stepSize, maxStepSize#{id});
+    return;
+  }
+
   vec3 transformedPos = samplePos;
   if (gridType_#{id} == 1) {
     transformedPos = volume_cartesianToSpherical(samplePos);
@@ -100,6 +100,10 @@ std::string GenerateRawVolumeTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> GenerateRawVolumeTask::outputFiles() const {
+    return { _rawVolumeOutputPath, _dictionaryOutputPath };
+}
+
 void GenerateRawVolumeTask::perform(const Task::ProgressCallback& progressCallback) {
     // Spice kernel is required for time conversions.
     // Todo: Make this dependency less hard coded.
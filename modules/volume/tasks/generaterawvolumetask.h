@@ -38,6 +38,7 @@ public:
     GenerateRawVolumeTask(const ghoul::Dictionary& dictionary);
     std::string description() override;
     void perform(const Task::ProgressCallback& progressCallback) override;
+    std::vector<std::filesystem::path> outputFiles() const override;
     static documentation::Documentation Documentation();
 
 private:
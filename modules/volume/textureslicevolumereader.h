@@ -25,13 +25,15 @@
 #ifndef __OPENSPACE_MODULE_VOLUME___TEXTURESLICEVOLUMEREADER___H__
 #define __OPENSPACE_MODULE_VOLUME___TEXTURESLICEVOLUMEREADER___H__
 
-#include <modules/volume/linearlrucache.h>
+#include <openspace/util/lrucache.h>
 #include <ghoul/glm.h>
 #include <memory>
 #include <vector>
 
 namespace ghoul::opengl { class Texture; }
 
+namespace openspace { class ThreadPool; }
+
 namespace openspace::volume {
 
 template <typename Type>
@@ -39,12 +41,20 @@ class TextureSliceVolumeReader {
 public:
     using VoxelType = Type;
 
-    TextureSliceVolumeReader(std::vector<std::string> paths, size_t sliceCacheMaxItems,
-        size_t sliceCacheSize);
+    TextureSliceVolumeReader(std::vector<std::string> paths, size_t sliceCacheSize);
     virtual ~TextureSliceVolumeReader();
 
     void initialize();
 
+    /**
+     * Loads all slices in the range [\p firstSlice, \p lastSlice] that are not in the
+     * cache yet, decoding the images concurrently on the provided \p pool. The range is
+     * clamped to the available slices and has to fit into the cache. Afterwards, #get can
+     * be called concurrently from multiple threads as long as only the slices in this
+     * range are accessed.
+     */
+    void preload(int firstSlice, int lastSlice, ThreadPool& pool);
+
     VoxelType get(const glm::ivec3& coordinates) const;
     virtual glm::ivec3 dimensions() const;
     void setPaths(std::vector<std::string> paths);
@@ -52,7 +62,7 @@ public:
 private:
     ghoul::opengl::Texture& getSlice(int sliceIndex) const;
     std::vector<std::string> _paths;
-    mutable LinearLruCache<std::shared_ptr<ghoul::opengl::Texture>> _cache;
+    mutable LruCache<int, std::shared_ptr<ghoul::opengl::Texture>> _cache;
     glm::ivec2 _sliceDimensions = glm::ivec2(0);
     bool _isInitialized = false;
 };
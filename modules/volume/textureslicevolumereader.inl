@@ -22,18 +22,19 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
+#include <openspace/util/threadpool.h>
 #include <ghoul/io/texture/texturereader.h>
 #include <ghoul/opengl/texture.h>
+#include <algorithm>
 
 namespace openspace::volume {
 
 template <typename VoxelType>
 TextureSliceVolumeReader<VoxelType>::TextureSliceVolumeReader(
                                                            std::vector<std::string> paths,
-                                                           size_t sliceCacheNIndices,
                                                            size_t sliceCacheCapacity)
     : _paths(std::move(paths))
-    , _cache(sliceCacheCapacity, sliceCacheNIndices)
+    , _cache(sliceCacheCapacity)
 {}
 
 template <typename VoxelType>
@@ -49,7 +50,51 @@ void TextureSliceVolumeReader<VoxelType>::initialize() {
     glm::uvec3 dimensions = firstSlice->dimensions();
     _sliceDimensions = glm::uvec2(dimensions.x, dimensions.y);
     _isInitialized = true;
-    _cache.set(0, firstSlice);
+    _cache.put(0, firstSlice);
+}
+
+template <typename VoxelType>
+void TextureSliceVolumeReader<VoxelType>::preload(int firstSlice, int lastSlice,
+                                                  ThreadPool& pool)
+{
+    ghoul_assert(_isInitialized, "Volume is not initialized");
+
+    const int first = std::max(firstSlice, 0);
+    const int last = std::min(lastSlice, static_cast<int>(_paths.size()) - 1);
+    if (first > last) {
+        return;
+    }
+    ghoul_assert(
+        static_cast<size_t>(last - first + 1) <= _cache.maximumCacheSize(),
+        "Slices do not fit into the cache"
+    );
+
+    // Mark the cached slices in the range as recently used first, so that inserting the
+    // missing slices only evicts slices outside of the range
+    std::vector<int> missing;
+    for (int i = first; i <= last; i++) {
+        if (!_cache.touch(i)) {
+            missing.push_back(i);
+        }
+    }
+
+    std::vector<std::shared_ptr<ghoul::opengl::Texture>> textures(missing.size());
+    pool.parallelFor(0, missing.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            textures[i] = ghoul::io::TextureReader::ref().loadTexture(
+                _paths[missing[i]],
+                2
+            );
+        }
+    });
+
+    for (size_t i = 0; i < missing.size(); i++) {
+        ghoul_assert(
+            glm::ivec2(textures[i]->dimensions()) == _sliceDimensions,
+            "Slice dimensions do not agree"
+        );
+        _cache.put(missing[i], std::move(textures[i]));
+    }
 }
 
 template <typename VoxelType>
@@ -78,7 +123,7 @@ TextureSliceVolumeReader<VoxelType>::getSlice(int sliceIndex) const
         "Slice index " + std::to_string(sliceIndex) + "is outside the range"
     );
 
-    if (!_cache.has(sliceIndex)) {
+    if (!_cache.exist(sliceIndex)) {
         std::shared_ptr<ghoul::opengl::Texture> texture =
             ghoul::io::TextureReader::ref().loadTexture(_paths[sliceIndex], 2);
 
@@ -86,9 +131,9 @@ TextureSliceVolumeReader<VoxelType>::getSlice(int sliceIndex) const
             glm::ivec2(texture->dimensions()) == _sliceDimensions,
             "Slice dimensions do not agree"
         );
-        _cache.set(sliceIndex, std::move(texture));
+        _cache.put(sliceIndex, std::move(texture));
     }
-    return *_cache.get(sliceIndex).get();
+    return *_cache.peek(sliceIndex);
 }
 
 } // namespace openspace::volume
@@ -26,8 +26,12 @@
 
 #include <ghoul/lua/ghoul_lua.h>
 #include <ghoul/misc/dictionaryluaformatter.h>
+#include <ghoul/misc/assert.h>
 #include <ghoul/opengl/texture.h>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <limits>
 
 using json = nlohmann::json;
 
@@ -191,35 +195,77 @@ bool TransferFunction::createTexture(ghoul::opengl::Texture& ptr) {
     }
     else {
         float* transferFunction = new float[_width * 4];
-        std::memset(transferFunction, 0, _width * 4 * sizeof(float));
-
-        for (int i = 0; i < _width ; ++i) {
-            const float position = static_cast<float>(i) / static_cast<float>(_width);
-            int count = 0;
-            glm::vec4 rgbFromEnvelopes(0.f);
-            float alpha = 0.f;
-            for (const Envelope& env : _envelopes) {
-                if (env.isValueInEnvelope(position) && env.isEnvelopeValid()) {
-                    count++;
-                    const glm::vec4 tmp = env.valueAtPosition(position);
-                    rgbFromEnvelopes.r += tmp.r * tmp.a;
-                    rgbFromEnvelopes.g += tmp.g * tmp.a;
-                    rgbFromEnvelopes.b += tmp.b * tmp.a;
-                    alpha = std::min(alpha, tmp.a);
-                }
-            }
-            rgbFromEnvelopes /= (count == 0) ? 1.f : static_cast<float>(count);
-            rgbFromEnvelopes.w = alpha;
+        rasterize(transferFunction, 0, _width);
+        ptr.setPixelData(transferFunction);
+        return true;
+    }
+}
 
-            for (int channel = 0; channel < 4; ++channel) {
-                const int p = 4 * i + channel;
-                const float value = rgbFromEnvelopes[channel];
-                transferFunction[p] = value;
+int TransferFunction::width() const {
+    return _width;
+}
+
+void TransferFunction::rasterize(float* texels, int first, int last) const {
+    ghoul_assert(first >= 0 && last <= _width, "Texel range out of bounds");
+
+    for (int i = first; i < last; ++i) {
+        const float position = static_cast<float>(i) / static_cast<float>(_width);
+        int count = 0;
+        glm::vec4 rgbFromEnvelopes(0.f);
+        float alpha = 0.f;
+        for (const Envelope& env : _envelopes) {
+            if (env.isValueInEnvelope(position) && env.isEnvelopeValid()) {
+                count++;
+                const glm::vec4 tmp = env.valueAtPosition(position);
+                rgbFromEnvelopes.r += tmp.r * tmp.a;
+                rgbFromEnvelopes.g += tmp.g * tmp.a;
+                rgbFromEnvelopes.b += tmp.b * tmp.a;
+                alpha = std::min(alpha, tmp.a);
             }
         }
-        ptr.setPixelData(transferFunction);
-        return true;
+        rgbFromEnvelopes /= (count == 0) ? 1.f : static_cast<float>(count);
+        rgbFromEnvelopes.w = alpha;
+
+        for (int channel = 0; channel < 4; ++channel) {
+            texels[4 * i + channel] = rgbFromEnvelopes[channel];
+        }
+    }
+}
+
+glm::ivec2 TransferFunction::changedTexelRange(const TransferFunction& previous) const {
+    if (_width != previous._width || _envelopes.size() != previous._envelopes.size()) {
+        return glm::ivec2(0, _width);
     }
+
+    float minPosition = std::numeric_limits<float>::max();
+    float maxPosition = -std::numeric_limits<float>::max();
+    auto extend = [&minPosition, &maxPosition](const Envelope& env) {
+        for (const EnvelopePoint& point : env.points()) {
+            minPosition = std::min(minPosition, point.position.first);
+            maxPosition = std::max(maxPosition, point.position.first);
+        }
+    };
+    for (size_t i = 0; i < _envelopes.size(); ++i) {
+        if (_envelopes[i] != previous._envelopes[i]) {
+            extend(_envelopes[i]);
+            extend(previous._envelopes[i]);
+        }
+    }
+
+    if (minPosition > maxPosition) {
+        // No envelope has changed
+        return glm::ivec2(0);
+    }
+
+    // Texel i samples the position i / width, so the texels that are covered by the
+    // changed envelopes are those in [ceil(min * width), floor(max * width)]
+    const float w = static_cast<float>(_width);
+    const int first = static_cast<int>(std::ceil(minPosition * w));
+    const int last = static_cast<int>(std::floor(maxPosition * w)) + 1;
+    return glm::ivec2(
+        std::clamp(first, 0, _width),
+        std::clamp(std::max(first, last), 0, _width)
+    );
 }
 
 } // namespace openspace::volume
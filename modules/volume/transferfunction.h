@@ -52,6 +52,22 @@ public:
     bool createTexture(ghoul::opengl::Texture& ptr);
     std::string serializedToString() const;
 
+    int width() const;
+
+    /**
+     * Evaluates the envelopes for the texels in the range [\p first, \p last) and writes
+     * them as RGBA values into \p texels, which must hold 4 * width() floats.
+     */
+    void rasterize(float* texels, int first, int last) const;
+
+    /**
+     * Returns the range [x, y) of texels that differ between this transfer function and
+     * \p previous. If envelopes were only moved, this is the union of the ranges that
+     * are covered by the changed envelopes before and after the change. The range is
+     * empty if nothing has changed.
+     */
+    glm::ivec2 changedTexelRange(const TransferFunction& previous) const;
+
 private:
     int _width = 1024;
     std::string _loadableFilePath;
@@ -111,9 +111,43 @@ void TransferFunctionHandler::initialize() {
 }
 
 void TransferFunctionHandler::setTexture() {
-    if (_transferFunctionProperty.value().createTexture(*_texture)) {
+    TransferFunction tf = _transferFunctionProperty.value();
+    if (!tf.hasEnvelopes()) {
+        return;
+    }
+
+    const int width = tf.width();
+    if (!_hasUploadedTexture || static_cast<int>(_texels.size()) != 4 * width) {
+        _texels.resize(4 * width);
+        tf.rasterize(_texels.data(), 0, width);
+        _texture->setPixelData(
+            _texels.data(),
+            ghoul::opengl::Texture::TakeOwnership::No
+        );
         uploadTexture();
+        _hasUploadedTexture = true;
+        _uploadedTransferFunction = std::move(tf);
+        return;
+    }
+
+    // Dragging an envelope in the GUI only changes the texels that the envelope covers,
+    // so we only evaluate and upload that part of the texture
+    const glm::ivec2 range = tf.changedTexelRange(_uploadedTransferFunction);
+    if (range.x >= range.y) {
+        return;
     }
+    tf.rasterize(_texels.data(), range.x, range.y);
+    _texture->bind();
+    glTexSubImage1D(
+        GL_TEXTURE_1D,
+        0,
+        range.x,
+        range.y - range.x,
+        GL_RGBA,
+        GL_FLOAT,
+        _texels.data() + 4 * range.x
+    );
+    _uploadedTransferFunction = std::move(tf);
 }
 
 void TransferFunctionHandler::setUnit(std::string unit) {
@@ -32,6 +32,7 @@
 #include <openspace/properties/triggerproperty.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace openspace {
     class Histogram;
@@ -71,6 +72,12 @@ private:
     properties::TransferFunctionProperty _transferFunctionProperty;
     std::shared_ptr<openspace::TransferFunction> _transferFunction;
     std::shared_ptr<ghoul::opengl::Texture> _texture;
+
+    /// The texel values of the texture, kept so that edits only touch the changed part
+    std::vector<float> _texels;
+    /// The transfer function that is currently in the texture
+    TransferFunction _uploadedTransferFunction;
+    bool _hasUploadedTexture = false;
 };
 
 } //namespace openspace::volume
@@ -32,14 +32,46 @@
 #include <openspace/util/factorymanager.h>
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/templatefactory.h>
+#include <optional>
+
+namespace {
+    constexpr uint64_t BytesPerMB = 1024 * 1024;
+
+    constexpr openspace::properties::Property::PropertyInfo GpuMemoryBudgetInfo = {
+        "GpuMemoryBudget",
+        "GPU Memory Budget (MB)",
+        "The maximum amount of graphics memory in megabytes that is shared between the "
+        "textures of all volume renderables. If a new volume texture does not fit, the "
+        "least recently rendered volumes that are not currently visible are evicted",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    struct [[codegen::Dictionary(VolumeModule)]] Parameters {
+        // [[codegen::verbatim(GpuMemoryBudgetInfo.description)]]
+        std::optional<int> gpuMemoryBudget [[codegen::greater(0)]];
+    };
+#include "volumemodule_codegen.cpp"
+} // namespace
 
 namespace openspace {
 
 using namespace volume;
 
-VolumeModule::VolumeModule() : OpenSpaceModule(Name) {}
+VolumeModule::VolumeModule()
+    : OpenSpaceModule(Name)
+    , _gpuMemoryBudgetMB(GpuMemoryBudgetInfo, 4096, 64, 65536)
+    , _textureCache(4096 * BytesPerMB)
+{
+    _gpuMemoryBudgetMB.onChange([this]() {
+        _textureCache.setBudget(static_cast<uint64_t>(_gpuMemoryBudgetMB) * BytesPerMB);
+    });
+    addProperty(_gpuMemoryBudgetMB);
+}
+
+void VolumeModule::internalInitialize(const ghoul::Dictionary& dict) {
+    const Parameters p = codegen::bake<Parameters>(dict);
+    _gpuMemoryBudgetMB = p.gpuMemoryBudget.value_or(_gpuMemoryBudgetMB);
 
-void VolumeModule::internalInitialize(const ghoul::Dictionary&) {
     ghoul::TemplateFactory<Renderable>* rFactory =
         FactoryManager::ref().factory<Renderable>();
     ghoul_assert(rFactory, "No renderable factory existed");
@@ -57,4 +89,8 @@ std::vector<documentation::Documentation> VolumeModule::documentations() const {
     };
 }
 
+VolumeTextureCache& VolumeModule::textureCache() {
+    return _textureCache;
+}
+
 } // namespace openspace
@@ -27,6 +27,9 @@
 
 #include <openspace/util/openspacemodule.h>
 
+#include <modules/volume/volumetexturecache.h>
+#include <openspace/properties/scalar/intproperty.h>
+
 namespace openspace {
 
 class VolumeModule : public OpenSpaceModule {
@@ -38,6 +41,15 @@ public:
     void internalInitialize(const ghoul::Dictionary&) override;
 
     std::vector<documentation::Documentation> documentations() const override;
+
+    /**
+     * Returns the cache that shares the GPU memory budget between all volume renderables
+     */
+    volume::VolumeTextureCache& textureCache();
+
+private:
+    properties::IntProperty _gpuMemoryBudgetMB;
+    volume::VolumeTextureCache _textureCache;
 };
 
 } // namespace openspace
@@ -0,0 +1,141 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/volume/volumetexturecache.h>
+
+#include <openspace/engine/globals.h>
+#include <openspace/rendering/renderengine.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <vector>
+
+namespace {
+    constexpr std::string_view _loggerCat = "VolumeTextureCache";
+
+    // The number of textures the cache can hold initially. The capacity is doubled
+    // whenever it is reached, as the textures are only limited by their total size
+    constexpr size_t InitialCapacity = 64;
+} // namespace
+
+namespace openspace::volume {
+
+VolumeTextureCache::VolumeTextureCache(uint64_t budget)
+    : _entries(InitialCapacity)
+    , _budget(budget)
+{}
+
+VolumeTextureCache::Handle VolumeTextureCache::allocate(uint64_t bytes,
+                                                        EvictCallback onEvict)
+{
+    makeRoom(bytes);
+    if (_entries.weight() + bytes > _budget && !_hasWarned) {
+        LWARNING(fmt::format(
+            "Exceeding the volume memory budget of {} MB as all volumes are visible",
+            _budget / (1024 * 1024)
+        ));
+        _hasWarned = true;
+    }
+
+    const Handle handle = _nextHandle;
+    _nextHandle++;
+
+    if (_entries.size() == _entries.maximumCacheSize()) {
+        _entries.setMaximumCacheSize(2 * _entries.maximumCacheSize());
+    }
+    Entry entry;
+    entry.bytes = bytes;
+    entry.onEvict = std::move(onEvict);
+    _entries.put(handle, std::move(entry), bytes);
+    return handle;
+}
+
+void VolumeTextureCache::use(Handle handle) {
+    if (!_entries.touch(handle)) {
+        return;
+    }
+
+    Entry& entry = _entries.peek(handle);
+    entry.hasBeenUsed = true;
+    entry.lastUsedFrame = global::renderEngine->frameNumber();
+}
+
+void VolumeTextureCache::release(Handle handle) {
+    if (!_entries.erase(handle)) {
+        return;
+    }
+
+    if (_entries.weight() <= _budget) {
+        _hasWarned = false;
+    }
+}
+
+void VolumeTextureCache::setBudget(uint64_t budget) {
+    _budget = budget;
+    makeRoom(0);
+}
+
+uint64_t VolumeTextureCache::budget() const {
+    return _budget;
+}
+
+uint64_t VolumeTextureCache::usedMemory() const {
+    return _entries.weight();
+}
+
+void VolumeTextureCache::makeRoom(uint64_t bytes) {
+    const uint64_t frame = global::renderEngine->frameNumber();
+
+    // Walk from the least recently used texture towards the most recently used one. The
+    // textures that can't be evicted are taken out of the cache on the way and are put
+    // back in the same order afterwards
+    std::vector<LruCache<Handle, Entry>::Item> kept;
+    uint64_t keptBytes = 0;
+    while (_entries.weight() + keptBytes + bytes > _budget && !_entries.isEmpty()) {
+        LruCache<Handle, Entry>::Item item = _entries.popLRU();
+        Entry& entry = item.second;
+
+        // Textures that were rendered in this or the last frame are visible and pinned
+        // textures can't be evicted at all. Textures that were never rendered, for
+        // example prefetched timesteps, can always be evicted
+        const bool isVisible = entry.hasBeenUsed && entry.lastUsedFrame + 1 >= frame;
+        if (isVisible || !entry.onEvict) {
+            keptBytes += entry.bytes;
+            kept.push_back(std::move(item));
+            continue;
+        }
+
+        // The entry has already been removed, so the owner can call release from within
+        // the callback
+        entry.onEvict();
+    }
+
+    // The oldest texture was taken out first, so it has to be put back last to end up
+    // at the back of the queue again
+    for (auto it = kept.rbegin(); it != kept.rend(); it++) {
+        const uint64_t entryBytes = it->second.bytes;
+        _entries.putBackAndFetchPopped(it->first, std::move(it->second), entryBytes);
+    }
+}
+
+} // namespace openspace::volume
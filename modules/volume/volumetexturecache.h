@@ -0,0 +1,96 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_VOLUME___VOLUMETEXTURECACHE___H__
+#define __OPENSPACE_MODULE_VOLUME___VOLUMETEXTURECACHE___H__
+
+#include <openspace/util/lrucache.h>
+#include <cstdint>
+#include <functional>
+
+namespace openspace::volume {
+
+/**
+ * Keeps track of the graphics memory that is used by the textures of all volume
+ * renderables so that they share a common budget. Each texture is registered with an
+ * #allocate call before it is created. If the new texture does not fit into the budget,
+ * the least recently used textures that have not been rendered in the current or the
+ * previous frame are evicted by calling their eviction callback. Textures without an
+ * eviction callback are never evicted but still count towards the budget. If all other
+ * textures are visible, the budget is exceeded rather than evicting a visible volume.
+ */
+class VolumeTextureCache {
+public:
+    using Handle = uint64_t;
+    static constexpr Handle InvalidHandle = 0;
+
+    /// Called when the texture has to be freed. The owner must not use the handle again
+    using EvictCallback = std::function<void()>;
+
+    explicit VolumeTextureCache(uint64_t budget);
+
+    /**
+     * Registers a texture of \p bytes size with the cache, evicting other textures if
+     * necessary, and returns the handle that identifies it.
+     */
+    Handle allocate(uint64_t bytes, EvictCallback onEvict);
+
+    /**
+     * Marks the texture as rendered in the current frame, which also makes it the most
+     * recently used one. Passing the InvalidHandle is a no-op.
+     */
+    void use(Handle handle);
+
+    /**
+     * Removes the texture from the cache after it has been freed by its owner. Passing
+     * a handle that was already evicted or the InvalidHandle is a no-op.
+     */
+    void release(Handle handle);
+
+    void setBudget(uint64_t budget);
+    uint64_t budget() const;
+    uint64_t usedMemory() const;
+
+private:
+    /// Evicts textures until \p bytes additional bytes fit into the budget
+    void makeRoom(uint64_t bytes);
+
+    struct Entry {
+        uint64_t bytes = 0;
+        EvictCallback onEvict;
+        bool hasBeenUsed = false;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    /// The textures by their handle, weighted by their size. The cache itself does not
+    /// limit the weight, as textures that are visible must not be evicted
+    LruCache<Handle, Entry> _entries;
+    uint64_t _budget = 0;
+    Handle _nextHandle = 1;
+    bool _hasWarned = false;
+};
+
+} // namespace openspace::volume
+
+#endif // __OPENSPACE_MODULE_VOLUME___VOLUMETEXTURECACHE___H__
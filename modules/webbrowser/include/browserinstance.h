@@ -46,6 +46,7 @@
 #endif // _MSC_VER
 
 #include <ghoul/glm.h>
+#include <chrono>
 #include <string>
 
 namespace openspace {
@@ -116,6 +117,19 @@ public:
 
     bool hasContent(const glm::ivec2& pos) const;
 
+    /**
+     * Updates the rate at which the browser renders its content. The browser uses
+     * \p activeFrameRate while it is receiving input or loading a page and drops to
+     * \p idleFrameRate once it has been left alone for a while.
+     */
+    void updateFrameRate(int activeFrameRate, int idleFrameRate);
+
+    /**
+     * Notifies the browser whether its content is currently shown anywhere. A hidden
+     * browser does not render at all until it becomes visible again.
+     */
+    void setHidden(bool isHidden);
+
     bool _shouldReshape = false;
 
 private:
@@ -125,6 +139,10 @@ private:
     CefRefPtr<CefBrowser> _browser;
     bool _isInitialized = false;
     double _zoomLevel = 1.0;
+
+    std::chrono::steady_clock::time_point _lastActivity;
+    int _frameRate = 0;
+    bool _isHidden = false;
 };
 
 } // namespace openspace
@@ -35,6 +35,7 @@
 #ifdef WIN32
 #pragma warning(pop)
 #endif // WIN32
+#include <chrono>
 #include <string>
 
 struct CefSettingsTraits;
@@ -43,14 +44,24 @@ using CefSettings = CefStructBase<CefSettingsTraits>;
 
 namespace openspace {
 
+class WebBrowserApp;
+
 class CefHost {
 public:
     CefHost(const std::string& helperLocation);
     ~CefHost();
+
+    /**
+     * Runs the CEF message loop if CEF has scheduled work that is due, or if the loop
+     * has not been run for a while. This is cheap to call when there is nothing to do.
+     */
     void doMessageLoopWork();
 
 private:
     void attachDebugSettings(CefSettings&);
+
+    CefRefPtr<WebBrowserApp> _app;
+    std::chrono::steady_clock::time_point _lastMessageLoopWork;
 };
 
 } // namespace openspace
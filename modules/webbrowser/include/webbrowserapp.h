@@ -37,23 +37,46 @@
 #pragma warning (pop)
 #endif // _MSC_VER
 
+#include <atomic>
+#include <chrono>
+
 namespace openspace {
 
 /**
- * Custom interface to CefApp and CefRenderProcessHandler. This allows us to
- * set global objects within, and modify, the DOM.
+ * Custom interface to CefApp, CefBrowserProcessHandler, and CefRenderProcessHandler.
+ * This allows us to set global objects within, and modify, the DOM. It also keeps
+ * track of when CEF has requested its message loop to be run.
  */
-class WebBrowserApp : public CefApp, public CefRenderProcessHandler {
+class WebBrowserApp : public CefApp, public CefBrowserProcessHandler,
+                      public CefRenderProcessHandler
+{
 public:
     WebBrowserApp() = default;
 
+    CefRefPtr<CefBrowserProcessHandler> GetBrowserProcessHandler() override;
     CefRefPtr<CefRenderProcessHandler> GetRenderProcessHandler() override;
+
+    /**
+     * Called by CEF from any thread whenever it needs the message loop to do work
+     * within \p delayMs milliseconds.
+     */
+    void OnScheduleMessagePumpWork(int64 delayMs) override;
     void OnContextCreated(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> frame,
         CefRefPtr<CefV8Context> context) override;
     void OnBeforeCommandLineProcessing(const CefString &process_type,
         CefRefPtr<CefCommandLine> command_line) override;
 
+    /**
+     * Returns `true` if CEF has scheduled message loop work that is due at \p time and
+     * marks that work as handled.
+     */
+    bool consumeScheduledWork(std::chrono::steady_clock::time_point time);
+
 private:
+    /// The time, in steady clock ticks, at which the next scheduled work is due
+    std::atomic<std::chrono::steady_clock::rep> _scheduledWork =
+        std::chrono::steady_clock::duration::max().count();
+
     IMPLEMENT_REFCOUNTING(WebBrowserApp);
 };
 
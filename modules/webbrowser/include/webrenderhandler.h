@@ -52,6 +52,8 @@ class WebRenderHandler : public CefRenderHandler {
 public:
     using Pixel = glm::tvec4<char>;
 
+    ~WebRenderHandler() override;
+
     virtual void draw(void) = 0;
     virtual void render() = 0;
 
@@ -78,9 +80,17 @@ private:
     std::vector<Pixel> _browserBuffer;
     bool _needsRepaint = true;
     bool _textureSizeIsDirty = true;
-    bool _textureIsDirty = true;
-    glm::ivec2 _lowerDirtyRectBound = glm::ivec2(0);
-    glm::ivec2 _upperDirtyRectBound = glm::ivec2(0);
+
+    /**
+     * Regions of the browser buffer that have changed since the last texture upload,
+     * stored as (x, y, width, height) in OpenGL (bottom-up) coordinates
+     */
+    std::vector<glm::ivec4> _dirtyRects;
+
+    /**
+     * Pixel unpack buffer that is used to stream the dirty regions to the texture
+     */
+    GLuint _pixelBuffer = 0;
 
     IMPLEMENT_REFCOUNTING(WebRenderHandler);
 };
@@ -39,6 +39,13 @@
 
 namespace {
     constexpr std::string_view _loggerCat = "CEF BrowserInstance";
+
+    // The frame rate that a browser is created with until its first update
+    constexpr int InitialFrameRate = 60;
+
+    // The time after the last input or page load after which a browser is considered
+    // to be idle and switches to the idle frame rate
+    constexpr std::chrono::seconds IdleTimeout = std::chrono::seconds(2);
 } // namespace
 
 namespace openspace {
@@ -56,7 +63,9 @@ BrowserInstance::BrowserInstance(WebRenderHandler* renderer,
     windowInfo.SetAsWindowless(0);
 
     CefBrowserSettings browserSettings;
-    browserSettings.windowless_frame_rate = 60;
+    browserSettings.windowless_frame_rate = InitialFrameRate;
+    _frameRate = InitialFrameRate;
+    _lastActivity = std::chrono::steady_clock::now();
 
     std::string url;
     _browser = CefBrowserHost::CreateBrowserSync(
@@ -93,6 +102,7 @@ void BrowserInstance::loadUrl(std::string url) {
         LDEBUG(fmt::format("Loading URL: {}", url));
         CefString cefUrl = std::move(url);
         _browser->GetMainFrame()->LoadURL(cefUrl);
+        _lastActivity = std::chrono::steady_clock::now();
     }
     else {
         LWARNING("Provided browser URL is empty");
@@ -114,6 +124,7 @@ void BrowserInstance::reshape(const glm::ivec2& windowSize) {
 
     _renderHandler->reshape(windowSize.x, windowSize.y);
     _browser->GetHost()->WasResized();
+    _lastActivity = std::chrono::steady_clock::now();
 }
 
 void BrowserInstance::draw() {
@@ -141,6 +152,7 @@ const CefRefPtr<CefBrowser>& BrowserInstance::getBrowser() const {
 
 bool BrowserInstance::sendKeyEvent(const CefKeyEvent& event) {
     _browser->GetHost()->SendKeyEvent(event);
+    _lastActivity = std::chrono::steady_clock::now();
     return false;
 }
 
@@ -149,12 +161,14 @@ bool BrowserInstance::sendMouseClickEvent(const CefMouseEvent& event,
                                           bool mouseUp, int clickCount)
 {
     _browser->GetHost()->SendMouseClickEvent(event, button, mouseUp, clickCount);
+    _lastActivity = std::chrono::steady_clock::now();
     return hasContent(glm::ivec2(event.x, event.y));
 }
 
 #ifdef WIN32
 void BrowserInstance::sendTouchEvent(const CefTouchEvent& event) const{
     _browser->GetHost()->SendTouchEvent(event);
+    _lastActivity = std::chrono::steady_clock::now();
 }
 #endif // WIN32
 
@@ -162,6 +176,7 @@ bool BrowserInstance::sendMouseMoveEvent(const CefMouseEvent& event) {
     constexpr bool DidNotLeaveWindow = false;
 
     _browser->GetHost()->SendMouseMoveEvent(event, DidNotLeaveWindow);
+    _lastActivity = std::chrono::steady_clock::now();
     return false;
 }
 
@@ -169,6 +184,7 @@ bool BrowserInstance::sendMouseWheelEvent(const CefMouseEvent& event,
                                           const glm::ivec2& delta)
 {
     _browser->GetHost()->SendMouseWheelEvent(event, delta.x, delta.y);
+    _lastActivity = std::chrono::steady_clock::now();
     return hasContent(glm::ivec2(event.x, event.y));
 }
 
@@ -183,6 +199,7 @@ void BrowserInstance::setZoom(float ratio) {
 
 void BrowserInstance::reloadBrowser() {
     _browser->Reload();
+    _lastActivity = std::chrono::steady_clock::now();
 }
 
 void BrowserInstance::selectAll() {
@@ -195,4 +212,21 @@ bool BrowserInstance::hasContent(const glm::ivec2& pos) const {
     return _renderHandler->hasContent(pos.x, pos.y);
 }
 
+void BrowserInstance::updateFrameRate(int activeFrameRate, int idleFrameRate) {
+    const bool isIdle = std::chrono::steady_clock::now() - _lastActivity > IdleTimeout;
+    const int frameRate = isIdle ? idleFrameRate : activeFrameRate;
+    if (frameRate != _frameRate) {
+        _browser->GetHost()->SetWindowlessFrameRate(frameRate);
+        _frameRate = frameRate;
+    }
+}
+
+void BrowserInstance::setHidden(bool isHidden) {
+    if (isHidden != _isHidden) {
+        _browser->GetHost()->WasHidden(isHidden);
+        _isHidden = isHidden;
+        _lastActivity = std::chrono::steady_clock::now();
+    }
+}
+
 } // namespace openspace
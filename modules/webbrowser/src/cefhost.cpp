@@ -36,6 +36,11 @@
 
 namespace {
     constexpr std::string_view _loggerCat = "CefHost";
+
+    // CEF might not schedule all of the work it needs, so the message loop is also run
+    // at least this often as recommended by the CEF documentation
+    constexpr std::chrono::milliseconds MaxMessageLoopDelay =
+        std::chrono::milliseconds(33);
 } // namespace
 
 namespace openspace {
@@ -51,6 +56,9 @@ CefHost::CefHost([[maybe_unused]] const std::string& helperLocation) {
 #endif // __APPLE__
 
     settings.windowless_rendering_enabled = true;
+    // CEF tells us through WebBrowserApp when its message loop needs to run, so that we
+    // don't have to run it many times per frame in case it has pending work
+    settings.external_message_pump = true;
     attachDebugSettings(settings);
 
 #ifdef WIN32
@@ -67,10 +75,10 @@ CefHost::CefHost([[maybe_unused]] const std::string& helperLocation) {
     }
 #endif // __APPLE__
 
-    CefRefPtr<WebBrowserApp> app(new WebBrowserApp);
+    _app = new WebBrowserApp;
 
     CefMainArgs args;
-    CefInitialize(args, settings, app.get(), nullptr);
+    CefInitialize(args, settings, _app.get(), nullptr);
     LDEBUG("Initializing CEF... done");
 }
 
@@ -90,6 +98,13 @@ void CefHost::attachDebugSettings(CefSettings &settings) {
 void CefHost::doMessageLoopWork() {
     ZoneScoped;
 
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const bool isScheduled = _app && _app->consumeScheduledWork(now);
+    if (!isScheduled && now - _lastMessageLoopWork < MaxMessageLoopDelay) {
+        return;
+    }
+
+    _lastMessageLoopWork = now;
     CefDoMessageLoopWork();
 }
 
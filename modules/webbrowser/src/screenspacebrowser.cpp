@@ -169,6 +169,9 @@ void ScreenSpaceBrowser::render(float blackoutFactor) {
 void ScreenSpaceBrowser::update() {
     _objectSize = _texture->dimensions();
 
+    // There is no need for the browser to render content that nobody will see
+    _browserInstance->setHidden(!isEnabled());
+
     if (_isUrlDirty) {
         _browserInstance->loadUrl(_url);
         _isUrlDirty = false;
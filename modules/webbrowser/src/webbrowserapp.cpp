@@ -24,8 +24,14 @@
 
 #include "include/webbrowserapp.h"
 
+#include <algorithm>
+
 namespace openspace {
 
+CefRefPtr<CefBrowserProcessHandler> WebBrowserApp::GetBrowserProcessHandler() {
+    return this;
+}
+
 CefRefPtr<CefRenderProcessHandler> WebBrowserApp::GetRenderProcessHandler() {
     return this;
 }
@@ -55,4 +61,27 @@ void WebBrowserApp::OnBeforeCommandLineProcessing(const CefString&,
 #endif
 }
 
+void WebBrowserApp::OnScheduleMessagePumpWork(int64 delayMs) {
+    using namespace std::chrono;
+    // A newer request replaces any previously scheduled one
+    const steady_clock::time_point time =
+        steady_clock::now() + milliseconds(std::max<int64>(delayMs, 0));
+    _scheduledWork = time.time_since_epoch().count();
+}
+
+bool WebBrowserApp::consumeScheduledWork(std::chrono::steady_clock::time_point time) {
+    std::chrono::steady_clock::rep scheduled = _scheduledWork;
+    while (scheduled <= time.time_since_epoch().count()) {
+        // Only clear the request if it wasn't replaced in the meantime
+        const bool success = _scheduledWork.compare_exchange_weak(
+            scheduled,
+            std::chrono::steady_clock::duration::max().count()
+        );
+        if (success) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace openspace
@@ -27,9 +27,21 @@
 #include <ghoul/glm.h>
 #include <fmt/format.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+
+namespace {
+    // Maximum number of separate regions that are uploaded to the texture each frame
+    constexpr size_t MaxDirtyRects = 16;
+} // namespace
 
 namespace openspace {
 
+WebRenderHandler::~WebRenderHandler() {
+    if (_pixelBuffer != 0) {
+        glDeleteBuffers(1, &_pixelBuffer);
+    }
+}
+
 void WebRenderHandler::reshape(int w, int h) {
     if (w == _windowSize.x && h == _windowSize.y) {
         return;
@@ -47,52 +59,57 @@ void WebRenderHandler::OnPaint(CefRefPtr<CefBrowser>, CefRenderHandler::PaintEle
                                const void* buffer, int w, int h)
 {
     const size_t bufferSize = static_cast<size_t>(w * h);
-
-    glm::ivec2 upperUpdatingRectBound = glm::ivec2(0, 0);
-    glm::ivec2 lowerUpdatingRectBound = glm::ivec2(w, h);
+    const Pixel* source = reinterpret_cast<const Pixel*>(buffer);
 
     if (_needsRepaint || _browserBuffer.size() != bufferSize) {
         _browserBufferSize = glm::ivec2(w, h);
-        _browserBuffer.resize(w * h, Pixel(0));
+        _browserBuffer.resize(bufferSize, Pixel(0));
         _textureSizeIsDirty = true;
-        _upperDirtyRectBound = upperUpdatingRectBound = glm::ivec2(w, h);
-        _lowerDirtyRectBound = lowerUpdatingRectBound = glm::ivec2(0, 0);
+        _dirtyRects.clear();
+
+        // The entire texture is recreated, so the whole buffer has to be up to date.
+        // Chromium stores image upside down compared to OpenGL, so we flip it
+        for (int y = 0; y < h; ++y) {
+            std::copy(
+                source + y * w,
+                source + (y + 1) * w,
+                _browserBuffer.data() + (h - y - 1) * w
+            );
+        }
+        _needsRepaint = false;
+        return;
     }
 
     for (const CefRect& r : dirtyRects) {
-        lowerUpdatingRectBound = glm::min(lowerUpdatingRectBound, glm::ivec2(r.x, r.y));
-        upperUpdatingRectBound = glm::max(
-            upperUpdatingRectBound,
-            glm::ivec2(r.x + r.width, r.y + r.height)
-        );
-
+        const int x0 = std::clamp(r.x, 0, w);
+        const int x1 = std::clamp(r.x + r.width, 0, w);
+        const int y0 = std::clamp(r.y, 0, h);
+        const int y1 = std::clamp(r.y + r.height, 0, h);
+        if (x1 <= x0 || y1 <= y0) {
+            continue;
+        }
+
+        // Copy the updated rectangle line by line, flipping it as above
+        for (int y = y0; y < y1; ++y) {
+            std::copy(
+                source + y * w + x0,
+                source + y * w + x1,
+                _browserBuffer.data() + (h - y - 1) * w + x0
+            );
+        }
+        _dirtyRects.emplace_back(x0, h - y1, x1 - x0, y1 - y0);
     }
 
-    const glm::ivec2 rectSize = upperUpdatingRectBound - lowerUpdatingRectBound;
-    if (rectSize.x > 0 && rectSize.y > 0) {
-        _textureIsDirty = true;
+    if (_dirtyRects.size() > MaxDirtyRects) {
+        // Past a certain point, a single larger upload is cheaper than many small ones
+        glm::ivec2 lower = glm::ivec2(w, h);
+        glm::ivec2 upper = glm::ivec2(0, 0);
+        for (const glm::ivec4& r : _dirtyRects) {
+            lower = glm::min(lower, glm::ivec2(r.x, r.y));
+            upper = glm::max(upper, glm::ivec2(r.x + r.z, r.y + r.w));
+        }
+        _dirtyRects = { glm::ivec4(lower, upper - lower) };
     }
-    else {
-        return;
-    }
-
-    // Copy the updated rectangle line by line.
-    for (int y = lowerUpdatingRectBound.y; y < upperUpdatingRectBound.y; ++y) {
-        int lineOffset = y * w + lowerUpdatingRectBound.x;
-        // Chromium stores image upside down compared to OpenGL, so we flip it:
-        int invLineOffset = (h - y - 1) * w + lowerUpdatingRectBound.x;
-        int rectWidth = upperUpdatingRectBound.x - lowerUpdatingRectBound.x;
-        std::copy(
-            reinterpret_cast<const Pixel*>(buffer) + lineOffset,
-            reinterpret_cast<const Pixel*>(buffer) + lineOffset + rectWidth,
-            _browserBuffer.data() + invLineOffset
-        );
-    }
-
-    // Add the dirty rect bounds to the GPU texture dirty rect.
-    _lowerDirtyRectBound = glm::min(lowerUpdatingRectBound, _lowerDirtyRectBound);
-    _upperDirtyRectBound = glm::max(upperUpdatingRectBound, _upperDirtyRectBound);
-    _needsRepaint = false;
 }
 
 void WebRenderHandler::updateTexture() {
@@ -119,34 +136,64 @@ void WebRenderHandler::updateTexture() {
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glBindTexture(GL_TEXTURE_2D, 0);
     }
-    else if (_textureIsDirty) {
-        glBindTexture(GL_TEXTURE_2D, _texture);
-        glPixelStorei(GL_UNPACK_ROW_LENGTH, _browserBufferSize.x);
-
-        glTexSubImage2D(
-            GL_TEXTURE_2D,
+    else if (!_dirtyRects.empty()) {
+        size_t nPixels = 0;
+        for (const glm::ivec4& r : _dirtyRects) {
+            nPixels += static_cast<size_t>(r.z) * static_cast<size_t>(r.w);
+        }
+        const GLsizeiptr size = static_cast<GLsizeiptr>(nPixels * sizeof(Pixel));
+
+        if (_pixelBuffer == 0) {
+            glGenBuffers(1, &_pixelBuffer);
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffer);
+        // Orphan the previous storage so that we don't have to wait for the driver to
+        // finish reading last frame's upload before we can write into the buffer
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        Pixel* dst = reinterpret_cast<Pixel*>(glMapBufferRange(
+            GL_PIXEL_UNPACK_BUFFER,
             0,
-            _lowerDirtyRectBound.x,
-            _browserBufferSize.y - _upperDirtyRectBound.y,
-            _upperDirtyRectBound.x - _lowerDirtyRectBound.x,
-            _upperDirtyRectBound.y - _lowerDirtyRectBound.y,
-            GL_BGRA_EXT,
-            GL_UNSIGNED_BYTE,
-            reinterpret_cast<char*>(
-                _browserBuffer.data() +
-                (_browserBufferSize.y - _upperDirtyRectBound.y) *
-                _browserBufferSize.x + _lowerDirtyRectBound.x
-            )
-        );
+            size,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+        ));
+        if (!dst) {
+            // Keep the dirty rects around and try again next frame
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            return;
+        }
+
+        // Pack the dirty rects tightly one after another
+        for (const glm::ivec4& r : _dirtyRects) {
+            for (int y = r.y; y < r.y + r.w; ++y) {
+                const Pixel* line =
+                    _browserBuffer.data() + y * _browserBufferSize.x + r.x;
+                dst = std::copy(line, line + r.z, dst);
+            }
+        }
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
 
-        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glBindTexture(GL_TEXTURE_2D, _texture);
+        size_t offset = 0;
+        for (const glm::ivec4& r : _dirtyRects) {
+            glTexSubImage2D(
+                GL_TEXTURE_2D,
+                0,
+                r.x,
+                r.y,
+                r.z,
+                r.w,
+                GL_BGRA_EXT,
+                GL_UNSIGNED_BYTE,
+                reinterpret_cast<const void*>(offset * sizeof(Pixel))
+            );
+            offset += static_cast<size_t>(r.z) * static_cast<size_t>(r.w);
+        }
         glBindTexture(GL_TEXTURE_2D, 0);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
     }
 
-    _upperDirtyRectBound = glm::ivec2(0, 0);
-    _lowerDirtyRectBound = glm::ivec2(_browserBufferSize.x, _browserBufferSize.y);
+    _dirtyRects.clear();
     _textureSizeIsDirty = false;
-    _textureIsDirty = false;
 }
 
 bool WebRenderHandler::hasContent(int x, int y) {
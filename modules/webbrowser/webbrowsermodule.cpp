@@ -51,22 +51,20 @@ namespace {
         constexpr std::string_view SubprocessPath = "OpenSpace_Helper";
     #endif
 
-    constexpr openspace::properties::Property::PropertyInfo
-        UpdateBrowserBetweenRenderablesInfo =
-    {
-        "UpdateBrowserBetweenRenderables",
-        "Update Browser Between Renderables",
-        "Run the message loop of the browser between calls to render individual "
-        "renderables. When disabled, the browser message loop only runs "
-        "once per frame",
+    constexpr openspace::properties::Property::PropertyInfo FrameRateInfo = {
+        "FrameRate",
+        "Frame Rate",
+        "The maximum number of times per second that a web browser renders its content "
+        "while it is being interacted with",
         openspace::properties::Property::Visibility::Developer
     };
 
-    constexpr openspace::properties::Property::PropertyInfo BrowserUpdateIntervalInfo = {
-        "BrowserUpdateInterval",
-        "Browser Update Interval",
-        "The time in microseconds between running the message loop of the browser. "
-        "Only used if UpdateBrowserBetweenRenderables is true",
+    constexpr openspace::properties::Property::PropertyInfo IdleFrameRateInfo = {
+        "IdleFrameRate",
+        "Idle Frame Rate",
+        "The maximum number of times per second that a web browser renders its content "
+        "when it has not received any input for a few seconds. Browsers that are not "
+        "shown at all do not render their content",
         openspace::properties::Property::Visibility::Developer
     };
 } // namespace
@@ -75,8 +73,8 @@ namespace openspace {
 
 WebBrowserModule::WebBrowserModule()
     : OpenSpaceModule(WebBrowserModule::Name)
-    , _updateBrowserBetweenRenderables(UpdateBrowserBetweenRenderablesInfo, true)
-    , _browserUpdateInterval(BrowserUpdateIntervalInfo, 1.f, 1.0f, 1000.f)
+    , _frameRate(FrameRateInfo, 60, 1, 120)
+    , _idleFrameRate(IdleFrameRateInfo, 10, 1, 120)
     , _eventHandler(new EventHandler)
 {
     global::callback::deinitialize->emplace_back([this]() {
@@ -85,23 +83,8 @@ WebBrowserModule::WebBrowserModule()
         deinitialize();
     });
 
-    _browserUpdateInterval.onChange([this]() {
-        webbrowser::interval = std::chrono::microseconds(
-            static_cast<long long>(_browserUpdateInterval)
-        );
-    });
-
-    _updateBrowserBetweenRenderables.onChange([this]() {
-        if (_updateBrowserBetweenRenderables && !_browsers.empty()) {
-            global::callback::webBrowserPerformanceHotfix = webbrowser::update;
-        }
-        else {
-            global::callback::webBrowserPerformanceHotfix = nullptr;
-        }
-    });
-
-    addProperty(_updateBrowserBetweenRenderables);
-    addProperty(_browserUpdateInterval);
+    addProperty(_frameRate);
+    addProperty(_idleFrameRate);
 }
 
 void WebBrowserModule::internalDeinitialize() {
@@ -147,19 +130,33 @@ void WebBrowserModule::internalInitialize(const ghoul::Dictionary& dictionary) {
     _cefHost = std::make_unique<CefHost>(_webHelperLocation.string());
     LDEBUG("Starting CEF... done");
 
-    if (dictionary.hasValue<bool>(UpdateBrowserBetweenRenderablesInfo.identifier)) {
-        _updateBrowserBetweenRenderables =
-            dictionary.value<bool>(UpdateBrowserBetweenRenderablesInfo.identifier);
+    if (dictionary.hasValue<double>(FrameRateInfo.identifier)) {
+        _frameRate = static_cast<int>(dictionary.value<double>(FrameRateInfo.identifier));
     }
 
-    if (dictionary.hasValue<double>(BrowserUpdateIntervalInfo.identifier)) {
-        _browserUpdateInterval = static_cast<float>(
-            dictionary.value<double>(BrowserUpdateIntervalInfo.identifier)
+    if (dictionary.hasValue<double>(IdleFrameRateInfo.identifier)) {
+        _idleFrameRate = static_cast<int>(
+            dictionary.value<double>(IdleFrameRateInfo.identifier)
         );
     }
 
     _eventHandler->initialize();
 
+    // CEF schedules the work it needs to do, so checking once per frame is enough and
+    // its message loop no longer has to be run in between the rendering of objects
+    global::callback::preSync->emplace_back([this]() {
+        ZoneScopedN("WebBrowserModule");
+
+        if (!_enabled || !_cefHost) {
+            return;
+        }
+
+        for (BrowserInstance* browser : _browsers) {
+            browser->updateFrameRate(_frameRate, _idleFrameRate);
+        }
+        _cefHost->doMessageLoopWork();
+    });
+
     // register ScreenSpaceBrowser
     ghoul::TemplateFactory<ScreenSpaceRenderable>* fScreenSpaceRenderable =
         FactoryManager::ref().factory<ScreenSpaceRenderable>();
@@ -172,9 +169,6 @@ void WebBrowserModule::addBrowser(BrowserInstance* browser) {
 
     if (_enabled) {
         _browsers.push_back(browser);
-        if (_updateBrowserBetweenRenderables) {
-            global::callback::webBrowserPerformanceHotfix = webbrowser::update;
-        }
     }
 }
 
@@ -190,10 +184,6 @@ void WebBrowserModule::removeBrowser(BrowserInstance* browser) {
         LWARNING("Could not find browser in list of browsers");
     }
 
-    if (_browsers.empty()) {
-        global::callback::webBrowserPerformanceHotfix = nullptr;
-    }
-
     LDEBUG(fmt::format("Number of browsers stored: {}", _browsers.size()));
 }
 
@@ -213,35 +203,4 @@ bool WebBrowserModule::isEnabled() const {
     return _enabled;
 }
 
-/// Logic for the webbrowser performance hotfix, described in globalscallbacks.h
-namespace webbrowser {
-
-/**
- * The time interval to describe how often the CEF message loop needs to be pumped to work
- * properly. A value of 10000 us updates CEF a 100 times per second which is enough for
- * fluid interaction without wasting resources
- */
-std::chrono::microseconds interval = std::chrono::microseconds(10000);
-std::chrono::time_point<std::chrono::high_resolution_clock> latestCall;
-CefHost* cefHost = nullptr;
-
-void update() {
-    const std::chrono::time_point<std::chrono::high_resolution_clock> timeBefore =
-        std::chrono::high_resolution_clock::now();
-
-    std::chrono::microseconds duration =
-        std::chrono::duration_cast<std::chrono::microseconds>(timeBefore - latestCall);
-
-    if (duration > interval) {
-        cefHost->doMessageLoopWork();
-
-        const std::chrono::time_point<std::chrono::high_resolution_clock> timeAfter =
-            std::chrono::high_resolution_clock::now();
-
-        latestCall = timeAfter;
-    }
-}
-
-} // namespace webbrowser
-
 } // namespace openspace
@@ -26,9 +26,7 @@
 #define __OPENSPACE_MODULE_WEBBROWSER___WEBBROWSERMODULE___H__
 
 #include <openspace/util/openspacemodule.h>
-#include <openspace/properties/scalar/boolproperty.h>
-#include <openspace/properties/scalar/floatproperty.h>
-#include <chrono>
+#include <openspace/properties/scalar/intproperty.h>
 #include <filesystem>
 
 namespace openspace {
@@ -37,13 +35,6 @@ class BrowserInstance;
 class CefHost;
 class EventHandler;
 
-namespace webbrowser {
-    extern std::chrono::microseconds interval;
-    extern std::chrono::time_point<std::chrono::high_resolution_clock> latestCall;
-    extern CefHost* cefHost;
-    void update();
-} // namespace webbrowser
-
 class WebBrowserModule : public OpenSpaceModule {
 public:
     static constexpr const char* Name = "WebBrowser";
@@ -71,8 +62,8 @@ private:
      */
     std::filesystem::path findHelperExecutable();
 
-    properties::BoolProperty _updateBrowserBetweenRenderables;
-    properties::FloatProperty _browserUpdateInterval;
+    properties::IntProperty _frameRate;
+    properties::IntProperty _idleFrameRate;
 
     std::vector<BrowserInstance*> _browsers;
     std::unique_ptr<EventHandler> _eventHandler;
@@ -1,2 +1,8 @@
 #version __CONTEXT__
+
+// Lets renderables pass bindless texture handles to their samplers if they are supported
+#ifdef GL_ARB_bindless_texture
+#extension GL_ARB_bindless_texture : enable
+#endif // GL_ARB_bindless_texture
+
 #include <#{rendererData.fragmentRendererPath}>
\ No newline at end of file
@@ -204,6 +204,12 @@ const glm::dmat4& Camera::combinedViewMatrix() const {
     return _cachedCombinedViewMatrix.datum;
 }
 
+glm::dmat4 Camera::cameraRelativeViewMatrix() const {
+    return glm::dmat4(sgctInternal.viewMatrix()) *
+        glm::dmat4(viewScaleMatrix()) *
+        glm::dmat4(viewRotationMatrix());
+}
+
 void Camera::invalidateCache() {
     _cachedViewDirection.isDirty = true;
     _cachedLookupVector.isDirty = true;
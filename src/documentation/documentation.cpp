@@ -24,12 +24,159 @@
 
 #include <openspace/documentation/documentation.h>
 
+#include <openspace/documentation/documentationengine.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/util/stablehash.h>
+#include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionary.h>
+#include <ghoul/misc/dictionaryluaformatter.h>
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace {
+    constexpr std::string_view _loggerCat = "Documentation";
+
+    // Increase this whenever the way the fingerprints are computed changes
+    constexpr uint64_t VerificationCacheVersion = 2;
+
+    // The fingerprints of the documentation/dictionary pairs that have successfully
+    // passed the testSpecificationAndThrow function in this or previous runs. Only the
+    // ones that were used in this run are written back to the cache, which keeps the
+    // cache from growing indefinitely as assets change
+    std::mutex VerificationMutex;
+    std::unordered_set<uint64_t> VerifiedFingerprints;
+    std::unordered_set<uint64_t> UsedFingerprints;
+    // The digests of the documentations by their identifier, or std::nullopt if the
+    // result of a documentation must not be cached
+    std::unordered_map<std::string, std::optional<uint64_t>> DocumentationDigests;
+
+    bool checksFileSystem(const openspace::documentation::Documentation& doc,
+                          std::set<std::string>& visited);
+
+    // Returns whether the \p verifier, or any verifier nested in it, checks the existence
+    // of a file or directory
+    bool checksFileSystem(const openspace::documentation::Verifier& verifier,
+                          std::set<std::string>& visited)
+    {
+        using namespace openspace::documentation;
+
+        if (dynamic_cast<const FileVerifier*>(&verifier) ||
+            dynamic_cast<const DirectoryVerifier*>(&verifier))
+        {
+            return true;
+        }
+        const ReferencingVerifier* r =
+            dynamic_cast<const ReferencingVerifier*>(&verifier);
+        if (r) {
+            if (!visited.insert(r->identifier).second) {
+                return false;
+            }
+            const std::vector<Documentation> docs = DocEng.documentations();
+            auto it = std::find_if(
+                docs.begin(),
+                docs.end(),
+                [r](const Documentation& d) { return d.id == r->identifier; }
+            );
+            // If we can't tell what the referenced documentation checks, we have to
+            // assume the worst
+            return it == docs.end() || checksFileSystem(*it, visited);
+        }
+        const TableVerifier* t = dynamic_cast<const TableVerifier*>(&verifier);
+        if (t) {
+            return std::any_of(
+                t->documentations.begin(),
+                t->documentations.end(),
+                [&visited](const DocumentationEntry& e) {
+                    return checksFileSystem(*e.verifier, visited);
+                }
+            );
+        }
+        auto checkValues = [&visited](const std::vector<std::shared_ptr<Verifier>>& v) {
+            return std::any_of(
+                v.begin(),
+                v.end(),
+                [&visited](const std::shared_ptr<Verifier>& value) {
+                    return checksFileSystem(*value, visited);
+                }
+            );
+        };
+        const AndVerifier* a = dynamic_cast<const AndVerifier*>(&verifier);
+        if (a) {
+            return checkValues(a->values);
+        }
+        const OrVerifier* o = dynamic_cast<const OrVerifier*>(&verifier);
+        if (o) {
+            return checkValues(o->values);
+        }
+        return false;
+    }
+
+    bool checksFileSystem(const openspace::documentation::Documentation& doc,
+                          std::set<std::string>& visited)
+    {
+        return std::any_of(
+            doc.entries.begin(),
+            doc.entries.end(),
+            [&visited](const openspace::documentation::DocumentationEntry& e) {
+                return checksFileSystem(*e.verifier, visited);
+            }
+        );
+    }
+
+    uint64_t documentationDigest(const openspace::documentation::Documentation& doc) {
+        // The fingerprints are stored between runs, so they need a stable hash
+        uint64_t hash = openspace::StableHashOffset;
+        openspace::stableHashCombine(hash, doc.name);
+        openspace::stableHashCombine(hash, doc.id);
+        for (const openspace::documentation::DocumentationEntry& e : doc.entries) {
+            openspace::stableHashCombine(hash, e.key);
+            openspace::stableHashCombine(hash, e.optional ? "1" : "0");
+            openspace::stableHashCombine(hash, e.verifier->type());
+            openspace::stableHashCombine(hash, e.verifier->documentation());
+        }
+        return hash;
+    }
+
+    std::optional<uint64_t> fingerprint(
+                                       const openspace::documentation::Documentation& doc,
+                                                      const ghoul::Dictionary& dictionary)
+    {
+        // Documentations without an identifier are usually created ad-hoc and we can't
+        // tell them apart, so we don't cache them
+        if (doc.id.empty()) {
+            return std::nullopt;
+        }
+
+        std::optional<uint64_t> digest;
+        {
+            std::lock_guard lock(VerificationMutex);
+            auto it = DocumentationDigests.find(doc.id);
+            if (it == DocumentationDigests.end()) {
+                // The result of File and Directory verifiers depends on the state of the
+                // disk rather than just on the dictionary, so they have to run every time
+                std::set<std::string> visited = { doc.id };
+                std::optional<uint64_t> d;
+                if (!checksFileSystem(doc, visited)) {
+                    d = documentationDigest(doc);
+                }
+                it = DocumentationDigests.emplace(doc.id, d).first;
+            }
+            digest = it->second;
+        }
+        if (!digest.has_value()) {
+            return std::nullopt;
+        }
+
+        uint64_t hash = *digest;
+        openspace::stableHashCombine(hash, ghoul::formatLua(dictionary));
+        return hash;
+    }
 
 // Structure used to make offenses unique
 struct OffenseCompare {
@@ -207,8 +354,8 @@ TestResult testSpecification(const Documentation& documentation,
     TestResult result;
     result.success = true;
 
-    auto applyVerifier = [dictionary, &result](const Verifier& verifier,
-                                               const std::string& key)
+    auto applyVerifier = [&dictionary, &result](const Verifier& verifier,
+                                                const std::string& key)
     {
         TestResult res = verifier(dictionary, key);
         if (!res.success) {
@@ -264,11 +411,92 @@ TestResult testSpecification(const Documentation& documentation,
 void testSpecificationAndThrow(const Documentation& documentation,
                                const ghoul::Dictionary& dictionary, std::string component)
 {
+    // If the same dictionary has already passed the same documentation, we don't need to
+    // test it again
+    const std::optional<uint64_t> fp = fingerprint(documentation, dictionary);
+    if (fp.has_value()) {
+        std::lock_guard lock(VerificationMutex);
+        if (VerifiedFingerprints.contains(*fp)) {
+            UsedFingerprints.insert(*fp);
+            return;
+        }
+    }
+
     // Perform testing against the documentation/specification
     TestResult testResult = testSpecification(documentation, dictionary);
     if (!testResult.success) {
         throw SpecificationError(testResult, component);
     }
+
+    // Results with warnings are not cached so that the warnings are reported every time
+    if (fp.has_value() && testResult.warnings.empty()) {
+        std::lock_guard lock(VerificationMutex);
+        VerifiedFingerprints.insert(*fp);
+        UsedFingerprints.insert(*fp);
+    }
+}
+
+void loadVerificationCache(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ifstream::binary);
+    if (!file.good()) {
+        return;
+    }
+
+    uint64_t version = 0;
+    uint64_t nEntries = 0;
+    file.read(reinterpret_cast<char*>(&version), sizeof(uint64_t));
+    file.read(reinterpret_cast<char*>(&nEntries), sizeof(uint64_t));
+    if (!file.good() || version != VerificationCacheVersion) {
+        LDEBUG(fmt::format("Ignoring outdated verification cache {}", path));
+        return;
+    }
+
+    // Don't trust the number of entries before we know that the file can contain them
+    std::error_code ec;
+    const uintmax_t fileSize = std::filesystem::file_size(path, ec);
+    const uintmax_t headerSize = 2 * sizeof(uint64_t);
+    if (ec || fileSize < headerSize ||
+        nEntries != (fileSize - headerSize) / sizeof(uint64_t))
+    {
+        LWARNING(fmt::format("Ignoring corrupt verification cache {}", path));
+        return;
+    }
+
+    std::vector<uint64_t> entries(nEntries);
+    file.read(
+        reinterpret_cast<char*>(entries.data()),
+        nEntries * sizeof(uint64_t)
+    );
+    if (!file.good()) {
+        LWARNING(fmt::format("Ignoring truncated verification cache {}", path));
+        return;
+    }
+
+    std::lock_guard lock(VerificationMutex);
+    VerifiedFingerprints.insert(entries.begin(), entries.end());
+}
+
+void saveVerificationCache(const std::filesystem::path& path) {
+    std::vector<uint64_t> entries;
+    {
+        std::lock_guard lock(VerificationMutex);
+        entries = std::vector<uint64_t>(UsedFingerprints.begin(), UsedFingerprints.end());
+    }
+
+    std::ofstream file(path, std::ofstream::binary);
+    const uint64_t nEntries = entries.size();
+    file.write(
+        reinterpret_cast<const char*>(&VerificationCacheVersion),
+        sizeof(uint64_t)
+    );
+    file.write(reinterpret_cast<const char*>(&nEntries), sizeof(uint64_t));
+    file.write(
+        reinterpret_cast<const char*>(entries.data()),
+        nEntries * sizeof(uint64_t)
+    );
+    if (!file.good()) {
+        LWARNING(fmt::format("Could not write verification cache {}", path));
+    }
 }
 
 } // namespace openspace::documentation
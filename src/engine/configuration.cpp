@@ -276,6 +276,22 @@ namespace {
         // debugging support
         std::optional<bool> useMultithreadedInitialization;
 
+        // If this value is set to 'true', renderables that are disabled when their scene
+        // graph node is initialized are not initialized until they are enabled for the
+        // first time. This reduces the startup time and memory usage for profiles that
+        // contain many disabled renderables, at the expense of a delay when enabling them
+        std::optional<bool> useLazyRenderableInitialization;
+
+        // If this value is set to 'true', the master node of a cluster only transmits
+        // the synchronized state that has changed since the previous frame, instead of
+        // all of the state in every frame
+        std::optional<bool> useDeltaSyncEncoding;
+
+        // If the delta encoding of synchronized state is used, this value determines the
+        // number of frames after which the complete state is transmitted again, so that
+        // nodes that join late can catch up
+        std::optional<int> syncKeyframeInterval [[codegen::greater(0)]];
+
         // If this value is set to 'true', the launcher will not be shown and OpenSpace
         // will start with the provided configuration options directly. Useful in
         // multiprojector setups where a launcher window would be undesired
@@ -368,6 +384,10 @@ void parseLuaState(Configuration& configuration) {
     c.versionCheckUrl = p.versionCheckUrl.value_or(c.versionCheckUrl);
     c.useMultithreadedInitialization =
         p.useMultithreadedInitialization.value_or(c.useMultithreadedInitialization);
+    c.useLazyRenderableInitialization =
+        p.useLazyRenderableInitialization.value_or(c.useLazyRenderableInitialization);
+    c.useDeltaSyncEncoding = p.useDeltaSyncEncoding.value_or(c.useDeltaSyncEncoding);
+    c.syncKeyframeInterval = p.syncKeyframeInterval.value_or(c.syncKeyframeInterval);
     c.isCheckingOpenGLState = p.checkOpenGLState.value_or(c.isCheckingOpenGLState);
     c.isLoggingOpenGLCalls = p.logEachOpenGLCall.value_or(c.isLoggingOpenGLCalls);
     c.isPrintingEvents = p.printEvents.value_or(c.isPrintingEvents);
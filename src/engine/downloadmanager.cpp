@@ -24,88 +24,69 @@
 
 #include <openspace/engine/downloadmanager.h>
 
+#include <openspace/util/httpengine.h>
 #include <ghoul/fmt.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
-#include <ghoul/misc/thread.h>
-#include <curl/curl.h>
 #include <chrono>
+#include <cstring>
 #include <filesystem>
+#include <optional>
 #include <sstream>
-#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "DownloadManager";
 
-    struct ProgressInformation {
-        std::shared_ptr<openspace::DownloadManager::FileFuture> future;
-        std::chrono::system_clock::time_point startTime;
-        const openspace::DownloadManager::DownloadProgressCallback* callback;
-    };
-
-    size_t writeData(void* ptr, size_t size, size_t nmemb, FILE* stream) {
-        size_t written = fwrite(ptr, size, nmemb, stream);
-        return written;
-    }
-
-    size_t writeMemoryCallback(void* contents, size_t size, size_t nmemb, void* userp) {
-        size_t realsize = size * nmemb;
-        auto mem = static_cast<openspace::DownloadManager::MemoryFile*>(userp);
-
+    void writeMemory(openspace::DownloadManager::MemoryFile& mem, const char* contents,
+                     size_t size)
+    {
         // @TODO(abock): Remove this and replace mem->buffer with std::vector<char>
-        mem->buffer = reinterpret_cast<char*>(
-            realloc(mem->buffer, mem->size + realsize + 1)
-        );
-
-        std::memcpy(&(mem->buffer[mem->size]), contents, realsize);
-        mem->size += realsize;
-        mem->buffer[mem->size] = 0;
+        mem.buffer = reinterpret_cast<char*>(realloc(mem.buffer, mem.size + size + 1));
 
-        return realsize;
+        std::memcpy(&(mem.buffer[mem.size]), contents, size);
+        mem.size += size;
+        mem.buffer[mem.size] = 0;
     }
 
-    int xferinfo(void* p, curl_off_t dltotal, curl_off_t dlnow, curl_off_t, curl_off_t) {
-        if (dltotal == 0) {
-            return 0;
+    bool updateProgress(openspace::DownloadManager::FileFuture& future,
+                        std::chrono::system_clock::time_point startTime,
+                  const openspace::DownloadManager::DownloadProgressCallback& callback,
+                        size_t downloadedBytes, std::optional<size_t> totalBytes)
+    {
+        if (future.abortDownload) {
+            future.isAborted = true;
+            return false;
         }
 
-        ghoul_assert(p, "Passed progress information is nullptr");
-        ProgressInformation* i = static_cast<ProgressInformation*>(p);
-        ghoul_assert(i, "Passed pointer is not a ProgressInformation");
-        ghoul_assert(i && i->future, "FileFuture is not initialized");
-        ghoul_assert(i && i->callback, "Callback pointer is nullptr");
-
-        if (i->future->abortDownload) {
-            i->future->isAborted = true;
-            return 1;
+        if (!totalBytes.has_value() || *totalBytes == 0) {
+            return true;
         }
 
-        i->future->currentSize = dlnow;
-        i->future->totalSize = dltotal;
-        i->future->progress = static_cast<float>(dlnow) / static_cast<float>(dltotal);
+        future.currentSize = static_cast<long long>(downloadedBytes);
+        future.totalSize = static_cast<long long>(*totalBytes);
+        future.progress =
+            static_cast<float>(downloadedBytes) / static_cast<float>(*totalBytes);
 
         auto now = std::chrono::system_clock::now();
 
         // Compute time spent transferring.
-        auto transferTime = now - i->startTime;
+        auto transferTime = now - startTime;
         // Compute estimated transfer time.
-        auto estimatedTime = transferTime / i->future->progress;
+        auto estimatedTime = transferTime / future.progress;
         // Compute estimated time remaining.
         auto timeRemaining = estimatedTime - transferTime;
 
-        i->future->secondsRemaining = static_cast<float>(
+        future.secondsRemaining = static_cast<float>(
             std::chrono::duration_cast<std::chrono::seconds>(timeRemaining).count()
         );
 
-        if (*(i->callback)) {
-            // The callback function is a pointer to an std::function; that is the reason
-            // for the excessive referencing
-            (*(i->callback))(*(i->future));
+        if (callback) {
+            callback(future);
         }
 
-        return 0;
+        return true;
     }
 } // namespace
 
@@ -117,9 +98,7 @@ DownloadManager::FileFuture::FileFuture(std::string file)
 
 DownloadManager::DownloadManager(UseMultipleThreads useMultipleThreads)
     : _useMultithreadedDownload(useMultipleThreads)
-{
-    curl_global_init(CURL_GLOBAL_ALL);
-}
+{}
 
 std::shared_ptr<DownloadManager::FileFuture> DownloadManager::downloadFile(
                                                                    const std::string& url,
@@ -151,72 +130,57 @@ std::shared_ptr<DownloadManager::FileFuture> DownloadManager::downloadFile(
         LERROR(fmt::format(
             "Could not open/create file: {}. Errno: {}", file, errno
         ));
+        return nullptr;
     }
 
-    auto downloadFunction = [url, failOnError, timeout_secs,
-                             finishedCb = std::move(finishedCallback),
-                             progressCb = std::move(progressCallback), future, fp]()
-    {
-        CURL* curl = curl_easy_init();
-        if (curl) {
-            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-            curl_easy_setopt(curl, CURLOPT_USERAGENT, "OpenSpace");
-            curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-            curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
-            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &writeData);
-            if (timeout_secs) {
-                curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout_secs);
-            }
-            if (failOnError) {
-                curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
-            }
-
-            ProgressInformation p = {
-                .future = future,
-                .startTime = std::chrono::system_clock::now(),
-                .callback = &progressCb
-            };
-            #if LIBCURL_VERSION_NUM >= 0x072000
-            // xferinfo was introduced in 7.32.0, if a lower curl version is used the
-            // progress will not be shown for downloads on the splash screen
-            curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, xferinfo);
-            curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &p);
-            #endif
-            curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
-
-            CURLcode res = curl_easy_perform(curl);
-            curl_easy_cleanup(curl);
+    auto finished = std::make_shared<std::promise<void>>();
+    std::future<void> finishedFuture = finished->get_future();
+
+    HttpEngine::ref().submit({
+        .url = url,
+        .timeout = std::chrono::seconds(timeout_secs),
+        .priority = HttpEngine::Priority::Normal,
+        .onData = [fp](char* buffer, size_t size) {
+            return fwrite(buffer, 1, size, fp) == size;
+        },
+        .onProgress = [future, startTime = std::chrono::system_clock::now(),
+                       progressCb = std::move(progressCallback)]
+            (size_t downloadedBytes, std::optional<size_t> totalBytes)
+        {
+            return updateProgress(
+                *future,
+                startTime,
+                progressCb,
+                downloadedBytes,
+                totalBytes
+            );
+        },
+        .onFinish = [future, fp, failOnError, finished,
+                     finishedCb = std::move(finishedCallback)]
+            (const HttpEngine::Result& result)
+        {
             fclose(fp);
 
-            if (res == CURLE_OK) {
+            const bool hasHttpError = failOnError && result.responseCode >= 400;
+            if (result.isComplete && !hasHttpError) {
                 future->isFinished = true;
             }
             else {
-                long rescode;
-                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &rescode);
                 future->errorMessage = fmt::format(
-                    "{}. HTTP code: {}", curl_easy_strerror(res), rescode
+                    "{}. HTTP code: {}",
+                    result.isComplete ? "HTTP error" : result.error, result.responseCode
                 );
             }
 
             if (finishedCb) {
                 finishedCb(*future);
             }
+            finished->set_value();
         }
-    };
-
-    if (_useMultithreadedDownload) {
-        std::thread t = std::thread(downloadFunction);
-        ghoul::thread::setPriority(
-            t,
-            ghoul::thread::ThreadPriorityClass::Idle,
-            ghoul::thread::ThreadPriorityLevel::Lowest
-        );
+    });
 
-        t.detach();
-    }
-    else {
-        downloadFunction();
+    if (!_useMultithreadedDownload) {
+        finishedFuture.wait();
     }
 
     return future;
@@ -229,103 +193,88 @@ std::future<DownloadManager::MemoryFile> DownloadManager::fetchFile(
 {
     LDEBUG(fmt::format("Start downloading file: '{}' into memory", url));
 
-    auto downloadFunction = [url, successCb = std::move(successCallback),
-                             errorCb = std::move(errorCallback)]()
-    {
-        DownloadManager::MemoryFile file;
-        file.buffer = reinterpret_cast<char*>(malloc(1));
-        file.size = 0;
-        file.corrupted = false;
-
-        CURL* curl = curl_easy_init();
-        if (!curl) {
-            throw ghoul::RuntimeError("Error initializing cURL");
-        }
-
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, "OpenSpace");
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, reinterpret_cast<void*>(&file));
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeMemoryCallback);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 5L);
-        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, false);
-
-        // Will fail when response status is 400 or above
-        curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
-
-        CURLcode res = curl_easy_perform(curl);
-        if (res == CURLE_OK) {
-            // ask for the content-type
-            char* ct;
-            res = curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &ct);
-            if (res == CURLE_OK) {
-                std::string extension = std::string(ct);
-                std::stringstream ss(extension);
-                getline(ss, extension ,'/');
-                getline(ss, extension);
-                file.format = extension;
-            }
-            else {
-                LWARNING("Could not get extension from file downloaded from: " + url);
-            }
-            successCb(file);
-            curl_easy_cleanup(curl);
-            return file;
-        }
-        else {
-            std::string err = curl_easy_strerror(res);
-            if (errorCb) {
-                errorCb(err);
+    auto file = std::make_shared<MemoryFile>();
+    file->buffer = reinterpret_cast<char*>(malloc(1));
+    file->size = 0;
+    file->corrupted = false;
+
+    auto promise = std::make_shared<std::promise<MemoryFile>>();
+    std::future<MemoryFile> result = promise->get_future();
+
+    // The files fetched into memory are usually images that are shown right away, so
+    // they take precedence over other downloads
+    HttpEngine::ref().submit({
+        .url = url,
+        .timeout = std::chrono::seconds(5),
+        .priority = HttpEngine::Priority::High,
+        .verifyPeer = false,
+        .onData = [file](char* buffer, size_t size) {
+            writeMemory(*file, buffer, size);
+            return true;
+        },
+        .onFinish = [url, file, promise, successCb = std::move(successCallback),
+                     errorCb = std::move(errorCallback)](const HttpEngine::Result& res)
+        {
+            // Responses with a status of 400 or above are treated as failures
+            if (res.isComplete && res.responseCode < 400) {
+                if (!res.contentType.empty()) {
+                    std::string extension = res.contentType;
+                    std::stringstream ss(extension);
+                    getline(ss, extension ,'/');
+                    getline(ss, extension);
+                    file->format = extension;
+                }
+                else {
+                    LWARNING("Could not get extension from file downloaded from: " + url);
+                }
+                if (successCb) {
+                    successCb(*file);
+                }
             }
             else {
-                LWARNING(fmt::format("Error downloading '{}': {}", url, err));
+                std::string err = res.isComplete ?
+                    fmt::format("HTTP code {}", res.responseCode) :
+                    res.error;
+                if (errorCb) {
+                    errorCb(err);
+                }
+                else {
+                    LWARNING(fmt::format("Error downloading '{}': {}", url, err));
+                }
+                // Set a boolean variable in MemoryFile to determine if it is
+                // valid/corrupted or not.
+                // Return MemoryFile even if it is not valid, and check if it is after
+                // future.get() call.
+                file->corrupted = true;
             }
-            curl_easy_cleanup(curl);
-            // Set a boolean variable in MemoryFile to determine if it is
-            // valid/corrupted or not.
-            // Return MemoryFile even if it is not valid, and check if it is after
-            // future.get() call.
-            file.corrupted = true;
-            return file;
+            promise->set_value(*file);
         }
-    };
+    });
 
-    return std::async(std::launch::async, downloadFunction);
+    return result;
 }
 
 void DownloadManager::getFileExtension(const std::string& url,
                                        RequestFinishedCallback finishedCallback)
 {
-    auto requestFunction = [url, finishedCb = std::move(finishedCallback)]() {
-        CURL* curl = curl_easy_init();
-        if (curl) {
-            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-            //USING CURLOPT NOBODY
-            curl_easy_setopt(curl, CURLOPT_NOBODY, 1);
-            CURLcode res = curl_easy_perform(curl);
-            if (CURLE_OK == res) {
-                char* ct;
-                // ask for the content-type
-                res = curl_easy_getinfo(curl, CURLINFO_CONTENT_TYPE, &ct);
-                if ((res == CURLE_OK) && ct && finishedCb) {
-                    finishedCb(std::string(ct));
-                }
+    auto finished = std::make_shared<std::promise<void>>();
+    std::future<void> finishedFuture = finished->get_future();
+
+    HttpEngine::ref().submit({
+        .url = url,
+        .headerOnly = true,
+        .onFinish = [finished, finishedCb = std::move(finishedCallback)]
+            (const HttpEngine::Result& result)
+        {
+            if (result.isComplete && !result.contentType.empty() && finishedCb) {
+                finishedCb(result.contentType);
             }
-
-            curl_easy_cleanup(curl);
+            finished->set_value();
         }
-    };
-    if (_useMultithreadedDownload) {
-        std::thread t = std::thread(requestFunction);
-        ghoul::thread::setPriority(
-            t,
-            ghoul::thread::ThreadPriorityClass::Idle,
-            ghoul::thread::ThreadPriorityLevel::Lowest
-        );
-        t.detach();
-    }
-    else {
-        requestFunction();
+    });
+
+    if (!_useMultithreadedDownload) {
+        finishedFuture.wait();
     }
 }
 
@@ -51,7 +51,9 @@
 #include <openspace/scene/profile.h>
 #include <openspace/scripting/scriptengine.h>
 #include <openspace/scripting/scriptscheduler.h>
+#include <openspace/util/frameprofiler.h>
 #include <openspace/util/memorymanager.h>
+#include <openspace/util/startupprofiler.h>
 #include <openspace/util/timemanager.h>
 #include <openspace/util/versionchecker.h>
 #include <ghoul/misc/assert.h>
@@ -72,6 +74,8 @@ namespace {
 #ifdef WIN32
     constexpr int TotalSize =
         sizeof(MemoryManager) +
+        sizeof(FrameProfiler) +
+        sizeof(StartupProfiler) +
         sizeof(EventEngine) +
         sizeof(ghoul::fontrendering::FontManager) +
         sizeof(Dashboard) +
@@ -128,6 +132,22 @@ void create() {
     memoryManager = new MemoryManager;
 #endif // WIN32
 
+#ifdef WIN32
+    frameProfiler = new (currentPos) FrameProfiler;
+    ghoul_assert(frameProfiler, "No frameProfiler");
+    currentPos += sizeof(FrameProfiler);
+#else // ^^^ WIN32 / !WIN32 vvv
+    frameProfiler = new FrameProfiler;
+#endif // WIN32
+
+#ifdef WIN32
+    startupProfiler = new (currentPos) StartupProfiler;
+    ghoul_assert(startupProfiler, "No startupProfiler");
+    currentPos += sizeof(StartupProfiler);
+#else // ^^^ WIN32 / !WIN32 vvv
+    startupProfiler = new StartupProfiler;
+#endif // WIN32
+
 #ifdef WIN32
     eventEngine = new (currentPos) EventEngine;
     ghoul_assert(eventEngine, "No eventEngine");
@@ -619,6 +639,20 @@ void destroy() {
     delete eventEngine;
 #endif // WIN32
 
+    LDEBUGC("Globals", "Destroying 'StartupProfiler'");
+#ifdef WIN32
+    startupProfiler->~StartupProfiler();
+#else // ^^^ WIN32 / !WIN32 vvv
+    delete startupProfiler;
+#endif // WIN32
+
+    LDEBUGC("Globals", "Destroying 'FrameProfiler'");
+#ifdef WIN32
+    frameProfiler->~FrameProfiler();
+#else // ^^^ WIN32 / !WIN32 vvv
+    delete frameProfiler;
+#endif // WIN32
+
     LDEBUGC("Globals", "Destroying 'MemoryManager'");
 #ifdef WIN32
     memoryManager->~MemoryManager();
@@ -653,6 +687,7 @@ void deinitializeGL() {
 
     renderEngine->deinitializeGL();
     moduleEngine->deinitializeGL();
+    frameProfiler->deinitializeGL();
 }
 
 } // namespace openspace::global
@@ -307,6 +307,4 @@ void destroy() {
 #endif // WIN32
 }
 
-void(*webBrowserPerformanceHotfix)() = nullptr;
-
 } // namespace openspace::global::callback
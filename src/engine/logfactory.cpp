@@ -26,6 +26,7 @@
 
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
+#include <openspace/util/threadedlog.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/loglevel.h>
 #include <ghoul/logging/htmllog.h>
@@ -105,6 +106,7 @@ std::unique_ptr<ghoul::logging::Log> createLog(const ghoul::Dictionary& dictiona
         p.logLevel.value_or(Parameters::LogLevel::AllLogging)
     );
 
+    std::unique_ptr<ghoul::logging::Log> log;
     switch (p.type) {
         case Parameters::Type::Html:
         {
@@ -114,7 +116,7 @@ std::unique_ptr<ghoul::logging::Log> createLog(const ghoul::Dictionary& dictiona
             };
             std::vector<std::string> jsFiles{ absPath(JsPath).string() };
 
-            return std::make_unique<ghoul::logging::HTMLLog>(
+            log = std::make_unique<ghoul::logging::HTMLLog>(
                 filename.string(),
                 ghoul::logging::TextLog::Append(append),
                 ghoul::logging::Log::TimeStamping(timeStamp),
@@ -124,10 +126,11 @@ std::unique_ptr<ghoul::logging::Log> createLog(const ghoul::Dictionary& dictiona
                 cssFiles,
                 jsFiles,
                 level
-                );
+            );
+            break;
         }
         case Parameters::Type::Text:
-            return std::make_unique<ghoul::logging::TextLog>(
+            log = std::make_unique<ghoul::logging::TextLog>(
                 filename.string(),
                 ghoul::logging::TextLog::Append(append),
                 ghoul::logging::Log::TimeStamping(timeStamp),
@@ -136,9 +139,14 @@ std::unique_ptr<ghoul::logging::Log> createLog(const ghoul::Dictionary& dictiona
                 ghoul::logging::Log::LogLevelStamping(logLevelStamp),
                 level
             );
+            break;
         default:
             throw new ghoul::MissingCaseException();
     }
+
+    // Writing to the file happens on a separate thread to not slow down the threads
+    // that produce the log messages
+    return std::make_unique<ThreadedLog>(std::move(log), level);
 }
 
 } // namespace openspace
@@ -46,6 +46,7 @@
 #include <openspace/navigation/orbitalnavigator.h>
 #include <openspace/navigation/waypoint.h>
 #include <openspace/network/parallelpeer.h>
+#include <openspace/properties/property.h>
 #include <openspace/rendering/dashboard.h>
 #include <openspace/rendering/helper.h>
 #include <openspace/rendering/loadingscreen.h>
@@ -61,8 +62,12 @@
 #include <openspace/scripting/scriptscheduler.h>
 #include <openspace/scripting/scriptengine.h>
 #include <openspace/util/factorymanager.h>
+#include <openspace/util/frameprofiler.h>
+#include <openspace/util/httpengine.h>
 #include <openspace/util/memorymanager.h>
 #include <openspace/util/spicemanager.h>
+#include <openspace/util/startupprofiler.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/timemanager.h>
 #include <openspace/util/transformationmanager.h>
 #include <ghoul/ghoul.h>
@@ -157,6 +162,32 @@ namespace {
         // @VISIBILITY(2.67)
         openspace::properties::Property::Visibility::User
     };
+
+    constexpr openspace::properties::Property::PropertyInfo FrameBudgetInfo = {
+        "FrameBudget",
+        "Frame Budget (ms)",
+        "The time in milliseconds after the beginning of a frame after which work that "
+        "can be deferred, such as the OpenGL initialization of newly added scene graph "
+        "nodes or tile uploads, is postponed to the following frames. Each kind of work "
+        "still progresses by at least one step per frame. Choosing a value below the "
+        "frame time of the display, for example 12 ms for a 60 Hz projection system, "
+        "keeps the frame rate steady while the scene is changing. If this value is 0, "
+        "no work is deferred",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo DeferRenderableUpdatesInfo = {
+        "DeferRenderableUpdates",
+        "Defer Renderable Updates",
+        "If enabled, the master only updates the transformations of the scene graph "
+        "nodes before the cluster synchronization, which is all that the camera needs, "
+        "and the renderables are updated once per frame after the synchronization. "
+        "Otherwise the renderables are updated both before and after the "
+        "synchronization, which removes a frame of latency for renderables that change "
+        "the interaction sphere of their node, at the cost of the CPU time of a second "
+        "update. The nodes of a cluster stay frame-locked either way",
+        openspace::properties::Property::Visibility::Developer
+    };
 } // namespace
 
 namespace openspace {
@@ -170,10 +201,16 @@ OpenSpaceEngine::OpenSpaceEngine()
     , _showHiddenSceneGraphNodes(ShowHiddenSceneInfo, false)
     , _fadeOnEnableDuration(FadeDurationInfo, 1.f, 0.f, 5.f)
     , _disableAllMouseInputs(DisableMouseInputInfo, false)
+    , _frameBudgetTime(FrameBudgetInfo, 0.f, 0.f, 100.f)
+    , _deferRenderableUpdates(DeferRenderableUpdatesInfo, false)
+    , _threadPool(std::make_unique<ThreadPool>(
+        std::max(std::thread::hardware_concurrency(), 2u) - 1
+    ))
 {
     FactoryManager::initialize();
     SpiceManager::initialize();
     TransformationManager::initialize();
+    HttpEngine::initialize();
 
     addProperty(_printEvents);
 
@@ -190,6 +227,14 @@ OpenSpaceEngine::OpenSpaceEngine()
     addProperty(_showHiddenSceneGraphNodes);
     addProperty(_fadeOnEnableDuration);
     addProperty(_disableAllMouseInputs);
+
+    _frameBudgetTime.onChange([this]() {
+        _frameBudget.setBudget(std::chrono::microseconds(
+            static_cast<long long>(_frameBudgetTime * 1000.f)
+        ));
+    });
+    addProperty(_frameBudgetTime);
+    addProperty(_deferRenderableUpdates);
 }
 
 OpenSpaceEngine::~OpenSpaceEngine() {}
@@ -223,6 +268,7 @@ void OpenSpaceEngine::registerPathTokens() {
 
 void OpenSpaceEngine::initialize() {
     ZoneScoped;
+    StartupProfiler::Scope profilerScope(StartupProfiler::Category::Engine, "Initialize");
 
     LTRACE("OpenSpaceEngine::initialize(begin)");
 
@@ -235,6 +281,11 @@ void OpenSpaceEngine::initialize() {
     _printEvents = global::configuration->isPrintingEvents;
     _visibility = static_cast<int>(global::configuration->propertyVisibility);
 
+    global::syncEngine->setDeltaEncoding(
+        global::configuration->useDeltaSyncEncoding,
+        global::configuration->syncKeyframeInterval
+    );
+
     std::string cacheFolder = absPath("${CACHE}").string();
     if (global::configuration->usePerProfileCache) {
         cacheFolder = cacheFolder + "-" + global::configuration->profile;
@@ -263,6 +314,8 @@ void OpenSpaceEngine::initialize() {
         LFATALC(e.component, e.message);
     }
 
+    documentation::loadVerificationCache(absPath("${CACHE}/verification.cache"));
+
 
 
     // Initialize the requested logs from the configuration file
@@ -380,6 +433,7 @@ void OpenSpaceEngine::initialize() {
         global::scriptEngine->luaState(),
         absPath("${ASSETS}")
     );
+    _assetManager->loadSnapshot(absPath("${CACHE}/assets.snapshot"));
 
     global::scriptEngine->addLibrary(_assetManager->luaLibrary());
 
@@ -410,6 +464,10 @@ void OpenSpaceEngine::initialize() {
 
 void OpenSpaceEngine::initializeGL() {
     ZoneScoped;
+    StartupProfiler::Scope profilerScope(
+        StartupProfiler::Category::Engine,
+        "InitializeGL"
+    );
 
     LTRACE("OpenSpaceEngine::initializeGL(begin)");
 
@@ -874,6 +932,12 @@ void OpenSpaceEngine::loadAssets() {
 
     global::renderEngine->updateScene();
 
+    // The nodes have been initialized on the GPU in the scene update above, so all of
+    // the startup work is done at this point
+    global::startupProfiler->finish(absPath("${LOGS}/startup_profile.json"));
+    documentation::saveVerificationCache(absPath("${CACHE}/verification.cache"));
+    _assetManager->saveSnapshot(absPath("${CACHE}/assets.snapshot"));
+
     global::syncEngine->addSyncables(global::timeManager->syncables());
     if (_scene && _scene->camera()) {
         global::syncEngine->addSyncables(_scene->camera()->syncables());
@@ -918,6 +982,7 @@ void OpenSpaceEngine::deinitialize() {
     global::deinitialize();
 
     FactoryManager::deinitialize();
+    HttpEngine::deinitialize();
     TransformationManager::deinitialize();
     SpiceManager::deinitialize();
 
@@ -1083,6 +1148,8 @@ void OpenSpaceEngine::writeDocumentation() {
 void OpenSpaceEngine::preSynchronization() {
     ZoneScoped;
     TracyGpuZone("preSynchronization");
+    global::frameProfiler->beginFrame();
+    FrameProfiler::Scope profilerScope("PreSync");
 
     LTRACE("OpenSpaceEngine::preSynchronization(begin)");
 
@@ -1106,6 +1173,9 @@ void OpenSpaceEngine::preSynchronization() {
         global::windowDelegate->setSynchronization(false);
     }
 
+    // The budget starts after the initial asset loading so that it is not limited
+    _frameBudget.beginFrame();
+
     bool master = global::windowDelegate->isMaster();
 
     global::syncEngine->preSynchronization(SyncEngine::IsMaster(master));
@@ -1128,7 +1198,12 @@ void OpenSpaceEngine::preSynchronization() {
             );
         }
 
-        global::renderEngine->updateScene();
+        if (_deferRenderableUpdates) {
+            global::renderEngine->updateSceneTransforms();
+        }
+        else {
+            global::renderEngine->updateScene();
+        }
 
         if (_scene) {
             Camera* camera = _scene->camera();
@@ -1169,11 +1244,20 @@ void OpenSpaceEngine::preSynchronization() {
 void OpenSpaceEngine::postSynchronizationPreDraw() {
     ZoneScoped;
     TracyGpuZone("postSynchronizationPreDraw");
+    FrameProfiler::Scope profilerScope("PostSyncPreDraw");
     LTRACE("OpenSpaceEngine::postSynchronizationPreDraw(begin)");
 
     bool master = global::windowDelegate->isMaster();
     global::syncEngine->postSynchronization(SyncEngine::IsMaster(master));
 
+    // All scripts for this frame have run, so property batches must not stay open
+    const int nOpenBatches = properties::Property::flushChangeNotificationBatches();
+    if (nOpenBatches > 0) {
+        LWARNING(fmt::format(
+            "{} property batch(es) were not ended during the frame", nOpenBatches
+        ));
+    }
+
     if (_shutdown.inShutdown) {
         if (_shutdown.timer <= 0.f) {
             global::eventEngine->publishEvent<events::EventApplicationShutdown>(
@@ -1241,6 +1325,7 @@ void OpenSpaceEngine::render(const glm::mat4& sceneMatrix, const glm::mat4& view
 {
     ZoneScoped;
     TracyGpuZone("Render");
+    FrameProfiler::Scope profilerScope("Render", FrameProfiler::Gpu::Yes);
     LTRACE("OpenSpaceEngine::render(begin)");
 
     viewportChanged();
@@ -1259,6 +1344,7 @@ void OpenSpaceEngine::render(const glm::mat4& sceneMatrix, const glm::mat4& view
 void OpenSpaceEngine::drawOverlays() {
     ZoneScoped;
     TracyGpuZone("Draw2D");
+    FrameProfiler::Scope profilerScope("Draw2D", FrameProfiler::Gpu::Yes);
     LTRACE("OpenSpaceEngine::drawOverlays(begin)");
 
     viewportChanged();
@@ -1285,6 +1371,7 @@ void OpenSpaceEngine::drawOverlays() {
 void OpenSpaceEngine::postDraw() {
     ZoneScoped;
     TracyGpuZone("postDraw");
+    FrameProfiler::Scope profilerScope("PostDraw");
     LTRACE("OpenSpaceEngine::postDraw(begin)");
 
     global::renderEngine->postDraw();
@@ -1320,6 +1407,9 @@ void OpenSpaceEngine::postDraw() {
     global::eventEngine->postFrameCleanup();
     global::memoryManager->PersistentMemory.housekeeping();
 
+    // The Lua garbage is collected last so that it can use whatever is left of the frame
+    global::scriptEngine->collectGarbage(_frameBudget);
+
     LTRACE("OpenSpaceEngine::postDraw(end)");
 }
 
@@ -1581,16 +1671,16 @@ void OpenSpaceEngine::handleDragDrop(std::filesystem::path file) {
     );
 }
 
-std::vector<std::byte> OpenSpaceEngine::encode() {
+std::span<const std::byte> OpenSpaceEngine::encode() {
     ZoneScoped;
 
     return global::syncEngine->encodeSyncables();
 }
 
-void OpenSpaceEngine::decode(std::vector<std::byte> data) {
+void OpenSpaceEngine::decode(std::span<const std::byte> data) {
     ZoneScoped;
 
-    global::syncEngine->decodeSyncables(std::move(data));
+    global::syncEngine->decodeSyncables(data);
 }
 
 properties::Property::Visibility openspace::OpenSpaceEngine::visibility() const {
@@ -1691,7 +1781,9 @@ scripting::LuaLibrary OpenSpaceEngine::luaLibrary() {
             codegen::lua::IsMaster,
             codegen::lua::Version,
             codegen::lua::ReadCSVFile,
-            codegen::lua::ResetCamera
+            codegen::lua::ResetCamera,
+            codegen::lua::SetFrameProfilerEnabled,
+            codegen::lua::SaveFrameProfile
         },
         {
             absPath("${SCRIPTS}/core_scripts.lua")
@@ -1703,6 +1795,14 @@ LoadingScreen* OpenSpaceEngine::loadingScreen() {
     return _loadingScreen.get();
 }
 
+const FrameBudget& OpenSpaceEngine::frameBudget() const {
+    return _frameBudget;
+}
+
+ThreadPool& OpenSpaceEngine::threadPool() {
+    return *_threadPool;
+}
+
 AssetManager& OpenSpaceEngine::assetManager() {
     ghoul_assert(_assetManager, "Asset Manager must not be nullptr");
     return *_assetManager;
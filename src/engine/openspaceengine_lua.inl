@@ -235,4 +235,21 @@ namespace {
     openspace::setCameraFromProfile(*openspace::global::profile);
 }
 
+/**
+ * Enables or disables the recording of the CPU and GPU timings of the frame phases by the
+ * built-in frame profiler
+ */
+[[codegen::luawrap]] void setFrameProfilerEnabled(bool enabled) {
+    openspace::global::frameProfiler->setEnabled(enabled);
+}
+
+/**
+ * Saves the frame phases that were recorded by the built-in frame profiler to the
+ * provided file in the Chrome trace event format. The file can be inspected by opening
+ * it in chrome://tracing or https://ui.perfetto.dev
+ */
+[[codegen::luawrap]] void saveFrameProfile(std::filesystem::path file) {
+    openspace::global::frameProfiler->saveChromeTrace(absPath(file));
+}
+
 #include "openspaceengine_lua_codegen.cpp"
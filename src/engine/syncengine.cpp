@@ -25,10 +25,16 @@
 #include <openspace/engine/syncengine.h>
 
 #include <openspace/util/syncdata.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/profiling.h>
 #include <algorithm>
 
+namespace {
+    constexpr std::string_view _loggerCat = "SyncEngine";
+} // namespace
+
 namespace openspace {
 
 SyncEngine::SyncEngine(unsigned int syncBufferSize)
@@ -38,21 +44,81 @@ SyncEngine::SyncEngine(unsigned int syncBufferSize)
 }
 
 // Should be called on sgct master
-std::vector<std::byte> SyncEngine::encodeSyncables() {
-    for (Syncable* syncable : _syncables) {
-        syncable->encode(&_syncBuffer);
+std::span<const std::byte> SyncEngine::encodeSyncables() {
+    ZoneScoped;
+
+    const bool isKeyframe =
+        !_useDeltaEncoding || _framesSinceKeyframe >= _keyframeInterval;
+    _framesSinceKeyframe = isKeyframe ? 0 : _framesSinceKeyframe + 1;
+
+    _syncBuffer.encode(isKeyframe ? FrameType::Full : FrameType::Delta);
+    _syncBuffer.encode(static_cast<uint32_t>(_syncables.size()));
+
+    if (isKeyframe) {
+        for (Syncable* syncable : _syncables) {
+            syncable->encode(&_syncBuffer);
+        }
+    }
+    else {
+        // One bit per Syncable that marks whether its data is part of this frame
+        _changedMask.assign((_syncables.size() + 7) / 8, 0);
+        for (size_t i = 0; i < _syncables.size(); i++) {
+            if (_syncables[i]->hasChanged()) {
+                _changedMask[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+            }
+        }
+
+        for (uint8_t byte : _changedMask) {
+            _syncBuffer.encode(byte);
+        }
+        for (size_t i = 0; i < _syncables.size(); i++) {
+            if (_changedMask[i / 8] & (1 << (i % 8))) {
+                _syncables[i]->encode(&_syncBuffer);
+            }
+        }
     }
 
-    std::vector<std::byte> data = _syncBuffer.data();
+    // The SyncBuffer alternates between two buffers, so the returned data stays valid
+    // until the next frame is encoded
+    std::span<const std::byte> data = _syncBuffer.encodedData();
     _syncBuffer.reset();
     return data;
 }
 
 // Should be called on sgct clients
-void SyncEngine::decodeSyncables(std::vector<std::byte> data) {
-    _syncBuffer.setData(std::move(data));
-    for (Syncable* syncable : _syncables) {
-        syncable->decode(&_syncBuffer);
+void SyncEngine::decodeSyncables(std::span<const std::byte> data) {
+    ZoneScoped;
+
+    _syncBuffer.setData(data);
+
+    FrameType type;
+    _syncBuffer.decode(type);
+    uint32_t nSyncables;
+    _syncBuffer.decode(nSyncables);
+    if (nSyncables != _syncables.size()) {
+        LERROR(fmt::format(
+            "Mismatching number of Syncables. Expected {} but received {}",
+            _syncables.size(), nSyncables
+        ));
+        _syncBuffer.reset();
+        return;
+    }
+
+    if (type == FrameType::Full) {
+        for (Syncable* syncable : _syncables) {
+            syncable->decode(&_syncBuffer);
+        }
+    }
+    else {
+        _changedMask.resize((_syncables.size() + 7) / 8);
+        for (uint8_t& byte : _changedMask) {
+            _syncBuffer.decode(byte);
+        }
+        for (size_t i = 0; i < _syncables.size(); i++) {
+            if (_changedMask[i / 8] & (1 << (i % 8))) {
+                _syncables[i]->decode(&_syncBuffer);
+            }
+        }
     }
 
     _syncBuffer.reset();
@@ -78,6 +144,8 @@ void SyncEngine::addSyncable(Syncable* syncable) {
     ghoul_assert(syncable, "Syncable must not be nullptr");
 
     _syncables.push_back(syncable);
+    // The clients have to receive a full frame to pick up the new Syncable
+    _framesSinceKeyframe = _keyframeInterval;
 }
 
 void SyncEngine::addSyncables(const std::vector<Syncable*>& syncables) {
@@ -92,6 +160,7 @@ void SyncEngine::removeSyncable(Syncable* syncable) {
         std::remove(_syncables.begin(), _syncables.end(), syncable),
         _syncables.end()
     );
+    _framesSinceKeyframe = _keyframeInterval;
 }
 
 void SyncEngine::removeSyncables(const std::vector<Syncable*>& syncables) {
@@ -100,4 +169,14 @@ void SyncEngine::removeSyncables(const std::vector<Syncable*>& syncables) {
     }
 }
 
+void SyncEngine::setDeltaEncoding(bool enabled, int keyframeInterval) {
+    ghoul_assert(keyframeInterval > 0, "keyframeInterval must be bigger than 0");
+
+    _useDeltaEncoding = enabled;
+    _keyframeInterval = keyframeInterval;
+    // Make sure that the next frame is a keyframe so that all clients start from a
+    // known state
+    _framesSinceKeyframe = keyframeInterval;
+}
+
 } // namespace openspace
@@ -32,6 +32,7 @@
 namespace openspace {
 
 uint32_t EventEngine::nextRegisteredEventId = 0;
+uint32_t EventEngine::nextRegisteredCallbackId = 0;
 
 #ifdef _DEBUG
 uint64_t EventEngine::nEvents = 0;
@@ -115,6 +116,40 @@ void EventEngine::unregisterEventAction(uint32_t identifier) {
     ));
 }
 
+uint32_t EventEngine::registerEventCallback(events::Event::Type type,
+                                            EventCallback callback)
+{
+    ghoul_assert(callback, "Callback must not be empty");
+
+    const uint32_t id = nextRegisteredCallbackId;
+    nextRegisteredCallbackId++;
+    _eventCallbacks[type].emplace_back(id, std::move(callback));
+    return id;
+}
+
+void EventEngine::unregisterEventCallback(uint32_t identifier) {
+    for (auto it = _eventCallbacks.begin(); it != _eventCallbacks.end(); it++) {
+        auto jt = std::find_if(
+            it->second.begin(),
+            it->second.end(),
+            [identifier](const std::pair<uint32_t, EventCallback>& p) {
+                return p.first == identifier;
+            }
+        );
+        if (jt != it->second.end()) {
+            it->second.erase(jt);
+            if (it->second.empty()) {
+                _eventCallbacks.erase(it);
+            }
+            return;
+        }
+    }
+
+    throw ghoul::RuntimeError(fmt::format(
+        "Could not find event callback with identifier {}", identifier
+    ));
+}
+
 std::vector<EventEngine::ActionInfo> EventEngine::registeredActions() const {
     std::vector<EventEngine::ActionInfo> result;
     result.reserve(_eventActions.size());
@@ -150,21 +185,34 @@ void EventEngine::disableEvent(uint32_t identifier) {
 }
 
 void EventEngine::triggerActions() const {
-    if (_eventActions.empty()) {
+    if (_eventActions.empty() && _eventCallbacks.empty()) {
         // Nothing to do here
         return;
     }
 
     const events::Event* e = _firstEvent;
     while (e) {
+        const auto cb = _eventCallbacks.find(e->type);
+        if (cb != _eventCallbacks.end()) {
+            for (const std::pair<uint32_t, EventCallback>& p : cb->second) {
+                p.second(*e);
+            }
+        }
+
         const auto it = _eventActions.find(e->type);
         if (it != _eventActions.end()) {
-            ghoul::Dictionary params = toParameter(*e);
+            // Creating the parameters is the expensive part, so we only do it once we
+            // know that at least one enabled action needs them
+            std::optional<ghoul::Dictionary> params;
             for (const ActionInfo& ai : it->second) {
-                if (ai.isEnabled &&
-                    (!ai.filter.has_value() || params.isSubset(*ai.filter)))
-                {
-                    global::actionManager->triggerAction(ai.action, params);
+                if (!ai.isEnabled) {
+                    continue;
+                }
+                if (!params.has_value()) {
+                    params = toParameter(*e);
+                }
+                if (!ai.filter.has_value() || params->isSubset(*ai.filter)) {
+                    global::actionManager->triggerAction(ai.action, *params);
                 }
             }
         }
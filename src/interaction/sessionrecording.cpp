@@ -51,11 +51,15 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/profiling.h>
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <iomanip>
 
 #ifdef WIN32
 #include <Windows.h>
+#else // ^^^ WIN32 / !WIN32 vvv
+#include <fcntl.h>
+#include <unistd.h>
 #endif // WIN32
 
 #include "sessionrecording_lua.inl"
@@ -63,6 +67,57 @@
 namespace {
     constexpr std::string_view _loggerCat = "SessionRecording";
 
+    // Size of one keyframe index entry: type, three timestamps, and file offset
+    constexpr size_t IndexEntrySize = sizeof(char) + 3 * sizeof(double) +
+        sizeof(uint64_t);
+    // Size of the trailer at the very end of an indexed file: the number of index
+    // entries, the offset of the index, and the magic string
+    constexpr size_t IndexTrailerSize = 2 * sizeof(uint64_t) + 8;
+
+    // Read-only stream buffer over a range of the memory-mapped playback file, so that
+    // the keyframe structures can decode themselves with their std::istream interface
+    struct MappedBuffer : public std::streambuf {
+        MappedBuffer(const char* begin, const char* end) {
+            setg(const_cast<char*>(begin), const_cast<char*>(begin),
+                const_cast<char*>(end));
+        }
+    };
+
+    // Size of the stream buffer used by the writer thread when saving a recording
+    constexpr size_t RecordingWriteBufferSize = 1 << 20;
+
+    void syncFileToDisk(const std::string& filename) {
+#ifdef WIN32
+        const std::filesystem::path path = filename;
+        HANDLE f = CreateFileW(
+            path.c_str(),
+            GENERIC_WRITE,
+            FILE_SHARE_READ | FILE_SHARE_WRITE,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr
+        );
+        if (f != INVALID_HANDLE_VALUE) {
+            FlushFileBuffers(f);
+            CloseHandle(f);
+        }
+#else // ^^^ WIN32 / !WIN32 vvv
+        const int fd = open(filename.c_str(), O_WRONLY);
+        if (fd != -1) {
+            fsync(fd);
+            close(fd);
+        }
+#endif // WIN32
+    }
+
+    template <typename T>
+    T readFromMapping(const char* mapping, size_t offset) {
+        T res;
+        std::memcpy(&res, mapping + offset, sizeof(T));
+        return res;
+    }
+
     constexpr bool UsingTimeKeyframes = false;
 
     constexpr openspace::properties::Property::PropertyInfo RenderPlaybackInfo = {
@@ -110,11 +165,13 @@ SessionRecording::SessionRecording(bool isGlobal)
 }
 
 SessionRecording::~SessionRecording() {
+    waitForRecordingWriter();
 }
 
 void SessionRecording::deinitialize() {
     stopRecording();
     stopPlayback();
+    waitForRecordingWriter();
 }
 
 void SessionRecording::setRecordDataFormat(DataMode dataMode) {
@@ -189,11 +246,11 @@ bool SessionRecording::handleRecordingFile(std::string filenameIn) {
         LERROR(fmt::format("Unable to open file {} for keyframe recording", absFilename));
         return false;
     }
+    _recordFilename = absFilename.string();
     return true;
 }
 
 bool SessionRecording::startRecording(const std::string& filename) {
-    _timeline.clear();
     if (_state == SessionState::Recording) {
         LERROR("Unable to start recording while already in recording mode");
         return false;
@@ -202,6 +259,9 @@ bool SessionRecording::startRecording(const std::string& filename) {
         LERROR("Unable to start recording while in session playback mode");
         return false;
     }
+    _timeline.clear();
+    // The previous recording might still be in the process of being written
+    waitForRecordingWriter();
     if (!std::filesystem::is_directory(absPath("${RECORDINGS}"))) {
         std::filesystem::create_directories(absPath("${RECORDINGS}"));
     }
@@ -262,80 +322,140 @@ void SessionRecording::recordCurrentTimeRate() {
 
 void SessionRecording::stopRecording() {
     if (_state == SessionState::Recording) {
-        // Add all property baseline scripts to the beginning of the recording file
-        datamessagestructures::ScriptMessage smTmp;
-        for (TimelineEntry& initPropScripts : _keyframesSavePropertiesBaseline_timeline) {
-            if (initPropScripts.keyframeType == RecordedType::Script) {
-                smTmp._script = _keyframesSavePropertiesBaseline_scripts
-                    [initPropScripts.idxIntoKeyframeTypeArray];
+        // Close the recording file; it only contains the header at this point
+        _recordFile.close();
+
+        // Hand the recorded keyframes over to a writer thread so that formatting and
+        // writing a long recording does not stall the frame in which it is stopped
+        RecordingJob job;
+        job.filename = std::move(_recordFilename);
+        job.mode = _recordingDataMode;
+        job.timestampsStarted = _timestamps3RecordStarted;
+        job.timeline = std::move(_timeline);
+        job.keyframesCamera = std::move(_keyframesCamera);
+        job.keyframesTime = std::move(_keyframesTime);
+        job.keyframesScript = std::move(_keyframesScript);
+        job.baselineScripts = std::move(_keyframesSavePropertiesBaseline_scripts);
+        job.baselineTimeline = std::move(_keyframesSavePropertiesBaseline_timeline);
+        waitForRecordingWriter();
+        _recordWriterThread = std::thread(
+            &SessionRecording::writeRecording,
+            this,
+            std::move(job)
+        );
+
+        _state = SessionState::Idle;
+        LINFO("Session recording stopped");
+    }
+    // Close the recording file
+    _recordFile.close();
+    _recordFilename.clear();
+    _cleanupNeededRecording = true;
+}
+
+void SessionRecording::writeRecording(RecordingJob job) {
+    ZoneScoped;
+
+    // A large stream buffer batches the many small keyframe writes into few system
+    // calls, which matters most when recording to a network share
+    std::vector<char> streamBuffer(RecordingWriteBufferSize);
+    std::ofstream file;
+    file.rdbuf()->pubsetbuf(streamBuffer.data(), streamBuffer.size());
+    if (job.mode == DataMode::Binary) {
+        file.open(job.filename, std::ios::binary | std::ios::app);
+    }
+    else {
+        file.open(job.filename, std::ios::app);
+    }
+    if (!file.is_open() || !file.good()) {
+        LERROR(fmt::format(
+            "Unable to open file {} for keyframe recording", job.filename
+        ));
+        return;
+    }
+
+    std::vector<unsigned char> buffer(_saveBufferMaxSize_bytes);
+    // Add all property baseline scripts to the beginning of the recording file
+    datamessagestructures::ScriptMessage smTmp;
+    for (const TimelineEntry& initPropScripts : job.baselineTimeline) {
+        if (initPropScripts.keyframeType == RecordedType::Script) {
+            smTmp._script = job.baselineScripts[initPropScripts.idxIntoKeyframeTypeArray];
+            saveSingleKeyframeScript(
+                smTmp,
+                job.timestampsStarted,
+                job.mode,
+                file,
+                buffer.data()
+            );
+        }
+    }
+    for (TimelineEntry& entry : job.timeline) {
+        switch (entry.keyframeType) {
+            case RecordedType::Camera:
+            {
+                interaction::KeyframeNavigator::CameraPose& kf =
+                    job.keyframesCamera[entry.idxIntoKeyframeTypeArray];
+                datamessagestructures::CameraKeyframe kfMsg(
+                    std::move(kf.position),
+                    std::move(kf.rotation),
+                    std::move(kf.focusNode),
+                    std::move(kf.followFocusNodeRotation),
+                    std::move(kf.scale)
+                );
+                saveSingleKeyframeCamera(
+                    kfMsg,
+                    entry.t3stamps,
+                    job.mode,
+                    file,
+                    buffer.data()
+                );
+                break;
+            }
+            case RecordedType::Time:
+            {
+                datamessagestructures::TimeKeyframe& tf =
+                    job.keyframesTime[entry.idxIntoKeyframeTypeArray];
+                saveSingleKeyframeTime(
+                    tf,
+                    entry.t3stamps,
+                    job.mode,
+                    file,
+                    buffer.data()
+                );
+                break;
+            }
+            case RecordedType::Script:
+            {
+                smTmp._script = job.keyframesScript[entry.idxIntoKeyframeTypeArray];
                 saveSingleKeyframeScript(
                     smTmp,
-                    _timestamps3RecordStarted,
-                    _recordingDataMode,
-                    _recordFile,
-                    _keyframeBuffer
+                    entry.t3stamps,
+                    job.mode,
+                    file,
+                    buffer.data()
                 );
+                break;
             }
-        }
-        for (TimelineEntry entry : _timeline) {
-            switch (entry.keyframeType) {
-                case RecordedType::Camera:
-                {
-                    interaction::KeyframeNavigator::CameraPose kf
-                        = _keyframesCamera[entry.idxIntoKeyframeTypeArray];
-                    datamessagestructures::CameraKeyframe kfMsg(
-                        std::move(kf.position),
-                        std::move(kf.rotation),
-                        std::move(kf.focusNode),
-                        std::move(kf.followFocusNodeRotation),
-                        std::move(kf.scale)
-                    );
-                    saveSingleKeyframeCamera(
-                        kfMsg,
-                        entry.t3stamps,
-                        _recordingDataMode,
-                        _recordFile,
-                        _keyframeBuffer
-                    );
-                    break;
-                }
-                case RecordedType::Time:
-                {
-                    datamessagestructures::TimeKeyframe tf
-                        = _keyframesTime[entry.idxIntoKeyframeTypeArray];
-                    saveSingleKeyframeTime(
-                        tf,
-                        entry.t3stamps,
-                        _recordingDataMode,
-                        _recordFile,
-                        _keyframeBuffer
-                    );
-                    break;
-                }
-                case RecordedType::Script:
-                {
-                    smTmp._script = _keyframesScript[entry.idxIntoKeyframeTypeArray];
-                    saveSingleKeyframeScript(
-                        smTmp,
-                        entry.t3stamps,
-                        _recordingDataMode,
-                        _recordFile,
-                        _keyframeBuffer
-                    );
-                    break;
-                }
-                default:
-                {
-                    break;
-                }
+            default:
+            {
+                break;
             }
         }
-        _state = SessionState::Idle;
-        LINFO("Session recording stopped");
     }
-    // Close the recording file
-    _recordFile.close();
-    _cleanupNeededRecording = true;
+    file.close();
+
+    if (job.mode == DataMode::Binary) {
+        appendPlaybackIndex(job.filename);
+    }
+    // Only force the recording onto the disk once it is complete
+    syncFileToDisk(job.filename);
+    LINFO(fmt::format("Finished writing session recording {}", job.filename));
+}
+
+void SessionRecording::waitForRecordingWriter() {
+    if (_recordWriterThread.joinable()) {
+        _recordWriterThread.join();
+    }
 }
 
 bool SessionRecording::startPlayback(std::string& filename,
@@ -350,6 +470,8 @@ bool SessionRecording::startPlayback(std::string& filename,
     else {
         absFilename = absPath("${RECORDINGS}/" + filename).string();
     }
+    // The file might be a recording that is still being written in the background
+    waitForRecordingWriter();
     // Run through conversion in case file is older. Does nothing if the file format
     // is up-to-date
     absFilename = convertFile(absFilename);
@@ -432,7 +554,11 @@ bool SessionRecording::startPlayback(std::string& filename,
     _loadedNodes.clear();
     populateListofLoadedSceneGraphNodes();
 
-    if (!playbackAddEntriesToTimeline()) {
+    // Indexed binary recordings are mapped into memory and only their timestamps are
+    // read up front; everything else goes through the sequential parser
+    const bool hasIndex =
+        _recordingDataMode == DataMode::Binary && playbackAddEntriesFromIndex();
+    if (!hasIndex && !playbackAddEntriesToTimeline()) {
         cleanUpPlayback();
         return false;
     }
@@ -455,7 +581,7 @@ bool SessionRecording::startPlayback(std::string& filename,
     LINFO(fmt::format(
         "Playback session started: ({:8.3f},0.0,{:13.3f}) with {}/{}/{} entries, "
         "forceTime={}",
-        now, _timestampPlaybackStarted_simulation, _keyframesCamera.size(),
+        now, _timestampPlaybackStarted_simulation, nCameraKeyframes(),
         _keyframesTime.size(), _keyframesScript.size(),
         (_playbackForceSimTimeAtStart ? 1 : 0)
     ));
@@ -606,11 +732,17 @@ void SessionRecording::handlePlaybackEnd() {
 
 void SessionRecording::enableTakeScreenShotDuringPlayback(int fps) {
     _saveRenderingDuringPlayback = true;
+    _saveRenderingTakeScreenshots = true;
     _saveRenderingDeltaTime = 1.0 / fps;
     _saveRenderingDeltaTime_interpolation_usec =
         std::chrono::microseconds(static_cast<long>(_saveRenderingDeltaTime * 1000000));
 }
 
+void SessionRecording::enableFixedStepPlayback(int fps) {
+    enableTakeScreenShotDuringPlayback(fps);
+    _saveRenderingTakeScreenshots = false;
+}
+
 void SessionRecording::disableTakeScreenShotDuringPlayback() {
     _saveRenderingDuringPlayback = false;
 }
@@ -629,10 +761,8 @@ void SessionRecording::cleanUpPlayback() {
     if (!_timeline.empty()) {
         unsigned int p =
             _timeline[_idxTimeline_cameraPtrPrev].idxIntoKeyframeTypeArray;
-        if (_keyframesCamera.size() > 0) {
-            const SceneGraphNode* n = scene->sceneGraphNode(
-                _keyframesCamera[p].focusNode
-            );
+        if (nCameraKeyframes() > 0) {
+            const SceneGraphNode* n = scene->sceneGraphNode(cameraKeyframe(p).focusNode);
             if (n) {
                 global::navigationHandler->orbitalNavigator().setFocusNode(
                     n->identifier()
@@ -641,6 +771,11 @@ void SessionRecording::cleanUpPlayback() {
         }
     }
 
+    if (_saveRenderingDuringPlayback && _saveRenderingTakeScreenshots) {
+        // Make sure that all frames of the playback have been written
+        global::renderEngine->finishScreenshots();
+    }
+
     _playbackFile.close();
     cleanUpTimelinesAndKeyframes();
     _cleanupNeededPlayback = false;
@@ -654,6 +789,8 @@ void SessionRecording::cleanUpRecording() {
 void SessionRecording::cleanUpTimelinesAndKeyframes() {
     _timeline.clear();
     _keyframesCamera.clear();
+    _cameraKeyframeOffsets.clear();
+    unmapPlaybackFile();
     _keyframesTime.clear();
     _keyframesScript.clear();
     _keyframesSavePropertiesBaseline_scripts.clear();
@@ -667,6 +804,7 @@ void SessionRecording::cleanUpTimelinesAndKeyframes() {
     _idxTimeline_cameraPtrPrev = 0;
     _hasHitEndOfCameraKeyframes = false;
     _saveRenderingDuringPlayback = false;
+    _saveRenderingTakeScreenshots = true;
     _saveRendering_isFirstFrame = true;
     _playbackPauseOffset = 0.0;
     _playbackLoopMode = false;
@@ -1080,6 +1218,10 @@ bool SessionRecording::playbackAddEntriesToTimeline() {
             else if (frameType == HeaderScriptBinary) {
                 parsingStatusOk = playbackScript();
             }
+            else if (frameType == HeaderIndexBinary) {
+                // The keyframe index follows the last keyframe
+                break;
+            }
             else {
                 LERROR(fmt::format(
                     "Unknown frame type {} @ index {} of playback file {}",
@@ -1136,6 +1278,230 @@ bool SessionRecording::playbackAddEntriesToTimeline() {
     return parsingStatusOk;
 }
 
+bool SessionRecording::appendPlaybackIndex(const std::string& filename) {
+    ZoneScoped;
+
+    std::ifstream file(filename, std::ifstream::in | std::ios::binary);
+    if (!file.is_open()) {
+        LERROR(fmt::format("Unable to open recording {} for indexing", filename));
+        return false;
+    }
+    const size_t headerSize = FileHeaderTitle.length() + FileHeaderVersionLength +
+        sizeof(DataFormatBinaryTag) + sizeof('\n');
+    file.seekg(headerSize);
+
+    struct Entry {
+        char type;
+        Timestamps times;
+        uint64_t offset;
+    };
+    std::vector<Entry> entries;
+    Timestamps times;
+    datamessagestructures::CameraKeyframe cameraKf;
+    datamessagestructures::TimeKeyframe timeKf;
+    datamessagestructures::ScriptMessage scriptKf;
+    int lineNum = 1;
+    while (true) {
+        const uint64_t offset = static_cast<uint64_t>(file.tellg());
+        const char frameType = readFromPlayback<char>(file);
+        if (!file) {
+            break;
+        }
+
+        bool success = false;
+        if (frameType == HeaderCameraBinary) {
+            success = readCameraKeyframeBinary(times, cameraKf, file, lineNum);
+        }
+        else if (frameType == HeaderTimeBinary) {
+            success = readTimeKeyframeBinary(times, timeKf, file, lineNum);
+        }
+        else if (frameType == HeaderScriptBinary) {
+            success = readScriptKeyframeBinary(times, scriptKf, file, lineNum);
+        }
+        if (!success) {
+            LERROR(fmt::format(
+                "Unable to index entry {} of recording {}", lineNum - 1, filename
+            ));
+            return false;
+        }
+        entries.push_back({ frameType, times, offset });
+        lineNum++;
+    }
+    file.close();
+
+    std::ofstream out(filename, std::ios::binary | std::ios::app);
+    out.seekp(0, std::ios::end);
+    const uint64_t indexOffset = static_cast<uint64_t>(out.tellp());
+    out.write(&HeaderIndexBinary, sizeof(HeaderIndexBinary));
+    for (const Entry& e : entries) {
+        out.write(&e.type, sizeof(e.type));
+        out.write(reinterpret_cast<const char*>(&e.times.timeOs), sizeof(double));
+        out.write(reinterpret_cast<const char*>(&e.times.timeRec), sizeof(double));
+        out.write(reinterpret_cast<const char*>(&e.times.timeSim), sizeof(double));
+        out.write(reinterpret_cast<const char*>(&e.offset), sizeof(uint64_t));
+    }
+    const uint64_t nEntries = entries.size();
+    out.write(reinterpret_cast<const char*>(&nEntries), sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(&indexOffset), sizeof(uint64_t));
+    out.write(IndexMagic.data(), IndexMagic.size());
+    if (!out.good()) {
+        LERROR(fmt::format("Unable to write keyframe index to recording {}", filename));
+        return false;
+    }
+    return true;
+}
+
+bool SessionRecording::playbackAddEntriesFromIndex() {
+    ZoneScoped;
+
+    _playbackFile = MemoryMappedFile(_playbackFilename);
+    if (_playbackFile.size() < IndexTrailerSize) {
+        _playbackFile = MemoryMappedFile();
+        return false;
+    }
+    _playbackMapping = reinterpret_cast<const char*>(_playbackFile.data());
+    const size_t fileSize = _playbackFile.size();
+
+    const size_t trailer = fileSize - IndexTrailerSize;
+    const uint64_t nEntries = readFromMapping<uint64_t>(_playbackMapping, trailer);
+    const uint64_t indexOffset = readFromMapping<uint64_t>(
+        _playbackMapping,
+        trailer + sizeof(uint64_t)
+    );
+    const bool isValid =
+        std::memcmp(
+            _playbackMapping + trailer + 2 * sizeof(uint64_t),
+            IndexMagic.data(),
+            IndexMagic.size()
+        ) == 0 &&
+        indexOffset < trailer &&
+        _playbackMapping[indexOffset] == HeaderIndexBinary &&
+        (trailer - indexOffset - 1) == nEntries * IndexEntrySize;
+    if (!isValid) {
+        // Not an indexed file; fall back to parsing the keyframes sequentially
+        unmapPlaybackFile();
+        return false;
+    }
+    _playbackIndexOffset = static_cast<size_t>(indexOffset);
+
+    _cameraKeyframeOffsets.reserve(nEntries);
+    _timeline.reserve(nEntries);
+    size_t entry = _playbackIndexOffset + 1;
+    for (uint64_t i = 0; i < nEntries; i++) {
+        const char type = _playbackMapping[entry];
+        Timestamps times;
+        const char* ts = _playbackMapping + entry + sizeof(char);
+        times.timeOs = readFromMapping<double>(ts, 0);
+        times.timeRec = readFromMapping<double>(ts, sizeof(double));
+        times.timeSim = readFromMapping<double>(ts, 2 * sizeof(double));
+        const uint64_t offset = readFromMapping<uint64_t>(ts, 3 * sizeof(double));
+        entry += IndexEntrySize;
+        _playbackLineNum++;
+
+        bool success = false;
+        if (offset + 1 + 3 * sizeof(double) >= _playbackIndexOffset) {
+            success = false;
+        }
+        else if (type == HeaderCameraBinary) {
+            const size_t idx = _cameraKeyframeOffsets.size();
+            _cameraKeyframeOffsets.push_back(offset);
+            success = addKeyframeToTimeline(
+                _timeline,
+                RecordedType::Camera,
+                idx,
+                times,
+                _playbackLineNum
+            );
+        }
+        else if (type == HeaderTimeBinary) {
+            // Time and script keyframes are rare, so they are decoded right away
+            const char* begin = _playbackMapping + offset + 1 + 3 * sizeof(double);
+            MappedBuffer buffer(begin, _playbackMapping + _playbackIndexOffset);
+            std::istream stream(&buffer);
+            datamessagestructures::TimeKeyframe kf;
+            kf.read(&stream);
+            kf._timestamp =
+                equivalentApplicationTime(times.timeOs, times.timeRec, times.timeSim);
+            kf._time = kf._timestamp + _timestampApplicationStarted_simulation;
+            success = stream && addKeyframe(times, kf, _playbackLineNum);
+        }
+        else if (type == HeaderScriptBinary) {
+            const char* begin = _playbackMapping + offset + 1 + 3 * sizeof(double);
+            MappedBuffer buffer(begin, _playbackMapping + _playbackIndexOffset);
+            std::istream stream(&buffer);
+            datamessagestructures::ScriptMessage kf;
+            try {
+                kf.read(&stream);
+            }
+            catch (std::bad_alloc&) {
+                stream.setstate(std::ios::failbit);
+            }
+            catch (std::length_error&) {
+                stream.setstate(std::ios::failbit);
+            }
+            checkIfScriptUsesScenegraphNode(kf._script);
+            success = stream && addKeyframe(times, kf._script, _playbackLineNum);
+        }
+        if (!success) {
+            LWARNING(fmt::format(
+                "Error reading indexed keyframe entry {} of playback file {}; parsing "
+                "the file sequentially instead",
+                _playbackLineNum - 1, _playbackFilename
+            ));
+            // Leave a clean state behind for the sequential parser
+            _timeline.clear();
+            _keyframesTime.clear();
+            _keyframesScript.clear();
+            _cameraKeyframeOffsets.clear();
+            unmapPlaybackFile();
+            _playbackLineNum = 1;
+            return false;
+        }
+    }
+
+    LINFO(fmt::format(
+        "Finished indexing {} entries from playback file {}",
+        nEntries, _playbackFilename
+    ));
+    return true;
+}
+
+void SessionRecording::unmapPlaybackFile() {
+    _playbackFile = MemoryMappedFile();
+    _playbackMapping = nullptr;
+    _playbackIndexOffset = 0;
+}
+
+interaction::KeyframeNavigator::CameraPose SessionRecording::cameraKeyframe(
+                                                                 unsigned int index) const
+{
+    if (_cameraKeyframeOffsets.empty()) {
+        return _keyframesCamera[index];
+    }
+
+    const size_t offset = _cameraKeyframeOffsets[index] + 1 + 3 * sizeof(double);
+    MappedBuffer buffer(
+        _playbackMapping + offset,
+        _playbackMapping + _playbackIndexOffset
+    );
+    std::istream stream(&buffer);
+    datamessagestructures::CameraKeyframe kf;
+    kf.read(&stream);
+    if (!stream) {
+        LERROR(fmt::format(
+            "Error reading camera keyframe {} of playback file {}",
+            index, _playbackFilename
+        ));
+    }
+    return interaction::KeyframeNavigator::CameraPose(std::move(kf));
+}
+
+size_t SessionRecording::nCameraKeyframes() const {
+    return _cameraKeyframeOffsets.empty() ?
+        _keyframesCamera.size() :
+        _cameraKeyframeOffsets.size();
+}
+
 double SessionRecording::appropriateTimestamp(Timestamps t3stamps)
 {
     if (_playbackTimeReferenceMode == KeyframeTimeRef::Relative_recordedStart) {
@@ -1242,7 +1608,7 @@ bool SessionRecording::playbackCamera() {
     return success;
 }
 
-bool SessionRecording::convertCamera(std::stringstream& inStream, DataMode mode,
+bool SessionRecording::convertCamera(std::ifstream& inStream, DataMode mode,
                                      int lineNum, std::string& inputLine,
                                      std::ofstream& outFile, unsigned char* buffer)
 {
@@ -1253,7 +1619,7 @@ bool SessionRecording::convertCamera(std::stringstream& inStream, DataMode mode,
         kf,
         times,
         mode,
-        reinterpret_cast<std::ifstream&>(inStream),
+        inStream,
         inputLine,
         lineNum
     );
@@ -1377,7 +1743,7 @@ bool SessionRecording::playbackTimeChange() {
     return success;
 }
 
-bool SessionRecording::convertTimeChange(std::stringstream& inStream, DataMode mode,
+bool SessionRecording::convertTimeChange(std::ifstream& inStream, DataMode mode,
                                          int lineNum, std::string& inputLine,
                                          std::ofstream& outFile, unsigned char* buffer)
 {
@@ -1388,7 +1754,7 @@ bool SessionRecording::convertTimeChange(std::stringstream& inStream, DataMode m
         kf,
         times,
         mode,
-        reinterpret_cast<std::ifstream&>(inStream),
+        inStream,
         inputLine,
         lineNum
     );
@@ -1647,9 +2013,9 @@ std::string SessionRecording::getNameFromSurroundingQuotes(std::string& s) {
 }
 
 bool SessionRecording::checkIfInitialFocusNodeIsLoaded(unsigned int camIdx1) {
-    if (_keyframesCamera.size() > 0) {
-        std::string startFocusNode
-            = _keyframesCamera[_timeline[camIdx1].idxIntoKeyframeTypeArray].focusNode;
+    if (nCameraKeyframes() > 0) {
+        std::string startFocusNode =
+            cameraKeyframe(_timeline[camIdx1].idxIntoKeyframeTypeArray).focusNode;
         auto it = std::find(_loadedNodes.begin(), _loadedNodes.end(), startFocusNode);
         if (it == _loadedNodes.end()) {
             LERROR(fmt::format(
@@ -1663,7 +2029,7 @@ bool SessionRecording::checkIfInitialFocusNodeIsLoaded(unsigned int camIdx1) {
 }
 
 
-bool SessionRecording::convertScript(std::stringstream& inStream, DataMode mode,
+bool SessionRecording::convertScript(std::ifstream& inStream, DataMode mode,
                                      int lineNum, std::string& inputLine,
                                      std::ofstream& outFile, unsigned char* buffer)
 {
@@ -1674,7 +2040,7 @@ bool SessionRecording::convertScript(std::stringstream& inStream, DataMode mode,
         kf,
         times,
         mode,
-        reinterpret_cast<std::ifstream&>(inStream),
+        inStream,
         inputLine,
         lineNum
     );
@@ -1875,7 +2241,9 @@ void SessionRecording::moveAheadInTime() {
                 _saveRenderingCurrentRecordedTime += _saveRenderingDeltaTime;
                 _saveRenderingCurrentApplicationTime_interpolation +=
                     _saveRenderingDeltaTime;
-                global::renderEngine->takeScreenshot();
+                if (_saveRenderingTakeScreenshots) {
+                    global::renderEngine->takeScreenshot();
+                }
             }
         }
     }
@@ -1939,7 +2307,7 @@ bool SessionRecording::findNextFutureCameraIndex(double currTime) {
             double seekAheadKeyframeTimestamp
                 = appropriateTimestamp(_timeline[seekAheadIndex].t3stamps);
 
-            if (indexIntoCameraKeyframes >= (_keyframesCamera.size() - 1)) {
+            if (indexIntoCameraKeyframes >= (nCameraKeyframes() - 1)) {
                 _hasHitEndOfCameraKeyframes = true;
             }
 
@@ -2021,14 +2389,14 @@ bool SessionRecording::processCameraKeyframe(double now) {
     if (!_playbackActive_camera) {
         return false;
     }
-    else if (_keyframesCamera.empty()) {
+    else if (nCameraKeyframes() == 0) {
         return false;
     }
     else {
         prevIdx = _timeline[_idxTimeline_cameraPtrPrev].idxIntoKeyframeTypeArray;
-        prevPose = _keyframesCamera[prevIdx];
+        prevPose = cameraKeyframe(prevIdx);
         nextIdx = _timeline[_idxTimeline_cameraPtrNext].idxIntoKeyframeTypeArray;
-        nextPose = _keyframesCamera[nextIdx];
+        nextPose = cameraKeyframe(nextIdx);
     }
 
     // getPrevTimestamp();
@@ -2059,7 +2427,7 @@ bool SessionRecording::processCameraKeyframe(double now) {
     Camera* camera = global::navigationHandler->camera();
     Scene* scene = camera->parent()->scene();
 
-    const SceneGraphNode* n = scene->sceneGraphNode(_keyframesCamera[prevIdx].focusNode);
+    const SceneGraphNode* n = scene->sceneGraphNode(prevPose.focusNode);
     if (n) {
         global::navigationHandler->orbitalNavigator().setFocusNode(n->identifier());
     }
@@ -2159,7 +2527,8 @@ void SessionRecording::saveKeyframeToFileBinary(unsigned char* buffer,
 }
 
 void SessionRecording::saveKeyframeToFile(std::string entry, std::ofstream& file) {
-    file << std::move(entry) << std::endl;
+    // No std::endl here as flushing every line defeats the buffering of the stream
+    file << std::move(entry) << '\n';
 }
 
 SessionRecording::CallbackHandle SessionRecording::addStateChangeCallback(
@@ -2216,7 +2585,7 @@ std::vector<std::string> SessionRecording::playbackList() const {
     return fileList;
 }
 
-void SessionRecording::readPlaybackHeader_stream(std::stringstream& conversionInStream,
+void SessionRecording::readPlaybackHeader_stream(std::ifstream& conversionInStream,
                                                  std::string& version, DataMode& mode)
 {
     // Read header
@@ -2270,9 +2639,8 @@ SessionRecording::DataMode SessionRecording::readModeFromHeader(std::string file
     return mode;
 }
 
-void SessionRecording::readFileIntoStringStream(std::string filename,
-                                                std::ifstream& inputFstream,
-                                                std::stringstream& stream)
+void SessionRecording::openFileForConversion(std::string filename,
+                                             std::ifstream& inputFstream)
 {
     std::filesystem::path conversionInFilename = absPath(filename);
     if (!std::filesystem::is_regular_file(conversionInFilename)) {
@@ -2283,22 +2651,22 @@ void SessionRecording::readFileIntoStringStream(std::string filename,
 
     DataMode mode = readModeFromHeader(conversionInFilename.string());
 
-    stream.str("");
-    stream.clear();
+    // The file is read as a stream during the conversion instead of being loaded into
+    // memory first, so that converting large recordings does not require memory
+    // proportional to their size
     inputFstream.close();
+    inputFstream.clear();
     if (mode == DataMode::Binary) {
         inputFstream.open(conversionInFilename, std::ifstream::in | std::ios::binary);
     }
     else {
         inputFstream.open(conversionInFilename, std::ifstream::in);
     }
-    stream << inputFstream.rdbuf();
     if (!inputFstream.is_open() || !inputFstream.good()) {
         throw ConversionError(fmt::format(
             "Unable to open file {} for conversion", filename.c_str()
         ));
     }
-    inputFstream.close();
 }
 
 void SessionRecording::convertFileRelativePath(std::string filenameRelative) {
@@ -2308,18 +2676,17 @@ void SessionRecording::convertFileRelativePath(std::string filenameRelative) {
 std::string SessionRecording::convertFile(std::string filename, int depth) {
     std::string conversionOutFilename = filename;
     std::ifstream conversionInFile;
-    std::stringstream conversionInStream;
     if (depth >= _maximumRecursionDepth) {
         LERROR("Runaway recursion in session recording conversion of file version");
         exit(EXIT_FAILURE);
     }
     std::string newFilename = filename;
     try {
-        readFileIntoStringStream(filename, conversionInFile, conversionInStream);
+        openFileForConversion(filename, conversionInFile);
         DataMode mode;
         std::string fileVersion;
         readPlaybackHeader_stream(
-            conversionInStream,
+            conversionInFile,
             fileVersion,
             mode
         );
@@ -2330,15 +2697,14 @@ std::string SessionRecording::convertFile(std::string filename, int depth) {
         // to the next level down in the legacy subclasses until we get the right
         // version, then proceed with conversion from there.
         if (fileVersion != fileFormatVersion()) {
-            //conversionInStream.seekg(conversionInStream.beg);
             newFilename = getLegacyConversionResult(filename, depth + 1);
             removeTrailingPathSlashes(newFilename);
             if (filename == newFilename) {
                 return filename;
             }
-            readFileIntoStringStream(newFilename, conversionInFile, conversionInStream);
+            openFileForConversion(newFilename, conversionInFile);
             readPlaybackHeader_stream(
-                conversionInStream,
+                conversionInFile,
                 fileVersion,
                 mode
             );
@@ -2379,12 +2745,17 @@ std::string SessionRecording::convertFile(std::string filename, int depth) {
             conversionOutFile << '\n';
             convertEntries(
                 newFilename,
-                conversionInStream,
+                conversionInFile,
                 mode,
                 conversionLineNum,
                 conversionOutFile
             );
             conversionOutFile.close();
+            if (mode == DataMode::Binary &&
+                targetFileFormatVersion() >= IndexedFileFormatVersion)
+            {
+                appendPlaybackIndex(conversionOutFilename);
+            }
         }
         conversionInFile.close();
     }
@@ -2401,7 +2772,7 @@ std::string SessionRecording::convertFile(std::string filename, int depth) {
 }
 
 bool SessionRecording::convertEntries(std::string& inFilename,
-                                      std::stringstream& inStream, DataMode mode,
+                                      std::ifstream& inStream, DataMode mode,
                                       int lineNum, std::ofstream& outFile)
 {
     bool conversionStatusOk = true;
@@ -2454,6 +2825,11 @@ bool SessionRecording::convertEntries(std::string& inFilename,
                     conversionStatusOk = false;
                 }
             }
+            else if (frameType == HeaderIndexBinary) {
+                // The keyframe index follows the last keyframe and is regenerated for
+                // the converted file
+                break;
+            }
             else {
                 LERROR(fmt::format(
                     "Unknown frame type {} @ index {} of conversion file {}",
@@ -2534,6 +2910,13 @@ bool SessionRecording::convertEntries(std::string& inFilename,
 }
 
 std::string SessionRecording::getLegacyConversionResult(std::string filename, int depth) {
+    SessionRecording_legacy_0100 legacy;
+    return legacy.convertFile(filename, depth);
+}
+
+std::string SessionRecording_legacy_0100::getLegacyConversionResult(std::string filename,
+                                                                    int depth)
+{
     SessionRecording_legacy_0085 legacy;
     return legacy.convertFile(filename, depth);
 }
@@ -2574,7 +2957,7 @@ std::string SessionRecording::determineConversionOutFilename(const std::string f
     return filenameSansExtension + fileExtension;
 }
 
-bool SessionRecording_legacy_0085::convertScript(std::stringstream& inStream,
+bool SessionRecording_legacy_0085::convertScript(std::ifstream& inStream,
                                                  DataMode mode, int lineNum,
                                                  std::string& inputLine,
                                                  std::ofstream& outFile,
@@ -2587,7 +2970,7 @@ bool SessionRecording_legacy_0085::convertScript(std::stringstream& inStream,
         kf,
         times,
         mode,
-        reinterpret_cast<std::ifstream&>(inStream),
+        inStream,
         inputLine,
         lineNum
     );
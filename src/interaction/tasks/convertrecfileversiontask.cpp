@@ -32,11 +32,17 @@
 #include <filesystem>
 #include <iomanip>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "ConvertRecFileVersionTask";
 
     constexpr std::string_view KeyInFilePath = "InputFilePath";
+    constexpr std::string_view KeyInDirectory = "InputDirectory";
+    constexpr std::string_view KeyThreadCount = "ThreadCount";
 } // namespace
 
 namespace openspace::interaction {
@@ -49,6 +55,47 @@ ConvertRecFileVersionTask::ConvertRecFileVersionTask(const ghoul::Dictionary& di
         "ConvertRecFileVersionTask"
     );
 
+    if (dictionary.hasValue<std::string>(KeyInDirectory)) {
+        _inDirectory = absPath(dictionary.value<std::string>(KeyInDirectory));
+        if (!std::filesystem::is_directory(_inDirectory)) {
+            LERROR(fmt::format(
+                "Failed to find session recording directory: {}", _inDirectory
+            ));
+            return;
+        }
+        namespace fs = std::filesystem;
+        for (const fs::directory_entry& e : fs::directory_iterator(_inDirectory)) {
+            const std::string path = e.path().string();
+            if (e.is_regular_file() &&
+                (SessionRecording::hasFileExtension(
+                    path,
+                    SessionRecording::FileExtensionBinary
+                ) ||
+                SessionRecording::hasFileExtension(
+                    path,
+                    SessionRecording::FileExtensionAscii
+                )))
+            {
+                _directoryFiles.push_back(e.path());
+            }
+        }
+        std::sort(_directoryFiles.begin(), _directoryFiles.end());
+
+        _nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        if (dictionary.hasValue<int>(KeyThreadCount)) {
+            _nThreads = static_cast<unsigned int>(
+                std::max(dictionary.value<int>(KeyThreadCount), 1)
+            );
+        }
+        return;
+    }
+
+    if (!dictionary.hasValue<std::string>(KeyInFilePath)) {
+        LERROR(fmt::format(
+            "Either '{}' or '{}' has to be specified", KeyInFilePath, KeyInDirectory
+        ));
+        return;
+    }
     _inFilename = dictionary.value<std::string>(KeyInFilePath);
     _inFilePath = absPath(_inFilename);
 
@@ -68,6 +115,13 @@ ConvertRecFileVersionTask::~ConvertRecFileVersionTask() {
 }
 
 std::string ConvertRecFileVersionTask::description() {
+    if (!_inDirectory.empty()) {
+        return fmt::format(
+            "Convert file format of the {} session recording files in {} to current "
+            "version using {} threads",
+            _directoryFiles.size(), _inDirectory, _nThreads
+        );
+    }
     std::string description = fmt::format(
         "Convert file format of session recording file {} to current version",
         _inFilePath
@@ -75,11 +129,57 @@ std::string ConvertRecFileVersionTask::description() {
     return description;
 }
 
-void ConvertRecFileVersionTask::perform(const Task::ProgressCallback&) {
-    convert();
+void ConvertRecFileVersionTask::perform(const Task::ProgressCallback& progressCallback) {
+    if (!_inDirectory.empty()) {
+        convertDirectory(progressCallback);
+    }
+    else {
+        convert();
+    }
+}
+
+void ConvertRecFileVersionTask::convertDirectory(
+                                         const Task::ProgressCallback& progressCallback)
+{
+    // Every thread picks the next unconverted file until all files are done. The
+    // conversion of a single file is streamed from the file, so memory usage only
+    // depends on the number of threads and not on the size of the recordings
+    std::atomic<size_t> next = 0;
+    size_t nFinished = 0;
+    std::mutex progressMutex;
+    auto worker = [&]() {
+        SessionRecording sessionRecording(false);
+        while (true) {
+            const size_t i = next++;
+            if (i >= _directoryFiles.size()) {
+                break;
+            }
+            sessionRecording.convertFile(_directoryFiles[i].string());
+
+            std::lock_guard lock(progressMutex);
+            nFinished++;
+            progressCallback(static_cast<float>(nFinished) / _directoryFiles.size());
+        }
+    };
+
+    const size_t nThreads = std::min<size_t>(_nThreads, _directoryFiles.size());
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    for (size_t i = 0; i < nThreads; i++) {
+        threads.emplace_back(worker);
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    LINFO(fmt::format(
+        "Converted {} session recording files in {}", nFinished, _inDirectory
+    ));
 }
 
 void ConvertRecFileVersionTask::convert() {
+    if (!sessRec) {
+        return;
+    }
     bool hasBinaryFileExtension = sessRec->hasFileExtension(
         _inFilename,
         SessionRecording::FileExtensionBinary
@@ -107,8 +207,23 @@ documentation::Documentation ConvertRecFileVersionTask::documentation() {
             {
                 "InputFilePath",
                 new StringAnnotationVerifier("A valid filename to convert"),
-                Optional::No,
-                "The filename to update to the current file format",
+                Optional::Yes,
+                "The filename to update to the current file format. Either this or "
+                "InputDirectory has to be specified",
+            },
+            {
+                "InputDirectory",
+                new StringAnnotationVerifier("A valid directory"),
+                Optional::Yes,
+                "A directory whose session recording files are all updated to the "
+                "current file format. The files are converted in parallel",
+            },
+            {
+                "ThreadCount",
+                new IntGreaterVerifier(0),
+                Optional::Yes,
+                "The number of files from the InputDirectory that are converted at the "
+                "same time. Defaults to the number of hardware threads",
             },
         },
     };
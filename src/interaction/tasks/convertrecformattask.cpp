@@ -225,6 +225,10 @@ void ConvertRecFormatTask::convertToAscii() {
                 keyframeLine);
             skf.write(keyframeLine);
         }
+        else if (frameType == SessionRecording::HeaderIndexBinary) {
+            // The keyframe index follows the last keyframe and has no ascii equivalent
+            break;
+        }
         else {
             LERROR(fmt::format(
                 "Unknown frame type @ index {} of playback file {}",
@@ -53,7 +53,6 @@ KeyframeNavigator::CameraPose::CameraPose(datamessagestructures::CameraKeyframe&
 
 bool KeyframeNavigator::updateCamera(Camera& camera, bool ignoreFutureKeyframes) {
     double now = currentTime();
-    bool foundPrevKeyframe = false;
 
     if (_cameraPoseTimeline.nKeyframes() == 0) {
         return false;
@@ -63,46 +62,119 @@ bool KeyframeNavigator::updateCamera(Camera& camera, bool ignoreFutureKeyframes)
         _cameraPoseTimeline.firstKeyframeAfter(now);
     const Keyframe<CameraPose>* prevKeyframe =
         _cameraPoseTimeline.lastKeyframeBefore(now);
+    const Keyframe<CameraPose>* beforePrevKeyframe = prevKeyframe ?
+        _cameraPoseTimeline.lastKeyframeBefore(prevKeyframe->timestamp) :
+        nullptr;
 
-    double nextTime = 0.0;
-    if (nextKeyframe) {
-        nextTime = nextKeyframe->timestamp;
-    }
-    else {
+    if (!nextKeyframe) {
         if (ignoreFutureKeyframes) {
             _cameraPoseTimeline.removeKeyframesBefore(now);
+            return false;
+        }
+
+        // The next keyframe has not arrived yet, so continue the motion between the
+        // last two keyframes for a limited time instead of stopping the camera
+        if (!prevKeyframe || !beforePrevKeyframe) {
+            return false;
+        }
+        const double interval = prevKeyframe->timestamp - beforePrevKeyframe->timestamp;
+        if (interval <= 0.0 || now - prevKeyframe->timestamp > interval) {
+            return false;
         }
+        const double t = (now - beforePrevKeyframe->timestamp) / interval;
+        applyPose(
+            &camera,
+            beforePrevKeyframe->data,
+            prevKeyframe->data,
+            t,
+            ignoreFutureKeyframes,
+            std::nullopt,
+            2.0
+        );
         return false;
     }
 
-    double prevTime = 0.0;
-    double t = 0.0;
-    if (prevKeyframe) {
-        prevTime = prevKeyframe->timestamp;
-        t = (now - prevTime) / (nextTime - prevTime);
-        foundPrevKeyframe = true;
-    }
-    else {
+    const double nextTime = nextKeyframe->timestamp;
+    if (!prevKeyframe) {
         // If there is no keyframe before: Only use the next keyframe.
-        prevTime = nextTime;
-        prevKeyframe = nextKeyframe;
-        t = 1;
+        if (ignoreFutureKeyframes) {
+            return false;
+        }
+        const CameraPose nextPose = nextKeyframe->data;
+        return applyPose(
+            &camera,
+            nextPose,
+            nextPose,
+            1.0,
+            ignoreFutureKeyframes,
+            std::nullopt,
+            1.0
+        );
     }
 
+    const double prevTime = prevKeyframe->timestamp;
+    const double t = (now - prevTime) / (nextTime - prevTime);
     const CameraPose prevPose = prevKeyframe->data;
     const CameraPose nextPose = nextKeyframe->data;
-    _cameraPoseTimeline.removeKeyframesBefore(prevTime);
 
-    if (!foundPrevKeyframe && ignoreFutureKeyframes) {
-        return false;
+    // Catmull-Rom style tangents from the neighboring keyframes, scaled to the interval
+    // between prevPose and nextPose. Neighbors with a different focus node or rotation
+    // mode are not used, which makes the corresponding end of the curve linear
+    auto isCompatible = [&prevPose](const CameraPose& pose) {
+        return pose.focusNode == prevPose.focusNode &&
+            pose.followFocusNodeRotation == prevPose.followFocusNodeRotation;
+    };
+    const double interval = nextTime - prevTime;
+    const glm::dvec3 chord = nextPose.position - prevPose.position;
+    glm::dvec3 prevTangent = chord;
+    if (beforePrevKeyframe && isCompatible(beforePrevKeyframe->data)) {
+        prevTangent = (nextPose.position - beforePrevKeyframe->data.position) /
+            (nextTime - beforePrevKeyframe->timestamp) * interval;
     }
+    glm::dvec3 nextTangent = chord;
+    const Keyframe<CameraPose>* afterNextKeyframe =
+        _cameraPoseTimeline.firstKeyframeAfter(nextTime);
+    if (afterNextKeyframe && isCompatible(afterNextKeyframe->data)) {
+        nextTangent = (afterNextKeyframe->data.position - prevPose.position) /
+            (afterNextKeyframe->timestamp - prevTime) * interval;
+    }
+
+    // Keep the keyframe before the previous one around for the tangent computation
+    _cameraPoseTimeline.removeKeyframesBefore(
+        beforePrevKeyframe ? beforePrevKeyframe->timestamp : prevTime
+    );
 
-    return updateCamera(&camera, prevPose, nextPose, t, ignoreFutureKeyframes);
+    return applyPose(
+        &camera,
+        prevPose,
+        nextPose,
+        t,
+        ignoreFutureKeyframes,
+        Tangents{ prevTangent, nextTangent },
+        1.0
+    );
 }
 
 bool KeyframeNavigator::updateCamera(Camera* camera, const CameraPose prevPose,
                                      const CameraPose nextPose, double t,
                                      bool ignoreFutureKeyframes)
+{
+    return applyPose(
+        camera,
+        prevPose,
+        nextPose,
+        t,
+        ignoreFutureKeyframes,
+        std::nullopt,
+        1.0
+    );
+}
+
+bool KeyframeNavigator::applyPose(Camera* camera, const CameraPose& prevPose,
+                                  const CameraPose& nextPose, double t,
+                                  bool ignoreFutureKeyframes,
+                                  const std::optional<Tangents>& tangents,
+                                  double maxT)
 {
     Scene* scene = camera->parent()->scene();
     SceneGraphNode* prevFocusNode = scene->sceneGraphNode(prevPose.focusNode);
@@ -140,10 +212,31 @@ bool KeyframeNavigator::updateCamera(Camera* camera, const CameraPose prevPose,
     prevKeyframeCameraPosition += prevFocusNode->worldPosition();
     nextKeyframeCameraPosition += nextFocusNode->worldPosition();
 
-    // Linear interpolation
-    t = std::max(0.0, std::min(1.0, t));
-    glm::dvec3 nowCameraPosition = prevKeyframeCameraPosition * (1.0 - t) +
-                                   nextKeyframeCameraPosition * t;
+    t = std::max(0.0, std::min(maxT, t));
+    glm::dvec3 nowCameraPosition;
+    const bool useHermite = tangents.has_value() && t <= 1.0 &&
+        prevPose.focusNode == nextPose.focusNode &&
+        prevPose.followFocusNodeRotation == nextPose.followFocusNodeRotation;
+    if (useHermite) {
+        // Cubic Hermite interpolation in the frame of the poses, which is then
+        // transformed the same way as the keyframe positions above
+        const double t2 = t * t;
+        const double t3 = t2 * t;
+        const glm::dvec3 position =
+            (2.0 * t3 - 3.0 * t2 + 1.0) * prevPose.position +
+            (t3 - 2.0 * t2 + t) * (*tangents)[0] +
+            (-2.0 * t3 + 3.0 * t2) * nextPose.position +
+            (t3 - t2) * (*tangents)[1];
+        nowCameraPosition = prevPose.followFocusNodeRotation ?
+            prevFocusNode->worldRotationMatrix() * position :
+            position;
+        nowCameraPosition += prevFocusNode->worldPosition();
+    }
+    else {
+        // Linear interpolation
+        nowCameraPosition = prevKeyframeCameraPosition * (1.0 - t) +
+                            nextKeyframeCameraPosition * t;
+    }
     glm::dquat nowCameraRotation = glm::slerp(
         prevKeyframeCameraRotation,
         nextKeyframeCameraRotation,
@@ -139,6 +139,8 @@ Waypoint Path::endPoint() const { return _end; }
 
 double Path::pathLength() const { return _curve->length(); }
 
+double Path::traveledDistance() const { return _traveledDistance; }
+
 std::vector<glm::dvec3> Path::controlPoints() const {
     return _curve->points();
 }
@@ -125,93 +125,70 @@ void PathCurve::initializeParameterData() {
 
     _parameterSamples.push_back({ max, _totalLength });
     _parameterSamples.shrink_to_fit();
+
+    // Store the derivative du/ds at every sample for the Hermite interpolation
+    for (ParameterPair& sample : _parameterSamples) {
+        const double dsdu = approximatedDerivative(sample.u);
+        sample.dudS = dsdu > 0.0 ? 1.0 / dsdu : 0.0;
+    }
+
+    // Divide the arc length into evenly sized buckets and store the last sample at or
+    // before the start of each bucket, so that the samples around an arc length can be
+    // found without searching the whole curve
+    const size_t nBuckets = _parameterSamples.size();
+    _lookupStep = _totalLength / static_cast<double>(nBuckets);
+    _sampleLookup.clear();
+    _sampleLookup.reserve(nBuckets + 1);
+    size_t sampleIndex = 0;
+    for (size_t i = 0; i <= nBuckets; i++) {
+        const double bucketStart = static_cast<double>(i) * _lookupStep;
+        while (sampleIndex + 1 < _parameterSamples.size() &&
+               _parameterSamples[sampleIndex + 1].s <= bucketStart)
+        {
+            sampleIndex++;
+        }
+        _sampleLookup.push_back(sampleIndex);
+    }
 }
 
-// Compute the curve parameter from an arc length value, using a combination of
-// Newton's method and bisection. Source:
-// https://www.geometrictools.com/Documentation/MovingAlongCurveSpecifiedSpeed.pdf
-// Input s is a length value, in the range [0, _totalLength]
-// Returns curve parameter in range [0, _nSegments]
+// Compute the curve parameter from an arc length value, using a cubic Hermite
+// interpolation between the precomputed samples that surround it. Input s is a length
+// value, in the range [0, _totalLength]. Returns curve parameter in range [0, _nSegments]
 double PathCurve::curveParameter(double s) const {
     if (s <= 0.0) return 0.0;
     if (s >= (_totalLength - LengthEpsilon)) return _curveParameterSteps.back();
 
-    unsigned int segmentIndex = 1;
-    while (s > _lengthSums[segmentIndex]) {
-        segmentIndex++;
-    }
-
-    const double segmentS = s - _lengthSums[segmentIndex - 1];
-    const double uMin = _curveParameterSteps[segmentIndex - 1];
-    const double uMax = _curveParameterSteps[segmentIndex];
-
-    // Find sample indices corresponding to the selected sample
-    auto findIndexOfFirstEqualOrLarger_u = [&samples = _parameterSamples](double value) {
-        auto it = std::lower_bound(
-            samples.begin(),
-            samples.end(),
-            ParameterPair{ value, 0.0 }, // 0.0 is a dummy value for s
-            [](const ParameterPair& lhs, const ParameterPair& rhs) {
-                return lhs.u < rhs.u;
-            }
-        );
-        return std::distance(samples.begin(), it);
-    };
-
-    size_t startIndex = findIndexOfFirstEqualOrLarger_u(uMin);
-    size_t endIndex = findIndexOfFirstEqualOrLarger_u(uMax);
-
-    // Use samples to find an initial guess for Newton's method
-    // Find first sample with s larger than input s
+    // The bucket that contains s limits the search to the few samples inside of it
+    const size_t bucket = std::min(
+        static_cast<size_t>(s / _lookupStep),
+        _sampleLookup.size() - 2
+    );
+    const size_t first = _sampleLookup[bucket];
+    const size_t last = std::min(_sampleLookup[bucket + 1] + 2, _parameterSamples.size());
     auto sampleIterator = std::upper_bound(
-        _parameterSamples.begin() + startIndex,
-        _parameterSamples.begin() + endIndex,
-        ParameterPair{ 0.0 , s }, // 0.0 is a dummy value for u
-        [](const ParameterPair& lhs, const ParameterPair& rhs) {
-            return lhs.s < rhs.s;
-        }
+        _parameterSamples.begin() + first,
+        _parameterSamples.begin() + last,
+        s,
+        [](double value, const ParameterPair& sample) { return value < sample.s; }
     );
 
     const ParameterPair& sample = *sampleIterator;
     const ParameterPair& prevSample = *(sampleIterator - 1);
-    const double uPrev = prevSample.u;
-    const double sPrev = prevSample.s;
-    const double slope = (sample.u - uPrev) / (sample.s - sPrev);
-    double u = uPrev + slope * (s - sPrev);
-
-    constexpr int maxIterations = 50;
-
-    // Initialize root bounding limits for bisection
-    double lower = uMin;
-    double upper = uMax;
-
-    for (int i = 0; i < maxIterations; ++i) {
-        double F = arcLength(uMin, u) - segmentS;
-
-        // The error we tolerate, in meters. Note that distances are very large
-        constexpr double tolerance = 0.5;
-        if (std::abs(F) <= tolerance) {
-            return u;
-        }
-
-        // Generate a candidate for Newton's method
-        double dfdu = approximatedDerivative(u); // > 0
-        double uCandidate = u - F / dfdu;
-
-        // Update root-bounding interval and test candidate
-        if (F > 0) {  // => candidate < u <= upper
-            upper = u;
-            u = (uCandidate <= lower) ? (upper + lower) / 2.0 : uCandidate;
-        }
-        else { // F < 0 => lower <= u < candidate
-            lower = u;
-            u = (uCandidate >= upper) ? (upper + lower) / 2.0 : uCandidate;
-        }
-    }
-
-    // No root was found based on the number of iterations and tolerance. However, it is
-    // safe to report the last computed u value, since it is within the segment interval
-    return u;
+    const double h = sample.s - prevSample.s;
+    const double t = (s - prevSample.s) / h;
+
+    // Limiting the derivatives to three times the secant keeps the interpolation
+    // monotone (Fritsch-Carlson), so that the camera never moves backwards
+    const double secant = (sample.u - prevSample.u) / h;
+    const double m0 = std::clamp(prevSample.dudS, 0.0, 3.0 * secant);
+    const double m1 = std::clamp(sample.dudS, 0.0, 3.0 * secant);
+
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    return (2.0 * t3 - 3.0 * t2 + 1.0) * prevSample.u +
+           (t3 - 2.0 * t2 + t) * h * m0 +
+           (-2.0 * t3 + 3.0 * t2) * sample.u +
+           (t3 - t2) * h * m1;
 }
 
 double PathCurve::approximatedDerivative(double u, double h) const {
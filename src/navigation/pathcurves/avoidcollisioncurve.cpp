@@ -36,6 +36,8 @@
 #include <ghoul/misc/exception.h>
 #include <glm/gtx/projection.hpp>
 #include <algorithm>
+#include <limits>
+#include <numeric>
 #include <vector>
 
 namespace {
@@ -47,13 +49,29 @@ namespace {
     constexpr int MaxAvoidCollisionSteps = 10;
 
     constexpr double Epsilon = 1e-5;
+
+    // The maximum number of obstacles in a leaf of the bounding sphere hierarchy
+    constexpr int MaxObstaclesPerLeaf = 4;
+
+    // Enlarges the world space bounding spheres to be safe from rounding errors, as the
+    // exact collision test is done in model coordinates
+    constexpr double WorldBoundsMargin = 1.01;
+
+    double distanceToSegment(const glm::dvec3& p, const glm::dvec3& a,
+                             const glm::dvec3& b)
+    {
+        const glm::dvec3 ab = b - a;
+        const double lengthSquared = glm::dot(ab, ab);
+        const double t = lengthSquared > 0.0 ?
+            std::clamp(glm::dot(p - a, ab) / lengthSquared, 0.0, 1.0) :
+            0.0;
+        return glm::distance(p, a + t * ab);
+    }
 } // namespace
 
 namespace openspace::interaction {
 
 AvoidCollisionCurve::AvoidCollisionCurve(const Waypoint& start, const Waypoint& end) {
-    _relevantNodes = global::navigationHandler->pathNavigator().relevantNodes();
-
     if (!start.node() || !end.node()) { // guard, but should never happen
         LERROR("Something went wrong. The start or end node does not exist");
         return;
@@ -125,11 +143,140 @@ AvoidCollisionCurve::AvoidCollisionCurve(const Waypoint& start, const Waypoint&
     _points.push_back(end.position());
 
     // Create extra points to avoid collision
+    buildObstacleHierarchy();
     removeCollisions();
 
     initializeParameterData();
 }
 
+void AvoidCollisionCurve::buildObstacleHierarchy() {
+    const PathNavigator& navigator = global::navigationHandler->pathNavigator();
+    const std::vector<SceneGraphNode*>& nodes = navigator.relevantNodes();
+    const double minValidBoundingSphere = navigator.minValidBoundingSphere();
+
+    // The transforms don't change while the curve is created, so they are only computed
+    // and inverted once per node rather than for every tested segment
+    _obstacles.clear();
+    _obstacles.reserve(nodes.size());
+    for (SceneGraphNode* node : nodes) {
+        Obstacle obstacle;
+        obstacle.node = node;
+        obstacle.modelTransform = node->modelTransform();
+        obstacle.inverseModelTransform = glm::inverse(obstacle.modelTransform);
+        // Sphere to check for collision. Make sure it does not have radius zero.
+        obstacle.radius = std::max(node->boundingSphere(), minValidBoundingSphere);
+        obstacle.center = glm::dvec3(obstacle.modelTransform[3]);
+        const double scale = std::max({
+            glm::length(glm::dvec3(obstacle.modelTransform[0])),
+            glm::length(glm::dvec3(obstacle.modelTransform[1])),
+            glm::length(glm::dvec3(obstacle.modelTransform[2]))
+        });
+        obstacle.worldRadius = WorldBoundsMargin * scale * obstacle.radius *
+            (1.0 + CollisionBufferSizeRadiusMultiplier);
+        _obstacles.push_back(obstacle);
+    }
+
+    _obstacleOrder.resize(_obstacles.size());
+    std::iota(_obstacleOrder.begin(), _obstacleOrder.end(), 0);
+    _obstacleHierarchy.clear();
+    if (!_obstacles.empty()) {
+        buildHierarchyNode(0, static_cast<int>(_obstacles.size()));
+    }
+}
+
+int AvoidCollisionCurve::buildHierarchyNode(int first, int count) {
+    const int index = static_cast<int>(_obstacleHierarchy.size());
+    _obstacleHierarchy.emplace_back();
+
+    glm::dvec3 minimum = glm::dvec3(std::numeric_limits<double>::max());
+    glm::dvec3 maximum = glm::dvec3(std::numeric_limits<double>::lowest());
+    for (int i = first; i < first + count; i++) {
+        const Obstacle& obstacle = _obstacles[_obstacleOrder[i]];
+        minimum = glm::min(minimum, obstacle.center);
+        maximum = glm::max(maximum, obstacle.center);
+    }
+
+    HierarchyNode node;
+    node.center = 0.5 * (minimum + maximum);
+    for (int i = first; i < first + count; i++) {
+        const Obstacle& obstacle = _obstacles[_obstacleOrder[i]];
+        node.radius = std::max(
+            node.radius,
+            glm::distance(node.center, obstacle.center) + obstacle.worldRadius
+        );
+    }
+
+    if (count <= MaxObstaclesPerLeaf) {
+        node.first = first;
+        node.count = count;
+        _obstacleHierarchy[index] = node;
+        return index;
+    }
+
+    // Split the obstacles at the median along the axis in which they are most spread out
+    const glm::dvec3 extent = maximum - minimum;
+    int axis = 0;
+    if (extent.y > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+        axis = 2;
+    }
+    const int half = count / 2;
+    std::vector<int>::iterator begin = _obstacleOrder.begin() + first;
+    std::nth_element(
+        begin,
+        begin + half,
+        begin + count,
+        [this, axis](int lhs, int rhs) {
+            return _obstacles[lhs].center[axis] < _obstacles[rhs].center[axis];
+        }
+    );
+
+    // The first child is placed directly after this node
+    buildHierarchyNode(first, half);
+    node.secondChild = buildHierarchyNode(first + half, count - half);
+    _obstacleHierarchy[index] = node;
+    return index;
+}
+
+std::vector<int> AvoidCollisionCurve::potentialObstacles(const glm::dvec3& p1,
+                                                         const glm::dvec3& p2) const
+{
+    std::vector<int> result;
+    if (_obstacleHierarchy.empty()) {
+        return result;
+    }
+
+    std::vector<int> stack = { 0 };
+    while (!stack.empty()) {
+        const int index = stack.back();
+        stack.pop_back();
+
+        const HierarchyNode& node = _obstacleHierarchy[index];
+        if (distanceToSegment(node.center, p1, p2) > node.radius) {
+            continue;
+        }
+
+        if (node.secondChild == -1) {
+            for (int i = node.first; i < node.first + node.count; i++) {
+                const Obstacle& obstacle = _obstacles[_obstacleOrder[i]];
+                if (distanceToSegment(obstacle.center, p1, p2) <= obstacle.worldRadius) {
+                    result.push_back(_obstacleOrder[i]);
+                }
+            }
+        }
+        else {
+            stack.push_back(index + 1);
+            stack.push_back(node.secondChild);
+        }
+    }
+
+    // The collisions are resolved in the order of the relevant nodes
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
 // Try to reduce the risk of collision by approximating the curve with linear segments.
 // If a collision happens, create a new point for the path to go through, in an attempt to
 // avoid that collision
@@ -147,17 +294,17 @@ void AvoidCollisionCurve::removeCollisions(int step) {
             continue; // Start and end position are the same. Go to next segment
         }
 
-        for (SceneGraphNode* node : _relevantNodes) {
-            // Do collision check in relative coordinates, to avoid huge numbers
-            const glm::dmat4 modelTransform = node->modelTransform();
-            glm::dvec3 p1 = glm::inverse(modelTransform) * glm::dvec4(lineStart, 1.0);
-            glm::dvec3 p2 = glm::inverse(modelTransform) * glm::dvec4(lineEnd, 1.0);
+        for (int obstacleIndex : potentialObstacles(lineStart, lineEnd)) {
+            const Obstacle& obstacle = _obstacles[obstacleIndex];
+            SceneGraphNode* node = obstacle.node;
 
-            // Sphere to check for collision. Make sure it does not have radius zero.
-            const double minValidBoundingSphere =
-                global::navigationHandler->pathNavigator().minValidBoundingSphere();
+            // Do collision check in relative coordinates, to avoid huge numbers
+            const glm::dmat4& modelTransform = obstacle.modelTransform;
+            const glm::dmat4& inverseTransform = obstacle.inverseModelTransform;
+            glm::dvec3 p1 = inverseTransform * glm::dvec4(lineStart, 1.0);
+            glm::dvec3 p2 = inverseTransform * glm::dvec4(lineEnd, 1.0);
 
-            double radius = std::max(node->boundingSphere(), minValidBoundingSphere);
+            double radius = obstacle.radius;
             glm::dvec3 center = glm::dvec3(0.0, 0.0, 0.0);
 
             // Add a buffer to avoid passing too close to the node.
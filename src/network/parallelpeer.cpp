@@ -39,11 +39,22 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/io/socket/tcpsocket.h>
 #include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <cmath>
 
 #include "parallelpeer_lua.inl"
 
 namespace {
     constexpr size_t MaxLatencyDiffs = 64;
+
+    // Number of standard deviations of the latency that the adaptive playout delay
+    // covers, and the rate (in seconds per second) at which the delay may change
+    constexpr double PlayoutDelayDeviations = 3.0;
+    constexpr double MaxPlayoutDelayRate = 0.1;
+    constexpr double MaxPlayoutDelay = 5.0;
+    // The number of received messages that can be queued before the receive thread has
+    // to wait for them to be handled
+    constexpr size_t ReceiveBufferSize = 1024;
     constexpr std::string_view _loggerCat = "ParallelPeer";
 
     constexpr openspace::properties::Property::PropertyInfo PasswordInfo = {
@@ -96,6 +107,16 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo AdaptiveBufferTimeInfo = {
+        "AdaptiveBufferTime",
+        "Adaptive Buffer Time",
+        "If this value is enabled, the buffer time follows the measured latency and its "
+        "variation, as well as the interval of the received camera keyframes, so that "
+        "the keyframes usually arrive before they are needed. The BufferTime is then "
+        "used as the smallest allowed buffer time",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo TimeKeyFrameInfo = {
         "TimeKeyframeInterval",
         "Time keyframe interval",
@@ -115,6 +136,15 @@ namespace {
         // @VISIBILITY(3.5)
         openspace::properties::Property::Visibility::AdvancedUser
     };
+
+    constexpr openspace::properties::Property::PropertyInfo CompactCameraKeyframesInfo = {
+        "CompactCameraKeyframes",
+        "Compact Camera Keyframes",
+        "If this value is enabled, the host sends most camera keyframes as quantized "
+        "deltas to the previous keyframe, which requires considerably less internet "
+        "bandwidth. All connected peers have to support this encoding",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
 } // namespace
 
 namespace openspace {
@@ -127,8 +157,11 @@ ParallelPeer::ParallelPeer()
     , _address(AddressInfo)
     , _name(NameInfo)
     , _bufferTime(BufferTimeInfo, 0.2f, 0.01f, 5.0f)
+    , _adaptiveBufferTime(AdaptiveBufferTimeInfo, true)
     , _timeKeyframeInterval(TimeKeyFrameInfo, 0.1f, 0.f, 1.f)
     , _cameraKeyframeInterval(CameraKeyFrameInfo, 0.1f, 0.f, 1.f)
+    , _compactCameraKeyframes(CompactCameraKeyframesInfo, true)
+    , _receiveBuffer(ReceiveBufferSize)
     , _connectionEvent(std::make_shared<ghoul::Event<>>())
     , _connection(nullptr)
 {
@@ -136,12 +169,15 @@ ParallelPeer::ParallelPeer()
     addProperty(_port);
     addProperty(_address);
     addProperty(_bufferTime);
+    addProperty(_adaptiveBufferTime);
 
     addProperty(_password);
     addProperty(_hostPassword);
 
     addProperty(_timeKeyframeInterval);
     addProperty(_cameraKeyframeInterval);
+    _compactCameraKeyframes.onChange([this]() { _forceFullCameraKeyframe = true; });
+    addProperty(_compactCameraKeyframes);
 }
 
 ParallelPeer::~ParallelPeer() {
@@ -247,8 +283,14 @@ void ParallelPeer::sendAuthentication() {
 }
 
 void ParallelPeer::queueInMessage(const ParallelConnection::Message& message) {
-    std::lock_guard unqlock(_receiveBufferMutex);
-    _receiveBuffer.push_back(message);
+    while (!_receiveBuffer.tryPush(message)) {
+        if (_shouldDisconnect) {
+            // The main thread is waiting for this thread to finish and will not consume
+            // any more messages, so the message is dropped
+            return;
+        }
+        std::this_thread::yield();
+    }
 }
 
 void ParallelPeer::handleMessage(const ParallelConnection::Message& message) {
@@ -280,11 +322,44 @@ void ParallelPeer::analyzeTimeDifference(double messageTimestamp) {
         _latencyDiffs.pop_front();
     }
     _latencyDiffs.push_back(latencyDiff);
+
+    // The playout delay has to cover the latency variation of most messages plus the
+    // wait for the next camera keyframe that is needed for the interpolation
+    double sum = 0.0;
+    double sumSquared = 0.0;
+    for (double diff : _latencyDiffs) {
+        sum += diff;
+        sumSquared += diff * diff;
+    }
+    const double n = static_cast<double>(_latencyDiffs.size());
+    const double mean = sum / n;
+    const double deviation = std::sqrt(std::max(sumSquared / n - mean * mean, 0.0));
+    _targetPlayoutDelay = std::clamp(
+        _cameraKeyframeSpacing + mean + PlayoutDelayDeviations * deviation,
+        static_cast<double>(_bufferTime),
+        MaxPlayoutDelay
+    );
 }
 
 double ParallelPeer::convertTimestamp(double messageTimestamp) {
     std::lock_guard latencyLock(_latencyMutex);
-    return messageTimestamp + _initialTimeDiff + _bufferTime;
+    const double delay =
+        _adaptiveBufferTime ? _playoutDelay : static_cast<double>(_bufferTime);
+    return messageTimestamp + _initialTimeDiff + delay;
+}
+
+void ParallelPeer::updatePlayoutDelay(double now) {
+    std::lock_guard latencyLock(_latencyMutex);
+    const double dt = std::max(now - _lastPlayoutDelayUpdate, 0.0);
+    _lastPlayoutDelayUpdate = now;
+    if (!_adaptiveBufferTime) {
+        _playoutDelay = _bufferTime;
+        return;
+    }
+    // Changing the delay shifts all following keyframes in time, so it is only allowed
+    // to change slowly to keep the motion smooth
+    const double maxStep = MaxPlayoutDelayRate * dt;
+    _playoutDelay += std::clamp(_targetPlayoutDelay - _playoutDelay, -maxStep, maxStep);
 }
 
 
@@ -322,8 +397,29 @@ void ParallelPeer::dataMessageReceived(const std::vector<char>& message) {
     std::vector<char> buffer(message.begin() + offset, message.end());
 
     switch (static_cast<datamessagestructures::Type>(type)) {
-        case datamessagestructures::Type::CameraData: {
-            datamessagestructures::CameraKeyframe kf(buffer);
+        case datamessagestructures::Type::CameraData:
+        case datamessagestructures::Type::CameraDataCompact: {
+            datamessagestructures::CameraKeyframe kf;
+            if (static_cast<datamessagestructures::Type>(type) ==
+                datamessagestructures::Type::CameraDataCompact)
+            {
+                // Delta keyframes are skipped until the first full keyframe arrived
+                if (!_cameraKeyframeDecoder.decode(buffer, kf)) {
+                    break;
+                }
+            }
+            else {
+                kf.deserialize(buffer);
+            }
+            if (_lastReceivedCameraTimestamp >= 0.0 &&
+                kf._timestamp > _lastReceivedCameraTimestamp)
+            {
+                const double spacing = kf._timestamp - _lastReceivedCameraTimestamp;
+                _cameraKeyframeSpacing = _cameraKeyframeSpacing > 0.0 ?
+                    0.9 * _cameraKeyframeSpacing + 0.1 * spacing :
+                    spacing;
+            }
+            _lastReceivedCameraTimestamp = kf._timestamp;
             const double convertedTimestamp = convertTimestamp(kf._timestamp);
 
             global::navigationHandler->keyframeNavigator().removeKeyframesAfter(
@@ -552,15 +648,15 @@ void ParallelPeer::resetTimeOffset() {
 void ParallelPeer::preSynchronization() {
     ZoneScoped;
 
-    std::unique_lock<std::mutex> unlock(_receiveBufferMutex);
-    while (!_receiveBuffer.empty()) {
-        ParallelConnection::Message& message = _receiveBuffer.front();
+    ParallelConnection::Message message;
+    while (_receiveBuffer.tryPop(message)) {
         handleMessage(message);
-        _receiveBuffer.pop_front();
     }
 
+    const double now = global::windowDelegate->applicationTime();
+    updatePlayoutDelay(now);
+
     if (isHost()) {
-        double now = global::windowDelegate->applicationTime();
 
         if (_lastCameraKeyframeTimestamp + _cameraKeyframeInterval < now) {
             sendCameraKeyframe();
@@ -585,6 +681,11 @@ void ParallelPeer::setStatus(ParallelConnection::Status status) {
         ParallelConnection::Status prevStatus = _status;
         _status = status;
         _timeJumped = true;
+        _cameraKeyframeEncoder.reset();
+        _cameraKeyframeDecoder.reset();
+        _forceFullCameraKeyframe = true;
+        _cameraKeyframeSpacing = 0.0;
+        _lastReceivedCameraTimestamp = -1.0;
         _connectionEvent->publish("statusChanged");
 
 
@@ -658,6 +759,8 @@ ParallelConnection::Status ParallelPeer::status() {
 void ParallelPeer::setNConnections(size_t nConnections) {
     if (_nConnections != nConnections) {
         _nConnections = nConnections;
+        // A client that just joined needs a full camera keyframe to decode the deltas
+        _forceFullCameraKeyframe = true;
         _connectionEvent->publish("nConnectionsChanged");
     }
 }
@@ -713,12 +816,20 @@ void ParallelPeer::sendCameraKeyframe() {
     std::vector<char> buffer;
 
     // Fill the keyframe buffer
-    kf.serialize(buffer);
+    datamessagestructures::Type type = datamessagestructures::Type::CameraData;
+    if (_compactCameraKeyframes) {
+        _cameraKeyframeEncoder.encode(kf, _forceFullCameraKeyframe, buffer);
+        _forceFullCameraKeyframe = false;
+        type = datamessagestructures::Type::CameraDataCompact;
+    }
+    else {
+        kf.serialize(buffer);
+    }
 
     const double timestamp = global::windowDelegate->applicationTime();
     // Send message
     _connection.sendDataMessage(ParallelConnection::DataMessage(
-        datamessagestructures::Type::CameraData,
+        type,
         timestamp,
         buffer
     ));
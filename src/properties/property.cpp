@@ -29,6 +29,7 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/lua/ghoul_lua.h>
 #include <ghoul/misc/dictionaryjsonformatter.h>
+#include <ghoul/misc/exception.h>
 #include <algorithm>
 
 namespace {
@@ -42,6 +43,12 @@ namespace {
     constexpr std::string_view TypeKey = "Type";
     constexpr std::string_view MetaDataKey = "MetaData";
     constexpr std::string_view AdditionalDataKey = "AdditionalData";
+
+    // The nesting depth of change notification batches on this thread and the
+    // Propertys whose onChange callbacks were deferred by them. Entries of Propertys
+    // that are destroyed before the batch ends are set to nullptr
+    thread_local int BatchDepth = 0;
+    thread_local std::vector<openspace::properties::Property*> DeferredNotifications;
 } // namespace
 
 namespace openspace::properties {
@@ -68,7 +75,22 @@ Property::Property(PropertyInfo info)
 }
 
 Property::~Property() {
+    if (_hasDeferredNotification) {
+        auto it = std::find(
+            DeferredNotifications.begin(),
+            DeferredNotifications.end(),
+            this
+        );
+        if (it != DeferredNotifications.end()) {
+            *it = nullptr;
+        }
+    }
     notifyDeleteListeners();
+
+    // Remove this Property from the URI index of its owner's tree
+    if (_owner) {
+        _owner->removeProperty(this);
+    }
 }
 
 const std::string& Property::identifier() const {
@@ -241,11 +263,64 @@ void Property::setPropertyOwner(PropertyOwner* owner) {
 }
 
 void Property::notifyChangeListeners() {
+    if (BatchDepth > 0) {
+        if (!_hasDeferredNotification) {
+            _hasDeferredNotification = true;
+            DeferredNotifications.push_back(this);
+        }
+        return;
+    }
+
     for (const std::pair<OnChangeHandle, std::function<void()>>& p : _onChangeCallbacks) {
         p.second();
     }
 }
 
+void Property::beginChangeNotificationBatch() {
+    BatchDepth++;
+}
+
+void Property::endChangeNotificationBatch() {
+    ghoul_precondition(BatchDepth > 0, "A batch must have been opened");
+
+    BatchDepth--;
+    if (BatchDepth == 0) {
+        invokeDeferredChangeListeners();
+    }
+}
+
+bool Property::isBatchingChangeNotifications() {
+    return BatchDepth > 0;
+}
+
+int Property::flushChangeNotificationBatches() {
+    const int nOpenBatches = BatchDepth;
+    BatchDepth = 0;
+    invokeDeferredChangeListeners();
+    return nOpenBatches;
+}
+
+void Property::invokeDeferredChangeListeners() {
+    // With the batch closed, changes made by the callbacks are notified immediately, so
+    // the list does not grow while we are iterating it. It can only have entries
+    // replaced by nullptr if a callback destroys a Property that is still waiting
+    for (size_t i = 0; i < DeferredNotifications.size(); i++) {
+        Property* prop = DeferredNotifications[i];
+        if (prop) {
+            prop->_hasDeferredNotification = false;
+            // A failing callback must not keep the remaining Propertys waiting, and
+            // this function is called when closing a batch during stack unwinding
+            try {
+                prop->notifyChangeListeners();
+            }
+            catch (const ghoul::RuntimeError& e) {
+                LERRORC(e.component, e.message);
+            }
+        }
+    }
+    DeferredNotifications.clear();
+}
+
 void Property::notifyDeleteListeners() {
     for (const std::pair<OnDeleteHandle, std::function<void()>>& p : _onDeleteCallbacks) {
         p.second();
@@ -36,11 +36,19 @@
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/invariants.h>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <numeric>
 
 namespace {
     constexpr std::string_view _loggerCat = "PropertyOwner";
 
+    // Scene graph nodes are initialized on worker threads while they are already part of
+    // the scene, so additions to the shared URI index of a tree have to be serialized
+    std::mutex UriIndexMutex;
+
+    std::atomic<uint64_t> TreeVersion = 0;
+
     nlohmann::json createJson(openspace::properties::PropertyOwner* owner) {
         ZoneScoped;
 
@@ -97,8 +105,19 @@ PropertyOwner::PropertyOwner(PropertyOwnerInfo info)
 }
 
 PropertyOwner::~PropertyOwner() {
-    _properties.clear();
-    _subOwners.clear();
+    // Propertys and sub-owners that are destroyed before us remove themselves, so all
+    // remaining ones are still alive. Detaching them, and ourselves from our owner,
+    // ensures that no URI index keeps a pointer to us or to one of our Propertys and
+    // that nobody is left with a dangling pointer to us as their owner
+    if (_owner) {
+        _owner->removePropertySubOwner(this);
+    }
+    while (!_properties.empty()) {
+        removeProperty(_properties.back());
+    }
+    while (!_subOwners.empty()) {
+        removePropertySubOwner(_subOwners.back());
+    }
 }
 
 const std::vector<Property*>& PropertyOwner::properties() const {
@@ -116,32 +135,43 @@ std::vector<Property*> PropertyOwner::propertiesRecursive() const {
     return props;
 }
 
-Property* PropertyOwner::property(const std::string& uri) const {
+Property* PropertyOwner::property(std::string_view uri) const {
+    if (!_owner) {
+        // As the root of the tree, all of the Propertys are in our index
+        std::lock_guard lock(UriIndexMutex);
+        auto it = _uriIndex.find(uri);
+        return it != _uriIndex.end() ? it->second : nullptr;
+    }
+
     auto it = std::find_if(
         _properties.begin(),
         _properties.end(),
         [&uri](Property* prop) { return prop->identifier() == uri; }
     );
 
-    if (it == _properties.end() || (*it)->identifier() != uri) {
+    if (it == _properties.end()) {
         // if we do not own the searched property, it must consist of a concatenated
         // name and we can delegate it to a subowner
         const size_t ownerSeparator = uri.find(URISeparator);
-        if (ownerSeparator == std::string::npos) {
+        if (ownerSeparator == std::string_view::npos) {
             // if we do not own the property and there is no separator, it does not exist
             return nullptr;
         }
         else {
-            const std::string ownerName = uri.substr(0, ownerSeparator);
-            const std::string propertyName = uri.substr(ownerSeparator + 1);
-
-            PropertyOwner* owner = propertySubOwner(ownerName);
-            if (!owner) {
+            const std::string_view ownerName = uri.substr(0, ownerSeparator);
+            const std::string_view propertyName = uri.substr(ownerSeparator + 1);
+
+            auto owner = std::find_if(
+                _subOwners.begin(),
+                _subOwners.end(),
+                [ownerName](PropertyOwner* o) { return o->identifier() == ownerName; }
+            );
+            if (owner == _subOwners.end()) {
                 return nullptr;
             }
             else {
                 // Recurse into the subOwner
-                return owner->property(propertyName);
+                return (*owner)->property(propertyName);
             }
         }
     }
@@ -237,6 +267,9 @@ void PropertyOwner::addProperty(Property* prop) {
         else {
             _properties.push_back(prop);
             prop->setPropertyOwner(this);
+            std::lock_guard lock(UriIndexMutex);
+            TreeVersion++;
+            rootOwner()->_uriIndex.emplace(uriPrefix() + prop->identifier(), prop);
         }
     }
 }
@@ -282,6 +315,16 @@ void PropertyOwner::addPropertySubOwner(openspace::properties::PropertyOwner* ow
         else {
             _subOwners.push_back(owner);
             owner->setPropertyOwner(this);
+
+            // The new subtree was its own root so far, its index moves to our root
+            const std::string prefix = uriPrefix() + owner->identifier() + URISeparator;
+            std::lock_guard lock(UriIndexMutex);
+            TreeVersion++;
+            UriIndex& index = rootOwner()->_uriIndex;
+            for (const std::pair<const std::string, Property*>& p : owner->_uriIndex) {
+                index.emplace(prefix + p.first, p.second);
+            }
+            owner->_uriIndex.clear();
         }
     }
 }
@@ -302,6 +345,13 @@ void PropertyOwner::removeProperty(Property* prop) {
 
     // If we found the property identifier, we can delete it
     if (it != _properties.end() && (*it)->identifier() == prop->identifier()) {
+        std::lock_guard lock(UriIndexMutex);
+        TreeVersion++;
+        UriIndex& index = rootOwner()->_uriIndex;
+        auto jt = index.find(uriPrefix() + (*it)->identifier());
+        if (jt != index.end() && jt->second == *it) {
+            index.erase(jt);
+        }
         (*it)->setPropertyOwner(nullptr);
         _properties.erase(it);
     }
@@ -330,6 +380,13 @@ void PropertyOwner::removePropertySubOwner(openspace::properties::PropertyOwner*
 
     // If we found the propertyowner, we can delete it
     if (it != _subOwners.end() && (*it)->identifier() == owner->identifier()) {
+        // The removed subtree becomes its own root and takes its Propertys along
+        const std::string prefix = uriPrefix() + (*it)->identifier() + URISeparator;
+        std::lock_guard lock(UriIndexMutex);
+        TreeVersion++;
+        (*it)->removeFromUriIndex(rootOwner()->_uriIndex, prefix);
+        (*it)->setPropertyOwner(nullptr);
+        (*it)->addToUriIndex((*it)->_uriIndex, "");
         _subOwners.erase(it);
     }
     else {
@@ -347,7 +404,20 @@ void PropertyOwner::setIdentifier(std::string identifier) {
     if (identifier.find_first_of(". \t\n") != std::string::npos) {
         throw ghoul::RuntimeError("Identifier must not contain any dots or whitespaces");
     }
-    _identifier = std::move(identifier);
+
+    if (_owner) {
+        // Our identifier is part of the URIs of all Propertys below us in the index
+        std::lock_guard lock(UriIndexMutex);
+        TreeVersion++;
+        UriIndex& index = rootOwner()->_uriIndex;
+        const std::string parentPrefix = _owner->uriPrefix();
+        removeFromUriIndex(index, parentPrefix + _identifier + URISeparator);
+        _identifier = std::move(identifier);
+        addToUriIndex(index, parentPrefix + _identifier + URISeparator);
+    }
+    else {
+        _identifier = std::move(identifier);
+    }
 }
 
 const std::string& PropertyOwner::identifier() const {
@@ -380,10 +450,66 @@ const std::vector<std::string>& PropertyOwner::tags() const {
 
 void PropertyOwner::addTag(std::string tag) {
     _tags.push_back(std::move(tag));
+    TreeVersion++;
 }
 
 void PropertyOwner::removeTag(const std::string& tag) {
     _tags.erase(std::remove(_tags.begin(), _tags.end(), tag), _tags.end());
+    TreeVersion++;
+}
+
+void PropertyOwner::forEachProperty(
+                  const std::function<void(std::string_view, Property*)>& function) const
+{
+    ghoul_precondition(_owner == nullptr, "PropertyOwner must be the root of its tree");
+
+    std::lock_guard lock(UriIndexMutex);
+    for (const std::pair<const std::string, Property*>& p : _uriIndex) {
+        function(p.first, p.second);
+    }
+}
+
+uint64_t PropertyOwner::treeVersion() {
+    return TreeVersion;
+}
+
+PropertyOwner* PropertyOwner::rootOwner() {
+    PropertyOwner* root = this;
+    while (root->_owner) {
+        root = root->_owner;
+    }
+    return root;
+}
+
+std::string PropertyOwner::uriPrefix() const {
+    std::string prefix;
+    for (const PropertyOwner* o = this; o->_owner; o = o->_owner) {
+        prefix.insert(0, o->_identifier + URISeparator);
+    }
+    return prefix;
+}
+
+void PropertyOwner::addToUriIndex(UriIndex& index, const std::string& prefix) const {
+    for (Property* prop : _properties) {
+        index.emplace(prefix + prop->identifier(), prop);
+    }
+    for (const PropertyOwner* owner : _subOwners) {
+        owner->addToUriIndex(index, prefix + owner->identifier() + URISeparator);
+    }
+}
+
+void PropertyOwner::removeFromUriIndex(UriIndex& index,
+                                       const std::string& prefix) const
+{
+    for (Property* prop : _properties) {
+        auto it = index.find(prefix + prop->identifier());
+        if (it != index.end() && it->second == prop) {
+            index.erase(it);
+        }
+    }
+    for (const PropertyOwner* owner : _subOwners) {
+        owner->removeFromUriIndex(index, prefix + owner->identifier() + URISeparator);
+    }
 }
 
 nlohmann::json PropertyOwner::generateJson() const {
@@ -27,7 +27,9 @@
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
+#include <ghoul/font/font.h>
 #include <ghoul/font/fontmanager.h>
+#include <ghoul/font/fontrenderer.h>
 #include <optional>
 
 namespace {
@@ -87,4 +89,9 @@ DashboardTextItem::DashboardTextItem(const ghoul::Dictionary& dictionary, float
     _font = global::fontManager->font(_fontName, _fontSize);
 }
 
+void DashboardTextItem::renderText(glm::vec2& penPosition) const {
+    RenderFont(*_font, penPosition, _text);
+    penPosition.y -= _font->height();
+}
+
 } // namespace openspace
@@ -0,0 +1,148 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/eclipseshadow.h>
+
+#include <openspace/engine/globals.h>
+#include <openspace/rendering/renderengine.h>
+#include <openspace/scene/scene.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <openspace/util/spicemanager.h>
+#include <ghoul/glm.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace {
+    constexpr double KmToM = 1000.0;
+
+    struct CacheEntry {
+        std::string source;
+        double sourceRadius = 0.0;
+        std::string caster;
+        double casterRadius = 0.0;
+        std::optional<openspace::EclipseShadow> shadow;
+    };
+
+    // The shadows of the current frame. Node scales can change without the time
+    // changing, so the cache is invalidated by both the frame number and the time
+    struct {
+        std::vector<CacheEntry> entries;
+        uint64_t frameNumber = std::numeric_limits<uint64_t>::max();
+        double time = std::numeric_limits<double>::quiet_NaN();
+    } Cache;
+
+    glm::dvec3 galacticPosition(const std::string& target, double time) {
+        double lt = 0.0;
+        const glm::dvec3 p = openspace::SpiceManager::ref().targetPosition(
+            target,
+            "SSB",
+            "GALACTIC",
+            {},
+            time,
+            lt
+        );
+        return p * KmToM;
+    }
+} // namespace
+
+namespace openspace {
+
+bool EclipseShadow::isShadowing(const glm::dvec3& position, double radius) const {
+    const glm::dvec3 receiverCasterVec = casterPosition - position;
+    const double scLength = glm::length(sourceCasterVec);
+    const glm::dvec3 receiverCasterProj =
+        (glm::dot(receiverCasterVec, sourceCasterVec) / (scLength * scLength)) *
+        sourceCasterVec;
+
+    const double dist = glm::length(receiverCasterVec - receiverCasterProj);
+    const double penumbraRadius =
+        radiusCaster * (glm::length(receiverCasterProj) + penumbra) / penumbra;
+
+    const double casterDistSun = glm::length(casterPosition - sunPosition);
+    const double receiverDistSun = glm::length(position - sunPosition);
+    return (dist - penumbraRadius) < radius && casterDistSun < receiverDistSun;
+}
+
+std::optional<EclipseShadow> eclipseShadow(const std::string& source, double sourceRadius,
+                                           const std::string& caster, double casterRadius,
+                                           double j2000Seconds)
+{
+    ZoneScoped;
+
+    const uint64_t frameNumber = global::renderEngine->frameNumber();
+    if (frameNumber != Cache.frameNumber || j2000Seconds != Cache.time) {
+        Cache.entries.clear();
+        Cache.frameNumber = frameNumber;
+        Cache.time = j2000Seconds;
+    }
+
+    auto it = std::find_if(
+        Cache.entries.begin(),
+        Cache.entries.end(),
+        [&](const CacheEntry& e) {
+            return e.source == source && e.caster == caster &&
+                e.sourceRadius == sourceRadius && e.casterRadius == casterRadius;
+        }
+    );
+    if (it != Cache.entries.end()) {
+        return it->shadow;
+    }
+
+    CacheEntry entry = {
+        .source = source,
+        .sourceRadius = sourceRadius,
+        .caster = caster,
+        .casterRadius = casterRadius
+    };
+
+    const Scene* scene = global::renderEngine->scene();
+    const SceneGraphNode* sourceNode = scene ? scene->sceneGraphNode(source) : nullptr;
+    const SceneGraphNode* casterNode = scene ? scene->sceneGraphNode(caster) : nullptr;
+    if (sourceNode && casterNode) {
+        const double sourceScale = std::max(glm::compMax(sourceNode->scale()), 1.0);
+        const double casterScale = std::max(glm::compMax(casterNode->scale()), 1.0);
+
+        EclipseShadow shadow;
+        shadow.casterPosition = galacticPosition(caster, j2000Seconds);
+        shadow.sourceCasterVec =
+            shadow.casterPosition - galacticPosition(source, j2000Seconds);
+        shadow.sunPosition = galacticPosition("SUN", j2000Seconds);
+        shadow.radiusSource = sourceRadius * sourceScale;
+        shadow.radiusCaster = casterRadius * casterScale;
+
+        const double scLength = glm::length(shadow.sourceCasterVec);
+        shadow.penumbra = shadow.radiusCaster * scLength /
+            (shadow.radiusSource + shadow.radiusCaster);
+        shadow.umbra = shadow.radiusCaster * scLength /
+            (shadow.radiusSource - shadow.radiusCaster);
+        entry.shadow = shadow;
+    }
+
+    Cache.entries.push_back(std::move(entry));
+    return Cache.entries.back().shadow;
+}
+
+} // namespace openspace
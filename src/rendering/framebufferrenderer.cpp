@@ -34,6 +34,8 @@
 #include <openspace/rendering/renderengine.h>
 #include <openspace/rendering/volumeraycaster.h>
 #include <openspace/scene/scene.h>
+#include <openspace/util/frameprofiler.h>
+#include <openspace/util/memorymanager.h>
 #include <openspace/util/timemanager.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -43,8 +45,13 @@
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/textureunit.h>
+#include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <memory_resource>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -83,10 +90,249 @@ namespace {
        GL_COLOR_ATTACHMENT2,
        GL_COLOR_ATTACHMENT3
     };
+
+    constexpr openspace::properties::Property::PropertyInfo MeasureGpuTimesInfo = {
+        "MeasureGpuTimes",
+        "Measure GPU Times",
+        "If this value is enabled, the time that the GPU spends in each of the stages of "
+        "the rendering is measured and reported in the GpuTimes properties. The values "
+        "are delayed by one frame",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo GBufferTimeInfo = {
+        "GBuffer",
+        "G-Buffer (ms)",
+        "The GPU time spent rendering the Background, Opaque, and "
+        "PreDeferredTransparent render bins into the G-buffer",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo RaycasterTimeInfo = {
+        "Raycasters",
+        "Raycasters (ms)",
+        "The GPU time spent performing all raycaster tasks, including the downscaled "
+        "volume rendering",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo DownscaledVolumeTimeInfo = {
+        "DownscaledVolume",
+        "Downscaled Volume (ms)",
+        "The GPU time spent writing the downscaled volume rendering of the last "
+        "raycaster that uses a downscaled resolution back into the full-resolution buffer",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo DeferredcasterTimeInfo = {
+        "Deferredcasters",
+        "Deferredcasters (ms)",
+        "The GPU time spent performing all deferred caster tasks, such as atmospheres",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo TmoTimeInfo = {
+        "TMO",
+        "Tone Mapping (ms)",
+        "The GPU time spent applying the HDR tone mapping operator",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FxaaTimeInfo = {
+        "FXAA",
+        "FXAA (ms)",
+        "The GPU time spent applying the fast approximate anti-aliasing",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo AdaptiveRaycastingInfo = {
+        "Enabled",
+        "Enabled",
+        "If this value is enabled, the step size and the resolution of all raycasters "
+        "are adjusted every frame to keep the GPU time spent on raycasting below the "
+        "target time while the camera is moving. When the camera stops, the quality is "
+        "ramped back up to the values that are specified by the raycasters",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo TargetRaycastTimeInfo = {
+        "TargetTime",
+        "Target Time (ms)",
+        "The GPU time in milliseconds that all raycasters together should not exceed "
+        "while the camera is moving",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo MinimumRaycastQualityInfo =
+    {
+        "MinimumQuality",
+        "Minimum Quality",
+        "The lowest quality that the raycasters are reduced to, as a fraction of the "
+        "full quality. A quality of 0.25 means that only about a quarter of the samples "
+        "are taken",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo RaycastQualityInfo = {
+        "Quality",
+        "Current Quality",
+        "The quality of the raycasters in the current frame as a fraction of the full "
+        "quality",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo VariableRateShadingInfo = {
+        "Enabled",
+        "Enabled",
+        "If this value is enabled and the graphics card supports "
+        "GL_NV_shading_rate_image, the periphery of the rendering is shaded at a reduced "
+        "rate. Parts of the image close to the focus direction are shaded for every "
+        "pixel, parts within the half rate angle once for every 2x2 pixels, and "
+        "everything else once for every 4x4 pixels",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FullRateAngleInfo = {
+        "FullRateAngle",
+        "Full Rate Angle",
+        "The angle in degrees around the focus direction within which every pixel is "
+        "shaded",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo HalfRateAngleInfo = {
+        "HalfRateAngle",
+        "Half Rate Angle",
+        "The angle in degrees around the focus direction within which the image is "
+        "shaded once for every 2x2 pixels. Beyond this angle, the image is shaded once "
+        "for every 4x4 pixels",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FocusDirectionInfo = {
+        "FocusDirection",
+        "Focus Direction",
+        "The direction around which the image is shaded at the full rate, given in the "
+        "coordinate system of the display. For a flat screen, (0, 0, -1) is the center "
+        "of the screen; for a fisheye dome it should point at the sweet spot of the "
+        "dome. This value is ignored if the display system provides a gaze direction",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr std::string_view ShadingRateImageExtension = "GL_NV_shading_rate_image";
+
+    // The shading rates that the values in the shading rate image refer to
+    constexpr std::array<GLenum, 3> ShadingRatePalette = {
+        GL_SHADING_RATE_1_INVOCATION_PER_PIXEL_NV,
+        GL_SHADING_RATE_1_INVOCATION_PER_2X2_PIXELS_NV,
+        GL_SHADING_RATE_1_INVOCATION_PER_4X4_PIXELS_NV
+    };
+
+    // The fraction of the full quality that is regained each frame after the camera has
+    // stopped moving
+    constexpr float RaycastQualityRampUp = 0.1f;
+
+    // The downscale factors are rounded to multiples of this value to avoid recreating
+    // the downscaled textures for every small change in quality
+    constexpr float DownscaleQuantization = 0.125f;
+
+    // Converts screen-space bounds in normalized device coordinates into the pixel
+    // rectangle (x0, y0, x1, y1) in the viewport that fully covers them, grown by
+    // padding pixels on each side. The rectangle is empty if x0 >= x1 or y0 >= y1
+    glm::ivec4 scissorRectangle(const glm::vec4& bounds, const glm::ivec4& viewport,
+                                int padding = 0)
+    {
+        if (bounds.x >= bounds.z || bounds.y >= bounds.w) {
+            return glm::ivec4(0);
+        }
+
+        const glm::vec4 b = bounds * 0.5f + 0.5f;
+        const int x0 = static_cast<int>(std::floor(b.x * viewport.z)) - padding;
+        const int y0 = static_cast<int>(std::floor(b.y * viewport.w)) - padding;
+        const int x1 = static_cast<int>(std::ceil(b.z * viewport.z)) + padding;
+        const int y1 = static_cast<int>(std::ceil(b.w * viewport.w)) + padding;
+        return glm::ivec4(
+            viewport.x + std::clamp(x0, 0, viewport.z),
+            viewport.y + std::clamp(y0, 0, viewport.w),
+            viewport.x + std::clamp(x1, 0, viewport.z),
+            viewport.y + std::clamp(y1, 0, viewport.w)
+        );
+    }
+
+    bool isEmpty(const glm::ivec4& rect) {
+        return rect.x >= rect.z || rect.y >= rect.w;
+    }
+
+    void setScissor(const glm::ivec4& rect) {
+        glScissor(rect.x, rect.y, rect.z - rect.x, rect.w - rect.y);
+    }
 } // namespace
 
 namespace openspace {
 
+FramebufferRenderer::FramebufferRenderer()
+    : properties::PropertyOwner({ "Renderer", "Renderer" })
+    , _measureGpuTimes(MeasureGpuTimesInfo, false)
+    , _gpuTimes({ "GpuTimes", "GPU Times" })
+    , _gBufferTime(GBufferTimeInfo, 0.f, 0.f, 1000.f)
+    , _raycasterTime(RaycasterTimeInfo, 0.f, 0.f, 1000.f)
+    , _downscaledVolumeTime(DownscaledVolumeTimeInfo, 0.f, 0.f, 1000.f)
+    , _deferredcasterTime(DeferredcasterTimeInfo, 0.f, 0.f, 1000.f)
+    , _tmoTime(TmoTimeInfo, 0.f, 0.f, 1000.f)
+    , _fxaaTime(FxaaTimeInfo, 0.f, 0.f, 1000.f)
+    , _adaptiveRaycasting({ "AdaptiveRaycasting", "Adaptive Raycasting" })
+    , _adaptiveRaycastingEnabled(AdaptiveRaycastingInfo, false)
+    , _targetRaycastTime(TargetRaycastTimeInfo, 8.f, 1.f, 100.f)
+    , _minimumRaycastQuality(MinimumRaycastQualityInfo, 0.25f, 0.05f, 1.f)
+    , _raycastQuality(RaycastQualityInfo, 1.f, 0.f, 1.f)
+    , _variableRateShading({ "VariableRateShading", "Variable Rate Shading" })
+    , _variableRateShadingEnabled(VariableRateShadingInfo, false)
+    , _fullRateAngle(FullRateAngleInfo, 30.f, 0.f, 180.f)
+    , _halfRateAngle(HalfRateAngleInfo, 60.f, 0.f, 180.f)
+    , _focusDirection(
+        FocusDirectionInfo,
+        glm::vec3(0.f, 0.f, -1.f),
+        glm::vec3(-1.f),
+        glm::vec3(1.f)
+    )
+{
+    addProperty(_measureGpuTimes);
+
+    for (properties::FloatProperty* p : { &_gBufferTime, &_raycasterTime,
+        &_downscaledVolumeTime, &_deferredcasterTime, &_tmoTime, &_fxaaTime })
+    {
+        p->setReadOnly(true);
+        _gpuTimes.addProperty(p);
+    }
+    addPropertySubOwner(_gpuTimes);
+
+    _adaptiveRaycasting.addProperty(_adaptiveRaycastingEnabled);
+    _adaptiveRaycasting.addProperty(_targetRaycastTime);
+    _adaptiveRaycasting.addProperty(_minimumRaycastQuality);
+    _raycastQuality.setReadOnly(true);
+    _adaptiveRaycasting.addProperty(_raycastQuality);
+    addPropertySubOwner(_adaptiveRaycasting);
+
+    _variableRateShadingEnabled.onChange([this]() {
+        using namespace ghoul::systemcapabilities;
+        const bool isSupported = OpenGLCap.isExtensionSupported(
+            std::string(ShadingRateImageExtension)
+        );
+        if (_variableRateShadingEnabled && !isSupported) {
+            LWARNING(fmt::format(
+                "Variable rate shading is not available as {} is not supported",
+                ShadingRateImageExtension
+            ));
+            _variableRateShadingEnabled = false;
+        }
+    });
+    _variableRateShading.addProperty(_variableRateShadingEnabled);
+    _variableRateShading.addProperty(_fullRateAngle);
+    _variableRateShading.addProperty(_halfRateAngle);
+    _variableRateShading.addProperty(_focusDirection);
+    addPropertySubOwner(_variableRateShading);
+}
+
 //============================//
 //=====  Reuse textures  =====//
 //============================//
@@ -140,6 +386,13 @@ void FramebufferRenderer::initialize() {
 
     LDEBUG("Initializing FramebufferRenderer");
 
+    for (std::array<GLuint, 2 * NGpuStages>& queries : _gpuTimer.queries) {
+        glGenQueries(static_cast<GLsizei>(queries.size()), queries.data());
+    }
+    for (std::array<bool, NGpuStages>& isIssued : _gpuTimer.isIssued) {
+        isIssued.fill(false);
+    }
+
     const GLfloat vertexData[] = {
         // x     y
         -1.f, -1.f,
@@ -420,10 +673,15 @@ void FramebufferRenderer::deinitialize() {
 
     glDeleteTextures(1, &_exitColorTexture);
     glDeleteTextures(1, &_exitDepthTexture);
+    glDeleteTextures(1, &_shadingRateImage.texture);
 
     glDeleteBuffers(1, &_vertexPositionBuffer);
     glDeleteVertexArrays(1, &_screenQuad);
 
+    for (std::array<GLuint, 2 * NGpuStages>& queries : _gpuTimer.queries) {
+        glDeleteQueries(static_cast<GLsizei>(queries.size()), queries.data());
+    }
+
     global::raycasterManager->removeListener(*this);
     global::deferredcasterManager->removeListener(*this);
 }
@@ -440,6 +698,187 @@ void FramebufferRenderer::deferredcastersChanged(Deferredcaster&,
     _dirtyDeferredcastData = true;
 }
 
+bool FramebufferRenderer::isMeasuringGpuTimes() const {
+    // The adaptive raycasting relies on the raycaster times, so they are measured even
+    // if the user has not requested them
+    return _measureGpuTimes || _adaptiveRaycastingEnabled;
+}
+
+void FramebufferRenderer::beginGpuStage(GpuStage stage) {
+    if (!isMeasuringGpuTimes()) {
+        return;
+    }
+
+    const int i = static_cast<int>(stage);
+    glQueryCounter(_gpuTimer.queries[_gpuTimer.current][2 * i], GL_TIMESTAMP);
+}
+
+void FramebufferRenderer::endGpuStage(GpuStage stage) {
+    if (!isMeasuringGpuTimes()) {
+        return;
+    }
+
+    const int i = static_cast<int>(stage);
+    glQueryCounter(_gpuTimer.queries[_gpuTimer.current][2 * i + 1], GL_TIMESTAMP);
+    _gpuTimer.isIssued[_gpuTimer.current][i] = true;
+}
+
+void FramebufferRenderer::collectGpuTimes() {
+    if (!isMeasuringGpuTimes()) {
+        return;
+    }
+
+    // Switch to the set of queries that was issued in the previous frame
+    _gpuTimer.current = 1 - _gpuTimer.current;
+    const std::array<GLuint, 2 * NGpuStages>& queries =
+        _gpuTimer.queries[_gpuTimer.current];
+    std::array<bool, NGpuStages>& isIssued = _gpuTimer.isIssued[_gpuTimer.current];
+
+    const std::array<properties::FloatProperty*, NGpuStages> properties = {
+        &_gBufferTime, &_raycasterTime, &_downscaledVolumeTime, &_deferredcasterTime,
+        &_tmoTime, &_fxaaTime
+    };
+    for (int i = 0; i < NGpuStages; i++) {
+        if (!isIssued[i]) {
+            continue;
+        }
+        isIssued[i] = false;
+
+        // If the GPU is still busy with the previous frame we skip this value rather
+        // than waiting for it
+        GLint isAvailable = GL_FALSE;
+        glGetQueryObjectiv(queries[2 * i + 1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (!isAvailable) {
+            continue;
+        }
+
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(queries[2 * i], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(queries[2 * i + 1], GL_QUERY_RESULT, &end);
+        *properties[i] = static_cast<float>(end > begin ? end - begin : 0) / 1e6f;
+    }
+}
+
+void FramebufferRenderer::updateAdaptiveRaycasting(const Camera& camera) {
+    if (!_adaptiveRaycastingEnabled) {
+        _raycastQuality = 1.f;
+        return;
+    }
+
+    const glm::dmat4 viewMatrix = camera.combinedViewMatrix();
+    const bool isMoving = viewMatrix != _previousViewMatrix;
+    _previousViewMatrix = viewMatrix;
+
+    float quality = _raycastQuality;
+    const float time = _raycasterTime;
+    if (isMoving && time > 0.f) {
+        // The cost of the raycasting is roughly proportional to the number of samples,
+        // so scaling the quality by the ratio gets us close to the target. Increases are
+        // limited to avoid oscillating around the target
+        quality *= std::clamp(_targetRaycastTime / time, 0.5f, 1.1f);
+    }
+    else if (!isMoving) {
+        quality += RaycastQualityRampUp;
+    }
+    _raycastQuality = std::clamp(quality, _minimumRaycastQuality.value(), 1.f);
+}
+
+void FramebufferRenderer::updateShadingRateImage(const Camera& camera,
+                                                 const glm::ivec4& viewport)
+{
+    ZoneScoped;
+
+    if (_shadingRateImage.texture == 0) {
+        GLint width = 0;
+        GLint height = 0;
+        glGetIntegerv(GL_SHADING_RATE_IMAGE_TEXEL_WIDTH_NV, &width);
+        glGetIntegerv(GL_SHADING_RATE_IMAGE_TEXEL_HEIGHT_NV, &height);
+        _shadingRateImage.texelSize = glm::max(glm::ivec2(width, height), 1);
+    }
+
+    const glm::ivec2 texelSize = _shadingRateImage.texelSize;
+    const glm::ivec2 size = (_resolution + texelSize - 1) / texelSize;
+    if (size != _shadingRateImage.size) {
+        // The shading rate image needs immutable storage, so it has to be recreated
+        glDeleteTextures(1, &_shadingRateImage.texture);
+        glGenTextures(1, &_shadingRateImage.texture);
+        glBindTexture(GL_TEXTURE_2D, _shadingRateImage.texture);
+        glTexStorage2D(GL_TEXTURE_2D, 1, GL_R8UI, size.x, size.y);
+        if (glbinding::Binding::ObjectLabel.isResolved()) {
+            glObjectLabel(GL_TEXTURE, _shadingRateImage.texture, -1, "Shading Rate");
+        }
+        _shadingRateImage.size = size;
+        _shadingRateImage.rates.resize(static_cast<size_t>(size.x) * size.y);
+    }
+
+    glm::vec3 focus = global::windowDelegate->gazeDirection().value_or(
+        _focusDirection.value()
+    );
+    if (glm::length(focus) == 0.f) {
+        focus = glm::vec3(0.f, 0.f, -1.f);
+    }
+
+    // The view matrix also contains the scene rotation, which the focus direction should
+    // not follow, so only the orientation of the frustum is applied to it
+    const glm::mat4 frustumView = camera.sgctInternal.viewMatrix() *
+        glm::inverse(camera.sgctInternal.sceneMatrix());
+    const glm::vec3 f = glm::normalize(glm::mat3(frustumView) * focus);
+    const glm::mat4 inverseProjection =
+        glm::inverse(camera.sgctInternal.projectionMatrix());
+
+    const float cosFullRate = std::cos(glm::radians(_fullRateAngle.value()));
+    const float cosHalfRate = std::cos(
+        glm::radians(std::max(_halfRateAngle.value(), _fullRateAngle.value()))
+    );
+
+    for (int y = 0; y < size.y; y++) {
+        for (int x = 0; x < size.x; x++) {
+            // Direction of the view ray through the center of the tile
+            const glm::vec2 center = (glm::vec2(x, y) + 0.5f) * glm::vec2(texelSize);
+            const glm::vec2 ndc = (center - glm::vec2(viewport.x, viewport.y)) /
+                glm::vec2(viewport.z, viewport.w) * 2.f - 1.f;
+            const glm::vec4 p = inverseProjection * glm::vec4(ndc, -1.f, 1.f);
+            const float angle = glm::dot(glm::normalize(glm::vec3(p) / p.w), f);
+
+            GLubyte rate = 2;
+            if (angle >= cosFullRate) {
+                rate = 0;
+            }
+            else if (angle >= cosHalfRate) {
+                rate = 1;
+            }
+            _shadingRateImage.rates[static_cast<size_t>(y) * size.x + x] = rate;
+        }
+    }
+
+    GLint unpackAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, _shadingRateImage.texture);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        size.x,
+        size.y,
+        GL_RED_INTEGER,
+        GL_UNSIGNED_BYTE,
+        _shadingRateImage.rates.data()
+    );
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+
+    glShadingRateImagePaletteNV(
+        0,
+        0,
+        static_cast<GLsizei>(ShadingRatePalette.size()),
+        ShadingRatePalette.data()
+    );
+    glBindShadingRateImageNV(_shadingRateImage.texture);
+}
+
 void FramebufferRenderer::applyTMO(float blackoutFactor, const glm::ivec4& viewport) {
     ZoneScoped;
     TracyGpuZone("applyTMO");
@@ -1112,10 +1551,15 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
 
     _pingPongIndex = 0;
 
+    // Read back the GPU times of the previous frame before issuing new queries
+    collectGpuTimes();
+
     if (!scene || !camera) {
         return;
     }
 
+    updateAdaptiveRaycasting(*camera);
+
     {
         // deferred g-buffer
         ZoneScopedN("Deferred G-Buffer");
@@ -1133,10 +1577,24 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
         .time = std::move(time),
         .renderBinMask = 0
     };
-    RendererTasks tasks;
+    // The tasks only live for this frame, so they are stored in the frame memory
+    std::pmr::memory_resource* frameMemory = &global::memoryManager->TemporaryMemory;
+    RendererTasks tasks = {
+        .raycasterTasks = std::pmr::vector<RaycasterTask>(frameMemory),
+        .deferredcasterTasks = std::pmr::vector<DeferredcasterTask>(frameMemory)
+    };
 
+    // Only the geometry of the G-buffer is rendered with variable rate shading. The
+    // following full-screen passes read the G-buffer per pixel
+    if (_variableRateShadingEnabled) {
+        updateShadingRateImage(*camera, viewport);
+        glEnable(GL_SHADING_RATE_IMAGE_NV);
+    }
+
+    beginGpuStage(GpuStage::GBuffer);
     {
         TracyGpuZone("Background")
+        FrameProfiler::Scope profilerScope("Background", FrameProfiler::Gpu::Yes);
         ghoul::GLDebugGroup group("Background");
         data.renderBinMask = static_cast<int>(Renderable::RenderBin::Background);
         scene->render(data, tasks);
@@ -1144,6 +1602,7 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
 
     {
         TracyGpuZone("Opaque")
+        FrameProfiler::Scope profilerScope("Opaque", FrameProfiler::Gpu::Yes);
         ghoul::GLDebugGroup group("Opaque");
         data.renderBinMask = static_cast<int>(Renderable::RenderBin::Opaque);
         scene->render(data, tasks);
@@ -1151,22 +1610,38 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
 
     {
         TracyGpuZone("PreDeferredTransparent")
+        FrameProfiler::Scope profilerScope(
+            "PreDeferredTransparent",
+            FrameProfiler::Gpu::Yes
+        );
         ghoul::GLDebugGroup group("PreDeferredTransparent");
         data.renderBinMask = static_cast<int>(
             Renderable::RenderBin::PreDeferredTransparent
         );
         scene->render(data, tasks);
     }
+    endGpuStage(GpuStage::GBuffer);
+
+    if (_variableRateShadingEnabled) {
+        glDisable(GL_SHADING_RATE_IMAGE_NV);
+    }
 
     // Run Volume Tasks
     {
         TracyGpuZone("Raycaster Tasks")
+        FrameProfiler::Scope profilerScope("Raycaster Tasks", FrameProfiler::Gpu::Yes);
         ghoul::GLDebugGroup group("Raycaster Tasks");
+        beginGpuStage(GpuStage::Raycasters);
         performRaycasterTasks(tasks.raycasterTasks, viewport);
+        endGpuStage(GpuStage::Raycasters);
     }
 
     if (!tasks.deferredcasterTasks.empty()) {
         TracyGpuZone("Deferred Caster Tasks")
+        FrameProfiler::Scope profilerScope(
+            "Deferred Caster Tasks",
+            FrameProfiler::Gpu::Yes
+        );
         ghoul::GLDebugGroup group("Deferred Caster Tasks");
 
         // We use ping pong rendering in order to be able to render multiple deferred
@@ -1175,7 +1650,9 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
         glBindFramebuffer(GL_FRAMEBUFFER, _pingPongBuffers.framebuffer);
         glDrawBuffers(1, &ColorAttachmentArray[_pingPongIndex]);
 
+        beginGpuStage(GpuStage::DeferredCasters);
         performDeferredTasks(tasks.deferredcasterTasks, viewport);
+        endGpuStage(GpuStage::DeferredCasters);
     }
 
     glDrawBuffers(1, &ColorAttachmentArray[_pingPongIndex]);
@@ -1183,6 +1660,7 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
 
     {
         TracyGpuZone("Overlay")
+        FrameProfiler::Scope profilerScope("Overlay", FrameProfiler::Gpu::Yes);
         ghoul::GLDebugGroup group("Overlay");
         data.renderBinMask = static_cast<int>(Renderable::RenderBin::Overlay);
         scene->render(data, tasks);
@@ -1190,6 +1668,10 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
 
     {
         TracyGpuZone("PostDeferredTransparent")
+        FrameProfiler::Scope profilerScope(
+            "PostDeferredTransparent",
+            FrameProfiler::Gpu::Yes
+        );
         ghoul::GLDebugGroup group("PostDeferredTransparent");
         data.renderBinMask = static_cast<int>(
             Renderable::RenderBin::PostDeferredTransparent
@@ -1199,6 +1681,7 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
 
     {
         TracyGpuZone("Sticker")
+        FrameProfiler::Scope profilerScope("Sticker", FrameProfiler::Gpu::Yes);
         ghoul::GLDebugGroup group("Sticker");
         data.renderBinMask = static_cast<int>(
             Renderable::RenderBin::Sticker
@@ -1226,28 +1709,67 @@ void FramebufferRenderer::render(Scene* scene, Camera* camera, float blackoutFac
     {
         // Apply the selected TMO on the results and resolve the result to the default FBO
         TracyGpuZone("Apply TMO");
+        FrameProfiler::Scope profilerScope("Apply TMO", FrameProfiler::Gpu::Yes);
         ghoul::GLDebugGroup group("Apply TMO");
 
+        beginGpuStage(GpuStage::TMO);
         applyTMO(blackoutFactor, viewport);
+        endGpuStage(GpuStage::TMO);
     }
 
     if (_enableFXAA) {
         TracyGpuZone("Apply FXAA")
+        FrameProfiler::Scope profilerScope("Apply FXAA", FrameProfiler::Gpu::Yes);
         ghoul::GLDebugGroup group("Apply FXAA");
         glBindFramebuffer(GL_FRAMEBUFFER, _defaultFBO);
+        beginGpuStage(GpuStage::FXAA);
         applyFXAA(viewport);
+        endGpuStage(GpuStage::FXAA);
     }
 }
 
-void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>& tasks,
-                                                const glm::ivec4& viewport)
+void FramebufferRenderer::performRaycasterTasks(
+                                             const std::pmr::vector<RaycasterTask>& tasks,
+                                                               const glm::ivec4& viewport)
 {
     ZoneScoped;
 
+    // The reduced quality is split evenly between fewer pixels and fewer samples per ray
+    const float quality = _raycastQuality;
+    const float downscaleFactor = std::sqrt(std::sqrt(quality));
+    const float stepSizeScale = 1.f / std::sqrt(quality);
+
     for (const RaycasterTask& raycasterTask : tasks) {
         TracyGpuZone("Raycaster");
 
         VolumeRaycaster* raycaster = raycasterTask.raycaster;
+        raycaster->setStepSizeScale(stepSizeScale);
+
+        float downscale = raycaster->downscaleRender();
+        if (quality < 1.f) {
+            downscale = std::max(
+                std::round(downscale * downscaleFactor / DownscaleQuantization) *
+                    DownscaleQuantization,
+                DownscaleQuantization
+            );
+        }
+
+        // The passes are restricted to the part of the screen that is covered by the
+        // volume. The downscaled volume is upsampled with linear filtering, which can
+        // reach one downscaled pixel past the bounds, so the region is padded for that
+        const std::optional<glm::vec4> bounds =
+            raycaster->screenSpaceBounds(raycasterTask.renderData);
+        std::optional<glm::ivec4> scissor;
+        if (bounds.has_value()) {
+            const int padding = static_cast<int>(std::ceil(1.f / downscale)) + 1;
+            scissor = scissorRectangle(*bounds, viewport, padding);
+            if (isEmpty(*scissor)) {
+                // The volume is not visible
+                continue;
+            }
+            glEnable(GL_SCISSOR_TEST);
+            setScissor(*scissor);
+        }
 
         glBindFramebuffer(GL_FRAMEBUFFER, _exitFramebuffer);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -1260,9 +1782,9 @@ void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>
             exitProgram->deactivate();
         }
 
-        if (raycaster->downscaleRender() < 1.f) {
+        if (downscale < 1.f) {
             glBindFramebuffer(GL_FRAMEBUFFER, _downscaleVolumeRendering.framebuffer);
-            const float s = raycaster->downscaleRender();
+            const float s = downscale;
             GLint newVP[4] = {
                 static_cast<GLint>(viewport[0] * s),
                 static_cast<GLint>(viewport[1] * s),
@@ -1270,6 +1792,14 @@ void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>
                 static_cast<GLint>(viewport[3] * s)
             };
             global::renderEngine->openglStateCache().setViewportState(newVP);
+            if (scissor.has_value()) {
+                setScissor(glm::ivec4(
+                    static_cast<int>(std::floor(scissor->x * s)),
+                    static_cast<int>(std::floor(scissor->y * s)),
+                    static_cast<int>(std::ceil(scissor->z * s)),
+                    static_cast<int>(std::ceil(scissor->w * s))
+                ));
+            }
 
             if (_downscaleVolumeRendering.currentDownscaleFactor != s) {
                 _downscaleVolumeRendering.currentDownscaleFactor = s;
@@ -1331,8 +1861,8 @@ void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>
             glBindTexture(GL_TEXTURE_2D, _gBuffers.depthTexture);
             raycastProgram->setUniform("mainDepthTexture", mainDepthTextureUnit);
 
-            if (raycaster->downscaleRender() < 1.f) {
-                float scaleDown = raycaster->downscaleRender();
+            if (downscale < 1.f) {
+                float scaleDown = downscale;
                 raycastProgram->setUniform(
                     "windowSize",
                     glm::vec2(_resolution.x * scaleDown, _resolution.y * scaleDown)
@@ -1365,18 +1895,27 @@ void FramebufferRenderer::performRaycasterTasks(const std::vector<RaycasterTask>
             LWARNING("Raycaster is not attached when trying to perform raycaster task");
         }
 
-        if (raycaster->downscaleRender() < 1.f) {
+        if (downscale < 1.f) {
             global::renderEngine->openglStateCache().setViewportState(
                 glm::value_ptr(viewport)
             );
             glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _gBuffers.framebuffer);
+            if (scissor.has_value()) {
+                setScissor(*scissor);
+            }
+            beginGpuStage(GpuStage::DownscaledVolume);
             writeDownscaledVolume(viewport);
+            endGpuStage(GpuStage::DownscaledVolume);
+        }
+
+        if (scissor.has_value()) {
+            glDisable(GL_SCISSOR_TEST);
         }
     }
 }
 
 void FramebufferRenderer::performDeferredTasks(
-                                             const std::vector<DeferredcasterTask>& tasks,
+                                       const std::pmr::vector<DeferredcasterTask>& tasks,
                                                                const glm::ivec4& viewport)
 {
     ZoneScoped;
@@ -1390,6 +1929,17 @@ void FramebufferRenderer::performDeferredTasks(
             _deferredcastPrograms[deferredcaster].get();
 
         if (deferredcastProgram) {
+            const std::optional<glm::vec4> bounds =
+                deferredcaster->screenSpaceBounds(deferredcasterTask.renderData);
+            std::optional<glm::ivec4> scissor;
+            if (bounds.has_value()) {
+                scissor = scissorRectangle(*bounds, viewport);
+                if (isEmpty(*scissor)) {
+                    // The deferredcaster does not change anything on the screen
+                    continue;
+                }
+            }
+
             _pingPongIndex = _pingPongIndex == 0 ? 1 : 0;
             int fromIndex = _pingPongIndex == 0 ? 1 : 0;
             glDrawBuffers(1, &ColorAttachmentArray[_pingPongIndex]);
@@ -1445,10 +1995,33 @@ void FramebufferRenderer::performDeferredTasks(
             glDisable(GL_DEPTH_TEST);
             glDepthMask(false);
 
+            if (scissor.has_value()) {
+                glEnable(GL_SCISSOR_TEST);
+                setScissor(*scissor);
+            }
+
             glBindVertexArray(_screenQuad);
             glDrawArrays(GL_TRIANGLES, 0, 6);
             glBindVertexArray(0);
 
+            if (scissor.has_value()) {
+                glDisable(GL_SCISSOR_TEST);
+
+                // Only the scissored region of the target buffer was written, so instead
+                // of switching to it the region is copied back into the source buffer,
+                // which then stays the current one
+                glReadBuffer(ColorAttachmentArray[_pingPongIndex]);
+                glDrawBuffers(1, &ColorAttachmentArray[fromIndex]);
+                glBlitFramebuffer(
+                    scissor->x, scissor->y, scissor->z, scissor->w,
+                    scissor->x, scissor->y, scissor->z, scissor->w,
+                    GL_COLOR_BUFFER_BIT,
+                    GL_NEAREST
+                );
+                glReadBuffer(GL_COLOR_ATTACHMENT0);
+                _pingPongIndex = fromIndex;
+            }
+
             glDepthMask(true);
             glEnable(GL_DEPTH_TEST);
 
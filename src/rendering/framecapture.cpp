@@ -0,0 +1,319 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/framecapture.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+namespace {
+    constexpr std::string_view _loggerCat = "FrameCapture";
+
+    // The number of frames that can be waiting for the worker threads before the
+    // capturing waits for them to catch up. At 4K, every frame uses 33 MB of memory
+    constexpr int MaxOutstandingTasks = 16;
+
+    // The number of frames that can be waiting for the worker threads before new frames
+    // are dropped when streaming live. Keeping this low also keeps the latency low
+    constexpr int MaxOutstandingLiveTasks = 2;
+
+    // The maximum time that is waited for a read back to finish when finishing
+    constexpr GLuint64 ReadbackTimeout = 1'000'000'000; // 1 s
+
+    // OpenGL returns the rows from bottom to top, but all formats expect them from top
+    // to bottom
+    void flipRows(std::vector<std::byte>& pixels, const glm::ivec2& size) {
+        const size_t rowSize = static_cast<size_t>(size.x) * 4;
+        for (int y = 0; y < size.y / 2; y++) {
+            std::byte* top = pixels.data() + y * rowSize;
+            std::byte* bottom = pixels.data() + (size.y - 1 - y) * rowSize;
+            std::swap_ranges(top, top + rowSize, bottom);
+        }
+    }
+
+    void writePpm(const std::vector<std::byte>& pixels, const glm::ivec2& size,
+                  const std::string& file)
+    {
+        std::ofstream out(file, std::ofstream::binary);
+        if (!out.good()) {
+            LERROR(fmt::format("Could not write frame to '{}'", file));
+            return;
+        }
+
+        out << "P6\n" << size.x << ' ' << size.y << "\n255\n";
+        // PPM files don't have an alpha channel, so it is dropped row by row
+        std::vector<std::byte> row(static_cast<size_t>(size.x) * 3);
+        for (int y = 0; y < size.y; y++) {
+            const std::byte* src = pixels.data() + static_cast<size_t>(y) * size.x * 4;
+            for (int x = 0; x < size.x; x++) {
+                row[3 * x + 0] = src[4 * x + 0];
+                row[3 * x + 1] = src[4 * x + 1];
+                row[3 * x + 2] = src[4 * x + 2];
+            }
+            out.write(reinterpret_cast<const char*>(row.data()), row.size());
+        }
+    }
+
+    void writeRaw(const std::vector<std::byte>& pixels, const std::string& file) {
+        std::ofstream out(file, std::ofstream::binary);
+        if (!out.good()) {
+            LERROR(fmt::format("Could not write frame to '{}'", file));
+            return;
+        }
+        out.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+    }
+} // namespace
+
+namespace openspace {
+
+FrameCapture::FrameCapture(bool dropLateFrames)
+    : _filePool(std::max(std::thread::hardware_concurrency() / 2, 1u))
+    , _ffmpegPool(1)
+    , _dropLateFrames(dropLateFrames)
+{}
+
+void FrameCapture::capture(const glm::ivec2& size, Format format, std::string target) {
+    ZoneScoped;
+
+    if (size.x <= 0 || size.y <= 0) {
+        return;
+    }
+
+    auto it = std::find_if(
+        _buffers.begin(),
+        _buffers.end(),
+        [](const Buffer& b) { return !b.isInUse; }
+    );
+    if (it == _buffers.end()) {
+        Buffer b;
+        glGenBuffers(1, &b.buffer);
+        _buffers.push_back(b);
+        it = _buffers.end() - 1;
+    }
+    Buffer& buffer = *it;
+
+    const size_t nBytes = static_cast<size_t>(size.x) * size.y * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.buffer);
+    if (buffer.size != nBytes) {
+        glBufferData(
+            GL_PIXEL_PACK_BUFFER,
+            static_cast<GLsizeiptr>(nBytes),
+            nullptr,
+            GL_STREAM_READ
+        );
+        buffer.size = nBytes;
+    }
+
+    GLint readFramebuffer = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glReadBuffer(GL_BACK);
+    // As the pixel pack buffer is bound, this only schedules the transfer
+    glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFramebuffer));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    buffer.isInUse = true;
+    _readbacks.push_back({
+        .buffer = static_cast<size_t>(std::distance(_buffers.begin(), it)),
+        .fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0),
+        .size = size,
+        .format = format,
+        .target = std::move(target)
+    });
+}
+
+void FrameCapture::update() {
+    processReadbacks(false);
+}
+
+void FrameCapture::finish() {
+    ZoneScoped;
+
+    processReadbacks(true);
+
+    _nOutstandingTasks++;
+    _ffmpegPool.enqueue([this]() {
+        closeFfmpeg();
+        _nOutstandingTasks--;
+    });
+    while (_nOutstandingTasks > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void FrameCapture::deinitialize() {
+    finish();
+
+    for (const Buffer& b : _buffers) {
+        glDeleteBuffers(1, &b.buffer);
+    }
+    _buffers.clear();
+}
+
+void FrameCapture::processReadbacks(bool waitForGpu) {
+    ZoneScoped;
+
+    while (!_readbacks.empty()) {
+        Readback& readback = _readbacks.front();
+        const GLenum res = glClientWaitSync(
+            readback.fence,
+            GL_SYNC_FLUSH_COMMANDS_BIT,
+            waitForGpu ? ReadbackTimeout : 0
+        );
+        if (res != GL_ALREADY_SIGNALED && res != GL_CONDITION_SATISFIED) {
+            if (waitForGpu) {
+                LERROR("Timed out waiting for a frame to be read back");
+            }
+            // The read backs finish in the order in which they were issued, so none of
+            // the later ones can be ready either
+            return;
+        }
+        glDeleteSync(readback.fence);
+
+        Buffer& buffer = _buffers[readback.buffer];
+        if (_dropLateFrames && _nOutstandingTasks >= MaxOutstandingLiveTasks) {
+            // A live stream is better served by a skipped frame than by a stalled one
+            buffer.isInUse = false;
+            _readbacks.pop_front();
+            continue;
+        }
+
+        const size_t nBytes =
+            static_cast<size_t>(readback.size.x) * readback.size.y * 4;
+        std::vector<std::byte> pixels(nBytes);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.buffer);
+        const void* data = glMapBufferRange(
+            GL_PIXEL_PACK_BUFFER,
+            0,
+            static_cast<GLsizeiptr>(nBytes),
+            GL_MAP_READ_BIT
+        );
+        if (data) {
+            std::memcpy(pixels.data(), data, nBytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        buffer.isInUse = false;
+
+        if (!data) {
+            LERROR("Could not map the pixels of a captured frame");
+            _readbacks.pop_front();
+            continue;
+        }
+
+        // Offline rendering should not lose any frames, so rather than dropping frames
+        // we wait for the worker threads to catch up
+        while (_nOutstandingTasks >= MaxOutstandingTasks) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        _nOutstandingTasks++;
+        ThreadPool& pool = readback.format == Format::Ffmpeg ? _ffmpegPool : _filePool;
+        pool.enqueue(
+            [this, pixels = std::move(pixels), size = readback.size,
+             format = readback.format, target = std::move(readback.target)]() mutable
+            {
+                write(std::move(pixels), size, format, target);
+                _nOutstandingTasks--;
+            }
+        );
+        _readbacks.pop_front();
+    }
+}
+
+void FrameCapture::write(std::vector<std::byte> pixels, const glm::ivec2& size,
+                         Format format, const std::string& target)
+{
+    ZoneScoped;
+
+    flipRows(pixels, size);
+    switch (format) {
+        case Format::Ppm:
+            writePpm(pixels, size, target);
+            break;
+        case Format::Raw:
+            writeRaw(pixels, target);
+            break;
+        case Format::Ffmpeg:
+            writeToFfmpeg(pixels, size, target);
+            break;
+    }
+}
+
+void FrameCapture::writeToFfmpeg(const std::vector<std::byte>& pixels,
+                                 const glm::ivec2& size, const std::string& command)
+{
+    ZoneScoped;
+
+    if (_ffmpeg && (size != _ffmpegSize || command != _ffmpegCommand)) {
+        closeFfmpeg();
+    }
+
+    if (!_ffmpeg) {
+#ifdef WIN32
+        _ffmpeg = _popen(command.c_str(), "wb");
+#else // ^^^ WIN32 / !WIN32 vvv
+        // If the process terminates, for example because the command is wrong, writing
+        // to the pipe would otherwise terminate OpenSpace rather than fail
+        std::signal(SIGPIPE, SIG_IGN);
+        _ffmpeg = popen(command.c_str(), "w");
+#endif // WIN32
+        if (!_ffmpeg) {
+            LERROR(fmt::format("Could not start ffmpeg with '{}'", command));
+            return;
+        }
+        LINFO(fmt::format("Started ffmpeg with '{}'", command));
+        _ffmpegSize = size;
+        _ffmpegCommand = command;
+    }
+
+    const size_t n = std::fwrite(pixels.data(), 1, pixels.size(), _ffmpeg);
+    if (n != pixels.size()) {
+        LERROR("Could not write frame to ffmpeg");
+        closeFfmpeg();
+    }
+}
+
+void FrameCapture::closeFfmpeg() {
+    if (!_ffmpeg) {
+        return;
+    }
+
+#ifdef WIN32
+    _pclose(_ffmpeg);
+#else // ^^^ WIN32 / !WIN32 vvv
+    pclose(_ffmpeg);
+#endif // WIN32
+    _ffmpeg = nullptr;
+}
+
+} // namespace openspace
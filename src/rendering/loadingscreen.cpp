@@ -296,7 +296,7 @@ void LoadingScreen::render() {
     }
 
     if (_showNodeNames) {
-        std::lock_guard guard(_itemsMutex);
+        applyItemUpdates();
 
         std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
 
@@ -477,11 +477,20 @@ void LoadingScreen::render() {
     glEnable(GL_CULL_FACE);
     glEnable(GL_DEPTH_TEST);
 
-    std::this_thread::sleep_for(RefreshRate);
+    // Only wait for what is left of the refresh period, as rendering the frame or the
+    // work in between two calls might already have taken longer than that
+    std::this_thread::sleep_until(_lastFrameTime + RefreshRate);
     global::windowDelegate->swapBuffer();
+    _lastFrameTime = std::chrono::steady_clock::now();
     FrameMarkEnd("Loading");
 }
 
+void LoadingScreen::renderIfDue() {
+    if (std::chrono::steady_clock::now() - _lastFrameTime >= RefreshRate) {
+        render();
+    }
+}
+
 void LoadingScreen::postMessage(std::string message) {
     std::lock_guard guard(_messageMutex);
     _message = std::move(message);
@@ -492,6 +501,7 @@ void LoadingScreen::setCatastrophicError(CatastrophicError catastrophicError) {
 }
 
 void LoadingScreen::finalize() {
+    applyItemUpdates();
     _items.erase(
         std::remove_if(
             _items.begin(),
@@ -533,41 +543,63 @@ void LoadingScreen::updateItem(const std::string& itemIdentifier,
         // also would create any of the text information
         return;
     }
-    std::lock_guard guard(_itemsMutex);
 
-    auto it = std::find_if(
-        _items.begin(),
-        _items.end(),
-        [&itemIdentifier](const Item& i) {
-            return i.identifier == itemIdentifier;
-        }
-    );
-    if (it != _items.end()) {
-        it->status = newStatus;
-        it->progress = std::move(progressInfo);
-        if (newStatus == ItemStatus::Finished) {
-            it->finishedTime = std::chrono::system_clock::now();
-        }
+    // The update is only queued here so that the threads initializing the scene graph
+    // nodes never have to wait for the main thread to finish rendering a frame
+    ItemUpdate update = {
+        .identifier = itemIdentifier,
+        .name = itemName,
+        .status = newStatus,
+        .progress = std::move(progressInfo),
+        .time = std::chrono::system_clock::now()
+    };
+    std::lock_guard guard(_itemUpdatesMutex);
+    _itemUpdates.push_back(std::move(update));
+}
+
+void LoadingScreen::applyItemUpdates() {
+    std::vector<ItemUpdate> updates;
+    {
+        std::lock_guard guard(_itemUpdatesMutex);
+        updates.swap(_itemUpdates);
     }
-    else {
-        // We are not computing the location in here since doing it this way might stall
-        // the main thread while trying to find a position for the new item
-        Item item = {
-            .identifier = itemIdentifier,
-            .name = itemName,
-            .status = ItemStatus::Started,
-            .progress = std::move(progressInfo),
-            .hasLocation = false,
-            .finishedTime = std::chrono::system_clock::from_time_t(0)
-        };
-
-        if (newStatus == ItemStatus::Finished) {
-            // This is only going to be triggered if an item finishes so quickly that
-            // there was not even time to create the item between starting and finishing
-            item.finishedTime = std::chrono::system_clock::now();
+
+    for (ItemUpdate& update : updates) {
+        auto it = std::find_if(
+            _items.begin(),
+            _items.end(),
+            [&update](const Item& i) {
+                return i.identifier == update.identifier;
+            }
+        );
+        if (it != _items.end()) {
+            it->status = update.status;
+            it->progress = std::move(update.progress);
+            if (update.status == ItemStatus::Finished) {
+                it->finishedTime = update.time;
+            }
         }
+        else {
+            // We are not computing the location in here since doing it this way might
+            // stall the main thread while trying to find a position for the new item
+            Item item = {
+                .identifier = std::move(update.identifier),
+                .name = std::move(update.name),
+                .status = ItemStatus::Started,
+                .progress = std::move(update.progress),
+                .hasLocation = false,
+                .finishedTime = std::chrono::system_clock::from_time_t(0)
+            };
+
+            if (update.status == ItemStatus::Finished) {
+                // This is only going to be triggered if an item finishes so quickly that
+                // there was not even time to create the item between starting and
+                // finishing
+                item.finishedTime = update.time;
+            }
 
-        _items.push_back(std::move(item));
+            _items.push_back(std::move(item));
+        }
     }
 }
 
@@ -0,0 +1,185 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/memoryaccounting.h>
+
+#include <openspace/scene/scene.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <limits>
+
+namespace {
+    constexpr std::string_view _loggerCat = "MemoryAccounting";
+
+    constexpr openspace::properties::Property::PropertyInfo GpuBuffersInfo = {
+        "GpuBuffers",
+        "GPU Buffers (MB)",
+        "The memory that is used by the OpenGL buffers of all renderables, in megabytes",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo GpuTexturesInfo = {
+        "GpuTextures",
+        "GPU Textures (MB)",
+        "The memory that is used by the OpenGL textures of all renderables, in megabytes",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CpuDataInfo = {
+        "CpuData",
+        "CPU Data (MB)",
+        "The main memory that is used by the data of all renderables, in megabytes",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo GpuBudgetInfo = {
+        "GpuBudget",
+        "GPU Budget (MB)",
+        "The amount of GPU memory, in megabytes, that all renderables together may use. "
+        "If the budget is exceeded, the renderables using the most GPU memory are asked "
+        "to reduce their quality, one step per update interval, until the usage is "
+        "within the budget again. A value of 0 disables the budget",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo UpdateIntervalInfo = {
+        "UpdateInterval",
+        "Update Interval (s)",
+        "The time in seconds between two updates of the memory usage",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr double MaxMemory = std::numeric_limits<double>::max();
+
+    double toMegabytes(size_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    size_t gpuMemory(const openspace::Renderable::MemoryUsage& usage) {
+        return usage.gpuBuffers + usage.gpuTextures;
+    }
+} // namespace
+
+namespace openspace {
+
+MemoryAccounting::MemoryAccounting()
+    : properties::PropertyOwner({ "MemoryUsage", "Memory Usage" })
+    , _gpuBuffers(GpuBuffersInfo, 0.0, 0.0, MaxMemory)
+    , _gpuTextures(GpuTexturesInfo, 0.0, 0.0, MaxMemory)
+    , _cpuData(CpuDataInfo, 0.0, 0.0, MaxMemory)
+    , _gpuBudget(GpuBudgetInfo, 0.f, 0.f, 65536.f)
+    , _updateInterval(UpdateIntervalInfo, 1.f, 0.1f, 60.f)
+{
+    _gpuBuffers.setReadOnly(true);
+    addProperty(_gpuBuffers);
+    _gpuTextures.setReadOnly(true);
+    addProperty(_gpuTextures);
+    _cpuData.setReadOnly(true);
+    addProperty(_cpuData);
+    addProperty(_gpuBudget);
+    addProperty(_updateInterval);
+}
+
+void MemoryAccounting::update(const Scene& scene) {
+    ZoneScoped;
+
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - _lastUpdate < std::chrono::duration<float>(_updateInterval)) {
+        return;
+    }
+    _lastUpdate = now;
+
+    struct Usage {
+        Renderable* renderable;
+        std::string_view identifier;
+        size_t gpu;
+    };
+    std::vector<Usage> usages;
+
+    _entries.clear();
+    Renderable::MemoryUsage total;
+    for (SceneGraphNode* node : scene.allSceneGraphNodes()) {
+        Renderable* renderable = node->renderable();
+        if (!renderable) {
+            continue;
+        }
+
+        const Renderable::MemoryUsage usage = renderable->updateMemoryUsage();
+        total += usage;
+        _entries.push_back({ node->identifier(), usage });
+        usages.push_back({ renderable, node->identifier(), gpuMemory(usage) });
+    }
+    std::sort(
+        _entries.begin(),
+        _entries.end(),
+        [](const Entry& lhs, const Entry& rhs) {
+            return gpuMemory(lhs.usage) > gpuMemory(rhs.usage);
+        }
+    );
+
+    _gpuBuffers = toMegabytes(total.gpuBuffers);
+    _gpuTextures = toMegabytes(total.gpuTextures);
+    _cpuData = toMegabytes(total.cpuData);
+
+    const size_t budget = static_cast<size_t>(_gpuBudget * 1024.0 * 1024.0);
+    if (budget == 0 || gpuMemory(total) <= budget) {
+        _hasReportedExceededBudget = false;
+        return;
+    }
+
+    // Only a single renderable is reduced per interval so that the effect of the
+    // reduction is measured before more quality is given up
+    std::sort(
+        usages.begin(),
+        usages.end(),
+        [](const Usage& lhs, const Usage& rhs) { return lhs.gpu > rhs.gpu; }
+    );
+    for (const Usage& u : usages) {
+        if (u.gpu > 0 && u.renderable->reduceMemoryUsage()) {
+            LINFO(fmt::format(
+                "GPU memory budget exceeded ({:.1f} of {:.1f} MB), reduced the memory "
+                "usage of '{}'",
+                toMegabytes(gpuMemory(total)), _gpuBudget.value(), u.identifier
+            ));
+            return;
+        }
+    }
+
+    if (!_hasReportedExceededBudget) {
+        LWARNING(fmt::format(
+            "GPU memory budget exceeded ({:.1f} of {:.1f} MB) and no renderable can "
+            "reduce its memory usage any further",
+            toMegabytes(gpuMemory(total)), _gpuBudget.value()
+        ));
+        _hasReportedExceededBudget = true;
+    }
+}
+
+const std::vector<MemoryAccounting::Entry>& MemoryAccounting::entries() const {
+    return _entries;
+}
+
+} // namespace openspace
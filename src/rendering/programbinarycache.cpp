@@ -0,0 +1,238 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/programbinarycache.h>
+
+#include <openspace/util/stablehash.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <ghoul/opengl/programobject.h>
+#include <ghoul/opengl/shaderobject.h>
+#include <ghoul/opengl/shaderpreprocessor.h>
+#include <cstdint>
+#include <fstream>
+
+namespace {
+    constexpr std::string_view _loggerCat = "ProgramBinaryCache";
+
+    constexpr uint32_t FileMagic = 0x4253504F; // 'OPSB'
+    constexpr uint32_t FileVersion = 1;
+
+    struct FileHeader {
+        uint32_t magic = FileMagic;
+        uint32_t version = FileVersion;
+        uint32_t format = 0;
+        uint32_t size = 0;
+    };
+
+    std::string_view glString(GLenum name) {
+        const GLubyte* value = glGetString(name);
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+
+    std::unique_ptr<ghoul::opengl::ShaderObject> createShader(
+                                             ghoul::opengl::ShaderObject::ShaderType type,
+                                                        const std::filesystem::path& path,
+                                                                  const std::string& name,
+                                                      const ghoul::Dictionary& dictionary)
+    {
+        using namespace ghoul::opengl;
+        return std::make_unique<ShaderObject>(type, path, name, dictionary);
+    }
+} // namespace
+
+namespace openspace {
+
+ProgramBinaryCache::ProgramBinaryCache(std::filesystem::path folder)
+    : _folder(std::move(folder))
+{}
+
+std::optional<std::string> ProgramBinaryCache::key(const Shaders& shaders,
+                                                const ghoul::Dictionary& dictionary) const
+{
+    // The keys have to be the same between different runs and builds of the application
+    uint64_t hash = StableHashOffset;
+    stableHashCombine(hash, glString(GL_VENDOR));
+    stableHashCombine(hash, glString(GL_RENDERER));
+    stableHashCombine(hash, glString(GL_VERSION));
+
+    auto addShader = [&hash, &dictionary](const std::filesystem::path& path) {
+        try {
+            ghoul::opengl::ShaderPreprocessor preprocessor(path, dictionary);
+            std::string source;
+            preprocessor.process(source);
+            stableHashCombine(hash, source);
+            return true;
+        }
+        catch (const ghoul::RuntimeError& e) {
+            // The compilation of the shader will report the same error with more context
+            LDEBUG(fmt::format("Not caching program: {}", e.message));
+            return false;
+        }
+    };
+
+    if (!addShader(shaders.vertex) || !addShader(shaders.fragment)) {
+        return std::nullopt;
+    }
+    if (shaders.geometry.has_value() && !addShader(*shaders.geometry)) {
+        return std::nullopt;
+    }
+    return fmt::format("{:016x}", hash);
+}
+
+std::unique_ptr<ghoul::opengl::ProgramObject> ProgramBinaryCache::load(
+                                                                   const std::string& key,
+                                                                  const std::string& name,
+                                                                   const Shaders& shaders,
+                                               const ghoul::Dictionary& dictionary) const
+{
+    using namespace ghoul::opengl;
+
+    const std::filesystem::path file = _folder / (key + ".bin");
+    std::ifstream stream(file, std::ifstream::binary);
+    if (!stream.good()) {
+        return nullptr;
+    }
+
+    FileHeader header;
+    stream.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+    if (!stream.good() || header.magic != FileMagic || header.version != FileVersion) {
+        LWARNING(fmt::format("Ignoring malformed program binary {}", file));
+        return nullptr;
+    }
+    std::vector<char> binary(header.size);
+    stream.read(binary.data(), header.size);
+    if (!stream.good()) {
+        LWARNING(fmt::format("Ignoring truncated program binary {}", file));
+        return nullptr;
+    }
+
+    auto program = std::make_unique<ProgramObject>(name);
+    try {
+        // The shaders are only attached but never compiled, as the program's executable
+        // comes from the binary. They are needed in case the program is rebuilt later
+        program->attachObject(
+            createShader(
+                ShaderObject::ShaderType::Vertex,
+                shaders.vertex,
+                name,
+                dictionary
+            )
+        );
+        program->attachObject(
+            createShader(
+                ShaderObject::ShaderType::Fragment,
+                shaders.fragment,
+                name,
+                dictionary
+            )
+        );
+        if (shaders.geometry.has_value()) {
+            program->attachObject(
+                createShader(
+                    ShaderObject::ShaderType::Geometry,
+                    *shaders.geometry,
+                    name,
+                    dictionary
+                )
+            );
+        }
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LDEBUG(fmt::format(
+            "Could not create shaders for program '{}': {}", name, e.message
+        ));
+        return nullptr;
+    }
+
+    glProgramBinary(
+        *program,
+        static_cast<GLenum>(header.format),
+        binary.data(),
+        static_cast<GLsizei>(binary.size())
+    );
+
+    // A driver update or a different driver configuration can invalidate a binary even
+    // if the version string did not change, in which case we have to compile again
+    GLint status = GL_FALSE;
+    glGetProgramiv(*program, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        LDEBUG(fmt::format("Driver rejected the cached binary for program '{}'", name));
+        std::error_code ec;
+        std::filesystem::remove(file, ec);
+        return nullptr;
+    }
+    return program;
+}
+
+void ProgramBinaryCache::store(const std::string& key,
+                               const ghoul::opengl::ProgramObject& program) const
+{
+    GLint size = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+    if (size <= 0) {
+        return;
+    }
+
+    FileHeader header;
+    std::vector<char> binary(size);
+    GLsizei length = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, size, &length, &format, binary.data());
+    if (length <= 0) {
+        return;
+    }
+    header.format = static_cast<uint32_t>(format);
+    header.size = static_cast<uint32_t>(length);
+
+    std::error_code ec;
+    std::filesystem::create_directories(_folder, ec);
+    if (ec) {
+        LWARNING(fmt::format("Could not create program cache folder {}", _folder));
+        return;
+    }
+
+    // Write to a temporary file first so that other instances reading the cache at the
+    // same time never see a partially written binary
+    const std::filesystem::path file = _folder / (key + ".bin");
+    std::filesystem::path tmp = file;
+    tmp += ".tmp";
+    {
+        std::ofstream stream(tmp, std::ofstream::binary);
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+        stream.write(binary.data(), length);
+        if (!stream.good()) {
+            LWARNING(fmt::format("Could not write program binary {}", file));
+            return;
+        }
+    }
+    std::filesystem::rename(tmp, file, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+    }
+}
+
+} // namespace openspace
@@ -37,6 +37,8 @@
 #include <openspace/util/updatestructures.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/opengl/programobject.h>
+#include <ghoul/opengl/texture.h>
+#include <limits>
 #include <optional>
 
 namespace {
@@ -76,6 +78,33 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo GpuBufferMemoryInfo = {
+        "GpuBuffers",
+        "GPU Buffers (MB)",
+        "The memory that is used by the OpenGL buffers of this renderable, in megabytes",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo GpuTextureMemoryInfo = {
+        "GpuTextures",
+        "GPU Textures (MB)",
+        "The memory that is used by the OpenGL textures of this renderable, in megabytes",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo CpuDataMemoryInfo = {
+        "CpuData",
+        "CPU Data (MB)",
+        "The main memory that is used by the data of this renderable, in megabytes",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr double MaxMemory = std::numeric_limits<double>::max();
+
+    double toMegabytes(size_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
     struct [[codegen::Dictionary(Renderable)]] Parameters {
         // [[codegen::verbatim(EnabledInfo.description)]]
         std::optional<bool> enabled;
@@ -146,7 +175,13 @@ Renderable::Renderable(const ghoul::Dictionary& dictionary, RenderableSettings s
     , _enabled(EnabledInfo, true)
     , _renderableType(RenderableTypeInfo, "Renderable")
     , _dimInAtmosphere(DimInAtmosphereInfo, false)
+    , _memoryUsageOwner({ "MemoryUsage", "Memory Usage" })
+    , _gpuBufferMemory(GpuBufferMemoryInfo, 0.0, 0.0, MaxMemory)
+    , _gpuTextureMemory(GpuTextureMemoryInfo, 0.0, 0.0, MaxMemory)
+    , _cpuDataMemory(CpuDataMemoryInfo, 0.0, 0.0, MaxMemory)
     , _shouldUpdateIfDisabled(settings.shouldUpdateIfDisabled)
+    , _hasThreadSafeUpdate(settings.hasThreadSafeUpdate)
+    , _supportsCulling(settings.supportsCulling)
     , _automaticallyUpdateRenderBin(settings.automaticallyUpdateRenderBin)
 {
     ZoneScoped;
@@ -202,6 +237,14 @@ Renderable::Renderable(const ghoul::Dictionary& dictionary, RenderableSettings s
 
     _dimInAtmosphere = p.dimInAtmosphere.value_or(_dimInAtmosphere);
     addProperty(_dimInAtmosphere);
+
+    _gpuBufferMemory.setReadOnly(true);
+    _memoryUsageOwner.addProperty(_gpuBufferMemory);
+    _gpuTextureMemory.setReadOnly(true);
+    _memoryUsageOwner.addProperty(_gpuTextureMemory);
+    _cpuDataMemory.setReadOnly(true);
+    _memoryUsageOwner.addProperty(_cpuDataMemory);
+    addPropertySubOwner(_memoryUsageOwner);
 }
 
 void Renderable::initialize() {}
@@ -280,6 +323,49 @@ bool Renderable::isReady() const {
     return true;
 }
 
+Renderable::MemoryUsage& Renderable::MemoryUsage::operator+=(const MemoryUsage& rhs) {
+    gpuBuffers += rhs.gpuBuffers;
+    gpuTextures += rhs.gpuTextures;
+    cpuData += rhs.cpuData;
+    return *this;
+}
+
+Renderable::MemoryUsage Renderable::memoryUsage() const {
+    return MemoryUsage();
+}
+
+bool Renderable::reduceMemoryUsage() {
+    return false;
+}
+
+Renderable::MemoryUsage Renderable::updateMemoryUsage() {
+    const MemoryUsage usage = memoryUsage();
+    _gpuBufferMemory = toMegabytes(usage.gpuBuffers);
+    _gpuTextureMemory = toMegabytes(usage.gpuTextures);
+    _cpuDataMemory = toMegabytes(usage.cpuData);
+    return usage;
+}
+
+size_t Renderable::bufferMemory(unsigned int buffer) {
+    if (buffer == 0) {
+        return 0;
+    }
+
+    // The buffer is bound to the copy target, which is not used for rendering, and the
+    // previous binding is restored so that no cached binding state is invalidated
+    GLint previous = 0;
+    glGetIntegerv(GL_COPY_READ_BUFFER_BINDING, &previous);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    GLint64 size = 0;
+    glGetBufferParameteri64v(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+    glBindBuffer(GL_COPY_READ_BUFFER, static_cast<GLuint>(previous));
+    return static_cast<size_t>(size);
+}
+
+size_t Renderable::textureMemory(const ghoul::opengl::Texture* texture) {
+    return texture ? texture->expectedPixelDataSize() : 0;
+}
+
 bool Renderable::isEnabled() const {
     return _enabled;
 }
@@ -288,6 +374,14 @@ bool Renderable::shouldUpdateIfDisabled() const noexcept {
     return _shouldUpdateIfDisabled;
 }
 
+bool Renderable::hasThreadSafeUpdate() const noexcept {
+    return _hasThreadSafeUpdate;
+}
+
+bool Renderable::supportsCulling() const noexcept {
+    return _supportsCulling;
+}
+
 void Renderable::onEnabledChange(std::function<void(bool)> callback) {
     _enabled.onChange([this, c = std::move(callback)]() {
         c(isEnabled());
@@ -28,7 +28,6 @@
 #include <openspace/openspace.h>
 #include <openspace/engine/configuration.h>
 #include <openspace/engine/globals.h>
-#include <openspace/engine/globalscallbacks.h>
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/events/event.h>
@@ -41,13 +40,16 @@
 #include <openspace/rendering/helper.h>
 #include <openspace/rendering/framebufferrenderer.h>
 #include <openspace/rendering/luaconsole.h>
+#include <openspace/rendering/programbinarycache.h>
 #include <openspace/rendering/raycastermanager.h>
 #include <openspace/rendering/screenspacerenderable.h>
 #include <openspace/scene/scene.h>
 #include <openspace/scripting/scriptengine.h>
+#include <openspace/util/frameprofiler.h>
 #include <openspace/util/memorymanager.h>
 #include <openspace/util/timemanager.h>
 #include <openspace/util/screenlog.h>
+#include <openspace/util/spicemanager.h>
 #include <openspace/util/updatestructures.h>
 #include <openspace/util/versionchecker.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -142,6 +144,62 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo AsyncScreenshotsInfo = {
+        "AsyncScreenshots",
+        "Asynchronous Screenshots",
+        "If this value is enabled, screenshots of the current window are read back "
+        "without stalling the rendering and are written by background threads. This "
+        "makes it possible to capture frames at a much higher rate, for example when "
+        "saving frames during a session playback. These screenshots always include "
+        "everything that is rendered on top of the scene and ignore the list of "
+        "screenshot windows",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo AsyncScreenshotFormatInfo =
+    {
+        "AsyncScreenshotFormat",
+        "Asynchronous Screenshot Format",
+        "The format in which asynchronous screenshots are written. 'PPM' and 'Raw' "
+        "write one file per frame into the screenshot folder, where 'Raw' files only "
+        "contain the RGBA values of the pixels. 'Ffmpeg' pipes the frames into an "
+        "ffmpeg process that is started with the FfmpegCommand",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FfmpegCommandInfo = {
+        "FfmpegCommand",
+        "Ffmpeg Command",
+        "The command that starts the ffmpeg process into which asynchronous screenshots "
+        "are piped if their format is 'Ffmpeg'. The frames are provided as raw RGBA "
+        "values on the standard input. {width} and {height} are replaced with the size "
+        "of the frames and {folder} with the screenshot folder",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo LiveOutputInfo = {
+        "LiveOutput",
+        "Live Output",
+        "If this value is enabled, every frame of the current window on the master is "
+        "read back without stalling the rendering and is piped into the ffmpeg process "
+        "that is started with the LiveOutputCommand, for example to send the rendering "
+        "to a vision mixer. Frames are dropped rather than delaying the rendering if the "
+        "process cannot keep up",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo LiveOutputCommandInfo = {
+        "LiveOutputCommand",
+        "Live Output Command",
+        "The command that starts the ffmpeg process into which the frames are piped if "
+        "the LiveOutput is enabled. The frames are provided as raw RGBA values on the "
+        "standard input and {width} and {height} are replaced with the size of the "
+        "frames. The default streams the frames to a local UDP port, but any output of "
+        "ffmpeg can be used, such as a v4l2loopback device on Linux or an NDI output if "
+        "ffmpeg has been built with support for it",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo ShowStatisticsInfo = {
         "ShowStatistics",
         "Show Statistics",
@@ -286,6 +344,17 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo UseProgramBinaryCacheInfo = {
+        "UseProgramBinaryCache",
+        "Use Program Binary Cache",
+        "If this value is enabled, the linked binaries of rendering programs are stored "
+        "in the cache folder and reused the next time the same program is requested, "
+        "which avoids compiling the shaders again on subsequent starts or when a "
+        "renderable changes its shaders. The cache only affects programs that are built "
+        "after the value has changed",
+        openspace::properties::Property::Visibility::Developer
+    };
+
     constexpr openspace::properties::Property::PropertyInfo EnabledFontColorInfo = {
         "EnabledFontColor",
         "Enabled Font Color",
@@ -314,6 +383,20 @@ RenderEngine::RenderEngine()
     , _applyWarping(ApplyWarpingInfo, false)
     , _showStatistics(ShowStatisticsInfo, false)
     , _screenshotUseDate(ScreenshotUseDateInfo, false)
+    , _asyncScreenshots(AsyncScreenshotsInfo, false)
+    , _asyncScreenshotFormat(AsyncScreenshotFormatInfo)
+    , _ffmpegCommand(
+        FfmpegCommandInfo,
+        "ffmpeg -y -f rawvideo -pix_fmt rgba -s {width}x{height} -r 60 -i - "
+        "-c:v libx264 -pix_fmt yuv420p -crf 18 \"{folder}/OpenSpace.mp4\""
+    )
+    , _liveOutput(LiveOutputInfo, false)
+    , _liveOutputCommand(
+        LiveOutputCommandInfo,
+        "ffmpeg -f rawvideo -pix_fmt rgba -s {width}x{height} -r 60 -i - "
+        "-c:v libx264 -preset ultrafast -tune zerolatency -pix_fmt yuv420p "
+        "-f mpegts udp://127.0.0.1:5000"
+    )
     , _showFrameInformation(ShowFrameNumberInfo, false)
     , _disableMasterRendering(DisableMasterInfo, false)
     , _globalBlackOutFactor(GlobalBlackoutFactorInfo, 1.f, 0.f, 1.f)
@@ -344,6 +427,7 @@ RenderEngine::RenderEngine()
         glm::vec3(-glm::pi<float>()),
         glm::vec3(glm::pi<float>())
     )
+    , _useProgramBinaryCache(UseProgramBinaryCacheInfo, true)
     , _enabledFontColor(EnabledFontColorInfo, glm::vec4(0.2f, 0.75f, 0.2f, 1.f))
     , _disabledFontColor(DisabledFontColorInfo, glm::vec4(0.55f, 0.2f, 0.2f, 1.f))
 {
@@ -380,6 +464,9 @@ RenderEngine::RenderEngine()
     addProperty(_screenshotWindowIds);
     addProperty(_applyWarping);
 
+    addPropertySubOwner(_renderer);
+    addPropertySubOwner(_memoryAccounting);
+
     _showStatistics.onChange([this]() {
         global::windowDelegate->showStatistics(_showStatistics);
     });
@@ -423,6 +510,26 @@ RenderEngine::RenderEngine()
     });
     addProperty(_screenshotUseDate);
 
+    // Changing any of these settings finishes the screenshots that are still being
+    // written, which also ends a video that is being recorded with ffmpeg
+    _asyncScreenshots.onChange([this]() { finishScreenshots(); });
+    addProperty(_asyncScreenshots);
+    _asyncScreenshotFormat.addOptions({
+        { static_cast<int>(FrameCapture::Format::Ppm), "PPM" },
+        { static_cast<int>(FrameCapture::Format::Raw), "Raw" },
+        { static_cast<int>(FrameCapture::Format::Ffmpeg), "Ffmpeg" }
+    });
+    _asyncScreenshotFormat.onChange([this]() { finishScreenshots(); });
+    addProperty(_asyncScreenshotFormat);
+    _ffmpegCommand.onChange([this]() { finishScreenshots(); });
+    addProperty(_ffmpegCommand);
+
+    // Ending the live output, or changing its command, ends the running ffmpeg process
+    _liveOutput.onChange([this]() { _liveCapture.finish(); });
+    addProperty(_liveOutput);
+    _liveOutputCommand.onChange([this]() { _liveCapture.finish(); });
+    addProperty(_liveOutputCommand);
+
     _horizFieldOfView.onChange([this]() {
         if (global::windowDelegate->isMaster()) {
             global::windowDelegate->setHorizFieldOfView(_horizFieldOfView);
@@ -437,6 +544,7 @@ RenderEngine::RenderEngine()
     addProperty(_screenSpaceRotation);
     addProperty(_masterRotation);
     addProperty(_disableMasterRendering);
+    addProperty(_useProgramBinaryCache);
 
     _enabledFontColor.setViewOption(openspace::properties::Property::ViewOptions::Color);
     addProperty(_enabledFontColor);
@@ -451,6 +559,10 @@ const FramebufferRenderer& RenderEngine::renderer() const {
     return _renderer;
 }
 
+const MemoryAccounting& RenderEngine::memoryAccounting() const {
+    return _memoryAccounting;
+}
+
 void RenderEngine::initialize() {
     ZoneScoped;
 
@@ -461,6 +573,9 @@ void RenderEngine::initialize() {
     _masterRotation = global::configuration->masterRotation;
     _disableMasterRendering = global::configuration->isRenderingOnMasterDisabled;
     _screenshotUseDate = global::configuration->shouldUseScreenshotDate;
+    _programBinaryCache = std::make_unique<ProgramBinaryCache>(
+        absPath("${CACHE}/programs")
+    );
 
     ghoul::io::TextureReader::ref().addReader(
         std::make_unique<ghoul::io::TextureReaderSTB>()
@@ -539,6 +654,8 @@ void RenderEngine::initializeGL() {
 void RenderEngine::deinitializeGL() {
     ZoneScoped;
 
+    _frameCapture.deinitialize();
+    _liveCapture.deinitialize();
     _renderer.deinitialize();
 }
 
@@ -554,15 +671,48 @@ void RenderEngine::updateScene() {
     const Time& currentTime = global::timeManager->time();
     const Time& integrateFromTime = global::timeManager->integrateFromTime();
 
+    // Most SPICE queries during the update and rendering are for the current time
+    if (SpiceManager::isInitialized()) {
+        SpiceManager::ref().setQueryCacheTime(currentTime.j2000Seconds());
+    }
+
+    FrameProfiler::Scope profilerScope("Scene::update");
     _scene->update({
         TransformData{ glm::dvec3(0.0), glm::dmat3(1.0), glm::dvec3(1.0) },
         currentTime,
         integrateFromTime
     });
 
+    _memoryAccounting.update(*_scene);
+
     LTRACE("RenderEngine::updateSceneGraph(end)");
 }
 
+void RenderEngine::updateSceneTransforms() {
+    ZoneScoped;
+
+    if (!_scene) {
+        return;
+    }
+
+    _scene->updateInterpolations();
+
+    const Time& currentTime = global::timeManager->time();
+    if (SpiceManager::isInitialized()) {
+        SpiceManager::ref().setQueryCacheTime(currentTime.j2000Seconds());
+    }
+
+    FrameProfiler::Scope profilerScope("Scene::updateTransforms");
+    _scene->update(
+        {
+            TransformData{ glm::dvec3(0.0), glm::dmat3(1.0), glm::dvec3(1.0) },
+            currentTime,
+            global::timeManager->integrateFromTime()
+        },
+        Scene::UpdateRenderables::No
+    );
+}
+
 void RenderEngine::updateShaderPrograms() {
     ZoneScoped;
 
@@ -690,14 +840,6 @@ void RenderEngine::render(const glm::mat4& sceneMatrix, const glm::mat4& viewMat
         _renderer.render(_scene, _camera, _globalBlackOutFactor);
     }
 
-    // The CEF webbrowser fix has to be called at least once per frame and we are doing
-    // that in the renderer::render method.  So if we disable the rendering, that fix is
-    // no longer called as we lose access to the Web UI.  Since we are calling the fix
-    // many times anyway, we can just add one call to it here and not lose much
-    if (global::callback::webBrowserPerformanceHotfix) {
-        (*global::callback::webBrowserPerformanceHotfix)();
-    }
-
     if (_showFrameInformation) {
         ZoneScopedN("Show Frame Information");
 
@@ -905,6 +1047,51 @@ void RenderEngine::renderDashboard() {
 void RenderEngine::postDraw() {
     ZoneScoped;
 
+    if (_shouldCaptureFrame) {
+        // The frame is captured here as all windows have been rendered completely
+        _shouldCaptureFrame = false;
+
+        const FrameCapture::Format format =
+            static_cast<FrameCapture::Format>(_asyncScreenshotFormat.value());
+        const glm::ivec2 size = global::windowDelegate->currentWindowSize();
+        const std::filesystem::path folder = absPath("${SCREENSHOTS}");
+        std::string target;
+        switch (format) {
+            case FrameCapture::Format::Ppm:
+            case FrameCapture::Format::Raw:
+                target = (folder / fmt::format(
+                    "OpenSpace_{:0>6}.{}",
+                    _latestScreenshotNumber,
+                    format == FrameCapture::Format::Ppm ? "ppm" : "raw"
+                )).string();
+                break;
+            case FrameCapture::Format::Ffmpeg:
+                target = fmt::format(
+                    fmt::runtime(_ffmpegCommand.value()),
+                    fmt::arg("width", size.x),
+                    fmt::arg("height", size.y),
+                    fmt::arg("folder", folder.string())
+                );
+                break;
+            default:
+                throw ghoul::MissingCaseException();
+        }
+        _frameCapture.capture(size, format, std::move(target));
+    }
+    _frameCapture.update();
+
+    // Only the master streams its frames so that nodes don't compete for the output
+    if (_liveOutput && global::windowDelegate->isMaster()) {
+        const glm::ivec2 size = global::windowDelegate->currentWindowSize();
+        std::string command = fmt::format(
+            fmt::runtime(_liveOutputCommand.value()),
+            fmt::arg("width", size.x),
+            fmt::arg("height", size.y)
+        );
+        _liveCapture.capture(size, FrameCapture::Format::Ffmpeg, std::move(command));
+    }
+    _liveCapture.update();
+
     ++_frameNumber;
 }
 
@@ -962,17 +1149,15 @@ std::unique_ptr<ghoul::opengl::ProgramObject> RenderEngine::buildRenderProgram(
     dict.setValue("fragmentPath", fsPath.string());
 
     using namespace ghoul::opengl;
-    std::unique_ptr<ProgramObject> program = ProgramObject::Build(
+    const std::filesystem::path renderFsPath = absPath(RenderFsPath);
+    return buildCachedProgram(
         name,
         vsPath,
-        absPath(RenderFsPath),
-        std::move(dict)
+        renderFsPath,
+        std::nullopt,
+        dict,
+        [&]() { return ProgramObject::Build(name, vsPath, renderFsPath, dict); }
     );
-
-    if (program) {
-        _programs.push_back(program.get());
-    }
-    return program;
 }
 
 /**
@@ -994,13 +1179,43 @@ std::unique_ptr<ghoul::opengl::ProgramObject> RenderEngine::buildRenderProgram(
     dict.setValue("fragmentPath", fsPath.string());
 
     using namespace ghoul::opengl;
-    std::unique_ptr<ProgramObject> program = ProgramObject::Build(
+    const std::filesystem::path renderFsPath = absPath(RenderFsPath);
+    return buildCachedProgram(
         name,
         vsPath,
-        absPath(RenderFsPath),
+        renderFsPath,
         csPath,
-        std::move(dict)
+        dict,
+        [&]() { return ProgramObject::Build(name, vsPath, renderFsPath, csPath, dict); }
     );
+}
+
+std::unique_ptr<ghoul::opengl::ProgramObject> RenderEngine::buildCachedProgram(
+                                                                  const std::string& name,
+                                                      const std::filesystem::path& vsPath,
+                                                      const std::filesystem::path& fsPath,
+                                       const std::optional<std::filesystem::path>& gsPath,
+                                                      const ghoul::Dictionary& dictionary,
+              const std::function<std::unique_ptr<ghoul::opengl::ProgramObject>()>& build)
+{
+    ZoneScoped;
+
+    std::unique_ptr<ghoul::opengl::ProgramObject> program;
+    std::optional<std::string> key;
+    if (_useProgramBinaryCache && _programBinaryCache) {
+        const ProgramBinaryCache::Shaders shaders = { vsPath, fsPath, gsPath };
+        key = _programBinaryCache->key(shaders, dictionary);
+        if (key.has_value()) {
+            program = _programBinaryCache->load(*key, name, shaders, dictionary);
+        }
+    }
+
+    if (!program) {
+        program = build();
+        if (program && key.has_value()) {
+            _programBinaryCache->store(*key, *program);
+        }
+    }
 
     if (program) {
         _programs.push_back(program.get());
@@ -1059,6 +1274,13 @@ void RenderEngine::takeScreenshot() {
         std::filesystem::create_directories(absPath("${SCREENSHOTS}"));
     }
 
+    if (_asyncScreenshots) {
+        // The frame is captured in postDraw after everything has been rendered
+        _shouldCaptureFrame = true;
+        _latestScreenshotNumber++;
+        return;
+    }
+
     _latestScreenshotNumber = global::windowDelegate->takeScreenshot(
         _applyWarping,
         _screenshotWindowIds
@@ -1073,6 +1295,10 @@ void RenderEngine::resetScreenshotNumber() {
     global::windowDelegate->resetScreenshotNumber();
 }
 
+void RenderEngine::finishScreenshots() {
+    _frameCapture.finish();
+}
+
 unsigned int RenderEngine::latestScreenshotNumber() const {
     return _latestScreenshotNumber;
 }
@@ -1316,12 +1542,13 @@ void RenderEngine::renderVersionInformation() {
 void RenderEngine::renderScreenLog() {
     ZoneScoped;
 
+    // The entries are collected even if the log is hidden to not let them accumulate
+    _log->removeExpiredEntries();
+
     if (!_showLog) {
         return;
     }
 
-    _log->removeExpiredEntries();
-
     constexpr size_t MaxNumberMessages = 20;
     constexpr int CategoryLength = 30;
     constexpr int MessageLength = 280;
@@ -1411,13 +1638,16 @@ void RenderEngine::renderScreenLog() {
             );
         }
 
+        // Repeated messages are shown once with the number of repetitions
+        const std::string repeatedMessage =
+            it.count > 1 ? fmt::format("[{}x] {}", it.count, message) : std::string();
         RenderFont(
             *_fontLog,
             glm::vec2(
                 10 + 44 * _fontLog->pointSize(),
                 _fontLog->pointSize() * nRows * 2 + fontRes.y * _verticalLogOffset
             ),
-            message,
+            it.count > 1 ? std::string_view(repeatedMessage) : message,
             white
         );
         ++nRows;
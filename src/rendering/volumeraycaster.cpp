@@ -24,6 +24,8 @@
 
 #include <openspace/rendering/volumeraycaster.h>
 
+#include <limits>
+
 namespace openspace {
 
 void VolumeRaycaster::preRaycast(const RaycastData&, ghoul::opengl::ProgramObject&) {}
@@ -33,6 +35,36 @@ bool VolumeRaycaster::isCameraInside(const RenderData&, glm::vec3&) {
     return false;
 }
 
+std::optional<glm::vec4> VolumeRaycaster::screenSpaceBounds(const RenderData&) {
+    return std::nullopt;
+}
+
+std::optional<glm::vec4> VolumeRaycaster::boxScreenSpaceBounds(
+                                                   const glm::dmat4& modelViewProjection)
+{
+    glm::dvec2 min = glm::dvec2(std::numeric_limits<double>::max());
+    glm::dvec2 max = glm::dvec2(-std::numeric_limits<double>::max());
+    for (int i = 0; i < 8; ++i) {
+        const glm::dvec4 corner = glm::dvec4(
+            (i & 1) ? 0.5 : -0.5,
+            (i & 2) ? 0.5 : -0.5,
+            (i & 4) ? 0.5 : -0.5,
+            1.0
+        );
+        const glm::dvec4 clip = modelViewProjection * corner;
+        if (clip.w <= 0.0) {
+            return std::nullopt;
+        }
+        const glm::dvec2 ndc = glm::dvec2(clip) / clip.w;
+        min = glm::min(min, ndc);
+        max = glm::max(max, ndc);
+    }
+
+    min = glm::clamp(min, -1.0, 1.0);
+    max = glm::clamp(max, -1.0, 1.0);
+    return glm::vec4(min.x, min.y, max.x, max.y);
+}
+
 void VolumeRaycaster::setMaxSteps(int nsteps) {
     _rayCastMaxSteps = nsteps;
 }
@@ -49,4 +81,12 @@ float VolumeRaycaster::downscaleRender() const {
     return _downscaleRenderConst;
 }
 
+void VolumeRaycaster::setStepSizeScale(float scale) {
+    _stepSizeScale = scale;
+}
+
+float VolumeRaycaster::stepSizeScale() const {
+    return _stepSizeScale;
+}
+
 } // namespace openspace
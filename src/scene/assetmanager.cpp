@@ -27,11 +27,18 @@
 #include <openspace/documentation/documentation.h>
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/engine/globals.h>
+#include <openspace/rendering/loadingscreen.h>
 #include <openspace/scene/asset.h>
 #include <openspace/scripting/lualibrary.h>
+#include <openspace/util/startupprofiler.h>
+#include <openspace/util/threadpool.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/lua/lua_helper.h>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <unordered_set>
 
 #include "assetmanager_lua.inl"
 
@@ -43,6 +50,8 @@ namespace {
     constexpr const char* ExportsTableName = "_exports";
     constexpr const char* AssetTableName = "_asset";
 
+    constexpr uint64_t SnapshotVersion = 1;
+
     enum class PathType {
         RelativeToAsset, ///< Specified as a path relative to the requiring asset
         RelativeToAssetRoot, ///< Specified as a path relative to the root folder
@@ -69,6 +78,103 @@ namespace {
         return PathType::RelativeToAssetRoot;
     }
 
+    struct FileStamp {
+        uint64_t size = 0;
+        int64_t writeTime = 0;
+
+        bool operator==(const FileStamp&) const = default;
+    };
+
+    std::optional<FileStamp> fileStamp(const std::filesystem::path& path) {
+        std::error_code ec;
+        const uint64_t size = std::filesystem::file_size(path, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        const std::filesystem::file_time_type time =
+            std::filesystem::last_write_time(path, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        return FileStamp{ size, time.time_since_epoch().count() };
+    }
+
+    struct CompiledAsset {
+        std::filesystem::path path;
+        // The stamp of the compiled file. It is taken before the file is read, so a file
+        // that changes while it is compiled does not match its snapshot entry
+        std::optional<FileStamp> stamp;
+        std::string bytecode;
+        // The arguments of all `asset.require` calls that use a string literal
+        std::vector<std::string> dependencies;
+        bool isFromSnapshot = false;
+    };
+
+    int writeBytecode(lua_State*, const void* data, size_t size, void* buffer) {
+        static_cast<std::string*>(buffer)->append(static_cast<const char*>(data), size);
+        return 0;
+    }
+
+    // Finds the string literal arguments of all asset.require calls in the source. This
+    // is only a textual scan, so requires in comments are also picked up, which only
+    // means that an asset is compiled that might not be loaded
+    std::vector<std::string> findRequires(std::string_view source) {
+        constexpr std::string_view Require = "asset.require(";
+
+        std::vector<std::string> res;
+        size_t pos = source.find(Require);
+        while (pos != std::string_view::npos) {
+            size_t begin = source.find_first_not_of(" \t", pos + Require.size());
+            if (begin != std::string_view::npos &&
+                (source[begin] == '"' || source[begin] == '\''))
+            {
+                const char quote = source[begin];
+                const size_t end = source.find(quote, begin + 1);
+                if (end != std::string_view::npos) {
+                    res.emplace_back(source.substr(begin + 1, end - begin - 1));
+                }
+            }
+            pos = source.find(Require, pos + Require.size());
+        }
+        return res;
+    }
+
+    // Compiles the asset file at the provided path in a separate Lua state. If the file
+    // cannot be compiled, the bytecode is left empty and the error is reported when the
+    // asset file is run the regular way
+    CompiledAsset compileAsset(std::filesystem::path path) {
+        ZoneScoped;
+
+        CompiledAsset res;
+        res.path = std::move(path);
+        res.stamp = fileStamp(res.path);
+
+        std::ifstream file(res.path, std::ios::binary);
+        if (!file.good()) {
+            return res;
+        }
+        std::string source = std::string(
+            std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>()
+        );
+
+        lua_State* state = luaL_newstate();
+        const std::string chunkName = "@" + res.path.string();
+        const int status = luaL_loadbuffer(
+            state,
+            source.data(),
+            source.size(),
+            chunkName.c_str()
+        );
+        if (status == LUA_OK) {
+            lua_dump(state, writeBytecode, &res.bytecode, 0);
+        }
+        lua_close(state);
+
+        res.dependencies = findRequires(source);
+        return res;
+    }
+
     struct [[codegen::Dictionary(AssetMeta)]] Parameters {
         // The user-facing name of the asset. It should describe to the user what they can
         // expect when loading the asset into a profile
@@ -178,7 +284,13 @@ void AssetManager::update() {
             continue;
         }
 
-        a->initialize();
+        {
+            StartupProfiler::Scope scope(
+                StartupProfiler::Category::AssetInitialize,
+                a->path().string()
+            );
+            a->initialize();
+        }
 
         // We are only doing one asset per frame to keep the loading screen working a bit
         // smoother, so we remove the current one and then break out of the loop
@@ -190,6 +302,16 @@ void AssetManager::update() {
         break;
     }
 
+    // Compile the queued assets and their dependencies concurrently before they are run
+    // in dependency order in the shared Lua state
+    if (!_assetAddQueue.empty()) {
+        std::vector<std::filesystem::path> paths;
+        for (const std::string& asset : _assetAddQueue) {
+            paths.push_back(generateAssetPath(_assetRootDirectory, asset));
+        }
+        precompileAssets(std::move(paths));
+    }
+
     // Add all assets that have been queued for loading since the last `update` call
     for (const std::string& asset : _assetAddQueue) {
         ZoneScopedN("Adding queued assets");
@@ -226,6 +348,8 @@ void AssetManager::update() {
         global::profile->addAsset(asset);
     }
     _assetAddQueue.clear();
+    // Assets that were only required conditionally might not have been used
+    _precompiledAssets.clear();
 
     // Remove assets
     for (const std::string& asset : _assetRemoveQueue) {
@@ -281,6 +405,19 @@ void AssetManager::update() {
          it != _unfinishedSynchronizations.end();)
     {
         SyncItem* si = *it;
+        const bool isFinished =
+            si->synchronization->isResolved() || si->synchronization->isRejected();
+        if (isFinished && si->requestTime != std::chrono::steady_clock::time_point()) {
+            // The same item can be in the list multiple times, but we only record it once
+            global::startupProfiler->record(
+                StartupProfiler::Category::AssetSynchronization,
+                si->synchronization->name(),
+                si->requestTime,
+                std::chrono::steady_clock::now()
+            );
+            si->requestTime = std::chrono::steady_clock::time_point();
+        }
+
         if (si->synchronization->isResolved()) {
             for (Asset* a : si->assets) {
                 a->setSynchronizationStateResolved();
@@ -353,6 +490,18 @@ bool AssetManager::isRootAsset(const Asset* asset) const {
 bool AssetManager::loadAsset(Asset* asset, Asset* parent) {
     ghoul_precondition(asset, "Asset must not be nullptr");
 
+    StartupProfiler::Scope scope(
+        StartupProfiler::Category::AssetLoad,
+        asset->path().string()
+    );
+
+    // Loading a large tree of assets blocks the main thread for a while, so we keep the
+    // loading screen going in between the individual assets
+    LoadingScreen* loadingScreen = global::openSpaceEngine->loadingScreen();
+    if (loadingScreen) {
+        loadingScreen->renderIfDue();
+    }
+
     const int top = lua_gettop(*_luaState);
 
     setCurrentAsset(asset);
@@ -369,7 +518,27 @@ bool AssetManager::loadAsset(Asset* asset, Asset* parent) {
     }
 
     try {
-        ghoul::lua::runScriptFile(*_luaState, asset->path());
+        auto it = _precompiledAssets.find(asset->path().string());
+        if (it != _precompiledAssets.end()) {
+            std::string bytecode = std::move(it->second);
+            _precompiledAssets.erase(it);
+
+            const std::string chunkName = "@" + asset->path().string();
+            const int status = luaL_loadbuffer(
+                *_luaState,
+                bytecode.data(),
+                bytecode.size(),
+                chunkName.c_str()
+            );
+            if (status != LUA_OK || lua_pcall(*_luaState, 0, 0, 0) != LUA_OK) {
+                throw ghoul::lua::LuaRuntimeException(
+                    ghoul::lua::value<std::string>(*_luaState, -1)
+                );
+            }
+        }
+        else {
+            ghoul::lua::runScriptFile(*_luaState, asset->path());
+        }
     }
     catch (const ghoul::lua::LuaRuntimeException& e) {
         LERROR(fmt::format("Could not load asset {}: {}", asset->path(), e.message));
@@ -541,6 +710,7 @@ void AssetManager::setUpAssetLuaTable(Asset* asset) {
             auto it = manager->_synchronizations.find(uid);
             if (it == manager->_synchronizations.end()) {
                 auto si = std::make_unique<SyncItem>();
+                si->requestTime = std::chrono::steady_clock::now();
                 si->synchronization = std::move(s);
                 si->assets.push_back(thisAsset);
                 syncItem = si.get();
@@ -904,6 +1074,175 @@ void AssetManager::callOnDeinitialize(Asset* asset) const {
     }
 }
 
+void AssetManager::precompileAssets(std::vector<std::filesystem::path> paths) {
+    ZoneScoped;
+
+    std::unordered_set<std::string> visited;
+    for (const std::unique_ptr<Asset>& asset : _assets) {
+        // Assets that already exist are never run again
+        visited.insert(asset->path().string());
+    }
+
+    std::vector<std::filesystem::path> level;
+    for (std::filesystem::path& path : paths) {
+        if (visited.insert(path.string()).second) {
+            level.push_back(std::move(path));
+        }
+    }
+
+    const unsigned int nThreads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    ThreadPool pool(nThreads);
+    while (!level.empty()) {
+        std::vector<CompiledAsset> compiled(level.size());
+        pool.parallelFor(
+            0,
+            level.size(),
+            1,
+            [this, &level, &compiled](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    // The snapshot is not modified while the level is compiled
+                    auto it = _snapshot.find(level[i].string());
+                    if (it != _snapshot.end()) {
+                        const SnapshotEntry& e = it->second;
+                        const std::optional<FileStamp> stamp = fileStamp(level[i]);
+                        if (stamp.has_value() &&
+                            *stamp == FileStamp{ e.fileSize, e.writeTime })
+                        {
+                            compiled[i] = {
+                                .path = level[i],
+                                .stamp = stamp,
+                                .bytecode = e.bytecode,
+                                .dependencies = e.dependencies,
+                                .isFromSnapshot = true
+                            };
+                            continue;
+                        }
+                    }
+                    compiled[i] = compileAsset(level[i]);
+                }
+            }
+        );
+
+        // The dependencies are resolved here as the path tokens are not thread-safe
+        std::vector<std::filesystem::path> nextLevel;
+        for (CompiledAsset& c : compiled) {
+            for (const std::string& dependency : c.dependencies) {
+                std::filesystem::path p =
+                    generateAssetPath(c.path.parent_path(), dependency);
+                if (visited.insert(p.string()).second) {
+                    nextLevel.push_back(std::move(p));
+                }
+            }
+            if (c.bytecode.empty()) {
+                continue;
+            }
+            SnapshotEntry& entry = _snapshot[c.path.string()];
+            entry.isUsed = true;
+            if (!c.isFromSnapshot && c.stamp.has_value()) {
+                entry.fileSize = c.stamp->size;
+                entry.writeTime = c.stamp->writeTime;
+                entry.dependencies = std::move(c.dependencies);
+                entry.bytecode = c.bytecode;
+            }
+            _precompiledAssets[c.path.string()] = std::move(c.bytecode);
+        }
+        level = std::move(nextLevel);
+    }
+}
+
+void AssetManager::loadSnapshot(const std::filesystem::path& path) {
+    ZoneScoped;
+
+    std::ifstream file(path, std::ifstream::binary);
+    if (!file.good()) {
+        return;
+    }
+
+    auto readString = [&file]() {
+        uint64_t size = 0;
+        file.read(reinterpret_cast<char*>(&size), sizeof(uint64_t));
+        std::string res;
+        if (file.good()) {
+            res.resize(size);
+            file.read(res.data(), size);
+        }
+        return res;
+    };
+
+    uint64_t version = 0;
+    int32_t luaVersion = 0;
+    uint64_t nEntries = 0;
+    file.read(reinterpret_cast<char*>(&version), sizeof(uint64_t));
+    file.read(reinterpret_cast<char*>(&luaVersion), sizeof(int32_t));
+    file.read(reinterpret_cast<char*>(&nEntries), sizeof(uint64_t));
+    // Lua bytecode can only be loaded by the version of Lua that has created it
+    if (!file.good() || version != SnapshotVersion || luaVersion != LUA_VERSION_NUM) {
+        LDEBUG(fmt::format("Ignoring outdated asset snapshot {}", path));
+        return;
+    }
+
+    std::unordered_map<std::string, SnapshotEntry> snapshot;
+    for (uint64_t i = 0; i < nEntries; i++) {
+        std::string assetPath = readString();
+        SnapshotEntry entry;
+        file.read(reinterpret_cast<char*>(&entry.fileSize), sizeof(uint64_t));
+        file.read(reinterpret_cast<char*>(&entry.writeTime), sizeof(int64_t));
+        uint64_t nDependencies = 0;
+        file.read(reinterpret_cast<char*>(&nDependencies), sizeof(uint64_t));
+        for (uint64_t j = 0; j < nDependencies && file.good(); j++) {
+            entry.dependencies.push_back(readString());
+        }
+        entry.bytecode = readString();
+        if (!file.good()) {
+            LWARNING(fmt::format("Ignoring truncated asset snapshot {}", path));
+            return;
+        }
+        snapshot[std::move(assetPath)] = std::move(entry);
+    }
+    _snapshot = std::move(snapshot);
+}
+
+void AssetManager::saveSnapshot(const std::filesystem::path& path) const {
+    ZoneScoped;
+
+    std::ofstream file(path, std::ofstream::binary);
+    auto writeString = [&file](const std::string& s) {
+        const uint64_t size = s.size();
+        file.write(reinterpret_cast<const char*>(&size), sizeof(uint64_t));
+        file.write(s.data(), size);
+    };
+
+    const int32_t luaVersion = LUA_VERSION_NUM;
+    const uint64_t nEntries = std::count_if(
+        _snapshot.begin(),
+        _snapshot.end(),
+        [](const std::pair<const std::string, SnapshotEntry>& p) {
+            return p.second.isUsed;
+        }
+    );
+    file.write(reinterpret_cast<const char*>(&SnapshotVersion), sizeof(uint64_t));
+    file.write(reinterpret_cast<const char*>(&luaVersion), sizeof(int32_t));
+    file.write(reinterpret_cast<const char*>(&nEntries), sizeof(uint64_t));
+    for (const std::pair<const std::string, SnapshotEntry>& p : _snapshot) {
+        const SnapshotEntry& entry = p.second;
+        if (!entry.isUsed) {
+            continue;
+        }
+        writeString(p.first);
+        file.write(reinterpret_cast<const char*>(&entry.fileSize), sizeof(uint64_t));
+        file.write(reinterpret_cast<const char*>(&entry.writeTime), sizeof(int64_t));
+        const uint64_t nDependencies = entry.dependencies.size();
+        file.write(reinterpret_cast<const char*>(&nDependencies), sizeof(uint64_t));
+        for (const std::string& dependency : entry.dependencies) {
+            writeString(dependency);
+        }
+        writeString(entry.bytecode);
+    }
+    if (!file.good()) {
+        LWARNING(fmt::format("Could not write asset snapshot {}", path));
+    }
+}
+
 void AssetManager::setCurrentAsset(Asset* asset) {
     const int top = lua_gettop(*_luaState);
 
@@ -0,0 +1,398 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/scene/boundingspherehierarchy.h>
+
+#include <openspace/scene/scenegraphnode.h>
+#include <openspace/scene/worldtransformcache.h>
+#include <ghoul/misc/profiling.h>
+#include <glm/gtc/matrix_access.hpp>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+
+namespace {
+    // The maximum number of scene graph nodes in a leaf of the hierarchy
+    constexpr uint32_t MaxNodesPerLeaf = 4;
+
+    // The hierarchy is rebuilt if refitting has made the spheres this much larger in
+    // total than they were after the last rebuild
+    constexpr double MaxDegradation = 2.0;
+
+    // Returns the smallest sphere that encloses both spheres, given as center and radius
+    glm::dvec4 mergeSpheres(const glm::dvec4& a, const glm::dvec4& b) {
+        const glm::dvec3 ab = glm::dvec3(b) - glm::dvec3(a);
+        const double distance = glm::length(ab);
+        if (distance + b.w <= a.w) {
+            return a;
+        }
+        if (distance + a.w <= b.w) {
+            return b;
+        }
+        const double radius = 0.5 * (distance + a.w + b.w);
+        const glm::dvec3 center = glm::dvec3(a) + ab * ((radius - a.w) / distance);
+        return glm::dvec4(center, radius);
+    }
+} // namespace
+
+namespace openspace {
+
+BoundingSphereHierarchy::BoundingSphereHierarchy(const WorldTransformCache& cache)
+    : _cache(cache)
+{}
+
+void BoundingSphereHierarchy::invalidateTransforms() {
+    _needsRefit = true;
+}
+
+void BoundingSphereHierarchy::invalidateNodes() {
+    _needsRebuild = true;
+}
+
+std::vector<BoundingSphereHierarchy::RayHit> BoundingSphereHierarchy::intersectRay(
+                                                              const glm::dvec3& origin,
+                                                           const glm::dvec3& direction)
+{
+    ZoneScoped;
+
+    update();
+
+    std::vector<RayHit> hits;
+    if (_nodes.empty() || glm::length(direction) == 0.0) {
+        return hits;
+    }
+    const glm::dvec3 dir = glm::normalize(direction);
+
+    // Returns the distance at which the ray enters the sphere, or a negative value if
+    // the sphere is missed. The perpendicular distance is computed directly, rather than
+    // from the difference of squares, to not lose the precision for small spheres that
+    // are far away
+    auto intersect = [&origin, &dir](const glm::dvec3& center, double radius) {
+        const glm::dvec3 oc = center - origin;
+        const double tca = glm::dot(oc, dir);
+        const glm::dvec3 perpendicular = oc - tca * dir;
+        const double d2 = glm::dot(perpendicular, perpendicular);
+        if (d2 > radius * radius) {
+            return -1.0;
+        }
+        const double thc = std::sqrt(radius * radius - d2);
+        if (tca + thc < 0.0) {
+            return -1.0;
+        }
+        return std::max(tca - thc, 0.0);
+    };
+
+    std::vector<int> stack = { 0 };
+    while (!stack.empty()) {
+        const int index = stack.back();
+        stack.pop_back();
+
+        const Node& node = _nodes[index];
+
+        if (intersect(node.center, node.radius) < 0.0) {
+            continue;
+        }
+
+        if (node.secondChild != -1) {
+            stack.push_back(index + 1);
+            stack.push_back(node.secondChild);
+            continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.count; i++) {
+            const uint32_t idx = _order[i];
+            SceneGraphNode* n = queryableNode(idx);
+            if (!n || _spheres[idx].w <= 0.0) {
+                continue;
+            }
+            const double distance = intersect(glm::dvec3(_spheres[idx]), _spheres[idx].w);
+            if (distance >= 0.0) {
+                hits.push_back({ n, distance });
+            }
+        }
+    }
+
+    std::sort(
+        hits.begin(),
+        hits.end(),
+        [](const RayHit& lhs, const RayHit& rhs) { return lhs.distance < rhs.distance; }
+    );
+    return hits;
+}
+
+SceneGraphNode* BoundingSphereHierarchy::nearestNode(const glm::dvec3& position) {
+    ZoneScoped;
+
+    update();
+
+    // The distance to the surface of a sphere is a lower bound for the distance to the
+    // surface of every sphere that it encloses
+    auto surfaceDistance = [&position](const glm::dvec3& center, double radius) {
+        return glm::distance(position, center) - radius;
+    };
+
+    SceneGraphNode* nearest = nullptr;
+    double nearestDistance = std::numeric_limits<double>::max();
+    std::vector<int> stack;
+    if (!_nodes.empty()) {
+        stack.push_back(0);
+    }
+    while (!stack.empty()) {
+        const int index = stack.back();
+        stack.pop_back();
+
+        const Node& node = _nodes[index];
+        if (surfaceDistance(node.center, node.radius) >= nearestDistance) {
+            continue;
+        }
+
+        if (node.secondChild != -1) {
+            // Visit the closer child first, which makes it more likely that the other
+            // one can be skipped
+            const Node& first = _nodes[index + 1];
+            const Node& second = _nodes[node.secondChild];
+            if (surfaceDistance(first.center, first.radius) <
+                surfaceDistance(second.center, second.radius))
+            {
+                stack.push_back(node.secondChild);
+                stack.push_back(index + 1);
+            }
+            else {
+                stack.push_back(index + 1);
+                stack.push_back(node.secondChild);
+            }
+            continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.count; i++) {
+            const uint32_t idx = _order[i];
+            SceneGraphNode* n = queryableNode(idx);
+            if (!n) {
+                continue;
+            }
+            const double d = surfaceDistance(glm::dvec3(_spheres[idx]), _spheres[idx].w);
+            if (d < nearestDistance) {
+                nearest = n;
+                nearestDistance = d;
+            }
+        }
+    }
+    return nearest;
+}
+
+std::vector<SceneGraphNode*> BoundingSphereHierarchy::nodesInFrustum(
+                                                         const glm::dmat4& viewProjection)
+{
+    ZoneScoped;
+
+    update();
+
+    // Extract the six clipping planes in world coordinates from the rows of the matrix
+    const glm::dvec4 row0 = glm::row(viewProjection, 0);
+    const glm::dvec4 row1 = glm::row(viewProjection, 1);
+    const glm::dvec4 row2 = glm::row(viewProjection, 2);
+    const glm::dvec4 row3 = glm::row(viewProjection, 3);
+    std::array<glm::dvec4, 6> planes = {
+        row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2
+    };
+    for (glm::dvec4& plane : planes) {
+        plane /= glm::length(glm::dvec3(plane));
+    }
+
+    auto isOutside = [&planes](const glm::dvec3& center, double radius) {
+        return std::any_of(
+            planes.begin(),
+            planes.end(),
+            [&center, radius](const glm::dvec4& plane) {
+                return glm::dot(glm::dvec3(plane), center) + plane.w < -radius;
+            }
+        );
+    };
+
+    std::vector<SceneGraphNode*> result;
+    std::vector<int> stack;
+    if (!_nodes.empty()) {
+        stack.push_back(0);
+    }
+    while (!stack.empty()) {
+        const int index = stack.back();
+        stack.pop_back();
+
+        const Node& node = _nodes[index];
+        if (isOutside(node.center, node.radius)) {
+            continue;
+        }
+
+        if (node.secondChild != -1) {
+            stack.push_back(index + 1);
+            stack.push_back(node.secondChild);
+            continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.count; i++) {
+            const uint32_t idx = _order[i];
+            SceneGraphNode* n = queryableNode(idx);
+            if (n && !isOutside(glm::dvec3(_spheres[idx]), _spheres[idx].w)) {
+                result.push_back(n);
+            }
+        }
+    }
+    return result;
+}
+
+void BoundingSphereHierarchy::update() {
+    if (_needsRebuild) {
+        rebuild();
+        return;
+    }
+    if (_needsRefit) {
+        refit();
+        if (totalRadius() > MaxDegradation * _builtTotalRadius) {
+            rebuild();
+        }
+    }
+}
+
+void BoundingSphereHierarchy::rebuild() {
+    ZoneScoped;
+
+    const uint32_t nNodes = static_cast<uint32_t>(_cache.size());
+    _spheres.resize(nNodes);
+    for (uint32_t i = 0; i < nNodes; i++) {
+        const SceneGraphNode* node = _cache.node(i);
+        _spheres[i] = glm::dvec4(
+            _cache.worldPosition(i),
+            node ? node->boundingSphere() : 0.0
+        );
+    }
+
+    _order.resize(nNodes);
+    std::iota(_order.begin(), _order.end(), 0);
+    _nodes.clear();
+    if (nNodes > 0) {
+        buildNode(0, nNodes);
+    }
+    _needsRebuild = false;
+
+    // The topology only depends on the positions, the spheres are computed by the refit
+    refit();
+    _builtTotalRadius = totalRadius();
+}
+
+int BoundingSphereHierarchy::buildNode(uint32_t first, uint32_t count) {
+    const int index = static_cast<int>(_nodes.size());
+    _nodes.emplace_back();
+
+    if (count <= MaxNodesPerLeaf) {
+        _nodes[index].first = first;
+        _nodes[index].count = count;
+        return index;
+    }
+
+    // Split the nodes at the median along the axis in which they are most spread out
+    glm::dvec3 minimum = glm::dvec3(std::numeric_limits<double>::max());
+    glm::dvec3 maximum = glm::dvec3(std::numeric_limits<double>::lowest());
+    for (uint32_t i = first; i < first + count; i++) {
+        minimum = glm::min(minimum, glm::dvec3(_spheres[_order[i]]));
+        maximum = glm::max(maximum, glm::dvec3(_spheres[_order[i]]));
+    }
+    const glm::dvec3 extent = maximum - minimum;
+    int axis = 0;
+    if (extent.y > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+        axis = 2;
+    }
+
+    const uint32_t half = count / 2;
+    std::vector<uint32_t>::iterator begin = _order.begin() + first;
+    std::nth_element(
+        begin,
+        begin + half,
+        begin + count,
+        [this, axis](uint32_t lhs, uint32_t rhs) {
+            return _spheres[lhs][axis] < _spheres[rhs][axis];
+        }
+    );
+
+    // The first child is placed directly after this node
+    buildNode(first, half);
+    const int second = buildNode(first + half, count - half);
+    _nodes[index].secondChild = second;
+    return index;
+}
+
+void BoundingSphereHierarchy::refit() {
+    ZoneScoped;
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(_spheres.size()); i++) {
+        const SceneGraphNode* node = _cache.node(i);
+        _spheres[i] = glm::dvec4(
+            _cache.worldPosition(i),
+            node ? node->boundingSphere() : 0.0
+        );
+    }
+
+    // Children are always stored after their parent, so walking backwards updates every
+    // child before its parent
+    for (int i = static_cast<int>(_nodes.size()) - 1; i >= 0; i--) {
+        Node& node = _nodes[i];
+        glm::dvec4 sphere;
+        if (node.secondChild != -1) {
+            const Node& a = _nodes[i + 1];
+            const Node& b = _nodes[node.secondChild];
+            sphere = mergeSpheres(
+                glm::dvec4(a.center, a.radius),
+                glm::dvec4(b.center, b.radius)
+            );
+        }
+        else {
+            sphere = _spheres[_order[node.first]];
+            for (uint32_t j = node.first + 1; j < node.first + node.count; j++) {
+                sphere = mergeSpheres(sphere, _spheres[_order[j]]);
+            }
+        }
+        node.center = glm::dvec3(sphere);
+        node.radius = sphere.w;
+    }
+    _needsRefit = false;
+}
+
+double BoundingSphereHierarchy::totalRadius() const {
+    return std::accumulate(
+        _nodes.begin(),
+        _nodes.end(),
+        0.0,
+        [](double sum, const Node& node) { return sum + node.radius; }
+    );
+}
+
+SceneGraphNode* BoundingSphereHierarchy::queryableNode(uint32_t index) const {
+    SceneGraphNode* node = _cache.node(index);
+    return node && _cache.isActive(index) ? node : nullptr;
+}
+
+} // namespace openspace
@@ -79,13 +79,24 @@ const glm::dmat3& Rotation::matrix() const {
     return _cachedMatrix;
 }
 
+bool Rotation::isThreadSafe() const {
+    return true;
+}
+
 void Rotation::update(const UpdateData& data) {
     if (!_needsUpdate && (data.time.j2000Seconds() == _cachedTime)) {
+        _hasChanged = false;
         return;
     }
+    const glm::dmat3 oldMatrix = _cachedMatrix;
     _cachedMatrix = matrix(data);
     _cachedTime = data.time.j2000Seconds();
     _needsUpdate = false;
+    _hasChanged = oldMatrix != _cachedMatrix;
+}
+
+bool Rotation::hasChanged() const {
+    return _hasChanged;
 }
 
 } // namespace openspace
@@ -80,13 +80,24 @@ glm::dvec3 Scale::scaleValue() const {
     return _cachedScale;
 }
 
+bool Scale::isThreadSafe() const {
+    return true;
+}
+
 void Scale::update(const UpdateData& data) {
     if (!_needsUpdate && data.time.j2000Seconds() == _cachedTime) {
+        _hasChanged = false;
         return;
     }
+    const glm::dvec3 oldScale = _cachedScale;
     _cachedScale = scaleValue(data);
     _cachedTime = data.time.j2000Seconds();
     _needsUpdate = false;
+    _hasChanged = oldScale != _cachedScale;
+}
+
+bool Scale::hasChanged() const {
+    return _hasChanged;
 }
 
 } // namespace openspace
@@ -27,7 +27,6 @@
 #include <openspace/camera/camera.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/engine/globals.h>
-#include <openspace/engine/globalscallbacks.h>
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/events/event.h>
@@ -35,6 +34,7 @@
 #include <openspace/interaction/sessionrecording.h>
 #include <openspace/navigation/navigationhandler.h>
 #include <openspace/query/query.h>
+#include <openspace/rendering/renderable.h>
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/profile.h>
 #include <openspace/scene/scenegraphnode.h>
@@ -42,6 +42,8 @@
 #include <openspace/scene/sceneinitializer.h>
 #include <openspace/scripting/lualibrary.h>
 #include <openspace/scripting/scriptengine.h>
+#include <openspace/util/startupprofiler.h>
+#include <openspace/util/threadpool.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/opengl/programobject.h>
 #include <ghoul/logging/logmanager.h>
@@ -52,6 +54,9 @@
 #include <ghoul/misc/misc.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/opengl/ghoul_gl.h>
+#include <glm/gtc/matrix_access.hpp>
+#include <array>
+#include <bit>
 #include <string>
 #include <stack>
 
@@ -62,6 +67,94 @@ namespace {
     constexpr std::string_view KeyIdentifier = "Identifier";
     constexpr std::string_view KeyParent = "Parent";
 
+    // The minimum number of nodes that are handed to a worker thread as one job when
+    // updating the scene in parallel. Levels with fewer nodes are updated in one job
+    constexpr size_t MinNodesPerUpdateJob = 16;
+
+    // Calls the function \p func for all indices in [0, n), distributed across the
+    // threads of the \p pool, with the calling thread taking part in the work. If no pool
+    // is provided, all calls happen on the calling thread. This function returns when
+    // all calls have finished
+    template <typename Func>
+    void parallelFor(openspace::ThreadPool* pool, size_t n, const Func& func) {
+        auto runRange = [&func](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                func(i);
+            }
+        };
+
+        if (!pool) {
+            runRange(0, n);
+            return;
+        }
+
+        const size_t nWorkers = pool->numberOfThreads() + 1;
+        const size_t jobSize = std::max(
+            MinNodesPerUpdateJob,
+            (n + nWorkers - 1) / nWorkers
+        );
+        pool->parallelFor(0, n, jobSize, runRange);
+    }
+
+    constexpr openspace::properties::Property::PropertyInfo ParallelUpdateInfo = {
+        "ParallelUpdate",
+        "Parallel Update",
+        "If this value is enabled, the scene graph nodes are updated in parallel on a "
+        "number of worker threads. The nodes are grouped into levels in which no node "
+        "depends on any other node of the same level. Nodes whose Translation, Rotation, "
+        "or Scale is not thread-safe, as well as all Renderables that do not declare "
+        "their update as thread-safe, are still updated on the main thread",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FrustumCullingInfo = {
+        "FrustumCulling",
+        "Frustum Culling",
+        "If this value is enabled, scene graph nodes whose bounding sphere is completely "
+        "outside of the view frustum are not rendered. Nodes without a bounding sphere "
+        "and Renderables that do not support culling are always rendered",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo MinimumScreenSizeInfo = {
+        "MinimumScreenSize",
+        "Minimum Screen Size",
+        "The size in pixels that the bounding sphere of a scene graph node has to cover "
+        "on the screen for the node to be rendered. Renderables that draw their content "
+        "with a fixed size in pixels, such as point clouds, might disappear while they "
+        "are still visible if this value is larger than 0. This value is only used if "
+        "frustum culling is enabled",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo SortRenderBinsInfo = {
+        "SortRenderBins",
+        "Sort Render Bins",
+        "If this value is enabled, the scene graph nodes within the opaque render bin "
+        "are grouped by the type of their Renderable, which share shader programs and "
+        "OpenGL state, to reduce the number of state changes between nodes. The nodes "
+        "in the transparent and overlay render bins are instead sorted back to front. "
+        "If this value is disabled, the nodes are rendered in the order of the scene "
+        "graph",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    // Extracts the six clipping planes from the rows of the view projection matrix. The
+    // planes are normalized so that the signed distance of a point can be computed
+    std::array<glm::dvec4, 6> frustumPlanes(const glm::dmat4& viewProjection) {
+        const glm::dvec4 row0 = glm::row(viewProjection, 0);
+        const glm::dvec4 row1 = glm::row(viewProjection, 1);
+        const glm::dvec4 row2 = glm::row(viewProjection, 2);
+        const glm::dvec4 row3 = glm::row(viewProjection, 3);
+        std::array<glm::dvec4, 6> planes = {
+            row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2
+        };
+        for (glm::dvec4& plane : planes) {
+            plane /= glm::length(glm::dvec3(plane));
+        }
+        return planes;
+    }
+
 #ifdef TRACY_ENABLE
     constexpr const char* renderBinToString(int renderBin) {
         // Synced with Renderable::RenderBin
@@ -102,8 +195,20 @@ Scene::InvalidSceneError::InvalidSceneError(std::string msg, std::string comp)
 Scene::Scene(std::unique_ptr<SceneInitializer> initializer)
     : properties::PropertyOwner({"Scene", "Scene"})
     , _camera(std::make_unique<Camera>())
+    , _parallelUpdate(ParallelUpdateInfo, false)
+    , _frustumCulling(FrustumCullingInfo, true)
+    , _minimumScreenSize(MinimumScreenSizeInfo, 0.f, 0.f, 10.f)
+    , _sortRenderBins(SortRenderBinsInfo, false)
     , _initializer(std::move(initializer))
 {
+    addProperty(_parallelUpdate);
+    _frustumCulling.onChange([this]() { _visibleNodesDirty = true; });
+    addProperty(_frustumCulling);
+    _minimumScreenSize.onChange([this]() { _visibleNodesDirty = true; });
+    addProperty(_minimumScreenSize);
+    _sortRenderBins.onChange([this]() { _renderCandidatesDirty = true; });
+    addProperty(_sortRenderBins);
+
     _rootDummy.setIdentifier(SceneGraphNode::RootNodeIdentifier);
     _rootDummy.setScene(this);
 
@@ -155,6 +260,7 @@ void Scene::registerNode(SceneGraphNode* node) {
     _nodesByIdentifier[node->identifier()] = node;
     addPropertySubOwner(node);
     _dirtyNodeRegistry = true;
+    _renderCandidatesDirty = true;
     global::eventEngine->publishEvent<events::EventSceneGraphNodeAdded>(node);
 }
 
@@ -168,13 +274,20 @@ void Scene::unregisterNode(SceneGraphNode* node) {
         _topologicallySortedNodes.end()
     );
     _nodesByIdentifier.erase(node->identifier());
+    _nodesToInitializeGL.erase(
+        std::remove(_nodesToInitializeGL.begin(), _nodesToInitializeGL.end(), node),
+        _nodesToInitializeGL.end()
+    );
     // Just try to remove all properties; if the property doesn't exist, the
     // removeInterpolation will not do anything
     for (properties::Property* p : node->properties()) {
         removePropertyInterpolation(p);
     }
     removePropertySubOwner(node);
+    _transformCache.remove(node);
+    _boundingHierarchy.invalidateNodes();
     _dirtyNodeRegistry = true;
+    _renderCandidatesDirty = true;
     global::eventEngine->publishEvent<events::EventSceneGraphNodeRemoved>(node);
 }
 
@@ -260,6 +373,62 @@ void Scene::sortTopologically() {
     }
 
     _topologicallySortedNodes = nodes;
+    createUpdateLevels();
+}
+
+void Scene::createUpdateLevels() {
+    ZoneScoped;
+
+    // The level of a node is one higher than the highest level of its parent and all of
+    // its dependencies. Since the nodes are sorted topologically, all of these have
+    // already been assigned a level by the time we reach a node
+    std::unordered_map<const SceneGraphNode*, size_t> levels;
+    levels.reserve(_topologicallySortedNodes.size());
+    std::vector<UpdateLevel> updateLevels;
+    for (SceneGraphNode* node : _topologicallySortedNodes) {
+        size_t level = 0;
+        if (node->parent()) {
+            level = levels[node->parent()] + 1;
+        }
+        for (const SceneGraphNode* dep : node->dependencies()) {
+            level = std::max(level, levels[dep] + 1);
+        }
+        levels[node] = level;
+
+        if (updateLevels.size() <= level) {
+            updateLevels.resize(level + 1);
+        }
+        if (node->hasThreadSafeTransform()) {
+            updateLevels[level].parallelNodes.push_back(node);
+        }
+        else {
+            updateLevels[level].serialNodes.push_back(node);
+        }
+    }
+
+    // Each level occupies a contiguous range in the transform cache, which lets us
+    // compute all world transformations of a level in a single pass. Concatenating the
+    // levels results in an order that is still topologically sorted
+    std::vector<SceneGraphNode*> cacheOrder;
+    cacheOrder.reserve(_topologicallySortedNodes.size());
+    for (UpdateLevel& level : updateLevels) {
+        level.begin = static_cast<uint32_t>(cacheOrder.size());
+        cacheOrder.insert(
+            cacheOrder.end(),
+            level.parallelNodes.begin(),
+            level.parallelNodes.end()
+        );
+        cacheOrder.insert(
+            cacheOrder.end(),
+            level.serialNodes.begin(),
+            level.serialNodes.end()
+        );
+        level.end = static_cast<uint32_t>(cacheOrder.size());
+    }
+
+    _transformCache.rebuild(cacheOrder);
+    _boundingHierarchy.invalidateNodes();
+    _updateLevels = std::move(updateLevels);
 }
 
 void Scene::initializeNode(SceneGraphNode* node) {
@@ -270,25 +439,137 @@ bool Scene::isInitializing() const {
     return _initializer->isInitializing();
 }
 
-void Scene::update(const UpdateData& data) {
+void Scene::update(const UpdateData& data, UpdateRenderables updateRenderables) {
     ZoneScoped;
 
+    if (_dirtyNodeRegistry) {
+        updateNodeRegistry();
+    }
+
+    // The main thread participates in the update alongside the engine's workers
+    ThreadPool* pool = _parallelUpdate ? &global::openSpaceEngine->threadPool() : nullptr;
+
+    if (!updateRenderables) {
+        if (pool) {
+            for (const UpdateLevel& level : _updateLevels) {
+                updateTransforms(level, data, pool);
+            }
+        }
+        else {
+            updateSerially(data, UpdateRenderables::No);
+        }
+        _boundingHierarchy.invalidateTransforms();
+        _renderCandidatesDirty = true;
+        return;
+    }
+
     std::vector<SceneGraphNode*> initializedNodes = _initializer->takeInitializedNodes();
-    for (SceneGraphNode* node : initializedNodes) {
+    _nodesToInitializeGL.insert(
+        _nodesToInitializeGL.end(),
+        initializedNodes.begin(),
+        initializedNodes.end()
+    );
+
+    // Adding many nodes at once would stall the frame, so the OpenGL initialization is
+    // spread over multiple frames, but at least one node is initialized per frame
+    const FrameBudget& budget = global::openSpaceEngine->frameBudget();
+    bool isFirstNode = true;
+    while (!_nodesToInitializeGL.empty() && (isFirstNode || budget.hasTimeRemaining())) {
+        SceneGraphNode* node = _nodesToInitializeGL.front();
+        _nodesToInitializeGL.pop_front();
+        isFirstNode = false;
         try {
+            StartupProfiler::Scope scope(
+                StartupProfiler::Category::NodeInitializeGL,
+                node->identifier()
+            );
             node->initializeGL();
         }
         catch (const ghoul::RuntimeError& e) {
             LERRORC(e.component, e.message);
         }
     }
-    if (_dirtyNodeRegistry) {
-        updateNodeRegistry();
-    }
     _camera->setAtmosphereDimmingFactor(1.f);
+
+    if (!pool) {
+        updateSerially(data, UpdateRenderables::Yes);
+        _boundingHierarchy.invalidateTransforms();
+        _renderCandidatesDirty = true;
+        return;
+    }
+
+    // The nodes are updated one level at a time in three steps. First the local
+    // transformations of all nodes are updated, which are then combined into the world
+    // transformations in a single pass over the level. Lastly the renderables are
+    // updated, which might depend on the world transformation of their node
+    for (const UpdateLevel& level : _updateLevels) {
+        updateTransforms(level, data, pool);
+
+        if (pool) {
+            parallelFor(
+                pool,
+                level.parallelNodes.size(),
+                [this, &level, &data](size_t i) {
+                    SceneGraphNode* node = level.parallelNodes[i];
+                    const Renderable* renderable = node->renderable();
+                    if (!renderable || !renderable->hasThreadSafeUpdate() ||
+                        !_transformCache.isActive(level.begin + static_cast<uint32_t>(i)))
+                    {
+                        return;
+                    }
+
+                    try {
+                        node->updateRenderable(data);
+                    }
+                    catch (const ghoul::RuntimeError& e) {
+                        LERRORC(e.component, e.what());
+                    }
+                }
+            );
+        }
+
+        // All remaining renderables are updated on the main thread in topological order
+        const uint32_t endParallelNodes =
+            level.begin + static_cast<uint32_t>(level.parallelNodes.size());
+        for (uint32_t i = level.begin; i < level.end; i++) {
+            SceneGraphNode* node = _transformCache.node(i);
+            if (!node || !_transformCache.isActive(i)) {
+                continue;
+            }
+            const Renderable* renderable = node->renderable();
+            if (pool && i < endParallelNodes && renderable &&
+                renderable->hasThreadSafeUpdate())
+            {
+                // Already updated on a worker thread
+                continue;
+            }
+
+            try {
+                node->updateRenderable(data);
+            }
+            catch (const ghoul::RuntimeError& e) {
+                LERRORC(e.component, e.what());
+            }
+        }
+    }
+
+    _boundingHierarchy.invalidateTransforms();
+    _renderCandidatesDirty = true;
+}
+
+void Scene::updateSerially(const UpdateData& data, UpdateRenderables updateRenderables) {
+    // Some transformations, such as the FixedRotation, look up the world position of
+    // other nodes that are not registered as dependencies. Updating each node completely
+    // before moving on to the next one makes these lookups see the current frame's value
+    // for every node that comes earlier in the topological order
     for (SceneGraphNode* node : _topologicallySortedNodes) {
         try {
-            node->update(data);
+            if (updateRenderables) {
+                node->update(data);
+            }
+            else {
+                node->updateTransform(data);
+            }
         }
         catch (const ghoul::RuntimeError& e) {
             LERRORC(e.component, e.what());
@@ -296,6 +577,47 @@ void Scene::update(const UpdateData& data) {
     }
 }
 
+void Scene::updateTransforms(const UpdateLevel& level, const UpdateData& data,
+                             ThreadPool* pool)
+{
+    parallelFor(
+        pool,
+        level.parallelNodes.size(),
+        [&level, &data](size_t i) {
+            SceneGraphNode* node = level.parallelNodes[i];
+            try {
+                node->updateLocalTransform(data);
+            }
+            catch (const ghoul::RuntimeError& e) {
+                LERRORC(e.component, e.what());
+            }
+        }
+    );
+    // The parallel nodes come first in the level's range of the cache, so their world
+    // transformations are available to the serial nodes, which might look up the
+    // position of other nodes of the same level (for example the FixedRotation)
+    const uint32_t endParallelNodes =
+        level.begin + static_cast<uint32_t>(level.parallelNodes.size());
+    _transformCache.computeWorldTransforms(level.begin, endParallelNodes);
+
+    for (SceneGraphNode* node : level.serialNodes) {
+        try {
+            node->updateTransform(data);
+        }
+        catch (const ghoul::RuntimeError& e) {
+            LERRORC(e.component, e.what());
+        }
+    }
+}
+
+const WorldTransformCache& Scene::worldTransformCache() const {
+    return _transformCache;
+}
+
+BoundingSphereHierarchy& Scene::boundingSphereHierarchy() {
+    return _boundingHierarchy;
+}
+
 void Scene::render(const RenderData& data, RendererTasks& tasks) {
     ZoneScoped;
     ZoneName(
@@ -303,29 +625,186 @@ void Scene::render(const RenderData& data, RendererTasks& tasks) {
         strlen(renderBinToString(data.renderBinMask))
     );
 
-    for (SceneGraphNode* node : _topologicallySortedNodes) {
+    // This is a no-op for all but the first render bin of a frame, unless the camera
+    // changes between the bins
+    _transformCache.computeModelViewTransforms(
+        data.camera.positionVec3(),
+        data.camera.cameraRelativeViewMatrix()
+    );
+
+    updateVisibleNodes(data.camera);
+
+    // Masks that combine multiple bins, as well as the Sticker bin, have to go through
+    // all visible nodes
+    const unsigned int mask = static_cast<unsigned int>(data.renderBinMask);
+    const bool usesSingleBin = std::has_single_bit(mask) &&
+        mask != static_cast<unsigned int>(Renderable::RenderBin::Sticker);
+    const std::vector<SceneGraphNode*>& nodes = usesSingleBin ?
+        _visibleNodesPerBin[std::countr_zero(mask)] :
+        _visibleNodes;
+
+    for (SceneGraphNode* node : nodes) {
         try {
             node->render(data, tasks);
         }
         catch (const ghoul::RuntimeError& e) {
             LERRORC(e.component, e.what());
         }
-        if (global::callback::webBrowserPerformanceHotfix) {
-            (*global::callback::webBrowserPerformanceHotfix)();
+    }
+}
+
+bool Scene::updateRenderCandidates(const glm::dvec3& cameraPosition) {
+    ZoneScoped;
+
+    if (!_renderCandidatesDirty && cameraPosition == _renderCandidatesCameraPosition) {
+        return false;
+    }
+    _renderCandidatesDirty = false;
+    _renderCandidatesCameraPosition = cameraPosition;
+
+    _renderCandidates.clear();
+    for (std::vector<uint32_t>& indices : _renderCandidatesPerBin) {
+        indices.clear();
+    }
+    for (SceneGraphNode* node : _topologicallySortedNodes) {
+        const Renderable* renderable = node->renderable();
+        if (!renderable || !renderable->isVisible()) {
+            continue;
+        }
+
+        const uint32_t index = static_cast<uint32_t>(_renderCandidates.size());
+        _renderCandidates.push_back(node);
+        for (int bin = 0; bin < NRenderBins; bin++) {
+            const int mask = 1 << bin;
+            if (renderable->matchesRenderBinMask(mask) ||
+                renderable->matchesSecondaryRenderBin(mask))
+            {
+                _renderCandidatesPerBin[bin].push_back(index);
+            }
         }
     }
 
+    if (!_sortRenderBins) {
+        return true;
+    }
+
+    using RenderBin = Renderable::RenderBin;
+    auto binIndex = [](RenderBin bin) {
+        return std::countr_zero(static_cast<unsigned int>(bin));
+    };
+
+    // Renderables of the same type share their shader programs and most of their state.
+    // The sort is stable to keep the scene graph order within each type
+    std::vector<uint32_t>& opaque = _renderCandidatesPerBin[binIndex(RenderBin::Opaque)];
+    std::stable_sort(
+        opaque.begin(),
+        opaque.end(),
+        [this](uint32_t lhs, uint32_t rhs) {
+            return _renderCandidates[lhs]->renderable()->typeAsString() <
+                   _renderCandidates[rhs]->renderable()->typeAsString();
+        }
+    );
+
+    // Blending requires the transparent bins to be drawn back to front, which takes
+    // precedence over grouping the nodes by their state
+    struct NodeDistance {
+        uint32_t index;
+        double distance;
+    };
+    std::vector<NodeDistance> distances;
+    for (RenderBin bin : { RenderBin::PreDeferredTransparent, RenderBin::Overlay,
+                           RenderBin::PostDeferredTransparent })
     {
-        ZoneScopedN("Get Error Hack");
+        std::vector<uint32_t>& indices = _renderCandidatesPerBin[binIndex(bin)];
+        distances.clear();
+        distances.reserve(indices.size());
+        for (uint32_t index : indices) {
+            distances.push_back({
+                index,
+                glm::distance(_renderCandidates[index]->worldPosition(), cameraPosition)
+            });
+        }
+        std::stable_sort(
+            distances.begin(),
+            distances.end(),
+            [](const NodeDistance& lhs, const NodeDistance& rhs) {
+                return lhs.distance > rhs.distance;
+            }
+        );
+        for (size_t i = 0; i < indices.size(); i++) {
+            indices[i] = distances[i].index;
+        }
+    }
+    return true;
+}
+
+void Scene::updateVisibleNodes(const Camera& camera) {
+    ZoneScoped;
+
+    // The culling is done relative to the camera position to not lose any precision
+    const glm::dvec3 cameraPosition = camera.positionVec3();
+    const bool candidatesChanged = updateRenderCandidates(cameraPosition);
+
+    const glm::dmat4 viewProjection = glm::dmat4(camera.projectionMatrix()) *
+        camera.cameraRelativeViewMatrix();
+    if (!candidatesChanged && !_visibleNodesDirty &&
+        viewProjection == _visibleNodesViewProjection)
+    {
+        return;
+    }
+    _visibleNodesDirty = false;
+    _visibleNodesViewProjection = viewProjection;
+
+    const std::array<glm::dvec4, 6> planes = frustumPlanes(viewProjection);
+
+    // The projected radius of a sphere in pixels is its radius divided by its distance,
+    // multiplied by this factor, which is accurate close to the center of the screen
+    const double pixelScale = camera.projectionMatrix()[1][1] *
+        global::windowDelegate->currentDrawBufferResolution().y / 2.0;
+    const double minimumScreenSize = _minimumScreenSize;
+
+    auto isCulled = [&](const SceneGraphNode& node) {
+        if (!_frustumCulling || !node.renderable()->supportsCulling() ||
+            node.computesScreenSpaceValues())
+        {
+            return false;
+        }
+        const double radius = node.boundingSphere();
+        if (radius <= 0.0) {
+            return false;
+        }
+
+        const glm::dvec3 center = node.worldPosition() - cameraPosition;
+        for (const glm::dvec4& plane : planes) {
+            if (glm::dot(glm::dvec3(plane), center) + plane.w < -radius) {
+                return true;
+            }
+        }
+
+        const double distance = glm::length(center);
+        return distance > radius &&
+            radius / distance * pixelScale < minimumScreenSize;
+    };
 
-        // @TODO(abock 2019-08-19) This glGetError call is a hack to prevent the GPU
-        // thread and the CPU thread from diverging too much, particularly the uploading
-        // of a lot of textures for the globebrowsing planets can cause a hard stuttering
-        // effect. Asking for a glGetError after every rendering call will force the
-        // threads to implicitly synchronize and thus prevent the stuttering.  The better
-        // solution would be to reduce the number of uploads per frame, use a staggered
-        // buffer, or something else like that preventing a large spike in uploads
-        glGetError();
+    // Filtering the candidates keeps their order, so the lists end up sorted the same
+    // way as if the visible nodes had been sorted directly
+    _isCandidateCulled.resize(_renderCandidates.size());
+    _visibleNodes.clear();
+    for (size_t i = 0; i < _renderCandidates.size(); i++) {
+        SceneGraphNode* node = _renderCandidates[i];
+        _isCandidateCulled[i] = isCulled(*node);
+        if (!_isCandidateCulled[i]) {
+            _visibleNodes.push_back(node);
+        }
+    }
+    for (int bin = 0; bin < NRenderBins; bin++) {
+        std::vector<SceneGraphNode*>& nodes = _visibleNodesPerBin[bin];
+        nodes.clear();
+        for (uint32_t index : _renderCandidatesPerBin[bin]) {
+            if (!_isCandidateCulled[index]) {
+                nodes.push_back(_renderCandidates[index]);
+            }
+        }
     }
 }
 
@@ -454,13 +933,7 @@ void Scene::addPropertyInterpolation(properties::Property* prop, float durationS
     ghoul_precondition(prop != nullptr, "prop must not be nullptr");
     ghoul_precondition(durationSeconds > 0.f, "durationSeconds must be positive");
     ghoul_postcondition(
-        std::find_if(
-            _propertyInterpolationInfos.begin(),
-            _propertyInterpolationInfos.end(),
-            [prop](const PropertyInterpolationInfo& info) {
-                return info.prop == prop && !info.isExpired;
-            }
-        ) != _propertyInterpolationInfos.end(),
+        _propertyInterpolationIndices.find(prop) != _propertyInterpolationIndices.end(),
         "A new interpolation record exists for p that is not expired"
     );
 
@@ -469,51 +942,62 @@ void Scene::addPropertyInterpolation(properties::Property* prop, float durationS
         nullptr :
         ghoul::easingFunction<float>(easingFunction);
 
+    PropertyInterpolations& interpolations = _propertyInterpolations;
+
     // First check if the current property already has an interpolation information
     std::chrono::steady_clock::time_point now = currentTimeForInterpolation();
-    for (PropertyInterpolationInfo& info : _propertyInterpolationInfos) {
-        if (info.prop == prop) {
-            info.beginTime = now;
-            info.durationSeconds = durationSeconds;
-            info.postScript = std::move(postScript);
-            info.easingFunction = func;
-            // If we found it, we can break since we make sure that each property is only
-            // represented once in this
-            return;
-        }
+    auto it = _propertyInterpolationIndices.find(prop);
+    if (it != _propertyInterpolationIndices.end()) {
+        const size_t i = it->second;
+        interpolations.beginTimes[i] = now;
+        interpolations.durationSeconds[i] = durationSeconds;
+        interpolations.postScripts[i] = std::move(postScript);
+        interpolations.easingFunctions[i] = func;
+        return;
     }
 
-    PropertyInterpolationInfo i = {
-        .prop = prop,
-        .beginTime = now,
-        .durationSeconds = durationSeconds,
-        .postScript = std::move(postScript),
-        .easingFunction = func
-    };
-    _propertyInterpolationInfos.push_back(std::move(i));
+    _propertyInterpolationIndices[prop] = interpolations.props.size();
+    interpolations.props.push_back(prop);
+    interpolations.beginTimes.push_back(now);
+    interpolations.durationSeconds.push_back(durationSeconds);
+    interpolations.postScripts.push_back(std::move(postScript));
+    interpolations.easingFunctions.push_back(func);
 }
 
 void Scene::removePropertyInterpolation(properties::Property* prop) {
     ghoul_precondition(prop != nullptr, "prop must not be nullptr");
     ghoul_postcondition(
-        std::find_if(
-            _propertyInterpolationInfos.begin(),
-            _propertyInterpolationInfos.end(),
-            [prop](const PropertyInterpolationInfo& info) {
-                return info.prop == prop;
-            }
-        ) == _propertyInterpolationInfos.end(),
+        _propertyInterpolationIndices.find(prop) == _propertyInterpolationIndices.end(),
         "No interpolation record exists for prop"
     );
 
-    _propertyInterpolationInfos.erase(
-        std::remove_if(
-            _propertyInterpolationInfos.begin(),
-            _propertyInterpolationInfos.end(),
-            [prop](const PropertyInterpolationInfo& info) { return info.prop == prop; }
-        ),
-        _propertyInterpolationInfos.end()
-    );
+    auto it = _propertyInterpolationIndices.find(prop);
+    if (it != _propertyInterpolationIndices.end()) {
+        erasePropertyInterpolation(it->second);
+    }
+}
+
+void Scene::erasePropertyInterpolation(size_t index) {
+    PropertyInterpolations& interpolations = _propertyInterpolations;
+    ghoul_assert(index < interpolations.props.size(), "index out of range");
+
+    _propertyInterpolationIndices.erase(interpolations.props[index]);
+
+    const size_t last = interpolations.props.size() - 1;
+    if (index != last) {
+        interpolations.props[index] = interpolations.props[last];
+        interpolations.beginTimes[index] = interpolations.beginTimes[last];
+        interpolations.durationSeconds[index] = interpolations.durationSeconds[last];
+        interpolations.postScripts[index] = std::move(interpolations.postScripts[last]);
+        interpolations.easingFunctions[index] = interpolations.easingFunctions[last];
+        _propertyInterpolationIndices[interpolations.props[index]] = index;
+    }
+
+    interpolations.props.pop_back();
+    interpolations.beginTimes.pop_back();
+    interpolations.durationSeconds.pop_back();
+    interpolations.postScripts.pop_back();
+    interpolations.easingFunctions.pop_back();
 }
 
 void Scene::updateInterpolations() {
@@ -521,51 +1005,66 @@ void Scene::updateInterpolations() {
 
     using namespace std::chrono;
 
+    PropertyInterpolations& interpolations = _propertyInterpolations;
+    const size_t nInterpolations = interpolations.props.size();
+    if (nInterpolations == 0) {
+        return;
+    }
+
     steady_clock::time_point now = currentTimeForInterpolation();
-    // First, let's update the properties
-    for (PropertyInterpolationInfo& i : _propertyInterpolationInfos) {
-        long long us =
-            duration_cast<std::chrono::microseconds>(now - i.beginTime).count();
-
-        const float t = glm::clamp(
-            static_cast<float>(
-                static_cast<double>(us) /
-                static_cast<double>(i.durationSeconds * 1000000)
-            ),
-            0.f,
-            1.f
-        );
 
+    // First, compute the interpolation parameters of all properties in one pass
+    std::vector<float>& t = interpolations.t;
+    t.resize(nInterpolations);
+    for (size_t i = 0; i < nInterpolations; i++) {
+        const long long us =
+            duration_cast<microseconds>(now - interpolations.beginTimes[i]).count();
+        const double duration =
+            static_cast<double>(interpolations.durationSeconds[i]) * 1000000.0;
+        const float ti = static_cast<float>(static_cast<double>(us) / duration);
+        t[i] = glm::clamp(ti, 0.f, 1.f);
+    }
+
+    // Then apply the easing functions. Linear interpolations don't have a function and
+    // are passed through unchanged
+    std::vector<float>& easedT = interpolations.easedT;
+    easedT.resize(nInterpolations);
+    for (size_t i = 0; i < nInterpolations; i++) {
+        ghoul::EasingFunc<float> func = interpolations.easingFunctions[i];
+        easedT[i] = func ? func(t[i]) : t[i];
+    }
+
+    // With all values computed, notify the properties about their new values
+    for (size_t i = 0; i < nInterpolations; i++) {
         // @FRAGILE(abock): This method might crash if someone deleted the property
         //                  underneath us. We take care of removing entire PropertyOwners,
         //                  but we assume that Propertys live as long as their
         //                  SceneGraphNodes. This is true in general, but if Propertys are
         //                  created and destroyed often by the SceneGraphNode, this might
         //                  become a problem.
-        i.prop->interpolateValue(t, i.easingFunction);
-
-        i.isExpired = (t == 1.f);
+        interpolations.props[i]->interpolateValue(easedT[i]);
+    }
 
-        if (i.isExpired) {
-            if (!i.postScript.empty()) {
-                global::scriptEngine->queueScript(
-                    std::move(i.postScript),
-                    scripting::ScriptEngine::RemoteScripting::No
-                );
-            }
+    // Finally remove the expired interpolations. Iterating backwards means that the
+    // interpolation moved into an erased slot has already been checked
+    for (size_t i = nInterpolations; i > 0; i--) {
+        const size_t idx = i - 1;
+        if (t[idx] != 1.f) {
+            continue;
+        }
 
-            global::eventEngine->publishEvent<events::EventInterpolationFinished>(i.prop);
+        if (!interpolations.postScripts[idx].empty()) {
+            global::scriptEngine->queueScript(
+                std::move(interpolations.postScripts[idx]),
+                scripting::ScriptEngine::RemoteScripting::No
+            );
         }
-    }
 
-    _propertyInterpolationInfos.erase(
-        std::remove_if(
-            _propertyInterpolationInfos.begin(),
-            _propertyInterpolationInfos.end(),
-            [](const PropertyInterpolationInfo& i) { return i.isExpired; }
-        ),
-        _propertyInterpolationInfos.end()
-    );
+        global::eventEngine->publishEvent<events::EventInterpolationFinished>(
+            interpolations.props[idx]
+        );
+        erasePropertyInterpolation(idx);
+    }
 }
 
 void Scene::addInterestingTime(InterestingTime time) {
@@ -579,6 +1078,10 @@ const std::vector<Scene::InterestingTime>& Scene::interestingTimes() const {
 void Scene::setPropertiesFromProfile(const Profile& p) {
     ghoul::lua::LuaState L(ghoul::lua::LuaState::IncludeStandardLibrary::Yes);
 
+    // Related properties are often set together, so their callbacks only run once
+    properties::Property::beginChangeNotificationBatch();
+    defer { properties::Property::endChangeNotificationBatch(); };
+
     for (const Profile::Property& prop : p.properties) {
         if (prop.name.empty()) {
             LWARNING("Property name in profile was empty");
@@ -602,7 +1105,6 @@ void Scene::setPropertiesFromProfile(const Profile& p) {
         applyRegularExpression(
             L,
             uriOrRegex,
-            allProperties(),
             0.0,
             groupName,
             ghoul::EasingFunction::Linear,
@@ -773,7 +1275,7 @@ PropertyValueType Scene::propertyValueType(const std::string& value) {
 std::vector<properties::Property*> Scene::propertiesMatchingRegex(
                                                               std::string propertyString)
 {
-    return findMatchesInAllProperties(propertyString, allProperties(), "");
+    return findMatchesInAllProperties(propertyString, "");
 }
 
 std::vector<std::string> Scene::allTags() {
@@ -857,6 +1359,8 @@ scripting::LuaLibrary Scene::luaLibrary() {
                 "Deprecated in favor of the 'propertyValue' function",
                 {}
             },
+            codegen::lua::BeginPropertyBatch,
+            codegen::lua::EndPropertyBatch,
             codegen::lua::HasProperty,
             codegen::lua::PropertyDeprecated,
             codegen::lua::Property,
@@ -875,6 +1379,9 @@ scripting::LuaLibrary Scene::luaLibrary() {
             codegen::lua::SetParent,
             codegen::lua::BoundingSphere,
             codegen::lua::InteractionSphere,
+            codegen::lua::NodesAlongRay,
+            codegen::lua::NearestNode,
+            codegen::lua::NodesInView,
             codegen::lua::MakeIdentifier
         }
     };
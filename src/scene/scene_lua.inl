@@ -56,6 +56,8 @@
 #include <openspace/rendering/screenspacerenderable.h>
 #include <algorithm>
 #include <cctype>
+#include <mutex>
+#include <unordered_map>
 
 namespace {
 
@@ -86,119 +88,174 @@ openspace::properties::PropertyOwner* findPropertyOwnerWithMatchingGroupTag(T* p
     return tagMatchOwner;
 }
 
-std::vector<openspace::properties::Property*> findMatchesInAllProperties(
-                                                                const std::string& regex,
-                         const std::vector<openspace::properties::Property*>& properties,
-                                                            const std::string& groupName)
+// A parsed property regular expression together with the properties that matched it
+// the last time it was used. The matches stay valid until any of the property trees
+// change, which is tracked through PropertyOwner::treeVersion
+struct PropertySelector {
+    std::string nodeName;
+    std::string propertyName;
+    std::string groupName;
+    bool isLiteral = false;
+
+    uint64_t treeVersion = 0;
+    bool hasMatches = false;
+    std::vector<openspace::properties::Property*> matches;
+};
+
+// Maximum number of selectors that are kept around. Show scripts tend to reuse the same
+// few dozen expressions, so the cache is just cleared when it overflows
+constexpr size_t MaxCachedSelectors = 256;
+
+bool isSelectorMatch(const PropertySelector& selector, std::string_view id,
+                     openspace::properties::Property* prop)
 {
     using namespace openspace;
 
-    std::vector<properties::Property*> matches;
-    const bool isGroupMode = !groupName.empty();
-    bool isLiteral = false;
+    const bool isGroupMode = !selector.groupName.empty();
+    const std::string& propertyName = selector.propertyName;
+    const std::string& nodeName = selector.nodeName;
 
-    // Extract the property and node name to be searched for from regex
-    std::string propertyName;
-    std::string nodeName;
-    size_t wildPos = regex.find_first_of("*");
-    if (wildPos != std::string::npos) {
-        nodeName = regex.substr(0, wildPos);
-        propertyName = regex.substr(wildPos + 1, regex.length());
+    if (!propertyName.empty()) {
+        size_t propertyPos = id.find(propertyName);
+        if (propertyPos == std::string_view::npos) {
+            return false;
+        }
 
-        // If none then malformed regular expression
-        if (propertyName.empty() && nodeName.empty()) {
-            LERRORC(
-                "findMatchesInAllProperties",
-                fmt::format(
-                    "Malformed regular expression: '{}': Empty both before and after '*'",
-                    regex
-                )
-            );
-            return matches;
+        // Check that the propertyName fully matches the property in id
+        if ((propertyPos + propertyName.length() + 1) < id.length()) {
+            return false;
         }
 
-        // Currently do not support several wildcards
-        if (regex.find_first_of("*", wildPos + 1) != std::string::npos) {
-            LERRORC(
-                "findMatchesInAllProperties",
-                fmt::format(
-                    "Malformed regular expression: '{}': Currently only one '*' is "
-                    "supported", regex
-                )
-            );
-            return matches;
+        // Match node name
+        if (!nodeName.empty() && id.find(nodeName) == std::string_view::npos) {
+            return false;
         }
-    }
-    // Literal or tag
-    else {
-        propertyName = regex;
-        if (!isGroupMode) {
-            isLiteral = true;
+
+        // Check tag
+        if (isGroupMode) {
+            if (!findPropertyOwnerWithMatchingGroupTag(prop, selector.groupName)) {
+                return false;
+            }
         }
     }
+    else if (!nodeName.empty()) {
+        size_t nodePos = id.find(nodeName);
+        if (nodePos == std::string_view::npos) {
+            return false;
+        }
 
-    // Stores whether we found at least one matching property. If this is false at the end
-    // of the loop, the property name regex was probably misspelled.
-    for (properties::Property* prop : properties) {
-        // Check the regular expression for all properties
-        const std::string id = prop->fullyQualifiedIdentifier();
-
-        if (isLiteral && id != propertyName) {
-            continue;
+        // Check tag
+        if (isGroupMode) {
+            if (!findPropertyOwnerWithMatchingGroupTag(prop, selector.groupName)) {
+                return false;
+            }
         }
-        else if (!propertyName.empty()) {
-            size_t propertyPos = id.find(propertyName);
-            if (propertyPos != std::string::npos) {
-                // Check that the propertyName fully matches the property in id
-                if ((propertyPos + propertyName.length() + 1) < id.length()) {
-                    continue;
-                }
+        // Check that the nodeName fully matches the node in id
+        else if (nodePos != 0) {
+            return false;
+        }
+    }
+    return true;
+}
 
-                // Match node name
-                if (!nodeName.empty() && id.find(nodeName) == std::string::npos) {
-                    continue;
-                }
+std::vector<openspace::properties::Property*> findMatchesInAllProperties(
+                                                                const std::string& regex,
+                                                            const std::string& groupName)
+{
+    using namespace openspace;
 
-                // Check tag
-                if (isGroupMode) {
-                    properties::PropertyOwner* matchingTaggedOwner =
-                        findPropertyOwnerWithMatchingGroupTag(prop, groupName);
-                    if (!matchingTaggedOwner) {
-                        continue;
-                    }
-                }
+    static std::mutex cacheMutex;
+    static std::unordered_map<std::string, PropertySelector> cache;
+
+    std::lock_guard lock(cacheMutex);
+
+    // The group name can't contain a '}', which makes this key unique
+    std::string key = fmt::format("{}}}{}", groupName, regex);
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        PropertySelector selector;
+        selector.groupName = groupName;
+
+        // Extract the property and node name to be searched for from regex
+        size_t wildPos = regex.find_first_of("*");
+        if (wildPos != std::string::npos) {
+            selector.nodeName = regex.substr(0, wildPos);
+            selector.propertyName = regex.substr(wildPos + 1, regex.length());
+
+            // If none then malformed regular expression
+            if (selector.propertyName.empty() && selector.nodeName.empty()) {
+                LERRORC(
+                    "findMatchesInAllProperties",
+                    fmt::format(
+                        "Malformed regular expression: '{}': Empty both before and "
+                        "after '*'",
+                        regex
+                    )
+                );
+                return {};
             }
-            else {
-                continue;
+
+            // Currently do not support several wildcards
+            if (regex.find_first_of("*", wildPos + 1) != std::string::npos) {
+                LERRORC(
+                    "findMatchesInAllProperties",
+                    fmt::format(
+                        "Malformed regular expression: '{}': Currently only one '*' is "
+                        "supported", regex
+                    )
+                );
+                return {};
             }
         }
-        else if (!nodeName.empty()) {
-            size_t nodePos = id.find(nodeName);
-            if (nodePos != std::string::npos) {
-                // Check tag
-                if (isGroupMode) {
-                    properties::PropertyOwner* matchingTaggedOwner =
-                        findPropertyOwnerWithMatchingGroupTag(prop, groupName);
-                    if (!matchingTaggedOwner) {
-                        continue;
-                    }
-                }
-                // Check that the nodeName fully matches the node in id
-                else if (nodePos != 0) {
-                    continue;
+        // Literal or tag
+        else {
+            selector.propertyName = regex;
+            selector.isLiteral = groupName.empty();
+        }
+
+        if (cache.size() >= MaxCachedSelectors) {
+            cache.clear();
+        }
+        it = cache.emplace(std::move(key), std::move(selector)).first;
+    }
+
+    PropertySelector& selector = it->second;
+    const uint64_t version = properties::PropertyOwner::treeVersion();
+    if (selector.hasMatches && selector.treeVersion == version) {
+        return selector.matches;
+    }
+
+    selector.matches.clear();
+    if (selector.isLiteral) {
+        // A literal can be looked up directly in the URI index
+        properties::Property* prop = openspace::property(selector.propertyName);
+        if (prop) {
+            selector.matches.push_back(prop);
+        }
+    }
+    else {
+        std::vector<std::pair<std::string_view, properties::Property*>> matches;
+        global::rootPropertyOwner->forEachProperty(
+            [&selector, &matches](std::string_view id, properties::Property* prop) {
+                if (isSelectorMatch(selector, id, prop)) {
+                    matches.emplace_back(id, prop);
                 }
             }
-            else {
-                continue;
-            }
+        );
+
+        // The index is unordered, so we sort the matches to have a stable order
+        std::sort(matches.begin(), matches.end());
+        selector.matches.reserve(matches.size());
+        for (const std::pair<std::string_view, properties::Property*>& m : matches) {
+            selector.matches.push_back(m.second);
         }
-        matches.push_back(prop);
     }
-    return matches;
+    selector.treeVersion = version;
+    selector.hasMatches = true;
+    return selector.matches;
 }
 
 void applyRegularExpression(lua_State* L, const std::string& regex,
-                          const std::vector<openspace::properties::Property*>& properties,
                                                              double interpolationDuration,
                                                              const std::string& groupName,
                                                      ghoul::EasingFunction easingFunction,
@@ -212,7 +269,6 @@ void applyRegularExpression(lua_State* L, const std::string& regex,
 
     std::vector<properties::Property*> matchingProps = findMatchesInAllProperties(
         regex,
-        properties,
         groupName
     );
 
@@ -441,7 +497,6 @@ int propertySetValue(lua_State* L) {
         applyRegularExpression(
             L,
             uriOrRegex,
-            allProperties(),
             interpolationDuration,
             groupName,
             easingMethod,
@@ -486,6 +541,28 @@ int propertyGetValueDeprecated(lua_State* L) {
 
 namespace {
 
+/**
+ * Starts a batch of property changes. Until the matching endPropertyBatch call, the
+ * onChange callbacks of changed properties are deferred and each property's callbacks
+ * run only once when the batch ends. Batches can be nested, and batches that are still
+ * open at the end of a frame are closed automatically.
+ */
+[[codegen::luawrap]] void beginPropertyBatch() {
+    openspace::properties::Property::beginChangeNotificationBatch();
+}
+
+/**
+ * Ends a batch of property changes that was started with beginPropertyBatch. Ending the
+ * outermost batch invokes the deferred onChange callbacks of all changed properties.
+ */
+[[codegen::luawrap]] void endPropertyBatch() {
+    using namespace openspace::properties;
+    if (!Property::isBatchingChangeNotifications()) {
+        throw ghoul::lua::LuaError("No property batch has been started");
+    }
+    Property::endChangeNotificationBatch();
+}
+
 /**
  * Returns whether a property with the given URI exists
  */
@@ -506,17 +583,11 @@ namespace {
         regex = removeGroupNameFromUri(regex);
     }
 
-    // Extract the property and node name to be searched for from regex
-    bool isLiteral = false;
-    std::string propertyName;
-    std::string nodeName;
+    // Check the regex here to report malformed expressions as Lua errors
     size_t wildPos = regex.find_first_of("*");
     if (wildPos != std::string::npos) {
-        nodeName = regex.substr(0, wildPos);
-        propertyName = regex.substr(wildPos + 1, regex.length());
-
         // If none then malformed regular expression
-        if (propertyName.empty() && nodeName.empty()) {
+        if (regex.length() == 1) {
             throw ghoul::lua::LuaError(fmt::format(
                 "Malformed regular expression: '{}': Empty both before and after '*'",
                 regex
@@ -531,73 +602,14 @@ namespace {
             ));
         }
     }
-    // Literal or tag
-    else {
-        propertyName = regex;
-        if (groupName.empty()) {
-            isLiteral = true;
-        }
-    }
 
     // Get all matching property uris and save to res
-    std::vector<properties::Property*> props = allProperties();
+    std::vector<properties::Property*> props =
+        findMatchesInAllProperties(regex, groupName);
     std::vector<std::string> res;
+    res.reserve(props.size());
     for (properties::Property* prop : props) {
-        // Check the regular expression for all properties
-        const std::string& id = prop->fullyQualifiedIdentifier();
-
-        if (isLiteral && id != propertyName) {
-            continue;
-        }
-        else if (!propertyName.empty()) {
-            size_t propertyPos = id.find(propertyName);
-            if (propertyPos != std::string::npos) {
-                // Check that the propertyName fully matches the property in id
-                if ((propertyPos + propertyName.length() + 1) < id.length()) {
-                    continue;
-                }
-
-                // Match node name
-                if (!nodeName.empty() && id.find(nodeName) == std::string::npos) {
-                    continue;
-                }
-
-                // Check tag
-                if (!groupName.empty()) {
-                    properties::PropertyOwner* matchingTaggedOwner =
-                        findPropertyOwnerWithMatchingGroupTag(prop, groupName);
-                    if (!matchingTaggedOwner) {
-                        continue;
-                    }
-                }
-            }
-            else {
-                continue;
-            }
-        }
-        else if (!nodeName.empty()) {
-            size_t nodePos = id.find(nodeName);
-            if (nodePos != std::string::npos) {
-
-                // Check tag
-                if (!groupName.empty()) {
-                    properties::PropertyOwner* matchingTaggedOwner =
-                        findPropertyOwnerWithMatchingGroupTag(prop, groupName);
-                    if (!matchingTaggedOwner) {
-                        continue;
-                    }
-                }
-                // Check that the nodeName fully matches the node in id
-                else if (nodePos != 0) {
-                    continue;
-                }
-            }
-            else {
-                continue;
-            }
-        }
-
-        res.push_back(id);
+        res.push_back(prop->fullyQualifiedIdentifier());
     }
 
     return res;
@@ -1024,6 +1036,68 @@ namespace {
     return is;
 }
 
+/**
+ * Returns the identifiers of the scene graph nodes whose bounding spheres are hit by the
+ * ray starting at the world position `origin` in the `direction`, ordered by increasing
+ * distance from the origin.
+ */
+[[codegen::luawrap]] std::vector<std::string> nodesAlongRay(glm::dvec3 origin,
+                                                            glm::dvec3 direction)
+{
+    using namespace openspace;
+    if (glm::length(direction) == 0.0) {
+        throw ghoul::lua::LuaError("The direction of the ray must not be zero");
+    }
+
+    std::vector<BoundingSphereHierarchy::RayHit> hits =
+        global::renderEngine->scene()->boundingSphereHierarchy().intersectRay(
+            origin,
+            direction
+        );
+    std::vector<std::string> res;
+    res.reserve(hits.size());
+    for (const BoundingSphereHierarchy::RayHit& hit : hits) {
+        res.push_back(hit.node->identifier());
+    }
+    return res;
+}
+
+/**
+ * Returns the identifier of the scene graph node whose bounding sphere has the closest
+ * surface to the provided world position, or an empty string if the scene is empty.
+ */
+[[codegen::luawrap]] std::string nearestNode(glm::dvec3 position) {
+    using namespace openspace;
+    SceneGraphNode* node =
+        global::renderEngine->scene()->boundingSphereHierarchy().nearestNode(position);
+    return node ? node->identifier() : "";
+}
+
+/**
+ * Returns the identifiers of the scene graph nodes whose bounding spheres are at least
+ * partially inside the view frustum of the camera.
+ */
+[[codegen::luawrap]] std::vector<std::string> nodesInView() {
+    using namespace openspace;
+    Scene* scene = global::renderEngine->scene();
+    const Camera* camera = scene->camera();
+    if (!camera) {
+        throw ghoul::lua::LuaError("No camera available");
+    }
+
+    const glm::dmat4 viewProjection =
+        glm::dmat4(camera->sgctInternal.projectionMatrix()) *
+        camera->combinedViewMatrix();
+    std::vector<SceneGraphNode*> nodes =
+        scene->boundingSphereHierarchy().nodesInFrustum(viewProjection);
+    std::vector<std::string> res;
+    res.reserve(nodes.size());
+    for (SceneGraphNode* node : nodes) {
+        res.push_back(node->identifier());
+    }
+    return res;
+}
+
 template <typename T>
 void createCustomProperty(openspace::properties::Property::PropertyInfo info,
                           std::optional<std::string> onChange)
@@ -28,6 +28,7 @@
 #include <modules/base/rotation/staticrotation.h>
 #include <modules/base/translation/statictranslation.h>
 #include <openspace/documentation/documentation.h>
+#include <openspace/engine/configuration.h>
 #include <openspace/engine/globals.h>
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/rendering/helper.h>
@@ -35,6 +36,7 @@
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scene.h>
 #include <openspace/scene/timeframe.h>
+#include <openspace/scene/worldtransformcache.h>
 #include <openspace/util/memorymanager.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -592,20 +594,47 @@ void SceneGraphNode::initialize() {
 
     LDEBUG(fmt::format("Initializing: {}", identifier()));
 
-    if (_renderable) {
+    const bool shouldDefer = global::configuration->useLazyRenderableInitialization &&
+        _renderable && !_renderable->isEnabled() &&
+        _renderableState == RenderableState::Uninitialized;
+
+    if (shouldDefer) {
+        LDEBUG(fmt::format("Deferring initialization of renderable: {}", identifier()));
+        _renderableState = RenderableState::Deferred;
+        _renderable->onEnabledChange([this](bool isEnabled) {
+            RenderableState expected = RenderableState::Deferred;
+            const bool shouldInitialize = isEnabled && _scene &&
+                _renderableState.compare_exchange_strong(
+                    expected,
+                    RenderableState::Initializing
+                );
+            if (shouldInitialize) {
+                // The scene initializer calls this node's initialize function and then
+                // initializeGL once that has finished, which only initializes the
+                // renderable as the rest of the node has already been initialized
+                _scene->initializeNode(this);
+            }
+        });
+    }
+    else if (_renderable && _renderableState != RenderableState::Initialized &&
+             _renderableState != RenderableState::GLInitialized)
+    {
         _renderable->initialize();
+        _renderableState = RenderableState::Initialized;
     }
 
-    if (_transform.translation) {
-        _transform.translation->initialize();
-    }
-    if (_transform.rotation) {
-        _transform.rotation->initialize();
-    }
-    if (_transform.scale) {
-        _transform.scale->initialize();
+    if (_state == State::Loaded) {
+        if (_transform.translation) {
+            _transform.translation->initialize();
+        }
+        if (_transform.rotation) {
+            _transform.rotation->initialize();
+        }
+        if (_transform.scale) {
+            _transform.scale->initialize();
+        }
+        _state = State::Initialized;
     }
-    _state = State::Initialized;
 
     LDEBUG(fmt::format("Finished initializing: {}", identifier()));
 }
@@ -616,8 +645,9 @@ void SceneGraphNode::initializeGL() {
 
     LDEBUG(fmt::format("Initializing GL: {}", identifier()));
 
-    if (_renderable) {
+    if (_renderable && _renderableState == RenderableState::Initialized) {
         _renderable->initializeGL();
+        _renderableState = RenderableState::GLInitialized;
     }
 
     // The first one to get here will create program shared between all scene graph nodes
@@ -651,7 +681,9 @@ void SceneGraphNode::deinitialize() {
 
     setScene(nullptr);
 
-    if (_renderable) {
+    if (_renderable && (_renderableState == RenderableState::Initialized ||
+                        _renderableState == RenderableState::GLInitialized))
+    {
         _renderable->deinitialize();
     }
     clearChildren();
@@ -666,7 +698,7 @@ void SceneGraphNode::deinitializeGL() {
 
     LDEBUG(fmt::format("Deinitializing GL: {}", identifier()));
 
-    if (_renderable) {
+    if (_renderable && _renderableState == RenderableState::GLInitialized) {
         _renderable->deinitializeGL();
     }
 
@@ -691,12 +723,33 @@ void SceneGraphNode::update(const UpdateData& data) {
     ZoneScoped;
     ZoneName(identifier().c_str(), identifier().size());
 
+    const bool isActive = updateTransform(data);
+    if (isActive) {
+        updateRenderable(data);
+    }
+}
+
+bool SceneGraphNode::updateTransform(const UpdateData& data) {
+    const bool isActive = updateLocalTransform(data);
+    if (isActive && _transformCache) {
+        _transformCache->computeWorldTransform(_transformIndex);
+    }
+    return isActive;
+}
+
+bool SceneGraphNode::updateLocalTransform(const UpdateData& data) {
     State s = _state;
     if (s != State::Initialized && _state != State::GLInitialized) {
-        return;
+        if (_transformCache) {
+            _transformCache->setInactive(_transformIndex);
+        }
+        return false;
     }
     if (!isTimeFrameActive(data.time)) {
-        return;
+        if (_transformCache) {
+            _transformCache->setInactive(_transformIndex);
+        }
+        return false;
     }
 
     if (_transform.translation) {
@@ -710,38 +763,64 @@ void SceneGraphNode::update(const UpdateData& data) {
     if (_transform.scale) {
         _transform.scale->update(data);
     }
-    UpdateData newUpdateData = data;
+
+    if (_transformCache) {
+        const bool hasChanged =
+            (_transform.translation && _transform.translation->hasChanged()) ||
+            (_transform.rotation && _transform.rotation->hasChanged()) ||
+            (_transform.scale && _transform.scale->hasChanged());
+
+        _transformCache->setLocalTransform(
+            _transformIndex,
+            position(),
+            rotationMatrix(),
+            scale(),
+            hasChanged
+        );
+        return true;
+    }
 
     // Assumes _worldRotationCached and _worldScaleCached have been calculated for parent
     _worldPositionCached = calculateWorldPosition();
     _worldRotationCached = calculateWorldRotation();
     _worldScaleCached = calculateWorldScale();
 
-    newUpdateData.modelTransform.translation = _worldPositionCached;
-    newUpdateData.modelTransform.rotation = _worldRotationCached;
-    newUpdateData.modelTransform.scale = _worldScaleCached;
-
-    glm::dmat4 translation = glm::translate(
-        glm::dmat4(1.0),
-        newUpdateData.modelTransform.translation
-    );
-    glm::dmat4 rotation = glm::dmat4(newUpdateData.modelTransform.rotation);
-    glm::dmat4 scaling = glm::scale(glm::dmat4(1.0), newUpdateData.modelTransform.scale);
+    glm::dmat4 translation = glm::translate(glm::dmat4(1.0), _worldPositionCached);
+    glm::dmat4 rotation = glm::dmat4(_worldRotationCached);
+    glm::dmat4 scaling = glm::scale(glm::dmat4(1.0), _worldScaleCached);
 
     _modelTransformCached = translation * rotation * scaling;
+    return true;
+}
 
-    if (_renderable && _renderable->isReady() &&
+void SceneGraphNode::updateRenderable(const UpdateData& data) {
+    const RenderableState state = _renderableState;
+    const bool isInitialized = state == RenderableState::Initialized ||
+                               state == RenderableState::GLInitialized;
+    if (_renderable && isInitialized && _renderable->isReady() &&
         (_renderable->isEnabled() || _renderable->shouldUpdateIfDisabled()))
     {
+        UpdateData newUpdateData = data;
+        newUpdateData.modelTransform.translation = worldPosition();
+        newUpdateData.modelTransform.rotation = worldRotationMatrix();
+        newUpdateData.modelTransform.scale = worldScale();
         _renderable->update(newUpdateData);
     }
 }
 
+bool SceneGraphNode::hasThreadSafeTransform() const {
+    return (!_transform.translation || _transform.translation->isThreadSafe()) &&
+           (!_transform.rotation || _transform.rotation->isThreadSafe()) &&
+           (!_transform.scale || _transform.scale->isThreadSafe());
+}
+
 void SceneGraphNode::render(const RenderData& data, RendererTasks& tasks) {
     ZoneScoped;
     ZoneName(identifier().c_str(), identifier().size());
 
-    if (_state != State::GLInitialized) {
+    if (_state != State::GLInitialized ||
+        _renderableState != RenderableState::GLInitialized)
+    {
         return;
     }
 
@@ -761,10 +840,19 @@ void SceneGraphNode::render(const RenderData& data, RendererTasks& tasks) {
         .time = data.time,
         .renderBinMask = data.renderBinMask,
         .modelTransform = {
-            .translation = _worldPositionCached,
-            .rotation = _worldRotationCached,
-            .scale = _worldScaleCached
-        }
+            .translation = worldPosition(),
+            .rotation = worldRotationMatrix(),
+            .scale = worldScale()
+        },
+        .modelViewTransform = _transformCache ?
+            _transformCache->modelViewTransform(_transformIndex) :
+            WorldTransformCache::modelViewTransform(
+                worldPosition(),
+                worldRotationMatrix(),
+                worldScale(),
+                data.camera.positionVec3(),
+                data.camera.cameraRelativeViewMatrix()
+            )
     };
 
     if (_renderable->matchesSecondaryRenderBin(data.renderBinMask)) {
@@ -798,10 +886,10 @@ void SceneGraphNode::render(const RenderData& data, RendererTasks& tasks) {
 
 void SceneGraphNode::renderDebugSphere(const Camera& camera, double size, glm::vec4 color)
 {
-    glm::dvec3 scaleVec = _worldScaleCached * size;
+    glm::dvec3 scaleVec = worldScale() * size;
     glm::dmat4 modelTransform =
-        glm::translate(glm::dmat4(1.0), _worldPositionCached) *
-        glm::dmat4(_worldRotationCached) *
+        glm::translate(glm::dmat4(1.0), worldPosition()) *
+        glm::dmat4(worldRotationMatrix()) *
         glm::scale(glm::dmat4(1.0), scaleVec);
 
     glm::mat4 modelViewProjection = camera.projectionMatrix() *
@@ -970,7 +1058,7 @@ void SceneGraphNode::computeScreenSpaceData(RenderData& newData) {
 
     // Calculate ndc
     const Camera& cam = newData.camera;
-    const glm::dvec3& worldPos = _worldPositionCached;
+    const glm::dvec3 worldPos = worldPosition();
     const glm::dvec4 clipSpace = glm::dmat4(cam.projectionMatrix()) *
                                  cam.combinedViewMatrix() * glm::vec4(worldPos, 1.0);
     const glm::dvec2 worldPosNDC = glm::dvec2(clipSpace / clipSpace.w);
@@ -1078,19 +1166,39 @@ glm::dvec3 SceneGraphNode::scale() const {
 }
 
 glm::dvec3 SceneGraphNode::worldPosition() const {
-    return _worldPositionCached;
+    return _transformCache ?
+        _transformCache->worldPosition(_transformIndex) :
+        _worldPositionCached;
 }
 
 const glm::dmat3& SceneGraphNode::worldRotationMatrix() const {
-    return _worldRotationCached;
+    return _transformCache ?
+        _transformCache->worldRotation(_transformIndex) :
+        _worldRotationCached;
 }
 
 glm::dmat4 SceneGraphNode::modelTransform() const {
-    return _modelTransformCached;
+    return _transformCache ?
+        _transformCache->modelTransform(_transformIndex) :
+        _modelTransformCached;
 }
 
 glm::dvec3 SceneGraphNode::worldScale() const {
-    return _worldScaleCached;
+    return _transformCache ?
+        _transformCache->worldScale(_transformIndex) :
+        _worldScaleCached;
+}
+
+void SceneGraphNode::setWorldTransformCache(WorldTransformCache* cache, uint32_t index) {
+    // Preserve the current world transformation locally so that it stays valid while
+    // the node is not part of any cache
+    _worldPositionCached = worldPosition();
+    _worldRotationCached = worldRotationMatrix();
+    _worldScaleCached = worldScale();
+    _modelTransformCached = modelTransform();
+
+    _transformCache = cache;
+    _transformIndex = index;
 }
 
 std::string SceneGraphNode::guiPath() const {
@@ -1101,6 +1209,10 @@ bool SceneGraphNode::hasGuiHintHidden() const {
     return _guiHidden;
 }
 
+bool SceneGraphNode::computesScreenSpaceValues() const {
+    return _computeScreenSpaceValues;
+}
+
 glm::dvec3 SceneGraphNode::calculateWorldPosition() const {
     // recursive up the hierarchy if there are parents available
     if (_parent) {
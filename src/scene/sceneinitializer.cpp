@@ -28,11 +28,16 @@
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/rendering/loadingscreen.h>
 #include <openspace/scene/scenegraphnode.h>
+#include <openspace/util/startupprofiler.h>
 #include <ghoul/logging/logmanager.h>
 
 namespace openspace {
 
 void SingleThreadedSceneInitializer::initializeNode(SceneGraphNode* node) {
+    StartupProfiler::Scope scope(
+        StartupProfiler::Category::NodeInitialize,
+        node->identifier()
+    );
     node->initialize();
     _initializedNodes.push_back(node);
 }
@@ -66,6 +71,10 @@ void MultiThreadedSceneInitializer::initializeNode(SceneGraphNode* node) {
         }
 
         try {
+            StartupProfiler::Scope scope(
+                StartupProfiler::Category::NodeInitialize,
+                node->identifier()
+            );
             node->initialize();
         }
         catch (const ghoul::RuntimeError& e) {
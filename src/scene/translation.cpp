@@ -71,6 +71,7 @@ bool Translation::initialize() {
 
 void Translation::update(const UpdateData& data) {
     if (!_needsUpdate && data.time.j2000Seconds() == _cachedTime) {
+        _hasChanged = false;
         return;
     }
     const glm::dvec3 oldPosition = _cachedPosition;
@@ -78,11 +79,20 @@ void Translation::update(const UpdateData& data) {
     _cachedTime = data.time.j2000Seconds();
     _needsUpdate = false;
 
-    if (oldPosition != _cachedPosition) {
+    _hasChanged = oldPosition != _cachedPosition;
+    if (_hasChanged) {
         notifyObservers();
     }
 }
 
+bool Translation::hasChanged() const {
+    return _hasChanged;
+}
+
+bool Translation::isThreadSafe() const {
+    return true;
+}
+
 glm::dvec3 Translation::position() const {
     return _cachedPosition;
 }
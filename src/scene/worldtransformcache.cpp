@@ -0,0 +1,297 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/scene/worldtransformcache.h>
+
+#include <openspace/scene/scenegraphnode.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <unordered_map>
+
+namespace {
+    glm::dmat4 composeModelTransform(const glm::dvec3& position,
+                                     const glm::dmat3& rotation, const glm::dvec3& scale)
+    {
+        // Equivalent to translate(position) * dmat4(rotation) * scale(scale) but without
+        // the two full matrix multiplications
+        return glm::dmat4(
+            glm::dvec4(rotation[0] * scale.x, 0.0),
+            glm::dvec4(rotation[1] * scale.y, 0.0),
+            glm::dvec4(rotation[2] * scale.z, 0.0),
+            glm::dvec4(position, 1.0)
+        );
+    }
+} // namespace
+
+namespace openspace {
+
+void WorldTransformCache::rebuild(const std::vector<SceneGraphNode*>& nodes) {
+    ZoneScoped;
+
+    // First detach all nodes, which makes them copy their current world transformation
+    // into their local storage. This has to happen before we touch the arrays
+    for (SceneGraphNode* node : _nodes) {
+        if (node) {
+            node->setWorldTransformCache(nullptr, NoIndex);
+        }
+    }
+
+    const size_t n = nodes.size();
+    _nodes = nodes;
+    _parentIndices.assign(n, NoIndex);
+    _isActive.assign(n, 0);
+    _isDirty.assign(n, 1);
+    _hasChanged.assign(n, 0);
+    _localPositions.assign(n, glm::dvec3(0.0));
+    _localRotations.assign(n, glm::dmat3(1.0));
+    _localScales.assign(n, glm::dvec3(1.0));
+    _worldPositions.assign(n, glm::dvec3(0.0));
+    _worldRotations.assign(n, glm::dmat3(1.0));
+    _worldScales.assign(n, glm::dvec3(1.0));
+    _modelTransforms.assign(n, glm::dmat4(1.0));
+    _modelViewTransforms.assign(n, glm::dmat4(1.0));
+    _hasValidModelViewTransforms = false;
+
+    std::unordered_map<const SceneGraphNode*, uint32_t> indices;
+    indices.reserve(n);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(n); i++) {
+        SceneGraphNode* node = nodes[i];
+        indices[node] = i;
+
+        if (node->parent()) {
+            const auto it = indices.find(node->parent());
+            ghoul_assert(it != indices.end(), "Parent must be stored before its child");
+            _parentIndices[i] = it->second;
+        }
+
+        setWorldTransform(
+            i,
+            node->worldPosition(),
+            node->worldRotationMatrix(),
+            node->worldScale()
+        );
+        node->setWorldTransformCache(this, i);
+    }
+}
+
+void WorldTransformCache::remove(SceneGraphNode* node) {
+    if (node->_transformCache != this) {
+        return;
+    }
+
+    const uint32_t index = node->_transformIndex;
+    node->setWorldTransformCache(nullptr, NoIndex);
+    _nodes[index] = nullptr;
+    _isActive[index] = 0;
+    _hasChanged[index] = 0;
+}
+
+void WorldTransformCache::clear() {
+    for (SceneGraphNode* node : _nodes) {
+        if (node) {
+            node->setWorldTransformCache(nullptr, NoIndex);
+        }
+    }
+
+    _nodes.clear();
+    _parentIndices.clear();
+    _isActive.clear();
+    _isDirty.clear();
+    _hasChanged.clear();
+    _localPositions.clear();
+    _localRotations.clear();
+    _localScales.clear();
+    _worldPositions.clear();
+    _worldRotations.clear();
+    _worldScales.clear();
+    _modelTransforms.clear();
+    _modelViewTransforms.clear();
+    _hasValidModelViewTransforms = false;
+}
+
+void WorldTransformCache::setLocalTransform(uint32_t index, const glm::dvec3& position,
+                                            const glm::dmat3& rotation,
+                                            const glm::dvec3& scale, bool hasChanged)
+{
+    ghoul_assert(index < size(), "Index out of bounds");
+
+    // If the node was inactive, its parent might have moved in the meantime without us
+    // noticing, so we have to recompute the world transformation regardless
+    if (hasChanged || !_isActive[index]) {
+        _localPositions[index] = position;
+        _localRotations[index] = rotation;
+        _localScales[index] = scale;
+        _isDirty[index] = 1;
+    }
+    _isActive[index] = 1;
+}
+
+void WorldTransformCache::setInactive(uint32_t index) {
+    ghoul_assert(index < size(), "Index out of bounds");
+    _isActive[index] = 0;
+}
+
+bool WorldTransformCache::isActive(uint32_t index) const {
+    ghoul_assert(index < size(), "Index out of bounds");
+    return _isActive[index] != 0;
+}
+
+bool WorldTransformCache::hasChanged(uint32_t index) const {
+    ghoul_assert(index < size(), "Index out of bounds");
+    return _hasChanged[index] != 0;
+}
+
+void WorldTransformCache::computeWorldTransforms(uint32_t begin, uint32_t end) {
+    ghoul_assert(begin <= end && end <= size(), "Invalid range");
+
+    for (uint32_t i = begin; i < end; i++) {
+        const uint32_t p = _parentIndices[i];
+        const bool parentChanged = p != NoIndex && _hasChanged[p];
+        if (!_isActive[i] || (!_isDirty[i] && !parentChanged)) {
+            _hasChanged[i] = 0;
+            continue;
+        }
+        _isDirty[i] = 0;
+        _hasChanged[i] = 1;
+        _hasValidModelViewTransforms = false;
+
+        if (p != NoIndex) {
+            _worldPositions[i] = _worldPositions[p] +
+                _worldRotations[p] * (_worldScales[p] * _localPositions[i]);
+            _worldRotations[i] = _worldRotations[p] * _localRotations[i];
+            _worldScales[i] = _worldScales[p] * _localScales[i];
+        }
+        else {
+            _worldPositions[i] = _localPositions[i];
+            _worldRotations[i] = _localRotations[i];
+            _worldScales[i] = _localScales[i];
+        }
+        _modelTransforms[i] = composeModelTransform(
+            _worldPositions[i],
+            _worldRotations[i],
+            _worldScales[i]
+        );
+    }
+}
+
+void WorldTransformCache::computeWorldTransform(uint32_t index) {
+    computeWorldTransforms(index, index + 1);
+}
+
+void WorldTransformCache::computeModelViewTransforms(const glm::dvec3& cameraPosition,
+                                                     const glm::dmat4& cameraRelativeView)
+{
+    ZoneScoped;
+
+    if (_hasValidModelViewTransforms && cameraPosition == _modelViewCameraPosition &&
+        cameraRelativeView == _modelViewCameraMatrix)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < _modelViewTransforms.size(); i++) {
+        _modelViewTransforms[i] = modelViewTransform(
+            _worldPositions[i],
+            _worldRotations[i],
+            _worldScales[i],
+            cameraPosition,
+            cameraRelativeView
+        );
+    }
+    _modelViewCameraPosition = cameraPosition;
+    _modelViewCameraMatrix = cameraRelativeView;
+    _hasValidModelViewTransforms = true;
+}
+
+glm::dmat4 WorldTransformCache::modelViewTransform(const glm::dvec3& position,
+                                                   const glm::dmat3& rotation,
+                                                   const glm::dvec3& scale,
+                                                   const glm::dvec3& cameraPosition,
+                                                   const glm::dmat4& cameraRelativeView)
+{
+    return cameraRelativeView *
+        composeModelTransform(position - cameraPosition, rotation, scale);
+}
+
+void WorldTransformCache::setWorldTransform(uint32_t index, const glm::dvec3& position,
+                                            const glm::dmat3& rotation,
+                                            const glm::dvec3& scale)
+{
+    _worldPositions[index] = position;
+    _worldRotations[index] = rotation;
+    _worldScales[index] = scale;
+    _modelTransforms[index] = composeModelTransform(position, rotation, scale);
+    _hasValidModelViewTransforms = false;
+}
+
+const glm::dvec3& WorldTransformCache::worldPosition(uint32_t index) const {
+    return _worldPositions[index];
+}
+
+const glm::dmat3& WorldTransformCache::worldRotation(uint32_t index) const {
+    return _worldRotations[index];
+}
+
+const glm::dvec3& WorldTransformCache::worldScale(uint32_t index) const {
+    return _worldScales[index];
+}
+
+const glm::dmat4& WorldTransformCache::modelTransform(uint32_t index) const {
+    return _modelTransforms[index];
+}
+
+const glm::dmat4& WorldTransformCache::modelViewTransform(uint32_t index) const {
+    return _modelViewTransforms[index];
+}
+
+std::span<const glm::dvec3> WorldTransformCache::worldPositions() const {
+    return _worldPositions;
+}
+
+std::span<const glm::dmat3> WorldTransformCache::worldRotations() const {
+    return _worldRotations;
+}
+
+std::span<const glm::dvec3> WorldTransformCache::worldScales() const {
+    return _worldScales;
+}
+
+std::span<const glm::dmat4> WorldTransformCache::modelTransforms() const {
+    return _modelTransforms;
+}
+
+std::span<const glm::dmat4> WorldTransformCache::modelViewTransforms() const {
+    return _modelViewTransforms;
+}
+
+SceneGraphNode* WorldTransformCache::node(uint32_t index) const {
+    ghoul_assert(index < size(), "Index out of bounds");
+    return _nodes[index];
+}
+
+size_t WorldTransformCache::size() const {
+    return _worldPositions.size();
+}
+
+} // namespace openspace
@@ -37,6 +37,7 @@
 #include <ghoul/lua/lua_helper.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/ext/assimp/contrib/zip/src/zip.h>
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include "scriptengine_lua.inl"
@@ -46,6 +47,14 @@ namespace {
 
     constexpr int TableOffset = -3; // top-first argument-second argument
 
+    // Maximum number of compiled scripts that are kept. The cache is cleared when it
+    // is full, which keeps scripts with ever-changing arguments from growing it forever
+    constexpr size_t MaxCompiledScripts = 512;
+
+    // Upper limit of garbage collection steps per frame in case the frame budget is so
+    // generous that a single cycle would otherwise never be interrupted
+    constexpr int MaxGarbageCollectionSteps = 1000;
+
     struct [[codegen::Dictionary(Documentation)]] Parameters {
         std::string name;
         std::map<std::string, std::string> arguments;
@@ -127,11 +136,21 @@ void ScriptEngine::initialize() {
 
     LDEBUG("Initializing Lua state");
     initializeLuaState(_state);
+
+    // The incremental mode is used as every explicit step only does a bounded amount of
+    // work, whereas a step in the generational mode is a full minor collection. The
+    // automatic collection stays enabled so that scripts allocating a lot of memory in a
+    // single frame are still collected, but most of the work is done in #collectGarbage
+    lua_gc(_state, LUA_GCINC, 0, 0, 0);
 }
 
 void ScriptEngine::deinitialize() {
     ZoneScoped;
 
+    for (const std::pair<const std::string, int>& p : _compiledScripts) {
+        luaL_unref(_state, LUA_REGISTRYINDEX, p.second);
+    }
+    _compiledScripts.clear();
     _registeredLibraries.clear();
 }
 
@@ -210,7 +229,7 @@ bool ScriptEngine::runScript(const std::string& script, ScriptCallback callback)
             callback(returnValue);
         }
         else {
-            ghoul::lua::runScript(_state, script);
+            runCompiledScript(script);
         }
     }
     catch (const ghoul::lua::LuaLoadingException& e) {
@@ -238,6 +257,47 @@ bool ScriptEngine::runScript(const std::string& script, ScriptCallback callback)
     return true;
 }
 
+void ScriptEngine::runCompiledScript(const std::string& script) {
+    ZoneScoped;
+
+    lua_State* state = _state;
+    const int top = lua_gettop(state);
+
+    auto it = _compiledScripts.find(script);
+    if (it == _compiledScripts.end()) {
+        const int loadStatus = luaL_loadbuffer(
+            state,
+            script.data(),
+            script.size(),
+            script.c_str()
+        );
+        if (loadStatus != LUA_OK) {
+            std::string error = ghoul::lua::value<std::string>(state, -1);
+            lua_settop(state, top);
+            throw ghoul::lua::LuaRuntimeException(std::move(error));
+        }
+
+        if (_compiledScripts.size() >= MaxCompiledScripts) {
+            for (const std::pair<const std::string, int>& p : _compiledScripts) {
+                luaL_unref(state, LUA_REGISTRYINDEX, p.second);
+            }
+            _compiledScripts.clear();
+        }
+        // luaL_ref pops the function, so the cached copy is pushed again below
+        it = _compiledScripts.emplace(script, luaL_ref(state, LUA_REGISTRYINDEX)).first;
+    }
+
+    lua_rawgeti(state, LUA_REGISTRYINDEX, it->second);
+    const int callStatus = lua_pcall(state, 0, 0, 0);
+    if (callStatus != LUA_OK) {
+        std::string error = ghoul::lua::value<std::string>(state, -1);
+        lua_settop(state, top);
+        throw ghoul::lua::LuaRuntimeException(std::move(error));
+    }
+    // Clean up the stack, in case the script left anything there
+    lua_settop(state, top);
+}
+
 bool ScriptEngine::runScriptFile(const std::filesystem::path& filename) {
     ZoneScoped;
 
@@ -437,6 +497,49 @@ bool ScriptEngine::registerLuaLibrary(lua_State* state, LuaLibrary& library) {
     return true;
 }
 
+void ScriptEngine::collectGarbage(const FrameBudget& budget) {
+    ZoneScoped;
+
+    using namespace std::chrono;
+
+    // Without a budget there is no way to know how much time is left in the frame, so
+    // only a single step is run
+    const bool hasBudget = budget.budget().count() > 0;
+
+    const steady_clock::time_point begin = steady_clock::now();
+    int nSteps = 0;
+    bool finishedCycle = false;
+    do {
+        finishedCycle = lua_gc(_state, LUA_GCSTEP, 0) == 1;
+        nSteps++;
+    } while (hasBudget && !finishedCycle && budget.hasTimeRemaining() &&
+             nSteps < MaxGarbageCollectionSteps);
+    const microseconds duration = duration_cast<microseconds>(
+        steady_clock::now() - begin
+    );
+
+    GarbageCollectionStatistics& stats = _garbageCollectionStatistics;
+    stats.nSteps += nSteps;
+    if (finishedCycle) {
+        stats.nCycles++;
+    }
+    stats.lastDuration = duration;
+    stats.maxDuration = std::max(stats.maxDuration, duration);
+    stats.totalDuration += duration;
+}
+
+const ScriptEngine::GarbageCollectionStatistics&
+ScriptEngine::garbageCollectionStatistics() const
+{
+    return _garbageCollectionStatistics;
+}
+
+size_t ScriptEngine::luaMemoryUsage() {
+    const int kb = lua_gc(_state, LUA_GCCOUNT);
+    const int remainder = lua_gc(_state, LUA_GCCOUNTB);
+    return static_cast<size_t>(kb) * 1024 + static_cast<size_t>(remainder);
+}
+
 std::vector<std::string> ScriptEngine::allLuaFunctions() const {
     ZoneScoped;
 
@@ -556,6 +659,10 @@ void ScriptEngine::preSync(bool isMaster) {
     }
 }
 
+bool ScriptEngine::hasChanged() const {
+    return !_scriptsToSync.empty();
+}
+
 void ScriptEngine::encode(SyncBuffer* syncBuffer) {
     ZoneScoped;
 
@@ -700,7 +807,8 @@ void ScriptEngine::addBaseLibrary() {
             codegen::lua::WalkDirectoryFiles,
             codegen::lua::WalkDirectoryFolders,
             codegen::lua::DirectoryForPath,
-            codegen::lua::UnzipFile
+            codegen::lua::UnzipFile,
+            codegen::lua::GarbageCollectionStatistics
         }
     };
     addLibrary(lib);
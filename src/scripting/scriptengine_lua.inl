@@ -241,6 +241,36 @@ std::vector<std::string> walkCommon(std::string path, bool recursive, bool sorte
     }
 }
 
+/**
+ * Returns statistics about the garbage collection of the Lua state that is done at the
+ * end of each frame. The returned table contains the number of incremental steps
+ * (`Steps`) and completed collection cycles (`Cycles`), the time in milliseconds that was
+ * spent in the last frame (`LastDuration`), the longest frame (`MaxDuration`), and in
+ * total (`TotalDuration`), as well as the memory currently used by Lua in kilobytes
+ * (`Memory`).
+ */
+[[codegen::luawrap]] ghoul::Dictionary garbageCollectionStatistics() {
+    using namespace openspace;
+    using Stats = scripting::ScriptEngine::GarbageCollectionStatistics;
+
+    const Stats& stats = global::scriptEngine->garbageCollectionStatistics();
+    auto toMs = [](std::chrono::microseconds us) {
+        return static_cast<double>(us.count()) / 1000.0;
+    };
+
+    ghoul::Dictionary res;
+    res.setValue("Steps", static_cast<double>(stats.nSteps));
+    res.setValue("Cycles", static_cast<double>(stats.nCycles));
+    res.setValue("LastDuration", toMs(stats.lastDuration));
+    res.setValue("MaxDuration", toMs(stats.maxDuration));
+    res.setValue("TotalDuration", toMs(stats.totalDuration));
+    res.setValue(
+        "Memory",
+        static_cast<double>(global::scriptEngine->luaMemoryUsage()) / 1024.0
+    );
+    return res;
+}
+
 #include "scriptengine_lua_codegen.cpp"
 
 } // namespace
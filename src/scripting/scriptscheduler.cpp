@@ -30,6 +30,9 @@
 #include <openspace/scripting/scriptengine.h>
 #include <openspace/util/time.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <string_view>
+#include <unordered_set>
 
 #include "scriptscheduler_lua.inl"
 
@@ -75,6 +78,12 @@ namespace {
 
         // The group that this script belongs to, default group is 0
         std::optional<int> group;
+
+        // An identifier for the state that this script sets, for example the URI of the
+        // property that it changes. If a time jump passes over multiple scripts with the
+        // same key, only the last of them is executed, as it would overwrite the changes
+        // of the others anyway
+        std::optional<std::string> key;
     };
 
 #include "scriptscheduler_codegen.cpp"
@@ -106,6 +115,7 @@ ScriptScheduler::ScheduledScript::ScheduledScript(const ghoul::Dictionary& dict)
     backwardScript = p.backwardScript.value_or(backwardScript);
     universalScript = p.script.value_or(universalScript);
     group = p.group.value_or(group);
+    key = p.key.value_or(key);
 }
 
 void ScriptScheduler::loadScripts(std::vector<ScheduledScript> scheduledScripts) {
@@ -166,14 +176,17 @@ void ScriptScheduler::clearSchedule(std::optional<int> group) {
 }
 
 std::vector<std::string> ScriptScheduler::progressTo(double newTime) {
-    std::vector<std::string> result;
     if (!_enabled || newTime == _currentTime || _scripts.empty()) {
         // Update the new time
         _currentTime = newTime;
-        return result;
+        return std::vector<std::string>();
     }
 
-    if (newTime > _currentTime) {
+    // The scripts that were passed over, in the order in which they are executed
+    std::vector<const ScheduledScript*> passed;
+    const bool isForward = newTime > _currentTime;
+
+    if (isForward) {
         // Moving forward in time; we need to find the highest entry in the timings
         // vector that is still smaller than the newTime
         size_t prevIndex = _currentIndex;
@@ -193,18 +206,12 @@ std::vector<std::string> ScriptScheduler::progressTo(double newTime) {
         // Update the new time
         _currentTime = newTime;
 
-        // Construct result
         for (auto iter = _scripts.begin() + prevIndex;
             iter < (_scripts.begin() + _currentIndex);
             ++iter)
         {
-            std::string script = iter->universalScript.empty() ?
-                iter->forwardScript :
-                iter->universalScript + "; " + iter->forwardScript;
-            result.push_back(script);
+            passed.push_back(&*iter);
         }
-
-        return result;
     }
     else {
         // Moving backward in time; the need to find the lowest entry that is still bigger
@@ -226,23 +233,35 @@ std::vector<std::string> ScriptScheduler::progressTo(double newTime) {
         // Update the new time
         _currentTime = newTime;
 
-        // Construct result
         const size_t startOffset = prevIndex == 0 ? prevIndex : prevIndex - 1;
         auto start = _scripts.begin() + startOffset;
         auto end = it;
         for (auto iter = start; iter != _scripts.end() && iter >= end; --iter) {
-            std::string script = iter->universalScript.empty() ?
-                iter->backwardScript :
-                iter->universalScript + "; " + iter->backwardScript;
-            result.push_back(script);
+            passed.push_back(&*iter);
 
             if (iter == _scripts.begin()) {
                 break;
             }
         }
+    }
+
+    // Construct result. Walking backwards through the passed scripts, only the first
+    // script for each key is kept, as that is the one that would be executed last
+    std::unordered_set<std::string_view> keys;
+    std::vector<std::string> result;
+    for (auto iter = passed.rbegin(); iter != passed.rend(); ++iter) {
+        const ScheduledScript& s = **iter;
+        if (!s.key.empty() && !keys.insert(s.key).second) {
+            continue;
+        }
 
-        return result;
+        const std::string& script = isForward ? s.forwardScript : s.backwardScript;
+        result.push_back(
+            s.universalScript.empty() ? script : s.universalScript + "; " + script
+        );
     }
+    std::reverse(result.begin(), result.end());
+    return result;
 }
 
 void ScriptScheduler::setTimeReferenceMode(interaction::KeyframeTimeRef refType) {
@@ -258,7 +277,8 @@ void ScriptScheduler::setCurrentTime(double time) {
     std::vector<std::string> scheduledScripts = progressTo(time);
 
     if (_shouldRunAllTimeJump) {
-        // Queue all scripts for the time jump
+        // Queue all scripts for the time jump. Each script is queued on its own so that
+        // an error in one of them does not prevent the others from running
         for (const std::string& script : scheduledScripts) {
             global::scriptEngine->queueScript(
                 script,
@@ -56,13 +56,16 @@ namespace {
  * Load a single scheduled script. The first argument is the time at which the scheduled
  * script is triggered, the second argument is the script that is executed in the forward
  * direction, the optional third argument is the script executed in the backwards
- * direction, and the optional last argument is the universal script, executed in either
- * direction.
+ * direction, and the optional fourth argument is the universal script, executed in either
+ * direction. The optional fifth argument is the group of the script, and the optional
+ * last argument is a key identifying the state that the script sets. If a time jump
+ * passes over multiple scripts with the same key, only the last of them is executed.
  */
 [[codegen::luawrap]] void loadScheduledScript(std::string time, std::string forwardScript,
                                               std::optional<std::string> backwardScript,
                                               std::optional<std::string> universalScript,
-                                              std::optional<int> group)
+                                              std::optional<int> group,
+                                              std::optional<std::string> key)
 {
     using namespace openspace;
 
@@ -72,6 +75,7 @@ namespace {
     script.backwardScript = backwardScript.value_or(script.backwardScript);
     script.universalScript = universalScript.value_or(script.universalScript);
     script.group = group.value_or(script.group);
+    script.key = key.value_or(script.key);
 
     std::vector<scripting::ScriptScheduler::ScheduledScript> scripts;
     scripts.push_back(std::move(script));
@@ -0,0 +1,250 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/benchmarkrunner.h>
+
+#include <openspace/engine/globals.h>
+#include <openspace/engine/windowdelegate.h>
+#include <openspace/interaction/sessionrecording.h>
+#include <openspace/json.h>
+#include <openspace/openspace.h>
+#include <openspace/util/frameprofiler.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+
+#ifdef WIN32
+#include <Windows.h>
+#include <Psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif // WIN32
+
+namespace {
+    constexpr std::string_view _loggerCat = "BenchmarkRunner";
+
+    // Returns the number of bytes of the process that are resident in physical memory
+    uint64_t residentMemory() {
+#ifdef WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<uint64_t>(counters.WorkingSetSize);
+        }
+        return 0;
+#elif defined(__APPLE__)
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        kern_return_t res = task_info(
+            mach_task_self(),
+            MACH_TASK_BASIC_INFO,
+            reinterpret_cast<task_info_t>(&info),
+            &count
+        );
+        return res == KERN_SUCCESS ? static_cast<uint64_t>(info.resident_size) : 0;
+#else
+        // The second value is the number of resident pages
+        std::ifstream statm("/proc/self/statm");
+        uint64_t size = 0;
+        uint64_t resident = 0;
+        if (!(statm >> size >> resident)) {
+            return 0;
+        }
+        return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif // WIN32
+    }
+
+    // Returns the mean, median, 95th percentile, and maximum of the provided values
+    nlohmann::json summarize(std::vector<double> values) {
+        if (values.empty()) {
+            return nlohmann::json::object();
+        }
+
+        std::sort(values.begin(), values.end());
+        auto percentile = [&values](double p) {
+            const double n = static_cast<double>(values.size());
+            const size_t i = static_cast<size_t>(std::ceil(p * n));
+            return values[std::clamp<size_t>(i, 1, values.size()) - 1];
+        };
+        const double sum = std::accumulate(values.begin(), values.end(), 0.0);
+        return {
+            { "mean", sum / static_cast<double>(values.size()) },
+            { "p50", percentile(0.5) },
+            { "p95", percentile(0.95) },
+            { "max", values.back() }
+        };
+    }
+} // namespace
+
+namespace openspace {
+
+BenchmarkRunner::BenchmarkRunner(Settings settings)
+    : _settings(std::move(settings))
+{}
+
+void BenchmarkRunner::postDraw() {
+    switch (_state) {
+        case State::Loading:
+            // The assets of the profile are loaded during the first frame, so the
+            // recording is started once that frame has been rendered
+            start();
+            break;
+        case State::Running:
+        {
+            const auto now = std::chrono::steady_clock::now();
+            Frame& frame = _frames[global::frameProfiler->frame()];
+            frame.durationMs =
+                std::chrono::duration<double, std::milli>(now - _lastFrameEnd).count();
+            frame.memory = residentMemory();
+            _lastFrameEnd = now;
+
+            collectEvents();
+            if (!global::sessionRecording->isPlayingBack()) {
+                finish();
+            }
+            break;
+        }
+        case State::Finished:
+            break;
+    }
+}
+
+void BenchmarkRunner::start() {
+    LINFO(fmt::format("Starting benchmark of recording '{}'", _settings.recording));
+
+    // The playback waits for the tiles to finish loading and then advances by a fixed
+    // time step, which would otherwise only be done when saving the frames
+    global::sessionRecording->enableFixedStepPlayback(_settings.fps);
+    const bool success = global::sessionRecording->startPlayback(
+        _settings.recording,
+        interaction::KeyframeTimeRef::Relative_recordedStart,
+        true,
+        false,
+        true
+    );
+    if (!success) {
+        LERROR(fmt::format("Could not play back recording '{}'", _settings.recording));
+        _state = State::Finished;
+        global::windowDelegate->terminate();
+        return;
+    }
+
+    global::frameProfiler->setEnabled(true);
+    // Skip the events that were recorded before the benchmark started
+    global::frameProfiler->newEvents(_eventCursor);
+    _firstFrame = global::frameProfiler->frame() + 1;
+    _lastFrameEnd = std::chrono::steady_clock::now();
+    _state = State::Running;
+}
+
+void BenchmarkRunner::collectEvents() {
+    for (const FrameProfiler::Event& e : global::frameProfiler->newEvents(_eventCursor)) {
+        if (e.frame < _firstFrame) {
+            continue;
+        }
+
+        auto it = _frames.find(e.frame);
+        if (it == _frames.end()) {
+            continue;
+        }
+        std::map<std::string, double>& phases = e.isGpu ? it->second.gpuMs :
+                                                           it->second.cpuMs;
+        phases[e.name] += static_cast<double>(e.duration) / 1e6;
+    }
+}
+
+void BenchmarkRunner::finish() {
+    _state = State::Finished;
+    collectEvents();
+    writeReport();
+    LINFO(fmt::format(
+        "Benchmark finished after {} frames, report written to {}",
+        _frames.size(), _settings.report
+    ));
+    global::windowDelegate->terminate();
+}
+
+void BenchmarkRunner::writeReport() const {
+    std::vector<double> durations;
+    durations.reserve(_frames.size());
+    uint64_t peakMemory = 0;
+    std::map<std::string, std::vector<double>> cpuPhases;
+    std::map<std::string, std::vector<double>> gpuPhases;
+
+    nlohmann::json frames = nlohmann::json::array();
+    for (const auto& [number, frame] : _frames) {
+        durations.push_back(frame.durationMs);
+        peakMemory = std::max(peakMemory, frame.memory);
+        for (const auto& [name, ms] : frame.cpuMs) {
+            cpuPhases[name].push_back(ms);
+        }
+        for (const auto& [name, ms] : frame.gpuMs) {
+            gpuPhases[name].push_back(ms);
+        }
+
+        frames.push_back({
+            { "frame", number - _firstFrame },
+            { "durationMs", frame.durationMs },
+            { "memory", frame.memory },
+            { "cpuMs", frame.cpuMs },
+            { "gpuMs", frame.gpuMs }
+        });
+    }
+
+    nlohmann::json cpu = nlohmann::json::object();
+    for (const auto& [name, values] : cpuPhases) {
+        cpu[name] = summarize(values);
+    }
+    nlohmann::json gpu = nlohmann::json::object();
+    for (const auto& [name, values] : gpuPhases) {
+        gpu[name] = summarize(values);
+    }
+
+    nlohmann::json report = {
+        { "version", std::string(OPENSPACE_VERSION_STRING_FULL) },
+        { "commit", std::string(OPENSPACE_GIT_COMMIT) },
+        { "recording", _settings.recording },
+        { "fps", _settings.fps },
+        { "nFrames", _frames.size() },
+        { "totalMs", std::accumulate(durations.begin(), durations.end(), 0.0) },
+        { "frameMs", summarize(durations) },
+        { "peakMemory", peakMemory },
+        { "cpuMs", cpu },
+        { "gpuMs", gpu },
+        { "frames", frames }
+    };
+
+    std::ofstream file(_settings.report);
+    if (!file.good()) {
+        LERROR(fmt::format("Could not open file '{}' for writing", _settings.report));
+        return;
+    }
+    file << report.dump(2) << '\n';
+}
+
+} // namespace openspace
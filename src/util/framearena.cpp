@@ -0,0 +1,144 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/framearena.h>
+
+#include <ghoul/misc/assert.h>
+#include <algorithm>
+
+namespace {
+    // The size of the first block of the per-thread arenas
+    constexpr size_t ThreadArenaSize = 256 * 1024;
+} // namespace
+
+namespace openspace {
+
+FrameArena::Scope::Scope(FrameArena& arena_)
+    : arena(arena_)
+    , marker(arena_.marker())
+{}
+
+FrameArena::Scope::~Scope() {
+    arena.rewind(marker);
+}
+
+FrameArena::FrameArena(size_t initialSize, size_t maxRetainedSize)
+    : _initialSize(std::max<size_t>(initialSize, 1))
+    , _maxRetainedSize(std::max(maxRetainedSize, _initialSize))
+{
+    _blocks.push_back({ std::make_unique<std::byte[]>(_initialSize), _initialSize });
+}
+
+void FrameArena::reset() {
+    if (_blocks.size() > 1) {
+        // Replace all blocks with a single one that can hold all of the memory that was
+        // in use since the last reset so that the next frame does not need to grow
+        const size_t size = _peakBytes > _maxRetainedSize ? _initialSize : _peakBytes;
+        _blocks.clear();
+        _blocks.push_back({ std::make_unique<std::byte[]>(size), size });
+    }
+    _currentBlock = 0;
+    _offset = 0;
+    _usedBytes = 0;
+    _peakBytes = 0;
+}
+
+FrameArena::Marker FrameArena::marker() const {
+    return { _currentBlock, _offset, _usedBytes };
+}
+
+void FrameArena::rewind(const Marker& marker) {
+    ghoul_assert(marker.block < _currentBlock ||
+        (marker.block == _currentBlock && marker.offset <= _offset),
+        "Marker must not point past the current position"
+    );
+    _currentBlock = marker.block;
+    _offset = marker.offset;
+    _usedBytes = marker.usedBytes;
+}
+
+size_t FrameArena::usedBytes() const {
+    return _usedBytes;
+}
+
+size_t FrameArena::highWaterMark() const {
+    return _highWaterMark;
+}
+
+size_t FrameArena::capacity() const {
+    size_t result = 0;
+    for (const Block& block : _blocks) {
+        result += block.size;
+    }
+    return result;
+}
+
+FrameArena& FrameArena::threadArena() {
+    thread_local FrameArena arena(ThreadArenaSize);
+    return arena;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    while (true) {
+        Block& block = _blocks[_currentBlock];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        const uintptr_t current = base + _offset;
+        const uintptr_t aligned = (current + alignment - 1) & ~(alignment - 1);
+        const size_t padding = aligned - current;
+
+        if (_offset + padding + bytes <= block.size) {
+            _offset += padding + bytes;
+            _usedBytes += padding + bytes;
+            _peakBytes = std::max(_peakBytes, _usedBytes);
+            _highWaterMark = std::max(_highWaterMark, _usedBytes);
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        // The remainder of the current block is lost for this frame
+        _usedBytes += block.size - _offset;
+        _offset = 0;
+        _currentBlock++;
+        if (_currentBlock == _blocks.size() ||
+            _blocks[_currentBlock].size < bytes + alignment)
+        {
+            // Either there are no more blocks or the next block is too small to hold the
+            // allocation, so we insert a new block that is guaranteed to fit it
+            const size_t size = std::max(2 * block.size, bytes + alignment);
+            _blocks.insert(
+                _blocks.begin() + _currentBlock,
+                { std::make_unique<std::byte[]>(size), size }
+            );
+        }
+    }
+}
+
+void FrameArena::do_deallocate(void*, size_t, size_t) {
+    // Memory is only released by resetting or rewinding the arena
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace openspace
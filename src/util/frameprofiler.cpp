@@ -0,0 +1,278 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/frameprofiler.h>
+
+#include <openspace/engine/globals.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <algorithm>
+#include <fstream>
+
+namespace {
+    constexpr std::string_view _loggerCat = "FrameProfiler";
+
+    // The number of phases that enclose the phase that is currently being recorded
+    thread_local uint8_t CurrentDepth = 0;
+
+    // Sequential numbers for the threads that recorded phases
+    std::atomic<uint16_t> NextThreadIndex = 0;
+    thread_local uint16_t ThreadIndex = NextThreadIndex++;
+} // namespace
+
+namespace openspace {
+
+FrameProfiler::Scope::Scope(const char* name, Gpu gpu)
+    : _name(name)
+    , _isActive(global::frameProfiler && global::frameProfiler->isEnabled())
+{
+    if (!_isActive) {
+        return;
+    }
+
+    _depth = CurrentDepth++;
+    if (gpu) {
+        _gpuQuery = global::frameProfiler->beginGpuQuery(_name, _depth);
+    }
+    _begin = global::frameProfiler->now();
+}
+
+FrameProfiler::Scope::~Scope() {
+    if (!_isActive) {
+        return;
+    }
+
+    const uint64_t end = global::frameProfiler->now();
+    if (_gpuQuery != -1) {
+        global::frameProfiler->endGpuQuery(_gpuQuery);
+    }
+    CurrentDepth--;
+
+    global::frameProfiler->record({
+        .name = _name,
+        .begin = _begin,
+        .duration = end - _begin,
+        .frame = global::frameProfiler->_frame,
+        .thread = ThreadIndex,
+        .depth = _depth,
+        .isGpu = false
+    });
+}
+
+FrameProfiler::FrameProfiler(size_t capacity)
+    : _epoch(std::chrono::steady_clock::now())
+    , _events(std::max<size_t>(capacity, 1))
+{}
+
+FrameProfiler::~FrameProfiler() {
+    ghoul_assert(_gpuQueries.empty(), "deinitializeGL was not called");
+}
+
+void FrameProfiler::beginFrame() {
+    _frame++;
+
+    if (_pendingGpuQueries.empty()) {
+        return;
+    }
+
+    // The GPU timestamps use a different clock, so we measure the offset between the
+    // two clocks every frame to place the GPU events on the CPU timeline
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    _gpuClockOffset = static_cast<int64_t>(now()) - static_cast<int64_t>(gpuNow);
+
+    auto it = _pendingGpuQueries.begin();
+    while (it != _pendingGpuQueries.end()) {
+        const GpuQuery& query = _gpuQueries[*it];
+        GLint isAvailable = GL_FALSE;
+        glGetQueryObjectiv(query.queries[1], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        if (!isAvailable) {
+            ++it;
+            continue;
+        }
+
+        GLuint64 begin = 0;
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(query.queries[0], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(query.queries[1], GL_QUERY_RESULT, &end);
+        record({
+            .name = query.name,
+            .begin = static_cast<uint64_t>(static_cast<int64_t>(begin) + _gpuClockOffset),
+            .duration = end > begin ? end - begin : 0,
+            .frame = query.frame,
+            .thread = 0,
+            .depth = query.depth,
+            .isGpu = true
+        });
+
+        _freeGpuQueries.push_back(*it);
+        it = _pendingGpuQueries.erase(it);
+    }
+}
+
+void FrameProfiler::deinitializeGL() {
+    for (GpuQuery& query : _gpuQueries) {
+        glDeleteQueries(2, query.queries);
+    }
+    _gpuQueries.clear();
+    _pendingGpuQueries.clear();
+    _freeGpuQueries.clear();
+}
+
+void FrameProfiler::setEnabled(bool enabled) {
+    _isEnabled = enabled;
+}
+
+bool FrameProfiler::isEnabled() const {
+    return _isEnabled;
+}
+
+uint32_t FrameProfiler::frame() const {
+    return _frame;
+}
+
+std::vector<FrameProfiler::Event> FrameProfiler::events() const {
+    std::lock_guard lock(_mutex);
+    if (!_hasWrapped) {
+        return std::vector<Event>(_events.begin(), _events.begin() + _nextEvent);
+    }
+
+    std::vector<Event> result;
+    result.reserve(_events.size());
+    result.insert(result.end(), _events.begin() + _nextEvent, _events.end());
+    result.insert(result.end(), _events.begin(), _events.begin() + _nextEvent);
+    return result;
+}
+
+std::vector<FrameProfiler::Event> FrameProfiler::newEvents(uint64_t& cursor) const {
+    std::lock_guard lock(_mutex);
+    const uint64_t capacity = _events.size();
+    const uint64_t oldest =
+        _nRecordedEvents > capacity ? _nRecordedEvents - capacity : 0;
+    cursor = std::clamp(cursor, oldest, _nRecordedEvents);
+
+    std::vector<Event> result;
+    result.reserve(_nRecordedEvents - cursor);
+    for (; cursor < _nRecordedEvents; cursor++) {
+        result.push_back(_events[cursor % capacity]);
+    }
+    return result;
+}
+
+std::vector<FrameProfiler::PhaseStatistics> FrameProfiler::phaseStatistics() const {
+    std::vector<PhaseStatistics> result;
+    std::vector<size_t> counts;
+    for (const Event& e : events()) {
+        // The same phase name might be placed at different addresses by the compiler
+        auto it = std::find_if(
+            result.begin(),
+            result.end(),
+            [&e](const PhaseStatistics& s) {
+                return s.isGpu == e.isGpu && std::string_view(s.name) == e.name;
+            }
+        );
+        if (it == result.end()) {
+            result.push_back({ .name = e.name, .isGpu = e.isGpu, .depth = e.depth });
+            counts.push_back(0);
+            it = result.end() - 1;
+        }
+
+        const double ms = static_cast<double>(e.duration) / 1e6;
+        const size_t idx = std::distance(result.begin(), it);
+        it->lastMs = ms;
+        it->averageMs += ms;
+        it->maxMs = std::max(it->maxMs, ms);
+        counts[idx]++;
+    }
+    for (size_t i = 0; i < result.size(); i++) {
+        result[i].averageMs /= static_cast<double>(counts[i]);
+    }
+    return result;
+}
+
+void FrameProfiler::saveChromeTrace(const std::filesystem::path& path) const {
+    std::ofstream file(path);
+    if (!file.good()) {
+        LERROR(fmt::format("Could not open file '{}' for writing", path));
+        return;
+    }
+
+    // The GPU events are placed on thread 0, the CPU threads start at 1
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << R"({"name":"thread_name","ph":"M","pid":0,"tid":0,"args":{"name":"GPU"}})";
+    for (const Event& e : events()) {
+        file << fmt::format(
+            ",\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},"
+            "\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{\"frame\":{}}}}}",
+            e.name, e.isGpu ? "gpu" : "cpu", e.isGpu ? 0 : e.thread + 1,
+            e.begin / 1000.0, e.duration / 1000.0, e.frame
+        );
+    }
+    file << "\n]}\n";
+}
+
+void FrameProfiler::record(const Event& event) {
+    std::lock_guard lock(_mutex);
+    _events[_nextEvent] = event;
+    _nextEvent++;
+    _nRecordedEvents++;
+    if (_nextEvent == _events.size()) {
+        _nextEvent = 0;
+        _hasWrapped = true;
+    }
+}
+
+int FrameProfiler::beginGpuQuery(const char* name, uint8_t depth) {
+    int index = 0;
+    if (_freeGpuQueries.empty()) {
+        GpuQuery query;
+        glGenQueries(2, query.queries);
+        _gpuQueries.push_back(query);
+        index = static_cast<int>(_gpuQueries.size() - 1);
+    }
+    else {
+        index = _freeGpuQueries.back();
+        _freeGpuQueries.pop_back();
+    }
+
+    GpuQuery& query = _gpuQueries[index];
+    query.name = name;
+    query.frame = _frame;
+    query.depth = depth;
+    glQueryCounter(query.queries[0], GL_TIMESTAMP);
+    return index;
+}
+
+void FrameProfiler::endGpuQuery(int index) {
+    glQueryCounter(_gpuQueries[index].queries[1], GL_TIMESTAMP);
+    _pendingGpuQueries.push_back(index);
+}
+
+uint64_t FrameProfiler::now() const {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now() - _epoch).count();
+}
+
+} // namespace openspace
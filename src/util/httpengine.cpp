@@ -0,0 +1,421 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/httpengine.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+#include <curl/curl.h>
+#include <algorithm>
+#include <iterator>
+#include <optional>
+
+namespace {
+    constexpr std::string_view _loggerCat = "HttpEngine";
+
+    // The stream weights of HTTP/2 range from 1 to 256 with a default of 16
+    long streamWeight(openspace::HttpEngine::Priority priority) {
+        using Priority = openspace::HttpEngine::Priority;
+        switch (priority) {
+            case Priority::Low:    return 4;
+            case Priority::Normal: return 16;
+            case Priority::High:   return 256;
+            default:               throw ghoul::MissingCaseException();
+        }
+    }
+} // namespace
+
+namespace openspace {
+
+struct HttpEngine::ActiveTransfer {
+    TransferId id = 0;
+    Transfer transfer;
+    CURL* handle = nullptr;
+    curl_slist* requestHeaders = nullptr;
+};
+
+HttpEngine* HttpEngine::_instance = nullptr;
+
+void HttpEngine::initialize() {
+    ghoul_assert(!isInitialized(), "HttpEngine is already initialized");
+    _instance = new HttpEngine;
+}
+
+void HttpEngine::deinitialize() {
+    ghoul_assert(isInitialized(), "HttpEngine is not initialized");
+    delete _instance;
+    _instance = nullptr;
+}
+
+bool HttpEngine::isInitialized() {
+    return _instance != nullptr;
+}
+
+HttpEngine& HttpEngine::ref() {
+    ghoul_assert(isInitialized(), "HttpEngine is not initialized");
+    return *_instance;
+}
+
+HttpEngine::HttpEngine() {
+    curl_global_init(CURL_GLOBAL_ALL);
+
+    CURLM* multi = curl_multi_init();
+    if (!multi) {
+        throw ghoul::RuntimeError("Error initializing cURL", "HttpEngine");
+    }
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(
+        multi,
+        CURLMOPT_MAX_TOTAL_CONNECTIONS,
+        static_cast<long>(MaxActiveTransfers)
+    );
+    _multiHandle = multi;
+
+    _thread = std::thread([this]() { run(); });
+}
+
+HttpEngine::~HttpEngine() {
+    {
+        std::lock_guard lock(_mutex);
+        _shouldStop = true;
+    }
+    wakeUp();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    curl_multi_cleanup(static_cast<CURLM*>(_multiHandle));
+    curl_global_cleanup();
+}
+
+HttpEngine::TransferId HttpEngine::submit(Transfer transfer) {
+    ghoul_assert(!transfer.url.empty(), "url must not be empty");
+
+    TransferId id = 0;
+    {
+        std::lock_guard lock(_mutex);
+        id = _nextId++;
+        const size_t p = static_cast<size_t>(transfer.priority);
+        _queuedTransfers[p].emplace_back(id, std::move(transfer));
+    }
+    wakeUp();
+    return id;
+}
+
+void HttpEngine::cancel(TransferId id) {
+    {
+        std::lock_guard lock(_mutex);
+        _cancellations.push_back(id);
+    }
+    wakeUp();
+}
+
+void HttpEngine::run() {
+    CURLM* multi = static_cast<CURLM*>(_multiHandle);
+
+    while (true) {
+        {
+            std::lock_guard lock(_mutex);
+            if (_shouldStop) {
+                break;
+            }
+        }
+
+        processCancellations();
+        startQueuedTransfers();
+
+        int nRunning = 0;
+        curl_multi_perform(multi, &nRunning);
+
+        int nMessages = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi, &nMessages)) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+
+            ActiveTransfer* transfer = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &transfer);
+            ghoul_assert(transfer, "Missing transfer for easy handle");
+
+            Result result;
+            result.isComplete = msg->data.result == CURLE_OK;
+            curl_easy_getinfo(
+                msg->easy_handle,
+                CURLINFO_RESPONSE_CODE,
+                &result.responseCode
+            );
+            char* contentType = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_CONTENT_TYPE, &contentType);
+            if (contentType) {
+                result.contentType = contentType;
+            }
+            if (!result.isComplete) {
+                result.error = curl_easy_strerror(msg->data.result);
+            }
+            finishTransfer(transfer, std::move(result));
+        }
+
+#if LIBCURL_VERSION_NUM >= 0x074400
+        // The thread is woken up early through curl_multi_wakeup when a transfer is
+        // submitted or cancelled
+        curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+#else // ^^^ LIBCURL_VERSION_NUM >= 7.68.0 / LIBCURL_VERSION_NUM < 7.68.0 vvv
+        // Without curl_multi_wakeup, we have to check for new transfers regularly
+        curl_multi_wait(multi, nullptr, 0, 10, nullptr);
+#endif // LIBCURL_VERSION_NUM >= 7.68.0
+    }
+
+    // Finish all remaining transfers so that nobody waits for them indefinitely
+    Result cancelled = { .error = "The HttpEngine was shut down" };
+    while (!_activeTransfers.empty()) {
+        finishTransfer(_activeTransfers.back().get(), cancelled);
+    }
+    std::array<std::deque<std::pair<TransferId, Transfer>>, 3> queued;
+    {
+        std::lock_guard lock(_mutex);
+        queued = std::move(_queuedTransfers);
+    }
+    for (std::deque<std::pair<TransferId, Transfer>>& q : queued) {
+        for (std::pair<TransferId, Transfer>& t : q) {
+            if (t.second.onFinish) {
+                t.second.onFinish(cancelled);
+            }
+        }
+    }
+}
+
+void HttpEngine::startQueuedTransfers() {
+    CURLM* multi = static_cast<CURLM*>(_multiHandle);
+
+    while (_activeTransfers.size() < static_cast<size_t>(MaxActiveTransfers)) {
+        // The last slots are reserved for transfers with a high priority, so that a
+        // caller that is waiting for a request does not have to wait for a number of
+        // long downloads to finish first
+        const bool hasReservedSlotsOnly =
+            _activeTransfers.size() >=
+            static_cast<size_t>(MaxActiveTransfers - ReservedHighPriorityTransfers);
+
+        std::optional<std::pair<TransferId, Transfer>> next;
+        {
+            std::lock_guard lock(_mutex);
+            // Start with the queue of the highest priority
+            for (auto it = _queuedTransfers.rbegin(); it != _queuedTransfers.rend(); it++)
+            {
+                const bool isHighPriority = it == _queuedTransfers.rbegin();
+                if (hasReservedSlotsOnly && !isHighPriority) {
+                    break;
+                }
+                if (!it->empty()) {
+                    next = std::move(it->front());
+                    it->pop_front();
+                    break;
+                }
+            }
+        }
+        if (!next.has_value()) {
+            return;
+        }
+
+        auto active = std::make_unique<ActiveTransfer>();
+        active->id = next->first;
+        active->transfer = std::move(next->second);
+        Transfer& t = active->transfer;
+
+        if (t.onStart && !t.onStart()) {
+            if (t.onFinish) {
+                t.onFinish({ .error = "The transfer could not be started" });
+            }
+            continue;
+        }
+
+        CURL* curl = curl_easy_init();
+        if (!curl) {
+            if (t.onFinish) {
+                t.onFinish({ .error = "Error initializing cURL" });
+            }
+            continue;
+        }
+        active->handle = curl;
+
+        curl_easy_setopt(curl, CURLOPT_URL, t.url.c_str());
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, "OpenSpace");
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(curl, CURLOPT_PRIVATE, active.get());
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(t.timeout.count()));
+
+        // Prefer waiting for an existing connection that can be multiplexed over opening
+        // a new connection to the same server
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+        curl_easy_setopt(curl, CURLOPT_STREAM_WEIGHT, streamWeight(t.priority));
+
+        if (t.headerOnly) {
+            curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+        }
+        if (!t.verifyPeer) {
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+        }
+        for (const std::string& header : t.requestHeaders) {
+            active->requestHeaders =
+                curl_slist_append(active->requestHeaders, header.c_str());
+        }
+        if (active->requestHeaders) {
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, active->requestHeaders);
+        }
+
+        // The leading + in all of the lambda expressions are to cause an implicit
+        // conversion to a standard C function pointer. Since the `curl_easy_setopt`
+        // function just takes anything as an argument, passing the standard
+        // lambda-created anonoymous struct causes crashes while using it if the + is
+        // not there
+
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &t);
+        curl_easy_setopt(
+            curl,
+            CURLOPT_HEADERFUNCTION,
+            +[](char* ptr, size_t size, size_t nmemb, void* userData) {
+                Transfer* tr = reinterpret_cast<Transfer*>(userData);
+                const bool shouldContinue =
+                    tr->onHeader ? tr->onHeader(ptr, size * nmemb) : true;
+                return shouldContinue ? size * nmemb : 0;
+            }
+        );
+
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &t);
+        curl_easy_setopt(
+            curl,
+            CURLOPT_WRITEFUNCTION,
+            +[](char* ptr, size_t size, size_t nmemb, void* userData) {
+                Transfer* tr = reinterpret_cast<Transfer*>(userData);
+                const bool shouldContinue =
+                    tr->onData ? tr->onData(ptr, size * nmemb) : true;
+                return shouldContinue ? size * nmemb : 0;
+            }
+        );
+
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &t);
+        curl_easy_setopt(
+            curl,
+            CURLOPT_XFERINFOFUNCTION,
+            +[](void* userData, curl_off_t nTotalDownloadBytes,
+                curl_off_t nDownloadedBytes, curl_off_t, curl_off_t)
+            {
+                Transfer* tr = reinterpret_cast<Transfer*>(userData);
+                if (!tr->onProgress) {
+                    return 0;
+                }
+
+                std::optional<size_t> totalBytes;
+                if (nTotalDownloadBytes > 0) {
+                    totalBytes = static_cast<size_t>(nTotalDownloadBytes);
+                }
+                const bool shouldContinue = tr->onProgress(
+                    static_cast<size_t>(nDownloadedBytes),
+                    totalBytes
+                );
+                return shouldContinue ? 0 : 1;
+            }
+        );
+
+        curl_multi_add_handle(multi, curl);
+        _activeTransfers.push_back(std::move(active));
+    }
+}
+
+void HttpEngine::processCancellations() {
+    std::vector<TransferId> cancellations;
+    std::vector<std::pair<TransferId, Transfer>> cancelledQueued;
+    {
+        std::lock_guard lock(_mutex);
+        if (_cancellations.empty()) {
+            return;
+        }
+        cancellations = std::move(_cancellations);
+        _cancellations.clear();
+
+        for (std::deque<std::pair<TransferId, Transfer>>& q : _queuedTransfers) {
+            auto it = std::stable_partition(
+                q.begin(), q.end(),
+                [&cancellations](const std::pair<TransferId, Transfer>& t) {
+                    return std::find(
+                        cancellations.begin(),
+                        cancellations.end(),
+                        t.first
+                    ) == cancellations.end();
+                }
+            );
+            std::move(it, q.end(), std::back_inserter(cancelledQueued));
+            q.erase(it, q.end());
+        }
+    }
+
+    // The callbacks are called without holding the lock as they might submit new
+    // transfers
+    const Result cancelled = { .error = "The transfer was cancelled" };
+    for (std::pair<TransferId, Transfer>& t : cancelledQueued) {
+        if (t.second.onFinish) {
+            t.second.onFinish(cancelled);
+        }
+    }
+
+    for (TransferId id : cancellations) {
+        auto it = std::find_if(
+            _activeTransfers.begin(), _activeTransfers.end(),
+            [id](const std::unique_ptr<ActiveTransfer>& t) { return t->id == id; }
+        );
+        if (it != _activeTransfers.end()) {
+            finishTransfer(it->get(), cancelled);
+        }
+    }
+}
+
+void HttpEngine::finishTransfer(ActiveTransfer* transfer, Result result) {
+    curl_multi_remove_handle(static_cast<CURLM*>(_multiHandle), transfer->handle);
+    curl_easy_cleanup(transfer->handle);
+    curl_slist_free_all(transfer->requestHeaders);
+
+    if (transfer->transfer.onFinish) {
+        transfer->transfer.onFinish(result);
+    }
+
+    auto it = std::find_if(
+        _activeTransfers.begin(), _activeTransfers.end(),
+        [transfer](const std::unique_ptr<ActiveTransfer>& t) {
+            return t.get() == transfer;
+        }
+    );
+    ghoul_assert(it != _activeTransfers.end(), "Finished transfer was not active");
+    _activeTransfers.erase(it);
+}
+
+void HttpEngine::wakeUp() {
+#if LIBCURL_VERSION_NUM >= 0x074400
+    curl_multi_wakeup(static_cast<CURLM*>(_multiHandle));
+#endif // LIBCURL_VERSION_NUM >= 7.68.0
+}
+
+} // namespace openspace
@@ -24,12 +24,36 @@
 
 #include <openspace/util/httprequest.h>
 
+#include <openspace/util/httpengine.h>
 #include <ghoul/fmt.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
-#include <curl/curl.h>
+#include <algorithm>
+#include <cctype>
 #include <filesystem>
+#include <future>
+#include <thread>
+
+namespace {
+    bool isSuccessful(const openspace::HttpEngine::Result& result, std::string_view url) {
+        if (!result.isComplete) {
+            LERRORC(
+                "HttpRequest",
+                fmt::format("Failed download {} with error {}", url, result.error)
+            );
+            return false;
+        }
+        if (result.responseCode >= 400) {
+            LERRORC(
+                "HttpRequest",
+                fmt::format("Failed download {} with code {}", url, result.responseCode)
+            );
+            return false;
+        }
+        return true;
+    }
+} // namespace
 
 namespace openspace {
 
@@ -52,93 +76,22 @@ void HttpRequest::onHeader(HeaderCallback cb) {
 }
 
 bool HttpRequest::perform(std::chrono::milliseconds timeout) {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        return false;
-    }
-
-    curl_easy_setopt(curl, CURLOPT_URL, _url.data());
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, "OpenSpace");
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-
-    // The leading + in all of the lambda expressions are to cause an implicit conversion
-    // to a standard C function pointer. Since the `curl_easy_setopt` function just takes
-    // anything as an argument, passing the standard lambda-created anonoymous struct
-    // causes crashes while using it if the + is not there
-
-    curl_easy_setopt(curl, CURLOPT_HEADERDATA, this);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_HEADERFUNCTION,
-        +[](char* ptr, size_t size, size_t nmemb, void* userData) {
-            HttpRequest* r = reinterpret_cast<HttpRequest*>(userData);
-            bool shouldContinue = r->_onHeader ? r->_onHeader(ptr, size * nmemb) : true;
-            return shouldContinue ? size * nmemb : 0;
-        }
-    );
-
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, this);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_WRITEFUNCTION,
-        +[](char* ptr, size_t size, size_t nmemb, void* userData) {
-            HttpRequest* r = reinterpret_cast<HttpRequest*>(userData);
-            bool shouldContinue = r->_onData ? r->_onData(ptr, size * nmemb) : true;
-            return shouldContinue ? size * nmemb : 0;
-        }
-    );
-
-    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
-    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, this);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_XFERINFOFUNCTION,
-        +[](void* userData, int64_t nTotalDownloadBytes, int64_t nDownloadedBytes,
-           int64_t, int64_t)
-        {
-            HttpRequest* r = reinterpret_cast<HttpRequest*>(userData);
-
-            std::optional<int64_t> totalBytes;
-            if (nTotalDownloadBytes > 0) {
-                totalBytes = nTotalDownloadBytes;
-            }
-
-            bool shouldContinue = r->_onProgress ?
-                r->_onProgress(nDownloadedBytes, totalBytes) :
-                true;
-            return shouldContinue ? 0 : 1;
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::future<bool> future = promise->get_future();
+
+    HttpEngine::ref().submit({
+        .url = _url,
+        .timeout = timeout,
+        .priority = HttpEngine::Priority::High,
+        .onHeader = _onHeader,
+        .onData = _onData,
+        .onProgress = _onProgress,
+        .onFinish = [url = _url, promise](const HttpEngine::Result& result) {
+            promise->set_value(isSuccessful(result, url));
         }
-    );
-
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout.count()));
-
-    CURLcode res = curl_easy_perform(curl);
-    bool success = false;
-    if (res == CURLE_OK) {
-        long responseCode;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+    });
 
-        if (responseCode >= 400) {
-            LERRORC(
-                "HttpRequest",
-                fmt::format("Failed download {} with code {}", _url, responseCode)
-            );
-            success = false;
-        }
-        else {
-            success = true;
-        }
-    }
-    else {
-        LERRORC(
-            "HttpRequest",
-            fmt::format(
-                "Failed download {} with error {}", _url, curl_easy_strerror(res)
-            )
-        );
-    }
-    curl_easy_cleanup(curl);
-    return success;
+    return future.get();
 }
 
 const std::string& HttpRequest::url() const {
@@ -149,18 +102,9 @@ const std::string& HttpRequest::url() const {
 
 
 HttpDownload::HttpDownload(std::string url)
-    : _httpRequest(std::move(url))
+    : _url(std::move(url))
 {
-    _httpRequest.onData([this](char* buffer, size_t size) {
-        return handleData(buffer, size) && !_shouldCancel;
-    });
-
-    _httpRequest.onProgress(
-        [this](int64_t downloadedBytes, std::optional<int64_t> totalBytes) {
-            bool cont = _onProgress ? _onProgress(downloadedBytes, totalBytes) : true;
-            return cont && !_shouldCancel;
-        }
-    );
+    ghoul_assert(!_url.empty(), "url must not be empty");
 }
 
 HttpDownload::~HttpDownload() {
@@ -172,6 +116,10 @@ void HttpDownload::onProgress(HttpRequest::ProgressCallback progressCallback) {
     _onProgress = std::move(progressCallback);
 }
 
+void HttpDownload::setRequestHeaders(std::vector<std::string> headers) {
+    _requestHeaders = std::move(headers);
+}
+
 bool HttpDownload::hasFailed() const {
     return _isFinished && !_isSuccessful;
 }
@@ -181,60 +129,115 @@ bool HttpDownload::hasSucceeded() const {
 }
 
 void HttpDownload::start(std::chrono::milliseconds timeout) {
-    if (_isDownloading) {
-        return;
-    }
-    _isDownloading = true;
-    _downloadThread = std::thread([this, timeout]() {
+    {
+        std::lock_guard lock(_stateMutex);
+        if (_isDownloading) {
+            return;
+        }
+        _isDownloading = true;
         _isFinished = false;
-        LTRACEC("HttpDownload", fmt::format("Start download '{}'", _httpRequest.url()));
-
-        const bool setupSuccess = setup();
-        if (setupSuccess) {
-            _isSuccessful = _httpRequest.perform(timeout);
+    }
+    LTRACEC("HttpDownload", fmt::format("Start download '{}'", _url));
+
+    _transferId = HttpEngine::ref().submit({
+        .url = _url,
+        .timeout = timeout,
+        .priority = HttpEngine::Priority::Normal,
+        .requestHeaders = _requestHeaders,
+        .onStart = [this]() {
+            _isSetUp = !_shouldCancel && setup();
+            return _isSetUp;
+        },
+        .onHeader = [this](char* buffer, size_t size) {
+            std::string_view line = std::string_view(buffer, size);
+            if (line.starts_with("HTTP/")) {
+                // A new response is starting after a redirect
+                _responseHeaders.clear();
+            }
+            _responseHeaders.emplace_back(line);
+            return !_shouldCancel;
+        },
+        .onData = [this](char* buffer, size_t size) {
+            return handleData(buffer, size) && !_shouldCancel;
+        },
+        .onProgress = [this](size_t downloadedBytes, std::optional<size_t> totalBytes) {
+            bool cont = _onProgress ? _onProgress(downloadedBytes, totalBytes) : true;
+            return cont && !_shouldCancel;
+        },
+        .onFinish = [this](const HttpEngine::Result& result) {
+            bool success = isSuccessful(result, _url);
+            if (_isSetUp) {
+                const bool teardownSuccess = teardown();
+                success = success && teardownSuccess;
+            }
 
-            const bool teardownSuccess = teardown();
-            _isSuccessful = _isSuccessful && teardownSuccess;
-        }
-        else {
-            _isSuccessful = false;
-        }
+            if (success) {
+                LTRACEC(
+                    "HttpDownload",
+                    fmt::format("Finished async download '{}'", _url)
+                );
+            }
+            else {
+                LTRACEC("HttpDownload", fmt::format("Failed async download '{}'", _url));
+            }
 
-        _isFinished = true;
-        if (_isSuccessful) {
-            LTRACEC(
-                "HttpDownload",
-                fmt::format("Finished async download '{}'", _httpRequest.url())
-            );
-        }
-        else {
-            LTRACEC(
-                "HttpDownload",
-                fmt::format("Failed async download '{}'", _httpRequest.url())
-            );
+            {
+                std::lock_guard lock(_stateMutex);
+                _responseCode = result.responseCode;
+                _isSuccessful = success;
+                _isFinished = true;
+                _isDownloading = false;
+            }
+            _downloadFinishCondition.notify_all();
         }
-
-        _downloadFinishCondition.notify_all();
-        _isDownloading = false;
     });
 }
 
 void HttpDownload::cancel() {
     _shouldCancel = true;
+    if (_transferId != 0 && HttpEngine::isInitialized()) {
+        HttpEngine::ref().cancel(_transferId);
+    }
 }
 
 bool HttpDownload::wait() {
-    std::mutex conditionMutex;
-    std::unique_lock lock(conditionMutex);
-    _downloadFinishCondition.wait(lock, [this]() { return _isFinished; });
-    if (_downloadThread.joinable()) {
-        _downloadThread.join();
-    }
+    std::unique_lock lock(_stateMutex);
+    _downloadFinishCondition.wait(lock, [this]() { return !_isDownloading; });
     return _isSuccessful;
 }
 
 const std::string& HttpDownload::url() const {
-    return _httpRequest.url();
+    return _url;
+}
+
+long HttpDownload::responseCode() const {
+    return _responseCode;
+}
+
+std::optional<std::string> HttpDownload::responseHeader(std::string_view name) const {
+    std::optional<std::string> value;
+    for (const std::string& line : _responseHeaders) {
+        const size_t colon = line.find(':');
+        if (colon != name.size()) {
+            continue;
+        }
+
+        const bool matches = std::equal(
+            name.begin(), name.end(), line.begin(),
+            [](unsigned char a, unsigned char b) {
+                return std::tolower(a) == std::tolower(b);
+            }
+        );
+        if (matches) {
+            // The value is separated by optional whitespace and the line ends in CRLF
+            const size_t b = line.find_first_not_of(" \t", colon + 1);
+            const size_t e = line.find_last_not_of(" \t\r\n");
+            value = (b != std::string::npos && e >= b) ?
+                line.substr(b, e - b + 1) :
+                std::string();
+        }
+    }
+    return value;
 }
 
 bool HttpDownload::setup() {
@@ -269,6 +272,10 @@ bool HttpFileDownload::setup() {
         }
     }
 
+    // This is called on the HttpEngine's thread, which never has more than
+    // HttpEngine::MaxActiveTransfers downloads set up at the same time, so the engine
+    // does not stall here waiting for a handle
+    static_assert(HttpEngine::MaxActiveTransfers <= MaxFileHandles);
     while (nCurrentFileHandles >= MaxFileHandles) {
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
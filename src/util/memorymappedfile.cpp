@@ -0,0 +1,187 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/memorymappedfile.h>
+
+#include <ghoul/misc/assert.h>
+#include <cstdint>
+#include <utility>
+
+#ifdef WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // WIN32
+
+namespace openspace {
+
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& file, Mode mode) {
+    std::error_code ec;
+    const size_t fileSize = std::filesystem::file_size(file, ec);
+    if (ec || fileSize == 0) {
+        // Empty files cannot be mapped
+        return;
+    }
+
+#ifdef WIN32
+    HANDLE f = CreateFileW(
+        file.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (f == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    // The view keeps the file and the mapping object alive after the handles are closed
+    const bool isCopy = mode == Mode::CopyOnWrite;
+    HANDLE m = CreateFileMappingW(
+        f,
+        nullptr,
+        isCopy ? PAGE_WRITECOPY : PAGE_READONLY,
+        0,
+        0,
+        nullptr
+    );
+    CloseHandle(f);
+    if (!m) {
+        return;
+    }
+    void* data = MapViewOfFile(m, isCopy ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(m);
+    if (!data) {
+        return;
+    }
+#else
+    const int fd = open(file.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    // The mapping stays valid after the file descriptor is closed
+    const int protection =
+        mode == Mode::CopyOnWrite ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void* data = mmap(nullptr, fileSize, protection, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return;
+    }
+#endif // WIN32
+
+    _data = static_cast<std::byte*>(data);
+    _size = fileSize;
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+    : _data(std::exchange(other._data, nullptr))
+    , _size(std::exchange(other._size, 0))
+{}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+    }
+    return *this;
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    release();
+}
+
+bool MemoryMappedFile::isValid() const {
+    return _data != nullptr;
+}
+
+const std::byte* MemoryMappedFile::data() const {
+    return _data;
+}
+
+std::byte* MemoryMappedFile::data() {
+    return _data;
+}
+
+size_t MemoryMappedFile::size() const {
+    return _size;
+}
+
+void MemoryMappedFile::advise([[maybe_unused]] Usage usage,
+                              [[maybe_unused]] const void* begin,
+                              [[maybe_unused]] size_t size) const
+{
+    ghoul_assert(
+        static_cast<const std::byte*>(begin) >= _data &&
+        static_cast<const std::byte*>(begin) + size <= _data + _size,
+        "Range must lie within the mapped file"
+    );
+
+#ifndef WIN32
+    int advice = MADV_NORMAL;
+    switch (usage) {
+        case Usage::WillNeed:
+            advice = MADV_WILLNEED;
+            break;
+        case Usage::DontNeed:
+            advice = MADV_DONTNEED;
+            break;
+        case Usage::Random:
+            advice = MADV_RANDOM;
+            break;
+    }
+
+    // The advised range has to start at a page boundary
+    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t b = reinterpret_cast<uintptr_t>(begin) / pageSize * pageSize;
+    const uintptr_t e = reinterpret_cast<uintptr_t>(begin) + size;
+    madvise(reinterpret_cast<void*>(b), e - b, advice);
+#endif // WIN32
+}
+
+void MemoryMappedFile::advise(Usage usage) const {
+    if (_data) {
+        advise(usage, _data, _size);
+    }
+}
+
+void MemoryMappedFile::release() {
+    if (!_data) {
+        return;
+    }
+
+#ifdef WIN32
+    UnmapViewOfFile(_data);
+#else
+    munmap(_data, _size);
+#endif // WIN32
+
+    _data = nullptr;
+    _size = 0;
+}
+
+} // namespace openspace
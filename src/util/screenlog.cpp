@@ -24,19 +24,44 @@
 
 #include <openspace/util/screenlog.h>
 
+#include <ghoul/fmt.h>
 #include <algorithm>
 
+namespace {
+    // The number of messages that can be logged between two frames before new messages
+    // are dropped
+    constexpr size_t PendingCapacity = 4096;
+
+    // The maximum number of entries that are kept. The oldest entries are removed first
+    constexpr size_t MaxEntries = 256;
+} // namespace
+
 namespace openspace {
 
 ScreenLog::ScreenLog(std::chrono::seconds timeToLive, LogLevel logLevel)
-    : _timeToLive(std::move(timeToLive))
+    : _pending(PendingCapacity)
+    , _timeToLive(std::move(timeToLive))
     , _logLevel(logLevel)
 {
     _entries.reserve(64);
 }
 
 void ScreenLog::removeExpiredEntries() {
-    std::lock_guard guard(_mutex);
+    LogEntry entry;
+    while (_pending.tryPop(entry)) {
+        addEntry(std::move(entry));
+    }
+
+    if (const int nDropped = _nDropped.exchange(0);  nDropped > 0) {
+        addEntry({
+            LogLevel::Warning,
+            std::chrono::steady_clock::now(),
+            Log::timeString(),
+            "ScreenLog",
+            fmt::format("Skipped {} messages that arrived too quickly", nDropped)
+        });
+    }
+
     const auto t = std::chrono::steady_clock::now();
 
     const auto rit = std::remove_if(
@@ -49,16 +74,42 @@ void ScreenLog::removeExpiredEntries() {
 }
 
 void ScreenLog::log(LogLevel level, std::string_view category, std::string_view message) {
-    std::lock_guard guard(_mutex);
-    if (level >= _logLevel) {
-        _entries.push_back({
-            level,
-            std::chrono::steady_clock::now(),
-            Log::timeString(),
-            std::string(category),
-            std::string(message)
-        });
+    if (level < _logLevel) {
+        return;
+    }
+
+    const bool success = _pending.tryPush({
+        level,
+        std::chrono::steady_clock::now(),
+        Log::timeString(),
+        std::string(category),
+        std::string(message)
+    });
+    if (!success) {
+        _nDropped++;
+    }
+}
+
+void ScreenLog::addEntry(LogEntry entry) {
+    // Repeated messages usually follow each other closely, so we search from the back
+    const auto it = std::find_if(
+        _entries.rbegin(),
+        _entries.rend(),
+        [&entry](const LogEntry& e) {
+            return e.level == entry.level && e.category == entry.category &&
+                e.message == entry.message;
+        }
+    );
+
+    if (it != _entries.rend()) {
+        // Move the existing entry to the back, as it is now the most recent one
+        entry.count = it->count + 1;
+        _entries.erase(std::next(it).base());
+    }
+    else if (_entries.size() >= MaxEntries) {
+        _entries.erase(_entries.begin());
     }
+    _entries.push_back(std::move(entry));
 }
 
 const std::vector<ScreenLog::LogEntry>& ScreenLog::entries() const {
@@ -54,6 +54,11 @@ namespace {
         }
     }
 
+    // Unique number for each aberration correction to be used in the query cache keys
+    int aberrationKey(openspace::SpiceManager::AberrationCorrection a) {
+        return 2 * static_cast<int>(a.type) + static_cast<int>(a.direction);
+    }
+
     const char* toString(openspace::SpiceManager::TerminatorType t) {
         using SM = openspace::SpiceManager;
         switch (t) {
@@ -68,6 +73,43 @@ namespace {
 
 namespace openspace {
 
+namespace detail {
+
+void insertInterval(std::vector<std::pair<double, double>>& intervals, double begin,
+                    double end)
+{
+    auto first = std::lower_bound(
+        intervals.begin(),
+        intervals.end(),
+        begin,
+        [](const std::pair<double, double>& i, double t) { return i.second <= t; }
+    );
+    auto last = first;
+    while (last != intervals.end() && last->first < end) {
+        begin = std::min(begin, last->first);
+        end = std::max(end, last->second);
+        last++;
+    }
+    first = intervals.erase(first, last);
+    intervals.insert(first, { begin, end });
+}
+
+bool containsTime(const std::vector<std::pair<double, double>>& intervals, double t) {
+    // Find the first interval that starts after t; only the one before it can contain t
+    auto it = std::upper_bound(
+        intervals.begin(),
+        intervals.end(),
+        t,
+        [](double v, const std::pair<double, double>& i) { return v < i.first; }
+    );
+    if (it == intervals.begin()) {
+        return false;
+    }
+    return std::prev(it)->second > t;
+}
+
+} // namespace detail
+
 SpiceManager* SpiceManager::_instance = nullptr;
 
 SpiceManager::SpiceException::SpiceException(std::string msg)
@@ -246,6 +288,11 @@ SpiceManager::KernelHandle SpiceManager::loadKernel(std::string filePath) {
         throwSpiceError("Kernel loading");
     }
 
+    // The kernel might define new names for bodies and frames
+    _naifIdCache.clear();
+    _frameIdCache.clear();
+    clearQueryCache();
+
     std::filesystem::path fileExtension = path.extension();
     if (fileExtension == ".bc" || fileExtension == ".BC") {
         findCkCoverage(path.string()); // binary ck kernel
@@ -277,6 +324,9 @@ void SpiceManager::unloadKernel(KernelHandle kernelId) {
             LINFO(fmt::format("Unloading SPICE kernel {}", it->path));
             unload_c(it->path.c_str());
             _loadedKernels.erase(it);
+            _naifIdCache.clear();
+            _frameIdCache.clear();
+            clearQueryCache();
         }
         // Otherwise, we hold on to it, but reduce the reference counter by 1
         else {
@@ -313,6 +363,9 @@ void SpiceManager::unloadKernel(std::string filePath) {
             LINFO(fmt::format("Unloading SPICE kernel {}", path));
             unload_c(path.string().c_str());
             _loadedKernels.erase(it);
+            _naifIdCache.clear();
+            _frameIdCache.clear();
+            clearQueryCache();
         }
         else {
             // Otherwise, we hold on to it, but reduce the reference counter by 1
@@ -325,22 +378,14 @@ void SpiceManager::unloadKernel(std::string filePath) {
 bool SpiceManager::hasSpkCoverage(const std::string& target, double et) const {
     ghoul_assert(!target.empty(), "Empty target");
 
-    const int id = naifId(target);
+    const int id = cachedNaifId(target);
     // SOLAR SYSTEM BARYCENTER special case, implicitly included by Spice
     if (id == 0) {
         return true;
     }
 
-    const auto it = _spkIntervals.find(id);
-    if (it != _spkIntervals.end()) {
-        const std::vector<std::pair<double, double>>& intervalVector = it->second;
-        for (const std::pair<double, double>& vecElement : intervalVector) {
-            if ((vecElement.first < et) && (vecElement.second > et)) {
-                return true;
-            }
-        }
-    }
-    return false;
+    const auto it = _spkMergedIntervals.find(id);
+    return it != _spkMergedIntervals.end() && detail::containsTime(it->second, et);
 }
 
 std::vector<std::pair<double, double>> SpiceManager::spkCoverage(
@@ -363,17 +408,9 @@ std::vector<std::pair<double, double>> SpiceManager::spkCoverage(
 bool SpiceManager::hasCkCoverage(const std::string& frame, double et) const {
     ghoul_assert(!frame.empty(), "Empty target");
 
-    const int id = frameId(frame);
-    const auto it = _ckIntervals.find(id);
-    if (it != _ckIntervals.end()) {
-        const std::vector<std::pair<double, double>>& intervalVector = it->second;
-        for (const std::pair<double, double>& i : intervalVector) {
-            if ((i.first < et) && (i.second > et)) {
-                return true;
-            }
-        }
-    }
-    return false;
+    const int id = cachedFrameId(frame);
+    const auto it = _ckMergedIntervals.find(id);
+    return it != _ckMergedIntervals.end() && detail::containsTime(it->second, et);
 }
 
 std::vector<std::pair<double, double>> SpiceManager::ckCoverage(
@@ -479,6 +516,28 @@ int SpiceManager::naifId(const std::string& body) const {
     return id;
 }
 
+int SpiceManager::cachedNaifId(const std::string& body) const {
+    const auto it = _naifIdCache.find(body);
+    if (it != _naifIdCache.end()) {
+        return it->second;
+    }
+
+    SpiceBoolean success;
+    SpiceInt id;
+    bods2c_c(body.c_str(), &id, &success);
+    if (!success) {
+        if (_useExceptions) {
+            throw SpiceException(
+                fmt::format("Could not find NAIF ID of body '{}'", body)
+            );
+        }
+        // Failed lookups are not cached as they would be stuck until the next kernel
+        return id;
+    }
+    _naifIdCache[body] = id;
+    return id;
+}
+
 bool SpiceManager::hasNaifId(const std::string& body) const {
     ghoul_assert(!body.empty(), "Empty body");
 
@@ -500,6 +559,19 @@ int SpiceManager::frameId(const std::string& frame) const {
     return id;
 }
 
+int SpiceManager::cachedFrameId(const std::string& frame) const {
+    const auto it = _frameIdCache.find(frame);
+    if (it != _frameIdCache.end()) {
+        return it->second;
+    }
+
+    const int id = frameId(frame);
+    if (id != 0) {
+        _frameIdCache[frame] = id;
+    }
+    return id;
+}
+
 bool SpiceManager::hasFrameId(const std::string& frame) const {
     ghoul_assert(!frame.empty(), "Empty frame");
 
@@ -609,11 +681,89 @@ std::string SpiceManager::dateFromEphemerisTime(double ephemerisTime, const char
     return std::string(Buffer);
 }
 
+void SpiceManager::setQueryCacheTime(double ephemerisTime) {
+    std::lock_guard lock(_queryCacheMutex);
+    if (ephemerisTime != _queryCacheTime) {
+        _positionCache.clear();
+        _stateCache.clear();
+        _transformCache.clear();
+        _queryCacheTime = ephemerisTime;
+    }
+}
+
+void SpiceManager::clearQueryCache() {
+    std::lock_guard lock(_queryCacheMutex);
+    _positionCache.clear();
+    _stateCache.clear();
+    _transformCache.clear();
+}
+
+template <typename T, typename Func>
+T SpiceManager::memoized(std::map<QueryKey, T, std::less<>>& cache,
+                         const QueryKeyView& key, Func compute) const
+{
+    const double time = std::get<4>(key);
+    {
+        std::lock_guard lock(_queryCacheMutex);
+        if (time != _queryCacheTime) {
+            return compute();
+        }
+        const auto it = cache.find(key);
+        if (it != cache.end()) {
+            return it->second;
+        }
+    }
+
+    // The lock is not held while computing so that an exception thrown by SPICE leaves
+    // the cache untouched
+    T result = compute();
+    std::lock_guard lock(_queryCacheMutex);
+    if (time == _queryCacheTime) {
+        cache.emplace(QueryKey(key), result);
+    }
+    return result;
+}
+
 glm::dvec3 SpiceManager::targetPosition(const std::string& target,
                                         const std::string& observer,
                                         const std::string& referenceFrame,
                                         AberrationCorrection aberrationCorrection,
                                         double ephemerisTime, double& lightTime) const
+{
+    ZoneScoped;
+
+    const std::pair<glm::dvec3, double> res = memoized(
+        _positionCache,
+        QueryKeyView(
+            target,
+            observer,
+            referenceFrame,
+            aberrationKey(aberrationCorrection),
+            ephemerisTime
+        ),
+        [&]() {
+            double lt = 0.0;
+            glm::dvec3 p = uncachedTargetPosition(
+                target,
+                observer,
+                referenceFrame,
+                aberrationCorrection,
+                ephemerisTime,
+                lt
+            );
+            return std::pair(p, lt);
+        }
+    );
+    lightTime = res.second;
+    return res.first;
+}
+
+glm::dvec3 SpiceManager::uncachedTargetPosition(const std::string& target,
+                                                const std::string& observer,
+                                                const std::string& referenceFrame,
+                                                AberrationCorrection aberrationCorrection,
+                                                double ephemerisTime,
+                                                double& lightTime) const
 {
     ghoul_assert(!target.empty(), "Target is not empty");
     ghoul_assert(!observer.empty(), "Observer is not empty");
@@ -701,26 +851,31 @@ glm::dmat3 SpiceManager::frameTransformationMatrix(const std::string& from,
     ghoul_assert(!from.empty(), "From must not be empty");
     ghoul_assert(!to.empty(), "To must not be empty");
 
-    // get rotation matrix from frame A - frame B
-    glm::dmat3 transform = glm::dmat3(1.0);
-    pxform_c(
-        from.c_str(),
-        to.c_str(),
-        ephemerisTime,
-        reinterpret_cast<double(*)[3]>(glm::value_ptr(transform))
-    );
-
-    if (failed_c()) {
-        throwSpiceError(
-            fmt::format("Error converting from frame '{}' to frame '{}' at time '{}'",
-                from, to, ephemerisTime
-            )
+    // The empty string is a stand-in for the observer, 0 marks this kind of query
+    static const std::string Empty;
+    const QueryKeyView key = QueryKeyView(from, to, Empty, 0, ephemerisTime);
+    return memoized(_transformCache, key, [&]() {
+        // get rotation matrix from frame A - frame B
+        glm::dmat3 transform = glm::dmat3(1.0);
+        pxform_c(
+            from.c_str(),
+            to.c_str(),
+            ephemerisTime,
+            reinterpret_cast<double(*)[3]>(glm::value_ptr(transform))
         );
-    }
 
-    // The rox-major, column-major order are switched in GLM and SPICE, so we have to
-    // transpose the matrix before we can return it
-    return glm::transpose(transform);
+        if (failed_c()) {
+            throwSpiceError(
+                fmt::format("Error converting from frame '{}' to frame '{}' at time '{}'",
+                    from, to, ephemerisTime
+                )
+            );
+        }
+
+        // The rox-major, column-major order are switched in GLM and SPICE, so we have to
+        // transpose the matrix before we can return it
+        return glm::transpose(transform);
+    });
 }
 
 SpiceManager::SurfaceInterceptResult SpiceManager::surfaceIntercept(
@@ -815,32 +970,41 @@ SpiceManager::TargetStateResult SpiceManager::targetState(const std::string& tar
     ghoul_assert(!observer.empty(), "Observer must not be empty");
     ghoul_assert(!referenceFrame.empty(), "Reference frame must not be empty");
 
-    TargetStateResult result;
-    result.lightTime = 0.0;
+    const QueryKeyView key = QueryKeyView(
+        target,
+        observer,
+        referenceFrame,
+        aberrationKey(aberrationCorrection),
+        ephemerisTime
+    );
+    return memoized(_stateCache, key, [&]() {
+        TargetStateResult result;
+        result.lightTime = 0.0;
 
-    double buffer[6];
+        double buffer[6];
 
-    spkezr_c(
-        target.c_str(),
-        ephemerisTime,
-        referenceFrame.c_str(),
-        aberrationCorrection,
-        observer.c_str(),
-        buffer,
-        &result.lightTime
-    );
+        spkezr_c(
+            target.c_str(),
+            ephemerisTime,
+            referenceFrame.c_str(),
+            aberrationCorrection,
+            observer.c_str(),
+            buffer,
+            &result.lightTime
+        );
 
-    if (failed_c()) {
-        throwSpiceError(fmt::format(
-            "Error retrieving state of target '{}' viewed from observer '{}' in "
-            "reference frame '{}' at time '{}'",
-            target, observer, referenceFrame, ephemerisTime
-        ));
-    }
+        if (failed_c()) {
+            throwSpiceError(fmt::format(
+                "Error retrieving state of target '{}' viewed from observer '{}' in "
+                "reference frame '{}' at time '{}'",
+                target, observer, referenceFrame, ephemerisTime
+            ));
+        }
 
-    memmove(glm::value_ptr(result.position), buffer, sizeof(double) * 3);
-    memmove(glm::value_ptr(result.velocity), buffer + 3, sizeof(double) * 3);
-    return result;
+        memmove(glm::value_ptr(result.position), buffer, sizeof(double) * 3);
+        memmove(glm::value_ptr(result.velocity), buffer + 3, sizeof(double) * 3);
+        return result;
+    });
 }
 
 SpiceManager::TransformMatrix SpiceManager::stateTransformMatrix(
@@ -875,28 +1039,40 @@ glm::dmat3 SpiceManager::positionTransformMatrix(const std::string& sourceFrame,
     ghoul_assert(!sourceFrame.empty(), "sourceFrame must not be empty");
     ghoul_assert(!destinationFrame.empty(), "destinationFrame must not be empty");
 
-    glm::dmat3 result = glm::dmat3(1.0);
-    pxform_c(
-        sourceFrame.c_str(),
-        destinationFrame.c_str(),
-        ephemerisTime,
-        reinterpret_cast<double(*)[3]>(glm::value_ptr(result))
+    // 1 separates these from the frameTransformationMatrix queries, which don't fall
+    // back to an estimated matrix
+    static const std::string Empty;
+    const QueryKeyView key = QueryKeyView(
+        sourceFrame,
+        destinationFrame,
+        Empty,
+        1,
+        ephemerisTime
     );
-
-    if (failed_c()) {
-        throwSpiceError("");
-    }
-    SpiceBoolean success = !(failed_c());
-    reset_c();
-    if (!success) {
-        result = getEstimatedTransformMatrix(
-            sourceFrame,
-            destinationFrame,
-            ephemerisTime
+    return memoized(_transformCache, key, [&]() {
+        glm::dmat3 result = glm::dmat3(1.0);
+        pxform_c(
+            sourceFrame.c_str(),
+            destinationFrame.c_str(),
+            ephemerisTime,
+            reinterpret_cast<double(*)[3]>(glm::value_ptr(result))
         );
-    }
 
-    return glm::transpose(result);
+        if (failed_c()) {
+            throwSpiceError("");
+        }
+        SpiceBoolean success = !(failed_c());
+        reset_c();
+        if (!success) {
+            result = getEstimatedTransformMatrix(
+                sourceFrame,
+                destinationFrame,
+                ephemerisTime
+            );
+        }
+
+        return glm::transpose(result);
+    });
 }
 
 glm::dmat3 SpiceManager::positionTransformMatrix(const std::string& sourceFrame,
@@ -1078,6 +1254,7 @@ void SpiceManager::findCkCoverage(const std::string& path) {
             _ckCoverageTimes[frame].insert(e);
             _ckCoverageTimes[frame].insert(b);
             _ckIntervals[frame].emplace_back(b, e);
+            detail::insertInterval(_ckMergedIntervals[frame], b, e);
         }
     }
 }
@@ -1138,6 +1315,7 @@ void SpiceManager::findSpkCoverage(const std::string& path) {
             _spkCoverageTimes[obj].insert(e);
             _spkCoverageTimes[obj].insert(b);
             _spkIntervals[obj].emplace_back(b, e);
+            detail::insertInterval(_spkMergedIntervals[obj], b, e);
         }
     }
 }
@@ -0,0 +1,73 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/stablehash.h>
+
+#include <array>
+#include <fstream>
+
+namespace {
+    constexpr uint64_t Prime = 1099511628211ULL;
+} // namespace
+
+namespace openspace {
+
+uint64_t stableHash(std::string_view data, uint64_t hash) {
+    for (char c : data) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= Prime;
+    }
+    return hash;
+}
+
+void stableHashCombine(uint64_t& hash, std::string_view data) {
+    hash = stableHash(data, hash);
+    const uint64_t size = data.size();
+    for (int i = 0; i < 8; i++) {
+        hash ^= (size >> (i * 8)) & 0xFF;
+        hash *= Prime;
+    }
+}
+
+std::optional<StableFileHash> stableHashFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ifstream::binary);
+    if (!file.good()) {
+        return std::nullopt;
+    }
+
+    StableFileHash result;
+    std::array<char, 1 << 16> buffer;
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        const std::streamsize n = file.gcount();
+        result.hash = stableHash(std::string_view(buffer.data(), n), result.hash);
+        result.size += static_cast<uint64_t>(n);
+    }
+    if (file.bad()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+} // namespace openspace
@@ -0,0 +1,281 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/startupprofiler.h>
+
+#include <openspace/engine/globals.h>
+#include <openspace/json.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <numeric>
+
+namespace {
+    constexpr std::string_view _loggerCat = "StartupProfiler";
+
+    // The number of steps that enclose the step that is currently being recorded
+    thread_local uint8_t CurrentDepth = 0;
+
+    // Sequential numbers for the threads that recorded steps
+    std::atomic<uint16_t> NextThreadIndex = 0;
+    thread_local uint16_t ThreadIndex = NextThreadIndex++;
+
+    // Keep in sync with StartupProfiler::Category
+    constexpr std::array<const char*, 6> CategoryNames = {
+        "Engine", "AssetLoad", "AssetSynchronization", "AssetInitialize",
+        "NodeInitialize", "NodeInitializeGL"
+    };
+
+    double toMs(uint64_t ns) {
+        return static_cast<double>(ns) / 1e6;
+    }
+} // namespace
+
+namespace openspace {
+
+StartupProfiler::Scope::Scope(Category category, std::string name)
+    : _category(category)
+    , _isActive(global::startupProfiler && global::startupProfiler->isRecording())
+{
+    if (!_isActive) {
+        return;
+    }
+
+    _name = std::move(name);
+    _depth = CurrentDepth++;
+    _begin = global::startupProfiler->toNanoseconds(std::chrono::steady_clock::now());
+}
+
+StartupProfiler::Scope::~Scope() {
+    if (!_isActive) {
+        return;
+    }
+
+    const uint64_t end =
+        global::startupProfiler->toNanoseconds(std::chrono::steady_clock::now());
+    CurrentDepth--;
+
+    if (!global::startupProfiler->isRecording()) {
+        return;
+    }
+    std::lock_guard lock(global::startupProfiler->_mutex);
+    global::startupProfiler->_records.push_back({
+        .category = _category,
+        .name = std::move(_name),
+        .begin = _begin,
+        .duration = end - _begin,
+        .thread = ThreadIndex,
+        .depth = _depth
+    });
+}
+
+StartupProfiler::StartupProfiler()
+    : _epoch(std::chrono::steady_clock::now())
+{}
+
+void StartupProfiler::record(Category category, std::string name,
+                             std::chrono::steady_clock::time_point begin,
+                             std::chrono::steady_clock::time_point end)
+{
+    if (!_isRecording) {
+        return;
+    }
+
+    const uint64_t b = toNanoseconds(begin);
+    const uint64_t e = toNanoseconds(end);
+    std::lock_guard lock(_mutex);
+    _records.push_back({
+        .category = category,
+        .name = std::move(name),
+        .begin = b,
+        .duration = e > b ? e - b : 0,
+        .thread = AsyncThread,
+        .depth = 0
+    });
+}
+
+void StartupProfiler::finish(const std::filesystem::path& path) {
+    if (!_isRecording.exchange(false)) {
+        return;
+    }
+
+    std::vector<Record> records;
+    {
+        std::lock_guard lock(_mutex);
+        records = std::move(_records);
+        _records.clear();
+    }
+    if (records.empty()) {
+        return;
+    }
+
+    // Order by thread and beginning, with enclosing steps before the steps they contain
+    std::sort(
+        records.begin(),
+        records.end(),
+        [](const Record& lhs, const Record& rhs) {
+            if (lhs.thread != rhs.thread) {
+                return lhs.thread < rhs.thread;
+            }
+            if (lhs.begin != rhs.begin) {
+                return lhs.begin < rhs.begin;
+            }
+            return lhs.depth < rhs.depth;
+        }
+    );
+
+    // The exclusive time is the duration minus the durations of the directly enclosed
+    // steps on the same thread, which we find with a stack of the currently open steps
+    std::vector<uint64_t> selfTimes(records.size());
+    std::vector<size_t> open;
+    for (size_t i = 0; i < records.size(); i++) {
+        const Record& r = records[i];
+        selfTimes[i] = r.duration;
+        while (!open.empty()) {
+            const Record& top = records[open.back()];
+            const bool isParent = top.thread == r.thread &&
+                top.depth < r.depth &&
+                r.begin + r.duration <= top.begin + top.duration;
+            if (isParent) {
+                break;
+            }
+            open.pop_back();
+        }
+        if (!open.empty()) {
+            selfTimes[open.back()] -= std::min(selfTimes[open.back()], r.duration);
+        }
+        open.push_back(i);
+    }
+
+    uint64_t startupEnd = 0;
+    for (const Record& r : records) {
+        startupEnd = std::max(startupEnd, r.begin + r.duration);
+    }
+
+    nlohmann::json report;
+    report["totalMs"] = toMs(startupEnd);
+
+    // Totals per category, using the exclusive times so that nested steps of the same
+    // category, such as required assets, are not counted twice
+    nlohmann::json categories = nlohmann::json::object();
+    for (size_t i = 0; i < CategoryNames.size(); i++) {
+        size_t count = 0;
+        uint64_t total = 0;
+        for (size_t j = 0; j < records.size(); j++) {
+            if (static_cast<size_t>(records[j].category) == i) {
+                count++;
+                total += selfTimes[j];
+            }
+        }
+        categories[CategoryNames[i]] = { { "count", count }, { "selfMs", toMs(total) } };
+    }
+    report["categories"] = categories;
+
+    // All steps, ordered by their exclusive time so that the most expensive come first
+    std::vector<size_t> order(records.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(
+        order.begin(),
+        order.end(),
+        [&selfTimes](size_t lhs, size_t rhs) { return selfTimes[lhs] > selfTimes[rhs]; }
+    );
+    nlohmann::json items = nlohmann::json::array();
+    for (size_t i : order) {
+        const Record& r = records[i];
+        items.push_back({
+            { "category", CategoryNames[static_cast<size_t>(r.category)] },
+            { "name", r.name },
+            { "thread", r.thread },
+            { "beginMs", toMs(r.begin) },
+            { "durationMs", toMs(r.duration) },
+            { "selfMs", toMs(selfTimes[i]) }
+        });
+    }
+    report["items"] = items;
+
+    // The critical path starts with the outermost step that ended last and continues
+    // backwards through the outermost step that ended last before the current one began
+    std::vector<const Record*> path;
+    const Record* current = nullptr;
+    for (const Record& r : records) {
+        if (r.depth == 0 && (!current ||
+            r.begin + r.duration > current->begin + current->duration))
+        {
+            current = &r;
+        }
+    }
+    while (current) {
+        path.push_back(current);
+        const Record* previous = nullptr;
+        for (const Record& r : records) {
+            const uint64_t end = r.begin + r.duration;
+            if (r.depth == 0 && end <= current->begin &&
+                (!previous || end > previous->begin + previous->duration))
+            {
+                previous = &r;
+            }
+        }
+        current = previous;
+    }
+    std::reverse(path.begin(), path.end());
+
+    nlohmann::json criticalPath = nlohmann::json::array();
+    uint64_t previousEnd = 0;
+    for (const Record* r : path) {
+        criticalPath.push_back({
+            { "category", CategoryNames[static_cast<size_t>(r->category)] },
+            { "name", r->name },
+            { "beginMs", toMs(r->begin) },
+            { "durationMs", toMs(r->duration) },
+            { "waitMs", toMs(r->begin - previousEnd) }
+        });
+        previousEnd = r->begin + r->duration;
+    }
+    report["criticalPath"] = criticalPath;
+
+    std::ofstream file(path);
+    if (!file.good()) {
+        LERROR(fmt::format("Could not write startup profile to {}", path));
+        return;
+    }
+    file << report.dump(2);
+    LINFO(fmt::format(
+        "Startup took {:.1f} s. Wrote startup profile to {}",
+        toMs(startupEnd) / 1000.0, path
+    ));
+}
+
+bool StartupProfiler::isRecording() const {
+    return _isRecording;
+}
+
+uint64_t StartupProfiler::toNanoseconds(std::chrono::steady_clock::time_point time) const
+{
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<nanoseconds>(time - _epoch).count());
+}
+
+} // namespace openspace
@@ -25,13 +25,15 @@
 #include <openspace/util/syncbuffer.h>
 
 #include <ghoul/misc/profiling.h>
+#include <algorithm>
 
 namespace openspace {
 
 SyncBuffer::SyncBuffer(size_t n)
     : _n(n)
 {
-    _dataStream.resize(_n);
+    _buffers[0].resize(_n);
+    _buffers[1].resize(_n);
 }
 
 SyncBuffer::~SyncBuffer() {}
@@ -39,39 +41,43 @@ SyncBuffer::~SyncBuffer() {}
 void SyncBuffer::encode(const std::string& s) {
     ZoneScoped;
 
-    int32_t anticpatedBufferSize = static_cast<int32_t>(
-        _encodeOffset + (sizeof(char) * s.size()) + sizeof(int32_t)
-    );
-    if (anticpatedBufferSize >= static_cast<int32_t>(_n)) {
-        _dataStream.resize(anticpatedBufferSize);
-    }
+    reserve(sizeof(char) * s.size() + sizeof(int32_t));
 
+    std::byte* data = _buffers[_activeBuffer].data();
     int32_t length = static_cast<int32_t>(s.size() * sizeof(char));
     memcpy(
-        _dataStream.data() + _encodeOffset,
+        data + _encodeOffset,
         reinterpret_cast<const char*>(&length),
         sizeof(int32_t)
     );
     _encodeOffset += sizeof(int32_t);
-    memcpy(_dataStream.data() + _encodeOffset, s.c_str(), length);
+    memcpy(data + _encodeOffset, s.c_str(), length);
     _encodeOffset += length;
 }
 
 std::string SyncBuffer::decode() {
     ZoneScoped;
 
+    ghoul_assert(
+        _decodeOffset + sizeof(int32_t) <= _decodeData.size(),
+        "Reading past the end"
+    );
     int32_t length;
     memcpy(
         reinterpret_cast<char*>(&length),
-        _dataStream.data() + _decodeOffset,
+        _decodeData.data() + _decodeOffset,
         sizeof(int32_t)
     );
-    std::vector<char> tmp(length + 1);
     _decodeOffset += sizeof(int32_t);
-    memcpy(tmp.data(), _dataStream.data() + _decodeOffset, length);
+    ghoul_assert(
+        _decodeOffset + length <= _decodeData.size(),
+        "Reading past the end"
+    );
+    std::string ret(
+        reinterpret_cast<const char*>(_decodeData.data() + _decodeOffset),
+        length
+    );
     _decodeOffset += length;
-    tmp[length] = '\0';
-    std::string ret(tmp.data());
     return ret;
 }
 
@@ -81,46 +87,59 @@ void SyncBuffer::decode(std::string& s) {
 
 void SyncBuffer::decode(glm::quat& value) {
     const size_t size = sizeof(glm::quat);
-    ghoul_assert(_decodeOffset + size < _n, "");
-    std::memcpy(glm::value_ptr(value), _dataStream.data() + _decodeOffset, size);
+    ghoul_assert(_decodeOffset + size <= _decodeData.size(), "Reading past the end");
+    std::memcpy(glm::value_ptr(value), _decodeData.data() + _decodeOffset, size);
     _decodeOffset += size;
 }
 
 void SyncBuffer::decode(glm::dquat& value) {
     const size_t size = sizeof(glm::dquat);
-    ghoul_assert(_decodeOffset + size < _n, "");
-    std::memcpy(glm::value_ptr(value), _dataStream.data() + _decodeOffset, size);
+    ghoul_assert(_decodeOffset + size <= _decodeData.size(), "Reading past the end");
+    std::memcpy(glm::value_ptr(value), _decodeData.data() + _decodeOffset, size);
     _decodeOffset += size;
 }
 
 void SyncBuffer::decode(glm::vec3& value) {
     const size_t size = sizeof(glm::vec3);
-    ghoul_assert(_decodeOffset + size < _n, "");
-    std::memcpy(glm::value_ptr(value), _dataStream.data() + _decodeOffset, size);
+    ghoul_assert(_decodeOffset + size <= _decodeData.size(), "Reading past the end");
+    std::memcpy(glm::value_ptr(value), _decodeData.data() + _decodeOffset, size);
     _decodeOffset += size;
 }
 
 void SyncBuffer::decode(glm::dvec3& value) {
     const size_t size = sizeof(glm::dvec3);
-    ghoul_assert(_decodeOffset + size < _n, "");
-    std::memcpy(glm::value_ptr(value), _dataStream.data() + _decodeOffset, size);
+    ghoul_assert(_decodeOffset + size <= _decodeData.size(), "Reading past the end");
+    std::memcpy(glm::value_ptr(value), _decodeData.data() + _decodeOffset, size);
     _decodeOffset += size;
 }
 
-void SyncBuffer::setData(std::vector<std::byte> data) {
-    _dataStream = std::move(data);
+void SyncBuffer::setData(std::span<const std::byte> data) {
+    _decodeData = data;
+    _decodeOffset = 0;
 }
 
-std::vector<std::byte> SyncBuffer::data() {
-    _dataStream.resize(_encodeOffset);
+std::span<const std::byte> SyncBuffer::encodedData() const {
+    return std::span<const std::byte>(_buffers[_activeBuffer].data(), _encodeOffset);
+}
 
-    return _dataStream;
+void SyncBuffer::reserve(size_t size) {
+    std::vector<std::byte>& buffer = _buffers[_activeBuffer];
+    if (_encodeOffset + size > buffer.size()) {
+        // Grow geometrically and remember the new size so that the other buffer is
+        // enlarged as well the next time it is used and the growth does not repeat
+        _n = std::max(_encodeOffset + size, 2 * buffer.size());
+        buffer.resize(_n);
+    }
 }
 
 void SyncBuffer::reset() {
-    _dataStream.resize(_n);
+    _activeBuffer = (_activeBuffer + 1) % _buffers.size();
+    if (_buffers[_activeBuffer].size() < _n) {
+        _buffers[_activeBuffer].resize(_n);
+    }
     _encodeOffset = 0;
     _decodeOffset = 0;
+    _decodeData = std::span<const std::byte>();
 }
 
 } // namespace openspace
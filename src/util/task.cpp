@@ -28,7 +28,9 @@
 #include <openspace/documentation/verifier.h>
 #include <openspace/util/factorymanager.h>
 #include <ghoul/misc/dictionary.h>
+#include <ghoul/misc/dictionaryjsonformatter.h>
 #include <ghoul/misc/templatefactory.h>
+#include <optional>
 
 namespace {
     struct [[codegen::Dictionary(Task)]] Parameters {
@@ -36,6 +38,23 @@ namespace {
         // valid Tasks that are available for creation (see the FactoryDocumentation for a
         // list of possible Tasks), which depends on the configration of the application
         std::string type [[codegen::annotation("A valid Task created by a factory")]];
+
+        // An identifier by which other tasks in the same task file can declare that they
+        // depend on this task
+        std::optional<std::string> identifier [[codegen::identifier()]];
+
+        // The identifiers of the tasks that have to be finished before this task is
+        // started. If any of these tasks fails, this task is not performed
+        std::optional<std::vector<std::string>> dependencies;
+
+        // The number of threads that this task uses. The TaskRunner does not start more
+        // tasks concurrently than it has threads available
+        std::optional<int> threads [[codegen::greater(0)]];
+
+        // The estimated peak amount of memory, in megabytes, that this task uses. If the
+        // TaskRunner has a memory limit, tasks are only started concurrently while their
+        // combined estimates stay below that limit
+        std::optional<int> memory [[codegen::greaterequal(0)]];
     };
 #include "task_codegen.cpp"
 } // namespace
@@ -51,7 +70,36 @@ std::unique_ptr<Task> Task::createFromDictionary(const ghoul::Dictionary& dictio
 
     ghoul::TemplateFactory<Task>* factory = FactoryManager::ref().factory<Task>();
     Task* task = factory->create(p.type, dictionary);
+    if (task) {
+        Scheduling scheduling;
+        scheduling.identifier = p.identifier.value_or(scheduling.identifier);
+        scheduling.dependencies = p.dependencies.value_or(scheduling.dependencies);
+        scheduling.nThreads = p.threads.value_or(scheduling.nThreads);
+        scheduling.memory = p.memory.value_or(scheduling.memory);
+        task->setScheduling(std::move(scheduling));
+        task->_parameters = ghoul::formatJson(dictionary);
+    }
     return std::unique_ptr<Task>(task);
 }
 
+std::vector<std::filesystem::path> Task::inputFiles() const {
+    return {};
+}
+
+std::vector<std::filesystem::path> Task::outputFiles() const {
+    return {};
+}
+
+const Task::Scheduling& Task::scheduling() const {
+    return _scheduling;
+}
+
+void Task::setScheduling(Scheduling scheduling) {
+    _scheduling = std::move(scheduling);
+}
+
+const std::string& Task::parameters() const {
+    return _parameters;
+}
+
 } // namespace openspace
@@ -0,0 +1,264 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/taskcache.h>
+
+#include <openspace/json.h>
+#include <openspace/util/stablehash.h>
+#include <openspace/util/task.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <fstream>
+
+namespace {
+    constexpr std::string_view _loggerCat = "TaskCache";
+
+    // Returns the stable hash of the contents of the file, or an empty string if the file
+    // could not be read, which never matches a previously stored hash
+    std::string hashFile(const std::filesystem::path& path) {
+        const std::optional<openspace::StableFileHash> hash =
+            openspace::stableHashFile(path);
+        return hash.has_value() ? fmt::format("{:016x}", hash->hash) : std::string();
+    }
+
+    std::string hashString(std::string_view s) {
+        return fmt::format("{:016x}", openspace::stableHash(s));
+    }
+
+    // Returns all files that are in the list of paths, where folders are replaced by the
+    // files that they contain. Paths that do not exist are ignored
+    std::vector<std::filesystem::path> expandFolders(
+                                         const std::vector<std::filesystem::path>& paths)
+    {
+        std::vector<std::filesystem::path> res;
+        for (const std::filesystem::path& path : paths) {
+            if (std::filesystem::is_regular_file(path)) {
+                res.push_back(path);
+            }
+            else if (std::filesystem::is_directory(path)) {
+                const size_t first = res.size();
+                using It = std::filesystem::recursive_directory_iterator;
+                for (const std::filesystem::directory_entry& e : It(path)) {
+                    if (e.is_regular_file()) {
+                        res.push_back(e.path());
+                    }
+                }
+                // The iteration order of folders is unspecified
+                std::sort(res.begin() + first, res.end());
+            }
+        }
+        return res;
+    }
+
+    int64_t modificationTime(const std::filesystem::path& path) {
+        return std::filesystem::last_write_time(path).time_since_epoch().count();
+    }
+} // namespace
+
+namespace openspace {
+
+TaskCache::TaskCache(std::filesystem::path path)
+    : _path(std::move(path))
+{
+    std::ifstream file(_path);
+    if (!file.good()) {
+        return;
+    }
+
+    nlohmann::json json = nlohmann::json::parse(file, nullptr, false);
+    if (json.is_discarded() || !json.is_object()) {
+        LWARNING(fmt::format("Ignoring malformed task cache {}", _path));
+        return;
+    }
+
+    auto readStates = [](const nlohmann::json& states) {
+        std::vector<FileState> res;
+        for (const nlohmann::json& s : states) {
+            FileState state;
+            state.path = s["path"].get<std::string>();
+            state.size = s["size"].get<uint64_t>();
+            state.modificationTime = s["time"].get<int64_t>();
+            state.hash = s.value("hash", "");
+            res.push_back(std::move(state));
+        }
+        return res;
+    };
+
+    try {
+        for (const auto& [key, record] : json.items()) {
+            _records[key] = {
+                .inputs = readStates(record["inputs"]),
+                .outputs = readStates(record["outputs"])
+            };
+        }
+    }
+    catch (const nlohmann::json::exception& e) {
+        LWARNING(fmt::format("Ignoring malformed task cache {}: {}", _path, e.what()));
+        _records.clear();
+    }
+}
+
+bool TaskCache::isUpToDate(const Task& task) {
+    const std::vector<std::filesystem::path> outputFiles = task.outputFiles();
+    if (outputFiles.empty()) {
+        return false;
+    }
+
+    const std::string key = hashString(task.parameters());
+    Record record;
+    {
+        std::lock_guard lock(_mutex);
+        auto it = _records.find(key);
+        if (it == _records.end()) {
+            return false;
+        }
+        record = it->second;
+    }
+
+    // The outputs must not have been removed or modified since the task was performed
+    const std::vector<FileState> outputs = fileStates(outputFiles, nullptr);
+    const bool hasSameOutputs = std::equal(
+        outputs.begin(), outputs.end(),
+        record.outputs.begin(), record.outputs.end(),
+        [](const FileState& lhs, const FileState& rhs) {
+            return lhs.path == rhs.path && lhs.size == rhs.size &&
+                lhs.modificationTime == rhs.modificationTime;
+        }
+    );
+    if (!hasSameOutputs) {
+        return false;
+    }
+
+    // Inputs might have been touched without their contents changing, in which case
+    // only the hash decides
+    std::vector<FileState> inputs = fileStates(task.inputFiles(), &record.inputs);
+    const bool hasSameInputs = std::equal(
+        inputs.begin(), inputs.end(),
+        record.inputs.begin(), record.inputs.end(),
+        [](const FileState& lhs, const FileState& rhs) {
+            return lhs.path == rhs.path && lhs.hash == rhs.hash;
+        }
+    );
+    if (!hasSameInputs) {
+        return false;
+    }
+
+    // Remember the new modification times so that the files are not hashed again
+    if (inputs != record.inputs) {
+        std::lock_guard lock(_mutex);
+        _records[key].inputs = std::move(inputs);
+    }
+    return true;
+}
+
+void TaskCache::update(const Task& task) {
+    const std::string key = hashString(task.parameters());
+    std::vector<FileState> previous;
+    {
+        std::lock_guard lock(_mutex);
+        auto it = _records.find(key);
+        if (it != _records.end()) {
+            previous = it->second.inputs;
+        }
+    }
+
+    Record record = {
+        .inputs = fileStates(task.inputFiles(), &previous),
+        .outputs = fileStates(task.outputFiles(), nullptr)
+    };
+
+    std::lock_guard lock(_mutex);
+    _records[key] = std::move(record);
+}
+
+void TaskCache::save() {
+    auto writeStates = [](const std::vector<FileState>& states) {
+        nlohmann::json res = nlohmann::json::array();
+        for (const FileState& state : states) {
+            nlohmann::json s = {
+                { "path", state.path.string() },
+                { "size", state.size },
+                { "time", state.modificationTime }
+            };
+            if (!state.hash.empty()) {
+                s["hash"] = state.hash;
+            }
+            res.push_back(std::move(s));
+        }
+        return res;
+    };
+
+    nlohmann::json json = nlohmann::json::object();
+    {
+        std::lock_guard lock(_mutex);
+        for (const auto& [key, record] : _records) {
+            json[key] = {
+                { "inputs", writeStates(record.inputs) },
+                { "outputs", writeStates(record.outputs) }
+            };
+        }
+    }
+
+    std::filesystem::create_directories(_path.parent_path());
+    std::ofstream file(_path);
+    if (!file.good()) {
+        LERROR(fmt::format("Could not write task cache {}", _path));
+        return;
+    }
+    file << json.dump(2);
+}
+
+std::vector<TaskCache::FileState> TaskCache::fileStates(
+                                          const std::vector<std::filesystem::path>& paths,
+                                                 const std::vector<FileState>* previous)
+{
+    std::unordered_map<std::string, const FileState*> previousStates;
+    if (previous) {
+        for (const FileState& state : *previous) {
+            previousStates[state.path.string()] = &state;
+        }
+    }
+
+    std::vector<FileState> res;
+    for (const std::filesystem::path& path : expandFolders(paths)) {
+        FileState state;
+        state.path = path;
+        state.size = std::filesystem::file_size(path);
+        state.modificationTime = modificationTime(path);
+
+        if (previous) {
+            auto it = previousStates.find(path.string());
+            const bool isUnchanged = it != previousStates.end() &&
+                it->second->size == state.size &&
+                it->second->modificationTime == state.modificationTime &&
+                !it->second->hash.empty();
+            state.hash = isUnchanged ? it->second->hash : hashFile(path);
+        }
+        res.push_back(std::move(state));
+    }
+    return res;
+}
+
+} // namespace openspace
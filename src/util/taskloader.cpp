@@ -61,6 +61,7 @@ std::vector<std::unique_ptr<Task>> TaskLoader::tasksFromDictionary(
                 LERROR(fmt::format(
                     "Failed to create a Task object of type '{}'", taskType
                 ));
+                continue;
             }
             tasks.push_back(std::move(task));
         }
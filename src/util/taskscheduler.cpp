@@ -0,0 +1,268 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/taskscheduler.h>
+
+#include <openspace/util/task.h>
+#include <openspace/util/taskcache.h>
+#include <openspace/util/threadpool.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+    constexpr std::string_view _loggerCat = "TaskScheduler";
+
+    enum class State {
+        Pending = 0,
+        Running,
+        Succeeded,
+        UpToDate,
+        Failed,
+        Skipped
+    };
+} // namespace
+
+namespace openspace {
+
+TaskScheduler::TaskScheduler(std::vector<std::unique_ptr<Task>> tasks)
+    : _tasks(std::move(tasks))
+    , _dependencies(_tasks.size())
+{
+    std::unordered_map<std::string, size_t> indices;
+    for (size_t i = 0; i < _tasks.size(); i++) {
+        const std::string& identifier = _tasks[i]->scheduling().identifier;
+        if (identifier.empty()) {
+            continue;
+        }
+        const bool inserted = indices.emplace(identifier, i).second;
+        if (!inserted) {
+            throw ghoul::RuntimeError(fmt::format(
+                "Multiple tasks have the identifier '{}'", identifier
+            ));
+        }
+    }
+
+    std::vector<std::vector<size_t>> dependents(_tasks.size());
+    std::vector<size_t> nUnresolved(_tasks.size(), 0);
+    for (size_t i = 0; i < _tasks.size(); i++) {
+        for (const std::string& dependency : _tasks[i]->scheduling().dependencies) {
+            auto it = indices.find(dependency);
+            if (it == indices.end()) {
+                throw ghoul::RuntimeError(fmt::format(
+                    "Task '{}' depends on unknown task '{}'",
+                    _tasks[i]->description(), dependency
+                ));
+            }
+            _dependencies[i].push_back(it->second);
+            dependents[it->second].push_back(i);
+            nUnresolved[i]++;
+        }
+    }
+
+    // Sort the tasks topologically, preferring the order in which they were provided
+    std::priority_queue<size_t, std::vector<size_t>, std::greater<>> ready;
+    for (size_t i = 0; i < _tasks.size(); i++) {
+        if (nUnresolved[i] == 0) {
+            ready.push(i);
+        }
+    }
+    while (!ready.empty()) {
+        const size_t i = ready.top();
+        ready.pop();
+        _order.push_back(i);
+        for (size_t dependent : dependents[i]) {
+            nUnresolved[dependent]--;
+            if (nUnresolved[dependent] == 0) {
+                ready.push(dependent);
+            }
+        }
+    }
+
+    if (_order.size() != _tasks.size()) {
+        throw ghoul::RuntimeError("The dependencies between the tasks contain a cycle");
+    }
+}
+
+TaskScheduler::~TaskScheduler() = default;
+
+std::vector<TaskScheduler::Result> TaskScheduler::perform(int nThreads, int memoryLimit,
+                                                      const ProgressCallback& onProgress,
+                                                                    TaskCache* cache)
+{
+    ghoul_precondition(nThreads > 0, "nThreads must be positive");
+    ghoul_precondition(memoryLimit >= 0, "memoryLimit must not be negative");
+
+    std::vector<Result> results(_tasks.size());
+    std::vector<State> states(_tasks.size(), State::Pending);
+    for (size_t i = 0; i < _tasks.size(); i++) {
+        results[i].description = _tasks[i]->description();
+    }
+
+    std::mutex mutex;
+    std::condition_variable hasFinishedTask;
+    int freeThreads = nThreads;
+    int freeMemory = memoryLimit;
+    size_t nFinished = 0;
+
+    // Declared last so that all of the tasks have returned before the other variables
+    // are destroyed
+    ThreadPool pool(nThreads);
+
+    std::unique_lock lock(mutex);
+    while (nFinished < _tasks.size()) {
+        // Skip all tasks that depend on a task that did not succeed. Since the tasks are
+        // processed in topological order, this also covers indirect dependencies
+        for (size_t i : _order) {
+            if (states[i] != State::Pending) {
+                continue;
+            }
+            const bool hasFailedDependency = std::any_of(
+                _dependencies[i].begin(), _dependencies[i].end(),
+                [&states](size_t d) {
+                    return states[d] == State::Failed || states[d] == State::Skipped;
+                }
+            );
+            if (hasFailedDependency) {
+                LWARNING(fmt::format(
+                    "Skipping task {} out of {}: {}",
+                    i + 1, _tasks.size(), results[i].description
+                ));
+                states[i] = State::Skipped;
+                nFinished++;
+            }
+        }
+
+        for (size_t i = 0; i < _tasks.size(); i++) {
+            if (states[i] != State::Pending) {
+                continue;
+            }
+            const bool isReady = std::all_of(
+                _dependencies[i].begin(), _dependencies[i].end(),
+                [&states](size_t d) {
+                    return states[d] == State::Succeeded || states[d] == State::UpToDate;
+                }
+            );
+            if (!isReady) {
+                continue;
+            }
+
+            const Task::Scheduling& scheduling = _tasks[i]->scheduling();
+            const int threads = std::clamp(scheduling.nThreads, 1, nThreads);
+            const int memory = std::min(scheduling.memory, memoryLimit);
+            if (threads > freeThreads || (memoryLimit > 0 && memory > freeMemory)) {
+                continue;
+            }
+
+            freeThreads -= threads;
+            freeMemory -= memory;
+            states[i] = State::Running;
+
+            pool.enqueue([&, i, threads, memory]() {
+                using namespace std::chrono;
+                const steady_clock::time_point start = steady_clock::now();
+                Task& task = *_tasks[i];
+
+                State state = State::Succeeded;
+                if (cache && cache->isUpToDate(task)) {
+                    LINFO(fmt::format(
+                        "Task {} out of {} is up to date: {}",
+                        i + 1, _tasks.size(), results[i].description
+                    ));
+                    state = State::UpToDate;
+                }
+                else {
+                    LINFO(fmt::format(
+                        "Performing task {} out of {}: {}",
+                        i + 1, _tasks.size(), results[i].description
+                    ));
+                    try {
+                        task.perform([&onProgress, i](float progress) {
+                            if (onProgress) {
+                                onProgress(i, progress);
+                            }
+                        });
+                        if (cache) {
+                            cache->update(task);
+                        }
+                    }
+                    catch (const std::exception& e) {
+                        LERROR(fmt::format(
+                            "Task {} ({}) failed: {}",
+                            i + 1, results[i].description, e.what()
+                        ));
+                        state = State::Failed;
+                    }
+                }
+                const duration<double> d = steady_clock::now() - start;
+
+                {
+                    std::lock_guard g(mutex);
+                    results[i].duration = d;
+                    states[i] = state;
+                    freeThreads += threads;
+                    freeMemory += memory;
+                    nFinished++;
+                }
+                hasFinishedTask.notify_one();
+            });
+        }
+
+        if (nFinished < _tasks.size()) {
+            const size_t nFinishedBefore = nFinished;
+            hasFinishedTask.wait(lock, [&]() { return nFinished != nFinishedBefore; });
+        }
+    }
+
+    for (size_t i = 0; i < _tasks.size(); i++) {
+        switch (states[i]) {
+            case State::Succeeded:
+                results[i].status = Result::Status::Succeeded;
+                break;
+            case State::UpToDate:
+                results[i].status = Result::Status::UpToDate;
+                break;
+            case State::Failed:
+                results[i].status = Result::Status::Failed;
+                break;
+            default:
+                results[i].status = Result::Status::Skipped;
+                break;
+        }
+    }
+    return results;
+}
+
+size_t TaskScheduler::numberOfTasks() const {
+    return _tasks.size();
+}
+
+} // namespace openspace
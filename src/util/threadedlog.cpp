@@ -0,0 +1,112 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/threadedlog.h>
+
+#include <ghoul/misc/assert.h>
+
+namespace {
+    // The number of messages that can be waiting to be written before logging blocks
+    constexpr size_t QueueCapacity = 8192;
+} // namespace
+
+namespace openspace {
+
+ThreadedLog::ThreadedLog(std::unique_ptr<ghoul::logging::Log> log,
+                         ghoul::logging::LogLevel logLevel)
+    : _log(std::move(log))
+    , _logLevel(logLevel)
+    , _queue(QueueCapacity)
+{
+    ghoul_assert(_log, "Log must not be nullptr");
+
+    _thread = std::thread([this]() { run(); });
+}
+
+ThreadedLog::~ThreadedLog() {
+    _shouldStop = true;
+    _hasMessages = true;
+    _hasMessages.notify_one();
+    _thread.join();
+
+    // Messages that arrived after the writer thread has finished
+    writeMessages();
+    _log->flush();
+}
+
+void ThreadedLog::log(ghoul::logging::LogLevel level, std::string_view category,
+                      std::string_view message)
+{
+    if (level < _logLevel) {
+        return;
+    }
+
+    Message msg = { level, std::string(category), std::string(message) };
+    _nPending++;
+    while (!_queue.tryPush(std::move(msg))) {
+        // The queue is full, so we wake up the writer thread and wait for it to make
+        // room instead of losing the message
+        _hasMessages = true;
+        _hasMessages.notify_one();
+        std::this_thread::yield();
+    }
+
+    if (!_hasMessages.exchange(true)) {
+        _hasMessages.notify_one();
+    }
+}
+
+void ThreadedLog::flush() {
+    while (_nPending > 0) {
+        _hasMessages = true;
+        _hasMessages.notify_one();
+        std::this_thread::yield();
+    }
+    _log->flush();
+}
+
+void ThreadedLog::run() {
+    while (!_shouldStop) {
+        _hasMessages.wait(false);
+        // Reset the flag before draining the queue so that a message that is pushed
+        // while we are writing wakes us up again
+        _hasMessages = false;
+        writeMessages();
+    }
+}
+
+void ThreadedLog::writeMessages() {
+    Message msg;
+    size_t nWritten = 0;
+    while (_queue.tryPop(msg)) {
+        _log->log(msg.level, msg.category, msg.message);
+        nWritten++;
+    }
+    if (nWritten > 0) {
+        _log->flush();
+        _nPending -= nWritten;
+    }
+}
+
+} // namespace openspace
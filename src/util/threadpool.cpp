@@ -24,83 +24,252 @@
 
 #include <openspace/util/threadpool.h>
 
+namespace {
+    struct CurrentWorker {
+        const openspace::ThreadPool* pool = nullptr;
+        size_t index = 0;
+    };
+    // Identifies the pool and worker that the current thread belongs to, if any
+    thread_local CurrentWorker currentWorker;
+
+    // The initial number of tasks that fit into a worker's deque before it has to grow
+    constexpr int64_t InitialDequeCapacity = 256;
+} // namespace
+
 namespace openspace {
 
-Worker::Worker(ThreadPool& p) : pool(p) {}
+/**
+ * A lock-free work-stealing deque following Chase and Lev, "Dynamic Circular Work-Stealing
+ * Deque" (2005), with the memory orderings from Lê et al., "Correct and Efficient
+ * Work-Stealing for Weak Memory Models" (2013). Only the owning worker calls #push and
+ * #pop, while all other threads may call #steal.
+ */
+struct ThreadPool::WorkerQueue {
+    struct Buffer {
+        Buffer(int64_t cap)
+            : capacity(cap)
+            , tasks(std::make_unique<std::atomic<Task*>[]>(cap))
+        {}
 
-void Worker::operator()() {
-    std::function<void()> task;
-    while (true) {
-        // acquire lock
-        {
-            std::unique_lock<std::mutex> lock(pool.queue_mutex);
-
-            // look for a work item
-            while (!pool.stop && pool.tasks.empty()) {
-                // if there are none wait for notification
-                pool.condition.wait(lock);
-            }
+        Task* get(int64_t i) const {
+            return tasks[i & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t i, Task* task) {
+            tasks[i & (capacity - 1)].store(task, std::memory_order_relaxed);
+        }
+
+        const int64_t capacity;
+        std::unique_ptr<std::atomic<Task*>[]> tasks;
+    };
 
-            if (pool.stop) { // exit if the pool is stopped
-                return;
+    WorkerQueue() {
+        _buffers.push_back(std::make_unique<Buffer>(InitialDequeCapacity));
+        _buffer = _buffers.back().get();
+    }
+
+    void push(Task* task) {
+        const int64_t b = _bottom.load(std::memory_order_relaxed);
+        const int64_t t = _top.load(std::memory_order_acquire);
+        Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+        if (b - t > buffer->capacity - 1) {
+            // Thieves might still read from the old buffer, so it is kept alive until
+            // the queue is destroyed
+            auto grown = std::make_unique<Buffer>(buffer->capacity * 2);
+            for (int64_t i = t; i < b; i++) {
+                grown->put(i, buffer->get(i));
             }
+            buffer = grown.get();
+            _buffers.push_back(std::move(grown));
+            _buffer.store(buffer, std::memory_order_release);
+        }
+        buffer->put(b, task);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+    }
 
-            // get the task from the queue
-            task = pool.tasks.front();
-            pool.tasks.pop_front();
+    Task* pop() {
+        const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = _top.load(std::memory_order_relaxed);
+        if (t > b) {
+            // The deque was empty
+            _bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
 
-        } // release lock
+        Task* task = buffer->get(b);
+        if (t == b) {
+            // This is the last task, so we are racing against the thieves for it
+            const bool success = _top.compare_exchange_strong(
+                t,
+                t + 1,
+                std::memory_order_seq_cst,
+                std::memory_order_relaxed
+            );
+            if (!success) {
+                task = nullptr;
+            }
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
 
-        // execute the task
-        task();
+    Task* steal() {
+        int64_t t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = _bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return nullptr;
+        }
+
+        Buffer* buffer = _buffer.load(std::memory_order_acquire);
+        Task* task = buffer->get(t);
+        const bool success = _top.compare_exchange_strong(
+            t,
+            t + 1,
+            std::memory_order_seq_cst,
+            std::memory_order_relaxed
+        );
+        return success ? task : nullptr;
     }
-}
 
-ThreadPool::ThreadPool(size_t numThreads) : stop(false) {
+private:
+    std::atomic<int64_t> _top = 0;
+    std::atomic<int64_t> _bottom = 0;
+    std::atomic<Buffer*> _buffer;
+    std::vector<std::unique_ptr<Buffer>> _buffers;
+};
+
+ThreadPool::ThreadPool(size_t numThreads) {
+    _workerQueues.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        _workerQueues.push_back(std::make_unique<WorkerQueue>());
+    }
+    _workers.reserve(numThreads);
     for (size_t i = 0; i < numThreads; ++i) {
-        workers.emplace_back(std::thread(Worker(*this)));
+        _workers.emplace_back([this, i]() { work(i); });
     }
 }
 
-ThreadPool::ThreadPool(const ThreadPool& toCopy) : ThreadPool(toCopy.workers.size()) {}
+ThreadPool::ThreadPool(const ThreadPool& toCopy) : ThreadPool(toCopy._workers.size()) {}
 
 // the destructor joins all threads
 ThreadPool::~ThreadPool() {
     // stop all threads
     {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        stop = true;
+        std::unique_lock lock(_mutex);
+        _stop = true;
     }
-    condition.notify_all();
+    _condition.notify_all();
 
     // join them
-    for (std::thread& w : workers) {
+    for (std::thread& w : _workers) {
         w.join();
     }
-}
 
-// add new work item to the pool
-void ThreadPool::enqueue(std::function<void()> f) {
-    { // acquire lock
-        std::unique_lock<std::mutex> lock(queue_mutex);
+    clearTasks();
+}
 
-        // add the task
-        tasks.push_back(std::move(f));
-    } // release lock
+void ThreadPool::enqueue(std::function<void()> f, Priority priority) {
+    Task* task = new Task(std::move(f));
 
-    // wake up one thread
-    condition.notify_one();
+    // The counter is increased first so that it never underflows if a worker picks up
+    // the task before this function returns
+    _nQueuedTasks++;
+    if (currentWorker.pool == this && priority == Priority::Normal) {
+        _workerQueues[currentWorker.index]->push(task);
+        // Taking the lock ensures that no worker is between checking for queued tasks
+        // and going to sleep, which would otherwise miss this notification
+        { std::unique_lock lock(_mutex); }
+    }
+    else {
+        std::unique_lock lock(_mutex);
+        _sharedQueues[static_cast<int>(priority)].push_back(task);
+    }
+    _condition.notify_one();
 }
 
 void ThreadPool::clearTasks() {
-    { // acquire lock
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.clear();
-    } // release lock
+    size_t nRemoved = 0;
+    {
+        std::unique_lock lock(_mutex);
+        for (std::deque<Task*>& queue : _sharedQueues) {
+            for (Task* task : queue) {
+                delete task;
+            }
+            nRemoved += queue.size();
+            queue.clear();
+        }
+    }
+    for (const std::unique_ptr<WorkerQueue>& queue : _workerQueues) {
+        while (Task* task = queue->steal()) {
+            delete task;
+            nRemoved++;
+        }
+    }
+    _nQueuedTasks -= nRemoved;
 }
 
 bool ThreadPool::hasOutstandingTasks() const {
-    return !tasks.empty();
+    return _nQueuedTasks > 0;
+}
+
+size_t ThreadPool::numberOfThreads() const {
+    return _workers.size();
+}
+
+ThreadPool::Task* ThreadPool::findTask(size_t workerIndex) {
+    // 1. The most recently added task of our own deque
+    if (Task* task = _workerQueues[workerIndex]->pop()) {
+        return task;
+    }
+
+    // 2. The task with the highest priority from the shared queues
+    {
+        std::unique_lock lock(_mutex);
+        for (std::deque<Task*>& queue : _sharedQueues) {
+            if (!queue.empty()) {
+                Task* task = queue.front();
+                queue.pop_front();
+                return task;
+            }
+        }
+    }
+
+    // 3. The oldest task from one of the other workers, starting with our neighbor so
+    //    that not all workers try to steal from the same victim
+    for (size_t i = 1; i < _workerQueues.size(); i++) {
+        const size_t victim = (workerIndex + i) % _workerQueues.size();
+        if (Task* task = _workerQueues[victim]->steal()) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::work(size_t workerIndex) {
+    currentWorker = { this, workerIndex };
+
+    while (true) {
+        if (Task* task = findTask(workerIndex)) {
+            _nQueuedTasks--;
+            std::unique_ptr<Task> t = std::unique_ptr<Task>(task);
+            (*t)();
+            continue;
+        }
+
+        std::unique_lock lock(_mutex);
+        // The counter might be non-zero while the task is being pushed or is lost in a
+        // race with another thief, in which case we just try again
+        _condition.wait(lock, [this]() { return _stop || _nQueuedTasks > 0; });
+        if (_stop) {
+            // exit if the pool is stopped
+            return;
+        }
+    }
 }
 
 } // namespace openspace
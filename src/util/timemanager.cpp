@@ -216,12 +216,8 @@ void TimeManager::preSynchronization(double dt) {
 TimeKeyframeData TimeManager::interpolate(double applicationTime) {
     const std::deque<Keyframe<TimeKeyframeData>>& keyframes = _timeline.keyframes();
 
-    auto firstFutureKeyframe = std::lower_bound(
-        keyframes.begin(),
-        keyframes.end(),
-        applicationTime,
-        &compareKeyframeTimeWithTime
-    );
+    const auto firstFutureKeyframe = keyframes.begin() +
+        _timeline.firstKeyframeIndexAfter(applicationTime, true);
 
     const bool hasFutureKeyframes = firstFutureKeyframe != keyframes.end();
     const bool hasPastKeyframes = firstFutureKeyframe != keyframes.begin();
@@ -298,16 +294,12 @@ void TimeManager::progressTime(double dt) {
     const double now = currentApplicationTimeForInterpolation();
     const std::deque<Keyframe<TimeKeyframeData>>& keyframes = _timeline.keyframes();
 
-    std::function<bool(const KeyframeBase&, double)> comparisonFunc =
-        (isPlayingBackSessionRecording()) ?
-        &compareKeyframeTimeWithTime_playbackWithFrames : &compareKeyframeTimeWithTime;
-
-    auto firstFutureKeyframe = std::lower_bound(
-        keyframes.begin(),
-        keyframes.end(),
-        now,
-        comparisonFunc
-    );
+    // When playing back a session recording with a fixed frame rate, a keyframe that is
+    // exactly at the current time already counts as being in the past. See
+    // compareKeyframeTimeWithTime_playbackWithFrames for details
+    const bool inclusive = !isPlayingBackSessionRecording();
+    const auto firstFutureKeyframe = keyframes.begin() +
+        _timeline.firstKeyframeIndexAfter(now, inclusive);
 
     const bool hasFutureKeyframes = firstFutureKeyframe != keyframes.end();
     const bool hasPastKeyframes = firstFutureKeyframe != keyframes.begin();
@@ -30,20 +30,20 @@
 namespace openspace {
 
 tstring temporaryString(const std::string& str) {
-    void* ptr = global::memoryManager->TemporaryMemory.do_allocate(str.size(), 8);
+    void* ptr = global::memoryManager->TemporaryMemory.allocate(str.size(), 8);
     std::strcpy(reinterpret_cast<char*>(ptr), str.data());
     return tstring(reinterpret_cast<char*>(ptr), str.size());
 }
 
 tstring temporaryString(std::string_view str) {
-    void* ptr = global::memoryManager->TemporaryMemory.do_allocate(str.size(), 8);
+    void* ptr = global::memoryManager->TemporaryMemory.allocate(str.size(), 8);
     std::strcpy(reinterpret_cast<char*>(ptr), str.data());
     return tstring(reinterpret_cast<char*>(ptr), str.size());
 }
 
 tstring temporaryString(const char str[]) {
     size_t size = strlen(str);
-    void* ptr = global::memoryManager->TemporaryMemory.do_allocate(size, 8);
+    void* ptr = global::memoryManager->TemporaryMemory.allocate(size, 8);
     std::strcpy(reinterpret_cast<char*>(ptr), str);
     return tstring(reinterpret_cast<char*>(ptr), size);
 }
@@ -0,0 +1,108 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_case_info.hpp>
+#include <catch2/benchmark/catch_estimate.hpp>
+#include <catch2/interfaces/catch_interfaces_reporter.hpp>
+#include <catch2/reporters/catch_reporter_registrars.hpp>
+#include <catch2/reporters/catch_reporter_streaming_base.hpp>
+
+#include <openspace/json.h>
+#include <openspace/openspace.h>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace {
+    using Nanoseconds = std::chrono::duration<double, std::nano>;
+
+    template <typename Duration>
+    nlohmann::json toJson(const Catch::Benchmark::Estimate<Duration>& estimate) {
+        return {
+            { "point", Nanoseconds(estimate.point).count() },
+            { "lowerBound", Nanoseconds(estimate.lower_bound).count() },
+            { "upperBound", Nanoseconds(estimate.upper_bound).count() },
+            { "confidenceInterval", estimate.confidence_interval }
+        };
+    }
+
+    std::string currentTime() {
+        const std::time_t now = std::time(nullptr);
+        std::tm tm = {};
+#ifdef WIN32
+        gmtime_s(&tm, &now);
+#else
+        gmtime_r(&now, &tm);
+#endif // WIN32
+        std::stringstream ss;
+        ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+        return ss.str();
+    }
+
+    /**
+     * Reports the results of all benchmarks that were run as a single JSON document, so
+     * that the results of different builds can be compared by tools. All durations are
+     * provided in nanoseconds. The reporter is selected with `--reporter benchmarkjson`
+     * and writes to the file that is passed with `--out`. Only the benchmarks are
+     * reported, the results of the assertions are not included.
+     */
+    class BenchmarkJsonReporter final : public Catch::StreamingReporterBase {
+    public:
+        using StreamingReporterBase::StreamingReporterBase;
+
+        static std::string getDescription() {
+            return "Reports the results of the benchmarks as a JSON document";
+        }
+
+        void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override {
+            _benchmarks.push_back({
+                { "testCase", currentTestCaseInfo->name },
+                { "name", stats.info.name },
+                { "samples", stats.info.samples },
+                { "iterations", stats.info.iterations },
+                { "mean", toJson(stats.mean) },
+                { "standardDeviation", toJson(stats.standardDeviation) },
+                { "outlierVariance", stats.outlierVariance }
+            });
+        }
+
+        void testRunEnded(const Catch::TestRunStats& stats) override {
+            const nlohmann::json result = {
+                { "version", OPENSPACE_VERSION_STRING_FULL },
+                { "commit", OPENSPACE_GIT_COMMIT },
+                { "time", currentTime() },
+                { "benchmarks", _benchmarks }
+            };
+            m_stream << result.dump(2) << '\n';
+            StreamingReporterBase::testRunEnded(stats);
+        }
+
+    private:
+        nlohmann::json _benchmarks = nlohmann::json::array();
+    };
+} // namespace
+
+CATCH_REGISTER_REPORTER("benchmarkjson", BenchmarkJsonReporter)
@@ -0,0 +1,145 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <openspace/properties/propertyowner.h>
+#include <openspace/properties/scalar/boolproperty.h>
+#include <ghoul/fmt.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace openspace::properties;
+
+namespace {
+    // The benchmark tree resembles a scene with many nodes, each of which has a few
+    // components with a handful of properties
+    constexpr int BenchmarkNodes = 500;
+    constexpr int BenchmarkComponents = 4;
+    constexpr int BenchmarkProperties = 8;
+} // namespace
+
+TEST_CASE("PropertyOwner: URI Lookup", "[propertyowner]") {
+    PropertyOwner root({ "" });
+    PropertyOwner a({ "A" });
+    PropertyOwner b({ "B" });
+    BoolProperty p({ "p", "gui", "desc" });
+    BoolProperty q({ "q", "gui", "desc" });
+
+    // Build parts of the tree before attaching them to the root
+    b.addProperty(p);
+    a.addPropertySubOwner(b);
+    CHECK(a.property("B.p") == &p);
+    root.addPropertySubOwner(a);
+    a.addProperty(q);
+
+    CHECK(root.property("A.B.p") == &p);
+    CHECK(root.property("A.q") == &q);
+    CHECK(a.property("B.p") == &p);
+    CHECK(root.property("A.B") == nullptr);
+    CHECK(root.property("A.B.x") == nullptr);
+
+    b.setIdentifier("C");
+    CHECK(root.property("A.B.p") == nullptr);
+    CHECK(root.property("A.C.p") == &p);
+
+    a.removePropertySubOwner(b);
+    CHECK(root.property("A.C.p") == nullptr);
+    CHECK(b.property("p") == &p);
+
+    a.removeProperty(q);
+    CHECK(root.property("A.q") == nullptr);
+}
+
+TEST_CASE("PropertyOwner: Destroyed While Attached", "[propertyowner]") {
+    PropertyOwner root({ "" });
+    BoolProperty p({ "p", "gui", "desc" });
+
+    {
+        PropertyOwner a({ "A" });
+        a.addProperty(p);
+        root.addPropertySubOwner(a);
+        {
+            BoolProperty q({ "q", "gui", "desc" });
+            a.addProperty(q);
+            CHECK(root.property("A.q") == &q);
+        }
+        CHECK(root.property("A.q") == nullptr);
+        CHECK(root.property("A.p") == &p);
+    }
+    CHECK(root.property("A.p") == nullptr);
+    CHECK(root.propertySubOwners().empty());
+    CHECK(p.owner() == nullptr);
+}
+
+TEST_CASE("PropertyOwner: Lookup Benchmark", "[propertyowner][.benchmark]") {
+    PropertyOwner root({ "" });
+    std::vector<std::unique_ptr<PropertyOwner>> owners;
+    std::vector<std::unique_ptr<BoolProperty>> properties;
+    std::vector<std::string> uris;
+    for (int n = 0; n < BenchmarkNodes; n++) {
+        auto node = std::make_unique<PropertyOwner>(
+            PropertyOwner::PropertyOwnerInfo{ fmt::format("Node{}", n) }
+        );
+        for (int c = 0; c < BenchmarkComponents; c++) {
+            auto component = std::make_unique<PropertyOwner>(
+                PropertyOwner::PropertyOwnerInfo{ fmt::format("Component{}", c) }
+            );
+            for (int p = 0; p < BenchmarkProperties; p++) {
+                const std::string identifier = fmt::format("Property{}", p);
+                auto prop = std::make_unique<BoolProperty>(
+                    Property::PropertyInfo{ identifier.c_str(), "gui", "desc" }
+                );
+                component->addProperty(*prop);
+                properties.push_back(std::move(prop));
+                uris.push_back(fmt::format("Node{}.Component{}.{}", n, c, identifier));
+            }
+            node->addPropertySubOwner(*component);
+            owners.push_back(std::move(component));
+        }
+        root.addPropertySubOwner(*node);
+        owners.push_back(std::move(node));
+    }
+    REQUIRE(root.property(uris.back()) == properties.back().get());
+
+    BENCHMARK("Existing Properties") {
+        size_t nFound = 0;
+        // Stepping by a large prime visits the properties in a scattered order
+        for (size_t i = 0; i < uris.size(); i++) {
+            const std::string& uri = uris[(i * 7919) % uris.size()];
+            nFound += root.property(uri) ? 1 : 0;
+        }
+        return nFound;
+    };
+
+    BENCHMARK("Missing Properties") {
+        size_t nFound = 0;
+        for (int n = 0; n < BenchmarkNodes; n++) {
+            nFound += root.property(fmt::format("Node{}.Component0.Missing", n)) ? 1 : 0;
+        }
+        return nFound;
+    };
+}
@@ -0,0 +1,91 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <modules/globebrowsing/src/blockcompression.h>
+#include <array>
+#include <vector>
+
+using namespace openspace::globebrowsing;
+
+TEST_CASE("BlockCompression: Sizes", "[blockcompression]") {
+    CHECK(numberOfMipLevels(glm::ivec2(1, 1)) == 1);
+    CHECK(numberOfMipLevels(glm::ivec2(512, 512)) == 10);
+    CHECK(numberOfMipLevels(glm::ivec2(512, 128)) == 10);
+
+    CHECK(bc3LevelSize(glm::ivec2(512, 512), 0) == 128 * 128 * 16);
+    CHECK(bc3LevelSize(glm::ivec2(512, 512), 8) == 16);
+    CHECK(bc3LevelSize(glm::ivec2(512, 512), 9) == 16);
+
+    // 4x4, 2x2, and 1x1 all occupy a single block
+    CHECK(bc3CompressedSize(glm::ivec2(4, 4)) == 3 * 16);
+}
+
+TEST_CASE("BlockCompression: Uniform Color", "[blockcompression]") {
+    // Red with half transparency in BGRA order
+    std::vector<std::byte> image;
+    for (int i = 0; i < 4 * 4; i++) {
+        image.push_back(std::byte(0));
+        image.push_back(std::byte(0));
+        image.push_back(std::byte(255));
+        image.push_back(std::byte(128));
+    }
+
+    std::vector<std::byte> blocks(bc3CompressedSize(glm::ivec2(4, 4)));
+    compressBC3(image.data(), glm::ivec2(4, 4), true, blocks.data());
+
+    // Every mip level is the same single block
+    constexpr std::array<int, 16> Expected = {
+        128, 128, 0, 0, 0, 0, 0, 0,
+        0x00, 0xF8, 0x00, 0xF8, 0, 0, 0, 0
+    };
+    for (size_t i = 0; i < blocks.size(); i++) {
+        CHECK(std::to_integer<int>(blocks[i]) == Expected[i % 16]);
+    }
+}
+
+TEST_CASE("BlockCompression: Alpha Endpoints", "[blockcompression]") {
+    // The top half of the block is opaque and the bottom half transparent
+    std::vector<std::byte> image;
+    for (int i = 0; i < 4 * 4; i++) {
+        const std::byte alpha = i < 8 ? std::byte(255) : std::byte(0);
+        image.push_back(std::byte(255));
+        image.push_back(std::byte(255));
+        image.push_back(std::byte(255));
+        image.push_back(alpha);
+    }
+
+    std::vector<std::byte> blocks(bc3CompressedSize(glm::ivec2(4, 4)));
+    compressBC3(image.data(), glm::ivec2(4, 4), false, blocks.data());
+
+    CHECK(std::to_integer<int>(blocks[0]) == 255);
+    CHECK(std::to_integer<int>(blocks[1]) == 0);
+    // The first eight pixels use index 0 (alpha0) and the last eight index 1 (alpha1),
+    // packed as 3 bits per pixel
+    constexpr std::array<int, 6> Indices = { 0x00, 0x00, 0x00, 0x49, 0x92, 0x24 };
+    for (size_t i = 0; i < Indices.size(); i++) {
+        CHECK(std::to_integer<int>(blocks[2 + i]) == Indices[i]);
+    }
+}
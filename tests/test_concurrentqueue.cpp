@@ -23,8 +23,62 @@
  ****************************************************************************************/
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
+#include <openspace/util/boundedconcurrentqueue.h>
 #include <openspace/util/concurrentqueue.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr int NumThreads = 4;
+    constexpr int ItemsPerProducer = 10000;
+
+    // Runs NumThreads producers and NumThreads consumers on the bounded queue and
+    // returns the number of times each item was popped
+    std::vector<int> runContention(size_t capacity) {
+        using namespace openspace;
+
+        BoundedConcurrentQueue<int> q(capacity);
+        std::vector<std::atomic<int>> counts(NumThreads * ItemsPerProducer);
+        std::atomic<int> nPopped = 0;
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NumThreads; t++) {
+            threads.emplace_back([&q, t]() {
+                for (int i = 0; i < ItemsPerProducer; i++) {
+                    while (!q.tryPush(t * ItemsPerProducer + i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+            threads.emplace_back([&q, &counts, &nPopped]() {
+                int item = 0;
+                while (nPopped < NumThreads * ItemsPerProducer) {
+                    if (q.tryPop(item)) {
+                        counts[item]++;
+                        nPopped++;
+                    }
+                    else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread& t : threads) {
+            t.join();
+        }
+
+        std::vector<int> result;
+        result.reserve(counts.size());
+        for (const std::atomic<int>& c : counts) {
+            result.push_back(c);
+        }
+        return result;
+    }
+} // namespace
 
 TEST_CASE("ConcurrentQueue: Basic", "[concurrentqueue]") {
     using namespace openspace;
@@ -34,3 +88,61 @@ TEST_CASE("ConcurrentQueue: Basic", "[concurrentqueue]") {
     int val = q1.pop();
     CHECK(val == 4);
 }
+
+TEST_CASE("BoundedConcurrentQueue: Basic", "[concurrentqueue]") {
+    using namespace openspace;
+
+    BoundedConcurrentQueue<int> q(3);
+    CHECK(q.capacity() == 4);
+    CHECK(q.empty());
+
+    int val = 0;
+    CHECK_FALSE(q.tryPop(val));
+    for (int i = 0; i < 4; i++) {
+        CHECK(q.tryPush(i));
+    }
+    CHECK_FALSE(q.tryPush(4));
+    CHECK(q.size() == 4);
+
+    CHECK(q.tryPop(val));
+    CHECK(val == 0);
+
+    std::vector<int> batch;
+    CHECK(q.tryPopBatch(batch, 10) == 3);
+    CHECK(batch == std::vector<int>{ 1, 2, 3 });
+    CHECK(q.empty());
+}
+
+TEST_CASE("BoundedConcurrentQueue: Contention", "[concurrentqueue]") {
+    // A small capacity forces the producers to wrap around the buffer many times
+    std::vector<int> counts = runContention(16);
+    CHECK(std::all_of(counts.begin(), counts.end(), [](int c) { return c == 1; }));
+}
+
+TEST_CASE("ConcurrentQueue: Contention Benchmark", "[concurrentqueue][.benchmark]") {
+    using namespace openspace;
+
+    BENCHMARK("ConcurrentQueue") {
+        ConcurrentQueue<int> q;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NumThreads; t++) {
+            threads.emplace_back([&q]() {
+                for (int i = 0; i < ItemsPerProducer; i++) {
+                    q.push(i);
+                }
+            });
+            threads.emplace_back([&q]() {
+                for (int i = 0; i < ItemsPerProducer; i++) {
+                    q.pop();
+                }
+            });
+        }
+        for (std::thread& t : threads) {
+            t.join();
+        }
+    };
+
+    BENCHMARK("BoundedConcurrentQueue") {
+        return runContention(1024);
+    };
+}
@@ -218,6 +218,18 @@ TEST_CASE("Configuration: useMultithreadedInit", "[configuration]") {
     CHECK(c.useMultithreadedInitialization == true);
 }
 
+TEST_CASE("Configuration: useDeltaSyncEncoding", "[configuration]") {
+    constexpr std::string_view Extra = R"(UseDeltaSyncEncoding = true)";
+    const Configuration c = loadConfiguration("useDeltaSyncEncoding", Extra);
+    CHECK(c.useDeltaSyncEncoding == true);
+}
+
+TEST_CASE("Configuration: syncKeyframeInterval", "[configuration]") {
+    constexpr std::string_view Extra = R"(SyncKeyframeInterval = 120)";
+    const Configuration c = loadConfiguration("syncKeyframeInterval", Extra);
+    CHECK(c.syncKeyframeInterval == 120);
+}
+
 TEST_CASE("Configuration: loadingscreen", "[configuration]") {
     Configuration defaultConf;
 
@@ -0,0 +1,93 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+#include <modules/space/ephemeristable.h>
+#include <cmath>
+#include <filesystem>
+
+namespace {
+    void circularOrbit(double time, std::span<double> result) {
+        constexpr double Radius = 1.5e8;
+        constexpr double Period = 3.15e7;
+        const double angle = 2.0 * 3.14159265358979323846 * time / Period;
+        result[0] = Radius * std::cos(angle);
+        result[1] = Radius * std::sin(angle);
+        result[2] = 0.0;
+    }
+} // namespace
+
+TEST_CASE("EphemerisTable: Approximates Between Nodes", "[ephemeristable]") {
+    using namespace openspace;
+
+    const EphemerisTable table = EphemerisTable::create(
+        { "A", "B", "C" }, 3, 0.0, 1e7, 86400.0, 12, circularOrbit
+    );
+
+    CHECK(table.contains(0.0));
+    CHECK(table.contains(1e7));
+    CHECK_FALSE(table.contains(-1.0));
+    CHECK_FALSE(table.contains(1e7 + 1.0));
+
+    for (double time = 0.0; time <= 1e7; time += 12345.6) {
+        double expected[3];
+        double result[3];
+        circularOrbit(time, expected);
+        table.evaluate(time, result);
+        CHECK(result[0] == Catch::Approx(expected[0]).margin(1e-3));
+        CHECK(result[1] == Catch::Approx(expected[1]).margin(1e-3));
+        CHECK(result[2] == Catch::Approx(expected[2]).margin(1e-3));
+    }
+}
+
+TEST_CASE("EphemerisTable: Save And Load", "[ephemeristable]") {
+    using namespace openspace;
+
+    const EphemerisTable table = EphemerisTable::create(
+        { "A", "B", "C" }, 3, 100.0, 5e5, 43200.0, 8, circularOrbit
+    );
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "test_ephemeristable.bin";
+    table.save(path);
+
+    const EphemerisTable loaded = EphemerisTable::load(path);
+    CHECK(loaded.identifiers() == table.identifiers());
+    CHECK(loaded.nComponents() == 3);
+    CHECK(loaded.start() == 100.0);
+    CHECK(loaded.end() == 5e5);
+
+    double a[3];
+    double b[3];
+    table.evaluate(250000.0, a);
+    loaded.evaluate(250000.0, b);
+    CHECK(a[0] == b[0]);
+    CHECK(a[1] == b[1]);
+    CHECK(a[2] == b[2]);
+
+    std::filesystem::remove(path);
+}
+#endif // OPENSPACE_MODULE_SPACE_ENABLED
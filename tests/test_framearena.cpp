@@ -0,0 +1,71 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/framearena.h>
+#include <memory_resource>
+#include <vector>
+
+TEST_CASE("FrameArena: Reuses Memory After Reset", "[framearena]") {
+    using namespace openspace;
+
+    FrameArena arena(1024);
+    for (int frame = 0; frame < 3; frame++) {
+        std::pmr::vector<double> v(&arena);
+        for (int i = 0; i < 1000; i++) {
+            v.push_back(static_cast<double>(i));
+        }
+        CHECK(arena.usedBytes() >= 1000 * sizeof(double));
+        arena.reset();
+        CHECK(arena.usedBytes() == 0);
+    }
+
+    // After the first frame, the arena consists of a single block that fits a frame
+    const size_t capacity = arena.capacity();
+    CHECK(capacity >= arena.highWaterMark());
+    {
+        std::pmr::vector<double> v(&arena);
+        v.resize(1000);
+    }
+    CHECK(arena.capacity() == capacity);
+}
+
+TEST_CASE("FrameArena: Scope", "[framearena]") {
+    using namespace openspace;
+
+    FrameArena arena(1024);
+    void* first = arena.allocate(16);
+    const size_t used = arena.usedBytes();
+    {
+        FrameArena::Scope scope(arena);
+        arena.allocate(100);
+        CHECK(arena.usedBytes() > used);
+    }
+    CHECK(arena.usedBytes() == used);
+
+    void* second = arena.allocate(16);
+    CHECK(second != first);
+    CHECK(arena.highWaterMark() >= used + 100);
+}
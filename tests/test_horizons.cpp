@@ -182,6 +182,52 @@ TEST_CASE("HorizonsFile: File size too large", "[horizonsfile]") {
 #endif // OPENSPACE_MODULE_SPACE_ENABLED
 }
 
+TEST_CASE("HorizonsFile: Chunked request", "[horizonsfile]") {
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+    std::filesystem::path filePath =
+        absPath("${TESTDIR}/horizonsTest/horizonstest_c.hrz");
+
+    // 8760 hourly steps that are split into 5 chunks
+    json answer = sendChunkedHorizonsRequest(
+        HorizonsType::Vector,
+        "-74", // MRO
+        "@ssb",
+        "2021-01-01 00:00:00",
+        "2022-01-01 00:00:00",
+        "1",
+        "h",
+        filePath,
+        2000
+    );
+    CHECK(isValidHorizonsAnswer(answer) == HorizonsResultCode::Valid);
+
+    auto result = answer.find("result");
+    REQUIRE(result != answer.end());
+    HorizonsFile horizonsFile(filePath, *result);
+    CHECK(isValidHorizonsFile(horizonsFile.file()) == HorizonsResultCode::Valid);
+
+    std::filesystem::remove(filePath);
+    CHECK(!std::filesystem::is_regular_file(filePath));
+#endif // OPENSPACE_MODULE_SPACE_ENABLED
+}
+
+TEST_CASE("HorizonsFile: Merge results", "[horizonsfile]") {
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+    std::vector<std::string> results = {
+        "Header 1\n$$SOE\nA\nB\n$$EOE\nFooter 1\n",
+        "Header 2\n$$SOE\nC\n$$EOE\nFooter 2\n",
+        "Header 3\n$$SOE\nD\nE\n$$EOE\nFooter 3\n"
+    };
+    CHECK(
+        mergeHorizonsResults(results) ==
+        "Header 1\n$$SOE\nA\nB\nC\nD\nE\n$$EOE\nFooter 3\n"
+    );
+
+    results.push_back("Error without data");
+    CHECK(mergeHorizonsResults(results).empty());
+#endif // OPENSPACE_MODULE_SPACE_ENABLED
+}
+
 TEST_CASE("HorizonsFile: Time steps too large", "[horizonsfile]") {
 #ifdef OPENSPACE_MODULE_SPACE_ENABLED
     HorizonsTestData data;
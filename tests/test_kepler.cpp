@@ -0,0 +1,105 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <modules/space/kepler.h>
+#include <ghoul/fmt.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+namespace {
+    constexpr int BenchmarkObjects = 20000;
+    constexpr int BenchmarkAnomalies = 100000;
+
+    // The element set of the ISS from the description of the TLE format
+    constexpr std::string_view TleLine1 =
+        "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+    constexpr std::string_view TleLine2 =
+        "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+
+    // Writes a TLE file that contains the provided number of copies of the same element
+    // set, which only differ in their name
+    std::filesystem::path createTleFile(std::string_view name, int nObjects) {
+        const std::filesystem::path path =
+            std::filesystem::temp_directory_path() / fmt::format("{}.txt", name);
+        std::ofstream file(path);
+        for (int i = 0; i < nObjects; i++) {
+            file << fmt::format("OBJECT {}\n", i);
+            file << TleLine1 << '\n' << TleLine2 << '\n';
+        }
+        return path;
+    }
+} // namespace
+
+TEST_CASE("Kepler: Read TLE File", "[kepler]") {
+    const std::filesystem::path path = createTleFile("test_kepler", 3);
+    const std::vector<openspace::kepler::Parameters> params =
+        openspace::kepler::readTleFile(path);
+
+    REQUIRE(params.size() == 3);
+    CHECK(params[2].name == "OBJECT 2");
+    CHECK(params[0].inclination == Catch::Approx(51.6416));
+    CHECK(params[0].ascendingNode == Catch::Approx(247.4627));
+    CHECK(params[0].eccentricity == Catch::Approx(0.0006703));
+    CHECK(params[0].period == Catch::Approx(86400.0 / 15.72125391));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Kepler: Benchmark", "[kepler][.benchmark]") {
+    using namespace openspace::kepler;
+
+    const std::filesystem::path path =
+        createTleFile("benchmark_kepler", BenchmarkObjects);
+
+    BENCHMARK("Parse TLE") {
+        return readTleFile(path).size();
+    };
+
+    // The first call creates the cache file which is used by all subsequent calls
+    readFile(path, Format::TLE);
+    BENCHMARK("Read Cached File") {
+        return readFile(path, Format::TLE).size();
+    };
+
+    std::vector<double> meanAnomalies(BenchmarkAnomalies);
+    for (int i = 0; i < BenchmarkAnomalies; i++) {
+        meanAnomalies[i] = std::fmod(i * 0.001, 2.0 * 3.14159265358979323846);
+    }
+    std::vector<double> result(BenchmarkAnomalies);
+    for (double eccentricity : { 0.01, 0.5, 0.95 }) {
+        BENCHMARK(fmt::format("Eccentric Anomalies e={}", eccentricity)) {
+            eccentricAnomalies(eccentricity, meanAnomalies, result);
+            return result.back();
+        };
+    }
+
+    std::filesystem::remove(path);
+}
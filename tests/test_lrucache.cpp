@@ -23,11 +23,17 @@
  ****************************************************************************************/
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
-#include <modules/globebrowsing/src/lrucache.h>
-#include <glm/glm.hpp>
+#include <openspace/util/lrucache.h>
+#include <thread>
+#include <vector>
 
 namespace {
+    constexpr int BenchmarkCapacity = 4096;
+    constexpr int BenchmarkOperations = 100000;
+    constexpr int NumThreads = 4;
+
     struct DefaultHasher {
         unsigned long long operator()(int var) const {
             return static_cast<unsigned long long>(var);
@@ -52,17 +58,24 @@ namespace {
             return s.x ^ (s.y << 1);
         }
     };
+
+    // Places all keys into the same bucket to test the collision handling
+    struct CollidingHasher {
+        unsigned long long operator()(int) const {
+            return 0;
+        }
+    };
 } // namespace
 
 TEST_CASE("LRUCache: Get", "[lrucache]") {
-    openspace::globebrowsing::cache::LRUCache<int, std::string, DefaultHasher> lru(4);
+    openspace::LruCache<int, std::string, DefaultHasher> lru(4);
     lru.put(1, "hej");
     lru.put(12, "san");
     CHECK(lru.get(1) == "hej");
 }
 
 TEST_CASE("LRUCache: CleaningCache", "[lrucache]") {
-    openspace::globebrowsing::cache::LRUCache<int, double, DefaultHasher> lru(4);
+    openspace::LruCache<int, double, DefaultHasher> lru(4);
     lru.put(1, 1.2);
     lru.put(12, 2.3);
     lru.put(123, 33.4);
@@ -72,8 +85,25 @@ TEST_CASE("LRUCache: CleaningCache", "[lrucache]") {
     CHECK(lru.exist(12));
 }
 
+TEST_CASE("LRUCache: PutBack", "[lrucache]") {
+    openspace::LruCache<int, double, DefaultHasher> lru(2);
+    lru.put(1, 1.2);
+    lru.put(12, 2.3);
+
+    // Items that are put at the back are removed first, even when they are the newest
+    std::vector<std::pair<int, double>> popped = lru.putBackAndFetchPopped(123, 3.4);
+    REQUIRE(popped.size() == 1);
+    CHECK(popped[0].first == 123);
+    CHECK(lru.exist(1));
+    CHECK(lru.exist(12));
+
+    // Existing items keep their position
+    CHECK(lru.putBackAndFetchPopped(12, 5.6).empty());
+    CHECK(lru.popMRU().first == 12);
+}
+
 TEST_CASE("LRUCache: StructKey", "[lrucache]") {
-    openspace::globebrowsing::cache::LRUCache<
+    openspace::LruCache<
         MyKey, std::string, DefaultHasherMyKey
     > lru(4);
 
@@ -96,3 +126,208 @@ TEST_CASE("LRUCache: StructKey", "[lrucache]") {
     CHECK(lru.get(key1) == val2);
     CHECK(lru.get(key2) == val2);
 }
+
+TEST_CASE("LRUCache: Order", "[lrucache]") {
+    openspace::LruCache<int, int, DefaultHasher> lru(3);
+    lru.put(1, 1);
+    lru.put(2, 2);
+    lru.put(3, 3);
+
+    // Peeking does not change the order, but getting and touching do
+    CHECK(lru.peek(1) == 1);
+    CHECK(lru.get(2) == 2);
+    CHECK(lru.touch(1));
+    CHECK_FALSE(lru.touch(4));
+
+    std::vector<std::pair<int, int>> popped = lru.putAndFetchPopped(4, 4);
+    REQUIRE(popped.size() == 1);
+    CHECK(popped[0].first == 3);
+    CHECK(lru.popLRU().first == 2);
+    CHECK(lru.popLRU().first == 1);
+    CHECK(lru.popMRU().first == 4);
+    CHECK(lru.isEmpty());
+}
+
+TEST_CASE("LRUCache: Weight", "[lrucache]") {
+    openspace::LruCache<int, int, DefaultHasher> lru(10, 100);
+    lru.put(1, 1, 40);
+    lru.put(2, 2, 40);
+    CHECK(lru.weight() == 80);
+
+    // Exceeding the maximum weight evicts the least recently used items
+    lru.put(3, 3, 30);
+    CHECK_FALSE(lru.exist(1));
+    CHECK(lru.weight() == 70);
+
+    // Replacing an item replaces its weight
+    lru.put(2, 2, 10);
+    CHECK(lru.weight() == 40);
+
+    // An item that is heavier than the maximum weight is not kept
+    std::vector<std::pair<int, int>> popped = lru.putAndFetchPopped(4, 4, 200);
+    CHECK(popped.size() == 3);
+    CHECK(lru.isEmpty());
+    CHECK(lru.weight() == 0);
+}
+
+TEST_CASE("LRUCache: Collisions", "[lrucache]") {
+    openspace::LruCache<int, int, CollidingHasher> lru(16);
+    for (int i = 0; i < 16; i++) {
+        lru.put(i, i * 10);
+    }
+
+    // Erasing from the middle of a probe sequence must keep the later keys reachable
+    CHECK(lru.erase(3));
+    CHECK(lru.erase(8));
+    CHECK_FALSE(lru.erase(8));
+    for (int i = 0; i < 16; i++) {
+        if (i == 3 || i == 8) {
+            CHECK_FALSE(lru.exist(i));
+        }
+        else {
+            REQUIRE(lru.exist(i));
+            CHECK(lru.peek(i) == i * 10);
+        }
+    }
+
+    lru.put(16, 160);
+    lru.put(17, 170);
+    lru.put(18, 180);
+    CHECK(lru.size() == 16);
+    CHECK_FALSE(lru.exist(0));
+    CHECK(lru.peek(18) == 180);
+}
+
+TEST_CASE("LRUCache: Resize", "[lrucache]") {
+    openspace::LruCache<int, int, DefaultHasher> lru(8);
+    for (int i = 0; i < 8; i++) {
+        lru.put(i, i);
+    }
+
+    // Shrinking keeps the most recently used items
+    lru.setMaximumCacheSize(3);
+    CHECK(lru.size() == 3);
+    CHECK(lru.maximumCacheSize() == 3);
+    CHECK_FALSE(lru.exist(4));
+    CHECK(lru.exist(5));
+    CHECK(lru.exist(7));
+    CHECK(lru.popLRU().first == 5);
+
+    lru.setMaximumCacheSize(10);
+    for (int i = 10; i < 20; i++) {
+        lru.put(i, i);
+    }
+    CHECK(lru.size() == 10);
+    CHECK(lru.exist(10));
+}
+
+TEST_CASE("LRUCache: Concurrent", "[lrucache]") {
+    constexpr int NumKeys = 1000;
+    openspace::ConcurrentLruCache<int, int, DefaultHasher> lru(NumKeys, 8);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NumThreads; t++) {
+        threads.emplace_back([&lru, t]() {
+            for (int i = t; i < NumKeys; i += NumThreads) {
+                lru.put(i, i * 2);
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    // The capacity is split evenly into the shards, so not all keys have to fit
+    CHECK(lru.size() <= static_cast<size_t>(NumKeys + 8));
+    int nFound = 0;
+    for (int i = 0; i < NumKeys; i++) {
+        std::optional<int> value = lru.get(i);
+        if (value.has_value()) {
+            CHECK(*value == i * 2);
+            nFound++;
+        }
+    }
+    CHECK(nFound == static_cast<int>(lru.size()));
+
+    CHECK_FALSE(lru.get(NumKeys).has_value());
+    lru.clear();
+    CHECK(lru.size() == 0);
+}
+
+TEST_CASE("LRUCache: Benchmark", "[lrucache][.benchmark]") {
+    using Cache = openspace::LruCache<int, int, DefaultHasher>;
+
+    BENCHMARK("Put With Eviction") {
+        Cache lru(BenchmarkCapacity);
+        for (int i = 0; i < BenchmarkOperations; i++) {
+            lru.put(i, i);
+        }
+        return lru.size();
+    };
+
+    Cache lru(BenchmarkCapacity);
+    for (int i = 0; i < BenchmarkCapacity; i++) {
+        lru.put(i, i);
+    }
+    REQUIRE(lru.size() == static_cast<size_t>(BenchmarkCapacity));
+
+    BENCHMARK("Touch and Get") {
+        int sum = 0;
+        // Stepping by a large prime visits the cache in a scattered order
+        for (int i = 0; i < BenchmarkOperations; i++) {
+            const int key = static_cast<int>((static_cast<long long>(i) * 7919) %
+                BenchmarkCapacity);
+            lru.touch(key);
+            sum += lru.get(key);
+        }
+        return sum;
+    };
+
+    BENCHMARK("Miss") {
+        int nHits = 0;
+        for (int i = 0; i < BenchmarkOperations; i++) {
+            nHits += lru.exist(BenchmarkCapacity + i) ? 1 : 0;
+        }
+        return nHits;
+    };
+}
+
+TEST_CASE("LRUCache: Weighted Benchmark", "[lrucache][.benchmark]") {
+    using Cache = openspace::LruCache<int, int, DefaultHasher>;
+
+    BENCHMARK("Put With Weighted Eviction") {
+        // Each item weighs between 1 and 16 so that the weight limit evicts first
+        Cache lru(BenchmarkCapacity, BenchmarkCapacity * 4);
+        for (int i = 0; i < BenchmarkOperations; i++) {
+            lru.put(i, i, 1 + (i % 16));
+        }
+        return lru.weight();
+    };
+}
+
+TEST_CASE("LRUCache: Concurrent Benchmark", "[lrucache][.benchmark]") {
+    using Cache = openspace::ConcurrentLruCache<int, int, DefaultHasher>;
+
+    Cache lru(BenchmarkCapacity);
+    for (int i = 0; i < BenchmarkCapacity; i++) {
+        lru.put(i, i);
+    }
+
+    BENCHMARK("Get and Put") {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NumThreads; t++) {
+            threads.emplace_back([&lru, t]() {
+                for (int i = 0; i < BenchmarkOperations / NumThreads; i++) {
+                    const int key = (i * 7919 + t) % (2 * BenchmarkCapacity);
+                    if (!lru.get(key).has_value()) {
+                        lru.put(key, key);
+                    }
+                }
+            });
+        }
+        for (std::thread& t : threads) {
+            t.join();
+        }
+        return lru.size();
+    };
+}
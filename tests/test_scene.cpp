@@ -0,0 +1,217 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <openspace/properties/scalar/boolproperty.h>
+#include <openspace/properties/vector/dvec3property.h>
+#include <openspace/scene/scene.h>
+#include <openspace/scene/scenegraphnode.h>
+#include <openspace/scene/sceneinitializer.h>
+#include <openspace/util/time.h>
+#include <openspace/util/updatestructures.h>
+#include <ghoul/fmt.h>
+#include <ghoul/misc/dictionary.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr int BenchmarkNodes = 5000;
+    constexpr int TestNodes = 500;
+
+    // Creates a graph of nodes with a static translation each. The first node is a child
+    // of the root and the node `i` is a child of the node `(i - 1) / branchingFactor`
+    void createGraph(openspace::Scene& scene, int nNodes, int branchingFactor) {
+        for (int i = 0; i < nNodes; i++) {
+            ghoul::Dictionary translation;
+            translation.setValue("Type", std::string("StaticTranslation"));
+            translation.setValue("Position", glm::dvec3(i, 1.0, 0.0));
+            ghoul::Dictionary transform;
+            transform.setValue("Translation", translation);
+
+            ghoul::Dictionary dictionary;
+            dictionary.setValue("Identifier", fmt::format("Node{}", i));
+            if (i > 0) {
+                dictionary.setValue(
+                    "Parent",
+                    fmt::format("Node{}", (i - 1) / branchingFactor)
+                );
+            }
+            dictionary.setValue("Transform", transform);
+
+            openspace::SceneGraphNode* node = scene.loadNode(dictionary);
+            REQUIRE(node);
+            // The node is initialized directly, as the scene initializer would also pass
+            // it on to be initialized for rendering, which requires an OpenGL context
+            node->initialize();
+        }
+    }
+
+    void destroyGraph(openspace::Scene& scene) {
+        openspace::SceneGraphNode* first = scene.sceneGraphNode("Node0");
+        ghoul::mm_unique_ptr<openspace::SceneGraphNode> graph = scene.detachNode(*first);
+        graph->traversePostOrder([](openspace::SceneGraphNode* node) {
+            node->deinitialize();
+        });
+    }
+
+    void update(openspace::Scene& scene) {
+        const openspace::Time time = openspace::Time(0.0);
+        scene.update({ openspace::TransformData(), time, time });
+    }
+
+    void setParallelUpdate(openspace::Scene& scene, bool isParallel) {
+        auto parallel = dynamic_cast<openspace::properties::BoolProperty*>(
+            scene.property("ParallelUpdate")
+        );
+        REQUIRE(parallel);
+        *parallel = isParallel;
+    }
+
+    std::vector<glm::dvec3> worldPositions(const openspace::Scene& scene, int nNodes) {
+        std::vector<glm::dvec3> result;
+        result.reserve(nNodes);
+        for (int i = 0; i < nNodes; i++) {
+            openspace::SceneGraphNode* node =
+                scene.sceneGraphNode(fmt::format("Node{}", i));
+            REQUIRE(node);
+            result.push_back(node->worldPosition());
+        }
+        return result;
+    }
+} // namespace
+
+TEST_CASE("Scene: Update World Positions", "[scene]") {
+    openspace::Scene scene(std::make_unique<openspace::SingleThreadedSceneInitializer>());
+    // A chain of nodes in which every node is the child of the previous one
+    createGraph(scene, 4, 1);
+
+    update(scene);
+    CHECK(scene.sceneGraphNode("Node0")->worldPosition() == glm::dvec3(0.0, 1.0, 0.0));
+    CHECK(scene.sceneGraphNode("Node3")->worldPosition() == glm::dvec3(6.0, 4.0, 0.0));
+
+    destroyGraph(scene);
+}
+
+TEST_CASE("Scene: Parallel Update Matches Serial Update", "[scene]") {
+    // A flat graph has a single wide level, a binary tree has many levels of which only
+    // the deeper ones are split into several jobs
+    for (int branchingFactor : { TestNodes, 2 }) {
+        std::vector<glm::dvec3> serialPositions;
+        {
+            openspace::Scene scene(
+                std::make_unique<openspace::SingleThreadedSceneInitializer>()
+            );
+            createGraph(scene, TestNodes, branchingFactor);
+            update(scene);
+            serialPositions = worldPositions(scene, TestNodes);
+            destroyGraph(scene);
+        }
+
+        openspace::Scene scene(
+            std::make_unique<openspace::SingleThreadedSceneInitializer>()
+        );
+        createGraph(scene, TestNodes, branchingFactor);
+        setParallelUpdate(scene, true);
+        update(scene);
+        const std::vector<glm::dvec3> parallelPositions =
+            worldPositions(scene, TestNodes);
+        destroyGraph(scene);
+
+        for (int i = 0; i < TestNodes; i++) {
+            INFO(fmt::format("Branching factor {}, Node{}", branchingFactor, i));
+            CHECK(parallelPositions[i] == serialPositions[i]);
+        }
+    }
+}
+
+TEST_CASE("Scene: Moving Parent Moves Static Children", "[scene]") {
+    // The children of the moved node have static translations that do not change, so
+    // they are only updated if the change of their parent is propagated to them
+    for (bool isParallel : { false, true }) {
+        for (int branchingFactor : { TestNodes, 2 }) {
+            INFO(fmt::format(
+                "Parallel: {}, Branching factor {}", isParallel, branchingFactor
+            ));
+
+            openspace::Scene scene(
+                std::make_unique<openspace::SingleThreadedSceneInitializer>()
+            );
+            createGraph(scene, TestNodes, branchingFactor);
+            setParallelUpdate(scene, isParallel);
+            update(scene);
+            const std::vector<glm::dvec3> before = worldPositions(scene, TestNodes);
+
+            // Updating again without any change must not move anything
+            update(scene);
+            CHECK(worldPositions(scene, TestNodes) == before);
+
+            openspace::properties::PropertyOwner* translation =
+                scene.sceneGraphNode("Node0")->propertySubOwner("Translation");
+            REQUIRE(translation);
+            auto position = dynamic_cast<openspace::properties::DVec3Property*>(
+                translation->property("Position")
+            );
+            REQUIRE(position);
+            const glm::dvec3 offset = glm::dvec3(10.0, -5.0, 2.0);
+            position->setValue(position->value() + offset);
+            update(scene);
+
+            const std::vector<glm::dvec3> after = worldPositions(scene, TestNodes);
+            for (int i = 0; i < TestNodes; i++) {
+                INFO(fmt::format("Node{}", i));
+                CHECK(after[i] == before[i] + offset);
+            }
+
+            destroyGraph(scene);
+        }
+    }
+}
+
+TEST_CASE("Scene: Update Benchmark", "[scene][.benchmark]") {
+    // The graphs resemble a flat scene with many objects around the same parent and a
+    // deep hierarchy of nested reference frames
+    for (int branchingFactor : { BenchmarkNodes, 4 }) {
+        openspace::Scene scene(
+            std::make_unique<openspace::SingleThreadedSceneInitializer>()
+        );
+        createGraph(scene, BenchmarkNodes, branchingFactor);
+        // The first update sorts the nodes, which should not be part of the measurement
+        update(scene);
+
+        const std::string shape = branchingFactor == BenchmarkNodes ? "Flat" : "Deep";
+        BENCHMARK(fmt::format("{} Serial", shape)) {
+            update(scene);
+        };
+
+        setParallelUpdate(scene, true);
+        BENCHMARK(fmt::format("{} Parallel", shape)) {
+            update(scene);
+        };
+
+        destroyGraph(scene);
+    }
+}
@@ -880,3 +880,51 @@ TEST_CASE("ScriptScheduler: All Scripts Mixed Load", "[scriptscheduler]") {
 
     SpiceManager::deinitialize();
 }
+
+TEST_CASE("ScriptScheduler: Coalesce Keys", "[scriptscheduler]") {
+    using namespace openspace;
+    using namespace openspace::scripting;
+
+    SpiceManager::initialize();
+    SpiceManager::ref().loadKernel(
+        absPath("${TESTDIR}/SpiceTest/spicekernels/naif0008.tls").string()
+    );
+
+    ScriptScheduler::ScheduledScript script1;
+    script1.time = Time::convertTime("2000 JAN 03");
+    script1.forwardScript = "ForwardScript1";
+    script1.backwardScript = "BackwardScript1";
+    script1.key = "Scene.A.Renderable.Enabled";
+
+    ScriptScheduler::ScheduledScript script2;
+    script2.time = Time::convertTime("2000 JAN 05");
+    script2.forwardScript = "ForwardScript2";
+    script2.backwardScript = "BackwardScript2";
+
+    ScriptScheduler::ScheduledScript script3;
+    script3.time = Time::convertTime("2000 JAN 07");
+    script3.forwardScript = "ForwardScript3";
+    script3.backwardScript = "BackwardScript3";
+    script3.key = "Scene.A.Renderable.Enabled";
+
+    ScriptScheduler scheduler;
+    scheduler.progressTo(Time::convertTime("2000 JAN 01"));
+    scheduler.loadScripts({ script1, script2, script3 });
+
+    std::vector<std::string> res = scheduler.progressTo(Time::convertTime("2000 JAN 10"));
+    REQUIRE(res.size() == 2);
+    CHECK(res[0] == "ForwardScript2");
+    CHECK(res[1] == "ForwardScript3");
+
+    res = scheduler.progressTo(Time::convertTime("2000 JAN 01"));
+    REQUIRE(res.size() == 2);
+    CHECK(res[0] == "BackwardScript2");
+    CHECK(res[1] == "BackwardScript1");
+
+    // Without a jump over both keyed scripts, each of them is returned
+    res = scheduler.progressTo(Time::convertTime("2000 JAN 04"));
+    REQUIRE(res.size() == 1);
+    CHECK(res[0] == "ForwardScript1");
+
+    SpiceManager::deinitialize();
+}
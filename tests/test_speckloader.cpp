@@ -0,0 +1,92 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <modules/space/speckloader.h>
+#include <ghoul/fmt.h>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+namespace {
+    constexpr int BenchmarkEntries = 200000;
+
+    // Writes a speck file with the provided number of entries with three data values and
+    // a comment each. The values only depend on the index of the entry, so the same file
+    // is generated every time
+    std::filesystem::path createSpeckFile(std::string_view name, int nEntries) {
+        const std::filesystem::path path =
+            std::filesystem::temp_directory_path() / fmt::format("{}.speck", name);
+        std::ofstream file(path);
+        file << "# Synthetic speck file\n";
+        file << "datavar 0 lum\n";
+        file << "datavar 1 colorb_v\n";
+        file << "datavar 2 absmag\n";
+        for (int i = 0; i < nEntries; i++) {
+            file << fmt::format(
+                "{} {} {} {} {} {} # Star {}\n",
+                i * 0.5, -i * 0.25, i % 1000, i * 1.5, (i % 200) * 0.01, -i * 0.001, i
+            );
+        }
+        return path;
+    }
+} // namespace
+
+TEST_CASE("SpeckLoader: Load File", "[speckloader]") {
+    const std::filesystem::path path = createSpeckFile("test_speckloader", 1000);
+    const openspace::speck::Dataset dataset = openspace::speck::data::loadFile(path);
+
+    REQUIRE(dataset.variables.size() == 3);
+    CHECK(dataset.variables[1].name == "colorb_v");
+    CHECK(dataset.nValuesPerEntry == 3);
+    REQUIRE(dataset.positions.size() == 1000);
+    CHECK(dataset.positions[10] == glm::vec3(5.f, -2.5f, 10.f));
+    // The values of the same data value index are stored contiguously
+    CHECK(dataset.values[dataset.positions.size() + 10] == 0.1f);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("SpeckLoader: Benchmark", "[speckloader][.benchmark]") {
+    const std::filesystem::path path = createSpeckFile(
+        "benchmark_speckloader",
+        BenchmarkEntries
+    );
+    const std::filesystem::path cache =
+        std::filesystem::path(path).replace_extension("cache");
+
+    BENCHMARK("Load Text") {
+        return openspace::speck::data::loadFile(path).positions.size();
+    };
+
+    openspace::speck::data::saveCachedFile(openspace::speck::data::loadFile(path), cache);
+    BENCHMARK("Load Cache") {
+        return openspace::speck::data::loadCachedFile(cache)->positions.size();
+    };
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(cache);
+}
@@ -24,6 +24,7 @@
 
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 #include <openspace/util/spicemanager.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -35,6 +36,8 @@ namespace {
     constexpr int TYPLEN = 32;
     constexpr int SRCLEN = 128;
 
+    constexpr int BenchmarkQueries = 10000;
+
     namespace spicemanager_constants {
         SpiceInt handle;
         char file[FILLEN], filtyp[TYPLEN], source[SRCLEN];
@@ -497,3 +500,144 @@ TEST_CASE("SpiceManager: Get Field Of View", "[spicemanager]") {
 
     openspace::SpiceManager::deinitialize();
 }
+
+TEST_CASE("SpiceManager: Merge Overlapping Intervals", "[spicemanager]") {
+    using Intervals = std::vector<std::pair<double, double>>;
+    using openspace::detail::insertInterval;
+
+    Intervals intervals;
+    insertInterval(intervals, 0.0, 10.0);
+    insertInterval(intervals, 5.0, 15.0);
+    CHECK(intervals == Intervals{ { 0.0, 15.0 } });
+
+    // An interval that overlaps the beginning of an existing one
+    insertInterval(intervals, -5.0, 1.0);
+    CHECK(intervals == Intervals{ { -5.0, 15.0 } });
+
+    // An interval that is disjoint is inserted in sorted order
+    insertInterval(intervals, 30.0, 40.0);
+    insertInterval(intervals, -20.0, -10.0);
+    CHECK(intervals == Intervals{ { -20.0, -10.0 }, { -5.0, 15.0 }, { 30.0, 40.0 } });
+
+    // An interval that bridges the gap between several existing ones
+    insertInterval(intervals, -12.0, 35.0);
+    CHECK(intervals == Intervals{ { -20.0, 40.0 } });
+}
+
+TEST_CASE("SpiceManager: Keep Touching Intervals Separate", "[spicemanager]") {
+    using Intervals = std::vector<std::pair<double, double>>;
+    using openspace::detail::insertInterval;
+
+    Intervals intervals;
+    insertInterval(intervals, 0.0, 10.0);
+    insertInterval(intervals, 10.0, 20.0);
+    insertInterval(intervals, -10.0, 0.0);
+    CHECK(intervals == Intervals{ { -10.0, 0.0 }, { 0.0, 10.0 }, { 10.0, 20.0 } });
+
+    // An interval that overlaps the touching ones merges all of them
+    insertInterval(intervals, 5.0, 15.0);
+    CHECK(intervals == Intervals{ { -10.0, 0.0 }, { 0.0, 20.0 } });
+}
+
+TEST_CASE("SpiceManager: Merge Nested Intervals", "[spicemanager]") {
+    using Intervals = std::vector<std::pair<double, double>>;
+    using openspace::detail::insertInterval;
+
+    Intervals inner;
+    insertInterval(inner, 0.0, 20.0);
+    insertInterval(inner, 5.0, 10.0);
+    CHECK(inner == Intervals{ { 0.0, 20.0 } });
+
+    // An interval that shares one end point with the outer interval
+    insertInterval(inner, 0.0, 5.0);
+    insertInterval(inner, 15.0, 20.0);
+    CHECK(inner == Intervals{ { 0.0, 20.0 } });
+
+    Intervals outer;
+    insertInterval(outer, 5.0, 10.0);
+    insertInterval(outer, 12.0, 14.0);
+    insertInterval(outer, 0.0, 20.0);
+    CHECK(outer == Intervals{ { 0.0, 20.0 } });
+}
+
+TEST_CASE("SpiceManager: Contains Time At End Points", "[spicemanager]") {
+    using Intervals = std::vector<std::pair<double, double>>;
+    using openspace::detail::containsTime;
+    using openspace::detail::insertInterval;
+
+    CHECK_FALSE(containsTime(Intervals(), 0.0));
+
+    Intervals intervals;
+    insertInterval(intervals, 0.0, 10.0);
+    insertInterval(intervals, 20.0, 30.0);
+    insertInterval(intervals, 30.0, 40.0);
+
+    CHECK_FALSE(containsTime(intervals, -1.0));
+    // The begin of an interval is included, the end is not
+    CHECK(containsTime(intervals, 0.0));
+    CHECK(containsTime(intervals, 5.0));
+    CHECK_FALSE(containsTime(intervals, 10.0));
+    CHECK_FALSE(containsTime(intervals, 15.0));
+    CHECK(containsTime(intervals, 20.0));
+    // The end of an interval that touches the next one is covered by the next one
+    CHECK(containsTime(intervals, 30.0));
+    CHECK(containsTime(intervals, 39.0));
+    CHECK_FALSE(containsTime(intervals, 40.0));
+    CHECK_FALSE(containsTime(intervals, 50.0));
+}
+
+TEST_CASE("SpiceManager: Query Benchmark", "[spicemanager][.benchmark]") {
+    openspace::SpiceManager::initialize();
+
+    using openspace::SpiceManager;
+    loadMetaKernel();
+
+    const double et = SpiceManager::ref().ephemerisTimeFromDate("2004 jun 11 19:32:00");
+    const SpiceManager::AberrationCorrection corr = {
+        SpiceManager::AberrationCorrection::Type::LightTimeStellar,
+        SpiceManager::AberrationCorrection::Direction::Reception
+    };
+
+    BENCHMARK("Ephemeris Time From Date") {
+        double sum = 0.0;
+        for (int i = 0; i < BenchmarkQueries; i++) {
+            sum += SpiceManager::ref().ephemerisTimeFromDate("2004 jun 11 19:32:00");
+        }
+        return sum;
+    };
+
+    BENCHMARK("Target Position") {
+        glm::dvec3 sum = glm::dvec3(0.0);
+        for (int i = 0; i < BenchmarkQueries; i++) {
+            sum += SpiceManager::ref().targetPosition(
+                "EARTH", "CASSINI", "J2000", corr, et + i * 0.1
+            );
+        }
+        return sum;
+    };
+
+    BENCHMARK("Position Transform Matrix") {
+        glm::dmat3 sum = glm::dmat3(0.0);
+        for (int i = 0; i < BenchmarkQueries; i++) {
+            sum += SpiceManager::ref().positionTransformMatrix(
+                "J2000", "IAU_PHOEBE", et + i * 0.1
+            );
+        }
+        return sum;
+    };
+
+    // Within a frame, most queries are for the current time and are answered by the
+    // query cache
+    SpiceManager::ref().setQueryCacheTime(et);
+    BENCHMARK("Target Position At Cached Time") {
+        glm::dvec3 sum = glm::dvec3(0.0);
+        for (int i = 0; i < BenchmarkQueries; i++) {
+            sum += SpiceManager::ref().targetPosition(
+                "EARTH", "CASSINI", "J2000", corr, et
+            );
+        }
+        return sum;
+    };
+
+    openspace::SpiceManager::deinitialize();
+}
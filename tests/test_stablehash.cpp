@@ -0,0 +1,77 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/stablehash.h>
+#include <filesystem>
+#include <fstream>
+
+TEST_CASE("StableHash: Reference Values", "[stablehash]") {
+    using namespace openspace;
+
+    // The keys that are stored on disk depend on these values never changing
+    CHECK(stableHash("") == StableHashOffset);
+    CHECK(stableHash("a") == 0xaf63dc4c8601ec8cULL);
+    CHECK(stableHash("foobar") == 0x85944171f73967e8ULL);
+}
+
+TEST_CASE("StableHash: Continue Hash", "[stablehash]") {
+    using namespace openspace;
+
+    CHECK(stableHash("bar", stableHash("foo")) == stableHash("foobar"));
+}
+
+TEST_CASE("StableHash: Combine Is Unambiguous", "[stablehash]") {
+    using namespace openspace;
+
+    uint64_t first = StableHashOffset;
+    stableHashCombine(first, "ab");
+    stableHashCombine(first, "c");
+
+    uint64_t second = StableHashOffset;
+    stableHashCombine(second, "a");
+    stableHashCombine(second, "bc");
+
+    CHECK(first != second);
+}
+
+TEST_CASE("StableHash: File", "[stablehash]") {
+    using namespace openspace;
+
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "openspace-test-stablehash.txt";
+    {
+        std::ofstream file(path, std::ofstream::binary);
+        file << "foobar";
+    }
+
+    const std::optional<StableFileHash> hash = stableHashFile(path);
+    REQUIRE(hash.has_value());
+    CHECK(hash->hash == stableHash("foobar"));
+    CHECK(hash->size == 6);
+
+    std::filesystem::remove(path);
+    CHECK_FALSE(stableHashFile(path).has_value());
+}
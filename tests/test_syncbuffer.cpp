@@ -0,0 +1,114 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <openspace/util/syncbuffer.h>
+#include <ghoul/glm.h>
+#include <string>
+#include <vector>
+
+namespace {
+    // Roughly the amount of data that is synchronized per frame in a large scene
+    constexpr int BenchmarkValues = 10000;
+} // namespace
+
+TEST_CASE("SyncBuffer: Encode Decode", "[syncbuffer]") {
+    openspace::SyncBuffer buffer(8);
+
+    buffer.encode(42);
+    buffer.encode(glm::dvec3(1.0, 2.0, 3.0));
+    buffer.encode(std::string("OpenSpace"));
+    buffer.encode(glm::dquat(1.0, 0.0, 0.0, 0.0));
+    buffer.encode(std::string());
+    buffer.encode(0.5);
+
+    // The buffer has to grow past its initial size, but the encoded data stays intact
+    const std::vector<std::byte> data(
+        buffer.encodedData().begin(),
+        buffer.encodedData().end()
+    );
+    buffer.setData(data);
+
+    CHECK(buffer.decode<int>() == 42);
+    glm::dvec3 v;
+    buffer.decode(v);
+    CHECK(v == glm::dvec3(1.0, 2.0, 3.0));
+    CHECK(buffer.decode() == "OpenSpace");
+    glm::dquat q;
+    buffer.decode(q);
+    CHECK(q == glm::dquat(1.0, 0.0, 0.0, 0.0));
+    CHECK(buffer.decode().empty());
+    CHECK(buffer.decode<double>() == 0.5);
+
+    buffer.reset();
+    CHECK(buffer.encodedData().empty());
+}
+
+TEST_CASE("SyncBuffer: Benchmark", "[syncbuffer][.benchmark]") {
+    openspace::SyncBuffer buffer(1024);
+
+    // Every value corresponds to a synchronized node state with a position, a rotation,
+    // a time, and an occasional string property
+    auto encodeFrame = [&buffer]() {
+        for (int i = 0; i < BenchmarkValues; i++) {
+            buffer.encode(glm::dvec3(i, 2.0 * i, 3.0 * i));
+            buffer.encode(glm::dquat(1.0, 0.0, 0.0, 0.0));
+            buffer.encode(static_cast<double>(i));
+            if (i % 16 == 0) {
+                buffer.encode(std::string("Scene.Node.Renderable.Property"));
+            }
+        }
+    };
+
+    BENCHMARK("Encode") {
+        buffer.reset();
+        encodeFrame();
+        return buffer.encodedData().size();
+    };
+
+    buffer.reset();
+    encodeFrame();
+    const std::vector<std::byte> data(
+        buffer.encodedData().begin(),
+        buffer.encodedData().end()
+    );
+
+    BENCHMARK("Decode") {
+        buffer.setData(data);
+        double sum = 0.0;
+        for (int i = 0; i < BenchmarkValues; i++) {
+            glm::dvec3 position;
+            buffer.decode(position);
+            glm::dquat rotation;
+            buffer.decode(rotation);
+            sum += position.x + rotation.w + buffer.decode<double>();
+            if (i % 16 == 0) {
+                sum += static_cast<double>(buffer.decode().size());
+            }
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,256 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/task.h>
+#include <openspace/util/taskcache.h>
+#include <openspace/util/taskscheduler.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // A task that records the order in which the tasks were performed and keeps track of
+    // the largest number of tasks that were running at the same time
+    class RecordingTask : public openspace::Task {
+    public:
+        struct Log {
+            std::mutex mutex;
+            std::vector<std::string> order;
+            std::atomic_int nRunning = 0;
+            std::atomic_int maxRunning = 0;
+        };
+
+        RecordingTask(Log& log, std::string identifier,
+                      std::vector<std::string> dependencies = {}, bool fails = false)
+            : _log(log)
+            , _fails(fails)
+        {
+            Scheduling scheduling;
+            scheduling.identifier = std::move(identifier);
+            scheduling.dependencies = std::move(dependencies);
+            setScheduling(std::move(scheduling));
+        }
+
+        void perform(const ProgressCallback& onProgress) override {
+            const int running = ++_log.nRunning;
+            int max = _log.maxRunning;
+            while (running > max && !_log.maxRunning.compare_exchange_weak(max, running))
+            {}
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            {
+                std::lock_guard lock(_log.mutex);
+                _log.order.push_back(scheduling().identifier);
+            }
+            onProgress(1.f);
+            _log.nRunning--;
+
+            if (_fails) {
+                throw std::runtime_error("Task failed");
+            }
+        }
+
+        std::string description() override {
+            return scheduling().identifier;
+        }
+
+    private:
+        Log& _log;
+        bool _fails = false;
+    };
+
+    size_t position(const std::vector<std::string>& order, const std::string& id) {
+        return std::find(order.begin(), order.end(), id) - order.begin();
+    }
+} // namespace
+
+TEST_CASE("TaskScheduler: Dependencies", "[taskscheduler]") {
+    using namespace openspace;
+
+    RecordingTask::Log log;
+    std::vector<std::unique_ptr<Task>> tasks;
+    tasks.push_back(std::make_unique<RecordingTask>(log, "c", std::vector<std::string>{
+        "a", "b"
+    }));
+    tasks.push_back(std::make_unique<RecordingTask>(log, "a"));
+    tasks.push_back(std::make_unique<RecordingTask>(log, "b", std::vector<std::string>{
+        "a"
+    }));
+    tasks.push_back(std::make_unique<RecordingTask>(log, "d"));
+
+    TaskScheduler scheduler(std::move(tasks));
+    std::vector<TaskScheduler::Result> results = scheduler.perform(4, 0);
+
+    REQUIRE(results.size() == 4);
+    for (const TaskScheduler::Result& r : results) {
+        CHECK(r.status == TaskScheduler::Result::Status::Succeeded);
+    }
+    REQUIRE(log.order.size() == 4);
+    CHECK(position(log.order, "a") < position(log.order, "b"));
+    CHECK(position(log.order, "b") < position(log.order, "c"));
+}
+
+TEST_CASE("TaskScheduler: Concurrency Limit", "[taskscheduler]") {
+    using namespace openspace;
+
+    RecordingTask::Log log;
+    std::vector<std::unique_ptr<Task>> tasks;
+    for (int i = 0; i < 8; i++) {
+        tasks.push_back(std::make_unique<RecordingTask>(log, std::to_string(i)));
+    }
+
+    TaskScheduler scheduler(std::move(tasks));
+    scheduler.perform(2, 0);
+
+    CHECK(log.order.size() == 8);
+    CHECK(log.maxRunning <= 2);
+}
+
+TEST_CASE("TaskScheduler: Failed Dependency", "[taskscheduler]") {
+    using namespace openspace;
+
+    RecordingTask::Log log;
+    std::vector<std::unique_ptr<Task>> tasks;
+    tasks.push_back(std::make_unique<RecordingTask>(
+        log, "a", std::vector<std::string>(), true
+    ));
+    tasks.push_back(std::make_unique<RecordingTask>(log, "b", std::vector<std::string>{
+        "a"
+    }));
+    tasks.push_back(std::make_unique<RecordingTask>(log, "c", std::vector<std::string>{
+        "b"
+    }));
+    tasks.push_back(std::make_unique<RecordingTask>(log, "d"));
+
+    TaskScheduler scheduler(std::move(tasks));
+    std::vector<TaskScheduler::Result> results = scheduler.perform(2, 0);
+
+    REQUIRE(results.size() == 4);
+    CHECK(results[0].status == TaskScheduler::Result::Status::Failed);
+    CHECK(results[1].status == TaskScheduler::Result::Status::Skipped);
+    CHECK(results[2].status == TaskScheduler::Result::Status::Skipped);
+    CHECK(results[3].status == TaskScheduler::Result::Status::Succeeded);
+}
+
+TEST_CASE("TaskScheduler: Invalid Dependencies", "[taskscheduler]") {
+    using namespace openspace;
+
+    RecordingTask::Log log;
+
+    std::vector<std::unique_ptr<Task>> unknown;
+    unknown.push_back(std::make_unique<RecordingTask>(log, "a", std::vector<std::string>{
+        "b"
+    }));
+    CHECK_THROWS_AS(TaskScheduler(std::move(unknown)), ghoul::RuntimeError);
+
+    std::vector<std::unique_ptr<Task>> cycle;
+    cycle.push_back(std::make_unique<RecordingTask>(log, "a", std::vector<std::string>{
+        "b"
+    }));
+    cycle.push_back(std::make_unique<RecordingTask>(log, "b", std::vector<std::string>{
+        "a"
+    }));
+    CHECK_THROWS_AS(TaskScheduler(std::move(cycle)), ghoul::RuntimeError);
+}
+
+TEST_CASE("TaskScheduler: Up To Date Tasks", "[taskscheduler]") {
+    using namespace openspace;
+
+    // A task that copies its input file to its output file
+    class CopyTask : public Task {
+    public:
+        CopyTask(std::filesystem::path input, std::filesystem::path output, int& count)
+            : _input(std::move(input))
+            , _output(std::move(output))
+            , _count(count)
+        {}
+
+        void perform(const ProgressCallback&) override {
+            std::filesystem::copy_file(
+                _input,
+                _output,
+                std::filesystem::copy_options::overwrite_existing
+            );
+            _count++;
+        }
+
+        std::string description() override { return "Copy"; }
+        std::vector<std::filesystem::path> inputFiles() const override {
+            return { _input };
+        }
+        std::vector<std::filesystem::path> outputFiles() const override {
+            return { _output };
+        }
+
+    private:
+        std::filesystem::path _input;
+        std::filesystem::path _output;
+        int& _count;
+    };
+
+    const std::filesystem::path folder =
+        std::filesystem::temp_directory_path() / "test_taskscheduler";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    const std::filesystem::path input = folder / "input.txt";
+    const std::filesystem::path output = folder / "output.txt";
+    std::ofstream(input) << "first";
+
+    int count = 0;
+    auto run = [&]() {
+        TaskCache cache(folder / "cache.json");
+        std::vector<std::unique_ptr<Task>> tasks;
+        tasks.push_back(std::make_unique<CopyTask>(input, output, count));
+        TaskScheduler scheduler(std::move(tasks));
+        std::vector<TaskScheduler::Result> results = scheduler.perform(1, 0, {}, &cache);
+        cache.save();
+        return results.front().status;
+    };
+
+    CHECK(run() == TaskScheduler::Result::Status::Succeeded);
+    CHECK(count == 1);
+
+    CHECK(run() == TaskScheduler::Result::Status::UpToDate);
+    CHECK(count == 1);
+
+    std::ofstream(input) << "second input";
+    CHECK(run() == TaskScheduler::Result::Status::Succeeded);
+    CHECK(count == 2);
+
+    std::filesystem::remove(output);
+    CHECK(run() == TaskScheduler::Result::Status::Succeeded);
+    CHECK(count == 3);
+
+    std::filesystem::remove_all(folder);
+}
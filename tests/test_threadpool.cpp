@@ -0,0 +1,118 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/threadpool.h>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ThreadPool: ParallelFor", "[threadpool]") {
+    using namespace openspace;
+
+    ThreadPool pool(4);
+    std::vector<int> values(1000, 0);
+    pool.parallelFor(
+        0,
+        values.size(),
+        16,
+        [&values](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                values[i]++;
+            }
+        }
+    );
+    CHECK(std::all_of(values.begin(), values.end(), [](int v) { return v == 1; }));
+}
+
+TEST_CASE("ThreadPool: ParallelFor Exception", "[threadpool]") {
+    using namespace openspace;
+
+    ThreadPool pool(4);
+    std::atomic<int> nRunning = 0;
+    CHECK_THROWS_AS(
+        pool.parallelFor(
+            0,
+            1000,
+            16,
+            [&nRunning](size_t begin, size_t) {
+                nRunning++;
+                if (begin == 0) {
+                    nRunning--;
+                    throw std::runtime_error("Error");
+                }
+                std::this_thread::yield();
+                nRunning--;
+            }
+        ),
+        std::runtime_error
+    );
+    // The exception must only be rethrown after all chunks have finished
+    CHECK(nRunning == 0);
+}
+
+TEST_CASE("ThreadPool: ParallelReduce", "[threadpool]") {
+    using namespace openspace;
+
+    ThreadPool pool(4);
+    const size_t sum = pool.parallelReduce(
+        size_t(0),
+        size_t(1001),
+        10,
+        size_t(0),
+        [](size_t begin, size_t end) {
+            size_t s = 0;
+            for (size_t i = begin; i < end; i++) {
+                s += i;
+            }
+            return s;
+        },
+        [](size_t a, size_t b) { return a + b; }
+    );
+    CHECK(sum == 500500);
+}
+
+TEST_CASE("ThreadPool: Nested Enqueue", "[threadpool]") {
+    using namespace openspace;
+
+    std::atomic<int> counter = 0;
+    {
+        ThreadPool pool(4);
+        for (int i = 0; i < 10; i++) {
+            pool.enqueue([&pool, &counter]() {
+                // Tasks enqueued from a worker are placed in the worker's own deque
+                for (int j = 0; j < 10; j++) {
+                    pool.enqueue([&counter]() { counter++; });
+                }
+            });
+        }
+        while (pool.hasOutstandingTasks() || counter < 100) {
+            std::this_thread::yield();
+        }
+    }
+    CHECK(counter == 100);
+}
@@ -0,0 +1,59 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <modules/globebrowsing/src/tiletelemetry.h>
+
+using namespace openspace::globebrowsing;
+using Histogram = TileTelemetry::Histogram;
+
+TEST_CASE("TileTelemetry: Histogram Buckets", "[tiletelemetry]") {
+    using namespace std::chrono_literals;
+
+    Histogram h;
+    h.record(0us);
+    h.record(1ms);
+    h.record(1500us);
+    h.record(2ms);
+    h.record(3ms);
+    h.record(1024ms);
+    h.record(1025ms);
+    h.record(1h);
+
+    CHECK(h.buckets()[0] == 2);
+    CHECK(h.buckets()[1] == 2);
+    CHECK(h.buckets()[2] == 1);
+    CHECK(h.buckets()[10] == 1);
+    CHECK(h.buckets()[Histogram::NumBuckets - 1] == 2);
+    CHECK(h.count() == 8);
+    CHECK(h.total() == 1h + 1024ms + 1025ms + 7500us);
+}
+
+TEST_CASE("TileTelemetry: Histogram Bounds", "[tiletelemetry]") {
+    CHECK(Histogram::bucketUpperBound(0) == 1);
+    CHECK(Histogram::bucketUpperBound(1) == 2);
+    CHECK(Histogram::bucketUpperBound(10) == 1024);
+    CHECK(Histogram::bucketUpperBound(Histogram::NumBuckets - 1) == 0);
+}
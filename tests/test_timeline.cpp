@@ -24,10 +24,16 @@
 
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 #include <openspace/util/timeline.h>
 #include <openspace/util/time.h>
 
+namespace {
+    constexpr int BenchmarkKeyframes = 1000000;
+    constexpr int BenchmarkQueuedKeyframes = 100000;
+} // namespace
+
 TEST_CASE("TimeLine: Add and Count Keyframes", "[timeline]") {
     openspace::Timeline<openspace::Time> timeline;
     timeline.addKeyframe(0.0, openspace::Time::now());
@@ -95,3 +101,118 @@ TEST_CASE("TimeLine: Remove Keyframes In Range", "[timeline]") {
     timeline.removeKeyframesBetween(-1.0, 4.0);
     CHECK(timeline.nKeyframes() == 0);
 }
+
+TEST_CASE("TimeLine: Monotonic And Random Queries", "[timeline]") {
+    openspace::Timeline<int> timeline;
+    for (int i = 0; i < 100; i++) {
+        timeline.addKeyframe(static_cast<double>(i), i);
+    }
+
+    // Forward playback, which is served by the lookup hint
+    for (int i = 0; i < 990; i++) {
+        const double t = i * 0.1;
+        const openspace::Keyframe<int>* before = timeline.lastKeyframeBefore(t, true);
+        const openspace::Keyframe<int>* after = timeline.firstKeyframeAfter(t);
+        REQUIRE(before);
+        REQUIRE(after);
+        CHECK(before->timestamp <= t);
+        CHECK(after->timestamp > t);
+        CHECK(after->data == before->data + 1);
+    }
+
+    // Jumping around has to fall back to the binary search
+    CHECK(timeline.lastKeyframeBefore(12.5)->data == 12);
+    CHECK(timeline.firstKeyframeAfter(87.0, true)->data == 87);
+    CHECK(timeline.lastKeyframeBefore(3.0)->data == 2);
+    CHECK(timeline.lastKeyframeBefore(0.0) == nullptr);
+    CHECK(timeline.firstKeyframeAfter(99.0) == nullptr);
+
+    // Removing keyframes keeps the lookups consistent
+    timeline.removeKeyframesBefore(50.0);
+    CHECK(timeline.lastKeyframeBefore(49.0, true) == nullptr);
+    CHECK(timeline.firstKeyframeAfter(0.0)->data == 50);
+}
+
+TEST_CASE("TimeLine: Streaming Keyframes", "[timeline]") {
+    openspace::Timeline<int> timeline;
+    for (int i = 0; i < 10; i++) {
+        timeline.addKeyframe(static_cast<double>(i), i);
+    }
+
+    // Keyframes are added at the back and evicted from the front as time progresses
+    for (int i = 10; i < 1000; i++) {
+        timeline.addKeyframe(static_cast<double>(i), i);
+        timeline.removeKeyframesBefore(static_cast<double>(i - 9));
+        REQUIRE(timeline.nKeyframes() == 10);
+        CHECK(timeline.keyframes().front().data == i - 9);
+        CHECK(timeline.lastKeyframeBefore(i - 4.5)->data == i - 5);
+        CHECK(timeline.firstKeyframeAfter(i - 4.5)->data == i - 4);
+        CHECK(timeline.firstKeyframeIndexAfter(i - 4.5) == 5);
+    }
+
+    // Out-of-order keyframes are still sorted into place
+    timeline.addKeyframe(995.5, -1);
+    CHECK(timeline.firstKeyframeAfter(995.0)->data == -1);
+    CHECK(timeline.lastKeyframeBefore(996.0)->data == -1);
+
+    timeline.removeKeyframesBefore(1000.0);
+    CHECK(timeline.nKeyframes() == 0);
+    CHECK(timeline.firstKeyframeAfter(0.0) == nullptr);
+
+    timeline.addKeyframe(2000.0, 2000);
+    CHECK(timeline.lastKeyframeBefore(2001.0)->data == 2000);
+}
+
+TEST_CASE("TimeLine: Lookup Benchmark", "[timeline][.benchmark]") {
+    openspace::Timeline<float> timeline;
+    for (int i = 0; i < BenchmarkKeyframes; i++) {
+        timeline.addKeyframe(static_cast<double>(i), static_cast<float>(i));
+    }
+    REQUIRE(timeline.nKeyframes() == BenchmarkKeyframes);
+
+    BENCHMARK("Forward Playback") {
+        float sum = 0.f;
+        for (int i = 0; i < BenchmarkKeyframes; i++) {
+            const double t = i + 0.5;
+            sum += timeline.lastKeyframeBefore(t, true)->data;
+            const openspace::Keyframe<float>* after = timeline.firstKeyframeAfter(t);
+            sum += after ? after->data : 0.f;
+        }
+        return sum;
+    };
+
+    BENCHMARK("Random Access") {
+        float sum = 0.f;
+        // Stepping by a large prime visits the timeline in a scattered order
+        for (int i = 0; i < BenchmarkKeyframes; i++) {
+            const double t = (static_cast<long long>(i) * 7919) % BenchmarkKeyframes;
+            sum += timeline.lastKeyframeBefore(t + 0.5, true)->data;
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("TimeLine: Streaming Benchmark", "[timeline][.benchmark]") {
+    BENCHMARK("Append, Interpolate, and Evict") {
+        openspace::Timeline<float> timeline;
+        for (int i = 0; i < BenchmarkQueuedKeyframes; i++) {
+            timeline.addKeyframe(static_cast<double>(i), static_cast<float>(i));
+        }
+
+        // Every frame a new keyframe arrives, the current time is interpolated between
+        // the surrounding keyframes, and the keyframes in the past are evicted
+        float sum = 0.f;
+        for (int i = 0; i < BenchmarkQueuedKeyframes; i++) {
+            const double t = i + 0.5;
+            timeline.addKeyframe(
+                static_cast<double>(i + BenchmarkQueuedKeyframes),
+                static_cast<float>(i)
+            );
+            const size_t index = timeline.firstKeyframeIndexAfter(t, true);
+            const std::deque<openspace::Keyframe<float>>& kfs = timeline.keyframes();
+            sum += kfs[index - 1].data + kfs[index].data;
+            timeline.removeKeyframesBefore(t);
+        }
+        return sum;
+    };
+}
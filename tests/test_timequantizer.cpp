@@ -23,17 +23,22 @@
  ****************************************************************************************/
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 #include "modules/globebrowsing/src/timequantizer.h"
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/time.h>
+#include <ghoul/fmt.h>
 #include <ghoul/filesystem/filesystem.h>
+#include <algorithm>
 #include "SpiceUsr.h"
 #include "SpiceZpr.h"
 
 using namespace openspace;
 
 namespace {
+    constexpr int BenchmarkQuantizations = 10000;
+
     int loadLSKKernel() {
         int kernelID = openspace::SpiceManager::ref().loadKernel(
             absPath("${TESTDIR}/SpiceTest/spicekernels/naif0008.tls").string()
@@ -366,3 +371,66 @@ TEST_CASE("TimeQuantizer: Test start time using constructor", "[timequantizer]")
 
     SpiceManager::deinitialize();
 }
+
+TEST_CASE("TimeQuantizer: Test quantized times", "[timequantizer]") {
+    SpiceManager::initialize();
+
+    loadLSKKernel();
+    globebrowsing::TimeQuantizer t1;
+    t1.setStartEndRange("2016-05-28T00:00:00", "2016-07-08T12:00:00");
+    t1.setResolution("4d");
+
+    std::vector<double> times = t1.quantizedTimes(100);
+    REQUIRE(times.size() == 11);
+    CHECK(Time(times.front()).ISO8601() == "2016-05-28T00:00:00.000");
+    CHECK(Time(times[1]).ISO8601() == "2016-06-01T00:00:00.000");
+    CHECK(Time(times.back()).ISO8601() == "2016-07-07T00:00:00.000");
+    CHECK(std::is_sorted(times.begin(), times.end()));
+
+    // Every quantized time has to map onto itself and every time inside a timestep onto
+    // the start of that timestep
+    Time t;
+    for (size_t i = 0; i < times.size() - 1; i++) {
+        t.setTime(times[i]);
+        t1.quantize(t, true);
+        CHECK(t.j2000Seconds() == times[i]);
+
+        t.setTime((times[i] + times[i + 1]) / 2.0);
+        t1.quantize(t, true);
+        CHECK(t.j2000Seconds() == times[i]);
+    }
+
+    CHECK(t1.quantizedTimes(10).empty());
+
+    SpiceManager::deinitialize();
+}
+
+TEST_CASE("TimeQuantizer: Benchmark", "[timequantizer][.benchmark]") {
+    SpiceManager::initialize();
+
+    loadLSKKernel();
+    globebrowsing::TimeQuantizer t1;
+    t1.setStartEndRange("2019-12-09T00:00:00", "2030-03-01T00:00:00");
+
+    Time start;
+    start.setTime("2019-12-09T00:00:00");
+    const double begin = start.j2000Seconds();
+
+    // The same sequence of times is quantized for each resolution, spread over the
+    // whole range with sub-second offsets so that every time has to be rounded
+    for (const char* resolution : { "15m", "1d", "1M", "1y" }) {
+        t1.setResolution(resolution);
+        BENCHMARK(fmt::format("Quantize {}", resolution)) {
+            Time t;
+            double sum = 0.0;
+            for (int i = 0; i < BenchmarkQuantizations; i++) {
+                t.setTime(begin + i * 30011.25);
+                t1.quantize(t, true);
+                sum += t.j2000Seconds();
+            }
+            return sum;
+        };
+    }
+
+    SpiceManager::deinitialize();
+}